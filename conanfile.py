@@ -20,14 +20,24 @@ class EarthMapConan(ConanFile):
         "fPIC": [True, False],
         "with_tests": [True, False],
         "with_examples": [True, False],
-        "enable_opengl_debug": [True, False]
+        "enable_opengl_debug": [True, False],
+        "with_turbojpeg": [True, False],
+        "with_spng": [True, False],
+        "with_zlib": [True, False],
+        "with_lz4": [True, False],
+        "with_zstd": [True, False]
     }
     default_options = {
         "shared": False,
         "fPIC": True,
         "with_tests": True,
         "with_examples": True,
-        "enable_opengl_debug": False
+        "enable_opengl_debug": False,
+        "with_turbojpeg": False,
+        "with_spng": False,
+        "with_zlib": False,
+        "with_lz4": False,
+        "with_zstd": False
     }
 
     # Export sources for conan center
@@ -66,6 +76,20 @@ class EarthMapConan(ConanFile):
         # Image loading for textures and icons
         self.requires("stb/cci.20230920")
 
+        # Optional SIMD decoders for JPEG / PNG tiles
+        if self.options.with_turbojpeg:
+            self.requires("libjpeg-turbo/3.0.2")
+        if self.options.with_spng:
+            self.requires("libspng/0.7.4")
+
+        # Optional tile compression codecs (gzip/deflate, LZ4, zstd)
+        if self.options.with_zlib:
+            self.requires("zlib/1.3.1")
+        if self.options.with_lz4:
+            self.requires("lz4/1.9.4")
+        if self.options.with_zstd:
+            self.requires("zstd/1.5.5")
+
         # Logging framework
         self.requires("spdlog/1.13.0")
 
@@ -94,6 +118,11 @@ class EarthMapConan(ConanFile):
         tc.variables["EARTH_MAP_BUILD_TESTS"] = self.options.with_tests
         tc.variables["EARTH_MAP_BUILD_EXAMPLES"] = self.options.with_examples
         tc.variables["EARTH_MAP_ENABLE_OPENGL_DEBUG"] = self.options.enable_opengl_debug
+        tc.variables["EARTH_MAP_WITH_TURBOJPEG"] = self.options.with_turbojpeg
+        tc.variables["EARTH_MAP_WITH_SPNG"] = self.options.with_spng
+        tc.variables["EARTH_MAP_WITH_ZLIB"] = self.options.with_zlib
+        tc.variables["EARTH_MAP_WITH_LZ4"] = self.options.with_lz4
+        tc.variables["EARTH_MAP_WITH_ZSTD"] = self.options.with_zstd
         tc.generate()
 
     def build(self):
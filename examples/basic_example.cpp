@@ -4,6 +4,7 @@
 #include <iostream>
 #include <exception>
 #include <chrono>
+#include <filesystem>
 #include <thread>
 #include <iomanip>
 
@@ -377,6 +378,9 @@ int main() {
         config.screen_width = window_width;
         config.screen_height = window_height;
         config.enable_performance_monitoring = true;
+        // Tiles, shader binaries and meshes go to a temp directory, not the working tree
+        config.cache_directory =
+            (std::filesystem::temp_directory_path() / "earth_map_example").string();
 
         // Example usage of custom XYZ tile provider
         auto googleProvider = std::make_shared<earth_map::BasicXYZTileProvider>(
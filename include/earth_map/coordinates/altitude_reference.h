@@ -13,7 +13,10 @@
 
 #pragma once
 
+#include <earth_map/coordinates/geoid_grid.h>
 #include <cstdint>
+#include <memory>
+#include <span>
 
 namespace earth_map {
 namespace coordinates {
@@ -88,8 +91,8 @@ enum class AltitudeReference : uint8_t {
  * Provides functions to convert altitude between different reference systems.
  *
  * **Important**: Conversions involving MEAN_SEA_LEVEL require a geoid model
- * (EGM96 or EGM2008). Without a geoid model, these conversions will use an
- * approximate offset based on global average (~0m at equator).
+ * (EGM96 or EGM2008) set with SetGeoidModel(). Without a geoid model, these
+ * conversions use a rough latitude-only approximation (±20 m).
  */
 class AltitudeConverter {
 public:
@@ -116,8 +119,8 @@ public:
      * );
      * ```
      *
-     * **Note**: Conversions involving MEAN_SEA_LEVEL use approximate geoid heights
-     * until a full geoid model (EGM96/EGM2008) is integrated.
+     * **Note**: Conversions involving MEAN_SEA_LEVEL use the geoid model set
+     * with SetGeoidModel(), or approximate geoid heights without one.
      */
     static double Convert(
         double altitude,
@@ -127,6 +130,49 @@ public:
         double terrain_elevation = 0.0
     ) noexcept;
 
+    /**
+     * @brief Convert many altitudes from one reference to another
+     *
+     * Batch form of Convert() over points in structure-of-arrays layout.
+     * Geoid heights are sampled for the whole batch at once. The output
+     * may alias the altitudes.
+     *
+     * @param altitudes Altitude values in meters
+     * @param from Source altitude reference
+     * @param to Target altitude reference
+     * @param latitudes Latitudes in degrees
+     * @param longitudes Longitudes in degrees
+     * @param[out] converted Converted altitudes in meters
+     * @param terrain_elevations Terrain elevations in meters above the WGS84
+     *        ellipsoid; may be empty when neither reference is TERRAIN
+     * @throws std::invalid_argument if the spans differ in length
+     */
+    static void Convert(
+        std::span<const double> altitudes,
+        AltitudeReference from,
+        AltitudeReference to,
+        std::span<const double> latitudes,
+        std::span<const double> longitudes,
+        std::span<double> converted,
+        std::span<const double> terrain_elevations = {}
+    );
+
+    /**
+     * @brief Set the geoid model used for MEAN_SEA_LEVEL conversions
+     *
+     * Applies process-wide; pass nullptr to return to the approximation.
+     *
+     * @param grid Geoid grid, e.g. from GeoidGrid::Load()
+     * @param interpolation Interpolation between grid samples
+     */
+    static void SetGeoidModel(std::shared_ptr<const GeoidGrid> grid,
+                              GeoidInterpolation interpolation = GeoidInterpolation::BILINEAR) noexcept;
+
+    /**
+     * @brief Get the geoid model set with SetGeoidModel(), if any
+     */
+    static std::shared_ptr<const GeoidGrid> GetGeoidModel() noexcept;
+
     /**
      * @brief Get geoid height (undulation) at a location
      *
@@ -135,13 +181,25 @@ public:
      * @param location Geographic location
      * @return double Geoid height in meters (positive = geoid above ellipsoid)
      *
-     * **Note**: Currently returns approximate values. Will be updated when full
-     * geoid model (EGM96/EGM2008) is integrated.
+     * **Note**: Samples the geoid model set with SetGeoidModel(); without
+     * one, returns a rough latitude-only approximation.
      *
      * **Range**: Typically -100m to +100m globally
      */
     static double GetGeoidHeight(const Geographic& location) noexcept;
 
+    /**
+     * @brief Get geoid heights at many locations
+     *
+     * @param latitudes Latitudes in degrees
+     * @param longitudes Longitudes in degrees
+     * @param[out] heights Geoid height in meters at each location
+     * @throws std::invalid_argument if the spans differ in length
+     */
+    static void GetGeoidHeights(std::span<const double> latitudes,
+                                std::span<const double> longitudes,
+                                std::span<double> heights);
+
     /**
      * @brief Get WGS84 ellipsoid radius at a given latitude
      *
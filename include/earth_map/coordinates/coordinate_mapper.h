@@ -18,14 +18,57 @@
 #pragma once
 
 #include <earth_map/coordinates/coordinate_spaces.h>
+#include <earth_map/math/frustum.h>
 #include <earth_map/math/tile_mathematics.h>
 #include <glm/glm.hpp>
+#include <cstddef>
 #include <optional>
+#include <span>
 #include <vector>
 
 namespace earth_map {
 namespace coordinates {
 
+/**
+ * @brief Part of the globe's surface the camera sees
+ *
+ * The horizon cap (points in front of the globe's limb) intersected with
+ * the frustum's half-spaces. Each half-space cuts the sphere in a small
+ * circle, so the boundary is made of circular arcs meeting at vertices.
+ * Rings run counter-clockwise seen from outside the globe (the region on
+ * their left) and hold the exact vertices and the latitude and longitude
+ * extremes of every arc, with points at most a couple of degrees apart
+ * along an arc in between.
+ */
+struct VisibleRegion {
+    /// Boundary rings (usually one; none if nothing is visible)
+    std::vector<std::vector<Geographic>> rings;
+
+    /// Exact latitude/longitude box; spans all longitudes when the region crosses the antimeridian
+    GeographicBounds bounds;
+
+    /// Western edge of the region (greater than east_longitude across the antimeridian)
+    double west_longitude = -180.0;
+
+    /// Eastern edge of the region
+    double east_longitude = 180.0;
+
+    bool contains_north_pole = false;  ///< North pole is visible
+    bool contains_south_pole = false;  ///< South pole is visible
+
+    /**
+     * @brief Check whether no part of the globe is visible
+     */
+    [[nodiscard]] bool IsEmpty() const noexcept { return rings.empty(); }
+
+    /**
+     * @brief Check whether the region's longitudes wrap past ±180°
+     */
+    [[nodiscard]] bool CrossesAntimeridian() const noexcept {
+        return west_longitude > east_longitude;
+    }
+};
+
 /**
  * @brief Central hub for all coordinate space conversions
  *
@@ -253,6 +296,97 @@ public:
         const glm::mat4& proj_matrix,
         const glm::ivec4& viewport) noexcept;
 
+    // ========================================================================
+    // BATCH CONVERSIONS (structure-of-arrays)
+    // ========================================================================
+    //
+    // Each batch overload converts whole arrays with the vectorized kernels
+    // of VectorMath and agrees with its single-point counterpart to float
+    // precision. Arrays of at least kParallelBatchMin points are split into chunks
+    // converted on worker threads. All spans must have the same length;
+    // otherwise std::invalid_argument is thrown.
+
+    /// Point count from which batch conversions run on several threads
+    static constexpr std::size_t kParallelBatchMin = std::size_t{1} << 16;
+
+    /**
+     * @brief Convert arrays of geographic coordinates to world positions
+     *
+     * Invalid points map to the origin, like GeographicToWorld().
+     *
+     * @param latitudes Latitudes in degrees
+     * @param longitudes Longitudes in degrees
+     * @param[out] x World X of each point
+     * @param[out] y World Y of each point
+     * @param[out] z World Z of each point
+     * @param radius Globe radius (default: 1.0)
+     */
+    static void GeographicToWorld(std::span<const double> latitudes,
+                                  std::span<const double> longitudes,
+                                  std::span<float> x,
+                                  std::span<float> y,
+                                  std::span<float> z,
+                                  float radius = 1.0f);
+
+    /**
+     * @brief Convert arrays of world positions to geographic coordinates
+     *
+     * @param x World X of each point
+     * @param y World Y of each point
+     * @param z World Z of each point
+     * @param[out] latitudes Latitudes in degrees
+     * @param[out] longitudes Longitudes in degrees
+     * @param[out] altitudes Distance from the sphere surface
+     * @param radius Globe radius (default: 1.0)
+     */
+    static void WorldToGeographic(std::span<const float> x,
+                                  std::span<const float> y,
+                                  std::span<const float> z,
+                                  std::span<double> latitudes,
+                                  std::span<double> longitudes,
+                                  std::span<double> altitudes,
+                                  float radius = 1.0f);
+
+    /**
+     * @brief Project arrays of geographic coordinates to Web Mercator
+     *
+     * Points outside the Web Mercator bounds get NaN, like
+     * GeographicToProjected().
+     *
+     * @param latitudes Latitudes in degrees
+     * @param longitudes Longitudes in degrees
+     * @param[out] x Projected X in meters
+     * @param[out] y Projected Y in meters
+     */
+    static void GeographicToProjected(std::span<const double> latitudes,
+                                      std::span<const double> longitudes,
+                                      std::span<double> x,
+                                      std::span<double> y);
+
+    /**
+     * @brief Project arrays of world positions to screen
+     *
+     * Points WorldToScreen() rejects (behind the camera or outside the view
+     * volume) get NaN.
+     *
+     * @param x World X of each point
+     * @param y World Y of each point
+     * @param z World Z of each point
+     * @param view_matrix Camera view matrix
+     * @param proj_matrix Projection matrix
+     * @param viewport Screen viewport
+     * @param[out] screen_x Screen X in pixels
+     * @param[out] screen_y Screen Y in pixels
+     */
+    static void WorldToScreen(std::span<const float> x,
+                              std::span<const float> y,
+                              std::span<const float> z,
+                              const glm::mat4& view_matrix,
+                              const glm::mat4& proj_matrix,
+                              const glm::ivec4& viewport,
+                              std::span<double> screen_x,
+                              std::span<double> screen_y);
+
     // ========================================================================
     // UTILITY: Bounds Conversions
     // ========================================================================
@@ -260,14 +394,14 @@ public:
     /**
      * @brief Calculate visible geographic bounds from camera
      *
-     * Determines which geographic region is visible in the current view.
-     * Useful for tile selection and level-of-detail calculations.
+     * Bounding box of CalculateVisibleRegion(), limited to the Web Mercator
+     * latitude range. Across the antimeridian it spans all longitudes.
      *
      * @param camera_world Camera position in world space
      * @param view_matrix View matrix
      * @param proj_matrix Projection matrix
      * @param globe_radius Radius of globe (default: 1.0)
-     * @return Geographic bounding box of visible area
+     * @return Geographic bounding box of visible area (invalid if none is visible)
      */
     [[nodiscard]] static GeographicBounds CalculateVisibleGeographicBounds(
         const World& camera_world,
@@ -275,6 +409,30 @@ public:
         const glm::mat4& proj_matrix,
         float globe_radius = 1.0f) noexcept;
 
+    /**
+     * @brief Calculate the part of the globe the camera sees, analytically
+     *
+     * Intersects the horizon cap with the frustum's planes on the sphere
+     * instead of casting rays, so grazing views and views where the globe
+     * does not reach the screen corners are exact.
+     *
+     * @param camera_world Camera position in world space
+     * @param frustum Camera frustum
+     * @param globe_radius Radius of globe (default: 1.0)
+     * @return Visible region (empty if the camera is inside the globe or looks past it)
+     */
+    [[nodiscard]] static VisibleRegion CalculateVisibleRegion(const World& camera_world,
+                                                              const Frustum& frustum,
+                                                              float globe_radius = 1.0f);
+
+    /**
+     * @brief CalculateVisibleRegion() for a view and projection matrix
+     */
+    [[nodiscard]] static VisibleRegion CalculateVisibleRegion(const World& camera_world,
+                                                              const glm::mat4& view_matrix,
+                                                              const glm::mat4& proj_matrix,
+                                                              float globe_radius = 1.0f);
+
     // ========================================================================
     // Low-Level Cartesian ↔ Geographic Conversions
     // ========================================================================
@@ -0,0 +1,126 @@
+/**
+ * @file geoid_grid.h
+ * @brief Memory-mapped geoid undulation grid (EGM96 / EGM2008)
+ *
+ * Reads the geoid grids distributed with GeographicLib (egm96-15.pgm,
+ * egm2008-2_5.pgm, ...): a binary 16-bit PGM whose header comments give
+ * the Offset and Scale that turn samples into meters. Rows run from 90°N
+ * to 90°S and columns from 0°E eastwards, one sample per grid step.
+ *
+ * The file is mapped rather than read, so only the pages around sampled
+ * locations are loaded. Batch sampling decodes the blocks it touches into
+ * a small per-call cache of float tiles, so neighboring points reuse them.
+ *
+ * Uses POSIX mmap.
+ *
+ * @see altitude_reference.h for conversions using the geoid
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace earth_map {
+namespace coordinates {
+
+/**
+ * @brief Interpolation between geoid grid samples
+ */
+enum class GeoidInterpolation : uint8_t {
+    BILINEAR = 0,  ///< 2x2 samples
+    BICUBIC = 1    ///< 4x4 samples, cubic convolution (Catmull-Rom)
+};
+
+/**
+ * @brief Geoid heights above the WGS84 ellipsoid on a regular lat/lon grid
+ *
+ * Immutable once loaded; safe to sample from several threads.
+ */
+class GeoidGrid {
+public:
+    /// Samples per side of a decoded cache tile
+    static constexpr std::size_t kCacheTileSize = 64;
+    /// Decoded tiles kept per batch call
+    static constexpr std::size_t kCacheTileCount = 16;
+
+    /**
+     * @brief Map a GeographicLib PGM geoid file
+     *
+     * @param file_path Path to the .pgm file
+     * @return Grid, or nullptr if the file is missing or not a geoid grid
+     */
+    [[nodiscard]] static std::shared_ptr<const GeoidGrid> Load(const std::string& file_path);
+
+    ~GeoidGrid();
+
+    GeoidGrid(const GeoidGrid&) = delete;
+    GeoidGrid& operator=(const GeoidGrid&) = delete;
+
+    /**
+     * @brief Get the geoid height at a location
+     *
+     * @param latitude Latitude in degrees [-90, 90]
+     * @param longitude Longitude in degrees (any range; wraps)
+     * @param interpolation Interpolation between samples
+     * @return Geoid height in meters (positive = geoid above ellipsoid)
+     */
+    [[nodiscard]] double Sample(double latitude, double longitude,
+                                GeoidInterpolation interpolation =
+                                    GeoidInterpolation::BILINEAR) const noexcept;
+
+    /**
+     * @brief Get the geoid heights at many locations
+     *
+     * @param latitudes Latitudes in degrees
+     * @param longitudes Longitudes in degrees
+     * @param[out] heights Geoid height in meters at each location
+     * @param interpolation Interpolation between samples
+     * @throws std::invalid_argument if the spans differ in length
+     */
+    void SampleBatch(std::span<const double> latitudes,
+                     std::span<const double> longitudes,
+                     std::span<double> heights,
+                     GeoidInterpolation interpolation = GeoidInterpolation::BILINEAR) const;
+
+    /**
+     * @brief Get the number of samples per row (one per longitude step)
+     */
+    [[nodiscard]] std::size_t GetWidth() const noexcept { return width_; }
+
+    /**
+     * @brief Get the number of rows (one per latitude step, poles included)
+     */
+    [[nodiscard]] std::size_t GetHeight() const noexcept { return height_; }
+
+    /**
+     * @brief Get the grid step in degrees
+     */
+    [[nodiscard]] double GetResolution() const noexcept { return resolution_; }
+
+private:
+    GeoidGrid() = default;
+
+    /// Raw big-endian sample at a row and wrapped column
+    [[nodiscard]] uint16_t RawSample(std::size_t row, std::size_t column) const noexcept {
+        const uint8_t* p = samples_ + 2 * (row * width_ + column);
+        return static_cast<uint16_t>((p[0] << 8) | p[1]);
+    }
+
+    class TileCache;
+
+    void* mapping_ = nullptr;
+    std::size_t mapping_size_ = 0;
+    const uint8_t* samples_ = nullptr;
+    std::size_t width_ = 0;
+    std::size_t height_ = 0;
+    double resolution_ = 0.0;
+    double offset_ = 0.0;
+    double scale_ = 1.0;
+};
+
+} // namespace coordinates
+} // namespace earth_map
@@ -178,6 +178,16 @@ public:
       * @return glm::vec3 Normalized forward direction in world space
       */
      virtual glm::vec3 GetForwardVector() const = 0;
+
+     /**
+      * @brief Get camera velocity
+      *
+      * Measured across Update() calls and smoothed; jumps through
+      * SetPosition() or Reset() are not counted as motion.
+      *
+      * @return glm::vec3 Velocity in world units per second
+      */
+     virtual glm::vec3 GetVelocity() const = 0;
     
     /**
      * @brief Set projection type
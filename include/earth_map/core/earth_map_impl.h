@@ -12,9 +12,13 @@
 #include <earth_map/renderer/renderer.h>
 #include <earth_map/core/scene_manager.h>
 #include <earth_map/core/camera_controller.h>
+#include <earth_map/core/memory_budget_manager.h>
 #include <earth_map/data/tile_manager.h>
 #include <earth_map/renderer/texture_atlas/tile_texture_coordinator.h>
+#include <chrono>
+#include <future>
 #include <memory>
+#include <vector>
 
 namespace earth_map {
 
@@ -54,14 +58,32 @@ public:
     void SetMiniMapOffset(uint32_t offset_x, uint32_t offset_y) override;
     std::pair<uint32_t, uint32_t> GetMiniMapOffset() const override;
     std::string GetPerformanceStats() const override;
+    MetricsRegistry& GetMetrics() override;
+    std::string ExportMetrics(MetricsFormat format) const override;
 
 private:
+    /// GL-free part of the tile system, built on a worker during initialization
+    struct TileBackend {
+        std::unique_ptr<TileManager> tile_manager;
+        std::shared_ptr<TileCache> cache;
+        std::shared_ptr<TileLoader> loader;
+        std::vector<ResidentTile> basemap;  ///< Decoded basemap pack
+    };
+
     Configuration config_;                     ///< Configuration parameters
+    MetricsRegistry metrics_;                  ///< Live metrics and subsystem collectors (outlives them)
+    CounterMetric* frames_total_ = nullptr;    ///< Frames rendered
+    HistogramMetric* frame_time_ = nullptr;    ///< CPU time per frame
+    std::vector<std::size_t> metric_collectors_; ///< Collectors removed before the subsystems go
+    MemoryBudgetManager memory_budget_;        ///< Splits max_cache_memory_mb and the tile pool VRAM between the caches
     std::unique_ptr<Renderer> renderer_;      ///< Rendering engine
     std::unique_ptr<SceneManager> scene_manager_; ///< Scene management
     std::unique_ptr<CameraController> camera_controller_; ///< Camera control
     std::unique_ptr<TileManager> tile_manager_; ///< Tile management
     std::unique_ptr<TileTextureCoordinator> texture_coordinator_; ///< Texture atlas coordinator (new lock-free architecture)
+    std::future<TileBackend> tile_backend_;    ///< Tile system being built off the GL thread
+    std::chrono::steady_clock::time_point init_start_; ///< Start of Initialize()
+    bool first_frame_rendered_ = false;        ///< Time to first frame recorded
     bool initialized_ = false;                 ///< Initialization status
     bool mini_map_enabled_ = false;            ///< Mini-map display enabled
     
@@ -71,6 +93,52 @@ private:
      * @return true if all subsystems initialized successfully
      */
     bool InitializeSubsystems();
+
+    /**
+     * @brief Build the tile manager, cache (loading its index) and loader, and decode the basemap pack
+     *
+     * Touches no GL state; runs on a worker while the renderer initializes.
+     */
+    TileBackend BuildTileBackend() const;
+
+    /**
+     * @brief Attach a built tile backend to the renderer (GL thread)
+     *
+     * Creates the texture coordinator and its upload thread, then connects
+     * the tile renderer.
+     */
+    void FinishTileSystem(TileBackend backend);
+
+    /**
+     * @brief Finish the tile system once its worker is done, without blocking
+     */
+    void PollTileSystem();
+
+    /**
+     * @brief Export the statistics structs of the renderer and tile uploads through metrics_
+     */
+    void RegisterMetricCollectors();
+
+    /**
+     * @brief Export the statistics structs of the tile cache and loader through metrics_
+     *
+     * @param tile_cache Tile cache shared by the loader and texture coordinator
+     * @param tile_loader Tile loader
+     */
+    void RegisterTileBackendCollectors(std::shared_ptr<TileCache> tile_cache,
+                                       std::shared_ptr<TileLoader> tile_loader);
+
+    /**
+     * @brief Register the elevation cache with memory_budget_ (after the renderer is initialized)
+     */
+    void RegisterElevationMemoryConsumer();
+
+    /**
+     * @brief Register the tile cache and the tile pool with memory_budget_
+     *
+     * @param tile_cache Tile cache shared by the loader and texture coordinator
+     */
+    void RegisterTileMemoryConsumers(std::shared_ptr<TileCache> tile_cache);
     
     /**
      * @brief Validate configuration
@@ -0,0 +1,92 @@
+#pragma once
+
+/**
+ * @file executor.h
+ * @brief Minimal executor interface for resuming coroutines on a thread pool
+ *
+ * An executor runs posted work somewhere: a decode pool worker, the GL
+ * thread's upload queue, or the calling thread. Coroutines hop between them
+ * with `co_await ScheduleOn(executor)`, and loader awaitables take an
+ * optional executor to resume on instead of the thread that completed the
+ * load (usually the download engine's event loop, which must not block).
+ */
+
+#include <coroutine>
+#include <functional>
+#include <utility>
+
+namespace earth_map {
+
+/**
+ * @brief Runs posted work, usually on another thread
+ *
+ * Thread Safety: Post() must be safe from any thread.
+ */
+class Executor {
+public:
+    virtual ~Executor() = default;
+
+    /**
+     * @brief Queue work to run
+     *
+     * @param work Work to run exactly once if accepted
+     * @return false if the executor is shut down (work is dropped)
+     */
+    virtual bool Post(std::function<void()> work) = 0;
+};
+
+/**
+ * @brief Executor that runs work immediately on the posting thread
+ */
+class InlineExecutor final : public Executor {
+public:
+    bool Post(std::function<void()> work) override {
+        work();
+        return true;
+    }
+};
+
+/**
+ * @brief Awaitable that resumes the awaiting coroutine on an executor
+ *
+ * If the executor refuses the work (shut down) the coroutine continues on
+ * the current thread rather than being left suspended forever.
+ */
+class ScheduleAwaitable {
+public:
+    explicit ScheduleAwaitable(Executor& executor) : executor_(executor) {}
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        return executor_.Post([handle]() { handle.resume(); });
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    Executor& executor_;
+};
+
+/**
+ * @brief Continue the current coroutine on @p executor
+ *
+ * @code
+ * co_await ScheduleOn(decode_executor);
+ * auto image = DecodeImage(result.metadata, data);   // on a decode worker
+ * @endcode
+ */
+inline ScheduleAwaitable ScheduleOn(Executor& executor) {
+    return ScheduleAwaitable(executor);
+}
+
+/**
+ * @brief Resume @p handle on @p executor, or inline if it is null or refuses
+ */
+inline void ResumeOn(Executor* executor, std::coroutine_handle<> handle) {
+    if (executor == nullptr || !executor->Post([handle]() { handle.resume(); })) {
+        handle.resume();
+    }
+}
+
+} // namespace earth_map
@@ -0,0 +1,534 @@
+#pragma once
+
+/**
+ * @file flat_hash_map.h
+ * @brief Open-addressing hash map and set with SIMD group probing
+ *
+ * Swiss-table layout: slots live in one flat array beside an array of
+ * control bytes, one per slot, holding 7 bits of the key's hash (or an
+ * empty / deleted marker). A lookup loads a group of 16 control bytes,
+ * compares all of them with the hash tag in one SSE2 instruction and
+ * compares keys only for the matching slots, so most probes touch one
+ * cache line of control bytes and one slot. Inserts allocate only when
+ * the table grows.
+ *
+ * Unlike std::unordered_map, inserting may move elements (rehashing
+ * invalidates iterators, pointers and references); erasing never moves
+ * them. TileMap and TileSet key tiles by their packed QuadtreeKey code.
+ */
+
+#include <earth_map/math/tile_mathematics.h>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define EARTH_MAP_FLAT_HASH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace earth_map {
+
+namespace detail {
+
+/// Control byte values; full slots hold a 7-bit hash tag (0 to 127)
+constexpr std::int8_t kCtrlEmpty = -128;
+constexpr std::int8_t kCtrlDeleted = -2;
+
+/// Slots probed together
+constexpr std::size_t kGroupWidth = 16;
+
+/**
+ * @brief Bit mask of the control bytes of a group that satisfy a test
+ */
+struct GroupMatch {
+    std::uint32_t bits;
+
+    /// Bitmask of the bytes equal to @p tag
+    static std::uint32_t Equal(const std::int8_t* ctrl, std::int8_t tag) {
+#ifdef EARTH_MAP_FLAT_HASH_SSE2
+        const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+        return static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(tag))));
+#else
+        std::uint32_t bits = 0;
+        for (std::size_t i = 0; i < kGroupWidth; ++i) {
+            bits |= static_cast<std::uint32_t>(ctrl[i] == tag) << i;
+        }
+        return bits;
+#endif
+    }
+
+    /// Bitmask of the empty or deleted bytes
+    static std::uint32_t Free(const std::int8_t* ctrl) {
+#ifdef EARTH_MAP_FLAT_HASH_SSE2
+        const __m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+        return static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_cmplt_epi8(group, _mm_set1_epi8(-1))));
+#else
+        std::uint32_t bits = 0;
+        for (std::size_t i = 0; i < kGroupWidth; ++i) {
+            bits |= static_cast<std::uint32_t>(ctrl[i] < -1) << i;
+        }
+        return bits;
+#endif
+    }
+};
+
+/// Finalize a hash so that its low and high bits both depend on every input bit
+constexpr std::uint64_t MixHash(std::uint64_t hash) {
+    hash ^= hash >> 30;
+    hash *= 0xBF58476D1CE4E5B9ull;
+    hash ^= hash >> 27;
+    hash *= 0x94D049BB133111EBull;
+    hash ^= hash >> 31;
+    return hash;
+}
+
+} // namespace detail
+
+/**
+ * @brief Flat open-addressing hash map
+ *
+ * Implements the subset of the std::unordered_map interface the engine
+ * uses. Not thread-safe.
+ *
+ * @tparam Key Key type
+ * @tparam Value Mapped type
+ * @tparam Hash Hash of a key (mixed again, so weak hashes are fine)
+ * @tparam Equal Key equality
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename Equal = std::equal_to<Key>>
+class FlatHashMap {
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<const Key, Value>;
+    using size_type = std::size_t;
+
+    template <bool Const>
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FlatHashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, const value_type&, value_type&>;
+        using pointer = std::conditional_t<Const, const value_type*, value_type*>;
+
+        Iterator() = default;
+
+        /// Non-const to const conversion
+        template <bool OtherConst, typename = std::enable_if_t<Const && !OtherConst>>
+        Iterator(const Iterator<OtherConst>& other) : map_(other.map_), index_(other.index_) {}
+
+        reference operator*() const { return map_->slots_[index_]; }
+        pointer operator->() const { return &map_->slots_[index_]; }
+
+        Iterator& operator++() {
+            index_ = map_->NextFull(index_ + 1);
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator previous = *this;
+            ++*this;
+            return previous;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) {
+            return a.index_ == b.index_;
+        }
+
+    private:
+        friend class FlatHashMap;
+        using MapPointer = std::conditional_t<Const, const FlatHashMap*, FlatHashMap*>;
+
+        Iterator(MapPointer map, std::size_t index) : map_(map), index_(index) {}
+
+        MapPointer map_ = nullptr;
+        std::size_t index_ = 0;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    FlatHashMap() = default;
+
+    FlatHashMap(const FlatHashMap& other) {
+        reserve(other.size_);
+        for (const value_type& value : other) {
+            try_emplace(value.first, value.second);
+        }
+    }
+
+    FlatHashMap(FlatHashMap&& other) noexcept { Swap(other); }
+
+    FlatHashMap& operator=(const FlatHashMap& other) {
+        if (this != &other) {
+            FlatHashMap copy(other);
+            Swap(copy);
+        }
+        return *this;
+    }
+
+    FlatHashMap& operator=(FlatHashMap&& other) noexcept {
+        if (this != &other) {
+            FlatHashMap moved(std::move(other));
+            Swap(moved);
+        }
+        return *this;
+    }
+
+    ~FlatHashMap() {
+        DestroyAll();
+        Deallocate();
+    }
+
+    iterator begin() { return iterator(this, NextFull(0)); }
+    iterator end() { return iterator(this, capacity_); }
+    const_iterator begin() const { return const_iterator(this, NextFull(0)); }
+    const_iterator end() const { return const_iterator(this, capacity_); }
+
+    size_type size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief Remove every element, keeping the allocation
+     */
+    void clear() {
+        DestroyAll();
+        std::fill(ctrl_.begin(), ctrl_.end(), detail::kCtrlEmpty);
+        size_ = 0;
+        tombstones_ = 0;
+    }
+
+    /**
+     * @brief Make room for @p count elements without rehashing
+     */
+    void reserve(size_type count) {
+        const size_type needed = CapacityFor(count);
+        if (needed > capacity_) {
+            Rehash(needed);
+        }
+    }
+
+    iterator find(const Key& key) { return iterator(this, Find(key)); }
+    const_iterator find(const Key& key) const { return const_iterator(this, Find(key)); }
+    bool contains(const Key& key) const { return Find(key) != capacity_; }
+    size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+    /**
+     * @brief Insert a value constructed from @p args unless the key is present
+     *
+     * @return Position of the key's element and whether it was inserted
+     */
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args) {
+        const std::uint64_t hash = HashOf(key);
+        const std::size_t found = Find(key, hash);
+        if (found != capacity_) {
+            return {iterator(this, found), false};
+        }
+        const std::size_t index = PrepareInsert(hash);
+        std::construct_at(&slots_[index], std::piecewise_construct, std::forward_as_tuple(key),
+                          std::forward_as_tuple(std::forward<Args>(args)...));
+        return {iterator(this, index), true};
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> emplace(const Key& key, Args&&... args) {
+        return try_emplace(key, std::forward<Args>(args)...);
+    }
+
+    std::pair<iterator, bool> insert(const value_type& value) {
+        return try_emplace(value.first, value.second);
+    }
+
+    Value& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+    /**
+     * @brief Remove the element at @p position
+     *
+     * @return Iterator to the next element
+     */
+    iterator erase(const_iterator position) {
+        EraseAt(position.index_);
+        return iterator(this, NextFull(position.index_ + 1));
+    }
+
+    iterator erase(iterator position) { return erase(const_iterator(position)); }
+
+    size_type erase(const Key& key) {
+        const std::size_t index = Find(key);
+        if (index == capacity_) {
+            return 0;
+        }
+        EraseAt(index);
+        return 1;
+    }
+
+private:
+    using Allocator = std::allocator<value_type>;
+
+    static bool IsFull(std::int8_t ctrl) { return ctrl >= 0; }
+
+    static size_type CapacityFor(size_type count) {
+        // Power of two with load factor at most 7/8
+        size_type capacity = detail::kGroupWidth;
+        while (capacity - capacity / 8 < count) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    std::uint64_t HashOf(const Key& key) const {
+        return detail::MixHash(static_cast<std::uint64_t>(Hash{}(key)));
+    }
+
+    std::size_t Find(const Key& key) const { return Find(key, HashOf(key)); }
+
+    /// Slot of @p key, or capacity_ if absent
+    std::size_t Find(const Key& key, std::uint64_t hash) const {
+        if (capacity_ == 0) {
+            return capacity_;
+        }
+        const auto tag = static_cast<std::int8_t>(hash & 0x7F);
+        const std::size_t mask = capacity_ - 1;
+        std::size_t position = (hash >> 7) & mask;
+        for (std::size_t step = 0; step <= capacity_; step += detail::kGroupWidth) {
+            const std::int8_t* group = ctrl_.data() + position;
+            for (std::uint32_t bits = detail::GroupMatch::Equal(group, tag); bits != 0;
+                 bits &= bits - 1) {
+                const std::size_t index = (position + std::countr_zero(bits)) & mask;
+                if (Equal{}(slots_[index].first, key)) {
+                    return index;
+                }
+            }
+            if (detail::GroupMatch::Equal(group, detail::kCtrlEmpty) != 0) {
+                return capacity_;
+            }
+            position = (position + step + detail::kGroupWidth) & mask;
+        }
+        return capacity_;
+    }
+
+    /// Claim a free slot for a new element of @p hash (absent from the map)
+    std::size_t PrepareInsert(std::uint64_t hash) {
+        if (size_ + tombstones_ + 1 > capacity_ - capacity_ / 8) {
+            // Grow, or just clear the tombstones if they fill the table
+            Rehash(size_ + 1 > (capacity_ - capacity_ / 8) / 2 ? CapacityFor(2 * (size_ + 1))
+                                                                : capacity_);
+        }
+        const std::size_t mask = capacity_ - 1;
+        std::size_t position = (hash >> 7) & mask;
+        for (std::size_t step = 0;; step += detail::kGroupWidth) {
+            const std::uint32_t free = detail::GroupMatch::Free(ctrl_.data() + position);
+            if (free != 0) {
+                const std::size_t index = (position + std::countr_zero(free)) & mask;
+                tombstones_ -= ctrl_[index] == detail::kCtrlDeleted ? 1 : 0;
+                SetCtrl(index, static_cast<std::int8_t>(hash & 0x7F));
+                ++size_;
+                return index;
+            }
+            position = (position + step + detail::kGroupWidth) & mask;
+        }
+    }
+
+    void EraseAt(std::size_t index) {
+        std::destroy_at(&slots_[index]);
+        SetCtrl(index, detail::kCtrlDeleted);
+        --size_;
+        ++tombstones_;
+    }
+
+    /// Set a control byte and its mirror past the end (for unaligned group loads)
+    void SetCtrl(std::size_t index, std::int8_t value) {
+        ctrl_[index] = value;
+        if (index < detail::kGroupWidth) {
+            ctrl_[capacity_ + index] = value;
+        }
+    }
+
+    std::size_t NextFull(std::size_t index) const {
+        while (index < capacity_ && !IsFull(ctrl_[index])) {
+            ++index;
+        }
+        return index;
+    }
+
+    void Rehash(size_type capacity) {
+        std::vector<std::int8_t> old_ctrl(capacity + detail::kGroupWidth, detail::kCtrlEmpty);
+        old_ctrl.swap(ctrl_);
+        value_type* old_slots = slots_;
+        const size_type old_capacity = capacity_;
+
+        slots_ = Allocator().allocate(capacity);
+        capacity_ = capacity;
+        size_ = 0;
+        tombstones_ = 0;
+        for (std::size_t i = 0; i < old_capacity; ++i) {
+            if (IsFull(old_ctrl[i])) {
+                value_type& value = old_slots[i];
+                const std::size_t index = PrepareInsert(HashOf(value.first));
+                std::construct_at(&slots_[index], std::move(value));
+                std::destroy_at(&value);
+            }
+        }
+        if (old_slots) {
+            Allocator().deallocate(old_slots, old_capacity);
+        }
+    }
+
+    void DestroyAll() {
+        if constexpr (!std::is_trivially_destructible_v<value_type>) {
+            for (std::size_t i = 0; i < capacity_; ++i) {
+                if (IsFull(ctrl_[i])) {
+                    std::destroy_at(&slots_[i]);
+                }
+            }
+        }
+    }
+
+    void Deallocate() {
+        if (slots_) {
+            Allocator().deallocate(slots_, capacity_);
+            slots_ = nullptr;
+        }
+    }
+
+    void Swap(FlatHashMap& other) noexcept {
+        std::swap(ctrl_, other.ctrl_);
+        std::swap(slots_, other.slots_);
+        std::swap(capacity_, other.capacity_);
+        std::swap(size_, other.size_);
+        std::swap(tombstones_, other.tombstones_);
+    }
+
+    std::vector<std::int8_t> ctrl_;   ///< capacity_ + kGroupWidth bytes; the tail mirrors the head
+    value_type* slots_ = nullptr;     ///< capacity_ slots, constructed where ctrl_ is full
+    size_type capacity_ = 0;          ///< Zero or a power of two of at least kGroupWidth
+    size_type size_ = 0;
+    size_type tombstones_ = 0;
+};
+
+/**
+ * @brief Flat open-addressing hash set (a FlatHashMap without values)
+ */
+template <typename Key, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class FlatHashSet {
+    using Map = FlatHashMap<Key, std::monostate, Hash, Equal>;
+
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using size_type = std::size_t;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Key;
+        using difference_type = std::ptrdiff_t;
+        using reference = const Key&;
+        using pointer = const Key*;
+
+        const_iterator() = default;
+
+        reference operator*() const { return it_->first; }
+        pointer operator->() const { return &it_->first; }
+
+        const_iterator& operator++() {
+            ++it_;
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator previous = *this;
+            ++it_;
+            return previous;
+        }
+
+        friend bool operator==(const const_iterator& a, const const_iterator& b) {
+            return a.it_ == b.it_;
+        }
+
+    private:
+        friend class FlatHashSet;
+        explicit const_iterator(typename Map::const_iterator it) : it_(it) {}
+
+        typename Map::const_iterator it_;
+    };
+
+    using iterator = const_iterator;
+
+    const_iterator begin() const { return const_iterator(map_.begin()); }
+    const_iterator end() const { return const_iterator(map_.end()); }
+
+    size_type size() const { return map_.size(); }
+    bool empty() const { return map_.empty(); }
+    void clear() { map_.clear(); }
+    void reserve(size_type count) { map_.reserve(count); }
+
+    const_iterator find(const Key& key) const { return const_iterator(map_.find(key)); }
+    bool contains(const Key& key) const { return map_.contains(key); }
+    size_type count(const Key& key) const { return map_.count(key); }
+
+    std::pair<const_iterator, bool> insert(const Key& key) {
+        const auto [it, inserted] = map_.try_emplace(key);
+        return {const_iterator(it), inserted};
+    }
+
+    template <typename InputIt>
+    void insert(InputIt first, InputIt last) {
+        for (; first != last; ++first) {
+            map_.try_emplace(*first);
+        }
+    }
+
+    const_iterator erase(const_iterator position) {
+        return const_iterator(map_.erase(position.it_));
+    }
+
+    size_type erase(const Key& key) { return map_.erase(key); }
+
+private:
+    Map map_;
+};
+
+/**
+ * @brief Tile hash: the packed QuadtreeKey code (mixed by the table)
+ *
+ * Tiles outside the valid range (which have no quadtree code) fall back to
+ * packing their coordinates.
+ */
+struct TileKeyHash {
+    std::size_t operator()(const TileCoordinates& tile) const {
+        const QuadtreeKey key(tile);
+        if (key.IsValid()) {
+            return static_cast<std::size_t>(key.code);
+        }
+        return static_cast<std::size_t>(
+            (static_cast<std::uint64_t>(static_cast<std::uint32_t>(tile.x)) << 32) ^
+            (static_cast<std::uint64_t>(static_cast<std::uint32_t>(tile.y)) << 8) ^
+            static_cast<std::uint64_t>(static_cast<std::uint32_t>(tile.zoom)) ^
+            0x8000000000000000ull);
+    }
+};
+
+/// Per-tile state keyed by tile
+template <typename Value>
+using TileMap = FlatHashMap<TileCoordinates, Value, TileKeyHash>;
+
+/// Set of tiles
+using TileSet = FlatHashSet<TileCoordinates, TileKeyHash>;
+
+} // namespace earth_map
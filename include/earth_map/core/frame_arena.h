@@ -0,0 +1,83 @@
+#pragma once
+
+/**
+ * @file frame_arena.h
+ * @brief Linear allocator for per-frame temporaries
+ *
+ * A frame's scratch containers (visible tile lists, selection queues)
+ * allocate from one block with a pointer bump and are all freed at once
+ * when the next frame resets the arena. Allocations past the block fall
+ * back to the heap; the following Reset() grows the block to cover them,
+ * so once frames reach a steady size they no longer touch the heap.
+ *
+ * Containers allocated from the arena must not outlive the frame.
+ */
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+namespace earth_map {
+
+/**
+ * @brief Monotonic per-frame memory resource that grows to the frame's peak
+ *
+ * Not thread-safe: one thread allocates from it during a frame.
+ */
+class FrameArena {
+public:
+    static constexpr std::size_t kDefaultCapacity = 64 * 1024;
+
+    /**
+     * @brief Create an arena
+     *
+     * @param initial_capacity Bytes of the first block
+     */
+    explicit FrameArena(std::size_t initial_capacity = kDefaultCapacity);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * @brief Get the resource to allocate this frame's temporaries from
+     */
+    std::pmr::memory_resource* GetResource() { return &*resource_; }
+
+    /**
+     * @brief Free everything allocated since the last reset
+     *
+     * If the frame overflowed the block, the block is replaced by one large
+     * enough for everything the frame allocated.
+     */
+    void Reset();
+
+    /**
+     * @brief Get the size of the block in bytes
+     */
+    std::size_t GetCapacity() const { return capacity_; }
+
+    /**
+     * @brief Get the bytes taken from the heap since the last reset
+     */
+    std::size_t GetOverflowBytes() const { return overflow_.bytes; }
+
+private:
+    /// Heap upstream that counts what the monotonic resource takes from it
+    class OverflowResource : public std::pmr::memory_resource {
+    public:
+        std::size_t bytes = 0;
+
+    private:
+        void* do_allocate(std::size_t size, std::size_t alignment) override;
+        void do_deallocate(void* p, std::size_t size, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    };
+
+    std::unique_ptr<std::byte[]> block_;
+    std::size_t capacity_ = 0;
+    OverflowResource overflow_;
+    std::optional<std::pmr::monotonic_buffer_resource> resource_;
+};
+
+} // namespace earth_map
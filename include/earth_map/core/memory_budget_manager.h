@@ -0,0 +1,242 @@
+#pragma once
+
+/**
+ * @file memory_budget_manager.h
+ * @brief One memory budget shared by the caches in RAM and VRAM
+ *
+ * Caches register as consumers of a tier (RAM or VRAM). The manager splits
+ * each tier's budget between its consumers, in proportion to the sizes
+ * they register with, and keeps the sum fixed while it rebalances:
+ *
+ * - Rebalance() moves a step of budget from the consumer that gains least
+ *   from its bytes to the one that gains most. The gain is the consumer's
+ *   misses per megabyte of budget since the last rebalance, counted only
+ *   while it is full: a cache with spare room misses on data it never
+ *   held, and more room would not help it.
+ * - OnMemoryPressure() sheds cold entries (the consumers evict least
+ *   recently used first) in shed order, tier by tier: MODERATE halves the
+ *   earliest consumers until a quarter of the held bytes is released,
+ *   CRITICAL takes every consumer down to its minimum. Budgets are kept,
+ *   so caches refill as the pressure passes.
+ * - Poll() samples the OS pressure signal (MemAvailable of /proc/meminfo
+ *   on Linux) and rebalances at most once per interval. Platforms with a
+ *   push signal (Android onTrimMemory, iOS memory warnings) forward it to
+ *   OnMemoryPressure() instead.
+ *
+ * Thread Safety: NOT thread-safe — call from one thread (the render
+ * thread); consumer callbacks must be safe to call from it.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Memory a consumer holds its entries in
+ */
+enum class MemoryTier : std::uint8_t {
+    RAM,
+    VRAM
+};
+
+/**
+ * @brief Memory pressure reported by the OS
+ */
+enum class MemoryPressure : std::uint8_t {
+    NONE,
+    MODERATE,  ///< Release what is cheap to reload
+    CRITICAL   ///< Release everything above the minimums
+};
+
+/**
+ * @brief Usage sample of a consumer
+ */
+struct MemoryConsumerUsage {
+    std::size_t used_bytes = 0;   ///< Bytes held now
+    std::uint64_t hits = 0;       ///< Lookups served, since creation
+    std::uint64_t misses = 0;     ///< Lookups not served, since creation
+};
+
+/**
+ * @brief A cache whose capacity the manager controls
+ */
+struct MemoryConsumer {
+    std::string name;
+    MemoryTier tier = MemoryTier::RAM;
+
+    /** Share of the tier at registration (the budget it would have on its own) */
+    std::size_t initial_bytes = 0;
+
+    /** Rebalancing keeps the budget within [min_bytes, max_bytes] */
+    std::size_t min_bytes = 0;
+    std::size_t max_bytes = SIZE_MAX;
+
+    /** Lower sheds first under memory pressure */
+    int shed_order = 0;
+
+    /** Sample the consumer's usage */
+    std::function<MemoryConsumerUsage()> sample;
+
+    /** Apply a new budget, evicting down to it if needed */
+    std::function<void(std::size_t bytes)> set_budget;
+
+    /**
+     * Evict cold entries until at most @p bytes are held, keeping the
+     * budget (null = set_budget(bytes), then set_budget(budget))
+     */
+    std::function<void(std::size_t bytes)> shed;
+};
+
+/**
+ * @brief Memory budget manager configuration
+ */
+struct MemoryBudgetConfig {
+    /** RAM shared by the RAM consumers (0 = sum of their initial_bytes) */
+    std::size_t ram_budget_bytes = 0;
+
+    /** VRAM shared by the VRAM consumers (0 = sum of their initial_bytes) */
+    std::size_t vram_budget_bytes = 0;
+
+    /** Fraction of a tier's budget moved by one rebalance step */
+    double rebalance_step = 0.05;
+
+    /** The receiver's gain must exceed the donor's by this factor */
+    double rebalance_hysteresis = 1.5;
+
+    /** Poll() rebalances at most this often */
+    std::chrono::milliseconds rebalance_interval{5000};
+
+    /** Poll() samples the OS pressure signal at most this often */
+    std::chrono::milliseconds pressure_interval{1000};
+
+    /** Available RAM fraction below which pressure is MODERATE */
+    double moderate_available_fraction = 0.15;
+
+    /** Available RAM fraction below which pressure is CRITICAL */
+    double critical_available_fraction = 0.05;
+
+    /** Pressure source for Poll() (null = ReadSystemMemoryPressure()) */
+    std::function<MemoryPressure()> pressure_source;
+};
+
+/**
+ * @brief Budget of one consumer as the manager sees it
+ */
+struct MemoryConsumerStatus {
+    std::string name;
+    MemoryTier tier = MemoryTier::RAM;
+    std::size_t budget_bytes = 0;
+    std::size_t used_bytes = 0;
+    double gain = 0.0;  ///< Misses per MB of budget in the last rebalance interval
+};
+
+/**
+ * @brief Splits RAM and VRAM budgets between registered caches
+ */
+class MemoryBudgetManager {
+public:
+    /// Consumer handle returned by Register()
+    using ConsumerId = std::size_t;
+
+    explicit MemoryBudgetManager(const MemoryBudgetConfig& config = {});
+
+    /**
+     * @brief Register a cache and apply its share of the tier
+     *
+     * The tier's budget is split again between its consumers in
+     * proportion to their initial_bytes.
+     *
+     * @return Handle for Unregister()
+     * @throws std::invalid_argument if sample or set_budget is null
+     */
+    ConsumerId Register(MemoryConsumer consumer);
+
+    /**
+     * @brief Stop managing a consumer (before the cache is destroyed)
+     *
+     * Its budget is split between the remaining consumers of the tier.
+     */
+    void Unregister(ConsumerId id);
+
+    /**
+     * @brief Set a tier's total budget and split it again
+     *
+     * @param bytes Budget; 0 = sum of the consumers' initial_bytes
+     */
+    void SetTierBudget(MemoryTier tier, std::size_t bytes);
+
+    /**
+     * @brief Get a tier's total budget
+     */
+    std::size_t GetTierBudget(MemoryTier tier) const;
+
+    /**
+     * @brief Move one step of budget towards the consumer that gains most
+     *
+     * @return Number of tiers whose split changed
+     */
+    std::size_t Rebalance();
+
+    /**
+     * @brief Shed cold entries for an OS memory pressure signal
+     *
+     * @return Bytes released (as reported by the consumers' samples)
+     */
+    std::size_t OnMemoryPressure(MemoryPressure level);
+
+    /**
+     * @brief Sample the pressure source and rebalance when due (once per frame)
+     *
+     * Shedding repeats while the pressure lasts, once per pressure interval.
+     */
+    void Poll(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+
+    /**
+     * @brief Get the budgets and usage of every consumer
+     */
+    std::vector<MemoryConsumerStatus> GetStatus() const;
+
+    /**
+     * @brief Get the consumers' bytes held in a tier
+     */
+    std::size_t GetUsedBytes(MemoryTier tier) const;
+
+    /**
+     * @brief Read the OS memory pressure (NONE where there is no signal)
+     *
+     * @param moderate_fraction Available RAM fraction below which pressure is MODERATE
+     * @param critical_fraction Available RAM fraction below which pressure is CRITICAL
+     */
+    static MemoryPressure ReadSystemMemoryPressure(double moderate_fraction = 0.15,
+                                                   double critical_fraction = 0.05);
+
+private:
+    struct Entry {
+        ConsumerId id = 0;
+        MemoryConsumer consumer;
+        std::size_t budget = 0;
+        std::uint64_t last_misses = 0;
+        double gain = 0.0;
+    };
+
+    /// Split a tier's budget in proportion to initial_bytes and apply it
+    void Distribute(MemoryTier tier);
+
+    /// Rebalance one tier; true if budget moved
+    bool RebalanceTier(MemoryTier tier);
+
+    std::size_t& TierBudget(MemoryTier tier);
+
+    MemoryBudgetConfig config_;
+    std::vector<Entry> entries_;
+    ConsumerId next_id_ = 1;
+    std::chrono::steady_clock::time_point last_rebalance_{};
+    std::chrono::steady_clock::time_point last_pressure_check_{};
+};
+
+} // namespace earth_map
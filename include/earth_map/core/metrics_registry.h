@@ -0,0 +1,283 @@
+#pragma once
+
+/**
+ * @file metrics_registry.h
+ * @brief Counters, gauges and histograms exported as JSON or Prometheus text
+ *
+ * Hot paths update live metrics owned by a MetricsRegistry: counters and
+ * histograms are split into cache-line-sized shards, each thread writes
+ * its own shard with relaxed atomics, and the shards are summed only when
+ * the registry is read. Subsystems that already keep statistics structs
+ * (TileCacheStats, TileLoaderStats, RenderStats, ...) register a collector
+ * instead, which copies the struct into the snapshot at read time, so
+ * exporting costs nothing between scrapes.
+ *
+ * Metric names follow Prometheus conventions: snake_case with a unit
+ * suffix ("_ms", "_bytes") and "_total" on counters. Histograms are
+ * LatencyHistogram-bucketed and measured in milliseconds.
+ */
+
+#include <earth_map/data/latency_histogram.h>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iosfwd>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace earth_map {
+
+/// Label name/value pairs distinguishing series of one metric
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+/**
+ * @brief Kind of a metric
+ */
+enum class MetricType : std::uint8_t {
+    COUNTER,   ///< Monotonic total
+    GAUGE,     ///< Current value
+    HISTOGRAM  ///< Distribution of millisecond samples
+};
+
+/**
+ * @brief Text format of exported metrics
+ */
+enum class MetricsFormat : std::uint8_t {
+    JSON,       ///< MetricsSnapshot::WriteJson()
+    PROMETHEUS  ///< MetricsSnapshot::WritePrometheus()
+};
+
+/**
+ * @brief Get a metric type name ("counter", "gauge", "histogram")
+ */
+const char* GetMetricTypeName(MetricType type);
+
+/// Shards per live metric; threads are spread over them round-robin
+inline constexpr std::size_t kMetricShards = 16;
+
+/**
+ * @brief Shard of the calling thread
+ */
+std::size_t GetMetricShard();
+
+/**
+ * @brief Monotonic counter updated from any thread
+ */
+class CounterMetric {
+public:
+    void Increment(std::uint64_t delta = 1) {
+        shards_[GetMetricShard()].value.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get the sum over all shards
+     */
+    std::uint64_t GetValue() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<std::uint64_t> value{0};
+    };
+
+    std::array<Shard, kMetricShards> shards_{};
+};
+
+/**
+ * @brief Current value set or adjusted from any thread
+ *
+ * Not sharded: a gauge is one value, and Set() must win over earlier Add()s.
+ */
+class GaugeMetric {
+public:
+    void Set(double value) { value_.store(value, std::memory_order_relaxed); }
+    void Add(double delta) { value_.fetch_add(delta, std::memory_order_relaxed); }
+    double GetValue() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> value_{0.0};
+};
+
+/**
+ * @brief Millisecond distribution recorded from any thread
+ */
+class HistogramMetric {
+public:
+    /**
+     * @brief Record one sample
+     *
+     * @param value_ms Sample in milliseconds
+     */
+    void Record(double value_ms);
+
+    /**
+     * @brief Merge all shards into one histogram
+     *
+     * Samples recorded concurrently may be missing from some fields.
+     */
+    LatencyHistogram Snapshot() const;
+
+private:
+    struct alignas(64) Shard {
+        std::array<std::atomic<std::uint64_t>, LatencyHistogram::kBucketCount> buckets{};
+        std::atomic<double> sum_ms{0.0};
+        std::atomic<double> max_ms{0.0};
+    };
+
+    std::array<Shard, kMetricShards> shards_{};
+};
+
+/**
+ * @brief One series of a metric at collection time
+ */
+struct MetricSample {
+    std::string name;
+    std::string help;
+    MetricType type = MetricType::GAUGE;
+    MetricLabels labels;
+    double value = 0.0;           ///< Counter or gauge value
+    LatencyHistogram histogram;   ///< Histogram samples (HISTOGRAM only)
+};
+
+/**
+ * @brief Values of every metric at one point in time
+ *
+ * Filled by MetricsRegistry::Collect() and by collectors.
+ */
+class MetricsSnapshot {
+public:
+    void AddCounter(std::string name, std::string help, double value, MetricLabels labels = {});
+    void AddGauge(std::string name, std::string help, double value, MetricLabels labels = {});
+    void AddHistogram(std::string name, std::string help, const LatencyHistogram& histogram,
+                      MetricLabels labels = {});
+
+    /**
+     * @brief Get all samples in insertion order
+     */
+    const std::vector<MetricSample>& GetSamples() const { return samples_; }
+
+    /**
+     * @brief Find a series by name and labels (null if absent)
+     */
+    const MetricSample* Find(const std::string& name, const MetricLabels& labels = {}) const;
+
+    /**
+     * @brief Write the snapshot as one JSON object
+     *
+     * {"metrics": [{"name", "type", "help", "labels", "value"}, ...]};
+     * histograms carry "count", "sum", "max" and "p50"/"p95"/"p99" in
+     * place of "value".
+     */
+    void WriteJson(std::ostream& out) const;
+
+    /**
+     * @brief Write the snapshot in the Prometheus text exposition format
+     *
+     * Series of one metric are grouped under a single HELP/TYPE header.
+     * Histograms export every fourth LatencyHistogram bucket (bounds
+     * doubling) so the le set stays fixed across scrapes.
+     */
+    void WritePrometheus(std::ostream& out) const;
+
+private:
+    std::vector<MetricSample> samples_;
+};
+
+/**
+ * @brief Owner of live metrics and collectors of subsystem statistics
+ *
+ * Thread Safety: all methods are thread-safe. References returned by the
+ * Get*() methods stay valid for the lifetime of the registry.
+ */
+class MetricsRegistry {
+public:
+    /// Fills a snapshot from a subsystem's statistics
+    using Collector = std::function<void(MetricsSnapshot&)>;
+
+    MetricsRegistry() = default;
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    /**
+     * @brief Get or create a counter
+     *
+     * @throws std::invalid_argument if the name is already used by another type
+     */
+    CounterMetric& GetCounter(const std::string& name, const std::string& help,
+                              const MetricLabels& labels = {});
+
+    /**
+     * @brief Get or create a gauge
+     *
+     * @throws std::invalid_argument if the name is already used by another type
+     */
+    GaugeMetric& GetGauge(const std::string& name, const std::string& help,
+                          const MetricLabels& labels = {});
+
+    /**
+     * @brief Get or create a histogram
+     *
+     * @throws std::invalid_argument if the name is already used by another type
+     */
+    HistogramMetric& GetHistogram(const std::string& name, const std::string& help,
+                                  const MetricLabels& labels = {});
+
+    /**
+     * @brief Add a collector run by every Collect()
+     *
+     * @return Collector id for RemoveCollector()
+     */
+    std::size_t AddCollector(Collector collector);
+
+    /**
+     * @brief Remove a collector (before whatever it reads is destroyed)
+     */
+    void RemoveCollector(std::size_t id);
+
+    /**
+     * @brief Read every live metric and run every collector
+     */
+    MetricsSnapshot Collect() const;
+
+    /**
+     * @brief Collect() written as JSON
+     */
+    std::string ExportJson() const;
+
+    /**
+     * @brief Collect() written as Prometheus text
+     */
+    std::string ExportPrometheus() const;
+
+private:
+    /// Series key: name followed by its labels
+    using SeriesKey = std::pair<std::string, MetricLabels>;
+
+    struct Series {
+        std::string help;
+        std::variant<CounterMetric*, GaugeMetric*, HistogramMetric*> metric;
+    };
+
+    /// Checks that the name is not registered with another type
+    void ClaimName(const std::string& name, MetricType type);
+
+    mutable std::mutex mutex_;  // Guards the live metrics
+    std::map<SeriesKey, Series> series_;
+    std::map<std::string, MetricType> types_;
+    std::deque<CounterMetric> counters_;
+    std::deque<GaugeMetric> gauges_;
+    std::deque<HistogramMetric> histograms_;
+
+    // Held while collectors run, so none is running once RemoveCollector() returns
+    mutable std::mutex collector_mutex_;
+    std::map<std::size_t, Collector> collectors_;
+    std::size_t next_collector_id_ = 0;
+};
+
+} // namespace earth_map
@@ -0,0 +1,158 @@
+#pragma once
+
+/**
+ * @file scene_index.h
+ * @brief Spatial index of scene objects for culling and picking
+ *
+ * Objects live in a few packed Hilbert R-trees of geometrically growing
+ * size plus a small overlay of recent inserts. A full overlay is packed
+ * into a tree, merging with trees no larger than it (the logarithmic
+ * method), so bulk loads and edits both cost O(log n) amortized rebuild
+ * work per object while queries visit O(log n) trees. Removed objects
+ * are skipped until their tree is next rebuilt.
+ */
+
+#include <earth_map/math/packed_hilbert_rtree.h>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace earth_map {
+
+/// Scene object handle (for placemarks, their PlacemarkId)
+using SceneObjectId = std::uint32_t;
+
+/**
+ * @brief Object and box to index
+ */
+struct SceneIndexEntry {
+    SceneObjectId id = 0;
+    BoundingBox box;  ///< World units
+};
+
+/**
+ * @brief Object hit by a pick ray
+ */
+struct ScenePick {
+    SceneObjectId id = 0;
+    float distance = 0.0f;  ///< Distance along the ray (world units)
+};
+
+/**
+ * @brief Spatial index of scene objects
+ *
+ * Not thread-safe.
+ */
+class SceneIndex {
+public:
+    /**
+     * @brief Create an empty index
+     *
+     * @param overlay_capacity Inserts kept unpacked (scanned linearly by queries)
+     */
+    explicit SceneIndex(std::size_t overlay_capacity = 1024);
+
+    /**
+     * @brief Replace the contents with a bulk-loaded set (one tree)
+     */
+    void Build(std::span<const SceneIndexEntry> entries);
+
+    /**
+     * @brief Insert or move an object
+     */
+    void Insert(SceneObjectId id, const BoundingBox& box);
+
+    /**
+     * @brief Remove an object
+     *
+     * @return true if the object was indexed
+     */
+    bool Remove(SceneObjectId id);
+
+    /**
+     * @brief Pack every object into one tree
+     *
+     * Queries are fastest over a single tree; call after a bulk of edits
+     * (such as a finished load).
+     */
+    void Compact();
+
+    /**
+     * @brief Remove every object
+     */
+    void Clear();
+
+    /**
+     * @brief Check if an object is indexed
+     */
+    bool Contains(SceneObjectId id) const;
+
+    /**
+     * @brief Get the number of indexed objects
+     */
+    std::size_t GetCount() const { return count_; }
+
+    /**
+     * @brief Get the number of packed trees (for statistics)
+     */
+    std::size_t GetTreeCount() const { return trees_.size(); }
+
+    /**
+     * @brief Append the objects whose box intersects a frustum
+     */
+    void QueryVisible(const Frustum& frustum, std::vector<SceneObjectId>& objects) const;
+
+    /**
+     * @brief Append the objects whose box intersects a box
+     */
+    void Query(const BoundingBox& box, std::vector<SceneObjectId>& objects) const;
+
+    /**
+     * @brief Find the object nearest the ray origin within a radius of a ray
+     *
+     * Build the ray from a screen point with
+     * CoordinateMapper::ScreenToWorldRay; for a radius in pixels, scale it
+     * by the world size of a pixel at the expected distance.
+     *
+     * @param origin Ray origin (world units)
+     * @param direction Ray direction (normalized)
+     * @param radius Pick radius (world units)
+     * @return std::optional<ScenePick> Nearest object, if any
+     */
+    std::optional<ScenePick> Pick(const glm::vec3& origin, const glm::vec3& direction,
+                                  float radius) const;
+
+private:
+    /// Where the live copy of an object is
+    struct Location {
+        static constexpr std::uint32_t NONE = 0xFFFFFFFFu;
+        static constexpr std::uint32_t OVERLAY = 0xFFFFFFFEu;
+
+        std::uint32_t container = NONE;  ///< Tree index, OVERLAY or NONE
+        std::uint32_t slot = 0;          ///< Item in the tree or overlay
+    };
+
+    struct Tree {
+        PackedHilbertRTree tree;
+        std::vector<SceneIndexEntry> entries;  ///< By tree item
+        std::size_t live = 0;
+    };
+
+    /// Pack the overlay into a tree, merging the trees no larger than it (or all)
+    void FlushOverlay(bool merge_all = false);
+
+    /// Make a tree from entries, pointing their locations at it
+    Tree MakeTree(std::vector<SceneIndexEntry> entries, std::uint32_t index);
+
+    bool IsLive(std::uint32_t container, std::uint32_t slot, SceneObjectId id) const;
+
+    std::size_t overlay_capacity_;
+    std::vector<Tree> trees_;                 ///< Largest first
+    std::vector<SceneIndexEntry> overlay_;
+    std::vector<Location> locations_;         ///< Indexed by SceneObjectId
+    std::size_t count_ = 0;
+};
+
+} // namespace earth_map
@@ -8,7 +8,9 @@
  * all renderable objects in the 3D scene.
  */
 
+#include <earth_map/core/scene_index.h>
 #include <memory>
+#include <optional>
 #include <vector>
 #include <string>
 
@@ -66,6 +68,26 @@ public:
      * @return std::size_t Number of objects
      */
     virtual std::size_t GetObjectCount() const = 0;
+    
+    /**
+     * @brief Get the objects intersecting a view frustum
+     * 
+     * @param frustum View frustum (world units)
+     * @param objects Receives the visible objects (appended)
+     */
+    virtual void QueryVisible(const Frustum& frustum, std::vector<SceneObjectId>& objects) const = 0;
+    
+    /**
+     * @brief Get the object nearest the ray origin within a radius of a ray
+     * 
+     * @param ray_origin Ray origin (world units), e.g. from CoordinateMapper::ScreenToWorldRay
+     * @param ray_direction Ray direction (normalized)
+     * @param radius Pick radius (world units)
+     * @return std::optional<ScenePick> Picked object, if any
+     */
+    virtual std::optional<ScenePick> Pick(const glm::vec3& ray_origin,
+                                          const glm::vec3& ray_direction,
+                                          float radius) const = 0;
 
 protected:
     /**
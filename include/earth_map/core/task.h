@@ -0,0 +1,401 @@
+#pragma once
+
+/**
+ * @file task.h
+ * @brief Lazily started coroutine task with symmetric-transfer continuation
+ *
+ * Task<T> is the return type of loading pipelines written as coroutines:
+ *
+ * @code
+ * Task<std::optional<DecodedImage>> LoadAndDecode(TileLoader& loader,
+ *                                                 Executor& decoders,
+ *                                                 TileCoordinates coords) {
+ *     TileLoadResult result = co_await AsyncLoadTile(loader, coords, "", &decoders);
+ *     if (!result.success) {
+ *         co_return std::nullopt;
+ *     }
+ *     co_return DecodeImage(result.metadata, result.tile_data->data);
+ * }
+ * @endcode
+ *
+ * A task does nothing until it is awaited (or handed to Spawn() or
+ * SyncWait()); awaiting it runs it on the awaiting thread, and when it
+ * finishes its awaiter is resumed directly (symmetric transfer), so deep
+ * co_await chains do not grow the stack. No thread is blocked while a task
+ * waits on a load: the callback completing the load resumes it.
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace earth_map {
+
+template <typename T = void>
+class Task;
+
+namespace detail {
+
+/**
+ * @brief State shared by every task promise: the awaiter and any exception
+ */
+class TaskPromiseBase {
+public:
+    /**
+     * @brief Final awaiter: transfer control to the awaiting coroutine
+     */
+    struct FinalAwaiter {
+        bool await_ready() const noexcept { return false; }
+
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+            return handle.promise().continuation_;
+        }
+
+        void await_resume() const noexcept {}
+    };
+
+    std::suspend_always initial_suspend() const noexcept { return {}; }
+    FinalAwaiter final_suspend() const noexcept { return {}; }
+
+    void unhandled_exception() noexcept { exception_ = std::current_exception(); }
+
+    void SetContinuation(std::coroutine_handle<> continuation) noexcept {
+        continuation_ = continuation;
+    }
+
+protected:
+    void RethrowIfFailed() const {
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+    }
+
+private:
+    std::coroutine_handle<> continuation_ = std::noop_coroutine();
+    std::exception_ptr exception_;
+};
+
+template <typename T>
+class TaskPromise final : public TaskPromiseBase {
+public:
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+        requires std::is_convertible_v<U&&, T>
+    void return_value(U&& value) {
+        value_.emplace(std::forward<U>(value));
+    }
+
+    T TakeResult() {
+        RethrowIfFailed();
+        return std::move(*value_);
+    }
+
+private:
+    std::optional<T> value_;
+};
+
+template <>
+class TaskPromise<void> final : public TaskPromiseBase {
+public:
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void TakeResult() const { RethrowIfFailed(); }
+};
+
+} // namespace detail
+
+/**
+ * @brief Lazily started coroutine producing a T
+ *
+ * Move-only; owns the coroutine frame and destroys it when dropped. A task
+ * can be awaited once.
+ *
+ * Exceptions escaping the coroutine body are rethrown to the awaiter.
+ */
+template <typename T>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+    using value_type = T;
+
+    Task() noexcept = default;
+
+    explicit Task(std::coroutine_handle<promise_type> handle) noexcept : handle_(handle) {}
+
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            handle_ = std::exchange(other.handle_, nullptr);
+        }
+        return *this;
+    }
+
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
+    ~Task() { Reset(); }
+
+    /**
+     * @brief Check whether the task holds a coroutine
+     */
+    bool IsValid() const noexcept { return static_cast<bool>(handle_); }
+
+    /**
+     * @brief Check whether the coroutine has run to completion
+     */
+    bool IsDone() const noexcept { return !handle_ || handle_.done(); }
+
+    /**
+     * @brief Awaiter: start the task and resume the awaiter when it finishes
+     */
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() const noexcept { return !handle || handle.done(); }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) noexcept {
+                handle.promise().SetContinuation(awaiter);
+                return handle;
+            }
+
+            T await_resume() { return handle.promise().TakeResult(); }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    void Reset() noexcept {
+        if (handle_) {
+            handle_.destroy();
+            handle_ = nullptr;
+        }
+    }
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+
+/**
+ * @brief Eagerly started coroutine that frees its own frame when it ends
+ */
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() const noexcept { return {}; }
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+        void return_void() const noexcept {}
+        void unhandled_exception() const noexcept { std::terminate(); }
+    };
+};
+
+inline DetachedTask RunDetached(Task<void> task) {
+    co_await std::move(task);
+}
+
+/**
+ * @brief Completion flag a blocking caller waits on
+ */
+struct SyncWaitEvent {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool done = false;
+    std::exception_ptr exception;
+
+    void Set() {
+        // Notify under the lock: the waiter destroys the event once it sees done
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+        cv.notify_all();
+    }
+
+    void Wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait(lock, [this]() { return done; });
+    }
+};
+
+template <typename T>
+DetachedTask RunSyncWait(Task<T> task, std::optional<T>* result, SyncWaitEvent* event) {
+    try {
+        result->emplace(co_await std::move(task));
+    } catch (...) {
+        event->exception = std::current_exception();
+    }
+    event->Set();
+}
+
+inline DetachedTask RunSyncWait(Task<void> task, SyncWaitEvent* event) {
+    try {
+        co_await std::move(task);
+    } catch (...) {
+        event->exception = std::current_exception();
+    }
+    event->Set();
+}
+
+/**
+ * @brief Counts finished children; the last one resumes the awaiting parent
+ *
+ * Starts at children + 1: the parent's own arrival in await_suspend decides
+ * whether it needs to suspend at all (every child may already be done).
+ */
+class WhenAllLatch {
+public:
+    explicit WhenAllLatch(std::size_t children) : count_(children + 1) {}
+
+    void Arrive() {
+        if (count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            parent_.resume();
+        }
+    }
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> parent) noexcept {
+        parent_ = parent;
+        return count_.fetch_sub(1, std::memory_order_acq_rel) != 1;
+    }
+
+    void await_resume() const noexcept {}
+
+private:
+    std::atomic<std::size_t> count_;
+    std::coroutine_handle<> parent_;
+};
+
+template <typename T>
+DetachedTask RunWhenAllChild(Task<T> task, std::optional<T>* result,
+                             std::exception_ptr* exception, WhenAllLatch* latch) {
+    try {
+        result->emplace(co_await std::move(task));
+    } catch (...) {
+        *exception = std::current_exception();
+    }
+    latch->Arrive();
+}
+
+inline DetachedTask RunWhenAllChild(Task<void> task, std::exception_ptr* exception,
+                                    WhenAllLatch* latch) {
+    try {
+        co_await std::move(task);
+    } catch (...) {
+        *exception = std::current_exception();
+    }
+    latch->Arrive();
+}
+
+} // namespace detail
+
+/**
+ * @brief Start a task without waiting for it
+ *
+ * The coroutine frame is freed when the task finishes. An exception
+ * escaping a spawned task terminates the program, as it would on a
+ * std::thread; handle errors inside the task.
+ */
+inline void Spawn(Task<void> task) {
+    detail::RunDetached(std::move(task));
+}
+
+/**
+ * @brief Run a task and block the calling thread until it finishes
+ *
+ * The bridge from synchronous code (tests, shutdown paths). Never call it
+ * from a thread the task needs to make progress, e.g. an executor worker
+ * the task resumes on.
+ */
+template <typename T>
+T SyncWait(Task<T> task) {
+    detail::SyncWaitEvent event;
+    if constexpr (std::is_void_v<T>) {
+        detail::RunSyncWait(std::move(task), &event);
+        event.Wait();
+        if (event.exception) {
+            std::rethrow_exception(event.exception);
+        }
+    } else {
+        std::optional<T> result;
+        detail::RunSyncWait(std::move(task), &result, &event);
+        event.Wait();
+        if (event.exception) {
+            std::rethrow_exception(event.exception);
+        }
+        return std::move(*result);
+    }
+}
+
+/**
+ * @brief Run tasks concurrently and collect their results in order
+ *
+ * Every task is started immediately on the calling thread; each runs until
+ * its first suspension, so loads issued by the tasks are all in flight
+ * before the returned task suspends. The awaiter resumes on the thread
+ * that finishes the last task. If any task threw, the first exception (by
+ * index) is rethrown once all have finished.
+ */
+template <typename T>
+Task<std::vector<T>> WhenAll(std::vector<Task<T>> tasks) {
+    std::vector<std::optional<T>> results(tasks.size());
+    std::vector<std::exception_ptr> exceptions(tasks.size());
+    detail::WhenAllLatch latch(tasks.size());
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        detail::RunWhenAllChild(std::move(tasks[i]), &results[i], &exceptions[i], &latch);
+    }
+    co_await latch;
+
+    for (const auto& exception : exceptions) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+    std::vector<T> values;
+    values.reserve(results.size());
+    for (auto& result : results) {
+        values.push_back(std::move(*result));
+    }
+    co_return values;
+}
+
+/**
+ * @brief Run void tasks concurrently and wait for all of them
+ */
+inline Task<void> WhenAll(std::vector<Task<void>> tasks) {
+    std::vector<std::exception_ptr> exceptions(tasks.size());
+    detail::WhenAllLatch latch(tasks.size());
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        detail::RunWhenAllChild(std::move(tasks[i]), &exceptions[i], &latch);
+    }
+    co_await latch;
+
+    for (const auto& exception : exceptions) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+}
+
+} // namespace earth_map
@@ -0,0 +1,250 @@
+#pragma once
+
+/**
+ * @file async_loading.h
+ * @brief Coroutine awaitables over the tile loader, SRTM loader and download engine
+ *
+ * Each awaitable starts its operation when awaited and suspends the
+ * coroutine until the completion callback fires; no thread blocks on a
+ * future and no promise is allocated per request. The result is stored in
+ * the awaiting coroutine's frame.
+ *
+ * By default the coroutine resumes on the thread that completed the
+ * operation, which for downloads is the engine's event loop. Pass an
+ * executor (e.g. a DecodePoolExecutor) to continue on a worker instead:
+ *
+ * @code
+ * DecodePoolExecutor decoders(decode_pool);
+ *
+ * Task<float> SampleAround(SRTMLoader& srtm, Executor& decoders, SRTMCoordinates center) {
+ *     std::vector<Task<SRTMLoadResult>> loads;
+ *     for (int dy = -1; dy <= 1; ++dy) {
+ *         for (int dx = -1; dx <= 1; ++dx) {
+ *             loads.push_back(LoadElevationTask(srtm, {center.latitude + dy,
+ *                                                      center.longitude + dx}, &decoders));
+ *         }
+ *     }
+ *     std::vector<SRTMLoadResult> tiles = co_await WhenAll(std::move(loads));
+ *     co_return Sample(tiles);   // on a decode worker
+ * }
+ * @endcode
+ */
+
+#include <earth_map/core/executor.h>
+#include <earth_map/core/task.h>
+#include <earth_map/data/http_download_engine.h>
+#include <earth_map/data/srtm_loader.h>
+#include <earth_map/data/tile_loader.h>
+#include <earth_map/renderer/texture_atlas/decode_thread_pool.h>
+#include <atomic>
+#include <coroutine>
+#include <optional>
+#include <string>
+#include <utility>
+
+namespace earth_map {
+
+/**
+ * @brief Executor running work on the decode thread pool
+ */
+class DecodePoolExecutor final : public Executor {
+public:
+    explicit DecodePoolExecutor(DecodeThreadPool& pool) : pool_(pool) {}
+
+    bool Post(std::function<void()> work) override {
+        return pool_.Submit(std::move(work));
+    }
+
+private:
+    DecodeThreadPool& pool_;
+};
+
+namespace detail {
+
+/**
+ * @brief Suspends until Complete() is called, then resumes on an executor
+ *
+ * Derived classes implement Start() to launch their operation with a
+ * callback that calls Complete() exactly once. The callback may run inside
+ * Start() (e.g. on a cache hit); the completed_ flag decides which side
+ * resumes the coroutine, so it is resumed exactly once either way.
+ *
+ * @tparam Derived Awaitable implementing Start()
+ * @tparam Result Value produced by co_await
+ */
+template <typename Derived, typename Result>
+class CompletionAwaitable {
+public:
+    explicit CompletionAwaitable(Executor* resume_on) : resume_on_(resume_on) {}
+
+    // Callbacks hold a pointer to the awaitable
+    CompletionAwaitable(const CompletionAwaitable&) = delete;
+    CompletionAwaitable& operator=(const CompletionAwaitable&) = delete;
+
+    bool await_ready() const noexcept { return false; }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+        handle_ = handle;
+        static_cast<Derived*>(this)->Start();
+        if (!completed_.exchange(true, std::memory_order_acq_rel)) {
+            return true;   // The callback resumes us
+        }
+
+        // Completed inline: only hop if the caller asked for an executor
+        return resume_on_ != nullptr &&
+               resume_on_->Post([handle]() { handle.resume(); });
+    }
+
+    Result await_resume() { return std::move(*result_); }
+
+protected:
+    template <typename U>
+    void Complete(U&& result) {
+        result_.emplace(std::forward<U>(result));
+        if (completed_.exchange(true, std::memory_order_acq_rel)) {
+            // await_suspend has returned; the awaitable may be gone after this
+            ResumeOn(resume_on_, handle_);
+        }
+    }
+
+private:
+    Executor* resume_on_;
+    std::coroutine_handle<> handle_;
+    std::optional<Result> result_;
+    std::atomic<bool> completed_{false};
+};
+
+} // namespace detail
+
+/**
+ * @brief Awaitable tile load (see AsyncLoadTile())
+ */
+class TileLoadAwaitable
+    : public detail::CompletionAwaitable<TileLoadAwaitable, TileLoadResult> {
+public:
+    TileLoadAwaitable(TileLoader& loader, const TileCoordinates& coordinates,
+                      std::string provider_name, Executor* resume_on)
+        : CompletionAwaitable(resume_on)
+        , loader_(loader)
+        , coordinates_(coordinates)
+        , provider_name_(std::move(provider_name)) {}
+
+    void Start() {
+        loader_.LoadTileWithCallback(coordinates_,
+            [this](const TileLoadResult& result) { Complete(result); },
+            provider_name_);
+    }
+
+private:
+    TileLoader& loader_;
+    TileCoordinates coordinates_;
+    std::string provider_name_;
+};
+
+/**
+ * @brief Awaitable SRTM tile load (see AsyncLoadElevation())
+ */
+class ElevationLoadAwaitable
+    : public detail::CompletionAwaitable<ElevationLoadAwaitable, SRTMLoadResult> {
+public:
+    ElevationLoadAwaitable(SRTMLoader& loader, const SRTMCoordinates& coordinates,
+                           Executor* resume_on)
+        : CompletionAwaitable(resume_on)
+        , loader_(loader)
+        , coordinates_(coordinates) {}
+
+    void Start() {
+        loader_.LoadTileWithCallback(coordinates_,
+            [this](const SRTMLoadResult& result) { Complete(result); });
+    }
+
+private:
+    SRTMLoader& loader_;
+    SRTMCoordinates coordinates_;
+};
+
+/**
+ * @brief Awaitable HTTP transfer (see AsyncDownload())
+ */
+class DownloadAwaitable
+    : public detail::CompletionAwaitable<DownloadAwaitable, HttpResponse> {
+public:
+    DownloadAwaitable(HttpDownloadEngine& engine, HttpRequest request, Executor* resume_on)
+        : CompletionAwaitable(resume_on)
+        , engine_(engine)
+        , request_(std::move(request)) {}
+
+    void Start() {
+        request_.on_complete = [this](HttpResponse&& response) { Complete(std::move(response)); };
+        engine_.Submit(std::move(request_));
+    }
+
+private:
+    HttpDownloadEngine& engine_;
+    HttpRequest request_;
+};
+
+/**
+ * @brief Load a tile: `TileLoadResult result = co_await AsyncLoadTile(...)`
+ *
+ * Coalesces with concurrent loads of the same tile like LoadTileAsync.
+ *
+ * @param loader Tile loader (must outlive the await)
+ * @param coordinates Tile coordinates
+ * @param provider_name Provider name (empty = default provider)
+ * @param resume_on Executor to resume on (nullptr = completing thread)
+ */
+inline TileLoadAwaitable AsyncLoadTile(TileLoader& loader, const TileCoordinates& coordinates,
+                                       std::string provider_name = "",
+                                       Executor* resume_on = nullptr) {
+    return TileLoadAwaitable(loader, coordinates, std::move(provider_name), resume_on);
+}
+
+/**
+ * @brief Load an SRTM tile: `SRTMLoadResult result = co_await AsyncLoadElevation(...)`
+ *
+ * @param loader SRTM loader (must outlive the await)
+ * @param coordinates Tile coordinates
+ * @param resume_on Executor to resume on (nullptr = completing thread)
+ */
+inline ElevationLoadAwaitable AsyncLoadElevation(SRTMLoader& loader,
+                                                 const SRTMCoordinates& coordinates,
+                                                 Executor* resume_on = nullptr) {
+    return ElevationLoadAwaitable(loader, coordinates, resume_on);
+}
+
+/**
+ * @brief Download a URL: `HttpResponse response = co_await AsyncDownload(...)`
+ *
+ * Without an executor the coroutine resumes on the engine's event loop and
+ * must not block there. Do not Cancel() an awaited request: a cancelled
+ * request never completes, so its coroutine would stay suspended (engine
+ * shutdown completes it with HttpResponse::cancelled set).
+ *
+ * @param engine Download engine (must outlive the await)
+ * @param request Request; its on_complete is replaced
+ * @param resume_on Executor to resume on (nullptr = event-loop thread)
+ */
+inline DownloadAwaitable AsyncDownload(HttpDownloadEngine& engine, HttpRequest request,
+                                       Executor* resume_on = nullptr) {
+    return DownloadAwaitable(engine, std::move(request), resume_on);
+}
+
+/**
+ * @brief Load a tile as a Task, for use with WhenAll() and Spawn()
+ */
+inline Task<TileLoadResult> LoadTileTask(TileLoader& loader, TileCoordinates coordinates,
+                                         std::string provider_name = "",
+                                         Executor* resume_on = nullptr) {
+    co_return co_await AsyncLoadTile(loader, coordinates, std::move(provider_name), resume_on);
+}
+
+/**
+ * @brief Load an SRTM tile as a Task, for use with WhenAll() and Spawn()
+ */
+inline Task<SRTMLoadResult> LoadElevationTask(SRTMLoader& loader, SRTMCoordinates coordinates,
+                                              Executor* resume_on = nullptr) {
+    co_return co_await AsyncLoadElevation(loader, coordinates, resume_on);
+}
+
+} // namespace earth_map
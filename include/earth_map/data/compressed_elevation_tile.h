@@ -0,0 +1,78 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "elevation_data.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace earth_map {
+
+/// Lossless compact in-memory form of an SRTM tile
+///
+/// The tile is split into 64×64 sample blocks that decode independently.
+/// Each sample is predicted from its west, north and north-west neighbors
+/// (the LOCO-I median predictor) and the zigzag-encoded residuals are
+/// Rice-coded with one parameter per block row. Terrain residuals are mostly
+/// a few meters: rolling SRTM1 terrain shrinks about 5x, flat land more, and
+/// rugged SRTM3 mountains (Everest) about 2.5x.
+class CompressedElevationTile {
+public:
+    /// Samples per block edge (edge blocks are smaller)
+    static constexpr size_t kBlockSize = 64;
+
+    /// Compress a tile
+    /// @param tile Tile to compress (owned or mapped samples)
+    explicit CompressedElevationTile(const SRTMTileData& tile);
+
+    // Non-copyable but movable
+    CompressedElevationTile(const CompressedElevationTile&) = delete;
+    CompressedElevationTile& operator=(const CompressedElevationTile&) = delete;
+    CompressedElevationTile(CompressedElevationTile&&) noexcept = default;
+    CompressedElevationTile& operator=(CompressedElevationTile&&) noexcept = default;
+
+    /// Get metadata of the compressed tile
+    [[nodiscard]] const SRTMMetadata& GetMetadata() const noexcept { return metadata_; }
+
+    /// Check if the compressed tile had valid data
+    [[nodiscard]] bool IsValid() const noexcept { return valid_; }
+
+    /// Get the memory footprint of the compressed form in bytes
+    [[nodiscard]] size_t GetSizeBytes() const noexcept;
+
+    /// Get blocks per tile edge
+    [[nodiscard]] size_t GetBlocksPerSide() const noexcept { return blocks_per_side_; }
+
+    /// Decode one block
+    /// @param block_x Block column [0, GetBlocksPerSide() - 1]
+    /// @param block_y Block row [0, GetBlocksPerSide() - 1]
+    /// @param samples Output: the block's samples row-major, kBlockSize
+    ///        apart (at least kBlockSize^2 elements)
+    /// @return False if the block is out of range or @p samples is too small
+    bool DecodeBlock(size_t block_x, size_t block_y, std::span<int16_t> samples) const noexcept;
+
+    /// Decode the whole tile
+    /// @return Tile with owned samples equal to the compressed ones
+    [[nodiscard]] std::unique_ptr<SRTMTileData> Decompress() const;
+
+private:
+    /// Width and height of a block in samples
+    [[nodiscard]] size_t BlockExtent(size_t block) const noexcept;
+
+    /// Decode a block into rows @p stride samples apart
+    void DecodeBlockInto(size_t block_x, size_t block_y, int16_t* samples,
+                         size_t stride) const noexcept;
+
+    SRTMMetadata metadata_;
+    bool valid_;
+    size_t blocks_per_side_;
+    std::vector<uint64_t> block_offsets_;  ///< Bit offset of each block, row-major
+    std::vector<uint64_t> bits_;           ///< Rows: 5-bit Rice parameter, then residuals
+};
+
+} // namespace earth_map
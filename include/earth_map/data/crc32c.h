@@ -0,0 +1,37 @@
+#pragma once
+
+/**
+ * @file crc32c.h
+ * @brief CRC32C (Castagnoli) checksums for cached tile integrity
+ *
+ * Uses the SSE4.2 crc32 instruction on x86-64 (selected at runtime) or the
+ * ARMv8 CRC32 extension when the compiler targets it, and a slicing-by-8
+ * table implementation everywhere else. All variants produce the same value.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace earth_map {
+
+/**
+ * @brief Compute (or extend) a CRC32C
+ *
+ * @param data Bytes to checksum
+ * @param crc Result of a previous call to continue from, or 0
+ * @return CRC32C of the concatenated input
+ */
+std::uint32_t Crc32c(std::span<const std::uint8_t> data, std::uint32_t crc = 0);
+
+/**
+ * @brief Portable implementation of Crc32c (exposed for testing)
+ */
+std::uint32_t Crc32cSoftware(std::span<const std::uint8_t> data, std::uint32_t crc = 0);
+
+/**
+ * @brief Check whether Crc32c uses CPU CRC instructions
+ */
+bool Crc32cIsHardwareAccelerated();
+
+} // namespace earth_map
@@ -0,0 +1,179 @@
+#pragma once
+
+/**
+ * @file disk_cache_collector.h
+ * @brief Background garbage collector of the file-per-tile disk cache
+ *
+ * Enforces the disk size budget and the tile TTL from a low-priority thread,
+ * so BasicTileCache never deletes files on a foreground thread and
+ * cleanup_interval actually means something. Victims come from the
+ * DiskCacheManifest, never from a directory walk:
+ *
+ * - Expired tiles are listed once per expiry scan interval.
+ * - When the cache outgrows its budget, the manifest is ordered once by the
+ *   eviction strategy and tiles are taken from that order until usage
+ *   drops below the low-water mark.
+ *
+ * Each tick deletes at most max_deletions_per_tick tiles, and each victim is
+ * checked against the manifest again before it is deleted, so a tile that
+ * was read or rewritten after it was listed is kept. On Linux the thread
+ * runs at the lowest CPU priority and in the idle I/O class, so its disk
+ * traffic gives way to foreground tile reads.
+ */
+
+#include <earth_map/data/disk_cache_manifest.h>
+#include <earth_map/data/tile_cache.h>
+#include <earth_map/math/tile_mathematics.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Limits enforced by the collector (read at every tick)
+ */
+struct DiskCacheBudget {
+    /// Disk usage above which tiles are evicted
+    std::uint64_t max_bytes = 0;
+
+    /// Seconds since the last download or revalidation before a tile expires
+    std::uint64_t ttl_seconds = 0;
+
+    /// Victim order of size-based eviction
+    TileCacheConfig::EvictionStrategy strategy = TileCacheConfig::EvictionStrategy::LRU;
+};
+
+/**
+ * @brief Disk cache collector configuration
+ */
+struct DiskCacheCollectorConfig {
+    /// Time between ticks of the collector thread
+    std::chrono::milliseconds tick_interval{1000};
+
+    /// Most tiles deleted per tick
+    std::size_t max_deletions_per_tick = 256;
+
+    /// Time between two listings of the expired tiles
+    std::chrono::seconds expiry_scan_interval{3600};
+
+    /// Fraction of max_bytes that size-based eviction brings usage down to
+    double low_water_fraction = 0.9;
+
+    /// Run the thread at idle CPU and I/O priority (Linux only)
+    bool lower_priority = true;
+};
+
+/**
+ * @brief Collector counters
+ */
+struct DiskCacheCollectorStats {
+    std::uint64_t ticks = 0;           ///< Collect() calls
+    std::uint64_t expired_removed = 0; ///< Tiles deleted for their TTL
+    std::uint64_t evicted = 0;         ///< Tiles deleted for the size budget
+    std::uint64_t bytes_freed = 0;     ///< Disk bytes of deleted tiles
+};
+
+/**
+ * @brief Incremental size and TTL enforcement over a disk cache manifest
+ *
+ * Thread Safety: All methods are thread-safe.
+ */
+class DiskCacheCollector {
+public:
+    /// Current limits (the cache configuration may change at any time)
+    using BudgetSource = std::function<DiskCacheBudget()>;
+
+    /// Delete a tile's files and manifest entry; false if it must stay
+    using Remover = std::function<bool(const TileCoordinates&)>;
+
+    /**
+     * @brief Constructor (the thread starts with Start())
+     *
+     * @param manifest Index of the cached tiles (must not be null)
+     * @param budget Limit source (must not be empty)
+     * @param remove Tile remover (must not be empty)
+     * @param config Collector configuration
+     * @throws std::invalid_argument if an argument is missing
+     */
+    DiskCacheCollector(std::shared_ptr<DiskCacheManifest> manifest,
+                       BudgetSource budget,
+                       Remover remove,
+                       const DiskCacheCollectorConfig& config = {});
+
+    /**
+     * @brief Destructor: stops the thread after its current tick
+     */
+    ~DiskCacheCollector();
+
+    // Non-copyable
+    DiskCacheCollector(const DiskCacheCollector&) = delete;
+    DiskCacheCollector& operator=(const DiskCacheCollector&) = delete;
+
+    /**
+     * @brief Start the collector thread (no-op if running)
+     */
+    void Start();
+
+    /**
+     * @brief Stop the collector thread after its current tick
+     */
+    void Stop();
+
+    /**
+     * @brief Run the next tick now, e.g. after writes pushed usage over the budget
+     */
+    void Wake();
+
+    /**
+     * @brief Run one tick on the calling thread
+     *
+     * Deletes expired tiles first, then evicts while over the budget, up
+     * to max_deletions_per_tick tiles in total.
+     *
+     * @param now Current time
+     * @return Number of tiles deleted
+     */
+    std::size_t Collect(std::chrono::system_clock::time_point now);
+
+    /** @brief Get the collector counters */
+    DiskCacheCollectorStats GetStats() const;
+
+    /** @brief Get the configuration */
+    const DiskCacheCollectorConfig& GetConfig() const { return config_; }
+
+private:
+    /// Victim with the manifest entry it was ordered by
+    using Victim = std::pair<TileCoordinates, DiskCacheManifest::Entry>;
+
+    void Run();
+    std::vector<Victim> OrderVictims(TileCacheConfig::EvictionStrategy strategy) const;
+
+    const DiskCacheCollectorConfig config_;
+    std::shared_ptr<DiskCacheManifest> manifest_;
+    BudgetSource budget_;
+    Remover remove_;
+
+    /// Serializes Collect() and guards the work lists and counters
+    mutable std::mutex collect_mutex_;
+    std::vector<TileCoordinates> expired_;  ///< Next expired tile at back()
+    std::vector<Victim> victims_;           ///< Next eviction victim at back()
+    std::chrono::system_clock::time_point next_expiry_scan_{};
+    DiskCacheCollectorStats stats_;
+
+    /// Guards the thread state below
+    std::mutex thread_mutex_;
+    std::condition_variable wake_cv_;
+    bool wake_ = false;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+} // namespace earth_map
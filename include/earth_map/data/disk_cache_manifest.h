@@ -0,0 +1,200 @@
+#pragma once
+
+/**
+ * @file disk_cache_manifest.h
+ * @brief Persistent index of the file-per-tile disk cache
+ *
+ * The manifest keeps size, access time, expiry and checksum of every tile
+ * file so BasicTileCache never has to walk the cache directory. It is
+ * stored as a snapshot (manifest.bin) plus an append-only journal
+ * (manifest.journal). Load() reads the snapshot in one read and replays the
+ * journal; every change appends one fixed-size journal record, and the
+ * journal is folded into a fresh snapshot once it outgrows the index.
+ * A torn record at the journal tail (crash mid-append) is ignored.
+ *
+ * Next to the index, an ordered victim index keeps tiles sorted by the
+ * configured eviction order, so victims are taken from its front instead of
+ * sorting the whole index on every eviction.
+ */
+
+#include <earth_map/math/tile_mathematics.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Snapshot plus journal index of cached tile files
+ *
+ * Thread Safety: All methods are thread-safe.
+ */
+class DiskCacheManifest {
+public:
+    /**
+     * @brief Per-tile record (fixed layout, written to disk as is)
+     */
+    struct Entry {
+        std::uint64_t tile_size = 0;      ///< Bytes of the .tile file
+        std::int64_t last_access = 0;     ///< Seconds since epoch
+        std::int64_t last_modified = 0;   ///< Seconds since epoch
+        std::int64_t expires_at = 0;      ///< Seconds since epoch
+        std::uint32_t metadata_size = 0;  ///< Bytes of the .meta file
+        std::uint32_t checksum = 0;       ///< Tile checksum from metadata
+
+        /** @brief Total bytes on disk */
+        std::uint64_t GetDiskSize() const { return tile_size + metadata_size; }
+    };
+
+    using Predicate = std::function<bool(const TileCoordinates&, const Entry&)>;
+
+    /**
+     * @brief Order in which CollectVictims() hands out tiles
+     */
+    enum class VictimOrder {
+        LEAST_RECENTLY_ACCESSED,  ///< Oldest last_access first
+        OLDEST_MODIFIED,          ///< Oldest last_modified first
+        LARGEST                   ///< Largest on disk first
+    };
+
+    /// Journal records tolerated per indexed tile before checkpointing
+    static constexpr std::size_t kMinCheckpointRecords = 4096;
+
+    /**
+     * @brief Constructor
+     *
+     * @param directory Cache directory holding manifest.bin / manifest.journal
+     */
+    explicit DiskCacheManifest(std::string directory);
+
+    /**
+     * @brief Destructor (closes the journal)
+     */
+    ~DiskCacheManifest();
+
+    // Non-copyable
+    DiskCacheManifest(const DiskCacheManifest&) = delete;
+    DiskCacheManifest& operator=(const DiskCacheManifest&) = delete;
+
+    /**
+     * @brief Read the snapshot, replay the journal and open it for appends
+     *
+     * @return true if a manifest existed; false if the index starts empty
+     *         (first run or unreadable snapshot) and must be rebuilt
+     */
+    bool Load();
+
+    /**
+     * @brief Record a written tile file
+     */
+    void RecordTile(const TileCoordinates& coords, std::uint64_t tile_size,
+                    std::uint32_t checksum);
+
+    /**
+     * @brief Record a written metadata file
+     */
+    void RecordMetadata(const TileCoordinates& coords, std::uint32_t metadata_size,
+                        std::chrono::system_clock::time_point last_modified,
+                        std::chrono::system_clock::time_point expires_at);
+
+    /**
+     * @brief Record a disk read of a tile
+     */
+    void Touch(const TileCoordinates& coords, std::chrono::system_clock::time_point when);
+
+    /**
+     * @brief Forget a tile
+     *
+     * @return true if the tile was indexed
+     */
+    bool Remove(const TileCoordinates& coords);
+
+    /**
+     * @brief Forget every tile and truncate both files
+     */
+    void Clear();
+
+    /**
+     * @brief Replace the index (used when rebuilding from a directory scan)
+     */
+    void Reset(std::vector<std::pair<TileCoordinates, Entry>> entries);
+
+    /**
+     * @brief Write a fresh snapshot and truncate the journal
+     *
+     * @return true on success
+     */
+    bool Checkpoint();
+
+    /** @brief Look up a tile */
+    std::optional<Entry> Find(const TileCoordinates& coords) const;
+
+    /** @brief Get coordinates of tiles matching a predicate */
+    std::vector<TileCoordinates> CollectIf(const Predicate& predicate) const;
+
+    /**
+     * @brief Set the victim order (rebuilds the victim index if it changes)
+     */
+    void SetVictimOrder(VictimOrder order);
+
+    /** @brief Get the victim order */
+    VictimOrder GetVictimOrder() const;
+
+    /**
+     * @brief Get the first tiles in victim order whose sizes add up to @p bytes
+     *
+     * Walks the victim index from its front: O(k log n) for k victims.
+     *
+     * @param bytes Bytes to free
+     * @return Victims with the entries they were ordered by, first victim first
+     */
+    std::vector<std::pair<TileCoordinates, Entry>> CollectVictims(std::uint64_t bytes) const;
+
+    /** @brief Copy all entries */
+    std::vector<std::pair<TileCoordinates, Entry>> GetEntries() const;
+
+    /** @brief Get total bytes on disk of indexed tiles (O(1)) */
+    std::uint64_t GetTotalSize() const;
+
+    /** @brief Get number of indexed tiles (O(1)) */
+    std::size_t GetCount() const;
+
+    /** @brief Get number of journal records since the last checkpoint */
+    std::size_t GetJournalRecordCount() const;
+
+    /** @brief Convert a time point to manifest seconds */
+    static std::int64_t ToSeconds(std::chrono::system_clock::time_point time);
+
+private:
+    enum class Op : std::uint8_t { PUT = 1, REMOVE = 2 };
+
+    void UpdateLocked(const TileCoordinates& coords, const Entry& entry);
+    void AppendLocked(Op op, const TileCoordinates& coords, const Entry& entry);
+    bool CheckpointLocked();
+    void Apply(Op op, const TileCoordinates& coords, const Entry& entry);
+    void ClearLocked();
+    std::int64_t VictimKey(const Entry& entry) const;
+    bool OpenJournalLocked(bool truncate);
+    void CloseJournalLocked();
+
+    std::string snapshot_path_;
+    std::string journal_path_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<TileCoordinates, Entry, TileCoordinatesHash> entries_;
+    VictimOrder victim_order_ = VictimOrder::LEAST_RECENTLY_ACCESSED;
+    std::set<std::pair<std::int64_t, TileCoordinates>> victims_;  ///< First victim first
+    std::uint64_t total_size_ = 0;
+    std::size_t journal_records_ = 0;
+    int journal_fd_ = -1;
+};
+
+} // namespace earth_map
@@ -0,0 +1,68 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "elevation_data.h"
+#include "elevation_provider.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include <earth_map/coordinates/coordinate_spaces.h>
+
+namespace earth_map {
+
+/// Resolves an SRTM tile for a batch query
+/// Called concurrently from several threads; must be thread-safe
+/// @return Tile data, or nullptr if the tile is unavailable
+using SRTMTileLookup =
+    std::function<std::shared_ptr<SRTMTileData>(const SRTMCoordinates&)>;
+
+/// Configuration for batch elevation sampling
+struct ElevationBatchConfig {
+    /// Maximum worker threads (0 = hardware concurrency). Threads come from
+    /// one process-wide set of hardware concurrency - 1 helpers plus the caller.
+    size_t max_threads = 0;
+
+    /// Points per thread below which fewer threads are used
+    /// (batches smaller than this run on the calling thread)
+    size_t min_points_per_thread = 16384;
+};
+
+/// Sample elevations for many points at once
+///
+/// Points are bucketed by SRTM tile, each tile is looked up once and held
+/// for the whole batch, and the buckets are interpolated in parallel. Within
+/// a tile, points are visited in Morton (Z-order) of their sample position so
+/// neighboring queries read neighboring rows instead of striding the tile.
+///
+/// Results are identical to querying each point on its own: the same
+/// normalization, the same tile, and the same interpolation.
+///
+/// @param points Geographic coordinates to query (at most 2^32 points)
+/// @param lookup Tile source
+/// @param config Threading configuration
+/// @return Query results in the order of @p points
+[[nodiscard]] std::vector<ElevationQuery> SampleElevationBatch(
+    const std::vector<coordinates::Geographic>& points,
+    const SRTMTileLookup& lookup,
+    const ElevationBatchConfig& config = ElevationBatchConfig{});
+
+/// Interleave the bits of two 16-bit coordinates (x in the even bits)
+/// @return Morton (Z-order) code
+[[nodiscard]] constexpr uint32_t MortonEncode(uint16_t x, uint16_t y) noexcept {
+    const auto spread = [](uint32_t v) {
+        v = (v | (v << 8)) & 0x00FF00FFu;
+        v = (v | (v << 4)) & 0x0F0F0F0Fu;
+        v = (v | (v << 2)) & 0x33333333u;
+        v = (v | (v << 1)) & 0x55555555u;
+        return v;
+    };
+    return spread(x) | (spread(y) << 1);
+}
+
+} // namespace earth_map
@@ -31,6 +31,14 @@ struct ElevationCacheConfig {
 
     /// Enable disk cache (if false, memory-only cache)
     bool enable_disk_cache = true;
+
+    /// Keep memory-cached tiles compressed (CompressedElevationTile, lossless,
+    /// 2.5-5x smaller); max_memory_cache_size then counts compressed bytes
+    bool compress_memory_tiles = false;
+
+    /// Decompressed tiles kept for reuse when compress_memory_tiles is set
+    /// (outside max_memory_cache_size)
+    size_t hot_tile_count = 4;
 };
 
 /// Statistics for elevation cache
@@ -43,6 +51,7 @@ struct ElevationCacheStats {
     size_t tile_count_memory;        ///< Tiles in memory cache
     size_t tile_count_disk;          ///< Tiles in disk cache
     uint64_t evictions;              ///< Total evictions (LRU)
+    uint64_t decompressions;         ///< Compressed tiles decoded on access
 
     ElevationCacheStats()
         : memory_cache_hits(0),
@@ -52,7 +61,8 @@ struct ElevationCacheStats {
           disk_cache_size_bytes(0),
           tile_count_memory(0),
           tile_count_disk(0),
-          evictions(0) {}
+          evictions(0),
+          decompressions(0) {}
 };
 
 /// Elevation cache interface
@@ -67,6 +77,8 @@ public:
     virtual bool Initialize(const ElevationCacheConfig& config) = 0;
 
     /// Store tile in cache
+    /// Tiles are keyed by coordinates and pyramid level, so the levels of
+    /// one tile are cached side by side
     /// @param tile_data Tile to store
     /// @return True on success
     virtual bool Put(const SRTMTileData& tile_data) = 0;
@@ -77,12 +89,20 @@ public:
     virtual std::optional<std::shared_ptr<SRTMTileData>> Get(
         const SRTMCoordinates& coordinates) = 0;
 
+    /// Retrieve a pyramid level of a tile from cache
+    /// @param coordinates Tile coordinates to retrieve
+    /// @param level Pyramid level (0 = source resolution)
+    /// @return Shared pointer to tile data, or nullopt if not in cache
+    virtual std::optional<std::shared_ptr<SRTMTileData>> Get(
+        const SRTMCoordinates& coordinates, uint32_t level) = 0;
+
     /// Check if tile exists in cache (without loading)
+    /// Only the source resolution (level 0) is considered
     /// @param coordinates Tile coordinates to check
     /// @return True if tile is cached
     virtual bool Contains(const SRTMCoordinates& coordinates) const = 0;
 
-    /// Remove tile from cache
+    /// Remove tile from cache, with every pyramid level
     /// @param coordinates Tile coordinates to remove
     /// @return True if tile was removed
     virtual bool Remove(const SRTMCoordinates& coordinates) = 0;
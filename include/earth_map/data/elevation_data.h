@@ -7,6 +7,7 @@
 #include <iomanip>
 #include <memory>
 #include <optional>
+#include <span>
 #include <sstream>
 #include <vector>
 
@@ -56,10 +57,50 @@ enum class SRTMResolution {
     return samples * samples * sizeof(int16_t);
 }
 
+/// Coarsest level of the per-tile elevation pyramid (level 0 is the source data)
+constexpr uint32_t kMaxElevationPyramidLevel = 8;
+
+/// Approximate ground length of one degree of latitude
+constexpr double kMetersPerDegreeLatitude = 111320.0;
+
+/// Get samples per side of an elevation pyramid level
+/// Each level doubles the sample spacing of the one below it (rounding the
+/// number of intervals down), keeping at least the four corner samples
+/// SRTM3: 1201, 601, 301, 151, 76, 38, 19, 10, 5
+/// SRTM1: 3601, 1801, 901, 451, 226, 113, 57, 29, 15
+[[nodiscard]] constexpr size_t GetPyramidSamplesPerSide(SRTMResolution resolution,
+                                                        uint32_t level) noexcept {
+    const size_t intervals = level < 32 ? (GetSamplesPerSide(resolution) - 1) >> level : 0;
+    return (intervals > 0 ? intervals : 1) + 1;
+}
+
+/// Get the north-south sample spacing of an elevation pyramid level in meters
+[[nodiscard]] constexpr double GetPyramidSampleSpacing(SRTMResolution resolution,
+                                                       uint32_t level) noexcept {
+    return kMetersPerDegreeLatitude /
+           static_cast<double>(GetPyramidSamplesPerSide(resolution, level) - 1);
+}
+
+/// Select the coarsest pyramid level whose sample spacing does not exceed
+/// a ground resolution, so sampling it does not alias
+/// @param resolution Source resolution of the tile
+/// @param ground_resolution_meters Spacing between the query points in meters
+/// @return Pyramid level [0, kMaxElevationPyramidLevel]
+[[nodiscard]] constexpr uint32_t SelectPyramidLevel(SRTMResolution resolution,
+                                                    double ground_resolution_meters) noexcept {
+    uint32_t level = 0;
+    while (level < kMaxElevationPyramidLevel &&
+           GetPyramidSampleSpacing(resolution, level + 1) <= ground_resolution_meters) {
+        ++level;
+    }
+    return level;
+}
+
 /// SRTM tile metadata
 struct SRTMMetadata {
     SRTMCoordinates coordinates;
     SRTMResolution resolution;
+    uint32_t level;             ///< Pyramid level (0 = source resolution)
     size_t samples_per_side;
     size_t file_size;
     bool has_voids;
@@ -67,15 +108,18 @@ struct SRTMMetadata {
     SRTMMetadata() noexcept
         : coordinates{0, 0},
           resolution(SRTMResolution::SRTM3),
+          level(0),
           samples_per_side(0),
           file_size(0),
           has_voids(false) {}
 
-    SRTMMetadata(const SRTMCoordinates& coords, SRTMResolution res) noexcept
+    SRTMMetadata(const SRTMCoordinates& coords, SRTMResolution res,
+                 uint32_t pyramid_level = 0) noexcept
         : coordinates(coords),
           resolution(res),
-          samples_per_side(GetSamplesPerSide(res)),
-          file_size(GetExpectedFileSize(res)),
+          level(pyramid_level),
+          samples_per_side(GetPyramidSamplesPerSide(res, pyramid_level)),
+          file_size(samples_per_side * samples_per_side * sizeof(int16_t)),
           has_voids(false) {}
 };
 
@@ -98,6 +142,20 @@ public:
     /// Construct with metadata
     explicit SRTMTileData(const SRTMMetadata& metadata);
 
+    /// Construct owning existing samples, without copying them
+    /// @param metadata Tile metadata
+    /// @param samples samples_per_side^2 samples, row-major
+    SRTMTileData(const SRTMMetadata& metadata, std::vector<int16_t> samples) noexcept;
+
+    /// Construct a read-only view of samples owned by someone else
+    /// (e.g. a file mapping), without copying them
+    /// @param metadata Tile metadata
+    /// @param mapping Keeps the samples alive as long as the tile
+    /// @param samples samples_per_side^2 samples in host byte order, row-major
+    SRTMTileData(const SRTMMetadata& metadata,
+                 std::shared_ptr<const void> mapping,
+                 const int16_t* samples) noexcept;
+
     /// Default destructor
     ~SRTMTileData() = default;
 
@@ -120,16 +178,50 @@ public:
     [[nodiscard]] float InterpolateElevation(double lat_fraction,
                                              double lon_fraction) const noexcept;
 
+    /// Bilinear interpolation of many points within tile
+    /// Same sampling and double arithmetic as InterpolateElevation, so the
+    /// results are identical to it; 4 points per step with AVX2 gathers
+    /// (selected at runtime) or 2 with NEON
+    /// @param lat_fractions Latitude fractions within tile [0, 1)
+    /// @param lon_fractions Longitude fractions within tile [0, 1)
+    /// @param elevations Output: interpolated elevations in meters, 0.0f
+    ///        where a corner is void or the tile is invalid
+    /// Processes the shortest of the three spans
+    void InterpolateElevations(std::span<const double> lat_fractions,
+                               std::span<const double> lon_fractions,
+                               std::span<float> elevations) const noexcept;
+
+    /// Portable implementation of InterpolateElevations (exposed for testing)
+    void InterpolateElevationsScalar(std::span<const double> lat_fractions,
+                                     std::span<const double> lon_fractions,
+                                     std::span<float> elevations) const noexcept;
+
+    /// Check whether InterpolateElevations uses SIMD instructions
+    [[nodiscard]] static bool IsBatchSimdAccelerated() noexcept;
+
+    /// Build a coarser pyramid level of this tile
+    /// Each output sample is a tent-filtered average of the samples within
+    /// one output spacing of it, skipping voids (void only if all are void)
+    /// @param level Target level (greater than this tile's level, at most
+    ///        kMaxElevationPyramidLevel)
+    /// @return Downsampled tile, or nullptr if the tile is invalid or the
+    ///         level is out of range
+    [[nodiscard]] std::unique_ptr<SRTMTileData> Downsample(uint32_t level) const;
+
     /// Get raw elevation data (mutable for population during parsing)
-    [[nodiscard]] std::vector<int16_t>& GetRawData() noexcept {
-        return elevation_data_;
-    }
+    /// A mapped tile is first copied into owned storage
+    [[nodiscard]] std::vector<int16_t>& GetRawData();
 
-    /// Get raw elevation data (const)
-    [[nodiscard]] const std::vector<int16_t>& GetRawData() const noexcept {
-        return elevation_data_;
+    /// Get the elevation samples, owned or mapped (row-major)
+    [[nodiscard]] std::span<const int16_t> GetSamples() const noexcept {
+        return {SampleData(), mapped_samples_ ? metadata_.samples_per_side *
+                                                    metadata_.samples_per_side
+                                              : elevation_data_.size()};
     }
 
+    /// Check if the samples are viewed from a mapping rather than owned
+    [[nodiscard]] bool IsMapped() const noexcept { return mapped_samples_ != nullptr; }
+
     /// Get metadata
     [[nodiscard]] const SRTMMetadata& GetMetadata() const noexcept {
         return metadata_;
@@ -147,9 +239,17 @@ public:
     }
 
 private:
+    [[nodiscard]] const int16_t* SampleData() const noexcept {
+        return mapped_samples_ ? mapped_samples_ : elevation_data_.data();
+    }
+
     SRTMMetadata metadata_;
     std::vector<int16_t> elevation_data_;  ///< Row-major: [y * width + x]
     bool valid_;
+
+    /// Mapped samples (nullptr when owned in elevation_data_) and their owner
+    const int16_t* mapped_samples_ = nullptr;
+    std::shared_ptr<const void> mapping_;
 };
 
 /// Format SRTM filename from coordinates following standard naming convention
@@ -0,0 +1,85 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <earth_map/coordinates/coordinate_spaces.h>
+
+namespace earth_map {
+
+/// Elevations sampled at a fixed spacing along a path
+struct ElevationProfile {
+    /// Elevations in meters, sample i at distance i * spacing_meters along
+    /// the path; NaN where no elevation data is available
+    std::vector<float> elevations;
+
+    /// Distance between samples in meters
+    double spacing_meters = 0.0;
+
+    /// Length of the path in meters (the last sample is within one
+    /// spacing of its end)
+    double length_meters = 0.0;
+
+    /// Number of NaN samples
+    size_t missing_samples = 0;
+};
+
+/// Walks a path of great-circle legs, emitting points a fixed distance apart
+///
+/// Distances match GeodeticCalculator::HaversineDistance (a sphere of the
+/// WGS84 semi-major axis). Each leg is walked by rotating the position and
+/// heading vectors by the spacing angle, so a step costs a few
+/// multiply-adds plus the conversion to latitude and longitude.
+class GeodesicPathSampler {
+public:
+    /// Start walking a path
+    /// @param path Path vertices (altitudes ignored)
+    /// @param spacing_meters Distance between samples (must be positive)
+    /// @throws std::invalid_argument if the spacing is not positive
+    GeodesicPathSampler(const std::vector<coordinates::Geographic>& path, double spacing_meters);
+
+    /// Get the path length in meters
+    [[nodiscard]] double GetLength() const noexcept { return length_; }
+
+    /// Get the number of samples: one at every multiple of the spacing up to
+    /// the length (none for an empty path)
+    [[nodiscard]] size_t GetSampleCount() const noexcept { return sample_count_; }
+
+    /// Get the number of samples emitted so far
+    [[nodiscard]] size_t GetEmittedCount() const noexcept { return emitted_; }
+
+    /// Emit the next samples
+    /// @param points Output buffer (altitudes are 0)
+    /// @return Number of points written; 0 once every sample was emitted
+    size_t Next(std::span<coordinates::Geographic> points) noexcept;
+
+private:
+    struct Vector {
+        double x = 0.0;
+        double y = 0.0;
+        double z = 0.0;
+    };
+
+    /// Position the walk @p offset meters into leg @p leg
+    void EnterLeg(size_t leg, double offset) noexcept;
+
+    std::vector<Vector> vertices_;  ///< Unit vectors of the path vertices
+    std::vector<double> legs_;      ///< Leg lengths in meters
+    double spacing_;
+    double length_ = 0.0;
+    size_t sample_count_ = 0;
+    size_t emitted_ = 0;
+
+    size_t leg_ = 0;            ///< Current leg
+    double leg_offset_ = 0.0;   ///< Distance of the current point into the leg
+    Vector position_;           ///< Current point
+    Vector heading_;            ///< Unit tangent of the leg at the current point
+    double step_cos_ = 1.0;     ///< Rotation of one spacing
+    double step_sin_ = 0.0;
+};
+
+} // namespace earth_map
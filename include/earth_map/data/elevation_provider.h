@@ -5,9 +5,11 @@
 
 #include "elevation_cache.h"
 #include "elevation_data.h"
+#include "elevation_profile.h"
 #include "srtm_loader.h"
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include <earth_map/coordinates/coordinate_spaces.h>
@@ -30,6 +32,33 @@ struct ElevationQuery {
         source_tile{0, 0} {}
 };
 
+/// Progress handle of an asynchronous region preload
+/// Thread-safe; keeps tracking after the provider stops issuing loads
+class ElevationPreload {
+public:
+    virtual ~ElevationPreload() = default;
+
+    /// Get number of tiles in the region
+    [[nodiscard]] virtual size_t GetTotalTiles() const = 0;
+
+    /// Get number of tiles finished (loaded, cached already, or failed)
+    [[nodiscard]] virtual size_t GetCompletedTiles() const = 0;
+
+    /// Get number of tiles available after loading
+    [[nodiscard]] virtual size_t GetLoadedTiles() const = 0;
+
+    /// Check if every tile finished, or the preload was cancelled and its
+    /// loads in flight finished
+    [[nodiscard]] virtual bool IsDone() const = 0;
+
+    /// Block until IsDone()
+    /// @return Number of tiles loaded
+    virtual size_t Wait() = 0;
+
+    /// Stop issuing loads; loads in flight still complete
+    virtual void Cancel() = 0;
+};
+
 /// High-level interface for querying elevation at any geographic point
 /// Handles SRTM tile loading, caching, and interpolation automatically
 class ElevationProvider {
@@ -50,12 +79,46 @@ public:
     [[nodiscard]] virtual std::vector<ElevationQuery> GetElevations(
         const std::vector<coordinates::Geographic>& points) const = 0;
 
+    /// Query elevations for points spaced a given distance apart (batch operation)
+    /// Each tile is read from the coarsest level of its elevation pyramid
+    /// whose sample spacing does not exceed the query spacing, so distant
+    /// views read kilobytes of prefiltered data instead of full tiles.
+    /// The default implementation ignores the spacing.
+    /// @param points Vector of geographic coordinates to query
+    /// @param ground_resolution_meters Spacing between the query points in meters
+    /// @return Vector of query results (same order as input)
+    [[nodiscard]] virtual std::vector<ElevationQuery> GetElevations(
+        const std::vector<coordinates::Geographic>& points,
+        double ground_resolution_meters) const;
+
+    /// Sample elevations at a fixed spacing along a path of great-circle legs
+    /// The path is walked incrementally (GeodesicPathSampler) and sampled in
+    /// bounded chunks through the batch query at @p spacing_meters, so
+    /// points are grouped by tile and interpolated in SIMD batches.
+    /// @param path Path vertices
+    /// @param spacing_meters Distance between samples in meters
+    /// @return Profile with one float per sample, ready for upload
+    /// @throws std::invalid_argument if the spacing is not positive
+    [[nodiscard]] virtual ElevationProfile GetElevationProfile(
+        const std::vector<coordinates::Geographic>& path, double spacing_meters) const;
+
     /// Preload SRTM tiles for a geographic region
     /// Useful for prefetching data before querying
     /// @param bounds Geographic bounds to preload
     /// @return Number of tiles successfully loaded
     virtual size_t PreloadRegion(const coordinates::GeographicBounds& bounds) = 0;
 
+    /// Preload SRTM tiles for a geographic region in the background
+    /// Tiles load on the SRTM loader's workers nearest @p focus first, with
+    /// a bounded number in flight, so a later call or a cancel takes effect
+    /// within a few tiles. Destroying the provider cancels the preload.
+    /// @param bounds Geographic bounds to preload
+    /// @param focus Point loaded outward from (default: the region center)
+    /// @return Progress handle
+    [[nodiscard]] virtual std::shared_ptr<ElevationPreload> PreloadRegionAsync(
+        const coordinates::GeographicBounds& bounds,
+        const std::optional<coordinates::Geographic>& focus = std::nullopt) = 0;
+
     /// Check if elevation data is available for a point
     /// Does not load tiles, only checks cache
     /// @param latitude Latitude in degrees
@@ -74,6 +137,11 @@ public:
     /// Clear all cached elevation data
     virtual void ClearCache() = 0;
 
+    /// Set the memory the in-memory elevation cache may hold, evicting
+    /// least recently used tiles down to it (providers without one ignore it)
+    /// @param bytes Memory budget in bytes
+    virtual void SetMemoryCacheBudget(size_t bytes) { static_cast<void>(bytes); }
+
     /// Create elevation provider instance
     /// @param loader_config SRTM loader configuration
     /// @param cache_config Optional cache configuration
@@ -108,6 +176,13 @@ public:
     };
 }
 
+/// List the SRTM tiles covering a region, nearest @p focus first
+/// @param bounds Geographic bounds (invalid bounds yield no tiles)
+/// @param focus Point to order by (equirectangular distance to tile centers)
+/// @return Tile coordinates, clamped to the SRTM range
+[[nodiscard]] std::vector<SRTMCoordinates> GetRegionTiles(
+    const coordinates::GeographicBounds& bounds, const coordinates::Geographic& focus);
+
 /// Normalize longitude to range [-180, 180)
 [[nodiscard]] inline double NormalizeLongitude(double longitude) noexcept {
     while (longitude >= 180.0) {
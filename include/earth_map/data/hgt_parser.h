@@ -7,33 +7,72 @@
 
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace earth_map {
 
 /// HGT file parser for SRTM elevation data
-/// Parses big-endian signed 16-bit integer elevation data
+/// Parses big-endian signed 16-bit integer elevation data, and reads and
+/// writes the native-endian form used by the elevation disk cache
+/// Uses POSIX mmap for file input.
 class HGTParser {
 public:
     /// Parse SRTM data from memory buffer
+    /// Samples are byte-swapped 8 at a time (SSE2, NEON) straight into the tile
     /// @param data Raw HGT file data
     /// @param coordinates SRTM tile coordinates
     /// @return Parsed tile data, or nullptr on error
     [[nodiscard]] static std::unique_ptr<SRTMTileData> Parse(
-        const std::vector<uint8_t>& data,
+        std::span<const uint8_t> data,
+        const SRTMCoordinates& coordinates);
+
+    /// Parse SRTM data already in a sample buffer, without copying it
+    /// The samples are swapped to host order in place and the buffer
+    /// becomes the tile's storage (used for streamed downloads)
+    /// @param samples Samples as read from an HGT file (big-endian), as
+    ///        many as an SRTM1 or SRTM3 tile has
+    /// @param coordinates SRTM tile coordinates
+    /// @return Parsed tile data, or nullptr on error
+    [[nodiscard]] static std::unique_ptr<SRTMTileData> ParseInPlace(
+        std::vector<int16_t> samples,
         const SRTMCoordinates& coordinates);
 
     /// Parse SRTM data from disk file
+    /// The file is mapped and swapped from the mapping: one copy, no read buffer
     /// @param file_path Path to .hgt file
     /// @return Parsed tile data, or nullptr on error
     [[nodiscard]] static std::unique_ptr<SRTMTileData> ParseFile(
         const std::string& file_path);
 
+    /// Write a tile in the native-endian cache format
+    /// A 32-byte header (magic, byte-order mark, samples per side, flags,
+    /// coordinates, pyramid level) followed by the samples in host byte order. Written to a
+    /// temporary file and renamed, so tiles mapping an older version of the
+    /// file keep their data.
+    /// @param tile Tile to write
+    /// @param file_path Destination path
+    /// @return True on success
+    static bool WriteNativeFile(const SRTMTileData& tile, const std::string& file_path);
+
+    /// Map a native-endian cache file as a tile viewing the mapping
+    /// No copy and no parse: samples are paged in as they are read.
+    /// @param file_path Path written by WriteNativeFile()
+    /// @param coordinates Expected tile coordinates
+    /// @param level Expected pyramid level
+    /// @return Tile, or nullptr if the file is missing, malformed, for other
+    ///         coordinates or another level, or written on a host of the
+    ///         other byte order
+    [[nodiscard]] static std::unique_ptr<SRTMTileData> MapNativeFile(
+        const std::string& file_path,
+        const SRTMCoordinates& coordinates,
+        uint32_t level = 0);
+
     /// Validate HGT data format
     /// @param data Raw HGT file data
     /// @return True if data appears to be valid HGT format
-    [[nodiscard]] static bool Validate(const std::vector<uint8_t>& data) noexcept;
+    [[nodiscard]] static bool Validate(std::span<const uint8_t> data) noexcept;
 
     /// Detect SRTM resolution from file size
     /// @param file_size Size of HGT file in bytes
@@ -63,6 +102,12 @@ private:
     /// @return Elevation in meters
     [[nodiscard]] static int16_t ParseSample(const uint8_t* bytes) noexcept;
 
+    /// Convert big-endian samples to host order
+    /// @param bytes count * 2 bytes (big-endian)
+    /// @param samples Output: count samples
+    /// @return True if any sample is a void
+    static bool SwapSamples(const uint8_t* bytes, int16_t* samples, size_t count) noexcept;
+
     /// Fill voids in tile data using interpolation
     /// @param tile Tile to process (modified in place)
     static void FillVoids(SRTMTileData& tile);
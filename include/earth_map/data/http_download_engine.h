@@ -0,0 +1,189 @@
+#pragma once
+
+/**
+ * @file http_download_engine.h
+ * @brief Event-loop HTTP download engine shared by all tile requests
+ *
+ * Runs every transfer on a single curl_multi event loop instead of one
+ * blocking easy handle per worker thread. Connections are reused across
+ * requests and HTTP/2 streams are multiplexed per provider host, so hundreds
+ * of tiles can be in flight without spawning per-tile work.
+ */
+
+#include <earth_map/data/tile_loader.h>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Identifier assigned to a submitted HTTP request
+ *
+ * Zero is never assigned and can be used as "no request".
+ */
+using HttpRequestId = std::uint64_t;
+
+/**
+ * @brief Result of a single HTTP transfer
+ */
+struct HttpResponse {
+    /// Transfer finished and the server answered with a 2xx status
+    bool success = false;
+
+    /// True when the request was cancelled or the engine shut down
+    bool cancelled = false;
+
+    /// Server answered 304 Not Modified to a conditional request (empty body)
+    bool not_modified = false;
+
+    /// HTTP status code (0 for non-HTTP schemes such as file://)
+    std::uint32_t status_code = 0;
+
+    /// Response body
+    std::vector<std::uint8_t> body;
+
+    /// ETag response header, verbatim (empty if absent)
+    std::string etag;
+
+    /// Last-Modified response header, verbatim (empty if absent)
+    std::string last_modified;
+
+    /// Freshness lifetime from Cache-Control max-age (or no-cache) or Expires
+    std::optional<std::chrono::seconds> max_age;
+
+    /// Cache-Control: no-store; the response must not be cached
+    bool no_store = false;
+
+    /// Retry-After header (seconds or HTTP date, relative to now), if present
+    std::optional<std::chrono::seconds> retry_after;
+
+    /// Human readable error description (empty on success)
+    std::string error_message;
+
+    /// Time from transfer start to completion in milliseconds
+    std::uint64_t elapsed_ms = 0;
+};
+
+/**
+ * @brief Completion callback for HTTP requests
+ *
+ * Invoked on the engine's event-loop thread. Keep it short: every transfer
+ * shares that thread, so blocking here stalls all other downloads.
+ */
+using HttpCompletionCallback = std::function<void(HttpResponse&&)>;
+
+/**
+ * @brief HTTP request submitted to the download engine
+ */
+struct HttpRequest {
+    /// Absolute URL to fetch
+    std::string url;
+
+    /// Extra request headers (name, value)
+    std::vector<std::pair<std::string, std::string>> headers;
+
+    /// Earliest time the transfer may start (default: immediately)
+    std::chrono::steady_clock::time_point not_before{};
+
+    /// Fair-queuing flow, normally the provider name (requests of one flow share a queue)
+    std::string flow;
+
+    /// Share of start slots the flow gets relative to other flows with queued requests
+    std::uint32_t flow_weight = 1;
+
+    /// Called exactly once unless the request is cancelled first
+    HttpCompletionCallback on_complete;
+};
+
+/**
+ * @brief Multiplexed HTTP download engine
+ *
+ * Thread Safety:
+ * - Submit(), Cancel() and CancelAll() are safe from any thread
+ * - Completion callbacks run on the internal event-loop thread
+ *
+ * Connection limits come from TileLoaderConfig:
+ * - max_concurrent_downloads caps transfers in flight
+ * - max_requests_per_host and host_requests_per_second limit each host
+ *   (see RequestScheduler); 429 / 503 answers pause a host for Retry-After
+ * - max_connections_per_host / max_total_connections cap sockets
+ * - max_streams_per_connection caps HTTP/2 streams on one connection
+ *
+ * Queued requests start in weighted fair order across flows, so a slow or
+ * throttled provider does not hold back the others.
+ */
+class HttpDownloadEngine {
+public:
+    /**
+     * @brief Virtual destructor
+     *
+     * Stops the event loop. Outstanding requests complete with
+     * HttpResponse::cancelled set so that no waiter is left hanging.
+     */
+    virtual ~HttpDownloadEngine() = default;
+
+    /**
+     * @brief Queue a request for download
+     *
+     * @param request Request description (moved into the engine)
+     * @return HttpRequestId Identifier usable with Cancel()
+     */
+    virtual HttpRequestId Submit(HttpRequest request) = 0;
+
+    /**
+     * @brief Cancel a queued or running request
+     *
+     * The completion callback is not invoked for a cancelled request unless
+     * the transfer had already finished on the event loop.
+     *
+     * @param id Identifier returned by Submit()
+     * @return true if the request was still queued or running
+     */
+    virtual bool Cancel(HttpRequestId id) = 0;
+
+    /**
+     * @brief Cancel every queued and running request
+     */
+    virtual void CancelAll() = 0;
+
+    /**
+     * @brief Apply new connection and transfer settings
+     *
+     * Takes effect for transfers started after the call.
+     *
+     * @param config New loader configuration
+     */
+    virtual void SetConfiguration(const TileLoaderConfig& config) = 0;
+
+    /**
+     * @brief Get number of transfers currently running
+     */
+    virtual std::size_t GetActiveCount() const = 0;
+
+    /**
+     * @brief Get number of requests waiting to start
+     */
+    virtual std::size_t GetQueuedCount() const = 0;
+
+protected:
+    /**
+     * @brief Protected constructor
+     */
+    HttpDownloadEngine() = default;
+};
+
+/**
+ * @brief Factory function to create the curl_multi based download engine
+ *
+ * @param config Loader configuration providing connection limits and options
+ * @return std::unique_ptr<HttpDownloadEngine> New engine with its event loop running
+ */
+std::unique_ptr<HttpDownloadEngine> CreateHttpDownloadEngine(const TileLoaderConfig& config);
+
+} // namespace earth_map
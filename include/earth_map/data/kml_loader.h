@@ -0,0 +1,122 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "kml_stream_parser.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace earth_map {
+
+/// Options of a streaming KML/KMZ load
+struct KmlLoadOptions {
+    /// Placemarks handed over per batch
+    size_t batch_size = 4096;
+
+    /// Batches waiting to be taken before the reader blocks; with
+    /// batch_size this bounds the memory of a load, whatever the file size
+    size_t max_queued_batches = 4;
+
+    /// Bytes read (inflated, for KMZ) per parser step
+    size_t chunk_bytes = 256 * 1024;
+
+    /// A partial batch is handed over once it is this old, so the first
+    /// features show up before a whole batch has been parsed
+    std::chrono::milliseconds flush_interval{100};
+};
+
+/// Read a KML document chunk by chunk, without loading it whole
+///
+/// KMZ archives (detected by their zip signature, not the extension) are
+/// read through libzip straight from the archive: doc.kml, or else the
+/// first .kml entry, is inflated chunk by chunk without extracting it.
+/// @param path KML or KMZ file
+/// @param chunk_bytes Size of the chunks
+/// @param on_chunk Called with every chunk; returns false to stop reading
+/// @param error Set to why reading failed
+/// @param total_bytes If not null, set to the document size (inflated) once known
+/// @return False if the file could not be read (stopping is not a failure)
+bool ReadKmlDocument(const std::string& path, size_t chunk_bytes,
+                     const std::function<bool(std::span<const char>)>& on_chunk,
+                     std::string& error, size_t* total_bytes = nullptr);
+
+/// KML/KMZ file parsed on a background thread into batches of placemarks
+///
+/// The reader blocks while max_queued_batches batches wait, so a consumer
+/// taking batches once per frame paces the load instead of the load
+/// buffering the whole file.
+///
+/// Thread Safety: all methods may be called from any thread.
+class KmlLoadJob {
+public:
+    /// Start loading @p path on a background thread
+    explicit KmlLoadJob(std::string path, KmlLoadOptions options = {});
+
+    /// Cancel the load and join the reader
+    ~KmlLoadJob();
+
+    // Non-copyable, non-movable (owns the reader thread)
+    KmlLoadJob(const KmlLoadJob&) = delete;
+    KmlLoadJob& operator=(const KmlLoadJob&) = delete;
+
+    /// Take the oldest parsed batch without blocking
+    /// @return False if no batch is waiting
+    bool TakeBatch(std::vector<KmlPlacemark>& batch);
+
+    /// Check if the reader has finished and every batch was taken
+    [[nodiscard]] bool IsDone() const;
+
+    /// Stop reading; batches already queued can still be taken
+    void Cancel();
+
+    /// Get why the load failed (empty if it did not, or has not yet)
+    [[nodiscard]] std::string GetError() const;
+
+    /// Get the file path
+    [[nodiscard]] const std::string& GetPath() const noexcept { return path_; }
+
+    /// Get bytes parsed so far (inflated, for KMZ)
+    [[nodiscard]] size_t GetBytesRead() const noexcept { return bytes_read_.load(); }
+
+    /// Get the document size (inflated, for KMZ; 0 until known)
+    [[nodiscard]] size_t GetTotalBytes() const noexcept { return total_bytes_.load(); }
+
+    /// Get placemarks parsed so far
+    [[nodiscard]] size_t GetPlacemarkCount() const noexcept { return placemark_count_.load(); }
+
+private:
+    void Run();
+
+    /// Queue a batch, blocking while the queue is full
+    /// @return False if cancelled
+    bool Push(std::vector<KmlPlacemark>& batch);
+
+    const std::string path_;
+    const KmlLoadOptions options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable space_;
+    std::deque<std::vector<KmlPlacemark>> queue_;
+    std::string error_;
+    bool finished_ = false;
+    bool cancelled_ = false;
+
+    std::atomic<size_t> bytes_read_{0};
+    std::atomic<size_t> total_bytes_{0};
+    std::atomic<size_t> placemark_count_{0};
+
+    std::thread thread_;
+};
+
+} // namespace earth_map
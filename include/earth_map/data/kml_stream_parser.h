@@ -0,0 +1,108 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include <earth_map/coordinates/coordinate_spaces.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace earth_map {
+
+/// Geometry of a KML placemark
+enum class KmlGeometryType : uint8_t {
+    POINT,
+    LINE_STRING,
+    POLYGON  ///< Outer boundary only
+};
+
+/// Placemark read from a KML document
+struct KmlPlacemark {
+    std::string name;
+    std::string style_url;
+    KmlGeometryType geometry = KmlGeometryType::POINT;
+
+    /// Vertices (one for points); altitudes as written, 0 if omitted
+    std::vector<coordinates::Geographic> coordinates;
+};
+
+/// Incremental SAX-style reader for KML documents arriving in chunks
+///
+/// Only the markup straddling a chunk boundary and the text of the
+/// placemark being read are buffered, so memory does not grow with the
+/// document. Placemarks are reported as their closing tag is read. Of a
+/// MultiGeometry the first Point, LineString or Polygon is kept; features
+/// without coordinates are skipped. Namespace prefixes are ignored.
+///
+/// Not a validating parser: unknown elements are skipped and only
+/// mismatched or unbalanced tags fail. Not thread-safe.
+class KmlStreamParser {
+public:
+    using PlacemarkCallback = std::function<void(KmlPlacemark&&)>;
+
+    /// Create a parser reporting every placemark to @p on_placemark
+    explicit KmlStreamParser(PlacemarkCallback on_placemark);
+
+    /// Parse the next chunk of the document
+    /// @return False once the document is malformed; GetError() tells why
+    bool Write(std::span<const char> data);
+
+    /// Finish parsing
+    /// @return False if the document is malformed or truncated
+    bool Finish();
+
+    /// Get the error that stopped parsing (empty if none)
+    [[nodiscard]] const std::string& GetError() const noexcept { return error_; }
+
+    /// Get placemarks reported so far
+    [[nodiscard]] size_t GetPlacemarkCount() const noexcept { return placemark_count_; }
+
+    /// Get placemarks skipped for lack of coordinates
+    [[nodiscard]] size_t GetSkippedCount() const noexcept { return skipped_count_; }
+
+private:
+    /// Text content the parser is collecting
+    enum class Field : uint8_t { NONE, NAME, STYLE_URL, COORDINATES };
+
+    /// Handle one complete markup construct (between '<' and '>')
+    bool HandleMarkup(std::string_view markup);
+    bool OpenElement(std::string_view name);
+    bool CloseElement(std::string_view name);
+
+    /// Append character data, decoding entities
+    void AppendText(std::string_view text);
+    bool ParseCoordinates();
+
+    bool Fail(std::string error);
+
+    PlacemarkCallback on_placemark_;
+    std::string error_;
+    bool failed_ = false;
+
+    /// Unparsed bytes: an incomplete markup construct or entity
+    std::string pending_;
+
+    /// Local names of the open elements
+    std::vector<std::string> stack_;
+
+    /// Placemark being read (placemark_depth_ = its stack size, 0 if none)
+    KmlPlacemark current_;
+    size_t placemark_depth_ = 0;
+    size_t geometry_depth_ = 0;   ///< Stack size of the geometry being read
+    bool has_geometry_ = false;
+    bool in_inner_boundary_ = false;
+    Field field_ = Field::NONE;
+    size_t field_depth_ = 0;
+    std::string text_;
+
+    size_t placemark_count_ = 0;
+    size_t skipped_count_ = 0;
+};
+
+} // namespace earth_map
@@ -0,0 +1,109 @@
+#pragma once
+
+/**
+ * @file latency_histogram.h
+ * @brief Fixed-size log-bucketed latency histogram
+ *
+ * Records request latencies into geometrically growing buckets (about 19%
+ * apart, from 10 us to about four minutes), so percentiles are accurate to
+ * a bucket width at any scale while the histogram stays a small fixed-size
+ * value that is cheap to copy into statistics snapshots.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace earth_map {
+
+/**
+ * @brief Latency distribution of one host or one tile pipeline stage
+ *
+ * Thread Safety: not thread-safe; callers synchronize (the tile loader
+ * keeps its histograms under the statistics mutex).
+ */
+class LatencyHistogram {
+public:
+    /// Number of buckets; the last one also collects everything slower
+    static constexpr std::size_t kBucketCount = 99;
+
+    /**
+     * @brief Record one latency sample
+     *
+     * @param latency_ms Latency in milliseconds
+     */
+    void Record(double latency_ms);
+
+    /**
+     * @brief Get the latency below which a fraction of samples fall
+     *
+     * @param fraction Fraction in [0, 1], e.g. 0.95 for p95
+     * @return double Upper bound of the bucket holding that sample (ms),
+     *         0 if no samples were recorded
+     */
+    double GetPercentile(double fraction) const;
+
+    /**
+     * @brief Get number of samples
+     */
+    std::uint64_t GetCount() const { return count_; }
+
+    /**
+     * @brief Get mean latency in milliseconds (0 without samples)
+     */
+    double GetMean() const { return count_ > 0 ? sum_ms_ / static_cast<double>(count_) : 0.0; }
+
+    /**
+     * @brief Get the sum of all samples in milliseconds
+     */
+    double GetSum() const { return sum_ms_; }
+
+    /**
+     * @brief Get slowest recorded latency in milliseconds
+     */
+    double GetMax() const { return max_ms_; }
+
+    /**
+     * @brief Add another histogram's samples
+     */
+    void Merge(const LatencyHistogram& other);
+
+    /**
+     * @brief Forget all samples
+     */
+    void Reset();
+
+    /**
+     * @brief Get the number of samples in a bucket
+     */
+    std::uint64_t GetBucketCount(std::size_t bucket) const { return buckets_[bucket]; }
+
+    /**
+     * @brief Get the upper bound of a bucket in milliseconds
+     */
+    static double GetBucketUpperBound(std::size_t bucket);
+
+    /**
+     * @brief Get the bucket a latency falls into
+     */
+    static std::size_t GetBucket(double latency_ms);
+
+    /**
+     * @brief Build a histogram from bucket counts gathered elsewhere
+     *
+     * @param buckets Samples per bucket
+     * @param sum_ms Sum of all samples in milliseconds
+     * @param max_ms Slowest sample in milliseconds
+     */
+    static LatencyHistogram FromBuckets(const std::array<std::uint64_t, kBucketCount>& buckets,
+                                        double sum_ms, double max_ms);
+
+private:
+
+    std::array<std::uint64_t, kBucketCount> buckets_{};
+    std::uint64_t count_ = 0;
+    double sum_ms_ = 0.0;
+    double max_ms_ = 0.0;
+};
+
+} // namespace earth_map
@@ -0,0 +1,112 @@
+#pragma once
+
+/**
+ * @file mvt_tile.h
+ * @brief Mapbox Vector Tile (MVT 2.x) decoding
+ *
+ * Reads the protobuf encoding of a vector tile into layers of features with
+ * their geometry decoded from the command stream. Coordinates are scaled
+ * from the layer's extent to [0, 1] across the tile, x east and y south,
+ * like the tile's pixels. Geometry slightly outside that range is the
+ * tile's buffer.
+ *
+ * Tiles served gzip-encoded are inflated first when EARTH_MAP_WITH_ZLIB is
+ * enabled.
+ */
+
+#include <glm/vec2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Geometry type of a feature
+ */
+enum class MvtGeometryType : std::uint8_t {
+    UNKNOWN = 0,
+    POINT = 1,
+    LINESTRING = 2,
+    POLYGON = 3
+};
+
+/**
+ * @brief Attribute value (string, number or boolean)
+ */
+using MvtValue = std::variant<std::string, double, std::int64_t, std::uint64_t, bool>;
+
+/**
+ * @brief One feature of a layer
+ */
+struct MvtFeature {
+    std::uint64_t id = 0;                          ///< Feature id (0 if none)
+    MvtGeometryType type = MvtGeometryType::UNKNOWN;
+    std::vector<std::uint32_t> tags;               ///< Key/value index pairs into the layer
+
+    /**
+     * @brief Geometry parts in tile units
+     *
+     * POINT: one part holding every point. LINESTRING: one part per line.
+     * POLYGON: one part per ring, not repeating the first point; exterior
+     * rings have positive area (clockwise with y south), the rings after
+     * one up to the next exterior ring are its holes.
+     */
+    std::vector<std::vector<glm::vec2>> geometry;
+};
+
+/**
+ * @brief A named layer and its features
+ */
+struct MvtLayer {
+    std::string name;
+    std::uint32_t version = 1;
+    std::uint32_t extent = 4096;                   ///< Integer units across the tile
+    std::vector<std::string> keys;                 ///< Attribute keys
+    std::vector<MvtValue> values;                  ///< Attribute values
+    std::vector<MvtFeature> features;
+
+    /**
+     * @brief Look up a feature's attribute
+     *
+     * @return The value, or null if the feature has no such key
+     */
+    const MvtValue* GetProperty(const MvtFeature& feature, std::string_view key) const;
+};
+
+/**
+ * @brief Decoded vector tile
+ */
+struct MvtTile {
+    std::vector<MvtLayer> layers;
+
+    /**
+     * @brief Find a layer by name
+     *
+     * @return The layer, or null
+     */
+    const MvtLayer* FindLayer(std::string_view name) const;
+};
+
+/**
+ * @brief Decode a vector tile
+ *
+ * Unknown fields are skipped. Features with malformed geometry are
+ * dropped; a malformed protobuf fails the whole tile.
+ *
+ * @param data Tile bytes (protobuf, or gzip-encoded protobuf)
+ * @return The tile, or nullopt if the bytes are not a vector tile
+ */
+[[nodiscard]] std::optional<MvtTile> DecodeMvtTile(std::span<const std::uint8_t> data);
+
+/**
+ * @brief Signed area of a ring in tile units (positive for exterior rings)
+ */
+[[nodiscard]] double MvtRingArea(std::span<const glm::vec2> ring);
+
+} // namespace earth_map
@@ -0,0 +1,327 @@
+#pragma once
+
+/**
+ * @file packed_tile_store.h
+ * @brief Packed, memory-mapped disk store for cached tiles
+ *
+ * Alternative disk backend of BasicTileCache. Instead of two small files per
+ * tile, tiles and their metadata are appended as records to large segment
+ * files. A hash index maps tile coordinates to record locations; it is
+ * rebuilt on Open() by scanning the segments, so no separate index file can
+ * go out of sync. Segments are read through mmap and Get() returns a
+ * zero-copy view that keeps its segment mapped.
+ *
+ * Overwrites and removals only append (removals as tombstone records, and
+ * metadata updates as metadata-only records that supersede the metadata of
+ * the tile's record). A background thread compacts sealed segments whose
+ * dead fraction passes a threshold by re-appending their live records and
+ * deleting the segment. EvictToFit() enforces a disk budget by dropping
+ * whole segments, oldest first.
+ *
+ * In shared mode several processes open the same directory. The segments
+ * form one log: writers append under an exclusive flock() of store.lock, and
+ * publish the end of the log in a small header mapped from store.shm. Every
+ * process keeps its own index and, before each operation, replays the
+ * records other processes appended since the head it last saw, so a tile one
+ * process just downloaded is served from disk by the others. The head only
+ * moves past complete records, and a writer that dies releases its flock,
+ * so a crash never leaves the shared state half-updated.
+ *
+ * Uses POSIX file and mmap APIs.
+ */
+
+#include <earth_map/data/tile_buffer.h>
+#include <earth_map/data/tile_cache.h>
+#include <earth_map/math/tile_mathematics.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Packed tile store configuration
+ */
+struct PackedTileStoreConfig {
+    /** Directory holding the segment files */
+    std::string directory = "./tile_cache/packed";
+
+    /** Capacity of one segment file in bytes */
+    std::size_t segment_size = 64 * 1024 * 1024;  // 64MB
+
+    /** Dead fraction at which a sealed segment is compacted */
+    double compaction_threshold = 0.5;
+
+    /** Interval between background compaction passes */
+    std::chrono::milliseconds compaction_interval{5000};
+
+    /** Run compaction on a background thread */
+    bool background_compaction = true;
+
+    /** Share the directory with other processes (see file comment) */
+    bool shared = false;
+};
+
+/**
+ * @brief Packed tile store statistics
+ */
+struct PackedTileStoreStats {
+    std::size_t tile_count = 0;
+    std::size_t segment_count = 0;
+    std::size_t live_bytes = 0;     ///< Bytes of records still referenced
+    std::size_t dead_bytes = 0;     ///< Bytes of overwritten / removed records
+    std::size_t compacted_segments = 0;
+};
+
+/**
+ * @brief Zero-copy view of a stored tile
+ *
+ * Data() points into the mapped segment; the view keeps the mapping alive,
+ * even if the segment is compacted away meanwhile.
+ */
+class PackedTileView {
+public:
+    PackedTileView() = default;
+
+    /** @brief Raw tile bytes */
+    std::span<const std::uint8_t> Data() const { return data_; }
+
+    /** @brief Tile bytes as a shared buffer that keeps the segment mapped */
+    TileBuffer Buffer() const { return TileBuffer::Wrap(mapping_, data_); }
+
+    /** @brief Tile metadata stored with the record */
+    const TileMetadata& Metadata() const { return metadata_; }
+
+private:
+    friend class PackedTileStore;
+
+    PackedTileView(std::shared_ptr<const void> mapping,
+                   std::span<const std::uint8_t> data,
+                   TileMetadata metadata)
+        : mapping_(std::move(mapping))
+        , data_(data)
+        , metadata_(std::move(metadata)) {}
+
+    std::shared_ptr<const void> mapping_;
+    std::span<const std::uint8_t> data_;
+    TileMetadata metadata_;
+};
+
+/**
+ * @brief Append-only segment store with hash index and mmap reads
+ *
+ * Thread Safety: All methods are thread-safe. Lookups share a reader lock;
+ * appends are serialised.
+ */
+class PackedTileStore {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param config Store configuration
+     */
+    explicit PackedTileStore(const PackedTileStoreConfig& config);
+
+    /**
+     * @brief Destructor (stops compaction, unmaps segments)
+     */
+    ~PackedTileStore();
+
+    // Non-copyable
+    PackedTileStore(const PackedTileStore&) = delete;
+    PackedTileStore& operator=(const PackedTileStore&) = delete;
+
+    // Non-movable
+    PackedTileStore(PackedTileStore&&) = delete;
+    PackedTileStore& operator=(PackedTileStore&&) = delete;
+
+    /**
+     * @brief Open the directory, map segments and rebuild the index
+     *
+     * A torn record at the end of the newest segment (crash during append)
+     * ends the scan; everything before it is recovered.
+     *
+     * @return true on success
+     */
+    bool Open();
+
+    /**
+     * @brief Stop compaction and unmap all segments
+     */
+    void Close();
+
+    /**
+     * @brief Append (or overwrite) a tile
+     *
+     * @param metadata Tile metadata (keyed by metadata.coordinates)
+     * @param data Raw tile bytes
+     * @return true if the record was written
+     */
+    bool Put(const TileMetadata& metadata, std::span<const std::uint8_t> data);
+
+    /**
+     * @brief Append several tiles under a single lock acquisition
+     *
+     * Records are written back to back into the active segment.
+     *
+     * @return Number of records written
+     */
+    std::size_t PutBatch(const std::vector<std::shared_ptr<const TileData>>& tiles);
+
+    /**
+     * @brief Look up a tile
+     *
+     * @return Zero-copy view, or nullopt if not stored
+     */
+    std::optional<PackedTileView> Get(const TileCoordinates& coords) const;
+
+    /**
+     * @brief Look up only the metadata of a tile
+     */
+    std::optional<TileMetadata> GetMetadata(const TileCoordinates& coords) const;
+
+    /**
+     * @brief Replace the metadata of a stored tile
+     *
+     * Appends a metadata-only record under the writer lock; the payload is
+     * not rewritten. The stored compression is kept, since it describes the
+     * payload rather than the tile.
+     *
+     * @return false if the tile is not stored
+     */
+    bool UpdateMetadata(const TileMetadata& metadata);
+
+    /**
+     * @brief Check if a tile is stored
+     */
+    bool Contains(const TileCoordinates& coords) const;
+
+    /**
+     * @brief Remove a tile (appends a tombstone)
+     *
+     * @return true if the tile was stored
+     */
+    bool Remove(const TileCoordinates& coords);
+
+    /**
+     * @brief Delete every segment
+     */
+    void Clear();
+
+    /**
+     * @brief Get the coordinates of every stored tile
+     */
+    std::vector<TileCoordinates> GetKeys() const;
+
+    /**
+     * @brief Drop the oldest tiles until the segments fit a disk budget
+     *
+     * Eviction follows write order, the natural order of the log: the
+     * oldest sealed segment is dropped whole, after a tombstone for each of
+     * its live tiles (so other processes of a shared store forget them
+     * too), and nothing is copied. The active segment is never dropped, so
+     * the budget should span several segments.
+     *
+     * @param max_bytes Disk budget (see GetDiskUsage())
+     * @return Number of tiles evicted
+     */
+    std::size_t EvictToFit(std::size_t max_bytes);
+
+    /**
+     * @brief Compact eligible sealed segments now
+     *
+     * @return Number of segments reclaimed
+     */
+    std::size_t Compact();
+
+    /**
+     * @brief Get store statistics
+     */
+    PackedTileStoreStats GetStats() const;
+
+    /**
+     * @brief Get bytes used on disk by the segments
+     */
+    std::size_t GetDiskUsage() const;
+
+private:
+    struct Segment;
+    struct SharedHeader;
+    class WriterGuard;
+
+    struct Location {
+        std::shared_ptr<Segment> segment;
+        std::size_t offset = 0;
+        std::size_t size = 0;  ///< Whole record including header and padding
+
+        /// Metadata-only record superseding the record's own metadata (null if none)
+        std::shared_ptr<Segment> metadata_segment;
+        std::size_t metadata_offset = 0;
+        std::size_t metadata_size = 0;
+    };
+
+    std::string SegmentPath(std::uint32_t id) const;
+    std::vector<std::uint32_t> ListSegmentIds() const;
+    std::shared_ptr<Segment> MapSegmentFileLocked(std::uint32_t id) const;
+    std::size_t ReplayLocked(Segment& segment, std::size_t offset, std::size_t limit,
+                             std::size_t* records) const;
+    bool OpenShared();
+    void CloseShared();
+    void CatchUp() const;
+    void CatchUpLocked() const;
+    void PublishLocked();
+    std::shared_ptr<Segment> CreateSegmentLocked(std::size_t capacity);
+    void SealActiveLocked();
+    bool AppendLocked(const TileCoordinates& coords, std::uint16_t flags,
+                      std::span<const std::uint8_t> metadata_bytes,
+                      std::span<const std::uint8_t> data,
+                      Location* location);
+    void ReplaceLocked(const TileCoordinates& coords, const Location& location) const;
+    bool SetMetadataLocked(const TileCoordinates& coords, const Location& record) const;
+    static std::span<const std::uint8_t> MetadataBytes(const Location& location);
+    bool CompactSegment(const std::shared_ptr<Segment>& segment);
+    bool HasOlderSegmentLocked(std::uint32_t id) const;
+    std::size_t DiskUsageLocked() const;
+    void CompactionLoop();
+    void CloseLocked();
+
+    PackedTileStoreConfig config_;
+
+    // Mutable: in shared mode, const lookups first replay other processes' appends
+    mutable std::shared_mutex mutex_;
+    mutable std::unordered_map<TileCoordinates, Location, TileCoordinatesHash> index_;
+    mutable std::map<std::uint32_t, std::shared_ptr<Segment>> segments_;  ///< Oldest first
+    mutable std::shared_ptr<Segment> active_;
+    mutable std::uint32_t next_segment_id_ = 0;
+    bool open_ = false;
+
+    // Shared mode (lock_fd_ < 0 and shared_ null otherwise)
+    int lock_fd_ = -1;                  ///< store.lock, flock()ed by writers
+    SharedHeader* shared_ = nullptr;    ///< Mapped store.shm
+    std::mutex writer_mutex_;           ///< Writers of this process (the flock is per process)
+    mutable std::atomic<std::uint64_t> replayed_head_{0};    ///< Log head the index reflects
+    mutable std::atomic<std::uint64_t> seen_generation_{0};  ///< Clear() count the index reflects
+
+    /// Serialises compaction passes (background and explicit)
+    std::mutex compaction_mutex_;
+    std::atomic<std::size_t> compacted_segments_{0};
+
+    std::thread compaction_thread_;
+    std::mutex stop_mutex_;
+    std::condition_variable stop_cv_;
+    bool stop_ = false;
+};
+
+} // namespace earth_map
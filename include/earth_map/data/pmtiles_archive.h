@@ -0,0 +1,238 @@
+#pragma once
+
+/**
+ * @file pmtiles_archive.h
+ * @brief Read-only PMTiles v3 archive and offline tile provider
+ *
+ * PMTiles is a single-file tile archive addressed by Hilbert-curve tile ids.
+ * The whole file is memory-mapped; directory lookups and tile reads are
+ * plain memory accesses and tile bytes are returned as zero-copy spans. In
+ * clustered archives tile data is stored in tile id order, so the tiles of a
+ * viewport sit close together and Prefetch() turns them into a few
+ * sequential read-ahead ranges.
+ *
+ * Directories must be uncompressed unless the library is built with
+ * EARTH_MAP_WITH_ZLIB, which adds gzip support. Uses POSIX mmap.
+ */
+
+#include <earth_map/data/tile_loader.h>
+#include <earth_map/math/tile_mathematics.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Fixed-size PMTiles v3 header fields
+ */
+struct PMTilesHeader {
+    /** Compression of directories, metadata and tiles */
+    enum class Compression : std::uint8_t {
+        UNKNOWN = 0,
+        NONE = 1,
+        GZIP = 2,
+        BROTLI = 3,
+        ZSTD = 4
+    };
+
+    /** Tile payload format */
+    enum class TileType : std::uint8_t {
+        UNKNOWN = 0,
+        MVT = 1,
+        PNG = 2,
+        JPEG = 3,
+        WEBP = 4,
+        AVIF = 5
+    };
+
+    std::uint64_t root_dir_offset = 0;
+    std::uint64_t root_dir_length = 0;
+    std::uint64_t metadata_offset = 0;
+    std::uint64_t metadata_length = 0;
+    std::uint64_t leaf_dirs_offset = 0;
+    std::uint64_t leaf_dirs_length = 0;
+    std::uint64_t tile_data_offset = 0;
+    std::uint64_t tile_data_length = 0;
+    std::uint64_t addressed_tiles = 0;
+    bool clustered = false;
+    Compression internal_compression = Compression::UNKNOWN;
+    Compression tile_compression = Compression::UNKNOWN;
+    TileType tile_type = TileType::UNKNOWN;
+    std::uint8_t min_zoom = 0;
+    std::uint8_t max_zoom = 0;
+};
+
+/**
+ * @brief Memory-mapped read-only PMTiles v3 archive
+ *
+ * Thread Safety: All methods are thread-safe after Open().
+ */
+class PMTilesArchive {
+public:
+    /// Size of the fixed v3 header
+    static constexpr std::size_t kHeaderSize = 127;
+
+    /**
+     * @brief Constructor
+     *
+     * @param path Path of the .pmtiles file
+     */
+    explicit PMTilesArchive(const std::string& path);
+
+    /**
+     * @brief Destructor (unmaps the file)
+     */
+    ~PMTilesArchive();
+
+    // Non-copyable
+    PMTilesArchive(const PMTilesArchive&) = delete;
+    PMTilesArchive& operator=(const PMTilesArchive&) = delete;
+
+    /**
+     * @brief Map the file and validate the header and root directory
+     *
+     * @return true on success
+     */
+    bool Open();
+
+    /**
+     * @brief Get tile bytes as a view into the mapping
+     *
+     * Valid while the archive is alive. Bytes are still compressed with
+     * GetHeader().tile_compression.
+     *
+     * @return Tile bytes, or nullopt if the archive has no such tile
+     */
+    std::optional<std::span<const std::uint8_t>> GetTile(const TileCoordinates& coords) const;
+
+    /**
+     * @brief Decompress tile bytes stored with GetHeader().tile_compression
+     *
+     * @return Raw tile bytes, or nullopt on corrupt input or unsupported codec
+     */
+    std::optional<std::vector<std::uint8_t>> DecompressTile(
+        std::span<const std::uint8_t> bytes) const;
+
+    /**
+     * @brief Check if the archive has a tile
+     */
+    bool Contains(const TileCoordinates& coords) const;
+
+    /**
+     * @brief Hint the OS to read the given tiles ahead
+     *
+     * Tile ranges are sorted by offset and merged when they are near each
+     * other, so a clustered viewport becomes a few sequential reads.
+     *
+     * @return Number of read-ahead ranges issued
+     */
+    std::size_t Prefetch(const std::vector<TileCoordinates>& coords) const;
+
+    /** @brief Get the parsed header */
+    const PMTilesHeader& GetHeader() const { return header_; }
+
+    /** @brief Get the JSON metadata blob (uncompressed archives only) */
+    std::string GetMetadataJson() const;
+
+    /** @brief Get the archive path */
+    const std::string& GetPath() const { return path_; }
+
+    /**
+     * @brief Convert tile coordinates to a PMTiles (Hilbert) tile id
+     */
+    static std::uint64_t TileId(const TileCoordinates& coords);
+
+private:
+    struct DirectoryEntry {
+        std::uint64_t tile_id = 0;
+        std::uint64_t offset = 0;
+        std::uint32_t length = 0;
+        std::uint32_t run_length = 0;  ///< 0: entry points to a leaf directory
+    };
+
+    using Directory = std::vector<DirectoryEntry>;
+
+    struct TileRange {
+        std::uint64_t offset;
+        std::uint64_t length;
+    };
+
+    std::optional<TileRange> FindTile(std::uint64_t tile_id) const;
+    std::shared_ptr<const Directory> LoadDirectory(std::uint64_t offset,
+                                                   std::uint64_t length) const;
+    std::optional<std::vector<std::uint8_t>> Decompress(std::span<const std::uint8_t> bytes,
+                                                        PMTilesHeader::Compression type) const;
+    bool ParseHeader();
+
+    std::string path_;
+    int fd_ = -1;
+    const std::uint8_t* data_ = nullptr;
+    std::size_t size_ = 0;
+
+    PMTilesHeader header_;
+    std::shared_ptr<const Directory> root_;
+
+    /// Decoded leaf directories keyed by file offset
+    mutable std::mutex leaf_mutex_;
+    mutable std::unordered_map<std::uint64_t, std::shared_ptr<const Directory>> leaves_;
+};
+
+/**
+ * @brief Tile provider serving tiles from a local PMTiles archive
+ *
+ * Tiles are read from the archive by the loader without any HTTP request.
+ */
+class PMTilesTileProvider : public TileProvider {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param name Provider name
+     * @param archive Opened archive (must not be null)
+     * @throws std::invalid_argument if archive is null
+     */
+    PMTilesTileProvider(const std::string& name, std::shared_ptr<PMTilesArchive> archive);
+
+    std::string BuildTileURL(const TileCoordinates& coords) const override;
+    std::string GetName() const override { return name_; }
+    std::int32_t GetMinZoom() const override;
+    std::int32_t GetMaxZoom() const override;
+    std::string GetFormat() const override;
+    std::uint32_t GetMaxRetries() const override { return 0; }
+
+    bool IsLocal() const override { return true; }
+
+    /**
+     * @brief Read a tile, decompressed per the archive's tile compression
+     *
+     * Uncompressed tiles are returned as views into the mapping, which stay
+     * valid (and keep the archive alive) for as long as the buffer exists.
+     */
+    std::optional<TileBuffer> ReadTile(const TileCoordinates& coords) const override;
+
+    /** @brief Get the underlying archive */
+    const std::shared_ptr<PMTilesArchive>& GetArchive() const { return archive_; }
+
+private:
+    std::string name_;
+    std::shared_ptr<PMTilesArchive> archive_;
+};
+
+/**
+ * @brief Open a PMTiles archive and wrap it in a tile provider
+ *
+ * @param path Path of the .pmtiles file
+ * @param name Provider name (defaults to the file stem)
+ * @return Provider, or nullptr if the archive cannot be opened
+ */
+std::shared_ptr<PMTilesTileProvider> CreatePMTilesTileProvider(const std::string& path,
+                                                               const std::string& name = "");
+
+} // namespace earth_map
@@ -0,0 +1,108 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "elevation_provider.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace earth_map {
+
+/// Region preload shared by the elevation providers: tiles are issued
+/// nearest-first, a window at a time, as earlier loads complete
+/// @tparam Tile Tile key of the provider (SRTM cell or XYZ tile)
+template <typename Tile>
+class RegionPreloadJob : public ElevationPreload {
+public:
+    explicit RegionPreloadJob(std::vector<Tile> tiles)
+        : tiles_(std::move(tiles)) {}
+
+    size_t GetTotalTiles() const override { return tiles_.size(); }
+
+    size_t GetCompletedTiles() const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return completed_;
+    }
+
+    size_t GetLoadedTiles() const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return loaded_;
+    }
+
+    bool IsDone() const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return IsDoneLocked();
+    }
+
+    size_t Wait() override {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return IsDoneLocked(); });
+        return loaded_;
+    }
+
+    void Cancel() override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cancelled_ = true;
+        done_.notify_all();
+    }
+
+    /// Reserve the next tiles to issue, up to @p window in flight
+    std::vector<Tile> TakeNext(size_t window) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<Tile> batch;
+        while (!cancelled_ && in_flight_ < window && next_ < tiles_.size()) {
+            batch.push_back(tiles_[next_++]);
+            ++in_flight_;
+        }
+        return batch;
+    }
+
+    /// Record a finished tile and reserve the tiles to issue in its place
+    /// In one step, so the job is never idle while it has tiles left and
+    /// the last one wakes the waiters only once nothing else will be issued
+    /// @return Tiles to issue (empty: the caller must not touch the provider)
+    std::vector<Tile> FinishAndTakeNext(bool loaded, size_t window) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --in_flight_;
+        ++completed_;
+        if (loaded) {
+            ++loaded_;
+        }
+        std::vector<Tile> batch;
+        while (!cancelled_ && in_flight_ < window && next_ < tiles_.size()) {
+            batch.push_back(tiles_[next_++]);
+            ++in_flight_;
+        }
+        if (IsDoneLocked()) {
+            done_.notify_all();
+        }
+        return batch;
+    }
+
+    /// Block until no load is in flight (after Cancel(): until it is done)
+    void WaitIdle() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return in_flight_ == 0; });
+    }
+
+private:
+    bool IsDoneLocked() const {
+        return in_flight_ == 0 && (cancelled_ || next_ == tiles_.size());
+    }
+
+    const std::vector<Tile> tiles_;
+    mutable std::mutex mutex_;
+    std::condition_variable done_;
+    size_t next_ = 0;
+    size_t in_flight_ = 0;
+    size_t completed_ = 0;
+    size_t loaded_ = 0;
+    bool cancelled_ = false;
+};
+
+} // namespace earth_map
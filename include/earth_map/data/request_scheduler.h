@@ -0,0 +1,185 @@
+#pragma once
+
+/**
+ * @file request_scheduler.h
+ * @brief Per-host limits and weighted fair queuing for HTTP requests
+ *
+ * The download engine used to start requests in plain FIFO order, so one
+ * slow or rate-limited provider at the front of the queue could hold back
+ * every other layer. The scheduler keeps one queue per flow (normally a
+ * tile provider) and picks between flows by weighted fair queuing (stride
+ * scheduling on a virtual clock). Within a flow, requests are grouped by
+ * host: a host that has reached its concurrency cap, run out of rate-limit
+ * tokens or asked the client to back off (429 / Retry-After) is skipped
+ * without blocking requests to other hosts, including other subdomain
+ * shards of the same provider.
+ */
+
+#include <earth_map/data/http_download_engine.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Scheduler limits (applied per host)
+ */
+struct RequestSchedulerConfig {
+    /** Requests in flight per host (0 = unlimited) */
+    std::size_t max_requests_per_host = 32;
+
+    /** Request starts per second per host (0 = unlimited) */
+    double requests_per_second = 0.0;
+
+    /** Token bucket capacity: starts allowed back to back */
+    std::size_t burst = 8;
+
+    /** Back-off after 429 / 503 answers without a Retry-After header */
+    std::chrono::milliseconds throttle_delay{1000};
+};
+
+/**
+ * @brief Chooses which queued request starts next
+ *
+ * Requests whose URL has no host (e.g. file://) are not limited.
+ *
+ * Thread Safety: not thread-safe; the download engine serializes access
+ * under its state mutex.
+ */
+class RequestScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Request handed out by PopNext()
+    struct Entry {
+        HttpRequestId id = 0;
+        std::string host;
+        HttpRequest request;
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param config Per-host limits
+     */
+    explicit RequestScheduler(const RequestSchedulerConfig& config = RequestSchedulerConfig{});
+
+    /**
+     * @brief Apply new limits (queued requests and host states are kept)
+     */
+    void SetConfig(const RequestSchedulerConfig& config);
+
+    /**
+     * @brief Get current limits
+     */
+    const RequestSchedulerConfig& GetConfig() const { return config_; }
+
+    /**
+     * @brief Queue a request that may start now
+     *
+     * @param id Request identifier
+     * @param request Request (flow and flow_weight select its queue)
+     */
+    void Push(HttpRequestId id, HttpRequest request);
+
+    /**
+     * @brief Take the next request that may start
+     *
+     * The request counts against its host's limits until Release().
+     *
+     * @param now Current time
+     * @return std::optional<Entry> Request to start, nullopt if none is eligible
+     */
+    std::optional<Entry> PopNext(Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Report that a request handed out by PopNext() has finished
+     *
+     * @param host Entry::host of the finished request
+     */
+    void Release(const std::string& host);
+
+    /**
+     * @brief Hold back new requests to a host until a point in time
+     *
+     * Used for 429 / 503 answers; Retry-After gives the time when known.
+     */
+    void ThrottleHost(const std::string& host, Clock::time_point until);
+
+    /**
+     * @brief Remove a queued request
+     *
+     * @return true if the request was queued
+     */
+    bool Remove(HttpRequestId id);
+
+    /**
+     * @brief Remove every queued request
+     *
+     * @return std::vector<HttpRequest> Removed requests (e.g. to resolve their callbacks)
+     */
+    std::vector<HttpRequest> Clear();
+
+    /**
+     * @brief Get number of queued requests
+     */
+    std::size_t GetQueuedCount() const { return queued_count_; }
+
+    /**
+     * @brief Get number of requests in flight to a host
+     */
+    std::size_t GetActiveCount(const std::string& host) const;
+
+    /**
+     * @brief Earliest time a queued request becomes eligible by time alone
+     *
+     * Hosts at their concurrency cap only become eligible when a request
+     * finishes, and are not considered.
+     *
+     * @param now Current time
+     * @return std::optional<Clock::time_point> now or later, nullopt if no
+     *         queued request can become eligible without a Release()
+     */
+    std::optional<Clock::time_point> GetNextEligibleTime(Clock::time_point now = Clock::now());
+
+private:
+    struct QueuedRequest {
+        HttpRequestId id = 0;
+        std::uint64_t sequence = 0;
+        HttpRequest request;
+    };
+
+    struct HostState {
+        std::size_t active = 0;
+        double tokens = 0.0;
+        Clock::time_point last_refill{};
+        Clock::time_point blocked_until{};
+    };
+
+    struct Flow {
+        std::uint32_t weight = 1;
+        double pass = 0.0;  ///< Virtual time of the flow's next pick
+        std::size_t queued = 0;
+        std::map<std::string, std::deque<QueuedRequest>> hosts;
+    };
+
+    HostState& GetHost(const std::string& host, Clock::time_point now);
+    void Refill(HostState& state, Clock::time_point now) const;
+    bool IsEligible(const std::string& host, Clock::time_point now);
+
+    RequestSchedulerConfig config_;
+    std::unordered_map<std::string, Flow> flows_;
+    std::unordered_map<std::string, HostState> host_states_;
+    double virtual_time_ = 0.0;
+    std::uint64_t next_sequence_ = 0;
+    std::size_t queued_count_ = 0;
+};
+
+} // namespace earth_map
@@ -0,0 +1,162 @@
+#pragma once
+
+/**
+ * @file retry_policy.h
+ * @brief Retry backoff and per-host circuit breaking for tile downloads
+ *
+ * Failed downloads are rescheduled on the download engine's timer queue
+ * (HttpRequest::not_before) rather than sleeping on a thread. The delay grows
+ * exponentially with the attempt number and is jittered so that tiles which
+ * failed together do not retry together. A host that keeps failing trips its
+ * circuit breaker: requests to it fail fast for a cooldown period, then a
+ * single probe decides whether the host is healthy again. Other hosts are
+ * not affected.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace earth_map {
+
+/**
+ * @brief Exponential backoff with jitter
+ */
+struct RetryBackoff {
+    /** Delay before the first retry */
+    std::chrono::milliseconds base_delay{1000};
+
+    /** Upper bound for any delay */
+    std::chrono::milliseconds max_delay{30000};
+
+    /** Fraction of the delay that is randomized (0 = none, 1 = full jitter) */
+    float jitter = 0.5f;
+
+    /**
+     * @brief Delay before a retry
+     *
+     * The un-jittered delay is base_delay * 2^attempt, capped at max_delay;
+     * jitter then shortens it by up to jitter * delay.
+     *
+     * @param attempt Retry number, starting at 0
+     * @param random Uniform random value in [0, 1)
+     * @return std::chrono::milliseconds Delay before the retry starts
+     */
+    std::chrono::milliseconds GetDelay(std::uint32_t attempt, double random) const;
+};
+
+/**
+ * @brief Circuit breaker configuration
+ */
+struct CircuitBreakerConfig {
+    /** Consecutive failures that open a host's circuit (0 = never open) */
+    std::uint32_t failure_threshold = 5;
+
+    /** Time an open circuit rejects requests before a probe is allowed */
+    std::chrono::milliseconds cooldown{30000};
+};
+
+/**
+ * @brief Per-host circuit breaker
+ *
+ * Each host is CLOSED (requests pass), OPEN (requests are rejected until the
+ * cooldown ends) or HALF_OPEN (one probe request is in flight; others are
+ * rejected until it finishes). A successful probe closes the circuit, a
+ * failed one opens it again.
+ *
+ * Only failures that say something about the host's health should be
+ * recorded (transport errors, 5xx, 429); a 404 is a healthy answer.
+ *
+ * Thread Safety: all methods are thread-safe.
+ */
+class HostCircuitBreaker {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// Circuit state of one host
+    enum class State {
+        CLOSED,
+        OPEN,
+        HALF_OPEN
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param config Breaker configuration
+     */
+    explicit HostCircuitBreaker(const CircuitBreakerConfig& config = CircuitBreakerConfig{});
+
+    // Non-copyable
+    HostCircuitBreaker(const HostCircuitBreaker&) = delete;
+    HostCircuitBreaker& operator=(const HostCircuitBreaker&) = delete;
+
+    /**
+     * @brief Check whether a request to a host may start
+     *
+     * Moves an OPEN host whose cooldown has ended to HALF_OPEN and grants
+     * the caller the probe. Requests with an empty host always pass.
+     *
+     * @param host Host name (see HostFromUrl)
+     * @param now Current time
+     * @return true if the request may start; it must then report its outcome
+     */
+    bool AllowRequest(const std::string& host, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Record a healthy response from a host (closes its circuit)
+     */
+    void RecordSuccess(const std::string& host);
+
+    /**
+     * @brief Record a failure that indicates an unhealthy host
+     */
+    void RecordFailure(const std::string& host, Clock::time_point now = Clock::now());
+
+    /**
+     * @brief Record a request that ended without an answer (e.g. cancelled)
+     *
+     * Releases the probe slot of a HALF_OPEN host without changing its state.
+     */
+    void RecordAbandoned(const std::string& host);
+
+    /**
+     * @brief Get the state of a host (CLOSED for unknown hosts)
+     */
+    State GetState(const std::string& host, Clock::time_point now = Clock::now()) const;
+
+    /**
+     * @brief Apply a new configuration (existing host states are kept)
+     */
+    void SetConfig(const CircuitBreakerConfig& config);
+
+    /**
+     * @brief Forget all host states
+     */
+    void Reset();
+
+    /**
+     * @brief Extract the host (and port) from a URL
+     *
+     * @return std::string "host[:port]", empty for URLs without an authority
+     *         such as file:///path
+     */
+    static std::string HostFromUrl(const std::string& url);
+
+private:
+    struct HostState {
+        State state = State::CLOSED;
+        std::uint32_t consecutive_failures = 0;
+        Clock::time_point open_until{};
+        bool probe_in_flight = false;
+    };
+
+    mutable std::mutex mutex_;
+    CircuitBreakerConfig config_;
+    std::unordered_map<std::string, HostState> hosts_;
+};
+
+} // namespace earth_map
@@ -0,0 +1,179 @@
+#pragma once
+
+/**
+ * @file single_flight.h
+ * @brief In-flight request coalescing ("single flight") keyed by request
+ *
+ * The first caller for a key becomes the leader and performs the work; every
+ * caller that arrives while it is in flight joins the same call and receives
+ * the same shared_future (and optionally a completion listener) instead of
+ * starting a duplicate download or decode. Once the leader completes the
+ * call the key is forgotten, so later callers start a fresh one (by then the
+ * result is normally in a cache).
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Coalesces concurrent calls for the same key into one
+ *
+ * Thread Safety: all methods are thread-safe. Listeners and the shared
+ * future are resolved on the thread that calls Complete(), without the
+ * internal lock held.
+ *
+ * @tparam Key Request key (e.g. provider and tile coordinates)
+ * @tparam Value Result shared by every caller
+ * @tparam Hash Hash functor for Key
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class SingleFlight {
+public:
+    /// Invoked with the result before the shared future becomes ready
+    using Listener = std::function<void(const Value&)>;
+
+    /**
+     * @brief Handle returned by Join()
+     */
+    struct Call {
+        /// Resolves to the leader's result
+        std::shared_future<Value> future;
+
+        /// True if this caller must perform the work and call Complete()
+        bool leader = false;
+
+        /// Identifies the call for Complete() (a key may be reused later)
+        std::uint64_t id = 0;
+    };
+
+    SingleFlight() = default;
+
+    // Non-copyable
+    SingleFlight(const SingleFlight&) = delete;
+    SingleFlight& operator=(const SingleFlight&) = delete;
+
+    /**
+     * @brief Join the call in flight for a key, or start one as its leader
+     *
+     * @param key Request key
+     * @param listener Optional completion listener for this caller
+     * @return Call Shared future, leader flag and call id
+     */
+    Call Join(const Key& key, Listener listener = nullptr) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = calls_.find(key);
+        if (it != calls_.end()) {
+            ++coalesced_;
+            if (listener) {
+                it->second.listeners.push_back(std::move(listener));
+            }
+            return Call{it->second.future, false, it->second.id};
+        }
+
+        InFlight call;
+        call.id = ++next_id_;
+        call.future = call.promise.get_future().share();
+        if (listener) {
+            call.listeners.push_back(std::move(listener));
+        }
+        Call result{call.future, true, call.id};
+        calls_.emplace(key, std::move(call));
+        return result;
+    }
+
+    /**
+     * @brief Resolve a call: run its listeners, then make its future ready
+     *
+     * @param key Request key
+     * @param id Call id from Join() (stale ids are ignored)
+     * @param value Result handed to every caller
+     * @return true if the call was still in flight
+     */
+    bool Complete(const Key& key, std::uint64_t id, const Value& value) {
+        InFlight call;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = calls_.find(key);
+            if (it == calls_.end() || it->second.id != id) {
+                return false;
+            }
+            call = std::move(it->second);
+            calls_.erase(it);
+        }
+
+        for (const auto& listener : call.listeners) {
+            listener(value);
+        }
+        call.promise.set_value(value);
+        return true;
+    }
+
+    /**
+     * @brief Check whether a call is in flight for a key
+     */
+    bool Contains(const Key& key) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return calls_.find(key) != calls_.end();
+    }
+
+    /**
+     * @brief Get the id of the call in flight for a key (0 if none)
+     */
+    std::uint64_t GetCallId(const Key& key) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = calls_.find(key);
+        return it != calls_.end() ? it->second.id : 0;
+    }
+
+    /**
+     * @brief Get keys of all calls in flight (snapshot)
+     */
+    std::vector<Key> GetKeys() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::vector<Key> keys;
+        keys.reserve(calls_.size());
+        for (const auto& [key, call] : calls_) {
+            keys.push_back(key);
+        }
+        return keys;
+    }
+
+    /**
+     * @brief Get number of calls in flight
+     */
+    std::size_t Size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return calls_.size();
+    }
+
+    /**
+     * @brief Get number of Join() calls that joined an existing call
+     */
+    std::uint64_t GetCoalescedCount() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return coalesced_;
+    }
+
+private:
+    struct InFlight {
+        std::uint64_t id = 0;
+        std::promise<Value> promise;
+        std::shared_future<Value> future;
+        std::vector<Listener> listeners;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<Key, InFlight, Hash> calls_;
+    std::uint64_t next_id_ = 0;
+    std::uint64_t coalesced_ = 0;
+};
+
+} // namespace earth_map
@@ -50,6 +50,7 @@ struct SRTMLoaderStats {
     uint64_t bytes_downloaded;     ///< Total bytes downloaded (HTTP only)
     double average_load_time_ms;   ///< Average load time per tile
     uint64_t pending_loads;        ///< Currently pending async loads
+    uint64_t coalesced_loads;      ///< Requests that joined a load already in flight
 
     SRTMLoaderStats()
         : tiles_loaded(0),
@@ -58,7 +59,8 @@ struct SRTMLoaderStats {
           cache_misses(0),
           bytes_downloaded(0),
           average_load_time_ms(0.0),
-          pending_loads(0) {}
+          pending_loads(0),
+          coalesced_loads(0) {}
 };
 
 /// Configuration for SRTM loader
@@ -72,6 +74,8 @@ struct SRTMLoaderConfig {
     /// URL template for HTTP downloads (for HTTP source)
     /// Placeholders: {lat} = latitude with N/S, {lon} = longitude with E/W
     /// Example: "https://server.com/srtm/{lat}{lon}.hgt"
+    /// Plain, gzip (.hgt.gz) and zip (.hgt.zip) bodies are detected and
+    /// decoded while downloading (compressed ones need EARTH_MAP_WITH_ZLIB)
     std::string url_template;
 
     /// Preferred SRTM resolution
@@ -108,6 +112,7 @@ public:
     virtual bool Initialize(const SRTMLoaderConfig& config) = 0;
 
     /// Load SRTM tile synchronously
+    /// Concurrent requests for the same tile (sync or async) share one load.
     /// @param coordinates Tile coordinates to load
     /// @return Load result with tile data or error
     virtual SRTMLoadResult LoadTile(const SRTMCoordinates& coordinates) = 0;
@@ -120,6 +125,15 @@ public:
         const SRTMCoordinates& coordinates,
         SRTMLoadCallback callback = nullptr) = 0;
 
+    /// Load SRTM tile, reporting the result only through the callback
+    /// (no future or promise per request; used by coroutine awaitables)
+    /// @param coordinates Tile coordinates to load
+    /// @param callback Called exactly once, possibly on a loader thread
+    virtual void LoadTileWithCallback(const SRTMCoordinates& coordinates,
+                                      SRTMLoadCallback callback) {
+        (void)LoadTileAsync(coordinates, std::move(callback));
+    }
+
     /// Load multiple tiles asynchronously
     /// @param coordinates Vector of tile coordinates to load
     /// @param callback Optional callback for each completed tile
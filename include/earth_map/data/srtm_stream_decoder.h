@@ -0,0 +1,103 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "elevation_data.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace earth_map {
+
+/// Incremental decoder for an SRTM tile arriving in chunks (an HTTP body)
+///
+/// The format is detected from the first bytes: a plain .hgt file, a gzip
+/// stream (.hgt.gz) or a zip archive (.hgt.zip, its first entry, stored or
+/// deflated). Compressed bodies are inflated chunk by chunk straight into
+/// the sample buffer, which is swapped to host order in place and adopted
+/// by the tile: no temporary file and no second tile-sized buffer.
+///
+/// Inflating needs zlib (EARTH_MAP_WITH_ZLIB); without it only plain and
+/// stored bodies decode. Not thread-safe.
+class SRTMStreamDecoder {
+public:
+    /// Create a decoder
+    /// @param coordinates Tile coordinates
+    /// @param expected_resolution Resolution the sample buffer is sized for
+    ///        up front (it grows once if the tile turns out larger)
+    explicit SRTMStreamDecoder(const SRTMCoordinates& coordinates,
+                               SRTMResolution expected_resolution = SRTMResolution::SRTM3);
+    ~SRTMStreamDecoder();
+
+    // Non-copyable, non-movable (holds inflate state)
+    SRTMStreamDecoder(const SRTMStreamDecoder&) = delete;
+    SRTMStreamDecoder& operator=(const SRTMStreamDecoder&) = delete;
+
+    /// Decode the next chunk of the body
+    /// @param data Bytes as received
+    /// @return False once the body is malformed; GetError() tells why
+    bool Write(std::span<const uint8_t> data);
+
+    /// Finish decoding
+    /// @return Tile (voids filled as HGTParser::Parse does), or nullptr if
+    ///         the body was malformed, truncated or not a tile
+    [[nodiscard]] std::unique_ptr<SRTMTileData> Finish();
+
+    /// Get the error that stopped decoding (empty if none)
+    [[nodiscard]] const std::string& GetError() const noexcept { return error_; }
+
+    /// Get bytes received so far (compressed size for archives)
+    [[nodiscard]] size_t GetBytesReceived() const noexcept { return bytes_received_; }
+
+    /// Check if compressed (deflated) bodies can be decoded in this build
+    [[nodiscard]] static bool SupportsCompression() noexcept;
+
+private:
+    enum class State {
+        DETECT,       ///< Buffering the first bytes
+        ZIP_HEADER,   ///< Buffering the zip local file header
+        RAW,          ///< Copying samples (plain or stored)
+        INFLATE,      ///< Inflating samples (gzip or deflated zip)
+        DONE,         ///< Entry complete; trailing bytes are ignored
+        FAILED
+    };
+
+    struct InflateState;
+
+    bool Detect();
+    bool ParseZipHeader();
+    bool CopyRaw(std::span<const uint8_t> data);
+    bool Inflate(std::span<const uint8_t> data);
+    bool StartInflate(bool gzip);
+
+    /// Make room for @p bytes more output, growing to SRTM1 once
+    bool Reserve(size_t bytes);
+
+    bool Fail(std::string error);
+
+    SRTMCoordinates coordinates_;
+    State state_ = State::DETECT;
+    std::string error_;
+    size_t bytes_received_ = 0;
+
+    /// First bytes of the body, until the format and any header are known
+    std::vector<uint8_t> header_;
+
+    /// Big-endian samples as decoded; becomes the tile's storage
+    std::vector<int16_t> samples_;
+    size_t output_bytes_ = 0;
+
+    /// Zip entry: size still to copy (stored) and checksum to verify
+    size_t stored_remaining_ = 0;
+    bool check_crc_ = false;
+    uint32_t expected_crc_ = 0;
+
+    std::unique_ptr<InflateState> inflate_;
+};
+
+} // namespace earth_map
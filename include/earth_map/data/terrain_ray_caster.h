@@ -0,0 +1,176 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "elevation_data.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <earth_map/coordinates/coordinate_spaces.h>
+
+namespace earth_map {
+
+/// Min/max elevation quadtree (hierarchical max-mip) of one SRTM tile
+///
+/// Level L holds the elevation range of blocks of 2^L x 2^L cells, a cell
+/// being the bilinear patch between four neighboring samples. Levels from 2
+/// up are stored (a sixth of the tile's own size); finer ranges are read
+/// straight from the samples. Void samples count as 0 m, matching
+/// SRTMTileData::InterpolateElevation.
+class ElevationMinMaxPyramid {
+public:
+    /// Build the quadtree of a tile
+    /// @param tile Tile data (kept alive by the pyramid)
+    /// @throws std::invalid_argument if the tile is null or invalid
+    explicit ElevationMinMaxPyramid(std::shared_ptr<const SRTMTileData> tile);
+
+    /// Get the tile
+    [[nodiscard]] const SRTMTileData& GetTile() const noexcept { return *tile_; }
+
+    /// Get the tile coordinates
+    [[nodiscard]] const SRTMCoordinates& GetCoordinates() const noexcept {
+        return tile_->GetMetadata().coordinates;
+    }
+
+    /// Get the number of levels, up to the one covering the tile in one block
+    [[nodiscard]] uint32_t GetLevelCount() const noexcept { return level_count_; }
+
+    /// Get the north-south sample spacing in meters
+    [[nodiscard]] double GetSampleSpacing() const noexcept;
+
+    /// Get the elevation range of the whole tile
+    /// @return (min, max) in meters
+    [[nodiscard]] std::pair<float, float> GetRange() const noexcept { return range_; }
+
+    /// Get a conservative elevation range of a region of the tile
+    /// Reads at most 2 x 2 blocks of the level just coarser than the region,
+    /// so the range may cover up to twice the region on each side.
+    /// @param lat_min, lat_max Latitude fractions within the tile [0, 1]
+    /// @param lon_min, lon_max Longitude fractions within the tile [0, 1]
+    /// @return (min, max) in meters covering the surface over the region
+    [[nodiscard]] std::pair<float, float> QueryRange(double lat_min, double lat_max,
+                                                     double lon_min, double lon_max) const noexcept;
+
+    /// Get memory used by the quadtree levels in bytes (the tile excluded)
+    [[nodiscard]] size_t GetMemoryUsage() const noexcept;
+
+private:
+    struct Range {
+        int16_t min;
+        int16_t max;
+    };
+
+    /// Range of the samples [x0, x1] x [y0, y1], voids as 0 m
+    [[nodiscard]] Range ScanSamples(size_t x0, size_t x1, size_t y0, size_t y1) const noexcept;
+
+    std::shared_ptr<const SRTMTileData> tile_;
+    size_t cells_per_side_;
+    uint32_t level_count_;
+    std::vector<std::vector<Range>> levels_;  ///< Stored levels from 2 up
+    std::pair<float, float> range_;
+};
+
+/// Intersection of a ray with the terrain
+struct TerrainRayHit {
+    coordinates::Geographic position;  ///< Hit point (altitude above sea level in meters)
+    double distance = 0.0;             ///< Distance along the ray, in ray units
+};
+
+/// Sight line between two points (altitudes above sea level in meters)
+struct SightLine {
+    coordinates::Geographic from;
+    coordinates::Geographic to;
+};
+
+/// Configuration for terrain ray casting
+struct TerrainRayCasterConfig {
+    /// Radius of the spherical earth the terrain sits on, in meters
+    double earth_radius_meters = 6371008.8;
+
+    /// Elevation assumed where no tile is loaded, in meters
+    float missing_elevation = 0.0f;
+
+    /// Refraction coefficient of line-of-sight queries: sight lines bend
+    /// down with this fraction of the earth's curvature (picking ignores it)
+    double refraction_coefficient = 0.13;
+
+    /// Terrain within this distance of either end of a sight line does
+    /// not block it, so points on the ground see and are seen
+    double endpoint_clearance_meters = 1.0;
+};
+
+/// Ray casting against terrain over min/max elevation quadtrees
+///
+/// A ray segment is tested as a whole against the elevation range under its
+/// ground track: the segment is clear if its lowest point (its altitude is
+/// convex along it) is above the highest terrain, and hits at its start if
+/// its highest point is below the lowest terrain. Otherwise it is halved,
+/// and ranges come from finer quadtree levels as the track shortens, so
+/// empty space is skipped in O(log n) steps. Segments over flat terrain
+/// intersect its sphere directly; segments shorter than half a sample
+/// find the crossing of the bilinear surface by bisection.
+///
+/// Immutable once built, so queries may run concurrently.
+class TerrainRayCaster {
+public:
+    /// Create a ray caster over tiles
+    /// @param tiles Tile quadtrees (later duplicates of a tile are ignored)
+    /// @param config Ray casting configuration
+    explicit TerrainRayCaster(std::vector<std::shared_ptr<const ElevationMinMaxPyramid>> tiles,
+                              const TerrainRayCasterConfig& config = TerrainRayCasterConfig{});
+
+    /// Get the number of tiles
+    [[nodiscard]] size_t GetTileCount() const noexcept { return tiles_.size(); }
+
+    /// Intersect a ray with the terrain
+    /// World space follows CoordinateMapper: a sphere of @p globe_radius at
+    /// the origin, +Y north, longitude 0 on +Z and 90°E on +X.
+    /// @param origin Ray origin in world units
+    /// @param direction Ray direction (need not be normalized)
+    /// @param globe_radius World units of the earth radius
+    /// @return First hit in front of the origin, or nullopt
+    [[nodiscard]] std::optional<TerrainRayHit> Intersect(const glm::dvec3& origin,
+                                                         const glm::dvec3& direction,
+                                                         double globe_radius = 1.0) const noexcept;
+
+    /// Check if terrain leaves the sight line between two points clear
+    [[nodiscard]] bool LineOfSight(const coordinates::Geographic& from,
+                                   const coordinates::Geographic& to) const noexcept;
+
+    /// Check many sight lines
+    /// @return 1 for each clear sight line, 0 for each blocked one
+    [[nodiscard]] std::vector<uint8_t> LineOfSight(std::span<const SightLine> lines) const;
+
+    /// Get the terrain elevation at a point
+    /// @return Interpolated elevation in meters, or the missing elevation
+    [[nodiscard]] float GetElevation(double latitude, double longitude) const noexcept;
+
+private:
+    struct Segment;
+
+    /// Elevation range over a geographic box (longitudes may exceed ±180)
+    [[nodiscard]] std::pair<float, float> QueryRange(double lat_min, double lat_max,
+                                                     double lon_min, double lon_max) const noexcept;
+
+    /// First hit parameter of p(t) = origin + t * direction on [t0, t1]
+    /// over a sphere of the given radius, or a negative value
+    [[nodiscard]] double Traverse(const Segment& segment, double t0, double t1,
+                                  int depth) const noexcept;
+
+    std::unordered_map<SRTMCoordinates, std::shared_ptr<const ElevationMinMaxPyramid>> tiles_;
+    TerrainRayCasterConfig config_;
+    double leaf_meters_;          ///< Track length below which segments are bisected
+    std::pair<float, float> range_;  ///< Elevation range of all terrain
+};
+
+} // namespace earth_map
@@ -0,0 +1,157 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "elevation_provider.h"
+#include "tile_loader.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <earth_map/math/tile_mathematics.h>
+
+namespace earth_map {
+
+/// Encoding of XYZ elevation tiles
+enum class TerrainTileEncoding {
+    /// Mapbox Terrain-RGB PNG on the Web Mercator XYZ grid:
+    /// height = -10000 + (R * 65536 + G * 256 + B) * 0.1 at pixel centers
+    TERRAIN_RGB,
+
+    /// Cesium quantized-mesh on the geographic TMS grid (two tiles at
+    /// zoom 0, y counted from the south); rasterized to a height grid
+    QUANTIZED_MESH
+};
+
+/// Position of a geographic point within an elevation tile
+struct TerrainTilePosition {
+    TileCoordinates tile;  ///< Tile containing the point
+    double u = 0.0;        ///< Fraction of the tile width from the west edge [0, 1]
+    double v = 0.0;        ///< Fraction of the tile height from the north edge [0, 1]
+};
+
+/// Locate the elevation tile containing a point
+/// Latitudes are clamped to the Web Mercator range for TERRAIN_RGB
+/// @param encoding Tile encoding (selects the tiling scheme)
+/// @param latitude Latitude in degrees
+/// @param longitude Longitude in degrees
+/// @param zoom Zoom level
+/// @return Tile and position within it
+[[nodiscard]] TerrainTilePosition LocateTerrainTile(TerrainTileEncoding encoding,
+                                                    double latitude, double longitude,
+                                                    int32_t zoom) noexcept;
+
+/// Decoded height grid of one elevation tile, rows from north to south
+class TerrainHeightmap {
+public:
+    /// Create a height grid
+    /// @param coordinates Tile coordinates
+    /// @param width Samples per row
+    /// @param height Rows
+    /// @param heights width * height heights in meters, row-major
+    /// @param pixel_is_area True if samples sit at cell centers (images),
+    ///        false if the outer samples lie on the tile edges (meshes)
+    TerrainHeightmap(const TileCoordinates& coordinates, uint32_t width, uint32_t height,
+                     std::vector<float> heights, bool pixel_is_area);
+
+    /// Get tile coordinates
+    [[nodiscard]] const TileCoordinates& GetCoordinates() const noexcept { return coordinates_; }
+
+    /// Get samples per row
+    [[nodiscard]] uint32_t GetWidth() const noexcept { return width_; }
+
+    /// Get rows
+    [[nodiscard]] uint32_t GetHeight() const noexcept { return height_; }
+
+    /// Get heights, row-major from the north-west corner
+    [[nodiscard]] std::span<const float> GetHeights() const noexcept { return heights_; }
+
+    /// Get memory used by the grid in bytes
+    [[nodiscard]] size_t GetMemoryUsage() const noexcept {
+        return sizeof(*this) + heights_.size() * sizeof(float);
+    }
+
+    /// Bilinearly interpolate the height at a position in the tile
+    /// @param u Fraction of the tile width from the west edge [0, 1]
+    /// @param v Fraction of the tile height from the north edge [0, 1]
+    /// @return Height in meters
+    [[nodiscard]] float Sample(double u, double v) const noexcept;
+
+private:
+    TileCoordinates coordinates_;
+    uint32_t width_;
+    uint32_t height_;
+    std::vector<float> heights_;
+    bool pixel_is_area_;
+};
+
+/// Decode Terrain-RGB pixels
+/// @param coordinates Tile coordinates
+/// @param rgba Decoded image, 4 bytes per pixel (alpha ignored)
+/// @param width Image width
+/// @param height Image height
+/// @return Height grid, or nullptr if the pixel count does not match
+[[nodiscard]] std::unique_ptr<TerrainHeightmap> DecodeTerrainRGB(
+    const TileCoordinates& coordinates, std::span<const uint8_t> rgba,
+    uint32_t width, uint32_t height);
+
+/// Decode a quantized-mesh tile and rasterize it to a height grid
+/// Only the header, vertex and index data are read; extensions are ignored.
+/// @param coordinates Tile coordinates
+/// @param data Tile bytes (not gzip-encoded)
+/// @param grid_size Samples per grid edge, from edge to edge (at least 2)
+/// @return Height grid, or nullptr if the mesh is malformed
+[[nodiscard]] std::unique_ptr<TerrainHeightmap> DecodeQuantizedMesh(
+    const TileCoordinates& coordinates, std::span<const uint8_t> data,
+    uint32_t grid_size = 65);
+
+/// Configuration for the elevation provider over XYZ elevation tiles
+struct TerrainTileProviderConfig {
+    /// Tile encoding
+    TerrainTileEncoding encoding = TerrainTileEncoding::TERRAIN_RGB;
+
+    /// Name of the TileLoader provider serving the tiles (its cache is used);
+    /// empty for the loader's default provider
+    std::string provider_name = "terrain";
+
+    /// Zoom of point queries (the finest zoom used)
+    int32_t max_zoom = 12;
+
+    /// Coarsest zoom batch queries with a ground resolution fall back to
+    int32_t min_zoom = 0;
+
+    /// Samples per tile edge; sets the spacing used to pick batch zooms and
+    /// the grid quantized-mesh tiles are rasterized to (+1 for the edge)
+    uint32_t tile_size = 256;
+
+    /// Decoded tiles kept in memory (encoded tiles stay in the TileCache)
+    size_t max_decoded_tiles = 256;
+
+    /// Decode threads (0 = hardware concurrency)
+    int decode_threads = 0;
+
+    /// Preload loads in flight at once
+    size_t preload_window = 16;
+};
+
+/// Create an elevation provider over XYZ elevation tiles
+///
+/// Tiles are fetched through @p loader, so they share its download engine,
+/// request coalescing and TileCache with imagery, and are decoded on a
+/// DecodeThreadPool. Query results carry the 1° SRTM cell of the point as
+/// source_tile. Loader statistics are reported in SRTMLoaderStats terms.
+///
+/// @param loader Tile loader with the elevation tile provider added
+/// @param config Provider configuration
+/// @return Elevation provider
+/// @throws std::invalid_argument if the loader is null or has no such provider
+[[nodiscard]] std::shared_ptr<ElevationProvider> CreateTerrainTileElevationProvider(
+    std::shared_ptr<TileLoader> loader,
+    const TerrainTileProviderConfig& config = TerrainTileProviderConfig{});
+
+} // namespace earth_map
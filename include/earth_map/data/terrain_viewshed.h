@@ -0,0 +1,145 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "elevation_provider.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <earth_map/coordinates/coordinate_spaces.h>
+
+namespace earth_map {
+
+/// Configuration for terrain viewshed analysis
+struct ViewshedConfig {
+    /// Observer height above the terrain in meters
+    double observer_height_meters = 2.0;
+
+    /// Height above the terrain a target must be seen at, in meters
+    /// (e.g. an aircraft altitude for radar coverage)
+    double target_height_meters = 0.0;
+
+    /// Analysis radius in meters
+    double max_distance_meters = 10000.0;
+
+    /// Raster cell size in meters
+    double cell_size_meters = 30.0;
+
+    /// Lower terrain by the earth's curvature with distance
+    bool earth_curvature = true;
+
+    /// Atmospheric refraction coefficient: sight lines bend down with this
+    /// fraction of the earth's curvature (0.13 for visible light, about 0.25
+    /// for radar's 4/3-earth model, 0 to disable)
+    double refraction_coefficient = 0.13;
+
+    /// Maximum worker threads (0 = hardware concurrency)
+    size_t max_threads = 0;
+};
+
+/// Visibility bitmask on a square raster centered on the observer
+///
+/// The raster is a local tangent plane: rows run north to south and columns
+/// west to east, one cell size apart at the observer. Cells farther than the
+/// analysis radius are never visible.
+class ViewshedRaster {
+public:
+    /// Create a raster
+    /// @param observer Observer position (the center cell)
+    /// @param radius_cells Cells from the center to each edge
+    /// @param cell_size_meters Cell size in meters
+    /// @param bits Row-major visibility bits, bit i % 64 of word i / 64 for
+    ///        cell i; (2 * radius_cells + 1)^2 bits, rounded up to words
+    ViewshedRaster(const coordinates::Geographic& observer, uint32_t radius_cells,
+                   double cell_size_meters, std::vector<uint64_t> bits);
+
+    /// Get observer position
+    [[nodiscard]] const coordinates::Geographic& GetObserver() const noexcept { return observer_; }
+
+    /// Get cells from the center to each edge
+    [[nodiscard]] uint32_t GetRadiusCells() const noexcept { return radius_cells_; }
+
+    /// Get cells per row and rows (2 * radius + 1)
+    [[nodiscard]] uint32_t GetSize() const noexcept { return 2 * radius_cells_ + 1; }
+
+    /// Get cell size in meters
+    [[nodiscard]] double GetCellSize() const noexcept { return cell_size_meters_; }
+
+    /// Get the visibility bits (layout as in the constructor)
+    [[nodiscard]] std::span<const uint64_t> GetBits() const noexcept { return bits_; }
+
+    /// Check if a cell is visible
+    /// @param column Column from the west edge
+    /// @param row Row from the north edge
+    /// @return False for cells outside the raster
+    [[nodiscard]] bool IsVisible(uint32_t column, uint32_t row) const noexcept;
+
+    /// Check if the cell containing a geographic point is visible
+    /// @return False for points outside the raster
+    [[nodiscard]] bool IsVisibleAt(double latitude, double longitude) const noexcept;
+
+    /// Get the number of visible cells
+    [[nodiscard]] size_t CountVisible() const noexcept;
+
+    /// Get the geographic position of a cell center
+    [[nodiscard]] coordinates::Geographic GetCellCenter(uint32_t column,
+                                                        uint32_t row) const noexcept;
+
+    /// Find the cell containing a geographic point
+    /// @return False if the point lies outside the raster
+    [[nodiscard]] bool FindCell(double latitude, double longitude,
+                                uint32_t& column, uint32_t& row) const noexcept;
+
+private:
+    coordinates::Geographic observer_;
+    uint32_t radius_cells_;
+    double cell_size_meters_;
+    double meters_per_degree_latitude_;
+    double meters_per_degree_longitude_;
+    std::vector<uint64_t> bits_;
+};
+
+/// Get the raster radius in cells for a configuration
+/// @throws std::invalid_argument if the cell size or distance is not positive,
+///         or the raster would exceed 32768 cells from center to edge
+[[nodiscard]] uint32_t GetViewshedRadiusCells(const ViewshedConfig& config);
+
+/// Compute a viewshed over a height grid
+///
+/// R2 sweep: a sight line runs from the observer to every perimeter cell,
+/// one cell per step along its major axis, keeping the steepest horizon of
+/// the terrain interpolated where it crosses each column (or row). Each cell
+/// is decided by the one sight line passing nearest its center, so sight
+/// lines are independent and run in parallel by sector without sharing.
+///
+/// @param heights Terrain heights in meters, (2r + 1)^2 row-major from the
+///        north-west corner with the observer at the center, where
+///        r = GetViewshedRadiusCells(config)
+/// @param observer Observer position the raster is anchored at
+/// @param config Analysis configuration
+/// @return Visibility raster
+/// @throws std::invalid_argument if the configuration or grid size is invalid
+[[nodiscard]] ViewshedRaster ComputeViewshed(std::span<const float> heights,
+                                             const coordinates::Geographic& observer,
+                                             const ViewshedConfig& config);
+
+/// Compute a viewshed from elevation data
+///
+/// The height grid is sampled from @p provider in row bands through the
+/// batch query at the cell size; points without data count as sea level.
+///
+/// @param provider Elevation source
+/// @param observer Observer position (its altitude is ignored; the observer
+///        stands config.observer_height_meters above the terrain)
+/// @param config Analysis configuration
+/// @return Visibility raster
+/// @throws std::invalid_argument if the configuration is invalid
+[[nodiscard]] ViewshedRaster ComputeViewshed(const ElevationProvider& provider,
+                                             const coordinates::Geographic& observer,
+                                             const ViewshedConfig& config = ViewshedConfig{});
+
+} // namespace earth_map
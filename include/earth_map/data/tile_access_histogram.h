@@ -0,0 +1,126 @@
+#pragma once
+
+/**
+ * @file tile_access_histogram.h
+ * @brief Persistent, session-decayed per-tile access counts
+ *
+ * Operators look at the same few regions day after day, yet every session
+ * starts with a cold memory cache. The histogram counts cache hits per tile
+ * during a session and folds them into a score that decays once per
+ * session, so the tiles of the last few sessions rank first. It is stored
+ * next to the disk cache manifest (access_histogram.bin) and read on
+ * startup to choose the tiles worth warming up.
+ *
+ * score(next session) = score(this session) × decay + hits(this session)
+ */
+
+#include <earth_map/math/tile_mathematics.h>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Decayed access counts of cached tiles, persisted across sessions
+ *
+ * Save() writes the folded scores but leaves the in-memory state alone, so
+ * it may run any number of times per session without decaying twice.
+ *
+ * Thread Safety: All methods are thread-safe.
+ */
+class TileAccessHistogram {
+public:
+    /// Weight of the previous sessions' score in the next one
+    static constexpr float kDefaultDecay = 0.7f;
+
+    /// Tiles kept in the file (hottest first)
+    static constexpr std::size_t kDefaultMaxTiles = 4096;
+
+    /// Scores below this are dropped (one hit decays below it in ~8 sessions)
+    static constexpr float kMinScore = 0.05f;
+
+    /**
+     * @brief Constructor
+     *
+     * @param directory Cache directory holding access_histogram.bin
+     * @param decay Weight of past sessions (0..1)
+     * @param max_tiles Tiles kept when saving
+     */
+    explicit TileAccessHistogram(const std::string& directory,
+                                 float decay = kDefaultDecay,
+                                 std::size_t max_tiles = kDefaultMaxTiles);
+
+    // Non-copyable
+    TileAccessHistogram(const TileAccessHistogram&) = delete;
+    TileAccessHistogram& operator=(const TileAccessHistogram&) = delete;
+
+    /**
+     * @brief Read the scores of past sessions
+     *
+     * @return true if a histogram was read; false if none existed or it was
+     *         unreadable (the histogram then starts empty)
+     */
+    bool Load();
+
+    /**
+     * @brief Count one access to a tile in this session
+     */
+    void Record(const TileCoordinates& coords);
+
+    /**
+     * @brief Get the highest-scoring tiles, hottest first
+     *
+     * Ranks by past score plus this session's hits.
+     */
+    std::vector<TileCoordinates> GetHottest(std::size_t max_count) const;
+
+    /**
+     * @brief Get the current score of a tile (past score + session hits)
+     */
+    float GetScore(const TileCoordinates& coords) const;
+
+    /**
+     * @brief Write the folded scores for the next session
+     *
+     * @return true on success
+     */
+    bool Save() const;
+
+    /**
+     * @brief Forget all scores and remove the file
+     */
+    void Clear();
+
+    /** @brief Get number of tiles with a score */
+    std::size_t GetCount() const;
+
+    /** @brief Get the file the histogram is stored in */
+    const std::string& GetPath() const { return path_; }
+
+private:
+    /**
+     * @brief Per-tile state
+     */
+    struct Counts {
+        float past_score = 0.0f;          ///< Decayed score of previous sessions
+        std::uint32_t session_hits = 0;   ///< Hits in this session
+    };
+
+    /**
+     * @brief Scores for the next session, hottest first, capped (mutex_ held)
+     */
+    std::vector<std::pair<TileCoordinates, float>> FoldLocked() const;
+
+    std::string path_;
+    float decay_;
+    std::size_t max_tiles_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<TileCoordinates, Counts, TileCoordinatesHash> counts_;
+};
+
+} // namespace earth_map
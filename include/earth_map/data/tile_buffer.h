@@ -0,0 +1,158 @@
+#pragma once
+
+/**
+ * @file tile_buffer.h
+ * @brief Immutable, reference-counted tile byte buffer
+ *
+ * Tile bytes travel from the download engine through the loader, the
+ * memory cache, the disk tier and the decode workers. A TileBuffer shares
+ * one immutable allocation between all of them: copying a buffer (or the
+ * TileData holding it) only bumps a reference count, and a buffer can also
+ * view memory it does not own, such as a memory-mapped packed segment,
+ * keeping that mapping alive for as long as the view exists.
+ *
+ * The container-style accessors (data, size, begin, end, ...) follow std
+ * naming so buffers work with spans, algorithms and range-for directly.
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Shared, read-only view of tile bytes
+ *
+ * Thread Safety: the bytes are immutable, so buffers may be read and copied
+ * from any number of threads.
+ */
+class TileBuffer {
+public:
+    using value_type = std::uint8_t;
+    using const_iterator = const std::uint8_t*;
+    using iterator = const_iterator;
+
+    /**
+     * @brief Empty buffer
+     */
+    TileBuffer() = default;
+
+    /**
+     * @brief Take ownership of bytes without copying them
+     */
+    TileBuffer(std::vector<std::uint8_t>&& bytes) {
+        if (!bytes.empty()) {
+            auto owned = std::make_shared<const std::vector<std::uint8_t>>(std::move(bytes));
+            data_ = owned->data();
+            size_ = owned->size();
+            owner_ = std::move(owned);
+        }
+    }
+
+    /**
+     * @brief Copy bytes into a new buffer (explicit, so copies stay visible)
+     */
+    explicit TileBuffer(const std::vector<std::uint8_t>& bytes)
+        : TileBuffer(std::vector<std::uint8_t>(bytes)) {}
+
+    /**
+     * @brief Copy bytes into a new buffer
+     */
+    TileBuffer(std::initializer_list<std::uint8_t> bytes)
+        : TileBuffer(std::vector<std::uint8_t>(bytes)) {}
+
+    /**
+     * @brief Copy bytes into a new buffer
+     */
+    static TileBuffer CopyOf(std::span<const std::uint8_t> bytes) {
+        return TileBuffer(std::vector<std::uint8_t>(bytes.begin(), bytes.end()));
+    }
+
+    /**
+     * @brief View memory owned by someone else, without copying
+     *
+     * @param owner Keeps the viewed memory alive (e.g. a segment mapping)
+     * @param bytes Viewed bytes, valid while owner is alive
+     */
+    static TileBuffer Wrap(std::shared_ptr<const void> owner,
+                           std::span<const std::uint8_t> bytes) {
+        TileBuffer buffer;
+        if (!bytes.empty()) {
+            buffer.owner_ = std::move(owner);
+            buffer.data_ = bytes.data();
+            buffer.size_ = bytes.size();
+        }
+        return buffer;
+    }
+
+    /** @brief Pointer to the first byte (nullptr if empty) */
+    const std::uint8_t* data() const { return data_; }
+
+    /** @brief Number of bytes */
+    std::size_t size() const { return size_; }
+
+    /** @brief Check whether the buffer holds no bytes */
+    bool empty() const { return size_ == 0; }
+
+    const_iterator begin() const { return data_; }
+    const_iterator end() const { return data_ + size_; }
+
+    const std::uint8_t& operator[](std::size_t index) const { return data_[index]; }
+
+    /** @brief View of the bytes */
+    std::span<const std::uint8_t> Span() const { return {data_, size_}; }
+
+    /**
+     * @brief Sub-range sharing this buffer's storage
+     *
+     * Out-of-range requests are clamped to the buffer.
+     */
+    TileBuffer Slice(std::size_t offset, std::size_t length) const {
+        if (offset >= size_) {
+            return TileBuffer();
+        }
+        TileBuffer slice;
+        slice.owner_ = owner_;
+        slice.data_ = data_ + offset;
+        slice.size_ = std::min(length, size_ - offset);
+        return slice;
+    }
+
+    /** @brief Copy the bytes into a mutable vector */
+    std::vector<std::uint8_t> ToVector() const { return {begin(), end()}; }
+
+    /** @brief Number of buffers sharing the storage (0 if empty) */
+    long UseCount() const { return owner_.use_count(); }
+
+    /** @brief Check whether two buffers share the same bytes in memory */
+    bool SharesStorageWith(const TileBuffer& other) const {
+        return data_ == other.data_ && size_ == other.size_;
+    }
+
+    /** @brief Byte-wise comparison */
+    friend bool operator==(const TileBuffer& a, const TileBuffer& b) {
+        return a.size_ == b.size_ &&
+               (a.data_ == b.data_ || a.size_ == 0 ||
+                std::memcmp(a.data_, b.data_, a.size_) == 0);
+    }
+
+    /** @brief Byte-wise comparison with plain bytes (e.g. a vector) */
+    friend bool operator==(const TileBuffer& a, std::span<const std::uint8_t> b) {
+        return a.size_ == b.size() &&
+               (a.size_ == 0 || std::memcmp(a.data_, b.data(), a.size_) == 0);
+    }
+
+private:
+    std::shared_ptr<const void> owner_;
+    const std::uint8_t* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+} // namespace earth_map
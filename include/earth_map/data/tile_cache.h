@@ -10,6 +10,7 @@
 
 #include <earth_map/math/tile_mathematics.h>
 #include <earth_map/math/bounding_box.h>
+#include <earth_map/data/tile_buffer.h>
 #include <glm/vec2.hpp>
 #include <vector>
 #include <memory>
@@ -31,7 +32,7 @@ struct TileMetadata {
     /** File size in bytes */
     std::size_t file_size = 0;
     
-    /** Last modified timestamp */
+    /** When the tile was last fetched or revalidated (local clock) */
     std::chrono::system_clock::time_point last_modified;
     
     /** Expiration timestamp */
@@ -40,6 +41,9 @@ struct TileMetadata {
     /** ETag from HTTP header for validation */
     std::string etag;
     
+    /** Last-Modified HTTP header, verbatim, for If-Modified-Since (empty if none) */
+    std::string server_last_modified;
+    
     /** Content type */
     std::string content_type;
     
@@ -48,7 +52,9 @@ struct TileMetadata {
         NONE,       ///< No compression
         GZIP,       ///< GZIP compression
         DEFLATE,    ///< DEFLATE compression
-        BROTLI      ///< Brotli compression
+        BROTLI,     ///< Brotli compression
+        LZ4,        ///< LZ4 block compression (fast decode)
+        ZSTD        ///< Zstandard, optionally with a trained dictionary
     } compression = Compression::NONE;
     
     /** Checksum for data integrity */
@@ -79,8 +85,8 @@ struct TileData {
     /** Tile metadata */
     TileMetadata metadata;
     
-    /** Raw tile data bytes */
-    std::vector<std::uint8_t> data;
+    /** Raw tile data bytes (shared and immutable: copying a TileData does not copy them) */
+    TileBuffer data;
     
     /** Whether data is compressed */
     bool is_compressed = false;
@@ -136,6 +142,32 @@ struct TileCacheConfig {
     /** Disk cache directory path */
     std::string disk_cache_directory = "./tile_cache";
     
+    /** Disk cache layout */
+    enum class DiskBackend {
+        FILES,  ///< One tile file and one metadata file per tile
+        PACKED  ///< Append-only memory-mapped segments (PackedTileStore)
+    } disk_backend = DiskBackend::FILES;
+    
+    /**
+     * Segment file size of the packed disk backend. The disk budget is
+     * enforced by dropping whole segments, so keep it well below
+     * max_disk_cache_size.
+     */
+    std::size_t packed_segment_size = 64 * 1024 * 1024;  // 64MB
+    
+    /**
+     * Share the disk cache with other processes using the same directory:
+     * implies DiskBackend::PACKED in shared mode, so a tile one process
+     * downloads is served from disk to the others
+     */
+    bool shared_disk_cache = false;
+    
+    /** Persist disk writes on a background I/O thread (Put only touches memory) */
+    bool enable_write_behind = true;
+    
+    /** Maximum tiles waiting for the I/O thread before Put blocks */
+    std::size_t write_behind_queue_size = 1024;
+    
     /** Cache eviction strategy */
     enum class EvictionStrategy {
         LRU,        ///< Least Recently Used
@@ -147,10 +179,19 @@ struct TileCacheConfig {
     /** Enable compression for disk cache */
     bool enable_compression = true;
     
-    /** Default compression type */
+    /** Disk cache compression type (ZSTD recommended; unavailable codecs store raw) */
     TileMetadata::Compression default_compression = TileMetadata::Compression::GZIP;
     
-    /** TTL for cached tiles in seconds */
+    /** Memory cache compression type (LZ4 recommended for fast decode) */
+    TileMetadata::Compression memory_compression = TileMetadata::Compression::NONE;
+    
+    /** Trained zstd dictionary for this layer's disk tiles (empty: none) */
+    std::string zstd_dictionary_path;
+    
+    /**
+     * TTL for cached tiles in seconds, counted from the last download or
+     * revalidation; Cleanup() keeps tiles whose expires_at is still ahead
+     */
     std::uint64_t tile_ttl = 7 * 24 * 3600;  // 7 days
     
     /** Enable integrity checking */
@@ -159,8 +200,44 @@ struct TileCacheConfig {
     /** Maximum number of tiles to cache */
     std::size_t max_tile_count = 10000;
     
-    /** Cache cleanup interval in seconds */
+    /** Interval in seconds between the background collector's scans for expired tiles */
     std::uint64_t cleanup_interval = 3600;  // 1 hour
+    
+    /**
+     * Enforce max_disk_cache_size and tile_ttl on a low-priority collector
+     * thread (DiskBackend::FILES) instead of on the thread that writes
+     */
+    bool enable_background_cleanup = true;
+    
+    /** Most tiles the background collector deletes per one-second tick */
+    std::size_t cleanup_batch_size = 256;
+    
+    /**
+     * Count tile hits in a TileAccessHistogram stored beside the disk cache
+     * index, decayed once per session
+     */
+    bool enable_access_histogram = true;
+    
+    /** Weight of past sessions in the access histogram (0..1) */
+    float access_histogram_decay = 0.7f;
+    
+    /** Tiles the access histogram keeps across sessions */
+    std::size_t access_histogram_max_tiles = 4096;
+    
+    /**
+     * On Initialize, promote the hottest tiles of past sessions from disk
+     * into the memory tier on a background thread
+     */
+    bool enable_warmup = true;
+    
+    /** Most tiles promoted by the warm-up */
+    std::size_t warmup_max_tiles = 512;
+    
+    /** Memory tier bytes the warm-up may fill (capped by max_memory_cache_size) */
+    std::size_t warmup_memory_budget = 32 * 1024 * 1024;  // 32MB
+    
+    /** Time the warm-up may spend reading from disk, in milliseconds */
+    std::uint32_t warmup_time_budget_ms = 2000;
 };
 
 /**
@@ -184,6 +261,16 @@ struct TileCacheStats {
     std::size_t total_evictions = 0;
     std::size_t total_corruptions = 0;
     
+    /** Tiles waiting for the write-behind I/O thread */
+    std::size_t pending_disk_writes = 0;
+    
+    /** Tiles promoted into memory by the startup warm-up */
+    std::size_t warmup_tiles = 0;
+    
+    /** Achieved compression (uncompressed / stored bytes) of tiles stored since reset */
+    float memory_compression_ratio = 1.0f;
+    float disk_compression_ratio = 1.0f;
+    
     /** Cache hit ratio */
     float GetHitRatio() const {
         return total_requests > 0 ? 
@@ -205,6 +292,10 @@ struct TileCacheStats {
         total_requests = 0;
         total_evictions = 0;
         total_corruptions = 0;
+        pending_disk_writes = 0;
+        warmup_tiles = 0;
+        memory_compression_ratio = 1.0f;
+        disk_compression_ratio = 1.0f;
     }
 };
 
@@ -232,6 +323,8 @@ public:
     /**
      * @brief Put tile data into cache
      *
+     * The cache keeps a reference to the tile bytes rather than a copy.
+     *
      * @param tile_data Tile data to store
      * @return true if storage succeeded, false otherwise
      */
@@ -240,6 +333,9 @@ public:
     /**
      * @brief Get tile data from cache
      *
+     * The returned bytes are shared with the cache (and, for the packed disk
+     * backend, with the memory-mapped segment); they are never copied.
+     *
      * @param coordinates Tile coordinates to retrieve
      * @return std::optional<TileData> Tile data if found, std::nullopt otherwise
      */
@@ -299,6 +395,13 @@ public:
      */
     virtual std::size_t Cleanup() = 0;
     
+    /**
+     * @brief Block until all queued disk writes are persisted
+     *
+     * Caches that write synchronously have nothing to do.
+     */
+    virtual void Flush() {}
+    
     /**
      * @brief Get cache configuration
      * 
@@ -339,6 +442,19 @@ public:
      */
     virtual std::vector<TileCoordinates> GetTilesAtZoom(
         std::uint8_t zoom_level) const = 0;
+    
+    /**
+     * @brief Get the most used tiles of recent sessions, hottest first
+     *
+     * Caches without an access histogram return nothing.
+     *
+     * @param max_count Most tiles to return
+     * @return std::vector<TileCoordinates> Tile coordinates by descending use
+     */
+    virtual std::vector<TileCoordinates> GetHottestTiles(std::size_t max_count) const {
+        (void)max_count;
+        return {};
+    }
 
 protected:
     /**
@@ -0,0 +1,106 @@
+#pragma once
+
+/**
+ * @file tile_compression.h
+ * @brief Tile byte compression codecs used by the tile cache
+ *
+ * Codecs are optional build dependencies: GZIP/DEFLATE need
+ * EARTH_MAP_WITH_ZLIB, LZ4 needs EARTH_MAP_WITH_LZ4 and ZSTD needs
+ * EARTH_MAP_WITH_ZSTD. Use IsCompressionAvailable() to check at runtime;
+ * callers fall back to Compression::NONE for missing codecs.
+ *
+ * Compressed blobs are self-describing for decompression: LZ4 blobs carry a
+ * 4-byte little-endian uncompressed size, zstd frames carry their content
+ * size, and gzip/zlib streams are inflated until the end of the stream.
+ */
+
+#include <earth_map/data/tile_cache.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Trained zstd dictionary (for one provider / layer)
+ *
+ * Small tiles of one layer share a lot of structure; a dictionary trained on
+ * sample tiles raises the zstd ratio substantially for them.
+ */
+class ZstdDictionary {
+public:
+    /**
+     * @brief Wrap raw dictionary bytes (e.g. loaded from disk)
+     *
+     * @return Dictionary, or nullptr if zstd is unavailable or bytes are invalid
+     */
+    static std::shared_ptr<const ZstdDictionary> FromBytes(std::vector<std::uint8_t> bytes);
+
+    /**
+     * @brief Train a dictionary from sample tiles
+     *
+     * @param samples Sample tile payloads (a few hundred is typical)
+     * @param capacity Maximum dictionary size in bytes
+     * @return Dictionary, or nullptr if training failed or zstd is unavailable
+     */
+    static std::shared_ptr<const ZstdDictionary> Train(
+        const std::vector<std::vector<std::uint8_t>>& samples,
+        std::size_t capacity = 16 * 1024);
+
+    ~ZstdDictionary();
+
+    // Non-copyable
+    ZstdDictionary(const ZstdDictionary&) = delete;
+    ZstdDictionary& operator=(const ZstdDictionary&) = delete;
+
+    /** @brief Get raw dictionary bytes (for persisting) */
+    const std::vector<std::uint8_t>& GetBytes() const { return bytes_; }
+
+    /** @brief Get the zstd dictionary id stored in frames */
+    std::uint32_t GetId() const { return id_; }
+
+private:
+    friend std::optional<std::vector<std::uint8_t>> CompressTileData(
+        std::span<const std::uint8_t>, TileMetadata::Compression, int, const ZstdDictionary*);
+    friend std::optional<std::vector<std::uint8_t>> DecompressTileData(
+        std::span<const std::uint8_t>, TileMetadata::Compression, const ZstdDictionary*);
+
+    explicit ZstdDictionary(std::vector<std::uint8_t> bytes);
+
+    std::vector<std::uint8_t> bytes_;
+    std::uint32_t id_ = 0;
+    void* compress_dict_ = nullptr;    ///< ZSTD_CDict*
+    void* decompress_dict_ = nullptr;  ///< ZSTD_DDict*
+};
+
+/**
+ * @brief Check whether a codec is compiled in
+ */
+bool IsCompressionAvailable(TileMetadata::Compression type);
+
+/**
+ * @brief Compress tile bytes
+ *
+ * @param data Raw bytes
+ * @param type Codec (NONE copies)
+ * @param level Codec level, 0 for the codec default
+ * @param dictionary Optional zstd dictionary (ZSTD only)
+ * @return Compressed blob, or nullopt if the codec is unavailable or failed
+ */
+std::optional<std::vector<std::uint8_t>> CompressTileData(
+    std::span<const std::uint8_t> data, TileMetadata::Compression type,
+    int level = 0, const ZstdDictionary* dictionary = nullptr);
+
+/**
+ * @brief Decompress a blob produced by CompressTileData
+ *
+ * @return Raw bytes, or nullopt on corrupt input or unavailable codec
+ */
+std::optional<std::vector<std::uint8_t>> DecompressTileData(
+    std::span<const std::uint8_t> data, TileMetadata::Compression type,
+    const ZstdDictionary* dictionary = nullptr);
+
+} // namespace earth_map
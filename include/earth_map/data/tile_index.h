@@ -6,6 +6,13 @@
  * 
  * Provides efficient spatial indexing for tiles using quadtree data structure,
  * supporting fast spatial queries, visibility culling, and tile priority calculations.
+ *
+ * The index created by CreateTileIndex is a linear quadtree: a sorted array
+ * of 64-bit quadkey codes (a leading 1 bit, then the Morton code of x and y),
+ * about 8 bytes per tile with no per-node allocation. Zoom queries are a
+ * binary search for the level's run; bounds queries binary search the code
+ * range of each quadtree cell along the bounds' edge and copy the runs of
+ * cells inside them.
  */
 
 #include <earth_map/math/tile_mathematics.h>
@@ -13,6 +20,7 @@
 #include <glm/vec2.hpp>
 #include <vector>
 #include <memory>
+#include <memory_resource>
 #include <cstdint>
 #include <optional>
 #include <unordered_map>
@@ -21,7 +29,9 @@
 namespace earth_map {
 
 /**
- * @brief Quadtree node for tile indexing
+ * @brief Pointer-based quadtree node for tile indexing
+ *
+ * Standalone structure; the index from CreateTileIndex does not use it.
  */
 struct QuadtreeNode {
     /** Node bounds in geographic coordinates */
@@ -126,10 +136,10 @@ struct QuadtreeNode {
  * @brief Tile index configuration
  */
 struct TileIndexConfig {
-    /** Maximum tiles per quadtree node */
+    /** Maximum tiles per quadtree node (QuadtreeNode only; the linear index has no nodes) */
     std::size_t max_tiles_per_node = 10;
     
-    /** Maximum quadtree depth */
+    /** Maximum quadtree depth (QuadtreeNode only) */
     std::uint8_t max_quadtree_depth = 20;
     
     /** Enable automatic rebuilding */
@@ -228,6 +238,23 @@ public:
                                                std::int32_t min_zoom,
                                                std::int32_t max_zoom) const = 0;
     
+    /**
+     * @brief Query tiles within zoom range into a caller-provided list
+     * 
+     * The query allocates from the list's memory resource (e.g. a
+     * FrameArena), so per-frame queries need not touch the heap. The
+     * default implementation copies the result of the vector overload.
+     * 
+     * @param bounds Geographic bounds to query
+     * @param min_zoom Minimum zoom level (inclusive)
+     * @param max_zoom Maximum zoom level (inclusive)
+     * @param results Receives the tiles (appended)
+     */
+    virtual void Query(const BoundingBox2D& bounds,
+                       std::int32_t min_zoom,
+                       std::int32_t max_zoom,
+                       std::pmr::vector<TileCoordinates>& results) const;
+    
     /**
      * @brief Query tiles visible from camera position
      * 
@@ -292,6 +319,8 @@ public:
     
     /**
      * @brief Rebuild index from scratch
+     *
+     * Re-sorts every tile (with a parallel radix sort for large indexes).
      */
     virtual void Rebuild() = 0;
     
@@ -300,8 +329,8 @@ public:
      */
     struct IndexStats {
         std::size_t total_tiles = 0;
-        std::size_t total_nodes = 0;
-        std::size_t leaf_nodes = 0;
+        std::size_t total_nodes = 0;   ///< Quadtree cells holding a tile or a tile's ancestor
+        std::size_t leaf_nodes = 0;    ///< Such cells with no such child
         std::size_t max_depth = 0;
         std::size_t query_count = 0;
         float average_query_time_ms = 0.0f;
@@ -10,12 +10,16 @@
 
 #include <earth_map/math/tile_mathematics.h>
 #include <earth_map/data/tile_cache.h>
+#include <earth_map/data/latency_histogram.h>
+#include <earth_map/data/tile_variant.h>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 #include <functional>
 #include <cstdint>
 #include <future>
+#include <optional>
 
 namespace earth_map {
 
@@ -42,6 +46,20 @@ public:
      */
     virtual std::string BuildTileURL(const TileCoordinates& coords) const = 0;
 
+    /**
+     * @brief Build URL of the same tile on a mirror host
+     *
+     * Used for hedged requests: when the primary request is slower than its
+     * host's usual tail latency, a duplicate goes to the mirror and the
+     * slower of the two is cancelled.
+     *
+     * @return Mirror URL, empty if the provider has no mirror
+     */
+    virtual std::string BuildMirrorURL(const TileCoordinates& coords) const {
+        (void)coords;
+        return {};
+    }
+
     /**
      * @brief Get headers for tile request
      */
@@ -91,6 +109,50 @@ public:
      * @brief Get retry delay
      */
     virtual std::uint32_t GetRetryDelay() const { return 1000; }
+
+    /**
+     * @brief Get scheduling weight
+     *
+     * Share of download start slots this provider gets when several
+     * providers have requests queued (fair queuing between layers).
+     */
+    virtual std::uint32_t GetSchedulingWeight() const { return 1; }
+
+    /**
+     * @brief Whether tiles come from a local source via ReadTile() instead of HTTP
+     */
+    virtual bool IsLocal() const { return false; }
+
+    /**
+     * @brief Read a tile from the local source (only used when IsLocal())
+     *
+     * Sources that store tiles uncompressed should return a view of their
+     * storage (TileBuffer::Wrap) rather than a copy.
+     *
+     * @return Decoded tile bytes, or nullopt if the source has no such tile
+     */
+    virtual std::optional<TileBuffer> ReadTile(
+        const TileCoordinates& coords) const {
+        (void)coords;
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Get the encodings tiles are served in
+     *
+     * With variants, the loader picks one per download from the measured
+     * link throughput (see TileVariantSelector) and builds its URL with
+     * BuildVariantURL(). Without, BuildTileURL() is used.
+     */
+    virtual std::vector<TileVariant> GetVariants() const { return {}; }
+
+    /**
+     * @brief Build URL of a tile in one of GetVariants()
+     */
+    virtual std::string BuildVariantURL(const TileCoordinates& coords, std::size_t variant) const {
+        (void)variant;
+        return BuildTileURL(coords);
+    }
 };
 
 /**
@@ -110,16 +172,41 @@ public:
                         const std::string& user_agent = "EarthMap/1.0");
 
     std::string BuildTileURL(const TileCoordinates& coords) const override;
+    std::string BuildMirrorURL(const TileCoordinates& coords) const override;
     std::vector<std::pair<std::string, std::string>> GetHeaders() const override;
     std::string GetAttribution() const override;
     std::int32_t GetMinZoom() const override;
     std::int32_t GetMaxZoom() const override;
     std::string GetFormat() const override;
     std::string GetName() const override;
+    std::vector<TileVariant> GetVariants() const override;
+    std::string BuildVariantURL(const TileCoordinates& coords, std::size_t variant) const override;
+
+    /**
+     * @brief Set URL templates of mirror hosts for hedged requests
+     *
+     * Templates use the same placeholders as the primary one. Without
+     * mirrors, a template with {s} and several subdomains hedges to the
+     * next subdomain.
+     */
+    void SetMirrorTemplates(std::vector<std::string> templates);
+
+    /**
+     * @brief Advertise an encoding served under its own URL template
+     *
+     * Once a variant is added, tiles are only fetched as variants.
+     */
+    void AddVariant(const TileVariant& variant, const std::string& url_template);
 
 private:
+    std::string ExpandTemplate(const std::string& url_template, const TileCoordinates& coords,
+                               char subdomain) const;
+
     std::string name_;
     std::string url_template_;
+    std::vector<std::string> mirror_templates_;
+    std::vector<TileVariant> variants_;
+    std::vector<std::string> variant_templates_;
     std::string subdomains_;
     std::int32_t min_zoom_;
     std::int32_t max_zoom_;
@@ -130,6 +217,55 @@ private:
     std::string user_agent_;
 };
 
+/**
+ * @brief One timestamped frame of a time-series provider (weather radar)
+ *
+ * Wraps a provider whose URL templates carry a {t} placeholder and fills it
+ * with the frame's timestamp. Each frame is registered with the loader under
+ * its own name, so in-flight loads of the same tile in different frames are
+ * kept apart. Tile caches are keyed by coordinates only: a loader serving
+ * frames should not have one.
+ */
+class TimeFrameTileProvider : public TileProvider {
+public:
+    /**
+     * @param base Provider with {t} in its URL templates
+     * @param time Timestamp substituted for {t}
+     */
+    TimeFrameTileProvider(std::shared_ptr<const TileProvider> base, std::string time);
+
+    /**
+     * @brief Name a frame is registered under ("<base>@<time>")
+     */
+    static std::string MakeName(const std::string& base_name, const std::string& time) {
+        return base_name + "@" + time;
+    }
+
+    std::string BuildTileURL(const TileCoordinates& coords) const override;
+    std::string BuildMirrorURL(const TileCoordinates& coords) const override;
+    std::vector<std::pair<std::string, std::string>> GetHeaders() const override;
+    std::string GetAttribution() const override;
+    std::string GetName() const override;
+    std::int32_t GetMinZoom() const override;
+    std::int32_t GetMaxZoom() const override;
+    std::string GetFormat() const override;
+    std::string GetUserAgent() const override;
+    std::uint32_t GetTimeout() const override;
+    std::uint32_t GetMaxRetries() const override;
+    std::uint32_t GetRetryDelay() const override;
+    std::uint32_t GetSchedulingWeight() const override;
+    std::vector<TileVariant> GetVariants() const override;
+    std::string BuildVariantURL(const TileCoordinates& coords, std::size_t variant) const override;
+
+    /** @brief Get the frame's timestamp */
+    const std::string& GetTime() const { return time_; }
+
+private:
+    std::string ExpandTime(std::string url) const;
+
+    std::shared_ptr<const TileProvider> base_;
+    std::string time_;
+};
 
 
 /**
@@ -159,14 +295,17 @@ struct TileLoadResult {
     
     /** Provider name */
     std::string provider_name;
+    
+    /** Variant downloaded (empty if the provider has none or the tile came from cache) */
+    std::string variant;
 };
 
 /**
  * @brief Tile loader configuration
  */
 struct TileLoaderConfig {
-    /** Maximum concurrent downloads */
-    std::size_t max_concurrent_downloads = 4;
+    /** Maximum concurrent downloads (transfers in flight on the download engine) */
+    std::size_t max_concurrent_downloads = 128;
     
     /** Request timeout in seconds */
     std::uint32_t timeout = 30;
@@ -177,6 +316,56 @@ struct TileLoaderConfig {
     /** Retry delay in milliseconds */
     std::uint32_t retry_delay = 1000;
     
+    /**
+     * Upper bound for retry delays in milliseconds; the provider's retry
+     * delay doubles with every attempt up to this value
+     */
+    std::uint32_t max_retry_delay = 30000;
+    
+    /** Fraction of each retry delay that is randomized (0 = none, 1 = full jitter) */
+    float retry_jitter = 0.5f;
+    
+    /**
+     * Hedged requests: when a download outlasts its host's hedge_percentile
+     * latency, a duplicate goes to the provider's mirror (BuildMirrorURL)
+     * and whichever finishes first wins
+     */
+    bool enable_hedging = true;
+    
+    /** Latency percentile of the primary host that triggers a hedge */
+    double hedge_percentile = 0.95;
+    
+    /** Samples a host needs before its latency histogram drives hedging */
+    std::size_t hedge_min_samples = 20;
+    
+    /** Lower bound for the hedge delay in milliseconds */
+    std::uint32_t hedge_min_delay = 50;
+    
+    /**
+     * Bandwidth-adaptive variants: for providers with GetVariants(), fetch
+     * the richest variant that arrives within variant_target_latency, or
+     * the cheapest one covering required_pixel_scale on a slow link
+     */
+    bool enable_adaptive_variants = true;
+    
+    /** Pixel scale the display needs (device pixel ratio) */
+    float required_pixel_scale = 1.0f;
+    
+    /** Longest acceptable tile wait in milliseconds, queueing included */
+    std::uint32_t variant_target_latency = 1000;
+    
+    /** Re-fetch tiles downloaded in a cheaper variant when the link is idle */
+    bool refine_degraded_tiles = true;
+    
+    /** Most degraded tiles remembered for refinement */
+    std::size_t max_degraded_tiles = 1024;
+    
+    /** Consecutive host failures that open its circuit breaker (0 = disabled) */
+    std::uint32_t circuit_breaker_threshold = 5;
+    
+    /** Time in milliseconds an open circuit fails requests fast before probing the host */
+    std::uint32_t circuit_breaker_cooldown = 30000;
+    
     /** Enable HTTP/2 */
     bool enable_http2 = true;
     
@@ -186,12 +375,37 @@ struct TileLoaderConfig {
     /** Follow redirects */
     bool follow_redirects = true;
     
+    /**
+     * Stale-while-revalidate: serve expired cached tiles immediately and
+     * refresh them with a background conditional GET (If-None-Match /
+     * If-Modified-Since); a 304 only extends the tile's expires_at
+     */
+    bool enable_revalidation = true;
+    
     /** Verify SSL certificates */
     bool verify_ssl = true;
     
     /** Connection cache size */
     std::size_t connection_cache_size = 10;
     
+    /** Maximum requests in flight per host (0 = unlimited); subdomain shards count separately */
+    std::size_t max_requests_per_host = 32;
+    
+    /** Request starts per second per host (0 = unlimited) */
+    double host_requests_per_second = 0.0;
+    
+    /** Request starts per host allowed back to back before the rate limit applies */
+    std::size_t host_request_burst = 8;
+    
+    /** Maximum open connections per host (HTTP/2 multiplexes streams over these) */
+    std::size_t max_connections_per_host = 2;
+    
+    /** Maximum open connections across all hosts */
+    std::size_t max_total_connections = 16;
+    
+    /** Maximum concurrent HTTP/2 streams per connection */
+    std::size_t max_streams_per_connection = 100;
+    
     /** User agent string */
     std::string user_agent = "EarthMap/1.0";
     
@@ -224,6 +438,39 @@ struct TileLoaderStats {
     /** Cached requests (served from cache) */
     std::size_t cached_requests = 0;
     
+    /** Requests that joined a download already in flight for the same tile */
+    std::size_t coalesced_requests = 0;
+    
+    /** Background revalidations issued for expired cached tiles */
+    std::size_t revalidation_requests = 0;
+    
+    /** Revalidations answered 304 Not Modified (no body downloaded) */
+    std::size_t not_modified_responses = 0;
+    
+    /** Retries rescheduled after a failed attempt */
+    std::size_t retried_requests = 0;
+    
+    /** Requests failed fast because their host's circuit breaker was open */
+    std::size_t circuit_rejected_requests = 0;
+    
+    /** Downloads that outlasted the hedge delay and raced a mirror request */
+    std::size_t hedged_requests = 0;
+    
+    /** Hedged downloads won by the mirror request */
+    std::size_t hedge_wins = 0;
+    
+    /** Downloads made in a cheaper variant than the preferred one */
+    std::size_t degraded_loads = 0;
+    
+    /** Degraded tiles replaced by the preferred variant on an idle link */
+    std::size_t refined_loads = 0;
+    
+    /** Estimated link throughput in bytes per second (0 = no sample yet) */
+    double throughput_bytes_per_second = 0.0;
+    
+    /** Download latency per host ("host[:port]") of answered requests */
+    std::unordered_map<std::string, LatencyHistogram> host_latency;
+    
     /** Total bytes downloaded */
     std::uint64_t total_bytes_downloaded = 0;
     
@@ -299,6 +546,11 @@ public:
      * @param cache Tile cache instance
      */
     virtual void SetTileCache(std::shared_ptr<TileCache> cache) = 0;
+
+    /**
+     * @brief Get the tile cache set with SetTileCache() (null if none)
+     */
+    virtual std::shared_ptr<TileCache> GetTileCache() const = 0;
     
     /**
      * @brief Add tile provider
@@ -367,9 +619,46 @@ public:
         TileLoadCallback callback = nullptr,
         const std::string& provider_name = "") = 0;
     
+    /**
+     * @brief Load tile, sharing the download with concurrent requesters
+     * 
+     * Every caller asking for the same (provider, tile) while a download is
+     * in flight receives the same shared future; LoadTile, LoadTileAsync and
+     * PreloadTiles coalesce the same way.
+     * 
+     * @param coordinates Tile coordinates
+     * @param provider_name Provider name (optional, uses default if empty)
+     * @return std::shared_future<TileLoadResult> Shared future for the load result
+     */
+    virtual std::shared_future<TileLoadResult> LoadTileShared(
+        const TileCoordinates& coordinates,
+        const std::string& provider_name = "") {
+        return LoadTileAsync(coordinates, nullptr, provider_name).share();
+    }
+    
+    /**
+     * @brief Load tile, reporting the result only through the callback
+     * 
+     * LoadTileAsync without the future: no promise is allocated for the
+     * request, which makes this the entry point for coroutine awaitables
+     * (see async_loading.h). The callback runs exactly once, either before
+     * this returns (cache hit) or on a loader thread.
+     * 
+     * @param coordinates Tile coordinates
+     * @param callback Load completion callback
+     * @param provider_name Provider name (optional, uses default if empty)
+     */
+    virtual void LoadTileWithCallback(const TileCoordinates& coordinates,
+                                      TileLoadCallback callback,
+                                      const std::string& provider_name = "") {
+        (void)LoadTileAsync(coordinates, std::move(callback), provider_name);
+    }
+    
     /**
      * @brief Cancel tile loading
      * 
+     * Every requester sharing the load receives a "Load cancelled" result.
+     * 
      * @param coordinates Tile coordinates to cancel
      * @return true if cancellation was successful, false otherwise
      */
@@ -441,6 +730,16 @@ public:
      * @return std::string Default provider name
      */
     virtual std::string GetDefaultProvider() const = 0;
+    
+    /**
+     * @brief Set the callback told about refined tiles
+     * 
+     * Called on the download thread after an idle-link refinement replaced a
+     * degraded tile in the cache, so a consumer showing it can reload it.
+     * 
+     * @param callback Refinement callback (empty to clear)
+     */
+    virtual void SetRefinementCallback(TileLoadCallback callback) { (void)callback; }
 
 protected:
     /**
@@ -0,0 +1,283 @@
+#pragma once
+
+/**
+ * @file tile_memory_cache.h
+ * @brief Sharded concurrent in-memory tile store
+ *
+ * Memory tier of BasicTileCache. Tiles are spread over independent shards by
+ * TileCoordinatesHash; each shard has its own lock, map and LRU list, so
+ * threads touching different tiles rarely contend. Only map updates happen
+ * under a shard lock: tiles are stored as immutable shared_ptrs and copied
+ * by callers after the lock is released, and no disk I/O is done here.
+ *
+ * The byte and count budgets are global. When one is exceeded, shards give
+ * up their eviction victim in round-robin order, which approximates a global
+ * policy without ever holding two shard locks at once.
+ *
+ * Victim selection per shard follows TileCacheConfig::EvictionStrategy:
+ * - LRU: intrusive doubly linked list through the entries, O(1) per access
+ * - TIME_BASED: same list in insertion order (access does not reorder), O(1)
+ * - LFU: ordered index on (hit count, last use), O(log n) per access
+ * - SIZE_BASED: ordered index on size, largest first, O(log n) per insert
+ *
+ * Valid tiles are also kept in a linear quadtree TileIndex behind its own
+ * lock (taken after a shard lock, never before), so zoom and bounds queries
+ * cost the size of their result rather than a scan of every shard.
+ */
+
+#include <earth_map/core/flat_hash_map.h>
+#include <earth_map/data/tile_cache.h>
+#include <earth_map/data/tile_index.h>
+#include <earth_map/math/tile_mathematics.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Sharded map of decoded or raw tiles with per-shard eviction order
+ *
+ * Thread Safety: All methods are thread-safe.
+ */
+class ShardedTileMemoryCache {
+public:
+    using EvictionStrategy = TileCacheConfig::EvictionStrategy;
+
+    /// Default number of shards (rounded to a power of two)
+    static constexpr std::size_t kDefaultShardCount = 16;
+
+    /**
+     * @brief Constructor
+     *
+     * @param max_bytes Memory budget for tile data
+     * @param shard_count Number of shards (rounded up to a power of two)
+     * @param strategy Eviction order within each shard
+     */
+    explicit ShardedTileMemoryCache(
+        std::size_t max_bytes,
+        std::size_t shard_count = kDefaultShardCount,
+        EvictionStrategy strategy = EvictionStrategy::LRU);
+
+    // Non-copyable
+    ShardedTileMemoryCache(const ShardedTileMemoryCache&) = delete;
+    ShardedTileMemoryCache& operator=(const ShardedTileMemoryCache&) = delete;
+
+    // Non-movable (shards hold mutexes)
+    ShardedTileMemoryCache(ShardedTileMemoryCache&&) = delete;
+    ShardedTileMemoryCache& operator=(ShardedTileMemoryCache&&) = delete;
+
+    /**
+     * @brief Look up a tile and record the access for the eviction policy
+     *
+     * Also bumps access_count and last_access of the tile's cached metadata
+     * (under the shard lock; readers only ever see copies).
+     *
+     * @return Shared tile, or nullptr if not in memory
+     */
+    std::shared_ptr<const TileData> Get(const TileCoordinates& coords);
+
+    /**
+     * @brief Check if a tile is in memory (does not touch recency)
+     */
+    bool Contains(const TileCoordinates& coords) const;
+
+    /**
+     * @brief Insert or replace a tile, then evict to fit the budget
+     *
+     * The inserted tile is never the one evicted.
+     *
+     * @param tile Tile to store (keyed by tile->metadata.coordinates)
+     * @return Number of tiles evicted
+     */
+    std::size_t Put(std::shared_ptr<const TileData> tile);
+
+    /**
+     * @brief Remove a tile and its metadata (eviction drops metadata too)
+     *
+     * @return true if the tile data was in memory
+     */
+    bool Erase(const TileCoordinates& coords);
+
+    /**
+     * @brief Remove all tiles and metadata
+     */
+    void Clear();
+
+    /**
+     * @brief Change the memory budget, evicting if over it
+     *
+     * @return Number of tiles evicted
+     */
+    std::size_t SetMaxBytes(std::size_t max_bytes);
+
+    /**
+     * @brief Change the tile count budget, evicting if over it
+     *
+     * @return Number of tiles evicted
+     */
+    std::size_t SetMaxCount(std::size_t max_count);
+
+    /**
+     * @brief Switch the eviction policy
+     *
+     * Rebuilds each shard's eviction order (O(n log n)); recency and hit
+     * counts recorded so far are kept.
+     */
+    void SetEvictionStrategy(EvictionStrategy strategy);
+
+    /** @brief Get the current eviction policy */
+    EvictionStrategy GetEvictionStrategy() const {
+        return strategy_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get cached metadata for a tile
+     *
+     * @return Copy taken under the shard lock, or nullptr if none cached
+     */
+    std::shared_ptr<TileMetadata> GetMetadata(const TileCoordinates& coords) const;
+
+    /**
+     * @brief Cache a copy of metadata (keyed by metadata->coordinates)
+     *
+     * Kept until the tile is erased or evicted.
+     */
+    void PutMetadata(std::shared_ptr<TileMetadata> metadata);
+
+    /**
+     * @brief Collect coordinates of tiles matching a predicate
+     *
+     * Shards are visited one at a time; the result is a snapshot.
+     */
+    std::vector<TileCoordinates> CollectIf(
+        const std::function<bool(const TileCoordinates&, const TileData&)>& predicate) const;
+
+    /**
+     * @brief Get coordinates of the valid tiles of one zoom level
+     *
+     * Answered from the spatial index in time linear in the result.
+     */
+    std::vector<TileCoordinates> CollectAtZoom(std::int32_t zoom) const;
+
+    /**
+     * @brief Get coordinates of the valid tiles whose bounds intersect a region
+     *
+     * Answered from the spatial index: only quadtree cells along the
+     * region's edge are searched, so cost follows the result size.
+     *
+     * @param bounds Region in degrees (x = longitude, y = latitude)
+     */
+    std::vector<TileCoordinates> CollectInBounds(const BoundingBox2D& bounds) const;
+
+    /** @brief Get bytes of tile data in memory */
+    std::size_t GetSizeBytes() const { return size_bytes_.load(std::memory_order_relaxed); }
+
+    /** @brief Get number of tiles in memory */
+    std::size_t GetCount() const { return count_.load(std::memory_order_relaxed); }
+
+    /** @brief Get total number of evictions */
+    std::uint64_t GetEvictionCount() const { return evictions_.load(std::memory_order_relaxed); }
+
+    /** @brief Get memory budget */
+    std::size_t GetMaxBytes() const { return max_bytes_.load(std::memory_order_relaxed); }
+
+    /** @brief Get tile count budget */
+    std::size_t GetMaxCount() const { return max_count_.load(std::memory_order_relaxed); }
+
+    /** @brief Get number of shards */
+    std::size_t GetShardCount() const { return shards_.size(); }
+
+private:
+    /// Cache line size used to keep shard locks apart
+    static constexpr std::size_t kCacheLineSize = 64;
+
+    struct Entry;
+
+    /// Position in an ordered (LFU / SIZE_BASED) eviction index
+    struct OrderKey {
+        std::uint64_t primary;
+        std::uint64_t secondary;  ///< Per-shard tick: unique, breaks ties by age
+        Entry* entry;
+
+        bool operator<(const OrderKey& other) const {
+            return primary != other.primary ? primary < other.primary
+                                            : secondary < other.secondary;
+        }
+    };
+
+    /// Heap-allocated so entries can link to each other across map rehashes
+    struct Entry {
+        std::shared_ptr<const TileData> tile;
+        TileCoordinates coords;
+
+        /// Intrusive list links (LRU / TIME_BASED)
+        Entry* prev = nullptr;
+        Entry* next = nullptr;
+
+        /// Ordered index position (LFU / SIZE_BASED)
+        std::set<OrderKey>::iterator order_position;
+
+        std::uint64_t hits = 0;
+        std::uint64_t tick = 0;
+    };
+
+    using EntryMap = TileMap<std::unique_ptr<Entry>>;
+
+    struct alignas(kCacheLineSize) Shard {
+        mutable std::mutex mutex;
+        EntryMap tiles;
+        TileMap<TileMetadata> metadata;
+
+        /// Intrusive list: most recently used / inserted at head, victim at tail
+        Entry* head = nullptr;
+        Entry* tail = nullptr;
+
+        /// Ordered index: victim at begin()
+        std::set<OrderKey> order;
+
+        std::uint64_t clock = 0;
+        EvictionStrategy strategy = EvictionStrategy::LRU;
+    };
+
+    Shard& ShardFor(const TileCoordinates& coords) const;
+    bool OverBudget() const;
+    std::size_t EvictToFit(const TileCoordinates* keep);
+    void RemoveEntryLocked(Shard& shard, EntryMap::iterator it);
+    void UpdateIndex(const TileCoordinates& coords, bool indexed);
+
+    // Eviction order maintenance (shard lock held)
+    static bool UsesList(EvictionStrategy strategy);
+    static void LinkFront(Shard& shard, Entry& entry);
+    static void Unlink(Shard& shard, Entry& entry);
+    static void IndexEntry(Shard& shard, Entry& entry);
+    static void UnindexEntry(Shard& shard, Entry& entry);
+    static void OnAccess(Shard& shard, Entry& entry);
+    static void OnReplace(Shard& shard, Entry& entry);
+    static Entry* FindVictim(const Shard& shard, const TileCoordinates* keep);
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::size_t shard_mask_;
+
+    std::atomic<std::size_t> max_bytes_;
+    std::atomic<std::size_t> max_count_{std::numeric_limits<std::size_t>::max()};
+    std::atomic<EvictionStrategy> strategy_;
+    std::atomic<std::size_t> size_bytes_{0};
+    std::atomic<std::size_t> count_{0};
+    std::atomic<std::uint64_t> evictions_{0};
+
+    /// Next shard asked to give up a tile
+    std::atomic<std::size_t> eviction_cursor_{0};
+
+    /// Valid tiles in memory; locked after a shard lock when both are held
+    mutable std::mutex index_mutex_;
+    std::unique_ptr<TileIndex> index_;
+};
+
+} // namespace earth_map
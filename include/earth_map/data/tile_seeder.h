@@ -0,0 +1,158 @@
+#pragma once
+
+/**
+ * @file tile_seeder.h
+ * @brief Bulk download of a region into the packed disk store
+ *
+ * Pre-seeds the disk cache before going offline: every tile of a region
+ * and zoom range is downloaded with bounded parallelism and a request rate
+ * limit, and written in batches straight into a PackedTileStore (the
+ * BasicTileCache packed backend reads them as regular cached tiles).
+ *
+ * Seeding is resumable: tiles already in the store are skipped, and the
+ * store recovers everything written before an interruption, so running
+ * the same seed again only downloads what is missing.
+ */
+
+#include <earth_map/coordinates/coordinate_spaces.h>
+#include <earth_map/data/packed_tile_store.h>
+#include <earth_map/data/tile_cache.h>
+#include <earth_map/data/tile_loader.h>
+#include <earth_map/math/tile_mathematics.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace earth_map {
+
+// Import coordinate types from coordinates namespace
+using coordinates::GeographicBounds;
+
+/**
+ * @brief Tile seeding configuration
+ */
+struct TileSeedConfig {
+    /** Provider to download from (empty = loader default) */
+    std::string provider_name;
+
+    /** Maximum downloads in flight at once */
+    std::size_t max_parallel_downloads = 8;
+
+    /** Maximum download starts per second (0 = unlimited) */
+    double max_requests_per_second = 10.0;
+
+    /** Skip tiles already in the store (resume) */
+    bool skip_existing = true;
+
+    /** Tiles buffered before they are appended to the store */
+    std::size_t write_batch_size = 64;
+
+    /** Payload compression for stored tiles (unavailable codecs store raw) */
+    TileMetadata::Compression compression = TileMetadata::Compression::NONE;
+};
+
+/**
+ * @brief Tile seeding progress and result
+ */
+struct TileSeedStats {
+    std::size_t total_tiles = 0;       ///< Tiles in the seed
+    std::size_t skipped_tiles = 0;     ///< Already stored (resume)
+    std::size_t downloaded_tiles = 0;  ///< Downloaded and stored
+    std::size_t failed_tiles = 0;      ///< Download or store failures
+    std::uint64_t downloaded_bytes = 0;
+    bool cancelled = false;
+
+    /** Coordinates of failed tiles (retry with Seed(tiles)) */
+    std::vector<TileCoordinates> failures;
+
+    /** @brief Tiles finished so far (skipped, downloaded or failed) */
+    std::size_t GetCompletedTiles() const {
+        return skipped_tiles + downloaded_tiles + failed_tiles;
+    }
+};
+
+/**
+ * @brief Downloads regions into a packed tile store
+ *
+ * The loader should not have a tile cache attached: results go to the
+ * store only, and a cache would keep a copy of every seeded tile.
+ *
+ * Thread Safety: Seed() runs on the calling thread (one seed at a time);
+ * Cancel() may be called from any thread.
+ */
+class TileSeeder {
+public:
+    /// Called on the seeding thread after every finished tile
+    using ProgressCallback = std::function<void(const TileSeedStats&)>;
+
+    /**
+     * @brief Constructor
+     *
+     * @param loader Tile loader used for downloads
+     * @param store Open packed store receiving the tiles
+     * @param config Seeding configuration
+     * @throws std::invalid_argument if loader or store is null
+     */
+    TileSeeder(std::shared_ptr<TileLoader> loader,
+               std::shared_ptr<PackedTileStore> store,
+               const TileSeedConfig& config = TileSeedConfig{});
+
+    // Non-copyable
+    TileSeeder(const TileSeeder&) = delete;
+    TileSeeder& operator=(const TileSeeder&) = delete;
+
+    /**
+     * @brief Enumerate the tiles of a region and zoom range
+     *
+     * Latitudes are clamped to the Web Mercator range.
+     *
+     * @param bounds Region (southwest and northeast corners)
+     * @param min_zoom Lowest zoom level
+     * @param max_zoom Highest zoom level
+     * @return Tiles, lowest zoom first (empty for invalid bounds)
+     */
+    static std::vector<TileCoordinates> EnumerateTiles(const GeographicBounds& bounds,
+                                                       std::int32_t min_zoom,
+                                                       std::int32_t max_zoom);
+
+    /**
+     * @brief Seed a region and zoom range
+     *
+     * Blocks until every tile is stored, failed, or the seed is cancelled.
+     *
+     * @return TileSeedStats Final statistics
+     */
+    TileSeedStats Seed(const GeographicBounds& bounds, std::int32_t min_zoom,
+                       std::int32_t max_zoom, ProgressCallback progress = nullptr);
+
+    /**
+     * @brief Seed an explicit list of tiles
+     */
+    TileSeedStats Seed(const std::vector<TileCoordinates>& tiles,
+                       ProgressCallback progress = nullptr);
+
+    /**
+     * @brief Stop the running seed
+     *
+     * No new downloads start; downloads in flight finish and are stored
+     * before Seed() returns with cancelled set.
+     */
+    void Cancel();
+
+    /**
+     * @brief Get seeding configuration
+     */
+    const TileSeedConfig& GetConfig() const { return config_; }
+
+private:
+    std::shared_ptr<TileLoader> loader_;
+    std::shared_ptr<PackedTileStore> store_;
+    TileSeedConfig config_;
+    std::atomic<bool> cancelled_{false};
+};
+
+} // namespace earth_map
@@ -0,0 +1,135 @@
+#pragma once
+
+/**
+ * @file tile_variant.h
+ * @brief Bandwidth-adaptive choice between encodings of the same tile
+ *
+ * A provider may serve each tile in several variants: @1x or @2x, PNG or
+ * JPEG/WebP at a few quality levels. On a fast link the loader fetches the
+ * richest variant the screen needs; on a slow or congested link (satellite,
+ * tethering) a 512px @2x PNG per tile keeps the pipeline starved, so the
+ * loader fetches the cheapest variant that still covers the screen-space
+ * need and refines it later when the link goes idle.
+ *
+ * The selector estimates the link throughput from completed transfers and
+ * the time a new download would take behind the ones already pending.
+ *
+ * Variants above the tile pool's 256px (@2x, @4x) are reduced to it on the
+ * decode threads (TileLoadWorkerPool::SetUploadTileSize()), so any variant
+ * the selector picks can be shown.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief One encoding of a provider's tiles
+ */
+struct TileVariant {
+    /** Variant name reported in TileLoadResult (e.g. "@2x-png") */
+    std::string name;
+
+    /** Resolution relative to a 256px tile (1 = 256px, 2 = 512px) */
+    float pixel_scale = 1.0f;
+
+    /** Image format (content type suffix) */
+    std::string format = "png";
+
+    /** Lossy quality 1-100; 0 = lossless */
+    std::uint32_t quality = 0;
+
+    /** Typical encoded tile size in bytes, the variant's cost (0 = unknown) */
+    std::size_t expected_bytes = 0;
+};
+
+/**
+ * @brief Variant selection configuration
+ */
+struct TileVariantSelectorConfig {
+    /** Pixel scale the screen needs (device pixel ratio of the view) */
+    float required_pixel_scale = 1.0f;
+
+    /** Longest acceptable wait for a tile, queueing included */
+    std::chrono::milliseconds target_latency{1000};
+
+    /** Weight of the newest transfer in the throughput average */
+    double throughput_smoothing = 0.2;
+
+    /** Pending downloads at or below which the link counts as idle */
+    std::size_t idle_pending_downloads = 0;
+};
+
+/**
+ * @brief Throughput estimate and variant choice
+ *
+ * Thread Safety: Not thread-safe; the loader calls it under its stats lock.
+ */
+class TileVariantSelector {
+public:
+    /// Returned when a provider has no variants
+    static constexpr std::size_t kNoVariant = static_cast<std::size_t>(-1);
+
+    explicit TileVariantSelector(const TileVariantSelectorConfig& config = {});
+
+    /**
+     * @brief Record a completed transfer
+     *
+     * @param bytes Body size
+     * @param elapsed_ms Transfer time
+     * @param concurrent Transfers that shared the link with it (at least 1)
+     */
+    void RecordTransfer(std::size_t bytes, std::uint64_t elapsed_ms, std::size_t concurrent);
+
+    /**
+     * @brief Get the estimated link throughput in bytes per second (0 = no sample yet)
+     */
+    double GetThroughput() const { return throughput_; }
+
+    /**
+     * @brief Get the variant a tile should be downloaded in
+     *
+     * The richest variant that covers the screen-space need and arrives
+     * within target_latency behind the pending downloads; the cheapest
+     * variant covering the need when none does. Without a throughput
+     * sample the preferred variant is chosen.
+     *
+     * @param variants Provider variants
+     * @param pending Downloads queued or in flight
+     * @return Index into variants, kNoVariant if empty
+     */
+    std::size_t Select(const std::vector<TileVariant>& variants, std::size_t pending) const;
+
+    /**
+     * @brief Get the variant a degraded tile is refined to
+     *
+     * The richest variant at the smallest pixel scale covering the need:
+     * more resolution than the screen shows is not worth downloading.
+     *
+     * @return Index into variants, kNoVariant if empty
+     */
+    std::size_t GetPreferred(const std::vector<TileVariant>& variants) const;
+
+    /**
+     * @brief Check whether the link has room for refinements
+     */
+    bool IsIdle(std::size_t pending) const {
+        return throughput_ > 0.0 && pending <= config_.idle_pending_downloads;
+    }
+
+    void SetConfig(const TileVariantSelectorConfig& config) { config_ = config; }
+    const TileVariantSelectorConfig& GetConfig() const { return config_; }
+
+private:
+    /// Variants covering the need (all of the largest scale if none does)
+    std::vector<std::size_t> GetCandidates(const std::vector<TileVariant>& variants) const;
+
+    TileVariantSelectorConfig config_;
+    double throughput_ = 0.0;  ///< Bytes per second of the whole link
+};
+
+} // namespace earth_map
@@ -0,0 +1,144 @@
+#pragma once
+
+/**
+ * @file tile_write_behind_queue.h
+ * @brief Bounded write-behind queue for tile cache disk persistence
+ *
+ * BasicTileCache::Put only updates the memory tier and hands the disk write
+ * to this queue. A dedicated I/O thread drains pending operations in batches
+ * sorted by tile (so writes to the same zoom directory or packed segment are
+ * issued together). Operations on the same tile coalesce: only the newest
+ * state is written. Pending operations stay visible through Find() until
+ * they are on disk, so readers never miss a tile in flight.
+ */
+
+#include <earth_map/data/tile_cache.h>
+#include <earth_map/math/tile_mathematics.h>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief One pending disk operation
+ */
+struct TileDiskOp {
+    enum class Kind {
+        WRITE_TILE,      ///< Write tile data and its metadata
+        WRITE_METADATA,  ///< Write metadata only
+        REMOVE           ///< Delete tile and metadata
+    } kind = Kind::WRITE_TILE;
+
+    TileCoordinates coordinates;
+
+    /** Tile for WRITE_TILE */
+    std::shared_ptr<const TileData> tile;
+
+    /** Metadata for WRITE_METADATA */
+    std::shared_ptr<const TileMetadata> metadata;
+};
+
+/**
+ * @brief Coalescing bounded queue with a dedicated I/O thread
+ *
+ * Thread Safety: All methods are thread-safe.
+ */
+class TileWriteBehindQueue {
+public:
+    /// Executes one batch of operations; called on the I/O thread only
+    using BatchWriter = std::function<void(const std::vector<TileDiskOp>&)>;
+
+    /// Default maximum number of pending tiles
+    static constexpr std::size_t kDefaultCapacity = 1024;
+
+    /// Maximum operations handed to the writer at once
+    static constexpr std::size_t kMaxBatchSize = 256;
+
+    /**
+     * @brief Constructor (starts the I/O thread)
+     *
+     * @param capacity Maximum number of distinct pending tiles
+     * @param writer Batch writer (must not be empty)
+     * @throws std::invalid_argument if writer is empty
+     */
+    TileWriteBehindQueue(std::size_t capacity, BatchWriter writer);
+
+    /**
+     * @brief Destructor: writes everything still pending, then stops
+     */
+    ~TileWriteBehindQueue();
+
+    // Non-copyable
+    TileWriteBehindQueue(const TileWriteBehindQueue&) = delete;
+    TileWriteBehindQueue& operator=(const TileWriteBehindQueue&) = delete;
+
+    /**
+     * @brief Queue an operation, coalescing with a pending one for the tile
+     *
+     * Metadata folds into a pending tile write and is dropped after a pending
+     * removal. Blocks while the queue is full and the tile has nothing pending.
+     */
+    void Enqueue(TileDiskOp op);
+
+    /**
+     * @brief Get the pending operation for a tile, if any
+     */
+    std::optional<TileDiskOp> Find(const TileCoordinates& coordinates) const;
+
+    /**
+     * @brief Block until every operation queued so far is on disk
+     */
+    void Flush();
+
+    /**
+     * @brief Drop pending operations and wait for the batch in flight
+     */
+    void Discard();
+
+    /** @brief Get number of pending tiles */
+    std::size_t Size() const;
+
+    /** @brief Get maximum number of pending tiles */
+    std::size_t Capacity() const { return capacity_; }
+
+    /** @brief Get number of batches written */
+    std::uint64_t GetBatchCount() const;
+
+    /** @brief Get number of operations merged into an already pending one */
+    std::uint64_t GetCoalescedCount() const;
+
+private:
+    struct Pending {
+        TileDiskOp op;
+        std::uint64_t sequence = 0;
+    };
+
+    void Run();
+
+    const std::size_t capacity_;
+    BatchWriter writer_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable space_cv_;
+    std::condition_variable idle_cv_;
+    std::unordered_map<TileCoordinates, Pending, TileCoordinatesHash> pending_;
+    std::uint64_t next_sequence_ = 0;
+    std::uint64_t batches_ = 0;
+    std::uint64_t coalesced_ = 0;
+    bool writing_ = false;
+    bool stop_ = false;
+
+    /// Declared last: started after, and joined before, the state above
+    std::thread thread_;
+};
+
+} // namespace earth_map
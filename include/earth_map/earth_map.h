@@ -19,6 +19,9 @@
 #include <earth_map/data/tile_loader.h>
 #include <earth_map/data/srtm_loader.h>
 #include <earth_map/renderer/elevation_manager.h>
+#include <earth_map/renderer/adaptive_quality_controller.h>
+#include <earth_map/core/metrics_registry.h>
+#include <earth_map/renderer/renderer.h>
 
 namespace earth_map {
 
@@ -47,8 +50,14 @@ struct Configuration {
     /** Maximum number of tiles to keep in memory */
     std::size_t max_tile_count = 1000;
     
-    /** Path to cache directory for tiles */
+    /** Path to cache directory for tiles (under tiles/) and shader program binaries */
     std::string cache_directory = "./cache";
+
+    /** Keep linked shader programs under cache_directory/shaders to skip compilation at startup */
+    bool cache_shader_binaries = true;
+
+    /** Keep the generated globe mesh under cache_directory/meshes to skip tessellation at startup */
+    bool cache_globe_mesh = true;
     
     /** User agent string for tile requests */
     std::string user_agent = "EarthMap/0.1.0";
@@ -59,6 +68,30 @@ struct Configuration {
     /** Tile provider for loading tiles */
     std::shared_ptr<TileProvider> tile_provider;
 
+    /** Store tiles BC1-compressed on the GPU (8x less VRAM, slight quality loss) */
+    bool compress_tile_textures = false;
+
+    /** Store a mip chain per tile on the GPU (a third more VRAM, no shimmer near the horizon) */
+    bool mipmap_tile_textures = true;
+
+    /** Upload tile textures from a second, shared GL context on its own thread */
+    bool async_tile_uploads = false;
+
+    /** Return from Initialize() before the tile cache and loader are ready; tiles come online during later Render() calls */
+    bool progressive_initialization = true;
+
+    /** Raster PMTiles archive with the low-zoom pyramid kept resident in the tile pool (empty = none) */
+    std::string basemap_pack;
+
+    /** Highest zoom of basemap_pack to load (z0-z4 = 341 tiles) */
+    int basemap_max_zoom = 4;
+
+    /** Rendering settings (anisotropic filtering applies to the tile pool) */
+    RenderSettings render_settings;
+
+    /** Lower tile detail while measured frame times exceed the budget (see MakeAdaptiveQualityConfig) */
+    AdaptiveQualityConfig adaptive_quality;
+
     /** Elevation rendering configuration */
     ElevationConfig elevation_config;
 
@@ -205,6 +238,21 @@ public:
       */
     virtual std::string GetPerformanceStats() const = 0;
 
+    /**
+      * @brief Get the registry holding the library's metrics
+      *
+      * Applications may add their own metrics and collectors to it.
+      */
+    virtual MetricsRegistry& GetMetrics() = 0;
+
+    /**
+      * @brief Export every metric: frame, render, tile cache, loader, upload and elevation statistics
+      *
+      * @param format JSON or Prometheus text exposition format
+      * @return std::string Metrics in that format
+      */
+    virtual std::string ExportMetrics(MetricsFormat format) const = 0;
+
 protected:
     /**
      * @brief Protected constructor to enforce factory pattern
@@ -11,10 +11,29 @@
 #include <earth_map/math/bounding_box.h>
 #include <glm/glm.hpp>
 #include <array>
+#include <cstddef>
 #include <cstdint>
 
 namespace earth_map {
 
+/**
+ * @brief Boxes in structure-of-arrays layout for batch frustum tests
+ *
+ * Each field points at one array of count floats. Oriented boxes set all
+ * nine axis arrays; axis-aligned boxes leave them null.
+ */
+struct FrustumBoxBatch {
+    std::array<const float*, 3> center{};                 ///< Box centers (x, y, z arrays)
+    std::array<const float*, 3> extent{};                 ///< Half extents along the box axes
+    std::array<std::array<const float*, 3>, 3> axis{};    ///< axis[a][c]: component c of unit axis a
+    std::size_t count = 0;                                ///< Number of boxes
+
+    /**
+     * @brief Check whether the boxes carry their own axes
+     */
+    bool IsOriented() const { return axis[0][0] != nullptr; }
+};
+
 /**
  * @brief Plane representation for frustum culling
  */
@@ -151,9 +170,10 @@ struct Frustum {
                                            view_projection[2][3] - view_projection[2][2]);
         planes[FAR].distance = view_projection[3][3] - view_projection[3][2];
         
-        // Normalize all plane normals
+        // Normalize planes (normal and distance together, so DistanceTo()
+        // returns world-space distances)
         for (auto& plane : planes) {
-            plane.normal = glm::normalize(plane.normal);
+            plane.Normalize();
         }
     }
     
@@ -201,6 +221,35 @@ struct Frustum {
         return true;
     }
     
+    /**
+     * @brief Number of mask words IntersectsBatch() writes for @p count boxes
+     */
+    static constexpr std::size_t BatchMaskWords(std::size_t count) {
+        return (count + 63) / 64;
+    }
+
+    /**
+     * @brief Check many boxes against the frustum
+     *
+     * Tests 8 (AVX2, selected at runtime) or 4 (SSE2, NEON) boxes per step.
+     * For axis-aligned boxes the result matches Intersects(BoundingBox).
+     *
+     * @param boxes Boxes to test
+     * @param visible_mask Output of BatchMaskWords(boxes.count) words; bit i
+     *        is set if box i is inside or intersects the frustum
+     */
+    void IntersectsBatch(const FrustumBoxBatch& boxes, std::uint64_t* visible_mask) const;
+
+    /**
+     * @brief Portable implementation of IntersectsBatch (exposed for testing)
+     */
+    void IntersectsBatchScalar(const FrustumBoxBatch& boxes, std::uint64_t* visible_mask) const;
+
+    /**
+     * @brief Check whether IntersectsBatch uses SIMD instructions
+     */
+    static bool IsBatchSimdAccelerated();
+
     /**
      * @brief Get frustum corners
      * 
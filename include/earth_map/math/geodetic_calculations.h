@@ -11,6 +11,8 @@
 #include "bounding_box.h"
 #include "projection.h"
 #include <glm/glm.hpp>
+#include <cstddef>
+#include <span>
 #include <string>
 #include <vector>
 #include <array>
@@ -45,6 +47,14 @@ struct DistanceResult {
         : distance(dist), initial_bearing(initial), final_bearing(final) {}
 };
 
+/**
+ * @brief Distance formula for batch geodetic queries
+ */
+enum class DistanceFormula {
+    HAVERSINE,  ///< Great circle on a sphere of the WGS84 semi-major axis
+    VINCENTY    ///< Geodesic on the WGS84 ellipsoid
+};
+
 /**
  * @brief Geodetic calculation utilities
  */
@@ -159,6 +169,87 @@ public:
     static double AlongTrackDistance(const Geographic& point,
                                      const Geographic& path_start,
                                      const Geographic& path_end);
+    
+    /**
+     * @brief Calculate Haversine distances from one point to many
+     * 
+     * Batch form of HaversineDistanceAndBearing() over targets in
+     * structure-of-arrays layout, evaluated with the VectorMath kernels.
+     * 
+     * @param origin Point to measure from
+     * @param latitudes Target latitudes in degrees
+     * @param longitudes Target longitudes in degrees
+     * @param distances Receives the distance to each target in meters
+     * @param initial_bearings Receives the initial bearing to each target
+     *        in degrees [0, 360); leave empty to skip bearings
+     * @throws std::invalid_argument if the spans differ in length
+     */
+    static void HaversineDistances(const Geographic& origin,
+                                   std::span<const double> latitudes,
+                                   std::span<const double> longitudes,
+                                   std::span<double> distances,
+                                   std::span<double> initial_bearings = {});
+    
+    /**
+     * @brief Calculate Vincenty distances from one point to many
+     * 
+     * Batch form of VincentyDistanceAndBearing(). Targets are iterated
+     * together, and each drops out of the iteration once its lambda
+     * converges. Targets that do not converge (nearly antipodal points)
+     * get NaN rather than an exception.
+     * 
+     * @param origin Point to measure from
+     * @param latitudes Target latitudes in degrees
+     * @param longitudes Target longitudes in degrees
+     * @param distances Receives the distance to each target in meters
+     * @param initial_bearings Receives the initial bearing to each target
+     *        in degrees [0, 360); leave empty to skip bearings
+     * @throws std::invalid_argument if the spans differ in length
+     */
+    static void VincentyDistances(const Geographic& origin,
+                                  std::span<const double> latitudes,
+                                  std::span<const double> longitudes,
+                                  std::span<double> distances,
+                                  std::span<double> initial_bearings = {});
+    
+    /**
+     * @brief Calculate the distances between every pair of two point sets
+     * 
+     * @param latitudes_a Latitudes of the first set in degrees
+     * @param longitudes_a Longitudes of the first set in degrees
+     * @param latitudes_b Latitudes of the second set in degrees
+     * @param longitudes_b Longitudes of the second set in degrees
+     * @param distances Receives the row-major matrix of distances in meters:
+     *        distances[i * size_b + j] is from point i of a to point j of b
+     * @param formula Distance formula
+     * @throws std::invalid_argument if the spans do not match the set sizes
+     */
+    static void DistanceMatrix(std::span<const double> latitudes_a,
+                               std::span<const double> longitudes_a,
+                               std::span<const double> latitudes_b,
+                               std::span<const double> longitudes_b,
+                               std::span<double> distances,
+                               DistanceFormula formula = DistanceFormula::HAVERSINE);
+    
+    /**
+     * @brief Find the points within a distance of a center
+     * 
+     * Points outside GeographicBounds::FromCenterRadius() of the center are
+     * rejected before any distance is evaluated.
+     * 
+     * @param center Center point
+     * @param radius Radius in meters
+     * @param latitudes Point latitudes in degrees
+     * @param longitudes Point longitudes in degrees
+     * @param formula Distance formula
+     * @return std::vector<std::size_t> Indices of the points within radius, ascending
+     * @throws std::invalid_argument if the spans differ in length
+     */
+    static std::vector<std::size_t> FindWithinDistance(const Geographic& center,
+                                                       double radius,
+                                                       std::span<const double> latitudes,
+                                                       std::span<const double> longitudes,
+                                                       DistanceFormula formula = DistanceFormula::HAVERSINE);
 };
 
 /**
@@ -169,6 +260,10 @@ public:
     /**
      * @brief Create bounding box from center point and radius
      * 
+     * The box contains the whole circle on a sphere of the WGS84 semi-major
+     * axis. Circles around a pole span all longitudes; otherwise longitudes
+     * may extend past +/-180 when the circle crosses the antimeridian.
+     * 
      * @param center Center geographic point
      * @param radius Radius in meters
      * @return BoundingBox2D Geographic bounding box
@@ -247,6 +342,9 @@ public:
     /**
      * @brief Simplify a path using Douglas-Peucker algorithm
      * 
+     * Distances are great-circle cross-track distances. To extract many
+     * tolerances from one path (e.g. per frame), keep a PolylineLod.
+     * 
      * @param points Original path points
      * @param tolerance Tolerance in meters
      * @return std::vector<Geographic> Simplified path
@@ -337,9 +435,13 @@ public:
     /**
      * @brief Calculate line of sight between two points
      * 
+     * Heights are taken as the altitudes of the points; profile samples
+     * are lowered by the earth's curvature with standard refraction.
+     * 
      * @param observer Observer point
      * @param target Target point
-     * @param terrain_heights Terrain heights along the path (optional)
+     * @param terrain_heights Terrain heights in meters at evenly spaced
+     *        points strictly between observer and target (optional)
      * @return bool True if line of sight is clear, false otherwise
      */
     static bool LineOfSight(const Geographic& observer,
@@ -349,6 +451,9 @@ public:
     /**
      * @brief Calculate viewshed (visible area from a point)
      * 
+     * Coarse 11x11 sampling without terrain; use ComputeViewshed() in
+     * earth_map/data/terrain_viewshed.h for viewsheds over elevation data.
+     * 
      * @param observer Observer point
      * @param bounds Area to analyze
      * @param max_distance Maximum viewing distance in meters
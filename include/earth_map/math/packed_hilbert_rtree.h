@@ -0,0 +1,142 @@
+#pragma once
+
+/**
+ * @file packed_hilbert_rtree.h
+ * @brief Static bulk-loaded R-tree over 3D boxes
+ *
+ * Items are sorted along a 3D Hilbert curve and packed bottom-up into
+ * full nodes, so the whole tree is two flat arrays (node boxes and child
+ * offsets) built in O(n log n) with no per-node allocation. Immutable once
+ * built; SceneIndex layers edits on top.
+ */
+
+#include <earth_map/math/bounding_box.h>
+#include <earth_map/math/frustum.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Item hit by a ray
+ */
+struct RayHit {
+    std::uint32_t item = 0;  ///< Index of the item in the build input
+    float distance = 0.0f;   ///< Distance along the ray to the closest approach
+};
+
+/**
+ * @brief Packed Hilbert R-tree
+ */
+class PackedHilbertRTree {
+public:
+    /** Default children per node */
+    static constexpr std::uint32_t DEFAULT_NODE_SIZE = 16;
+
+    /**
+     * @brief Position of a cell along the 3D Hilbert curve (exposed for testing)
+     *
+     * @param x Cell x, below 2^bits
+     * @param y Cell y, below 2^bits
+     * @param z Cell z, below 2^bits
+     * @param bits Bits per axis (1 to 21)
+     * @return std::uint64_t Curve index; consecutive indices are adjacent cells
+     */
+    static std::uint64_t HilbertIndex(std::uint32_t x, std::uint32_t y, std::uint32_t z,
+                                      std::uint32_t bits);
+
+    /**
+     * @brief Distance along a ray at which it passes within a radius of a box
+     *
+     * Measured at the closest approach to the box center; exact for points.
+     *
+     * @return std::optional<float> Distance, or nothing if the ray misses
+     */
+    static std::optional<float> PickDistance(const BoundingBox& box, const glm::vec3& origin,
+                                             const glm::vec3& direction, float radius);
+
+    /**
+     * @brief Create an empty tree
+     */
+    PackedHilbertRTree() = default;
+
+    /**
+     * @brief Build the tree
+     *
+     * @param boxes Item boxes; items are reported by their index here
+     * @param node_size Children per node (at least 2)
+     */
+    explicit PackedHilbertRTree(std::span<const BoundingBox> boxes,
+                                std::uint32_t node_size = DEFAULT_NODE_SIZE);
+
+    /**
+     * @brief Get the number of items
+     */
+    std::size_t GetItemCount() const { return item_count_; }
+
+    /**
+     * @brief Get the box enclosing all items (invalid if empty)
+     */
+    BoundingBox GetBounds() const { return boxes_.empty() ? BoundingBox() : boxes_.back(); }
+
+    /**
+     * @brief Get the memory held by the tree in bytes
+     */
+    std::size_t GetMemoryUsage() const;
+
+    /**
+     * @brief Append the items whose box intersects a box
+     */
+    void Query(const BoundingBox& box, std::vector<std::uint32_t>& items) const;
+
+    /**
+     * @brief Append the items whose box intersects a frustum
+     *
+     * Subtrees inside the frustum are reported without testing their items.
+     */
+    void Query(const Frustum& frustum, std::vector<std::uint32_t>& items) const;
+
+    /**
+     * @brief Find the item closest to the ray origin within a radius of a ray
+     *
+     * An item is hit if the ray passes within @p radius of its box.
+     *
+     * @param origin Ray origin
+     * @param direction Ray direction (normalized)
+     * @param radius Pick radius (world units)
+     * @param accept If set, items it rejects are ignored
+     * @param max_distance Hits at or beyond this distance are ignored
+     * @return std::optional<RayHit> Nearest hit along the ray, if any
+     */
+    std::optional<RayHit> Pick(const glm::vec3& origin, const glm::vec3& direction, float radius,
+                               const std::function<bool(std::uint32_t)>& accept = {},
+                               float max_distance = std::numeric_limits<float>::max()) const;
+
+private:
+    /// Positions [begin, end) of the children of the node at @p node on @p level (> 0)
+    std::pair<std::size_t, std::size_t> Children(std::size_t node, std::size_t level) const;
+
+    /// Traversal stack size that never reallocates
+    std::size_t StackCapacity() const;
+
+    std::size_t item_count_ = 0;
+    std::uint32_t node_size_ = DEFAULT_NODE_SIZE;
+
+    /// Node boxes: leaves (items in Hilbert order) first, then each level up to the root
+    std::vector<BoundingBox> boxes_;
+
+    /// Per leaf: item index; per inner node: position of its first child
+    std::vector<std::uint32_t> indices_;
+
+    /// End position of each level in boxes_, leaves first
+    std::vector<std::size_t> level_ends_;
+};
+
+} // namespace earth_map
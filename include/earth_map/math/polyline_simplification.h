@@ -0,0 +1,113 @@
+#pragma once
+
+/**
+ * @file polyline_simplification.h
+ * @brief Multi-LOD polyline simplification
+ *
+ * Ranks the vertices of a geographic polyline by significance once, so the
+ * simplification at any tolerance can be extracted per frame in time
+ * proportional to its output.
+ */
+
+#include <earth_map/coordinates/coordinate_spaces.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Vertex ranking used by PolylineLod
+ */
+enum class SimplificationMethod : uint8_t {
+    DouglasPeucker,  ///< Distance to the chord of the range that splits at the vertex
+    Visvalingam      ///< Effective area of the triangle the vertex forms when removed
+};
+
+/**
+ * @brief Polyline with precomputed per-vertex significance
+ *
+ * Significance is in meters on the sphere of GeodeticCalculator::HaversineDistance:
+ * for Douglas-Peucker, the great-circle cross-track distance at which the
+ * vertex is kept, capped by its parent ranges so keeping every vertex above
+ * a tolerance reproduces Douglas-Peucker at that tolerance exactly; for
+ * Visvalingam-Whyatt, the square root of the effective area. Endpoints are
+ * always kept.
+ *
+ * Index lists for the top half, quarter, ... of the vertices are stored in
+ * path order, so Extract filters a list at most twice its output. A
+ * renderer uploads the full vertex buffer once and each frame draws the
+ * indices extracted at its screen-space tolerance, e.g. the ground
+ * resolution (TileMathematics::CalculateGroundResolution) times a pixel.
+ *
+ * Immutable once built, so extraction may run concurrently.
+ */
+class PolylineLod {
+public:
+    /**
+     * @brief Rank the vertices of a polyline
+     *
+     * Douglas-Peucker runs iteratively over an explicit stack (O(n log n)
+     * for typical tracks); Visvalingam uses a heap over the remaining
+     * vertices (O(n log n)).
+     *
+     * @param points Polyline vertices (altitudes ignored)
+     * @param method Vertex ranking
+     * @throws std::invalid_argument if there are more than 2^32 - 1 vertices
+     */
+    explicit PolylineLod(const std::vector<coordinates::Geographic>& points,
+                         SimplificationMethod method = SimplificationMethod::DouglasPeucker);
+
+    /**
+     * @brief Get the number of vertices of the full polyline
+     */
+    size_t GetPointCount() const noexcept { return significance_.size(); }
+
+    /**
+     * @brief Get the vertex ranking
+     */
+    SimplificationMethod GetMethod() const noexcept { return method_; }
+
+    /**
+     * @brief Get the significance of each vertex in meters (infinite at the endpoints)
+     */
+    const std::vector<float>& GetSignificance() const noexcept { return significance_; }
+
+    /**
+     * @brief Count the vertices kept at a tolerance in O(log n)
+     *
+     * @param tolerance Tolerance in meters; vertices more significant are kept
+     * @return size_t Number of vertices Extract returns
+     */
+    size_t CountVertices(double tolerance) const noexcept;
+
+    /**
+     * @brief Extract the simplified polyline at a tolerance
+     *
+     * @param tolerance Tolerance in meters; a negative tolerance keeps every vertex
+     * @param indices Output vertex indices in path order (replaced; its
+     *        capacity is reused across frames)
+     */
+    void Extract(double tolerance, std::vector<uint32_t>& indices) const;
+
+    /**
+     * @brief Get the smallest tolerance keeping at most a number of vertices
+     *
+     * @param max_vertices Vertex budget (at least the two endpoints are kept)
+     * @return double Tolerance in meters for Extract
+     */
+    double GetToleranceForBudget(size_t max_vertices) const noexcept;
+
+    /**
+     * @brief Get memory used by the ranking and index lists in bytes
+     */
+    size_t GetMemoryUsage() const noexcept;
+
+private:
+    std::vector<float> significance_;              ///< Per vertex, in path order
+    std::vector<float> ranked_;                    ///< Significance sorted descending
+    std::vector<std::vector<uint32_t>> levels_;    ///< levels_[k]: top n / 2^(k+1) vertices in path order
+    SimplificationMethod method_;
+};
+
+} // namespace earth_map
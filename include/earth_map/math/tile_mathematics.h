@@ -11,9 +11,16 @@
 #include "projection.h"
 #include "bounding_box.h"
 #include <glm/glm.hpp>
+#include <array>
+#include <bit>
+#include <compare>
 #include <cstdint>
 #include <vector>
 #include <string>
+#include <string_view>
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
 
 namespace earth_map {
 
@@ -48,7 +55,7 @@ struct TileCoordinates {
      * 
      * @return true if valid, false otherwise
      */
-    bool IsValid() const {
+    constexpr bool IsValid() const {
         if (zoom < 0 || zoom > 30) return false;
         const int32_t max_coord = 1 << zoom;
         return x >= 0 && x < max_coord && y >= 0 && y < max_coord;
@@ -115,14 +122,14 @@ struct TileCoordinates {
     /**
      * @brief Equality operator
      */
-    bool operator==(const TileCoordinates& other) const {
+    constexpr bool operator==(const TileCoordinates& other) const {
         return x == other.x && y == other.y && zoom == other.zoom;
     }
     
     /**
      * @brief Inequality operator
      */
-    bool operator!=(const TileCoordinates& other) const {
+    constexpr bool operator!=(const TileCoordinates& other) const {
         return !(*this == other);
     }
     
@@ -164,71 +171,198 @@ struct TileCoordinatesHash {
     // }
 };
 
+namespace detail {
+
+/**
+ * @brief Spread the low 32 bits of a value to its even bits
+ */
+constexpr std::uint64_t SpreadEvenBits(std::uint32_t value) {
+#if defined(__BMI2__)
+    if (!std::is_constant_evaluated()) {
+        return _pdep_u64(value, 0x5555555555555555ull);
+    }
+#endif
+    std::uint64_t bits = value;
+    bits = (bits | (bits << 16)) & 0x0000FFFF0000FFFFull;
+    bits = (bits | (bits << 8)) & 0x00FF00FF00FF00FFull;
+    bits = (bits | (bits << 4)) & 0x0F0F0F0F0F0F0F0Full;
+    bits = (bits | (bits << 2)) & 0x3333333333333333ull;
+    bits = (bits | (bits << 1)) & 0x5555555555555555ull;
+    return bits;
+}
+
+/**
+ * @brief Gather the even bits of a value
+ */
+constexpr std::uint32_t GatherEvenBits(std::uint64_t value) {
+#if defined(__BMI2__)
+    if (!std::is_constant_evaluated()) {
+        return static_cast<std::uint32_t>(_pext_u64(value, 0x5555555555555555ull));
+    }
+#endif
+    std::uint64_t bits = value & 0x5555555555555555ull;
+    bits = (bits | (bits >> 1)) & 0x3333333333333333ull;
+    bits = (bits | (bits >> 2)) & 0x0F0F0F0F0F0F0F0Full;
+    bits = (bits | (bits >> 4)) & 0x00FF00FF00FF00FFull;
+    bits = (bits | (bits >> 8)) & 0x0000FFFF0000FFFFull;
+    bits = (bits | (bits >> 16)) & 0x00000000FFFFFFFFull;
+    return static_cast<std::uint32_t>(bits);
+}
+
+} // namespace detail
+
 /**
  * @brief Quadtree tile key for hierarchical indexing
+ *
+ * Packed into one 64-bit code: a leading 1 bit, then two bits per level
+ * from the root down (x in the low bit, y in the high bit of each pair,
+ * the digits of the Bing quadkey string). The position of the leading bit
+ * gives the zoom, so keys of zooms 0 to 30 fit in 61 bits, sort by zoom
+ * and then along the Z-order curve, and the parent is the code shifted
+ * right by two. Code 0 is the invalid key. Strings are built only by
+ * ToString, for URLs and file names.
  */
 struct QuadtreeKey {
-    std::string key;  ///< Quadtree key string
+    std::uint64_t code = 0;  ///< Packed key (0 = invalid)
     
     /**
-     * @brief Default constructor
+     * @brief Default constructor (invalid key)
      */
-    QuadtreeKey() = default;
+    constexpr QuadtreeKey() = default;
     
     /**
-     * @brief Construct from tile coordinates
+     * @brief Construct from tile coordinates (invalid for invalid tiles)
      * 
      * @param tile Tile coordinates
      */
-    explicit QuadtreeKey(const TileCoordinates& tile);
+    explicit constexpr QuadtreeKey(const TileCoordinates& tile) {
+        if (tile.IsValid()) {
+            code = (std::uint64_t{1} << (2 * tile.zoom)) |
+                   detail::SpreadEvenBits(static_cast<std::uint32_t>(tile.x)) |
+                   (detail::SpreadEvenBits(static_cast<std::uint32_t>(tile.y)) << 1);
+        }
+    }
     
     /**
      * @brief Construct from key string
      * 
-     * @param quadkey Quadtree key string
+     * @param quadkey Quadtree key string (digits 0-3; empty is the zoom 0 tile)
      */
-    explicit QuadtreeKey(const std::string& quadkey);
+    explicit QuadtreeKey(std::string_view quadkey);
+    
+    /**
+     * @brief Construct from a packed code
+     */
+    static constexpr QuadtreeKey FromCode(std::uint64_t packed) {
+        QuadtreeKey key;
+        key.code = packed;
+        return key;
+    }
+    
+    /**
+     * @brief Get the zoom level (-1 if invalid)
+     */
+    constexpr int32_t GetZoom() const {
+        return code == 0 ? -1 : (std::bit_width(code) - 1) / 2;
+    }
     
     /**
      * @brief Convert to tile coordinates
      * 
-     * @return TileCoordinates Tile coordinates
+     * @return TileCoordinates Tile coordinates (zoom 0 tile if invalid)
      */
-    TileCoordinates ToTileCoordinates() const;
+    constexpr TileCoordinates ToTileCoordinates() const {
+        if (!IsValid()) {
+            return TileCoordinates();
+        }
+        const int32_t zoom = GetZoom();
+        const std::uint64_t morton = code ^ (std::uint64_t{1} << (2 * zoom));
+        return TileCoordinates(static_cast<int32_t>(detail::GatherEvenBits(morton)),
+                               static_cast<int32_t>(detail::GatherEvenBits(morton >> 1)), zoom);
+    }
     
     /**
      * @brief Get parent quadtree key
      * 
-     * @return QuadtreeKey Parent key
+     * @return QuadtreeKey Parent key (invalid at zoom 0)
+     */
+    constexpr QuadtreeKey GetParent() const {
+        return FromCode(code >> 2 == 0 ? 0 : code >> 2);
+    }
+    
+    /**
+     * @brief Get a child quadtree key
+     *
+     * @param quadrant Child digit: 0 top-left, 1 top-right, 2 bottom-left, 3 bottom-right
      */
-    QuadtreeKey GetParent() const;
+    constexpr QuadtreeKey GetChild(uint32_t quadrant) const {
+        return FromCode(IsValid() && GetZoom() < 30 ? (code << 2) | (quadrant & 3u) : 0);
+    }
     
     /**
      * @brief Get child quadtree keys
      * 
-     * @return std::array<QuadtreeKey, 4> Array of 4 child keys
+     * @return std::array<QuadtreeKey, 4> Array of 4 child keys, by digit
      */
-    std::array<QuadtreeKey, 4> GetChildren() const;
+    constexpr std::array<QuadtreeKey, 4> GetChildren() const {
+        return {GetChild(0), GetChild(1), GetChild(2), GetChild(3)};
+    }
+    
+    /**
+     * @brief Get the key of the tile offset by whole tiles at the same zoom
+     *
+     * Columns wrap around the antimeridian; rows past the poles give an
+     * invalid key.
+     */
+    constexpr QuadtreeKey GetNeighbor(int32_t dx, int32_t dy) const {
+        if (!IsValid()) {
+            return QuadtreeKey();
+        }
+        const TileCoordinates tile = ToTileCoordinates();
+        const int64_t tiles = int64_t{1} << tile.zoom;
+        const int64_t y = static_cast<int64_t>(tile.y) + dy;
+        if (y < 0 || y >= tiles) {
+            return QuadtreeKey();
+        }
+        const int64_t x = ((static_cast<int64_t>(tile.x) + dx) % tiles + tiles) % tiles;
+        return QuadtreeKey(TileCoordinates(static_cast<int32_t>(x), static_cast<int32_t>(y),
+                                           tile.zoom));
+    }
+    
+    /**
+     * @brief Check if this key's tile contains another's (or is it)
+     */
+    constexpr bool Contains(const QuadtreeKey& other) const {
+        const int32_t depth = other.GetZoom() - GetZoom();
+        return IsValid() && depth >= 0 && (other.code >> (2 * depth)) == code;
+    }
     
     /**
      * @brief Check if key is valid
      * 
      * @return true if valid, false otherwise
      */
-    bool IsValid() const;
+    constexpr bool IsValid() const {
+        return code != 0 && GetZoom() <= 30;
+    }
     
     /**
-     * @brief Equality operator
+     * @brief Quadkey string (one digit per level; empty for zoom 0 or invalid)
      */
-    bool operator==(const QuadtreeKey& other) const {
-        return key == other.key;
-    }
+    std::string ToString() const;
     
     /**
-     * @brief Inequality operator
+     * @brief Order by zoom, then along the Z-order curve
      */
-    bool operator!=(const QuadtreeKey& other) const {
-        return !(*this == other);
+    constexpr auto operator<=>(const QuadtreeKey& other) const = default;
+};
+
+/**
+ * @brief Hash function for QuadtreeKey
+ */
+struct QuadtreeKeyHash {
+    std::size_t operator()(const QuadtreeKey& key) const {
+        return std::hash<std::uint64_t>{}(key.code);
     }
 };
 
@@ -0,0 +1,71 @@
+#pragma once
+
+/**
+ * @file vector_math.h
+ * @brief Vectorized elementary functions over arrays of doubles
+ *
+ * Batch sin/cos, atan2 and log for coordinate transforms of large point
+ * sets. Each kernel evaluates several elements per instruction with a
+ * polynomial approximation (fdlibm/Cephes coefficients) instead of one
+ * libm call per element. Elements outside a kernel's fast range (zeros,
+ * infinities, NaN, subnormals, huge angles) fall back to the std::
+ * function, so every input is handled.
+ *
+ * Outputs may alias their inputs element for element.
+ */
+
+#include <cstddef>
+#include <span>
+
+namespace earth_map {
+
+/**
+ * @brief Batch elementary functions in structure-of-arrays layout
+ */
+class VectorMath {
+public:
+    /// Largest |x| SinCos reduces itself; larger arguments use std::sin/std::cos
+    static constexpr double kMaxSinCosArgument = 65536.0;
+
+    /**
+     * @brief Compute sin and cos of every element
+     *
+     * Error is at most 2 ULP for |x| <= kMaxSinCosArgument (Cody-Waite
+     * reduction by pi/2, then the fdlibm kernel polynomials on [-pi/4, pi/4]).
+     *
+     * @param x Angles in radians
+     * @param sin_out Receives sin(x[i])
+     * @param cos_out Receives cos(x[i])
+     * @throws std::invalid_argument if the spans differ in length
+     */
+    static void SinCos(std::span<const double> x, std::span<double> sin_out,
+                       std::span<double> cos_out);
+
+    /**
+     * @brief Compute atan2(y[i], x[i]) for every element
+     *
+     * Error is at most 2 ULP (Cephes rational approximation of atan on
+     * [0, 1] after octant reduction).
+     *
+     * @throws std::invalid_argument if the spans differ in length
+     */
+    static void Atan2(std::span<const double> y, std::span<const double> x,
+                      std::span<double> out);
+
+    /**
+     * @brief Compute the natural logarithm of every element
+     *
+     * Error is at most 1 ULP (fdlibm reduction to [sqrt(2)/2, sqrt(2)) and
+     * its degree-14 polynomial in s = f / (2 + f)).
+     *
+     * @throws std::invalid_argument if the spans differ in length
+     */
+    static void Log(std::span<const double> x, std::span<double> out);
+
+    /**
+     * @brief Check whether the kernels run on SIMD lanes on this build
+     */
+    static bool IsSimdAccelerated();
+};
+
+} // namespace earth_map
@@ -71,6 +71,35 @@ public:
      * @return std::unique_ptr<OpenGLContext> New context instance
      */
     static std::unique_ptr<OpenGLContext> Create(const OpenGLConfig& config = OpenGLConfig{});
+
+    /**
+     * @brief Create a hidden context sharing objects with the current context
+     *
+     * The new context shares textures, buffers and sync objects with the
+     * (GLFW) context current on the calling thread and has the same version
+     * and profile. It is not made current: hand it to another thread, which
+     * calls MakeCurrent() there. Must be called on the main thread, and the
+     * context must be destroyed there too.
+     *
+     * @return std::unique_ptr<OpenGLContext> New context, or nullptr if no
+     *         context is current or creation failed
+     */
+    static std::unique_ptr<OpenGLContext> CreateSharedWithCurrent();
+
+    /**
+     * @brief Create a context without a window or display server
+     *
+     * Uses EGL: a surfaceless context where EGL_KHR_surfaceless_context is
+     * available, a 1x1 pbuffer otherwise. Rendering goes to framebuffer
+     * objects (see SnapshotRenderer); SwapBuffers() does nothing. The
+     * context is not made current.
+     *
+     * @param config Requested version and profile (window bits are ignored)
+     * @return std::unique_ptr<OpenGLContext> New context, or nullptr if the
+     *         library was built without EARTH_MAP_WITH_EGL or no EGL display
+     *         is available
+     */
+    static std::unique_ptr<OpenGLContext> CreateHeadless(const OpenGLConfig& config = OpenGLConfig{});
     
     /**
      * @brief Virtual destructor
@@ -90,6 +119,15 @@ public:
      * @return true if context was made current, false otherwise
      */
     virtual bool MakeCurrent() = 0;
+
+    /**
+     * @brief Detach this context from the calling thread
+     *
+     * Call on the thread the context is current on before that thread exits.
+     *
+     * @return true if no context is current on the calling thread afterwards
+     */
+    virtual bool ReleaseCurrent() = 0;
     
     /**
      * @brief Swap buffers (present the rendered frame)
@@ -0,0 +1,131 @@
+#pragma once
+
+/**
+ * @file adaptive_quality_controller.h
+ * @brief Closed-loop quality control from measured frame times
+ *
+ * Each frame the controller is fed the CPU and GPU frame times measured by
+ * GpuFrameProfiler. Their exponential moving averages, divided by the CPU
+ * and GPU budgets, give the frame load; the larger of the two drives a
+ * quality level between 0 (full quality) and max_level. Each level coarsens
+ * tile selection (a higher screen-space error threshold), caps the number
+ * of visible tiles, shrinks the upload budget and, when enabled, lowers
+ * the render resolution scale.
+ *
+ * Quality does not oscillate: the load must stay above degrade_load for
+ * degrade_frames frames to lose a level, and below improve_load for the
+ * longer improve_frames to regain one, and every change restarts both
+ * counts.
+ */
+
+#include <earth_map/renderer/tile_renderer.h>
+#include <cstdint>
+
+namespace earth_map {
+
+struct LODParams;
+
+/**
+ * @brief Adaptive quality configuration
+ */
+struct AdaptiveQualityConfig {
+    bool enabled = true;                  ///< Adjust quality to the measured frame times
+    double target_frame_ms = 1000.0 / 60.0;  ///< CPU time budget per frame
+    double target_gpu_ms = 1000.0 / 60.0;    ///< GPU time budget per frame
+    double degrade_load = 1.1;            ///< Lose a level above this fraction of the budget
+    double improve_load = 0.75;           ///< Regain a level below this fraction of the budget
+    std::uint32_t degrade_frames = 15;    ///< Consecutive frames over budget before degrading
+    std::uint32_t improve_frames = 90;    ///< Consecutive frames under budget before improving
+    double smoothing = 0.1;               ///< EMA weight of the newest frame time
+    std::uint32_t max_level = 6;          ///< Coarsest quality level
+    float texel_error_step = 1.35f;       ///< Screen-space error threshold factor per level
+    float tile_count_step = 0.8f;         ///< Max visible tiles factor per level
+    float upload_budget_step = 0.75f;     ///< Upload budget factor per level
+    bool scale_resolution = false;        ///< Lower the render resolution scale on the coarsest levels
+    float resolution_step = 0.1f;         ///< Resolution scale lost per level past half of max_level
+    float min_resolution_scale = 0.6f;    ///< Lowest render resolution scale
+};
+
+/**
+ * @brief Budgets of the LOD parameters as an adaptive quality configuration
+ *
+ * target_fps becomes the CPU budget, max_gpu_time the GPU budget and
+ * enable_adaptive the enabled flag.
+ */
+AdaptiveQualityConfig MakeAdaptiveQualityConfig(const LODParams& params);
+
+/**
+ * @brief Quality settings of one level, relative to full quality
+ */
+struct QualitySettings {
+    float texel_error_scale = 1.0f;    ///< Multiplier of TileSelectionConfig::max_texel_error
+    float tile_count_scale = 1.0f;     ///< Multiplier of TileRenderConfig::max_visible_tiles
+    float upload_budget_scale = 1.0f;  ///< Multiplier of TileRenderConfig::upload_budget_us
+    float resolution_scale = 1.0f;     ///< Render resolution relative to the window
+};
+
+/**
+ * @brief Frame-time feedback controller for rendering quality
+ *
+ * Thread Safety: Not thread-safe; fed from the render thread.
+ */
+class AdaptiveQualityController {
+public:
+    explicit AdaptiveQualityController(const AdaptiveQualityConfig& config = {});
+
+    /**
+     * @brief Feed the timings of a finished frame
+     *
+     * @param cpu_frame_ms CPU time of the frame
+     * @param gpu_frame_ms GPU time of the latest measured frame (0 = not measured)
+     * @return true if the quality level changed
+     */
+    bool Update(double cpu_frame_ms, double gpu_frame_ms);
+
+    /**
+     * @brief Scale the quality fields of a full-quality tile configuration
+     *
+     * Only max_visible_tiles, upload_budget_us and selection.max_texel_error
+     * are changed; every other field is copied from @p full_quality.
+     */
+    TileRenderConfig Apply(const TileRenderConfig& full_quality) const;
+
+    /**
+     * @brief Get the settings of a quality level
+     */
+    QualitySettings GetSettings(std::uint32_t level) const;
+
+    /**
+     * @brief Get the settings of the current level
+     */
+    QualitySettings GetSettings() const { return GetSettings(level_); }
+
+    /**
+     * @brief Get the current quality level (0 = full quality)
+     */
+    std::uint32_t GetLevel() const { return level_; }
+
+    /**
+     * @brief Get the smoothed frame load (1 = exactly on budget)
+     */
+    double GetLoad() const;
+
+    /**
+     * @brief Return to full quality and forget the measured frame times
+     */
+    void Reset();
+
+    void SetConfig(const AdaptiveQualityConfig& config);
+    const AdaptiveQualityConfig& GetConfig() const { return config_; }
+
+private:
+    AdaptiveQualityConfig config_;
+    std::uint32_t level_ = 0;
+    double cpu_ms_ = 0.0;  ///< Smoothed CPU frame time
+    double gpu_ms_ = 0.0;  ///< Smoothed GPU frame time
+    bool has_samples_ = false;
+    std::uint32_t frames_over_ = 0;
+    std::uint32_t frames_under_ = 0;
+};
+
+} // namespace earth_map
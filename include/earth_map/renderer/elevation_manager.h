@@ -33,6 +33,11 @@ struct ElevationConfig {
 
     /// Maximum elevation value to clamp to (meters)
     float max_elevation = 9000.0f;
+
+    /// Displace per-tile terrain patches on the GPU, with detail following
+    /// the view (false, the default: displace the whole globe mesh once on
+    /// the CPU). Opt-in while the patch path matures.
+    bool gpu_terrain = false;
 };
 
 /// Manages elevation data application to globe mesh vertices
@@ -0,0 +1,33 @@
+#pragma once
+
+/**
+ * @file frame_snapshot.h
+ * @brief Immutable camera state of one frame
+ *
+ * The renderer reads the camera once per frame into a FrameSnapshot and
+ * hands copies to the work that runs off the GL thread (CPU tile
+ * selection), so that work never observes a camera half-way through an
+ * input update.
+ */
+
+#include <earth_map/math/frustum.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+
+namespace earth_map {
+
+/**
+ * @brief Camera state captured at the start of a frame
+ */
+struct FrameSnapshot {
+    std::uint64_t frame_index = 0;         ///< Renderer frame counter
+    glm::mat4 view{1.0f};                  ///< View matrix
+    glm::mat4 projection{1.0f};            ///< Projection matrix
+    Frustum frustum;                       ///< Frustum of projection * view
+    glm::vec3 camera_position{0.0f};       ///< Camera position in world space
+    glm::vec3 camera_velocity{0.0f};       ///< World units per second
+    std::uint32_t viewport_width = 0;      ///< Viewport width in pixels
+    std::uint32_t viewport_height = 0;     ///< Viewport height in pixels
+};
+
+} // namespace earth_map
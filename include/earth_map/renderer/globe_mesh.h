@@ -9,19 +9,22 @@
  * coordinate generation and normal calculation for realistic Earth rendering.
  */
 
+#include <earth_map/core/flat_hash_map.h>
 #include <earth_map/math/bounding_box.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <array>
 #include <vector>
 #include <memory>
 #include <cstdint>
 #include <cstddef>
-#include <unordered_map>
+#include <utility>
 
 namespace earth_map {
 
-// Forward declaration
+// Forward declarations
 class ElevationManager;
+class GlobeMeshCache;
 
 /**
  * @brief Vertex structure for globe mesh
@@ -39,6 +42,9 @@ struct GlobeVertex {
     /** Geographic coordinates (longitude, latitude) */
     glm::vec2 geographic;
 
+    /** Normalized Web Mercator coordinates in tile order (x east, y south, [0, 1]) */
+    glm::vec2 mercator;
+
     /** Subdivision level of this vertex */
     std::uint8_t lod_level = 0;
     
@@ -113,6 +119,64 @@ struct GlobeMeshParams {
     
     /** Maximum edge length for subdivision in meters */
     double max_edge_length = 100000.0;  // 100km
+
+    /** Maximum triangles kept by runtime adaptive LOD */
+    std::size_t lod_triangle_budget = 131072;
+
+    /** Maximum splits and merges per UpdateLOD() call (0 = unlimited) */
+    std::size_t lod_max_operations = 1024;
+};
+
+/**
+ * @brief Range of the index buffer rewritten by an adaptive LOD update
+ */
+struct GlobeIndexRange {
+    /** First index (not triangle) of the range */
+    std::size_t first = 0;
+
+    /** Number of indices in the range */
+    std::size_t count = 0;
+};
+
+/**
+ * @brief Run of triangles drawn with 16-bit indices
+ *
+ * Draw with glDrawElementsBaseVertex(GL_TRIANGLES, count, GL_UNSIGNED_SHORT,
+ * first * sizeof(uint16_t), base_vertex).
+ */
+struct GlobeIndexChunk {
+    /** First index of the chunk in GetVertexIndices16() */
+    std::size_t first = 0;
+
+    /** Number of indices in the chunk */
+    std::size_t count = 0;
+
+    /** Vertex that 16-bit index 0 refers to */
+    std::uint32_t base_vertex = 0;
+};
+
+/**
+ * @brief Globe mesh statistics
+ *
+ * ACMR (average cache miss ratio) is the number of vertex shader
+ * invocations per triangle with a 16-entry FIFO post-transform cache:
+ * 3.0 without reuse, about 0.5 at best on a closed mesh.
+ */
+struct GlobeMeshStatistics {
+    /** Number of vertices */
+    std::size_t vertex_count = 0;
+
+    /** Number of triangles */
+    std::size_t triangle_count = 0;
+
+    /** ACMR of the index order before the last Optimize() (0 if not run) */
+    float acmr_before = 0.0f;
+
+    /** ACMR of the current index order (0 if Optimize() has not run) */
+    float acmr_after = 0.0f;
+
+    /** Number of 16-bit index chunks (0 = 32-bit indices only) */
+    std::size_t index_chunks = 0;
 };
 
 /**
@@ -181,10 +245,59 @@ public:
     /**
      * @brief Get vertex indices for rendering
      * 
-     * @return std::vector<std::uint32_t> Vertex indices for OpenGL rendering
+     * @return const std::vector<std::uint32_t>& Vertex indices for OpenGL rendering
+     */
+    virtual const std::vector<std::uint32_t>& GetVertexIndices() const = 0;
+
+    /**
+     * @brief Get the vertex indices as 16-bit offsets from each chunk's base vertex
+     *
+     * Same triangles as GetVertexIndices(). Empty unless Optimize() could
+     * cover the whole static mesh with chunks (see GetIndexChunks()).
+     *
+     * @return const std::vector<std::uint16_t>& Chunk-relative indices
+     */
+    virtual const std::vector<std::uint16_t>& GetVertexIndices16() const = 0;
+
+    /**
+     * @brief Get the chunks of GetVertexIndices16()
+     *
+     * @return const std::vector<GlobeIndexChunk>& Chunks in drawing order
      */
-    virtual std::vector<std::uint32_t> GetVertexIndices() const = 0;
+    virtual const std::vector<GlobeIndexChunk>& GetIndexChunks() const = 0;
     
+    /**
+     * @brief Get the mesh revision
+     *
+     * Changes whenever the vertices or indices change, so a GPU copy tagged
+     * with the revision it was uploaded at knows whether it is current.
+     *
+     * @return std::uint64_t Current revision
+     */
+    virtual std::uint64_t GetRevision() const = 0;
+
+    /**
+     * @brief Get the revision that GetDirtyIndexRanges() applies to
+     *
+     * A copy at this revision catches up by uploading the dirty index ranges
+     * and the vertices appended after its vertex count. Any other copy must
+     * upload everything.
+     *
+     * @return std::uint64_t Base revision, or kNoBaseRevision if the last
+     *         change replaced the mesh
+     */
+    virtual std::uint64_t GetDirtyBaseRevision() const = 0;
+
+    /**
+     * @brief Get the index ranges changed since GetDirtyBaseRevision()
+     *
+     * @return Sorted, non-overlapping ranges within GetVertexIndices()
+     */
+    virtual const std::vector<GlobeIndexRange>& GetDirtyIndexRanges() const = 0;
+
+    /** GetDirtyBaseRevision() after a change that replaced the whole mesh */
+    static constexpr std::uint64_t kNoBaseRevision = ~std::uint64_t{0};
+
     /**
      * @brief Get mesh parameters
      * 
@@ -212,6 +325,13 @@ public:
      * @return std::pair<std::size_t, std::size_t> Number of (vertices, triangles)
      */
     virtual std::pair<std::size_t, std::size_t> GetStatistics() const = 0;
+
+    /**
+     * @brief Get mesh statistics including vertex cache efficiency
+     *
+     * @return GlobeMeshStatistics Counts, ACMR and index chunks
+     */
+    virtual GlobeMeshStatistics GetDetailedStatistics() const = 0;
     
     /**
      * @brief Validate mesh integrity
@@ -223,8 +343,10 @@ public:
     /**
      * @brief Optimize mesh for GPU rendering
      * 
-     * Optimizes vertex ordering and triangle connectivity for
-     * improved GPU cache performance.
+     * Reorders the static mesh's triangles for the post-transform vertex
+     * cache, then its vertices in first-use order for fetch locality, and
+     * splits the indices into 16-bit chunks where each chunk's vertices fit
+     * in 65536 consecutive ones. The adaptive LOD layout is left as is.
      * 
      * @return true if optimization succeeded, false otherwise
      */
@@ -269,9 +391,20 @@ protected:
  * 
  * Implements globe mesh generation using icosahedron subdivision
  * with adaptive tessellation for optimal performance.
+ *
+ * With adaptive LOD enabled, UpdateLOD() refines the mesh incrementally:
+ * every triangle is a node of a 4-way subdivision hierarchy rooted at the
+ * 20 icosahedron faces. Each call merges sibling groups whose screen-space
+ * error dropped below the threshold, then splits the leaves with the
+ * largest error first, within GlobeMeshParams::lod_triangle_budget
+ * triangles and lod_max_operations changes. Neighboring triangles differ
+ * by at most one level (splits force coarser neighbors to split first).
  */
 class IcosahedronGlobeMesh : public GlobeMesh {
 public:
+    /** Indices per triangle block once adaptive LOD has run */
+    static constexpr std::size_t kIndicesPerLodTriangle = 12;
+
     explicit IcosahedronGlobeMesh(const GlobeMeshParams& params);
     
     bool Generate() override;
@@ -282,13 +415,18 @@ public:
     
     const std::vector<GlobeVertex>& GetVertices() const override;
     const std::vector<GlobeTriangle>& GetTriangles() const override;
-    std::vector<std::uint32_t> GetVertexIndices() const override;
+    const std::vector<std::uint32_t>& GetVertexIndices() const override;
+    const std::vector<std::uint16_t>& GetVertexIndices16() const override;
+    const std::vector<GlobeIndexChunk>& GetIndexChunks() const override;
+    std::uint64_t GetRevision() const override;
+    std::uint64_t GetDirtyBaseRevision() const override;
     
     GlobeMeshParams GetParameters() const override;
     void SetQuality(MeshQuality quality) override;
     MeshQuality GetQuality() const override;
     
     std::pair<std::size_t, std::size_t> GetStatistics() const override;
+    GlobeMeshStatistics GetDetailedStatistics() const override;
     bool Validate() const override;
     bool Optimize() override;
     BoundingBox2D CalculateBounds() const override;
@@ -305,13 +443,86 @@ public:
      */
     void SetElevationManager(std::shared_ptr<ElevationManager> manager);
 
+    /**
+     * @brief Set the cache Generate() restores meshes from and stores them to
+     *
+     * Meshes displaced by an elevation manager are always generated.
+     *
+     * @param cache Mesh cache (null = always generate)
+     */
+    void SetMeshCache(std::shared_ptr<GlobeMeshCache> cache);
+
+    /**
+     * @brief Get the index ranges changed by the last UpdateLOD()
+     *
+     * Once adaptive LOD has run, the index buffer holds a block of
+     * kIndicesPerLodTriangle indices for each entry of GetTriangles(): the
+     * triangle fanned out to the midpoints of edges shared with finer
+     * neighbors, so the mesh has no T-junction cracks, padded with
+     * degenerate triangles. Splits and merges rewrite only the blocks of
+     * the triangles involved and their neighbors, and the buffer grows or
+     * shrinks at its end. Vertices are only ever appended. The first update
+     * replaces the mesh (see GetDirtyBaseRevision()).
+     *
+     * @return Sorted, non-overlapping ranges within GetVertexIndices()
+     */
+    const std::vector<GlobeIndexRange>& GetDirtyIndexRanges() const override;
+
 private:
+    static constexpr std::uint32_t kNoLodNode = ~std::uint32_t{0};
+
+    /**
+     * @brief Triangle of the adaptive LOD hierarchy
+     */
+    struct LodNode {
+        std::array<std::uint32_t, 3> vertices{};
+        std::uint32_t parent = kNoLodNode;
+        std::uint32_t first_child = kNoLodNode;  ///< Four consecutive nodes
+        std::uint32_t slot = kNoLodNode;         ///< Index in triangles_ while a leaf
+        std::uint8_t level = 0;
+    };
+
+    /**
+     * @brief Split or merge candidate, ordered by screen-space error
+     */
+    struct LodCandidate {
+        float priority;
+        std::uint32_t node;
+    };
+
+    struct LodView;
+
     GlobeMeshParams params_;
     std::vector<GlobeVertex> vertices_;
     std::vector<GlobeTriangle> triangles_;
     std::vector<std::uint32_t> vertex_indices_;
-    std::unordered_map<std::uint64_t, std::size_t> midpoint_cache_;
+    std::vector<std::uint16_t> vertex_indices16_;
+    std::vector<GlobeIndexChunk> index_chunks_;
+    float acmr_before_ = 0.0f;
+    float acmr_after_ = 0.0f;
+    std::uint64_t revision_ = 0;
+    std::uint64_t dirty_base_revision_ = kNoBaseRevision;
+    FlatHashMap<std::uint64_t, std::uint32_t> midpoint_cache_;
     std::shared_ptr<ElevationManager> elevation_manager_;
+    std::shared_ptr<GlobeMeshCache> mesh_cache_;
+
+    // Adaptive LOD hierarchy. Leaves own the triangles_ slots; leaf edges
+    // map to the (up to two) leaves sharing them.
+    std::vector<LodNode> lod_nodes_;
+    std::vector<std::uint32_t> lod_slot_nodes_;
+    FlatHashMap<std::uint64_t, std::array<std::uint32_t, 2>> lod_edges_;
+    std::vector<std::uint32_t> lod_free_blocks_;
+    std::vector<std::uint32_t> lod_released_blocks_;
+    std::vector<std::uint32_t> lod_dirty_nodes_;
+    std::vector<LodCandidate> lod_split_queue_;
+    std::vector<LodCandidate> lod_merge_queue_;
+    std::vector<GlobeIndexRange> dirty_index_ranges_;
+
+    // Triangle bounds (SoA) and visibility bits for batch frustum culling,
+    // kept between UpdateLOD() calls to avoid reallocating every frame
+    std::array<std::vector<float>, 3> cull_centers_;
+    std::array<std::vector<float>, 3> cull_extents_;
+    std::vector<std::uint64_t> cull_mask_;
 
     /**
      * @brief Generate icosahedron base mesh
@@ -331,7 +542,10 @@ private:
     void SubdivideTriangle(const GlobeTriangle& triangle, std::uint8_t target_level);
     
     /**
-     * @brief Subdivide mesh to target level
+     * @brief Subdivide the base faces to target level
+     *
+     * Faces are subdivided in parallel as triangular grids with fixed
+     * vertex indices, so shared edges need no midpoint lookup.
      */
     void SubdivideToLevel(std::uint8_t target_level);
     
@@ -354,6 +568,11 @@ private:
      * @brief Calculate UV coordinates from geographic coordinates
      */
     glm::vec2 GeographicToUV(const glm::vec2& geographic) const;
+
+    /**
+     * @brief Calculate normalized Web Mercator coordinates from geographic coordinates
+     */
+    glm::vec2 GeographicToMercator(const glm::vec2& geographic) const;
     
     /**
      * @brief Calculate screen-space error for triangle
@@ -379,14 +598,97 @@ private:
     void PreventCracks();
     
     /**
-     * @brief Optimize vertex ordering for GPU cache
+     * @brief Reorder triangles for the vertex cache (per icosahedron face),
+     *        then vertices by first use
+     *
+     * The 12 icosahedron corners keep indices 0-11 for BuildLodHierarchy().
      */
     void OptimizeVertexOrder();
+
+    /**
+     * @brief Split vertex_indices_ into 16-bit chunks, or clear them if too fragmented
+     */
+    void BuildIndexChunks();
+
+    /**
+     * @brief Start a new revision that GPU copies must upload in full
+     */
+    void MarkMeshReplaced();
     
     /**
      * @brief Calculate triangle geographic bounds
      */
     BoundingBox2D CalculateTriangleBounds(const GlobeTriangle& triangle) const;
+
+    /**
+     * @brief Rebuild the adaptive LOD hierarchy from the icosahedron faces
+     */
+    void BuildLodHierarchy(const LodView& view);
+
+    /**
+     * @brief Merge low-error sibling groups, then split high-error leaves
+     */
+    void RefineLod(const LodView& view, std::size_t max_operations);
+
+    /**
+     * @brief Split a leaf into four, splitting coarser neighbors first
+     *
+     * @return false if the triangle budget does not allow it
+     */
+    bool SplitLodNode(std::uint32_t node, const LodView& view, std::size_t& operations);
+
+    /**
+     * @brief Replace the four leaf children of a node by the node itself
+     */
+    void MergeLodNode(std::uint32_t node, const LodView& view);
+
+    /**
+     * @brief Check that a node's children are leaves and no neighbor is finer
+     */
+    bool CanMergeLodNode(std::uint32_t node) const;
+
+    /**
+     * @brief Screen-space error of a node, or 0 if it is not visible
+     */
+    float LodPriority(const LodNode& node, const LodView& view) const;
+
+    /**
+     * @brief Make a node a leaf, in @p slot or a new slot at the end
+     */
+    void AddLodLeaf(std::uint32_t node, std::uint32_t slot, const LodView& view);
+
+    /**
+     * @brief Remove the leaf in the last slot's place, moving the last leaf
+     */
+    void ReleaseLodSlot(std::uint32_t slot);
+
+    void RegisterLodEdges(std::uint32_t node);
+    void UnregisterLodEdges(std::uint32_t node);
+
+    /**
+     * @brief Other leaf sharing edge (a, b) with @p node, or kNoLodNode
+     */
+    std::uint32_t LodEdgePartner(std::uint32_t a, std::uint32_t b, std::uint32_t node) const;
+
+    /**
+     * @brief Check whether the leaf across edge (a, b) is one level finer
+     */
+    bool IsLodEdgeSplit(std::uint32_t a, std::uint32_t b) const;
+
+    /**
+     * @brief Find the coarser leaf across edge @p edge of a node, or kNoLodNode
+     */
+    std::uint32_t CoarserLodNeighbor(std::uint32_t node, int edge) const;
+
+    /**
+     * @brief Write the index block of a leaf
+     */
+    void WriteLodIndices(std::uint32_t node);
+
+    /**
+     * @brief Write dirty index blocks, record their ranges and elevate new vertices
+     */
+    void FlushLodChanges(std::size_t first_new_vertex);
 };
 
 } // namespace earth_map
\ No newline at end of file
@@ -0,0 +1,125 @@
+#pragma once
+
+/**
+ * @file globe_mesh_cache.h
+ * @brief On-disk cache of generated globe meshes
+ *
+ * A static icosahedron mesh depends only on its GlobeMeshParams, yet
+ * subdivision, vertex cache optimization and index chunking take a
+ * noticeable part of startup at high subdivision levels. IcosahedronGlobeMesh
+ * stores the final arrays here and later restores them instead of
+ * generating the mesh again.
+ *
+ * Files hold the arrays back to back in their in-memory layout behind a
+ * small header, and are read through mmap so loading is one bulk copy per
+ * array. Entries are keyed by a hash of the parameters and the vertex and
+ * triangle layouts; a checksum of the arrays turns truncated or corrupt
+ * files into misses. Meshes displaced by elevation data are not cached.
+ *
+ * Uses POSIX file and mmap APIs.
+ */
+
+#include <earth_map/renderer/globe_mesh.h>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Arrays of a generated mesh, as written to the cache
+ */
+struct GlobeMeshArraysView {
+    std::span<const GlobeVertex> vertices;
+    std::span<const GlobeTriangle> triangles;
+    std::span<const std::uint32_t> indices;
+    std::span<const std::uint16_t> indices16;
+    std::span<const GlobeIndexChunk> index_chunks;
+    float acmr_before = 0.0f;  ///< Vertex cache miss ratio before optimization
+    float acmr_after = 0.0f;   ///< Vertex cache miss ratio after optimization
+};
+
+/**
+ * @brief Arrays of a mesh restored from the cache
+ */
+struct GlobeMeshArrays {
+    std::vector<GlobeVertex> vertices;
+    std::vector<GlobeTriangle> triangles;
+    std::vector<std::uint32_t> indices;
+    std::vector<std::uint16_t> indices16;
+    std::vector<GlobeIndexChunk> index_chunks;
+    float acmr_before = 0.0f;
+    float acmr_after = 0.0f;
+};
+
+/**
+ * @brief Globe mesh cache statistics
+ */
+struct GlobeMeshCacheStats {
+    std::uint64_t hits = 0;      ///< Meshes restored from a file
+    std::uint64_t misses = 0;    ///< Meshes generated (no file)
+    std::uint64_t rejected = 0;  ///< Corrupt or mismatched files
+    std::uint64_t stores = 0;    ///< Meshes written
+};
+
+/**
+ * @brief Directory of generated globe meshes keyed by their parameters
+ *
+ * Thread Safety: Load() and Store() may run concurrently; concurrent stores
+ * of one key leave one complete file.
+ */
+class GlobeMeshCache {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param directory Directory holding the meshes (created on first store)
+     */
+    explicit GlobeMeshCache(std::string directory);
+
+    /**
+     * @brief Cache key of the mesh generated from @p params
+     *
+     * @return 64-bit FNV-1a hash of the parameters and the array layouts
+     */
+    static std::uint64_t MakeKey(const GlobeMeshParams& params);
+
+    /**
+     * @brief Read a mesh
+     *
+     * @return The arrays, or nullopt if absent or corrupt
+     */
+    std::optional<GlobeMeshArrays> Load(std::uint64_t key) const;
+
+    /**
+     * @brief Write a mesh, replacing any previous one atomically
+     *
+     * @return true if the file was written
+     */
+    bool Store(std::uint64_t key, const GlobeMeshArraysView& mesh) const;
+
+    /**
+     * @brief Get statistics
+     */
+    GlobeMeshCacheStats GetStats() const;
+
+    /**
+     * @brief Get the cache directory
+     */
+    const std::string& GetDirectory() const { return directory_; }
+
+private:
+    std::string GetPath(std::uint64_t key) const;
+
+    std::string directory_;
+    mutable std::atomic<std::uint64_t> hits_{0};
+    mutable std::atomic<std::uint64_t> misses_{0};
+    mutable std::atomic<std::uint64_t> rejected_{0};
+    mutable std::atomic<std::uint64_t> stores_{0};
+    mutable std::atomic<std::uint64_t> temp_counter_{0};
+};
+
+} // namespace earth_map
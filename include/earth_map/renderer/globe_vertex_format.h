@@ -0,0 +1,81 @@
+#pragma once
+
+/**
+ * @file globe_vertex_format.h
+ * @brief Packed GPU vertex layout for the globe mesh
+ *
+ * GlobeVertex holds everything the CPU side uses (about 48 bytes). The
+ * GPU gets 16 bytes per vertex instead: the position as three floats and
+ * the normal octahedral-encoded in two snorm16 components. Texture and
+ * Web Mercator coordinates are not stored; the shaders derive them from
+ * the position's direction, which is as precise as the float coordinates
+ * uploaded before. Mercator is projected per fragment from the
+ * interpolated direction (see DirectionToMercator). Normals are kept
+ * because elevation bends them away from the sphere's.
+ *
+ * Attribute setup:
+ *   location 0: 3 x GL_FLOAT, offset 0
+ *   location 1: 2 x GL_SHORT normalized, offset 12 (decode with octDecode)
+ */
+
+#include <earth_map/renderer/globe_mesh.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Globe mesh vertex as uploaded to the GPU
+ */
+struct PackedGlobeVertex {
+    /** Vertex position in 3D space */
+    glm::vec3 position;
+
+    /** Octahedral-encoded unit normal (snorm16) */
+    std::array<std::int16_t, 2> normal;
+};
+
+static_assert(sizeof(PackedGlobeVertex) == 16, "PackedGlobeVertex attribute offsets and stride");
+
+/**
+ * @brief Encode a unit normal onto the octahedron, as two snorm16 values
+ *
+ * The decoded normal is within about 1e-4 radians of the input.
+ */
+std::array<std::int16_t, 2> EncodeOctahedralNormal(const glm::vec3& normal);
+
+/**
+ * @brief Decode an octahedral normal (CPU counterpart of the shaders' octDecode)
+ */
+glm::vec3 DecodeOctahedralNormal(const std::array<std::int16_t, 2>& encoded);
+
+/**
+ * @brief Normalized Web Mercator of a direction (CPU counterpart of the tile fragment shader)
+ *
+ * The direction need not be unit length: fragments pass the interpolated
+ * vertex direction. Latitude is clamped to the Web Mercator limit.
+ *
+ * @param direction Direction from the globe center (longitude 0 on +Z, north on +Y)
+ * @return glm::vec2 Mercator x east and y south, in [0, 1]
+ */
+glm::vec2 DirectionToMercator(const glm::vec3& direction);
+
+/**
+ * @brief Pack globe mesh vertices for upload
+ *
+ * @param vertices Mesh vertices
+ * @param[out] packed One packed vertex per input vertex
+ * @throws std::invalid_argument if the spans differ in length
+ */
+void PackGlobeVertices(std::span<const GlobeVertex> vertices,
+                       std::span<PackedGlobeVertex> packed);
+
+/**
+ * @brief Pack globe mesh vertices for upload
+ */
+std::vector<PackedGlobeVertex> PackGlobeVertices(std::span<const GlobeVertex> vertices);
+
+} // namespace earth_map
@@ -0,0 +1,196 @@
+#pragma once
+
+/**
+ * @file gpu_frame_profiler.h
+ * @brief Per-pass CPU and GPU timing of rendered frames
+ *
+ * Each render pass is bracketed by a Scope that measures the CPU time spent
+ * submitting it and, when GL is available, the GPU time between two
+ * GL_TIMESTAMP queries around it. Query sets are double-buffered per frame
+ * and read back only once GL_QUERY_RESULT_AVAILABLE reports them done, so
+ * the profiler never waits for the GPU; a set still in flight skips its
+ * frame instead. GPU timings therefore lag the CPU ones by a frame or two.
+ *
+ * Timestamps rather than GL_TIME_ELAPSED queries are used because elapsed
+ * queries cannot nest, and the tile upload scheduler already runs one
+ * inside the upload pass.
+ *
+ * With EARTH_MAP_HAVE_TRACY the timings are also plotted in Tracy and each
+ * EndFrame() emits a frame mark.
+ */
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace earth_map {
+
+/**
+ * @brief Render passes timed by GpuFrameProfiler, in frame order
+ */
+enum class RenderPass : std::uint8_t {
+    UPLOADS,            ///< Tile texture uploads (TileTextureCoordinator::ProcessUploads)
+    INDIRECTION_FLUSH,  ///< Indirection texture updates
+    GLOBE,              ///< Globe mesh or terrain patches with their tile textures
+    TILE_FEEDBACK,      ///< Tile feedback pass
+    PLACEMARKS,         ///< Placemarks
+    LABELS,             ///< Label placement and glyphs
+    MINI_MAP            ///< Mini-map texture and overlay
+};
+
+/// Number of RenderPass values
+inline constexpr std::size_t kRenderPassCount = 7;
+
+/**
+ * @brief Get a render pass name ("uploads", "globe", ...)
+ */
+const char* GetRenderPassName(RenderPass pass);
+
+/**
+ * @brief Time spent on one render pass in a frame
+ */
+struct RenderPassTiming {
+    double cpu_ms = 0.0;  ///< Submission time on the render thread
+    double gpu_ms = 0.0;  ///< GPU execution time (0 without timer queries)
+};
+
+/**
+ * @brief Per-pass CPU/GPU frame timer
+ *
+ * Thread Safety: GL thread only.
+ */
+class GpuFrameProfiler {
+public:
+    /// Query sets in flight; results are read two frames after they were issued
+    static constexpr std::size_t kQueryFrames = 2;
+
+    /**
+     * @brief Times one pass for the lifetime of the scope
+     */
+    class Scope {
+    public:
+        /**
+         * @param profiler Profiler (null = no timing)
+         * @param pass Pass being rendered
+         */
+        Scope(GpuFrameProfiler* profiler, RenderPass pass) : profiler_(profiler), pass_(pass) {
+            if (profiler_) {
+                profiler_->BeginPass(pass_);
+            }
+        }
+
+        ~Scope() {
+            if (profiler_) {
+                profiler_->EndPass(pass_);
+            }
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        GpuFrameProfiler* profiler_;
+        RenderPass pass_;
+    };
+
+    /**
+     * @brief Constructor
+     *
+     * @param use_timer_queries Create GL timestamp queries (false = CPU timing only)
+     */
+    explicit GpuFrameProfiler(bool use_timer_queries);
+
+    ~GpuFrameProfiler();
+
+    GpuFrameProfiler(const GpuFrameProfiler&) = delete;
+    GpuFrameProfiler& operator=(const GpuFrameProfiler&) = delete;
+
+    /**
+     * @brief Start a frame
+     *
+     * Collects finished GPU timings of earlier frames and clears this
+     * frame's CPU timings.
+     */
+    void BeginFrame();
+
+    /**
+     * @brief End a frame; its CPU timings become the reported ones
+     */
+    void EndFrame();
+
+    /**
+     * @brief Start timing a pass (prefer Scope)
+     *
+     * A pass entered several times in one frame accumulates its CPU time;
+     * its GPU time spans the first begin to the last end.
+     */
+    void BeginPass(RenderPass pass);
+
+    /**
+     * @brief Stop timing a pass started with BeginPass()
+     */
+    void EndPass(RenderPass pass);
+
+    /**
+     * @brief Get the latest timing of every pass
+     *
+     * CPU times are from the last ended frame, GPU times from the last
+     * frame whose queries have completed.
+     */
+    const std::array<RenderPassTiming, kRenderPassCount>& GetTimings() const {
+        return timings_;
+    }
+
+    /**
+     * @brief Get the latest timing of one pass
+     */
+    const RenderPassTiming& GetTiming(RenderPass pass) const {
+        return timings_[static_cast<std::size_t>(pass)];
+    }
+
+    /**
+     * @brief Get the summed GPU time of all passes of the last measured frame
+     */
+    double GetGpuFrameMs() const { return gpu_frame_ms_; }
+
+    /**
+     * @brief Get the CPU time between the last BeginFrame() and EndFrame()
+     */
+    double GetCpuFrameMs() const { return cpu_frame_ms_; }
+
+    /**
+     * @brief Check whether GPU times are measured
+     */
+    bool HasGpuTimings() const { return use_timer_queries_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /// Begin and end timestamp queries of one pass
+    struct PassQueries {
+        std::uint32_t begin = 0;
+        std::uint32_t end = 0;
+        bool issued = false;   ///< Both timestamps were recorded this frame
+        bool pending = false;  ///< Results not read back yet
+    };
+
+    using QuerySet = std::array<PassQueries, kRenderPassCount>;
+
+    void CollectQueries();
+    void PublishTracy() const;
+
+    bool use_timer_queries_;
+    std::array<QuerySet, kQueryFrames> query_sets_{};
+    std::size_t frame_index_ = 0;
+
+    std::array<Clock::time_point, kRenderPassCount> pass_start_{};
+    std::array<double, kRenderPassCount> frame_cpu_ms_{};
+    Clock::time_point frame_start_{};
+
+    std::array<RenderPassTiming, kRenderPassCount> timings_{};
+    double gpu_frame_ms_ = 0.0;
+    double cpu_frame_ms_ = 0.0;
+};
+
+} // namespace earth_map
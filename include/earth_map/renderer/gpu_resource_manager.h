@@ -0,0 +1,131 @@
+#pragma once
+
+/**
+ * @file gpu_resource_manager.h
+ * @brief GPU-resident copies of globe meshes
+ *
+ * Each globe mesh gets one vertex array with its vertex and index buffers,
+ * shared by every pass that draws it. SyncGlobeMesh() is called once per
+ * frame and compares revisions (GlobeMesh::GetRevision()), so an unchanged
+ * mesh costs nothing. After an incremental adaptive LOD update it uploads
+ * only the dirty index ranges and the appended vertices, and only a
+ * replaced mesh is uploaded again in full.
+ *
+ * All methods except PlanSync() must be called on the GL thread.
+ */
+
+#include <earth_map/renderer/globe_mesh.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief GPU copy of a globe mesh
+ */
+struct GPUMesh {
+    /** Vertex array with the PackedGlobeVertex attributes and the index buffer */
+    std::uint32_t vao = 0;
+    std::uint32_t vertex_buffer = 0;
+    std::uint32_t index_buffer = 0;
+
+    /** GL_UNSIGNED_SHORT (chunked) or GL_UNSIGNED_INT */
+    std::uint32_t index_type = 0;
+
+    /** Draw calls; a single chunk at base vertex 0 for 32-bit indices */
+    std::vector<GlobeIndexChunk> chunks;
+
+    std::size_t vertex_count = 0;
+    std::size_t index_count = 0;
+
+    /** Buffer sizes in elements; the buffers grow with headroom */
+    std::size_t vertex_capacity = 0;
+    std::size_t index_capacity = 0;
+
+    /** Mesh revision the buffers hold */
+    std::uint64_t revision = 0;
+};
+
+/**
+ * @brief What SyncGlobeMesh() has to upload
+ */
+enum class GPUMeshSync : std::uint8_t {
+    CURRENT = 0,      ///< Nothing
+    INCREMENTAL = 1,  ///< Dirty index ranges and appended vertices
+    FULL = 2          ///< Everything, into buffers (re)allocated as needed
+};
+
+/**
+ * @brief GPU memory and upload traffic
+ */
+struct GPUResourceStats {
+    std::size_t meshes = 0;                  ///< Meshes with GPU copies
+    std::size_t buffer_bytes = 0;            ///< Allocated vertex and index buffer bytes
+    std::size_t last_sync_bytes = 0;         ///< Bytes uploaded by the last SyncGlobeMesh()
+    std::uint64_t full_uploads = 0;          ///< SyncGlobeMesh() calls that uploaded everything
+    std::uint64_t incremental_uploads = 0;   ///< SyncGlobeMesh() calls that uploaded changes only
+};
+
+/**
+ * @brief Owner of the GPU buffers of globe meshes
+ */
+class GPUResourceManager {
+public:
+    /**
+     * @brief Create a GPU resource manager
+     */
+    static std::unique_ptr<GPUResourceManager> Create();
+
+    virtual ~GPUResourceManager() = default;
+
+    /**
+     * @brief Bring the GPU copy of a mesh up to date, creating it on first use
+     *
+     * @param mesh Globe mesh; its GPU copy is keyed by address
+     * @return GPU copy, valid until ReleaseGlobeMesh() or Release(), or
+     *         nullptr if the mesh has no geometry
+     */
+    virtual const GPUMesh* SyncGlobeMesh(const GlobeMesh& mesh) = 0;
+
+    /**
+     * @brief Get the GPU copy of a mesh without updating it
+     *
+     * @return GPU copy, or nullptr if the mesh was never synced
+     */
+    virtual const GPUMesh* GetGlobeMesh(const GlobeMesh& mesh) const = 0;
+
+    /**
+     * @brief Delete the GPU copy of a mesh
+     */
+    virtual void ReleaseGlobeMesh(const GlobeMesh& mesh) = 0;
+
+    /**
+     * @brief Delete all GPU copies
+     */
+    virtual void Release() = 0;
+
+    /**
+     * @brief Get memory and upload statistics
+     */
+    virtual GPUResourceStats GetStats() const = 0;
+
+    /**
+     * @brief Issue the draw calls of a GPU mesh (vertex array bound by the caller)
+     */
+    static void DrawGlobeMesh(const GPUMesh& gpu_mesh);
+
+    /**
+     * @brief Decide what a GPU copy needs to catch up with its mesh
+     *
+     * @param gpu_mesh GPU copy, or nullptr if there is none yet
+     * @param mesh Globe mesh
+     */
+    [[nodiscard]] static GPUMeshSync PlanSync(const GPUMesh* gpu_mesh, const GlobeMesh& mesh);
+
+protected:
+    GPUResourceManager() = default;
+};
+
+} // namespace earth_map
@@ -0,0 +1,173 @@
+#pragma once
+
+/**
+ * @file glyph_atlas.h
+ * @brief Signed-distance-field glyphs rasterized on demand into a shelf atlas
+ *
+ * Each glyph is rasterized once, at a single base size, as a signed
+ * distance field: texel value 0.5 lies on the outline and the value falls
+ * off linearly over `padding` pixels on either side. Because the field
+ * interpolates well, one atlas entry serves every label size, and the
+ * shader derives a sharp edge and a halo from the same texel.
+ *
+ * Metrics are in pixels of the base size (y down from the baseline);
+ * scale them by label_size / GetPixelSize().
+ */
+
+#include <earth_map/renderer/texture_atlas/shelf_texture_atlas.h>
+#include <glm/vec2.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Placement of one glyph relative to the pen position
+ */
+struct GlyphMetrics {
+    /// Atlas region of the distance field (empty for blank glyphs such as space)
+    ShelfAtlasRegion region;
+
+    /// Offset of the bitmap's top-left corner from the pen on the baseline
+    glm::vec2 offset{0.0f};
+
+    /// Bitmap size, distance-field padding included
+    glm::vec2 size{0.0f};
+
+    /// Horizontal pen advance
+    float advance = 0.0f;
+
+    /// Whether the glyph has a bitmap
+    bool has_bitmap = false;
+};
+
+/**
+ * @brief Font rasterizer and cache of its SDF glyphs
+ *
+ * Thread Safety: Not thread-safe; GetGlyph() uploads on the GL thread.
+ */
+class GlyphAtlas {
+public:
+    /// Default base size glyphs are rasterized at (pixels per em height)
+    static constexpr float kDefaultPixelSize = 32.0f;
+
+    /// Default distance-field spread on each side of the outline in pixels
+    static constexpr int kDefaultPadding = 4;
+
+    /**
+     * @brief Constructor
+     *
+     * @param atlas_size Atlas texture edge in pixels
+     * @param pixel_size Base rasterization size
+     * @param padding Distance-field spread in pixels
+     * @param skip_gl_init Skip OpenGL initialization (for testing)
+     */
+    explicit GlyphAtlas(std::uint32_t atlas_size = ShelfTextureAtlas::kDefaultSize,
+                        float pixel_size = kDefaultPixelSize,
+                        int padding = kDefaultPadding,
+                        bool skip_gl_init = false);
+
+    ~GlyphAtlas();
+
+    // Non-copyable
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    /**
+     * @brief Use a TrueType / OpenType font (first face of the data)
+     *
+     * Drops every glyph of the previous font.
+     *
+     * @return false if the data is not a readable font
+     */
+    bool LoadFont(std::vector<std::uint8_t> font_data);
+
+    /**
+     * @brief Read a font file and LoadFont() it
+     */
+    bool LoadFontFile(const std::string& path);
+
+    /**
+     * @brief Check whether a font is loaded
+     */
+    bool HasFont() const;
+
+    /**
+     * @brief Get a glyph, rasterizing and uploading it on first use
+     *
+     * @return nullptr if no font is loaded or the atlas is full (call
+     *         Clear() and lay out again; IsFull() reports the latter)
+     */
+    const GlyphMetrics* GetGlyph(char32_t codepoint);
+
+    /**
+     * @brief Kerning adjustment between two glyphs
+     */
+    float GetKerning(char32_t left, char32_t right) const;
+
+    /** @brief Distance from the baseline to the top of the tallest glyphs */
+    float GetAscent() const { return ascent_; }
+
+    /** @brief Distance from the baseline to the bottom (negative) */
+    float GetDescent() const { return descent_; }
+
+    /** @brief Baseline-to-baseline distance */
+    float GetLineHeight() const { return line_height_; }
+
+    /** @brief Base rasterization size */
+    float GetPixelSize() const { return pixel_size_; }
+
+    /** @brief Distance-field spread in pixels */
+    int GetPadding() const { return padding_; }
+
+    /**
+     * @brief Check whether a glyph failed to fit since the last Clear()
+     */
+    bool IsFull() const { return full_; }
+
+    /**
+     * @brief Drop every glyph and empty the atlas
+     *
+     * Bumps the generation; layouts made earlier must be redone.
+     */
+    void Clear();
+
+    /**
+     * @brief Get the generation (incremented by Clear() and LoadFont())
+     */
+    std::uint64_t GetGeneration() const { return generation_; }
+
+    /** @brief Get number of cached glyphs */
+    std::size_t GetGlyphCount() const { return glyphs_.size(); }
+
+    /** @brief Get the atlas holding the distance fields */
+    const ShelfTextureAtlas& GetAtlas() const { return atlas_; }
+
+    /**
+     * @brief Decode UTF-8 into codepoints (invalid bytes become U+FFFD)
+     */
+    static std::u32string DecodeUtf8(std::string_view text);
+
+private:
+    struct Font;
+
+    ShelfTextureAtlas atlas_;
+    float pixel_size_;
+    int padding_;
+
+    std::unique_ptr<Font> font_;
+    float ascent_ = 0.0f;
+    float descent_ = 0.0f;
+    float line_height_ = 0.0f;
+
+    std::unordered_map<char32_t, GlyphMetrics> glyphs_;
+    bool full_ = false;
+    std::uint64_t generation_ = 0;
+};
+
+} // namespace earth_map
@@ -0,0 +1,120 @@
+#pragma once
+
+/**
+ * @file label_collision_grid.h
+ * @brief Screen-space uniform grid rejecting overlapping label boxes
+ *
+ * Labels are placed greedily in priority order: a label is shown if its
+ * screen box overlaps none of the boxes placed before it. The grid buckets
+ * placed boxes by the cells they cover, so each test only compares against
+ * boxes in the same few cells and placing n candidates costs about O(n).
+ *
+ * The grid is rebuilt every frame but never cleared: BeginFrame() bumps a
+ * generation counter and a cell drops its stale boxes the first time it is
+ * touched in the new frame. A frame's cost therefore depends only on the
+ * candidates tested, not on the viewport's cell count.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Axis-aligned box in screen pixels (y down)
+ */
+struct LabelBox {
+    float min_x = 0.0f;
+    float min_y = 0.0f;
+    float max_x = 0.0f;
+    float max_y = 0.0f;
+
+    bool Overlaps(const LabelBox& other) const {
+        return min_x < other.max_x && other.min_x < max_x &&
+               min_y < other.max_y && other.min_y < max_y;
+    }
+};
+
+/**
+ * @brief Uniform grid of placed label boxes
+ *
+ * Thread Safety: Not thread-safe; used by the render thread.
+ */
+class LabelCollisionGrid {
+public:
+    /// Default cell edge in pixels (about one short label)
+    static constexpr float kDefaultCellSize = 64.0f;
+
+    /**
+     * @brief Constructor
+     *
+     * @param cell_size Cell edge in pixels
+     */
+    explicit LabelCollisionGrid(float cell_size = kDefaultCellSize);
+
+    /**
+     * @brief Forget the boxes of the previous frame
+     *
+     * O(1) unless the viewport size changed (cells are then reallocated).
+     */
+    void BeginFrame(float viewport_width, float viewport_height);
+
+    /**
+     * @brief Check whether a box overlaps a box placed this frame
+     */
+    bool Collides(const LabelBox& box) const;
+
+    /**
+     * @brief Place a box unless it overlaps a placed box or lies off screen
+     *
+     * Boxes partly on screen are accepted.
+     *
+     * @return true if the box was placed
+     */
+    bool TryInsert(const LabelBox& box);
+
+    /** @brief Get number of boxes placed this frame */
+    std::size_t GetBoxCount() const { return boxes_.size(); }
+
+    /** @brief Get number of box comparisons made this frame */
+    std::size_t GetTestCount() const { return tests_; }
+
+    /** @brief Get grid columns */
+    int GetColumns() const { return columns_; }
+
+    /** @brief Get grid rows */
+    int GetRows() const { return rows_; }
+
+private:
+    /**
+     * @brief Placed boxes overlapping one cell
+     */
+    struct Cell {
+        std::uint32_t generation = 0;
+        std::vector<std::uint32_t> boxes;
+    };
+
+    /**
+     * @brief Cells covered by a box, clamped to the grid
+     */
+    struct CellRange {
+        int x0 = 0, y0 = 0, x1 = -1, y1 = -1;   ///< Inclusive
+    };
+
+    CellRange CellsOf(const LabelBox& box) const;
+
+    float cell_size_;
+    float inverse_cell_size_;
+    float viewport_width_ = 0.0f;
+    float viewport_height_ = 0.0f;
+    int columns_ = 0;
+    int rows_ = 0;
+
+    std::uint32_t generation_ = 1;
+    std::vector<Cell> cells_;
+    std::vector<LabelBox> boxes_;
+    mutable std::size_t tests_ = 0;
+};
+
+} // namespace earth_map
@@ -0,0 +1,196 @@
+#pragma once
+
+/**
+ * @file label_renderer.h
+ * @brief Collision-placed map labels drawn as instanced SDF glyph quads
+ *
+ * Every frame the renderer projects the label anchors on the CPU (in
+ * double precision), culls those behind the globe or off screen, and
+ * places the rest in priority order into a LabelCollisionGrid: a label is
+ * shown only if its text box overlaps no label placed before it. Labels
+ * shown in the previous frame are tried first among equal priorities, so
+ * placement stays stable while the camera moves.
+ *
+ * Each label's text is laid out once (and again only when the glyph atlas
+ * is rebuilt) as glyph quads in base-size pixels. Placed labels append one
+ * instance per glyph to a persistent buffer, and all glyphs draw with a
+ * single instanced call; the fragment shader turns the distance field into
+ * the fill and the halo.
+ */
+
+#include <earth_map/coordinates/coordinate_spaces.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace earth_map {
+
+/// Label handle (stable until removed; handles of removed labels are reused)
+using LabelId = std::uint32_t;
+
+/**
+ * @brief Text and appearance of one label
+ */
+struct LabelDesc {
+    /// Anchor position
+    coordinates::Geographic position;
+
+    /// UTF-8 text; '\n' starts a new line
+    std::string text;
+
+    /// Placed before labels of lower priority
+    float priority = 0.0f;
+
+    /// Em height in pixels
+    float size_pixels = 14.0f;
+
+    /// Point of the text box at the anchor ((0, 0) = top-left, (0.5, 0.5) = center)
+    glm::vec2 anchor{0.5f, 0.5f};
+
+    /// Screen offset from the anchor in pixels (y down)
+    glm::vec2 offset_pixels{0.0f};
+
+    glm::vec4 color{1.0f};
+    glm::vec4 halo_color{0.0f, 0.0f, 0.0f, 0.75f};
+};
+
+/**
+ * @brief Label rendering configuration
+ */
+struct LabelRenderConfig {
+    /** Font file (TrueType / OpenType); labels are not drawn until a font is loaded */
+    std::string font_path;
+
+    /** Glyph atlas edge in pixels */
+    std::uint32_t atlas_size = 1024;
+
+    /** Size glyphs are rasterized at; larger keeps big labels crisp */
+    float sdf_pixel_size = 32.0f;
+
+    /** Distance-field spread in base-size pixels (bounds the halo width) */
+    int sdf_padding = 4;
+
+    /** Collision grid cell edge in pixels */
+    float collision_cell_pixels = 64.0f;
+
+    /** Empty space kept around each label's box in pixels */
+    float label_padding_pixels = 2.0f;
+
+    /** Halo width in screen pixels */
+    float halo_width_pixels = 1.5f;
+
+    /** Glyph instances allocated at first use */
+    std::uint32_t initial_capacity = 4096;
+};
+
+/**
+ * @brief Label rendering statistics of the last frame
+ */
+struct LabelRenderStats {
+    std::size_t candidates = 0;        ///< Labels considered
+    std::size_t culled = 0;            ///< Behind the globe or off screen
+    std::size_t placed = 0;            ///< Labels drawn
+    std::size_t glyphs_rendered = 0;   ///< Glyph instances drawn
+    std::size_t collision_tests = 0;   ///< Box comparisons in the collision grid
+    std::uint32_t draw_calls = 0;      ///< Instanced draws (0 or 1)
+    double placement_ms = 0.0;         ///< CPU time of projection and placement
+    std::size_t glyphs_cached = 0;     ///< Glyphs in the atlas
+    std::uint64_t atlas_rebuilds = 0;  ///< Glyph atlas rebuilds since creation
+};
+
+/**
+ * @brief Label renderer interface
+ */
+class LabelRenderer {
+public:
+    static constexpr LabelId INVALID_ID = std::numeric_limits<LabelId>::max();
+
+    /**
+     * @brief Create a label renderer
+     *
+     * @param config Rendering configuration
+     * @return std::unique_ptr<LabelRenderer> New renderer (not yet initialized)
+     */
+    static std::unique_ptr<LabelRenderer> Create(const LabelRenderConfig& config = {});
+
+    /**
+     * @brief Virtual destructor (releases GL resources; needs the GL context current)
+     */
+    virtual ~LabelRenderer() = default;
+
+    /**
+     * @brief Compile the shaders, create the atlas and load config.font_path if set
+     *
+     * @return true if initialization succeeded (a missing font is not an error)
+     */
+    virtual bool Initialize() = 0;
+
+    /**
+     * @brief Load the font glyphs are drawn with (drops the glyph atlas)
+     *
+     * @return false if the file is not a readable font
+     */
+    virtual bool LoadFontFile(const std::string& path) = 0;
+
+    /**
+     * @brief Add a label
+     *
+     * @return Handle of the label
+     */
+    virtual LabelId AddLabel(const LabelDesc& label) = 0;
+
+    /**
+     * @brief Remove a label
+     *
+     * @return false if the handle is not a label
+     */
+    virtual bool RemoveLabel(LabelId id) = 0;
+
+    /**
+     * @brief Remove every label
+     */
+    virtual void Clear() = 0;
+
+    /**
+     * @brief Get number of labels
+     */
+    virtual std::size_t GetLabelCount() const = 0;
+
+    /**
+     * @brief Check whether a label was drawn in the last frame
+     */
+    virtual bool IsLabelPlaced(LabelId id) const = 0;
+
+    /**
+     * @brief Place the labels and draw the placed ones
+     *
+     * Drawn as a screen overlay (not depth-tested); labels whose anchor is
+     * below the horizon are culled.
+     *
+     * @param view_matrix Camera view matrix (world units: globe radius 1)
+     * @param projection_matrix Camera projection matrix
+     * @param camera_position Camera position in world units
+     * @param viewport_width Viewport width in pixels
+     * @param viewport_height Viewport height in pixels
+     */
+    virtual void Render(const glm::mat4& view_matrix, const glm::mat4& projection_matrix,
+                        const glm::vec3& camera_position, std::uint32_t viewport_width,
+                        std::uint32_t viewport_height) = 0;
+
+    /**
+     * @brief Get statistics of the last frame
+     */
+    virtual LabelRenderStats GetStats() const = 0;
+
+protected:
+    /**
+     * @brief Protected constructor to enforce factory pattern
+     */
+    LabelRenderer() = default;
+};
+
+} // namespace earth_map
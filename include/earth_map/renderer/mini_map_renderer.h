@@ -6,11 +6,17 @@
  *
  * Renders a small 2D overview showing camera position and view frustum
  * on a textured Earth globe, similar to NASA World Wind mini-map.
+ *
+ * All geometry lives in GL buffers created once at initialization; only
+ * the frustum outline is rewritten in place. The mini-map texture is
+ * redrawn only when the camera or aspect ratio changes, otherwise the
+ * previous frame's texture is composited as is.
  */
 
 #include <earth_map/renderer/renderer.h>
 #include <glm/glm.hpp>
 #include <memory>
+#include <cstddef>
 #include <cstdint>
 
 namespace earth_map {
@@ -72,11 +78,33 @@ public:
                 uint32_t screen_width, uint32_t screen_height);
 
     /**
-     * @brief Render mini-map to screen
+     * @brief Render the mini-map texture if the camera state changed
+     *
+     * Call after Update(). Hashes the camera's view and projection matrices
+     * and skips the framebuffer pass when nothing changed since the last
+     * render.
      *
      * @param aspect_ratio Viewport aspect ratio for frustum calculation
+     * @return true if the texture was redrawn
+     */
+    bool Render(float aspect_ratio);
+
+    /**
+     * @brief Draw the [0, 1] screen quad used to composite the texture
+     *
+     * The caller binds the overlay program, its uniforms and GetTexture().
+     */
+    void DrawOverlayQuad() const;
+
+    /**
+     * @brief Force a redraw on the next Render()
+     */
+    void Invalidate() { dirty_ = true; }
+
+    /**
+     * @brief Get the number of framebuffer passes since initialization
      */
-    void Render(float aspect_ratio);
+    std::uint64_t GetRenderCount() const { return render_count_; }
 
     /**
      * @brief Render camera frustum on mini-map
@@ -188,12 +216,31 @@ private:
     uint32_t vbo_ = 0;                 ///< Vertex buffer object
     uint32_t grid_vao_ = 0;            ///< Grid vertex array
     uint32_t grid_vbo_ = 0;            ///< Grid vertex buffer
+    uint32_t marker_vao_ = 0;          ///< Camera marker vertex array
+    uint32_t marker_vbo_ = 0;          ///< Camera marker vertex buffer
+    uint32_t frustum_vao_ = 0;         ///< Frustum outline vertex array
+    uint32_t frustum_vbo_ = 0;         ///< Frustum outline vertex buffer (dynamic)
+    uint32_t overlay_vao_ = 0;         ///< Screen compositing quad vertex array
+    uint32_t overlay_vbo_ = 0;         ///< Screen compositing quad vertex buffer
+
+    // Uniform locations, looked up once
+    int32_t projection_location_ = -1;
+    int32_t model_location_ = -1;
+    int32_t texture_location_ = -1;
+    int32_t color_location_ = -1;
+    int32_t use_texture_location_ = -1;
+
+    /// Frustum outline: 4 segments of 2 vertices
+    static constexpr std::size_t kMaxFrustumVertices = 8;
 
     // Rendering data
     glm::vec2 camera_position_pixels_; ///< Camera position in pixels
 
     bool initialized_ = false;         ///< Initialization status
     bool texture_loaded_ = false;      ///< Earth texture loaded successfully
+    bool dirty_ = true;                ///< Texture must be redrawn
+    std::uint64_t rendered_state_hash_ = 0; ///< Camera state of the current texture
+    std::uint64_t render_count_ = 0;   ///< Framebuffer passes
 };
 
 } // namespace earth_map
\ No newline at end of file
@@ -0,0 +1,139 @@
+#pragma once
+
+/**
+ * @file placemark_clusters.h
+ * @brief Precomputed per-zoom clustering of point placemarks
+ *
+ * Placemarks are projected to Web Mercator and merged greedily, zoom by
+ * zoom from the most detailed level up: every point of a level absorbs the
+ * unclaimed points within a fixed pixel radius of it at the next coarser
+ * zoom, giving a weighted cluster. Each level is stored as a static
+ * KD-tree (points sorted in place by alternating median splits), so a view
+ * queries only the clusters around it and draws about as many as fit on
+ * screen, whatever the dataset size. Build cost is O(n log n) per level.
+ */
+
+#include <earth_map/renderer/placemark_store.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Clustering parameters
+ */
+struct PlacemarkClusterOptions {
+    float radius_pixels = 40.0f;     ///< Merge radius on screen
+    float tile_extent = 256.0f;      ///< Pixels per tile edge (world is extent * 2^zoom wide)
+    int min_zoom = 0;                ///< Coarsest clustered zoom
+    int max_zoom = 16;               ///< Finest clustered zoom; above it points are drawn as is
+    std::uint32_t min_points = 2;    ///< Fewer points within the radius stay unmerged
+    std::uint32_t node_size = 64;    ///< KD-tree leaf size
+};
+
+/**
+ * @brief Cluster (or single placemark) of one zoom level
+ */
+struct PlacemarkCluster {
+    glm::dvec2 mercator{0.0};  ///< Weighted center in Web Mercator [0, 1]^2 (y down)
+    std::uint32_t count = 0;   ///< Placemarks merged
+    PlacemarkId id = PlacemarkStore::INVALID_ID;  ///< The placemark if count is 1
+};
+
+/**
+ * @brief Cluster hierarchy of a set of placemarks
+ *
+ * Immutable once built and safe to query from any thread.
+ */
+class PlacemarkClusterIndex {
+public:
+    /**
+     * @brief Web Mercator position in [0, 1]^2 of a world position (y down)
+     *
+     * @param world Position in world axes (any scale); latitude is clamped
+     *        to the Mercator limit
+     */
+    static glm::dvec2 ToMercator(const glm::dvec3& world);
+
+    /**
+     * @brief Unit world direction of a Web Mercator position
+     */
+    static glm::dvec3 FromMercator(const glm::dvec2& mercator);
+
+    /**
+     * @brief Create an empty index
+     */
+    PlacemarkClusterIndex() = default;
+
+    /**
+     * @brief Build the hierarchy
+     *
+     * The tree sorts of large levels run in parallel.
+     *
+     * @param positions Placemark positions in world axes
+     * @param ids Placemark of each position
+     * @param options Clustering parameters
+     */
+    PlacemarkClusterIndex(std::span<const glm::dvec3> positions, std::span<const PlacemarkId> ids,
+                          const PlacemarkClusterOptions& options = {});
+
+    /**
+     * @brief Get the clustering parameters
+     */
+    const PlacemarkClusterOptions& GetOptions() const { return options_; }
+
+    /**
+     * @brief Get the number of placemarks indexed
+     */
+    std::size_t GetPointCount() const { return point_count_; }
+
+    /**
+     * @brief Get the number of clusters of a zoom level (clamped to the clustered range)
+     */
+    std::size_t GetClusterCount(int zoom) const;
+
+    /**
+     * @brief Append the clusters of a zoom level inside a Mercator box
+     *
+     * @param zoom Zoom level (clamped to the clustered range)
+     * @param min Box corner with the smallest coordinates
+     * @param max Box corner with the largest coordinates
+     * @param clusters Receives the clusters
+     */
+    void Query(int zoom, const glm::dvec2& min, const glm::dvec2& max,
+               std::vector<PlacemarkCluster>& clusters) const;
+
+    /**
+     * @brief Get the memory held by the levels in bytes
+     */
+    std::size_t GetMemoryUsage() const;
+
+private:
+    /// Clusters of one zoom in KD-tree order
+    using Level = std::vector<PlacemarkCluster>;
+
+    /// Level of a zoom, clamped to [min_zoom, max_zoom]
+    const Level& GetLevel(int zoom) const;
+
+    /// Merge a level into the clusters of the next coarser zoom
+    Level Cluster(const Level& level, int zoom) const;
+
+    /// Indices of the clusters of a level within @p radius of a point
+    void Within(const Level& level, const glm::dvec2& center, double radius,
+                std::vector<std::uint32_t>& found) const;
+
+    /// Sort a level into KD-tree order
+    void SortKd(std::span<PlacemarkCluster> clusters, int axis, int parallel_depth) const;
+
+    PlacemarkClusterOptions options_;
+    std::size_t point_count_ = 0;
+
+    /// Levels from min_zoom to max_zoom; a zoom that merged nothing shares the finer level
+    std::vector<std::shared_ptr<const Level>> levels_;
+};
+
+} // namespace earth_map
@@ -0,0 +1,129 @@
+#pragma once
+
+/**
+ * @file placemark_renderer.h
+ * @brief GPU-instanced rendering of point and billboard placemarks
+ *
+ * Placemarks live in persistent per-style GPU buffers mirroring a
+ * PlacemarkStore: one buffer of relative-to-center float positions and one
+ * of RGBA8 colors. Each frame uploads the slots edited since the last frame
+ * with glBufferSubData and draws every style with a single call (points:
+ * glDrawArrays over the slots; billboards: one instanced quad per slot).
+ * The center is subtracted from the eye position in double precision on
+ * the CPU, so the vertex shader only adds two small float vectors.
+ *
+ * Once clusters are built, views zoomed out to the clustered range draw
+ * the cluster level of their zoom around the view instead, so the sprites
+ * drawn stay about one per cluster radius of screen.
+ */
+
+#include <earth_map/renderer/placemark_clusters.h>
+#include <earth_map/renderer/placemark_store.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace earth_map {
+
+/**
+ * @brief Placemark rendering configuration
+ */
+struct PlacemarkRenderConfig {
+    /** Instance slots allocated per style buffer at first use */
+    std::uint32_t initial_capacity = 1024;
+
+    /** Dirty runs separated by at most this many clean slots upload together */
+    std::uint32_t merge_gap = 64;
+
+    /** Cluster hierarchy parameters (see BuildClusters) */
+    PlacemarkClusterOptions clusters;
+
+    /** Cluster sprite color */
+    glm::vec4 cluster_color{1.0f, 0.55f, 0.1f, 0.9f};
+
+    /** Sprite diameter of a lone placemark; clusters grow with log2 of their count */
+    float cluster_size_pixels = 8.0f;
+};
+
+/**
+ * @brief Placemark rendering statistics of the last frame
+ */
+struct PlacemarkRenderStats {
+    std::size_t placemarks_rendered = 0;  ///< Instances submitted
+    std::size_t clusters_rendered = 0;    ///< Cluster sprites among them
+    std::uint32_t draw_calls = 0;         ///< One per non-empty style (or cluster level)
+    std::uint32_t buffer_updates = 0;     ///< glBufferSubData runs (per attribute buffer)
+    std::size_t uploaded_bytes = 0;       ///< Bytes uploaded, reallocations included
+    std::size_t gpu_memory_bytes = 0;     ///< Bytes held by the instance buffers
+};
+
+/**
+ * @brief Placemark renderer interface
+ */
+class PlacemarkRenderer {
+public:
+    /**
+     * @brief Create a placemark renderer
+     *
+     * @param config Rendering configuration
+     * @return std::unique_ptr<PlacemarkRenderer> New renderer (not yet initialized)
+     */
+    static std::unique_ptr<PlacemarkRenderer> Create(const PlacemarkRenderConfig& config = {});
+
+    /**
+     * @brief Virtual destructor (releases GL resources; needs the GL context current)
+     */
+    virtual ~PlacemarkRenderer() = default;
+
+    /**
+     * @brief Compile the shaders
+     *
+     * @return true if initialization succeeded, false otherwise
+     */
+    virtual bool Initialize() = 0;
+
+    /**
+     * @brief Get the placemarks; edits are uploaded at the next Render
+     */
+    virtual PlacemarkStore& GetStore() = 0;
+
+    /**
+     * @brief Build the cluster hierarchy of the current placemarks in the background
+     *
+     * Placemarks are drawn unclustered until the build completes. Clusters
+     * are dropped when placemarks are added or removed afterwards; call
+     * again after a bulk of edits (such as a finished load).
+     */
+    virtual void BuildClusters() = 0;
+
+    /**
+     * @brief Upload edited placemarks and draw all styles
+     *
+     * Depth-tested against the scene drawn before; placemarks below the
+     * horizon are culled in the vertex shader. Clusters replace the
+     * placemarks when the view's zoom is within the clustered range.
+     *
+     * @param view_matrix Camera view matrix (world units: globe radius 1)
+     * @param projection_matrix Camera projection matrix
+     * @param camera_position Camera position in world units
+     * @param viewport_width Viewport width in pixels
+     * @param viewport_height Viewport height in pixels
+     */
+    virtual void Render(const glm::mat4& view_matrix, const glm::mat4& projection_matrix,
+                        const glm::vec3& camera_position, std::uint32_t viewport_width,
+                        std::uint32_t viewport_height) = 0;
+
+    /**
+     * @brief Get statistics of the last frame
+     */
+    virtual PlacemarkRenderStats GetStats() const = 0;
+
+protected:
+    /**
+     * @brief Protected constructor to enforce factory pattern
+     */
+    PlacemarkRenderer() = default;
+};
+
+} // namespace earth_map
@@ -0,0 +1,216 @@
+#pragma once
+
+/**
+ * @file placemark_store.h
+ * @brief Instance data of point placemarks, grouped by style
+ *
+ * Each style owns a dense run of instance slots mirrored one-to-one in GPU
+ * buffers, so a style draws with one call over slots [0, count). Positions
+ * are float meters relative to a per-style center (relative-to-center), in
+ * the renderer's world axes. Edits mark slots dirty; the renderer uploads
+ * only the dirty runs, so frame cost follows the number of edits rather
+ * than the number of placemarks.
+ */
+
+#include <earth_map/coordinates/coordinate_spaces.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief How the placemarks of a style are drawn
+ */
+enum class PlacemarkShape : std::uint8_t {
+    POINT,     ///< Round point sprite of size_pixels
+    BILLBOARD  ///< Screen-aligned quad of size_pixels, textured if the style has a texture
+};
+
+/**
+ * @brief Appearance shared by a group of placemarks
+ */
+struct PlacemarkStyle {
+    PlacemarkShape shape = PlacemarkShape::POINT;
+    glm::vec4 color{1.0f};                 ///< Multiplied with each placemark's color
+    float size_pixels = 6.0f;              ///< Point diameter or billboard edge in pixels
+    glm::vec2 anchor{0.5f, 0.5f};          ///< Billboard point at the position ((0, 0) = bottom-left)
+    std::uint32_t texture = 0;             ///< Billboard GL texture (0 = solid color)
+
+    /// Center of the style's relative positions; defaults to its first
+    /// placemark. Float offsets keep about 6e-8 of their distance from it.
+    std::optional<coordinates::Geographic> center;
+};
+
+/// Placemark handle (stable until removed; handles of removed placemarks are reused)
+using PlacemarkId = std::uint32_t;
+
+/// Style handle
+using PlacemarkStyleId = std::uint32_t;
+
+/**
+ * @brief Run of instance slots to upload
+ */
+struct PlacemarkUploadRange {
+    std::uint32_t first = 0;
+    std::uint32_t count = 0;
+};
+
+/**
+ * @brief Placemark instance data in structure-of-arrays layout
+ *
+ * Pure CPU logic with no GL dependencies.
+ */
+class PlacemarkStore {
+public:
+    static constexpr PlacemarkId INVALID_ID = std::numeric_limits<PlacemarkId>::max();
+
+    /**
+     * @brief Pack a color into the RGBA8 bytes of the color buffer
+     */
+    static std::uint32_t PackColor(const glm::vec4& color);
+
+    /**
+     * @brief Position in meters in world axes (sphere of EARTH_MEAN_RADIUS)
+     */
+    static glm::dvec3 ToWorldMeters(const coordinates::Geographic& position);
+
+    /**
+     * @brief Add a style
+     */
+    PlacemarkStyleId AddStyle(const PlacemarkStyle& style);
+
+    /**
+     * @brief Get the number of styles
+     */
+    std::size_t GetStyleCount() const { return styles_.size(); }
+
+    /**
+     * @brief Get a style
+     */
+    const PlacemarkStyle& GetStyle(PlacemarkStyleId style) const { return styles_[style].style; }
+
+    /**
+     * @brief Add a placemark
+     *
+     * @param style Style of the placemark
+     * @param position Position (altitude in meters above the sphere)
+     * @param color Packed color (PackColor), multiplied with the style color
+     * @return PlacemarkId Handle of the placemark
+     * @throws std::out_of_range if the style does not exist
+     */
+    PlacemarkId Add(PlacemarkStyleId style, const coordinates::Geographic& position,
+                    std::uint32_t color = 0xFFFFFFFFu);
+
+    /**
+     * @brief Move a placemark
+     *
+     * @return true if the placemark exists
+     */
+    bool Update(PlacemarkId id, const coordinates::Geographic& position);
+
+    /**
+     * @brief Recolor a placemark
+     *
+     * @return true if the placemark exists
+     */
+    bool SetColor(PlacemarkId id, std::uint32_t color);
+
+    /**
+     * @brief Remove a placemark; the style's last placemark moves into its slot
+     *
+     * @return true if the placemark existed
+     */
+    bool Remove(PlacemarkId id);
+
+    /**
+     * @brief Check if a placemark exists
+     */
+    bool Contains(PlacemarkId id) const;
+
+    /**
+     * @brief Get the number of placemarks
+     */
+    std::size_t GetCount() const { return count_; }
+
+    /**
+     * @brief Get the number of placemarks of a style
+     */
+    std::size_t GetCount(PlacemarkStyleId style) const { return styles_[style].ids.size(); }
+
+    /**
+     * @brief Get the center of a style's positions in meters (world axes)
+     */
+    const glm::dvec3& GetCenter(PlacemarkStyleId style) const { return styles_[style].center; }
+
+    /**
+     * @brief Get a style's positions: 3 floats per slot, meters from its center
+     */
+    const std::vector<float>& GetPositions(PlacemarkStyleId style) const {
+        return styles_[style].positions;
+    }
+
+    /**
+     * @brief Get a style's packed colors, one per slot
+     */
+    const std::vector<std::uint32_t>& GetColors(PlacemarkStyleId style) const {
+        return styles_[style].colors;
+    }
+
+    /**
+     * @brief Get a style's placemark of each slot
+     */
+    const std::vector<PlacemarkId>& GetIds(PlacemarkStyleId style) const {
+        return styles_[style].ids;
+    }
+
+    /**
+     * @brief Get the slot of a placemark within its style
+     */
+    std::uint32_t GetSlot(PlacemarkId id) const { return locations_[id].slot; }
+
+    /**
+     * @brief Take the slots of a style changed since the last call
+     *
+     * Slots past the style's count (freed by removals) are dropped; they
+     * are not drawn.
+     *
+     * @param style Style to take the changes of
+     * @param merge_gap Runs separated by at most this many clean slots are
+     *        merged, trading upload size for fewer uploads
+     * @return std::vector<PlacemarkUploadRange> Ascending, disjoint runs
+     */
+    std::vector<PlacemarkUploadRange> TakeDirtyRanges(PlacemarkStyleId style,
+                                                      std::uint32_t merge_gap = 64);
+
+private:
+    struct Location {
+        PlacemarkStyleId style = 0;
+        std::uint32_t slot = 0;
+        bool live = false;
+    };
+
+    struct StyleData {
+        PlacemarkStyle style;
+        glm::dvec3 center{0.0};
+        bool has_center = false;
+        std::vector<float> positions;
+        std::vector<std::uint32_t> colors;
+        std::vector<PlacemarkId> ids;         ///< Placemark of each slot
+        std::vector<std::uint8_t> dirty;      ///< Per slot: already in dirty_slots
+        std::vector<std::uint32_t> dirty_slots;
+    };
+
+    void WritePosition(StyleData& data, std::uint32_t slot, const coordinates::Geographic& position);
+    static void MarkDirty(StyleData& data, std::uint32_t slot);
+
+    std::vector<StyleData> styles_;
+    std::vector<Location> locations_;   ///< Indexed by PlacemarkId
+    std::vector<PlacemarkId> free_ids_;
+    std::size_t count_ = 0;
+};
+
+} // namespace earth_map
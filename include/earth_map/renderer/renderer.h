@@ -10,7 +10,9 @@
 
 #include "earth_map/math/bounding_box.h"
 #include "earth_map/core/camera_controller.h"
+#include "earth_map/renderer/gpu_frame_profiler.h"
 #include <glm/glm.hpp>
+#include <array>
 #include <memory>
 #include <string>
 #include <vector>
@@ -23,9 +25,12 @@ struct Configuration;
 class ShaderManager;
 class TileRenderer;
 class PlacemarkRenderer;
+class LabelRenderer;
 class LODManager;
 class GPUResourceManager;
 class ElevationManager;
+class TileManager;
+class TileTextureCoordinator;
 
 /**
  * @brief Rendering statistics for performance monitoring
@@ -54,6 +59,50 @@ struct RenderStats {
     
     /** Number of placemarks currently rendered */
     std::size_t placemarks_rendered = 0;
+
+    /** Number of labels placed in the last frame */
+    std::size_t labels_placed = 0;
+
+    /** GPU time of the last measured frame in milliseconds (0 without timer queries) */
+    double gpu_frame_time_ms = 0.0;
+
+    /** Adaptive quality level (0 = full quality) */
+    std::uint32_t quality_level = 0;
+
+    /**
+     * Render resolution the adaptive quality controller asks for, relative
+     * to the window; the host applies it (e.g. with a smaller framebuffer)
+     */
+    float resolution_scale = 1.0f;
+
+    /** CPU and GPU time of each render pass, indexed by RenderPass */
+    std::array<RenderPassTiming, kRenderPassCount> pass_timings{};
+
+    /**
+     * @brief Get the timing of one render pass
+     */
+    const RenderPassTiming& GetPassTiming(RenderPass pass) const {
+        return pass_timings[static_cast<std::size_t>(pass)];
+    }
+};
+
+/**
+ * @brief Additional view drawn by a renderer
+ *
+ * Views have their own camera, viewport and framebuffer but share the
+ * renderer's tile pool, tile cache, loader, globe mesh and elevation data.
+ * The tile requests of all views are merged into one request generation
+ * per frame.
+ */
+struct RenderViewConfig {
+    CameraController* camera = nullptr;  ///< Camera of the view (non-owning)
+    std::uint32_t x = 0;                 ///< Viewport left edge in framebuffer pixels
+    std::uint32_t y = 0;                 ///< Viewport bottom edge in framebuffer pixels
+    std::uint32_t width = 0;             ///< Viewport width in pixels
+    std::uint32_t height = 0;            ///< Viewport height in pixels
+    std::uint32_t framebuffer = 0;       ///< GL framebuffer drawn into (0 = default)
+    float priority_weight = 1.0f;        ///< Tile request weight relative to the main view's 1
+    bool draw_placemarks = true;         ///< Draw placemarks over the globe
 };
 
 /**
@@ -155,6 +204,15 @@ public:
      * @return PlacemarkRenderer* Pointer to placemark renderer (non-owning)
      */
     virtual PlacemarkRenderer* GetPlacemarkRenderer() = 0;
+
+    /**
+     * @brief Get the label renderer
+     *
+     * Labels are drawn only once a font is loaded into it.
+     *
+     * @return LabelRenderer* Pointer to label renderer (non-owning)
+     */
+    virtual LabelRenderer* GetLabelRenderer() = 0;
     
     /**
      * @brief Get the LOD manager
@@ -205,6 +263,52 @@ public:
      */
     virtual void SetElevationEnabled(bool enabled) = 0;
 
+    /**
+     * @brief Select, request and upload the tiles of a view without drawing
+     *
+     * Lets offscreen rendering wait for imagery: call until it returns true
+     * (or a deadline passes), then RenderScene() with the same matrices.
+     * Uses the viewport size of the last Resize().
+     *
+     * @param view_matrix View matrix
+     * @param projection_matrix Projection matrix
+     * @return true if every tile the view selects is loaded
+     */
+    virtual bool PrepareTiles(const glm::mat4& view_matrix, const glm::mat4& projection_matrix) = 0;
+
+    /**
+     * @brief Connect the tile system shared by the main view and all other views
+     *
+     * @param tile_manager Tile manager (non-owning)
+     * @param coordinator Texture coordinator (non-owning)
+     */
+    virtual void SetTileSystem(TileManager* tile_manager, TileTextureCoordinator* coordinator) = 0;
+
+    /**
+     * @brief Add a view drawn after the main view each frame (GL thread)
+     *
+     * @param view View configuration
+     * @return View identifier
+     * @throws std::invalid_argument if the view has no camera, an empty
+     *         viewport or a non-positive priority weight
+     */
+    virtual std::uint32_t AddView(const RenderViewConfig& view) = 0;
+
+    /**
+     * @brief Change a view's camera, viewport, framebuffer or weight
+     *
+     * @return false if there is no view @p id
+     * @throws std::invalid_argument as AddView()
+     */
+    virtual bool UpdateView(std::uint32_t id, const RenderViewConfig& view) = 0;
+
+    /**
+     * @brief Remove a view (GL thread)
+     *
+     * @return false if there is no view @p id
+     */
+    virtual bool RemoveView(std::uint32_t id) = 0;
+
 protected:
     /**
      * @brief Protected constructor to enforce factory pattern
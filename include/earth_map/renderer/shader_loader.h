@@ -6,13 +6,33 @@
  *
  * Provides RAII-based shader program management with compile-time
  * embedded shader sources or runtime string literals.
+ *
+ * With a ShaderProgramCache set, linked programs are restored from their
+ * cached binaries and compiled from source only on a miss. CreatePrograms()
+ * submits every compile and link before checking any status, so drivers
+ * with GL_KHR_parallel_shader_compile (enabled on first use) build the
+ * programs of a batch concurrently.
  */
 
 #include <cstdint>
+#include <memory>
+#include <span>
 #include <string>
+#include <vector>
 
 namespace earth_map {
 
+class ShaderProgramCache;
+
+/**
+ * @brief Sources of one program for ShaderLoader::CreatePrograms()
+ */
+struct ShaderProgramSource {
+    const char* vertex_source = nullptr;    ///< GLSL vertex shader source code
+    const char* fragment_source = nullptr;  ///< GLSL fragment shader source code
+    std::string name = "shader";            ///< Human-readable name for error messages
+};
+
 /**
  * @brief Compile and link GLSL shaders into an OpenGL program
  *
@@ -33,10 +53,61 @@ public:
                                        const char* fragment_source,
                                        const std::string& program_name = "shader");
 
+    /**
+     * @brief Create several programs, compiling them concurrently where supported
+     *
+     * @param sources Programs to create
+     * @return OpenGL program IDs in the order of @p sources, 0 for each failure
+     */
+    static std::vector<std::uint32_t> CreatePrograms(std::span<const ShaderProgramSource> sources);
+
+    /**
+     * @brief Compile and link a compute program (GL 4.3+; not cached)
+     *
+     * @param compute_source GLSL compute shader source code
+     * @param program_name Human-readable name for error messages
+     * @return OpenGL program ID, or 0 on failure
+     */
+    static std::uint32_t CreateComputeProgram(const char* compute_source,
+                                              const std::string& program_name = "compute");
+
+    /**
+     * @brief Set the program binary cache used by later CreateProgram() calls
+     *
+     * Ignored (binaries are never loaded or stored) when the driver offers
+     * no program binary format.
+     *
+     * @param cache Cache (null = always compile from source)
+     */
+    static void SetProgramCache(std::shared_ptr<ShaderProgramCache> cache);
+
+    /**
+     * @brief Get the program binary cache (null when unset)
+     */
+    static std::shared_ptr<ShaderProgramCache> GetProgramCache();
+
+    /**
+     * @brief Identity of the current context's driver ("vendor|renderer|version")
+     *
+     * Keys program binaries, which are only valid for the driver that made them.
+     */
+    static std::string QueryDriverId();
+
 private:
-    static std::uint32_t CompileShader(std::uint32_t type,
-                                       const char* source,
-                                       const std::string& shader_name);
+    /// A program whose compile and link were submitted but not yet checked
+    struct PendingProgram {
+        std::uint32_t program = 0;
+        std::uint32_t vertex_shader = 0;
+        std::uint32_t fragment_shader = 0;
+        std::uint64_t cache_key = 0;
+    };
+
+    static std::uint32_t LoadCachedProgram(const ShaderProgramCache& cache, std::uint64_t key);
+    static PendingProgram SubmitProgram(const ShaderProgramSource& source, bool retrievable);
+    static std::uint32_t FinishProgram(PendingProgram& pending, const ShaderProgramSource& source,
+                                       ShaderProgramCache* cache);
+    static bool CheckShader(std::uint32_t shader, const std::string& shader_name);
+    static void EnableParallelCompile();
 };
 
 } // namespace earth_map
@@ -0,0 +1,123 @@
+#pragma once
+
+/**
+ * @file shader_program_cache.h
+ * @brief On-disk cache of linked shader program binaries
+ *
+ * Linking the renderer's programs from source costs hundreds of
+ * milliseconds on some drivers. ShaderLoader stores each linked program
+ * (glGetProgramBinary) here and later restores it with glProgramBinary,
+ * compiling from source only on a miss or when the driver rejects the
+ * binary.
+ *
+ * Entries are keyed by a hash of the shader sources and the driver
+ * identity (GL vendor, renderer and version strings), so an edited shader
+ * or a driver update simply misses instead of loading a stale binary.
+ * Each file holds a small header with the binary format and a CRC32C of
+ * the binary; truncated or corrupt files are treated as misses.
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Linked program binary as returned by glGetProgramBinary
+ */
+struct ShaderProgramBinary {
+    std::uint32_t format = 0;        ///< Driver-specific binary format
+    std::vector<std::uint8_t> data;  ///< Binary contents
+};
+
+/**
+ * @brief Program binary cache statistics
+ */
+struct ShaderProgramCacheStats {
+    std::uint64_t hits = 0;      ///< Programs restored from a binary
+    std::uint64_t misses = 0;    ///< Programs compiled from source
+    std::uint64_t rejected = 0;  ///< Corrupt files or binaries the driver refused
+    std::uint64_t stores = 0;    ///< Binaries written
+};
+
+/**
+ * @brief Directory of program binaries keyed by source and driver
+ *
+ * Thread Safety: Load() and Store() may run concurrently; concurrent stores
+ * of one key leave one complete file.
+ */
+class ShaderProgramCache {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param directory Directory holding the binaries (created on first store)
+     * @param driver_id Identity of the GL driver (ShaderLoader::QueryDriverId())
+     */
+    ShaderProgramCache(std::string directory, std::string driver_id);
+
+    /**
+     * @brief Cache key of a program
+     *
+     * @param vertex_source Vertex shader source
+     * @param fragment_source Fragment shader source
+     * @return 64-bit FNV-1a hash of the sources and the driver identity
+     */
+    std::uint64_t MakeKey(std::string_view vertex_source, std::string_view fragment_source) const;
+
+    /**
+     * @brief Read a binary
+     *
+     * @return The binary, or nullopt if absent or corrupt
+     */
+    std::optional<ShaderProgramBinary> Load(std::uint64_t key) const;
+
+    /**
+     * @brief Write a binary, replacing any previous one atomically
+     *
+     * @return true if the file was written
+     */
+    bool Store(std::uint64_t key, const ShaderProgramBinary& binary) const;
+
+    /**
+     * @brief Count a program compiled from source
+     */
+    void RecordMiss() const { misses_.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Count a program restored from a binary
+     */
+    void RecordHit() const { hits_.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Count a binary the driver refused to load
+     */
+    void RecordRejected() const { rejected_.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Get statistics
+     */
+    ShaderProgramCacheStats GetStats() const;
+
+    /**
+     * @brief Get the cache directory
+     */
+    const std::string& GetDirectory() const { return directory_; }
+
+private:
+    std::string GetPath(std::uint64_t key) const;
+
+    std::string directory_;
+    std::string driver_id_;
+    mutable std::atomic<std::uint64_t> hits_{0};
+    mutable std::atomic<std::uint64_t> misses_{0};
+    mutable std::atomic<std::uint64_t> rejected_{0};
+    mutable std::atomic<std::uint64_t> stores_{0};
+    mutable std::atomic<std::uint64_t> temp_counter_{0};
+};
+
+} // namespace earth_map
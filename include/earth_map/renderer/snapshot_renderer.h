@@ -0,0 +1,183 @@
+#pragma once
+
+/**
+ * @file snapshot_renderer.h
+ * @brief Batch rendering of map images into memory
+ *
+ * Renders a list of camera views offscreen, typically on a headless
+ * context (OpenGLContext::CreateHeadless()), for server-side generation of
+ * static map images. The stages of consecutive images overlap:
+ *
+ * - The GPU draws view N into a framebuffer object.
+ * - View N-1's pixels are transferred into a pixel pack buffer. The ring
+ *   has SnapshotConfig::readback_slots buffers, so glReadPixels() never
+ *   stalls the pipeline.
+ * - Workers copy the pixels of earlier views out of the ring and encode
+ *   them.
+ *
+ * Before drawing a view, its tiles are requested and uploaded until they
+ * are all loaded or SnapshotConfig::tile_wait passes.
+ */
+
+#include <earth_map/renderer/renderer.h>
+#include <glm/glm.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace earth_map {
+
+class DecodeThreadPool;
+
+/**
+ * @brief Pixel format of snapshot images
+ */
+enum class SnapshotFormat {
+    RGBA8,  ///< Raw pixels, 4 bytes each, top row first
+    PNG     ///< PNG file
+};
+
+/**
+ * @brief One view to render
+ */
+struct SnapshotView {
+    glm::mat4 view{1.0f};          ///< View matrix
+    glm::mat4 projection{1.0f};    ///< Projection matrix
+    std::uint32_t width = 512;     ///< Image width in pixels
+    std::uint32_t height = 512;    ///< Image height in pixels
+};
+
+/**
+ * @brief Rendered image of one view
+ */
+struct SnapshotImage {
+    std::size_t index = 0;             ///< Position of the view in the batch
+    std::uint32_t width = 0;           ///< Width in pixels
+    std::uint32_t height = 0;          ///< Height in pixels
+    SnapshotFormat format = SnapshotFormat::PNG;
+    bool tiles_complete = false;       ///< Every tile was loaded when the view was drawn
+    std::vector<std::uint8_t> data;    ///< RGBA8 pixels or the encoded file
+};
+
+/**
+ * @brief Receives finished images, on an encoder thread, in any order
+ */
+using SnapshotCallback = std::function<void(SnapshotImage&& image)>;
+
+/**
+ * @brief Snapshot rendering configuration
+ */
+struct SnapshotConfig {
+    SnapshotFormat format = SnapshotFormat::PNG;      ///< Output format
+    std::uint32_t readback_slots = 3;                 ///< Pixel pack buffers in flight
+    int encode_threads = 0;                           ///< Encoder workers (0 = hardware concurrency)
+    std::size_t max_pending_images = 0;               ///< Images read back but not yet encoded before rendering waits (0 = 2 per encoder)
+    std::chrono::milliseconds tile_wait{2000};        ///< Longest wait for a view's tiles (0 = draw what is loaded)
+    glm::vec4 clear_color{0.0f, 0.0f, 0.0f, 1.0f};    ///< Background around the globe
+};
+
+/**
+ * @brief Snapshot rendering statistics
+ */
+struct SnapshotStats {
+    std::uint64_t images = 0;               ///< Images delivered (cumulative)
+    std::uint64_t tile_wait_timeouts = 0;   ///< Views drawn with tiles still loading (cumulative)
+    double images_per_second = 0.0;         ///< Throughput of the last batch
+};
+
+/**
+ * @brief Encode RGBA8 pixels (top row first) as a PNG file
+ *
+ * @return The file, empty on failure
+ */
+std::vector<std::uint8_t> EncodeSnapshotPng(std::span<const std::uint8_t> rgba,
+                                            std::uint32_t width, std::uint32_t height);
+
+/**
+ * @brief Renders batches of views through a renderer into images
+ *
+ * Thread Safety: construct, render and destroy on the thread the
+ * renderer's context is current on. The callback runs on encoder threads.
+ */
+class SnapshotRenderer {
+public:
+    /**
+     * @brief Constructor (GL thread)
+     *
+     * @param renderer Initialized renderer to draw with (non-owning, must outlive this)
+     * @param config Snapshot configuration
+     * @throws std::invalid_argument if readback_slots is 0
+     */
+    explicit SnapshotRenderer(Renderer& renderer, const SnapshotConfig& config = SnapshotConfig{});
+
+    /**
+     * @brief Destructor (GL thread); waits for pending encodes
+     */
+    ~SnapshotRenderer();
+
+    SnapshotRenderer(const SnapshotRenderer&) = delete;
+    SnapshotRenderer& operator=(const SnapshotRenderer&) = delete;
+
+    /**
+     * @brief Render every view and deliver its image
+     *
+     * Returns once every image has been passed to @p on_image. The
+     * renderer's viewport size is changed per view and restored afterwards.
+     *
+     * @param views Views to render
+     * @param on_image Receives each image
+     * @return Number of images delivered
+     * @throws std::invalid_argument if a view has an empty size
+     */
+    std::size_t RenderBatch(std::span<const SnapshotView> views, const SnapshotCallback& on_image);
+
+    /**
+     * @brief Get statistics
+     */
+    SnapshotStats GetStats() const;
+
+private:
+    /// Pixel pack buffer holding one view's pixels until they are copied out
+    struct ReadbackSlot {
+        std::uint32_t buffer = 0;
+        std::size_t capacity = 0;
+        void* fence = nullptr;  ///< GLsync of the glReadPixels()
+        bool busy = false;
+        std::size_t index = 0;
+        std::uint32_t width = 0;
+        std::uint32_t height = 0;
+        bool tiles_complete = false;
+    };
+
+    void EnsureFramebuffer(std::uint32_t width, std::uint32_t height);
+    bool WaitForTiles(const SnapshotView& view);
+    void StartReadback(ReadbackSlot& slot);
+    void FinishReadback(ReadbackSlot& slot, const SnapshotCallback& on_image);
+    void WaitForEncodes(std::size_t max_pending);
+    void ReleaseGL();
+
+    Renderer& renderer_;
+    SnapshotConfig config_;
+    std::unique_ptr<DecodeThreadPool> encoders_;
+    std::size_t max_pending_images_ = 0;
+
+    std::uint32_t framebuffer_ = 0;
+    std::uint32_t color_buffer_ = 0;
+    std::uint32_t depth_buffer_ = 0;
+    std::uint32_t framebuffer_width_ = 0;
+    std::uint32_t framebuffer_height_ = 0;
+    std::vector<ReadbackSlot> slots_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable encoded_;
+    std::size_t pending_encodes_ = 0;
+    SnapshotStats stats_;
+};
+
+} // namespace earth_map
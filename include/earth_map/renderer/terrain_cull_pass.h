@@ -0,0 +1,150 @@
+#pragma once
+
+/**
+ * @file terrain_cull_pass.h
+ * @brief GPU-driven culling and indirect drawing of terrain patches
+ *
+ * On GL 4.3+ the terrain instances of a frame are uploaded once and a
+ * compute shader, one invocation per tile, decides what is drawn:
+ *
+ * - Frustum: the tile's bounding sphere, spanning its lowest skirt to its
+ *   highest possible elevation, against the six frustum planes.
+ * - Horizon: tiles whose nearest point lies beyond the horizon of the
+ *   camera, widened by how far the highest terrain can be seen past it.
+ * - Screen-space error: the projected size of a grid quad picks the
+ *   coarsest patch density (TerrainPatchLod) keeping quads under
+ *   TerrainConfig::max_quad_pixels.
+ *
+ * Survivors are appended to the instance range of their density level and
+ * counted into that level's DrawElementsIndirectCommand, so one
+ * glMultiDrawElementsIndirect() draws every visible patch without the
+ * visible count ever coming back to the CPU.
+ *
+ * Contexts below 4.3 keep the CPU path: one instanced draw of every
+ * selected tile at full density.
+ */
+
+#include <earth_map/renderer/terrain_patch.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Per-frame inputs of the cull pass
+ */
+struct TerrainCullParams {
+    glm::mat4 view_projection{1.0f};   ///< Camera view-projection matrix
+    glm::vec3 camera_position{0.0f};   ///< Camera position in globe radii
+    float pixels_per_unit = 1.0f;      ///< Screen pixels covered by one unit at distance 1
+    float min_height = 0.0f;           ///< Lowest displacement, in globe radii
+    float max_height = 0.0f;           ///< Highest displacement, in globe radii
+    float skirt_depth = 0.0f;          ///< Skirt depth as a fraction of the tile's edge length
+    float max_quad_pixels = 8.0f;      ///< Largest grid quad a coarser density may produce
+};
+
+/**
+ * @brief Compute-shader culling feeding one multi-draw-indirect call
+ *
+ * Thread Safety: GL thread only.
+ */
+class TerrainCullPass {
+public:
+    /// Compute workgroup size (tiles per workgroup)
+    static constexpr std::uint32_t kWorkgroupSize = 64;
+
+    TerrainCullPass() = default;
+
+    /**
+     * @brief Destructor (releases GL objects; GL thread)
+     */
+    ~TerrainCullPass();
+
+    // Non-copyable
+    TerrainCullPass(const TerrainCullPass&) = delete;
+    TerrainCullPass& operator=(const TerrainCullPass&) = delete;
+
+    /**
+     * @brief Check whether the current context can run the pass (GL 4.3+)
+     */
+    static bool IsSupported();
+
+    /**
+     * @brief Compile the cull shader and build the draw state
+     *
+     * @param patch_vertex_buffer Buffer of the patch's (u, v, skirt) vertices
+     * @param patch_index_buffer Buffer of every level's indices
+     * @param lods Density levels of the patch, finest first
+     * @param resolution Grid quads per patch edge at the finest level
+     * @return true if the pass is ready
+     */
+    bool Initialize(std::uint32_t patch_vertex_buffer, std::uint32_t patch_index_buffer,
+                    std::span<const TerrainPatchLod> lods, std::uint32_t resolution);
+
+    /**
+     * @brief Cull this frame's instances and build the indirect commands
+     *
+     * @param instances kTerrainInstanceFloats floats per tile
+     * @param params Camera and elevation bounds
+     */
+    void Cull(std::span<const float> instances, const TerrainCullParams& params);
+
+    /**
+     * @brief Draw the patches that survived the last Cull()
+     *
+     * Called with the terrain program bound and its uniforms set.
+     */
+    void Draw() const;
+
+    /**
+     * @brief Release GL objects (GL thread)
+     */
+    void Release();
+
+    /**
+     * @brief Check whether Initialize() succeeded
+     */
+    bool IsInitialized() const { return program_ != 0; }
+
+    /**
+     * @brief Build the commands Cull() resets the indirect buffer to
+     *
+     * Level l draws instances [l * tile_count, l * tile_count + count),
+     * count starting at 0 and raised by the shader.
+     *
+     * @param lods Density levels
+     * @param tile_count Tiles culled this frame
+     * @return Five GLuints per level (count, instanceCount, firstIndex,
+     *         baseVertex, baseInstance)
+     */
+    static std::vector<std::uint32_t> MakeCommands(std::span<const TerrainPatchLod> lods,
+                                                   std::size_t tile_count);
+
+private:
+    std::uint32_t program_ = 0;
+    std::int32_t tile_count_location_ = -1;
+    std::int32_t level_count_location_ = -1;
+    std::int32_t resolution_location_ = -1;
+    std::int32_t planes_location_ = -1;
+    std::int32_t camera_location_ = -1;
+    std::int32_t pixels_per_unit_location_ = -1;
+    std::int32_t min_radius_location_ = -1;
+    std::int32_t max_radius_location_ = -1;
+    std::int32_t max_quad_pixels_location_ = -1;
+    std::int32_t skirt_depth_location_ = -1;
+
+    std::vector<TerrainPatchLod> lods_;
+    std::uint32_t resolution_ = 1;
+
+    std::uint32_t vao_ = 0;
+    std::uint32_t candidate_buffer_ = 0;  ///< This frame's instances (SSBO 0)
+    std::uint32_t visible_buffer_ = 0;    ///< Survivors per level (SSBO 1, instance attributes)
+    std::uint32_t command_buffer_ = 0;    ///< Indirect commands (SSBO 2, draw indirect)
+    std::size_t visible_capacity_ = 0;    ///< Tiles per level the visible buffer holds
+    std::size_t tile_count_ = 0;          ///< Tiles of the last Cull()
+};
+
+} // namespace earth_map
@@ -0,0 +1,192 @@
+#pragma once
+
+/**
+ * @file terrain_elevation_pool.h
+ * @brief Tile-aligned elevation texture array for GPU terrain displacement
+ *
+ * Each layer of one GL_TEXTURE_2D_ARRAY holds the elevation of one tile in
+ * meters, sampled on the same (samples x samples) grid as the terrain
+ * patch vertices: sample i of a row lies at u = i / (samples - 1), so the
+ * shader hits texel centers exactly and neighboring tiles of one zoom agree
+ * on their shared edge. Layers are R16F: half the memory of R32F, exact to
+ * 2 m below 4096 m and to 8 m up to the highest peaks, and still filtered
+ * by the hardware when an ancestor's layer is stretched over a finer tile.
+ *
+ * Like the tile texture pool, tiles are sampled from the ElevationProvider
+ * on worker threads and uploaded on the GL thread within a per-frame
+ * budget, coarsest first, and evicted least-recently-used. Tiles requested
+ * in the current Update() are never evicted by it, so a view needing more
+ * tiles than the pool holds keeps what it has instead of thrashing.
+ *
+ * There is no indirection texture: every terrain patch needs exactly one
+ * elevation tile, so the renderer resolves it (or the nearest resident
+ * ancestor) once per patch on the CPU and passes the layer as an instance
+ * attribute instead of a lookup per vertex.
+ */
+
+#include <earth_map/core/flat_hash_map.h>
+#include <earth_map/math/tile_mathematics.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace earth_map {
+
+class DecodeThreadPool;
+class ElevationProvider;
+
+/**
+ * @brief Elevation tiles resident on the GPU
+ *
+ * Thread Safety: NOT thread-safe — GL thread only (builds run on the
+ * pool's own workers).
+ */
+class TerrainElevationPool {
+public:
+    /// Builds queued or running per worker thread
+    static constexpr std::size_t kMaxPendingBuildsPerWorker = 4;
+
+    /**
+     * @brief Constructor
+     *
+     * @param samples Samples per tile edge (at least 2)
+     * @param max_layers Tiles kept resident (at least 1)
+     * @param skip_gl_init Skip OpenGL calls (for testing)
+     * @param worker_threads Threads sampling tiles (0 = sample synchronously in Update())
+     */
+    TerrainElevationPool(std::uint32_t samples, std::uint32_t max_layers,
+                         bool skip_gl_init = false, int worker_threads = 0);
+
+    /**
+     * @brief Destructor: waits for running builds (the provider must outlive them)
+     */
+    ~TerrainElevationPool();
+
+    TerrainElevationPool(const TerrainElevationPool&) = delete;
+    TerrainElevationPool& operator=(const TerrainElevationPool&) = delete;
+
+    /**
+     * @brief Sample a tile's elevation grid
+     *
+     * Rows run north to south. Points without data are 0 (sea level).
+     * The provider is told the sample spacing, so zoomed-out tiles read
+     * coarse elevation pyramid levels.
+     *
+     * @param provider Elevation source
+     * @param coords Tile to sample
+     * @param samples Samples per edge (at least 2)
+     * @param min_elevation Lower clamp in meters
+     * @param max_elevation Upper clamp in meters
+     * @return samples * samples elevations in meters
+     */
+    static std::vector<float> SampleTile(const ElevationProvider& provider,
+                                         const TileCoordinates& coords,
+                                         std::uint32_t samples,
+                                         float min_elevation,
+                                         float max_elevation);
+
+    /**
+     * @brief Keep @p tiles resident, uploading at most @p max_uploads missing ones
+     *
+     * Missing tiles are built in the given order (duplicates are ignored):
+     * synchronously without workers, otherwise queued for the workers and
+     * uploaded by a later call once sampled. Builds stop early when every
+     * layer holds a tile of this request; finished builds for tiles no
+     * longer requested are dropped.
+     *
+     * @return Number of tiles uploaded
+     */
+    std::size_t Update(const std::vector<TileCoordinates>& tiles,
+                       const ElevationProvider& provider,
+                       std::size_t max_uploads,
+                       float min_elevation,
+                       float max_elevation);
+
+    /**
+     * @brief Upload a tile's elevations, evicting the LRU tile if full
+     *
+     * @param heights GetSamples()^2 elevations in meters
+     * @return Layer index, or -1 if every layer is held by the current Update()
+     */
+    int UploadTile(const TileCoordinates& coords, const float* heights);
+
+    /**
+     * @brief Get the layer holding a tile (-1 if not resident)
+     */
+    int GetLayer(const TileCoordinates& coords) const;
+
+    /**
+     * @brief Drop every tile and pending build (e.g. after the elevation source changed)
+     */
+    void Clear();
+
+    /** @brief Get the OpenGL texture array ID (0 if GL is skipped) */
+    std::uint32_t GetTextureID() const { return texture_id_; }
+
+    /** @brief Get samples per tile edge */
+    std::uint32_t GetSamples() const { return samples_; }
+
+    /** @brief Get the layer count */
+    std::uint32_t GetMaxLayers() const { return max_layers_; }
+
+    /** @brief Get number of resident tiles */
+    std::size_t GetResidentTiles() const { return coord_to_layer_.size(); }
+
+    /** @brief Get number of builds queued or running on the workers */
+    std::size_t GetPendingBuilds() const { return pending_.size(); }
+
+private:
+    struct Layer {
+        TileCoordinates coords;
+        std::uint64_t last_update = 0;
+        std::list<int>::iterator lru_it;
+    };
+
+    /**
+     * @brief Elevations sampled by a worker
+     */
+    struct Build {
+        TileCoordinates coords;
+        std::uint64_t generation = 0;
+        std::vector<float> heights;
+    };
+
+    void Touch(int layer);
+
+    /// Whether a layer can take a new tile in the current Update()
+    bool HasAvailableLayer() const;
+
+    std::uint32_t samples_;
+    std::uint32_t max_layers_;
+    bool skip_gl_init_;
+    std::uint32_t texture_id_ = 0;
+
+    std::vector<Layer> layers_;
+    std::vector<int> free_layers_;
+    TileMap<int> coord_to_layer_;
+
+    /// LRU order: front = most recently used
+    std::list<int> lru_order_;
+
+    /// Incremented per Update(); layers touched in the current one are pinned
+    std::uint64_t update_counter_ = 0;
+
+    /// Tiles queued or running on the workers (GL thread only)
+    TileSet pending_;
+
+    /// Incremented by Clear() and the destructor; older builds are skipped or dropped
+    std::atomic<std::uint64_t> generation_{0};
+
+    /// Builds finished by the workers, waiting for the GL thread
+    std::mutex finished_mutex_;
+    std::vector<Build> finished_;
+
+    /// Declared last: destroyed (and joined) before the state its tasks use
+    std::unique_ptr<DecodeThreadPool> workers_;
+};
+
+} // namespace earth_map
@@ -0,0 +1,111 @@
+#pragma once
+
+/**
+ * @file terrain_patch.h
+ * @brief Shared grid patch for chunked-LOD terrain
+ *
+ * Instead of one globe mesh displaced on the CPU, the terrain is drawn as
+ * one small grid patch per visible tile. Every tile uses the same patch: a
+ * (resolution + 1)^2 vertex grid over the tile's [0,1]^2 square plus a
+ * skirt around its border. The vertex shader places each vertex from the
+ * instance's tile coordinates and displaces it by the tile's elevation
+ * (TerrainElevationPool), so geometric detail follows the tile selection.
+ *
+ * Neighboring tiles of different zooms do not share edge vertices; the
+ * skirts hang below the edges and hide the cracks between them.
+ */
+
+#include <earth_map/math/tile_mathematics.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Chunked-LOD terrain configuration
+ */
+struct TerrainConfig {
+    bool enabled = false;                    ///< Draw terrain patches instead of the globe mesh
+    std::uint32_t patch_resolution = 32;     ///< Grid quads per patch edge (elevation samples = resolution + 1)
+    std::int32_t max_elevation_zoom = 12;    ///< Finer tiles are displaced from an ancestor's elevation
+    std::uint32_t max_elevation_tiles = 256; ///< Elevation tiles kept on the GPU
+    std::uint32_t max_elevation_uploads = 4; ///< Elevation tiles uploaded per frame
+    std::int32_t elevation_workers = 2;      ///< Threads sampling elevation tiles (0 = on the render thread)
+    float skirt_depth = 0.05f;               ///< Skirt depth as a fraction of the tile's edge length
+    bool gpu_culling = true;                 ///< GL 4.3+: cull patches and pick their density in a compute shader (TerrainCullPass)
+    std::uint32_t lod_levels = 3;            ///< Patch densities for GPU culling, each halving the grid
+    float max_quad_pixels = 8.0f;            ///< Screen size a grid quad may reach before a denser level is used
+};
+
+/// Floats per terrain instance: tile x, y, zoom, elevation layer, elevation window (offset, scale)
+constexpr int kTerrainInstanceFloats = 7;
+
+/**
+ * @brief Index range of one density level of the patch
+ */
+struct TerrainPatchLod {
+    std::uint32_t first_index = 0;   ///< Offset into TerrainPatchGeometry::indices
+    std::uint32_t index_count = 0;   ///< Indices of the level (grid then skirt)
+    std::uint32_t step = 1;          ///< Grid vertices skipped per quad edge (1 = full resolution)
+};
+
+/**
+ * @brief Vertices and indices of the shared patch
+ */
+struct TerrainPatchGeometry {
+    /// (u, v, skirt): u east and v south over the tile, skirt 1 for lowered vertices
+    std::vector<glm::vec3> vertices;
+
+    /// Counter-clockwise triangles seen from above (skirts: seen from outside the tile)
+    std::vector<std::uint32_t> indices;
+
+    /// Vertices of the grid proper; skirt vertices follow them
+    std::uint32_t grid_vertex_count = 0;
+
+    /// Density levels, finest first; all share the vertices
+    std::vector<TerrainPatchLod> lods;
+};
+
+/**
+ * @brief Where a tile's elevation comes from
+ *
+ * Elevation patch coordinates are offset + uv * scale in the source tile.
+ */
+struct TerrainElevationWindow {
+    TileCoordinates source;
+    glm::vec2 offset{0.0f};
+    float scale = 1.0f;
+};
+
+/**
+ * @brief Shared terrain patch geometry and tile-to-elevation mapping
+ *
+ * Pure CPU logic with no GL dependencies.
+ */
+class TerrainPatch {
+public:
+    /**
+     * @brief Build the patch
+     *
+     * Level l uses every 2^l-th grid and skirt vertex. Levels stop early
+     * when the resolution is no longer divisible by the step, so their
+     * corners and edges always line up with the full grid.
+     *
+     * @param resolution Grid quads per edge (at least 1)
+     * @param lod_levels Density levels to build (at least 1)
+     */
+    static TerrainPatchGeometry Generate(std::uint32_t resolution, std::uint32_t lod_levels = 1);
+
+    /**
+     * @brief Map a tile to the part of an ancestor (or itself) covering it
+     *
+     * @param tile Tile to draw
+     * @param source_zoom Zoom of the elevation tile to use; clamped to
+     *        [0, tile.zoom]
+     */
+    static TerrainElevationWindow GetElevationWindow(const TileCoordinates& tile,
+                                                     std::int32_t source_zoom);
+};
+
+} // namespace earth_map
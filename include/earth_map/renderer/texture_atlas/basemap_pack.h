@@ -0,0 +1,49 @@
+#pragma once
+
+/**
+ * @file basemap_pack.h
+ * @brief Low-zoom basemap pyramid shipped next to the application
+ *
+ * On a cold start the globe has no imagery until the first tiles arrive
+ * from the network. A basemap pack is a raster PMTiles archive holding the
+ * pyramid from zoom 0 up to a small zoom (z0-z4 is 341 tiles, a few MB as
+ * JPEG). DecodeBasemapPack() decodes it off the GL thread, and
+ * TileTextureCoordinator::AddResidentTiles() uploads and pins the result,
+ * so the first frame is textured without a network round trip and every
+ * tile's fallback chain ends at a resident ancestor.
+ */
+
+#include <earth_map/math/tile_mathematics.h>
+#include <earth_map/renderer/texture_atlas/image_decoder.h>
+#include <string>
+#include <vector>
+
+namespace earth_map {
+
+/// Highest zoom of the default basemap pyramid (z0-z4, 341 tiles)
+constexpr int kBasemapMaxZoom = 4;
+
+/**
+ * @brief Decoded tile kept resident in the tile pool
+ */
+struct ResidentTile {
+    TileCoordinates coords;  ///< Tile coordinates
+    DecodedImage image;      ///< RGBA8 pixels
+};
+
+/**
+ * @brief Decode the low-zoom pyramid of a raster PMTiles archive
+ *
+ * Decodes every tile of zoom 0 to @p max_zoom the archive has, spread over
+ * the hardware threads. Tiles that fail to decode are skipped. Safe from
+ * any thread.
+ *
+ * @param path Path of the .pmtiles file
+ * @param max_zoom Highest zoom to decode (clamped to the archive's)
+ * @return Decoded tiles in zoom order; empty if the archive cannot be
+ *         opened or its tiles are not uncompressed raster images
+ */
+std::vector<ResidentTile> DecodeBasemapPack(const std::string& path,
+                                            int max_zoom = kBasemapMaxZoom);
+
+} // namespace earth_map
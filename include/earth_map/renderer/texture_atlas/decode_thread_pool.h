@@ -0,0 +1,131 @@
+#pragma once
+
+/**
+ * @file decode_thread_pool.h
+ * @brief Work-stealing thread pool for CPU-bound tile decoding
+ *
+ * Each worker owns a deque of tasks. Submissions are spread round-robin
+ * over the deques; a worker that runs dry steals from the others, so one
+ * slow decode does not leave the tiles queued behind it idle while other
+ * cores have nothing to do.
+ *
+ * Design:
+ * - One deque + mutex per worker (no single contended queue)
+ * - Owner pops from the front (oldest first), thieves steal from the back
+ * - Worker count defaults to std::thread::hardware_concurrency()
+ * - Graceful shutdown drains every queued task
+ */
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Work-stealing pool running short CPU-bound tasks
+ *
+ * Thread Safety:
+ * - Submit() is safe from any thread, including from inside a task
+ * - Shutdown() is safe from any thread except a pool worker
+ */
+class DecodeThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    /**
+     * @brief Constructor
+     *
+     * @param num_threads Number of workers (0 = hardware concurrency)
+     */
+    explicit DecodeThreadPool(int num_threads = 0);
+
+    /**
+     * @brief Destructor
+     *
+     * Runs remaining tasks and joins the workers.
+     */
+    ~DecodeThreadPool();
+
+    // Non-copyable
+    DecodeThreadPool(const DecodeThreadPool&) = delete;
+    DecodeThreadPool& operator=(const DecodeThreadPool&) = delete;
+
+    // Non-movable
+    DecodeThreadPool(DecodeThreadPool&&) = delete;
+    DecodeThreadPool& operator=(DecodeThreadPool&&) = delete;
+
+    /**
+     * @brief Queue a task
+     *
+     * Tasks submitted from a pool worker go to that worker's own deque;
+     * other submissions are distributed round-robin.
+     *
+     * @param task Task to run
+     * @return false if the pool is shut down (task is dropped)
+     */
+    bool Submit(Task task);
+
+    /**
+     * @brief Stop accepting tasks, run the queued ones and join workers
+     */
+    void Shutdown();
+
+    /**
+     * @brief Get number of worker threads
+     */
+    std::size_t GetThreadCount() const { return workers_.size(); }
+
+    /**
+     * @brief Get number of tasks queued but not yet started
+     */
+    std::size_t GetPendingCount() const { return pending_.load(); }
+
+    /**
+     * @brief Get number of tasks taken from another worker's deque
+     */
+    std::uint64_t GetStealCount() const { return steal_count_.load(); }
+
+private:
+    /**
+     * @brief Per-worker task deque
+     */
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void WorkerThreadMain(std::size_t index);
+    bool TryPopLocal(std::size_t index, Task& task);
+    bool TrySteal(std::size_t thief, Task& task);
+
+    /// One queue per worker (index matches threads_)
+    std::vector<std::unique_ptr<WorkerQueue>> workers_;
+
+    /// Worker threads
+    std::vector<std::thread> threads_;
+
+    /// Round-robin cursor for external submissions
+    std::atomic<std::size_t> next_queue_{0};
+
+    /// Tasks queued across all deques
+    std::atomic<std::size_t> pending_{0};
+
+    /// Number of successful steals
+    std::atomic<std::uint64_t> steal_count_{0};
+
+    /// Set once Shutdown() begins
+    std::atomic<bool> shutdown_flag_{false};
+
+    /// Mutex and condition variable idle workers sleep on
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+};
+
+} // namespace earth_map
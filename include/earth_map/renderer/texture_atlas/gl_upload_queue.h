@@ -4,33 +4,45 @@
  * @file gl_upload_queue.h
  * @brief Thread-safe queue for OpenGL texture upload commands
  *
- * Provides a multi-producer, single-consumer (MPSC) queue for transferring
- * decoded tile image data from worker threads to the OpenGL rendering thread.
- * Worker threads push upload commands; the GL thread drains the queue.
+ * Provides a bounded, lock-free multi-producer, single-consumer (MPSC) ring
+ * for transferring decoded tile images from worker threads to the OpenGL
+ * rendering thread. Worker threads push upload commands; the GL thread
+ * drains the ring in batches. Pixels stay in a PixelBufferRing slot;
+ * commands only carry its handle.
  */
 
 #include <earth_map/math/tile_mathematics.h>
+#include <earth_map/renderer/texture_atlas/pixel_buffer_ring.h>
+#include <earth_map/renderer/texture_atlas/tile_block_compressor.h>
+#include <earth_map/renderer/texture_atlas/tile_load_trace.h>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 #include <memory>
 #include <functional>
 #include <deque>
 #include <mutex>
+#include <semaphore>
 
 namespace earth_map {
 
+struct VectorTileMesh;
+
 /**
  * @brief Command structure for uploading a tile texture to OpenGL
  *
- * Contains all data needed to upload a decoded tile image to the GPU.
+ * Describes a decoded tile image waiting in a staging slot.
  * Transferred from worker threads to GL thread via GLUploadQueue.
+ * Vector tiles carry their tessellated mesh instead of a slot. A command
+ * with neither a valid slot nor a mesh reports a failed load.
  */
 struct GLUploadCommand {
     /// Tile coordinates (X, Y, Zoom)
     TileCoordinates coords;
 
-    /// Decoded pixel data (RGB or RGBA)
-    std::vector<std::uint8_t> pixel_data;
+    /// Staging slot holding the decoded pixels (invalid = load failed)
+    PixelSlotHandle slot;
 
     /// Image width in pixels
     std::uint32_t width;
@@ -41,9 +53,21 @@ struct GLUploadCommand {
     /// Number of color channels (3 for RGB, 4 for RGBA)
     std::uint8_t channels;
 
+    /// Format of the staged data (BC1 = compressed blocks, channels unused)
+    TileTextureFormat format = TileTextureFormat::RGBA8;
+
+    /// Mip levels staged back to back in the slot (TileMipChain layout)
+    std::uint32_t mip_levels = 1;
+
+    /// Tessellated vector tile (vector tile layers only, no slot)
+    std::shared_ptr<const VectorTileMesh> mesh;
+
     /// Optional callback executed after upload completes (on GL thread)
     std::function<void(const TileCoordinates&)> on_complete;
 
+    /// Lifecycle trace of the request (null unless tracing is enabled)
+    std::shared_ptr<TileLoadTrace> trace;
+
     /**
      * @brief Default constructor
      */
@@ -58,43 +82,55 @@ struct GLUploadCommand {
 };
 
 /**
- * @brief Thread-safe queue for GL upload commands
+ * @brief Thread-safe bounded queue for GL upload commands
  *
- * Multi-producer, single-consumer (MPSC) queue design:
+ * Multi-producer, single-consumer (MPSC) ring design:
  * - Multiple worker threads push decoded tile data (producers)
  * - Single OpenGL thread pops commands for upload (consumer)
  *
- * Implementation uses mutex + deque for simplicity and correctness.
- * Can be optimized to lock-free queue (e.g., moodycamel::ConcurrentQueue)
- * in future if profiling shows contention.
+ * Implementation is a fixed-capacity ring with a sequence number per cell
+ * (Vyukov bounded queue): producers claim cells with one CAS, the consumer
+ * never takes a lock. Free cells are counted by a semaphore, so a producer
+ * finding the ring full sleeps until the consumer frees a cell instead of
+ * growing the queue without bound. Producers that must not block (failure
+ * reports from the network thread) use TryPush(), which spills into a
+ * small overflow list instead; the consumer drains it before the ring.
  *
  * Thread Safety:
- * - Push() is thread-safe (multiple producers)
- * - TryPop() is thread-safe (single consumer expected, but safe for multiple)
+ * - Push() is thread-safe (multiple producers), blocks while the ring is full
+ * - TryPush() is thread-safe and never blocks
+ * - TryPop()/TryPopN() are thread-safe (single consumer expected, but safe
+ *   for multiple)
  * - Size() is thread-safe (approximate)
  *
  * Design Rationale:
  * - FIFO ordering ensures tiles are uploaded in request order
  * - Non-blocking TryPop() allows GL thread to budget upload time per frame
- * - Bounded memory via atlas eviction (managed by caller)
+ * - Bounded memory: pixel storage is the fixed-size PixelBufferRing and
+ *   commands are bounded by the ring capacity
  */
 class GLUploadQueue {
 public:
+    /// Default number of commands the ring holds
+    static constexpr std::size_t kDefaultCapacity = 1024;
+
     /**
      * @brief Constructor
+     *
+     * @param capacity Maximum queued commands (rounded up to a power of two)
      */
-    GLUploadQueue() = default;
+    explicit GLUploadQueue(std::size_t capacity = kDefaultCapacity);
 
     /**
-     * @brief Destructor
+     * @brief Destructor (destroys commands still queued)
      */
-    ~GLUploadQueue() = default;
+    ~GLUploadQueue();
 
     // Non-copyable
     GLUploadQueue(const GLUploadQueue&) = delete;
     GLUploadQueue& operator=(const GLUploadQueue&) = delete;
 
-    // Non-movable (contains std::mutex)
+    // Non-movable (producers may be blocked on the semaphore)
     GLUploadQueue(GLUploadQueue&&) = delete;
     GLUploadQueue& operator=(GLUploadQueue&&) = delete;
 
@@ -102,19 +138,36 @@ public:
      * @brief Push an upload command to the queue (thread-safe)
      *
      * Called by worker threads after decoding tile image data.
-     * Transfers ownership of the command to the queue.
+     * Transfers ownership of the command to the queue. If the ring is full,
+     * waits until the consumer frees a cell or the queue is closed.
      *
      * @param cmd Unique pointer to upload command (moved into queue)
+     * @return true if queued; false for a null command or a closed queue
+     *         (the command is dropped)
      *
      * Thread Safety: Safe to call from multiple threads concurrently
      */
-    void Push(std::unique_ptr<GLUploadCommand> cmd);
+    bool Push(std::unique_ptr<GLUploadCommand> cmd);
+
+    /**
+     * @brief Push an upload command without ever blocking (thread-safe)
+     *
+     * Takes a free ring cell if there is one, otherwise appends the command
+     * to an unbounded overflow list that TryPop()/TryPopN() drain before
+     * the ring. Meant for commands without pixels, such as failure reports
+     * from threads that must not stall (the loader's I/O thread).
+     *
+     * @param cmd Unique pointer to upload command (moved into queue)
+     * @return true if queued; false for a null command or a closed queue
+     */
+    bool TryPush(std::unique_ptr<GLUploadCommand> cmd);
 
     /**
      * @brief Try to pop an upload command from the queue (thread-safe, non-blocking)
      *
      * Called by GL thread to retrieve next command for upload.
-     * Returns nullptr if queue is empty (non-blocking).
+     * Returns nullptr if queue is empty (non-blocking). Overflowed
+     * commands come first.
      *
      * @return Unique pointer to upload command, or nullptr if empty
      *
@@ -123,13 +176,37 @@ public:
      */
     std::unique_ptr<GLUploadCommand> TryPop();
 
+    /**
+     * @brief Pop up to @p max_count commands (thread-safe, non-blocking)
+     *
+     * @param out Receives the commands, appended in FIFO order
+     * @param max_count Maximum number of commands to pop
+     * @return Number of commands appended
+     */
+    std::size_t TryPopN(std::vector<std::unique_ptr<GLUploadCommand>>& out,
+                        std::size_t max_count);
+
+    /**
+     * @brief Stop accepting commands and wake blocked producers
+     *
+     * Pushes after Close() drop their command. Commands already queued can
+     * still be popped. Call before shutting down producers when the consumer
+     * will stop draining.
+     */
+    void Close();
+
+    /**
+     * @brief Check if Close() was called
+     */
+    bool IsClosed() const { return closed_.load(std::memory_order_acquire); }
+
     /**
      * @brief Get current queue size (thread-safe, approximate)
      *
      * Returns approximate size due to concurrent access.
      * Useful for monitoring and debugging, not for synchronization.
      *
-     * @return Current number of commands in queue
+     * @return Current number of commands in queue, overflow included
      *
      * Thread Safety: Safe to call concurrently, but result may be stale
      */
@@ -146,12 +223,66 @@ public:
         return Size() == 0;
     }
 
+    /**
+     * @brief Get ring capacity
+     */
+    std::size_t Capacity() const { return capacity_; }
+
+    /**
+     * @brief Get number of pushes that had to wait for a free cell
+     */
+    std::uint64_t GetBlockedPushCount() const {
+        return blocked_pushes_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get number of TryPush() calls that found the ring full
+     */
+    std::uint64_t GetOverflowPushCount() const {
+        return overflow_pushes_.load(std::memory_order_relaxed);
+    }
+
 private:
-    /// Mutex protecting queue access
-    mutable std::mutex mutex_;
+    /**
+     * @brief Ring cell; sequence tells producers and consumer whose turn it is
+     */
+    struct Cell {
+        std::atomic<std::size_t> sequence{0};
+        GLUploadCommand* command = nullptr;
+    };
+
+    /// Cache line size used to keep producer and consumer indices apart
+    static constexpr std::size_t kCacheLineSize = 64;
+
+    void Enqueue(GLUploadCommand* command);
+    GLUploadCommand* Dequeue();
+
+    /// Pop the oldest overflowed command (null if there is none)
+    std::unique_ptr<GLUploadCommand> PopOverflow();
+
+    std::size_t capacity_;
+    std::size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+
+    /// Next cell producers claim
+    alignas(kCacheLineSize) std::atomic<std::size_t> enqueue_pos_{0};
+
+    /// Next cell the consumer reads
+    alignas(kCacheLineSize) std::atomic<std::size_t> dequeue_pos_{0};
+
+    /// Free cells; producers acquire before claiming one (backpressure)
+    std::counting_semaphore<> free_cells_;
+
+    /// Commands TryPush() could not fit in the ring (guarded by overflow_mutex_)
+    std::deque<std::unique_ptr<GLUploadCommand>> overflow_;
+    std::mutex overflow_mutex_;
+
+    /// Size of overflow_, so the consumer skips the lock while it is empty
+    std::atomic<std::size_t> overflow_size_{0};
 
-    /// Internal queue storage (FIFO)
-    std::deque<std::unique_ptr<GLUploadCommand>> queue_;
+    std::atomic<bool> closed_{false};
+    std::atomic<std::uint64_t> blocked_pushes_{0};
+    std::atomic<std::uint64_t> overflow_pushes_{0};
 };
 
 } // namespace earth_map
@@ -0,0 +1,262 @@
+#pragma once
+
+/**
+ * @file image_decoder.h
+ * @brief Pluggable image decoders for tile textures
+ *
+ * Tile images are decoded by the first registered backend that supports the
+ * detected format:
+ * - libjpeg-turbo (SIMD) for JPEG when built with EARTH_MAP_WITH_TURBOJPEG
+ * - libspng for PNG when built with EARTH_MAP_WITH_SPNG
+ * - stb_image for everything, always registered last as the fallback
+ *
+ * If a preferred backend rejects an image, the next one that supports the
+ * format is tried. Decode time is recorded per format so backend gains can
+ * be measured.
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Encoded image container format
+ */
+enum class ImageFormat : std::uint8_t {
+    Unknown = 0,
+    PNG,
+    JPEG,
+    WebP
+};
+
+/// Number of ImageFormat values (for per-format tables)
+constexpr std::size_t kImageFormatCount = 4;
+
+/**
+ * @brief Get a short human readable name for a format
+ */
+const char* ImageFormatName(ImageFormat format);
+
+/**
+ * @brief Detect image format from the leading magic bytes
+ *
+ * @param data Encoded image bytes
+ * @param size Number of bytes
+ * @return Detected format, or ImageFormat::Unknown
+ */
+ImageFormat DetectImageFormat(const std::uint8_t* data, std::size_t size);
+
+/**
+ * @brief Read an image's pixel size from its header without decoding it
+ *
+ * @param data Encoded image bytes
+ * @param size Number of bytes
+ * @param width Receives the width in pixels
+ * @param height Receives the height in pixels
+ * @return false if the format is unknown or the header is truncated
+ */
+bool ReadImageSize(const std::uint8_t* data, std::size_t size,
+                   std::uint32_t& width, std::uint32_t& height);
+
+/**
+ * @brief Decoded image (always RGBA8)
+ */
+struct DecodedImage {
+    /// Tightly packed RGBA8 pixels (width * height * 4 bytes)
+    std::vector<std::uint8_t> pixels;
+
+    /// Image width in pixels
+    std::uint32_t width = 0;
+
+    /// Image height in pixels
+    std::uint32_t height = 0;
+
+    /// Number of channels in pixels (always 4)
+    std::uint8_t channels = 0;
+};
+
+/**
+ * @brief Image decoder backend interface
+ *
+ * Implementations must be safe to call from several decode threads at once.
+ */
+class ImageDecoder {
+public:
+    virtual ~ImageDecoder() = default;
+
+    /**
+     * @brief Get backend name (for logs and stats)
+     */
+    virtual const char* GetName() const = 0;
+
+    /**
+     * @brief Check whether this backend can decode a format
+     */
+    virtual bool Supports(ImageFormat format) const = 0;
+
+    /**
+     * @brief Decode an image into RGBA8
+     *
+     * @param data Encoded image bytes
+     * @param size Number of bytes
+     * @param out Decoded image (valid only if true is returned)
+     * @return true on success
+     */
+    virtual bool Decode(const std::uint8_t* data, std::size_t size, DecodedImage& out) = 0;
+
+    /**
+     * @brief Decode an image into RGBA8 directly into caller memory
+     *
+     * Used to decode into mapped upload buffers. The default implementation
+     * decodes with Decode() and copies; backends that can write into a
+     * caller buffer override it to skip the copy.
+     *
+     * @param data Encoded image bytes
+     * @param size Number of bytes
+     * @param dst Destination for tightly packed RGBA8 pixels
+     * @param capacity Bytes available at dst
+     * @param out Receives width, height and channels (pixels stays empty)
+     * @return true on success; false also if the image does not fit
+     */
+    virtual bool DecodeInto(const std::uint8_t* data, std::size_t size,
+                            std::uint8_t* dst, std::size_t capacity, DecodedImage& out);
+
+protected:
+    ImageDecoder() = default;
+};
+
+/**
+ * @brief Create the stb_image decoder (supports every format stb knows)
+ */
+std::unique_ptr<ImageDecoder> CreateStbImageDecoder();
+
+/**
+ * @brief Create the libjpeg-turbo decoder
+ *
+ * @return Decoder, or nullptr if the library was built without libjpeg-turbo
+ */
+std::unique_ptr<ImageDecoder> CreateTurboJpegDecoder();
+
+/**
+ * @brief Create the libspng decoder
+ *
+ * @return Decoder, or nullptr if the library was built without libspng
+ */
+std::unique_ptr<ImageDecoder> CreateSpngDecoder();
+
+/**
+ * @brief Decode statistics for one image format
+ */
+struct ImageFormatDecodeStats {
+    std::uint64_t decoded = 0;           ///< Successful decodes
+    std::uint64_t failed = 0;            ///< Images no backend could decode
+    std::uint64_t total_decode_us = 0;   ///< Total time of successful decodes
+    std::uint64_t max_decode_us = 0;     ///< Slowest successful decode
+
+    /**
+     * @brief Average time per successful decode in microseconds
+     */
+    double GetAverageDecodeUs() const {
+        return decoded > 0 ? static_cast<double>(total_decode_us) / decoded : 0.0;
+    }
+};
+
+/**
+ * @brief Decode statistics for all formats
+ */
+struct ImageDecodeStats {
+    std::array<ImageFormatDecodeStats, kImageFormatCount> per_format{};
+
+    /**
+     * @brief Get statistics for one format
+     */
+    const ImageFormatDecodeStats& Get(ImageFormat format) const {
+        return per_format[static_cast<std::size_t>(format)];
+    }
+};
+
+/**
+ * @brief Ordered set of decoder backends with format dispatch
+ *
+ * Thread Safety:
+ * - Register() must happen before decoding starts
+ * - Decode() and GetStats() are safe from any thread
+ */
+class ImageDecoderRegistry {
+public:
+    /**
+     * @brief Create a registry with every backend built into the library
+     *
+     * SIMD backends come first when available; stb_image is always last.
+     */
+    static std::unique_ptr<ImageDecoderRegistry> CreateDefault();
+
+    ImageDecoderRegistry() = default;
+
+    // Non-copyable
+    ImageDecoderRegistry(const ImageDecoderRegistry&) = delete;
+    ImageDecoderRegistry& operator=(const ImageDecoderRegistry&) = delete;
+
+    // Non-movable (statistics are atomics)
+    ImageDecoderRegistry(ImageDecoderRegistry&&) = delete;
+    ImageDecoderRegistry& operator=(ImageDecoderRegistry&&) = delete;
+
+    /**
+     * @brief Append a backend (earlier backends are preferred)
+     *
+     * @param decoder Backend to add (ignored if null)
+     */
+    void Register(std::unique_ptr<ImageDecoder> decoder);
+
+    /**
+     * @brief Decode an image with the preferred backend for its format
+     *
+     * @param data Encoded image bytes
+     * @param size Number of bytes
+     * @param out Decoded image (valid only if true is returned)
+     * @return true if any supporting backend decoded the image
+     */
+    bool Decode(const std::uint8_t* data, std::size_t size, DecodedImage& out);
+
+    /**
+     * @brief Decode an image directly into caller memory
+     *
+     * Same backend selection and statistics as Decode().
+     *
+     * @see ImageDecoder::DecodeInto
+     */
+    bool DecodeInto(const std::uint8_t* data, std::size_t size,
+                    std::uint8_t* dst, std::size_t capacity, DecodedImage& out);
+
+    /**
+     * @brief Get backend names that would be tried for a format, in order
+     */
+    std::vector<std::string> GetDecoderNames(ImageFormat format) const;
+
+    /**
+     * @brief Get a snapshot of decode statistics
+     */
+    ImageDecodeStats GetStats() const;
+
+private:
+    template <typename DecodeFn>
+    bool DecodeWith(const std::uint8_t* data, std::size_t size, DecodeFn&& decode);
+
+    struct AtomicFormatStats {
+        std::atomic<std::uint64_t> decoded{0};
+        std::atomic<std::uint64_t> failed{0};
+        std::atomic<std::uint64_t> total_decode_us{0};
+        std::atomic<std::uint64_t> max_decode_us{0};
+    };
+
+    std::vector<std::unique_ptr<ImageDecoder>> decoders_;
+    std::array<AtomicFormatStats, kImageFormatCount> stats_;
+};
+
+} // namespace earth_map
@@ -0,0 +1,125 @@
+#pragma once
+
+/**
+ * @file overzoom_tile_synthesizer.h
+ * @brief Builds tiles beyond a provider's maximum zoom from an ancestor tile
+ *
+ * Providers stop at GetMaxZoom(), but the camera can zoom further. Instead of
+ * requesting tiles the loader can only reject, an overzoomed tile is made by
+ * cropping the quadrant of its deepest available ancestor that it covers and
+ * upscaling it (bilinear) to full tile size. The result is uploaded like any
+ * downloaded tile, so the renderer never has to fall back through the
+ * indirection chain at high zoom.
+ *
+ * One ancestor serves 4^n overzoomed descendants, so decoded ancestors are
+ * kept in a small LRU: neighbouring overzoomed tiles crop from the same
+ * pixels instead of decoding the same image again.
+ */
+
+#include <earth_map/math/tile_mathematics.h>
+#include <earth_map/renderer/texture_atlas/image_decoder.h>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+namespace earth_map {
+
+/**
+ * @brief Overzoomed tile synthesis and decoded ancestor cache
+ *
+ * Thread Safety:
+ * - FindSource(), AddSource() and Clear() are safe from any thread
+ * - Static helpers are pure functions
+ */
+class OverzoomTileSynthesizer {
+public:
+    /// Deepest overzoom: a 256px ancestor quadrant is one pixel wide after 8 levels
+    static constexpr std::int32_t kMaxOverzoomLevels = 8;
+
+    /// Decoded ancestors kept by default (16 x 256px RGBA8 = 4 MB)
+    static constexpr std::size_t kDefaultCachedSources = 16;
+
+    /**
+     * @brief Constructor
+     *
+     * @param max_cached_sources Decoded ancestors kept for reuse (0 = no caching)
+     */
+    explicit OverzoomTileSynthesizer(std::size_t max_cached_sources = kDefaultCachedSources);
+
+    /**
+     * @brief Get the ancestor an overzoomed tile is built from
+     *
+     * @param target Requested tile
+     * @param max_zoom Deepest zoom the provider serves
+     * @return Ancestor at max_zoom, or std::nullopt if target is not beyond
+     *         max_zoom or is more than kMaxOverzoomLevels beyond it
+     */
+    static std::optional<TileCoordinates> GetSourceTile(const TileCoordinates& target,
+                                                        std::int32_t max_zoom);
+
+    /**
+     * @brief Crop target's area out of an ancestor image and upscale it
+     *
+     * The output has the ancestor's size and channel count. Samples are
+     * taken at pixel centers and clamped to the ancestor image, so adjacent
+     * overzoomed tiles blend across their shared edge without seams.
+     *
+     * @param source_image Decoded ancestor pixels
+     * @param source Ancestor coordinates (must contain target)
+     * @param target Overzoomed tile to build
+     * @param dst Output pixels
+     * @param capacity Bytes available at dst
+     * @return true if target lies inside source and the result fits dst
+     */
+    static bool Synthesize(const DecodedImage& source_image,
+                           const TileCoordinates& source,
+                           const TileCoordinates& target,
+                           std::uint8_t* dst,
+                           std::size_t capacity);
+
+    /**
+     * @brief Look up a decoded ancestor (marks it recently used)
+     *
+     * @return Decoded image, or nullptr if not cached
+     */
+    std::shared_ptr<const DecodedImage> FindSource(const TileCoordinates& source);
+
+    /**
+     * @brief Keep a decoded ancestor for later overzoomed tiles
+     *
+     * Evicts the least recently used ancestor when full.
+     */
+    void AddSource(const TileCoordinates& source, std::shared_ptr<const DecodedImage> image);
+
+    /**
+     * @brief Drop every cached ancestor (the tiles' source changed)
+     */
+    void Clear();
+
+    /**
+     * @brief Get number of cached decoded ancestors
+     */
+    std::size_t GetCachedSourceCount() const;
+
+private:
+    using LruList = std::list<std::pair<TileCoordinates, std::shared_ptr<const DecodedImage>>>;
+
+    /// Maximum decoded ancestors kept
+    std::size_t max_cached_sources_;
+
+    /// Most recently used first
+    LruList lru_;
+
+    /// Coordinates → position in lru_
+    std::unordered_map<TileCoordinates, LruList::iterator, TileCoordinatesHash> index_;
+
+    /// Guards lru_ and index_
+    mutable std::mutex mutex_;
+};
+
+} // namespace earth_map
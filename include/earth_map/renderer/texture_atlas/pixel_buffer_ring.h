@@ -0,0 +1,176 @@
+#pragma once
+
+/**
+ * @file pixel_buffer_ring.h
+ * @brief Ring of persistently mapped pixel unpack buffer slots
+ *
+ * Decode threads write tile pixels straight into a slot of one large
+ * GL_PIXEL_UNPACK_BUFFER mapped with GL_MAP_PERSISTENT_BIT, and the GL thread
+ * uploads from that slot with glTexSubImage3D reading from the bound buffer.
+ * This removes the heap copy in GLUploadCommand and lets the driver DMA
+ * from the buffer instead of copying client memory synchronously.
+ *
+ * Slot lifecycle:
+ *   free → Acquire() (worker) → decode into GetSlotData() → GLUploadCommand →
+ *   upload (GL thread) → FenceAndRelease() → fence signalled → Reclaim() → free
+ *
+ * Without GL (skip_gl_init, or no ARB_buffer_storage) the slots are plain
+ * CPU memory and are freed immediately after upload.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Handle to one slot of a PixelBufferRing
+ */
+struct PixelSlotHandle {
+    static constexpr std::uint32_t kInvalidIndex = 0xFFFFFFFFu;
+
+    /// Slot index in the ring (kInvalidIndex = no slot)
+    std::uint32_t index = kInvalidIndex;
+
+    /**
+     * @brief Check whether the handle refers to a slot
+     */
+    bool IsValid() const { return index != kInvalidIndex; }
+};
+
+/**
+ * @brief Fixed-size ring of staging slots for tile uploads
+ *
+ * Thread Safety:
+ * - Acquire(), TryAcquire(), Release(), GetSlotData(): safe from any thread
+ * - FenceAndRelease(), Reclaim(), GetBufferID(): GL thread only
+ */
+class PixelBufferRing {
+public:
+    /// Default number of slots (64 × 256 KiB = 16 MiB for 256px RGBA tiles)
+    static constexpr std::uint32_t kDefaultSlotCount = 64;
+
+    /**
+     * @brief Constructor
+     *
+     * @param slot_count Number of slots
+     * @param slot_size Bytes per slot (one decoded tile)
+     * @param skip_gl_init Use CPU memory instead of a GL buffer (for testing)
+     */
+    PixelBufferRing(std::uint32_t slot_count, std::size_t slot_size, bool skip_gl_init = false);
+
+    /**
+     * @brief Destructor (GL thread when GL-backed)
+     */
+    ~PixelBufferRing();
+
+    // Non-copyable
+    PixelBufferRing(const PixelBufferRing&) = delete;
+    PixelBufferRing& operator=(const PixelBufferRing&) = delete;
+
+    // Non-movable
+    PixelBufferRing(PixelBufferRing&&) = delete;
+    PixelBufferRing& operator=(PixelBufferRing&&) = delete;
+
+    /**
+     * @brief Take a free slot, waiting up to @p timeout for one
+     *
+     * @return Valid handle, or an invalid one if no slot freed in time
+     */
+    PixelSlotHandle Acquire(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Take a free slot without waiting
+     */
+    PixelSlotHandle TryAcquire();
+
+    /**
+     * @brief Return a slot that was never uploaded (e.g. decode failed)
+     */
+    void Release(PixelSlotHandle slot);
+
+    /**
+     * @brief Get writable pointer to a slot's memory
+     *
+     * @return Pointer to GetSlotSize() bytes, or nullptr for an invalid handle
+     */
+    std::uint8_t* GetSlotData(PixelSlotHandle slot) const;
+
+    /**
+     * @brief Release a slot once the GPU has consumed the upload reading it
+     *
+     * Call right after issuing the upload. GL-backed slots are held until
+     * their fence signals; CPU slots are freed immediately.
+     */
+    void FenceAndRelease(PixelSlotHandle slot);
+
+    /**
+     * @brief Free slots whose upload fences have signalled (non-blocking)
+     *
+     * @return Number of slots returned to the free list
+     */
+    std::size_t Reclaim();
+
+    /**
+     * @brief Get GL buffer ID to bind as GL_PIXEL_UNPACK_BUFFER (0 if CPU-backed)
+     */
+    std::uint32_t GetBufferID() const { return buffer_id_; }
+
+    /**
+     * @brief Get byte offset of a slot inside the GL buffer
+     */
+    std::size_t GetSlotOffset(PixelSlotHandle slot) const {
+        return static_cast<std::size_t>(slot.index) * slot_size_;
+    }
+
+    /** @brief Check if slots live in a persistently mapped GL buffer */
+    bool IsPersistentlyMapped() const { return buffer_id_ != 0; }
+
+    /** @brief Get bytes per slot */
+    std::size_t GetSlotSize() const { return slot_size_; }
+
+    /** @brief Get number of slots */
+    std::uint32_t GetSlotCount() const { return slot_count_; }
+
+    /** @brief Get number of free slots */
+    std::size_t GetFreeCount() const;
+
+private:
+    /**
+     * @brief Slot waiting for its upload fence
+     */
+    struct FencedSlot {
+        std::uint32_t index;
+        void* fence;  ///< GLsync
+    };
+
+    bool CreateMappedBuffer();
+    void PushFree(std::uint32_t index);
+
+    std::uint32_t slot_count_;
+    std::size_t slot_size_;
+
+    /// GL buffer (0 when CPU-backed)
+    std::uint32_t buffer_id_ = 0;
+
+    /// Base of the mapped GL buffer or of cpu_storage_
+    std::uint8_t* base_ = nullptr;
+
+    /// CPU backing store when no GL buffer is used
+    std::vector<std::uint8_t> cpu_storage_;
+
+    /// Free slot indices
+    mutable std::mutex free_mutex_;
+    std::condition_variable free_cv_;
+    std::vector<std::uint32_t> free_slots_;
+
+    /// Slots uploaded but not yet known to be consumed by the GPU (GL thread only)
+    std::deque<FencedSlot> fenced_slots_;
+};
+
+} // namespace earth_map
@@ -0,0 +1,194 @@
+#pragma once
+
+/**
+ * @file shelf_texture_atlas.h
+ * @brief Dynamic texture atlas packing variable-size regions on shelves
+ *
+ * TextureAtlasManager packs equal tiles on a fixed grid. Glyphs, icons and
+ * other small images come in every size, so this variant packs them on
+ * horizontal shelves: a region goes on the best-fitting shelf that still
+ * has room, or opens a new shelf below the last one. Regions can be
+ * released; a shelf whose regions are all released is reused from its left
+ * edge, and empty shelves at the bottom are given back to the free height.
+ *
+ * Design:
+ * - Single-channel (R8) or RGBA8 texture, default 1024x1024
+ * - Padding around each region keeps linear filtering from bleeding
+ * - Shelf choice: smallest height that fits and wastes at most half of it
+ * - Thread safety: Designed for single-threaded GL access only
+ */
+
+#include <glm/vec4.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Region allocated in a shelf atlas
+ */
+struct ShelfAtlasRegion {
+    /// Top-left pixel of the region (inside the padding)
+    std::uint32_t x = 0;
+    std::uint32_t y = 0;
+
+    /// Size in pixels (without padding)
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+
+    /// Shelf holding the region (for Release)
+    std::uint32_t shelf = 0;
+
+    /// UV coordinates (u_min, v_min, u_max, v_max)
+    glm::vec4 uv{0.0f};
+};
+
+/**
+ * @brief Shelf atlas occupancy
+ */
+struct ShelfAtlasStats {
+    std::size_t shelves = 0;          ///< Shelves opened
+    std::size_t regions = 0;          ///< Regions allocated and not released
+    std::size_t used_pixels = 0;      ///< Area of those regions, padding included
+    std::size_t shelf_pixels = 0;     ///< Area covered by shelves
+    std::uint64_t resets = 0;         ///< Reset() calls
+};
+
+/**
+ * @brief Texture atlas for variable-size images packed on shelves
+ *
+ * Thread Safety:
+ * - NOT thread-safe - designed for single-threaded GL thread access only
+ */
+class ShelfTextureAtlas {
+public:
+    /// Default atlas edge in pixels
+    static constexpr std::uint32_t kDefaultSize = 1024;
+
+    /// Default padding around each region in pixels
+    static constexpr std::uint32_t kDefaultPadding = 1;
+
+    /**
+     * @brief Constructor
+     *
+     * @param atlas_width Atlas texture width in pixels
+     * @param atlas_height Atlas texture height in pixels
+     * @param channels 1 (R8) or 4 (RGBA8)
+     * @param padding Empty pixels kept around each region
+     * @param skip_gl_init Skip OpenGL initialization (for testing)
+     */
+    explicit ShelfTextureAtlas(std::uint32_t atlas_width = kDefaultSize,
+                               std::uint32_t atlas_height = kDefaultSize,
+                               std::uint8_t channels = 1,
+                               std::uint32_t padding = kDefaultPadding,
+                               bool skip_gl_init = false);
+
+    /**
+     * @brief Destructor
+     *
+     * Cleans up OpenGL resources.
+     */
+    ~ShelfTextureAtlas();
+
+    // Non-copyable
+    ShelfTextureAtlas(const ShelfTextureAtlas&) = delete;
+    ShelfTextureAtlas& operator=(const ShelfTextureAtlas&) = delete;
+
+    // Non-movable (owns GL resources)
+    ShelfTextureAtlas(ShelfTextureAtlas&&) = delete;
+    ShelfTextureAtlas& operator=(ShelfTextureAtlas&&) = delete;
+
+    /**
+     * @brief Allocate a region of @p width x @p height pixels
+     *
+     * @return The region, or std::nullopt if no shelf has room (Reset() or
+     *         Release() regions and retry)
+     */
+    std::optional<ShelfAtlasRegion> Allocate(std::uint32_t width, std::uint32_t height);
+
+    /**
+     * @brief Release a region; its shelf is reused once all its regions are released
+     */
+    void Release(const ShelfAtlasRegion& region);
+
+    /**
+     * @brief Upload pixels into a region
+     *
+     * The padding around the region is cleared in the same upload, so
+     * pixels of a released region never bleed into a new one.
+     *
+     * @param region Region from Allocate()
+     * @param pixels Tightly packed rows of region.width x channels bytes
+     * @return true on success
+     *
+     * Thread Safety: Must be called from GL thread
+     */
+    bool Upload(const ShelfAtlasRegion& region, const std::uint8_t* pixels);
+
+    /**
+     * @brief Release every region
+     *
+     * Regions allocated before the reset must not be released afterwards.
+     */
+    void Reset();
+
+    /**
+     * @brief Get atlas texture ID
+     */
+    std::uint32_t GetAtlasTextureID() const { return atlas_texture_id_; }
+
+    /** @brief Get atlas width in pixels */
+    std::uint32_t GetAtlasWidth() const { return atlas_width_; }
+
+    /** @brief Get atlas height in pixels */
+    std::uint32_t GetAtlasHeight() const { return atlas_height_; }
+
+    /** @brief Get bytes per pixel */
+    std::uint8_t GetChannels() const { return channels_; }
+
+    /**
+     * @brief Get occupancy statistics
+     */
+    ShelfAtlasStats GetStats() const;
+
+private:
+    /**
+     * @brief One row of regions
+     */
+    struct Shelf {
+        std::uint32_t y = 0;          ///< Top edge
+        std::uint32_t height = 0;     ///< Padded height
+        std::uint32_t cursor = 0;     ///< Next free x
+        std::uint32_t regions = 0;    ///< Live regions
+        std::size_t used_pixels = 0;  ///< Padded area of the live regions
+    };
+
+    void CreateAtlasTexture();
+    ShelfAtlasRegion Place(std::uint32_t shelf_index, std::uint32_t width, std::uint32_t height);
+
+    /// OpenGL atlas texture ID
+    std::uint32_t atlas_texture_id_ = 0;
+
+    std::uint32_t atlas_width_;
+    std::uint32_t atlas_height_;
+    std::uint8_t channels_;
+    std::uint32_t padding_;
+
+    /// Skip OpenGL initialization (for testing)
+    bool skip_gl_init_;
+
+    /// Shelves from top to bottom
+    std::vector<Shelf> shelves_;
+
+    /// Top edge of the unused space below the last shelf
+    std::uint32_t free_y_ = 0;
+
+    std::uint64_t resets_ = 0;
+
+    /// Padded staging area for uploads
+    std::vector<std::uint8_t> staging_;
+};
+
+} // namespace earth_map
@@ -15,11 +15,11 @@
  * - Thread safety: Designed for single-threaded GL access only
  */
 
+#include <earth_map/core/flat_hash_map.h>
 #include <earth_map/math/tile_mathematics.h>
 #include <glm/vec4.hpp>
 #include <cstdint>
 #include <vector>
-#include <unordered_map>
 #include <queue>
 #include <chrono>
 #include <memory>
@@ -317,7 +317,7 @@ private:
     std::queue<int> free_slots_;
 
     /// Map: tile coordinates → slot index
-    std::unordered_map<TileCoordinates, int, TileCoordinatesHash> coord_to_slot_;
+    TileMap<int> coord_to_slot_;
 };
 
 } // namespace earth_map
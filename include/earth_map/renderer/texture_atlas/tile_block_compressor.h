@@ -0,0 +1,84 @@
+#pragma once
+
+/**
+ * @file tile_block_compressor.h
+ * @brief Real-time block compression of decoded tiles for the tile pool
+ *
+ * An uncompressed 256x256 RGBA8 tile takes 256 KB of VRAM and upload
+ * bandwidth. Compressed to BC1 (S3TC DXT1) it takes 32 KB, so the same
+ * memory holds eight times as many tiles and uploads move an eighth of the
+ * bytes. Map imagery is opaque, so the format loses no channel.
+ *
+ * The encoder is the fast bounding-box kind used for run-time transcoding:
+ * endpoints are the inset corners of the block's color bounding box, along
+ * the diagonal that matches the sign of the block's color covariance, and
+ * each texel takes the nearest of the four palette colors. It runs on the
+ * decode threads, right after a tile is decoded into its staging slot.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace earth_map {
+
+/**
+ * @brief Texel format of the tile pool and of staged tile uploads
+ */
+enum class TileTextureFormat : std::uint8_t {
+    RGBA8,  ///< Uncompressed, 4 bytes per texel
+    BC1     ///< S3TC DXT1 opaque RGB, 8 bytes per 4x4 block
+};
+
+/**
+ * @brief BC1 encoder/decoder for tile images
+ *
+ * Thread Safety: Stateless, safe from any thread.
+ */
+class TileBlockCompressor {
+public:
+    /// Block edge length in texels
+    static constexpr std::uint32_t kBlockSize = 4;
+    /// Bytes per encoded BC1 block
+    static constexpr std::size_t kBC1BlockBytes = 8;
+
+    /**
+     * @brief Bytes an image of the given size takes in a format
+     *
+     * @return 0 if the size is not representable (BC1 needs multiples of 4)
+     */
+    static std::size_t GetEncodedSize(TileTextureFormat format,
+                                      std::uint32_t width, std::uint32_t height);
+
+    /**
+     * @brief Compress an image to BC1
+     *
+     * Blocks are written row by row. @p dst may equal @p src: each block is
+     * read before it is written, and a block's output always ends before the
+     * first texel of any later block, so the image is compressed in place.
+     *
+     * @param src Pixels, row-major, 3 (RGB) or 4 (RGBA) channels
+     * @param dst Output blocks
+     * @param capacity Bytes available at dst
+     * @return true if the image was compressed
+     */
+    static bool CompressBC1(const std::uint8_t* src, std::uint32_t width, std::uint32_t height,
+                            std::uint8_t channels, std::uint8_t* dst, std::size_t capacity);
+
+    /**
+     * @brief Encode one 4x4 block
+     *
+     * @param rgba 16 texels, row-major, 4 bytes each (alpha ignored)
+     * @param block Receives kBC1BlockBytes bytes
+     */
+    static void EncodeBC1Block(const std::uint8_t* rgba, std::uint8_t* block);
+
+    /**
+     * @brief Decode one 4x4 block as the GPU does
+     *
+     * @param block kBC1BlockBytes bytes
+     * @param rgba Receives 16 texels, row-major, 4 bytes each (alpha 255)
+     */
+    static void DecodeBC1Block(const std::uint8_t* block, std::uint8_t* rgba);
+};
+
+} // namespace earth_map
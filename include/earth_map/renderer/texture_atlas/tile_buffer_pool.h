@@ -0,0 +1,161 @@
+#pragma once
+
+/**
+ * @file tile_buffer_pool.h
+ * @brief Recycling pool for decode scratch buffers and upload commands
+ *
+ * Every loaded tile used to allocate a GLUploadCommand and, on the decode
+ * path, a pixel vector of a few hundred KiB that was freed again a frame
+ * later. Under sustained panning that churn fragments the heap and shows
+ * up as allocator time on the decode threads. The pool keeps released
+ * buffers in power-of-two size classes and released commands in a free
+ * list, so steady-state loading allocates nothing.
+ *
+ * Lifecycle:
+ *   AcquireBuffer() (decode thread) → decode → ReleaseBuffer()
+ *   AcquireCommand() (worker) → GLUploadQueue → upload (GL thread) →
+ *   ReleaseCommand()
+ */
+
+#include <earth_map/math/tile_mathematics.h>
+#include <earth_map/renderer/texture_atlas/gl_upload_queue.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Buffer pool statistics
+ */
+struct TileBufferPoolStats {
+    /// Buffer requests served from the pool
+    std::uint64_t buffer_hits = 0;
+
+    /// Buffer requests that allocated
+    std::uint64_t buffer_misses = 0;
+
+    /// Command requests served from the pool
+    std::uint64_t command_hits = 0;
+
+    /// Command requests that allocated
+    std::uint64_t command_misses = 0;
+
+    /// Buffers waiting for reuse
+    std::size_t pooled_buffers = 0;
+
+    /// Capacity of the buffers waiting for reuse (bytes)
+    std::size_t pooled_bytes = 0;
+
+    /// Commands waiting for reuse
+    std::size_t pooled_commands = 0;
+};
+
+/**
+ * @brief Size-classed free lists of pixel buffers and upload commands
+ *
+ * Buffers are grouped by capacity in power-of-two classes starting at
+ * kMinSizeClass. A request is rounded up to its class, so a released
+ * buffer serves any later request of the same class. Each class and the
+ * command list are capped; releases beyond the cap are freed.
+ *
+ * Thread Safety: All methods are thread-safe
+ */
+class TileBufferPool {
+public:
+    /// Smallest pooled buffer capacity (bytes)
+    static constexpr std::size_t kMinSizeClass = 4096;
+
+    /// Number of size classes (4 KiB .. 128 MiB)
+    static constexpr std::size_t kSizeClassCount = 16;
+
+    /// Default buffers kept per size class
+    static constexpr std::size_t kDefaultMaxBuffersPerClass = 16;
+
+    /// Default commands kept (about twice the upload queue depth)
+    static constexpr std::size_t kDefaultMaxCommands = 512;
+
+    /**
+     * @brief Constructor
+     *
+     * @param max_buffers_per_class Released buffers kept per size class
+     * @param max_commands Released commands kept
+     */
+    explicit TileBufferPool(std::size_t max_buffers_per_class = kDefaultMaxBuffersPerClass,
+                            std::size_t max_commands = kDefaultMaxCommands);
+
+    // Non-copyable
+    TileBufferPool(const TileBufferPool&) = delete;
+    TileBufferPool& operator=(const TileBufferPool&) = delete;
+
+    /**
+     * @brief Get an empty buffer with capacity for at least @p size bytes
+     *
+     * The capacity is rounded up to the size class, so the buffer can be
+     * released back to the class it came from.
+     */
+    std::vector<std::uint8_t> AcquireBuffer(std::size_t size);
+
+    /**
+     * @brief Return a buffer for reuse
+     *
+     * Filed under the largest class its capacity covers. Buffers smaller
+     * than kMinSizeClass, or beyond the class cap, are freed.
+     */
+    void ReleaseBuffer(std::vector<std::uint8_t>&& buffer);
+
+    /**
+     * @brief Get a command for @p coords, reset to its default state
+     */
+    std::unique_ptr<GLUploadCommand> AcquireCommand(const TileCoordinates& coords);
+
+    /**
+     * @brief Return a command for reuse
+     *
+     * Its callback, mesh and trace are dropped right away so that the
+     * pooled command keeps nothing alive.
+     */
+    void ReleaseCommand(std::unique_ptr<GLUploadCommand> command);
+
+    /**
+     * @brief Free everything the pool holds
+     */
+    void Clear();
+
+    /**
+     * @brief Get pool statistics
+     */
+    TileBufferPoolStats GetStats() const;
+
+    /**
+     * @brief Get the size class index for a capacity (kSizeClassCount = too large)
+     */
+    static std::size_t SizeClassFor(std::size_t size);
+
+    /**
+     * @brief Get the capacity of a size class
+     */
+    static std::size_t SizeClassCapacity(std::size_t size_class) {
+        return kMinSizeClass << size_class;
+    }
+
+private:
+    const std::size_t max_buffers_per_class_;
+    const std::size_t max_commands_;
+
+    mutable std::mutex mutex_;
+    std::array<std::vector<std::vector<std::uint8_t>>, kSizeClassCount> buffers_;
+    std::vector<std::unique_ptr<GLUploadCommand>> commands_;
+    std::size_t pooled_bytes_ = 0;
+
+    /// Statistics
+    std::uint64_t buffer_hits_ = 0;
+    std::uint64_t buffer_misses_ = 0;
+    std::uint64_t command_hits_ = 0;
+    std::uint64_t command_misses_ = 0;
+};
+
+} // namespace earth_map
@@ -0,0 +1,232 @@
+#pragma once
+
+/**
+ * @file tile_load_trace.h
+ * @brief Per-tile lifecycle tracing of the texture streaming pipeline
+ *
+ * A TileLoadTrace rides along with a tile from its request to the first
+ * frame that draws it: TileLoadRequest (queue and fetch), the decode pool,
+ * GLUploadCommand and TileTextureCoordinator::ProcessUploads(). Each stage
+ * stamps a monotonic time. Finished traces are folded into one latency
+ * histogram per stage by TileLoadTracer, and the most recent ones can be
+ * written as Chrome trace event JSON (chrome://tracing, ui.perfetto.dev).
+ *
+ * Tracing is off by default; requests then carry no trace and no stage
+ * is stamped.
+ */
+
+#include <earth_map/data/latency_histogram.h>
+#include <earth_map/math/tile_mathematics.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+namespace earth_map {
+
+/**
+ * @brief Pipeline stages a tile passes, in order
+ */
+enum class TileLoadStage : std::uint8_t {
+    REQUESTED,       ///< Submitted to the worker pool
+    FETCH_STARTED,   ///< Picked by the fetch dispatcher
+    FETCHED,         ///< Bytes read from the cache or downloaded
+    DECODED,         ///< Pixels decoded into a staging slot
+    STAGED,          ///< Mip chain built and transcoded, handed to the upload queue
+    UPLOADED,        ///< Texture in the tile pool (tile Loaded)
+    FIRST_RENDERED   ///< First frame that drew the tile
+};
+
+/// Number of TileLoadStage values
+inline constexpr std::size_t kTileLoadStageCount = 7;
+
+/**
+ * @brief How a trace ended
+ */
+enum class TileLoadOutcome : std::uint8_t {
+    RENDERED,   ///< Drawn at least once
+    FAILED,     ///< Fetch, decode or upload failed
+    CANCELLED,  ///< Dropped from the request queue before a worker took it
+    EVICTED     ///< Evicted from the tile pool before it was drawn
+};
+
+/// Number of TileLoadOutcome values
+inline constexpr std::size_t kTileLoadOutcomeCount = 4;
+
+/**
+ * @brief Get a stage's name ("requested", "fetched", ...)
+ */
+const char* GetTileLoadStageName(TileLoadStage stage);
+
+/**
+ * @brief Get the name of the phase that ends at a stage
+ *
+ * @param stage Any stage after REQUESTED ("queue" ends at FETCH_STARTED,
+ *        "fetch" at FETCHED, ... "render" at FIRST_RENDERED)
+ */
+const char* GetTileLoadPhaseName(TileLoadStage stage);
+
+/**
+ * @brief Monotonic stage timestamps of one tile load
+ *
+ * Only the thread currently owning the tile's request or upload command
+ * stamps it; ownership hand-offs (queue mutex, decode pool, upload queue)
+ * order the writes.
+ */
+struct TileLoadTrace {
+    using Clock = std::chrono::steady_clock;
+
+    TileCoordinates coords;
+
+    /// Time each stage was reached (default-constructed = not reached)
+    std::array<Clock::time_point, kTileLoadStageCount> stamps{};
+
+    /// Bytes were downloaded rather than read from the cache
+    bool from_network = false;
+
+    explicit TileLoadTrace(const TileCoordinates& tile) : coords(tile) {}
+
+    /**
+     * @brief Stamp a stage with the current time
+     */
+    void Mark(TileLoadStage stage) {
+        stamps[static_cast<std::size_t>(stage)] = Clock::now();
+    }
+
+    /**
+     * @brief Check whether a stage was stamped
+     */
+    bool HasReached(TileLoadStage stage) const {
+        return stamps[static_cast<std::size_t>(stage)] != Clock::time_point{};
+    }
+};
+
+/**
+ * @brief Tile load tracing configuration
+ */
+struct TileLoadTraceConfig {
+    /// Attach a trace to every new tile request
+    bool enabled = false;
+
+    /// Most recent finished traces kept for export (0 = histograms only)
+    std::size_t max_recorded_traces = 4096;
+};
+
+/**
+ * @brief Aggregated tile load traces
+ */
+struct TileLoadTraceStats {
+    /**
+     * Time spent in each phase, in ms: element i covers stage i to stage
+     * i + 1 (queue, fetch, decode, stage, upload, render)
+     */
+    std::array<LatencyHistogram, kTileLoadStageCount - 1> phase_latency;
+
+    /** Request to first frame drawn, for rendered tiles */
+    LatencyHistogram time_to_render;
+
+    /** Finished traces per TileLoadOutcome */
+    std::array<std::uint64_t, kTileLoadOutcomeCount> outcomes{};
+
+    /**
+     * @brief Get the histogram of the phase that ends at a stage
+     */
+    const LatencyHistogram& GetPhase(TileLoadStage end) const {
+        return phase_latency[static_cast<std::size_t>(end) - 1];
+    }
+
+    /**
+     * @brief Get number of traces that ended with an outcome
+     */
+    std::uint64_t GetOutcomeCount(TileLoadOutcome outcome) const {
+        return outcomes[static_cast<std::size_t>(outcome)];
+    }
+};
+
+/**
+ * @brief Creates tile load traces and aggregates the finished ones
+ *
+ * Thread Safety: all methods are thread-safe.
+ */
+class TileLoadTracer {
+public:
+    explicit TileLoadTracer(const TileLoadTraceConfig& config = TileLoadTraceConfig{});
+
+    /**
+     * @brief Change the configuration
+     *
+     * Traces already in flight still finish when tracing is turned off.
+     */
+    void SetConfig(const TileLoadTraceConfig& config);
+
+    /**
+     * @brief Get the configuration
+     */
+    TileLoadTraceConfig GetConfig() const;
+
+    /**
+     * @brief Check whether new requests are traced
+     */
+    bool IsEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Start a trace stamped REQUESTED
+     *
+     * @return New trace, or null if tracing is disabled
+     */
+    std::shared_ptr<TileLoadTrace> Begin(const TileCoordinates& coords) const;
+
+    /**
+     * @brief Fold a finished trace into the statistics
+     *
+     * Phases whose start or end stage was not reached are skipped.
+     */
+    void Finish(const TileLoadTrace& trace, TileLoadOutcome outcome);
+
+    /**
+     * @brief Get a snapshot of the aggregated traces
+     */
+    TileLoadTraceStats GetStats() const;
+
+    /**
+     * @brief Forget all statistics and recorded traces
+     */
+    void Reset();
+
+    /**
+     * @brief Write the recorded traces as Chrome trace event JSON
+     *
+     * Each tile is one async track ("tile z/x/y") with a slice per phase,
+     * timestamps in microseconds since the tracer was created.
+     */
+    void WriteChromeTrace(std::ostream& out) const;
+
+    /**
+     * @brief Write the recorded traces as Chrome trace event JSON to a file
+     *
+     * @return true if the file was written
+     */
+    bool WriteChromeTrace(const std::string& path) const;
+
+private:
+    struct RecordedTrace {
+        TileLoadTrace trace;
+        TileLoadOutcome outcome;
+    };
+
+    std::atomic<bool> enabled_;
+    const TileLoadTrace::Clock::time_point origin_;
+
+    mutable std::mutex mutex_;
+    TileLoadTraceConfig config_;
+    TileLoadTraceStats stats_;
+    std::deque<RecordedTrace> recorded_;
+};
+
+} // namespace earth_map
@@ -4,91 +4,77 @@
  * @file tile_load_worker_pool.h
  * @brief Worker pool for loading and decoding tile textures
  *
- * Manages multiple worker threads that:
- * 1. Pull tile load requests from a priority queue
- * 2. Check cache for tile data
- * 3. Download tile from network if cache miss
- * 4. Decode image data (stb_image)
- * 5. Create GL upload command
- * 6. Push to GL upload queue
+ * Runs the tile pipeline in two stages:
+ * 1. Fetch: a dispatcher thread pulls requests from a priority queue, checks
+ *    the cache and starts async downloads through TileLoader::LoadTileAsync
+ * 2. Decode: fetched tiles go to a work-stealing DecodeThreadPool that
+ *    decodes the image (ImageDecoderRegistry) straight into a PixelBufferRing
+ *    slot, optionally block-compresses it there (TileBlockCompressor),
+ *    creates the GL upload command and pushes it to the GL upload queue
  *
  * Design:
- * - Multi-threaded (configurable worker count, default 4)
+ * - No thread blocks on network I/O; downloads in flight are capped
+ *   separately from decode threads
+ * - Decode threads scale with hardware concurrency by default
  * - Priority-based request queue (lower number = higher priority)
- * - Automatic deduplication of requests
+ * - Queued requests can be re-prioritized or cancelled
+ * - Generation stamps let callers drop requests that went stale
+ * - Optional lifecycle traces (TileLoadTracer) ride along with requests
+ * - Automatic deduplication of requests; downloads are shared with other
+ *   requesters of the same tile through TileLoader's request coalescing
+ * - Vector tile mode: tiles are decoded as Mapbox Vector Tiles and
+ *   tessellated on the decode pool into meshes instead of staged pixels
  * - Graceful shutdown
  * - No OpenGL calls (CPU work only)
  */
 
+#include <earth_map/core/flat_hash_map.h>
 #include <earth_map/math/tile_mathematics.h>
 #include <earth_map/data/tile_cache.h>
 #include <earth_map/data/tile_loader.h>
 #include <earth_map/renderer/texture_atlas/gl_upload_queue.h>
+#include <earth_map/renderer/texture_atlas/decode_thread_pool.h>
+#include <earth_map/renderer/texture_atlas/image_decoder.h>
+#include <earth_map/renderer/texture_atlas/overzoom_tile_synthesizer.h>
+#include <earth_map/renderer/texture_atlas/pixel_buffer_ring.h>
+#include <earth_map/renderer/texture_atlas/tile_buffer_pool.h>
+#include <earth_map/renderer/texture_atlas/tile_load_trace.h>
+#include <earth_map/renderer/texture_atlas/tile_mip_chain.h>
+#include <earth_map/renderer/texture_atlas/tile_pyramid_builder.h>
+#include <earth_map/renderer/texture_atlas/tile_request_queue.h>
+#include <earth_map/renderer/vector_tile/vector_tile_mesh.h>
+#include <array>
 #include <memory>
 #include <vector>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
-#include <queue>
-#include <unordered_set>
+#include <cstdint>
 #include <atomic>
 #include <functional>
+#include <optional>
 
 namespace earth_map {
 
-/**
- * @brief Tile load request structure
- */
-struct TileLoadRequest {
-    /// Tile coordinates to load
-    TileCoordinates coords;
-
-    /// Priority (lower number = higher priority)
-    int priority;
-
-    /// Completion callback (optional, called after upload command created)
-    std::function<void(const TileCoordinates&)> on_complete;
-
-    /**
-     * @brief Default constructor
-     */
-    TileLoadRequest() : priority(0) {}
-
-    /**
-     * @brief Constructor with parameters
-     */
-    TileLoadRequest(
-        const TileCoordinates& tile_coords,
-        int prio,
-        std::function<void(const TileCoordinates&)> callback = nullptr)
-        : coords(tile_coords), priority(prio), on_complete(std::move(callback)) {}
-
-    /**
-     * @brief Comparison for priority queue (higher priority = lower number)
-     */
-    bool operator<(const TileLoadRequest& other) const {
-        // Higher priority (lower number) should come first
-        // std::priority_queue is a max-heap, so we invert the comparison
-        return priority > other.priority;
-    }
-};
-
 /**
  * @brief Worker pool for tile loading and decoding
  *
- * Manages worker threads that process tile load requests:
- * - Fetch tiles from cache or network
- * - Decode image data
+ * Processes tile load requests:
+ * - Fetch tiles from cache or network (async, no blocked threads)
+ * - Decode image data on the decode pool
  * - Create GL upload commands
  * - Push to GL upload queue
  *
  * Thread Safety:
  * - All public methods are thread-safe
  * - Can submit requests from multiple threads
- * - Worker threads coordinate via mutex and condition variable
+ * - Fetch completion callbacks run on the loader's I/O thread and only hand
+ *   work to the decode pool
  *
  * Design Rationale:
  * - Separates CPU work (download/decode) from GPU work (upload)
+ * - Separates I/O waits from decoding so downloaded tiles never wait
+ *   behind slow downloads for a free thread
  * - Priority queue ensures important tiles load first
  * - Deduplication prevents redundant work
  * - Graceful shutdown ensures no data loss
@@ -101,13 +87,19 @@ public:
      * @param cache Shared pointer to tile cache
      * @param loader Shared pointer to tile loader
      * @param upload_queue Shared pointer to GL upload queue
-     * @param num_threads Number of worker threads (default: 4)
+     * @param num_decode_threads Number of decode threads (0 = hardware concurrency)
+     * @param max_in_flight_fetches Maximum concurrent fetches
+     *                              (0 = loader's max_concurrent_downloads)
+     * @param pixel_ring Staging slots decoded pixels are written to
+     *                   (null = CPU-backed ring for 256px RGBA tiles)
      */
     TileLoadWorkerPool(
         std::shared_ptr<TileCache> cache,
         std::shared_ptr<TileLoader> loader,
         std::shared_ptr<GLUploadQueue> upload_queue,
-        int num_threads = 4);
+        int num_decode_threads = 0,
+        std::size_t max_in_flight_fetches = 0,
+        std::shared_ptr<PixelBufferRing> pixel_ring = nullptr);
 
     /**
      * @brief Destructor
@@ -127,8 +119,10 @@ public:
     /**
      * @brief Submit a tile load request
      *
-     * Adds request to priority queue. If tile is already queued or processing,
-     * request is ignored (deduplication).
+     * Adds request to priority queue, stamped with the current generation.
+     * If the tile is already queued, its priority and generation are refreshed
+     * instead (deduplication). If it is already being processed, the request
+     * is ignored.
      *
      * @param coords Tile coordinates
      * @param priority Priority (lower number = higher priority, default: 0)
@@ -141,11 +135,70 @@ public:
         int priority = 0,
         std::function<void(const TileCoordinates&)> on_complete = nullptr);
 
+    /**
+     * @brief Change the priority of a queued request
+     *
+     * Also stamps the request with the current generation so that it
+     * survives the next CancelStaleRequests().
+     *
+     * @param coords Tile coordinates
+     * @param priority New priority (lower number = higher priority)
+     * @return true if the tile was still queued
+     *
+     * Thread Safety: Safe to call from multiple threads
+     */
+    bool UpdatePriority(const TileCoordinates& coords, int priority);
+
+    /**
+     * @brief Remove a queued request before a worker picks it up
+     *
+     * Requests already being processed are not interrupted. The completion
+     * callback of a cancelled request is not invoked and its trace finishes
+     * as CANCELLED.
+     *
+     * @param coords Tile coordinates
+     * @return true if the tile was still queued
+     *
+     * Thread Safety: Safe to call from multiple threads
+     */
+    bool CancelRequest(const TileCoordinates& coords);
+
+    /**
+     * @brief Start a new request generation
+     *
+     * Requests submitted afterwards are stamped with the new generation.
+     * Call once per visible-tile update, then CancelStaleRequests() once the
+     * still-wanted tiles have been resubmitted.
+     *
+     * @return New generation number
+     */
+    std::uint64_t AdvanceGeneration();
+
+    /**
+     * @brief Get current request generation
+     */
+    std::uint64_t GetGeneration() const;
+
+    /**
+     * @brief Drop queued requests not renewed in the current generation
+     *
+     * Completion callbacks of dropped requests are not invoked; their
+     * traces finish as CANCELLED.
+     *
+     * @return Coordinates of the dropped requests
+     *
+     * Thread Safety: Safe to call from multiple threads
+     */
+    std::vector<TileCoordinates> CancelStaleRequests();
+
     /**
      * @brief Shutdown worker pool
      *
-     * Signals workers to stop processing and waits for them to finish.
-     * Current tasks will complete gracefully.
+     * Signals the dispatcher to stop once the queue is drained, cancels
+     * downloads still running in the loader (which also cancels them for
+     * other requesters of the same tile), waits for the callbacks of
+     * fetches in flight and then for the decode pool to finish.
+     * Current decodes will complete gracefully.
      *
      * Thread Safety: Safe to call from any thread
      */
@@ -158,6 +211,181 @@ public:
      */
     std::size_t GetPendingCount() const;
 
+    /**
+     * @brief Get number of fetches currently in flight
+     */
+    std::size_t GetInFlightFetchCount() const;
+
+    /**
+     * @brief Get number of decode threads
+     */
+    std::size_t GetDecodeThreadCount() const {
+        return decode_pool_->GetThreadCount();
+    }
+
+    /**
+     * @brief Get decode time and counts per image format
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    ImageDecodeStats GetDecodeStats() const;
+
+    /**
+     * @brief Get the tile cache workers read from (may be null)
+     */
+    std::shared_ptr<TileCache> GetCache() const { return cache_; }
+
+    /**
+     * @brief Get the pool recycling decode buffers and upload commands
+     *
+     * The GL thread hands uploaded commands back through it.
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    std::shared_ptr<TileBufferPool> GetBufferPool() const { return buffer_pool_; }
+
+    /**
+     * @brief Get number of tiles built from an ancestor beyond the provider's max zoom
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    std::uint64_t GetOverzoomedTileCount() const {
+        return overzoomed_tiles_.load();
+    }
+
+    /**
+     * @brief Configure building parents from cached children
+     *
+     * Applies to requests fetched afterwards.
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    void SetPyramidConfig(const TilePyramidConfig& config);
+
+    /**
+     * @brief Get the pyramid builder configuration
+     */
+    TilePyramidConfig GetPyramidConfig() const;
+
+    /**
+     * @brief Set the format staged tiles are transcoded to
+     *
+     * Must match the tile pool's format (TileTexturePool::GetFormat()).
+     * Applies to tiles staged afterwards.
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    void SetUploadFormat(TileTextureFormat format) {
+        upload_format_.store(format);
+    }
+
+    /**
+     * @brief Get the format staged tiles are transcoded to
+     */
+    TileTextureFormat GetUploadFormat() const {
+        return upload_format_.load();
+    }
+
+    /**
+     * @brief Set the mip levels built for each staged tile
+     *
+     * Must match the tile pool (TileTexturePool::GetMipLevels()), and the
+     * pixel ring slots must hold the uncompressed chain. Applies to tiles
+     * staged afterwards.
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    void SetUploadMipLevels(std::uint32_t levels) {
+        upload_mip_levels_.store(levels);
+    }
+
+    /**
+     * @brief Get the mip levels built for each staged tile
+     */
+    std::uint32_t GetUploadMipLevels() const {
+        return upload_mip_levels_.load();
+    }
+
+    /**
+     * @brief Set the pixel size of the tile pool's layers
+     *
+     * Square images a power-of-two multiple of this size (@2x and @4x
+     * variants) are box-filtered down to it on the decode threads, so they
+     * fit the ring slots and the pool. 0 (the default) stages images at
+     * their decoded size.
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    void SetUploadTileSize(std::uint32_t size) {
+        upload_tile_size_.store(size);
+    }
+
+    /**
+     * @brief Get the pixel size staged tiles are reduced to (0 = as decoded)
+     */
+    std::uint32_t GetUploadTileSize() const {
+        return upload_tile_size_.load();
+    }
+
+    /**
+     * @brief Attach lifecycle traces to new requests
+     *
+     * Requests submitted afterwards get a trace from @p tracer while it is
+     * enabled; the pool stamps queue, fetch, decode and staging and hands
+     * the trace to the upload command. Cancelled requests are finished here.
+     *
+     * @param tracer Tracer (null = no tracing)
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    void SetTracer(std::shared_ptr<TileLoadTracer> tracer);
+
+    /**
+     * @brief Load tiles from a named provider of the loader
+     *
+     * Applies to fetches started afterwards. Decoded ancestors kept for
+     * overzoomed tiles are dropped: they came from the previous provider.
+     *
+     * @param name Provider name (empty = the loader's default)
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    void SetProviderName(const std::string& name);
+
+    /**
+     * @brief Get the provider tiles are loaded from (empty = default)
+     */
+    std::string GetProviderName() const;
+
+    /**
+     * @brief Load vector tiles instead of images
+     *
+     * With styles set, fetched tiles are decoded as Mapbox Vector Tiles and
+     * tessellated (TessellateVectorTile) on the decode pool; upload
+     * commands carry the mesh and no pixel slot. Tiles beyond the
+     * provider's max zoom and parents built from children are not
+     * synthesized in this mode. Applies to tiles decoded afterwards.
+     *
+     * @param styles Styles of the tessellation (null = image tiles)
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    void SetVectorTileStyles(std::shared_ptr<const std::vector<VectorTileStyle>> styles);
+
+    /**
+     * @brief Get the vector tile styles (null in image mode)
+     */
+    std::shared_ptr<const std::vector<VectorTileStyle>> GetVectorTileStyles() const;
+
+    /**
+     * @brief Get number of tiles built from their cached children
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    std::uint64_t GetPyramidBuiltTileCount() const {
+        return pyramid_built_tiles_.load();
+    }
+
     /**
      * @brief Check if shutdown has been requested
      *
@@ -169,28 +397,233 @@ public:
 
 private:
     /**
-     * @brief Worker thread main loop
+     * @brief Fetch dispatcher main loop
+     *
+     * Pops requests while fewer than max_in_flight_fetches_ fetches are
+     * running, until shutdown and the queue is empty.
+     */
+    void FetchThreadMain();
+
+    /**
+     * @brief Start fetching a tile (cache lookup, then async download)
+     *
+     * @param request Tile load request to fetch
+     */
+    void StartFetch(const TileLoadRequest& request);
+
+    /**
+     * @brief Start the async download of a tile
+     *
+     * @param request Tile load request (holds a fetch slot)
+     * @param has_preview true if a parent built from children is already
+     *                    queued for upload; a failed download then keeps it
+     */
+    void StartDownload(const TileLoadRequest& request, bool has_preview);
+
+    /**
+     * @brief Handle a finished download (called on the loader's I/O thread)
+     */
+    void OnFetchComplete(const TileLoadRequest& request, const TileLoadResult& result,
+                         bool has_preview);
+
+    /**
+     * @brief Build a cache-missed tile from its four cached children
+     *
+     * @return true if the build was handed to the decode pool (it then owns
+     *         the request and its fetch slot), false to download as usual
+     */
+    bool TryStartPyramidBuild(const TileLoadRequest& request);
+
+    /**
+     * @brief Downsample children into their parent and queue it (decode pool)
+     *
+     * @param request Request for the parent tile (holds a fetch slot)
+     * @param child_data Children in TileCoordinates::GetChildren() order
+     * @param then_fetch Download the real tile after showing the built one
+     */
+    void BuildParentAndQueue(const TileLoadRequest& request,
+                             const std::array<std::shared_ptr<TileData>, 4>& child_data,
+                             bool then_fetch);
+
+    /**
+     * @brief Get the ancestor an overzoomed tile is built from
+     *
+     * @return Ancestor at the default provider's max zoom, or std::nullopt
+     *         if the tile is within the provider's zoom range
+     */
+    std::optional<TileCoordinates> GetOverzoomSource(const TileCoordinates& coords) const;
+
+    /**
+     * @brief Fetch the ancestor of an overzoomed tile (decoded LRU, cache, then network)
+     *
+     * @param request Request for the overzoomed tile
+     * @param source Ancestor to fetch
+     */
+    void StartOverzoomFetch(const TileLoadRequest& request, const TileCoordinates& source);
+
+    /**
+     * @brief Handle a finished ancestor download (called on the loader's I/O thread)
+     *
+     * An ancestor the provider does not have (404, no data) is replaced by
+     * its parent, looked up on a decode worker, so the deepest ancestor the
+     * provider actually has is used. Other failures fail the request.
+     */
+    void OnOverzoomFetchComplete(const TileLoadRequest& request,
+                                 const TileCoordinates& source,
+                                 const TileLoadResult& result);
+
+    /**
+     * @brief Hand an ancestor to the decode pool and release its fetch slot
+     *
+     * @param source_image Already decoded ancestor (null = decode source_data)
+     */
+    void ScheduleOverzoom(const TileLoadRequest& request,
+                          const TileCoordinates& source,
+                          std::shared_ptr<TileData> source_data,
+                          std::shared_ptr<const DecodedImage> source_image,
+                          bool from_network);
+
+    /**
+     * @brief Build an overzoomed tile from its ancestor and queue it for GL upload
+     *
+     * @param request Request for the overzoomed tile
+     * @param source Ancestor coordinates
+     * @param source_data Ancestor tile bytes (used if source_image is null)
+     * @param source_image Already decoded ancestor, or null
+     * @param from_network true if source_data was downloaded and should be cached
+     */
+    void SynthesizeAndQueue(const TileLoadRequest& request,
+                            const TileCoordinates& source,
+                            std::shared_ptr<TileData> source_data,
+                            std::shared_ptr<const DecodedImage> source_image,
+                            bool from_network);
+
+    /**
+     * @brief Fill a staging slot and push the upload command (decode pool)
      *
-     * Continuously processes requests from the queue until shutdown.
+     * Acquires a slot, lets @p fill write pixels and size into it, pushes the
+     * upload command and completes the request. Failures push an empty
+     * command so the tile returns to NotLoaded.
+     *
+     * @param request Tile load request
+     * @param fill Writes pixels into the slot and sets width, height, channels
+     */
+    void StageAndQueue(const TileLoadRequest& request,
+                       const std::function<bool(PixelSlotHandle, GLUploadCommand&)>& fill);
+
+    /**
+     * @brief Fill a staging slot and push its upload command
+     *
+     * Builds the mip chain and transcodes the filled slot in place to the
+     * upload format. Unlike
+     * StageAndQueue() it neither completes the request nor reports failures
+     * to the GL thread.
+     *
+     * @param request Tile load request; its trace is stamped and handed to
+     *        the upload command
+     * @return true if the tile was queued for upload
+     */
+    bool StageUpload(const TileLoadRequest& request,
+                     const std::function<bool(PixelSlotHandle, GLUploadCommand&)>& fill);
+
+    /**
+     * @brief Decode tile data into an owned image (already decoded data is copied)
+     *
+     * @return true if decode succeeded
+     */
+    bool DecodeToImage(const TileData& tile_data, DecodedImage& image);
+
+    /**
+     * @brief Decode a fetched tile and queue it for GL upload (decode pool)
+     *
+     * @param request Tile load request
+     * @param tile_data Raw tile data
+     * @param from_network true if the data was downloaded and should be cached
+     */
+    void DecodeAndQueue(const TileLoadRequest& request,
+                        std::shared_ptr<TileData> tile_data,
+                        bool from_network);
+
+    /**
+     * @brief Decode a vector tile, tessellate it and push its mesh (decode thread)
+     */
+    void TessellateAndQueue(const TileLoadRequest& request, const TileData& tile_data,
+                            const std::vector<VectorTileStyle>& styles);
+
+    /**
+     * @brief Hand a fetched tile to the decode pool and release its fetch slot
+     */
+    void ScheduleDecode(const TileLoadRequest& request,
+                        std::shared_ptr<TileData> tile_data,
+                        bool from_network);
+
+    /**
+     * @brief Report a failed tile and release its fetch slot
+     */
+    void FailFetch(const TileLoadRequest& request);
+
+    /**
+     * @brief Push an empty upload command so the GL thread resets a failed tile
+     */
+    void PushFailedUpload(const TileLoadRequest& request);
+
+    /**
+     * @brief Finish a request's trace here instead of on the GL thread
+     */
+    void FinishTrace(const TileLoadRequest& request, TileLoadOutcome outcome);
+
+    /**
+     * @brief Complete a request already queued for upload and release its fetch slot
      */
-    void WorkerThreadMain();
+    void FinishFetch(const TileLoadRequest& request);
 
     /**
-     * @brief Process a single tile load request
+     * @brief Release one fetch slot and wake the dispatcher
+     */
+    void ReleaseFetchSlot();
+
+    /**
+     * @brief Register a download about to start so Shutdown() can cancel it
      *
-     * @param request Tile load request to process
+     * @return false if Shutdown() is cancelling downloads; do not start it
+     */
+    bool BeginDownload(const TileCoordinates& coords);
+
+    /**
+     * @brief Unregister a download once its callback runs (or it failed to start)
+     */
+    void EndDownload(const TileCoordinates& coords);
+
+    /**
+     * @brief Remove a tile from the in-flight set once its pipeline ends
      */
-    void ProcessRequest(const TileLoadRequest& request);
+    void FinishRequest(const TileCoordinates& coords);
 
     /**
-     * @brief Decode image data using stb_image
+     * @brief Decode image data into a staging slot
+     *
+     * Uses the preferred backend for the image format. Already decoded tile
+     * data is copied into the slot as is. Images larger than the upload tile
+     * size are decoded aside and reduced into the slot (ShrinkToTile()).
      *
      * @param tile_data Tile data containing raw image bytes
+     * @param slot Acquired ring slot receiving RGBA8 pixels
+     * @param cmd Receives width, height and channels
      * @return true if decode succeeded, false otherwise
+     */
+    bool DecodeImage(const TileData& tile_data, PixelSlotHandle slot, GLUploadCommand& cmd);
+
+    /**
+     * @brief Halve a square image until it is tile_size wide, into @p dst
      *
-     * Note: Modifies tile_data in place (sets width, height, channels, data)
+     * @param src Source pixels, size x size
+     * @param dst Slot receiving tile_size x tile_size pixels
+     * @param capacity Bytes available at dst
+     * @return false unless size is a power-of-two multiple of tile_size
      */
-    bool DecodeImage(TileData& tile_data);
+    bool ShrinkToTile(const std::uint8_t* src, std::uint32_t size, std::uint8_t channels,
+                      std::uint32_t tile_size, std::uint8_t* dst, std::size_t capacity,
+                      GLUploadCommand& cmd);
 
     /// Tile cache (check before downloading)
     std::shared_ptr<TileCache> cache_;
@@ -201,8 +634,44 @@ private:
     /// GL upload queue (push decoded tiles for GPU upload)
     std::shared_ptr<GLUploadQueue> upload_queue_;
 
-    /// Worker threads
-    std::vector<std::thread> workers_;
+    /// Staging slots for decoded pixels (shared with the GL thread)
+    std::shared_ptr<PixelBufferRing> pixel_ring_;
+
+    /// Recycled decode buffers and upload commands (shared with the GL thread)
+    std::shared_ptr<TileBufferPool> buffer_pool_;
+
+    /// Image decoder backends (shared by all decode threads)
+    std::unique_ptr<ImageDecoderRegistry> decoders_;
+
+    /// Builds tiles beyond the provider's max zoom; keeps decoded ancestors
+    std::unique_ptr<OverzoomTileSynthesizer> overzoom_;
+
+    /// Tiles built from an ancestor
+    std::atomic<std::uint64_t> overzoomed_tiles_{0};
+
+    /// Tiles built from their cached children
+    std::atomic<std::uint64_t> pyramid_built_tiles_{0};
+
+    /// Format staged tiles are transcoded to (the tile pool's format)
+    std::atomic<TileTextureFormat> upload_format_{TileTextureFormat::RGBA8};
+
+    /// Mip levels built for staged tiles (the tile pool's levels)
+    std::atomic<std::uint32_t> upload_mip_levels_{1};
+
+    /// Pixel size larger images are reduced to (the tile pool's; 0 = as decoded)
+    std::atomic<std::uint32_t> upload_tile_size_{0};
+
+    /// Fetch dispatcher thread
+    std::thread fetch_thread_;
+
+    /// Work-stealing pool running decode and upload-command creation
+    std::unique_ptr<DecodeThreadPool> decode_pool_;
+
+    /// Maximum concurrent fetches
+    std::size_t max_in_flight_fetches_;
+
+    /// Fetches started but not yet handed to the decode pool (guarded by queue_mutex_)
+    std::size_t in_flight_fetches_ = 0;
 
     /// Shutdown flag (atomic)
     std::atomic<bool> shutdown_flag_;
@@ -210,14 +679,35 @@ private:
     /// Mutex protecting request queue and in-flight set
     mutable std::mutex queue_mutex_;
 
-    /// Condition variable for worker notification
+    /// Condition variable for dispatcher notification (new request or free fetch slot)
     std::condition_variable queue_cv_;
 
-    /// Priority queue of tile load requests
-    std::priority_queue<TileLoadRequest> request_queue_;
+    /// Indexed priority queue of tile load requests
+    TileRequestQueue request_queue_;
+
+    /// Set of tiles currently being fetched or decoded (deduplication)
+    TileSet in_flight_;
+
+    /// Downloads running in the loader, per tile (guarded by queue_mutex_)
+    TileMap<std::size_t> downloads_;
+
+    /// Set by Shutdown() once the queue is drained (guarded by queue_mutex_)
+    bool cancel_downloads_ = false;
+
+    /// Current request generation (guarded by queue_mutex_)
+    std::uint64_t generation_ = 0;
+
+    /// Building parents from cached children (guarded by queue_mutex_)
+    TilePyramidConfig pyramid_config_;
+
+    /// Lifecycle tracer of new requests (guarded by queue_mutex_)
+    std::shared_ptr<TileLoadTracer> tracer_;
+
+    /// Vector tile styles, null for image tiles (guarded by queue_mutex_)
+    std::shared_ptr<const std::vector<VectorTileStyle>> vector_styles_;
 
-    /// Set of tiles currently being processed (deduplication)
-    std::unordered_set<TileCoordinates, TileCoordinatesHash> in_flight_;
+    /// Provider tiles are loaded from, empty = default (guarded by queue_mutex_)
+    std::string provider_name_;
 };
 
 } // namespace earth_map
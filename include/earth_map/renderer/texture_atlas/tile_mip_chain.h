@@ -0,0 +1,71 @@
+#pragma once
+
+/**
+ * @file tile_mip_chain.h
+ * @brief Per-tile mip chain generation on the decode threads
+ *
+ * Tiles seen at grazing angles near the horizon are heavily minified. Without
+ * mipmaps every screen pixel samples texels far apart, which thrashes the
+ * texture cache and aliases. The tile pool stores a mip chain per layer, and
+ * the decode threads build it next to the decoded tile in its staging slot,
+ * so the GL thread only uploads.
+ *
+ * Staged chain layout: level 0, then level 1, ... packed back to back in the
+ * upload format. Level l is max(1, size >> l) texels square; BC1 chains stop
+ * at the 4x4 level (one block).
+ */
+
+#include <earth_map/renderer/texture_atlas/tile_block_compressor.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace earth_map {
+
+/**
+ * @brief Mip chain layout and 2x2 box-filter generation
+ *
+ * Thread Safety: Stateless, safe from any thread.
+ */
+class TileMipChain {
+public:
+    /**
+     * @brief Number of levels in a full chain for a square power-of-two tile
+     *
+     * @return 1 for sizes that are not a power of two (or too small for BC1)
+     */
+    static std::uint32_t GetMaxLevels(TileTextureFormat format, std::uint32_t size);
+
+    /**
+     * @brief Byte offset of a level in a staged chain (RGBA8 = 4 channels)
+     *
+     * GetLevelOffset(format, size, levels) is the size of the whole chain.
+     */
+    static std::size_t GetLevelOffset(TileTextureFormat format, std::uint32_t size,
+                                      std::uint32_t level);
+
+    /**
+     * @brief Build a chain in place
+     *
+     * @p data holds level 0 as uncompressed pixels. Levels 1.. are appended
+     * as 2x2 box-filtered pixels; for BC1 every level is then compressed
+     * into the packed chain at the front of @p data. The uncompressed chain
+     * must fit @p capacity (GetLevelOffset(RGBA8, ...) for 4 channels).
+     *
+     * @param channels 4, or 3 for BC1
+     * @param levels Levels to build (1 = compress only)
+     * @return true if the chain was built
+     */
+    static bool Build(std::uint8_t* data, std::uint32_t size, std::uint8_t channels,
+                      std::uint32_t levels, TileTextureFormat format, std::size_t capacity);
+
+    /**
+     * @brief Average 2x2 blocks of a square image into one of half the size
+     *
+     * @param src Source pixels, size x size
+     * @param dst Output pixels, (size / 2) x (size / 2); must not overlap src
+     */
+    static void Downsample(const std::uint8_t* src, std::uint32_t size, std::uint8_t channels,
+                           std::uint8_t* dst);
+};
+
+} // namespace earth_map
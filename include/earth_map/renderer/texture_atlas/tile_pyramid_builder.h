@@ -0,0 +1,60 @@
+#pragma once
+
+/**
+ * @file tile_pyramid_builder.h
+ * @brief Builds parent tiles from their four cached children
+ *
+ * After a deep zoom session the tile cache holds many children whose parents
+ * were never loaded. Zooming out would download every parent again, although
+ * each one is (up to the provider's styling of that zoom) the 2x2 box-filtered
+ * mosaic of its children. The worker pool uses this builder to show such a
+ * parent straight from the cache and, optionally, to skip its download.
+ */
+
+#include <earth_map/renderer/texture_atlas/image_decoder.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace earth_map {
+
+/**
+ * @brief Pyramid builder configuration
+ */
+struct TilePyramidConfig {
+    /// Build a parent from its children when all four are cached
+    bool enabled = true;
+
+    /**
+     * Use the built parent instead of downloading it. When false the built
+     * parent is shown while the real tile downloads and then replaced.
+     */
+    bool skip_network_fetch = false;
+};
+
+/**
+ * @brief Parent-from-children downsampling
+ *
+ * Thread Safety: Stateless, safe from any thread.
+ */
+class TilePyramidBuilder {
+public:
+    /// Children in TileCoordinates::GetChildren() order: (2x,2y), (2x+1,2y), (2x,2y+1), (2x+1,2y+1)
+    using Children = std::array<const DecodedImage*, 4>;
+
+    /**
+     * @brief Downsample four children into their parent
+     *
+     * Each child becomes one quadrant of the parent; every parent pixel is
+     * the average of a 2x2 block of child pixels. The parent has the
+     * children's size and channel count.
+     *
+     * @param children Decoded children (same even size and channel count)
+     * @param dst Output pixels
+     * @param capacity Bytes available at dst
+     * @return true if the children are consistent and the parent fits dst
+     */
+    static bool BuildParent(const Children& children, std::uint8_t* dst, std::size_t capacity);
+};
+
+} // namespace earth_map
@@ -0,0 +1,179 @@
+#pragma once
+
+/**
+ * @file tile_request_queue.h
+ * @brief Indexed priority queue of tile load requests
+ *
+ * Binary heap with a coordinate → heap-slot index so that queued requests
+ * can be re-prioritized or cancelled in O(log n) instead of waiting in a
+ * std::priority_queue until a worker pops them. Each request carries a
+ * generation stamp (one generation per visible-tile update) so requests
+ * that were not renewed by the latest update can be dropped in bulk.
+ */
+
+#include <earth_map/math/tile_mathematics.h>
+#include <earth_map/renderer/texture_atlas/tile_load_trace.h>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Tile load request structure
+ */
+struct TileLoadRequest {
+    /// Tile coordinates to load
+    TileCoordinates coords;
+
+    /// Priority (lower number = higher priority)
+    int priority;
+
+    /// Completion callback (optional, called after upload command created)
+    std::function<void(const TileCoordinates&)> on_complete;
+
+    /// Request generation (newer generations win ties in priority)
+    std::uint64_t generation = 0;
+
+    /// Lifecycle trace (null unless tile load tracing is enabled)
+    std::shared_ptr<TileLoadTrace> trace;
+
+    /**
+     * @brief Default constructor
+     */
+    TileLoadRequest() : priority(0) {}
+
+    /**
+     * @brief Constructor with parameters
+     */
+    TileLoadRequest(
+        const TileCoordinates& tile_coords,
+        int prio,
+        std::function<void(const TileCoordinates&)> callback = nullptr,
+        std::uint64_t request_generation = 0)
+        : coords(tile_coords)
+        , priority(prio)
+        , on_complete(std::move(callback))
+        , generation(request_generation) {}
+
+    /**
+     * @brief Comparison for priority queue (higher priority = lower number)
+     */
+    bool operator<(const TileLoadRequest& other) const {
+        // Higher priority (lower number) should come first
+        // std::priority_queue is a max-heap, so we invert the comparison
+        return priority > other.priority;
+    }
+};
+
+/**
+ * @brief Indexed min-heap of tile load requests keyed by TileCoordinates
+ *
+ * Ordering: lowest priority number first, then newest generation, then
+ * submission order (FIFO) for full ties.
+ *
+ * Thread Safety: Not thread-safe; the owner guards access with its own mutex.
+ */
+class TileRequestQueue {
+public:
+    /**
+     * @brief Insert a request or refresh an already queued one
+     *
+     * If the tile is already queued, its priority and generation are replaced
+     * by the new values and its callback and trace are kept unless new ones
+     * are given.
+     *
+     * @param request Request to insert
+     * @return true if a new entry was added, false if an existing one was refreshed
+     */
+    bool Push(TileLoadRequest request);
+
+    /**
+     * @brief Remove and return the highest-priority request
+     *
+     * @return Request, or std::nullopt if the queue is empty
+     */
+    std::optional<TileLoadRequest> Pop();
+
+    /**
+     * @brief Change the priority of a queued request
+     *
+     * @return true if the tile was queued
+     */
+    bool UpdatePriority(const TileCoordinates& coords, int priority);
+
+    /**
+     * @brief Remove a queued request
+     *
+     * @return true if the tile was queued
+     */
+    bool Cancel(const TileCoordinates& coords);
+
+    /**
+     * @brief Remove and return a queued request
+     *
+     * @return Request, or std::nullopt if the tile was not queued
+     */
+    std::optional<TileLoadRequest> Take(const TileCoordinates& coords);
+
+    /**
+     * @brief Remove every request stamped with a generation older than @p generation
+     *
+     * @param generation Oldest generation to keep
+     * @return Coordinates of the removed requests
+     */
+    std::vector<TileCoordinates> DropOlderThan(std::uint64_t generation);
+
+    /**
+     * @brief Remove every request older than @p generation, keeping them
+     *
+     * @param generation Oldest generation to keep
+     * @param dropped Receives the removed requests
+     */
+    void DropOlderThan(std::uint64_t generation, std::vector<TileLoadRequest>& dropped);
+
+    /**
+     * @brief Check whether a tile is queued
+     */
+    bool Contains(const TileCoordinates& coords) const {
+        return index_.find(coords) != index_.end();
+    }
+
+    /**
+     * @brief Get number of queued requests
+     */
+    std::size_t Size() const { return heap_.size(); }
+
+    /**
+     * @brief Check if the queue is empty
+     */
+    bool Empty() const { return heap_.empty(); }
+
+    /**
+     * @brief Remove all requests
+     */
+    void Clear();
+
+private:
+    struct Entry {
+        TileLoadRequest request;
+        std::uint64_t sequence = 0;
+    };
+
+    /// True if @p a should be popped before @p b
+    static bool Before(const Entry& a, const Entry& b);
+
+    void SiftUp(std::size_t slot);
+    void SiftDown(std::size_t slot);
+    void Swap(std::size_t a, std::size_t b);
+    TileLoadRequest RemoveAt(std::size_t slot);
+
+    std::vector<Entry> heap_;
+    std::unordered_map<TileCoordinates, std::size_t, TileCoordinatesHash> index_;
+    std::uint64_t next_sequence_ = 0;
+};
+
+} // namespace earth_map
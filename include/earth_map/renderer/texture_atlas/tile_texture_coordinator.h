@@ -5,12 +5,27 @@
  * @brief Main coordinator for tile texture loading and atlas management
  *
  * Coordinates all components of the texture atlas system:
- * - TileLoadWorkerPool: Worker threads for loading/decoding
+ * - TileLoadWorkerPool: Async fetch stage + work-stealing decode pool
+ * - PixelBufferRing: Persistently mapped PBO slots decoded pixels land in
+ * - TileUploadScheduler: Time-budgeted, priority-ordered uploads
  * - GLUploadQueue: Queue for GL upload commands
+ * - TileUploadThread: Optional thread issuing uploads from a shared context
+ * - TileLoadTracer: Optional per-tile lifecycle traces and stage histograms
  * - TextureAtlasManager: OpenGL atlas texture management
  *
  * Public API for requesting tiles, checking status, and processing uploads.
  *
+ * Overlay imagery layers (AddOverlayLayer()) have their own loader, states
+ * and indirection textures but upload into this coordinator's tile pool, so
+ * the tile shader composites every layer in one pass from one set of pool
+ * arrays and one VRAM budget covers them all.
+ *
+ * A time-series layer (AddTimeSeriesLayer()) animates timestamped frames of
+ * one provider (weather radar). A ring of frame slots, each an overlay-like
+ * layer in its own pool namespace, keeps the shown frame and the next ones
+ * loaded in a reserved share of the pool; advancing the animation rebinds
+ * the indirection texture of a slot that is already filled.
+ *
  * Design:
  * - Thread-safe RequestTiles (can be called from any thread)
  * - ProcessUploads must be called from GL thread
@@ -18,24 +33,61 @@
  * - Idempotent tile requests (safe to request same tile multiple times)
  */
 
+#include <earth_map/core/flat_hash_map.h>
 #include <earth_map/math/tile_mathematics.h>
 #include <earth_map/data/tile_cache.h>
 #include <earth_map/data/tile_loader.h>
+#include <earth_map/renderer/texture_atlas/basemap_pack.h>
 #include <earth_map/renderer/texture_atlas/tile_load_worker_pool.h>
 #include <earth_map/renderer/texture_atlas/gl_upload_queue.h>
+#include <earth_map/renderer/texture_atlas/tile_load_trace.h>
+#include <earth_map/renderer/texture_atlas/tile_upload_scheduler.h>
+#include <earth_map/renderer/texture_atlas/tile_upload_thread.h>
 #include <earth_map/renderer/tile_pool/tile_texture_pool.h>
+#include <earth_map/renderer/tile_pool/tile_eviction_policy.h>
 #include <earth_map/renderer/tile_pool/indirection_texture_manager.h>
 #include <glm/vec2.hpp>
 #include <glm/vec4.hpp>
 #include <atomic>
+#include <functional>
 #include <memory>
-#include <unordered_map>
+#include <mutex>
+#include <optional>
 #include <shared_mutex>
+#include <span>
+#include <string>
+#include <vector>
 #include <cstdint>
 #include <chrono>
 
 namespace earth_map {
 
+/**
+ * @brief Animated overlay of timestamped frames (see AddTimeSeriesLayer())
+ */
+struct TimeSeriesLayerConfig {
+    /// Frame timestamps in playback order, substituted for {t} in the provider's URLs
+    std::vector<std::string> frame_times;
+
+    /// Frames loaded ahead of the one shown (the ring has one slot more)
+    std::size_t prefetch_frames = 4;
+
+    /// Share of the pool budget reserved for the frames' tiles
+    double pool_fraction = 0.5;
+
+    /// How long each frame is shown (SetAnimationTime())
+    std::chrono::milliseconds frame_duration{500};
+};
+
+/**
+ * @brief Entries in a coordinator's per-tile bookkeeping (see GetStateMapSizes())
+ */
+struct TileStateMapSizes {
+    std::size_t tile_states = 0;      ///< Tiles loading or loaded
+    std::size_t awaiting_render = 0;  ///< Uploaded tiles whose trace waits for a draw
+    std::size_t pool_tiles = 0;       ///< Tiles resident in the texture pool
+};
+
 /**
  * @brief Tile texture coordinator - main public API
  *
@@ -60,7 +112,26 @@ namespace earth_map {
 class TileTextureCoordinator {
 public:
     static constexpr std::uint32_t kDefaultTileSize = 256;
+    /// Pool layer budget when the driver does not report free video memory
     static constexpr std::uint32_t kDefaultMaxPoolLayers = 512;
+    /// Share of the free video memory at startup the tile pool may use
+    static constexpr double kAutoVramBudgetFraction = 0.5;
+    /// Pool layers kept free for the upload thread while tiles are loading
+    static constexpr std::size_t kUploadThreadHeadroomLayers = 16;
+    /// Pool tiles evicted at once when layers must be freed
+    static constexpr std::size_t kEvictionBatchLayers = 8;
+    /// Share of the pool budget ancestors of visible tiles may hold protected
+    static constexpr double kMaxProtectedPoolFraction = 0.5;
+    /// Overlay layers the tile shader composites over the base imagery
+    static constexpr std::size_t kMaxOverlayLayers = 3;
+    /// Priority added per frame a time-series frame is ahead of the shown one
+    static constexpr int kTimeSeriesFramePriorityStep = 1000;
+    /// Priority advantage per level an auto-requested ancestor is above its tile
+    static constexpr int kAncestorPriorityStep = 1000;
+    /// Pool tiles WarmUpView() requests by default
+    static constexpr std::size_t kDefaultWarmUpTiles = 64;
+    /// Hottest cache tiles WarmUpView() considers
+    static constexpr std::size_t kWarmUpCandidateTiles = 1024;
 
     /**
      * @brief Tile loading state
@@ -85,14 +156,20 @@ public:
      *
      * @param cache Tile cache (may be null)
      * @param loader Tile loader (required)
-     * @param num_worker_threads Number of worker threads (default: 4)
+     * @param num_worker_threads Number of decode threads (0 = hardware concurrency)
      * @param skip_gl_init Skip OpenGL initialization for testing (default: false)
+     * @param pool_format Tile pool format; BC1 makes the decode threads
+     *        compress tiles before upload (RGBA8 if the driver lacks BC1)
+     * @param mipmapped_pool Store a full mip chain per tile, built by the
+     *        decode threads (a third more VRAM per tile)
      */
     explicit TileTextureCoordinator(
         std::shared_ptr<TileCache> cache,
         std::shared_ptr<TileLoader> loader,
-        int num_worker_threads = 4,
-        bool skip_gl_init = false);
+        int num_worker_threads = 0,
+        bool skip_gl_init = false,
+        TileTextureFormat pool_format = TileTextureFormat::RGBA8,
+        bool mipmapped_pool = true);
 
     /**
      * @brief Destructor
@@ -110,8 +187,13 @@ public:
     /**
      * @brief Request tiles to load (non-blocking, idempotent)
      *
-     * Submits tile load requests to worker pool. Tiles already loaded or
-     * currently loading are skipped (idempotent behavior).
+     * Submits tile load requests to worker pool. Tiles already loaded are
+     * skipped (idempotent behavior). Tiles still queued for loading take the
+     * new priority and are stamped with the current request generation.
+     *
+     * With SetAncestorLevels() > 0 the missing ancestors of each tile are
+     * requested too, kAncestorPriorityStep better per level up and ahead of
+     * the tiles themselves, so coarse coverage arrives first and sharpens.
      *
      * @param tiles List of tile coordinates to load
      * @param priority Priority (lower number = higher priority, default: 0)
@@ -120,9 +202,73 @@ public:
      * Performance: O(n) where n = tiles.size()
      */
     void RequestTiles(
-        const std::vector<TileCoordinates>& tiles,
+        std::span<const TileCoordinates> tiles,
         int priority = 0);
 
+    /**
+     * @brief Request tiles to load (see the span overload)
+     */
+    void RequestTiles(const std::vector<TileCoordinates>& tiles, int priority = 0) {
+        RequestTiles(std::span<const TileCoordinates>(tiles), priority);
+    }
+
+    /**
+     * @brief Start a new request generation
+     *
+     * Call before RequestTiles() for each visible-tile update. Queued
+     * requests not renewed by RequestTiles() in this generation are dropped
+     * by CancelStaleRequests().
+     *
+     * @return New generation number
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    std::uint64_t BeginRequestGeneration();
+
+    /**
+     * @brief Load the cache's most used tiles that cover a view into the pool
+     *
+     * Meant for startup, with the tiles of the initial camera view: of the
+     * tiles the cache's access histogram ranks hottest, those overlapping
+     * @p view_tiles (same tile, ancestor or descendant) are requested, up
+     * to @p max_tiles. Caches without a histogram yield nothing.
+     *
+     * @return Number of tiles requested
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    std::size_t WarmUpView(std::span<const TileCoordinates> view_tiles,
+                           std::size_t max_tiles = kDefaultWarmUpTiles,
+                           int priority = 0);
+
+    /**
+     * @brief Set how many levels of ancestors RequestTiles() adds (0 = none)
+     *
+     * Usually the depth of the shader's fallback chain below the drawn
+     * zoom. The walk up from a tile stops at the first loaded ancestor.
+     * Applies to the overlay and time-series layers as well.
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    void SetAncestorLevels(int levels);
+
+    /**
+     * @brief Get the ancestor levels RequestTiles() adds
+     */
+    int GetAncestorLevels() const { return ancestor_levels_.load(); }
+
+    /**
+     * @brief Drop queued loads for tiles no longer requested
+     *
+     * Removes requests from older generations that workers have not picked
+     * up yet and returns those tiles to NotLoaded.
+     *
+     * @return Number of tile loads cancelled
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    std::size_t CancelStaleRequests();
+
     /**
      * @brief Check if tile is ready for rendering
      *
@@ -150,14 +296,97 @@ public:
      */
     glm::vec4 GetTileUV(const TileCoordinates& coords) const;
 
+    /**
+     * @brief Get the states of many tiles at once
+     *
+     * Takes the state lock once for the whole batch, so a frame's visible
+     * tiles cost one lock acquisition rather than one or two per tile.
+     * Tiles never requested (or evicted) report a default NotLoaded state.
+     *
+     * @param tiles Tiles to look up
+     * @param states Receives the state of each tile (same size as tiles)
+     * @throws std::invalid_argument if the spans differ in size
+     *
+     * Thread Safety: Safe to call from any thread
+     * Performance: O(n) where n = tiles.size()
+     */
+    void QueryTiles(std::span<const TileCoordinates> tiles, std::span<TileState> states) const;
+
     /**
      * @brief Get tile pool texture array ID
      *
-     * Returns the OpenGL GL_TEXTURE_2D_ARRAY ID for the tile pool.
+     * Returns the OpenGL GL_TEXTURE_2D_ARRAY ID of one of the tile pool's
+     * arrays (see TileTexturePool::kMaxArrays).
+     *
+     * @param array Array index
+     * @return OpenGL texture ID, or 0 if the array is not allocated
+     */
+    std::uint32_t GetTilePoolTextureID(std::size_t array = 0) const;
+
+    /**
+     * @brief Get layers per tile pool array (power of two)
+     *
+     * A layer index from the indirection textures addresses array
+     * layer / GetTilePoolLayersPerArray(), layer layer % GetTilePoolLayersPerArray().
+     */
+    std::uint32_t GetTilePoolLayersPerArray() const;
+
+    /**
+     * @brief Set the VRAM the tile pool may use (GL thread)
+     *
+     * Tiles beyond the new budget are evicted, least recently used first, by
+     * the following ProcessUploads() calls.
+     *
+     * @param bytes Budget in bytes; 0 = kAutoVramBudgetFraction of the free
+     *        video memory the driver reports (kDefaultMaxPoolLayers layers
+     *        if it reports none)
+     */
+    void SetVramBudget(std::size_t bytes);
+
+    /**
+     * @brief Get the tile pool's VRAM budget in bytes
+     */
+    std::size_t GetVramBudget() const;
+
+    /**
+     * @brief Score pool tiles for eviction by the view's visible tiles (GL thread)
+     *
+     * Call once per view update. Ancestors of @p visible are protected from
+     * eviction, visible tiles are evicted last and the rest by distance to
+     * @p focus (see TileEvictionPolicy). Applies to the overlays' tiles too.
+     *
+     * @param visible Tiles selected for the view
+     * @param focus Tile under the camera at the view's zoom
+     */
+    void UpdateEvictionPriorities(std::span<const TileCoordinates> visible,
+                                  const TileCoordinates& focus);
+
+    /**
+     * @brief Get the number of pool tiles protected as ancestors of visible tiles
+     */
+    std::size_t GetProtectedTileCount() const;
+
+    /**
+     * @brief Get the VRAM held by the tile pool's occupied layers in bytes
+     */
+    std::size_t GetVramUsage() const;
+
+    /**
+     * @brief Evict tiles, least recently used first, until at most @p bytes are held (GL thread)
+     *
+     * Keeps the budget, so the pool refills as tiles are requested again.
+     * Pinned tiles are never evicted.
      *
-     * @return OpenGL texture ID
+     * @return Number of tiles evicted
      */
-    std::uint32_t GetTilePoolTextureID() const;
+    std::size_t ShedTiles(std::size_t bytes);
+
+    /**
+     * @brief Set the maximum anisotropy the tile pool is sampled with (GL thread)
+     *
+     * Clamped to the driver maximum; 1 disables anisotropic filtering.
+     */
+    void SetMaxAnisotropy(float anisotropy);
 
     /**
      * @brief Get indirection texture ID for a zoom level
@@ -174,6 +403,13 @@ public:
      */
     glm::ivec2 GetIndirectionOffset(int zoom) const;
 
+    /**
+     * @brief Get indirection texture size in texels for a zoom level
+     *
+     * @return (0, 0) if the zoom level is not allocated
+     */
+    glm::ivec2 GetIndirectionSize(int zoom) const;
+
     /**
      * @brief Update indirection window center for windowed zoom levels
      *
@@ -182,6 +418,13 @@ public:
      */
     void UpdateIndirectionWindowCenter(int zoom, int center_tile_x, int center_tile_y);
 
+    /**
+     * @brief Upload the frame's indirection changes in merged batches (GL thread)
+     *
+     * Call after the frame's uploads and window updates, before drawing.
+     */
+    void FlushIndirectionUpdates();
+
     /**
      * @brief Get tile pool layer index for a tile
      *
@@ -194,19 +437,59 @@ public:
      */
     std::uint32_t GetAtlasTextureID() const;
 
+    /// Default time spent on tile uploads per frame
+    static constexpr std::chrono::microseconds kDefaultUploadBudget{2000};
+
     /**
      * @brief Process upload queue (must be called from GL thread)
      *
-     * Drains the GL upload queue and uploads tiles to the atlas.
-     * Should be called once per frame from the rendering thread.
+     * Drains the GL upload queue and uploads tiles to the tile pool in
+     * priority order (lowest zoom first, then closest to the upload focus)
+     * until the measured upload cost would exceed @p frame_budget.
+     * Should be called once per frame from the rendering thread. With the
+     * upload thread running it transfers no pixels and ignores @p frame_budget.
      *
-     * @param max_uploads_per_frame Maximum uploads per call (default: 5)
-     *                              Limits GPU upload time per frame
+     * @param frame_budget Time allowed for uploads this frame
      *
      * Thread Safety: MUST be called from GL thread only
-     * Performance: O(max_uploads_per_frame)
      */
-    void ProcessUploads(int max_uploads_per_frame = 5);
+    void ProcessUploads(std::chrono::microseconds frame_budget = kDefaultUploadBudget);
+
+    /**
+     * @brief Move pixel transfers to a thread with its own shared context (GL thread)
+     *
+     * Afterwards ProcessUploads() only publishes uploads whose fences have
+     * signalled: it sets their indirection entries and marks them Loaded.
+     * The upload thread spends kDefaultUploadBudget per batch and cannot
+     * evict, so ProcessUploads() keeps kUploadThreadHeadroomLayers free.
+     *
+     * @param context Context in the render context's share group, not
+     *        current anywhere (see OpenGLContext::CreateSharedWithCurrent());
+     *        may be null when GL is skipped
+     * @return true if the thread runs; false leaves uploads on the GL thread
+     */
+    bool StartUploadThread(std::unique_ptr<OpenGLContext> context);
+
+    /**
+     * @brief Check whether uploads run on the upload thread
+     */
+    bool IsUploadThreadRunning() const { return upload_thread_ != nullptr; }
+
+    /**
+     * @brief Set the tile uploads are ordered around (usually the view center)
+     *
+     * Thread Safety: MUST be called from GL thread only
+     */
+    void SetUploadFocus(const TileCoordinates& focus);
+
+    /**
+     * @brief Get upload throughput and budget statistics
+     *
+     * With the upload thread, as of its last batch.
+     *
+     * Thread Safety: MUST be called from GL thread only
+     */
+    TileUploadStats GetUploadStats() const;
 
     /**
      * @brief Evict tiles not used recently
@@ -222,6 +505,19 @@ public:
     std::size_t EvictUnusedTiles(
         std::chrono::seconds max_age = std::chrono::seconds(300));
 
+    /**
+     * @brief Upload decoded tiles and keep them resident (GL thread)
+     *
+     * Builds each tile's mip chain and pool format (in parallel), uploads
+     * it, marks it Loaded and pins it, so neither LRU nor age eviction
+     * removes it. Used for the basemap pack (DecodeBasemapPack()). Stops
+     * when the pool is full.
+     *
+     * @param tiles Decoded tiles; their pixels are transcoded in place
+     * @return Number of tiles uploaded
+     */
+    std::size_t AddResidentTiles(std::vector<ResidentTile>& tiles);
+
     /**
      * @brief Get tile status
      *
@@ -232,6 +528,29 @@ public:
      */
     TileStatus GetTileStatus(const TileCoordinates& coords) const;
 
+    /**
+     * @brief Get tile image decode statistics per format
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    ImageDecodeStats GetDecodeStats() const { return worker_pool_->GetDecodeStats(); }
+
+    /**
+     * @brief Get decode buffer and upload command recycling statistics
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    TileBufferPoolStats GetBufferPoolStats() const {
+        return worker_pool_->GetBufferPool()->GetStats();
+    }
+
+    /**
+     * @brief Configure building tiles from their cached children on zoom-out
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    void SetPyramidConfig(const TilePyramidConfig& config) { worker_pool_->SetPyramidConfig(config); }
+
     /**
      * @brief Get number of tiles currently in Loading state
      *
@@ -239,10 +558,230 @@ public:
      */
     std::size_t GetPendingLoadCount() const { return pending_load_count_.load(); }
 
+    /**
+     * @brief Get the sizes of the per-tile maps (should stay bounded by the pool budget)
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    TileStateMapSizes GetStateMapSizes() const;
+
+    /**
+     * @brief Configure per-tile lifecycle tracing
+     *
+     * While enabled, every new request carries a trace stamped at each
+     * pipeline stage up to the first frame that draws the tile (see
+     * MarkTilesRendered()).
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    void SetTraceConfig(const TileLoadTraceConfig& config) { tracer_->SetConfig(config); }
+
+    /**
+     * @brief Check whether new requests are traced
+     */
+    bool IsTracingTiles() const { return tracer_->IsEnabled(); }
+
+    /**
+     * @brief Get per-stage latency histograms and outcomes of finished traces
+     *
+     * Thread Safety: Safe to call from any thread
+     */
+    TileLoadTraceStats GetTraceStats() const { return tracer_->GetStats(); }
+
+    /**
+     * @brief Write the recorded traces as Chrome trace event JSON
+     *
+     * Opens in chrome://tracing and ui.perfetto.dev.
+     *
+     * @return true if the file was written
+     */
+    bool ExportTrace(const std::string& path) const { return tracer_->WriteChromeTrace(path); }
+
+    /**
+     * @brief Finish the traces of uploaded tiles drawn this frame (GL thread)
+     *
+     * Call after drawing with the tiles that were ready. Tiles without an
+     * outstanding trace are ignored.
+     */
+    void MarkTilesRendered(std::span<const TileCoordinates> tiles);
+
     /// Maximum number of concurrent pending tile loads before backpressure kicks in
     static constexpr std::size_t kMaxPendingLoads = 256;
 
+    /**
+     * @brief Add an imagery layer drawn over this one (GL thread)
+     *
+     * The overlay loads and decodes with its own workers and keeps its own
+     * indirection textures, but its tiles share this coordinator's pool and
+     * VRAM budget. Requests, uploads, window updates and evictions made on
+     * this coordinator are applied to every overlay, so the renderer drives
+     * the base layer only.
+     *
+     * @param cache Overlay tile cache (may be null)
+     * @param loader Overlay tile loader (required)
+     * @param opacity Blend factor over the layers below (clamped to [0, 1])
+     * @param num_worker_threads Decode threads (0 = hardware concurrency)
+     * @return Overlay index, or -1 if kMaxOverlayLayers are in use
+     * @throws std::invalid_argument if the loader is null or this is an overlay
+     */
+    int AddOverlayLayer(std::shared_ptr<TileCache> cache,
+                        std::shared_ptr<TileLoader> loader,
+                        float opacity = 1.0f,
+                        int num_worker_threads = 0);
+
+    /**
+     * @brief Add an animated layer of timestamped frames drawn over the overlays (GL thread)
+     *
+     * Frame i is @p provider with {t} set to config.frame_times[i]
+     * (TimeFrameTileProvider), registered with @p loader. A ring of
+     * prefetch_frames + 1 frame slots, each with its own workers, states and
+     * indirection textures, loads the tiles requested on this coordinator
+     * for the shown frame and the ones after it, later frames at lower
+     * priority. Slot tiles are never pool eviction candidates; the ring
+     * keeps them within config.pool_fraction of the budget itself, dropping
+     * tiles that left the view, and hands a slot to the next frame once its
+     * frame has been shown and its loads have drained. Switching to a
+     * prefetched frame only rebinds that slot's indirection texture.
+     *
+     * The layer counts as one overlay and is always the last one
+     * (GetOverlay() returns the slot drawn: the shown frame's, or the last
+     * frame shown until the shown frame has a slot).
+     *
+     * @param loader Loader the frames are registered with; tile caches are
+     *        keyed by coordinates only, so it must have none
+     * @param provider Provider with {t} in its URL templates
+     * @param config Frames and ring configuration
+     * @param opacity Blend factor over the layers below (clamped to [0, 1])
+     * @param num_worker_threads Decode threads per frame slot (0 = hardware concurrency)
+     * @return Overlay index, or -1 if kMaxOverlayLayers are in use
+     * @throws std::invalid_argument if the loader or provider is null, the
+     *         loader has a tile cache, there are no frames, a time-series
+     *         layer exists or this is an overlay
+     */
+    int AddTimeSeriesLayer(std::shared_ptr<TileLoader> loader,
+                           std::shared_ptr<const TileProvider> provider,
+                           const TimeSeriesLayerConfig& config,
+                           float opacity = 1.0f,
+                           int num_worker_threads = 1);
+
+    /**
+     * @brief Show the frame an animation time falls in (GL thread)
+     *
+     * Each frame lasts config.frame_duration; playback loops.
+     */
+    void SetAnimationTime(std::chrono::duration<double> time);
+
+    /**
+     * @brief Show a time-series frame (GL thread; wraps around the frame count)
+     */
+    void SetTimeSeriesFrame(std::size_t frame);
+
+    /**
+     * @brief Get the time-series frame shown (0 without a time-series layer)
+     */
+    std::size_t GetTimeSeriesFrame() const;
+
+    /**
+     * @brief Get the ring slot holding a frame's tiles
+     *
+     * @return The slot, or null if the frame has none
+     */
+    TileTextureCoordinator* GetTimeSeriesFrameLayer(std::size_t frame) const;
+
+    /**
+     * @brief Get the number of overlay layers (a time-series layer included)
+     */
+    std::size_t GetOverlayCount() const { return overlays_.size() + (time_series_ ? 1 : 0); }
+
+    /**
+     * @brief Get an overlay's coordinator (states, indirection textures, stats)
+     *
+     * @return The overlay, or null if @p index is out of range
+     */
+    TileTextureCoordinator* GetOverlay(std::size_t index) const;
+
+    /**
+     * @brief Set an overlay's opacity (clamped to [0, 1]; 0 skips its lookups)
+     */
+    void SetOverlayOpacity(std::size_t index, float opacity);
+
+    /**
+     * @brief Get an overlay's opacity (0 if @p index is out of range)
+     */
+    float GetOverlayOpacity(std::size_t index) const;
+
 private:
+    /// Tile pool shared by a coordinator and its overlays
+    struct SharedPool {
+        std::unique_ptr<TileTexturePool> pool;
+        /// Guards pool once the upload thread shares it
+        std::mutex mutex;
+        /// Coordinator owning each pool namespace (0 = base, i + 1 = overlay i)
+        std::vector<TileTextureCoordinator*> users;
+        /// Scores the pool's tiles (guarded by mutex)
+        TileEvictionPolicy eviction_policy;
+        /// Namespaces whose tiles are never eviction candidates (guarded by mutex)
+        std::vector<bool> reserved_namespaces;
+    };
+
+    /// An overlay coordinator and its blend factor
+    struct OverlayLayer {
+        std::unique_ptr<TileTextureCoordinator> coordinator;
+        float opacity = 1.0f;
+    };
+
+    /// Frame ring of a time-series layer (guarded by time_series_mutex_)
+    struct TimeSeriesLayer {
+        TimeSeriesLayerConfig config;
+        /// Loader provider of each frame
+        std::vector<std::string> provider_names;
+        /// Frame slots (the vector itself is fixed once created)
+        std::vector<std::unique_ptr<TileTextureCoordinator>> slots;
+        /// Frame each slot holds
+        std::vector<std::size_t> slot_frames;
+        std::size_t current_frame = 0;
+        /// Slot drawn: the current frame's once it has one
+        std::size_t shown_slot = 0;
+        float opacity = 1.0f;
+        /// Tiles visible at the last UpdateEvictionPriorities()
+        TileSet visible;
+    };
+
+    /// Zoom offset between pool namespaces (pool keys never pass for real tiles)
+    static constexpr std::int32_t kPoolNamespaceZoomStride = 32;
+
+    /**
+     * @brief Overlay constructor: shares @p base's tile pool
+     */
+    TileTextureCoordinator(TileTextureCoordinator& base,
+                           std::shared_ptr<TileCache> cache,
+                           std::shared_ptr<TileLoader> loader,
+                           int num_worker_threads);
+
+    /**
+     * @brief Create the queue, indirection, scheduler, staging ring and workers
+     */
+    void InitializePipeline(std::shared_ptr<TileCache> cache,
+                            std::shared_ptr<TileLoader> loader,
+                            int num_worker_threads);
+
+    /**
+     * @brief Key of a tile of this layer in the shared pool
+     */
+    TileCoordinates PoolKey(const TileCoordinates& coords) const {
+        return {coords.x, coords.y, coords.zoom + pool_namespace_ * kPoolNamespaceZoomStride};
+    }
+
+    /**
+     * @brief Evict a pool key through the layer that owns it (GL thread)
+     */
+    void EvictPoolKey(const TileCoordinates& key);
+
+    /**
+     * @brief Score pool keys with the shared eviction policy (call with pool_mutex_ held)
+     */
+    TileImportanceFn EvictionImportance() const;
+
     /**
      * @brief Callback when worker completes tile loading
      *
@@ -253,26 +792,154 @@ private:
      */
     void OnTileLoadComplete(const TileCoordinates& coords);
 
+    /**
+     * @brief Upload a command's staged pixels to the tile pool
+     *
+     * @return Layer index, or -1 on failure
+     */
+    int UploadFromSlot(const GLUploadCommand& cmd);
+
+    /**
+     * @brief Upload a command to the pool and release its slot (upload or GL thread)
+     *
+     * @param allow_evict Evict the LRU tile if the pool is full (GL thread only)
+     * @return Layer index, or -1 on failure
+     */
+    int UploadToPool(GLUploadCommand& cmd, bool allow_evict);
+
+    /**
+     * @brief Point the indirection entry at an uploaded tile and mark it Loaded (GL thread)
+     *
+     * @param layer Pool layer, or -1 if the upload failed
+     * @param trace Lifecycle trace of the load, or null
+     */
+    void FinishUpload(const TileCoordinates& coords, int layer,
+                      const std::function<void(const TileCoordinates&)>& on_complete,
+                      const std::shared_ptr<TileLoadTrace>& trace);
+
+    /**
+     * @brief Upload the next batch of commands (upload thread)
+     *
+     * @return true if anything was uploaded
+     */
+    bool RunUploadBatch(std::vector<CompletedTileUpload>& completed);
+
+    /**
+     * @brief Scheduler callback returning uploaded commands to the worker pool
+     */
+    TileUploadScheduler::RecycleFn MakeCommandRecycler() const;
+
+    /**
+     * @brief Remove a tile from the pool, its indirection entry and its state (GL thread)
+     */
+    void EvictPoolTile(const TileCoordinates& coords);
+
+    /**
+     * @brief Remove a tile's state, settling the pending count if it was Loading
+     */
+    void ForgetTile(const TileCoordinates& coords);
+
+    /**
+     * @brief Finish the trace of an uploaded tile that leaves the pool undrawn
+     */
+    void FinishAwaitingTrace(const TileCoordinates& coords);
+
+    /**
+     * @brief Number of tiles loading or loaded
+     */
+    std::size_t GetTileCount() const;
+
+    /**
+     * @brief Evict loaded tiles outside @p keep until at most @p max_tiles remain (GL thread)
+     */
+    void TrimTiles(const TileSet& keep, std::size_t max_tiles);
+
+    /**
+     * @brief Hand frame slots to the frames of the prefetch window and keep
+     *        them within their region (GL thread, time_series_mutex_ held)
+     */
+    void UpdateTimeSeriesLocked();
+
+    /**
+     * @brief Request tiles for the frames of the prefetch window
+     */
+    void RequestTimeSeriesTiles(std::span<const TileCoordinates> tiles, int priority);
+
+    /**
+     * @brief Check whether a frame is within the prefetch window (time_series_mutex_ held)
+     *
+     * @return Frames the window is ahead of the shown one at @p frame, or nullopt
+     */
+    std::optional<std::size_t> GetFrameDistanceLocked(std::size_t frame) const;
+
+    /**
+     * @brief Pool layers one frame slot may hold (time_series_mutex_ held)
+     */
+    std::size_t GetFrameSlotLayersLocked() const;
+
     /// Tile state map (coordinates → state)
-    std::unordered_map<TileCoordinates, TileState, TileCoordinatesHash> tile_states_;
+    TileMap<TileState> tile_states_;
 
     /// Mutex protecting tile_states_ (read-write lock for concurrency)
     mutable std::shared_mutex state_mutex_;
 
+    /// Ancestor levels requested along with each tile (0 = only the tile)
+    std::atomic<int> ancestor_levels_{0};
+
+    /// Staging slots shared by decode threads and uploads (outlives worker_pool_)
+    std::shared_ptr<PixelBufferRing> pixel_ring_;
+
+    /// Lifecycle traces of tile loads (shared with the worker pool)
+    std::shared_ptr<TileLoadTracer> tracer_;
+
+    /// Traces of uploaded tiles not drawn yet (guarded by trace_mutex_)
+    TileMap<std::shared_ptr<TileLoadTrace>> awaiting_render_;
+    mutable std::mutex trace_mutex_;
+
     /// Worker pool for loading and decoding tiles
     std::unique_ptr<TileLoadWorkerPool> worker_pool_;
 
     /// GL upload queue (MPSC queue)
     std::shared_ptr<GLUploadQueue> upload_queue_;
 
-    /// Tile texture pool (GL_TEXTURE_2D_ARRAY, GL thread only)
-    std::unique_ptr<TileTexturePool> tile_pool_;
+    /// Orders uploads and spends the per-frame budget (GL thread only)
+    std::unique_ptr<TileUploadScheduler> upload_scheduler_;
+
+    /// Tile pool shared with the overlays (base and overlays keep it alive)
+    std::shared_ptr<SharedPool> shared_pool_;
+
+    /// Tile texture pool (GL_TEXTURE_2D_ARRAY; GL and upload thread under pool_mutex_)
+    TileTexturePool* tile_pool_;
+
+    /// Guards tile_pool_ once the upload thread shares it
+    std::mutex& pool_mutex_;
+
+    /// This layer's pool namespace (0 = base, i + 1 = overlay i)
+    std::int32_t pool_namespace_ = 0;
 
     /// Indirection texture manager (per-zoom lookup textures, GL thread only)
     std::unique_ptr<IndirectionTextureManager> indirection_manager_;
 
     /// Number of tiles currently in Loading state (atomic for lock-free reads)
     std::atomic<std::size_t> pending_load_count_{0};
+
+    /// GL objects are not created (testing)
+    bool skip_gl_init_;
+
+    /// Upload focus and the upload thread's last statistics
+    mutable std::mutex upload_focus_mutex_;
+    TileCoordinates upload_focus_{0, 0, 0};
+    TileUploadStats upload_stats_;
+
+    /// Issues uploads from a shared context (null = uploads on the GL thread)
+    std::unique_ptr<TileUploadThread> upload_thread_;
+
+    /// Overlay layers, bottom to top (GL thread only)
+    std::vector<OverlayLayer> overlays_;
+
+    /// Time-series layer drawn over the overlays (null if none)
+    std::unique_ptr<TimeSeriesLayer> time_series_;
+    mutable std::mutex time_series_mutex_;
 };
 
 } // namespace earth_map
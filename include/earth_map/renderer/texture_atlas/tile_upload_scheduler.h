@@ -0,0 +1,199 @@
+#pragma once
+
+/**
+ * @file tile_upload_scheduler.h
+ * @brief Time-budgeted, priority-ordered scheduling of tile texture uploads
+ *
+ * Replaces a fixed number of uploads per frame with a per-frame time budget.
+ * Commands drained from the GLUploadQueue are staged and uploaded in priority
+ * order until the estimated cost of the next upload would exceed the budget:
+ * - Lower zoom first (coarse tiles are the fallback for everything above)
+ * - Within a zoom, closest to the focus tile first
+ *
+ * Upload cost is an exponential moving average of the measured CPU submit
+ * time and, when GL is available, of the GPU time reported by GL_TIME_ELAPSED
+ * queries (read back a few frames later without stalling).
+ */
+
+#include <earth_map/math/tile_mathematics.h>
+#include <earth_map/renderer/texture_atlas/gl_upload_queue.h>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Upload scheduler configuration
+ */
+struct TileUploadSchedulerConfig {
+    /// Upload cost assumed before any measurement (microseconds)
+    double initial_upload_cost_us = 250.0;
+
+    /// Weight of a new measurement in the cost average (0..1]
+    double cost_smoothing = 0.2;
+
+    /// Length of the window uploads per second are measured over
+    std::chrono::milliseconds rate_window{1000};
+};
+
+/**
+ * @brief Upload scheduler statistics
+ */
+struct TileUploadStats {
+    /// Tile uploads per second over the last completed window
+    double uploads_per_second = 0.0;
+
+    /// Uploads issued by the last RunFrame()
+    std::size_t uploads_last_frame = 0;
+
+    /// Total uploads issued
+    std::uint64_t total_uploads = 0;
+
+    /// Frames whose CPU or GPU upload time exceeded the budget
+    std::uint64_t budget_overruns = 0;
+
+    /// Current estimated cost of one upload (microseconds)
+    double estimated_upload_cost_us = 0.0;
+
+    /// Average GPU time per upload (0 until a timer query returned)
+    double gpu_upload_cost_us = 0.0;
+
+    /// Commands staged but not yet uploaded
+    std::size_t staged_uploads = 0;
+};
+
+/**
+ * @brief Orders staged tile uploads and spends a per-frame time budget on them
+ *
+ * Thread Safety: NOT thread-safe — GL thread only (producers only touch
+ * the GLUploadQueue).
+ */
+class TileUploadScheduler {
+public:
+    /// Callback performing one upload (GL thread)
+    using UploadFn = std::function<void(GLUploadCommand&)>;
+
+    /// Callback taking back a command once it was handed to the upload function
+    using RecycleFn = std::function<void(std::unique_ptr<GLUploadCommand>)>;
+
+    /**
+     * @brief Constructor
+     *
+     * @param config Scheduler configuration
+     * @param skip_gl_init Measure CPU time only, no GL timer queries (for testing)
+     */
+    explicit TileUploadScheduler(
+        const TileUploadSchedulerConfig& config = TileUploadSchedulerConfig{},
+        bool skip_gl_init = false);
+
+    /**
+     * @brief Destructor (deletes timer queries)
+     */
+    ~TileUploadScheduler();
+
+    // Non-copyable
+    TileUploadScheduler(const TileUploadScheduler&) = delete;
+    TileUploadScheduler& operator=(const TileUploadScheduler&) = delete;
+
+    // Non-movable (owns GL query objects)
+    TileUploadScheduler(TileUploadScheduler&&) = delete;
+    TileUploadScheduler& operator=(TileUploadScheduler&&) = delete;
+
+    /**
+     * @brief Set the tile uploads are ordered around (usually the view center)
+     */
+    void SetFocus(const TileCoordinates& focus);
+
+    /**
+     * @brief Hand finished commands to @p recycle instead of deleting them
+     *
+     * Used to return commands to the TileBufferPool they came from.
+     */
+    void SetRecycler(RecycleFn recycle) { recycle_ = std::move(recycle); }
+
+    /**
+     * @brief Drain the queue and upload staged tiles within the budget
+     *
+     * Failure commands (no pixel slot) are always handed to @p upload first,
+     * since they cost no GPU time. At least one real upload is issued per
+     * call so that progress never stalls when the budget is tiny.
+     *
+     * @param queue Queue to drain into the staging list
+     * @param budget Time allowed for uploads this frame
+     * @param upload Performs one upload
+     * @return Number of commands handed to @p upload
+     */
+    std::size_t RunFrame(GLUploadQueue& queue,
+                         std::chrono::microseconds budget,
+                         const UploadFn& upload);
+
+    /**
+     * @brief Get number of staged commands not yet uploaded
+     */
+    std::size_t GetStagedCount() const { return staged_.size(); }
+
+    /**
+     * @brief Get scheduler statistics
+     */
+    TileUploadStats GetStats() const;
+
+private:
+    /// Timer queries in flight; results are read a few frames later
+    static constexpr std::size_t kTimerQueryCount = 4;
+
+    /**
+     * @brief GPU timing of one frame's uploads
+     */
+    struct TimerQuery {
+        std::uint32_t id = 0;
+        std::size_t uploads = 0;
+        std::int64_t budget_us = 0;
+        bool cpu_overrun = false;
+        bool pending = false;
+    };
+
+    /**
+     * @brief Sort key: zoom, then distance to the focus at that zoom
+     */
+    std::uint64_t PriorityKey(const TileCoordinates& coords) const;
+
+    void CollectTimerQueries();
+    void RecordCost(double sample_us, double& average_us) const;
+    void UpdateRate(std::size_t uploads);
+    void Retire(std::vector<std::unique_ptr<GLUploadCommand>>::iterator first,
+                std::vector<std::unique_ptr<GLUploadCommand>>::iterator last);
+
+    TileUploadSchedulerConfig config_;
+    bool use_timer_queries_;
+
+    /// Commands drained from the queue, waiting for budget
+    std::vector<std::unique_ptr<GLUploadCommand>> staged_;
+
+    /// Ordering focus
+    TileCoordinates focus_{0, 0, 0};
+
+    /// Receives finished commands (null = delete them)
+    RecycleFn recycle_;
+
+    /// Cost averages (microseconds per upload)
+    double cpu_cost_us_;
+    double gpu_cost_us_ = 0.0;
+
+    /// GL_TIME_ELAPSED queries, used round-robin
+    std::array<TimerQuery, kTimerQueryCount> queries_{};
+    std::size_t next_query_ = 0;
+
+    /// Statistics
+    std::uint64_t total_uploads_ = 0;
+    std::uint64_t budget_overruns_ = 0;
+    std::size_t uploads_last_frame_ = 0;
+    double uploads_per_second_ = 0.0;
+    std::size_t window_uploads_ = 0;
+    std::chrono::steady_clock::time_point window_start_;
+};
+
+} // namespace earth_map
@@ -0,0 +1,138 @@
+#pragma once
+
+/**
+ * @file tile_upload_thread.h
+ * @brief Tile texture uploads on a thread with its own shared GL context
+ *
+ * Pixel transfers into the tile pool cost render-thread time even when
+ * sourced from a pixel unpack buffer. With a second context in the render
+ * context's share group, a dedicated thread issues them instead:
+ *
+ *   upload thread: batch of pool uploads → glFenceSync → glFlush → queue
+ *   render thread: Publish() → fence signalled → apply results (indirection
+ *                  entry, Loaded state)
+ *
+ * A tile becomes visible only after its fence signalled, so the render
+ * context never samples a layer whose upload is still in flight. Texture,
+ * buffer and sync objects are shared between the contexts; the render
+ * thread re-binds the pool arrays every frame, which makes the completed
+ * uploads visible to it.
+ */
+
+#include <earth_map/math/tile_mathematics.h>
+#include <earth_map/platform/opengl_context.h>
+#include <earth_map/renderer/texture_atlas/tile_load_trace.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Result of one upload issued on the upload thread
+ */
+struct CompletedTileUpload {
+    TileCoordinates coords;
+
+    /// Pool layer the tile was uploaded to (-1 = upload failed)
+    int layer = -1;
+
+    /// Callback of the upload command, run on the render thread when published
+    std::function<void(const TileCoordinates&)> on_complete;
+
+    /// Lifecycle trace of the request (null unless tracing is enabled)
+    std::shared_ptr<TileLoadTrace> trace = nullptr;
+};
+
+/**
+ * @brief Thread owning a shared GL context that runs upload batches
+ *
+ * Thread Safety: Publish() and the getters are safe from any thread, but
+ * Publish() needs a context of the share group current (the render thread).
+ */
+class TileUploadThread {
+public:
+    /// Issues one batch of uploads on the upload thread; false = nothing to do
+    using BatchFn = std::function<bool(std::vector<CompletedTileUpload>&)>;
+
+    /// Applies one published upload on the render thread
+    using PublishFn = std::function<void(CompletedTileUpload&)>;
+
+    /// How long the thread sleeps when a batch found nothing to upload
+    static constexpr std::chrono::milliseconds kIdleWait{2};
+
+    /**
+     * @brief Constructor (starts the thread and waits until it has a context)
+     *
+     * @param context Context sharing objects with the render context; made
+     *        current on the upload thread. May be null with skip_gl_init.
+     * @param batch Upload batch function (must not be empty)
+     * @param skip_gl_init No fences, batches publish immediately (for testing)
+     * @throws std::invalid_argument if batch is empty
+     */
+    TileUploadThread(std::unique_ptr<OpenGLContext> context, BatchFn batch,
+                     bool skip_gl_init = false);
+
+    /**
+     * @brief Destructor: stops the thread; unpublished results are dropped
+     */
+    ~TileUploadThread();
+
+    // Non-copyable
+    TileUploadThread(const TileUploadThread&) = delete;
+    TileUploadThread& operator=(const TileUploadThread&) = delete;
+
+    /**
+     * @brief Check whether the thread runs (false if the context could not be made current)
+     */
+    bool IsRunning() const { return running_; }
+
+    /**
+     * @brief Hand results whose fences signalled to @p publish (non-blocking)
+     *
+     * Batches are published in the order they were uploaded.
+     *
+     * @return Number of uploads published
+     */
+    std::size_t Publish(const PublishFn& publish);
+
+    /** @brief Get number of batches uploaded but not yet published */
+    std::size_t GetPendingBatchCount() const;
+
+    /** @brief Get number of batches uploaded */
+    std::uint64_t GetBatchCount() const;
+
+private:
+    /**
+     * @brief Uploads waiting for their fence
+     */
+    struct Batch {
+        void* fence = nullptr;  ///< GLsync (null = nothing to wait for)
+        std::vector<CompletedTileUpload> uploads;
+    };
+
+    void Run();
+
+    std::unique_ptr<OpenGLContext> context_;
+    BatchFn batch_;
+    const bool skip_gl_init_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<Batch> batches_;
+    std::uint64_t batch_count_ = 0;
+    bool started_ = false;
+    bool running_ = false;
+    bool stop_ = false;
+
+    /// Declared last: started after, and joined before, the state above
+    std::thread thread_;
+};
+
+} // namespace earth_map
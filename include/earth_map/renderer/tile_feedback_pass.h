@@ -0,0 +1,162 @@
+#pragma once
+
+/**
+ * @file tile_feedback_pass.h
+ * @brief GPU feedback pass reporting which tiles cover pixels
+ *
+ * Virtual-texturing style tile determination: the globe is drawn into a
+ * low-resolution integer target whose fragment shader writes, per pixel, the
+ * tile (zoom, x, y) that pixel needs. The zoom comes from the screen-space
+ * derivatives of the pixel's Web Mercator coordinates, so it follows the
+ * real texel footprint (tilt, latitude) instead of a camera-wide estimate.
+ *
+ * The target is read back asynchronously: glReadPixels into one of a few
+ * pixel pack buffers, guarded by a fence, and collected a frame or two later
+ * without stalling the pipeline.
+ *
+ * Encoding of a feedback texel (GL_RG32UI): R = x, G = y | (zoom + 1) << 24.
+ * A cleared texel (0, 0) means "no globe here".
+ */
+
+#include <earth_map/math/tile_mathematics.h>
+#include <earth_map/renderer/gpu_resource_manager.h>
+#include <glm/glm.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Feedback pass configuration
+ */
+struct TileFeedbackConfig {
+    bool enabled = false;               ///< Request the tiles the GPU reports instead of CPU-selected ones
+    std::uint32_t downscale = 8;        ///< Feedback target size is the viewport divided by this
+    float lod_bias = 0.0f;              ///< Added to each pixel's zoom (positive = sharper)
+    std::uint32_t tile_size = 256;      ///< Tile edge length in texels
+};
+
+/**
+ * @brief Low-resolution tile feedback render pass with async readback
+ *
+ * Thread Safety: GL thread only.
+ */
+class TileFeedbackPass {
+public:
+    /// Readbacks that may be in flight at once
+    static constexpr std::size_t kReadbackDepth = 3;
+
+    TileFeedbackPass() = default;
+
+    /**
+     * @brief Destructor (releases GL objects; GL thread)
+     */
+    ~TileFeedbackPass();
+
+    // Non-copyable
+    TileFeedbackPass(const TileFeedbackPass&) = delete;
+    TileFeedbackPass& operator=(const TileFeedbackPass&) = delete;
+
+    /**
+     * @brief Compile the feedback shader
+     *
+     * @param config Pass configuration
+     * @return true if the pass is ready
+     */
+    bool Initialize(const TileFeedbackConfig& config);
+
+    /**
+     * @brief Update configuration (target size changes take effect next Render)
+     */
+    void SetConfig(const TileFeedbackConfig& config) { config_ = config; }
+
+    /**
+     * @brief Draw the globe into the feedback target and queue its readback
+     *
+     * Restores the previous framebuffer binding and viewport.
+     *
+     * @param globe GPU copy of the globe mesh
+     * @param view_matrix Camera view matrix
+     * @param projection_matrix Camera projection matrix
+     * @param min_zoom Coarsest zoom a pixel may request
+     * @param max_zoom Finest zoom a pixel may request
+     */
+    void Render(const GPUMesh& globe,
+                const glm::mat4& view_matrix, const glm::mat4& projection_matrix,
+                std::int32_t min_zoom, std::int32_t max_zoom);
+
+    /**
+     * @brief Collect the newest finished readback (non-blocking)
+     *
+     * @param tiles Replaced with the reported tiles, most covered first
+     * @return true if a new result was collected
+     */
+    bool Collect(std::vector<TileCoordinates>& tiles);
+
+    /**
+     * @brief Release GL objects (GL thread)
+     */
+    void Release();
+
+    /**
+     * @brief Check whether Initialize() succeeded
+     */
+    bool IsInitialized() const { return program_ != 0; }
+
+    /**
+     * @brief Encode a tile as a feedback texel (matches the shader)
+     */
+    static std::array<std::uint32_t, 2> EncodeTexel(const TileCoordinates& tile);
+
+    /**
+     * @brief Decode feedback texels into unique tiles
+     *
+     * @param texels Interleaved RG texels (2 values per pixel)
+     * @param tiles Replaced with the tiles found, ordered by pixel coverage
+     *        (most first), then finest zoom first
+     */
+    static void DecodeTexels(std::span<const std::uint32_t> texels,
+                             std::vector<TileCoordinates>& tiles);
+
+private:
+    /**
+     * @brief One pixel pack buffer and the fence of its pending readback
+     */
+    struct Readback {
+        std::uint32_t buffer = 0;
+        std::size_t capacity = 0;     ///< Buffer size in bytes
+        std::size_t texel_count = 0;  ///< Pixels of the pending readback
+        void* fence = nullptr;        ///< GLsync; null when idle
+        std::uint64_t sequence = 0;   ///< Submission order
+    };
+
+    bool EnsureTarget(std::uint32_t width, std::uint32_t height);
+    void QueueReadback();
+
+    TileFeedbackConfig config_;
+
+    std::uint32_t program_ = 0;
+    std::int32_t view_location_ = -1;
+    std::int32_t projection_location_ = -1;
+    std::int32_t min_zoom_location_ = -1;
+    std::int32_t max_zoom_location_ = -1;
+    std::int32_t lod_bias_location_ = -1;
+    std::int32_t pixel_scale_location_ = -1;
+    std::int32_t tile_size_location_ = -1;
+
+    std::uint32_t framebuffer_ = 0;
+    std::uint32_t color_texture_ = 0;
+    std::uint32_t depth_buffer_ = 0;
+    std::uint32_t target_width_ = 0;
+    std::uint32_t target_height_ = 0;
+
+    std::array<Readback, kReadbackDepth> readbacks_{};
+    std::size_t next_readback_ = 0;
+    std::uint64_t next_sequence_ = 1;
+    std::uint64_t last_collected_sequence_ = 0;
+};
+
+} // namespace earth_map
@@ -8,11 +8,23 @@
  * the TileTexturePool. Two modes:
  *
  * - Full mode (zoom 0-12): Complete GL_TEXTURE_2D of size 2^zoom x 2^zoom
- * - Windowed mode (zoom 13+): Fixed 512x512 texture with offset, centered
- *   on camera position. Tiles outside the window are not representable.
+ * - Windowed mode (zoom 13+): Fixed 512x512 texture covering a window of
+ *   tiles centered on the camera, addressed toroidally (texel = tile mod
+ *   512) so that moving the window only rewrites the rows and columns that
+ *   enter it. Tiles outside the window are not representable.
  *
- * Each texel stores a uint16 layer index, or kInvalidLayer (0xFFFF) sentinel.
- * The shader uses texelFetch with integer coordinates for O(1) lookup.
+ * The GL textures are pre-resolved: each texel stores the pool layer of the
+ * finest loaded tile among the texel's own tile and its ancestors up to
+ * kMaxAncestorDepth levels coarser, packed with how many levels up that tile
+ * is (see EncodeResolved), or kInvalidLayer (0xFFFF) if none is loaded. The
+ * shader resolves a fragment with a single texelFetch and derives the texture
+ * coordinate within the ancestor from the level delta. The tile's own layer
+ * is kept CPU-side (GetTileLayer) to resolve from.
+ *
+ * Changes are applied to CPU mirrors immediately and reach the GL textures
+ * in FlushUploads(), once per frame before drawing: dirty texels are
+ * tracked in blocks and uploaded as merged rectangles through one pixel
+ * unpack buffer.
  *
  * Thread Safety: NOT thread-safe — GL thread only.
  */
@@ -20,6 +32,7 @@
 #include <earth_map/math/tile_mathematics.h>
 #include <glm/vec2.hpp>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <unordered_map>
@@ -32,6 +45,24 @@ public:
     static constexpr int kMaxFullIndirectionZoom = 12;
     static constexpr std::uint16_t kInvalidLayer = 0xFFFF;
     static constexpr std::uint32_t kWindowSize = 512;
+    /// Edge length in texels of the blocks dirty regions are tracked in
+    static constexpr std::uint32_t kDirtyBlockSize = 64;
+
+    /// Coarsest ancestor a texel resolves to, in levels above its own zoom
+    static constexpr int kMaxAncestorDepth = 4;
+    /// Bits of a resolved entry holding the layer; the rest hold the level delta
+    static constexpr int kResolvedLayerBits = 13;
+    static constexpr std::uint16_t kResolvedLayerMask = (1u << kResolvedLayerBits) - 1u;
+    /// Largest layer index a resolved entry can address
+    static constexpr std::uint16_t kMaxLayerIndex = kResolvedLayerMask;
+
+    /**
+     * @brief Pack a layer and its level delta into a resolved entry
+     */
+    static constexpr std::uint16_t EncodeResolved(std::uint16_t layer_index, int levels_up) {
+        return static_cast<std::uint16_t>((layer_index & kResolvedLayerMask) |
+                                          (levels_up << kResolvedLayerBits));
+    }
 
     /**
      * @brief Constructor
@@ -69,6 +100,14 @@ public:
      */
     std::uint16_t GetTileLayer(const TileCoordinates& coords) const;
 
+    /**
+     * @brief Get the pre-resolved entry the shader sees for a tile
+     *
+     * @return EncodeResolved(layer, levels_up) of the finest loaded tile
+     *         covering coords, or kInvalidLayer if none / outside window
+     */
+    std::uint16_t GetResolvedEntry(const TileCoordinates& coords) const;
+
     /**
      * @brief Get GL texture ID for a zoom level
      * @return Texture ID, or 0 if not allocated
@@ -79,11 +118,18 @@ public:
      * @brief Get window offset for a zoom level
      *
      * For full mode (zoom <= 12), returns (0, 0).
-     * For windowed mode, returns the offset that the shader must subtract
-     * from tile coordinates before texelFetch.
+     * For windowed mode, returns the first tile of the window: tiles in
+     * [offset, offset + size) are representable, at texel tile mod size.
      */
     glm::ivec2 GetWindowOffset(int zoom) const;
 
+    /**
+     * @brief Get texture size in texels for a zoom level
+     *
+     * @return (0, 0) if the zoom level is not allocated
+     */
+    glm::ivec2 GetTextureSize(int zoom) const;
+
     /**
      * @brief Update window center for a windowed zoom level
      *
@@ -95,6 +141,16 @@ public:
      */
     void UpdateWindowCenter(int zoom, int center_tile_x, int center_tile_y);
 
+    /**
+     * @brief Upload every pending change to the GL textures (GL thread)
+     *
+     * Call once per frame before drawing with the indirection textures.
+     *
+     * @return Number of indirection texels in the uploaded rectangles
+     *         (counted without GL as well)
+     */
+    std::size_t FlushUploads();
+
     /**
      * @brief Get all zoom levels that have allocated indirection textures
      */
@@ -114,22 +170,59 @@ private:
         bool windowed = false;
         glm::ivec2 window_offset{0, 0};
 
-        // CPU-side mirror for skip_gl_init mode and fast reads
+        // Own layer per tile (CPU only), resolution source
         std::vector<std::uint16_t> data;
+
+        // Resolved entries, mirrored in the GL texture
+        std::vector<std::uint16_t> resolved;
+
+        // Blocks of resolved entries not yet uploaded
+        std::uint32_t blocks_x = 0;
+        std::uint32_t blocks_y = 0;
+        std::vector<std::uint8_t> dirty_blocks;
+        bool dirty = false;
+    };
+
+    /**
+     * @brief Texel rectangle queued for upload
+     */
+    struct UploadRect {
+        ZoomTexture* texture;
+        glm::ivec2 lo;
+        glm::ivec2 hi;
     };
 
     bool IsWindowedMode(int zoom) const { return zoom > kMaxFullIndirectionZoom; }
-    void CreateZoomTexture(int zoom);
+    void CreateZoomTexture(int zoom, glm::ivec2 window_offset = {0, 0});
     void ClearZoomTextureData(ZoomTexture& zt);
 
     /**
-     * @brief Shift window data by (dx, dy), preserving overlapping tiles
+     * @brief Clear own layers and re-resolve tiles [lo, hi) that entered the window
+     */
+    void ResetTiles(ZoomTexture& zt, glm::ivec2 lo, glm::ivec2 hi);
+
+    /**
+     * @brief Recompute resolved entries for tiles [lo, hi) from own and ancestor layers
      *
-     * Moves existing data so that tiles in the overlap region end up at
-     * their correct new texel positions. Newly exposed texels are set to
-     * kInvalidLayer.
+     * Tiles outside the level's window are skipped. Touched texels are
+     * marked dirty.
+     */
+    void ResolveRegion(ZoomTexture& zt, glm::ivec2 lo, glm::ivec2 hi);
+
+    /**
+     * @brief Mark texels [lo, hi) (no wrap-around) for upload
+     */
+    void MarkDirty(ZoomTexture& zt, glm::ivec2 lo, glm::ivec2 hi);
+
+    /**
+     * @brief Turn a level's dirty blocks into merged rectangles and clear them
      */
-    void ShiftWindowData(ZoomTexture& zt, int dx, int dy);
+    void CollectDirtyRects(ZoomTexture& zt, std::vector<UploadRect>& rects);
+
+    /**
+     * @brief Re-resolve the texels a tile covers at its own and finer zoom levels
+     */
+    void ResolveDescendants(const TileCoordinates& coords);
 
     /**
      * @brief Check if tile coords fall within the windowed texture
@@ -140,13 +233,17 @@ private:
      * @brief Convert tile coords to texel position in the indirection texture
      *
      * For full mode: texel = (tile_x, tile_y)
-     * For windowed mode: texel = (tile_x - offset_x, tile_y - offset_y)
+     * For windowed mode: texel = (tile_x mod width, tile_y mod height)
      */
     glm::ivec2 TileToTexel(const ZoomTexture& zt, int tile_x, int tile_y) const;
 
     std::unordered_map<int, ZoomTexture> zoom_textures_;
     bool skip_gl_init_;
     std::uint32_t dummy_texture_id_ = 0;
+
+    // Pixel unpack buffer staging FlushUploads() (orphaned every flush)
+    std::uint32_t upload_buffer_ = 0;
+    std::vector<UploadRect> upload_rects_;
 };
 
 } // namespace earth_map
@@ -0,0 +1,98 @@
+#pragma once
+
+/**
+ * @file tile_eviction_policy.h
+ * @brief Screen importance of pool tiles, for choosing eviction victims
+ *
+ * Pure LRU evicts the coarse ancestors the shader falls back to as soon as
+ * a zoom-in fills the pool with finer tiles, and the view shows holes until
+ * they are loaded again. The policy scores each tile from the last view
+ * update instead:
+ *
+ * - Ancestors of visible tiles, up to the levels the indirection textures
+ *   resolve to, are protected: they are never evicted while they back a
+ *   visible tile (at most max_protected_tiles of them, nearest levels first).
+ * - Visible tiles score above every tile that is not visible.
+ * - Other tiles score by their distance to the view focus, in tiles at
+ *   the coarser of their zoom and the focus zoom, and by how many levels
+ *   their zoom is from the focus zoom.
+ *
+ * Lower scores are evicted first; TileTexturePool breaks ties by LRU.
+ *
+ * Thread Safety: NOT thread-safe — guard with the pool's lock.
+ */
+
+#include <earth_map/core/flat_hash_map.h>
+#include <earth_map/math/tile_mathematics.h>
+#include <cstddef>
+#include <limits>
+#include <span>
+
+namespace earth_map {
+
+/**
+ * @brief Tile eviction policy configuration
+ */
+struct TileEvictionPolicyConfig {
+    /// Levels above each visible tile that are protected (the shader's fallback depth)
+    int protected_ancestor_levels = 4;
+
+    /// Most ancestors protected at once, so new tiles always find layers
+    std::size_t max_protected_tiles = 256;
+};
+
+/**
+ * @brief Scores pool tiles by screen importance
+ */
+class TileEvictionPolicy {
+public:
+    /// Score of protected tiles: never eviction candidates
+    static constexpr float kProtected = std::numeric_limits<float>::infinity();
+
+    /// Lowest score of a visible tile; other tiles score in [0, kVisibleScore)
+    static constexpr float kVisibleScore = 1.0f;
+
+    explicit TileEvictionPolicy(const TileEvictionPolicyConfig& config = {});
+
+    /**
+     * @brief Take the visible tiles and view focus of a view update
+     *
+     * @param visible Tiles selected for the view
+     * @param focus Tile under the camera at the view's zoom
+     */
+    void Update(std::span<const TileCoordinates> visible, const TileCoordinates& focus);
+
+    /**
+     * @brief Get a tile's importance (0 for every tile before the first Update())
+     */
+    float Score(const TileCoordinates& coords) const;
+
+    /**
+     * @brief Check if a tile is protected as the ancestor of a visible tile
+     */
+    bool IsProtected(const TileCoordinates& coords) const { return protected_.contains(coords); }
+
+    /**
+     * @brief Get the number of protected tiles
+     */
+    std::size_t GetProtectedCount() const { return protected_.size(); }
+
+    /**
+     * @brief Set the most ancestors protected at once (applies from the next Update())
+     */
+    void SetMaxProtectedTiles(std::size_t count) { config_.max_protected_tiles = count; }
+
+    /**
+     * @brief Get the configuration
+     */
+    const TileEvictionPolicyConfig& GetConfig() const { return config_; }
+
+private:
+    TileEvictionPolicyConfig config_;
+    TileSet visible_;
+    TileSet protected_;
+    TileCoordinates focus_{0, 0, 0};
+    bool has_focus_ = false;
+};
+
+} // namespace earth_map
@@ -4,31 +4,53 @@
  * @file tile_texture_pool.h
  * @brief GL_TEXTURE_2D_ARRAY-based tile texture pool with LRU eviction
  *
- * Manages a pool of texture layers in a GL_TEXTURE_2D_ARRAY. Each layer holds
- * one 256x256 tile. Tiles are uploaded to individual layers and evicted via LRU
- * when the pool is full. This replaces the texture atlas approach for tile
- * rendering, eliminating UV bleeding and atlas repacking costs.
+ * Manages a pool of texture layers spread over up to kMaxArrays
+ * GL_TEXTURE_2D_ARRAYs. Each layer holds one 256x256 tile. Tiles are uploaded
+ * to individual layers and evicted via LRU when the pool is full. This
+ * replaces the texture atlas approach for tile rendering, eliminating UV
+ * bleeding and atlas repacking costs.
  *
  * Design:
- * - Fixed number of layers (configurable, e.g., 512)
+ * - Layers are numbered globally: layer = array * GetLayersPerArray() +
+ *   layer within the array (layers per array is a power of two, so the
+ *   shader splits the index with a shift)
+ * - A layer budget (SetBudgetLayers) bounds how many layers may be occupied.
+ *   Arrays are allocated as occupancy grows into the budget and released
+ *   once a lower budget leaves them empty; GetEvictionCandidate() then
+ *   prefers tiles in the arrays being released
  * - Each layer = one tile at full [0,1] UV range
- * - Upload via glTexSubImage3D (per-layer, no impact on other tiles)
- * - LRU eviction when pool is full
+ * - Upload via glTexSubImage3D (per-layer, no impact on other tiles),
+ *   from client memory or from a pixel unpack buffer
+ * - Optional BC1 block-compressed layers (TileTextureFormat::BC1): tiles
+ *   arrive pre-compressed from the decode threads and are uploaded with
+ *   glCompressedTexSubImage3D, at an eighth of the RGBA8 memory
+ * - Eviction when the budget is used up (by the caller), in batches of the
+ *   least important tiles (GetEvictionCandidates with a TileImportanceFn,
+ *   see TileEvictionPolicy), least recently used first among equals;
+ *   pinned tiles (PinTile) are never eviction candidates
  * - Thread safety: GL thread only (same as TextureAtlasManager)
  */
 
+#include <earth_map/core/flat_hash_map.h>
 #include <earth_map/math/tile_mathematics.h>
+#include <earth_map/renderer/texture_atlas/tile_block_compressor.h>
 #include <chrono>
 #include <cstdint>
+#include <array>
+#include <functional>
 #include <list>
 #include <memory>
 #include <optional>
-#include <queue>
-#include <unordered_map>
+#include <set>
 #include <vector>
 
 namespace earth_map {
 
+/**
+ * @brief Importance of a pool tile: lower is evicted first, infinity never
+ */
+using TileImportanceFn = std::function<float(const TileCoordinates&)>;
+
 /**
  * @brief Tile texture pool using GL_TEXTURE_2D_ARRAY
  *
@@ -39,19 +61,31 @@ namespace earth_map {
  */
 class TileTexturePool {
 public:
+    /// Texture arrays the layers are spread over (one sampler each in the shader)
+    static constexpr std::size_t kMaxArrays = 8;
+    /// Arrays are allocated in multiples of this many layers (up to a full array)
+    static constexpr std::uint32_t kArrayGrowthLayers = 64;
+
     /**
      * @brief Constructor
      *
      * @param tile_size Tile dimensions in pixels (tiles are square)
-     * @param max_layers Maximum number of layers in the texture array
-     * It means 'how many tiles can be stored in GPU VRAM before LRU eviction.
+     * @param max_layers Maximum number of layers over all arrays, and the
+     * initial budget. It means 'how many tiles can be stored in GPU VRAM before LRU eviction.
      * To calculate GPU VRAM usage: 256×256×4×512 (tile_width * tile_height * channels * max_layers) = 128 MB
+     * (16 MB with BC1). Only the arrays the occupied layers need are allocated.
      * @param skip_gl_init Skip OpenGL initialization (for testing)
+     * @param format Layer format; BC1 falls back to RGBA8 when the driver
+     *        lacks S3TC support (check GetFormat())
+     * @param mip_levels Mip levels per layer, clamped to the full chain
+     *        (TileMipChain::GetMaxLevels); each adds a quarter of the level above
      */
     explicit TileTexturePool(
         std::uint32_t tile_size = 256,
         std::uint32_t max_layers = 512,
-        bool skip_gl_init = false);
+        bool skip_gl_init = false,
+        TileTextureFormat format = TileTextureFormat::RGBA8,
+        std::uint32_t mip_levels = 1);
 
     ~TileTexturePool();
 
@@ -66,6 +100,10 @@ public:
      * If the tile already exists, updates in place. If the pool is full,
      * evicts the LRU tile.
      *
+     * @param format Format of @p pixel_data; must match GetFormat()
+     *        (channels is only checked for RGBA8)
+     * @param mip_levels Levels in @p pixel_data, laid out as a TileMipChain;
+     *        must match GetMipLevels()
      * @return Layer index (0 to max_layers-1), or -1 on failure
      */
     int UploadTile(
@@ -73,7 +111,28 @@ public:
         const std::uint8_t* pixel_data,
         std::uint32_t width,
         std::uint32_t height,
-        std::uint8_t channels);
+        std::uint8_t channels,
+        TileTextureFormat format = TileTextureFormat::RGBA8,
+        std::uint32_t mip_levels = 1);
+
+    /**
+     * @brief Upload tile pixels from a pixel unpack buffer to a layer
+     *
+     * Same as UploadTile(), but the pixels are read by the GPU from
+     * @p buffer_id (bound as GL_PIXEL_UNPACK_BUFFER) at @p offset instead of
+     * being copied from client memory.
+     *
+     * @return Layer index (0 to max_layers-1), or -1 on failure
+     */
+    int UploadTileFromBuffer(
+        const TileCoordinates& coords,
+        std::uint32_t buffer_id,
+        std::size_t offset,
+        std::uint32_t width,
+        std::uint32_t height,
+        std::uint8_t channels,
+        TileTextureFormat format = TileTextureFormat::RGBA8,
+        std::uint32_t mip_levels = 1);
 
     /**
      * @brief Evict a tile from the pool
@@ -101,20 +160,102 @@ public:
      */
     void TouchTile(const TileCoordinates& coords);
 
-    /** @brief Get OpenGL texture array ID (0 if GL not initialized) */
-    std::uint32_t GetTextureArrayID() const { return texture_array_id_; }
+    /**
+     * @brief Keep a loaded tile resident: it is never returned by GetEvictionCandidate()
+     *
+     * EvictTile() still removes it. No-op if the tile is not loaded.
+     */
+    void PinTile(const TileCoordinates& coords);
+
+    /**
+     * @brief Check if a tile is pinned
+     */
+    bool IsTilePinned(const TileCoordinates& coords) const;
+
+    /**
+     * @brief Get the number of pinned tiles
+     */
+    std::size_t GetPinnedCount() const { return pinned_count_; }
+
+    /**
+     * @brief Get OpenGL texture ID of an array (0 if not allocated or GL not initialized)
+     */
+    std::uint32_t GetTextureArrayID(std::size_t array = 0) const {
+        return array < arrays_.size() ? arrays_[array].texture_id : 0;
+    }
 
     /** @brief Get maximum number of layers */
     std::uint32_t GetMaxLayers() const { return max_layers_; }
 
+    /** @brief Get layers per texture array (power of two) */
+    std::uint32_t GetLayersPerArray() const { return layers_per_array_; }
+
+    /** @brief Get number of texture arrays currently allocated */
+    std::size_t GetAllocatedArrayCount() const;
+
+    /** @brief Get number of layers currently allocated over all arrays */
+    std::uint32_t GetAllocatedLayers() const { return allocated_layers_; }
+
+    /** @brief Get bytes one layer takes in VRAM */
+    std::size_t GetLayerBytes() const;
+
+    /**
+     * @brief Set how many layers may be occupied
+     *
+     * Clamped to [1, GetMaxLayers()]. Lowering the budget does not evict:
+     * while IsOverBudget() the caller evicts GetEvictionCandidate() tiles,
+     * and arrays beyond the budget are released once empty.
+     */
+    void SetBudgetLayers(std::uint32_t layers);
+
+    /** @brief Get the layer budget */
+    std::uint32_t GetBudgetLayers() const { return budget_layers_; }
+
+    /**
+     * @brief Check whether tiles must be evicted to honor the budget
+     *
+     * True if more layers are occupied than the budget allows, or if tiles
+     * still occupy arrays the budget no longer needs.
+     */
+    bool IsOverBudget() const;
+
+    /**
+     * @brief Query free video memory from the driver (GL thread)
+     *
+     * Uses GL_NVX_gpu_memory_info or GL_ATI_meminfo.
+     *
+     * @return Free VRAM in bytes, or 0 if the driver does not report it
+     */
+    static std::size_t QueryAvailableVideoMemory();
+
     /** @brief Get tile size in pixels */
     std::uint32_t GetTileSize() const { return tile_size_; }
 
+    /** @brief Get the format layers are stored (and uploads expected) in */
+    TileTextureFormat GetFormat() const { return format_; }
+
+    /** @brief Get mip levels per layer */
+    std::uint32_t GetMipLevels() const { return mip_levels_; }
+
+    /**
+     * @brief Set the maximum anisotropy for sampling the pool
+     *
+     * Applies to allocated and future arrays. Clamped to the driver maximum;
+     * 1 disables anisotropic filtering. No-op without
+     * GL_EXT_texture_filter_anisotropic.
+     */
+    void SetMaxAnisotropy(float anisotropy);
+
+    /** @brief Get the maximum anisotropy applied to the arrays */
+    float GetMaxAnisotropy() const { return max_anisotropy_; }
+
     /** @brief Get number of occupied layers */
     std::size_t GetOccupiedLayers() const { return coord_to_layer_.size(); }
 
-    /** @brief Get number of free layers */
-    std::size_t GetFreeLayers() const { return free_layers_.size(); }
+    /** @brief Get number of layers that can be occupied before the budget is used up */
+    std::size_t GetFreeLayers() const {
+        return coord_to_layer_.size() < budget_layers_ ? budget_layers_ - coord_to_layer_.size() : 0;
+    }
 
     /**
      * @brief Get the last-used timestamp for a tile
@@ -127,20 +268,37 @@ public:
     /**
      * @brief Get the LRU eviction candidate
      *
-     * Returns the coordinates of the least-recently-used tile in the pool.
-     * Does NOT evict — the caller must call EvictTile() explicitly.
+     * Returns the coordinates of the least-recently-used tile in the pool,
+     * or of the least-recently-used tile in an array beyond the budget if
+     * there is one. Does NOT evict — the caller must call EvictTile() explicitly.
      *
      * @return Tile coordinates, or nullopt if pool is empty
      */
     std::optional<TileCoordinates> GetEvictionCandidate() const;
 
+    /**
+     * @brief Get a batch of eviction candidates, least important first
+     *
+     * Tiles in arrays beyond the budget come first, then tiles by ascending
+     * @p importance, least recently used first among equal scores. Pinned
+     * tiles and tiles of infinite importance are never returned. Does NOT
+     * evict.
+     *
+     * @param count Most candidates to return
+     * @param importance Tile scores (null = pure LRU)
+     * @return Up to @p count distinct tile coordinates
+     */
+    std::vector<TileCoordinates> GetEvictionCandidates(
+        std::size_t count, const TileImportanceFn& importance = {}) const;
+
 private:
     struct LayerSlot {
         TileCoordinates coords;
         bool occupied = false;
+        bool pinned = false;  ///< Not in lru_order_
         std::chrono::steady_clock::time_point last_used;
         int layer_index = -1;
-        /// Iterator into lru_order_ for O(1) splice/erase. Valid only when occupied.
+        /// Iterator into lru_order_ for O(1) splice/erase. Valid only when occupied and not pinned.
         std::list<int>::iterator lru_it;
 
         LayerSlot() = default;
@@ -148,21 +306,68 @@ private:
             : last_used(std::chrono::steady_clock::now()), layer_index(index) {}
     };
 
-    void CreateTextureArray();
+    /**
+     * @brief One GL_TEXTURE_2D_ARRAY holding layers [index * layers_per_array_, + depth)
+     */
+    struct ArrayPage {
+        std::uint32_t texture_id = 0;
+        std::uint32_t depth = 0;      ///< Allocated layers (0 = not allocated)
+        std::uint32_t occupied = 0;   ///< Occupied layers
+    };
+
+    void AllocateArray(std::size_t array, std::uint32_t depth);
+    void ReleaseArray(std::size_t array);
+    void ApplyAnisotropy(std::uint32_t texture_id) const;
+
+    /**
+     * @brief Allocate or enlarge an array so that a free layer exists
+     *
+     * @return true if free layers were added
+     */
+    bool Grow();
+
+    /**
+     * @brief Index of the first array the budget does not need (kMaxArrays if none)
+     */
+    std::size_t FirstExcessArray() const;
+
+    /**
+     * @brief Release empty arrays beyond the budget
+     */
+    void ReleaseExcessArrays();
+    int UploadLayer(
+        const TileCoordinates& coords,
+        const void* pixels,
+        std::uint32_t unpack_buffer,
+        std::uint32_t width,
+        std::uint32_t height,
+        std::uint8_t channels,
+        TileTextureFormat format,
+        std::uint32_t mip_levels);
     int AllocateLayer();
     void FreeLayer(int layer_index);
 
-    std::uint32_t texture_array_id_ = 0;
     std::uint32_t tile_size_;
     std::uint32_t max_layers_;
+    std::uint32_t layers_per_array_ = 1;
+    std::uint32_t budget_layers_;
+    std::uint32_t allocated_layers_ = 0;
     bool skip_gl_init_;
+    TileTextureFormat format_;
+    std::uint32_t mip_levels_;
+    float max_anisotropy_ = 1.0f;
 
+    std::array<ArrayPage, kMaxArrays> arrays_{};
     std::vector<LayerSlot> layers_;
-    std::queue<int> free_layers_;
-    std::unordered_map<TileCoordinates, int, TileCoordinatesHash> coord_to_layer_;
+    /// Free layers of allocated arrays; lowest first so tiles pack into low arrays
+    std::set<int> free_layers_;
+    TileMap<int> coord_to_layer_;
 
     /// LRU order: front = most recently used, back = eviction candidate
     std::list<int> lru_order_;
+
+    /// Occupied layers left out of lru_order_
+    std::size_t pinned_count_ = 0;
 };
 
 } // namespace earth_map
@@ -0,0 +1,175 @@
+#pragma once
+
+/**
+ * @file tile_prefetcher.h
+ * @brief Predictive tile prefetching from camera motion
+ *
+ * The visible-tile pass only requests what is on screen now, so a pan
+ * shows fallback tiles until the new ones arrive. The prefetcher
+ * extrapolates the camera trajectory (from its velocity, or towards a known
+ * fly-to destination) and selects tiles around the predicted positions,
+ * plus the parent and child zoom levels of the current view, for
+ * low-priority requests ahead of time.
+ *
+ * Speculative requests are bounded by a bandwidth budget (new tiles per
+ * second, token bucket) and a memory budget (decoded size of the
+ * prefetched working set). Tiles already admitted stay in the working set
+ * without further cost while they remain predicted.
+ */
+
+#include <earth_map/math/tile_mathematics.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <span>
+#include <unordered_set>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Tile prefetch configuration
+ */
+struct TilePrefetchConfig {
+    bool enabled = true;                          ///< Enable prefetch requests
+    float lookahead_seconds = 0.75f;              ///< How far ahead the trajectory is extrapolated
+    std::uint32_t lookahead_samples = 3;          ///< Predicted positions along the lookahead
+    float min_speed = 1e-4f;                      ///< Below this (globe radii / s) the camera is treated as still
+    std::int32_t ring_radius = 2;                 ///< Tiles around each predicted center (half window)
+    bool prefetch_parent_level = true;            ///< Prefetch parents of the visible tiles
+    bool prefetch_child_level = true;             ///< Prefetch children of the tiles around the view center
+    std::uint32_t max_tiles_per_second = 64;      ///< Bandwidth budget for newly admitted tiles
+    std::size_t memory_budget_bytes = 32 * 1024 * 1024;  ///< Decoded size budget of the prefetched set
+    std::size_t tile_bytes = 256 * 256 * 4;       ///< Decoded size of one tile (RGBA8)
+};
+
+/**
+ * @brief Tile prefetch statistics
+ */
+struct TilePrefetchStats {
+    /** Tiles in the prefetched working set after the last update */
+    std::size_t active_tiles = 0;
+
+    /** Tiles admitted into the working set (cumulative) */
+    std::uint64_t admitted_tiles = 0;
+
+    /** Candidate tiles deferred by the bandwidth or memory budget (cumulative) */
+    std::uint64_t deferred_tiles = 0;
+};
+
+/**
+ * @brief Selects tiles about to enter the view
+ *
+ * Pure CPU logic with no GL or loader dependencies: the tile renderer feeds
+ * it the camera state once per visible-tile update and requests the
+ * returned tiles at a lower priority than the visible ones.
+ *
+ * Thread Safety: not thread-safe; call from the render thread.
+ */
+class TilePrefetcher {
+public:
+    /// Maps camera distance from the globe center to a zoom level
+    using ZoomFunction = std::function<int(float camera_distance)>;
+
+    /**
+     * @brief Construct a prefetcher
+     *
+     * @param config Prefetch configuration
+     * @param zoom_for_distance Zoom selection matching the visible-tile pass
+     * @throws std::invalid_argument if zoom_for_distance is empty
+     */
+    TilePrefetcher(const TilePrefetchConfig& config, ZoomFunction zoom_for_distance);
+
+    // Non-copyable
+    TilePrefetcher(const TilePrefetcher&) = delete;
+    TilePrefetcher& operator=(const TilePrefetcher&) = delete;
+
+    /**
+     * @brief Set a known camera destination (e.g. from a fly-to)
+     *
+     * While set, positions are predicted along the path to the destination
+     * instead of from velocity, and the destination footprint is prefetched.
+     * Cleared once the camera arrives or the duration has elapsed.
+     *
+     * @param position Destination camera position in world space
+     * @param duration_seconds Expected travel time (0 for an immediate jump)
+     */
+    void SetDestination(const glm::vec3& position, float duration_seconds);
+
+    /**
+     * @brief Forget the destination and return to velocity extrapolation
+     */
+    void ClearDestination();
+
+    /**
+     * @brief Check whether a destination is set
+     */
+    bool HasDestination() const { return destination_.has_value(); }
+
+    /**
+     * @brief Select tiles to prefetch for this update
+     *
+     * @param camera_position Camera position in world space
+     * @param velocity Camera velocity in world units per second
+     * @param delta_time Seconds since the previous update
+     * @param visible_tiles Tiles requested by the visible pass (never returned)
+     * @return Tiles to request, most urgent first
+     */
+    std::vector<TileCoordinates> Update(const glm::vec3& camera_position,
+                                        const glm::vec3& velocity, float delta_time,
+                                        std::span<const TileCoordinates> visible_tiles);
+
+    /**
+     * @brief Drop the working set and budget state (e.g. after a cache clear)
+     */
+    void Reset();
+
+    /**
+     * @brief Get prefetch configuration
+     */
+    const TilePrefetchConfig& GetConfig() const { return config_; }
+
+    /**
+     * @brief Update prefetch configuration
+     */
+    void SetConfig(const TilePrefetchConfig& config);
+
+    /**
+     * @brief Get prefetch statistics
+     */
+    TilePrefetchStats GetStats() const { return stats_; }
+
+    /**
+     * @brief Tile under a world-space camera position
+     *
+     * @param position Camera position in world space (globe centered at origin)
+     * @param zoom Zoom level
+     * @return TileCoordinates Tile directly below the camera
+     */
+    static TileCoordinates WorldToTile(const glm::vec3& position, std::int32_t zoom);
+
+private:
+    struct Destination {
+        glm::vec3 position{0.0f};
+        float remaining_seconds = 0.0f;
+    };
+
+    using TileSet = std::unordered_set<TileCoordinates, TileCoordinatesHash>;
+
+    std::vector<glm::vec3> PredictPositions(const glm::vec3& camera_position,
+                                            const glm::vec3& velocity) const;
+    void AddRing(const TileCoordinates& center, std::int32_t ring, const TileSet& visible,
+                 TileSet& seen, std::vector<TileCoordinates>& candidates) const;
+    std::size_t GetMaxActiveTiles() const;
+
+    TilePrefetchConfig config_;
+    ZoomFunction zoom_for_distance_;
+    std::optional<Destination> destination_;
+    TileSet active_tiles_;
+    double bandwidth_tokens_ = 0.0;
+    TilePrefetchStats stats_;
+};
+
+} // namespace earth_map
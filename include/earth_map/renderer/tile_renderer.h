@@ -11,6 +11,11 @@
 #include <earth_map/math/tile_mathematics.h>
 #include <earth_map/data/tile_manager.h>
 #include <earth_map/math/frustum.h>
+#include <earth_map/renderer/frame_snapshot.h>
+#include <earth_map/renderer/tile_feedback_pass.h>
+#include <earth_map/renderer/tile_prefetcher.h>
+#include <earth_map/renderer/tile_selector.h>
+#include <earth_map/renderer/terrain_patch.h>
 #include <glm/glm.hpp>
 #include <memory>
 #include <vector>
@@ -22,6 +27,10 @@ namespace earth_map {
 class TileManager;
 class TileTextureCoordinator;
 class GlobeMesh;
+class GPUResourceManager;
+class ElevationManager;
+class GpuFrameProfiler;
+class TileRequestMerger;
 struct Frustum;
 
 /**
@@ -30,6 +39,9 @@ struct Frustum;
 struct TileRenderStats {
     /** Number of tiles currently visible */
     std::size_t visible_tiles = 0;
+
+    /** Visible tiles whose textures are loaded */
+    std::size_t ready_tiles = 0;
     
     /** Number of tiles successfully rendered */
     std::size_t rendered_tiles = 0;
@@ -45,6 +57,27 @@ struct TileRenderStats {
     
     /** Tile rendering time in milliseconds */
     float render_time_ms = 0.0f;
+
+    /** Tile texture uploads per second (measured over about one second) */
+    float uploads_per_second = 0.0f;
+
+    /** Frames whose tile uploads exceeded the upload budget (cumulative) */
+    std::uint64_t upload_budget_overruns = 0;
+
+    /** Tiles requested ahead of the view by the prefetcher this update */
+    std::size_t prefetch_tiles = 0;
+
+    /** Prefetch candidates deferred by the bandwidth or memory budget (cumulative) */
+    std::uint64_t prefetch_deferred_tiles = 0;
+
+    /** Coarsest zoom among visible tiles */
+    std::int32_t coarsest_visible_zoom = 0;
+
+    /** Finest zoom among visible tiles */
+    std::int32_t finest_visible_zoom = 0;
+
+    /** Terrain patches submitted this frame (0 when the globe mesh is drawn; GPU culling may drop some) */
+    std::size_t terrain_patches = 0;
 };
 
 /**
@@ -56,6 +89,13 @@ struct TileRenderConfig {
     bool enable_lod_transitions = true;           ///< Enable smooth LOD transitions
     float min_lod_distance = 100.0f;          ///< Minimum distance for LOD switching
     float max_lod_distance = 10000.0f;         ///< Maximum distance for LOD switching
+    std::uint32_t upload_budget_us = 2000;     ///< Time per frame spent on tile texture uploads
+    TilePrefetchConfig prefetch;               ///< Predictive prefetch of tiles about to become visible
+    TileSelectionConfig selection;             ///< Per-tile zoom selection by screen-space error
+    TileFeedbackConfig feedback;               ///< GPU-reported visible tiles (overrides selection)
+    TerrainConfig terrain;                     ///< Per-tile patches displaced on the GPU instead of the globe mesh
+    bool async_selection = true;               ///< Select tiles on a worker while uploads run (BeginTileSelection)
+    bool process_uploads = true;               ///< BeginFrame() runs the coordinator's uploads (one view per coordinator)
 };
 
 /**
@@ -74,6 +114,20 @@ public:
      */
     static std::unique_ptr<TileRenderer> Create(const TileRenderConfig& config = TileRenderConfig{});
     
+    /** Coarser zoom levels the tile shader falls back through for a tile not yet loaded */
+    static constexpr int kMaxFallbackLevels = 5;
+    
+    /** Request priority added to prefetched tiles so they queue behind every visible tile */
+    static constexpr int kPrefetchPriorityOffset = 1000;
+    
+    /**
+     * @brief Zoom level streamed for a camera at a distance from the globe center
+     * 
+     * @param camera_distance Distance from the center in globe radii
+     * @return Zoom level in [0, 21]
+     */
+    static int ZoomForCameraDistance(float camera_distance);
+    
     /**
      * @brief Virtual destructor
      */
@@ -116,16 +170,79 @@ public:
      */
     virtual void SetTextureCoordinator(TileTextureCoordinator* coordinator) = 0;
 
+    /**
+     * @brief Route tile requests through a merger shared with other views
+     *
+     * While set, UpdateVisibleTiles() submits its visible and prefetch tiles
+     * to @p merger instead of opening a request generation of its own; the
+     * merger's owner flushes it once per frame.
+     *
+     * @param merger Request merger (non-owning, null to request directly)
+     * @param weight Priority weight of this view (> 0, higher loads first)
+     * @throws std::invalid_argument if weight is not positive
+     */
+    virtual void SetRequestMerger(TileRequestMerger* merger, float weight = 1.0f) = 0;
+
     /**
      * @brief Set globe mesh to render tiles on
      *
      * CRITICAL: Tile renderer MUST use the provided mesh geometry, not generate its own.
      * This ensures tiles are rendered on the actual displaced geometry with elevation data.
+     * With terrain patches enabled the mesh is only drawn until the first
+     * tiles are selected, and by the tile feedback pass.
      *
      * @param globe_mesh Pointer to globe mesh (non-owning)
      */
     virtual void SetGlobeMesh(GlobeMesh* globe_mesh) = 0;
 
+    /**
+     * @brief Share the renderer's GPU mesh buffers
+     *
+     * The globe mesh is synced to the GPU through this manager each frame.
+     * Without one, the tile renderer keeps a manager of its own.
+     *
+     * @param manager Pointer to GPU resource manager (non-owning, may be null)
+     */
+    virtual void SetGPUResourceManager(GPUResourceManager* manager) = 0;
+
+    /**
+     * @brief Set the elevation source displacing terrain patches
+     *
+     * Only used with TerrainConfig::enabled; without a manager (or while it
+     * is disabled) the patches are flat.
+     *
+     * @param manager Pointer to elevation manager (non-owning, may be null)
+     */
+    virtual void SetElevationManager(ElevationManager* manager) = 0;
+
+    /**
+     * @brief Time the upload, indirection, globe and feedback passes
+     *
+     * @param profiler Frame profiler of the owning renderer (non-owning, may be null)
+     */
+    virtual void SetFrameProfiler(GpuFrameProfiler* profiler) = 0;
+
+    /**
+     * @brief Set the viewport size used to measure screen-space error
+     *
+     * @param width Viewport width in pixels
+     * @param height Viewport height in pixels
+     */
+    virtual void SetViewportSize(std::uint32_t width, std::uint32_t height) = 0;
+
+    /**
+     * @brief Start CPU tile selection for the coming frame on a worker thread
+     *
+     * Call before BeginFrame() so the selection overlaps the frame's texture
+     * uploads. UpdateVisibleTiles() with the same camera waits for and uses
+     * the result; with a different camera it selects on the calling thread.
+     * Does nothing while GPU feedback drives selection or when
+     * TileRenderConfig::async_selection is off.
+     *
+     * @param snapshot Camera state of the coming frame
+     */
+    virtual void BeginTileSelection(const FrameSnapshot& snapshot) = 0;
+
     /**
      * @brief Update visible tiles based on camera position
      * 
@@ -139,6 +256,23 @@ public:
                                 const glm::vec3& camera_position,
                                 const Frustum& frustum) = 0;
     
+    /**
+     * @brief Set the camera velocity used to predict upcoming tiles
+     *
+     * Call before UpdateVisibleTiles() each frame.
+     *
+     * @param velocity Camera velocity in world units per second
+     */
+    virtual void SetCameraVelocity(const glm::vec3& velocity) = 0;
+
+    /**
+     * @brief Prefetch tiles along the path to a known camera destination
+     *
+     * @param destination Destination camera position in world space
+     * @param duration_seconds Expected travel time (0 for an immediate jump)
+     */
+    virtual void PrefetchDestination(const glm::vec3& destination, float duration_seconds) = 0;
+
     /**
      * @brief Render all visible tiles
      * 
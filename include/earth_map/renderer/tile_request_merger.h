@@ -0,0 +1,110 @@
+#pragma once
+
+/**
+ * @file tile_request_merger.h
+ * @brief Per-frame merge of the tile requests of several views
+ *
+ * Each TileTextureCoordinator request generation drops queued loads that
+ * were not requested again, so views sharing a coordinator cannot each
+ * open their own generation: the last view would cancel the others'
+ * tiles. The views instead submit their visible and prefetch tiles here,
+ * and Flush() issues them once per frame as one generation. A tile wanted
+ * by several views is requested once, at the best priority any of them
+ * gave it after scaling by the view's weight.
+ */
+
+#include <earth_map/math/tile_mathematics.h>
+#include <earth_map/core/flat_hash_map.h>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace earth_map {
+
+class TileTextureCoordinator;
+
+/**
+ * @brief One merged tile request
+ */
+struct MergedTileRequest {
+    TileCoordinates coords;  ///< Tile
+    int priority = 0;        ///< Best weighted priority (lower loads first)
+};
+
+/**
+ * @brief Tile request merge statistics
+ */
+struct TileRequestMergeStats {
+    /** Tiles submitted for the last flushed frame, duplicates included */
+    std::size_t submitted_tiles = 0;
+
+    /** Distinct tiles requested by the last flush */
+    std::size_t unique_tiles = 0;
+
+    /** Requests saved by merging (cumulative) */
+    std::uint64_t merged_duplicates = 0;
+};
+
+/**
+ * @brief Collects the frame's tile requests of all views sharing a coordinator
+ *
+ * Thread Safety: not thread-safe; submit and flush from the thread that
+ * renders the views.
+ */
+class TileRequestMerger {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param coordinator Coordinator Flush() requests from (non-owning, may be null)
+     */
+    explicit TileRequestMerger(TileTextureCoordinator* coordinator = nullptr);
+
+    /**
+     * @brief Set the coordinator Flush() requests from (non-owning, may be null)
+     */
+    void SetCoordinator(TileTextureCoordinator* coordinator) { coordinator_ = coordinator; }
+
+    /**
+     * @brief Add tiles a view wants this frame
+     *
+     * @param tiles Tiles to request
+     * @param priority View-local priority (lower loads first)
+     * @param weight View priority weight; the priority is divided by it,
+     *        so a view of weight 2 outranks one of weight 1 at equal distance
+     * @throws std::invalid_argument if weight is not positive
+     */
+    void Submit(std::span<const TileCoordinates> tiles, int priority, float weight = 1.0f);
+
+    /**
+     * @brief Take the frame's requests, deduplicated, lowest priority first
+     *
+     * Clears the submitted requests. Flush() issues the same list.
+     */
+    std::vector<MergedTileRequest> TakeMerged();
+
+    /**
+     * @brief Issue the frame's requests as one request generation
+     *
+     * Opens a generation, requests the merged tiles grouped by priority and
+     * cancels queued loads no view asked for. Without a coordinator the
+     * requests are discarded.
+     *
+     * @return Number of distinct tiles requested
+     */
+    std::size_t Flush();
+
+    /**
+     * @brief Get statistics
+     */
+    TileRequestMergeStats GetStats() const { return stats_; }
+
+private:
+    TileTextureCoordinator* coordinator_ = nullptr;
+    TileMap<int> best_priority_;      ///< Frame's requests, reused across frames
+    std::size_t submitted_tiles_ = 0; ///< Submitted since the last take
+    TileRequestMergeStats stats_;
+};
+
+} // namespace earth_map
@@ -0,0 +1,109 @@
+#pragma once
+
+/**
+ * @file tile_selection_worker.h
+ * @brief CPU tile selection for the coming frame on a persistent thread
+ *
+ * The tile renderer starts the selection from a FrameSnapshot before the
+ * frame's texture uploads and collects it in UpdateVisibleTiles(). The
+ * thread lives as long as the renderer, so a frame costs one wake-up
+ * instead of a thread start. The result is only used when the camera
+ * UpdateVisibleTiles() is called with is the one the selection started
+ * from; otherwise the caller selects inline.
+ */
+
+#include <earth_map/math/tile_mathematics.h>
+#include <earth_map/renderer/frame_snapshot.h>
+#include <glm/glm.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Runs one tile selection at a time on its own thread
+ *
+ * Thread Safety: all methods are called from the render thread. Between
+ * Start() and the next Wait() the select function runs on the worker and
+ * must not race with state the render thread changes.
+ */
+class TileSelectionWorker {
+public:
+    /// Selects the tiles covering @p snapshot's view at @p zoom_level into @p tiles
+    using SelectFn = std::function<void(const FrameSnapshot& snapshot, int zoom_level,
+                                        std::pmr::vector<TileCoordinates>& tiles)>;
+
+    /**
+     * @brief Constructor (starts the thread)
+     *
+     * @param select Selection function (must not be empty)
+     * @throws std::invalid_argument if select is empty
+     */
+    explicit TileSelectionWorker(SelectFn select);
+
+    /**
+     * @brief Destructor: waits for a running selection, then stops the thread
+     */
+    ~TileSelectionWorker();
+
+    // Non-copyable
+    TileSelectionWorker(const TileSelectionWorker&) = delete;
+    TileSelectionWorker& operator=(const TileSelectionWorker&) = delete;
+
+    /**
+     * @brief Start selecting for @p snapshot (waits for the previous selection first)
+     */
+    void Start(const FrameSnapshot& snapshot, int zoom_level);
+
+    /**
+     * @brief Block until the started selection, if any, has finished
+     */
+    void Wait();
+
+    /**
+     * @brief Check whether a selection was started and not yet taken or discarded
+     */
+    bool HasSelection() const { return has_selection_; }
+
+    /**
+     * @brief Wait for the selection and take it if it was made for this camera
+     *
+     * The selection is consumed either way, so a later call returns null
+     * until the next Start().
+     *
+     * @return Selected tiles (valid until the next Start()), or null when no
+     *         selection was started or its snapshot differs from the camera
+     */
+    const std::pmr::vector<TileCoordinates>* Take(const glm::mat4& view,
+                                                  const glm::mat4& projection,
+                                                  const glm::vec3& camera_position);
+
+    /**
+     * @brief Get number of selections the worker has run
+     */
+    std::uint64_t GetRunCount() const;
+
+private:
+    void Run();
+
+    SelectFn select_;
+    FrameSnapshot snapshot_;
+    int zoom_level_ = 0;
+    std::pmr::vector<TileCoordinates> selected_;  // Reused across frames
+    bool has_selection_ = false;                  // Render thread only
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool requested_ = false;
+    bool running_ = false;
+    bool stop_ = false;
+    std::uint64_t run_count_ = 0;
+    std::thread thread_;
+};
+
+} // namespace earth_map
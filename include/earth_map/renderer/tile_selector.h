@@ -0,0 +1,242 @@
+#pragma once
+
+/**
+ * @file tile_selector.h
+ * @brief Screen-space-error driven mixed-zoom tile selection
+ *
+ * Loading one zoom level across the whole view spends most of the tile
+ * budget near the horizon of a tilted view, where tiles cover few pixels.
+ * The selector refines the tile quadtree from zoom 0 and gives each visible
+ * tile its own zoom: a tile is split while one of its texels would cover
+ * more than max_texel_error screen pixels at the tile's nearest point, so
+ * far tiles stay coarse and near tiles reach the camera's zoom.
+ *
+ * Selected zooms are kept within max_zoom_span levels of the finest one so
+ * the tile shader's indirection fallback chain (which walks down from the
+ * finest zoom) reaches every selected tile.
+ *
+ * Whole subtrees are culled during the descent: against the frustum with
+ * the tile's bounding sphere, and against the globe's horizon with the
+ * tile's horizon occlusion point, so the cost scales with the number of
+ * visible tiles rather than with the area of a geographic bounding box.
+ */
+
+#include <earth_map/coordinates/coordinate_mapper.h>
+#include <earth_map/math/frustum.h>
+#include <earth_map/math/tile_mathematics.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace earth_map {
+
+/**
+ * @brief Mixed-zoom tile selection configuration
+ */
+struct TileSelectionConfig {
+    bool enabled = true;                 ///< Pick each tile's zoom by screen-space error (false: one zoom for the view)
+    float max_texel_error = 1.0f;        ///< Split a tile while one texel covers more screen pixels than this
+    std::uint32_t tile_size = 256;       ///< Tile edge length in texels
+    std::int32_t max_zoom_span = 4;      ///< Levels between the finest and the coarsest selected tile
+    bool horizon_culling = true;         ///< Reject tiles hidden behind the globe
+    float occluder_radius = 1.0f;        ///< Globe radius used as the horizon occluder (world units)
+};
+
+/**
+ * @brief Mixed-zoom tile selection statistics (last Select() call)
+ */
+struct TileSelectionStats {
+    /** Quadtree nodes visited */
+    std::size_t visited_nodes = 0;
+
+    /** Nodes rejected by the frustum */
+    std::size_t culled_nodes = 0;
+
+    /** Nodes rejected as hidden behind the horizon */
+    std::size_t horizon_culled_nodes = 0;
+
+    /** Coarsest selected zoom */
+    std::int32_t coarsest_zoom = 0;
+
+    /** Finest selected zoom */
+    std::int32_t finest_zoom = 0;
+
+    /** Whether the tile budget stopped refinement early */
+    bool budget_limited = false;
+};
+
+/**
+ * @brief Selects visible tiles with per-tile zoom levels
+ *
+ * Pure CPU logic with no GL or loader dependencies.
+ *
+ * Thread Safety: not thread-safe; call from the render thread.
+ */
+class TileSelector {
+public:
+    /**
+     * @brief Bounding sphere of a tile's patch of the unit globe
+     */
+    struct TileBound {
+        glm::vec3 center{0.0f};
+        float radius = 0.0f;
+
+        /**
+         * Horizon occlusion point, scaled by 1 / occluder radius: if it is
+         * below the horizon, so is the whole tile. Not available for tiles
+         * too large to have one (about a hemisphere).
+         */
+        glm::vec3 horizon_point{0.0f};
+        bool has_horizon_point = false;
+    };
+
+    /**
+     * @brief Construct a selector
+     *
+     * @param config Selection configuration
+     */
+    explicit TileSelector(const TileSelectionConfig& config = TileSelectionConfig{});
+
+    /**
+     * @brief Select visible tiles, each at the zoom its screen-space error needs
+     *
+     * @param camera_position Camera position in world space (globe radius 1)
+     * @param frustum Camera frustum
+     * @param focal_length_px Pixels per unit of view-space slope (see FocalLengthPixels)
+     * @param max_zoom Finest zoom to select (usually the camera's zoom)
+     * @param max_tiles Tile budget; refinement stops before exceeding it
+     * @return Selected tiles, finest first
+     */
+    std::vector<TileCoordinates> Select(const glm::vec3& camera_position,
+                                        const Frustum& frustum,
+                                        float focal_length_px,
+                                        std::int32_t max_zoom,
+                                        std::size_t max_tiles);
+
+    /**
+     * @brief Select visible tiles, all at one zoom level
+     *
+     * Same culling as Select(), without screen-space refinement.
+     *
+     * @param camera_position Camera position in world space (globe radius 1)
+     * @param frustum Camera frustum
+     * @param zoom Zoom level to select
+     * @param max_tiles Tile budget; refinement stops before exceeding it
+     * @return Selected tiles
+     */
+    std::vector<TileCoordinates> SelectAtZoom(const glm::vec3& camera_position,
+                                              const Frustum& frustum,
+                                              std::int32_t zoom,
+                                              std::size_t max_tiles);
+
+    /**
+     * @brief Select() into a caller-provided list
+     *
+     * The list and the refinement queue allocate from the list's memory
+     * resource (e.g. a FrameArena).
+     *
+     * @param selected Replaced by the selected tiles, finest first
+     */
+    void Select(const glm::vec3& camera_position, const Frustum& frustum,
+                float focal_length_px, std::int32_t max_zoom, std::size_t max_tiles,
+                std::pmr::vector<TileCoordinates>& selected);
+
+    /**
+     * @brief SelectAtZoom() into a caller-provided list
+     *
+     * @param selected Replaced by the selected tiles
+     */
+    void SelectAtZoom(const glm::vec3& camera_position, const Frustum& frustum,
+                      std::int32_t zoom, std::size_t max_tiles,
+                      std::pmr::vector<TileCoordinates>& selected);
+
+    /**
+     * @brief Select the tiles of one zoom that overlap a visible region
+     *
+     * Enumerates the tiles in the region's latitude/longitude box (on both
+     * sides of the antimeridian when it crosses it) and culls them like
+     * SelectAtZoom(). Suited to coarse zooms, where tiles are too large for
+     * the quadtree descent to cull much but the box holds few of them.
+     *
+     * @param camera_position Camera position in world space (globe radius 1)
+     * @param frustum Camera frustum
+     * @param region Visible region (CoordinateMapper::CalculateVisibleRegion())
+     * @param zoom Zoom level to select
+     * @param max_tiles Tile budget; the tiles nearest the camera are kept
+     * @param selected Replaced by the selected tiles
+     */
+    void SelectInRegion(const glm::vec3& camera_position, const Frustum& frustum,
+                        const coordinates::VisibleRegion& region, std::int32_t zoom,
+                        std::size_t max_tiles, std::pmr::vector<TileCoordinates>& selected);
+
+    /**
+     * @brief Screen pixels covered by one texel of a tile at its nearest point
+     *
+     * @param tile Tile to evaluate
+     * @param camera_position Camera position in world space
+     * @param focal_length_px Pixels per unit of view-space slope
+     * @return Screen-space error in pixels per texel
+     */
+    float CalculateScreenSpaceError(const TileCoordinates& tile,
+                                    const glm::vec3& camera_position,
+                                    float focal_length_px) const;
+
+    /**
+     * @brief Vertical focal length in pixels of a perspective projection
+     *
+     * @param projection Perspective projection matrix
+     * @param viewport_height Viewport height in pixels
+     */
+    static float FocalLengthPixels(const glm::mat4& projection, float viewport_height);
+
+    /**
+     * @brief Bounding volumes of a tile's curved patch of the unit globe
+     *
+     * @param tile Tile to bound
+     * @param occluder_radius Radius of the horizon occluder sphere
+     */
+    static TileBound ComputeBound(const TileCoordinates& tile, float occluder_radius = 1.0f);
+
+    /**
+     * @brief Check whether a point is hidden behind the occluder sphere
+     *
+     * @param scaled_camera Camera position divided by the occluder radius
+     * @param scaled_point Point divided by the occluder radius
+     * @return true if the globe blocks the line of sight to the point
+     */
+    static bool IsBelowHorizon(const glm::vec3& scaled_camera, const glm::vec3& scaled_point);
+
+    /**
+     * @brief Get selection configuration
+     */
+    const TileSelectionConfig& GetConfig() const { return config_; }
+
+    /**
+     * @brief Update selection configuration
+     */
+    void SetConfig(const TileSelectionConfig& config) { config_ = config; }
+
+    /**
+     * @brief Get statistics of the last selection
+     */
+    TileSelectionStats GetStats() const { return stats_; }
+
+private:
+    void Traverse(const glm::vec3& camera_position,
+                  const Frustum& frustum,
+                  float focal_length_px,
+                  std::int32_t min_zoom,
+                  std::int32_t max_zoom,
+                  std::size_t max_tiles,
+                  std::pmr::vector<TileCoordinates>& selected);
+
+    float ErrorForBound(const TileCoordinates& tile, const TileBound& bound,
+                        const glm::vec3& camera_position, float focal_length_px) const;
+
+    TileSelectionConfig config_;
+    TileSelectionStats stats_;
+};
+
+} // namespace earth_map
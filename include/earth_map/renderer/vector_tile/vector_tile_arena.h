@@ -0,0 +1,124 @@
+#pragma once
+
+/**
+ * @file vector_tile_arena.h
+ * @brief Shared GPU buffers for the meshes of vector tiles
+ *
+ * Every resident vector tile lives in one vertex buffer and one index
+ * buffer, sub-allocated first-fit from free lists that coalesce on free.
+ * One vertex array object describes both, so drawing a tile only needs its
+ * index range and base vertex: no buffer or VAO switch between tiles, and
+ * no buffer allocation per tile.
+ *
+ * Indices are stored relative to the tile's first vertex and drawn with
+ * glDrawElementsBaseVertex.
+ */
+
+#include <earth_map/renderer/vector_tile/vector_tile_mesh.h>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace earth_map {
+
+/**
+ * @brief Where one tile's mesh lives in the arena
+ */
+struct VectorTileAllocation {
+    std::uint32_t first_vertex = 0;      ///< Base vertex of the tile's indices
+    std::uint32_t vertex_count = 0;
+    std::uint32_t first_index = 0;       ///< Offset into the index buffer, in indices
+    std::uint32_t index_count = 0;
+    std::uint32_t fill_index_count = 0;  ///< Fill triangles, then line quads
+};
+
+/**
+ * @brief Vertex and index buffers shared by all vector tiles
+ *
+ * Thread Safety: NOT thread-safe — GL thread only.
+ */
+class VectorTileArena {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param max_vertices Vertex buffer capacity (at least 1)
+     * @param max_indices Index buffer capacity (at least 1)
+     * @param skip_gl_init Skip OpenGL calls (for testing)
+     */
+    VectorTileArena(std::uint32_t max_vertices, std::uint32_t max_indices,
+                    bool skip_gl_init = false);
+
+    /**
+     * @brief Destructor (deletes the buffers; needs the GL context current)
+     */
+    ~VectorTileArena();
+
+    VectorTileArena(const VectorTileArena&) = delete;
+    VectorTileArena& operator=(const VectorTileArena&) = delete;
+
+    /**
+     * @brief Allocate room for a mesh and upload it
+     *
+     * @return The allocation, or nullopt if either buffer has no free range
+     *         large enough (free other tiles and retry)
+     */
+    std::optional<VectorTileAllocation> Upload(const VectorTileMesh& mesh);
+
+    /**
+     * @brief Return an allocation's ranges to the free lists
+     */
+    void Free(const VectorTileAllocation& allocation);
+
+    /** @brief Get the vertex array object (0 if GL is skipped) */
+    std::uint32_t GetVertexArray() const { return vertex_array_; }
+
+    /** @brief Get the vertex buffer capacity */
+    std::uint32_t GetMaxVertices() const { return vertices_.GetCapacity(); }
+
+    /** @brief Get the index buffer capacity */
+    std::uint32_t GetMaxIndices() const { return indices_.GetCapacity(); }
+
+    /** @brief Get the vertices allocated to tiles */
+    std::uint32_t GetUsedVertices() const { return vertices_.GetUsed(); }
+
+    /** @brief Get the indices allocated to tiles */
+    std::uint32_t GetUsedIndices() const { return indices_.GetUsed(); }
+
+    /** @brief Get the bytes held by both buffers */
+    std::size_t GetGpuMemoryBytes() const;
+
+private:
+    /**
+     * @brief First-fit allocator of ranges in [0, capacity)
+     */
+    class RangeAllocator {
+    public:
+        explicit RangeAllocator(std::uint32_t capacity);
+
+        /// Start of a free range of @p count elements, or nullopt
+        std::optional<std::uint32_t> Allocate(std::uint32_t count);
+
+        /// Free a range, merging it with free neighbors
+        void Free(std::uint32_t offset, std::uint32_t count);
+
+        std::uint32_t GetCapacity() const { return capacity_; }
+        std::uint32_t GetUsed() const { return used_; }
+
+    private:
+        std::uint32_t capacity_;
+        std::uint32_t used_ = 0;
+        /// Free ranges: offset -> length, never adjacent
+        std::map<std::uint32_t, std::uint32_t> free_;
+    };
+
+    RangeAllocator vertices_;
+    RangeAllocator indices_;
+    bool skip_gl_init_;
+    std::uint32_t vertex_array_ = 0;
+    std::uint32_t vertex_buffer_ = 0;
+    std::uint32_t index_buffer_ = 0;
+};
+
+} // namespace earth_map
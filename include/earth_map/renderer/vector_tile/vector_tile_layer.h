@@ -0,0 +1,150 @@
+#pragma once
+
+/**
+ * @file vector_tile_layer.h
+ * @brief Mapbox Vector Tile layer drawn over the globe
+ *
+ * Vector tiles go through the same pipeline as imagery: TileCache and
+ * TileLoader fetch them, a TileLoadWorkerPool in vector mode decodes and
+ * tessellates them on its decode threads, and the finished meshes reach
+ * the GL thread through a GLUploadQueue. The GL thread only copies them
+ * into the shared VectorTileArena.
+ *
+ * Tiles beyond the provider's max zoom are drawn from their ancestor at
+ * max zoom (vector geometry scales without loss), and tiles still loading
+ * are covered by their nearest resident ancestor. When the arena is full,
+ * least recently drawn tiles are evicted.
+ */
+
+#include <earth_map/math/tile_mathematics.h>
+#include <earth_map/renderer/vector_tile/vector_tile_mesh.h>
+#include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace earth_map {
+
+class TileCache;
+class TileLoader;
+
+/**
+ * @brief Vector tile layer configuration
+ */
+struct VectorTileLayerConfig {
+    /** Styled MVT layers (at most kMaxVectorTileStyles, drawn in order) */
+    std::vector<VectorTileStyle> styles;
+
+    /** Vertex capacity of the arena (20 bytes each) */
+    std::uint32_t max_vertices = 1u << 20;
+
+    /** Index capacity of the arena (4 bytes each) */
+    std::uint32_t max_indices = 3u << 20;
+
+    /** Decode threads (0 = hardware concurrency) */
+    int worker_threads = 0;
+};
+
+/**
+ * @brief Vector tile rendering statistics of the last frame
+ */
+struct VectorTileRenderStats {
+    std::size_t tiles_rendered = 0;      ///< Tiles drawn
+    std::size_t fallback_tiles = 0;      ///< Ancestors drawn for tiles still loading
+    std::uint32_t draw_calls = 0;
+    std::size_t resident_tiles = 0;      ///< Tiles in the arena
+    std::size_t used_vertices = 0;
+    std::size_t used_indices = 0;
+    std::size_t gpu_memory_bytes = 0;    ///< Bytes held by the arena
+};
+
+/**
+ * @brief Vector tile layer interface
+ *
+ * Thread Safety: NOT thread-safe — GL thread only (loading runs on the
+ * layer's own workers).
+ */
+class VectorTileLayer {
+public:
+    /**
+     * @brief Create a vector tile layer
+     *
+     * @param cache Tile cache (may be null)
+     * @param loader Loader of the vector tile provider
+     * @param config Styles and capacities
+     * @param skip_gl_init Skip OpenGL calls (for testing)
+     * @return std::unique_ptr<VectorTileLayer> New layer (shaders not yet compiled)
+     * @throws std::invalid_argument if @p loader is null
+     */
+    static std::unique_ptr<VectorTileLayer> Create(std::shared_ptr<TileCache> cache,
+                                                   std::shared_ptr<TileLoader> loader,
+                                                   const VectorTileLayerConfig& config = {},
+                                                   bool skip_gl_init = false);
+
+    /**
+     * @brief Virtual destructor (releases GL resources; needs the GL context current)
+     */
+    virtual ~VectorTileLayer() = default;
+
+    /**
+     * @brief Compile the shaders
+     *
+     * @return true if initialization succeeded, false otherwise
+     */
+    virtual bool Initialize() = 0;
+
+    /**
+     * @brief Replace the styles; resident tiles are dropped and reloaded
+     */
+    virtual void SetStyles(const std::vector<VectorTileStyle>& styles) = 0;
+
+    /**
+     * @brief Set the tiles of this frame and request the missing ones
+     *
+     * Tiles are requested in order (earlier = higher priority); queued
+     * requests for tiles no longer wanted are cancelled.
+     */
+    virtual void RequestTiles(const std::vector<TileCoordinates>& tiles) = 0;
+
+    /**
+     * @brief Copy up to @p max_uploads tessellated tiles into the arena
+     *
+     * @return Number of tiles uploaded
+     */
+    virtual std::size_t ProcessUploads(std::size_t max_uploads) = 0;
+
+    /**
+     * @brief Check if a tile's mesh is resident
+     */
+    virtual bool IsTileLoaded(const TileCoordinates& coords) const = 0;
+
+    /**
+     * @brief Draw the tiles of the last RequestTiles
+     *
+     * Fills of every tile first, then lines, alpha-blended and depth-tested
+     * against the globe drawn before.
+     *
+     * @param view_matrix Camera view matrix (world units: globe radius 1)
+     * @param projection_matrix Camera projection matrix
+     * @param camera_position Camera position in world units
+     * @param viewport_width Viewport width in pixels
+     * @param viewport_height Viewport height in pixels
+     */
+    virtual void Render(const glm::mat4& view_matrix, const glm::mat4& projection_matrix,
+                        const glm::vec3& camera_position, std::uint32_t viewport_width,
+                        std::uint32_t viewport_height) = 0;
+
+    /**
+     * @brief Get statistics of the last frame
+     */
+    virtual VectorTileRenderStats GetStats() const = 0;
+
+protected:
+    /**
+     * @brief Protected constructor to enforce factory pattern
+     */
+    VectorTileLayer() = default;
+};
+
+} // namespace earth_map
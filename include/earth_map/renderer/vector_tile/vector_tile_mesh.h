@@ -0,0 +1,105 @@
+#pragma once
+
+/**
+ * @file vector_tile_mesh.h
+ * @brief Tessellation of vector tiles into GPU-ready triangle meshes
+ *
+ * Runs on the decode threads (TileLoadWorkerPool), so the GL thread only
+ * copies finished vertex and index data into the vector tile arena:
+ *
+ * - Polygons are clipped to the tile and triangulated by ear clipping,
+ *   holes joined to their outer ring by bridge edges (as in earcut).
+ * - Lines (and polygon outlines, if styled) become one quad per segment.
+ *   Their vertices sit on the line and carry the unit normal; the vertex
+ *   shader extrudes them to the styled width in pixels, so lines stay
+ *   sharp at any zoom.
+ *
+ * Positions are in tile units ([0, 1], x east, y south), the shader places
+ * them on the globe.
+ */
+
+#include <earth_map/data/mvt_tile.h>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace earth_map {
+
+/// Styles one tessellation can reference (uniform arrays of the vector shader)
+constexpr std::size_t kMaxVectorTileStyles = 16;
+
+/**
+ * @brief How the features of one MVT layer are drawn
+ */
+struct VectorTileStyle {
+    std::string layer;                                 ///< MVT layer name
+    glm::vec4 fill_color{0.0f, 0.0f, 0.0f, 0.0f};      ///< Polygon fill (alpha 0 = no fill)
+    glm::vec4 line_color{0.0f, 0.0f, 0.0f, 1.0f};      ///< Lines and polygon outlines
+    float line_width = 1.0f;                           ///< Line width in pixels (0 = no lines)
+    bool outline_polygons = false;                     ///< Also draw polygon rings as lines
+};
+
+/**
+ * @brief Vertex of a tessellated vector tile (20 bytes)
+ */
+struct VectorTileVertex {
+    glm::vec2 position;   ///< Tile units
+    glm::vec2 extrude;    ///< Unit normal for line vertices, zero for fills
+    float style;          ///< Index into the styles
+};
+static_assert(sizeof(VectorTileVertex) == 20, "VectorTileVertex is tightly packed");
+
+/**
+ * @brief Triangles of one vector tile
+ *
+ * Indices [0, fill_index_count) are fill triangles, the rest line quads;
+ * both index the same vertex array.
+ */
+struct VectorTileMesh {
+    std::vector<VectorTileVertex> vertices;
+    std::vector<std::uint32_t> indices;
+    std::size_t fill_index_count = 0;
+
+    /**
+     * @brief Get the bytes the mesh takes in GPU buffers
+     */
+    std::size_t GetByteSize() const {
+        return vertices.size() * sizeof(VectorTileVertex) + indices.size() * sizeof(std::uint32_t);
+    }
+};
+
+/**
+ * @brief Triangulate a polygon with holes
+ *
+ * @param rings Exterior ring first, then its holes; no ring repeats its
+ *        first point
+ * @return Triangle indices into the rings' points, numbered ring after
+ *         ring; empty for degenerate input
+ */
+std::vector<std::uint32_t> TriangulatePolygon(std::span<const std::vector<glm::vec2>> rings);
+
+/**
+ * @brief Clip a ring to the tile square [0, 1]² (Sutherland-Hodgman)
+ *
+ * Keeps the ring's orientation. Concave rings may gain zero-area edges
+ * along the tile border, which triangulate to nothing.
+ */
+std::vector<glm::vec2> ClipRingToTile(std::span<const glm::vec2> ring);
+
+/**
+ * @brief Tessellate the styled layers of a vector tile
+ *
+ * Features of layers without a style and point features are skipped.
+ *
+ * @param tile Decoded tile
+ * @param styles Styles; at most kMaxVectorTileStyles are used, a vertex's
+ *        style is the index of its layer's style
+ * @return Mesh (empty if nothing is styled)
+ */
+VectorTileMesh TessellateVectorTile(const MvtTile& tile, std::span<const VectorTileStyle> styles);
+
+} // namespace earth_map
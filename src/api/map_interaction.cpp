@@ -7,6 +7,7 @@
 #include "../../include/earth_map/coordinates/coordinate_mapper.h"
 #include "../../include/earth_map/renderer/renderer.h"
 #include "../../include/earth_map/renderer/camera.h"
+#include "../../include/earth_map/renderer/tile_renderer.h"
 #include <spdlog/spdlog.h>
 
 namespace earth_map {
@@ -260,7 +261,11 @@ void MapInteraction::FlyToLocation(
 
     // Set camera to new position (animation not yet implemented in CameraController)
     // TODO: Implement smooth animation when CameraController supports it
-    (void)duration;  // Suppress unused parameter warning
+    // The destination is known up front: let the tile renderer prefetch the
+    // path and the destination footprint
+    if (auto tile_renderer = impl_->renderer_->GetTileRenderer()) {
+        tile_renderer->PrefetchDestination(new_camera_pos, static_cast<float>(duration));
+    }
     camera_controller->SetPosition(new_camera_pos);
 
     spdlog::info("Flying to location: lat={:.4f}, lon={:.4f}, altitude={:.0f}m",
@@ -5,28 +5,40 @@
 
 #include "../../include/earth_map/coordinates/altitude_reference.h"
 #include "../../include/earth_map/coordinates/coordinate_spaces.h"
+#include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <stdexcept>
 #include <glm/glm.hpp>
 
 namespace earth_map {
 namespace coordinates {
 
-// ============================================================================
-// Altitude Conversion
-// ============================================================================
+namespace {
 
-double AltitudeConverter::Convert(
-    double altitude,
-    AltitudeReference from,
-    AltitudeReference to,
-    const Geographic& location,
-    double terrain_elevation) noexcept {
+/// Geoid model shared by all conversions
+struct GeoidModel {
+    std::shared_ptr<const GeoidGrid> grid;
+    GeoidInterpolation interpolation = GeoidInterpolation::BILINEAR;
+};
 
-    // Same reference - no conversion needed
-    if (from == to) {
-        return altitude;
-    }
+std::atomic<std::shared_ptr<const GeoidModel>>& CurrentGeoidModel() {
+    static std::atomic<std::shared_ptr<const GeoidModel>> model;
+    return model;
+}
 
+/// Points converted per block by the batch conversions
+constexpr std::size_t kAltitudeBlock = 256;
+
+/**
+ * @brief Convert an altitude given the reference surfaces at its location
+ *
+ * @param geoid_height Geoid height, used by MEAN_SEA_LEVEL
+ * @param ellipsoid_radius Ellipsoid radius, used by ABSOLUTE
+ * @param terrain_elevation Terrain elevation, used by TERRAIN
+ */
+double ConvertAt(double altitude, AltitudeReference from, AltitudeReference to,
+                 double geoid_height, double ellipsoid_radius, double terrain_elevation) {
     // Convert to WGS84 ellipsoid as intermediate reference
     double wgs84_height = altitude;
 
@@ -37,25 +49,21 @@ double AltitudeConverter::Convert(
             wgs84_height = altitude;
             break;
 
-        case AltitudeReference::MEAN_SEA_LEVEL: {
+        case AltitudeReference::MEAN_SEA_LEVEL:
             // MSL to WGS84: add geoid height
             // Height above ellipsoid = Height above geoid + Geoid height
-            double geoid_height = GetGeoidHeight(location);
             wgs84_height = altitude + geoid_height;
             break;
-        }
 
         case AltitudeReference::TERRAIN:
             // Terrain-relative to WGS84: add terrain elevation
             wgs84_height = altitude + terrain_elevation;
             break;
 
-        case AltitudeReference::ABSOLUTE: {
+        case AltitudeReference::ABSOLUTE:
             // Absolute (geocentric) to WGS84: subtract ellipsoid radius
-            double ellipsoid_radius = GetEllipsoidRadius(location.latitude);
             wgs84_height = altitude - ellipsoid_radius;
             break;
-        }
     }
 
     // From WGS84 ellipsoid to target reference
@@ -63,51 +71,140 @@ double AltitudeConverter::Convert(
         case AltitudeReference::WGS84_ELLIPSOID:
             return wgs84_height;
 
-        case AltitudeReference::MEAN_SEA_LEVEL: {
+        case AltitudeReference::MEAN_SEA_LEVEL:
             // WGS84 to MSL: subtract geoid height
-            double geoid_height = GetGeoidHeight(location);
             return wgs84_height - geoid_height;
-        }
 
         case AltitudeReference::TERRAIN:
             // WGS84 to terrain-relative: subtract terrain elevation
             return wgs84_height - terrain_elevation;
 
-        case AltitudeReference::ABSOLUTE: {
+        case AltitudeReference::ABSOLUTE:
             // WGS84 to absolute: add ellipsoid radius
-            double ellipsoid_radius = GetEllipsoidRadius(location.latitude);
             return wgs84_height + ellipsoid_radius;
-        }
     }
 
     // Should never reach here
     return altitude;
 }
 
-double AltitudeConverter::GetGeoidHeight(const Geographic& location) noexcept {
-    // TODO: Implement full geoid model (EGM96 or EGM2008)
-    // For now, return approximate geoid height based on simple model
+bool Uses(AltitudeReference reference, AltitudeReference from, AltitudeReference to) {
+    return from == reference || to == reference;
+}
 
-    // Very rough approximation: geoid height varies with latitude
-    // Real geoid heights range from -110m to +85m globally
-    // This is a simplified model for initial implementation
+/**
+ * @brief Rough geoid height from latitude alone, used without a geoid model
+ *
+ * Geoid is slightly higher at equator, lower at poles. This is NOT
+ * accurate; real geoid heights range from -110m to +85m globally.
+ */
+double ApproximateGeoidHeight(double latitude_degrees) {
+    const double lat_rad = glm::radians(latitude_degrees);
+    return -20.0 * std::cos(2.0 * lat_rad);  // Range: -20m to +20m
+}
 
-    double lat_rad = glm::radians(location.latitude);
+} // namespace
 
-    // Simple approximation: geoid is below ellipsoid near poles, above at equator
-    // This is NOT accurate and should be replaced with EGM96/EGM2008 data
-    double approx_geoid_height = 0.0;  // Simplified: assume geoid ≈ ellipsoid
+// ============================================================================
+// Altitude Conversion
+// ============================================================================
 
-    // For better accuracy, we would:
-    // 1. Load EGM96 or EGM2008 geoid grid data
-    // 2. Interpolate geoid height at (lat, lon)
-    // 3. Return interpolated value
+double AltitudeConverter::Convert(
+    double altitude,
+    AltitudeReference from,
+    AltitudeReference to,
+    const Geographic& location,
+    double terrain_elevation) noexcept {
+
+    // Same reference - no conversion needed
+    if (from == to) {
+        return altitude;
+    }
 
-    // Placeholder simple model (very rough):
-    // Geoid is slightly higher at equator, lower at poles
-    approx_geoid_height = -20.0 * std::cos(2.0 * lat_rad);  // Range: -20m to +20m
+    const double geoid_height =
+        Uses(AltitudeReference::MEAN_SEA_LEVEL, from, to) ? GetGeoidHeight(location) : 0.0;
+    const double ellipsoid_radius =
+        Uses(AltitudeReference::ABSOLUTE, from, to) ? GetEllipsoidRadius(location.latitude) : 0.0;
+    return ConvertAt(altitude, from, to, geoid_height, ellipsoid_radius, terrain_elevation);
+}
+
+void AltitudeConverter::Convert(
+    std::span<const double> altitudes,
+    AltitudeReference from,
+    AltitudeReference to,
+    std::span<const double> latitudes,
+    std::span<const double> longitudes,
+    std::span<double> converted,
+    std::span<const double> terrain_elevations) {
+
+    const std::size_t count = altitudes.size();
+    const bool uses_terrain = Uses(AltitudeReference::TERRAIN, from, to);
+    if (latitudes.size() != count || longitudes.size() != count || converted.size() != count ||
+        (uses_terrain && terrain_elevations.size() != count)) {
+        throw std::invalid_argument("AltitudeConverter::Convert: span sizes differ");
+    }
 
-    return approx_geoid_height;
+    const bool uses_geoid = from != to && Uses(AltitudeReference::MEAN_SEA_LEVEL, from, to);
+    const bool uses_radius = from != to && Uses(AltitudeReference::ABSOLUTE, from, to);
+    for (std::size_t begin = 0; begin < count; begin += kAltitudeBlock) {
+        const std::size_t size = std::min(kAltitudeBlock, count - begin);
+        double geoid_heights[kAltitudeBlock] = {};
+        double radii[kAltitudeBlock] = {};
+        if (uses_geoid) {
+            GetGeoidHeights(latitudes.subspan(begin, size), longitudes.subspan(begin, size),
+                            std::span<double>(geoid_heights, size));
+        }
+        if (uses_radius) {
+            for (std::size_t j = 0; j < size; ++j) {
+                radii[j] = GetEllipsoidRadius(latitudes[begin + j]);
+            }
+        }
+        for (std::size_t j = 0; j < size; ++j) {
+            const std::size_t i = begin + j;
+            converted[i] = from == to
+                ? altitudes[i]
+                : ConvertAt(altitudes[i], from, to, geoid_heights[j], radii[j],
+                            uses_terrain ? terrain_elevations[i] : 0.0);
+        }
+    }
+}
+
+void AltitudeConverter::SetGeoidModel(std::shared_ptr<const GeoidGrid> grid,
+                                      GeoidInterpolation interpolation) noexcept {
+    std::shared_ptr<const GeoidModel> model;
+    if (grid) {
+        model = std::make_shared<const GeoidModel>(GeoidModel{std::move(grid), interpolation});
+    }
+    CurrentGeoidModel().store(std::move(model));
+}
+
+std::shared_ptr<const GeoidGrid> AltitudeConverter::GetGeoidModel() noexcept {
+    const std::shared_ptr<const GeoidModel> model = CurrentGeoidModel().load();
+    return model ? model->grid : nullptr;
+}
+
+double AltitudeConverter::GetGeoidHeight(const Geographic& location) noexcept {
+    const std::shared_ptr<const GeoidModel> model = CurrentGeoidModel().load();
+    if (model) {
+        return model->grid->Sample(location.latitude, location.longitude, model->interpolation);
+    }
+    return ApproximateGeoidHeight(location.latitude);
+}
+
+void AltitudeConverter::GetGeoidHeights(std::span<const double> latitudes,
+                                        std::span<const double> longitudes,
+                                        std::span<double> heights) {
+    const std::shared_ptr<const GeoidModel> model = CurrentGeoidModel().load();
+    if (model) {
+        model->grid->SampleBatch(latitudes, longitudes, heights, model->interpolation);
+        return;
+    }
+    if (longitudes.size() != latitudes.size() || heights.size() != latitudes.size()) {
+        throw std::invalid_argument("AltitudeConverter::GetGeoidHeights: span sizes differ");
+    }
+    for (std::size_t i = 0; i < latitudes.size(); ++i) {
+        heights[i] = ApproximateGeoidHeight(latitudes[i]);
+    }
 }
 
 double AltitudeConverter::GetEllipsoidRadius(double latitude_degrees) noexcept {
@@ -6,10 +6,17 @@
 #include "../../include/earth_map/coordinates/coordinate_mapper.h"
 #include "../../include/earth_map/math/projection.h"
 #include "../../include/earth_map/math/tile_mathematics.h"
+#include "../../include/earth_map/math/vector_math.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <cmath>
 #include <algorithm>
+#include <future>
+#include <initializer_list>
 #include <limits>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <utility>
 
 namespace earth_map {
 namespace coordinates {
@@ -278,155 +285,604 @@ GeographicBounds GetEverestGeoBounds() {
         );
 }
 
+// ============================================================================
+// Batch Conversions (structure-of-arrays)
+// ============================================================================
+
+namespace {
+
+/// Points converted per block, so the kernels' scratch arrays stay on the stack
+constexpr std::size_t kBatchBlock = 256;
+
+void RequireBatchSizes(std::size_t count, std::initializer_list<std::size_t> sizes) {
+    for (const std::size_t size : sizes) {
+        if (size != count) {
+            throw std::invalid_argument("CoordinateMapper batch: span sizes differ");
+        }
+    }
+}
+
+/**
+ * @brief Run block(begin, size) over [0, count) in blocks of kBatchBlock
+ *
+ * Large batches are split into one contiguous chunk per hardware thread.
+ */
+template <typename Block>
+void ForEachBatchBlock(std::size_t count, const Block& block) {
+    const std::size_t chunk_count = count < CoordinateMapper::kParallelBatchMin
+        ? 1 : std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t chunk_size = (count + chunk_count - 1) / std::max<std::size_t>(chunk_count, 1);
+    const auto work = [&](std::size_t chunk) {
+        const std::size_t end = std::min(count, (chunk + 1) * chunk_size);
+        for (std::size_t begin = chunk * chunk_size; begin < end; begin += kBatchBlock) {
+            block(begin, std::min(kBatchBlock, end - begin));
+        }
+    };
+
+    std::vector<std::future<void>> tasks;
+    for (std::size_t chunk = 1; chunk < chunk_count; ++chunk) {
+        tasks.push_back(std::async(std::launch::async, work, chunk));
+    }
+    work(0);
+    for (std::future<void>& task : tasks) {
+        task.get();
+    }
+}
+
+} // namespace
+
+void CoordinateMapper::GeographicToWorld(std::span<const double> latitudes,
+                                         std::span<const double> longitudes,
+                                         std::span<float> x,
+                                         std::span<float> y,
+                                         std::span<float> z,
+                                         float radius) {
+    RequireBatchSizes(latitudes.size(), {longitudes.size(), x.size(), y.size(), z.size()});
+    ForEachBatchBlock(latitudes.size(), [&](std::size_t begin, std::size_t size) {
+        double lat_rad[kBatchBlock];
+        double lon_rad[kBatchBlock];
+        double sin_lat[kBatchBlock];
+        double cos_lat[kBatchBlock];
+        double sin_lon[kBatchBlock];
+        double cos_lon[kBatchBlock];
+        for (std::size_t j = 0; j < size; ++j) {
+            lat_rad[j] = glm::radians(latitudes[begin + j]);
+            lon_rad[j] = glm::radians(longitudes[begin + j]);
+        }
+        VectorMath::SinCos({lat_rad, size}, {sin_lat, size}, {cos_lat, size});
+        VectorMath::SinCos({lon_rad, size}, {sin_lon, size}, {cos_lon, size});
+
+        for (std::size_t j = 0; j < size; ++j) {
+            const std::size_t i = begin + j;
+            if (!Geographic(latitudes[i], longitudes[i], 0.0).IsValid()) {
+                x[i] = y[i] = z[i] = 0.0f;
+                continue;
+            }
+            x[i] = radius * static_cast<float>(cos_lat[j] * sin_lon[j]);
+            y[i] = radius * static_cast<float>(sin_lat[j]);
+            z[i] = radius * static_cast<float>(cos_lat[j] * cos_lon[j]);
+        }
+    });
+}
+
+void CoordinateMapper::WorldToGeographic(std::span<const float> x,
+                                         std::span<const float> y,
+                                         std::span<const float> z,
+                                         std::span<double> latitudes,
+                                         std::span<double> longitudes,
+                                         std::span<double> altitudes,
+                                         float radius) {
+    RequireBatchSizes(x.size(), {y.size(), z.size(), latitudes.size(), longitudes.size(),
+                                 altitudes.size()});
+    ForEachBatchBlock(x.size(), [&](std::size_t begin, std::size_t size) {
+        double px[kBatchBlock];
+        double py[kBatchBlock];
+        double pz[kBatchBlock];
+        double horizontal[kBatchBlock];
+        for (std::size_t j = 0; j < size; ++j) {
+            const std::size_t i = begin + j;
+            px[j] = x[i];
+            py[j] = y[i];
+            pz[j] = z[i];
+            horizontal[j] = std::sqrt(px[j] * px[j] + pz[j] * pz[j]);
+            // The origin maps to (0, 0), as World::Direction() defaults to +Z
+            altitudes[i] = static_cast<double>(
+                std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]) - radius);
+        }
+
+        // lat = atan2(y, |xz|) and lon = atan2(x, z), each in place
+        VectorMath::Atan2({py, size}, {horizontal, size}, {py, size});
+        VectorMath::Atan2({px, size}, {pz, size}, {px, size});
+        for (std::size_t j = 0; j < size; ++j) {
+            latitudes[begin + j] = glm::degrees(py[j]);
+            longitudes[begin + j] = glm::degrees(px[j]);
+        }
+    });
+}
+
+void CoordinateMapper::GeographicToProjected(std::span<const double> latitudes,
+                                             std::span<const double> longitudes,
+                                             std::span<double> x,
+                                             std::span<double> y) {
+    RequireBatchSizes(latitudes.size(), {longitudes.size(), x.size(), y.size()});
+    constexpr double kMetersPerDegree = WebMercatorProjection::WEB_MERCATOR_HALF_WORLD / 180.0;
+    constexpr double kMetersPerLogUnit = WebMercatorProjection::WEB_MERCATOR_HALF_WORLD / M_PI;
+    ForEachBatchBlock(latitudes.size(), [&](std::size_t begin, std::size_t size) {
+        double lat_rad[kBatchBlock];
+        double sin_lat[kBatchBlock];
+        double cos_lat[kBatchBlock];
+        for (std::size_t j = 0; j < size; ++j) {
+            lat_rad[j] = glm::radians(latitudes[begin + j]);
+        }
+        VectorMath::SinCos({lat_rad, size}, {sin_lat, size}, {cos_lat, size});
+
+        // ln(tan(pi/4 + lat/2)) = ln((1 + sin(lat)) / cos(lat))
+        double ratio[kBatchBlock];
+        for (std::size_t j = 0; j < size; ++j) {
+            ratio[j] = (1.0 + sin_lat[j]) / cos_lat[j];
+        }
+        VectorMath::Log({ratio, size}, {ratio, size});
+
+        for (std::size_t j = 0; j < size; ++j) {
+            const std::size_t i = begin + j;
+            const Geographic geo(latitudes[i], longitudes[i], 0.0);
+            if (!geo.IsValid() || std::abs(geo.latitude) > WebMercatorProjection::MAX_LATITUDE) {
+                x[i] = y[i] = std::numeric_limits<double>::quiet_NaN();
+                continue;
+            }
+            x[i] = kMetersPerDegree * longitudes[i];
+            y[i] = kMetersPerLogUnit * ratio[j];
+        }
+    });
+}
+
+void CoordinateMapper::WorldToScreen(std::span<const float> x,
+                                     std::span<const float> y,
+                                     std::span<const float> z,
+                                     const glm::mat4& view_matrix,
+                                     const glm::mat4& proj_matrix,
+                                     const glm::ivec4& viewport,
+                                     std::span<double> screen_x,
+                                     std::span<double> screen_y) {
+    RequireBatchSizes(x.size(), {y.size(), z.size(), screen_x.size(), screen_y.size()});
+    const glm::mat4 view_proj = proj_matrix * view_matrix;
+    ForEachBatchBlock(x.size(), [&](std::size_t begin, std::size_t size) {
+        for (std::size_t i = begin; i < begin + size; ++i) {
+            const glm::vec4 clip = view_proj * glm::vec4(x[i], y[i], z[i], 1.0f);
+            const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+            if (clip.w <= 0.0f || !(std::abs(ndc.x) <= 1.0f && std::abs(ndc.y) <= 1.0f &&
+                                    std::abs(ndc.z) <= 1.0f)) {
+                screen_x[i] = screen_y[i] = std::numeric_limits<double>::quiet_NaN();
+                continue;
+            }
+            screen_x[i] = (ndc.x * 0.5 + 0.5) * viewport[2] + viewport[0];
+            screen_y[i] = (ndc.y * 0.5 + 0.5) * viewport[3] + viewport[1];
+        }
+    });
+}
+
 // ============================================================================
 // Utility: Bounds Conversions
 // ============================================================================
 
-GeographicBounds CoordinateMapper::CalculateVisibleGeographicBounds(
-    const World& camera_world,
-    const glm::mat4& view_matrix,  // Now used for accurate orientation-based calculation
-    const glm::mat4& proj_matrix,
-    float globe_radius) noexcept {
+namespace {
 
-    // Do not remove, this is for elevation testing
-    // return GetEverestGeoBounds();
+constexpr double kRegionPi = 3.14159265358979323846;
+constexpr double kRegionTwoPi = 2.0 * kRegionPi;
 
-    glm::vec3 camera_pos = camera_world.position;
-    float distance = glm::length(camera_pos);
+/// Tolerance of constraint tests and vertex matching on the unit globe
+constexpr double kRegionEpsilon = 1e-9;
 
-    // Create combined view-projection matrix for frustum corner extraction
-    glm::mat4 view_proj = proj_matrix * view_matrix;
+/// Distance within which an arc's end and the next arc's start are one vertex
+constexpr double kVertexMatchDistance = 1e-6;
 
-    // Attempt to invert the view-projection matrix for ray-casting
-    glm::mat4 inv_vp;
-    try {
-        inv_vp = glm::inverse(view_proj);
-    } catch (...) {
-        // Fallback to old method if matrix is not invertible
-        glm::vec3 view_point = glm::normalize(camera_pos) * globe_radius;
-        Geographic center = CartesianToGeographic(view_point);
-
-        float horizon_angle_rad = std::asin(std::min(1.0f, globe_radius / distance));
-        float horizon_angle_deg = glm::degrees(horizon_angle_rad);
-        float fov_y = 2.0f * std::atan(1.0f / proj_matrix[1][1]);
-        float fov_deg = glm::degrees(fov_y);
-        float coverage_angle = std::min(160.0f, std::max(horizon_angle_deg, fov_deg / 2.0f) * 2.0f);
-        double half_coverage = static_cast<double>(coverage_angle) / 2.0;
-
-        return GeographicBounds(
-            Geographic(std::max(-85.05, center.latitude - half_coverage),
-                      std::max(-180.0, center.longitude - half_coverage), 0.0),
-            Geographic(std::min(85.05, center.latitude + half_coverage),
-                      std::min(180.0, center.longitude + half_coverage), 0.0)
-        );
+/// Largest angle between ring points along one boundary circle (2 degrees)
+constexpr double kMaxBoundaryStep = kRegionPi / 90.0;
+
+/// Half-space normal · p + distance >= 0 of the unit globe's space
+struct SurfaceConstraint {
+    glm::dvec3 normal;
+    double distance;
+};
+
+/// Circle where a constraint's plane cuts the unit globe; angles run counter-clockwise about the normal
+struct SurfaceCircle {
+    glm::dvec3 center;
+    glm::dvec3 u;  ///< Unit axis at angle 0
+    glm::dvec3 v;  ///< Unit axis at angle pi/2 (u × v = normal)
+    double radius;
+
+    [[nodiscard]] glm::dvec3 At(double angle) const {
+        return center + radius * (std::cos(angle) * u + std::sin(angle) * v);
     }
 
-    // Ray-cast frustum corners to globe surface to find actual visible region
-    // NDC corners: 8 corners of the frustum (4 near plane + 4 far plane)
-    const glm::vec4 ndc_corners[8] = {
-        glm::vec4(-1.0f, -1.0f, -1.0f, 1.0f),  // Near bottom-left
-        glm::vec4( 1.0f, -1.0f, -1.0f, 1.0f),  // Near bottom-right
-        glm::vec4( 1.0f,  1.0f, -1.0f, 1.0f),  // Near top-right
-        glm::vec4(-1.0f,  1.0f, -1.0f, 1.0f),  // Near top-left
-        glm::vec4(-1.0f, -1.0f,  1.0f, 1.0f),  // Far bottom-left
-        glm::vec4( 1.0f, -1.0f,  1.0f, 1.0f),  // Far bottom-right
-        glm::vec4( 1.0f,  1.0f,  1.0f, 1.0f),  // Far top-right
-        glm::vec4(-1.0f,  1.0f,  1.0f, 1.0f)   // Far top-left
-    };
+    [[nodiscard]] double AngleOf(const glm::dvec3& point) const {
+        const glm::dvec3 offset = point - center;
+        return std::atan2(glm::dot(offset, v), glm::dot(offset, u));
+    }
 
-    // Collect geographic coordinates of ray-sphere intersections
-    double min_lat = 90.0;
-    double max_lat = -90.0;
-    double min_lon = 180.0;
-    double max_lon = -180.0;
-    int intersection_count = 0;
-
-    for (int i = 0; i < 8; ++i) {
-        // Unproject NDC corner to world space
-        glm::vec4 world_homo = inv_vp * ndc_corners[i];
-        if (std::abs(world_homo.w) < 1e-6f) {
-            continue;  // Skip if homogeneous coordinate is near zero
+    /// Sign of the longitude's derivative along the circle at an angle
+    [[nodiscard]] double LongitudeSlope(double angle) const {
+        const glm::dvec3 point = At(angle);
+        const glm::dvec3 tangent = radius * (std::cos(angle) * v - std::sin(angle) * u);
+        return tangent.x * point.z - tangent.z * point.x;
+    }
+};
+
+/// Part of a circle on the region's boundary, begin < end <= begin + 2 pi
+struct BoundaryArc {
+    std::size_t circle;
+    double begin;
+    double end;
+};
+
+/// Longitude interval [start, start + length] in degrees, length in [0, 360)
+struct LongitudeSweep {
+    double start;
+    double length;
+};
+
+bool SatisfiesAll(const std::vector<SurfaceConstraint>& constraints, const glm::dvec3& point) {
+    return std::all_of(constraints.begin(), constraints.end(),
+                       [&point](const SurfaceConstraint& constraint) {
+                           return glm::dot(constraint.normal, point) + constraint.distance >=
+                                  -kRegionEpsilon;
+                       });
+}
+
+SurfaceCircle MakeCircle(const SurfaceConstraint& constraint) {
+    const glm::dvec3 helper = std::abs(constraint.normal.y) < 0.9 ? glm::dvec3(0.0, 1.0, 0.0)
+                                                                  : glm::dvec3(1.0, 0.0, 0.0);
+    const glm::dvec3 u = glm::normalize(glm::cross(helper, constraint.normal));
+    return SurfaceCircle{-constraint.distance * constraint.normal, u,
+                         glm::cross(constraint.normal, u),
+                         std::sqrt(std::max(0.0, 1.0 - constraint.distance * constraint.distance))};
+}
+
+/// Points of the unit globe on both constraints' planes (none, one or two)
+void IntersectCircles(const SurfaceConstraint& a, const SurfaceConstraint& b,
+                      std::vector<glm::dvec3>& points) {
+    const glm::dvec3 direction = glm::cross(a.normal, b.normal);
+    const double determinant = glm::dot(direction, direction);
+    if (determinant < kRegionEpsilon) {
+        return;  // Parallel planes
+    }
+
+    // Point of the planes' common line nearest the origin, then the line
+    // against the sphere
+    const double k = glm::dot(a.normal, b.normal);
+    const double ha = -a.distance;
+    const double hb = -b.distance;
+    const glm::dvec3 origin = ((ha - hb * k) * a.normal + (hb - ha * k) * b.normal) / determinant;
+    const glm::dvec3 line = direction / std::sqrt(determinant);
+    const double half_b = glm::dot(origin, line);
+    const double discriminant = half_b * half_b - (glm::dot(origin, origin) - 1.0);
+    if (discriminant < 0.0) {
+        return;
+    }
+    const double root = std::sqrt(discriminant);
+    points.push_back(origin + (-half_b - root) * line);
+    if (root > kRegionEpsilon) {
+        points.push_back(origin + (-half_b + root) * line);
+    }
+}
+
+/// Angles solving a * sin(t) + b * cos(t) + k = 0
+void AppendAngleSolutions(double a, double b, double k, std::vector<double>& angles) {
+    const double magnitude = std::hypot(a, b);
+    if (magnitude < kRegionEpsilon || std::abs(k) > magnitude) {
+        return;
+    }
+    const double phase = std::atan2(b, a);
+    const double alpha = std::asin(-k / magnitude);
+    angles.push_back(alpha - phase);
+    angles.push_back(kRegionPi - alpha - phase);
+}
+
+/// Angles at which a circle reaches a latitude or longitude extreme
+std::vector<double> ExtremeAngles(const SurfaceCircle& circle) {
+    std::vector<double> angles;
+    // d(y)/dt = 0
+    AppendAngleSolutions(-circle.u.y, circle.v.y, 0.0, angles);
+    // d(atan2(x, z))/dt = 0, i.e. x' z - z' x = 0
+    const glm::dvec3& c = circle.center;
+    const glm::dvec3& u = circle.u;
+    const glm::dvec3& v = circle.v;
+    const double r = circle.radius;
+    AppendAngleSolutions(r * (u.z * c.x - u.x * c.z), r * (v.x * c.z - v.z * c.x),
+                         r * r * (u.z * v.x - u.x * v.z), angles);
+    return angles;
+}
+
+Geographic UnitToGeographic(const glm::dvec3& point) {
+    return Geographic(glm::degrees(std::asin(std::clamp(point.y, -1.0, 1.0))),
+                      glm::degrees(std::atan2(point.x, point.z)), 0.0);
+}
+
+double WrapDegrees(double degrees) {
+    const double wrapped = std::fmod(degrees, 360.0);
+    return wrapped < 0.0 ? wrapped + 360.0 : wrapped;
+}
+
+/**
+ * @brief Append an arc's points to a ring, all but its end point
+ *
+ * Points fall at most kMaxBoundaryStep apart and on every extreme of the
+ * arc, so the longitude is monotonic between neighbours; the interval each
+ * step sweeps goes to @p sweeps.
+ */
+void TessellateArc(const SurfaceCircle& circle, const BoundaryArc& arc,
+                   std::vector<Geographic>& ring, std::vector<LongitudeSweep>& sweeps) {
+    const double span = arc.end - arc.begin;
+    const auto steps = static_cast<std::size_t>(std::max(1.0, std::ceil(span / kMaxBoundaryStep)));
+    std::vector<double> angles;
+    for (std::size_t i = 0; i <= steps; ++i) {
+        angles.push_back(arc.begin + span * static_cast<double>(i) / static_cast<double>(steps));
+    }
+    for (const double extreme : ExtremeAngles(circle)) {
+        const double angle = arc.begin + std::fmod(std::fmod(extreme - arc.begin, kRegionTwoPi) +
+                                                   kRegionTwoPi, kRegionTwoPi);
+        if (angle > arc.begin && angle < arc.end) {
+            angles.push_back(angle);
+        }
+    }
+    std::sort(angles.begin(), angles.end());
+
+    Geographic previous = UnitToGeographic(circle.At(angles.front()));
+    for (std::size_t i = 1; i < angles.size(); ++i) {
+        ring.push_back(previous);
+        const Geographic next = UnitToGeographic(circle.At(angles[i]));
+        if (circle.LongitudeSlope(0.5 * (angles[i - 1] + angles[i])) >= 0.0) {
+            sweeps.push_back({previous.longitude, WrapDegrees(next.longitude - previous.longitude)});
+        } else {
+            sweeps.push_back({next.longitude, WrapDegrees(previous.longitude - next.longitude)});
+        }
+        previous = next;
+    }
+}
+
+/**
+ * @brief Western and eastern edge of the longitudes a set of sweeps covers
+ *
+ * The edges bound the largest longitude gap no sweep covers.
+ *
+ * @return Edges (west > east across the antimeridian), -180 and 180 if the sweeps cover every longitude
+ */
+std::pair<double, double> LongitudeEdges(const std::vector<LongitudeSweep>& sweeps) {
+    // Split at the antimeridian into intervals within [-180, 180]
+    std::vector<std::pair<double, double>> intervals;
+    for (const LongitudeSweep& sweep : sweeps) {
+        const double end = sweep.start + sweep.length;
+        if (end > 180.0) {
+            intervals.emplace_back(sweep.start, 180.0);
+            intervals.emplace_back(-180.0, end - 360.0);
+        } else {
+            intervals.emplace_back(sweep.start, end);
+        }
+    }
+    if (intervals.empty()) {
+        return {-180.0, 180.0};
+    }
+
+    std::sort(intervals.begin(), intervals.end());
+    std::vector<std::pair<double, double>> merged{intervals.front()};
+    for (const auto& interval : intervals) {
+        if (interval.first <= merged.back().second + kRegionEpsilon) {
+            merged.back().second = std::max(merged.back().second, interval.second);
+        } else {
+            merged.push_back(interval);
+        }
+    }
+
+    // The gap across the antimeridian, then the gaps between intervals
+    double west = merged.front().first;
+    double east = merged.back().second;
+    double largest_gap = merged.front().first + 360.0 - merged.back().second;
+    for (std::size_t i = 1; i < merged.size(); ++i) {
+        const double gap = merged[i].first - merged[i - 1].second;
+        if (gap > largest_gap) {
+            largest_gap = gap;
+            west = merged[i].first;
+            east = merged[i - 1].second;
+        }
+    }
+    if (largest_gap <= kRegionEpsilon) {
+        return {-180.0, 180.0};
+    }
+    return {west, east};
+}
+
+/**
+ * @brief Region of the unit globe satisfying every constraint
+ *
+ * Boundary vertices are the pairwise circle intersections that satisfy all
+ * constraints; between neighbouring vertices on a circle, an arc is on the
+ * boundary when its midpoint is. A circle without vertices is a whole ring
+ * if it lies in the region. Arcs run counter-clockwise about their
+ * constraint's normal, so each one ends where the next one starts.
+ */
+VisibleRegion BuildRegion(std::vector<SurfaceConstraint> constraints) {
+    VisibleRegion region;
+
+    // Planes that miss the globe either keep all of it or none of it
+    std::vector<SurfaceConstraint> cutting;
+    for (const SurfaceConstraint& constraint : constraints) {
+        if (constraint.distance < -1.0) {
+            return region;
+        }
+        if (constraint.distance < 1.0) {
+            cutting.push_back(constraint);
+        }
+    }
+    constraints = std::move(cutting);
+
+    std::vector<SurfaceCircle> circles;
+    for (const SurfaceConstraint& constraint : constraints) {
+        circles.push_back(MakeCircle(constraint));
+    }
+
+    std::vector<std::vector<double>> vertex_angles(circles.size());
+    std::vector<glm::dvec3> points;
+    for (std::size_t i = 0; i < circles.size(); ++i) {
+        for (std::size_t j = i + 1; j < circles.size(); ++j) {
+            points.clear();
+            IntersectCircles(constraints[i], constraints[j], points);
+            for (const glm::dvec3& point : points) {
+                if (SatisfiesAll(constraints, point)) {
+                    vertex_angles[i].push_back(circles[i].AngleOf(point));
+                    vertex_angles[j].push_back(circles[j].AngleOf(point));
+                }
+            }
         }
-        glm::vec3 world_pos = glm::vec3(world_homo) / world_homo.w;
+    }
 
-        // Ray from camera to this corner
-        glm::vec3 ray_dir = world_pos - camera_pos;
-        float ray_length = glm::length(ray_dir);
-        if (ray_length < 1e-6f) {
-            continue;  // Skip degenerate rays
+    std::vector<BoundaryArc> arcs;
+    for (std::size_t k = 0; k < circles.size(); ++k) {
+        std::vector<double>& angles = vertex_angles[k];
+        std::sort(angles.begin(), angles.end());
+        angles.erase(std::unique(angles.begin(), angles.end(),
+                                 [](double a, double b) { return b - a < kRegionEpsilon; }),
+                     angles.end());
+        if (angles.empty()) {
+            if (SatisfiesAll(constraints, circles[k].At(0.0))) {
+                arcs.push_back({k, 0.0, kRegionTwoPi});
+            }
+            continue;
         }
-        ray_dir /= ray_length;  // Normalize
-
-        // Ray-sphere intersection using quadratic formula
-        // Ray: P = camera_pos + t * ray_dir
-        // Sphere: |P|² = globe_radius²
-        // Expand: |camera_pos + t * ray_dir|² = globe_radius²
-        const float a = 1.0f;  // glm::dot(ray_dir, ray_dir) = 1.0 (normalized)
-        const float b = 2.0f * glm::dot(camera_pos, ray_dir);
-        const float c = glm::dot(camera_pos, camera_pos) - globe_radius * globe_radius;
-        const float discriminant = b * b - 4.0f * a * c;
-
-        if (discriminant >= 0.0f) {
-            // Take the nearest intersection (smaller t, in front of camera)
-            const float sqrt_discriminant = std::sqrt(discriminant);
-            const float t1 = (-b - sqrt_discriminant) / (2.0f * a);
-            const float t2 = (-b + sqrt_discriminant) / (2.0f * a);
-
-            // Use the nearest positive t (intersection in front of camera)
-            float t = (t1 > 0.0f) ? t1 : t2;
-            if (t > 0.0f) {
-                glm::vec3 intersection = camera_pos + t * ray_dir;
-                Geographic geo = CartesianToGeographic(intersection);
-
-                // Update bounds
-                min_lat = std::min(min_lat, geo.latitude);
-                max_lat = std::max(max_lat, geo.latitude);
-                min_lon = std::min(min_lon, geo.longitude);
-                max_lon = std::max(max_lon, geo.longitude);
-                ++intersection_count;
+        for (std::size_t i = 0; i < angles.size(); ++i) {
+            const double begin = angles[i];
+            const double end = i + 1 < angles.size() ? angles[i + 1] : angles.front() + kRegionTwoPi;
+            if (end - begin > kRegionEpsilon &&
+                SatisfiesAll(constraints, circles[k].At(0.5 * (begin + end)))) {
+                arcs.push_back({k, begin, end});
             }
         }
     }
+    if (arcs.empty()) {
+        return region;
+    }
 
-    // Fallback: if no valid intersections found, use old orbital method
-    if (intersection_count == 0) {
-        glm::vec3 view_point = glm::normalize(camera_pos) * globe_radius;
-        Geographic center = CartesianToGeographic(view_point);
+    // Chain arcs into rings
+    std::vector<LongitudeSweep> sweeps;
+    std::vector<bool> used(arcs.size(), false);
+    for (std::size_t seed = 0; seed < arcs.size(); ++seed) {
+        if (used[seed]) {
+            continue;
+        }
+        std::vector<Geographic> ring;
+        std::size_t current = seed;
+        while (true) {
+            used[current] = true;
+            const BoundaryArc& arc = arcs[current];
+            TessellateArc(circles[arc.circle], arc, ring, sweeps);
+
+            const glm::dvec3 end = circles[arc.circle].At(arc.end);
+            std::size_t next = seed;
+            double nearest = kVertexMatchDistance;
+            for (std::size_t candidate = 0; candidate < arcs.size(); ++candidate) {
+                if (used[candidate] && candidate != seed) {
+                    continue;
+                }
+                const BoundaryArc& other = arcs[candidate];
+                const double distance = glm::length(circles[other.circle].At(other.begin) - end);
+                if (distance < nearest) {
+                    nearest = distance;
+                    next = candidate;
+                }
+            }
+            if (next == seed) {
+                break;
+            }
+            current = next;
+        }
+        region.rings.push_back(std::move(ring));
+    }
 
-        float horizon_angle_rad = std::asin(std::min(1.0f, globe_radius / distance));
-        float horizon_angle_deg = glm::degrees(horizon_angle_rad);
-        float fov_y = 2.0f * std::atan(1.0f / proj_matrix[1][1]);
-        float fov_deg = glm::degrees(fov_y);
-        float coverage_angle = std::min(160.0f, std::max(horizon_angle_deg, fov_deg / 2.0f) * 2.0f);
-        double half_coverage = static_cast<double>(coverage_angle) / 2.0;
+    region.contains_north_pole = SatisfiesAll(constraints, glm::dvec3(0.0, 1.0, 0.0));
+    region.contains_south_pole = SatisfiesAll(constraints, glm::dvec3(0.0, -1.0, 0.0));
 
-        return GeographicBounds(
-            Geographic(std::max(-85.05, center.latitude - half_coverage),
-                      std::max(-180.0, center.longitude - half_coverage), 0.0),
-            Geographic(std::min(85.05, center.latitude + half_coverage),
-                      std::min(180.0, center.longitude + half_coverage), 0.0)
-        );
+    double min_lat = 90.0;
+    double max_lat = -90.0;
+    for (const auto& ring : region.rings) {
+        for (const Geographic& point : ring) {
+            min_lat = std::min(min_lat, point.latitude);
+            max_lat = std::max(max_lat, point.latitude);
+        }
+    }
+    if (region.contains_north_pole) {
+        max_lat = 90.0;
+    }
+    if (region.contains_south_pole) {
+        min_lat = -90.0;
     }
 
-    // Add 10% margin for safety (avoid edge cases where tiles at boundaries are missed)
-    const double lat_margin = (max_lat - min_lat) * 0.1;
-    const double lon_margin = (max_lon - min_lon) * 0.1;
+    // A region around a pole has every longitude; otherwise each meridian
+    // through it crosses its boundary
+    if (!region.contains_north_pole && !region.contains_south_pole) {
+        std::tie(region.west_longitude, region.east_longitude) = LongitudeEdges(sweeps);
+    }
+    const bool crosses = region.CrossesAntimeridian();
+    region.bounds = GeographicBounds(
+        Geographic(min_lat, crosses ? -180.0 : region.west_longitude, 0.0),
+        Geographic(max_lat, crosses ? 180.0 : region.east_longitude, 0.0));
+    return region;
+}
 
-    min_lat = std::max(-85.05, min_lat - lat_margin);
-    max_lat = std::min(85.05, max_lat + lat_margin);
-    min_lon = std::max(-180.0, min_lon - lon_margin);
-    max_lon = std::min(180.0, max_lon + lon_margin);
+} // namespace
 
-    // Handle date line wraparound (if bounds span more than 180° longitude)
-    if (max_lon - min_lon > 180.0) {
-        min_lon = -180.0;
-        max_lon = 180.0;
+GeographicBounds CoordinateMapper::CalculateVisibleGeographicBounds(
+    const World& camera_world,
+    const glm::mat4& view_matrix,
+    const glm::mat4& proj_matrix,
+    float globe_radius) noexcept {
+
+    // Do not remove, this is for elevation testing
+    // return GetEverestGeoBounds();
+
+    const VisibleRegion region =
+        CalculateVisibleRegion(camera_world, view_matrix, proj_matrix, globe_radius);
+    if (region.IsEmpty()) {
+        return GeographicBounds();
     }
 
+    constexpr double kMaxLatitude = WebMercatorProjection::MAX_LATITUDE;
     return GeographicBounds(
-        Geographic(min_lat, min_lon, 0.0),
-        Geographic(max_lat, max_lon, 0.0)
-    );
+        Geographic(std::clamp(region.bounds.min.latitude, -kMaxLatitude, kMaxLatitude),
+                   region.bounds.min.longitude, 0.0),
+        Geographic(std::clamp(region.bounds.max.latitude, -kMaxLatitude, kMaxLatitude),
+                   region.bounds.max.longitude, 0.0));
+}
+
+VisibleRegion CoordinateMapper::CalculateVisibleRegion(const World& camera_world,
+                                                       const Frustum& frustum,
+                                                       float globe_radius) {
+    // Work on the unit globe
+    const glm::dvec3 camera = glm::dvec3(camera_world.position) / static_cast<double>(globe_radius);
+    const double camera_distance = glm::length(camera);
+    if (!(globe_radius > 0.0f) || camera_distance <= 1.0) {
+        return VisibleRegion();
+    }
+
+    // In front of the limb: p · camera >= 1 for points p of the unit globe
+    std::vector<SurfaceConstraint> constraints;
+    constraints.push_back({camera / camera_distance, -1.0 / camera_distance});
+    for (const Plane& plane : frustum.planes) {
+        const glm::dvec3 normal(plane.normal);
+        const double length = glm::length(normal);
+        if (length <= 0.0) {
+            continue;
+        }
+        constraints.push_back({normal / length,
+                               static_cast<double>(plane.distance) / (length * globe_radius)});
+    }
+    return BuildRegion(std::move(constraints));
+}
+
+VisibleRegion CoordinateMapper::CalculateVisibleRegion(const World& camera_world,
+                                                       const glm::mat4& view_matrix,
+                                                       const glm::mat4& proj_matrix,
+                                                       float globe_radius) {
+    return CalculateVisibleRegion(camera_world, Frustum(proj_matrix * view_matrix), globe_radius);
 }
 
 // ============================================================================
@@ -0,0 +1,274 @@
+/**
+ * @file geoid_grid.cpp
+ * @brief Memory-mapped geoid grid loading and interpolation
+ */
+
+#include "../../include/earth_map/coordinates/geoid_grid.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace earth_map {
+namespace coordinates {
+
+namespace {
+
+/// Batches smaller than this sample the mapping directly
+constexpr std::size_t kMinCachedBatch = 64;
+
+/**
+ * @brief Header of a GeographicLib geoid PGM
+ */
+struct PgmHeader {
+    std::size_t width = 0;
+    std::size_t height = 0;
+    std::size_t max_value = 0;
+    std::size_t data_offset = 0;
+    double offset = std::numeric_limits<double>::quiet_NaN();
+    double scale = std::numeric_limits<double>::quiet_NaN();
+};
+
+/**
+ * @brief Parse the text header of a binary PGM, with its Offset/Scale comments
+ *
+ * @return True if the header is complete
+ */
+bool ParsePgmHeader(std::string_view data, PgmHeader& header) {
+    if (data.substr(0, 2) != "P5") {
+        return false;
+    }
+    std::size_t pos = 2;
+    std::size_t* const fields[] = {&header.width, &header.height, &header.max_value};
+    for (std::size_t* field : fields) {
+        for (;;) {
+            while (pos < data.size() && std::isspace(static_cast<unsigned char>(data[pos]))) {
+                ++pos;
+            }
+            if (pos >= data.size() || data[pos] != '#') {
+                break;
+            }
+            const std::size_t end = std::min(data.find('\n', pos), data.size());
+            const std::string comment(data.substr(pos + 1, end - pos - 1));
+            double value = 0.0;
+            if (std::sscanf(comment.c_str(), " Offset %lf", &value) == 1) {
+                header.offset = value;
+            } else if (std::sscanf(comment.c_str(), " Scale %lf", &value) == 1) {
+                header.scale = value;
+            }
+            pos = end;
+        }
+        if (pos >= data.size() || !std::isdigit(static_cast<unsigned char>(data[pos]))) {
+            return false;
+        }
+        char* end = nullptr;
+        const std::string digits(data.substr(pos, std::min<std::size_t>(20, data.size() - pos)));
+        *field = std::strtoul(digits.c_str(), &end, 10);
+        pos += static_cast<std::size_t>(end - digits.c_str());
+    }
+    // A single whitespace byte separates the header from the samples
+    if (pos >= data.size() || !std::isspace(static_cast<unsigned char>(data[pos]))) {
+        return false;
+    }
+    header.data_offset = pos + 1;
+    return !std::isnan(header.offset) && !std::isnan(header.scale);
+}
+
+/// Catmull-Rom weights for a fraction t in [0, 1)
+std::array<double, 4> CubicWeights(double t) {
+    const double t2 = t * t;
+    const double t3 = t2 * t;
+    return {
+        0.5 * (-t3 + 2.0 * t2 - t),
+        0.5 * (3.0 * t3 - 5.0 * t2 + 2.0),
+        0.5 * (-3.0 * t3 + 4.0 * t2 + t),
+        0.5 * (t3 - t2)
+    };
+}
+
+/**
+ * @brief Interpolate the grid at a location from a sample accessor
+ *
+ * @param fetch Returns the height in meters at (row, column); columns are
+ *        already wrapped and rows clamped
+ */
+template <typename Fetch>
+double Interpolate(double latitude, double longitude, GeoidInterpolation interpolation,
+                   std::size_t width, std::size_t height, double resolution,
+                   Fetch&& fetch) {
+    const double wrapped = longitude - 360.0 * std::floor(longitude / 360.0);
+    const double fx = wrapped / resolution;
+    const double fy = (90.0 - std::clamp(latitude, -90.0, 90.0)) / resolution;
+    const auto column0 = std::min(static_cast<std::size_t>(fx), width - 1);
+    const auto row0 = std::min(static_cast<std::size_t>(fy), height - 2);
+    const double tx = std::clamp(fx - static_cast<double>(column0), 0.0, 1.0);
+    const double ty = std::clamp(fy - static_cast<double>(row0), 0.0, 1.0);
+    const auto column = [width, column0](std::ptrdiff_t delta) {
+        return static_cast<std::size_t>(
+            (static_cast<std::ptrdiff_t>(column0 + width) + delta) % static_cast<std::ptrdiff_t>(width));
+    };
+
+    if (interpolation == GeoidInterpolation::BILINEAR) {
+        const double top = fetch(row0, column(0)) * (1.0 - tx) + fetch(row0, column(1)) * tx;
+        const double bottom = fetch(row0 + 1, column(0)) * (1.0 - tx) + fetch(row0 + 1, column(1)) * tx;
+        return top * (1.0 - ty) + bottom * ty;
+    }
+
+    const std::array<double, 4> wx = CubicWeights(tx);
+    const std::array<double, 4> wy = CubicWeights(ty);
+    double sum = 0.0;
+    for (std::ptrdiff_t i = 0; i < 4; ++i) {
+        const auto row = static_cast<std::size_t>(std::clamp<std::ptrdiff_t>(
+            static_cast<std::ptrdiff_t>(row0) + i - 1, 0, static_cast<std::ptrdiff_t>(height) - 1));
+        double row_sum = 0.0;
+        for (std::ptrdiff_t j = 0; j < 4; ++j) {
+            row_sum += wx[static_cast<std::size_t>(j)] * fetch(row, column(j - 1));
+        }
+        sum += wy[static_cast<std::size_t>(i)] * row_sum;
+    }
+    return sum;
+}
+
+} // namespace
+
+/**
+ * @brief Decoded float tiles of the grid, direct-mapped by tile position
+ *
+ * Lives for one batch call, so it needs no locking.
+ */
+class GeoidGrid::TileCache {
+public:
+    explicit TileCache(const GeoidGrid& grid)
+        : grid_(grid),
+          tiles_per_row_((grid.width_ + kCacheTileSize - 1) / kCacheTileSize),
+          storage_(kCacheTileCount * kCacheTileSize * kCacheTileSize) {
+        tags_.fill(std::numeric_limits<std::size_t>::max());
+    }
+
+    double operator()(std::size_t row, std::size_t column) {
+        const std::size_t tile_row = row / kCacheTileSize;
+        const std::size_t tile_column = column / kCacheTileSize;
+        const std::size_t tag = tile_row * tiles_per_row_ + tile_column;
+        // Vertically adjacent tiles land in different slots
+        const std::size_t slot = (tile_row * 5 + tile_column) % kCacheTileCount;
+        float* tile = storage_.data() + slot * kCacheTileSize * kCacheTileSize;
+        if (tags_[slot] != tag) {
+            Fill(tile, tile_row, tile_column);
+            tags_[slot] = tag;
+        }
+        return tile[(row % kCacheTileSize) * kCacheTileSize + column % kCacheTileSize];
+    }
+
+private:
+    void Fill(float* tile, std::size_t tile_row, std::size_t tile_column) const {
+        const std::size_t row_begin = tile_row * kCacheTileSize;
+        const std::size_t column_begin = tile_column * kCacheTileSize;
+        const std::size_t rows = std::min(kCacheTileSize, grid_.height_ - row_begin);
+        const std::size_t columns = std::min(kCacheTileSize, grid_.width_ - column_begin);
+        for (std::size_t r = 0; r < rows; ++r) {
+            for (std::size_t c = 0; c < columns; ++c) {
+                tile[r * kCacheTileSize + c] = static_cast<float>(
+                    grid_.offset_ + grid_.scale_ * grid_.RawSample(row_begin + r, column_begin + c));
+            }
+        }
+    }
+
+    const GeoidGrid& grid_;
+    const std::size_t tiles_per_row_;
+    std::array<std::size_t, kCacheTileCount> tags_;
+    std::vector<float> storage_;
+};
+
+std::shared_ptr<const GeoidGrid> GeoidGrid::Load(const std::string& file_path) {
+    const int fd = ::open(file_path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat file_stat {};
+    if (::fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    const auto size = static_cast<std::size_t>(file_stat.st_size);
+    void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        return nullptr;
+    }
+    // Samples are read around scattered locations, not streamed
+    ::madvise(address, size, MADV_RANDOM);
+
+    std::shared_ptr<GeoidGrid> grid(new GeoidGrid());
+    grid->mapping_ = address;
+    grid->mapping_size_ = size;
+
+    PgmHeader header;
+    const std::string_view bytes(static_cast<const char*>(address), std::min<std::size_t>(size, 4096));
+    if (!ParsePgmHeader(bytes, header) || header.max_value != 65535 || header.width < 4 ||
+        header.height < 4) {
+        return nullptr;
+    }
+    // The grid covers all longitudes once and both poles
+    const double resolution = 360.0 / static_cast<double>(header.width);
+    if (std::abs(resolution * static_cast<double>(header.height - 1) - 180.0) > 1e-9 ||
+        header.data_offset + 2 * header.width * header.height > size) {
+        return nullptr;
+    }
+
+    grid->samples_ = static_cast<const uint8_t*>(address) + header.data_offset;
+    grid->width_ = header.width;
+    grid->height_ = header.height;
+    grid->resolution_ = resolution;
+    grid->offset_ = header.offset;
+    grid->scale_ = header.scale;
+    return grid;
+}
+
+GeoidGrid::~GeoidGrid() {
+    if (mapping_ != nullptr) {
+        ::munmap(mapping_, mapping_size_);
+    }
+}
+
+double GeoidGrid::Sample(double latitude, double longitude,
+                         GeoidInterpolation interpolation) const noexcept {
+    return Interpolate(latitude, longitude, interpolation, width_, height_, resolution_,
+                       [this](std::size_t row, std::size_t column) {
+                           return offset_ + scale_ * RawSample(row, column);
+                       });
+}
+
+void GeoidGrid::SampleBatch(std::span<const double> latitudes,
+                            std::span<const double> longitudes,
+                            std::span<double> heights,
+                            GeoidInterpolation interpolation) const {
+    if (longitudes.size() != latitudes.size() || heights.size() != latitudes.size()) {
+        throw std::invalid_argument("GeoidGrid::SampleBatch: span sizes differ");
+    }
+    if (latitudes.size() < kMinCachedBatch) {
+        for (std::size_t i = 0; i < latitudes.size(); ++i) {
+            heights[i] = Sample(latitudes[i], longitudes[i], interpolation);
+        }
+        return;
+    }
+
+    TileCache cache(*this);
+    for (std::size_t i = 0; i < latitudes.size(); ++i) {
+        heights[i] = Interpolate(latitudes[i], longitudes[i], interpolation,
+                                 width_, height_, resolution_, cache);
+    }
+}
+
+} // namespace coordinates
+} // namespace earth_map
@@ -61,10 +61,12 @@ public:
     
     void SetGeographicPosition(double longitude, double latitude, double altitude) override {
         camera_->SetGeographicPosition(longitude, latitude, altitude);
+        ResetVelocity();
     }
     
     void SetPosition(const glm::vec3& position) override {
         camera_->SetPosition(position);
+        ResetVelocity();
     }
     
     glm::vec3 GetPosition() const override {
@@ -130,6 +132,10 @@ public:
          return glm::normalize(glm::vec3(-view[0][2], -view[1][2], -view[2][2]));
      }
 
+     glm::vec3 GetVelocity() const override {
+         return velocity_;
+     }
+
      void SetProjectionType(CameraProjectionType projection_type) override {
         // Recreate camera with new projection type
         switch (projection_type) {
@@ -145,6 +151,7 @@ public:
         if (initialized_) {
             camera_->Initialize();
         }
+        ResetVelocity();
     }
     
     CameraProjectionType GetProjectionType() const override {
@@ -161,11 +168,21 @@ public:
     
     void Update(float delta_time) override {
         camera_->Update(delta_time);
+
+        // Displacement since the previous update covers both animation and
+        // input handled between updates
+        const glm::vec3 position = camera_->GetPosition();
+        if (delta_time > 0.0f) {
+            const glm::vec3 instant = (position - last_position_) / delta_time;
+            velocity_ = glm::mix(velocity_, instant, kVelocitySmoothing);
+        }
+        last_position_ = position;
     }
 
     void Reset() override {
         // Let the base Camera::Reset() handle everything
         camera_->Reset();
+        ResetVelocity();
     }
 
     bool ProcessInput(const InputEvent& event) override {
@@ -174,9 +191,22 @@ public:
     }
 
 private:
+    /// Weight of the newest sample in the smoothed velocity
+    static constexpr float kVelocitySmoothing = 0.5f;
+
+    /**
+     * @brief Treat the current position as a jump, not motion
+     */
+    void ResetVelocity() {
+        last_position_ = camera_->GetPosition();
+        velocity_ = glm::vec3(0.0f);
+    }
+
     Configuration config_;
     bool initialized_ = false;
     std::unique_ptr<Camera> camera_;
+    glm::vec3 last_position_{0.0f};
+    glm::vec3 velocity_{0.0f};
 };
 
 // Factory function implementation
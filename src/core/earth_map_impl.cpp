@@ -4,14 +4,52 @@
 #include <earth_map/core/scene_manager.h>
 #include <earth_map/core/camera_controller.h>
 #include <earth_map/data/tile_manager.h>
+#include <earth_map/data/elevation_provider.h>
+#include <earth_map/renderer/elevation_manager.h>
+#include <earth_map/renderer/shader_loader.h>
+#include <earth_map/renderer/shader_program_cache.h>
 #include <earth_map/platform/library_info.h>
+#include <earth_map/platform/opengl_context.h>
 #include <spdlog/spdlog.h>
+#include <chrono>
+#include <filesystem>
 #include <stdexcept>
 
 namespace earth_map {
 
+namespace {
+
+double MillisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+constexpr std::size_t kBytesPerMb = 1024 * 1024;
+
+/// Rebalancing never takes a cache below this share of its initial size
+constexpr double kMinConsumerFraction = 0.25;
+
+/// Shed first what is cheapest to reload: encoded tiles come back from
+/// disk, elevation tiles are decoded again, pool tiles are uploaded again
+constexpr int kTileCacheShedOrder = 0;
+constexpr int kElevationCacheShedOrder = 1;
+constexpr int kTilePoolShedOrder = 2;
+
+MemoryBudgetConfig MakeMemoryBudgetConfig(const Configuration& config) {
+    MemoryBudgetConfig budget;
+    budget.ram_budget_bytes = config.max_cache_memory_mb * kBytesPerMb;
+    // 0: the tile pool keeps the VRAM budget it sized itself with
+    budget.vram_budget_bytes = 0;
+    return budget;
+}
+
+} // namespace
+
 EarthMapImpl::EarthMapImpl(const Configuration& config) 
-    : config_(config) {
+    : config_(config),
+      frames_total_(&metrics_.GetCounter("earth_map_frames_total", "Frames rendered")),
+      frame_time_(&metrics_.GetHistogram("earth_map_frame_time_ms", "CPU time per rendered frame")),
+      memory_budget_(MakeMemoryBudgetConfig(config)) {
     spdlog::info("Creating Earth Map instance v{}", LibraryInfo::GetVersion());
     
     if (!ValidateConfiguration(config)) {
@@ -21,6 +59,13 @@ EarthMapImpl::EarthMapImpl(const Configuration& config)
 
 EarthMapImpl::~EarthMapImpl() {
     spdlog::info("Destroying Earth Map instance");
+    // A tile backend still being built captures this
+    if (tile_backend_.valid()) {
+        tile_backend_.wait();
+    }
+    for (const std::size_t id : metric_collectors_) {
+        metrics_.RemoveCollector(id);
+    }
     renderer_.reset();
     scene_manager_.reset();
     camera_controller_.reset();
@@ -33,6 +78,7 @@ bool EarthMapImpl::Initialize() {
     }
     
     spdlog::info("Initializing Earth Map systems");
+    init_start_ = std::chrono::steady_clock::now();
     
     try {
         if (!InitializeSubsystems()) {
@@ -56,8 +102,23 @@ void EarthMapImpl::Render() {
         return;
     }
     
+    PollTileSystem();
+    memory_budget_.Poll();
+
+    if (scene_manager_) {
+        scene_manager_->Update();
+    }
+    
     if (renderer_) {
         renderer_->Render();
+        frames_total_->Increment();
+        frame_time_->Record(renderer_->GetStats().frame_time_ms);
+        if (!first_frame_rendered_) {
+            first_frame_rendered_ = true;
+            metrics_.GetGauge("earth_map_time_to_first_frame_ms",
+                              "Time from Initialize() to the end of the first frame")
+                .Set(MillisecondsSince(init_start_));
+        }
     }
 }
 
@@ -92,7 +153,6 @@ bool EarthMapImpl::LoadData(const std::string& file_path) {
     
     spdlog::info("Loading data from: {}", file_path);
     
-    // TODO: Implement data loading once scene manager and data parser are ready
     if (scene_manager_) {
         return scene_manager_->LoadData(file_path);
     }
@@ -137,20 +197,366 @@ std::string EarthMapImpl::GetPerformanceStats() const {
         return R"({"fps": 0, "frame_time_ms": 0, "draw_calls": 0})";
     }
     
-    // TODO: Implement proper performance monitoring
-    return R"({"fps": 60, "frame_time_ms": 16.67, "draw_calls": 1})";
+    const RenderStats stats = renderer_->GetStats();
+    std::string passes;
+    for (std::size_t pass = 0; pass < kRenderPassCount; ++pass) {
+        passes += fmt::format(R"({}"{}": {{"cpu_ms": {:.3f}, "gpu_ms": {:.3f}}})",
+                              pass > 0 ? ", " : "",
+                              GetRenderPassName(static_cast<RenderPass>(pass)),
+                              stats.pass_timings[pass].cpu_ms, stats.pass_timings[pass].gpu_ms);
+    }
+    return fmt::format(
+        R"({{"fps": {}, "frame_time_ms": {:.3f}, "gpu_frame_time_ms": {:.3f}, "draw_calls": {}, "quality_level": {}, "resolution_scale": {:.2f}, "passes": {{{}}}}})",
+        stats.frames_per_second, stats.frame_time_ms, stats.gpu_frame_time_ms,
+        stats.draw_calls, stats.quality_level, stats.resolution_scale, passes);
+}
+
+MetricsRegistry& EarthMapImpl::GetMetrics() {
+    return metrics_;
+}
+
+std::string EarthMapImpl::ExportMetrics(MetricsFormat format) const {
+    return format == MetricsFormat::JSON ? metrics_.ExportJson() : metrics_.ExportPrometheus();
+}
+
+void EarthMapImpl::RegisterMetricCollectors() {
+    metric_collectors_.push_back(metrics_.AddCollector([this](MetricsSnapshot& out) {
+        if (!renderer_) {
+            return;
+        }
+        const RenderStats stats = renderer_->GetStats();
+        out.AddGauge("earth_map_fps", "Frames rendered in the last second", stats.frames_per_second);
+        out.AddGauge("earth_map_gpu_frame_time_ms", "GPU time of the last measured frame",
+                     stats.gpu_frame_time_ms);
+        out.AddGauge("earth_map_draw_calls", "Draw calls in the last frame", stats.draw_calls);
+        out.AddGauge("earth_map_triangles", "Triangles rendered in the last frame",
+                     stats.triangles_rendered);
+        out.AddGauge("earth_map_gpu_buffer_bytes", "GPU buffer memory in use",
+                     static_cast<double>(stats.gpu_memory_mb) * 1024.0 * 1024.0);
+        out.AddGauge("earth_map_quality_level", "Adaptive quality level (0 = full quality)",
+                     stats.quality_level);
+        for (std::size_t pass = 0; pass < kRenderPassCount; ++pass) {
+            const char* name = GetRenderPassName(static_cast<RenderPass>(pass));
+            out.AddGauge("earth_map_pass_cpu_ms", "CPU time of a render pass in the last frame",
+                         stats.pass_timings[pass].cpu_ms, {{"pass", name}});
+            out.AddGauge("earth_map_pass_gpu_ms", "GPU time of a render pass in the last measured frame",
+                         stats.pass_timings[pass].gpu_ms, {{"pass", name}});
+        }
+
+        if (TileRenderer* tile_renderer = renderer_->GetTileRenderer()) {
+            const TileRenderStats tiles = tile_renderer->GetStats();
+            out.AddGauge("earth_map_visible_tiles", "Tiles selected for the view", tiles.visible_tiles);
+            out.AddGauge("earth_map_tile_uploads_per_second", "Tile texture uploads per second",
+                         tiles.uploads_per_second);
+            out.AddCounter("earth_map_upload_budget_overruns_total",
+                           "Frames whose tile uploads exceeded the upload budget",
+                           static_cast<double>(tiles.upload_budget_overruns));
+            out.AddCounter("earth_map_prefetch_deferred_tiles_total",
+                           "Prefetch candidates deferred by the bandwidth or memory budget",
+                           static_cast<double>(tiles.prefetch_deferred_tiles));
+        }
+
+        if (ElevationManager* elevation = renderer_->GetElevationManager()) {
+            if (const ElevationProvider* provider = elevation->GetElevationProvider()) {
+                const ElevationCacheStats cache = provider->GetCacheStatistics();
+                out.AddCounter("earth_map_elevation_cache_hits_total", "Elevation cache hits",
+                               static_cast<double>(cache.memory_cache_hits), {{"level", "memory"}});
+                out.AddCounter("earth_map_elevation_cache_hits_total", "Elevation cache hits",
+                               static_cast<double>(cache.disk_cache_hits), {{"level", "disk"}});
+                out.AddCounter("earth_map_elevation_cache_misses_total", "Elevation cache misses",
+                               static_cast<double>(cache.cache_misses));
+                out.AddGauge("earth_map_elevation_cache_bytes", "Elevation cache size",
+                             static_cast<double>(cache.memory_cache_size_bytes), {{"level", "memory"}});
+                out.AddGauge("earth_map_elevation_cache_bytes", "Elevation cache size",
+                             static_cast<double>(cache.disk_cache_size_bytes), {{"level", "disk"}});
+
+                const SRTMLoaderStats loader = provider->GetLoaderStatistics();
+                out.AddCounter("earth_map_srtm_tiles_loaded_total", "SRTM tiles loaded",
+                               static_cast<double>(loader.tiles_loaded));
+                out.AddCounter("earth_map_srtm_tiles_failed_total", "SRTM tiles that failed to load",
+                               static_cast<double>(loader.tiles_failed));
+                out.AddCounter("earth_map_srtm_downloaded_bytes_total", "SRTM bytes downloaded",
+                               static_cast<double>(loader.bytes_downloaded));
+                out.AddGauge("earth_map_srtm_pending_loads", "SRTM loads in flight",
+                             static_cast<double>(loader.pending_loads));
+            }
+        }
+    }));
+
+    metric_collectors_.push_back(metrics_.AddCollector([this](MetricsSnapshot& out) {
+        if (!texture_coordinator_) {
+            return;
+        }
+        const TileUploadStats uploads = texture_coordinator_->GetUploadStats();
+        out.AddCounter("earth_map_tile_uploads_total", "Tile texture uploads",
+                       static_cast<double>(uploads.total_uploads));
+        out.AddGauge("earth_map_tile_staged_uploads", "Tile uploads waiting for the GL thread",
+                     static_cast<double>(uploads.staged_uploads));
+        if (const auto shader_cache = ShaderLoader::GetProgramCache()) {
+            const ShaderProgramCacheStats shaders = shader_cache->GetStats();
+            const auto add_programs = [&](const char* result, std::uint64_t count) {
+                out.AddCounter("earth_map_shader_programs_total",
+                               "Shader programs created, by binary cache result",
+                               static_cast<double>(count), {{"result", result}});
+            };
+            add_programs("hit", shaders.hits);
+            add_programs("miss", shaders.misses);
+            add_programs("rejected", shaders.rejected);
+        }
+        if (texture_coordinator_->IsTracingTiles()) {
+            out.AddHistogram("earth_map_tile_time_to_render_ms",
+                             "Time from tile request to first render (traced tiles)",
+                             texture_coordinator_->GetTraceStats().time_to_render);
+        }
+    }));
+}
+
+void EarthMapImpl::RegisterTileBackendCollectors(std::shared_ptr<TileCache> tile_cache,
+                                                 std::shared_ptr<TileLoader> tile_loader) {
+    metric_collectors_.push_back(metrics_.AddCollector([tile_cache](MetricsSnapshot& out) {
+        const TileCacheStats stats = tile_cache->GetStatistics();
+        const auto add_level = [&](const char* level, std::size_t hits, std::size_t misses,
+                                   std::size_t bytes, std::size_t count) {
+            out.AddCounter("earth_map_tile_cache_hits_total", "Tile cache hits",
+                           static_cast<double>(hits), {{"level", level}});
+            out.AddCounter("earth_map_tile_cache_misses_total", "Tile cache misses",
+                           static_cast<double>(misses), {{"level", level}});
+            out.AddGauge("earth_map_tile_cache_bytes", "Tile cache size",
+                         static_cast<double>(bytes), {{"level", level}});
+            out.AddGauge("earth_map_tile_cache_tiles", "Tiles in the cache",
+                         static_cast<double>(count), {{"level", level}});
+        };
+        add_level("memory", stats.memory_cache_hits, stats.memory_cache_misses,
+                  stats.memory_cache_size, stats.memory_cache_count);
+        add_level("disk", stats.disk_cache_hits, stats.disk_cache_misses,
+                  stats.disk_cache_size, stats.disk_cache_count);
+        out.AddCounter("earth_map_tile_cache_evictions_total", "Tiles evicted from the cache",
+                       static_cast<double>(stats.total_evictions));
+        out.AddCounter("earth_map_tile_cache_corruptions_total", "Corrupt cached tiles dropped",
+                       static_cast<double>(stats.total_corruptions));
+        out.AddGauge("earth_map_tile_cache_pending_writes", "Tiles waiting for the write-behind thread",
+                     static_cast<double>(stats.pending_disk_writes));
+    }));
+
+    metric_collectors_.push_back(metrics_.AddCollector([tile_loader](MetricsSnapshot& out) {
+        const TileLoaderStats stats = tile_loader->GetStatistics();
+        const auto add_requests = [&](const char* result, std::size_t count) {
+            out.AddCounter("earth_map_tile_requests_total", "Tile load requests by result",
+                           static_cast<double>(count), {{"result", result}});
+        };
+        add_requests("success", stats.successful_requests);
+        add_requests("failure", stats.failed_requests);
+        add_requests("cached", stats.cached_requests);
+        add_requests("coalesced", stats.coalesced_requests);
+        add_requests("not_modified", stats.not_modified_responses);
+        add_requests("circuit_rejected", stats.circuit_rejected_requests);
+        out.AddCounter("earth_map_tile_retries_total", "Tile downloads retried",
+                       static_cast<double>(stats.retried_requests));
+        out.AddCounter("earth_map_tile_hedged_requests_total", "Tile downloads raced against a mirror",
+                       static_cast<double>(stats.hedged_requests));
+        out.AddCounter("earth_map_tile_downloaded_bytes_total", "Tile bytes downloaded",
+                       static_cast<double>(stats.total_bytes_downloaded));
+        out.AddGauge("earth_map_tile_active_downloads", "Tile downloads in flight",
+                     static_cast<double>(stats.active_downloads));
+        out.AddGauge("earth_map_tile_queued_downloads", "Tile downloads waiting for a connection",
+                     static_cast<double>(stats.queued_downloads));
+        for (const auto& [host, latency] : stats.host_latency) {
+            out.AddHistogram("earth_map_tile_download_latency_ms", "Tile download latency per host",
+                             latency, {{"host", host}});
+        }
+    }));
+}
+
+void EarthMapImpl::RegisterElevationMemoryConsumer() {
+    ElevationManager* elevation = renderer_->GetElevationManager();
+    if (!elevation || !elevation->GetElevationProvider()) {
+        return;
+    }
+
+    // The provider is created with the default cache configuration
+    const std::size_t initial_bytes = ElevationCacheConfig{}.max_memory_cache_size;
+    MemoryConsumer consumer;
+    consumer.name = "elevation_cache";
+    consumer.tier = MemoryTier::RAM;
+    consumer.initial_bytes = initial_bytes;
+    consumer.min_bytes =
+        static_cast<std::size_t>(static_cast<double>(initial_bytes) * kMinConsumerFraction);
+    consumer.shed_order = kElevationCacheShedOrder;
+    consumer.sample = [elevation] {
+        const ElevationCacheStats stats = elevation->GetElevationProvider()->GetCacheStatistics();
+        return MemoryConsumerUsage{stats.memory_cache_size_bytes, stats.memory_cache_hits,
+                                   stats.cache_misses};
+    };
+    consumer.set_budget = [elevation](std::size_t bytes) {
+        elevation->GetElevationProvider()->SetMemoryCacheBudget(bytes);
+    };
+    memory_budget_.Register(std::move(consumer));
+}
+
+void EarthMapImpl::RegisterTileMemoryConsumers(std::shared_ptr<TileCache> tile_cache) {
+    const std::size_t cache_bytes = tile_cache->GetConfiguration().max_memory_cache_size;
+    MemoryConsumer cache;
+    cache.name = "tile_cache";
+    cache.tier = MemoryTier::RAM;
+    cache.initial_bytes = cache_bytes;
+    cache.min_bytes =
+        static_cast<std::size_t>(static_cast<double>(cache_bytes) * kMinConsumerFraction);
+    cache.shed_order = kTileCacheShedOrder;
+    cache.sample = [tile_cache] {
+        const TileCacheStats stats = tile_cache->GetStatistics();
+        return MemoryConsumerUsage{stats.memory_cache_size, stats.memory_cache_hits,
+                                   stats.memory_cache_misses};
+    };
+    cache.set_budget = [tile_cache](std::size_t bytes) {
+        TileCacheConfig config = tile_cache->GetConfiguration();
+        config.max_memory_cache_size = bytes;
+        tile_cache->SetConfiguration(config);
+    };
+    memory_budget_.Register(std::move(cache));
+
+    // Every pool miss is a tile upload; Poll() runs on the GL thread
+    TileTextureCoordinator* coordinator = texture_coordinator_.get();
+    const std::size_t pool_bytes = coordinator->GetVramBudget();
+    MemoryConsumer pool;
+    pool.name = "tile_pool";
+    pool.tier = MemoryTier::VRAM;
+    pool.initial_bytes = pool_bytes;
+    pool.min_bytes =
+        static_cast<std::size_t>(static_cast<double>(pool_bytes) * kMinConsumerFraction);
+    pool.shed_order = kTilePoolShedOrder;
+    pool.sample = [coordinator] {
+        return MemoryConsumerUsage{coordinator->GetVramUsage(), 0,
+                                   coordinator->GetUploadStats().total_uploads};
+    };
+    pool.set_budget = [coordinator](std::size_t bytes) { coordinator->SetVramBudget(bytes); };
+    pool.shed = [coordinator](std::size_t bytes) { coordinator->ShedTiles(bytes); };
+    memory_budget_.Register(std::move(pool));
+
+    metric_collectors_.push_back(metrics_.AddCollector([this](MetricsSnapshot& out) {
+        for (const MemoryConsumerStatus& status : memory_budget_.GetStatus()) {
+            const MetricLabels labels = {
+                {"consumer", status.name},
+                {"tier", status.tier == MemoryTier::RAM ? "ram" : "vram"}};
+            out.AddGauge("earth_map_memory_budget_bytes", "Memory budget of a cache",
+                         static_cast<double>(status.budget_bytes), labels);
+            out.AddGauge("earth_map_memory_used_bytes", "Memory held by a cache",
+                         static_cast<double>(status.used_bytes), labels);
+        }
+    }));
+}
+
+EarthMapImpl::TileBackend EarthMapImpl::BuildTileBackend() const {
+    TileBackend backend;
+
+    // Initialize tile management system
+    backend.tile_manager = CreateTileManager();
+    if (!backend.tile_manager || !backend.tile_manager->Initialize({})) {
+        throw std::runtime_error("Failed to initialize tile manager");
+    }
+
+    // Create shared cache and loader for both tile manager and texture coordinator
+    TileCacheConfig cache_config;
+    if (!config_.cache_directory.empty()) {
+        cache_config.disk_cache_directory =
+            (std::filesystem::path(config_.cache_directory) / "tiles").string();
+    }
+    backend.cache = std::shared_ptr<TileCache>(CreateTileCache(cache_config).release());
+    // TODO: remove double config passing (constructor and Initialize)
+    backend.cache->Initialize(cache_config);
+    backend.loader = std::shared_ptr<TileLoader>(CreateTileLoader().release());
+    backend.loader->Initialize({});
+
+    // Set tile provider
+    if (config_.tile_provider) {
+        backend.loader->AddProvider(config_.tile_provider);
+        backend.loader->SetDefaultProvider(config_.tile_provider->GetName());
+    } else {
+        backend.loader->AddProvider(TileProviders::OpenStreetMap);
+        backend.loader->SetDefaultProvider("OpenStreetMap");
+    }
+
+    if (!config_.basemap_pack.empty()) {
+        backend.basemap = DecodeBasemapPack(config_.basemap_pack, config_.basemap_max_zoom);
+    }
+    return backend;
+}
+
+void EarthMapImpl::FinishTileSystem(TileBackend backend) {
+    tile_manager_ = std::move(backend.tile_manager);
+
+    // Downloads run on the loader's event loop; decode threads scale
+    // with the number of cores
+    texture_coordinator_ = std::make_unique<TileTextureCoordinator>(
+        backend.cache,
+        backend.loader,
+        0,
+        false,
+        config_.compress_tile_textures ? TileTextureFormat::BC1 : TileTextureFormat::RGBA8,
+        config_.mipmap_tile_textures
+    );
+    texture_coordinator_->SetMaxAnisotropy(
+        config_.render_settings.enable_anisotropic_filtering
+            ? static_cast<float>(config_.render_settings.max_anisotropy)
+            : 1.0f);
+
+    // Resident before the first tile request, so every fallback chain ends at one
+    if (!backend.basemap.empty()) {
+        texture_coordinator_->AddResidentTiles(backend.basemap);
+        backend.basemap.clear();
+    }
+
+    // The shared context is created here, on the thread owning the window
+    if (config_.async_tile_uploads) {
+        auto upload_context = OpenGLContext::CreateSharedWithCurrent();
+        if (upload_context) {
+            texture_coordinator_->StartUploadThread(std::move(upload_context));
+        }
+    }
+
+    spdlog::info("Tile texture coordinator initialized with lock-free architecture");
+    RegisterTileBackendCollectors(backend.cache, backend.loader);
+    RegisterTileMemoryConsumers(backend.cache);
+
+    // Connect tile system components
+    renderer_->SetTileSystem(tile_manager_.get(), texture_coordinator_.get());
+    spdlog::info("Tile system initialized with new lock-free texture coordinator");
+
+    metrics_.GetGauge("earth_map_init_stage_ms", "Time from Initialize() to each subsystem being ready",
+                      {{"stage", "tiles"}})
+        .Set(MillisecondsSince(init_start_));
+}
+
+void EarthMapImpl::PollTileSystem() {
+    if (!tile_backend_.valid() ||
+        tile_backend_.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return;
+    }
+
+    // The globe renders without tiles if their backend failed
+    try {
+        FinishTileSystem(tile_backend_.get());
+    } catch (const std::exception& e) {
+        spdlog::error("Exception during tile system initialization: {}", e.what());
+    }
 }
 
 bool EarthMapImpl::InitializeSubsystems() {
     spdlog::info("Initializing subsystems");
     
     try {
+        // The tile manager, cache index and provider setup need no GL
+        // context: build them on a worker while the renderer starts here
+        tile_backend_ = std::async(std::launch::async, [this] { return BuildTileBackend(); });
+
         // Initialize renderer first
         renderer_ = Renderer::Create(config_);
         if (!renderer_ || !renderer_->Initialize()) {
             spdlog::error("Failed to create or initialize renderer");
             return false;
         }
+        metrics_.GetGauge("earth_map_init_stage_ms", "Time from Initialize() to each subsystem being ready",
+                          {{"stage", "renderer"}})
+            .Set(MillisecondsSince(init_start_));
         
         // Initialize scene manager
         scene_manager_.reset(CreateSceneManager(config_));
@@ -167,47 +573,17 @@ bool EarthMapImpl::InitializeSubsystems() {
         }
 
         renderer_->SetCameraController(camera_controller_.get());
-        
-        // Initialize tile management system
-        tile_manager_ = CreateTileManager();
-        if (!tile_manager_ || !tile_manager_->Initialize({})) {
-            spdlog::error("Failed to initialize tile manager");
-            return false;
-        }
+        RegisterMetricCollectors();
+        RegisterElevationMemoryConsumer();
 
-        // Initialize tile texture coordinator (new lock-free architecture)
-        // Create shared cache and loader for both tile manager and texture coordinator
-        auto tile_cache = std::shared_ptr<TileCache>(CreateTileCache().release());
-        // TODO: remove double config passing (constructor and Initialize)
-        tile_cache->Initialize({});
-        auto tile_loader = std::shared_ptr<TileLoader>(CreateTileLoader().release());
-        tile_loader->Initialize({});
-
-        // Set tile provider
-        if (config_.tile_provider) {
-            tile_loader->AddProvider(config_.tile_provider);
-            tile_loader->SetDefaultProvider(config_.tile_provider->GetName());
-        } else {
-            tile_loader->AddProvider(TileProviders::OpenStreetMap);
-            tile_loader->SetDefaultProvider("OpenStreetMap");
+        // Progressive start: the first frames draw the bare globe and
+        // Render() attaches the tiles once the worker is done
+        if (config_.progressive_initialization) {
+            spdlog::info("Core subsystems initialized, tile system loading in background");
+            return true;
         }
 
-        texture_coordinator_ = std::make_unique<TileTextureCoordinator>(
-            tile_cache,
-            tile_loader,
-            4  // 4 worker threads for tile loading
-        );
-
-        spdlog::info("Tile texture coordinator initialized with lock-free architecture");
-
-        // Connect tile system components
-        auto tile_renderer = renderer_->GetTileRenderer();
-        if (tile_renderer) {
-            tile_renderer->SetTileManager(tile_manager_.get());
-            tile_renderer->SetTextureCoordinator(texture_coordinator_.get());
-            spdlog::info("Tile system initialized with new lock-free texture coordinator");
-        }
-        
+        FinishTileSystem(tile_backend_.get());
         spdlog::info("All subsystems initialized successfully");
         return true;
         
@@ -0,0 +1,39 @@
+#include <earth_map/core/frame_arena.h>
+#include <algorithm>
+#include <bit>
+
+namespace earth_map {
+
+FrameArena::FrameArena(std::size_t initial_capacity)
+    : block_(std::make_unique_for_overwrite<std::byte[]>(std::max<std::size_t>(initial_capacity, 1))),
+      capacity_(std::max<std::size_t>(initial_capacity, 1)) {
+    resource_.emplace(block_.get(), capacity_, &overflow_);
+}
+
+void FrameArena::Reset() {
+    // Destroying the resource hands its overflow blocks back to the heap
+    resource_.reset();
+    if (overflow_.bytes > 0) {
+        capacity_ = std::bit_ceil(capacity_ + overflow_.bytes);
+        block_ = std::make_unique_for_overwrite<std::byte[]>(capacity_);
+        overflow_.bytes = 0;
+    }
+    resource_.emplace(block_.get(), capacity_, &overflow_);
+}
+
+void* FrameArena::OverflowResource::do_allocate(std::size_t size, std::size_t alignment) {
+    bytes += size;
+    return std::pmr::new_delete_resource()->allocate(size, alignment);
+}
+
+void FrameArena::OverflowResource::do_deallocate(void* p, std::size_t size,
+                                                 std::size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(p, size, alignment);
+}
+
+bool FrameArena::OverflowResource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+} // namespace earth_map
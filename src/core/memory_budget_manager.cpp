@@ -0,0 +1,299 @@
+/**
+ * @file memory_budget_manager.cpp
+ * @brief Shared RAM and VRAM budget implementation
+ */
+
+#include <earth_map/core/memory_budget_manager.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace earth_map {
+
+namespace {
+
+constexpr double kBytesPerMb = 1024.0 * 1024.0;
+
+/// A consumer holding this much of its budget has no room to spare
+constexpr double kFullFraction = 0.9;
+
+/// MODERATE pressure stops shedding once this fraction of the held bytes is gone
+constexpr double kModerateReleaseFraction = 0.25;
+
+} // namespace
+
+MemoryBudgetManager::MemoryBudgetManager(const MemoryBudgetConfig& config) : config_(config) {
+    config_.rebalance_step = std::clamp(config_.rebalance_step, 0.0, 1.0);
+    config_.rebalance_hysteresis = std::max(config_.rebalance_hysteresis, 1.0);
+    if (!config_.pressure_source) {
+        config_.pressure_source = [moderate = config_.moderate_available_fraction,
+                                   critical = config_.critical_available_fraction]() {
+            return ReadSystemMemoryPressure(moderate, critical);
+        };
+    }
+}
+
+MemoryBudgetManager::ConsumerId MemoryBudgetManager::Register(MemoryConsumer consumer) {
+    if (!consumer.sample || !consumer.set_budget) {
+        throw std::invalid_argument("MemoryConsumer needs sample and set_budget callbacks");
+    }
+    consumer.max_bytes = std::max(consumer.max_bytes, consumer.min_bytes);
+    Entry entry;
+    entry.id = next_id_++;
+    entry.last_misses = consumer.sample().misses;
+    entry.consumer = std::move(consumer);
+    const MemoryTier tier = entry.consumer.tier;
+    entries_.push_back(std::move(entry));
+    Distribute(tier);
+    return entries_.back().id;
+}
+
+void MemoryBudgetManager::Unregister(ConsumerId id) {
+    const auto it = std::find_if(entries_.begin(), entries_.end(),
+                                 [id](const Entry& entry) { return entry.id == id; });
+    if (it == entries_.end()) {
+        return;
+    }
+    const MemoryTier tier = it->consumer.tier;
+    entries_.erase(it);
+    Distribute(tier);
+}
+
+std::size_t& MemoryBudgetManager::TierBudget(MemoryTier tier) {
+    return tier == MemoryTier::RAM ? config_.ram_budget_bytes : config_.vram_budget_bytes;
+}
+
+void MemoryBudgetManager::SetTierBudget(MemoryTier tier, std::size_t bytes) {
+    TierBudget(tier) = bytes;
+    Distribute(tier);
+}
+
+std::size_t MemoryBudgetManager::GetTierBudget(MemoryTier tier) const {
+    const std::size_t configured =
+        tier == MemoryTier::RAM ? config_.ram_budget_bytes : config_.vram_budget_bytes;
+    if (configured > 0) {
+        return configured;
+    }
+    std::size_t total = 0;
+    for (const Entry& entry : entries_) {
+        if (entry.consumer.tier == tier) {
+            total += entry.consumer.initial_bytes;
+        }
+    }
+    return total;
+}
+
+void MemoryBudgetManager::Distribute(MemoryTier tier) {
+    const double total = static_cast<double>(GetTierBudget(tier));
+    double weights = 0.0;
+    std::size_t count = 0;
+    for (const Entry& entry : entries_) {
+        if (entry.consumer.tier == tier) {
+            weights += static_cast<double>(entry.consumer.initial_bytes);
+            ++count;
+        }
+    }
+    for (Entry& entry : entries_) {
+        if (entry.consumer.tier != tier) {
+            continue;
+        }
+        // Consumers registered without a size share evenly
+        const double share = weights > 0.0
+            ? static_cast<double>(entry.consumer.initial_bytes) / weights
+            : 1.0 / static_cast<double>(count);
+        entry.budget = std::clamp(static_cast<std::size_t>(total * share),
+                                  entry.consumer.min_bytes, entry.consumer.max_bytes);
+        entry.consumer.set_budget(entry.budget);
+    }
+}
+
+std::size_t MemoryBudgetManager::Rebalance() {
+    std::size_t changed = 0;
+    for (const MemoryTier tier : {MemoryTier::RAM, MemoryTier::VRAM}) {
+        changed += RebalanceTier(tier) ? 1 : 0;
+    }
+    return changed;
+}
+
+bool MemoryBudgetManager::RebalanceTier(MemoryTier tier) {
+    Entry* donor = nullptr;
+    Entry* receiver = nullptr;
+    for (Entry& entry : entries_) {
+        if (entry.consumer.tier != tier) {
+            continue;
+        }
+        const MemoryConsumerUsage usage = entry.consumer.sample();
+        const std::uint64_t misses = usage.misses - std::min(usage.misses, entry.last_misses);
+        entry.last_misses = usage.misses;
+        const bool full = static_cast<double>(usage.used_bytes) >=
+                          kFullFraction * static_cast<double>(entry.budget);
+        entry.gain = full ? static_cast<double>(misses) /
+                                std::max(static_cast<double>(entry.budget) / kBytesPerMb, 1.0)
+                          : 0.0;
+
+        if (entry.budget > entry.consumer.min_bytes &&
+            (!donor || entry.gain < donor->gain)) {
+            donor = &entry;
+        }
+        if (entry.budget < entry.consumer.max_bytes && entry.gain > 0.0 &&
+            (!receiver || entry.gain > receiver->gain)) {
+            receiver = &entry;
+        }
+    }
+    if (!donor || !receiver || donor == receiver ||
+        receiver->gain <= donor->gain * config_.rebalance_hysteresis) {
+        return false;
+    }
+
+    const auto step = static_cast<std::size_t>(static_cast<double>(GetTierBudget(tier)) *
+                                               config_.rebalance_step);
+    const std::size_t moved = std::min({step, donor->budget - donor->consumer.min_bytes,
+                                        receiver->consumer.max_bytes - receiver->budget});
+    if (moved == 0) {
+        return false;
+    }
+    donor->budget -= moved;
+    receiver->budget += moved;
+    // Shrink first, so the tier never holds more than its budget
+    donor->consumer.set_budget(donor->budget);
+    receiver->consumer.set_budget(receiver->budget);
+    spdlog::debug("Memory budget: moved {} KB from {} to {} ({:.2f} vs {:.2f} misses/MB)",
+                  moved / 1024, donor->consumer.name, receiver->consumer.name, donor->gain,
+                  receiver->gain);
+    return true;
+}
+
+std::size_t MemoryBudgetManager::OnMemoryPressure(MemoryPressure level) {
+    if (level == MemoryPressure::NONE) {
+        return 0;
+    }
+
+    std::vector<Entry*> order;
+    std::size_t held = 0;
+    for (Entry& entry : entries_) {
+        order.push_back(&entry);
+        held += entry.consumer.sample().used_bytes;
+    }
+    // RAM before VRAM within one shed order
+    std::stable_sort(order.begin(), order.end(), [](const Entry* a, const Entry* b) {
+        if (a->consumer.shed_order != b->consumer.shed_order) {
+            return a->consumer.shed_order < b->consumer.shed_order;
+        }
+        return a->consumer.tier < b->consumer.tier;
+    });
+
+    const auto goal = level == MemoryPressure::CRITICAL
+        ? held
+        : static_cast<std::size_t>(static_cast<double>(held) * kModerateReleaseFraction);
+    std::size_t released = 0;
+    for (Entry* entry : order) {
+        if (released >= goal && level != MemoryPressure::CRITICAL) {
+            break;
+        }
+        const std::size_t before = entry->consumer.sample().used_bytes;
+        const std::size_t target = level == MemoryPressure::CRITICAL
+            ? entry->consumer.min_bytes
+            : std::max(before / 2, entry->consumer.min_bytes);
+        if (before <= target) {
+            continue;
+        }
+        if (entry->consumer.shed) {
+            entry->consumer.shed(target);
+        } else {
+            entry->consumer.set_budget(target);
+            entry->consumer.set_budget(entry->budget);
+        }
+        const std::size_t after = entry->consumer.sample().used_bytes;
+        released += before - std::min(before, after);
+    }
+
+    spdlog::info("Memory pressure ({}): released {} MB of {} MB held",
+                 level == MemoryPressure::CRITICAL ? "critical" : "moderate",
+                 released / (1024 * 1024), held / (1024 * 1024));
+    return released;
+}
+
+void MemoryBudgetManager::Poll(std::chrono::steady_clock::time_point now) {
+    if (now - last_pressure_check_ >= config_.pressure_interval) {
+        last_pressure_check_ = now;
+        const MemoryPressure pressure = config_.pressure_source();
+        if (pressure != MemoryPressure::NONE) {
+            OnMemoryPressure(pressure);
+            // Shed caches look like they have room: do not hand them more
+            last_rebalance_ = now;
+            for (Entry& entry : entries_) {
+                entry.last_misses = entry.consumer.sample().misses;
+            }
+            return;
+        }
+    }
+    if (now - last_rebalance_ >= config_.rebalance_interval) {
+        last_rebalance_ = now;
+        Rebalance();
+    }
+}
+
+std::vector<MemoryConsumerStatus> MemoryBudgetManager::GetStatus() const {
+    std::vector<MemoryConsumerStatus> status;
+    status.reserve(entries_.size());
+    for (const Entry& entry : entries_) {
+        MemoryConsumerStatus item;
+        item.name = entry.consumer.name;
+        item.tier = entry.consumer.tier;
+        item.budget_bytes = entry.budget;
+        item.used_bytes = entry.consumer.sample().used_bytes;
+        item.gain = entry.gain;
+        status.push_back(std::move(item));
+    }
+    return status;
+}
+
+std::size_t MemoryBudgetManager::GetUsedBytes(MemoryTier tier) const {
+    std::size_t used = 0;
+    for (const Entry& entry : entries_) {
+        if (entry.consumer.tier == tier) {
+            used += entry.consumer.sample().used_bytes;
+        }
+    }
+    return used;
+}
+
+MemoryPressure MemoryBudgetManager::ReadSystemMemoryPressure(double moderate_fraction,
+                                                             double critical_fraction) {
+#if defined(__linux__)
+    std::ifstream meminfo("/proc/meminfo");
+    std::string key;
+    std::uint64_t value = 0;
+    std::string unit;
+    std::uint64_t total = 0;
+    std::uint64_t available = 0;
+    bool has_available = false;
+    while (meminfo >> key >> value) {
+        std::getline(meminfo, unit);
+        if (key == "MemTotal:") {
+            total = value;
+        } else if (key == "MemAvailable:") {
+            available = value;
+            has_available = true;
+        }
+    }
+    if (total == 0 || !has_available) {
+        return MemoryPressure::NONE;
+    }
+    const double fraction = static_cast<double>(available) / static_cast<double>(total);
+    if (fraction < critical_fraction) {
+        return MemoryPressure::CRITICAL;
+    }
+    if (fraction < moderate_fraction) {
+        return MemoryPressure::MODERATE;
+    }
+#else
+    (void)moderate_fraction;
+    (void)critical_fraction;
+#endif
+    return MemoryPressure::NONE;
+}
+
+} // namespace earth_map
@@ -0,0 +1,341 @@
+/**
+ * @file metrics_registry.cpp
+ * @brief Metrics registry and its JSON and Prometheus exporters
+ */
+
+#include <earth_map/core/metrics_registry.h>
+#include <fmt/format.h>
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace earth_map {
+
+namespace {
+
+constexpr std::array<const char*, 3> kTypeNames = {"counter", "gauge", "histogram"};
+
+/// Every Nth LatencyHistogram bucket becomes a Prometheus bucket
+constexpr std::size_t kPrometheusBucketStride = 4;
+
+/// Numbers as JSON and Prometheus accept them: integers without a fraction
+std::string FormatNumber(double value) {
+    if (!std::isfinite(value)) {
+        return "0";
+    }
+    return fmt::format("{}", value);
+}
+
+std::string EscapeJson(const std::string& text) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (const char c : text) {
+        switch (c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            case '\t': escaped += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    escaped += fmt::format("\\u{:04x}", static_cast<unsigned>(c));
+                } else {
+                    escaped += c;
+                }
+        }
+    }
+    return escaped;
+}
+
+/// Label values escape backslash, quote and newline; help text only backslash and newline
+std::string EscapePrometheus(const std::string& text, bool quote) {
+    std::string escaped;
+    escaped.reserve(text.size());
+    for (const char c : text) {
+        if (c == '\\') {
+            escaped += "\\\\";
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else if (c == '"' && quote) {
+            escaped += "\\\"";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+/**
+ * @brief Write {a="1",b="2"}, with an optional extra label appended
+ */
+void WritePrometheusLabels(std::ostream& out, const MetricLabels& labels,
+                           const char* extra_name = nullptr, const std::string& extra_value = {}) {
+    if (labels.empty() && extra_name == nullptr) {
+        return;
+    }
+    out << '{';
+    bool first = true;
+    for (const auto& [name, value] : labels) {
+        out << (first ? "" : ",") << name << "=\"" << EscapePrometheus(value, true) << '"';
+        first = false;
+    }
+    if (extra_name != nullptr) {
+        out << (first ? "" : ",") << extra_name << "=\"" << extra_value << '"';
+    }
+    out << '}';
+}
+
+void WritePrometheusHistogram(std::ostream& out, const MetricSample& sample) {
+    const LatencyHistogram& histogram = sample.histogram;
+    std::uint64_t cumulative = 0;
+    for (std::size_t bucket = 0; bucket + 1 < LatencyHistogram::kBucketCount; ++bucket) {
+        cumulative += histogram.GetBucketCount(bucket);
+        if ((bucket + 1) % kPrometheusBucketStride != 0) {
+            continue;
+        }
+        out << sample.name << "_bucket";
+        WritePrometheusLabels(out, sample.labels, "le",
+                              FormatNumber(LatencyHistogram::GetBucketUpperBound(bucket)));
+        out << ' ' << cumulative << '\n';
+    }
+    out << sample.name << "_bucket";
+    WritePrometheusLabels(out, sample.labels, "le", "+Inf");
+    out << ' ' << histogram.GetCount() << '\n';
+
+    out << sample.name << "_sum";
+    WritePrometheusLabels(out, sample.labels);
+    out << ' ' << FormatNumber(histogram.GetSum()) << '\n';
+    out << sample.name << "_count";
+    WritePrometheusLabels(out, sample.labels);
+    out << ' ' << histogram.GetCount() << '\n';
+}
+
+void AtomicMax(std::atomic<double>& target, double value) {
+    double current = target.load(std::memory_order_relaxed);
+    while (value > current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+const char* GetMetricTypeName(MetricType type) {
+    return kTypeNames[static_cast<std::size_t>(type)];
+}
+
+std::size_t GetMetricShard() {
+    static std::atomic<std::size_t> next_shard{0};
+    thread_local const std::size_t shard =
+        next_shard.fetch_add(1, std::memory_order_relaxed) % kMetricShards;
+    return shard;
+}
+
+std::uint64_t CounterMetric::GetValue() const {
+    std::uint64_t total = 0;
+    for (const Shard& shard : shards_) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void HistogramMetric::Record(double value_ms) {
+    value_ms = std::max(value_ms, 0.0);
+    Shard& shard = shards_[GetMetricShard()];
+    shard.buckets[LatencyHistogram::GetBucket(value_ms)].fetch_add(1, std::memory_order_relaxed);
+    shard.sum_ms.fetch_add(value_ms, std::memory_order_relaxed);
+    AtomicMax(shard.max_ms, value_ms);
+}
+
+LatencyHistogram HistogramMetric::Snapshot() const {
+    std::array<std::uint64_t, LatencyHistogram::kBucketCount> buckets{};
+    double sum_ms = 0.0;
+    double max_ms = 0.0;
+    for (const Shard& shard : shards_) {
+        for (std::size_t bucket = 0; bucket < buckets.size(); ++bucket) {
+            buckets[bucket] += shard.buckets[bucket].load(std::memory_order_relaxed);
+        }
+        sum_ms += shard.sum_ms.load(std::memory_order_relaxed);
+        max_ms = std::max(max_ms, shard.max_ms.load(std::memory_order_relaxed));
+    }
+    return LatencyHistogram::FromBuckets(buckets, sum_ms, max_ms);
+}
+
+void MetricsSnapshot::AddCounter(std::string name, std::string help, double value,
+                                 MetricLabels labels) {
+    samples_.push_back({std::move(name), std::move(help), MetricType::COUNTER,
+                        std::move(labels), value, {}});
+}
+
+void MetricsSnapshot::AddGauge(std::string name, std::string help, double value,
+                               MetricLabels labels) {
+    samples_.push_back({std::move(name), std::move(help), MetricType::GAUGE,
+                        std::move(labels), value, {}});
+}
+
+void MetricsSnapshot::AddHistogram(std::string name, std::string help,
+                                   const LatencyHistogram& histogram, MetricLabels labels) {
+    samples_.push_back({std::move(name), std::move(help), MetricType::HISTOGRAM,
+                        std::move(labels), 0.0, histogram});
+}
+
+const MetricSample* MetricsSnapshot::Find(const std::string& name,
+                                          const MetricLabels& labels) const {
+    const auto it = std::find_if(samples_.begin(), samples_.end(), [&](const MetricSample& sample) {
+        return sample.name == name && sample.labels == labels;
+    });
+    return it != samples_.end() ? &*it : nullptr;
+}
+
+void MetricsSnapshot::WriteJson(std::ostream& out) const {
+    out << "{\"metrics\":[";
+    bool first = true;
+    for (const MetricSample& sample : samples_) {
+        out << (first ? "" : ",") << "\n{\"name\":\"" << EscapeJson(sample.name)
+            << "\",\"type\":\"" << GetMetricTypeName(sample.type)
+            << "\",\"help\":\"" << EscapeJson(sample.help) << "\",\"labels\":{";
+        bool first_label = true;
+        for (const auto& [name, value] : sample.labels) {
+            out << (first_label ? "" : ",") << '"' << EscapeJson(name) << "\":\""
+                << EscapeJson(value) << '"';
+            first_label = false;
+        }
+        out << '}';
+        if (sample.type == MetricType::HISTOGRAM) {
+            const LatencyHistogram& histogram = sample.histogram;
+            out << ",\"count\":" << histogram.GetCount()
+                << ",\"sum\":" << FormatNumber(histogram.GetSum())
+                << ",\"max\":" << FormatNumber(histogram.GetMax())
+                << ",\"p50\":" << FormatNumber(histogram.GetPercentile(0.5))
+                << ",\"p95\":" << FormatNumber(histogram.GetPercentile(0.95))
+                << ",\"p99\":" << FormatNumber(histogram.GetPercentile(0.99));
+        } else {
+            out << ",\"value\":" << FormatNumber(sample.value);
+        }
+        out << '}';
+        first = false;
+    }
+    out << "\n]}\n";
+}
+
+void MetricsSnapshot::WritePrometheus(std::ostream& out) const {
+    // Group series by name, metrics in order of their first series
+    std::vector<std::string> names;
+    std::map<std::string, std::vector<const MetricSample*>> by_name;
+    for (const MetricSample& sample : samples_) {
+        auto& series = by_name[sample.name];
+        if (series.empty()) {
+            names.push_back(sample.name);
+        }
+        series.push_back(&sample);
+    }
+
+    for (const std::string& name : names) {
+        const std::vector<const MetricSample*>& series = by_name[name];
+        const MetricSample& head = *series.front();
+        out << "# HELP " << name << ' ' << EscapePrometheus(head.help, false) << '\n';
+        out << "# TYPE " << name << ' ' << GetMetricTypeName(head.type) << '\n';
+        for (const MetricSample* sample : series) {
+            if (sample->type == MetricType::HISTOGRAM) {
+                WritePrometheusHistogram(out, *sample);
+                continue;
+            }
+            out << name;
+            WritePrometheusLabels(out, sample->labels);
+            out << ' ' << FormatNumber(sample->value) << '\n';
+        }
+    }
+}
+
+void MetricsRegistry::ClaimName(const std::string& name, MetricType type) {
+    const auto [it, inserted] = types_.emplace(name, type);
+    if (!inserted && it->second != type) {
+        throw std::invalid_argument("MetricsRegistry: " + name + " is already a " +
+                                    GetMetricTypeName(it->second));
+    }
+}
+
+CounterMetric& MetricsRegistry::GetCounter(const std::string& name, const std::string& help,
+                                           const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ClaimName(name, MetricType::COUNTER);
+    auto [it, inserted] = series_.try_emplace(SeriesKey(name, labels));
+    if (inserted) {
+        it->second = Series{help, &counters_.emplace_back()};
+    }
+    return *std::get<CounterMetric*>(it->second.metric);
+}
+
+GaugeMetric& MetricsRegistry::GetGauge(const std::string& name, const std::string& help,
+                                       const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ClaimName(name, MetricType::GAUGE);
+    auto [it, inserted] = series_.try_emplace(SeriesKey(name, labels));
+    if (inserted) {
+        it->second = Series{help, &gauges_.emplace_back()};
+    }
+    return *std::get<GaugeMetric*>(it->second.metric);
+}
+
+HistogramMetric& MetricsRegistry::GetHistogram(const std::string& name, const std::string& help,
+                                               const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ClaimName(name, MetricType::HISTOGRAM);
+    auto [it, inserted] = series_.try_emplace(SeriesKey(name, labels));
+    if (inserted) {
+        it->second = Series{help, &histograms_.emplace_back()};
+    }
+    return *std::get<HistogramMetric*>(it->second.metric);
+}
+
+std::size_t MetricsRegistry::AddCollector(Collector collector) {
+    std::lock_guard<std::mutex> lock(collector_mutex_);
+    const std::size_t id = next_collector_id_++;
+    collectors_.emplace(id, std::move(collector));
+    return id;
+}
+
+void MetricsRegistry::RemoveCollector(std::size_t id) {
+    std::lock_guard<std::mutex> lock(collector_mutex_);
+    collectors_.erase(id);
+}
+
+MetricsSnapshot MetricsRegistry::Collect() const {
+    MetricsSnapshot snapshot;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [key, series] : series_) {
+            const auto& [name, labels] = key;
+            if (const auto* counter = std::get_if<CounterMetric*>(&series.metric)) {
+                snapshot.AddCounter(name, series.help,
+                                    static_cast<double>((*counter)->GetValue()), labels);
+            } else if (const auto* gauge = std::get_if<GaugeMetric*>(&series.metric)) {
+                snapshot.AddGauge(name, series.help, (*gauge)->GetValue(), labels);
+            } else {
+                snapshot.AddHistogram(name, series.help,
+                                      std::get<HistogramMetric*>(series.metric)->Snapshot(),
+                                      labels);
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(collector_mutex_);
+    for (const auto& [id, collector] : collectors_) {
+        collector(snapshot);
+    }
+    return snapshot;
+}
+
+std::string MetricsRegistry::ExportJson() const {
+    std::ostringstream out;
+    Collect().WriteJson(out);
+    return out.str();
+}
+
+std::string MetricsRegistry::ExportPrometheus() const {
+    std::ostringstream out;
+    Collect().WritePrometheus(out);
+    return out.str();
+}
+
+} // namespace earth_map
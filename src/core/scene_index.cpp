@@ -0,0 +1,199 @@
+#include <earth_map/core/scene_index.h>
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace earth_map {
+
+SceneIndex::SceneIndex(std::size_t overlay_capacity)
+    : overlay_capacity_(std::max<std::size_t>(overlay_capacity, 1)) {
+    overlay_.reserve(overlay_capacity_);
+}
+
+void SceneIndex::Build(std::span<const SceneIndexEntry> entries) {
+    Clear();
+    if (!entries.empty()) {
+        trees_.push_back(MakeTree(std::vector<SceneIndexEntry>(entries.begin(), entries.end()), 0));
+    }
+}
+
+void SceneIndex::Insert(SceneObjectId id, const BoundingBox& box) {
+    Remove(id);
+    if (id >= locations_.size()) {
+        locations_.resize(static_cast<std::size_t>(id) + 1);
+    }
+    locations_[id] = {Location::OVERLAY, static_cast<std::uint32_t>(overlay_.size())};
+    overlay_.push_back({id, box});
+    ++count_;
+    if (overlay_.size() >= overlay_capacity_) {
+        FlushOverlay();
+    }
+}
+
+bool SceneIndex::Remove(SceneObjectId id) {
+    if (!Contains(id)) {
+        return false;
+    }
+    Location& location = locations_[id];
+    if (location.container == Location::OVERLAY) {
+        const std::uint32_t slot = location.slot;
+        if (slot + 1 != overlay_.size()) {
+            overlay_[slot] = overlay_.back();
+            locations_[overlay_[slot].id].slot = slot;
+        }
+        overlay_.pop_back();
+    } else {
+        // Left in its tree and skipped; a mostly dead tree is repacked
+        Tree& tree = trees_[location.container];
+        --tree.live;
+        if (tree.live * 2 < tree.entries.size() && tree.entries.size() >= overlay_capacity_) {
+            const std::uint32_t index = location.container;
+            location = {};
+            std::vector<SceneIndexEntry> live;
+            live.reserve(tree.live);
+            for (std::uint32_t slot = 0; slot < tree.entries.size(); ++slot) {
+                if (IsLive(index, slot, tree.entries[slot].id)) {
+                    live.push_back(tree.entries[slot]);
+                }
+            }
+            trees_[index] = MakeTree(std::move(live), index);
+        }
+    }
+    location = {};
+    --count_;
+    return true;
+}
+
+void SceneIndex::Clear() {
+    trees_.clear();
+    overlay_.clear();
+    locations_.clear();
+    count_ = 0;
+}
+
+bool SceneIndex::Contains(SceneObjectId id) const {
+    return id < locations_.size() && locations_[id].container != Location::NONE;
+}
+
+void SceneIndex::QueryVisible(const Frustum& frustum, std::vector<SceneObjectId>& objects) const {
+    for (std::uint32_t index = 0; index < trees_.size(); ++index) {
+        // Items are appended in place, then replaced by the ids of the live ones
+        const Tree& tree = trees_[index];
+        const std::size_t begin = objects.size();
+        tree.tree.Query(frustum, objects);
+        std::size_t end = begin;
+        for (std::size_t i = begin; i < objects.size(); ++i) {
+            const SceneObjectId id = tree.entries[objects[i]].id;
+            if (IsLive(index, objects[i], id)) {
+                objects[end++] = id;
+            }
+        }
+        objects.resize(end);
+    }
+    for (const SceneIndexEntry& entry : overlay_) {
+        if (frustum.Intersects(entry.box)) {
+            objects.push_back(entry.id);
+        }
+    }
+}
+
+void SceneIndex::Query(const BoundingBox& box, std::vector<SceneObjectId>& objects) const {
+    for (std::uint32_t index = 0; index < trees_.size(); ++index) {
+        const Tree& tree = trees_[index];
+        const std::size_t begin = objects.size();
+        tree.tree.Query(box, objects);
+        std::size_t end = begin;
+        for (std::size_t i = begin; i < objects.size(); ++i) {
+            const SceneObjectId id = tree.entries[objects[i]].id;
+            if (IsLive(index, objects[i], id)) {
+                objects[end++] = id;
+            }
+        }
+        objects.resize(end);
+    }
+    for (const SceneIndexEntry& entry : overlay_) {
+        if (entry.box.Intersects(box)) {
+            objects.push_back(entry.id);
+        }
+    }
+}
+
+std::optional<ScenePick> SceneIndex::Pick(const glm::vec3& origin, const glm::vec3& direction,
+                                          float radius) const {
+    std::optional<ScenePick> best;
+    for (std::uint32_t index = 0; index < trees_.size(); ++index) {
+        const Tree& tree = trees_[index];
+        const std::optional<RayHit> hit = tree.tree.Pick(
+            origin, direction, radius,
+            [&](std::uint32_t item) { return IsLive(index, item, tree.entries[item].id); },
+            best ? best->distance : std::numeric_limits<float>::max());
+        if (hit) {
+            best = ScenePick{tree.entries[hit->item].id, hit->distance};
+        }
+    }
+    for (const SceneIndexEntry& entry : overlay_) {
+        const std::optional<float> distance =
+            PackedHilbertRTree::PickDistance(entry.box, origin, direction, radius);
+        if (distance && (!best || *distance < best->distance)) {
+            best = ScenePick{entry.id, *distance};
+        }
+    }
+    return best;
+}
+
+void SceneIndex::Compact() {
+    if (trees_.size() + (overlay_.empty() ? 0 : 1) > 1) {
+        FlushOverlay(true);
+    }
+}
+
+void SceneIndex::FlushOverlay(bool merge_all) {
+    std::vector<SceneIndexEntry> entries = std::move(overlay_);
+    overlay_ = {};
+    overlay_.reserve(overlay_capacity_);
+
+    // Absorb the trees no larger than the new one, so sizes keep growing geometrically
+    while (!trees_.empty() && (merge_all || trees_.back().live <= entries.size())) {
+        const auto index = static_cast<std::uint32_t>(trees_.size() - 1);
+        const Tree& tree = trees_.back();
+        for (std::uint32_t slot = 0; slot < tree.entries.size(); ++slot) {
+            if (IsLive(index, slot, tree.entries[slot].id)) {
+                entries.push_back(tree.entries[slot]);
+            }
+        }
+        trees_.pop_back();
+    }
+    const auto index = static_cast<std::uint32_t>(trees_.size());
+    trees_.push_back(MakeTree(std::move(entries), index));
+}
+
+SceneIndex::Tree SceneIndex::MakeTree(std::vector<SceneIndexEntry> entries, std::uint32_t index) {
+    std::vector<BoundingBox> boxes;
+    boxes.reserve(entries.size());
+    for (std::uint32_t slot = 0; slot < entries.size(); ++slot) {
+        const SceneIndexEntry& entry = entries[slot];
+        boxes.push_back(entry.box);
+        if (entry.id >= locations_.size()) {
+            locations_.resize(static_cast<std::size_t>(entry.id) + 1);
+        }
+        if (locations_[entry.id].container == Location::NONE) {
+            ++count_;  // Bulk-loaded
+        }
+        locations_[entry.id] = {index, slot};
+    }
+
+    Tree tree;
+    tree.tree = PackedHilbertRTree(boxes);
+    for (std::uint32_t slot = 0; slot < entries.size(); ++slot) {
+        tree.live += IsLive(index, slot, entries[slot].id) ? 1 : 0;
+    }
+    tree.entries = std::move(entries);
+    return tree;
+}
+
+bool SceneIndex::IsLive(std::uint32_t container, std::uint32_t slot, SceneObjectId id) const {
+    const Location& location = locations_[id];
+    return location.container == container && location.slot == slot;
+}
+
+} // namespace earth_map
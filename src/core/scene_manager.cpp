@@ -1,10 +1,18 @@
 #include <earth_map/core/scene_manager.h>
 #include <earth_map/renderer/renderer.h>
+#include <earth_map/renderer/placemark_renderer.h>
+#include <earth_map/data/kml_loader.h>
+#include <earth_map/constants.h>
 #include <earth_map/earth_map.h>
 #include <spdlog/spdlog.h>
 #include <algorithm>
+#include <cctype>
+#include <filesystem>
 #include <fstream>
+#include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 namespace earth_map {
 
@@ -19,6 +27,8 @@ public:
     
     ~SceneManagerImpl() override {
         spdlog::info("Destroying scene manager");
+        // Stop the readers before the placemarks they feed go away
+        loads_.clear();
     }
     
     bool Initialize(Renderer* renderer) override {
@@ -45,6 +55,9 @@ public:
             return;
         }
         
+        // Hand placemarks parsed in the background to the renderer
+        UpdateLoads();
+        
         // Update scene objects, perform culling, etc.
             // Get camera and update tile visibility
         if (renderer_) {
@@ -67,34 +80,127 @@ public:
         
         spdlog::info("Loading scene data from: {}", file_path);
         
-        // TODO: Implement actual data loading based on file extension
-        // For now, just check if file exists
         std::ifstream file(file_path);
         if (!file.good()) {
             spdlog::error("Cannot open file: {}", file_path);
             return false;
         }
-        
         file.close();
-        spdlog::info("Data loading simulated for: {}", file_path);
+        
+        std::string extension = std::filesystem::path(file_path).extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (extension != ".kml" && extension != ".kmz") {
+            spdlog::error("Unsupported data format: {}", file_path);
+            return false;
+        }
+        
+        // Parsed on a background thread; placemarks appear batch by batch
+        loads_.push_back(std::make_unique<KmlLoadJob>(file_path));
         return true;
     }
     
     void Clear() override {
         spdlog::info("Clearing all scene data");
-        // TODO: Clear all scene objects
+        loads_.clear();
+        
+        PlacemarkRenderer* placemark_renderer =
+            renderer_ ? renderer_->GetPlacemarkRenderer() : nullptr;
+        if (placemark_renderer) {
+            PlacemarkStore& store = placemark_renderer->GetStore();
+            for (const PlacemarkId id : placemark_ids_) {
+                store.Remove(id);
+            }
+        }
+        placemark_ids_.clear();
+        index_.Clear();
         object_count_ = 0;
     }
     
     std::size_t GetObjectCount() const override {
         return object_count_;
     }
+    
+    void QueryVisible(const Frustum& frustum, std::vector<SceneObjectId>& objects) const override {
+        index_.QueryVisible(frustum, objects);
+    }
+    
+    std::optional<ScenePick> Pick(const glm::vec3& ray_origin, const glm::vec3& ray_direction,
+                                  float radius) const override {
+        return index_.Pick(ray_origin, ray_direction, radius);
+    }
 
 private:
+    /**
+     * @brief Move parsed placemarks into the placemark store
+     *
+     * Takes at most a few batches per load and frame, so a large file
+     * never stalls a frame; the readers block until their batches are taken.
+     */
+    void UpdateLoads() {
+        constexpr int MAX_BATCHES_PER_FRAME = 4;
+        
+        PlacemarkRenderer* placemark_renderer =
+            renderer_ ? renderer_->GetPlacemarkRenderer() : nullptr;
+        std::vector<KmlPlacemark> batch;
+        for (auto it = loads_.begin(); it != loads_.end();) {
+            KmlLoadJob& load = **it;
+            for (int i = 0; i < MAX_BATCHES_PER_FRAME && load.TakeBatch(batch); ++i) {
+                AddPlacemarks(placemark_renderer, batch);
+            }
+            if (!load.IsDone()) {
+                ++it;
+                continue;
+            }
+            
+            index_.Compact();
+            if (placemark_renderer) {
+                placemark_renderer->BuildClusters();
+            }
+            const std::string error = load.GetError();
+            if (error.empty()) {
+                spdlog::info("Loaded {} placemarks from {}", load.GetPlacemarkCount(),
+                             load.GetPath());
+            } else {
+                spdlog::error("Loading {} stopped after {} placemarks: {}", load.GetPath(),
+                              load.GetPlacemarkCount(), error);
+            }
+            it = loads_.erase(it);
+        }
+    }
+    
+    void AddPlacemarks(PlacemarkRenderer* placemark_renderer,
+                       const std::vector<KmlPlacemark>& batch) {
+        if (!placemark_renderer) {
+            return;
+        }
+        PlacemarkStore& store = placemark_renderer->GetStore();
+        if (!placemark_style_) {
+            placemark_style_ = store.AddStyle(PlacemarkStyle{});
+        }
+        
+        // Lines and polygons have no renderer yet: they show as their first vertex
+        for (const KmlPlacemark& placemark : batch) {
+            const coordinates::Geographic& position = placemark.coordinates.front();
+            const PlacemarkId id = store.Add(*placemark_style_, position);
+            placemark_ids_.push_back(id);
+            
+            const glm::vec3 world(PlacemarkStore::ToWorldMeters(position) /
+                                  constants::geodetic::EARTH_MEAN_RADIUS);
+            index_.Insert(id, BoundingBox(world, world));
+        }
+        object_count_ += batch.size();
+    }
+    
     Configuration config_;
     bool initialized_ = false;
     Renderer* renderer_ = nullptr;
     std::size_t object_count_ = 0;
+    
+    std::vector<std::unique_ptr<KmlLoadJob>> loads_;
+    std::optional<PlacemarkStyleId> placemark_style_;
+    std::vector<PlacemarkId> placemark_ids_;
+    SceneIndex index_;  ///< Placemarks by PlacemarkId, in world units
 };
 
 // Factory function - for now, create in the constructor
@@ -0,0 +1,296 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#include <earth_map/data/compressed_elevation_tile.h>
+
+#include <algorithm>
+#include <bit>
+
+namespace earth_map {
+
+namespace {
+
+/// Bits storing a block row's Rice parameter
+constexpr unsigned kParameterBits = 5;
+
+/// Largest useful Rice parameter (zigzag residuals have up to 17 bits)
+constexpr unsigned kMaxParameter = 16;
+
+/// Unary quotients from this length on escape to a raw residual
+constexpr unsigned kEscapeQuotient = 24;
+
+/// Bits of a raw (escaped) residual
+constexpr unsigned kRawResidualBits = 17;
+
+/// Median edge detector: the median of west, north and the gradient
+/// estimate west + north - north-west (branch-free)
+[[nodiscard]] int32_t Predict(int32_t west, int32_t north, int32_t north_west) noexcept {
+    return std::clamp(west + north - north_west, std::min(west, north), std::max(west, north));
+}
+
+/// Prediction of the sample at (x, y) of a block from its decoded neighbors:
+/// the first row predicts from the west, the first column from the north
+[[nodiscard]] int32_t PredictAt(const int16_t* samples, size_t stride, size_t x,
+                                size_t y) noexcept {
+    if (y == 0) {
+        return x == 0 ? 0 : samples[x - 1];
+    }
+    const int16_t* row = samples + y * stride;
+    const int16_t* above = row - stride;
+    if (x == 0) {
+        return above[0];
+    }
+    return Predict(row[x - 1], above[x], above[x - 1]);
+}
+
+[[nodiscard]] uint32_t ZigzagEncode(int32_t value) noexcept {
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+[[nodiscard]] int32_t ZigzagDecode(uint32_t value) noexcept {
+    return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+/// Append-only bit stream over 64-bit words
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<uint64_t>& words) : words_(words) {}
+
+    void Write(uint64_t value, unsigned width) {
+        if (width == 0) {
+            return;
+        }
+        const size_t word = position_ >> 6;
+        const unsigned shift = position_ & 63;
+        if (words_.size() < word + 2) {
+            words_.resize(word + 2, 0);
+        }
+        words_[word] |= value << shift;
+        if (shift + width > 64) {
+            words_[word + 1] |= value >> (64 - shift);
+        }
+        position_ += width;
+    }
+
+    /// Rice code: the quotient in unary (zeros ended by a one), then the
+    /// low @p parameter bits; long quotients escape to the raw value
+    void WriteRice(uint32_t value, unsigned parameter) {
+        const uint32_t quotient = value >> parameter;
+        if (quotient >= kEscapeQuotient) {
+            Write(uint64_t{1} << kEscapeQuotient, kEscapeQuotient + 1);
+            Write(value, kRawResidualBits);
+            return;
+        }
+        Write(uint64_t{1} << quotient, quotient + 1);
+        Write(value & ((uint32_t{1} << parameter) - 1), parameter);
+    }
+
+    [[nodiscard]] uint64_t Position() const noexcept { return position_; }
+
+private:
+    std::vector<uint64_t>& words_;
+    uint64_t position_ = 0;
+};
+
+/// The 64 bits starting at @p position (the stream is padded)
+[[nodiscard]] uint64_t PeekBits(const uint64_t* words, uint64_t position) noexcept {
+    const size_t word = position >> 6;
+    const unsigned shift = position & 63;
+    uint64_t value = words[word] >> shift;
+    if (shift > 0) {
+        value |= words[word + 1] << (64 - shift);
+    }
+    return value;
+}
+
+/// Sequential reader of a BitWriter stream through a 64-bit buffer, so
+/// consecutive codes do not each re-derive their word and shift
+class BitReader {
+public:
+    BitReader(const uint64_t* words, uint64_t position) noexcept
+        : words_(words), next_(position) {}
+
+    /// Read @p width (at most 41) bits
+    [[nodiscard]] uint32_t Read(unsigned width) noexcept {
+        Refill();
+        const auto value = static_cast<uint32_t>(buffer_ & ((uint64_t{1} << width) - 1));
+        Consume(width);
+        return value;
+    }
+
+    /// Read a value written by BitWriter::WriteRice
+    [[nodiscard]] uint32_t ReadRice(unsigned parameter) noexcept {
+        // Quotient, stop bit and remainder fit the refilled buffer (24 + 1 + 16)
+        Refill();
+        const auto quotient = static_cast<unsigned>(std::countr_zero(buffer_));
+        if (quotient >= kEscapeQuotient) {
+            Consume(kEscapeQuotient + 1);
+            return Read(kRawResidualBits);
+        }
+        const auto remainder =
+            static_cast<uint32_t>((buffer_ >> (quotient + 1)) & ((uint64_t{1} << parameter) - 1));
+        Consume(quotient + 1 + parameter);
+        return (quotient << parameter) | remainder;
+    }
+
+private:
+    /// Keep at least 41 bits buffered
+    void Refill() noexcept {
+        if (count_ < 41) {
+            buffer_ |= PeekBits(words_, next_) << count_;
+            next_ += 64 - count_;
+            count_ = 64;
+        }
+    }
+
+    void Consume(unsigned width) noexcept {
+        buffer_ >>= width;
+        count_ -= width;
+    }
+
+    const uint64_t* words_;
+    uint64_t next_;           ///< Position of the first bit not yet buffered
+    uint64_t buffer_ = 0;     ///< Buffered bits, next bit lowest
+    unsigned count_ = 0;      ///< Bits in buffer_
+};
+
+/// Rice parameter coding a block row in the fewest bits; the optimum lies
+/// near the bit width of the mean, so only its neighborhood is tried
+[[nodiscard]] unsigned ChooseRiceParameter(const uint32_t* values, size_t count) noexcept {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < count; ++i) {
+        sum += values[i];
+    }
+    const auto estimate = static_cast<unsigned>(std::bit_width(sum / std::max<size_t>(count, 1)));
+    const unsigned first = estimate > 2 ? estimate - 2 : 0;
+    const unsigned last = std::min(estimate + 1, kMaxParameter);
+
+    unsigned best = 0;
+    uint64_t best_bits = UINT64_MAX;
+    for (unsigned parameter = first; parameter <= last; ++parameter) {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const uint32_t quotient = values[i] >> parameter;
+            bits += quotient >= kEscapeQuotient ? kEscapeQuotient + 1 + kRawResidualBits
+                                                : quotient + 1 + parameter;
+        }
+        if (bits < best_bits) {
+            best_bits = bits;
+            best = parameter;
+        }
+    }
+    return best;
+}
+
+} // anonymous namespace
+
+CompressedElevationTile::CompressedElevationTile(const SRTMTileData& tile)
+    : metadata_(tile.GetMetadata()),
+      valid_(false),
+      blocks_per_side_((tile.GetMetadata().samples_per_side + kBlockSize - 1) / kBlockSize) {
+    const size_t size = metadata_.samples_per_side;
+    const auto samples = tile.GetSamples();
+    if (!tile.IsValid() || size == 0 || samples.size() < size * size) {
+        blocks_per_side_ = 0;
+        return;
+    }
+
+    BitWriter writer(bits_);
+    block_offsets_.reserve(blocks_per_side_ * blocks_per_side_);
+    uint32_t residuals[kBlockSize];
+    for (size_t block_y = 0; block_y < blocks_per_side_; ++block_y) {
+        for (size_t block_x = 0; block_x < blocks_per_side_; ++block_x) {
+            block_offsets_.push_back(writer.Position());
+            const int16_t* block =
+                samples.data() + block_y * kBlockSize * size + block_x * kBlockSize;
+            const size_t width = BlockExtent(block_x);
+            const size_t height = BlockExtent(block_y);
+
+            for (size_t y = 0; y < height; ++y) {
+                for (size_t x = 0; x < width; ++x) {
+                    const int32_t residual = block[y * size + x] - PredictAt(block, size, x, y);
+                    residuals[x] = ZigzagEncode(residual);
+                }
+                const unsigned parameter = ChooseRiceParameter(residuals, width);
+                writer.Write(parameter, kParameterBits);
+                for (size_t x = 0; x < width; ++x) {
+                    writer.WriteRice(residuals[x], parameter);
+                }
+            }
+        }
+    }
+
+    // Padding: BitReader buffers up to 40 bits ahead of its position and
+    // reads the word after that
+    bits_.resize(((writer.Position() + 63) >> 6) + 2, 0);
+    bits_.shrink_to_fit();
+    valid_ = true;
+}
+
+size_t CompressedElevationTile::GetSizeBytes() const noexcept {
+    return sizeof(*this) + (block_offsets_.capacity() + bits_.capacity()) * sizeof(uint64_t);
+}
+
+size_t CompressedElevationTile::BlockExtent(size_t block) const noexcept {
+    return std::min(kBlockSize, metadata_.samples_per_side - block * kBlockSize);
+}
+
+bool CompressedElevationTile::DecodeBlock(size_t block_x, size_t block_y,
+                                          std::span<int16_t> samples) const noexcept {
+    if (block_x >= blocks_per_side_ || block_y >= blocks_per_side_ ||
+        samples.size() < kBlockSize * kBlockSize) {
+        return false;
+    }
+    DecodeBlockInto(block_x, block_y, samples.data(), kBlockSize);
+    return true;
+}
+
+void CompressedElevationTile::DecodeBlockInto(size_t block_x, size_t block_y,
+                                              int16_t* samples,
+                                              size_t stride) const noexcept {
+    const size_t width = BlockExtent(block_x);
+    const size_t height = BlockExtent(block_y);
+    BitReader reader(bits_.data(), block_offsets_[block_y * blocks_per_side_ + block_x]);
+
+    for (size_t y = 0; y < height; ++y) {
+        const unsigned parameter = reader.Read(kParameterBits);
+        int16_t* row = samples + y * stride;
+        // The west neighbor stays in a register rather than reloading row[x - 1]
+        int32_t west = static_cast<int16_t>(PredictAt(samples, stride, 0, y) +
+                                            ZigzagDecode(reader.ReadRice(parameter)));
+        row[0] = static_cast<int16_t>(west);
+        if (y == 0) {
+            for (size_t x = 1; x < width; ++x) {
+                west = static_cast<int16_t>(west + ZigzagDecode(reader.ReadRice(parameter)));
+                row[x] = static_cast<int16_t>(west);
+            }
+            continue;
+        }
+        const int16_t* above = row - stride;
+        for (size_t x = 1; x < width; ++x) {
+            west = static_cast<int16_t>(Predict(west, above[x], above[x - 1]) +
+                                        ZigzagDecode(reader.ReadRice(parameter)));
+            row[x] = static_cast<int16_t>(west);
+        }
+    }
+}
+
+std::unique_ptr<SRTMTileData> CompressedElevationTile::Decompress() const {
+    auto tile = std::make_unique<SRTMTileData>(metadata_);
+    if (!valid_) {
+        return tile;
+    }
+
+    const size_t size = metadata_.samples_per_side;
+    int16_t* samples = tile->GetRawData().data();
+    for (size_t block_y = 0; block_y < blocks_per_side_; ++block_y) {
+        for (size_t block_x = 0; block_x < blocks_per_side_; ++block_x) {
+            DecodeBlockInto(block_x, block_y,
+                            samples + block_y * kBlockSize * size + block_x * kBlockSize, size);
+        }
+    }
+    tile->SetValid(true);
+    return tile;
+}
+
+} // namespace earth_map
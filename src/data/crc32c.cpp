@@ -0,0 +1,146 @@
+/**
+ * @file crc32c.cpp
+ * @brief CRC32C implementations and runtime dispatch
+ */
+
+#include <earth_map/data/crc32c.h>
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define EARTH_MAP_CRC32C_SSE42 1
+#include <nmmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#define EARTH_MAP_CRC32C_ARM 1
+#include <arm_acle.h>
+#endif
+
+namespace earth_map {
+
+namespace {
+
+constexpr std::uint32_t kPolynomial = 0x82F63B78u;  // Reflected Castagnoli
+
+using Table = std::array<std::array<std::uint32_t, 256>, 8>;
+
+constexpr Table MakeTable() {
+    Table table{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ ((crc & 1u) ? kPolynomial : 0u);
+        }
+        table[0][i] = crc;
+    }
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        for (std::size_t slice = 1; slice < 8; ++slice) {
+            const std::uint32_t previous = table[slice - 1][i];
+            table[slice][i] = (previous >> 8) ^ table[0][previous & 0xFFu];
+        }
+    }
+    return table;
+}
+
+constexpr Table kTable = MakeTable();
+
+#if defined(EARTH_MAP_CRC32C_SSE42)
+
+__attribute__((target("sse4.2")))
+std::uint32_t Crc32cSse42(std::span<const std::uint8_t> data, std::uint32_t crc) {
+    const std::uint8_t* bytes = data.data();
+    std::size_t size = data.size();
+    std::uint64_t state = ~crc;
+    while (size >= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        state = _mm_crc32_u64(state, word);
+        bytes += 8;
+        size -= 8;
+    }
+    auto state32 = static_cast<std::uint32_t>(state);
+    while (size-- > 0) {
+        state32 = _mm_crc32_u8(state32, *bytes++);
+    }
+    return ~state32;
+}
+
+bool DetectHardware() {
+    return __builtin_cpu_supports("sse4.2");
+}
+
+#elif defined(EARTH_MAP_CRC32C_ARM)
+
+std::uint32_t Crc32cArm(std::span<const std::uint8_t> data, std::uint32_t crc) {
+    const std::uint8_t* bytes = data.data();
+    std::size_t size = data.size();
+    std::uint32_t state = ~crc;
+    while (size >= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        state = __crc32cd(state, word);
+        bytes += 8;
+        size -= 8;
+    }
+    while (size-- > 0) {
+        state = __crc32cb(state, *bytes++);
+    }
+    return ~state;
+}
+
+bool DetectHardware() {
+    return true;  // Compiled for a CPU with the CRC32 extension
+}
+
+#else
+
+bool DetectHardware() {
+    return false;
+}
+
+#endif
+
+const bool kHardware = DetectHardware();
+
+} // namespace
+
+std::uint32_t Crc32cSoftware(std::span<const std::uint8_t> data, std::uint32_t crc) {
+    const std::uint8_t* bytes = data.data();
+    std::size_t size = data.size();
+    std::uint32_t state = ~crc;
+
+    // Slicing-by-8 (little-endian words): eight table lookups per 8-byte step
+    while (size >= 8) {
+        std::uint32_t low;
+        std::uint32_t high;
+        std::memcpy(&low, bytes, sizeof(low));
+        std::memcpy(&high, bytes + 4, sizeof(high));
+        low ^= state;
+        state = kTable[7][low & 0xFFu] ^ kTable[6][(low >> 8) & 0xFFu] ^
+                kTable[5][(low >> 16) & 0xFFu] ^ kTable[4][low >> 24] ^
+                kTable[3][high & 0xFFu] ^ kTable[2][(high >> 8) & 0xFFu] ^
+                kTable[1][(high >> 16) & 0xFFu] ^ kTable[0][high >> 24];
+        bytes += 8;
+        size -= 8;
+    }
+    while (size-- > 0) {
+        state = (state >> 8) ^ kTable[0][(state ^ *bytes++) & 0xFFu];
+    }
+    return ~state;
+}
+
+std::uint32_t Crc32c(std::span<const std::uint8_t> data, std::uint32_t crc) {
+#if defined(EARTH_MAP_CRC32C_SSE42)
+    if (kHardware) {
+        return Crc32cSse42(data, crc);
+    }
+#elif defined(EARTH_MAP_CRC32C_ARM)
+    return Crc32cArm(data, crc);
+#endif
+    return Crc32cSoftware(data, crc);
+}
+
+bool Crc32cIsHardwareAccelerated() {
+    return kHardware;
+}
+
+} // namespace earth_map
@@ -0,0 +1,210 @@
+/**
+ * @file disk_cache_collector.cpp
+ * @brief Implementation of the background disk cache garbage collector
+ */
+
+#include <earth_map/data/disk_cache_collector.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace earth_map {
+
+namespace {
+
+/// Put the calling thread at the back of the CPU and disk queues
+void LowerCurrentThreadPriority() {
+#if defined(__linux__)
+    // No glibc wrapper for ioprio_set; values from linux/ioprio.h
+    constexpr int kIoprioWhoProcess = 1;
+    constexpr int kIoprioClassIdle = 3;
+    constexpr int kIoprioClassShift = 13;
+    const auto tid = static_cast<int>(syscall(SYS_gettid));
+    if (syscall(SYS_ioprio_set, kIoprioWhoProcess, tid, kIoprioClassIdle << kIoprioClassShift) != 0) {
+        spdlog::debug("Disk cache collector keeps the default I/O priority");
+    }
+    // Nice values are per thread on Linux
+    if (setpriority(PRIO_PROCESS, static_cast<id_t>(tid), 19) != 0) {
+        spdlog::debug("Disk cache collector keeps the default CPU priority");
+    }
+#endif
+}
+
+bool IsExpired(const DiskCacheManifest::Entry& entry, std::int64_t ttl, std::int64_t now) {
+    // Same rule as BasicTileCache::Cleanup(): server freshness outlasts the TTL
+    return now - entry.last_modified > ttl && now >= entry.expires_at;
+}
+
+} // namespace
+
+DiskCacheCollector::DiskCacheCollector(std::shared_ptr<DiskCacheManifest> manifest,
+                                       BudgetSource budget,
+                                       Remover remove,
+                                       const DiskCacheCollectorConfig& config)
+    : config_(config)
+    , manifest_(std::move(manifest))
+    , budget_(std::move(budget))
+    , remove_(std::move(remove)) {
+    if (!manifest_ || !budget_ || !remove_) {
+        throw std::invalid_argument("DiskCacheCollector: manifest, budget and remover are required");
+    }
+}
+
+DiskCacheCollector::~DiskCacheCollector() {
+    Stop();
+}
+
+void DiskCacheCollector::Start() {
+    std::lock_guard<std::mutex> lock(thread_mutex_);
+    if (thread_.joinable()) {
+        return;
+    }
+    stop_ = false;
+    thread_ = std::thread(&DiskCacheCollector::Run, this);
+}
+
+void DiskCacheCollector::Stop() {
+    std::thread thread;
+    {
+        std::lock_guard<std::mutex> lock(thread_mutex_);
+        stop_ = true;
+        thread = std::move(thread_);
+    }
+    wake_cv_.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+void DiskCacheCollector::Wake() {
+    {
+        std::lock_guard<std::mutex> lock(thread_mutex_);
+        wake_ = true;
+    }
+    wake_cv_.notify_all();
+}
+
+std::size_t DiskCacheCollector::Collect(std::chrono::system_clock::time_point now) {
+    std::lock_guard<std::mutex> lock(collect_mutex_);
+    ++stats_.ticks;
+
+    const DiskCacheBudget budget = budget_();
+    const std::int64_t now_seconds = DiskCacheManifest::ToSeconds(now);
+    const auto ttl = static_cast<std::int64_t>(budget.ttl_seconds);
+    std::size_t removed = 0;
+
+    // TTL: list expired tiles once per scan interval, delete a batch per tick
+    if (now >= next_expiry_scan_) {
+        expired_ = manifest_->CollectIf(
+            [ttl, now_seconds](const TileCoordinates&, const DiskCacheManifest::Entry& entry) {
+                return IsExpired(entry, ttl, now_seconds);
+            });
+        next_expiry_scan_ = now + config_.expiry_scan_interval;
+    }
+    while (removed < config_.max_deletions_per_tick && !expired_.empty()) {
+        const TileCoordinates coords = expired_.back();
+        expired_.pop_back();
+        // Revalidated or rewritten since the scan: keep it
+        const auto entry = manifest_->Find(coords);
+        if (entry && IsExpired(*entry, ttl, now_seconds) && remove_(coords)) {
+            ++removed;
+            ++stats_.expired_removed;
+            stats_.bytes_freed += entry->GetDiskSize();
+        }
+    }
+
+    // Size: once over the budget, evict down to the low-water mark
+    std::uint64_t usage = manifest_->GetTotalSize();
+    if (usage <= budget.max_bytes) {
+        victims_.clear();
+        return removed;
+    }
+    const auto target = static_cast<std::uint64_t>(
+        static_cast<double>(budget.max_bytes) * std::clamp(config_.low_water_fraction, 0.0, 1.0));
+    while (removed < config_.max_deletions_per_tick && usage > target) {
+        if (victims_.empty()) {
+            victims_ = OrderVictims(budget.strategy);
+            if (victims_.empty()) {
+                break;
+            }
+        }
+        const auto [coords, ordered_by] = victims_.back();
+        victims_.pop_back();
+        // Read or rewritten since it was ordered: no longer where the order put it
+        const auto entry = manifest_->Find(coords);
+        if (!entry || entry->last_access != ordered_by.last_access ||
+            entry->last_modified != ordered_by.last_modified || !remove_(coords)) {
+            continue;
+        }
+        ++removed;
+        ++stats_.evicted;
+        stats_.bytes_freed += entry->GetDiskSize();
+        usage = usage > entry->GetDiskSize() ? usage - entry->GetDiskSize() : 0;
+    }
+    if (usage <= target) {
+        victims_.clear();
+    }
+
+    if (removed > 0) {
+        spdlog::debug("Disk cache collector removed {} tiles, {} bytes on disk",
+                      removed, manifest_->GetTotalSize());
+    }
+    return removed;
+}
+
+DiskCacheCollectorStats DiskCacheCollector::GetStats() const {
+    std::lock_guard<std::mutex> lock(collect_mutex_);
+    return stats_;
+}
+
+void DiskCacheCollector::Run() {
+    if (config_.lower_priority) {
+        LowerCurrentThreadPriority();
+    }
+
+    std::unique_lock<std::mutex> lock(thread_mutex_);
+    while (!stop_) {
+        wake_cv_.wait_for(lock, config_.tick_interval, [this] { return stop_ || wake_; });
+        if (stop_) {
+            break;
+        }
+        wake_ = false;
+        lock.unlock();
+        Collect(std::chrono::system_clock::now());
+        lock.lock();
+    }
+}
+
+std::vector<DiskCacheCollector::Victim> DiskCacheCollector::OrderVictims(
+    TileCacheConfig::EvictionStrategy strategy) const {
+    auto entries = manifest_->GetEntries();
+
+    // Sorted so the first victim is at back()
+    switch (strategy) {
+        case TileCacheConfig::EvictionStrategy::SIZE_BASED:
+            std::sort(entries.begin(), entries.end(), [](const Victim& a, const Victim& b) {
+                return a.second.GetDiskSize() < b.second.GetDiskSize();
+            });
+            break;
+        case TileCacheConfig::EvictionStrategy::TIME_BASED:
+            std::sort(entries.begin(), entries.end(), [](const Victim& a, const Victim& b) {
+                return a.second.last_modified > b.second.last_modified;
+            });
+            break;
+        case TileCacheConfig::EvictionStrategy::LRU:
+        case TileCacheConfig::EvictionStrategy::LFU:  // No disk hit counts: fall back to LRU
+            std::sort(entries.begin(), entries.end(), [](const Victim& a, const Victim& b) {
+                return a.second.last_access > b.second.last_access;
+            });
+            break;
+    }
+    return entries;
+}
+
+} // namespace earth_map
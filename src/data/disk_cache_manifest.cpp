@@ -0,0 +1,419 @@
+/**
+ * @file disk_cache_manifest.cpp
+ * @brief Implementation of the disk cache snapshot/journal index
+ */
+
+#include <earth_map/data/disk_cache_manifest.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace earth_map {
+
+namespace {
+
+constexpr std::uint32_t kRecordMagic = 0x4D434D45;    // "EMCM"
+constexpr std::uint32_t kSnapshotMagic = 0x534D4D45;  // "EMMS"
+constexpr std::uint32_t kSnapshotVersion = 1;
+constexpr const char* kSnapshotName = "manifest.bin";
+constexpr const char* kJournalName = "manifest.journal";
+
+/// One journal record; the snapshot is a header followed by PUT records
+struct Record {
+    std::uint32_t magic;
+    std::uint8_t op;
+    std::uint8_t reserved[3];
+    std::int32_t x;
+    std::int32_t y;
+    std::int32_t zoom;
+    std::uint32_t reserved2;
+    DiskCacheManifest::Entry entry;
+};
+static_assert(sizeof(Record) == 64, "Record layout must stay stable");
+
+struct SnapshotHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t count;
+};
+static_assert(sizeof(SnapshotHeader) == 16, "SnapshotHeader layout must stay stable");
+
+Record MakeRecord(std::uint8_t op, const TileCoordinates& coords,
+                  const DiskCacheManifest::Entry& entry) {
+    Record record{};
+    record.magic = kRecordMagic;
+    record.op = op;
+    record.x = coords.x;
+    record.y = coords.y;
+    record.zoom = coords.zoom;
+    record.entry = entry;
+    return record;
+}
+
+/// Read a whole file in one go
+std::vector<std::uint8_t> ReadFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return {};
+    }
+    const std::streamsize size = file.tellg();
+    std::vector<std::uint8_t> bytes(static_cast<std::size_t>(std::max<std::streamsize>(size, 0)));
+    file.seekg(0);
+    if (!bytes.empty() &&
+        !file.read(reinterpret_cast<char*>(bytes.data()), size)) {
+        return {};
+    }
+    return bytes;
+}
+
+bool WriteAll(int fd, const void* data, std::size_t size) {
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    while (size > 0) {
+        const ssize_t written = ::write(fd, bytes, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        bytes += written;
+        size -= static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+} // namespace
+
+DiskCacheManifest::DiskCacheManifest(std::string directory)
+    : snapshot_path_(directory + "/" + kSnapshotName)
+    , journal_path_(directory + "/" + kJournalName) {
+}
+
+DiskCacheManifest::~DiskCacheManifest() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CloseJournalLocked();
+}
+
+bool DiskCacheManifest::Load() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    CloseJournalLocked();
+    ClearLocked();
+    journal_records_ = 0;
+
+    bool found = false;
+    const std::vector<std::uint8_t> snapshot = ReadFile(snapshot_path_);
+    if (snapshot.size() >= sizeof(SnapshotHeader)) {
+        SnapshotHeader header;
+        std::memcpy(&header, snapshot.data(), sizeof(header));
+        const std::size_t body = snapshot.size() - sizeof(header);
+        if (header.magic == kSnapshotMagic && header.version == kSnapshotVersion &&
+            body == header.count * sizeof(Record)) {
+            entries_.reserve(header.count);
+            for (std::size_t i = 0; i < header.count; ++i) {
+                Record record;
+                std::memcpy(&record, snapshot.data() + sizeof(header) + i * sizeof(Record),
+                            sizeof(record));
+                Apply(static_cast<Op>(record.op),
+                      TileCoordinates(record.x, record.y, record.zoom), record.entry);
+            }
+            found = true;
+        } else {
+            spdlog::warn("Ignoring invalid disk cache manifest {}", snapshot_path_);
+        }
+    }
+
+    // Replay the journal; stop at the first torn or foreign record
+    const std::vector<std::uint8_t> journal = ReadFile(journal_path_);
+    if (found || snapshot.empty()) {
+        for (std::size_t offset = 0; offset + sizeof(Record) <= journal.size();
+             offset += sizeof(Record)) {
+            Record record;
+            std::memcpy(&record, journal.data() + offset, sizeof(record));
+            if (record.magic != kRecordMagic) {
+                break;
+            }
+            Apply(static_cast<Op>(record.op),
+                  TileCoordinates(record.x, record.y, record.zoom), record.entry);
+            ++journal_records_;
+            found = true;
+        }
+    }
+
+    // Fold the replayed journal in so the next start is a single read
+    if (journal_records_ > 0 || !journal.empty()) {
+        if (!CheckpointLocked()) {
+            OpenJournalLocked(false);
+        }
+    } else {
+        OpenJournalLocked(false);
+    }
+    return found;
+}
+
+void DiskCacheManifest::RecordTile(const TileCoordinates& coords, std::uint64_t tile_size,
+                                   std::uint32_t checksum) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry entry;
+    if (auto it = entries_.find(coords); it != entries_.end()) {
+        entry = it->second;
+    }
+    entry.tile_size = tile_size;
+    entry.checksum = checksum;
+    UpdateLocked(coords, entry);
+}
+
+void DiskCacheManifest::RecordMetadata(const TileCoordinates& coords,
+                                       std::uint32_t metadata_size,
+                                       std::chrono::system_clock::time_point last_modified,
+                                       std::chrono::system_clock::time_point expires_at) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry entry;
+    if (auto it = entries_.find(coords); it != entries_.end()) {
+        entry = it->second;
+    }
+    entry.metadata_size = metadata_size;
+    entry.last_modified = ToSeconds(last_modified);
+    entry.expires_at = ToSeconds(expires_at);
+    if (entry.last_access == 0) {
+        entry.last_access = ToSeconds(std::chrono::system_clock::now());
+    }
+    UpdateLocked(coords, entry);
+}
+
+void DiskCacheManifest::Touch(const TileCoordinates& coords,
+                              std::chrono::system_clock::time_point when) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(coords);
+    if (it == entries_.end()) {
+        return;
+    }
+    Entry entry = it->second;
+    entry.last_access = ToSeconds(when);
+    UpdateLocked(coords, entry);
+}
+
+bool DiskCacheManifest::Remove(const TileCoordinates& coords) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (entries_.find(coords) == entries_.end()) {
+        return false;
+    }
+    Apply(Op::REMOVE, coords, Entry{});
+    AppendLocked(Op::REMOVE, coords, Entry{});
+    return true;
+}
+
+void DiskCacheManifest::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ClearLocked();
+    CheckpointLocked();
+}
+
+void DiskCacheManifest::Reset(std::vector<std::pair<TileCoordinates, Entry>> entries) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ClearLocked();
+    for (const auto& [coords, entry] : entries) {
+        Apply(Op::PUT, coords, entry);
+    }
+    CheckpointLocked();
+}
+
+bool DiskCacheManifest::Checkpoint() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return CheckpointLocked();
+}
+
+std::optional<DiskCacheManifest::Entry> DiskCacheManifest::Find(
+    const TileCoordinates& coords) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(coords);
+    if (it == entries_.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::vector<TileCoordinates> DiskCacheManifest::CollectIf(const Predicate& predicate) const {
+    std::vector<TileCoordinates> result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& [coords, entry] : entries_) {
+        if (predicate(coords, entry)) {
+            result.push_back(coords);
+        }
+    }
+    return result;
+}
+
+void DiskCacheManifest::SetVictimOrder(VictimOrder order) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (order == victim_order_) {
+        return;
+    }
+    victim_order_ = order;
+    victims_.clear();
+    for (const auto& [coords, entry] : entries_) {
+        victims_.emplace(VictimKey(entry), coords);
+    }
+}
+
+DiskCacheManifest::VictimOrder DiskCacheManifest::GetVictimOrder() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return victim_order_;
+}
+
+std::vector<std::pair<TileCoordinates, DiskCacheManifest::Entry>>
+DiskCacheManifest::CollectVictims(std::uint64_t bytes) const {
+    std::vector<std::pair<TileCoordinates, Entry>> victims;
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::uint64_t covered = 0;
+    for (auto it = victims_.begin(); it != victims_.end() && covered < bytes; ++it) {
+        const Entry& entry = entries_.at(it->second);
+        victims.emplace_back(it->second, entry);
+        covered += entry.GetDiskSize();
+    }
+    return victims;
+}
+
+std::vector<std::pair<TileCoordinates, DiskCacheManifest::Entry>>
+DiskCacheManifest::GetEntries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return {entries_.begin(), entries_.end()};
+}
+
+std::uint64_t DiskCacheManifest::GetTotalSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return total_size_;
+}
+
+std::size_t DiskCacheManifest::GetCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+std::size_t DiskCacheManifest::GetJournalRecordCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return journal_records_;
+}
+
+std::int64_t DiskCacheManifest::ToSeconds(std::chrono::system_clock::time_point time) {
+    return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+}
+
+void DiskCacheManifest::UpdateLocked(const TileCoordinates& coords, const Entry& entry) {
+    Apply(Op::PUT, coords, entry);
+    AppendLocked(Op::PUT, coords, entry);
+}
+
+void DiskCacheManifest::AppendLocked(Op op, const TileCoordinates& coords, const Entry& entry) {
+    if (journal_fd_ < 0 && !OpenJournalLocked(false)) {
+        return;  // Index stays correct in memory; next checkpoint persists it
+    }
+    const Record record = MakeRecord(static_cast<std::uint8_t>(op), coords, entry);
+    if (!WriteAll(journal_fd_, &record, sizeof(record))) {
+        spdlog::warn("Failed to append to disk cache journal: {}", std::strerror(errno));
+        return;
+    }
+    ++journal_records_;
+
+    if (journal_records_ > std::max(kMinCheckpointRecords, entries_.size())) {
+        CheckpointLocked();
+    }
+}
+
+bool DiskCacheManifest::CheckpointLocked() {
+    std::vector<std::uint8_t> bytes(sizeof(SnapshotHeader) + entries_.size() * sizeof(Record));
+    const SnapshotHeader header{kSnapshotMagic, kSnapshotVersion, entries_.size()};
+    std::memcpy(bytes.data(), &header, sizeof(header));
+    std::size_t offset = sizeof(header);
+    for (const auto& [coords, entry] : entries_) {
+        const Record record = MakeRecord(static_cast<std::uint8_t>(Op::PUT), coords, entry);
+        std::memcpy(bytes.data() + offset, &record, sizeof(record));
+        offset += sizeof(record);
+    }
+
+    // Snapshot is replaced atomically; the journal is only truncated afterwards
+    const std::string temp_path = snapshot_path_ + ".tmp";
+    const int fd = ::open(temp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        spdlog::warn("Failed to write disk cache manifest {}: {}", temp_path, std::strerror(errno));
+        return false;
+    }
+    const bool written = WriteAll(fd, bytes.data(), bytes.size());
+    ::close(fd);
+
+    std::error_code error;
+    if (written) {
+        std::filesystem::rename(temp_path, snapshot_path_, error);
+    }
+    if (!written || error) {
+        std::filesystem::remove(temp_path, error);
+        return false;
+    }
+
+    journal_records_ = 0;
+    return OpenJournalLocked(true);
+}
+
+void DiskCacheManifest::Apply(Op op, const TileCoordinates& coords, const Entry& entry) {
+    auto it = entries_.find(coords);
+    if (it != entries_.end()) {
+        total_size_ -= it->second.GetDiskSize();
+        victims_.erase({VictimKey(it->second), coords});
+    }
+    if (op == Op::REMOVE) {
+        if (it != entries_.end()) {
+            entries_.erase(it);
+        }
+        return;
+    }
+    if (it != entries_.end()) {
+        it->second = entry;
+    } else {
+        entries_.emplace(coords, entry);
+    }
+    total_size_ += entry.GetDiskSize();
+    victims_.emplace(VictimKey(entry), coords);
+}
+
+void DiskCacheManifest::ClearLocked() {
+    entries_.clear();
+    victims_.clear();
+    total_size_ = 0;
+}
+
+std::int64_t DiskCacheManifest::VictimKey(const Entry& entry) const {
+    switch (victim_order_) {
+        case VictimOrder::OLDEST_MODIFIED:
+            return entry.last_modified;
+        case VictimOrder::LARGEST:
+            return -static_cast<std::int64_t>(entry.GetDiskSize());
+        case VictimOrder::LEAST_RECENTLY_ACCESSED:
+        default:
+            return entry.last_access;
+    }
+}
+
+bool DiskCacheManifest::OpenJournalLocked(bool truncate) {
+    CloseJournalLocked();
+    const int flags = O_WRONLY | O_CREAT | O_APPEND | (truncate ? O_TRUNC : 0);
+    journal_fd_ = ::open(journal_path_.c_str(), flags, 0644);
+    if (journal_fd_ < 0) {
+        spdlog::warn("Failed to open disk cache journal {}: {}", journal_path_,
+                     std::strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+void DiskCacheManifest::CloseJournalLocked() {
+    if (journal_fd_ >= 0) {
+        ::close(journal_fd_);
+        journal_fd_ = -1;
+    }
+}
+
+} // namespace earth_map
@@ -0,0 +1,304 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#include <earth_map/data/elevation_batch.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <unordered_map>
+
+namespace earth_map {
+
+using namespace coordinates;
+namespace {
+
+/// Points interpolated per task in the parallel pass
+constexpr size_t kPointsPerTask = 8192;
+
+/// Marks a point outside SRTM coverage
+constexpr uint32_t kNoBucket = UINT32_MAX;
+
+/// Check if coordinate is valid for SRTM coverage
+[[nodiscard]] bool IsValidCoordinate(double latitude, double longitude) noexcept {
+    return latitude >= -90.0 && latitude <= 90.0 &&
+           longitude >= -180.0 && longitude <= 180.0;
+}
+
+/// Morton cells per tile edge: a few samples across, so the rows a cell's
+/// points touch stay in cache while the cell is interpolated
+constexpr uint32_t kMortonCellsPerEdge = 256;
+
+/// Radix digits of the 16-bit Morton cell code
+constexpr int kRadixBits = 8;
+constexpr size_t kRadixBuckets = size_t{1} << kRadixBits;
+
+/// Quantize a tile fraction to its Morton cell
+[[nodiscard]] uint16_t QuantizeFraction(double fraction) noexcept {
+    return static_cast<uint16_t>(
+        std::clamp(fraction, 0.0, 1.0) * (kMortonCellsPerEdge - 1));
+}
+
+/// Stable LSD radix sort of keys by their Morton code (bits 32..47):
+/// linear time, and points of one cell keep their input order
+void SortByMortonCode(std::vector<uint64_t>& keys, std::vector<uint64_t>& scratch) {
+    scratch.resize(keys.size());
+    for (int shift = 32; shift < 48; shift += kRadixBits) {
+        size_t offsets[kRadixBuckets] = {};
+        for (const uint64_t key : keys) {
+            ++offsets[(key >> shift) & (kRadixBuckets - 1)];
+        }
+        size_t sum = 0;
+        for (size_t& offset : offsets) {
+            const size_t bucket_count = offset;
+            offset = sum;
+            sum += bucket_count;
+        }
+        for (const uint64_t key : keys) {
+            scratch[offsets[(key >> shift) & (kRadixBuckets - 1)]++] = key;
+        }
+        keys.swap(scratch);
+    }
+}
+
+/// Helper threads shared by every batch: a batch makes three parallel
+/// passes, and spawning threads for each cost more than small passes' work
+class BatchWorkers {
+public:
+    static BatchWorkers& Instance() {
+        static BatchWorkers workers(
+            std::max<size_t>(1, std::thread::hardware_concurrency()) - 1);
+        return workers;
+    }
+
+    ~BatchWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& thread : threads_) {
+            thread.join();
+        }
+    }
+
+    BatchWorkers(const BatchWorkers&) = delete;
+    BatchWorkers& operator=(const BatchWorkers&) = delete;
+
+    /// Run fn(0) .. fn(count - 1) on the caller and up to @p helpers workers
+    /// @return False, without running anything, if another pass holds the workers
+    bool TryRun(size_t count, size_t helpers, const std::function<void(size_t)>& fn) {
+        std::unique_lock<std::mutex> run(run_mutex_, std::try_to_lock);
+        if (!run.owns_lock()) {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            fn_ = &fn;
+            count_ = count;
+            next_.store(0);
+            helpers_wanted_ = std::min(helpers, threads_.size());
+        }
+        wake_.notify_all();
+        Drain();
+
+        // Helpers that have not woken up yet are no longer needed
+        std::unique_lock<std::mutex> lock(mutex_);
+        helpers_wanted_ = 0;
+        done_.wait(lock, [this]() { return helpers_running_ == 0; });
+        fn_ = nullptr;
+        return true;
+    }
+
+private:
+    explicit BatchWorkers(size_t threads) {
+        threads_.reserve(threads);
+        for (size_t t = 0; t < threads; ++t) {
+            threads_.emplace_back([this]() { WorkerLoop(); });
+        }
+    }
+
+    void WorkerLoop() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            wake_.wait(lock, [this]() { return stop_ || helpers_wanted_ > 0; });
+            if (stop_) {
+                return;
+            }
+            --helpers_wanted_;
+            ++helpers_running_;
+            lock.unlock();
+            Drain();
+            lock.lock();
+            if (--helpers_running_ == 0) {
+                done_.notify_all();
+            }
+        }
+    }
+
+    void Drain() {
+        for (size_t i = next_.fetch_add(1); i < count_; i = next_.fetch_add(1)) {
+            (*fn_)(i);
+        }
+    }
+
+    std::mutex run_mutex_;  ///< One pass at a time owns the workers
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    std::vector<std::thread> threads_;
+    const std::function<void(size_t)>* fn_ = nullptr;
+    size_t count_ = 0;
+    std::atomic<size_t> next_{0};
+    size_t helpers_wanted_ = 0;   ///< Workers still to join the current pass
+    size_t helpers_running_ = 0;  ///< Workers inside the current pass
+    bool stop_ = false;
+};
+
+/// Run fn(0) .. fn(count - 1) on up to @p threads threads (the caller included)
+/// Runs on the calling thread alone while another batch uses the shared workers
+template <typename Fn>
+void ParallelFor(size_t count, size_t threads, const Fn& fn) {
+    threads = std::min(threads, count);
+    if (threads > 1) {
+        const std::function<void(size_t)> task = std::cref(fn);
+        if (BatchWorkers::Instance().TryRun(count, threads - 1, task)) {
+            return;
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        fn(i);
+    }
+}
+
+/// Points of one SRTM tile
+struct TileBucket {
+    SRTMCoordinates coordinates;
+    std::shared_ptr<SRTMTileData> tile_data;
+    std::vector<uint64_t> keys;  ///< Morton code << 32 | point index
+};
+
+/// Contiguous range of one bucket's sorted keys
+struct BucketRange {
+    uint32_t bucket;
+    size_t begin;
+    size_t end;
+};
+
+} // anonymous namespace
+
+std::vector<ElevationQuery> SampleElevationBatch(const std::vector<Geographic>& points,
+                                                 const SRTMTileLookup& lookup,
+                                                 const ElevationBatchConfig& config) {
+    const size_t count = points.size();
+    std::vector<ElevationQuery> results(count);
+    if (count == 0) {
+        return results;
+    }
+
+    const size_t hardware_threads =
+        std::max<size_t>(1, std::thread::hardware_concurrency());
+    const size_t max_threads = config.max_threads > 0 ? config.max_threads : hardware_threads;
+    const size_t threads = std::clamp<size_t>(
+        count / std::max<size_t>(1, config.min_points_per_thread), 1, max_threads);
+
+    // Normalize every point and find its tile and sample position
+    std::vector<double> lat_fractions(count);
+    std::vector<double> lon_fractions(count);
+    ParallelFor((count + kPointsPerTask - 1) / kPointsPerTask, threads, [&](size_t task) {
+        const size_t end = std::min(count, (task + 1) * kPointsPerTask);
+        for (size_t i = task * kPointsPerTask; i < end; ++i) {
+            ElevationQuery& result = results[i];
+            result.latitude = points[i].latitude;
+            result.longitude = points[i].longitude;
+
+            const double lat = NormalizeLatitude(points[i].latitude);
+            const double lon = NormalizeLongitude(points[i].longitude);
+            if (!IsValidCoordinate(lat, lon)) {
+                lat_fractions[i] = -1.0;
+                continue;
+            }
+            result.source_tile = GeographicToSRTMTile(lat, lon);
+            std::tie(lat_fractions[i], lon_fractions[i]) =
+                GeographicToTileFraction(lat, lon, result.source_tile);
+        }
+    });
+
+    // Bucket by tile; consecutive points usually share one, so skip the
+    // hash lookup while the tile does not change
+    std::vector<TileBucket> buckets;
+    std::unordered_map<SRTMCoordinates, uint32_t> bucket_index;
+    uint32_t current = kNoBucket;
+    for (size_t i = 0; i < count; ++i) {
+        if (lat_fractions[i] < 0.0) {
+            continue;
+        }
+        const SRTMCoordinates& tile = results[i].source_tile;
+        if (current == kNoBucket || buckets[current].coordinates != tile) {
+            const auto [it, inserted] =
+                bucket_index.emplace(tile, static_cast<uint32_t>(buckets.size()));
+            if (inserted) {
+                buckets.push_back(TileBucket{tile, nullptr, {}});
+            }
+            current = it->second;
+        }
+        // Row 0 is northernmost: order by (x, rows from the north)
+        const uint32_t morton = MortonEncode(QuantizeFraction(lon_fractions[i]),
+                                             QuantizeFraction(1.0 - lat_fractions[i]));
+        buckets[current].keys.push_back((static_cast<uint64_t>(morton) << 32) |
+                                        static_cast<uint32_t>(i));
+    }
+
+    // Pin each tile once and sort its points into cache order
+    ParallelFor(buckets.size(), threads, [&](size_t b) {
+        TileBucket& bucket = buckets[b];
+        bucket.tile_data = lookup(bucket.coordinates);
+        if (bucket.tile_data) {
+            std::vector<uint64_t> scratch;
+            SortByMortonCode(bucket.keys, scratch);
+        }
+    });
+
+    // Split the loaded buckets so one large tile still spreads over every thread
+    std::vector<BucketRange> ranges;
+    for (uint32_t b = 0; b < buckets.size(); ++b) {
+        if (!buckets[b].tile_data) {
+            continue;
+        }
+        const size_t size = buckets[b].keys.size();
+        for (size_t begin = 0; begin < size; begin += kPointsPerTask) {
+            ranges.push_back({b, begin, std::min(size, begin + kPointsPerTask)});
+        }
+    }
+
+    // Gather each range's fractions in cache order for the SIMD kernel,
+    // then scatter the elevations back to their points
+    ParallelFor(ranges.size(), threads, [&](size_t r) {
+        const BucketRange& range = ranges[r];
+        const TileBucket& bucket = buckets[range.bucket];
+        const size_t size = range.end - range.begin;
+
+        std::vector<double> lat_batch(size);
+        std::vector<double> lon_batch(size);
+        std::vector<float> elevations(size);
+        for (size_t k = 0; k < size; ++k) {
+            const size_t i = static_cast<uint32_t>(bucket.keys[range.begin + k]);
+            lat_batch[k] = lat_fractions[i];
+            lon_batch[k] = lon_fractions[i];
+        }
+        bucket.tile_data->InterpolateElevations(lat_batch, lon_batch, elevations);
+        for (size_t k = 0; k < size; ++k) {
+            ElevationQuery& result = results[static_cast<uint32_t>(bucket.keys[range.begin + k])];
+            result.elevation_meters = elevations[k];
+            result.valid = true;
+        }
+    });
+
+    return results;
+}
+
+} // namespace earth_map
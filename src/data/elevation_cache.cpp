@@ -2,52 +2,140 @@
 // SPDX-License-Identifier: MIT
 
 #include <earth_map/data/elevation_cache.h>
+#include <earth_map/data/compressed_elevation_tile.h>
 #include <earth_map/data/hgt_parser.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
 #include <list>
 #include <mutex>
+#include <shared_mutex>
 #include <sstream>
 #include <unordered_map>
+#include <vector>
 
 namespace earth_map {
 
 namespace {
 
-/// LRU cache entry
-struct CacheEntry {
+/// Appended to the SRTM filename for native-endian cache files
+constexpr char kNativeCacheSuffix[] = ".native";
+
+/// Memory cache key: one entry per tile and pyramid level
+struct CacheKey {
     SRTMCoordinates coordinates;
-    std::shared_ptr<SRTMTileData> tile_data;
+    uint32_t level;
+
+    bool operator==(const CacheKey& other) const noexcept = default;
+};
+
+/// Hash function for CacheKey
+struct CacheKeyHash {
+    size_t operator()(const CacheKey& key) const noexcept {
+        return std::hash<SRTMCoordinates>{}(key.coordinates) ^
+               (static_cast<size_t>(key.level) << 24);
+    }
+};
+
+/// splitmix64 finalizer: spreads neighboring tiles over the shards
+uint64_t MixHash(uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ull;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBull;
+    value ^= value >> 31;
+    return value;
+}
+
+/// Memory cache shards (a power of two)
+constexpr size_t kShardCount = 16;
+
+/// Cache line size used to keep shard locks apart
+constexpr size_t kCacheLineSize = 64;
+
+/// Memory cache entry; immutable once inserted except for its CLOCK bit
+struct CacheEntry {
+    CacheKey key;
+    std::shared_ptr<SRTMTileData> tile_data;                 ///< Null when compressed
+    std::shared_ptr<const CompressedElevationTile> compressed;
     size_t size_bytes;
     std::chrono::system_clock::time_point timestamp;
 
-    CacheEntry(const SRTMCoordinates& coords,
+    /// Set by every hit (under the shared shard lock), cleared as the
+    /// eviction hand passes: entries hit since the last sweep survive it
+    std::atomic<bool> referenced{false};
+
+    CacheEntry(const CacheKey& cache_key,
                std::shared_ptr<SRTMTileData> data,
+               std::shared_ptr<const CompressedElevationTile> compressed_data,
                size_t size)
-        : coordinates(coords),
+        : key(cache_key),
           tile_data(std::move(data)),
+          compressed(std::move(compressed_data)),
           size_bytes(size),
           timestamp(std::chrono::system_clock::now()) {}
 };
 
+/// Memory cache shard: readers share the lock and never reorder anything
+struct alignas(kCacheLineSize) CacheShard {
+    using Ring = std::list<CacheEntry>;
+
+    mutable std::shared_mutex mutex;
+
+    /// CLOCK ring; new entries go just behind the hand
+    Ring ring;
+    Ring::iterator hand = ring.end();
+    std::unordered_map<CacheKey, Ring::iterator, CacheKeyHash> entries;
+
+    // Hit counters live with the shard so readers do not share a cache line
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> decompressions{0};
+};
+
+/// Decompressed copy of a compressed entry, valid while that entry is
+struct HotTile {
+    CacheKey key;
+    std::shared_ptr<const CompressedElevationTile> source;
+    std::shared_ptr<SRTMTileData> tile_data;
+};
+
 } // anonymous namespace
 
-/// Basic elevation cache implementation with LRU eviction
+/// Basic elevation cache implementation
+///
+/// The memory cache is sharded by tile key. A hit takes its shard's lock
+/// shared, copies the tile's shared_ptr and sets the entry's CLOCK bit, so
+/// concurrent readers neither block each other nor write shared state
+/// beyond their shard. Eviction approximates LRU with a per-shard CLOCK
+/// sweep; the byte budget is global and shards give up victims round-robin,
+/// never holding two shard locks at once. Disk I/O is serialized apart from
+/// the memory cache.
 class BasicElevationCache : public ElevationCache {
 public:
     explicit BasicElevationCache(const ElevationCacheConfig& config)
-        : config_(config) {}
+        : config_(config),
+          max_memory_bytes_(config.max_memory_cache_size),
+          hot_tile_count_(config.hot_tile_count) {}
 
     bool Initialize(const ElevationCacheConfig& config) override {
-        config_ = config;
+        {
+            std::lock_guard<std::mutex> lock(config_mutex_);
+            config_ = config;
+        }
+        max_memory_bytes_.store(config.max_memory_cache_size, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(hot_mutex_);
+            hot_tile_count_ = config.hot_tile_count;
+        }
 
         // Create disk cache directory if enabled
-        if (config_.enable_disk_cache) {
+        if (config.enable_disk_cache) {
             try {
-                std::filesystem::create_directories(config_.disk_cache_directory);
+                std::filesystem::create_directories(config.disk_cache_directory);
             } catch (...) {
                 return false;
             }
@@ -57,37 +145,32 @@ public:
     }
 
     bool Put(const SRTMTileData& tile_data) override {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
+        const ElevationCacheConfig config = GetConfiguration();
 
-        const auto& coords = tile_data.GetMetadata().coordinates;
+        const CacheKey key{tile_data.GetMetadata().coordinates, tile_data.GetMetadata().level};
         const size_t tile_size = tile_data.GetMetadata().file_size;
 
-        // Remove existing entry if present
-        RemoveFromMemoryCache(coords);
-
-        // Check if we need to evict entries to make room
-        while (stats_.memory_cache_size_bytes + tile_size > config_.max_memory_cache_size &&
-               !lru_list_.empty()) {
-            EvictLRU();
-        }
-
-        // Create shared pointer and add to memory cache
+        // Copy (and compress) outside any lock
         auto tile_ptr = std::make_shared<SRTMTileData>(tile_data.GetMetadata());
-        tile_ptr->GetRawData() = tile_data.GetRawData();
+        const auto samples = tile_data.GetSamples();
+        tile_ptr->GetRawData().assign(samples.begin(), samples.end());
         tile_ptr->SetValid(tile_data.IsValid());
         tile_ptr->SetHasVoids(tile_data.GetMetadata().has_voids);
 
-        auto entry = std::make_shared<CacheEntry>(coords, tile_ptr, tile_size);
-
-        lru_list_.push_front(entry);
-        memory_cache_[coords] = lru_list_.begin();
-
-        stats_.memory_cache_size_bytes += tile_size;
-        stats_.tile_count_memory = memory_cache_.size();
+        // Add to memory cache, replacing any existing entry; a compressed
+        // tile keeps its copy hot
+        if (config.compress_memory_tiles) {
+            auto compressed = std::make_shared<const CompressedElevationTile>(tile_data);
+            InsertEntry(key, nullptr, compressed, compressed->GetSizeBytes());
+            AddHotTile(key, std::move(compressed), std::move(tile_ptr));
+        } else {
+            InsertEntry(key, std::move(tile_ptr), nullptr, tile_size);
+        }
 
         // Write to disk cache if enabled
-        if (config_.enable_disk_cache) {
-            WriteToDiskCache(tile_data);
+        if (config.enable_disk_cache) {
+            std::lock_guard<std::mutex> lock(disk_mutex_);
+            WriteToDiskCache(config.disk_cache_directory, tile_data);
         }
 
         return true;
@@ -95,85 +178,126 @@ public:
 
     std::optional<std::shared_ptr<SRTMTileData>> Get(
         const SRTMCoordinates& coordinates) override {
+        return Get(coordinates, 0);
+    }
 
-        std::lock_guard<std::mutex> lock(cache_mutex_);
+    std::optional<std::shared_ptr<SRTMTileData>> Get(
+        const SRTMCoordinates& coordinates, uint32_t level) override {
 
         // Check memory cache first
-        auto it = memory_cache_.find(coordinates);
-        if (it != memory_cache_.end()) {
-            // Move to front of LRU list
-            lru_list_.splice(lru_list_.begin(), lru_list_, it->second);
-            ++stats_.memory_cache_hits;
-            return (*it->second)->tile_data;
+        const CacheKey key{coordinates, level};
+        CacheShard& shard = ShardFor(key);
+        std::shared_ptr<const CompressedElevationTile> compressed;
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            const auto it = shard.entries.find(key);
+            if (it != shard.entries.end()) {
+                CacheEntry& entry = *it->second;
+                if (!entry.referenced.load(std::memory_order_relaxed)) {
+                    entry.referenced.store(true, std::memory_order_relaxed);
+                }
+                shard.hits.fetch_add(1, std::memory_order_relaxed);
+                if (entry.tile_data) {
+                    return entry.tile_data;
+                }
+                compressed = entry.compressed;
+            }
+        }
+
+        if (compressed) {
+            if (auto hot = FindHotTile(key, compressed)) {
+                return hot;
+            }
+
+            // Decode outside the locks; a hot copy of a replaced entry is
+            // never returned, since it no longer matches the entry's source
+            shard.decompressions.fetch_add(1, std::memory_order_relaxed);
+            std::shared_ptr<SRTMTileData> tile_data = compressed->Decompress();
+            AddHotTile(key, std::move(compressed), tile_data);
+            return tile_data;
         }
 
         // Check disk cache if enabled
-        if (config_.enable_disk_cache) {
-            auto tile_data = ReadFromDiskCache(coordinates);
+        const ElevationCacheConfig config = GetConfiguration();
+        if (config.enable_disk_cache) {
+            std::shared_ptr<SRTMTileData> tile_data;
+            {
+                std::lock_guard<std::mutex> lock(disk_mutex_);
+                tile_data = ReadFromDiskCache(config.disk_cache_directory, coordinates, level);
+            }
             if (tile_data) {
-                ++stats_.disk_cache_hits;
+                disk_hits_.fetch_add(1, std::memory_order_relaxed);
 
                 // Add to memory cache
-                const size_t tile_size = tile_data->GetMetadata().file_size;
-
-                // Evict if needed
-                while (stats_.memory_cache_size_bytes + tile_size >
-                           config_.max_memory_cache_size &&
-                       !lru_list_.empty()) {
-                    EvictLRU();
+                if (config.compress_memory_tiles) {
+                    auto compressed_tile =
+                        std::make_shared<const CompressedElevationTile>(*tile_data);
+                    InsertEntry(key, nullptr, compressed_tile, compressed_tile->GetSizeBytes());
+                    AddHotTile(key, std::move(compressed_tile), tile_data);
+                } else {
+                    InsertEntry(key, tile_data, nullptr, tile_data->GetMetadata().file_size);
                 }
 
-                // Add to memory cache
-                auto entry = std::make_shared<CacheEntry>(
-                    coordinates, tile_data, tile_size);
-
-                lru_list_.push_front(entry);
-                memory_cache_[coordinates] = lru_list_.begin();
-                stats_.memory_cache_size_bytes += tile_size;
-                stats_.tile_count_memory = memory_cache_.size();
-
                 return tile_data;
             }
         }
 
-        ++stats_.cache_misses;
+        misses_.fetch_add(1, std::memory_order_relaxed);
         return std::nullopt;
     }
 
     bool Contains(const SRTMCoordinates& coordinates) const override {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-
         // Check memory cache
-        if (memory_cache_.find(coordinates) != memory_cache_.end()) {
-            return true;
+        const CacheKey key{coordinates, 0};
+        {
+            const CacheShard& shard = ShardFor(key);
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            if (shard.entries.find(key) != shard.entries.end()) {
+                return true;
+            }
         }
 
         // Check disk cache
-        if (config_.enable_disk_cache) {
-            const std::string filename = FormatSRTMFilename(coordinates);
-            const std::string filepath = config_.disk_cache_directory + "/" + filename;
-            return std::filesystem::exists(filepath);
+        const ElevationCacheConfig config = GetConfiguration();
+        if (config.enable_disk_cache) {
+            return std::filesystem::exists(NativeCachePath(config.disk_cache_directory, coordinates)) ||
+                   std::filesystem::exists(LegacyCachePath(config.disk_cache_directory, coordinates));
         }
 
         return false;
     }
 
     bool Remove(const SRTMCoordinates& coordinates) override {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-
-        bool removed = RemoveFromMemoryCache(coordinates);
-
-        // Remove from disk cache
-        if (config_.enable_disk_cache) {
-            const std::string filename = FormatSRTMFilename(coordinates);
-            const std::string filepath = config_.disk_cache_directory + "/" + filename;
+        bool removed = false;
+        for (uint32_t level = 0; level <= kMaxElevationPyramidLevel; ++level) {
+            const CacheKey key{coordinates, level};
+            RemoveHotTile(key);
+            CacheShard& shard = ShardFor(key);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            const auto it = shard.entries.find(key);
+            if (it != shard.entries.end()) {
+                RemoveEntryLocked(shard, it->second);
+                removed = true;
+            }
+        }
 
-            try {
-                if (std::filesystem::remove(filepath)) {
-                    removed = true;
+        // Remove from disk cache (unlinking is safe while tiles map the file)
+        const ElevationCacheConfig config = GetConfiguration();
+        if (config.enable_disk_cache) {
+            std::vector<std::string> filepaths = {
+                LegacyCachePath(config.disk_cache_directory, coordinates)};
+            for (uint32_t level = 0; level <= kMaxElevationPyramidLevel; ++level) {
+                filepaths.push_back(NativeCachePath(config.disk_cache_directory, coordinates, level));
+            }
+            std::lock_guard<std::mutex> lock(disk_mutex_);
+            for (const auto& filepath : filepaths) {
+                try {
+                    if (std::filesystem::remove(filepath)) {
+                        removed = true;
+                    }
+                } catch (...) {
+                    // Ignore errors
                 }
-            } catch (...) {
-                // Ignore errors
             }
         }
 
@@ -181,79 +305,89 @@ public:
     }
 
     void Clear() override {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-
-        lru_list_.clear();
-        memory_cache_.clear();
-        stats_.memory_cache_size_bytes = 0;
-        stats_.tile_count_memory = 0;
-
-        if (config_.enable_disk_cache) {
-            try {
-                std::filesystem::remove_all(config_.disk_cache_directory);
-                std::filesystem::create_directories(config_.disk_cache_directory);
-                stats_.disk_cache_size_bytes = 0;
-                stats_.tile_count_disk = 0;
-            } catch (...) {
-                // Ignore errors
-            }
-        }
+        ClearMemoryCache();
+        ClearDiskCache();
     }
 
     void ClearMemoryCache() override {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
+        for (auto& shard : shards_) {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            while (!shard.ring.empty()) {
+                RemoveEntryLocked(shard, shard.ring.begin());
+            }
+        }
 
-        lru_list_.clear();
-        memory_cache_.clear();
-        stats_.memory_cache_size_bytes = 0;
-        stats_.tile_count_memory = 0;
+        std::lock_guard<std::mutex> lock(hot_mutex_);
+        hot_tiles_.clear();
     }
 
     void ClearDiskCache() override {
-        if (!config_.enable_disk_cache) {
+        const ElevationCacheConfig config = GetConfiguration();
+        if (!config.enable_disk_cache) {
             return;
         }
 
-        std::lock_guard<std::mutex> lock(cache_mutex_);
+        std::lock_guard<std::mutex> lock(disk_mutex_);
 
         try {
-            std::filesystem::remove_all(config_.disk_cache_directory);
-            std::filesystem::create_directories(config_.disk_cache_directory);
-            stats_.disk_cache_size_bytes = 0;
-            stats_.tile_count_disk = 0;
+            std::filesystem::remove_all(config.disk_cache_directory);
+            std::filesystem::create_directories(config.disk_cache_directory);
+            disk_stats_.disk_cache_size_bytes = 0;
+            disk_stats_.tile_count_disk = 0;
         } catch (...) {
             // Ignore errors
         }
     }
 
     ElevationCacheStats GetStatistics() const override {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-        return stats_;
+        ElevationCacheStats stats;
+        {
+            std::lock_guard<std::mutex> lock(disk_mutex_);
+            stats.disk_cache_size_bytes = disk_stats_.disk_cache_size_bytes;
+            stats.tile_count_disk = disk_stats_.tile_count_disk;
+        }
+        for (const auto& shard : shards_) {
+            stats.memory_cache_hits += shard.hits.load(std::memory_order_relaxed);
+            stats.decompressions += shard.decompressions.load(std::memory_order_relaxed);
+        }
+        stats.disk_cache_hits = disk_hits_.load(std::memory_order_relaxed);
+        stats.cache_misses = misses_.load(std::memory_order_relaxed);
+        stats.memory_cache_size_bytes = memory_size_bytes_.load(std::memory_order_relaxed);
+        stats.tile_count_memory = tile_count_memory_.load(std::memory_order_relaxed);
+        stats.evictions = evictions_.load(std::memory_order_relaxed);
+        return stats;
     }
 
     ElevationCacheConfig GetConfiguration() const override {
+        std::lock_guard<std::mutex> lock(config_mutex_);
         return config_;
     }
 
     bool SetConfiguration(const ElevationCacheConfig& config) override {
-        std::lock_guard<std::mutex> lock(cache_mutex_);
-
-        const bool disk_cache_changed =
-            (config.enable_disk_cache != config_.enable_disk_cache) ||
-            (config.disk_cache_directory != config_.disk_cache_directory);
-
-        config_ = config;
+        bool disk_cache_changed = false;
+        {
+            std::lock_guard<std::mutex> lock(config_mutex_);
+            disk_cache_changed =
+                (config.enable_disk_cache != config_.enable_disk_cache) ||
+                (config.disk_cache_directory != config_.disk_cache_directory);
+            config_ = config;
+        }
 
-        // Clear memory cache if size limit decreased
-        while (stats_.memory_cache_size_bytes > config_.max_memory_cache_size &&
-               !lru_list_.empty()) {
-            EvictLRU();
+        // Evict if the size limit decreased
+        max_memory_bytes_.store(config.max_memory_cache_size, std::memory_order_relaxed);
+        EvictToFit(nullptr);
+        {
+            std::lock_guard<std::mutex> lock(hot_mutex_);
+            hot_tile_count_ = config.hot_tile_count;
+            if (hot_tiles_.size() > hot_tile_count_) {
+                hot_tiles_.resize(hot_tile_count_);
+            }
         }
 
         // Create disk cache directory if enabled
-        if (config_.enable_disk_cache && disk_cache_changed) {
+        if (config.enable_disk_cache && disk_cache_changed) {
             try {
-                std::filesystem::create_directories(config_.disk_cache_directory);
+                std::filesystem::create_directories(config.disk_cache_directory);
             } catch (...) {
                 return false;
             }
@@ -263,17 +397,26 @@ public:
     }
 
     size_t Flush() override {
-        if (!config_.enable_disk_cache) {
+        const ElevationCacheConfig config = GetConfiguration();
+        if (!config.enable_disk_cache) {
             return 0;
         }
 
-        std::lock_guard<std::mutex> lock(cache_mutex_);
+        // Snapshot the entries, then decode and write without shard locks
+        std::vector<std::pair<std::shared_ptr<SRTMTileData>,
+                              std::shared_ptr<const CompressedElevationTile>>> tiles;
+        for (const auto& shard : shards_) {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            for (const auto& entry : shard.ring) {
+                tiles.emplace_back(entry.tile_data, entry.compressed);
+            }
+        }
 
+        std::lock_guard<std::mutex> lock(disk_mutex_);
         size_t flushed = 0;
-
-        for (const auto& pair : memory_cache_) {
-            const auto& entry = *pair.second;
-            if (WriteToDiskCache(*entry->tile_data)) {
+        for (const auto& [tile_data, compressed] : tiles) {
+            const auto tile = tile_data ? tile_data : compressed->Decompress();
+            if (WriteToDiskCache(config.disk_cache_directory, *tile)) {
                 ++flushed;
             }
         }
@@ -282,19 +425,20 @@ public:
     }
 
     size_t PruneExpired() override {
-        if (!config_.enable_disk_cache) {
+        const ElevationCacheConfig config = GetConfiguration();
+        if (!config.enable_disk_cache) {
             return 0;
         }
 
-        std::lock_guard<std::mutex> lock(cache_mutex_);
+        std::lock_guard<std::mutex> lock(disk_mutex_);
 
         size_t pruned = 0;
         const auto now = std::chrono::system_clock::now();
-        const auto ttl = std::chrono::seconds(config_.tile_ttl_seconds);
+        const auto ttl = std::chrono::seconds(config.tile_ttl_seconds);
 
         try {
             for (const auto& entry : std::filesystem::directory_iterator(
-                     config_.disk_cache_directory)) {
+                     config.disk_cache_directory)) {
                 if (entry.is_regular_file()) {
                     const auto file_time = std::filesystem::last_write_time(entry);
                     const auto system_time = std::chrono::time_point_cast<
@@ -315,91 +459,191 @@ public:
     }
 
 private:
-    bool RemoveFromMemoryCache(const SRTMCoordinates& coordinates) {
-        auto it = memory_cache_.find(coordinates);
-        if (it != memory_cache_.end()) {
-            const size_t tile_size = (*it->second)->size_bytes;
-            lru_list_.erase(it->second);
-            memory_cache_.erase(it);
+    CacheShard& ShardFor(const CacheKey& key) {
+        return shards_[MixHash(CacheKeyHash{}(key)) & (kShardCount - 1)];
+    }
 
-            stats_.memory_cache_size_bytes -= tile_size;
-            stats_.tile_count_memory = memory_cache_.size();
-            return true;
-        }
-        return false;
+    const CacheShard& ShardFor(const CacheKey& key) const {
+        return shards_[MixHash(CacheKeyHash{}(key)) & (kShardCount - 1)];
     }
 
-    void EvictLRU() {
-        if (lru_list_.empty()) {
-            return;
+    /// Insert or replace an entry, then evict other entries to fit the budget
+    void InsertEntry(const CacheKey& key,
+                     std::shared_ptr<SRTMTileData> tile_data,
+                     std::shared_ptr<const CompressedElevationTile> compressed,
+                     size_t size_bytes) {
+        {
+            CacheShard& shard = ShardFor(key);
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            const auto it = shard.entries.find(key);
+            if (it != shard.entries.end()) {
+                RemoveEntryLocked(shard, it->second);
+            }
+            const auto position = shard.ring.emplace(shard.hand, key, std::move(tile_data),
+                                                     std::move(compressed), size_bytes);
+            shard.entries.emplace(key, position);
+            memory_size_bytes_.fetch_add(size_bytes, std::memory_order_relaxed);
+            tile_count_memory_.fetch_add(1, std::memory_order_relaxed);
         }
 
-        auto& entry = lru_list_.back();
-        const size_t tile_size = entry->size_bytes;
-
-        memory_cache_.erase(entry->coordinates);
-        lru_list_.pop_back();
+        EvictToFit(&key);
+    }
 
-        stats_.memory_cache_size_bytes -= tile_size;
-        stats_.tile_count_memory = memory_cache_.size();
-        ++stats_.evictions;
+    void RemoveEntryLocked(CacheShard& shard, CacheShard::Ring::iterator position) {
+        if (shard.hand == position) {
+            ++shard.hand;
+        }
+        memory_size_bytes_.fetch_sub(position->size_bytes, std::memory_order_relaxed);
+        tile_count_memory_.fetch_sub(1, std::memory_order_relaxed);
+        shard.entries.erase(position->key);
+        shard.ring.erase(position);
     }
 
-    bool WriteToDiskCache(const SRTMTileData& tile_data) {
-        const auto& coords = tile_data.GetMetadata().coordinates;
-        const std::string filename = FormatSRTMFilename(coords);
-        const std::string filepath = config_.disk_cache_directory + "/" + filename;
+    /// Sweep a shard's CLOCK hand, for at most one turn, to its first
+    /// unreferenced entry, clearing the bits it passes
+    /// @return Victim, or ring.end() if the shard has none but @p keep
+    static CacheShard::Ring::iterator FindVictimLocked(CacheShard& shard, const CacheKey* keep) {
+        for (size_t step = 0; step < shard.ring.size() + 1; ++step) {
+            if (shard.hand == shard.ring.end()) {
+                shard.hand = shard.ring.begin();
+                continue;
+            }
+            CacheEntry& entry = *shard.hand;
+            if ((keep && entry.key == *keep) ||
+                entry.referenced.exchange(false, std::memory_order_relaxed)) {
+                ++shard.hand;
+                continue;
+            }
+            return shard.hand;
+        }
+        return shard.ring.end();
+    }
 
-        try {
-            std::ofstream file(filepath, std::ios::binary);
-            if (!file.is_open()) {
-                return false;
+    /// Evict until the memory budget holds; @p keep is never evicted
+    void EvictToFit(const CacheKey* keep) {
+        size_t shards_without_victim = 0;
+
+        // Give up after two rounds over the shards found nothing to evict
+        // (the first one may only have cleared reference bits)
+        while (memory_size_bytes_.load(std::memory_order_relaxed) >
+                   max_memory_bytes_.load(std::memory_order_relaxed) &&
+               shards_without_victim < 2 * kShardCount) {
+            const size_t index =
+                eviction_cursor_.fetch_add(1, std::memory_order_relaxed) & (kShardCount - 1);
+            CacheShard& shard = shards_[index];
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+            const auto victim = FindVictimLocked(shard, keep);
+            if (victim == shard.ring.end()) {
+                ++shards_without_victim;
+                continue;
             }
 
-            const auto& raw_data = tile_data.GetRawData();
+            RemoveEntryLocked(shard, victim);
+            evictions_.fetch_add(1, std::memory_order_relaxed);
+            shards_without_victim = 0;
+        }
+    }
 
-            // Convert to big-endian format (HGT standard) before writing
-            std::vector<uint8_t> big_endian_data(raw_data.size() * 2);
-            for (size_t i = 0; i < raw_data.size(); ++i) {
-                const int16_t value = raw_data[i];
-                // Write high byte first (big-endian)
-                big_endian_data[i * 2] = static_cast<uint8_t>((value >> 8) & 0xFF);
-                big_endian_data[i * 2 + 1] = static_cast<uint8_t>(value & 0xFF);
+    /// Decompressed copy of a compressed entry, if still hot
+    std::shared_ptr<SRTMTileData> FindHotTile(
+        const CacheKey& key, const std::shared_ptr<const CompressedElevationTile>& source) {
+        std::lock_guard<std::mutex> lock(hot_mutex_);
+        for (auto it = hot_tiles_.begin(); it != hot_tiles_.end(); ++it) {
+            if (it->key == key && it->source == source) {
+                hot_tiles_.splice(hot_tiles_.begin(), hot_tiles_, it);
+                return it->tile_data;
             }
+        }
+        return nullptr;
+    }
 
-            file.write(reinterpret_cast<const char*>(big_endian_data.data()),
-                       big_endian_data.size());
+    void AddHotTile(const CacheKey& key,
+                    std::shared_ptr<const CompressedElevationTile> source,
+                    std::shared_ptr<SRTMTileData> tile_data) {
+        std::lock_guard<std::mutex> lock(hot_mutex_);
+        hot_tiles_.remove_if([&key](const HotTile& hot) { return hot.key == key; });
+        hot_tiles_.push_front(HotTile{key, std::move(source), std::move(tile_data)});
+        if (hot_tiles_.size() > hot_tile_count_) {
+            hot_tiles_.resize(hot_tile_count_);
+        }
+    }
 
-            return file.good();
-        } catch (...) {
-            return false;
+    void RemoveHotTile(const CacheKey& key) {
+        std::lock_guard<std::mutex> lock(hot_mutex_);
+        hot_tiles_.remove_if([&key](const HotTile& hot) { return hot.key == key; });
+    }
+
+    /// Native-endian cache file, mapped in place by ReadFromDiskCache
+    /// (N37W122.hgt.native, or N37W122.hgt.L3.native for pyramid level 3)
+    static std::string NativeCachePath(const std::string& directory,
+                                       const SRTMCoordinates& coordinates, uint32_t level = 0) {
+        std::string path = directory + "/" + FormatSRTMFilename(coordinates);
+        if (level > 0) {
+            path += ".L" + std::to_string(level);
         }
+        return path + kNativeCacheSuffix;
     }
 
-    std::shared_ptr<SRTMTileData> ReadFromDiskCache(
-        const SRTMCoordinates& coordinates) {
+    /// Big-endian HGT cache file written by earlier versions
+    static std::string LegacyCachePath(const std::string& directory,
+                                       const SRTMCoordinates& coordinates) {
+        return directory + "/" + FormatSRTMFilename(coordinates);
+    }
 
-        const std::string filename = FormatSRTMFilename(coordinates);
-        const std::string filepath = config_.disk_cache_directory + "/" + filename;
+    // Disk cache access (disk_mutex_ held)
+    static bool WriteToDiskCache(const std::string& directory, const SRTMTileData& tile_data) {
+        const auto& metadata = tile_data.GetMetadata();
+        return HGTParser::WriteNativeFile(
+            tile_data, NativeCachePath(directory, metadata.coordinates, metadata.level));
+    }
 
-        if (!std::filesystem::exists(filepath)) {
-            return nullptr;
+    static std::shared_ptr<SRTMTileData> ReadFromDiskCache(
+        const std::string& directory, const SRTMCoordinates& coordinates, uint32_t level) {
+
+        // Native form: the tile views the mapping, no parse step
+        auto tile_data = HGTParser::MapNativeFile(NativeCachePath(directory, coordinates, level),
+                                                  coordinates, level);
+        if (tile_data || level > 0) {
+            return tile_data;
         }
 
-        // Use HGT parser to read the file
-        // Note: Cache files use same format as HGT files
-        return HGTParser::ParseFile(filepath);
+        // Legacy HGT form: parse it once and keep it in the native form
+        const std::string legacy_path = LegacyCachePath(directory, coordinates);
+        if (!std::filesystem::exists(legacy_path)) {
+            return nullptr;
+        }
+        tile_data = HGTParser::ParseFile(legacy_path);
+        if (tile_data && WriteToDiskCache(directory, *tile_data)) {
+            std::error_code ignored;
+            std::filesystem::remove(legacy_path, ignored);
+        }
+        return tile_data;
     }
 
+    mutable std::mutex config_mutex_;
     ElevationCacheConfig config_;
-    ElevationCacheStats stats_;
-
-    mutable std::mutex cache_mutex_;
 
-    // LRU cache data structures
-    using LRUList = std::list<std::shared_ptr<CacheEntry>>;
-    LRUList lru_list_;
-    std::unordered_map<SRTMCoordinates, LRUList::iterator> memory_cache_;
+    // Memory cache
+    std::array<CacheShard, kShardCount> shards_;
+    std::atomic<size_t> max_memory_bytes_;
+    std::atomic<size_t> memory_size_bytes_{0};
+    std::atomic<size_t> tile_count_memory_{0};
+    std::atomic<uint64_t> evictions_{0};
+
+    /// Next shard asked to give up a tile
+    std::atomic<size_t> eviction_cursor_{0};
+
+    // Most recently decoded compressed tiles (at most hot_tile_count_)
+    std::mutex hot_mutex_;
+    std::list<HotTile> hot_tiles_;
+    size_t hot_tile_count_;
+
+    // Disk cache
+    mutable std::mutex disk_mutex_;
+    ElevationCacheStats disk_stats_;  ///< Disk fields only
+    std::atomic<uint64_t> disk_hits_{0};
+    std::atomic<uint64_t> misses_{0};
 };
 
 std::unique_ptr<ElevationCache> ElevationCache::Create(
@@ -5,9 +5,230 @@
 
 #include <algorithm>
 #include <cmath>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define EARTH_MAP_ELEVATION_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define EARTH_MAP_ELEVATION_NEON 1
+#include <arm_neon.h>
+#endif
 
 namespace earth_map {
 
+namespace {
+
+/// Largest fraction sampled, as in InterpolateElevation
+constexpr double kMaxFraction = 0.999999;
+
+/// SRTM void marker
+constexpr int32_t kVoidElevation = -32768;
+
+/// Row-major samples of a tile, at least 2 x 2
+struct SampleGrid {
+    const int16_t* data;
+    int32_t samples;
+};
+
+/// Clamp a fraction to [0, kMaxFraction] (NaN becomes 0)
+[[nodiscard]] double ClampFraction(double fraction) noexcept {
+    return fraction > 0.0 ? std::min(fraction, kMaxFraction) : 0.0;
+}
+
+/// Interpolate points [begin, count) one at a time. The kernels do the
+/// same double operations in the same order as InterpolateElevation, so
+/// their results are identical to it.
+void InterpolateRangeScalar(const SampleGrid& grid, const double* lat_fractions,
+                            const double* lon_fractions, float* elevations,
+                            size_t begin, size_t count) noexcept {
+    const double scale = static_cast<double>(grid.samples - 1);
+    const int32_t max_index = grid.samples - 2;
+    for (size_t i = begin; i < count; ++i) {
+        // Row 0 is northernmost; x and y are non-negative, so truncation floors
+        const double x = ClampFraction(lon_fractions[i]) * scale;
+        const double y = (1.0 - ClampFraction(lat_fractions[i])) * scale;
+        const int32_t x0 = std::min(static_cast<int32_t>(x), max_index);
+        const int32_t y0 = std::min(static_cast<int32_t>(y), max_index);
+        const double dx = x - x0;
+        const double dy = y - y0;
+
+        const int16_t* top = grid.data + static_cast<size_t>(y0) * grid.samples + x0;
+        const int16_t* bottom = top + grid.samples;
+        if (top[0] == kVoidElevation || top[1] == kVoidElevation ||
+            bottom[0] == kVoidElevation || bottom[1] == kVoidElevation) {
+            elevations[i] = 0.0f;
+            continue;
+        }
+
+        const double h0 = top[0] * (1.0 - dx) + top[1] * dx;
+        const double h1 = bottom[0] * (1.0 - dx) + bottom[1] * dx;
+        elevations[i] = static_cast<float>(h0 * (1.0 - dy) + h1 * dy);
+    }
+}
+
+#if defined(EARTH_MAP_ELEVATION_X86)
+
+/// Points [0, returned) interpolated four at a time (one double per lane)
+///
+/// One 32-bit gather per row fetches both horizontal neighbors: the low
+/// half is the sample at x0, the high half the one at x0 + 1.
+__attribute__((target("avx2")))
+size_t InterpolateAvx2(const SampleGrid& grid, const double* lat_fractions,
+                       const double* lon_fractions, float* elevations, size_t count) noexcept {
+    const __m256d scale = _mm256_set1_pd(static_cast<double>(grid.samples - 1));
+    const __m256d one = _mm256_set1_pd(1.0);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d max_fraction = _mm256_set1_pd(kMaxFraction);
+    const __m128i max_index = _mm_set1_epi32(grid.samples - 2);
+    const __m128i stride = _mm_set1_epi32(grid.samples);
+    const __m128i void_elevation = _mm_set1_epi32(kVoidElevation);
+    const auto* base = reinterpret_cast<const int*>(grid.data);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        // max(value, 0) returns 0 for NaN, as ClampFraction does
+        const __m256d lat = _mm256_min_pd(
+            _mm256_max_pd(_mm256_loadu_pd(lat_fractions + i), zero), max_fraction);
+        const __m256d lon = _mm256_min_pd(
+            _mm256_max_pd(_mm256_loadu_pd(lon_fractions + i), zero), max_fraction);
+
+        const __m256d x = _mm256_mul_pd(lon, scale);
+        const __m256d y = _mm256_mul_pd(_mm256_sub_pd(one, lat), scale);
+        const __m128i x0 = _mm_min_epi32(_mm256_cvttpd_epi32(x), max_index);
+        const __m128i y0 = _mm_min_epi32(_mm256_cvttpd_epi32(y), max_index);
+        const __m256d dx = _mm256_sub_pd(x, _mm256_cvtepi32_pd(x0));
+        const __m256d dy = _mm256_sub_pd(y, _mm256_cvtepi32_pd(y0));
+
+        const __m128i index = _mm_add_epi32(_mm_mullo_epi32(y0, stride), x0);
+        const __m128i top = _mm_i32gather_epi32(base, index, 2);
+        const __m128i bottom = _mm_i32gather_epi32(base, _mm_add_epi32(index, stride), 2);
+
+        // Sign-extend the 16-bit halves
+        const __m128i h00 = _mm_srai_epi32(_mm_slli_epi32(top, 16), 16);
+        const __m128i h10 = _mm_srai_epi32(top, 16);
+        const __m128i h01 = _mm_srai_epi32(_mm_slli_epi32(bottom, 16), 16);
+        const __m128i h11 = _mm_srai_epi32(bottom, 16);
+        const __m128i is_void = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi32(h00, void_elevation),
+                         _mm_cmpeq_epi32(h10, void_elevation)),
+            _mm_or_si128(_mm_cmpeq_epi32(h01, void_elevation),
+                         _mm_cmpeq_epi32(h11, void_elevation)));
+
+        const __m256d wx = _mm256_sub_pd(one, dx);
+        const __m256d h0 = _mm256_add_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(h00), wx),
+                                         _mm256_mul_pd(_mm256_cvtepi32_pd(h10), dx));
+        const __m256d h1 = _mm256_add_pd(_mm256_mul_pd(_mm256_cvtepi32_pd(h01), wx),
+                                         _mm256_mul_pd(_mm256_cvtepi32_pd(h11), dx));
+        const __m256d elevation = _mm256_add_pd(_mm256_mul_pd(h0, _mm256_sub_pd(one, dy)),
+                                                _mm256_mul_pd(h1, dy));
+        // Widen the 32-bit void mask to the 64-bit lanes
+        const __m256d void_mask = _mm256_castsi256_pd(_mm256_cvtepi32_epi64(is_void));
+        _mm_storeu_ps(elevations + i, _mm256_cvtpd_ps(_mm256_andnot_pd(void_mask, elevation)));
+    }
+    return i;
+}
+
+bool DetectAvx2() {
+    return __builtin_cpu_supports("avx2");
+}
+
+const bool kAvx2 = DetectAvx2();
+
+#elif defined(EARTH_MAP_ELEVATION_NEON)
+
+/// Points [0, returned) interpolated two at a time (one double per lane)
+///
+/// NEON has no gather: the corner samples are loaded per lane, the rest is
+/// vectorized.
+size_t InterpolateNeon(const SampleGrid& grid, const double* lat_fractions,
+                       const double* lon_fractions, float* elevations, size_t count) noexcept {
+    const float64x2_t scale = vdupq_n_f64(static_cast<double>(grid.samples - 1));
+    const float64x2_t one = vdupq_n_f64(1.0);
+    const float64x2_t zero = vdupq_n_f64(0.0);
+    const float64x2_t max_fraction = vdupq_n_f64(kMaxFraction);
+    const int64x2_t max_index = vdupq_n_s64(grid.samples - 2);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        // maxnm returns the number when one operand is NaN, as ClampFraction does
+        const float64x2_t lat =
+            vminq_f64(vmaxnmq_f64(vld1q_f64(lat_fractions + i), zero), max_fraction);
+        const float64x2_t lon =
+            vminq_f64(vmaxnmq_f64(vld1q_f64(lon_fractions + i), zero), max_fraction);
+
+        const float64x2_t x = vmulq_f64(lon, scale);
+        const float64x2_t y = vmulq_f64(vsubq_f64(one, lat), scale);
+        int64x2_t x0 = vcvtq_s64_f64(x);
+        int64x2_t y0 = vcvtq_s64_f64(y);
+        x0 = vbslq_s64(vcgtq_s64(x0, max_index), max_index, x0);
+        y0 = vbslq_s64(vcgtq_s64(y0, max_index), max_index, y0);
+        const float64x2_t dx = vsubq_f64(x, vcvtq_f64_s64(x0));
+        const float64x2_t dy = vsubq_f64(y, vcvtq_f64_s64(y0));
+
+        int64_t columns[2];
+        int64_t rows[2];
+        vst1q_s64(columns, x0);
+        vst1q_s64(rows, y0);
+        double corners[4][2];
+        uint64_t is_void[2];
+        for (int lane = 0; lane < 2; ++lane) {
+            const int16_t* top = grid.data + rows[lane] * grid.samples + columns[lane];
+            const int16_t* bottom = top + grid.samples;
+            corners[0][lane] = top[0];
+            corners[1][lane] = top[1];
+            corners[2][lane] = bottom[0];
+            corners[3][lane] = bottom[1];
+            is_void[lane] = (top[0] == kVoidElevation || top[1] == kVoidElevation ||
+                             bottom[0] == kVoidElevation || bottom[1] == kVoidElevation)
+                ? ~uint64_t{0} : 0;
+        }
+
+        const float64x2_t wx = vsubq_f64(one, dx);
+        const float64x2_t h0 = vaddq_f64(vmulq_f64(vld1q_f64(corners[0]), wx),
+                                         vmulq_f64(vld1q_f64(corners[1]), dx));
+        const float64x2_t h1 = vaddq_f64(vmulq_f64(vld1q_f64(corners[2]), wx),
+                                         vmulq_f64(vld1q_f64(corners[3]), dx));
+        const float64x2_t elevation =
+            vaddq_f64(vmulq_f64(h0, vsubq_f64(one, dy)), vmulq_f64(h1, dy));
+        const float64x2_t masked = vreinterpretq_f64_u64(
+            vbicq_u64(vreinterpretq_u64_f64(elevation), vld1q_u64(is_void)));
+        vst1_f32(elevations + i, vcvt_f32_f64(masked));
+    }
+    return i;
+}
+
+#endif
+
+/// Tent filter taps of one output sample along one axis
+struct FilterTaps {
+    size_t first;                ///< First source sample
+    std::vector<float> weights;  ///< Weights of consecutive source samples
+};
+
+/// Taps resampling @p source_size samples to @p size along an axis: output
+/// sample i sits at source position i * scale and weighs the source samples
+/// closer than one output spacing (scale) to it
+std::vector<FilterTaps> BuildFilterTaps(size_t source_size, size_t size) {
+    const double scale = static_cast<double>(source_size - 1) / static_cast<double>(size - 1);
+    std::vector<FilterTaps> taps(size);
+    for (size_t i = 0; i < size; ++i) {
+        const double center = static_cast<double>(i) * scale;
+        const auto first = static_cast<size_t>(std::max(0.0, std::floor(center - scale) + 1.0));
+        const auto last = std::min(source_size - 1,
+                                   static_cast<size_t>(std::ceil(center + scale) - 1.0));
+        taps[i].first = first;
+        for (size_t t = first; t <= last; ++t) {
+            const double distance = std::abs(static_cast<double>(t) - center);
+            taps[i].weights.push_back(static_cast<float>(std::max(0.0, 1.0 - distance / scale)));
+        }
+    }
+    return taps;
+}
+
+} // namespace
+
 SRTMTileData::SRTMTileData(const SRTMMetadata& metadata)
     : metadata_(metadata), valid_(false) {
     // Allocate storage for elevation data
@@ -15,6 +236,27 @@ SRTMTileData::SRTMTileData(const SRTMMetadata& metadata)
     elevation_data_.resize(total_samples, 0);
 }
 
+SRTMTileData::SRTMTileData(const SRTMMetadata& metadata, std::vector<int16_t> samples) noexcept
+    : metadata_(metadata), elevation_data_(std::move(samples)), valid_(false) {}
+
+SRTMTileData::SRTMTileData(const SRTMMetadata& metadata,
+                           std::shared_ptr<const void> mapping,
+                           const int16_t* samples) noexcept
+    : metadata_(metadata),
+      valid_(false),
+      mapped_samples_(samples),
+      mapping_(std::move(mapping)) {}
+
+std::vector<int16_t>& SRTMTileData::GetRawData() {
+    if (mapped_samples_) {
+        const auto samples = GetSamples();
+        elevation_data_.assign(samples.begin(), samples.end());
+        mapped_samples_ = nullptr;
+        mapping_.reset();
+    }
+    return elevation_data_;
+}
+
 ElevationSample SRTMTileData::GetSample(size_t x, size_t y) const noexcept {
     // Validate indices
     if (x >= metadata_.samples_per_side || y >= metadata_.samples_per_side) {
@@ -23,7 +265,7 @@ ElevationSample SRTMTileData::GetSample(size_t x, size_t y) const noexcept {
 
     // Row-major order: [y * width + x]
     const size_t index = y * metadata_.samples_per_side + x;
-    const int16_t elevation = elevation_data_[index];
+    const int16_t elevation = SampleData()[index];
 
     return ElevationSample{elevation};
 }
@@ -74,4 +316,103 @@ float SRTMTileData::InterpolateElevation(double lat_fraction,
     return static_cast<float>(interpolated);
 }
 
+void SRTMTileData::InterpolateElevations(std::span<const double> lat_fractions,
+                                         std::span<const double> lon_fractions,
+                                         std::span<float> elevations) const noexcept {
+    const size_t count =
+        std::min({lat_fractions.size(), lon_fractions.size(), elevations.size()});
+    const size_t samples = metadata_.samples_per_side;
+    if (!valid_ || samples < 2 || GetSamples().size() < samples * samples) {
+        std::fill_n(elevations.begin(), count, 0.0f);
+        return;
+    }
+
+    // Full SIMD groups first, then the remainder one point at a time
+    const SampleGrid grid{SampleData(), static_cast<int32_t>(samples)};
+    size_t done = 0;
+#if defined(EARTH_MAP_ELEVATION_X86)
+    if (kAvx2) {
+        done = InterpolateAvx2(grid, lat_fractions.data(), lon_fractions.data(),
+                               elevations.data(), count);
+    }
+#elif defined(EARTH_MAP_ELEVATION_NEON)
+    done = InterpolateNeon(grid, lat_fractions.data(), lon_fractions.data(),
+                           elevations.data(), count);
+#endif
+    InterpolateRangeScalar(grid, lat_fractions.data(), lon_fractions.data(),
+                           elevations.data(), done, count);
+}
+
+void SRTMTileData::InterpolateElevationsScalar(std::span<const double> lat_fractions,
+                                               std::span<const double> lon_fractions,
+                                               std::span<float> elevations) const noexcept {
+    const size_t count =
+        std::min({lat_fractions.size(), lon_fractions.size(), elevations.size()});
+    const size_t samples = metadata_.samples_per_side;
+    if (!valid_ || samples < 2 || GetSamples().size() < samples * samples) {
+        std::fill_n(elevations.begin(), count, 0.0f);
+        return;
+    }
+
+    const SampleGrid grid{SampleData(), static_cast<int32_t>(samples)};
+    InterpolateRangeScalar(grid, lat_fractions.data(), lon_fractions.data(),
+                           elevations.data(), 0, count);
+}
+
+std::unique_ptr<SRTMTileData> SRTMTileData::Downsample(uint32_t level) const {
+    const size_t source_size = metadata_.samples_per_side;
+    if (!valid_ || level <= metadata_.level || level > kMaxElevationPyramidLevel ||
+        source_size < 2 || GetSamples().size() < source_size * source_size) {
+        return nullptr;
+    }
+
+    auto result = std::make_unique<SRTMTileData>(
+        SRTMMetadata(metadata_.coordinates, metadata_.resolution, level));
+    const size_t size = result->metadata_.samples_per_side;
+    const std::vector<FilterTaps> taps = BuildFilterTaps(source_size, size);
+    const int16_t* source = SampleData();
+
+    bool has_voids = false;
+    for (size_t y = 0; y < size; ++y) {
+        const FilterTaps& row_taps = taps[y];
+        for (size_t x = 0; x < size; ++x) {
+            const FilterTaps& column_taps = taps[x];
+            float sum = 0.0f;
+            float weight = 0.0f;
+            for (size_t j = 0; j < row_taps.weights.size(); ++j) {
+                const int16_t* row = source + (row_taps.first + j) * source_size + column_taps.first;
+                for (size_t i = 0; i < column_taps.weights.size(); ++i) {
+                    if (row[i] != kVoidElevation) {
+                        const float w = row_taps.weights[j] * column_taps.weights[i];
+                        sum += w * static_cast<float>(row[i]);
+                        weight += w;
+                    }
+                }
+            }
+
+            int16_t& out = result->elevation_data_[y * size + x];
+            if (weight > 0.0f) {
+                out = static_cast<int16_t>(std::lround(sum / weight));
+            } else {
+                out = static_cast<int16_t>(kVoidElevation);
+                has_voids = true;
+            }
+        }
+    }
+
+    result->SetHasVoids(has_voids);
+    result->SetValid(true);
+    return result;
+}
+
+bool SRTMTileData::IsBatchSimdAccelerated() noexcept {
+#if defined(EARTH_MAP_ELEVATION_X86)
+    return kAvx2;
+#elif defined(EARTH_MAP_ELEVATION_NEON)
+    return true;
+#else
+    return false;
+#endif
+}
+
 } // namespace earth_map
@@ -0,0 +1,123 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#include <earth_map/data/elevation_profile.h>
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace earth_map {
+
+using namespace coordinates;
+namespace {
+
+/// Sphere radius of GeodeticCalculator::HaversineDistance (WGS84 semi-major axis)
+constexpr double kPathRadius = 6378137.0;
+
+/// Tolerance on distances when deciding whether a sample still lies in a leg
+constexpr double kDistanceEpsilon = 1e-6;
+
+} // anonymous namespace
+
+GeodesicPathSampler::GeodesicPathSampler(const std::vector<Geographic>& path,
+                                         double spacing_meters)
+    : spacing_(spacing_meters) {
+    if (!(spacing_meters > 0.0)) {
+        throw std::invalid_argument("Profile spacing must be positive");
+    }
+    if (path.empty()) {
+        return;
+    }
+
+    vertices_.reserve(path.size());
+    for (const Geographic& point : path) {
+        const double lat = point.latitude * M_PI / 180.0;
+        const double lon = point.longitude * M_PI / 180.0;
+        vertices_.push_back({std::cos(lat) * std::cos(lon), std::cos(lat) * std::sin(lon),
+                             std::sin(lat)});
+    }
+    legs_.reserve(vertices_.size() - 1);
+    for (size_t i = 1; i < vertices_.size(); ++i) {
+        const Vector& a = vertices_[i - 1];
+        const Vector& b = vertices_[i];
+        const Vector cross{a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+        const double sin_angle = std::sqrt(cross.x * cross.x + cross.y * cross.y + cross.z * cross.z);
+        const double cos_angle = a.x * b.x + a.y * b.y + a.z * b.z;
+        legs_.push_back(std::atan2(sin_angle, cos_angle) * kPathRadius);
+        length_ += legs_.back();
+    }
+
+    sample_count_ = static_cast<size_t>(std::floor(length_ / spacing_ + kDistanceEpsilon)) + 1;
+    step_cos_ = std::cos(spacing_ / kPathRadius);
+    step_sin_ = std::sin(spacing_ / kPathRadius);
+    EnterLeg(0, 0.0);
+}
+
+void GeodesicPathSampler::EnterLeg(size_t leg, double offset) noexcept {
+    // Skip the legs the offset runs past (and empty ones)
+    while (leg < legs_.size() && offset > legs_[leg] - kDistanceEpsilon &&
+           leg + 1 < legs_.size()) {
+        offset -= legs_[leg];
+        ++leg;
+    }
+    leg_ = leg;
+    leg_offset_ = offset;
+
+    const Vector& a = vertices_[std::min(leg, vertices_.size() - 1)];
+    if (leg >= legs_.size()) {
+        position_ = a;
+        heading_ = {};
+        return;
+    }
+
+    // Heading: the leg end's component perpendicular to its start; a leg
+    // between antipodes has none, so head north (or along x at the poles)
+    const Vector& b = vertices_[leg + 1];
+    const double dot = a.x * b.x + a.y * b.y + a.z * b.z;
+    Vector heading{b.x - a.x * dot, b.y - a.y * dot, b.z - a.z * dot};
+    double norm = std::sqrt(heading.x * heading.x + heading.y * heading.y + heading.z * heading.z);
+    if (norm < 1e-12) {
+        heading = {-a.z * a.x, -a.z * a.y, 1.0 - a.z * a.z};
+        norm = std::sqrt(heading.x * heading.x + heading.y * heading.y + heading.z * heading.z);
+        if (norm < 1e-12) {
+            heading = {1.0, 0.0, 0.0};
+            norm = 1.0;
+        }
+    }
+    heading = {heading.x / norm, heading.y / norm, heading.z / norm};
+
+    const double angle = offset / kPathRadius;
+    const double c = std::cos(angle);
+    const double s = std::sin(angle);
+    position_ = {a.x * c + heading.x * s, a.y * c + heading.y * s, a.z * c + heading.z * s};
+    heading_ = {heading.x * c - a.x * s, heading.y * c - a.y * s, heading.z * c - a.z * s};
+}
+
+size_t GeodesicPathSampler::Next(std::span<Geographic> points) noexcept {
+    size_t written = 0;
+    while (written < points.size() && emitted_ < sample_count_) {
+        const double horizontal = std::sqrt(position_.x * position_.x + position_.y * position_.y);
+        points[written++] = Geographic(std::atan2(position_.z, horizontal) * 180.0 / M_PI,
+                                       std::atan2(position_.y, position_.x) * 180.0 / M_PI, 0.0);
+        if (++emitted_ == sample_count_) {
+            break;
+        }
+
+        leg_offset_ += spacing_;
+        if (leg_ < legs_.size() && leg_offset_ <= legs_[leg_] + kDistanceEpsilon) {
+            // Rotate position and heading together within the leg's plane
+            const Vector p = position_;
+            const Vector h = heading_;
+            position_ = {p.x * step_cos_ + h.x * step_sin_, p.y * step_cos_ + h.y * step_sin_,
+                         p.z * step_cos_ + h.z * step_sin_};
+            heading_ = {h.x * step_cos_ - p.x * step_sin_, h.y * step_cos_ - p.y * step_sin_,
+                        h.z * step_cos_ - p.z * step_sin_};
+        } else if (leg_ < legs_.size()) {
+            EnterLeg(leg_ + 1, leg_offset_ - legs_[leg_]);
+        }
+    }
+    return written;
+}
+
+} // namespace earth_map
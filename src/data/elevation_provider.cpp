@@ -2,10 +2,13 @@
 // SPDX-License-Identifier: MIT
 
 #include <earth_map/data/elevation_provider.h>
+#include <earth_map/data/elevation_batch.h>
+#include <earth_map/data/region_preload_job.h>
 
 #include <algorithm>
 #include <cmath>
-#include <unordered_set>
+#include <limits>
+#include <mutex>
 
 namespace earth_map {
 
@@ -18,15 +21,58 @@ namespace {
            longitude >= -180.0 && longitude <= 180.0;
 }
 
+/// Points per batch query of an elevation profile
+constexpr size_t kProfileBatchSize = 65536;
+
+/// Region preload of SRTM tiles
+using PreloadJob = RegionPreloadJob<SRTMCoordinates>;
+
 } // anonymous namespace
 
+std::vector<SRTMCoordinates> GetRegionTiles(const GeographicBounds& bounds,
+                                            const Geographic& focus) {
+    if (!bounds.IsValid()) {
+        return {};
+    }
+
+    // Calculate tile range covering bounds, clamped to valid SRTM range
+    const int32_t lat_start = std::clamp(static_cast<int32_t>(std::floor(bounds.min.latitude)), -90, 89);
+    const int32_t lat_end = std::clamp(static_cast<int32_t>(std::floor(bounds.max.latitude)), -90, 89);
+    const int32_t lon_start = std::clamp(static_cast<int32_t>(std::floor(bounds.min.longitude)), -180, 179);
+    const int32_t lon_end = std::clamp(static_cast<int32_t>(std::floor(bounds.max.longitude)), -180, 179);
+
+    // Equirectangular distance from the focus to each tile center
+    constexpr double kDegToRad = 3.14159265358979323846 / 180.0;
+    std::vector<std::pair<double, SRTMCoordinates>> tiles;
+    for (int32_t lat = lat_start; lat <= lat_end; ++lat) {
+        for (int32_t lon = lon_start; lon <= lon_end; ++lon) {
+            const double center_lat = lat + 0.5;
+            const double d_lat = center_lat - focus.latitude;
+            const double d_lon = std::remainder(lon + 0.5 - focus.longitude, 360.0) *
+                                 std::cos(center_lat * kDegToRad);
+            tiles.emplace_back(d_lat * d_lat + d_lon * d_lon, SRTMCoordinates{lat, lon});
+        }
+    }
+    std::stable_sort(tiles.begin(), tiles.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    std::vector<SRTMCoordinates> result;
+    result.reserve(tiles.size());
+    for (const auto& tile : tiles) {
+        result.push_back(tile.second);
+    }
+    return result;
+}
+
 /// Basic elevation provider implementation
 class BasicElevationProvider : public ElevationProvider {
 public:
     BasicElevationProvider(const SRTMLoaderConfig& loader_config,
                            const ElevationCacheConfig& cache_config)
         : loader_(SRTMLoader::Create(loader_config)),
-        cache_(ElevationCache::Create(cache_config)) {
+        cache_(ElevationCache::Create(cache_config)),
+        preferred_resolution_(loader_config.preferred_resolution),
+        preload_window_(2 * std::max<size_t>(1, loader_config.max_concurrent_downloads)) {
         if (!loader_) {
             throw std::runtime_error("Failed to create SRTM loader");
         }
@@ -35,6 +81,17 @@ public:
         }
     }
 
+    ~BasicElevationProvider() override {
+        // Preload callbacks write to cache_, which is destroyed before loader_
+        std::lock_guard<std::mutex> lock(preloads_mutex_);
+        for (const auto& preload : preloads_) {
+            if (const auto job = preload.lock()) {
+                job->Cancel();
+                job->WaitIdle();
+            }
+        }
+    }
+
     ElevationQuery GetElevation(double latitude, double longitude) const override {
         // Lock-free: SRTMLoader and ElevationCache are already thread-safe
         ElevationQuery result;
@@ -87,67 +144,38 @@ public:
 
     std::vector<ElevationQuery> GetElevations(
         const std::vector<Geographic>& points) const override {
-        // Lock-free: delegate to GetElevation which is lock-free
-        std::vector<ElevationQuery> results;
-        results.reserve(points.size());
-
-        // Group points by tile for efficient loading
-        std::unordered_set<SRTMCoordinates> tiles_needed;
-        for (const auto& point : points) {
-            const double lat = NormalizeLatitude(point.latitude);
-            const double lon = NormalizeLongitude(point.longitude);
-
-            if (IsValidCoordinate(lat, lon)) {
-                tiles_needed.insert(GeographicToSRTMTile(lat, lon));
-            }
-        }
-
-        // Preload all needed tiles (cache handles thread-safety)
-        for (const auto& tile_coords : tiles_needed) {
-            LoadTile(tile_coords);
-        }
-
-        // Query each point (now lock-free, can be parallelized in future)
-        for (const auto& point : points) {
-            results.push_back(GetElevation(point.latitude, point.longitude));
-        }
+        // Lock-free: tiles are pinned once per batch and interpolated in parallel
+        return SampleElevationBatch(points, [this](const SRTMCoordinates& coords) {
+            return LoadTile(coords);
+        });
+    }
 
-        return results;
+    std::vector<ElevationQuery> GetElevations(
+        const std::vector<Geographic>& points,
+        double ground_resolution_meters) const override {
+        return SampleElevationBatch(points, [this, ground_resolution_meters](
+                                                const SRTMCoordinates& coords) {
+            return LoadTileLevel(coords, ground_resolution_meters);
+        });
     }
 
     size_t PreloadRegion(const GeographicBounds& bounds) override {
-        // Lock-free: LoadTile is thread-safe
-        if (!bounds.IsValid()) {
-            return 0;
-        }
-
-        // Calculate tile range covering bounds
-        const int32_t min_lat_tile = static_cast<int32_t>(std::floor(bounds.min.latitude));
-        const int32_t max_lat_tile = static_cast<int32_t>(std::floor(bounds.max.latitude));
-        const int32_t min_lon_tile = static_cast<int32_t>(std::floor(bounds.min.longitude));
-        const int32_t max_lon_tile = static_cast<int32_t>(std::floor(bounds.max.longitude));
-
-        // Clamp to valid SRTM range
-        const int32_t lat_start = std::clamp(min_lat_tile, -90, 89);
-        const int32_t lat_end = std::clamp(max_lat_tile, -90, 89);
-        const int32_t lon_start = std::clamp(min_lon_tile, -180, 179);
-        const int32_t lon_end = std::clamp(max_lon_tile, -180, 179);
-
-        size_t loaded_count = 0;
-
-        // Load all tiles in range (can be parallelized in future)
-        for (int32_t lat = lat_start; lat <= lat_end; ++lat) {
-            for (int32_t lon = lon_start; lon <= lon_end; ++lon) {
-                const SRTMCoordinates coords{lat, lon};
-                if (LoadTile(coords)) {
-                    ++loaded_count;
-                }
-            }
-        }
-
-        return loaded_count;
+        return PreloadRegionAsync(bounds, std::nullopt)->Wait();
     }
 
+    std::shared_ptr<ElevationPreload> PreloadRegionAsync(
+        const GeographicBounds& bounds, const std::optional<Geographic>& focus) override {
+        const Geographic center((bounds.min.latitude + bounds.max.latitude) / 2.0,
+                                (bounds.min.longitude + bounds.max.longitude) / 2.0);
+        auto job = std::make_shared<PreloadJob>(GetRegionTiles(bounds, focus.value_or(center)));
+        {
+            std::lock_guard<std::mutex> lock(preloads_mutex_);
+            std::erase_if(preloads_, [](const auto& preload) { return preload.expired(); });
+            preloads_.push_back(job);
+        }
+        IssuePreloads(job, job->TakeNext(preload_window_));
+        return job;
+    }
     bool IsAvailable(double latitude, double longitude) const override {
         // Lock-free: cache Contains() is thread-safe
         // Normalize coordinates
@@ -178,7 +206,40 @@ public:
         cache_->Clear();
     }
 
+    void SetMemoryCacheBudget(size_t bytes) override {
+        ElevationCacheConfig config = cache_->GetConfiguration();
+        config.max_memory_cache_size = bytes;
+        cache_->SetConfiguration(config);
+    }
+
 private:
+    /// Start loads of reserved preload tiles; cached tiles (memory or disk)
+    /// finish right away and hand their slot to the next tile
+    void IssuePreloads(const std::shared_ptr<PreloadJob>& job,
+                       std::vector<SRTMCoordinates> batch) const {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            const SRTMCoordinates coords = batch[i];
+            if (cache_->Get(coords).has_value()) {
+                const auto next = job->FinishAndTakeNext(true, preload_window_);
+                batch.insert(batch.end(), next.begin(), next.end());
+                continue;
+            }
+            // The future is not needed: the callback records the result
+            static_cast<void>(loader_->LoadTileAsync(
+                coords, [this, job](const SRTMLoadResult& result) {
+                    const bool loaded = result.success && result.tile_data;
+                    if (loaded) {
+                        cache_->Put(*result.tile_data);
+                    }
+                    // Once nothing is reserved the provider may be destroyed
+                    auto next = job->FinishAndTakeNext(loaded, preload_window_);
+                    if (!next.empty()) {
+                        IssuePreloads(job, std::move(next));
+                    }
+                }));
+        }
+    }
+
     /// Load SRTM tile (from cache or loader)
     /// @param coords Tile coordinates
     /// @return Shared pointer to tile data, or nullptr on failure
@@ -201,11 +262,96 @@ private:
         return result.tile_data;
     }
 
+    /// Load the pyramid level of an SRTM tile adequate for a ground resolution
+    /// Missing levels are built from the full tile once and cached with it
+    /// @param coords Tile coordinates
+    /// @param ground_resolution_meters Spacing between the query points
+    /// @return Shared pointer to tile data, or nullptr on failure
+    std::shared_ptr<SRTMTileData> LoadTileLevel(const SRTMCoordinates& coords,
+                                                double ground_resolution_meters) const {
+        // Most tiles have the preferred resolution: try its level first
+        const uint32_t expected_level =
+            SelectPyramidLevel(preferred_resolution_, ground_resolution_meters);
+        if (expected_level == 0) {
+            return LoadTile(coords);
+        }
+        auto cached = cache_->Get(coords, expected_level);
+        if (cached.has_value()) {
+            return cached.value();
+        }
+
+        auto source = LoadTile(coords);
+        if (!source) {
+            return nullptr;
+        }
+        const uint32_t level =
+            SelectPyramidLevel(source->GetMetadata().resolution, ground_resolution_meters);
+        if (level == 0) {
+            return source;
+        }
+        if (level != expected_level) {
+            cached = cache_->Get(coords, level);
+            if (cached.has_value()) {
+                return cached.value();
+            }
+        }
+
+        // Build the whole pyramid, each level from the one below it
+        std::shared_ptr<SRTMTileData> result;
+        std::shared_ptr<const SRTMTileData> finer = source;
+        for (uint32_t next = 1; next <= kMaxElevationPyramidLevel; ++next) {
+            std::shared_ptr<SRTMTileData> coarser = finer->Downsample(next);
+            if (!coarser) {
+                break;
+            }
+            cache_->Put(*coarser);
+            if (next == level) {
+                result = coarser;
+            }
+            finer = std::move(coarser);
+        }
+        return result ? result : source;
+    }
+
     std::unique_ptr<SRTMLoader> loader_;   // Thread-safe
     std::unique_ptr<ElevationCache> cache_; // Thread-safe
+    SRTMResolution preferred_resolution_;
+
+    /// Preload loads in flight at once: enough to keep the loader's workers busy
+    size_t preload_window_;
+    std::mutex preloads_mutex_;
+    std::vector<std::weak_ptr<PreloadJob>> preloads_;
     // No mutex needed - all operations delegate to thread-safe components
 };
 
+std::vector<ElevationQuery> ElevationProvider::GetElevations(
+    const std::vector<Geographic>& points, double /*ground_resolution_meters*/) const {
+    return GetElevations(points);
+}
+
+ElevationProfile ElevationProvider::GetElevationProfile(const std::vector<Geographic>& path,
+                                                        double spacing_meters) const {
+    GeodesicPathSampler sampler(path, spacing_meters);
+    ElevationProfile profile;
+    profile.spacing_meters = spacing_meters;
+    profile.length_meters = sampler.GetLength();
+    profile.elevations.reserve(sampler.GetSampleCount());
+
+    std::vector<Geographic> points(std::min(sampler.GetSampleCount(), kProfileBatchSize));
+    while (const size_t count = sampler.Next(points)) {
+        points.resize(count);
+        for (const ElevationQuery& query : GetElevations(points, spacing_meters)) {
+            if (query.valid) {
+                profile.elevations.push_back(query.elevation_meters);
+            } else {
+                profile.elevations.push_back(std::numeric_limits<float>::quiet_NaN());
+                ++profile.missing_samples;
+            }
+        }
+    }
+    return profile;
+}
+
 std::shared_ptr<ElevationProvider> ElevationProvider::Create(
     const SRTMLoaderConfig& loader_config,
     const ElevationCacheConfig& cache_config) {
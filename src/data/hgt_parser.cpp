@@ -6,14 +6,77 @@
 #include <algorithm>
 #include <cctype>
 #include <cstring>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define EARTH_MAP_HGT_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON) && \
+    defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define EARTH_MAP_HGT_NEON 1
+#include <arm_neon.h>
+#endif
 
 namespace earth_map {
 
+namespace {
+
+/// Header of the native-endian cache format; the samples follow it
+struct NativeTileHeader {
+    char magic[8];               ///< kNativeMagic
+    uint16_t byte_order;         ///< kByteOrderMark in the writer's byte order
+    uint16_t flags;              ///< kNativeFlagHadVoids
+    uint32_t samples_per_side;
+    int32_t latitude;
+    int32_t longitude;
+    uint8_t level;               ///< Pyramid level
+    uint8_t reserved[7];
+};
+static_assert(sizeof(NativeTileHeader) == 32, "samples must stay 2-byte aligned");
+
+constexpr char kNativeMagic[8] = {'E', 'M', 'S', 'R', 'T', 'M', 'N', '1'};
+constexpr uint16_t kByteOrderMark = 0xFEFF;
+constexpr uint16_t kNativeFlagHadVoids = 1;
+
+/// Map a whole file read-only; the returned pointer unmaps on release
+std::shared_ptr<const void> MapFile(const std::string& path, int advice, size_t* size) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat file_stat {};
+    if (::fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    const auto length = static_cast<size_t>(file_stat.st_size);
+
+    // The mapping keeps the file referenced after the descriptor is closed
+    void* address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        return nullptr;
+    }
+    ::madvise(address, length, advice);
+
+    *size = length;
+    return std::shared_ptr<const void>(address, [length](const void* ptr) {
+        ::munmap(const_cast<void*>(ptr), length);
+    });
+}
+
+} // anonymous namespace
+
 std::unique_ptr<SRTMTileData> HGTParser::Parse(
-    const std::vector<uint8_t>& data,
+    std::span<const uint8_t> data,
     const SRTMCoordinates& coordinates) {
 
     // Validate coordinates
@@ -36,21 +99,40 @@ std::unique_ptr<SRTMTileData> HGTParser::Parse(
     SRTMMetadata metadata(coordinates, resolution.value());
     auto tile = std::make_unique<SRTMTileData>(metadata);
 
-    // Parse samples
+    // Swap samples into host byte order
     auto& raw_data = tile->GetRawData();
     const size_t num_samples = metadata.samples_per_side * metadata.samples_per_side;
-    bool has_voids = false;
+    const bool has_voids = SwapSamples(data.data(), raw_data.data(), num_samples);
+
+    // Fill voids if present
+    if (has_voids) {
+        FillVoids(*tile);
+        tile->SetHasVoids(true);
+    }
 
-    for (size_t i = 0; i < num_samples; ++i) {
-        const size_t byte_offset = i * 2;
-        const int16_t elevation = ParseSample(&data[byte_offset]);
-        raw_data[i] = elevation;
+    tile->SetValid(true);
+    return tile;
+}
 
-        if (IsVoid(elevation)) {
-            has_voids = true;
-        }
+std::unique_ptr<SRTMTileData> HGTParser::ParseInPlace(
+    std::vector<int16_t> samples,
+    const SRTMCoordinates& coordinates) {
+
+    // Validate coordinates and size
+    if (!coordinates.IsValid()) {
+        return nullptr;
+    }
+    const auto resolution = DetectResolution(samples.size() * sizeof(int16_t));
+    if (!resolution.has_value()) {
+        return nullptr;
     }
 
+    // Swap samples into host byte order (each step loads before it stores)
+    const bool has_voids = SwapSamples(reinterpret_cast<const uint8_t*>(samples.data()),
+                                       samples.data(), samples.size());
+    auto tile = std::make_unique<SRTMTileData>(SRTMMetadata(coordinates, resolution.value()),
+                                               std::move(samples));
+
     // Fill voids if present
     if (has_voids) {
         FillVoids(*tile);
@@ -69,27 +151,100 @@ std::unique_ptr<SRTMTileData> HGTParser::ParseFile(const std::string& file_path)
         return nullptr;
     }
 
-    // Open file in binary mode
-    std::ifstream file(file_path, std::ios::binary | std::ios::ate);
-    if (!file.is_open()) {
+    // Map the file; it is read once, front to back
+    size_t file_size = 0;
+    const auto mapping = MapFile(file_path, MADV_SEQUENTIAL, &file_size);
+    if (!mapping) {
         return nullptr;
     }
 
-    // Get file size
-    const std::streamsize file_size = file.tellg();
-    file.seekg(0, std::ios::beg);
+    // Parse data
+    return Parse({static_cast<const uint8_t*>(mapping.get()), file_size}, coords.value());
+}
+
+bool HGTParser::WriteNativeFile(const SRTMTileData& tile, const std::string& file_path) {
+    const auto& metadata = tile.GetMetadata();
+    const auto samples = tile.GetSamples();
+    if (!tile.IsValid() || samples.size() != metadata.samples_per_side * metadata.samples_per_side) {
+        return false;
+    }
+
+    NativeTileHeader header{};
+    std::memcpy(header.magic, kNativeMagic, sizeof(header.magic));
+    header.byte_order = kByteOrderMark;
+    header.flags = metadata.has_voids ? kNativeFlagHadVoids : 0;
+    header.samples_per_side = static_cast<uint32_t>(metadata.samples_per_side);
+    header.latitude = metadata.coordinates.latitude;
+    header.longitude = metadata.coordinates.longitude;
+    header.level = static_cast<uint8_t>(metadata.level);
 
-    // Read entire file into buffer
-    std::vector<uint8_t> buffer(static_cast<size_t>(file_size));
-    if (!file.read(reinterpret_cast<char*>(buffer.data()), file_size)) {
+    const std::string temp_path = file_path + ".tmp";
+    try {
+        {
+            std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                return false;
+            }
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(samples.data()),
+                       static_cast<std::streamsize>(samples.size_bytes()));
+            if (!file.good()) {
+                file.close();
+                std::filesystem::remove(temp_path);
+                return false;
+            }
+        }
+        std::filesystem::rename(temp_path, file_path);
+        return true;
+    } catch (...) {
+        std::error_code ignored;
+        std::filesystem::remove(temp_path, ignored);
+        return false;
+    }
+}
+
+std::unique_ptr<SRTMTileData> HGTParser::MapNativeFile(const std::string& file_path,
+                                                       const SRTMCoordinates& coordinates,
+                                                       uint32_t level) {
+    size_t file_size = 0;
+    auto mapping = MapFile(file_path, MADV_RANDOM, &file_size);
+    if (!mapping || file_size < sizeof(NativeTileHeader)) {
         return nullptr;
     }
 
-    // Parse data
-    return Parse(buffer, coords.value());
+    const auto* bytes = static_cast<const uint8_t*>(mapping.get());
+    NativeTileHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+
+    const size_t samples = header.samples_per_side;
+    SRTMResolution resolution;
+    if (samples == GetPyramidSamplesPerSide(SRTMResolution::SRTM1, level)) {
+        resolution = SRTMResolution::SRTM1;
+    } else if (samples == GetPyramidSamplesPerSide(SRTMResolution::SRTM3, level)) {
+        resolution = SRTMResolution::SRTM3;
+    } else {
+        return nullptr;
+    }
+
+    if (std::memcmp(header.magic, kNativeMagic, sizeof(header.magic)) != 0 ||
+        header.byte_order != kByteOrderMark ||
+        header.level != level ||
+        header.latitude != coordinates.latitude ||
+        header.longitude != coordinates.longitude ||
+        file_size != sizeof(NativeTileHeader) + samples * samples * sizeof(int16_t)) {
+        return nullptr;
+    }
+
+    // Page-aligned mapping plus a 32-byte header: the samples are aligned
+    const auto* data = reinterpret_cast<const int16_t*>(bytes + sizeof(NativeTileHeader));
+    auto tile = std::make_unique<SRTMTileData>(SRTMMetadata(coordinates, resolution, level),
+                                               std::move(mapping), data);
+    tile->SetHasVoids((header.flags & kNativeFlagHadVoids) != 0);
+    tile->SetValid(true);
+    return tile;
 }
 
-bool HGTParser::Validate(const std::vector<uint8_t>& data) noexcept {
+bool HGTParser::Validate(std::span<const uint8_t> data) noexcept {
     // Check if size matches known SRTM formats
     const size_t size = data.size();
     return (size == SRTM1_FILE_SIZE || size == SRTM3_FILE_SIZE);
@@ -196,6 +351,38 @@ int16_t HGTParser::ParseSample(const uint8_t* bytes) noexcept {
     return value;
 }
 
+bool HGTParser::SwapSamples(const uint8_t* bytes, int16_t* samples, size_t count) noexcept {
+    // 8 samples per step, then the remainder one at a time
+    size_t i = 0;
+    bool has_voids = false;
+#if defined(EARTH_MAP_HGT_SSE2)
+    const __m128i void_value = _mm_set1_epi16(VOID_VALUE);
+    __m128i voids = _mm_setzero_si128();
+    for (; i + 8 <= count; i += 8) {
+        const __m128i big_endian = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i * 2));
+        const __m128i swapped = _mm_or_si128(_mm_slli_epi16(big_endian, 8),
+                                             _mm_srli_epi16(big_endian, 8));
+        voids = _mm_or_si128(voids, _mm_cmpeq_epi16(swapped, void_value));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(samples + i), swapped);
+    }
+    has_voids = _mm_movemask_epi8(voids) != 0;
+#elif defined(EARTH_MAP_HGT_NEON)
+    const int16x8_t void_value = vdupq_n_s16(VOID_VALUE);
+    uint16x8_t voids = vdupq_n_u16(0);
+    for (; i + 8 <= count; i += 8) {
+        const int16x8_t swapped = vreinterpretq_s16_u8(vrev16q_u8(vld1q_u8(bytes + i * 2)));
+        voids = vorrq_u16(voids, vceqq_s16(swapped, void_value));
+        vst1q_s16(samples + i, swapped);
+    }
+    has_voids = vmaxvq_u16(voids) != 0;
+#endif
+    for (; i < count; ++i) {
+        samples[i] = ParseSample(bytes + i * 2);
+        has_voids = has_voids || IsVoid(samples[i]);
+    }
+    return has_voids;
+}
+
 void HGTParser::FillVoids(SRTMTileData& tile) {
     auto& data = tile.GetRawData();
     const size_t size = tile.GetMetadata().samples_per_side;
@@ -227,7 +414,7 @@ void HGTParser::FillVoids(SRTMTileData& tile) {
 }
 
 int16_t HGTParser::InterpolateVoid(const SRTMTileData& tile, size_t x, size_t y) noexcept {
-    const auto& data = tile.GetRawData();
+    const auto data = tile.GetSamples();
     const size_t size = tile.GetMetadata().samples_per_side;
 
     // Collect valid neighbors
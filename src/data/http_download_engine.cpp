@@ -0,0 +1,736 @@
+/**
+ * @file http_download_engine.cpp
+ * @brief curl_multi event-loop implementation of the HTTP download engine
+ */
+
+#include <earth_map/data/http_download_engine.h>
+#include <earth_map/data/request_scheduler.h>
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <curl/curl.h>
+#include <spdlog/spdlog.h>
+
+namespace earth_map {
+
+namespace {
+
+/// Upper bound on a single curl_multi_poll wait; keeps the loop responsive
+constexpr int kMaxPollTimeoutMs = 100;
+
+/// Maximum number of HTTP redirects followed per transfer
+constexpr long kMaxRedirects = 5;
+
+/// Lowest and highest HTTP status codes treated as success
+constexpr long kHttpSuccessMin = 200;
+constexpr long kHttpSuccessMax = 299;
+
+/// Status returned for a conditional request whose validators still match
+constexpr long kHttpNotModified = 304;
+
+/// Statuses asking the client to slow down (honouring Retry-After)
+constexpr long kHttpTooManyRequests = 429;
+constexpr long kHttpServiceUnavailable = 503;
+
+/**
+ * @brief libcurl write callback appending to a byte vector
+ */
+std::size_t WriteCallback(void* contents, std::size_t size, std::size_t nmemb, void* userp) {
+    const std::size_t total_size = size * nmemb;
+    auto* buffer = static_cast<std::vector<std::uint8_t>*>(userp);
+    buffer->insert(buffer->end(), static_cast<std::uint8_t*>(contents),
+                   static_cast<std::uint8_t*>(contents) + total_size);
+    return total_size;
+}
+
+/**
+ * @brief Caching headers of the response currently being received
+ */
+struct ResponseHeaders {
+    std::string etag;
+    std::string last_modified;
+    std::optional<std::chrono::seconds> max_age;   ///< Cache-Control
+    bool no_store = false;                          ///< Cache-Control: no-store
+    std::optional<std::chrono::seconds> expires;   ///< Expires, relative to now
+    std::optional<std::chrono::seconds> retry_after;
+};
+
+bool HeaderNameEquals(std::string_view name, std::string_view expected) {
+    return name.size() == expected.size() &&
+           std::equal(name.begin(), name.end(), expected.begin(), [](char a, char b) {
+               return std::tolower(static_cast<unsigned char>(a)) == b;
+           });
+}
+
+std::string_view TrimHeaderValue(std::string_view value) {
+    while (!value.empty() && std::isspace(static_cast<unsigned char>(value.front()))) {
+        value.remove_prefix(1);
+    }
+    while (!value.empty() && std::isspace(static_cast<unsigned char>(value.back()))) {
+        value.remove_suffix(1);
+    }
+    return value;
+}
+
+/**
+ * @brief Extract the freshness lifetime from a Cache-Control value
+ */
+std::optional<std::chrono::seconds> ParseCacheControl(std::string_view value) {
+    std::string lower(value);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    // no-cache allows storing but requires revalidation before every reuse
+    if (lower.find("no-cache") != std::string::npos ||
+        lower.find("no-store") != std::string::npos) {
+        return std::chrono::seconds(0);
+    }
+    const std::size_t pos = lower.find("max-age=");
+    if (pos == std::string::npos) {
+        return std::nullopt;
+    }
+    try {
+        return std::chrono::seconds(std::stoll(lower.substr(pos + 8)));
+    } catch (const std::exception&) {
+        return std::nullopt;
+    }
+}
+
+/**
+ * @brief Check whether a Cache-Control value forbids storing the response
+ */
+bool ForbidsStoring(std::string_view value) {
+    std::string lower(value);
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) {
+        return static_cast<char>(std::tolower(c));
+    });
+    return lower.find("no-store") != std::string::npos;
+}
+
+/**
+ * @brief Parse a Retry-After value (delay in seconds or an HTTP date)
+ */
+std::optional<std::chrono::seconds> ParseRetryAfter(std::string_view value) {
+    if (value.empty()) {
+        return std::nullopt;
+    }
+    if (std::all_of(value.begin(), value.end(),
+                    [](unsigned char c) { return std::isdigit(c) != 0; })) {
+        try {
+            return std::chrono::seconds(std::stoll(std::string(value)));
+        } catch (const std::exception&) {
+            return std::nullopt;
+        }
+    }
+    const std::string date(value);
+    const std::time_t at = curl_getdate(date.c_str(), nullptr);
+    if (at < 0) {
+        return std::nullopt;
+    }
+    const std::time_t now = std::time(nullptr);
+    return std::chrono::seconds(at > now ? at - now : 0);
+}
+
+RequestSchedulerConfig ToSchedulerConfig(const TileLoaderConfig& config) {
+    RequestSchedulerConfig scheduler;
+    scheduler.max_requests_per_host = config.max_requests_per_host;
+    scheduler.requests_per_second = config.host_requests_per_second;
+    scheduler.burst = config.host_request_burst;
+    return scheduler;
+}
+
+/**
+ * @brief libcurl header callback collecting caching headers
+ *
+ * Called once per header line; a status line starts a new response (after a
+ * redirect), so anything collected so far is discarded.
+ */
+std::size_t HeaderCallback(char* buffer, std::size_t size, std::size_t nitems, void* userp) {
+    const std::size_t total_size = size * nitems;
+    auto* headers = static_cast<ResponseHeaders*>(userp);
+    const std::string_view line(buffer, total_size);
+
+    if (line.starts_with("HTTP/")) {
+        *headers = ResponseHeaders{};
+        return total_size;
+    }
+    const std::size_t colon = line.find(':');
+    if (colon == std::string_view::npos) {
+        return total_size;
+    }
+    const std::string_view name = TrimHeaderValue(line.substr(0, colon));
+    const std::string_view value = TrimHeaderValue(line.substr(colon + 1));
+
+    if (HeaderNameEquals(name, "etag")) {
+        headers->etag = value;
+    } else if (HeaderNameEquals(name, "last-modified")) {
+        headers->last_modified = value;
+    } else if (HeaderNameEquals(name, "cache-control")) {
+        if (auto max_age = ParseCacheControl(value)) {
+            headers->max_age = max_age;
+        }
+        headers->no_store = headers->no_store || ForbidsStoring(value);
+    } else if (HeaderNameEquals(name, "expires")) {
+        // Invalid dates (e.g. "0") mean "already expired"
+        const std::string date(value);
+        const std::time_t expires = curl_getdate(date.c_str(), nullptr);
+        const std::time_t now = std::time(nullptr);
+        headers->expires = std::chrono::seconds(expires > now ? expires - now : 0);
+    } else if (HeaderNameEquals(name, "retry-after")) {
+        headers->retry_after = ParseRetryAfter(value);
+    }
+    return total_size;
+}
+
+std::uint64_t ElapsedMs(std::chrono::steady_clock::time_point start) {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+} // namespace
+
+/**
+ * @brief Download engine driving all transfers from one curl_multi handle
+ *
+ * The multi handle, its easy handles and the connection cache are owned by
+ * the event-loop thread. Other threads only touch the request queues under
+ * state_mutex_ and wake the loop with curl_multi_wakeup().
+ */
+class CurlMultiDownloadEngine : public HttpDownloadEngine {
+public:
+    explicit CurlMultiDownloadEngine(const TileLoaderConfig& config);
+    ~CurlMultiDownloadEngine() override;
+
+    CurlMultiDownloadEngine(const CurlMultiDownloadEngine&) = delete;
+    CurlMultiDownloadEngine& operator=(const CurlMultiDownloadEngine&) = delete;
+    CurlMultiDownloadEngine(CurlMultiDownloadEngine&&) = delete;
+    CurlMultiDownloadEngine& operator=(CurlMultiDownloadEngine&&) = delete;
+
+    HttpRequestId Submit(HttpRequest request) override;
+    bool Cancel(HttpRequestId id) override;
+    void CancelAll() override;
+    void SetConfiguration(const TileLoaderConfig& config) override;
+    std::size_t GetActiveCount() const override;
+    std::size_t GetQueuedCount() const override;
+
+private:
+    /// Request waiting for a free transfer slot
+    struct PendingRequest {
+        HttpRequestId id = 0;
+        HttpRequest request;
+    };
+
+    /// Running transfer (owned by the event-loop thread)
+    struct Transfer {
+        HttpRequestId id = 0;
+        std::string host;
+        HttpRequest request;
+        CURL* easy = nullptr;
+        curl_slist* header_list = nullptr;
+        std::vector<std::uint8_t> body;
+        ResponseHeaders headers;
+        std::chrono::steady_clock::time_point start_time;
+        char error_buffer[CURL_ERROR_SIZE] = {};
+    };
+
+    void Run();
+    void ApplyMultiOptions(const TileLoaderConfig& config);
+    void ProcessCancellations();
+    void StartDueTransfers(const TileLoaderConfig& config);
+    bool StartTransfer(RequestScheduler::Entry&& entry, const TileLoaderConfig& config);
+    void CompleteFinishedTransfers();
+    void FinishTransfer(CURL* easy, HttpResponse&& response);
+    void ShutdownTransfers();
+    int ComputePollTimeoutMs();
+
+    CURLM* multi_ = nullptr;
+    std::thread loop_thread_;
+    std::atomic<bool> stop_{false};
+
+    // Shared state, protected by state_mutex_
+    mutable std::mutex state_mutex_;
+    TileLoaderConfig config_;
+    bool config_dirty_ = true;
+    HttpRequestId next_id_ = 1;
+    RequestScheduler scheduler_;  ///< Requests ready to start
+    std::multimap<std::chrono::steady_clock::time_point, PendingRequest> delayed_;
+    std::unordered_set<HttpRequestId> active_ids_;
+    std::vector<HttpRequestId> cancel_requests_;
+    bool cancel_all_ = false;
+
+    // Event-loop state (loop thread only)
+    TileLoaderConfig loop_config_;
+    std::unordered_map<CURL*, std::unique_ptr<Transfer>> transfers_;
+};
+
+std::unique_ptr<HttpDownloadEngine> CreateHttpDownloadEngine(const TileLoaderConfig& config) {
+    return std::make_unique<CurlMultiDownloadEngine>(config);
+}
+
+CurlMultiDownloadEngine::CurlMultiDownloadEngine(const TileLoaderConfig& config)
+    : config_(config), scheduler_(ToSchedulerConfig(config)) {
+    multi_ = curl_multi_init();
+    if (!multi_) {
+        throw std::runtime_error("Failed to initialize curl multi handle");
+    }
+
+    loop_thread_ = std::thread([this] { Run(); });
+}
+
+CurlMultiDownloadEngine::~CurlMultiDownloadEngine() {
+    stop_.store(true);
+    curl_multi_wakeup(multi_);
+
+    if (loop_thread_.joinable()) {
+        loop_thread_.join();
+    }
+
+    curl_multi_cleanup(multi_);
+}
+
+HttpRequestId CurlMultiDownloadEngine::Submit(HttpRequest request) {
+    HttpRequestId id = 0;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        id = next_id_++;
+
+        const auto not_before = request.not_before;
+        PendingRequest pending{id, std::move(request)};
+        if (not_before > std::chrono::steady_clock::now()) {
+            delayed_.emplace(not_before, std::move(pending));
+        } else {
+            scheduler_.Push(id, std::move(pending.request));
+        }
+    }
+
+    curl_multi_wakeup(multi_);
+    return id;
+}
+
+bool CurlMultiDownloadEngine::Cancel(HttpRequestId id) {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+
+        if (scheduler_.Remove(id)) {
+            return true;
+        }
+
+        auto delayed_it = std::find_if(delayed_.begin(), delayed_.end(),
+            [id](const auto& entry) { return entry.second.id == id; });
+        if (delayed_it != delayed_.end()) {
+            delayed_.erase(delayed_it);
+            return true;
+        }
+
+        if (active_ids_.find(id) == active_ids_.end()) {
+            return false;
+        }
+
+        // Running transfers can only be removed by the loop thread
+        cancel_requests_.push_back(id);
+    }
+
+    curl_multi_wakeup(multi_);
+    return true;
+}
+
+void CurlMultiDownloadEngine::CancelAll() {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        scheduler_.Clear();
+        delayed_.clear();
+        cancel_all_ = true;
+    }
+
+    curl_multi_wakeup(multi_);
+}
+
+void CurlMultiDownloadEngine::SetConfiguration(const TileLoaderConfig& config) {
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        config_ = config;
+        config_dirty_ = true;
+        scheduler_.SetConfig(ToSchedulerConfig(config));
+    }
+
+    curl_multi_wakeup(multi_);
+}
+
+std::size_t CurlMultiDownloadEngine::GetActiveCount() const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return active_ids_.size();
+}
+
+std::size_t CurlMultiDownloadEngine::GetQueuedCount() const {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    return scheduler_.GetQueuedCount() + delayed_.size();
+}
+
+void CurlMultiDownloadEngine::Run() {
+    while (!stop_.load()) {
+        bool config_dirty = false;
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            if (config_dirty_) {
+                loop_config_ = config_;
+                config_dirty_ = false;
+                config_dirty = true;
+            }
+        }
+
+        if (config_dirty) {
+            ApplyMultiOptions(loop_config_);
+        }
+
+        ProcessCancellations();
+        StartDueTransfers(loop_config_);
+
+        int running_handles = 0;
+        const CURLMcode perform_result = curl_multi_perform(multi_, &running_handles);
+        if (perform_result != CURLM_OK) {
+            spdlog::error("curl_multi_perform failed: {}", curl_multi_strerror(perform_result));
+        }
+
+        CompleteFinishedTransfers();
+
+        const CURLMcode poll_result =
+            curl_multi_poll(multi_, nullptr, 0, ComputePollTimeoutMs(), nullptr);
+        if (poll_result != CURLM_OK) {
+            spdlog::error("curl_multi_poll failed: {}", curl_multi_strerror(poll_result));
+        }
+    }
+
+    ShutdownTransfers();
+}
+
+void CurlMultiDownloadEngine::ApplyMultiOptions(const TileLoaderConfig& config) {
+    curl_multi_setopt(multi_, CURLMOPT_PIPELINING,
+                      config.enable_http2 ? CURLPIPE_MULTIPLEX : CURLPIPE_NOTHING);
+    curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS,
+                      static_cast<long>(config.max_connections_per_host));
+    curl_multi_setopt(multi_, CURLMOPT_MAX_TOTAL_CONNECTIONS,
+                      static_cast<long>(config.max_total_connections));
+    curl_multi_setopt(multi_, CURLMOPT_MAXCONNECTS,
+                      static_cast<long>(config.connection_cache_size));
+#if LIBCURL_VERSION_NUM >= 0x074300
+    curl_multi_setopt(multi_, CURLMOPT_MAX_CONCURRENT_STREAMS,
+                      static_cast<long>(config.max_streams_per_connection));
+#endif
+}
+
+void CurlMultiDownloadEngine::ProcessCancellations() {
+    std::vector<HttpRequestId> cancel_ids;
+    bool cancel_all = false;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        cancel_ids.swap(cancel_requests_);
+        cancel_all = cancel_all_;
+        cancel_all_ = false;
+    }
+
+    if (cancel_ids.empty() && !cancel_all) {
+        return;
+    }
+
+    const std::unordered_set<HttpRequestId> cancel_set(cancel_ids.begin(), cancel_ids.end());
+    for (auto it = transfers_.begin(); it != transfers_.end();) {
+        Transfer& transfer = *it->second;
+        if (!cancel_all && cancel_set.find(transfer.id) == cancel_set.end()) {
+            ++it;
+            continue;
+        }
+
+        curl_multi_remove_handle(multi_, transfer.easy);
+        curl_easy_cleanup(transfer.easy);
+        curl_slist_free_all(transfer.header_list);
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            active_ids_.erase(transfer.id);
+            scheduler_.Release(transfer.host);
+        }
+        it = transfers_.erase(it);
+    }
+}
+
+void CurlMultiDownloadEngine::StartDueTransfers(const TileLoaderConfig& config) {
+    const auto now = std::chrono::steady_clock::now();
+    const std::size_t max_in_flight = std::max<std::size_t>(config.max_concurrent_downloads, 1);
+
+    while (transfers_.size() < max_in_flight) {
+        std::optional<RequestScheduler::Entry> entry;
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+
+            // Promote delayed requests whose start time has passed
+            while (!delayed_.empty() && delayed_.begin()->first <= now) {
+                PendingRequest& pending = delayed_.begin()->second;
+                scheduler_.Push(pending.id, std::move(pending.request));
+                delayed_.erase(delayed_.begin());
+            }
+
+            // Fair pick among flows, skipping hosts at their limits
+            entry = scheduler_.PopNext(now);
+            if (!entry) {
+                return;
+            }
+            active_ids_.insert(entry->id);
+        }
+
+        StartTransfer(std::move(*entry), config);
+    }
+}
+
+bool CurlMultiDownloadEngine::StartTransfer(RequestScheduler::Entry&& entry,
+                                            const TileLoaderConfig& config) {
+    auto transfer = std::make_unique<Transfer>();
+    transfer->id = entry.id;
+    transfer->host = std::move(entry.host);
+    transfer->request = std::move(entry.request);
+    transfer->start_time = std::chrono::steady_clock::now();
+
+    CURL* easy = curl_easy_init();
+    if (!easy) {
+        spdlog::error("Failed to initialize curl handle for {}", transfer->request.url);
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            active_ids_.erase(transfer->id);
+            scheduler_.Release(transfer->host);
+        }
+        HttpResponse response;
+        response.error_message = "Failed to initialize curl handle";
+        if (transfer->request.on_complete) {
+            transfer->request.on_complete(std::move(response));
+        }
+        return false;
+    }
+    transfer->easy = easy;
+
+    curl_easy_setopt(easy, CURLOPT_URL, transfer->request.url.c_str());
+    curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, WriteCallback);
+    curl_easy_setopt(easy, CURLOPT_WRITEDATA, &transfer->body);
+    curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION, HeaderCallback);
+    curl_easy_setopt(easy, CURLOPT_HEADERDATA, &transfer->headers);
+    curl_easy_setopt(easy, CURLOPT_ERRORBUFFER, transfer->error_buffer);
+    curl_easy_setopt(easy, CURLOPT_PRIVATE, transfer.get());
+    curl_easy_setopt(easy, CURLOPT_USERAGENT, config.user_agent.c_str());
+    curl_easy_setopt(easy, CURLOPT_FOLLOWLOCATION, config.follow_redirects ? 1L : 0L);
+    curl_easy_setopt(easy, CURLOPT_MAXREDIRS, kMaxRedirects);
+    curl_easy_setopt(easy, CURLOPT_CONNECTTIMEOUT, static_cast<long>(config.timeout));
+    curl_easy_setopt(easy, CURLOPT_TIMEOUT, static_cast<long>(config.timeout));
+    curl_easy_setopt(easy, CURLOPT_SSL_VERIFYPEER, config.verify_ssl ? 1L : 0L);
+    curl_easy_setopt(easy, CURLOPT_SSL_VERIFYHOST, config.verify_ssl ? 2L : 0L);
+    curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+
+    if (config.enable_compression) {
+        curl_easy_setopt(easy, CURLOPT_ACCEPT_ENCODING, "");  // All supported encodings
+    }
+
+    if (config.enable_http2) {
+        // Negotiate h2 via ALPN and wait for an existing connection to
+        // multiplex on instead of opening a new socket per transfer
+        curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+    } else {
+        curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_1);
+    }
+
+    if (!config.ca_cert_path.empty()) {
+        curl_easy_setopt(easy, CURLOPT_CAINFO, config.ca_cert_path.c_str());
+    }
+
+    if (!config.proxy_url.empty()) {
+        curl_easy_setopt(easy, CURLOPT_PROXY, config.proxy_url.c_str());
+
+        if (!config.proxy_username.empty()) {
+            curl_easy_setopt(easy, CURLOPT_PROXYUSERNAME, config.proxy_username.c_str());
+            curl_easy_setopt(easy, CURLOPT_PROXYPASSWORD, config.proxy_password.c_str());
+        }
+    }
+
+    for (const auto& [name, value] : transfer->request.headers) {
+        const std::string header_str = name + ": " + value;
+        transfer->header_list = curl_slist_append(transfer->header_list, header_str.c_str());
+    }
+    if (transfer->header_list) {
+        curl_easy_setopt(easy, CURLOPT_HTTPHEADER, transfer->header_list);
+    }
+
+    const CURLMcode add_result = curl_multi_add_handle(multi_, easy);
+    if (add_result != CURLM_OK) {
+        spdlog::error("curl_multi_add_handle failed: {}", curl_multi_strerror(add_result));
+        curl_slist_free_all(transfer->header_list);
+        curl_easy_cleanup(easy);
+        {
+            std::lock_guard<std::mutex> lock(state_mutex_);
+            active_ids_.erase(transfer->id);
+            scheduler_.Release(transfer->host);
+        }
+        HttpResponse response;
+        response.error_message = curl_multi_strerror(add_result);
+        if (transfer->request.on_complete) {
+            transfer->request.on_complete(std::move(response));
+        }
+        return false;
+    }
+
+    transfers_.emplace(easy, std::move(transfer));
+    return true;
+}
+
+void CurlMultiDownloadEngine::CompleteFinishedTransfers() {
+    int messages_left = 0;
+    while (CURLMsg* message = curl_multi_info_read(multi_, &messages_left)) {
+        if (message->msg != CURLMSG_DONE) {
+            continue;
+        }
+
+        CURL* easy = message->easy_handle;
+        const CURLcode result = message->data.result;
+
+        auto it = transfers_.find(easy);
+        if (it == transfers_.end()) {
+            continue;
+        }
+        Transfer& transfer = *it->second;
+
+        HttpResponse response;
+        response.elapsed_ms = ElapsedMs(transfer.start_time);
+
+        if (result == CURLE_OK) {
+            long response_code = 0;
+            curl_easy_getinfo(easy, CURLINFO_RESPONSE_CODE, &response_code);
+            response.status_code = static_cast<std::uint32_t>(response_code);
+
+            // Non-HTTP schemes (file://) report no status code
+            if (response_code == 0 ||
+                (response_code >= kHttpSuccessMin && response_code <= kHttpSuccessMax)) {
+                response.success = true;
+            } else if (response_code == kHttpNotModified) {
+                response.not_modified = true;
+            } else {
+                response.error_message = "HTTP error " + std::to_string(response_code);
+                spdlog::warn("HTTP error {} for URL: {}", response_code, transfer.request.url);
+            }
+        } else {
+            response.error_message = transfer.error_buffer[0] != '\0'
+                ? std::string(transfer.error_buffer)
+                : std::string(curl_easy_strerror(result));
+            spdlog::warn("Curl error: {} for URL: {}", response.error_message, transfer.request.url);
+        }
+
+        FinishTransfer(easy, std::move(response));
+    }
+}
+
+void CurlMultiDownloadEngine::FinishTransfer(CURL* easy, HttpResponse&& response) {
+    auto it = transfers_.find(easy);
+    if (it == transfers_.end()) {
+        return;
+    }
+
+    std::unique_ptr<Transfer> transfer = std::move(it->second);
+    transfers_.erase(it);
+
+    curl_multi_remove_handle(multi_, easy);
+    curl_easy_cleanup(easy);
+    curl_slist_free_all(transfer->header_list);
+    transfer->header_list = nullptr;
+
+    response.retry_after = transfer->headers.retry_after;
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        active_ids_.erase(transfer->id);
+        scheduler_.Release(transfer->host);
+
+        // The host asked us to slow down: hold back its queued requests
+        if (response.status_code == kHttpTooManyRequests ||
+            response.status_code == kHttpServiceUnavailable) {
+            const auto delay = response.retry_after
+                ? std::chrono::duration_cast<std::chrono::milliseconds>(*response.retry_after)
+                : scheduler_.GetConfig().throttle_delay;
+            scheduler_.ThrottleHost(transfer->host, std::chrono::steady_clock::now() + delay);
+        }
+    }
+
+    if (response.success) {
+        response.body = std::move(transfer->body);
+    }
+    if (response.success || response.not_modified) {
+        // Cache-Control takes precedence over Expires
+        response.etag = std::move(transfer->headers.etag);
+        response.last_modified = std::move(transfer->headers.last_modified);
+        response.no_store = transfer->headers.no_store;
+        response.max_age = transfer->headers.max_age ? transfer->headers.max_age
+                                                     : transfer->headers.expires;
+    }
+
+    if (transfer->request.on_complete) {
+        transfer->request.on_complete(std::move(response));
+    }
+}
+
+void CurlMultiDownloadEngine::ShutdownTransfers() {
+    std::vector<HttpCompletionCallback> callbacks;
+
+    for (auto& [easy, transfer] : transfers_) {
+        curl_multi_remove_handle(multi_, easy);
+        curl_easy_cleanup(easy);
+        curl_slist_free_all(transfer->header_list);
+        callbacks.push_back(std::move(transfer->request.on_complete));
+    }
+    transfers_.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(state_mutex_);
+        for (auto& request : scheduler_.Clear()) {
+            callbacks.push_back(std::move(request.on_complete));
+        }
+        for (auto& [time, pending] : delayed_) {
+            callbacks.push_back(std::move(pending.request.on_complete));
+        }
+        delayed_.clear();
+        active_ids_.clear();
+    }
+
+    for (auto& callback : callbacks) {
+        if (callback) {
+            HttpResponse response;
+            response.cancelled = true;
+            response.error_message = "Download engine shut down";
+            callback(std::move(response));
+        }
+    }
+}
+
+int CurlMultiDownloadEngine::ComputePollTimeoutMs() {
+    std::lock_guard<std::mutex> lock(state_mutex_);
+    const auto now = std::chrono::steady_clock::now();
+
+    // Wake for the next delayed start or the next host leaving its limits;
+    // hosts at their concurrency cap wake the loop when a transfer finishes
+    std::optional<std::chrono::steady_clock::time_point> next;
+    if (transfers_.size() < std::max<std::size_t>(loop_config_.max_concurrent_downloads, 1)) {
+        next = scheduler_.GetNextEligibleTime(now);
+    }
+    if (!delayed_.empty() && (!next || delayed_.begin()->first < *next)) {
+        next = delayed_.begin()->first;
+    }
+    if (!next) {
+        return kMaxPollTimeoutMs;
+    }
+
+    const auto until_next = std::chrono::duration_cast<std::chrono::milliseconds>(
+        *next - now).count();
+    return static_cast<int>(std::clamp<long long>(until_next, 0, kMaxPollTimeoutMs));
+}
+
+} // namespace earth_map
@@ -0,0 +1,253 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#include <earth_map/data/kml_loader.h>
+
+#include <spdlog/spdlog.h>
+#include <zip.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <utility>
+
+namespace earth_map {
+
+namespace {
+
+constexpr char kZipLocalHeaderMagic[4] = {'P', 'K', 0x03, 0x04};
+
+struct ZipArchiveCloser {
+    void operator()(zip_t* archive) const noexcept { zip_discard(archive); }
+};
+
+struct ZipFileCloser {
+    void operator()(zip_file_t* file) const noexcept { zip_fclose(file); }
+};
+
+bool EndsWithKml(const char* name) {
+    const size_t length = std::strlen(name);
+    if (length < 4) {
+        return false;
+    }
+    std::string extension(name + length - 4);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension == ".kml";
+}
+
+/// Stream the KML entry of a KMZ archive
+bool ReadKmzDocument(const std::string& path, size_t chunk_bytes,
+                     const std::function<bool(std::span<const char>)>& on_chunk,
+                     std::string& error, size_t* total_bytes) {
+    int error_code = 0;
+    std::unique_ptr<zip_t, ZipArchiveCloser> archive(
+        zip_open(path.c_str(), ZIP_RDONLY, &error_code));
+    if (!archive) {
+        zip_error_t zip_error;
+        zip_error_init_with_code(&zip_error, error_code);
+        error = "Cannot open KMZ archive: " + std::string(zip_error_strerror(&zip_error));
+        zip_error_fini(&zip_error);
+        return false;
+    }
+
+    // doc.kml by convention; otherwise the first KML entry
+    zip_int64_t index = zip_name_locate(archive.get(), "doc.kml", ZIP_FL_NOCASE | ZIP_FL_NODIR);
+    if (index < 0) {
+        const zip_int64_t entries = zip_get_num_entries(archive.get(), 0);
+        for (zip_int64_t i = 0; i < entries; ++i) {
+            const char* name = zip_get_name(archive.get(), static_cast<zip_uint64_t>(i), 0);
+            if (name != nullptr && EndsWithKml(name)) {
+                index = i;
+                break;
+            }
+        }
+    }
+    if (index < 0) {
+        error = "KMZ archive has no KML document";
+        return false;
+    }
+
+    const auto entry = static_cast<zip_uint64_t>(index);
+    zip_stat_t stat;
+    zip_stat_init(&stat);
+    if (total_bytes != nullptr && zip_stat_index(archive.get(), entry, 0, &stat) == 0 &&
+        (stat.valid & ZIP_STAT_SIZE) != 0) {
+        *total_bytes = static_cast<size_t>(stat.size);
+    }
+
+    std::unique_ptr<zip_file_t, ZipFileCloser> file(zip_fopen_index(archive.get(), entry, 0));
+    if (!file) {
+        error = "Cannot open KMZ entry: " + std::string(zip_strerror(archive.get()));
+        return false;
+    }
+
+    std::vector<char> buffer(chunk_bytes);
+    while (true) {
+        const zip_int64_t read = zip_fread(file.get(), buffer.data(), buffer.size());
+        if (read < 0) {
+            error = "Cannot read KMZ entry: " + std::string(zip_file_strerror(file.get()));
+            return false;
+        }
+        if (read == 0) {
+            return true;
+        }
+        if (!on_chunk(std::span<const char>(buffer.data(), static_cast<size_t>(read)))) {
+            return true;
+        }
+    }
+}
+
+} // anonymous namespace
+
+bool ReadKmlDocument(const std::string& path, size_t chunk_bytes,
+                     const std::function<bool(std::span<const char>)>& on_chunk,
+                     std::string& error, size_t* total_bytes) {
+    chunk_bytes = std::max<size_t>(chunk_bytes, 1);
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        error = "Cannot open file: " + path;
+        return false;
+    }
+    const auto file_size = static_cast<size_t>(file.tellg());
+    file.seekg(0);
+
+    char magic[sizeof(kZipLocalHeaderMagic)] = {};
+    file.read(magic, sizeof(magic));
+    if (file.gcount() == sizeof(magic) &&
+        std::memcmp(magic, kZipLocalHeaderMagic, sizeof(magic)) == 0) {
+        file.close();
+        return ReadKmzDocument(path, chunk_bytes, on_chunk, error, total_bytes);
+    }
+
+    if (total_bytes != nullptr) {
+        *total_bytes = file_size;
+    }
+    file.clear();
+    file.seekg(0);
+    std::vector<char> buffer(chunk_bytes);
+    while (file) {
+        file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+        const auto read = static_cast<size_t>(file.gcount());
+        if (read == 0) {
+            break;
+        }
+        if (!on_chunk(std::span<const char>(buffer.data(), read))) {
+            return true;
+        }
+    }
+    if (file.bad()) {
+        error = "Cannot read file: " + path;
+        return false;
+    }
+    return true;
+}
+
+KmlLoadJob::KmlLoadJob(std::string path, KmlLoadOptions options)
+    : path_(std::move(path)), options_(options) {
+    thread_ = std::thread(&KmlLoadJob::Run, this);
+}
+
+KmlLoadJob::~KmlLoadJob() {
+    Cancel();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+bool KmlLoadJob::TakeBatch(std::vector<KmlPlacemark>& batch) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.empty()) {
+        return false;
+    }
+    batch = std::move(queue_.front());
+    queue_.pop_front();
+    space_.notify_one();
+    return true;
+}
+
+bool KmlLoadJob::IsDone() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return finished_ && queue_.empty();
+}
+
+void KmlLoadJob::Cancel() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cancelled_ = true;
+    space_.notify_all();
+}
+
+std::string KmlLoadJob::GetError() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return error_;
+}
+
+bool KmlLoadJob::Push(std::vector<KmlPlacemark>& batch) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    space_.wait(lock, [this] {
+        return cancelled_ || queue_.size() < std::max<size_t>(options_.max_queued_batches, 1);
+    });
+    if (cancelled_) {
+        return false;
+    }
+    queue_.push_back(std::move(batch));
+    batch = {};
+    batch.reserve(options_.batch_size);
+    return true;
+}
+
+void KmlLoadJob::Run() {
+    const size_t batch_size = std::max<size_t>(options_.batch_size, 1);
+    std::vector<KmlPlacemark> batch;
+    batch.reserve(batch_size);
+    bool running = true;
+    auto last_flush = std::chrono::steady_clock::now();
+
+    KmlStreamParser parser([&](KmlPlacemark&& placemark) {
+        batch.push_back(std::move(placemark));
+        ++placemark_count_;
+        if (running && batch.size() >= batch_size) {
+            running = Push(batch);
+            last_flush = std::chrono::steady_clock::now();
+        }
+    });
+
+    std::string error;
+    size_t total_bytes = 0;
+    const bool read = ReadKmlDocument(
+        path_, options_.chunk_bytes,
+        [&](std::span<const char> chunk) {
+            if (!parser.Write(chunk)) {
+                error = parser.GetError();
+                return false;
+            }
+            bytes_read_ += chunk.size();
+            total_bytes_ = total_bytes;
+            if (running && !batch.empty() &&
+                std::chrono::steady_clock::now() - last_flush >= options_.flush_interval) {
+                running = Push(batch);
+                last_flush = std::chrono::steady_clock::now();
+            }
+            return running;
+        },
+        error, &total_bytes);
+
+    if (read && error.empty() && running && !parser.Finish()) {
+        error = parser.GetError();
+    }
+    if (running && !batch.empty()) {
+        Push(batch);
+    }
+
+    if (!error.empty()) {
+        spdlog::error("Failed to load {}: {}", path_, error);
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    error_ = std::move(error);
+    finished_ = true;
+}
+
+} // namespace earth_map
@@ -0,0 +1,386 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#include <earth_map/data/kml_stream_parser.h>
+
+#include <charconv>
+#include <cmath>
+#include <utility>
+
+namespace earth_map {
+
+namespace {
+
+constexpr std::string_view kCommentOpen = "<!--";
+constexpr std::string_view kCDataOpen = "<![CDATA[";
+
+bool IsSpace(char c) noexcept {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+std::string_view Trim(std::string_view text) noexcept {
+    while (!text.empty() && IsSpace(text.front())) {
+        text.remove_prefix(1);
+    }
+    while (!text.empty() && IsSpace(text.back())) {
+        text.remove_suffix(1);
+    }
+    return text;
+}
+
+/// Element name of a tag without its namespace prefix
+std::string_view LocalName(std::string_view tag) noexcept {
+    size_t end = 0;
+    while (end < tag.size() && !IsSpace(tag[end]) && tag[end] != '/' && tag[end] != '>') {
+        ++end;
+    }
+    std::string_view name = tag.substr(0, end);
+    const size_t colon = name.rfind(':');
+    return colon == std::string_view::npos ? name : name.substr(colon + 1);
+}
+
+/// End of the tag starting at @p begin ('>' outside attribute quotes)
+size_t FindTagEnd(const std::string& buffer, size_t begin) noexcept {
+    char quote = 0;
+    for (size_t i = begin; i < buffer.size(); ++i) {
+        const char c = buffer[i];
+        if (quote != 0) {
+            if (c == quote) {
+                quote = 0;
+            }
+        } else if (c == '"' || c == '\'') {
+            quote = c;
+        } else if (c == '>') {
+            return i;
+        }
+    }
+    return std::string::npos;
+}
+
+void AppendUtf8(std::string& out, uint32_t code_point) {
+    if (code_point < 0x80) {
+        out.push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else if (code_point < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+}
+
+/// Decode the entity between '&' and ';' (exclusive)
+/// @return False if unknown (the caller keeps it verbatim)
+bool DecodeEntity(std::string_view entity, std::string& out) {
+    if (entity == "lt") {
+        out.push_back('<');
+    } else if (entity == "gt") {
+        out.push_back('>');
+    } else if (entity == "amp") {
+        out.push_back('&');
+    } else if (entity == "quot") {
+        out.push_back('"');
+    } else if (entity == "apos") {
+        out.push_back('\'');
+    } else if (entity.size() > 1 && entity[0] == '#') {
+        const bool hex = entity[1] == 'x' || entity[1] == 'X';
+        const std::string_view digits = entity.substr(hex ? 2 : 1);
+        uint32_t code_point = 0;
+        const auto [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(),
+                                               code_point, hex ? 16 : 10);
+        if (ec != std::errc() || end != digits.data() + digits.size() || digits.empty() ||
+            code_point > 0x10FFFF) {
+            return false;
+        }
+        AppendUtf8(out, code_point);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+KmlStreamParser::KmlStreamParser(PlacemarkCallback on_placemark)
+    : on_placemark_(std::move(on_placemark)) {}
+
+bool KmlStreamParser::Write(std::span<const char> data) {
+    if (failed_) {
+        return false;
+    }
+    pending_.append(data.data(), data.size());
+
+    size_t pos = 0;
+    while (pos < pending_.size()) {
+        if (pending_[pos] != '<') {
+            // Character data: only kept inside a field being collected
+            const size_t open = pending_.find('<', pos);
+            size_t end = open == std::string::npos ? pending_.size() : open;
+            if (field_ != Field::NONE && open == std::string::npos) {
+                // Hold back an entity split by the chunk boundary
+                const size_t amp = pending_.rfind('&', end - 1);
+                if (amp != std::string::npos && amp >= pos &&
+                    pending_.find(';', amp) == std::string::npos) {
+                    end = amp;
+                }
+            }
+            if (field_ != Field::NONE) {
+                AppendText(std::string_view(pending_).substr(pos, end - pos));
+            }
+            pos = end;
+            if (open == std::string::npos) {
+                break;
+            }
+            continue;
+        }
+
+        // Markup: wait until the whole construct has arrived
+        const std::string_view rest = std::string_view(pending_).substr(pos);
+        size_t close = std::string::npos;
+        size_t terminator = 1;
+        if (rest.starts_with(kCommentOpen)) {
+            close = pending_.find("-->", pos + kCommentOpen.size());
+            terminator = 3;
+        } else if (rest.starts_with(kCDataOpen)) {
+            close = pending_.find("]]>", pos + kCDataOpen.size());
+            terminator = 3;
+        } else if (rest.size() < kCDataOpen.size() &&
+                   (kCDataOpen.starts_with(rest) || kCommentOpen.starts_with(rest))) {
+            break;
+        } else if (rest.starts_with("<?")) {
+            close = pending_.find("?>", pos + 2);
+            terminator = 2;
+        } else if (rest.starts_with("<!")) {
+            close = pending_.find('>', pos + 2);
+        } else {
+            close = FindTagEnd(pending_, pos + 1);
+        }
+        if (close == std::string::npos) {
+            break;
+        }
+
+        const size_t next = close + terminator;
+        if (!HandleMarkup(std::string_view(pending_).substr(pos, next - pos))) {
+            pending_.clear();
+            return false;
+        }
+        pos = next;
+    }
+
+    pending_.erase(0, pos);
+    return true;
+}
+
+bool KmlStreamParser::Finish() {
+    if (failed_) {
+        return false;
+    }
+    if (!Trim(pending_).empty() || !stack_.empty()) {
+        return Fail("Unexpected end of document");
+    }
+    return true;
+}
+
+bool KmlStreamParser::HandleMarkup(std::string_view markup) {
+    if (markup.starts_with(kCDataOpen)) {
+        if (field_ != Field::NONE) {
+            text_.append(markup.substr(kCDataOpen.size(),
+                                       markup.size() - kCDataOpen.size() - 3));
+        }
+        return true;
+    }
+    if (markup.starts_with("<!") || markup.starts_with("<?")) {
+        return true;  // Comment, declaration or processing instruction
+    }
+
+    if (markup.starts_with("</")) {
+        return CloseElement(LocalName(Trim(markup.substr(2))));
+    }
+
+    const std::string_view name = LocalName(markup.substr(1));
+    if (name.empty()) {
+        return Fail("Invalid tag");
+    }
+    if (!OpenElement(name)) {
+        return false;
+    }
+    if (markup.size() >= 3 && markup[markup.size() - 2] == '/') {
+        return CloseElement(name);
+    }
+    return true;
+}
+
+bool KmlStreamParser::OpenElement(std::string_view name) {
+    stack_.emplace_back(name);
+    const size_t depth = stack_.size();
+
+    if (placemark_depth_ == 0) {
+        if (name == "Placemark") {
+            placemark_depth_ = depth;
+            current_ = KmlPlacemark{};
+            has_geometry_ = false;
+        }
+        return true;
+    }
+    if (field_ != Field::NONE) {
+        return true;  // Markup inside a field: its text still counts
+    }
+
+    if (depth == placemark_depth_ + 1) {
+        if (name == "name") {
+            field_ = Field::NAME;
+        } else if (name == "styleUrl") {
+            field_ = Field::STYLE_URL;
+        }
+    }
+    if (geometry_depth_ == 0 && !has_geometry_) {
+        if (name == "Point") {
+            current_.geometry = KmlGeometryType::POINT;
+            geometry_depth_ = depth;
+        } else if (name == "LineString") {
+            current_.geometry = KmlGeometryType::LINE_STRING;
+            geometry_depth_ = depth;
+        } else if (name == "Polygon") {
+            current_.geometry = KmlGeometryType::POLYGON;
+            geometry_depth_ = depth;
+        }
+    } else if (geometry_depth_ != 0) {
+        if (name == "innerBoundaryIs") {
+            in_inner_boundary_ = true;
+        } else if (name == "coordinates" && !in_inner_boundary_) {
+            field_ = Field::COORDINATES;
+        }
+    }
+
+    if (field_ != Field::NONE) {
+        field_depth_ = depth;
+        text_.clear();
+    }
+    return true;
+}
+
+bool KmlStreamParser::CloseElement(std::string_view name) {
+    if (stack_.empty() || stack_.back() != name) {
+        return Fail("Mismatched closing tag </" + std::string(name) + ">");
+    }
+    const size_t depth = stack_.size();
+    stack_.pop_back();
+    if (placemark_depth_ == 0) {
+        return true;
+    }
+
+    if (field_ != Field::NONE && depth == field_depth_) {
+        switch (field_) {
+            case Field::NAME:
+                current_.name = Trim(text_);
+                break;
+            case Field::STYLE_URL:
+                current_.style_url = Trim(text_);
+                break;
+            case Field::COORDINATES:
+                if (!ParseCoordinates()) {
+                    current_.coordinates.clear();
+                }
+                break;
+            case Field::NONE:
+                break;
+        }
+        field_ = Field::NONE;
+        text_.clear();
+        return true;
+    }
+
+    if (name == "innerBoundaryIs") {
+        in_inner_boundary_ = false;
+    }
+    if (depth == geometry_depth_) {
+        geometry_depth_ = 0;
+        has_geometry_ = !current_.coordinates.empty();
+        if (current_.geometry == KmlGeometryType::POINT && current_.coordinates.size() > 1) {
+            current_.coordinates.resize(1);
+        }
+    }
+    if (depth == placemark_depth_) {
+        placemark_depth_ = 0;
+        geometry_depth_ = 0;
+        in_inner_boundary_ = false;
+        if (has_geometry_) {
+            ++placemark_count_;
+            on_placemark_(std::move(current_));
+        } else {
+            ++skipped_count_;
+        }
+        current_ = KmlPlacemark{};
+    }
+    return true;
+}
+
+void KmlStreamParser::AppendText(std::string_view text) {
+    size_t pos = 0;
+    while (pos < text.size()) {
+        const size_t amp = text.find('&', pos);
+        if (amp == std::string_view::npos) {
+            text_.append(text.substr(pos));
+            return;
+        }
+        text_.append(text.substr(pos, amp - pos));
+        const size_t semicolon = text.find(';', amp);
+        if (semicolon == std::string_view::npos ||
+            !DecodeEntity(text.substr(amp + 1, semicolon - amp - 1), text_)) {
+            text_.push_back('&');
+            pos = amp + 1;
+        } else {
+            pos = semicolon + 1;
+        }
+    }
+}
+
+bool KmlStreamParser::ParseCoordinates() {
+    // Whitespace-separated "lon,lat[,alt]" tuples
+    const char* cursor = text_.data();
+    const char* const end = cursor + text_.size();
+    while (true) {
+        while (cursor != end && IsSpace(*cursor)) {
+            ++cursor;
+        }
+        if (cursor == end) {
+            return true;
+        }
+
+        double values[3] = {0.0, 0.0, 0.0};
+        int count = 0;
+        while (true) {
+            if (count == 3) {
+                return false;
+            }
+            const auto [next, ec] = std::from_chars(cursor, end, values[count]);
+            if (ec != std::errc() || !std::isfinite(values[count])) {
+                return false;
+            }
+            ++count;
+            cursor = next;
+            if (cursor == end || *cursor != ',') {
+                break;
+            }
+            ++cursor;
+        }
+        if (count < 2 || (cursor != end && !IsSpace(*cursor))) {
+            return false;
+        }
+        current_.coordinates.emplace_back(values[1], values[0], values[2]);
+    }
+}
+
+bool KmlStreamParser::Fail(std::string error) {
+    failed_ = true;
+    error_ = std::move(error);
+    return false;
+}
+
+} // namespace earth_map
@@ -0,0 +1,86 @@
+/**
+ * @file latency_histogram.cpp
+ * @brief Log-bucketed latency histogram implementation
+ */
+
+#include <earth_map/data/latency_histogram.h>
+#include <algorithm>
+#include <cmath>
+
+namespace earth_map {
+
+namespace {
+
+/// Bucket i covers latencies up to kFirstBucketMs * kBucketGrowth^i
+constexpr double kFirstBucketMs = 0.01;
+constexpr double kBucketGrowth = 1.19;
+
+} // namespace
+
+void LatencyHistogram::Record(double latency_ms) {
+    latency_ms = std::max(latency_ms, 0.0);
+    buckets_[GetBucket(latency_ms)]++;
+    count_++;
+    sum_ms_ += latency_ms;
+    max_ms_ = std::max(max_ms_, latency_ms);
+}
+
+double LatencyHistogram::GetPercentile(double fraction) const {
+    if (count_ == 0) {
+        return 0.0;
+    }
+
+    // Rank of the sample, 1-based: p95 of 100 samples is the 95th
+    const double clamped = std::clamp(fraction, 0.0, 1.0);
+    const auto rank = std::max<std::uint64_t>(
+        static_cast<std::uint64_t>(std::ceil(clamped * static_cast<double>(count_))), 1);
+
+    std::uint64_t seen = 0;
+    for (std::size_t bucket = 0; bucket < kBucketCount; ++bucket) {
+        seen += buckets_[bucket];
+        if (seen >= rank) {
+            // Never report more than the slowest actual sample
+            return std::min(GetBucketUpperBound(bucket), max_ms_);
+        }
+    }
+    return max_ms_;
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram& other) {
+    for (std::size_t bucket = 0; bucket < kBucketCount; ++bucket) {
+        buckets_[bucket] += other.buckets_[bucket];
+    }
+    count_ += other.count_;
+    sum_ms_ += other.sum_ms_;
+    max_ms_ = std::max(max_ms_, other.max_ms_);
+}
+
+void LatencyHistogram::Reset() {
+    *this = LatencyHistogram{};
+}
+
+double LatencyHistogram::GetBucketUpperBound(std::size_t bucket) {
+    return kFirstBucketMs * std::pow(kBucketGrowth, static_cast<double>(bucket));
+}
+
+LatencyHistogram LatencyHistogram::FromBuckets(
+    const std::array<std::uint64_t, kBucketCount>& buckets, double sum_ms, double max_ms) {
+    LatencyHistogram histogram;
+    histogram.buckets_ = buckets;
+    for (const std::uint64_t count : buckets) {
+        histogram.count_ += count;
+    }
+    histogram.sum_ms_ = sum_ms;
+    histogram.max_ms_ = max_ms;
+    return histogram;
+}
+
+std::size_t LatencyHistogram::GetBucket(double latency_ms) {
+    if (latency_ms <= kFirstBucketMs) {
+        return 0;
+    }
+    const double index = std::ceil(std::log(latency_ms / kFirstBucketMs) / std::log(kBucketGrowth));
+    return std::min(static_cast<std::size_t>(index), kBucketCount - 1);
+}
+
+} // namespace earth_map
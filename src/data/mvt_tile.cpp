@@ -0,0 +1,329 @@
+/**
+ * @file mvt_tile.cpp
+ * @brief Mapbox Vector Tile decoding implementation
+ */
+
+#include <earth_map/data/mvt_tile.h>
+#include <earth_map/data/tile_compression.h>
+#include <spdlog/spdlog.h>
+#include <cstring>
+
+namespace earth_map {
+
+namespace {
+
+// Protobuf wire types
+constexpr std::uint32_t kWireVarint = 0;
+constexpr std::uint32_t kWireFixed64 = 1;
+constexpr std::uint32_t kWireLengthDelimited = 2;
+constexpr std::uint32_t kWireFixed32 = 5;
+
+// Geometry commands
+constexpr std::uint32_t kCommandMoveTo = 1;
+constexpr std::uint32_t kCommandLineTo = 2;
+constexpr std::uint32_t kCommandClosePath = 7;
+
+/**
+ * @brief Reads protobuf fields from a byte range
+ *
+ * Errors latch: after a malformed field every read returns zero and Ok()
+ * is false.
+ */
+class ProtobufReader {
+public:
+    explicit ProtobufReader(std::span<const std::uint8_t> data) : data_(data) {}
+
+    bool Ok() const { return ok_; }
+    bool AtEnd() const { return !ok_ || position_ >= data_.size(); }
+
+    /// Read the next field key; false at the end or on error
+    bool Next(std::uint32_t& field, std::uint32_t& wire_type) {
+        if (AtEnd()) {
+            return false;
+        }
+        const std::uint64_t key = ReadVarint();
+        field = static_cast<std::uint32_t>(key >> 3);
+        wire_type = static_cast<std::uint32_t>(key & 0x7);
+        if (field == 0) {
+            ok_ = false;
+        }
+        return ok_;
+    }
+
+    std::uint64_t ReadVarint() {
+        std::uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (position_ >= data_.size()) {
+                break;
+            }
+            const std::uint8_t byte = data_[position_++];
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        ok_ = false;
+        return 0;
+    }
+
+    std::span<const std::uint8_t> ReadBytes() {
+        const std::uint64_t size = ReadVarint();
+        if (!ok_ || size > data_.size() - position_) {
+            ok_ = false;
+            return {};
+        }
+        const auto bytes = data_.subspan(position_, static_cast<std::size_t>(size));
+        position_ += static_cast<std::size_t>(size);
+        return bytes;
+    }
+
+    std::string ReadString() {
+        const auto bytes = ReadBytes();
+        return std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+    }
+
+    template <typename T>
+    T ReadFixed() {
+        T value{};
+        if (sizeof(T) > data_.size() - position_) {
+            ok_ = false;
+            return value;
+        }
+        // Little-endian on the wire and on every supported target
+        std::memcpy(&value, data_.data() + position_, sizeof(T));
+        position_ += sizeof(T);
+        return value;
+    }
+
+    void Skip(std::uint32_t wire_type) {
+        switch (wire_type) {
+            case kWireVarint: ReadVarint(); break;
+            case kWireFixed64: ReadFixed<std::uint64_t>(); break;
+            case kWireLengthDelimited: ReadBytes(); break;
+            case kWireFixed32: ReadFixed<std::uint32_t>(); break;
+            default: ok_ = false; break;
+        }
+    }
+
+private:
+    std::span<const std::uint8_t> data_;
+    std::size_t position_ = 0;
+    bool ok_ = true;
+};
+
+std::int64_t ZigZag(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+/// Read a packed repeated uint32 field
+bool ReadPacked(ProtobufReader& reader, std::vector<std::uint32_t>& out) {
+    ProtobufReader packed(reader.ReadBytes());
+    while (!packed.AtEnd()) {
+        out.push_back(static_cast<std::uint32_t>(packed.ReadVarint()));
+    }
+    return reader.Ok() && packed.Ok();
+}
+
+bool DecodeValue(std::span<const std::uint8_t> bytes, MvtValue& value) {
+    ProtobufReader reader(bytes);
+    std::uint32_t field = 0;
+    std::uint32_t wire_type = 0;
+    while (reader.Next(field, wire_type)) {
+        switch (field) {
+            case 1: value = reader.ReadString(); break;
+            case 2: value = static_cast<double>(reader.ReadFixed<float>()); break;
+            case 3: value = reader.ReadFixed<double>(); break;
+            case 4: value = static_cast<std::int64_t>(reader.ReadVarint()); break;
+            case 5: value = reader.ReadVarint(); break;
+            case 6: value = ZigZag(reader.ReadVarint()); break;
+            case 7: value = reader.ReadVarint() != 0; break;
+            default: reader.Skip(wire_type); break;
+        }
+    }
+    return reader.Ok();
+}
+
+/// Run a feature's command stream; false if it is malformed
+bool DecodeGeometry(const std::vector<std::uint32_t>& commands, MvtGeometryType type,
+                    float scale, std::vector<std::vector<glm::vec2>>& parts) {
+    std::int64_t x = 0;
+    std::int64_t y = 0;
+    std::size_t i = 0;
+    while (i < commands.size()) {
+        const std::uint32_t command = commands[i] & 0x7;
+        const std::uint32_t count = commands[i] >> 3;
+        ++i;
+
+        if (command == kCommandClosePath) {
+            if (type != MvtGeometryType::POLYGON || parts.empty() || parts.back().size() < 3) {
+                return false;
+            }
+            continue;
+        }
+        if (command != kCommandMoveTo && command != kCommandLineTo) {
+            return false;
+        }
+        if (count > (commands.size() - i) / 2) {
+            return false;
+        }
+
+        if (command == kCommandMoveTo) {
+            // Points keep every point in one part; lines and rings start a part
+            if (type != MvtGeometryType::POINT || parts.empty()) {
+                parts.emplace_back();
+            }
+        } else if (parts.empty()) {
+            return false;
+        }
+
+        for (std::uint32_t n = 0; n < count; ++n, i += 2) {
+            x += ZigZag(commands[i]);
+            y += ZigZag(commands[i + 1]);
+            parts.back().emplace_back(static_cast<float>(x) * scale,
+                                      static_cast<float>(y) * scale);
+        }
+    }
+    return true;
+}
+
+bool DecodeFeature(std::span<const std::uint8_t> bytes, float scale, MvtFeature& feature) {
+    ProtobufReader reader(bytes);
+    std::vector<std::uint32_t> commands;
+    std::uint32_t field = 0;
+    std::uint32_t wire_type = 0;
+    while (reader.Next(field, wire_type)) {
+        switch (field) {
+            case 1: feature.id = reader.ReadVarint(); break;
+            case 2:
+                if (!ReadPacked(reader, feature.tags)) {
+                    return false;
+                }
+                break;
+            case 3: {
+                const std::uint64_t type = reader.ReadVarint();
+                feature.type = type <= 3 ? static_cast<MvtGeometryType>(type)
+                                         : MvtGeometryType::UNKNOWN;
+                break;
+            }
+            case 4:
+                if (!ReadPacked(reader, commands)) {
+                    return false;
+                }
+                break;
+            default: reader.Skip(wire_type); break;
+        }
+    }
+    if (!reader.Ok()) {
+        return false;
+    }
+    return DecodeGeometry(commands, feature.type, scale, feature.geometry);
+}
+
+bool DecodeLayer(std::span<const std::uint8_t> bytes, MvtLayer& layer) {
+    ProtobufReader reader(bytes);
+    // Extent may follow the features: decode them once it is known
+    std::vector<std::span<const std::uint8_t>> features;
+    std::uint32_t field = 0;
+    std::uint32_t wire_type = 0;
+    while (reader.Next(field, wire_type)) {
+        switch (field) {
+            case 1: layer.name = reader.ReadString(); break;
+            case 2: features.push_back(reader.ReadBytes()); break;
+            case 3: layer.keys.push_back(reader.ReadString()); break;
+            case 4: {
+                MvtValue value;
+                if (!DecodeValue(reader.ReadBytes(), value)) {
+                    return false;
+                }
+                layer.values.push_back(std::move(value));
+                break;
+            }
+            case 5: layer.extent = static_cast<std::uint32_t>(reader.ReadVarint()); break;
+            case 15: layer.version = static_cast<std::uint32_t>(reader.ReadVarint()); break;
+            default: reader.Skip(wire_type); break;
+        }
+    }
+    if (!reader.Ok() || layer.extent == 0) {
+        return false;
+    }
+
+    const float scale = 1.0f / static_cast<float>(layer.extent);
+    layer.features.reserve(features.size());
+    for (const auto& feature_bytes : features) {
+        MvtFeature feature;
+        if (!DecodeFeature(feature_bytes, scale, feature)) {
+            spdlog::debug("Dropping malformed feature {} of vector tile layer '{}'", feature.id,
+                          layer.name);
+            continue;
+        }
+        layer.features.push_back(std::move(feature));
+    }
+    return true;
+}
+
+} // namespace
+
+const MvtValue* MvtLayer::GetProperty(const MvtFeature& feature, std::string_view key) const {
+    for (std::size_t i = 0; i + 1 < feature.tags.size(); i += 2) {
+        const std::uint32_t key_index = feature.tags[i];
+        const std::uint32_t value_index = feature.tags[i + 1];
+        if (key_index < keys.size() && value_index < values.size() && keys[key_index] == key) {
+            return &values[value_index];
+        }
+    }
+    return nullptr;
+}
+
+const MvtLayer* MvtTile::FindLayer(std::string_view name) const {
+    for (const MvtLayer& layer : layers) {
+        if (layer.name == name) {
+            return &layer;
+        }
+    }
+    return nullptr;
+}
+
+std::optional<MvtTile> DecodeMvtTile(std::span<const std::uint8_t> data) {
+    std::optional<std::vector<std::uint8_t>> inflated;
+    if (data.size() >= 2 && data[0] == 0x1F && data[1] == 0x8B) {
+        inflated = DecompressTileData(data, TileMetadata::Compression::GZIP);
+        if (!inflated) {
+            spdlog::warn("Cannot inflate gzip-encoded vector tile (zlib {})",
+                         IsCompressionAvailable(TileMetadata::Compression::GZIP)
+                             ? "error" : "not compiled in");
+            return std::nullopt;
+        }
+        data = *inflated;
+    }
+
+    MvtTile tile;
+    ProtobufReader reader(data);
+    std::uint32_t field = 0;
+    std::uint32_t wire_type = 0;
+    while (reader.Next(field, wire_type)) {
+        if (field != 3 || wire_type != kWireLengthDelimited) {
+            reader.Skip(wire_type);
+            continue;
+        }
+        MvtLayer layer;
+        if (!DecodeLayer(reader.ReadBytes(), layer)) {
+            return std::nullopt;
+        }
+        tile.layers.push_back(std::move(layer));
+    }
+    if (!reader.Ok()) {
+        return std::nullopt;
+    }
+    return tile;
+}
+
+double MvtRingArea(std::span<const glm::vec2> ring) {
+    double twice_area = 0.0;
+    for (std::size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++) {
+        twice_area += static_cast<double>(ring[j].x) * ring[i].y -
+                      static_cast<double>(ring[i].x) * ring[j].y;
+    }
+    return twice_area * 0.5;
+}
+
+} // namespace earth_map
@@ -0,0 +1,1128 @@
+/**
+ * @file packed_tile_store.cpp
+ * @brief Implementation of the packed, memory-mapped disk tile store
+ */
+
+#include <earth_map/data/packed_tile_store.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace earth_map {
+
+namespace {
+
+constexpr std::uint32_t kRecordMagic = 0x4B505445;  // "ETPK"
+constexpr std::uint16_t kRecordVersion = 1;
+constexpr std::uint16_t kFlagTombstone = 1;
+constexpr std::uint16_t kFlagMetadataOnly = 2;  ///< Supersedes the metadata of the tile's record
+constexpr std::size_t kRecordAlignment = 8;
+constexpr const char* kSegmentPrefix = "segment_";
+constexpr const char* kSegmentExtension = ".pack";
+constexpr const char* kSharedHeaderFile = "store.shm";
+constexpr const char* kLockFile = "store.lock";
+constexpr std::uint32_t kSharedMagic = 0x48535445;  // "ETSH"
+constexpr std::uint32_t kSharedVersion = 1;
+
+/// Log positions pack (segment id + 1, offset) so 0 means an empty log
+constexpr int kPositionOffsetBits = 40;
+constexpr std::uint64_t kPositionOffsetMask = (std::uint64_t{1} << kPositionOffsetBits) - 1;
+
+std::uint64_t PackPosition(std::uint32_t id, std::size_t offset) {
+    return ((std::uint64_t{id} + 1) << kPositionOffsetBits) | (offset & kPositionOffsetMask);
+}
+
+std::pair<std::uint32_t, std::size_t> UnpackPosition(std::uint64_t position) {
+    return {static_cast<std::uint32_t>((position >> kPositionOffsetBits) - 1),
+            static_cast<std::size_t>(position & kPositionOffsetMask)};
+}
+
+/// On-disk record header; followed by metadata bytes, tile bytes, padding
+struct RecordHeader {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t flags;
+    std::int32_t x;
+    std::int32_t y;
+    std::int32_t zoom;
+    std::uint32_t metadata_size;
+    std::uint32_t data_size;
+    std::uint32_t checksum;  ///< FNV-1a over metadata and data
+};
+static_assert(sizeof(RecordHeader) == 32, "RecordHeader layout must stay stable");
+
+std::size_t RecordSize(std::size_t metadata_size, std::size_t data_size) {
+    const std::size_t size = sizeof(RecordHeader) + metadata_size + data_size;
+    return (size + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+}
+
+std::uint32_t Fnv1a(std::span<const std::uint8_t> bytes, std::uint32_t hash = 2166136261u) {
+    for (std::uint8_t byte : bytes) {
+        hash ^= byte;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+template <typename T>
+void AppendPod(std::vector<std::uint8_t>& out, const T& value) {
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+void AppendString(std::vector<std::uint8_t>& out, const std::string& value) {
+    AppendPod(out, static_cast<std::uint32_t>(value.size()));
+    out.insert(out.end(), value.begin(), value.end());
+}
+
+/// Bounds-checked reader over a serialized metadata blob
+class BlobReader {
+public:
+    explicit BlobReader(std::span<const std::uint8_t> bytes) : bytes_(bytes) {}
+
+    template <typename T>
+    bool Read(T& value) {
+        if (offset_ + sizeof(T) > bytes_.size()) {
+            return false;
+        }
+        std::memcpy(&value, bytes_.data() + offset_, sizeof(T));
+        offset_ += sizeof(T);
+        return true;
+    }
+
+    bool ReadString(std::string& value) {
+        std::uint32_t size = 0;
+        if (!Read(size) || offset_ + size > bytes_.size()) {
+            return false;
+        }
+        value.assign(reinterpret_cast<const char*>(bytes_.data() + offset_), size);
+        offset_ += size;
+        return true;
+    }
+
+private:
+    std::span<const std::uint8_t> bytes_;
+    std::size_t offset_ = 0;
+};
+
+std::int64_t ToSeconds(std::chrono::system_clock::time_point time) {
+    return static_cast<std::int64_t>(std::chrono::system_clock::to_time_t(time));
+}
+
+std::chrono::system_clock::time_point FromSeconds(std::int64_t seconds) {
+    return std::chrono::system_clock::from_time_t(static_cast<std::time_t>(seconds));
+}
+
+std::vector<std::uint8_t> SerializeMetadata(const TileMetadata& metadata) {
+    std::vector<std::uint8_t> out;
+    out.reserve(64 + metadata.etag.size() + metadata.content_type.size() +
+                metadata.server_last_modified.size());
+    AppendPod(out, static_cast<std::uint64_t>(metadata.file_size));
+    AppendPod(out, ToSeconds(metadata.last_modified));
+    AppendPod(out, ToSeconds(metadata.expires_at));
+    AppendPod(out, ToSeconds(metadata.last_access));
+    AppendString(out, metadata.etag);
+    AppendString(out, metadata.content_type);
+    AppendPod(out, static_cast<std::uint8_t>(metadata.compression));
+    AppendPod(out, metadata.checksum);
+    AppendPod(out, metadata.access_count);
+    AppendString(out, metadata.server_last_modified);
+    return out;
+}
+
+bool DeserializeMetadata(std::span<const std::uint8_t> bytes,
+                         const TileCoordinates& coords,
+                         TileMetadata& metadata) {
+    BlobReader reader(bytes);
+    std::uint64_t file_size = 0;
+    std::int64_t modified = 0;
+    std::int64_t expires = 0;
+    std::int64_t accessed = 0;
+    std::uint8_t compression = 0;
+
+    if (!reader.Read(file_size) || !reader.Read(modified) || !reader.Read(expires) ||
+        !reader.Read(accessed) || !reader.ReadString(metadata.etag) ||
+        !reader.ReadString(metadata.content_type) || !reader.Read(compression) ||
+        !reader.Read(metadata.checksum) || !reader.Read(metadata.access_count)) {
+        return false;
+    }
+    // Trailing field: absent from records written before it existed
+    if (!reader.ReadString(metadata.server_last_modified)) {
+        metadata.server_last_modified.clear();
+    }
+
+    metadata.coordinates = coords;
+    metadata.file_size = static_cast<std::size_t>(file_size);
+    metadata.last_modified = FromSeconds(modified);
+    metadata.expires_at = FromSeconds(expires);
+    metadata.last_access = FromSeconds(accessed);
+    metadata.compression = static_cast<TileMetadata::Compression>(compression);
+    return true;
+}
+
+bool WriteFully(int fd, const std::uint8_t* data, std::size_t size, std::size_t offset) {
+    while (size > 0) {
+        const ssize_t written = ::pwrite(fd, data, size, static_cast<off_t>(offset));
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+        offset += static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * @brief One segment file and its read-only mapping
+ */
+struct PackedTileStore::Segment {
+    std::uint32_t id = 0;
+    std::string path;
+    int fd = -1;
+    const std::uint8_t* base = nullptr;
+    std::size_t capacity = 0;
+    std::size_t write_offset = 0;   ///< End of the last complete record
+    std::size_t live_bytes = 0;     ///< Bytes of records referenced by the index
+    bool sealed = false;
+
+    /// Owns the mapping; shared with views so it can outlive the segment
+    std::shared_ptr<const void> mapping;
+
+    ~Segment() {
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    const RecordHeader* HeaderAt(std::size_t offset) const {
+        return reinterpret_cast<const RecordHeader*>(base + offset);
+    }
+};
+
+/**
+ * @brief Cross-process state of a shared store (mapped from store.shm)
+ *
+ * Written only under the flock; read lock-free by every process.
+ */
+struct PackedTileStore::SharedHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::atomic<std::uint64_t> generation;       ///< Bumped by Clear()
+    std::atomic<std::uint64_t> head;             ///< End of the published log (PackPosition)
+    std::atomic<std::uint32_t> next_segment_id;  ///< Ids are unique across processes
+};
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free &&
+                  std::atomic<std::uint32_t>::is_always_lock_free,
+              "Shared header atomics must be address-free");
+
+/**
+ * @brief Excludes other writers of a shared store: this process's threads, then other processes
+ *
+ * No-op for a private store, whose writers are serialised by mutex_ alone.
+ * Taken before mutex_.
+ */
+class PackedTileStore::WriterGuard {
+public:
+    explicit WriterGuard(PackedTileStore& store) : fd_(store.lock_fd_) {
+        if (fd_ < 0) {
+            return;
+        }
+        lock_ = std::unique_lock<std::mutex>(store.writer_mutex_);
+        while (::flock(fd_, LOCK_EX) != 0 && errno == EINTR) {
+        }
+    }
+
+    ~WriterGuard() {
+        if (fd_ >= 0) {
+            ::flock(fd_, LOCK_UN);
+        }
+    }
+
+    WriterGuard(const WriterGuard&) = delete;
+    WriterGuard& operator=(const WriterGuard&) = delete;
+
+private:
+    int fd_;
+    std::unique_lock<std::mutex> lock_;
+};
+
+namespace {
+
+/// Map a segment file read-only; the returned pointer unmaps on release
+std::shared_ptr<const void> MapSegment(int fd, std::size_t size, const std::uint8_t** base) {
+    void* address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (address == MAP_FAILED) {
+        return nullptr;
+    }
+    *base = static_cast<const std::uint8_t*>(address);
+    return std::shared_ptr<const void>(address, [size](const void* ptr) {
+        ::munmap(const_cast<void*>(ptr), size);
+    });
+}
+
+} // namespace
+
+PackedTileStore::PackedTileStore(const PackedTileStoreConfig& config)
+    : config_(config) {
+    config_.segment_size = std::max<std::size_t>(config_.segment_size, 4096);
+    config_.compaction_threshold = std::clamp(config_.compaction_threshold, 0.0, 1.0);
+}
+
+PackedTileStore::~PackedTileStore() {
+    Close();
+}
+
+std::string PackedTileStore::SegmentPath(std::uint32_t id) const {
+    std::ostringstream oss;
+    oss << config_.directory << "/" << kSegmentPrefix
+        << std::setw(8) << std::setfill('0') << id << kSegmentExtension;
+    return oss.str();
+}
+
+std::vector<std::uint32_t> PackedTileStore::ListSegmentIds() const {
+    std::vector<std::uint32_t> ids;
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(config_.directory, error)) {
+        const std::string name = entry.path().filename().string();
+        if (entry.path().extension() != kSegmentExtension ||
+            name.rfind(kSegmentPrefix, 0) != 0) {
+            continue;
+        }
+        try {
+            ids.push_back(static_cast<std::uint32_t>(
+                std::stoul(name.substr(std::strlen(kSegmentPrefix)))));
+        } catch (const std::exception&) {
+            spdlog::warn("Ignoring unexpected file in packed tile store: {}", name);
+        }
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+}
+
+std::shared_ptr<PackedTileStore::Segment> PackedTileStore::MapSegmentFileLocked(
+    std::uint32_t id) const {
+    auto segment = std::make_shared<Segment>();
+    segment->id = id;
+    segment->path = SegmentPath(id);
+    segment->fd = ::open(segment->path.c_str(), O_RDWR);
+
+    struct stat file_stat {};
+    if (segment->fd < 0 || ::fstat(segment->fd, &file_stat) != 0) {
+        spdlog::warn("Failed to open packed tile segment {}", segment->path);
+        return nullptr;
+    }
+    segment->capacity = static_cast<std::size_t>(file_stat.st_size);
+    if (segment->capacity == 0) {
+        return nullptr;
+    }
+    segment->mapping = MapSegment(segment->fd, segment->capacity, &segment->base);
+    if (!segment->mapping) {
+        spdlog::warn("Failed to map packed tile segment {}", segment->path);
+        return nullptr;
+    }
+    segments_[id] = segment;
+    return segment;
+}
+
+std::size_t PackedTileStore::ReplayLocked(Segment& segment, std::size_t offset,
+                                          std::size_t limit, std::size_t* records) const {
+    // Later records supersede earlier ones; a bad record ends the segment
+    limit = std::min(limit, segment.capacity);
+    while (offset + sizeof(RecordHeader) <= limit) {
+        RecordHeader header;
+        std::memcpy(&header, segment.HeaderAt(offset), sizeof(header));
+        if (header.magic != kRecordMagic || header.version != kRecordVersion) {
+            break;
+        }
+        const std::size_t size = RecordSize(header.metadata_size, header.data_size);
+        if (offset + size > limit) {
+            break;
+        }
+        std::span<const std::uint8_t> body(
+            segment.base + offset + sizeof(RecordHeader),
+            header.metadata_size + header.data_size);
+        if (Fnv1a(body) != header.checksum) {
+            break;
+        }
+
+        const TileCoordinates coords(header.x, header.y, header.zoom);
+        if (header.flags & kFlagTombstone) {
+            ReplaceLocked(coords, Location{});
+        } else if (header.flags & kFlagMetadataOnly) {
+            SetMetadataLocked(coords,
+                              Location{segments_.at(segment.id), offset, size, nullptr, 0, 0});
+        } else {
+            ReplaceLocked(coords, Location{segments_.at(segment.id), offset, size, nullptr, 0, 0});
+        }
+        offset += size;
+        if (records) {
+            ++*records;
+        }
+    }
+    return offset;
+}
+
+bool PackedTileStore::Open() {
+    Close();
+
+    std::error_code error;
+    std::filesystem::create_directories(config_.directory, error);
+    if (error) {
+        spdlog::error("Failed to create packed tile store directory {}: {}",
+                      config_.directory, error.message());
+        return false;
+    }
+    if (config_.shared && !OpenShared()) {
+        return false;
+    }
+
+    // Shared: no other process appends while the log is recovered
+    WriterGuard guard(*this);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+
+    // The published head of a live shared log (0: none yet, or a new header)
+    const bool has_shared_log = shared_ && shared_->magic == kSharedMagic &&
+                                shared_->version == kSharedVersion;
+    std::uint64_t head = has_shared_log ? shared_->head.load(std::memory_order_acquire) : 0;
+    const auto [head_id, head_offset] = UnpackPosition(head);
+
+    std::size_t recovered = 0;
+    for (std::uint32_t id : ListSegmentIds()) {
+        next_segment_id_ = std::max(next_segment_id_, id + 1);
+
+        // Created by a writer that died before publishing it: never read
+        const bool published = !has_shared_log || (head != 0 && id <= head_id);
+        std::shared_ptr<Segment> segment = published ? MapSegmentFileLocked(id) : nullptr;
+        if (!segment) {
+            std::filesystem::remove(SegmentPath(id), error);
+            continue;
+        }
+
+        if (has_shared_log && id == head_id) {
+            // The shared head segment stays open for appends; nothing past the head is read
+            const std::size_t offset = ReplayLocked(*segment, 0, head_offset, &recovered);
+            if (offset < head_offset) {
+                head = PackPosition(id, offset);  // Lost writes (e.g. power loss): move the head back
+            }
+            segment->write_offset = offset;
+            active_ = segment;
+            continue;
+        }
+
+        const std::size_t offset = ReplayLocked(*segment, 0, segment->capacity, &recovered);
+        if (offset < segment->capacity) {
+            // Drop the unused or torn tail; it is never read
+            if (::ftruncate(segment->fd, static_cast<off_t>(offset)) != 0) {
+                spdlog::warn("Failed to truncate packed tile segment {}", segment->path);
+            }
+        }
+        segment->write_offset = offset;
+        segment->sealed = true;
+    }
+
+    if (shared_) {
+        if (!has_shared_log) {
+            // First process on this directory: the recovered segments are the log
+            shared_->generation.store(1, std::memory_order_relaxed);
+            shared_->next_segment_id.store(next_segment_id_, std::memory_order_relaxed);
+            shared_->magic = kSharedMagic;
+            shared_->version = kSharedVersion;
+            const auto last = segments_.rbegin();
+            head = last == segments_.rend() ? 0 : PackPosition(last->first, last->second->write_offset);
+        }
+        shared_->head.store(head, std::memory_order_release);
+        replayed_head_ = head;
+        seen_generation_ = shared_->generation.load(std::memory_order_acquire);
+    }
+
+    open_ = true;
+    spdlog::info("Packed tile store opened{}: {} segments, {} tiles ({} records replayed)",
+                 shared_ ? " (shared)" : "", segments_.size(), index_.size(), recovered);
+
+    lock.unlock();
+
+    if (config_.background_compaction) {
+        {
+            std::lock_guard<std::mutex> stop_lock(stop_mutex_);
+            stop_ = false;
+        }
+        compaction_thread_ = std::thread(&PackedTileStore::CompactionLoop, this);
+    }
+    return true;
+}
+
+bool PackedTileStore::OpenShared() {
+    const std::string lock_path = config_.directory + "/" + kLockFile;
+    lock_fd_ = ::open(lock_path.c_str(), O_RDWR | O_CREAT, 0644);
+    if (lock_fd_ < 0) {
+        spdlog::error("Failed to open packed tile store lock {}: {}", lock_path, std::strerror(errno));
+        return false;
+    }
+
+    // A zero-filled header is "not initialized"; Open() fills it under the flock
+    const std::string header_path = config_.directory + "/" + kSharedHeaderFile;
+    const int fd = ::open(header_path.c_str(), O_RDWR | O_CREAT, 0644);
+    struct stat file_stat {};
+    void* address = MAP_FAILED;
+    if (fd >= 0 && ::fstat(fd, &file_stat) == 0 &&
+        (static_cast<std::size_t>(file_stat.st_size) >= sizeof(SharedHeader) ||
+         ::ftruncate(fd, sizeof(SharedHeader)) == 0)) {
+        address = ::mmap(nullptr, sizeof(SharedHeader), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (fd >= 0) {
+        ::close(fd);  // The mapping stays valid
+    }
+    if (address == MAP_FAILED) {
+        spdlog::error("Failed to map packed tile store header {}", header_path);
+        CloseShared();
+        return false;
+    }
+    shared_ = static_cast<SharedHeader*>(address);
+    return true;
+}
+
+void PackedTileStore::CloseShared() {
+    if (shared_) {
+        ::munmap(shared_, sizeof(SharedHeader));
+        shared_ = nullptr;
+    }
+    if (lock_fd_ >= 0) {
+        ::close(lock_fd_);
+        lock_fd_ = -1;
+    }
+    replayed_head_ = 0;
+    seen_generation_ = 0;
+}
+
+void PackedTileStore::CatchUp() const {
+    if (!shared_ ||
+        (shared_->head.load(std::memory_order_acquire) == replayed_head_.load() &&
+         shared_->generation.load(std::memory_order_acquire) == seen_generation_.load())) {
+        return;
+    }
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    CatchUpLocked();
+}
+
+void PackedTileStore::CatchUpLocked() const {
+    if (!shared_ || !open_) {
+        return;
+    }
+    const std::uint64_t generation = shared_->generation.load(std::memory_order_acquire);
+    const std::uint64_t head = shared_->head.load(std::memory_order_acquire);
+    if (generation == seen_generation_ && head == replayed_head_) {
+        return;
+    }
+
+    // Segments holding records past the replayed head, with the offset to resume at
+    std::vector<std::uint32_t> ids;
+    auto [resume_id, resume_offset] = UnpackPosition(replayed_head_);
+    if (generation != seen_generation_ || replayed_head_ == 0) {
+        if (generation != seen_generation_) {
+            // Another process cleared the store
+            index_.clear();
+            segments_.clear();
+            active_.reset();
+            seen_generation_ = generation;
+        }
+        ids = ListSegmentIds();
+        resume_id = 0;
+        resume_offset = 0;
+    } else if (head != 0) {
+        for (std::uint32_t id = resume_id; id <= UnpackPosition(head).first; ++id) {
+            ids.push_back(id);
+        }
+    }
+
+    const auto [head_id, head_offset] = UnpackPosition(head);
+    for (std::uint32_t id : ids) {
+        if (head == 0 || id > head_id) {
+            break;
+        }
+        auto it = segments_.find(id);
+        std::shared_ptr<Segment> segment;
+        if (it != segments_.end()) {
+            segment = it->second;
+        } else if (std::filesystem::exists(SegmentPath(id))) {
+            segment = MapSegmentFileLocked(id);
+        }
+        if (!segment) {
+            continue;  // Compacted away; its live records were appended again later
+        }
+        // A segment sealed since it was mapped is shorter than its mapping
+        struct stat file_stat {};
+        const std::size_t file_size = ::fstat(segment->fd, &file_stat) == 0
+                                          ? static_cast<std::size_t>(file_stat.st_size)
+                                          : segment->write_offset;
+        const std::size_t from = id == resume_id ? std::max(resume_offset, segment->write_offset)
+                                                 : segment->write_offset;
+        const std::size_t limit = std::min(file_size, id == head_id ? head_offset : segment->capacity);
+        segment->write_offset = std::max(segment->write_offset, ReplayLocked(*segment, from, limit, nullptr));
+        segment->sealed = id != head_id;
+    }
+    replayed_head_ = head;
+
+    // Appends continue at the shared head
+    if (active_ && (head == 0 || active_->id != head_id)) {
+        active_.reset();
+    }
+    if (head != 0) {
+        next_segment_id_ = std::max(next_segment_id_, head_id + 1);
+        auto it = segments_.find(head_id);
+        if (!active_ && it != segments_.end()) {
+            active_ = it->second;
+        }
+    }
+}
+
+void PackedTileStore::PublishLocked() {
+    if (!shared_ || !active_) {
+        return;
+    }
+    const std::uint64_t head = PackPosition(active_->id, active_->write_offset);
+    shared_->head.store(head, std::memory_order_release);
+    replayed_head_ = head;
+}
+
+void PackedTileStore::Close() {
+    {
+        std::lock_guard<std::mutex> stop_lock(stop_mutex_);
+        stop_ = true;
+    }
+    stop_cv_.notify_all();
+    if (compaction_thread_.joinable()) {
+        compaction_thread_.join();
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        CloseLocked();
+    }
+    CloseShared();
+}
+
+void PackedTileStore::CloseLocked() {
+    if (shared_) {
+        active_.reset();  // Other processes may still append to it
+    } else {
+        SealActiveLocked();
+    }
+    index_.clear();
+    segments_.clear();
+    open_ = false;
+}
+
+std::shared_ptr<PackedTileStore::Segment> PackedTileStore::CreateSegmentLocked(
+    std::size_t capacity) {
+    auto segment = std::make_shared<Segment>();
+    segment->id = shared_ ? shared_->next_segment_id.fetch_add(1) : next_segment_id_++;
+    next_segment_id_ = std::max(next_segment_id_, segment->id + 1);
+    segment->path = SegmentPath(segment->id);
+    segment->capacity = capacity;
+    segment->fd = ::open(segment->path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (segment->fd < 0) {
+        spdlog::error("Failed to create packed tile segment {}: {}",
+                      segment->path, std::strerror(errno));
+        return nullptr;
+    }
+
+    // Sparse until written; mapped once at full capacity so appends are visible
+    if (::ftruncate(segment->fd, static_cast<off_t>(capacity)) != 0) {
+        spdlog::error("Failed to size packed tile segment {}", segment->path);
+        return nullptr;
+    }
+    segment->mapping = MapSegment(segment->fd, capacity, &segment->base);
+    if (!segment->mapping) {
+        spdlog::error("Failed to map packed tile segment {}", segment->path);
+        return nullptr;
+    }
+
+    segments_[segment->id] = segment;
+    return segment;
+}
+
+void PackedTileStore::SealActiveLocked() {
+    if (!active_) {
+        return;
+    }
+    if (::ftruncate(active_->fd, static_cast<off_t>(active_->write_offset)) != 0) {
+        spdlog::warn("Failed to truncate packed tile segment {}", active_->path);
+    }
+    active_->sealed = true;
+    active_.reset();
+}
+
+bool PackedTileStore::AppendLocked(const TileCoordinates& coords, std::uint16_t flags,
+                                   std::span<const std::uint8_t> metadata_bytes,
+                                   std::span<const std::uint8_t> data,
+                                   Location* location) {
+    const std::size_t size = RecordSize(metadata_bytes.size(), data.size());
+
+    if (!active_ || active_->write_offset + size > active_->capacity) {
+        SealActiveLocked();
+        active_ = CreateSegmentLocked(std::max(config_.segment_size, size));
+        if (!active_) {
+            return false;
+        }
+    }
+
+    RecordHeader header{};
+    header.magic = kRecordMagic;
+    header.version = kRecordVersion;
+    header.flags = flags;
+    header.x = coords.x;
+    header.y = coords.y;
+    header.zoom = coords.zoom;
+    header.metadata_size = static_cast<std::uint32_t>(metadata_bytes.size());
+    header.data_size = static_cast<std::uint32_t>(data.size());
+    header.checksum = Fnv1a(data, Fnv1a(metadata_bytes));
+
+    std::vector<std::uint8_t> prefix(sizeof(RecordHeader) + metadata_bytes.size());
+    std::memcpy(prefix.data(), &header, sizeof(header));
+    std::copy(metadata_bytes.begin(), metadata_bytes.end(), prefix.begin() + sizeof(header));
+
+    const std::size_t offset = active_->write_offset;
+    if (!WriteFully(active_->fd, prefix.data(), prefix.size(), offset) ||
+        !WriteFully(active_->fd, data.data(), data.size(), offset + prefix.size())) {
+        spdlog::error("Failed to append to packed tile segment {}: {}",
+                      active_->path, std::strerror(errno));
+        return false;
+    }
+
+    active_->write_offset += size;
+    if (location) {
+        *location = Location{active_, offset, size, nullptr, 0, 0};
+    }
+    return true;
+}
+
+void PackedTileStore::ReplaceLocked(const TileCoordinates& coords, const Location& location) const {
+    auto it = index_.find(coords);
+    if (it != index_.end()) {
+        it->second.segment->live_bytes -= it->second.size;
+        if (it->second.metadata_segment) {
+            it->second.metadata_segment->live_bytes -= it->second.metadata_size;
+        }
+        if (!location.segment) {
+            index_.erase(it);
+            return;
+        }
+        it->second = location;
+    } else if (location.segment) {
+        index_.emplace(coords, location);
+    } else {
+        return;
+    }
+    location.segment->live_bytes += location.size;
+    if (location.metadata_segment) {
+        location.metadata_segment->live_bytes += location.metadata_size;
+    }
+}
+
+bool PackedTileStore::SetMetadataLocked(const TileCoordinates& coords, const Location& record) const {
+    auto it = index_.find(coords);
+    if (it == index_.end()) {
+        return false;  // Removed or evicted since; the record is dead
+    }
+    Location& location = it->second;
+    if (location.metadata_segment) {
+        location.metadata_segment->live_bytes -= location.metadata_size;
+    }
+    location.metadata_segment = record.segment;
+    location.metadata_offset = record.offset;
+    location.metadata_size = record.size;
+    record.segment->live_bytes += record.size;
+    return true;
+}
+
+std::span<const std::uint8_t> PackedTileStore::MetadataBytes(const Location& location) {
+    const bool separate = location.metadata_segment != nullptr;
+    const Segment& segment = separate ? *location.metadata_segment : *location.segment;
+    const std::size_t offset = separate ? location.metadata_offset : location.offset;
+    RecordHeader header;
+    std::memcpy(&header, segment.HeaderAt(offset), sizeof(header));
+    return {segment.base + offset + sizeof(RecordHeader), header.metadata_size};
+}
+
+bool PackedTileStore::Put(const TileMetadata& metadata, std::span<const std::uint8_t> data) {
+    const std::vector<std::uint8_t> metadata_bytes = SerializeMetadata(metadata);
+
+    WriterGuard guard(*this);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!open_) {
+        return false;
+    }
+    CatchUpLocked();
+
+    Location location;
+    if (!AppendLocked(metadata.coordinates, 0, metadata_bytes, data, &location)) {
+        return false;
+    }
+    ReplaceLocked(metadata.coordinates, location);
+    PublishLocked();
+    return true;
+}
+
+std::size_t PackedTileStore::PutBatch(const std::vector<std::shared_ptr<const TileData>>& tiles) {
+    // Serialize outside the lock
+    std::vector<std::vector<std::uint8_t>> metadata_bytes;
+    metadata_bytes.reserve(tiles.size());
+    for (const auto& tile : tiles) {
+        metadata_bytes.push_back(SerializeMetadata(tile->metadata));
+    }
+
+    WriterGuard guard(*this);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!open_) {
+        return 0;
+    }
+    CatchUpLocked();
+
+    std::size_t written = 0;
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        const TileCoordinates& coords = tiles[i]->metadata.coordinates;
+        Location location;
+        if (AppendLocked(coords, 0, metadata_bytes[i], tiles[i]->data, &location)) {
+            ReplaceLocked(coords, location);
+            ++written;
+        }
+    }
+    PublishLocked();
+    return written;
+}
+
+std::optional<PackedTileView> PackedTileStore::Get(const TileCoordinates& coords) const {
+    CatchUp();
+
+    Location location;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = index_.find(coords);
+        if (it == index_.end()) {
+            return std::nullopt;
+        }
+        location = it->second;
+    }
+
+    // Record bytes are immutable once indexed: decode without the lock
+    const Segment& segment = *location.segment;
+    RecordHeader header;
+    std::memcpy(&header, segment.HeaderAt(location.offset), sizeof(header));
+    const std::uint8_t* body = segment.base + location.offset + sizeof(RecordHeader);
+
+    TileMetadata metadata;
+    if (!DeserializeMetadata(MetadataBytes(location), coords, metadata)) {
+        spdlog::warn("Corrupt metadata in packed tile store for {}/{}/{}",
+                     coords.x, coords.y, coords.zoom);
+        return std::nullopt;
+    }
+
+    return PackedTileView(segment.mapping,
+                          {body + header.metadata_size, header.data_size},
+                          std::move(metadata));
+}
+
+std::optional<TileMetadata> PackedTileStore::GetMetadata(const TileCoordinates& coords) const {
+    auto view = Get(coords);
+    if (!view) {
+        return std::nullopt;
+    }
+    return view->Metadata();
+}
+
+bool PackedTileStore::UpdateMetadata(const TileMetadata& metadata) {
+    const TileCoordinates& coords = metadata.coordinates;
+
+    // Lookup and append under one writer lock, so no write lands in between
+    WriterGuard guard(*this);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!open_) {
+        return false;
+    }
+    CatchUpLocked();
+    auto it = index_.find(coords);
+    if (it == index_.end()) {
+        return false;
+    }
+
+    // The payload stays as stored, so its encoding must not change
+    TileMetadata current;
+    if (!DeserializeMetadata(MetadataBytes(it->second), coords, current)) {
+        return false;
+    }
+    TileMetadata updated = metadata;
+    updated.compression = current.compression;
+
+    Location record;
+    if (!AppendLocked(coords, kFlagMetadataOnly, SerializeMetadata(updated), {}, &record)) {
+        return false;
+    }
+    SetMetadataLocked(coords, record);
+    PublishLocked();
+    return true;
+}
+
+bool PackedTileStore::Contains(const TileCoordinates& coords) const {
+    CatchUp();
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return index_.find(coords) != index_.end();
+}
+
+bool PackedTileStore::Remove(const TileCoordinates& coords) {
+    WriterGuard guard(*this);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!open_) {
+        return false;
+    }
+    CatchUpLocked();
+    if (index_.find(coords) == index_.end()) {
+        return false;
+    }
+    if (!AppendLocked(coords, kFlagTombstone, {}, {}, nullptr)) {
+        return false;
+    }
+    ReplaceLocked(coords, Location{});
+    PublishLocked();
+    return true;
+}
+
+void PackedTileStore::Clear() {
+    WriterGuard guard(*this);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    std::error_code error;
+    for (const auto& [id, segment] : segments_) {
+        std::filesystem::remove(segment->path, error);
+    }
+    if (shared_) {
+        // Including segments of other processes not replayed here yet
+        for (std::uint32_t id : ListSegmentIds()) {
+            std::filesystem::remove(SegmentPath(id), error);
+        }
+        shared_->head.store(0, std::memory_order_release);
+        seen_generation_ = shared_->generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+        replayed_head_ = 0;
+    }
+    index_.clear();
+    segments_.clear();
+    active_.reset();
+}
+
+std::vector<TileCoordinates> PackedTileStore::GetKeys() const {
+    CatchUp();
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    std::vector<TileCoordinates> keys;
+    keys.reserve(index_.size());
+    for (const auto& [coords, location] : index_) {
+        keys.push_back(coords);
+    }
+    return keys;
+}
+
+bool PackedTileStore::HasOlderSegmentLocked(std::uint32_t id) const {
+    return !segments_.empty() && segments_.begin()->first < id;
+}
+
+std::size_t PackedTileStore::DiskUsageLocked() const {
+    std::size_t usage = 0;
+    for (const auto& [id, segment] : segments_) {
+        usage += segment->write_offset;
+    }
+    return usage;
+}
+
+std::size_t PackedTileStore::EvictToFit(std::size_t max_bytes) {
+    // No compaction pass moves records meanwhile
+    std::lock_guard<std::mutex> compaction_lock(compaction_mutex_);
+    WriterGuard guard(*this);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (!open_) {
+        return 0;
+    }
+    CatchUpLocked();
+
+    std::size_t evicted = 0;
+    while (DiskUsageLocked() > max_bytes) {
+        if (segments_.empty() || segments_.begin()->second == active_) {
+            break;  // Only the active segment is left
+        }
+        const std::shared_ptr<Segment> segment = segments_.begin()->second;
+
+        // Metadata-only records always follow their tile's record, so the
+        // oldest segment holds no metadata of tiles stored elsewhere
+        std::vector<TileCoordinates> victims;
+        for (const auto& [coords, location] : index_) {
+            if (location.segment == segment) {
+                victims.push_back(coords);
+            }
+        }
+        for (const TileCoordinates& coords : victims) {
+            if (!AppendLocked(coords, kFlagTombstone, {}, {}, nullptr)) {
+                PublishLocked();
+                return evicted;
+            }
+            ReplaceLocked(coords, Location{});
+            ++evicted;
+        }
+
+        segments_.erase(segment->id);
+        std::error_code error;
+        std::filesystem::remove(segment->path, error);
+    }
+    PublishLocked();
+
+    if (evicted > 0) {
+        spdlog::debug("Packed tile store evicted {} tiles to fit {} bytes", evicted, max_bytes);
+    }
+    return evicted;
+}
+
+std::size_t PackedTileStore::Compact() {
+    std::lock_guard<std::mutex> compaction_lock(compaction_mutex_);
+    CatchUp();
+
+    std::vector<std::shared_ptr<Segment>> candidates;
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        for (const auto& [id, segment] : segments_) {
+            if (!segment->sealed || segment.get() == active_.get()) {
+                continue;
+            }
+            const std::size_t used = segment->write_offset;
+            const std::size_t dead = used - segment->live_bytes;
+            if (used == 0 ||
+                static_cast<double>(dead) >= config_.compaction_threshold * static_cast<double>(used)) {
+                candidates.push_back(segment);
+            }
+        }
+    }
+
+    std::size_t reclaimed = 0;
+    for (const auto& segment : candidates) {
+        if (CompactSegment(segment)) {
+            ++reclaimed;
+        }
+    }
+
+    if (reclaimed > 0) {
+        compacted_segments_.fetch_add(reclaimed, std::memory_order_relaxed);
+        spdlog::debug("Packed tile store compacted {} segments", reclaimed);
+    }
+    return reclaimed;
+}
+
+bool PackedTileStore::CompactSegment(const std::shared_ptr<Segment>& segment) {
+    // Shared: the whole segment moves under one flock, so no other process compacts it too
+    WriterGuard guard(*this);
+    if (shared_) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        CatchUpLocked();
+        if (segments_.find(segment->id) == segments_.end()) {
+            return false;  // Cleared meanwhile
+        }
+        if (!std::filesystem::exists(segment->path)) {
+            segments_.erase(segment->id);  // Another process compacted it
+            return false;
+        }
+    }
+
+    // Sealed segments never change, so the scan itself needs no lock
+    std::size_t offset = 0;
+    while (offset < segment->write_offset) {
+        RecordHeader header;
+        std::memcpy(&header, segment->HeaderAt(offset), sizeof(header));
+        const std::size_t size = RecordSize(header.metadata_size, header.data_size);
+        const TileCoordinates coords(header.x, header.y, header.zoom);
+        const std::uint8_t* body = segment->base + offset + sizeof(RecordHeader);
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        if (!open_) {
+            return false;
+        }
+
+        auto it = index_.find(coords);
+        if (header.flags & kFlagTombstone) {
+            // Keep the tombstone while an older segment may hold the tile
+            if (it == index_.end() && HasOlderSegmentLocked(segment->id) &&
+                !AppendLocked(coords, kFlagTombstone, {}, {}, nullptr)) {
+                return false;
+            }
+        } else if (header.flags & kFlagMetadataOnly) {
+            if (it != index_.end() && it->second.metadata_segment == segment &&
+                it->second.metadata_offset == offset) {
+                Location record;
+                if (!AppendLocked(coords, kFlagMetadataOnly, {body, header.metadata_size}, {},
+                                  &record)) {
+                    return false;
+                }
+                SetMetadataLocked(coords, record);
+            }
+        } else if (it != index_.end() && it->second.segment == segment &&
+                   it->second.offset == offset) {
+            // A newer metadata-only record is folded into the moved record
+            Location location;
+            if (!AppendLocked(coords, 0, MetadataBytes(it->second),
+                              {body + header.metadata_size, header.data_size}, &location)) {
+                return false;
+            }
+            ReplaceLocked(coords, location);
+        }
+        offset += size;
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    PublishLocked();
+    segments_.erase(segment->id);
+    std::error_code error;
+    std::filesystem::remove(segment->path, error);
+    return true;
+}
+
+void PackedTileStore::CompactionLoop() {
+    std::unique_lock<std::mutex> stop_lock(stop_mutex_);
+    while (!stop_) {
+        if (stop_cv_.wait_for(stop_lock, config_.compaction_interval, [this] { return stop_; })) {
+            break;
+        }
+        stop_lock.unlock();
+        Compact();
+        stop_lock.lock();
+    }
+}
+
+PackedTileStoreStats PackedTileStore::GetStats() const {
+    CatchUp();
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    PackedTileStoreStats stats;
+    stats.tile_count = index_.size();
+    stats.segment_count = segments_.size();
+    for (const auto& [id, segment] : segments_) {
+        stats.live_bytes += segment->live_bytes;
+        stats.dead_bytes += segment->write_offset - segment->live_bytes;
+    }
+    stats.compacted_segments = compacted_segments_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::size_t PackedTileStore::GetDiskUsage() const {
+    CatchUp();
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return DiskUsageLocked();
+}
+
+} // namespace earth_map
@@ -0,0 +1,458 @@
+/**
+ * @file pmtiles_archive.cpp
+ * @brief Implementation of the memory-mapped PMTiles v3 reader
+ */
+
+#include <earth_map/data/pmtiles_archive.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef EARTH_MAP_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace earth_map {
+
+namespace {
+
+constexpr char kMagic[] = "PMTiles";
+constexpr std::uint8_t kVersion = 3;
+
+/// Leaf directories visited by the lookup before giving up (spec maximum)
+constexpr int kMaxDirectoryDepth = 4;
+
+/// Decoded leaf directories kept before the cache is reset
+constexpr std::size_t kMaxCachedLeaves = 4096;
+
+/// Gap below which neighbouring tiles are prefetched as one range
+constexpr std::uint64_t kPrefetchMergeGap = 64 * 1024;
+
+template <typename T>
+T ReadLE(const std::uint8_t* bytes) {
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+/// Bounds-checked LEB128 varint reader
+class VarintReader {
+public:
+    explicit VarintReader(std::span<const std::uint8_t> bytes) : bytes_(bytes) {}
+
+    bool Read(std::uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (offset_ >= bytes_.size()) {
+                return false;
+            }
+            const std::uint8_t byte = bytes_[offset_++];
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    std::size_t Remaining() const { return bytes_.size() - offset_; }
+
+private:
+    std::span<const std::uint8_t> bytes_;
+    std::size_t offset_ = 0;
+};
+
+void Rotate(std::int64_t n, std::int64_t& x, std::int64_t& y, std::int64_t rx, std::int64_t ry) {
+    if (ry == 0) {
+        if (rx == 1) {
+            x = n - 1 - x;
+            y = n - 1 - y;
+        }
+        std::swap(x, y);
+    }
+}
+
+} // namespace
+
+PMTilesArchive::PMTilesArchive(const std::string& path)
+    : path_(path) {}
+
+PMTilesArchive::~PMTilesArchive() {
+    if (data_) {
+        ::munmap(const_cast<std::uint8_t*>(data_), size_);
+    }
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+bool PMTilesArchive::Open() {
+    fd_ = ::open(path_.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        spdlog::error("Failed to open PMTiles archive {}: {}", path_, std::strerror(errno));
+        return false;
+    }
+
+    struct stat file_stat {};
+    if (::fstat(fd_, &file_stat) != 0 ||
+        static_cast<std::size_t>(file_stat.st_size) < kHeaderSize) {
+        spdlog::error("PMTiles archive {} is too small", path_);
+        return false;
+    }
+    size_ = static_cast<std::size_t>(file_stat.st_size);
+
+    void* address = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+    if (address == MAP_FAILED) {
+        spdlog::error("Failed to map PMTiles archive {}: {}", path_, std::strerror(errno));
+        return false;
+    }
+    data_ = static_cast<const std::uint8_t*>(address);
+
+    if (!ParseHeader()) {
+        return false;
+    }
+
+    root_ = LoadDirectory(header_.root_dir_offset, header_.root_dir_length);
+    if (!root_) {
+        spdlog::error("PMTiles archive {} has an unreadable root directory", path_);
+        return false;
+    }
+
+    spdlog::info("Opened PMTiles archive {}: zoom {}-{}, {} tiles, {}clustered",
+                 path_, header_.min_zoom, header_.max_zoom, header_.addressed_tiles,
+                 header_.clustered ? "" : "not ");
+    return true;
+}
+
+bool PMTilesArchive::ParseHeader() {
+    if (std::memcmp(data_, kMagic, 7) != 0 || data_[7] != kVersion) {
+        spdlog::error("{} is not a PMTiles v3 archive", path_);
+        return false;
+    }
+
+    header_.root_dir_offset = ReadLE<std::uint64_t>(data_ + 8);
+    header_.root_dir_length = ReadLE<std::uint64_t>(data_ + 16);
+    header_.metadata_offset = ReadLE<std::uint64_t>(data_ + 24);
+    header_.metadata_length = ReadLE<std::uint64_t>(data_ + 32);
+    header_.leaf_dirs_offset = ReadLE<std::uint64_t>(data_ + 40);
+    header_.leaf_dirs_length = ReadLE<std::uint64_t>(data_ + 48);
+    header_.tile_data_offset = ReadLE<std::uint64_t>(data_ + 56);
+    header_.tile_data_length = ReadLE<std::uint64_t>(data_ + 64);
+    header_.addressed_tiles = ReadLE<std::uint64_t>(data_ + 72);
+    header_.clustered = data_[96] == 1;
+    header_.internal_compression = static_cast<PMTilesHeader::Compression>(data_[97]);
+    header_.tile_compression = static_cast<PMTilesHeader::Compression>(data_[98]);
+    header_.tile_type = static_cast<PMTilesHeader::TileType>(data_[99]);
+    header_.min_zoom = data_[100];
+    header_.max_zoom = data_[101];
+
+    if (header_.tile_data_offset > size_ ||
+        header_.tile_data_length > size_ - header_.tile_data_offset) {
+        spdlog::error("PMTiles archive {} is truncated", path_);
+        return false;
+    }
+    return true;
+}
+
+std::optional<std::vector<std::uint8_t>> PMTilesArchive::Decompress(
+    std::span<const std::uint8_t> bytes, PMTilesHeader::Compression type) const {
+    switch (type) {
+        case PMTilesHeader::Compression::NONE:
+            return std::vector<std::uint8_t>(bytes.begin(), bytes.end());
+#ifdef EARTH_MAP_HAVE_ZLIB
+        case PMTilesHeader::Compression::GZIP: {
+            z_stream stream{};
+            if (inflateInit2(&stream, 16 + MAX_WBITS) != Z_OK) {
+                return std::nullopt;
+            }
+            std::vector<std::uint8_t> out(std::max<std::size_t>(bytes.size() * 4, 1024));
+            stream.next_in = const_cast<Bytef*>(bytes.data());
+            stream.avail_in = static_cast<uInt>(bytes.size());
+            int status = Z_OK;
+            while (status == Z_OK) {
+                if (stream.total_out == out.size()) {
+                    out.resize(out.size() * 2);
+                }
+                stream.next_out = out.data() + stream.total_out;
+                stream.avail_out = static_cast<uInt>(out.size() - stream.total_out);
+                status = inflate(&stream, Z_NO_FLUSH);
+            }
+            out.resize(stream.total_out);
+            inflateEnd(&stream);
+            if (status != Z_STREAM_END) {
+                return std::nullopt;
+            }
+            return out;
+        }
+#endif
+        default:
+            spdlog::error("PMTiles archive {}: unsupported compression {}",
+                          path_, static_cast<int>(type));
+            return std::nullopt;
+    }
+}
+
+std::optional<std::vector<std::uint8_t>> PMTilesArchive::DecompressTile(
+    std::span<const std::uint8_t> bytes) const {
+    return Decompress(bytes, header_.tile_compression);
+}
+
+std::shared_ptr<const PMTilesArchive::Directory> PMTilesArchive::LoadDirectory(
+    std::uint64_t offset, std::uint64_t length) const {
+    if (offset > size_ || length > size_ - offset) {
+        return nullptr;
+    }
+
+    std::span<const std::uint8_t> raw(data_ + offset, length);
+    std::vector<std::uint8_t> decompressed;
+    if (header_.internal_compression != PMTilesHeader::Compression::NONE) {
+        auto bytes = Decompress(raw, header_.internal_compression);
+        if (!bytes) {
+            return nullptr;
+        }
+        decompressed = std::move(*bytes);
+        raw = decompressed;
+    }
+
+    VarintReader reader(raw);
+    std::uint64_t count = 0;
+    // Every entry takes at least four bytes
+    if (!reader.Read(count) || count > reader.Remaining() / 4) {
+        return nullptr;
+    }
+
+    auto directory = std::make_shared<Directory>(count);
+    std::uint64_t value = 0;
+    std::uint64_t last_id = 0;
+    for (auto& entry : *directory) {
+        if (!reader.Read(value)) {
+            return nullptr;
+        }
+        last_id += value;
+        entry.tile_id = last_id;
+    }
+    for (auto& entry : *directory) {
+        if (!reader.Read(value)) {
+            return nullptr;
+        }
+        entry.run_length = static_cast<std::uint32_t>(value);
+    }
+    for (auto& entry : *directory) {
+        if (!reader.Read(value)) {
+            return nullptr;
+        }
+        entry.length = static_cast<std::uint32_t>(value);
+    }
+    for (std::size_t i = 0; i < directory->size(); ++i) {
+        if (!reader.Read(value)) {
+            return nullptr;
+        }
+        auto& entry = (*directory)[i];
+        if (value == 0 && i > 0) {
+            // Contiguous with the previous entry
+            entry.offset = (*directory)[i - 1].offset + (*directory)[i - 1].length;
+        } else {
+            entry.offset = value - 1;
+        }
+    }
+    return directory;
+}
+
+std::optional<PMTilesArchive::TileRange> PMTilesArchive::FindTile(std::uint64_t tile_id) const {
+    std::shared_ptr<const Directory> directory = root_;
+
+    for (int depth = 0; depth < kMaxDirectoryDepth && directory; ++depth) {
+        // Last entry whose tile id is not above the target
+        auto it = std::upper_bound(directory->begin(), directory->end(), tile_id,
+            [](std::uint64_t id, const DirectoryEntry& entry) { return id < entry.tile_id; });
+        if (it == directory->begin()) {
+            return std::nullopt;
+        }
+        const DirectoryEntry& entry = *std::prev(it);
+
+        if (entry.run_length > 0) {
+            if (tile_id - entry.tile_id >= entry.run_length) {
+                return std::nullopt;
+            }
+            return TileRange{header_.tile_data_offset + entry.offset, entry.length};
+        }
+
+        // Leaf directory
+        const std::uint64_t leaf_offset = header_.leaf_dirs_offset + entry.offset;
+        {
+            std::lock_guard<std::mutex> lock(leaf_mutex_);
+            auto cached = leaves_.find(leaf_offset);
+            if (cached != leaves_.end()) {
+                directory = cached->second;
+                continue;
+            }
+        }
+        directory = LoadDirectory(leaf_offset, entry.length);
+        if (directory) {
+            std::lock_guard<std::mutex> lock(leaf_mutex_);
+            if (leaves_.size() >= kMaxCachedLeaves) {
+                leaves_.clear();
+            }
+            leaves_.emplace(leaf_offset, directory);
+        }
+    }
+    return std::nullopt;
+}
+
+std::optional<std::span<const std::uint8_t>> PMTilesArchive::GetTile(
+    const TileCoordinates& coords) const {
+    if (!data_ || !coords.IsValid() ||
+        coords.zoom < header_.min_zoom || coords.zoom > header_.max_zoom) {
+        return std::nullopt;
+    }
+
+    auto range = FindTile(TileId(coords));
+    if (!range || range->offset > size_ || range->length > size_ - range->offset) {
+        return std::nullopt;
+    }
+    return std::span<const std::uint8_t>(data_ + range->offset, range->length);
+}
+
+bool PMTilesArchive::Contains(const TileCoordinates& coords) const {
+    return GetTile(coords).has_value();
+}
+
+std::size_t PMTilesArchive::Prefetch(const std::vector<TileCoordinates>& coords) const {
+    std::vector<TileRange> ranges;
+    ranges.reserve(coords.size());
+    for (const auto& tile : coords) {
+        if (auto bytes = GetTile(tile)) {
+            ranges.push_back({static_cast<std::uint64_t>(bytes->data() - data_), bytes->size()});
+        }
+    }
+    if (ranges.empty()) {
+        return 0;
+    }
+
+    std::sort(ranges.begin(), ranges.end(),
+              [](const TileRange& a, const TileRange& b) { return a.offset < b.offset; });
+
+    // Merge neighbours: clustered archives collapse into a few long reads
+    std::vector<TileRange> merged{ranges.front()};
+    for (std::size_t i = 1; i < ranges.size(); ++i) {
+        TileRange& last = merged.back();
+        const std::uint64_t last_end = last.offset + last.length;
+        if (ranges[i].offset <= last_end + kPrefetchMergeGap) {
+            last.length = std::max(last_end, ranges[i].offset + ranges[i].length) - last.offset;
+        } else {
+            merged.push_back(ranges[i]);
+        }
+    }
+
+    const std::uint64_t page = static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+    for (const auto& range : merged) {
+        const std::uint64_t start = range.offset & ~(page - 1);
+        ::madvise(const_cast<std::uint8_t*>(data_) + start,
+                  range.offset + range.length - start, MADV_WILLNEED);
+    }
+    return merged.size();
+}
+
+std::string PMTilesArchive::GetMetadataJson() const {
+    if (!data_ || header_.metadata_offset > size_ ||
+        header_.metadata_length > size_ - header_.metadata_offset) {
+        return "";
+    }
+    auto bytes = Decompress({data_ + header_.metadata_offset, header_.metadata_length},
+                            header_.internal_compression);
+    return bytes ? std::string(bytes->begin(), bytes->end()) : "";
+}
+
+std::uint64_t PMTilesArchive::TileId(const TileCoordinates& coords) {
+    const int zoom = coords.zoom;
+    const std::uint64_t base = ((std::uint64_t{1} << (2 * zoom)) - 1) / 3;
+
+    // Hilbert curve index of (x, y) in a 2^zoom grid
+    const std::int64_t n = std::int64_t{1} << zoom;
+    std::int64_t x = coords.x;
+    std::int64_t y = coords.y;
+    std::uint64_t d = 0;
+    for (std::int64_t s = n / 2; s > 0; s /= 2) {
+        const std::int64_t rx = (x & s) > 0 ? 1 : 0;
+        const std::int64_t ry = (y & s) > 0 ? 1 : 0;
+        d += static_cast<std::uint64_t>(s) * static_cast<std::uint64_t>(s) *
+             static_cast<std::uint64_t>((3 * rx) ^ ry);
+        Rotate(n, x, y, rx, ry);
+    }
+    return base + d;
+}
+
+PMTilesTileProvider::PMTilesTileProvider(const std::string& name,
+                                         std::shared_ptr<PMTilesArchive> archive)
+    : name_(name)
+    , archive_(std::move(archive)) {
+    if (!archive_) {
+        throw std::invalid_argument("PMTilesTileProvider: archive must not be null");
+    }
+}
+
+std::string PMTilesTileProvider::BuildTileURL(const TileCoordinates& coords) const {
+    return "pmtiles://" + archive_->GetPath() + "/" + std::to_string(coords.zoom) + "/" +
+           std::to_string(coords.x) + "/" + std::to_string(coords.y);
+}
+
+std::int32_t PMTilesTileProvider::GetMinZoom() const {
+    return archive_->GetHeader().min_zoom;
+}
+
+std::int32_t PMTilesTileProvider::GetMaxZoom() const {
+    return archive_->GetHeader().max_zoom;
+}
+
+std::string PMTilesTileProvider::GetFormat() const {
+    switch (archive_->GetHeader().tile_type) {
+        case PMTilesHeader::TileType::MVT:  return "mvt";
+        case PMTilesHeader::TileType::JPEG: return "jpeg";
+        case PMTilesHeader::TileType::WEBP: return "webp";
+        case PMTilesHeader::TileType::AVIF: return "avif";
+        case PMTilesHeader::TileType::PNG:
+        case PMTilesHeader::TileType::UNKNOWN:
+        default:
+            return "png";
+    }
+}
+
+std::optional<TileBuffer> PMTilesTileProvider::ReadTile(const TileCoordinates& coords) const {
+    auto bytes = archive_->GetTile(coords);
+    if (!bytes) {
+        return std::nullopt;
+    }
+    switch (archive_->GetHeader().tile_compression) {
+        case PMTilesHeader::Compression::NONE:
+        case PMTilesHeader::Compression::UNKNOWN:
+            // Zero-copy: the buffer keeps the archive (and its mapping) alive
+            return TileBuffer::Wrap(archive_, *bytes);
+        default: {
+            auto decompressed = archive_->DecompressTile(*bytes);
+            if (!decompressed) {
+                return std::nullopt;
+            }
+            return TileBuffer(std::move(*decompressed));
+        }
+    }
+}
+
+std::shared_ptr<PMTilesTileProvider> CreatePMTilesTileProvider(const std::string& path,
+                                                               const std::string& name) {
+    auto archive = std::make_shared<PMTilesArchive>(path);
+    if (!archive->Open()) {
+        return nullptr;
+    }
+    const std::string provider_name =
+        name.empty() ? std::filesystem::path(path).stem().string() : name;
+    return std::make_shared<PMTilesTileProvider>(provider_name, std::move(archive));
+}
+
+} // namespace earth_map
@@ -0,0 +1,224 @@
+/**
+ * @file request_scheduler.cpp
+ * @brief Per-host limits and weighted fair queuing implementation
+ */
+
+#include <earth_map/data/request_scheduler.h>
+#include <earth_map/data/retry_policy.h>
+#include <algorithm>
+
+namespace earth_map {
+
+namespace {
+
+/// Virtual time a weight-1 flow advances per request
+constexpr double kStride = 1.0;
+
+} // namespace
+
+RequestScheduler::RequestScheduler(const RequestSchedulerConfig& config)
+    : config_(config) {}
+
+void RequestScheduler::SetConfig(const RequestSchedulerConfig& config) {
+    config_ = config;
+}
+
+void RequestScheduler::Push(HttpRequestId id, HttpRequest request) {
+    const std::string host = HostCircuitBreaker::HostFromUrl(request.url);
+    Flow& flow = flows_[request.flow];
+    flow.weight = std::max<std::uint32_t>(request.flow_weight, 1);
+    if (flow.queued == 0) {
+        // An idle flow rejoins at the current virtual time: no credit for idling
+        flow.pass = std::max(flow.pass, virtual_time_);
+    }
+
+    flow.hosts[host].push_back(QueuedRequest{id, next_sequence_++, std::move(request)});
+    flow.queued++;
+    queued_count_++;
+}
+
+std::optional<RequestScheduler::Entry> RequestScheduler::PopNext(Clock::time_point now) {
+    Flow* best_flow = nullptr;
+    std::deque<QueuedRequest>* best_queue = nullptr;
+    const std::string* best_host = nullptr;
+
+    for (auto& [name, flow] : flows_) {
+        if (flow.queued == 0 || (best_flow && flow.pass > best_flow->pass)) {
+            continue;
+        }
+
+        // Oldest request of the flow among hosts that may start one now
+        std::deque<QueuedRequest>* queue = nullptr;
+        const std::string* queue_host = nullptr;
+        for (auto& [host, requests] : flow.hosts) {
+            if (requests.empty() || !IsEligible(host, now)) {
+                continue;
+            }
+            if (!queue || requests.front().sequence < queue->front().sequence) {
+                queue = &requests;
+                queue_host = &host;
+            }
+        }
+        if (!queue) {
+            continue;
+        }
+
+        const bool better = !best_flow || flow.pass < best_flow->pass ||
+                            queue->front().sequence < best_queue->front().sequence;
+        if (better) {
+            best_flow = &flow;
+            best_queue = queue;
+            best_host = queue_host;
+        }
+    }
+
+    if (!best_flow) {
+        return std::nullopt;
+    }
+
+    Entry entry;
+    entry.id = best_queue->front().id;
+    entry.host = *best_host;
+    entry.request = std::move(best_queue->front().request);
+    best_queue->pop_front();
+    best_flow->queued--;
+    queued_count_--;
+
+    virtual_time_ = best_flow->pass;
+    best_flow->pass += kStride / best_flow->weight;
+
+    if (!entry.host.empty()) {
+        HostState& state = GetHost(entry.host, now);
+        state.active++;
+        if (config_.requests_per_second > 0.0) {
+            state.tokens -= 1.0;
+        }
+    }
+    return entry;
+}
+
+void RequestScheduler::Release(const std::string& host) {
+    auto it = host_states_.find(host);
+    if (it != host_states_.end() && it->second.active > 0) {
+        it->second.active--;
+    }
+}
+
+void RequestScheduler::ThrottleHost(const std::string& host, Clock::time_point until) {
+    if (host.empty()) {
+        return;
+    }
+    HostState& state = GetHost(host, Clock::now());
+    state.blocked_until = std::max(state.blocked_until, until);
+}
+
+bool RequestScheduler::Remove(HttpRequestId id) {
+    for (auto& [name, flow] : flows_) {
+        for (auto& [host, requests] : flow.hosts) {
+            auto it = std::find_if(requests.begin(), requests.end(),
+                [id](const QueuedRequest& queued) { return queued.id == id; });
+            if (it != requests.end()) {
+                requests.erase(it);
+                flow.queued--;
+                queued_count_--;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+std::vector<HttpRequest> RequestScheduler::Clear() {
+    std::vector<HttpRequest> removed;
+    removed.reserve(queued_count_);
+    for (auto& [name, flow] : flows_) {
+        for (auto& [host, requests] : flow.hosts) {
+            for (auto& queued : requests) {
+                removed.push_back(std::move(queued.request));
+            }
+            requests.clear();
+        }
+        flow.queued = 0;
+    }
+    queued_count_ = 0;
+    return removed;
+}
+
+std::size_t RequestScheduler::GetActiveCount(const std::string& host) const {
+    auto it = host_states_.find(host);
+    return it != host_states_.end() ? it->second.active : 0;
+}
+
+std::optional<RequestScheduler::Clock::time_point> RequestScheduler::GetNextEligibleTime(
+    Clock::time_point now) {
+    std::optional<Clock::time_point> next;
+    const double rate = config_.requests_per_second;
+
+    for (auto& [name, flow] : flows_) {
+        for (auto& [host, requests] : flow.hosts) {
+            if (requests.empty()) {
+                continue;
+            }
+            if (host.empty()) {
+                return now;
+            }
+
+            HostState& state = GetHost(host, now);
+            if (config_.max_requests_per_host > 0 &&
+                state.active >= config_.max_requests_per_host) {
+                continue;
+            }
+
+            Clock::time_point eligible = std::max(now, state.blocked_until);
+            if (rate > 0.0 && state.tokens < 1.0) {
+                const auto wait = std::chrono::duration<double>((1.0 - state.tokens) / rate);
+                eligible = std::max(eligible,
+                    now + std::chrono::duration_cast<Clock::duration>(wait));
+            }
+            if (!next || eligible < *next) {
+                next = eligible;
+            }
+        }
+    }
+    return next;
+}
+
+RequestScheduler::HostState& RequestScheduler::GetHost(const std::string& host,
+                                                       Clock::time_point now) {
+    auto [it, inserted] = host_states_.try_emplace(host);
+    if (inserted) {
+        it->second.tokens = static_cast<double>(std::max<std::size_t>(config_.burst, 1));
+        it->second.last_refill = now;
+    } else {
+        Refill(it->second, now);
+    }
+    return it->second;
+}
+
+void RequestScheduler::Refill(HostState& state, Clock::time_point now) const {
+    const double capacity = static_cast<double>(std::max<std::size_t>(config_.burst, 1));
+    if (config_.requests_per_second <= 0.0) {
+        state.tokens = capacity;
+    } else if (now > state.last_refill) {
+        const double elapsed = std::chrono::duration<double>(now - state.last_refill).count();
+        state.tokens = std::min(capacity, state.tokens + elapsed * config_.requests_per_second);
+    }
+    state.last_refill = std::max(state.last_refill, now);
+}
+
+bool RequestScheduler::IsEligible(const std::string& host, Clock::time_point now) {
+    if (host.empty()) {
+        return true;
+    }
+
+    const HostState& state = GetHost(host, now);
+    if (config_.max_requests_per_host > 0 && state.active >= config_.max_requests_per_host) {
+        return false;
+    }
+    if (now < state.blocked_until) {
+        return false;
+    }
+    return config_.requests_per_second <= 0.0 || state.tokens >= 1.0;
+}
+
+} // namespace earth_map
@@ -0,0 +1,148 @@
+/**
+ * @file retry_policy.cpp
+ * @brief Retry backoff and per-host circuit breaker implementation
+ */
+
+#include <earth_map/data/retry_policy.h>
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+namespace earth_map {
+
+std::chrono::milliseconds RetryBackoff::GetDelay(std::uint32_t attempt, double random) const {
+    const double base = static_cast<double>(std::max<std::int64_t>(base_delay.count(), 0));
+    const double cap = static_cast<double>(std::max<std::int64_t>(max_delay.count(), 0));
+
+    // 2^attempt overflows to inf for huge attempts, which the cap absorbs
+    const double delay = std::min(base * std::pow(2.0, static_cast<double>(attempt)), cap);
+    const double spread = std::clamp(static_cast<double>(jitter), 0.0, 1.0);
+    const double jittered = delay * (1.0 - spread * std::clamp(random, 0.0, 1.0));
+
+    return std::chrono::milliseconds(static_cast<std::int64_t>(jittered));
+}
+
+HostCircuitBreaker::HostCircuitBreaker(const CircuitBreakerConfig& config)
+    : config_(config) {}
+
+bool HostCircuitBreaker::AllowRequest(const std::string& host, Clock::time_point now) {
+    if (host.empty()) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = hosts_.find(host);
+    if (it == hosts_.end()) {
+        return true;
+    }
+
+    HostState& state = it->second;
+    switch (state.state) {
+        case State::CLOSED:
+            return true;
+        case State::OPEN:
+            if (now < state.open_until) {
+                return false;
+            }
+            state.state = State::HALF_OPEN;
+            state.probe_in_flight = true;
+            return true;
+        case State::HALF_OPEN:
+            if (state.probe_in_flight) {
+                return false;
+            }
+            state.probe_in_flight = true;
+            return true;
+    }
+    return true;
+}
+
+void HostCircuitBreaker::RecordSuccess(const std::string& host) {
+    if (host.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Healthy hosts carry no state
+    hosts_.erase(host);
+}
+
+void HostCircuitBreaker::RecordFailure(const std::string& host, Clock::time_point now) {
+    if (host.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (config_.failure_threshold == 0) {
+        return;
+    }
+    HostState& state = hosts_[host];
+    state.consecutive_failures++;
+
+    // A failed probe reopens at once; a closed circuit opens at the threshold
+    if (state.state == State::HALF_OPEN ||
+        (state.state == State::CLOSED &&
+         state.consecutive_failures >= config_.failure_threshold)) {
+        state.state = State::OPEN;
+        state.open_until = now + config_.cooldown;
+        state.probe_in_flight = false;
+    }
+}
+
+void HostCircuitBreaker::RecordAbandoned(const std::string& host) {
+    if (host.empty()) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = hosts_.find(host);
+    if (it != hosts_.end() && it->second.state == State::HALF_OPEN) {
+        it->second.probe_in_flight = false;
+    }
+}
+
+HostCircuitBreaker::State HostCircuitBreaker::GetState(const std::string& host,
+                                                       Clock::time_point now) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = hosts_.find(host);
+    if (it == hosts_.end()) {
+        return State::CLOSED;
+    }
+    // An expired cooldown is reported as the probe state it will turn into
+    if (it->second.state == State::OPEN && now >= it->second.open_until) {
+        return State::HALF_OPEN;
+    }
+    return it->second.state;
+}
+
+void HostCircuitBreaker::SetConfig(const CircuitBreakerConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+}
+
+void HostCircuitBreaker::Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    hosts_.clear();
+}
+
+std::string HostCircuitBreaker::HostFromUrl(const std::string& url) {
+    const std::size_t scheme_end = url.find("://");
+    if (scheme_end == std::string::npos) {
+        return {};
+    }
+
+    const std::size_t start = scheme_end + 3;
+    const std::size_t end = url.find_first_of("/?#", start);
+    std::string authority = url.substr(start, end == std::string::npos ? end : end - start);
+
+    // Drop credentials (user:password@host)
+    const std::size_t at = authority.rfind('@');
+    if (at != std::string::npos) {
+        authority.erase(0, at + 1);
+    }
+    std::transform(authority.begin(), authority.end(), authority.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return authority;
+}
+
+} // namespace earth_map
@@ -3,6 +3,8 @@
 
 #include <earth_map/data/srtm_loader.h>
 #include <earth_map/data/hgt_parser.h>
+#include <earth_map/data/single_flight.h>
+#include <earth_map/data/srtm_stream_decoder.h>
 
 #include <algorithm>
 #include <atomic>
@@ -12,6 +14,7 @@
 #include <filesystem>
 #include <fstream>
 #include <mutex>
+#include <optional>
 #include <queue>
 #include <set>
 #include <sstream>
@@ -88,13 +91,12 @@ private:
     bool stop_;
 };
 
-/// libcurl write callback
-size_t WriteCallback(void* contents, size_t size, size_t nmemb,
-                     std::vector<uint8_t>* userp) {
+/// libcurl write callback: decode the body as it arrives
+size_t DecodeCallback(void* contents, size_t size, size_t nmemb,
+                      SRTMStreamDecoder* decoder) {
     const size_t total_size = size * nmemb;
-    userp->insert(userp->end(), static_cast<uint8_t*>(contents),
-                  static_cast<uint8_t*>(contents) + total_size);
-    return total_size;
+    // Taking less than received aborts the transfer (CURLE_WRITE_ERROR)
+    return decoder->Write({static_cast<const uint8_t*>(contents), total_size}) ? total_size : 0;
 }
 
 } // anonymous namespace
@@ -128,39 +130,18 @@ public:
     }
 
     SRTMLoadResult LoadTile(const SRTMCoordinates& coordinates) override {
-        const auto start_time = std::chrono::high_resolution_clock::now();
-
-        SRTMLoadResult result;
-        result.coordinates = coordinates;
-
-        // Validate coordinates
-        if (!coordinates.IsValid()) {
-            result.error_message = "Invalid coordinates";
-            ++stats_.tiles_failed;
-            return result;
-        }
-
-        // Try to load from local disk first
-        if (config_.source == SRTMSource::LOCAL_DISK) {
-            result = LoadFromDisk(coordinates);
-        } else if (config_.source == SRTMSource::HTTP) {
-            result = LoadFromHTTP(coordinates);
-        }
-
-        // Calculate load time
-        const auto end_time = std::chrono::high_resolution_clock::now();
-        const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-            end_time - start_time);
-        result.load_time_ms = static_cast<double>(duration.count());
-
-        // Update statistics
-        if (result.success) {
-            ++stats_.tiles_loaded;
-            UpdateAverageLoadTime(result.load_time_ms);
-        } else {
-            ++stats_.tiles_failed;
+        // Wait for a load of the same tile already in flight instead of repeating it
+        auto call = flights_.Join(coordinates);
+        if (!call.leader) {
+            {
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                ++stats_.coalesced_loads;
+            }
+            return call.future.get();
         }
 
+        SRTMLoadResult result = LoadTileUncoalesced(coordinates);
+        flights_.Complete(coordinates, call.id, result);
         return result;
     }
 
@@ -171,38 +152,21 @@ public:
         auto promise = std::make_shared<std::promise<SRTMLoadResult>>();
         auto future = promise->get_future();
 
-        // Track pending load
-        {
-            std::lock_guard<std::mutex> lock(pending_mutex_);
-            pending_loads_.insert(coordinates);
-            ++stats_.pending_loads;
-        }
-
-        // Enqueue task
-        thread_pool_.Enqueue([this, coordinates, callback, promise]() {
-            SRTMLoadResult result = LoadTile(coordinates);
-
-            // Remove from pending
-            {
-                std::lock_guard<std::mutex> lock(pending_mutex_);
-                pending_loads_.erase(coordinates);
-                if (stats_.pending_loads > 0) {
-                    --stats_.pending_loads;
+        StartLoad(coordinates,
+            [callback = std::move(callback), promise](const SRTMLoadResult& result) {
+                if (callback) {
+                    callback(result);
                 }
-            }
-
-            // Call callback if provided
-            if (callback) {
-                callback(result);
-            }
-
-            // Set promise value
-            promise->set_value(result);
-        });
-
+                promise->set_value(result);
+            });
         return future;
     }
 
+    void LoadTileWithCallback(const SRTMCoordinates& coordinates,
+                              SRTMLoadCallback callback) override {
+        StartLoad(coordinates, std::move(callback));
+    }
+
     std::vector<std::future<SRTMLoadResult>> LoadTilesAsync(
         const std::vector<SRTMCoordinates>& coordinates,
         SRTMLoadCallback callback) override {
@@ -225,10 +189,12 @@ public:
     void CancelAllLoads() override {
         std::lock_guard<std::mutex> lock(pending_mutex_);
         pending_loads_.clear();
+        std::lock_guard<std::mutex> stats_lock(stats_mutex_);
         stats_.pending_loads = 0;
     }
 
     SRTMLoaderStats GetStatistics() const override {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
         return stats_;
     }
 
@@ -252,6 +218,81 @@ public:
     }
 
 private:
+    /// Join the load in flight for a tile, or start one as its leader
+    void StartLoad(const SRTMCoordinates& coordinates, SRTMLoadCallback listener) {
+        auto call = flights_.Join(coordinates, std::move(listener));
+        if (!call.leader) {
+            // Joined a load in flight: no second download or parse
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            ++stats_.coalesced_loads;
+            return;
+        }
+
+        // Track pending load
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            pending_loads_.insert(coordinates);
+            std::lock_guard<std::mutex> stats_lock(stats_mutex_);
+            ++stats_.pending_loads;
+        }
+
+        // Enqueue task
+        thread_pool_.Enqueue([this, coordinates, call_id = call.id]() {
+            SRTMLoadResult result = LoadTileUncoalesced(coordinates);
+
+            // Remove from pending
+            {
+                std::lock_guard<std::mutex> lock(pending_mutex_);
+                pending_loads_.erase(coordinates);
+                std::lock_guard<std::mutex> stats_lock(stats_mutex_);
+                if (stats_.pending_loads > 0) {
+                    --stats_.pending_loads;
+                }
+            }
+
+            // Run every waiter's callback, then resolve their futures
+            flights_.Complete(coordinates, call_id, result);
+        });
+    }
+
+    SRTMLoadResult LoadTileUncoalesced(const SRTMCoordinates& coordinates) {
+        const auto start_time = std::chrono::high_resolution_clock::now();
+
+        SRTMLoadResult result;
+        result.coordinates = coordinates;
+
+        // Validate coordinates
+        if (!coordinates.IsValid()) {
+            result.error_message = "Invalid coordinates";
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            ++stats_.tiles_failed;
+            return result;
+        }
+
+        // Try to load from local disk first
+        if (config_.source == SRTMSource::LOCAL_DISK) {
+            result = LoadFromDisk(coordinates);
+        } else if (config_.source == SRTMSource::HTTP) {
+            result = LoadFromHTTP(coordinates);
+        }
+
+        // Calculate load time
+        const auto end_time = std::chrono::high_resolution_clock::now();
+        result.load_time_ms =
+            std::chrono::duration<double, std::milli>(end_time - start_time).count();
+
+        // Update statistics
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        if (result.success) {
+            ++stats_.tiles_loaded;
+            UpdateAverageLoadTime(result.load_time_ms);
+        } else {
+            ++stats_.tiles_failed;
+        }
+
+        return result;
+    }
+
     SRTMLoadResult LoadFromDisk(const SRTMCoordinates& coordinates) {
         SRTMLoadResult result;
         result.coordinates = coordinates;
@@ -275,6 +316,7 @@ private:
 
         result.success = true;
         result.file_size_bytes = result.tile_data->GetMetadata().file_size;
+        std::lock_guard<std::mutex> lock(stats_mutex_);
         ++stats_.cache_hits;
 
         return result;
@@ -291,12 +333,17 @@ private:
             return result;
         }
 
-        // Download with retries
-        std::vector<uint8_t> data;
+        // Download with retries, decoding (and inflating .hgt.gz / .hgt.zip
+        // bodies) into the tile as data arrives
+        std::optional<SRTMStreamDecoder> decoder;
         bool downloaded = false;
 
         for (uint32_t retry = 0; retry <= config_.max_retries; ++retry) {
-            if (DownloadFile(url, data)) {
+            decoder.emplace(coordinates, config_.preferred_resolution);
+            const CURLcode res = DownloadFile(url, *decoder);
+            // A body the decoder rejected is not retried
+            if ((res == CURLE_OK && decoder->GetBytesReceived() > 0) ||
+                (res == CURLE_WRITE_ERROR && !decoder->GetError().empty())) {
                 downloaded = true;
                 break;
             }
@@ -311,16 +358,18 @@ private:
             return result;
         }
 
-        // Parse data
-        result.tile_data = HGTParser::Parse(data, coordinates);
+        // Finish parsing; a rejected body still used the bandwidth
+        const size_t bytes_received = decoder->GetBytesReceived();
+        result.tile_data = decoder->Finish();
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.bytes_downloaded += bytes_received;
         if (!result.tile_data) {
-            result.error_message = "Failed to parse downloaded HGT data";
+            result.error_message = "Failed to parse downloaded HGT data: " + decoder->GetError();
             return result;
         }
 
         result.success = true;
-        result.file_size_bytes = data.size();
-        stats_.bytes_downloaded += data.size();
+        result.file_size_bytes = bytes_received;
         ++stats_.cache_misses;
 
         return result;
@@ -354,17 +403,17 @@ private:
         return url;
     }
 
-    bool DownloadFile(const std::string& url, std::vector<uint8_t>& data) {
+    /// Download a URL into a decoder
+    /// @return Transfer result (CURLE_WRITE_ERROR if the decoder rejected the body)
+    CURLcode DownloadFile(const std::string& url, SRTMStreamDecoder& decoder) {
         CURL* curl = curl_easy_init();
         if (!curl) {
-            return false;
+            return CURLE_FAILED_INIT;
         }
 
-        data.clear();
-
         curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &data);
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, DecodeCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &decoder);
         curl_easy_setopt(curl, CURLOPT_TIMEOUT, config_.timeout_seconds);
         curl_easy_setopt(curl, CURLOPT_USERAGENT, config_.user_agent.c_str());
         curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
@@ -372,9 +421,10 @@ private:
         const CURLcode res = curl_easy_perform(curl);
         curl_easy_cleanup(curl);
 
-        return (res == CURLE_OK && !data.empty());
+        return res;
     }
 
+    /// Requires stats_mutex_
     void UpdateAverageLoadTime(double load_time_ms) {
         const uint64_t total = stats_.tiles_loaded;
         if (total == 0) {
@@ -386,8 +436,12 @@ private:
     }
 
     SRTMLoaderConfig config_;
+
+    /// Loads in flight, shared by concurrent requesters (outlives the pool's tasks)
+    SingleFlight<SRTMCoordinates, SRTMLoadResult> flights_;
     ThreadPool thread_pool_;
     SRTMLoaderStats stats_;
+    mutable std::mutex stats_mutex_;  ///< Loads update stats_ from several threads
 
     mutable std::mutex pending_mutex_;
     std::set<SRTMCoordinates> pending_loads_;
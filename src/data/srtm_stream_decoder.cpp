@@ -0,0 +1,321 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#include <earth_map/data/srtm_stream_decoder.h>
+#include <earth_map/data/hgt_parser.h>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#ifdef EARTH_MAP_HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace earth_map {
+
+namespace {
+
+constexpr uint8_t kGzipMagic[2] = {0x1F, 0x8B};
+constexpr uint8_t kZipLocalHeaderMagic[4] = {'P', 'K', 0x03, 0x04};
+
+/// Fixed part of a zip local file header
+constexpr size_t kZipLocalHeaderSize = 30;
+
+// Zip general purpose flags and compression methods
+constexpr uint16_t kZipFlagEncrypted = 1 << 0;
+constexpr uint16_t kZipFlagDataDescriptor = 1 << 3;
+constexpr uint16_t kZipMethodStored = 0;
+constexpr uint16_t kZipMethodDeflated = 8;
+
+/// Plain bodies have no declared size
+constexpr size_t kUnknownSize = std::numeric_limits<size_t>::max();
+
+uint16_t ReadLE16(const uint8_t* bytes) noexcept {
+    return static_cast<uint16_t>(bytes[0] | (bytes[1] << 8));
+}
+
+uint32_t ReadLE32(const uint8_t* bytes) noexcept {
+    return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+           (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+size_t SampleCount(SRTMResolution resolution) noexcept {
+    return GetExpectedFileSize(resolution) / sizeof(int16_t);
+}
+
+} // anonymous namespace
+
+#ifdef EARTH_MAP_HAVE_ZLIB
+struct SRTMStreamDecoder::InflateState {
+    z_stream stream{};
+    bool gzip = false;
+    uLong crc = crc32(0L, Z_NULL, 0);
+
+    ~InflateState() { inflateEnd(&stream); }
+};
+#else
+struct SRTMStreamDecoder::InflateState {};
+#endif
+
+SRTMStreamDecoder::SRTMStreamDecoder(const SRTMCoordinates& coordinates,
+                                     SRTMResolution expected_resolution)
+    : coordinates_(coordinates) {
+    samples_.resize(SampleCount(expected_resolution));
+}
+
+SRTMStreamDecoder::~SRTMStreamDecoder() = default;
+
+bool SRTMStreamDecoder::SupportsCompression() noexcept {
+#ifdef EARTH_MAP_HAVE_ZLIB
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool SRTMStreamDecoder::Write(std::span<const uint8_t> data) {
+    bytes_received_ += data.size();
+
+    switch (state_) {
+        case State::DETECT:
+        case State::ZIP_HEADER:
+            // Headers are small: buffer until they are complete
+            header_.insert(header_.end(), data.begin(), data.end());
+            return state_ == State::DETECT ? Detect() : ParseZipHeader();
+        case State::RAW:
+            return CopyRaw(data);
+        case State::INFLATE:
+            return Inflate(data);
+        case State::DONE:
+            return true;
+        case State::FAILED:
+            return false;
+    }
+    return false;
+}
+
+std::unique_ptr<SRTMTileData> SRTMStreamDecoder::Finish() {
+    // A body too short to detect can only be plain (and will not be a tile)
+    if (state_ == State::DETECT) {
+        state_ = State::RAW;
+        stored_remaining_ = kUnknownSize;
+        const std::vector<uint8_t> body = std::move(header_);
+        CopyRaw(body);
+    }
+
+    switch (state_) {
+        case State::ZIP_HEADER:
+        case State::INFLATE:
+            Fail("truncated SRTM archive");
+            return nullptr;
+        case State::RAW:
+            if (stored_remaining_ != kUnknownSize) {
+                Fail("truncated SRTM archive");
+                return nullptr;
+            }
+            break;
+        case State::FAILED:
+            return nullptr;
+        case State::DETECT:
+        case State::DONE:
+            break;
+    }
+
+    if (output_bytes_ % sizeof(int16_t) != 0) {
+        Fail("not an SRTM tile: " + std::to_string(output_bytes_) + " bytes");
+        return nullptr;
+    }
+    samples_.resize(output_bytes_ / sizeof(int16_t));
+    auto tile = HGTParser::ParseInPlace(std::move(samples_), coordinates_);
+    if (!tile) {
+        Fail("not an SRTM tile: " + std::to_string(output_bytes_) + " bytes");
+    }
+    state_ = tile ? State::DONE : State::FAILED;
+    return tile;
+}
+
+bool SRTMStreamDecoder::Detect() {
+    if (header_.size() < sizeof(kZipLocalHeaderMagic)) {
+        return true;
+    }
+
+    if (std::equal(std::begin(kGzipMagic), std::end(kGzipMagic), header_.begin())) {
+        if (!StartInflate(true)) {
+            return false;
+        }
+        const std::vector<uint8_t> body = std::move(header_);
+        return Inflate(body);
+    }
+
+    if (std::equal(std::begin(kZipLocalHeaderMagic), std::end(kZipLocalHeaderMagic),
+                   header_.begin())) {
+        state_ = State::ZIP_HEADER;
+        return ParseZipHeader();
+    }
+
+    // Plain .hgt
+    state_ = State::RAW;
+    stored_remaining_ = kUnknownSize;
+    const std::vector<uint8_t> body = std::move(header_);
+    return CopyRaw(body);
+}
+
+bool SRTMStreamDecoder::ParseZipHeader() {
+    if (header_.size() < kZipLocalHeaderSize) {
+        return true;
+    }
+    const uint8_t* header = header_.data();
+    const uint16_t flags = ReadLE16(header + 6);
+    const uint16_t method = ReadLE16(header + 8);
+    const uint32_t crc = ReadLE32(header + 14);
+    const uint32_t uncompressed_size = ReadLE32(header + 22);
+    const size_t data_offset =
+        kZipLocalHeaderSize + ReadLE16(header + 26) + ReadLE16(header + 28);
+    if (header_.size() < data_offset) {
+        return true;
+    }
+
+    if ((flags & kZipFlagEncrypted) != 0) {
+        return Fail("encrypted zip entry");
+    }
+
+    // Sizes and checksum follow the data when a data descriptor is used
+    const bool sizes_known = (flags & kZipFlagDataDescriptor) == 0;
+    check_crc_ = sizes_known;
+    expected_crc_ = crc;
+    if (sizes_known) {
+        if (!HGTParser::DetectResolution(uncompressed_size).has_value()) {
+            return Fail("zip entry is not an SRTM tile: " +
+                        std::to_string(uncompressed_size) + " bytes");
+        }
+        samples_.resize(uncompressed_size / sizeof(int16_t));
+    }
+
+    const std::vector<uint8_t> body(header_.begin() + static_cast<std::ptrdiff_t>(data_offset),
+                                    header_.end());
+    header_.clear();
+    header_.shrink_to_fit();
+
+    if (method == kZipMethodStored) {
+        if (!sizes_known) {
+            return Fail("stored zip entry without a size");
+        }
+        state_ = State::RAW;
+        stored_remaining_ = uncompressed_size;
+        return CopyRaw(body);
+    }
+    if (method == kZipMethodDeflated) {
+        return StartInflate(false) && Inflate(body);
+    }
+    return Fail("unsupported zip compression method " + std::to_string(method));
+}
+
+bool SRTMStreamDecoder::CopyRaw(std::span<const uint8_t> data) {
+    const size_t size = std::min(data.size(), stored_remaining_);
+    if (size == 0) {
+        return true;
+    }
+    if (!Reserve(size)) {
+        return false;
+    }
+    std::memcpy(reinterpret_cast<uint8_t*>(samples_.data()) + output_bytes_, data.data(), size);
+    output_bytes_ += size;
+
+    if (stored_remaining_ != kUnknownSize) {
+        stored_remaining_ -= size;
+        if (stored_remaining_ == 0) {
+            state_ = State::DONE;
+#ifdef EARTH_MAP_HAVE_ZLIB
+            const uLong crc = crc32(0L, reinterpret_cast<const Bytef*>(samples_.data()),
+                                    static_cast<uInt>(output_bytes_));
+            if (check_crc_ && crc != expected_crc_) {
+                return Fail("zip entry checksum mismatch");
+            }
+#endif
+        }
+    }
+    return true;
+}
+
+bool SRTMStreamDecoder::StartInflate([[maybe_unused]] bool gzip) {
+#ifdef EARTH_MAP_HAVE_ZLIB
+    inflate_ = std::make_unique<InflateState>();
+    inflate_->gzip = gzip;
+    // gzip wrapper (checked by zlib), or the raw deflate data of a zip entry
+    if (inflateInit2(&inflate_->stream, gzip ? 15 + 16 : -15) != Z_OK) {
+        inflate_.reset();
+        return Fail("inflate initialization failed");
+    }
+    state_ = State::INFLATE;
+    return true;
+#else
+    return Fail("compressed SRTM data needs zlib (EARTH_MAP_WITH_ZLIB)");
+#endif
+}
+
+bool SRTMStreamDecoder::Inflate([[maybe_unused]] std::span<const uint8_t> data) {
+#ifdef EARTH_MAP_HAVE_ZLIB
+    z_stream& stream = inflate_->stream;
+    stream.next_in = const_cast<Bytef*>(data.data());
+    stream.avail_in = static_cast<uInt>(data.size());
+
+    while (stream.avail_in > 0) {
+        // Inflate straight into the sample buffer
+        if (output_bytes_ == samples_.size() * sizeof(int16_t) && !Reserve(1)) {
+            return false;
+        }
+        auto* output = reinterpret_cast<uint8_t*>(samples_.data()) + output_bytes_;
+        const size_t room = samples_.size() * sizeof(int16_t) - output_bytes_;
+        stream.next_out = output;
+        stream.avail_out = static_cast<uInt>(room);
+
+        const int result = inflate(&stream, Z_NO_FLUSH);
+        const size_t produced = room - stream.avail_out;
+        output_bytes_ += produced;
+        if (!inflate_->gzip && check_crc_) {
+            inflate_->crc = crc32(inflate_->crc, output, static_cast<uInt>(produced));
+        }
+
+        if (result == Z_STREAM_END) {
+            state_ = State::DONE;
+            if (!inflate_->gzip && check_crc_ && inflate_->crc != expected_crc_) {
+                return Fail("zip entry checksum mismatch");
+            }
+            inflate_.reset();
+            return true;
+        }
+        if (result != Z_OK && result != Z_BUF_ERROR) {
+            return Fail(std::string("inflate failed: ") + (stream.msg ? stream.msg : "corrupt data"));
+        }
+    }
+    return true;
+#else
+    return Fail("compressed SRTM data needs zlib (EARTH_MAP_WITH_ZLIB)");
+#endif
+}
+
+bool SRTMStreamDecoder::Reserve(size_t bytes) {
+    const size_t needed = output_bytes_ + bytes;
+    if (needed <= samples_.size() * sizeof(int16_t)) {
+        return true;
+    }
+    // Sized for SRTM3 but larger: grow once to the largest tile
+    const size_t largest = SampleCount(SRTMResolution::SRTM1);
+    if (needed > largest * sizeof(int16_t)) {
+        return Fail("SRTM data larger than an SRTM1 tile");
+    }
+    samples_.resize(largest);
+    return true;
+}
+
+bool SRTMStreamDecoder::Fail(std::string error) {
+    if (state_ != State::FAILED) {
+        error_ = std::move(error);
+        state_ = State::FAILED;
+    }
+    inflate_.reset();
+    return false;
+}
+
+} // namespace earth_map
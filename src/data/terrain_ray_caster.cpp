@@ -0,0 +1,465 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#include <earth_map/data/terrain_ray_caster.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace earth_map {
+
+using namespace coordinates;
+namespace {
+
+/// Void sample marker in SRTM data
+constexpr int16_t kVoidSample = -32768;
+
+/// Lowest quadtree level stored; finer ranges scan at most 5 x 5 samples
+constexpr uint32_t kFirstStoredLevel = 2;
+
+/// Halvings of a ray segment before it is treated as a leaf regardless
+constexpr int kMaxDepth = 64;
+
+/// Bisection steps locating the crossing within a leaf segment
+constexpr int kBisectionSteps = 24;
+
+/// Ground tracks spanning more tiles than this use the global range
+constexpr int64_t kMaxTilesPerQuery = 64;
+
+/// Ground tracks wider than this (radians) use the global range
+constexpr double kMaxTrackAngle = 1.0;
+
+[[nodiscard]] double DegreesToRadians(double degrees) noexcept {
+    return degrees * M_PI / 180.0;
+}
+
+[[nodiscard]] double RadiansToDegrees(double radians) noexcept {
+    return radians * 180.0 / M_PI;
+}
+
+/// Unit vector of a geographic direction (CoordinateMapper axes)
+[[nodiscard]] glm::dvec3 GeographicDirection(double latitude, double longitude) noexcept {
+    const double lat = DegreesToRadians(latitude);
+    const double lon = DegreesToRadians(longitude);
+    return glm::dvec3(std::cos(lat) * std::sin(lon), std::sin(lat), std::cos(lat) * std::cos(lon));
+}
+
+/// Merge two elevation ranges
+[[nodiscard]] std::pair<float, float> Merge(const std::pair<float, float>& a,
+                                            const std::pair<float, float>& b) noexcept {
+    return {std::min(a.first, b.first), std::max(a.second, b.second)};
+}
+
+/// First root of |origin + t * direction| = radius at or after t0, or a
+/// negative value
+[[nodiscard]] double FirstSphereCrossing(const glm::dvec3& origin, const glm::dvec3& direction,
+                                         double radius, double t0) noexcept {
+    const double a = glm::dot(direction, direction);
+    const double b = glm::dot(origin, direction);
+    const double c = glm::dot(origin, origin) - radius * radius;
+    const double discriminant = b * b - a * c;
+    if (a <= 0.0 || discriminant < 0.0) {
+        return -1.0;
+    }
+    const double root = std::sqrt(discriminant);
+    const double near = (-b - root) / a;
+    const double far = (-b + root) / a;
+    if (near >= t0) {
+        return near;
+    }
+    return far >= t0 ? far : -1.0;
+}
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// ElevationMinMaxPyramid
+// ---------------------------------------------------------------------------
+
+ElevationMinMaxPyramid::ElevationMinMaxPyramid(std::shared_ptr<const SRTMTileData> tile)
+    : tile_(std::move(tile)), cells_per_side_(0), level_count_(0), range_{0.0f, 0.0f} {
+    if (!tile_ || !tile_->IsValid() || tile_->GetMetadata().samples_per_side < 2 ||
+        tile_->GetSamples().size() <
+            tile_->GetMetadata().samples_per_side * tile_->GetMetadata().samples_per_side) {
+        throw std::invalid_argument("ElevationMinMaxPyramid requires a valid tile");
+    }
+
+    const size_t samples = tile_->GetMetadata().samples_per_side;
+    cells_per_side_ = samples - 1;
+    level_count_ = 1;
+    while ((cells_per_side_ - 1) >> (level_count_ - 1) > 0) {
+        ++level_count_;
+    }
+
+    // The finest stored level scans samples; each coarser one folds 2 x 2 blocks
+    size_t blocks = cells_per_side_;
+    for (uint32_t level = 1; level < level_count_; ++level) {
+        const size_t child_blocks = blocks;
+        blocks = (blocks + 1) / 2;
+        if (level < kFirstStoredLevel) {
+            continue;
+        }
+
+        std::vector<Range> ranges(blocks * blocks);
+        if (level == kFirstStoredLevel) {
+            const size_t span = size_t{1} << level;
+            for (size_t y = 0; y < blocks; ++y) {
+                for (size_t x = 0; x < blocks; ++x) {
+                    ranges[y * blocks + x] =
+                        ScanSamples(x * span, std::min((x + 1) * span, cells_per_side_),
+                                    y * span, std::min((y + 1) * span, cells_per_side_));
+                }
+            }
+        } else {
+            const std::vector<Range>& children = levels_.back();
+            for (size_t y = 0; y < blocks; ++y) {
+                for (size_t x = 0; x < blocks; ++x) {
+                    Range range = children[(2 * y) * child_blocks + 2 * x];
+                    for (size_t cy = 2 * y; cy < std::min(2 * y + 2, child_blocks); ++cy) {
+                        for (size_t cx = 2 * x; cx < std::min(2 * x + 2, child_blocks); ++cx) {
+                            const Range& child = children[cy * child_blocks + cx];
+                            range.min = std::min(range.min, child.min);
+                            range.max = std::max(range.max, child.max);
+                        }
+                    }
+                    ranges[y * blocks + x] = range;
+                }
+            }
+        }
+        levels_.push_back(std::move(ranges));
+    }
+
+    const Range whole = levels_.empty() ? ScanSamples(0, cells_per_side_, 0, cells_per_side_)
+                                        : levels_.back().front();
+    range_ = {static_cast<float>(whole.min), static_cast<float>(whole.max)};
+}
+
+double ElevationMinMaxPyramid::GetSampleSpacing() const noexcept {
+    return kMetersPerDegreeLatitude / static_cast<double>(cells_per_side_);
+}
+
+ElevationMinMaxPyramid::Range ElevationMinMaxPyramid::ScanSamples(size_t x0, size_t x1,
+                                                                  size_t y0,
+                                                                  size_t y1) const noexcept {
+    const std::span<const int16_t> data = tile_->GetSamples();
+    const size_t samples = cells_per_side_ + 1;
+    Range range{std::numeric_limits<int16_t>::max(), std::numeric_limits<int16_t>::min()};
+    for (size_t y = y0; y <= y1; ++y) {
+        for (size_t x = x0; x <= x1; ++x) {
+            // Interpolation returns 0 m next to a void
+            const int16_t value = data[y * samples + x] == kVoidSample ? 0 : data[y * samples + x];
+            range.min = std::min(range.min, value);
+            range.max = std::max(range.max, value);
+        }
+    }
+    return range;
+}
+
+std::pair<float, float> ElevationMinMaxPyramid::QueryRange(double lat_min, double lat_max,
+                                                           double lon_min,
+                                                           double lon_max) const noexcept {
+    // Cells under the region; rows count from the north
+    const double cells = static_cast<double>(cells_per_side_);
+    const auto to_cell = [&](double position) {
+        return static_cast<size_t>(std::clamp(std::floor(position), 0.0, cells - 1.0));
+    };
+    const size_t x0 = to_cell(std::clamp(lon_min, 0.0, 1.0) * cells);
+    const size_t x1 = to_cell(std::clamp(lon_max, 0.0, 1.0) * cells);
+    const size_t y0 = to_cell((1.0 - std::clamp(lat_max, 0.0, 1.0)) * cells);
+    const size_t y1 = to_cell((1.0 - std::clamp(lat_min, 0.0, 1.0)) * cells);
+
+    // Finest level at which the region spans at most 2 x 2 blocks
+    uint32_t level = 0;
+    while (((x1 >> level) - (x0 >> level)) > 1 || ((y1 >> level) - (y0 >> level)) > 1) {
+        ++level;
+    }
+
+    Range range{};
+    if (level < kFirstStoredLevel || levels_.empty()) {
+        const size_t span = size_t{1} << std::min(level, kFirstStoredLevel);
+        const size_t last = cells_per_side_;
+        range = ScanSamples((x0 / span) * span, std::min((x1 / span + 1) * span, last),
+                            (y0 / span) * span, std::min((y1 / span + 1) * span, last));
+    } else {
+        level = std::min<uint32_t>(level, level_count_ - 1);
+        const std::vector<Range>& ranges = levels_[level - kFirstStoredLevel];
+        const size_t blocks = (cells_per_side_ + (size_t{1} << level) - 1) >> level;
+        range = ranges[(y0 >> level) * blocks + (x0 >> level)];
+        for (size_t y = y0 >> level; y <= (y1 >> level); ++y) {
+            for (size_t x = x0 >> level; x <= (x1 >> level); ++x) {
+                range.min = std::min(range.min, ranges[y * blocks + x].min);
+                range.max = std::max(range.max, ranges[y * blocks + x].max);
+            }
+        }
+    }
+    return {static_cast<float>(range.min), static_cast<float>(range.max)};
+}
+
+size_t ElevationMinMaxPyramid::GetMemoryUsage() const noexcept {
+    size_t bytes = sizeof(*this);
+    for (const auto& level : levels_) {
+        bytes += level.size() * sizeof(Range);
+    }
+    return bytes;
+}
+
+// ---------------------------------------------------------------------------
+// TerrainRayCaster
+// ---------------------------------------------------------------------------
+
+/// Ray p(t) = origin + t * direction over a sphere, in meters, optionally
+/// bent up into an arc rising bend * t * (1 - t) above the chord
+struct TerrainRayCaster::Segment {
+    glm::dvec3 origin;
+    glm::dvec3 direction;
+    double radius;
+    double bend = 0.0;
+
+    [[nodiscard]] glm::dvec3 At(double t) const noexcept { return origin + direction * t; }
+
+    [[nodiscard]] double ChordAltitude(double t) const noexcept {
+        return glm::length(At(t)) - radius;
+    }
+
+    [[nodiscard]] double Bend(double t) const noexcept { return bend * t * (1.0 - t); }
+
+    [[nodiscard]] double Altitude(double t) const noexcept { return ChordAltitude(t) + Bend(t); }
+};
+
+TerrainRayCaster::TerrainRayCaster(
+    std::vector<std::shared_ptr<const ElevationMinMaxPyramid>> tiles,
+    const TerrainRayCasterConfig& config)
+    : config_(config),
+      leaf_meters_(std::numeric_limits<double>::infinity()),
+      range_{config.missing_elevation, config.missing_elevation} {
+    for (auto& tile : tiles) {
+        if (!tile) {
+            continue;
+        }
+        const auto [it, inserted] = tiles_.emplace(tile->GetCoordinates(), tile);
+        if (inserted) {
+            leaf_meters_ = std::min(leaf_meters_, 0.5 * tile->GetSampleSpacing());
+            range_ = Merge(range_, tile->GetRange());
+        }
+    }
+    // Missing elevation is uniform: segments over it resolve by sphere crossing
+    // long before they shrink to this
+    if (tiles_.empty()) {
+        leaf_meters_ = 1.0;
+    }
+}
+
+std::pair<float, float> TerrainRayCaster::QueryRange(double lat_min, double lat_max,
+                                                     double lon_min,
+                                                     double lon_max) const noexcept {
+    if (lon_max - lon_min >= 360.0) {
+        lon_min = -180.0;
+        lon_max = 180.0;
+    }
+    // Wrap the west edge into [-180, 180); a box crossing the antimeridian
+    // is queried in two parts
+    const double shift = std::floor((lon_min + 180.0) / 360.0) * 360.0;
+    lon_min -= shift;
+    lon_max -= shift;
+    if (lon_max > 180.0) {
+        return Merge(QueryRange(lat_min, lat_max, lon_min, 180.0),
+                     QueryRange(lat_min, lat_max, -180.0, lon_max - 360.0));
+    }
+
+    const auto tile_lat0 = static_cast<int32_t>(std::clamp(std::floor(lat_min), -90.0, 89.0));
+    const auto tile_lat1 = static_cast<int32_t>(std::clamp(std::floor(lat_max), -90.0, 89.0));
+    const auto tile_lon0 = static_cast<int32_t>(std::clamp(std::floor(lon_min), -180.0, 179.0));
+    const auto tile_lon1 = static_cast<int32_t>(std::clamp(std::floor(lon_max), -180.0, 179.0));
+    if (static_cast<int64_t>(tile_lat1 - tile_lat0 + 1) * (tile_lon1 - tile_lon0 + 1) >
+        kMaxTilesPerQuery) {
+        return range_;
+    }
+
+    std::pair<float, float> range{std::numeric_limits<float>::max(),
+                                  std::numeric_limits<float>::lowest()};
+    for (int32_t lat = tile_lat0; lat <= tile_lat1; ++lat) {
+        for (int32_t lon = tile_lon0; lon <= tile_lon1; ++lon) {
+            const auto it = tiles_.find(SRTMCoordinates{lat, lon});
+            if (it == tiles_.end()) {
+                range = Merge(range, {config_.missing_elevation, config_.missing_elevation});
+                continue;
+            }
+            range = Merge(range, it->second->QueryRange(lat_min - lat, lat_max - lat,
+                                                        lon_min - lon, lon_max - lon));
+        }
+    }
+    return range;
+}
+
+float TerrainRayCaster::GetElevation(double latitude, double longitude) const noexcept {
+    latitude = std::clamp(latitude, -90.0, 90.0);
+    longitude -= std::floor((longitude + 180.0) / 360.0) * 360.0;
+    const SRTMCoordinates coords{
+        static_cast<int32_t>(std::min(std::floor(latitude), 89.0)),
+        static_cast<int32_t>(std::min(std::floor(longitude), 179.0))};
+    const auto it = tiles_.find(coords);
+    if (it == tiles_.end()) {
+        return config_.missing_elevation;
+    }
+    return it->second->GetTile().InterpolateElevation(latitude - coords.latitude,
+                                                      longitude - coords.longitude);
+}
+
+double TerrainRayCaster::Traverse(const Segment& segment, double t0, double t1,
+                                  int depth) const noexcept {
+    // Chord altitude is convex along the segment: lowest at the point nearest
+    // the center, highest at an end; the bend is concave, the other way round
+    const double nearest = -glm::dot(segment.origin, segment.direction) /
+                           glm::dot(segment.direction, segment.direction);
+    const double lowest = segment.ChordAltitude(std::clamp(nearest, t0, t1)) +
+                          std::min(segment.Bend(t0), segment.Bend(t1));
+    if (lowest > range_.second) {
+        return -1.0;
+    }
+    const double start_altitude = segment.Altitude(t0);
+    const double highest = std::max(segment.ChordAltitude(t0), segment.ChordAltitude(t1)) +
+                           segment.Bend(std::clamp(0.5, t0, t1));
+
+    // The ground track is the great-circle arc between the end directions,
+    // within half its angle of its midpoint
+    const glm::dvec3 u0 = glm::normalize(segment.At(t0));
+    const glm::dvec3 u1 = glm::normalize(segment.At(t1));
+    const double angle = std::atan2(glm::length(glm::cross(u0, u1)), glm::dot(u0, u1));
+    std::pair<float, float> terrain = range_;
+    if (angle < kMaxTrackAngle) {
+        const glm::dvec3 middle = glm::normalize(u0 + u1);
+        const double half = 0.5 * angle;
+        const double latitude = RadiansToDegrees(std::asin(std::clamp(middle.y, -1.0, 1.0)));
+        const double longitude = RadiansToDegrees(std::atan2(middle.x, middle.z));
+        const double lat_min = latitude - RadiansToDegrees(half);
+        const double lat_max = latitude + RadiansToDegrees(half);
+        double lon_extent = 180.0;
+        if (lat_min > -90.0 && lat_max < 90.0) {
+            const double cos_edge = std::cos(DegreesToRadians(std::max(std::abs(lat_min),
+                                                                       std::abs(lat_max))));
+            lon_extent = RadiansToDegrees(std::asin(std::min(1.0, std::sin(half) / cos_edge)));
+        }
+        terrain = QueryRange(std::max(lat_min, -90.0), std::min(lat_max, 90.0),
+                             longitude - lon_extent, longitude + lon_extent);
+    }
+
+    if (lowest > terrain.second) {
+        return -1.0;
+    }
+    if (highest < terrain.first) {
+        return t0;
+    }
+    if (terrain.first == terrain.second && segment.bend == 0.0) {
+        // Flat terrain is a sphere
+        if (start_altitude <= terrain.first) {
+            return t0;
+        }
+        const double t = FirstSphereCrossing(segment.origin, segment.direction,
+                                             segment.radius + terrain.first, t0);
+        return t <= t1 ? t : -1.0;
+    }
+
+    if (angle * segment.radius > leaf_meters_ && depth < kMaxDepth) {
+        const double middle = 0.5 * (t0 + t1);
+        const double hit = Traverse(segment, t0, middle, depth + 1);
+        return hit >= 0.0 ? hit : Traverse(segment, middle, t1, depth + 1);
+    }
+
+    // Leaf: shorter than half a sample, so the surface is near linear along it
+    const auto clearance = [&](double t) {
+        const glm::dvec3 p = segment.At(t);
+        const double length = glm::length(p);
+        const double latitude = RadiansToDegrees(std::asin(std::clamp(p.y / length, -1.0, 1.0)));
+        const double longitude = RadiansToDegrees(std::atan2(p.x, p.z));
+        return length - segment.radius + segment.Bend(t) - GetElevation(latitude, longitude);
+    };
+    if (clearance(t0) <= 0.0) {
+        return t0;
+    }
+    if (clearance(t1) > 0.0) {
+        return -1.0;
+    }
+    double above = t0;
+    double below = t1;
+    for (int step = 0; step < kBisectionSteps; ++step) {
+        const double middle = 0.5 * (above + below);
+        (clearance(middle) > 0.0 ? above : below) = middle;
+    }
+    return below;
+}
+
+std::optional<TerrainRayHit> TerrainRayCaster::Intersect(const glm::dvec3& origin,
+                                                         const glm::dvec3& direction,
+                                                         double globe_radius) const noexcept {
+    if (!(globe_radius > 0.0) || glm::dot(direction, direction) <= 0.0) {
+        return std::nullopt;
+    }
+    const double scale = config_.earth_radius_meters / globe_radius;
+    const Segment segment{origin * scale, direction * scale, config_.earth_radius_meters};
+
+    // Only the shell between the lowest and highest terrain can be hit
+    const double top = segment.radius + range_.second + 1.0;
+    double t0 = 0.0;
+    if (glm::length(segment.origin) > top) {
+        t0 = FirstSphereCrossing(segment.origin, segment.direction, top, 0.0);
+        if (t0 < 0.0) {
+            return std::nullopt;
+        }
+    }
+    const double bottom = segment.radius + range_.first - 1.0;
+    double t1 = FirstSphereCrossing(segment.origin, segment.direction, bottom, t0);
+    if (t1 < 0.0) {
+        // Leaves the shell outward: find the exit of the top sphere
+        const double a = glm::dot(segment.direction, segment.direction);
+        const double b = glm::dot(segment.origin, segment.direction);
+        const double c = glm::dot(segment.origin, segment.origin) - top * top;
+        t1 = (-b + std::sqrt(std::max(0.0, b * b - a * c))) / a;
+    }
+    if (t1 < t0) {
+        return std::nullopt;
+    }
+
+    const double t = Traverse(segment, t0, t1, 0);
+    if (t < 0.0) {
+        return std::nullopt;
+    }
+    const glm::dvec3 p = segment.At(t);
+    const double length = glm::length(p);
+    TerrainRayHit hit;
+    hit.position = Geographic(RadiansToDegrees(std::asin(std::clamp(p.y / length, -1.0, 1.0))),
+                              RadiansToDegrees(std::atan2(p.x, p.z)),
+                              length - segment.radius);
+    hit.distance = t;
+    return hit;
+}
+
+bool TerrainRayCaster::LineOfSight(const Geographic& from, const Geographic& to) const noexcept {
+    const double radius = config_.earth_radius_meters;
+    const glm::dvec3 start =
+        GeographicDirection(from.latitude, from.longitude) * (radius + from.altitude);
+    const glm::dvec3 end = GeographicDirection(to.latitude, to.longitude) * (radius + to.altitude);
+    Segment segment{start, end - start, radius};
+
+    // Refraction bends the sight line into an arc of radius R / k over the
+    // chord, rising k * x * (L - x) / 2R at x along it
+    const double length = glm::length(segment.direction);
+    segment.bend = config_.refraction_coefficient * length * length / (2.0 * radius);
+
+    const double margin = length > 0.0 ? config_.endpoint_clearance_meters / length : 1.0;
+    if (2.0 * margin >= 1.0) {
+        return true;
+    }
+    return Traverse(segment, margin, 1.0 - margin, 0) < 0.0;
+}
+
+std::vector<uint8_t> TerrainRayCaster::LineOfSight(std::span<const SightLine> lines) const {
+    std::vector<uint8_t> visible(lines.size());
+    for (size_t i = 0; i < lines.size(); ++i) {
+        visible[i] = LineOfSight(lines[i].from, lines[i].to) ? 1 : 0;
+    }
+    return visible;
+}
+
+} // namespace earth_map
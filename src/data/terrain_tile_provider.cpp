@@ -0,0 +1,733 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#include <earth_map/data/terrain_tile_provider.h>
+#include <earth_map/data/region_preload_job.h>
+#include <earth_map/data/single_flight.h>
+#include <earth_map/renderer/texture_atlas/decode_thread_pool.h>
+#include <earth_map/renderer/texture_atlas/image_decoder.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
+#include <limits>
+#include <list>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace earth_map {
+
+using namespace coordinates;
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+/// Latitude limit of the square Web Mercator world
+constexpr double kMaxMercatorLatitude = 85.05112877980659;
+
+/// Equatorial circumference of the WGS84 ellipsoid in meters
+constexpr double kEarthCircumference = 40075016.686;
+
+/// Fixed part of a quantized-mesh tile: center (3 doubles), minimum and
+/// maximum height (2 floats), bounding sphere (4 doubles) and horizon
+/// occlusion point (3 doubles)
+constexpr size_t kQuantizedMeshHeaderSize = 88;
+constexpr size_t kQuantizedMeshHeightsOffset = 24;
+
+/// Largest quantized vertex coordinate
+constexpr double kQuantizedMax = 32767.0;
+
+/// Meshes with more vertices use 32-bit indices
+constexpr uint32_t kMaxVerticesFor16BitIndices = 65536;
+
+/// Check if coordinate is valid for elevation coverage
+[[nodiscard]] bool IsValidCoordinate(double latitude, double longitude) noexcept {
+    return latitude >= -90.0 && latitude <= 90.0 &&
+           longitude >= -180.0 && longitude <= 180.0;
+}
+
+/// Tile columns and rows of a tiling scheme at a zoom
+[[nodiscard]] std::pair<int32_t, int32_t> GetGridSize(TerrainTileEncoding encoding,
+                                                      int32_t zoom) noexcept {
+    if (encoding == TerrainTileEncoding::QUANTIZED_MESH) {
+        return {2 << zoom, 1 << zoom};
+    }
+    return {1 << zoom, 1 << zoom};
+}
+
+/// Little-endian reader over a tile body
+class ByteReader {
+public:
+    explicit ByteReader(std::span<const uint8_t> data) noexcept : data_(data) {}
+
+    [[nodiscard]] size_t Remaining() const noexcept { return data_.size() - offset_; }
+
+    void Skip(size_t bytes) noexcept { offset_ += std::min(bytes, Remaining()); }
+
+    void Align(size_t alignment) noexcept { Skip((alignment - offset_ % alignment) % alignment); }
+
+    template <typename T>
+    [[nodiscard]] T Read() noexcept {
+        using Bits = std::conditional_t<sizeof(T) == 2, uint16_t,
+                     std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>;
+        Bits bits = 0;
+        for (size_t i = 0; i < sizeof(T); ++i) {
+            bits |= static_cast<Bits>(static_cast<Bits>(data_[offset_ + i]) << (8 * i));
+        }
+        offset_ += sizeof(T);
+        return std::bit_cast<T>(bits);
+    }
+
+private:
+    std::span<const uint8_t> data_;
+    size_t offset_ = 0;
+};
+
+/// Decode one zigzag-encoded delta
+[[nodiscard]] int32_t ZigZagDecode(uint16_t value) noexcept {
+    return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+/// Read a quantized-mesh vertex attribute (delta and zigzag encoded)
+[[nodiscard]] std::vector<uint16_t> ReadVertexAttribute(ByteReader& reader, uint32_t count) {
+    std::vector<uint16_t> values(count);
+    int32_t value = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        value += ZigZagDecode(reader.Read<uint16_t>());
+        values[i] = static_cast<uint16_t>(value);
+    }
+    return values;
+}
+
+/// Read quantized-mesh triangle indices (high-water-mark encoded)
+/// @return Indices, or an empty vector if one is out of range
+template <typename Index>
+[[nodiscard]] std::vector<uint32_t> ReadIndices(ByteReader& reader, size_t count,
+                                                uint32_t vertex_count) {
+    std::vector<uint32_t> indices(count);
+    uint32_t highest = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const uint32_t code = reader.Read<Index>();
+        if (code > highest) {
+            return {};
+        }
+        indices[i] = highest - code;
+        if (code == 0) {
+            ++highest;
+        }
+        if (indices[i] >= vertex_count) {
+            return {};
+        }
+    }
+    return indices;
+}
+
+} // anonymous namespace
+
+TerrainTilePosition LocateTerrainTile(TerrainTileEncoding encoding, double latitude,
+                                      double longitude, int32_t zoom) noexcept {
+    latitude = NormalizeLatitude(latitude);
+    longitude = NormalizeLongitude(longitude);
+    const auto [columns, rows] = GetGridSize(encoding, zoom);
+
+    // Position in tile units from the west and north edges of the world
+    const double x = (longitude + 180.0) / 360.0 * columns;
+    double y = 0.0;
+    if (encoding == TerrainTileEncoding::QUANTIZED_MESH) {
+        y = (90.0 - latitude) / 180.0 * rows;
+    } else {
+        const double phi = std::clamp(latitude, -kMaxMercatorLatitude, kMaxMercatorLatitude) *
+                           kPi / 180.0;
+        y = (1.0 - std::asinh(std::tan(phi)) / kPi) / 2.0 * rows;
+    }
+
+    const int32_t column = std::clamp(static_cast<int32_t>(std::floor(x)), 0, columns - 1);
+    const int32_t row = std::clamp(static_cast<int32_t>(std::floor(y)), 0, rows - 1);
+
+    TerrainTilePosition position;
+    position.u = std::clamp(x - column, 0.0, 1.0);
+    position.v = std::clamp(y - row, 0.0, 1.0);
+    // TMS rows count from the south
+    position.tile = TileCoordinates(
+        column, encoding == TerrainTileEncoding::QUANTIZED_MESH ? rows - 1 - row : row, zoom);
+    return position;
+}
+
+TerrainHeightmap::TerrainHeightmap(const TileCoordinates& coordinates, uint32_t width,
+                                   uint32_t height, std::vector<float> heights,
+                                   bool pixel_is_area)
+    : coordinates_(coordinates),
+      width_(width),
+      height_(height),
+      heights_(std::move(heights)),
+      pixel_is_area_(pixel_is_area) {
+    if (width_ == 0 || height_ == 0 ||
+        heights_.size() != static_cast<size_t>(width_) * height_) {
+        throw std::invalid_argument("Heightmap size does not match its dimensions");
+    }
+}
+
+float TerrainHeightmap::Sample(double u, double v) const noexcept {
+    // Sample position in grid units
+    double x = 0.0;
+    double y = 0.0;
+    if (pixel_is_area_) {
+        x = u * width_ - 0.5;
+        y = v * height_ - 0.5;
+    } else {
+        x = u * (width_ - 1);
+        y = v * (height_ - 1);
+    }
+    x = std::clamp(x, 0.0, static_cast<double>(width_ - 1));
+    y = std::clamp(y, 0.0, static_cast<double>(height_ - 1));
+
+    const uint32_t x0 = static_cast<uint32_t>(x);
+    const uint32_t y0 = static_cast<uint32_t>(y);
+    const uint32_t x1 = std::min(x0 + 1, width_ - 1);
+    const uint32_t y1 = std::min(y0 + 1, height_ - 1);
+    const double fx = x - x0;
+    const double fy = y - y0;
+
+    const auto at = [this](uint32_t column, uint32_t row) {
+        return static_cast<double>(heights_[static_cast<size_t>(row) * width_ + column]);
+    };
+    const double north = at(x0, y0) + (at(x1, y0) - at(x0, y0)) * fx;
+    const double south = at(x0, y1) + (at(x1, y1) - at(x0, y1)) * fx;
+    return static_cast<float>(north + (south - north) * fy);
+}
+
+std::unique_ptr<TerrainHeightmap> DecodeTerrainRGB(const TileCoordinates& coordinates,
+                                                   std::span<const uint8_t> rgba,
+                                                   uint32_t width, uint32_t height) {
+    const size_t pixels = static_cast<size_t>(width) * height;
+    if (pixels == 0 || rgba.size() != pixels * 4) {
+        return nullptr;
+    }
+
+    std::vector<float> heights(pixels);
+    for (size_t i = 0; i < pixels; ++i) {
+        const uint32_t value = (static_cast<uint32_t>(rgba[i * 4]) << 16) |
+                               (static_cast<uint32_t>(rgba[i * 4 + 1]) << 8) |
+                               rgba[i * 4 + 2];
+        heights[i] = static_cast<float>(-10000.0 + value * 0.1);
+    }
+    return std::make_unique<TerrainHeightmap>(coordinates, width, height, std::move(heights),
+                                              true);
+}
+
+std::unique_ptr<TerrainHeightmap> DecodeQuantizedMesh(const TileCoordinates& coordinates,
+                                                      std::span<const uint8_t> data,
+                                                      uint32_t grid_size) {
+    if (grid_size < 2 || data.size() < kQuantizedMeshHeaderSize + sizeof(uint32_t)) {
+        return nullptr;
+    }
+
+    ByteReader reader(data);
+    reader.Skip(kQuantizedMeshHeightsOffset);
+    const float min_height = reader.Read<float>();
+    const float max_height = reader.Read<float>();
+    reader.Skip(kQuantizedMeshHeaderSize - kQuantizedMeshHeightsOffset - 2 * sizeof(float));
+
+    // Vertex data: u, v and height arrays
+    const uint32_t vertex_count = reader.Read<uint32_t>();
+    if (vertex_count == 0 || reader.Remaining() / (3 * sizeof(uint16_t)) < vertex_count) {
+        return nullptr;
+    }
+    const auto us = ReadVertexAttribute(reader, vertex_count);
+    const auto vs = ReadVertexAttribute(reader, vertex_count);
+    const auto hs = ReadVertexAttribute(reader, vertex_count);
+
+    // Index data, 32-bit (and 4-byte aligned) for large meshes
+    const bool wide_indices = vertex_count > kMaxVerticesFor16BitIndices;
+    const size_t index_size = wide_indices ? sizeof(uint32_t) : sizeof(uint16_t);
+    if (wide_indices) {
+        reader.Align(sizeof(uint32_t));
+    }
+    if (reader.Remaining() < sizeof(uint32_t)) {
+        return nullptr;
+    }
+    const size_t index_count = static_cast<size_t>(reader.Read<uint32_t>()) * 3;
+    if (index_count == 0 || reader.Remaining() / index_size < index_count) {
+        return nullptr;
+    }
+    const auto indices = wide_indices ? ReadIndices<uint32_t>(reader, index_count, vertex_count)
+                                      : ReadIndices<uint16_t>(reader, index_count, vertex_count);
+    if (indices.empty()) {
+        return nullptr;
+    }
+
+    // Rasterize the triangles onto a grid spanning the tile edge to edge
+    const double scale = grid_size - 1;
+    const auto grid_x = [&](uint32_t vertex) { return us[vertex] / kQuantizedMax * scale; };
+    const auto grid_y = [&](uint32_t vertex) {
+        return (1.0 - vs[vertex] / kQuantizedMax) * scale;  // Rows from the north
+    };
+    const auto vertex_height = [&](uint32_t vertex) {
+        return min_height + (max_height - min_height) * (hs[vertex] / kQuantizedMax);
+    };
+
+    std::vector<float> heights(static_cast<size_t>(grid_size) * grid_size,
+                               std::numeric_limits<float>::quiet_NaN());
+    constexpr double kEdgeTolerance = 1e-9;
+    for (size_t t = 0; t < index_count; t += 3) {
+        const uint32_t a = indices[t];
+        const uint32_t b = indices[t + 1];
+        const uint32_t c = indices[t + 2];
+        const double ax = grid_x(a), ay = grid_y(a);
+        const double bx = grid_x(b), by = grid_y(b);
+        const double cx = grid_x(c), cy = grid_y(c);
+        const double area = (bx - ax) * (cy - ay) - (by - ay) * (cx - ax);
+        if (std::abs(area) < kEdgeTolerance) {
+            continue;
+        }
+
+        const auto first = [&](double lo) {
+            return static_cast<int64_t>(std::max(0.0, std::ceil(lo - kEdgeTolerance)));
+        };
+        const auto last = [&](double hi) {
+            return static_cast<int64_t>(std::min(scale, std::floor(hi + kEdgeTolerance)));
+        };
+        const int64_t x_begin = first(std::min({ax, bx, cx}));
+        const int64_t x_end = last(std::max({ax, bx, cx}));
+        const int64_t y_begin = first(std::min({ay, by, cy}));
+        const int64_t y_end = last(std::max({ay, by, cy}));
+
+        for (int64_t y = y_begin; y <= y_end; ++y) {
+            for (int64_t x = x_begin; x <= x_end; ++x) {
+                // Barycentric weights of the sample
+                const double wa = ((bx - x) * (cy - y) - (by - y) * (cx - x)) / area;
+                const double wb = ((cx - x) * (ay - y) - (cy - y) * (ax - x)) / area;
+                const double wc = 1.0 - wa - wb;
+                if (wa < -kEdgeTolerance || wb < -kEdgeTolerance || wc < -kEdgeTolerance) {
+                    continue;
+                }
+                heights[static_cast<size_t>(y) * grid_size + static_cast<size_t>(x)] =
+                    static_cast<float>(wa * vertex_height(a) + wb * vertex_height(b) +
+                                       wc * vertex_height(c));
+            }
+        }
+    }
+
+    // A well-formed mesh covers the whole tile; anything missed gets the minimum
+    for (float& height : heights) {
+        if (std::isnan(height)) {
+            height = min_height;
+        }
+    }
+    return std::make_unique<TerrainHeightmap>(coordinates, grid_size, grid_size,
+                                              std::move(heights), false);
+}
+
+namespace {
+
+using HeightmapPtr = std::shared_ptr<const TerrainHeightmap>;
+
+/// Region preload of elevation tiles
+using PreloadJob = RegionPreloadJob<TileCoordinates>;
+
+/// Elevation provider over XYZ elevation tiles
+class TerrainTileElevationProvider : public ElevationProvider {
+public:
+    TerrainTileElevationProvider(std::shared_ptr<TileLoader> loader,
+                                 const TerrainTileProviderConfig& config)
+        : loader_(std::move(loader)),
+          config_(config),
+          decoders_(ImageDecoderRegistry::CreateDefault()),
+          pool_(config.decode_threads) {
+        if (!loader_) {
+            throw std::invalid_argument("TileLoader cannot be null");
+        }
+        if (!config_.provider_name.empty() && !loader_->GetProvider(config_.provider_name)) {
+            throw std::invalid_argument("Unknown elevation tile provider: " +
+                                        config_.provider_name);
+        }
+        config_.max_zoom = std::clamp(config_.max_zoom, 0, 29);
+        config_.min_zoom = std::clamp(config_.min_zoom, 0, config_.max_zoom);
+        config_.tile_size = std::max(config_.tile_size, 1u);
+        config_.max_decoded_tiles = std::max<size_t>(config_.max_decoded_tiles, 1);
+        config_.preload_window = std::max<size_t>(config_.preload_window, 1);
+    }
+
+    ~TerrainTileElevationProvider() override {
+        // Load callbacks and decode tasks use this provider: let them finish
+        {
+            std::lock_guard<std::mutex> lock(preloads_mutex_);
+            for (const auto& preload : preloads_) {
+                if (const auto job = preload.lock()) {
+                    job->Cancel();
+                }
+            }
+        }
+        std::unique_lock<std::mutex> lock(in_flight_mutex_);
+        idle_.wait(lock, [this] { return in_flight_ == 0; });
+        lock.unlock();
+        pool_.Shutdown();
+    }
+
+    ElevationQuery GetElevation(double latitude, double longitude) const override {
+        return Sample({Geographic(latitude, longitude)}, config_.max_zoom).front();
+    }
+
+    std::vector<ElevationQuery> GetElevations(
+        const std::vector<Geographic>& points) const override {
+        return Sample(points, config_.max_zoom);
+    }
+
+    std::vector<ElevationQuery> GetElevations(
+        const std::vector<Geographic>& points,
+        double ground_resolution_meters) const override {
+        return Sample(points, SelectZoom(ground_resolution_meters));
+    }
+
+    size_t PreloadRegion(const GeographicBounds& bounds) override {
+        return PreloadRegionAsync(bounds, std::nullopt)->Wait();
+    }
+
+    std::shared_ptr<ElevationPreload> PreloadRegionAsync(
+        const GeographicBounds& bounds, const std::optional<Geographic>& focus) override {
+        const Geographic center((bounds.min.latitude + bounds.max.latitude) / 2.0,
+                                (bounds.min.longitude + bounds.max.longitude) / 2.0);
+        auto job = std::make_shared<PreloadJob>(GetRegionTiles(bounds, focus.value_or(center)));
+        {
+            std::lock_guard<std::mutex> lock(preloads_mutex_);
+            std::erase_if(preloads_, [](const auto& preload) { return preload.expired(); });
+            preloads_.push_back(job);
+        }
+        IssuePreloads(job, job->TakeNext(config_.preload_window));
+        return job;
+    }
+
+    bool IsAvailable(double latitude, double longitude) const override {
+        latitude = NormalizeLatitude(latitude);
+        longitude = NormalizeLongitude(longitude);
+        if (!IsValidCoordinate(latitude, longitude)) {
+            return false;
+        }
+        const auto position = LocateTerrainTile(config_.encoding, latitude, longitude,
+                                                config_.max_zoom);
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        return index_.count(position.tile) != 0;
+    }
+
+    ElevationCacheStats GetCacheStatistics() const override {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        return cache_stats_;
+    }
+
+    SRTMLoaderStats GetLoaderStatistics() const override {
+        // Download counters are the loader's, shared with its other providers
+        const TileLoaderStats tile_stats = loader_->GetStatistics();
+        SRTMLoaderStats stats;
+        stats.tiles_loaded = tiles_decoded_.load();
+        stats.tiles_failed = tiles_failed_.load();
+        stats.cache_hits = tile_stats.cached_requests;
+        stats.cache_misses = tile_stats.total_requests - tile_stats.cached_requests;
+        stats.bytes_downloaded = tile_stats.total_bytes_downloaded;
+        stats.average_load_time_ms = tile_stats.average_load_time_ms;
+        stats.pending_loads = decodes_.Size();
+        stats.coalesced_loads = decodes_.GetCoalescedCount();
+        return stats;
+    }
+
+    void ClearCache() override {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        lru_.clear();
+        index_.clear();
+        cache_stats_.memory_cache_size_bytes = 0;
+        cache_stats_.tile_count_memory = 0;
+    }
+
+    void SetMemoryCacheBudget(size_t bytes) override {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        max_decoded_bytes_ = bytes;
+        EvictToFit();
+    }
+
+private:
+    /// Sample points at a zoom: every tile is requested before any is
+    /// waited for, so downloads and decodes of a batch overlap
+    std::vector<ElevationQuery> Sample(const std::vector<Geographic>& points,
+                                       int32_t zoom) const {
+        std::vector<ElevationQuery> results(points.size());
+        std::vector<TerrainTilePosition> positions(points.size());
+        std::unordered_map<TileCoordinates, std::shared_future<HeightmapPtr>,
+                           TileCoordinatesHash> requests;
+
+        for (size_t i = 0; i < points.size(); ++i) {
+            ElevationQuery& result = results[i];
+            result.latitude = points[i].latitude;
+            result.longitude = points[i].longitude;
+
+            const double latitude = NormalizeLatitude(points[i].latitude);
+            const double longitude = NormalizeLongitude(points[i].longitude);
+            if (!IsValidCoordinate(latitude, longitude)) {
+                continue;
+            }
+            result.source_tile = GeographicToSRTMTile(latitude, longitude);
+            positions[i] = LocateTerrainTile(config_.encoding, latitude, longitude, zoom);
+            result.valid = true;  // Until its tile turns out unavailable
+
+            if (requests.count(positions[i].tile) == 0) {
+                requests.emplace(positions[i].tile, LoadTile(positions[i].tile));
+            }
+        }
+
+        std::unordered_map<TileCoordinates, HeightmapPtr, TileCoordinatesHash> tiles;
+        for (const auto& [coords, request] : requests) {
+            tiles.emplace(coords, request.get());
+        }
+
+        for (size_t i = 0; i < points.size(); ++i) {
+            ElevationQuery& result = results[i];
+            if (!result.valid) {
+                continue;
+            }
+            const auto& heightmap = tiles.at(positions[i].tile);
+            if (!heightmap) {
+                result.valid = false;
+                continue;
+            }
+            result.elevation_meters = heightmap->Sample(positions[i].u, positions[i].v);
+        }
+        return results;
+    }
+
+    /// Coarsest zoom whose sample spacing does not exceed a ground resolution
+    int32_t SelectZoom(double ground_resolution_meters) const noexcept {
+        for (int32_t zoom = config_.min_zoom; zoom < config_.max_zoom; ++zoom) {
+            const double spacing = kEarthCircumference /
+                                   (GetGridSize(config_.encoding, zoom).first *
+                                    static_cast<double>(config_.tile_size));
+            if (spacing <= ground_resolution_meters) {
+                return zoom;
+            }
+        }
+        return config_.max_zoom;
+    }
+
+    /// List the tiles covering a region at the query zoom, nearest @p focus first
+    std::vector<TileCoordinates> GetRegionTiles(const GeographicBounds& bounds,
+                                                const Geographic& focus) const {
+        if (!bounds.IsValid()) {
+            return {};
+        }
+
+        const int32_t zoom = config_.max_zoom;
+        const auto north_west = LocateTerrainTile(config_.encoding, bounds.max.latitude,
+                                                  bounds.min.longitude, zoom);
+        const auto south_east = LocateTerrainTile(config_.encoding, bounds.min.latitude,
+                                                  bounds.max.longitude, zoom);
+        const int32_t x_begin = std::min(north_west.tile.x, south_east.tile.x);
+        const int32_t x_end = std::max(north_west.tile.x, south_east.tile.x);
+        const int32_t y_begin = std::min(north_west.tile.y, south_east.tile.y);
+        const int32_t y_end = std::max(north_west.tile.y, south_east.tile.y);
+
+        // Distance in tile units from the focus to each tile center
+        const auto center = LocateTerrainTile(config_.encoding, focus.latitude,
+                                              focus.longitude, zoom);
+        const bool tms = config_.encoding == TerrainTileEncoding::QUANTIZED_MESH;
+        const double focus_x = center.tile.x + center.u;
+        const double focus_y = center.tile.y + (tms ? 1.0 - center.v : center.v);
+
+        std::vector<std::pair<double, TileCoordinates>> tiles;
+        for (int32_t y = y_begin; y <= y_end; ++y) {
+            for (int32_t x = x_begin; x <= x_end; ++x) {
+                const double dx = x + 0.5 - focus_x;
+                const double dy = y + 0.5 - focus_y;
+                tiles.emplace_back(dx * dx + dy * dy, TileCoordinates(x, y, zoom));
+            }
+        }
+        std::stable_sort(tiles.begin(), tiles.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        std::vector<TileCoordinates> result;
+        result.reserve(tiles.size());
+        for (const auto& tile : tiles) {
+            result.push_back(tile.second);
+        }
+        return result;
+    }
+
+    /// Start loads of reserved preload tiles; decoded tiles finish right
+    /// away and hand their slot to the next tile
+    void IssuePreloads(const std::shared_ptr<PreloadJob>& job,
+                       std::vector<TileCoordinates> batch) const {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            const TileCoordinates coords = batch[i];
+            if (FindDecoded(coords)) {
+                const auto next = job->FinishAndTakeNext(true, config_.preload_window);
+                batch.insert(batch.end(), next.begin(), next.end());
+                continue;
+            }
+            static_cast<void>(RequestTile(coords, [this, job](const HeightmapPtr& heightmap) {
+                auto next = job->FinishAndTakeNext(heightmap != nullptr, config_.preload_window);
+                if (!next.empty()) {
+                    IssuePreloads(job, std::move(next));
+                }
+            }));
+        }
+    }
+
+    /// Get a decoded tile, fetching and decoding it if needed
+    std::shared_future<HeightmapPtr> LoadTile(const TileCoordinates& coords) const {
+        if (auto heightmap = FindDecoded(coords)) {
+            std::promise<HeightmapPtr> ready;
+            ready.set_value(std::move(heightmap));
+            return ready.get_future().share();
+        }
+        return RequestTile(coords);
+    }
+
+    /// Fetch a tile through the loader and decode it on the pool; concurrent
+    /// requests for a tile share one fetch and decode
+    std::shared_future<HeightmapPtr> RequestTile(
+        const TileCoordinates& coords,
+        SingleFlight<TileCoordinates, HeightmapPtr, TileCoordinatesHash>::Listener listener =
+            nullptr) const {
+        auto call = decodes_.Join(coords, std::move(listener));
+        if (!call.leader) {
+            return call.future;
+        }
+
+        // The future is not needed: the callback completes the call
+        BeginWork();
+        static_cast<void>(loader_->LoadTileAsync(
+            coords,
+            [this, coords, id = call.id](const TileLoadResult& result) {
+                // Runs on the loader's I/O thread: only hand work to the pool
+                BeginWork();
+                if (!pool_.Submit([this, coords, id, result] {
+                        CompleteTile(coords, id, Decode(coords, result));
+                        EndWork();
+                    })) {
+                    CompleteTile(coords, id, nullptr);
+                    EndWork();
+                }
+                EndWork();
+            },
+            config_.provider_name));
+        return call.future;
+    }
+
+    /// Decode a fetched tile
+    HeightmapPtr Decode(const TileCoordinates& coords, const TileLoadResult& result) const {
+        if (!result.success || !result.tile_data) {
+            return nullptr;
+        }
+        const auto bytes = result.tile_data->data.Span();
+        if (config_.encoding == TerrainTileEncoding::QUANTIZED_MESH) {
+            return DecodeQuantizedMesh(coords, bytes, config_.tile_size + 1);
+        }
+        DecodedImage image;
+        if (!decoders_->Decode(bytes.data(), bytes.size(), image)) {
+            return nullptr;
+        }
+        return DecodeTerrainRGB(coords, image.pixels, image.width, image.height);
+    }
+
+    void CompleteTile(const TileCoordinates& coords, uint64_t id,
+                      const HeightmapPtr& heightmap) const {
+        if (heightmap) {
+            ++tiles_decoded_;
+            Insert(heightmap);
+        } else {
+            ++tiles_failed_;
+        }
+        decodes_.Complete(coords, id, heightmap);
+    }
+
+    /// Count a load callback or decode task the destructor must wait for
+    void BeginWork() const {
+        std::lock_guard<std::mutex> lock(in_flight_mutex_);
+        ++in_flight_;
+    }
+
+    /// Finish counted work; nothing may touch the provider afterwards
+    void EndWork() const {
+        std::lock_guard<std::mutex> lock(in_flight_mutex_);
+        if (--in_flight_ == 0) {
+            idle_.notify_all();
+        }
+    }
+
+    /// Look up a decoded tile and mark it recently used
+    HeightmapPtr FindDecoded(const TileCoordinates& coords) const {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        const auto it = index_.find(coords);
+        if (it == index_.end()) {
+            ++cache_stats_.cache_misses;
+            return nullptr;
+        }
+        ++cache_stats_.memory_cache_hits;
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return *it->second;
+    }
+
+    /// Add a decoded tile, evicting the least recently used ones
+    void Insert(const HeightmapPtr& heightmap) const {
+        std::lock_guard<std::mutex> lock(cache_mutex_);
+        const auto it = index_.find(heightmap->GetCoordinates());
+        if (it != index_.end()) {
+            cache_stats_.memory_cache_size_bytes -= (*it->second)->GetMemoryUsage();
+            lru_.erase(it->second);
+            index_.erase(it);
+        }
+        lru_.push_front(heightmap);
+        index_.emplace(heightmap->GetCoordinates(), lru_.begin());
+        cache_stats_.memory_cache_size_bytes += heightmap->GetMemoryUsage();
+        EvictToFit();
+    }
+
+    /// Evict least recently used tiles beyond the tile count and byte limits
+    /// (cache_mutex_ held)
+    void EvictToFit() const {
+        while (!lru_.empty() && (lru_.size() > config_.max_decoded_tiles ||
+                                 cache_stats_.memory_cache_size_bytes > max_decoded_bytes_)) {
+            cache_stats_.memory_cache_size_bytes -= lru_.back()->GetMemoryUsage();
+            index_.erase(lru_.back()->GetCoordinates());
+            lru_.pop_back();
+            ++cache_stats_.evictions;
+        }
+        cache_stats_.tile_count_memory = lru_.size();
+    }
+
+    std::shared_ptr<TileLoader> loader_;  // Thread-safe
+    TerrainTileProviderConfig config_;
+    std::unique_ptr<ImageDecoderRegistry> decoders_;  // Thread-safe
+    mutable DecodeThreadPool pool_;
+
+    /// Fetches and decodes in flight, shared by concurrent requesters
+    mutable SingleFlight<TileCoordinates, HeightmapPtr, TileCoordinatesHash> decodes_;
+
+    /// Load callbacks and decode tasks still running
+    mutable std::mutex in_flight_mutex_;
+    mutable std::condition_variable idle_;
+    mutable size_t in_flight_ = 0;
+
+    /// Decoded tiles, most recently used first
+    mutable std::mutex cache_mutex_;
+    mutable std::list<HeightmapPtr> lru_;
+    mutable std::unordered_map<TileCoordinates, std::list<HeightmapPtr>::iterator,
+                               TileCoordinatesHash> index_;
+    mutable ElevationCacheStats cache_stats_;
+    size_t max_decoded_bytes_ = std::numeric_limits<size_t>::max();  ///< SetMemoryCacheBudget(), on top of max_decoded_tiles
+
+    mutable std::atomic<uint64_t> tiles_decoded_{0};
+    mutable std::atomic<uint64_t> tiles_failed_{0};
+
+    std::mutex preloads_mutex_;
+    std::vector<std::weak_ptr<PreloadJob>> preloads_;
+};
+
+} // anonymous namespace
+
+std::shared_ptr<ElevationProvider> CreateTerrainTileElevationProvider(
+    std::shared_ptr<TileLoader> loader, const TerrainTileProviderConfig& config) {
+    return std::make_shared<TerrainTileElevationProvider>(std::move(loader), config);
+}
+
+} // namespace earth_map
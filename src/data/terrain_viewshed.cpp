@@ -0,0 +1,345 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#include <earth_map/data/terrain_viewshed.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+
+namespace earth_map {
+
+using namespace coordinates;
+namespace {
+
+/// WGS84 ellipsoid
+constexpr double kSemiMajorAxis = 6378137.0;
+constexpr double kEccentricitySquared = 6.69437999014e-3;
+
+/// Mean earth radius for the curvature correction
+constexpr double kMeanEarthRadius = 6371008.8;
+
+/// Largest supported raster radius in cells
+constexpr uint32_t kMaxRadiusCells = 32768;
+
+/// Sight lines traced per task in the parallel sweep
+constexpr size_t kRaysPerTask = 64;
+
+/// Raster rows sampled per elevation batch
+constexpr uint32_t kRowsPerBand = 64;
+
+/// Run fn(0) .. fn(count - 1) on up to @p threads threads (the caller included)
+template <typename Fn>
+void ParallelFor(size_t count, size_t threads, const Fn& fn) {
+    threads = std::min(threads, count);
+    if (threads <= 1) {
+        for (size_t i = 0; i < count; ++i) {
+            fn(i);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    const auto worker = [&]() {
+        for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1)) {
+            fn(i);
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (size_t t = 1; t < threads; ++t) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : workers) {
+        thread.join();
+    }
+}
+
+/// Meters per degree of latitude and longitude at a latitude
+[[nodiscard]] std::pair<double, double> MetersPerDegree(double latitude) noexcept {
+    const double phi = latitude * M_PI / 180.0;
+    const double sin_phi = std::sin(phi);
+    const double w = 1.0 - kEccentricitySquared * sin_phi * sin_phi;
+    const double meridian = kSemiMajorAxis * (1.0 - kEccentricitySquared) / (w * std::sqrt(w));
+    const double prime_vertical = kSemiMajorAxis / std::sqrt(w);
+    // Keep columns finite at the poles
+    const double cos_phi = std::max(std::cos(phi), 1e-9);
+    return {meridian * M_PI / 180.0, prime_vertical * cos_phi * M_PI / 180.0};
+}
+
+/// Perimeter cell (column, row offsets from the center) of sight line @p ray,
+/// clockwise from the north-west corner; every perimeter cell once
+[[nodiscard]] std::pair<int32_t, int32_t> PerimeterCell(int32_t ray, int32_t radius) noexcept {
+    const int32_t side = ray / (2 * radius);
+    const int32_t offset = ray % (2 * radius);
+    switch (side) {
+        case 0: return {-radius + offset, -radius};  // North edge, west to east
+        case 1: return {radius, -radius + offset};   // East edge, north to south
+        case 2: return {radius - offset, radius};    // South edge, east to west
+        default: return {-radius, radius - offset};  // West edge, south to north
+    }
+}
+
+/// Check if the sight line to perimeter minor @p end_minor is the one
+/// passing nearest the center of the cell @p minor across at step @p step:
+/// round(minor * radius / step) == end_minor, rounding halves away from zero
+[[nodiscard]] bool OwnsCell(int32_t end_minor, int32_t minor, int32_t step,
+                            int32_t radius) noexcept {
+    const int64_t twice_offset =
+        2 * (static_cast<int64_t>(end_minor) * step - static_cast<int64_t>(minor) * radius);
+    if (twice_offset == step) {
+        return minor > 0;
+    }
+    if (twice_offset == -step) {
+        return minor < 0;
+    }
+    return twice_offset < step && twice_offset > -step;
+}
+
+/// Sweep state shared by the sight lines
+struct Sweep {
+    std::span<const float> heights;
+    uint8_t* visible;
+    int32_t radius;
+    int32_t size;
+    double cell_size;
+    double observer_z;
+    double target_height;
+    double curvature;         ///< Height drop per squared meter of distance
+    int64_t max_distance_sq;  ///< In squared cells
+    std::span<const double> inverse_steps;  ///< 1 / t for steps 0..radius
+
+    [[nodiscard]] size_t Index(int32_t dx, int32_t dy) const noexcept {
+        return static_cast<size_t>(dy + radius) * size + (dx + radius);
+    }
+
+    /// Trace the sight line to perimeter cell (px, py), deciding the cells
+    /// it passes nearest the center of
+    void Trace(int32_t px, int32_t py) const noexcept {
+        // Steps along the major axis; corners belong to the x-major lines
+        const bool x_major = std::abs(px) == radius;
+        const int32_t major_sign = (x_major ? px : py) > 0 ? 1 : -1;
+        const int32_t end_minor = x_major ? py : px;
+
+        // Cells along the major and minor axes between steps
+        const ptrdiff_t major_stride = x_major ? major_sign : major_sign * size;
+        const ptrdiff_t minor_stride = x_major ? size : 1;
+
+        const double minor_per_step = static_cast<double>(end_minor) / radius;
+        const double meters_per_step = cell_size * std::sqrt(1.0 + minor_per_step * minor_per_step);
+        const double meters_to_steps = 1.0 / meters_per_step;
+        const double drop_per_step_sq = curvature * meters_per_step * meters_per_step;
+        const double cell_size_sq = cell_size * cell_size;
+
+        // Slopes are kept as rise per step so the horizon needs no division
+        // by distance: rise / step compares like rise / meters on one line
+        double horizon = -std::numeric_limits<double>::infinity();
+        const size_t center = Index(0, 0);
+        for (int32_t t = 1; t <= radius; ++t) {
+            if (static_cast<int64_t>(t) * t > max_distance_sq) {
+                break;
+            }
+            const double minor = minor_per_step * t;
+            const size_t column = center + major_stride * t;
+
+            // |minor| <= radius: truncating the shifted value floors it
+            // without a libm call
+            const int32_t floor_minor = static_cast<int32_t>(minor + radius) - radius;
+            const double weight = minor - floor_minor;
+
+            // Decide the cell nearest the line at this step if no other line
+            // passes nearer its center; diagonal cells go to x-major lines
+            const int32_t cell_minor = weight < 0.5 ? floor_minor : floor_minor + 1;
+            if ((x_major || std::abs(cell_minor) < t) &&
+                OwnsCell(end_minor, cell_minor, t, radius)) {
+                const int64_t distance_sq =
+                    static_cast<int64_t>(t) * t + static_cast<int64_t>(cell_minor) * cell_minor;
+                if (distance_sq <= max_distance_sq) {
+                    // Compare in the target's own metric: rise over its distance
+                    // against the horizon slope converted back to meters
+                    const double meters_sq = static_cast<double>(distance_sq) * cell_size_sq;
+                    const size_t cell = column + minor_stride * cell_minor;
+                    const double rise =
+                        heights[cell] + target_height - curvature * meters_sq - observer_z;
+                    if (rise >= horizon * meters_to_steps * std::sqrt(meters_sq)) {
+                        visible[cell] = 1;
+                    }
+                }
+            }
+
+            // Raise the horizon by the terrain where the line crosses this step
+            const size_t lower = column + minor_stride * floor_minor;
+            const size_t upper = floor_minor < radius ? lower + minor_stride : lower;
+            const double h = heights[lower] + (heights[upper] - heights[lower]) * weight;
+            const double rise = h - drop_per_step_sq * t * t - observer_z;
+            horizon = std::max(horizon, rise * inverse_steps[t]);
+        }
+    }
+};
+
+} // anonymous namespace
+
+ViewshedRaster::ViewshedRaster(const Geographic& observer, uint32_t radius_cells,
+                               double cell_size_meters, std::vector<uint64_t> bits)
+    : observer_(observer),
+      radius_cells_(radius_cells),
+      cell_size_meters_(cell_size_meters),
+      bits_(std::move(bits)) {
+    std::tie(meters_per_degree_latitude_, meters_per_degree_longitude_) =
+        MetersPerDegree(observer.latitude);
+    const size_t cells = static_cast<size_t>(GetSize()) * GetSize();
+    bits_.resize((cells + 63) / 64, 0);
+}
+
+bool ViewshedRaster::IsVisible(uint32_t column, uint32_t row) const noexcept {
+    const uint32_t size = GetSize();
+    if (column >= size || row >= size) {
+        return false;
+    }
+    const size_t index = static_cast<size_t>(row) * size + column;
+    return (bits_[index / 64] >> (index % 64)) & 1;
+}
+
+bool ViewshedRaster::IsVisibleAt(double latitude, double longitude) const noexcept {
+    uint32_t column = 0;
+    uint32_t row = 0;
+    return FindCell(latitude, longitude, column, row) && IsVisible(column, row);
+}
+
+size_t ViewshedRaster::CountVisible() const noexcept {
+    size_t count = 0;
+    for (const uint64_t word : bits_) {
+        count += static_cast<size_t>(std::popcount(word));
+    }
+    return count;
+}
+
+Geographic ViewshedRaster::GetCellCenter(uint32_t column, uint32_t row) const noexcept {
+    const double east = (static_cast<double>(column) - radius_cells_) * cell_size_meters_;
+    const double north = (static_cast<double>(radius_cells_) - row) * cell_size_meters_;
+    return Geographic(NormalizeLatitude(observer_.latitude + north / meters_per_degree_latitude_),
+                      NormalizeLongitude(observer_.longitude + east / meters_per_degree_longitude_),
+                      0.0);
+}
+
+bool ViewshedRaster::FindCell(double latitude, double longitude,
+                              uint32_t& column, uint32_t& row) const noexcept {
+    const double north = (latitude - observer_.latitude) * meters_per_degree_latitude_;
+    const double east =
+        NormalizeLongitude(longitude - observer_.longitude) * meters_per_degree_longitude_;
+    const double x = std::round(east / cell_size_meters_) + radius_cells_;
+    const double y = radius_cells_ - std::round(north / cell_size_meters_);
+    const double size = GetSize();
+    if (!(x >= 0.0 && x < size && y >= 0.0 && y < size)) {
+        return false;
+    }
+    column = static_cast<uint32_t>(x);
+    row = static_cast<uint32_t>(y);
+    return true;
+}
+
+uint32_t GetViewshedRadiusCells(const ViewshedConfig& config) {
+    if (!(config.cell_size_meters > 0.0) || !(config.max_distance_meters > 0.0)) {
+        throw std::invalid_argument("Viewshed cell size and distance must be positive");
+    }
+    const double radius = std::ceil(config.max_distance_meters / config.cell_size_meters);
+    if (radius > kMaxRadiusCells) {
+        throw std::invalid_argument("Viewshed raster too large for its cell size");
+    }
+    return static_cast<uint32_t>(radius);
+}
+
+ViewshedRaster ComputeViewshed(std::span<const float> heights, const Geographic& observer,
+                               const ViewshedConfig& config) {
+    const uint32_t radius = GetViewshedRadiusCells(config);
+    const uint32_t size = 2 * radius + 1;
+    const size_t cells = static_cast<size_t>(size) * size;
+    if (heights.size() != cells) {
+        throw std::invalid_argument("Viewshed height grid does not match the radius");
+    }
+
+    // One byte per cell: sight lines on different threads decide
+    // neighboring cells, which would share bitmask words
+    std::vector<uint8_t> visible(cells, 0);
+    visible[static_cast<size_t>(radius) * size + radius] = 1;
+
+    const double max_distance_cells = config.max_distance_meters / config.cell_size_meters;
+    Sweep sweep;
+    sweep.heights = heights;
+    sweep.visible = visible.data();
+    sweep.radius = static_cast<int32_t>(radius);
+    sweep.size = static_cast<int32_t>(size);
+    sweep.cell_size = config.cell_size_meters;
+    sweep.observer_z = heights[static_cast<size_t>(radius) * size + radius] +
+                       config.observer_height_meters;
+    sweep.target_height = config.target_height_meters;
+    sweep.curvature = config.earth_curvature
+        ? (1.0 - config.refraction_coefficient) / (2.0 * kMeanEarthRadius)
+        : 0.0;
+    sweep.max_distance_sq = static_cast<int64_t>(std::floor(max_distance_cells * max_distance_cells));
+
+    std::vector<double> inverse_steps(radius + 1, 0.0);
+    for (uint32_t t = 1; t <= radius; ++t) {
+        inverse_steps[t] = 1.0 / t;
+    }
+    sweep.inverse_steps = inverse_steps;
+
+    const size_t hardware_threads =
+        std::max<size_t>(1, std::thread::hardware_concurrency());
+    const size_t threads = config.max_threads > 0 ? config.max_threads : hardware_threads;
+
+    // Consecutive sight lines form a sector and touch neighboring cells
+    const size_t rays = 8 * static_cast<size_t>(radius);
+    ParallelFor((rays + kRaysPerTask - 1) / kRaysPerTask, threads, [&](size_t task) {
+        const size_t end = std::min(rays, (task + 1) * kRaysPerTask);
+        for (size_t ray = task * kRaysPerTask; ray < end; ++ray) {
+            const auto [px, py] = PerimeterCell(static_cast<int32_t>(ray), sweep.radius);
+            sweep.Trace(px, py);
+        }
+    });
+
+    std::vector<uint64_t> bits((cells + 63) / 64, 0);
+    for (size_t i = 0; i < cells; ++i) {
+        bits[i / 64] |= static_cast<uint64_t>(visible[i]) << (i % 64);
+    }
+    return ViewshedRaster(observer, radius, config.cell_size_meters, std::move(bits));
+}
+
+ViewshedRaster ComputeViewshed(const ElevationProvider& provider, const Geographic& observer,
+                               const ViewshedConfig& config) {
+    const uint32_t radius = GetViewshedRadiusCells(config);
+    const uint32_t size = 2 * radius + 1;
+
+    // Cell centers of the raster, before any bits are known
+    const ViewshedRaster grid(observer, radius, config.cell_size_meters, {});
+
+    std::vector<float> heights(static_cast<size_t>(size) * size);
+    std::vector<Geographic> points;
+    for (uint32_t band = 0; band < size; band += kRowsPerBand) {
+        const uint32_t band_end = std::min(size, band + kRowsPerBand);
+        points.clear();
+        points.reserve(static_cast<size_t>(band_end - band) * size);
+        for (uint32_t row = band; row < band_end; ++row) {
+            for (uint32_t column = 0; column < size; ++column) {
+                points.push_back(grid.GetCellCenter(column, row));
+            }
+        }
+        const std::vector<ElevationQuery> results =
+            provider.GetElevations(points, config.cell_size_meters);
+        float* out = heights.data() + static_cast<size_t>(band) * size;
+        for (size_t i = 0; i < results.size() && i < points.size(); ++i) {
+            out[i] = results[i].valid ? results[i].elevation_meters : 0.0f;
+        }
+    }
+
+    return ComputeViewshed(heights, observer, config);
+}
+
+} // namespace earth_map
@@ -0,0 +1,193 @@
+/**
+ * @file tile_access_histogram.cpp
+ * @brief Implementation of the persistent tile access histogram
+ */
+
+#include <earth_map/data/tile_access_histogram.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace earth_map {
+
+namespace {
+
+constexpr std::uint32_t kHistogramMagic = 0x48414D45;  // "EMAH"
+constexpr std::uint32_t kHistogramVersion = 1;
+constexpr const char* kHistogramName = "access_histogram.bin";
+
+struct HistogramHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint64_t count;
+};
+static_assert(sizeof(HistogramHeader) == 16, "HistogramHeader layout must stay stable");
+
+struct HistogramRecord {
+    std::int32_t x;
+    std::int32_t y;
+    std::int32_t zoom;
+    float score;
+};
+static_assert(sizeof(HistogramRecord) == 16, "HistogramRecord layout must stay stable");
+
+bool Hotter(const std::pair<TileCoordinates, float>& a,
+            const std::pair<TileCoordinates, float>& b) {
+    // Ties broken by coordinates so the order is stable across runs
+    if (a.second != b.second) {
+        return a.second > b.second;
+    }
+    return a.first < b.first;
+}
+
+} // namespace
+
+TileAccessHistogram::TileAccessHistogram(const std::string& directory, float decay,
+                                         std::size_t max_tiles)
+    : path_(directory + "/" + kHistogramName)
+    , decay_(std::clamp(decay, 0.0f, 1.0f))
+    , max_tiles_(max_tiles) {
+}
+
+bool TileAccessHistogram::Load() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    counts_.clear();
+
+    std::ifstream file(path_, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    const std::streamsize size = file.tellg();
+    std::vector<std::uint8_t> bytes(static_cast<std::size_t>(std::max<std::streamsize>(size, 0)));
+    file.seekg(0);
+    if (bytes.size() < sizeof(HistogramHeader) ||
+        !file.read(reinterpret_cast<char*>(bytes.data()), size)) {
+        return false;
+    }
+
+    HistogramHeader header;
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    const std::size_t body = bytes.size() - sizeof(header);
+    if (header.magic != kHistogramMagic || header.version != kHistogramVersion ||
+        body != header.count * sizeof(HistogramRecord)) {
+        spdlog::warn("Ignoring unreadable tile access histogram {}", path_);
+        return false;
+    }
+
+    counts_.reserve(header.count);
+    for (std::size_t i = 0; i < header.count; ++i) {
+        HistogramRecord record;
+        std::memcpy(&record, bytes.data() + sizeof(header) + i * sizeof(record), sizeof(record));
+        if (record.score > 0.0f) {
+            counts_[TileCoordinates(record.x, record.y, record.zoom)].past_score = record.score;
+        }
+    }
+    return true;
+}
+
+void TileAccessHistogram::Record(const TileCoordinates& coords) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++counts_[coords].session_hits;
+}
+
+std::vector<TileCoordinates> TileAccessHistogram::GetHottest(std::size_t max_count) const {
+    std::vector<std::pair<TileCoordinates, float>> scored;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        scored.reserve(counts_.size());
+        for (const auto& [coords, counts] : counts_) {
+            scored.emplace_back(coords, counts.past_score + static_cast<float>(counts.session_hits));
+        }
+    }
+
+    const std::size_t count = std::min(max_count, scored.size());
+    std::partial_sort(scored.begin(), scored.begin() + static_cast<std::ptrdiff_t>(count),
+                      scored.end(), Hotter);
+
+    std::vector<TileCoordinates> hottest;
+    hottest.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        hottest.push_back(scored[i].first);
+    }
+    return hottest;
+}
+
+float TileAccessHistogram::GetScore(const TileCoordinates& coords) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = counts_.find(coords);
+    if (it == counts_.end()) {
+        return 0.0f;
+    }
+    return it->second.past_score + static_cast<float>(it->second.session_hits);
+}
+
+std::vector<std::pair<TileCoordinates, float>> TileAccessHistogram::FoldLocked() const {
+    std::vector<std::pair<TileCoordinates, float>> folded;
+    folded.reserve(counts_.size());
+    for (const auto& [coords, counts] : counts_) {
+        const float score = counts.past_score * decay_ + static_cast<float>(counts.session_hits);
+        if (score >= kMinScore) {
+            folded.emplace_back(coords, score);
+        }
+    }
+
+    if (folded.size() > max_tiles_) {
+        std::nth_element(folded.begin(), folded.begin() + static_cast<std::ptrdiff_t>(max_tiles_),
+                         folded.end(), Hotter);
+        folded.resize(max_tiles_);
+    }
+    std::sort(folded.begin(), folded.end(), Hotter);
+    return folded;
+}
+
+bool TileAccessHistogram::Save() const {
+    std::vector<std::uint8_t> bytes;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto folded = FoldLocked();
+        bytes.resize(sizeof(HistogramHeader) + folded.size() * sizeof(HistogramRecord));
+        const HistogramHeader header{kHistogramMagic, kHistogramVersion, folded.size()};
+        std::memcpy(bytes.data(), &header, sizeof(header));
+        std::size_t offset = sizeof(header);
+        for (const auto& [coords, score] : folded) {
+            const HistogramRecord record{coords.x, coords.y, coords.zoom, score};
+            std::memcpy(bytes.data() + offset, &record, sizeof(record));
+            offset += sizeof(record);
+        }
+    }
+
+    // Replaced atomically: a crash leaves the previous session's histogram
+    const std::string temp_path = path_ + ".tmp";
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        if (!file.write(reinterpret_cast<const char*>(bytes.data()),
+                        static_cast<std::streamsize>(bytes.size()))) {
+            spdlog::warn("Failed to write tile access histogram {}", temp_path);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temp_path, path_, error);
+    if (error) {
+        std::filesystem::remove(temp_path, error);
+        return false;
+    }
+    return true;
+}
+
+void TileAccessHistogram::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    counts_.clear();
+    std::error_code error;
+    std::filesystem::remove(path_, error);
+}
+
+std::size_t TileAccessHistogram::GetCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return counts_.size();
+}
+
+} // namespace earth_map
@@ -4,27 +4,99 @@
  */
 
 #include <earth_map/data/tile_cache.h>
+#include <earth_map/data/crc32c.h>
+#include <earth_map/data/disk_cache_collector.h>
+#include <earth_map/data/disk_cache_manifest.h>
+#include <earth_map/data/tile_access_histogram.h>
+#include <earth_map/data/tile_memory_cache.h>
+#include <earth_map/data/tile_compression.h>
+#include <earth_map/data/packed_tile_store.h>
+#include <earth_map/data/tile_write_behind_queue.h>
 #include <earth_map/math/tile_mathematics.h>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
 #include <fstream>
 #include <filesystem>
-#include <mutex>
+#include <shared_mutex>
 #include <sstream>
 #include <iomanip>
+#include <mutex>
 #include <random>
+#include <thread>
 #include <spdlog/spdlog.h>
 
 namespace earth_map {
 
+namespace {
+
+/// Disk victim order of an eviction strategy
+DiskCacheManifest::VictimOrder ToVictimOrder(TileCacheConfig::EvictionStrategy strategy) {
+    switch (strategy) {
+        case TileCacheConfig::EvictionStrategy::SIZE_BASED:
+            return DiskCacheManifest::VictimOrder::LARGEST;
+        case TileCacheConfig::EvictionStrategy::TIME_BASED:
+            return DiskCacheManifest::VictimOrder::OLDEST_MODIFIED;
+        case TileCacheConfig::EvictionStrategy::LRU:
+        case TileCacheConfig::EvictionStrategy::LFU:  // No disk hit counts: fall back to LRU
+        default:
+            return DiskCacheManifest::VictimOrder::LEAST_RECENTLY_ACCESSED;
+    }
+}
 
+} // namespace
 
 /**
  * @brief Basic tile cache implementation
+ *
+ * Memory tier is a ShardedTileMemoryCache (per-shard locks) bounded by both
+ * max_memory_cache_size and max_tile_count, evicting per eviction_strategy.
+ * Disk I/O never runs under a lock: files are written to a temporary name
+ * and renamed into place, so concurrent readers see either the old or the
+ * new file, and recorded in a DiskCacheManifest so size accounting, cleanup
+ * and eviction never scan the directory. With DiskBackend::PACKED the disk
+ * tier is a PackedTileStore; shared_disk_cache opens it in shared mode so
+ * several processes use one cache.
+ * Tiles may be stored compressed in memory (memory_compression) and on disk
+ * (default_compression, optionally with a zstd dictionary); callers always
+ * receive raw bytes.
+ * With enable_write_behind, disk writes and removals are queued on a
+ * TileWriteBehindQueue and Put returns after updating the memory tier;
+ * lookups consult the queue before disk so pending tiles stay visible.
+ * With enable_background_cleanup, a DiskCacheCollector thread enforces the
+ * disk budget and TTL of the file backend; writers only wake it.
+ * With enable_access_histogram, hits are counted in a TileAccessHistogram
+ * saved beside the disk index; enable_warmup then promotes the hottest
+ * tiles of past sessions from disk into memory on a background thread
+ * after Initialize, within the warm-up time and memory budgets.
  */
 class BasicTileCache : public TileCache {
 public:
-    explicit BasicTileCache(const TileCacheConfig& config) : config_(config) {}
-    ~BasicTileCache() override = default;
+    explicit BasicTileCache(const TileCacheConfig& config)
+        : config_(config)
+        , memory_(config.max_memory_cache_size,
+                  ShardedTileMemoryCache::kDefaultShardCount,
+                  config.eviction_strategy) {
+        memory_.SetMaxCount(config.max_tile_count);
+        write_behind_enabled_ = config.enable_write_behind;
+        write_behind_ = std::make_unique<TileWriteBehindQueue>(
+            config.write_behind_queue_size,
+            [this](const std::vector<TileDiskOp>& batch) { WriteBatch(batch); });
+    }
+    ~BasicTileCache() override {
+        StopWarmUp();
+        if (auto histogram = GetHistogram()) {
+            histogram->Save();
+        }
+        // The collector deletes through this object; stop it first
+        if (auto collector = GetDiskCollector()) {
+            collector->Stop();
+        }
+        // Flush-on-shutdown: persist everything queued while the disk tier is alive
+        write_behind_.reset();
+    }
     
     bool Initialize(const TileCacheConfig& config) override;
     bool Put(const TileData& tile_data) override;
@@ -39,9 +111,10 @@ public:
     std::shared_ptr<TileMetadata> GetMetadata(
         const TileCoordinates& coordinates) const override;
     std::size_t Cleanup() override;
+    void Flush() override;
     
     TileCacheConfig GetConfiguration() const override {
-        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        std::shared_lock<std::shared_mutex> lock(config_mutex_);
         return config_;
     }
     bool SetConfiguration(const TileCacheConfig& config) override;
@@ -51,43 +124,117 @@ public:
         const BoundingBox2D& bounds) const override;
     std::vector<TileCoordinates> GetTilesAtZoom(
         std::uint8_t zoom_level) const override;
+    std::vector<TileCoordinates> GetHottestTiles(std::size_t max_count) const override;
 
 private:
-    // Coarse-grained lock protecting all mutable state. The LRU implementation
-    // (vector + index map) is O(n) per access and should be replaced with
-    // std::list + iterator map for O(1) when the cache is redesigned for
-    // texture streaming. For now this mutex prevents the data races.
-    mutable std::recursive_mutex mutex_;
+    /**
+     * @brief Request counters (lock-free, snapshotted into TileCacheStats)
+     */
+    struct AtomicStats {
+        std::atomic<std::size_t> memory_cache_hits{0};
+        std::atomic<std::size_t> memory_cache_misses{0};
+        std::atomic<std::size_t> disk_cache_hits{0};
+        std::atomic<std::size_t> disk_cache_misses{0};
+        std::atomic<std::size_t> total_requests{0};
+        std::atomic<std::size_t> total_corruptions{0};
+        std::atomic<std::size_t> warmup_tiles{0};
+        std::atomic<std::uint64_t> evictions_at_reset{0};
+        std::atomic<std::uint64_t> memory_raw_bytes{0};
+        std::atomic<std::uint64_t> memory_stored_bytes{0};
+        std::atomic<std::uint64_t> disk_raw_bytes{0};
+        std::atomic<std::uint64_t> disk_stored_bytes{0};
 
+        void Reset(std::uint64_t current_evictions) {
+            memory_cache_hits = 0;
+            memory_cache_misses = 0;
+            disk_cache_hits = 0;
+            disk_cache_misses = 0;
+            total_requests = 0;
+            total_corruptions = 0;
+            warmup_tiles = 0;
+            evictions_at_reset = current_evictions;
+            memory_raw_bytes = 0;
+            memory_stored_bytes = 0;
+            disk_raw_bytes = 0;
+            disk_stored_bytes = 0;
+        }
+    };
+
+    /// Guards config_ only; never held during I/O
+    mutable std::shared_mutex config_mutex_;
     TileCacheConfig config_;
-    TileCacheStats stats_;
-    
-    // Memory cache
-    std::unordered_map<TileCoordinates, std::shared_ptr<TileData>, 
-                      TileCoordinatesHash> memory_cache_;
-    std::unordered_map<TileCoordinates, std::shared_ptr<TileMetadata>, 
-                      TileCoordinatesHash> metadata_cache_;
-    
-    // LRU tracking
-    mutable std::vector<TileCoordinates> lru_list_;
-    mutable std::unordered_map<TileCoordinates, std::size_t, TileCoordinatesHash> lru_index_;
-    
+
+    AtomicStats stats_;
+
+    /// Sharded memory tier (tiles, metadata, LRU); const lookups may fill it
+    mutable ShardedTileMemoryCache memory_;
+
+    /// Suffix source for temporary files of concurrent writers
+    mutable std::atomic<std::uint64_t> temp_file_counter_{0};
+
+    /// Held by the one caller evicting inline; others leave the budget to it
+    std::mutex eviction_mutex_;
+
+    /// Packed disk backend (null for DiskBackend::FILES); guarded by config_mutex_
+    std::shared_ptr<PackedTileStore> packed_store_;
+
+    /// Index of tile files (null for DiskBackend::PACKED); guarded by config_mutex_
+    std::shared_ptr<DiskCacheManifest> manifest_;
+
+    /// Dictionary for ZSTD disk compression (may be null); guarded by config_mutex_
+    std::shared_ptr<const ZstdDictionary> zstd_dictionary_;
+
+    /// Background size and TTL enforcement (null unless enabled with a manifest); guarded by config_mutex_
+    std::shared_ptr<DiskCacheCollector> disk_collector_;
+
+    /// Per-tile hit counts across sessions (null unless enabled); guarded by config_mutex_
+    std::shared_ptr<TileAccessHistogram> histogram_;
+
+    /// Promotes the hottest tiles from disk after Initialize
+    std::thread warmup_thread_;
+    std::atomic<bool> warmup_stop_{false};
+
+    /// Queue disk operations instead of performing them inline
+    std::atomic<bool> write_behind_enabled_{true};
+
+    /// Background disk writer (declared last: its destructor drains into the members above)
+    std::unique_ptr<TileWriteBehindQueue> write_behind_;
+
+    void WriteBatch(const std::vector<TileDiskOp>& batch);
+    bool ContainsOnDisk(const TileCoordinates& coordinates) const;
+    bool RemoveFromDisk(const TileCoordinates& coordinates) const;
+    std::shared_ptr<PackedTileStore> GetPackedStore() const;
+    std::shared_ptr<DiskCacheManifest> GetManifest() const;
+    std::shared_ptr<DiskCacheCollector> GetDiskCollector() const;
+    std::shared_ptr<TileAccessHistogram> GetHistogram() const;
+    void RecordAccess(const TileCoordinates& coordinates);
+    void StopWarmUp();
+    void RunWarmUp(const TileAccessHistogram& histogram, const TileCacheConfig& config);
+    std::shared_ptr<DiskCacheCollector> MakeDiskCollector(
+        std::shared_ptr<DiskCacheManifest> manifest, const TileCacheConfig& config);
+    std::vector<std::pair<TileCoordinates, DiskCacheManifest::Entry>> ScanDiskDirectory() const;
+    void EnforceDiskBudget();
+    std::string GetDiskDirectory() const;
     std::string GetTileFilePath(const TileCoordinates& coordinates) const;
     std::string GetMetadataFilePath(const TileCoordinates& coordinates) const;
-    std::vector<std::uint8_t> CompressData(const std::vector<std::uint8_t>& data,
-                                           TileMetadata::Compression type) const;
-    std::vector<std::uint8_t> DecompressData(const std::vector<std::uint8_t>& data,
-                                             TileMetadata::Compression type) const;
-    std::uint32_t CalculateChecksum(const std::vector<std::uint8_t>& data) const;
+    std::optional<std::vector<std::uint8_t>> CompressData(std::span<const std::uint8_t> data,
+                                                          TileMetadata::Compression type) const;
+    std::optional<std::vector<std::uint8_t>> DecompressData(std::span<const std::uint8_t> data,
+                                                            TileMetadata::Compression type) const;
+    std::shared_ptr<const TileData> ToMemoryTile(std::shared_ptr<TileData> tile);
+    std::optional<TileData> Materialize(const TileData& tile) const;
+    std::optional<TileData> ToDiskTile(const TileData& tile);
+    bool PersistTile(const TileData& tile);
+    std::uint32_t CalculateChecksum(std::span<const std::uint8_t> data) const;
+    std::string MakeTempPath(const std::string& final_path) const;
+    bool CommitTempFile(const std::string& temp_path, const std::string& final_path) const;
     bool SaveTileToDisk(const TileData& tile_data) const;
     std::unique_ptr<TileData> LoadTileFromDisk(const TileCoordinates& coordinates) const;
+    std::unique_ptr<TileData> LoadVerifiedTileFromDisk(const TileCoordinates& coordinates);
     bool SaveMetadataToDisk(const TileMetadata& metadata) const;
     std::unique_ptr<TileMetadata> LoadMetadataFromDisk(const TileCoordinates& coordinates) const;
-    void UpdateLRU(const TileCoordinates& coordinates) const;
-    void EvictFromMemory(std::size_t required_space);
-    void EvictFromDisk(std::size_t required_space);
+    void EvictFromDisk();
     bool IsTileExpired(const TileMetadata& metadata) const;
-    std::size_t CalculateCurrentMemoryUsage() const;
     std::size_t CalculateCurrentDiskUsage() const;
 };
 
@@ -97,24 +244,110 @@ std::unique_ptr<TileCache> CreateTileCache(const TileCacheConfig& config) {
 }
 
 bool BasicTileCache::Initialize(const TileCacheConfig& config) {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    config_ = config;
-    stats_.Reset();
+    // The warm-up reads the previous disk tier; its histogram is saved there
+    StopWarmUp();
+    if (auto histogram = GetHistogram()) {
+        histogram->Save();
+    }
+    // Queued writes belong to the previous disk tier
+    write_behind_->Flush();
+    // So do the previous collector's victims
+    if (auto collector = GetDiskCollector()) {
+        collector->Stop();
+    }
+    {
+        std::unique_lock<std::shared_mutex> lock(config_mutex_);
+        config_ = config;
+    }
+    write_behind_enabled_ = config.enable_write_behind;
+    memory_.SetEvictionStrategy(config.eviction_strategy);
+    memory_.SetMaxCount(config.max_tile_count);
+    memory_.SetMaxBytes(config.max_memory_cache_size);
+    stats_.Reset(memory_.GetEvictionCount());
     
     // Create disk cache directory if it doesn't exist
     try {
-        std::filesystem::create_directories(config_.disk_cache_directory);
+        std::filesystem::create_directories(config.disk_cache_directory);
+        
+        std::shared_ptr<PackedTileStore> packed_store;
+        std::shared_ptr<DiskCacheManifest> manifest;
+        if (config.disk_backend == TileCacheConfig::DiskBackend::PACKED ||
+            config.shared_disk_cache) {
+            PackedTileStoreConfig store_config;
+            store_config.directory = config.disk_cache_directory + "/packed";
+            store_config.segment_size = config.packed_segment_size;
+            store_config.shared = config.shared_disk_cache;
+            packed_store = std::make_shared<PackedTileStore>(store_config);
+            if (!packed_store->Open()) {
+                spdlog::error("Failed to open packed tile store in {}", store_config.directory);
+                return false;
+            }
+        } else {
+            // Create subdirectories for different zoom levels
+            for (int zoom = 0; zoom <= 20; ++zoom) {
+                std::filesystem::create_directories(
+                    config.disk_cache_directory + "/" + std::to_string(zoom));
+            }
+            
+            // One read of the manifest; only a cache without one is scanned (once)
+            manifest = std::make_shared<DiskCacheManifest>(config.disk_cache_directory);
+            manifest->SetVictimOrder(ToVictimOrder(config.eviction_strategy));
+            if (!manifest->Load()) {
+                manifest->Reset(ScanDiskDirectory());
+                spdlog::info("Rebuilt disk cache manifest: {} tiles", manifest->GetCount());
+            }
+        }
         
-        // Create subdirectories for different zoom levels
-        for (int zoom = 0; zoom <= 20; ++zoom) {
-            std::filesystem::create_directories(
-                config_.disk_cache_directory + "/" + std::to_string(zoom));
+        std::shared_ptr<const ZstdDictionary> dictionary;
+        if (!config.zstd_dictionary_path.empty()) {
+            std::ifstream file(config.zstd_dictionary_path, std::ios::binary);
+            std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)),
+                                            std::istreambuf_iterator<char>());
+            dictionary = ZstdDictionary::FromBytes(std::move(bytes));
+            if (!dictionary) {
+                spdlog::warn("Could not load zstd dictionary {}", config.zstd_dictionary_path);
+            }
+        }
+        if (config.enable_compression && !IsCompressionAvailable(config.default_compression)) {
+            spdlog::info("Disk compression codec not built in; storing tiles uncompressed");
+        }
+        std::shared_ptr<DiskCacheCollector> collector;
+        if (manifest && config.enable_background_cleanup) {
+            collector = MakeDiskCollector(manifest, config);
+        }
+        std::shared_ptr<TileAccessHistogram> histogram;
+        if (config.enable_access_histogram) {
+            histogram = std::make_shared<TileAccessHistogram>(
+                config.disk_cache_directory, config.access_histogram_decay,
+                config.access_histogram_max_tiles);
+            histogram->Load();
+        }
+        {
+            std::unique_lock<std::shared_mutex> lock(config_mutex_);
+            packed_store_.swap(packed_store);
+            manifest_.swap(manifest);
+            zstd_dictionary_.swap(dictionary);
+            disk_collector_.swap(collector);
+            histogram_.swap(histogram);
+        }
+        // Started once installed: its deletions go through the new disk tier
+        if (auto installed = GetDiskCollector()) {
+            installed->Start();
+        }
+        // Likewise the warm-up reads through it
+        if (auto installed = GetHistogram(); installed && config.enable_warmup &&
+                                             installed->GetCount() > 0) {
+            warmup_stop_ = false;
+            warmup_thread_ = std::thread([this, installed, config] {
+                RunWarmUp(*installed, config);
+            });
         }
         
-        spdlog::info("Tile cache initialized. Memory: {}MB, Disk: {}MB, Directory: {}",
-                     config_.max_memory_cache_size / (1024 * 1024),
-                     config_.max_disk_cache_size / (1024 * 1024),
-                     config_.disk_cache_directory);
+        spdlog::info("Tile cache initialized. Memory: {}MB, Disk: {}MB, Directory: {}, {} shards",
+                     config.max_memory_cache_size / (1024 * 1024),
+                     config.max_disk_cache_size / (1024 * 1024),
+                     config.disk_cache_directory,
+                     memory_.GetShardCount());
         
         return true;
     } catch (const std::exception& e) {
@@ -124,7 +357,6 @@ bool BasicTileCache::Initialize(const TileCacheConfig& config) {
 }
 
 bool BasicTileCache::Put(const TileData& tile_data) {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
     if (!tile_data.IsValid()) {
         spdlog::warn("Attempted to store invalid tile data");
         return false;
@@ -133,72 +365,88 @@ bool BasicTileCache::Put(const TileData& tile_data) {
     const auto& coords = tile_data.metadata.coordinates;
     stats_.total_requests++;
 
-    // Update metadata
-    metadata_cache_[coords] = std::make_shared<TileMetadata>(tile_data.metadata);
-    SaveMetadataToDisk(tile_data.metadata);
+    auto tile = std::make_shared<TileData>(tile_data);
+    if (tile->metadata.checksum == 0 && GetConfiguration().enable_integrity_check) {
+        // Downloaded tiles arrive with a checksum; fill it in for everything else
+        tile->metadata.checksum = CalculateChecksum(tile->data);
+    }
 
-    // Store in memory cache
-    auto data_copy = std::make_shared<TileData>(tile_data);
-    memory_cache_[coords] = data_copy;
+    // Update metadata
+    memory_.PutMetadata(std::make_shared<TileMetadata>(tile->metadata));
 
-    // Update LRU
-    UpdateLRU(coords);
+    // Store in memory cache (evicts per eviction_strategy if over budget)
+    std::shared_ptr<const TileData> shared_tile = ToMemoryTile(std::move(tile));
+    memory_.Put(shared_tile);
 
-    // Update statistics
-    stats_.memory_cache_size += tile_data.GetDataSize();
-    stats_.memory_cache_count++;
+    if (write_behind_enabled_) {
+        // Shares the memory tier's copy; blocks only if the queue is full
+        write_behind_->Enqueue(TileDiskOp{TileDiskOp::Kind::WRITE_TILE, coords,
+                                          std::move(shared_tile), nullptr});
+        return true;
+    }
 
-    // Save to disk cache as well
-    if (!SaveTileToDisk(tile_data)) {
+    // Disk writes happen without any lock held
+    if (!PersistTile(*shared_tile)) {
         spdlog::warn("Failed to save tile to disk cache: {}/{}/{}",
                      coords.x, coords.y, coords.zoom);
     }
-
-    // Check if we need to evict from memory
-    std::size_t current_usage = CalculateCurrentMemoryUsage();
-    if (current_usage > config_.max_memory_cache_size) {
-        EvictFromMemory(current_usage - config_.max_memory_cache_size);
-    }
+    EnforceDiskBudget();
 
     return true;
 }
 
 std::optional<TileData> BasicTileCache::Get(const TileCoordinates& coordinates) {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
     stats_.total_requests++;
 
-    // First try memory cache
-    auto it = memory_cache_.find(coordinates);
-    if (it != memory_cache_.end()) {
-        stats_.memory_cache_hits++;
-        UpdateLRU(coordinates);
-
-        // Update access metadata
-        if (auto metadata = GetMetadata(coordinates)) {
-            metadata->access_count++;
-            metadata->last_access = std::chrono::system_clock::now();
+    // First try memory cache (shard lock only covers the lookup)
+    if (auto tile = memory_.Get(coordinates)) {
+        // Raw copy of TileData, outside the lock
+        if (auto raw = Materialize(*tile)) {
+            stats_.memory_cache_hits++;
+            RecordAccess(coordinates);
+            return raw;
         }
-
-        return *(it->second);  // Return copy of TileData
+        // Undecodable: drop the copy and fall through to the lower tiers
+        stats_.total_corruptions++;
+        memory_.Erase(coordinates);
     }
 
     stats_.memory_cache_misses++;
 
-    // Try loading from disk
-    auto disk_tile = LoadTileFromDisk(coordinates);
+    // A tile evicted from memory may still be waiting for the I/O thread
+    if (auto pending = write_behind_->Find(coordinates)) {
+        if (pending->kind == TileDiskOp::Kind::WRITE_TILE) {
+            auto raw = Materialize(*pending->tile);
+            if (!raw) {
+                stats_.total_corruptions++;
+                stats_.disk_cache_misses++;
+                return std::nullopt;
+            }
+            stats_.disk_cache_hits++;
+            RecordAccess(coordinates);
+            memory_.Put(pending->tile);
+            return raw;
+        }
+        if (pending->kind == TileDiskOp::Kind::REMOVE) {
+            stats_.disk_cache_misses++;
+            return std::nullopt;
+        }
+    }
+
+    // Try loading from disk (no lock held)
+    auto disk_tile = LoadVerifiedTileFromDisk(coordinates);
     if (disk_tile && disk_tile->IsValid()) {
         stats_.disk_cache_hits++;
+        RecordAccess(coordinates);
+        if (auto manifest = GetManifest()) {
+            manifest->Touch(coordinates, std::chrono::system_clock::now());
+        }
 
-        // Add to memory cache
-        auto shared_tile = std::shared_ptr<TileData>(disk_tile.release());
-        memory_cache_[coordinates] = shared_tile;
-        UpdateLRU(coordinates);
-
-        // Update statistics
-        stats_.memory_cache_size += shared_tile->GetDataSize();
-        stats_.memory_cache_count++;
+        // Add to memory cache, hand out the raw tile
+        TileData result = *disk_tile;
+        memory_.Put(ToMemoryTile(std::move(disk_tile)));
 
-        return *shared_tile;  // Return copy of TileData
+        return result;
     }
 
     stats_.disk_cache_misses++;
@@ -206,101 +454,103 @@ std::optional<TileData> BasicTileCache::Get(const TileCoordinates& coordinates)
 }
 
 bool BasicTileCache::Contains(const TileCoordinates& coordinates) const {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
     // Check memory cache first
-    if (memory_cache_.find(coordinates) != memory_cache_.end()) {
+    if (memory_.Contains(coordinates)) {
         return true;
     }
     
-    // Check disk cache
-    std::string file_path = GetTileFilePath(coordinates);
-    return std::filesystem::exists(file_path);
+    // Then pending writes, then disk
+    if (auto pending = write_behind_->Find(coordinates)) {
+        if (pending->kind == TileDiskOp::Kind::WRITE_TILE) {
+            return true;
+        }
+        if (pending->kind == TileDiskOp::Kind::REMOVE) {
+            return false;
+        }
+    }
+    return ContainsOnDisk(coordinates);
 }
 
 bool BasicTileCache::Remove(const TileCoordinates& coordinates) {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    bool removed_memory = false;
-    bool removed_disk = false;
+    // Remove from memory and metadata cache
+    const bool removed_memory = memory_.Erase(coordinates);
     
-    // Remove from memory cache
-    auto mem_it = memory_cache_.find(coordinates);
-    if (mem_it != memory_cache_.end()) {
-        stats_.memory_cache_size -= mem_it->second->GetDataSize();
-        stats_.memory_cache_count--;
-        memory_cache_.erase(mem_it);
-        removed_memory = true;
+    if (!write_behind_enabled_) {
+        return RemoveFromDisk(coordinates) || removed_memory;
     }
     
-    // Remove from metadata cache
-    metadata_cache_.erase(coordinates);
-    
-    // Remove from LRU
-    auto lru_it = lru_index_.find(coordinates);
-    if (lru_it != lru_index_.end()) {
-        std::size_t index = lru_it->second;
-        lru_list_.erase(lru_list_.begin() + index);
-        lru_index_.erase(lru_it);
-        
-        // Update indices
-        for (std::size_t i = index; i < lru_list_.size(); ++i) {
-            lru_index_[lru_list_[i]] = i;
-        }
+    bool removed = removed_memory;
+    if (auto pending = write_behind_->Find(coordinates)) {
+        removed = removed || pending->kind == TileDiskOp::Kind::WRITE_TILE;
     }
-    
-    // Remove from disk
-    std::string tile_path = GetTileFilePath(coordinates);
-    std::string meta_path = GetMetadataFilePath(coordinates);
-    
-    try {
-        removed_disk = std::filesystem::remove(tile_path) || 
-                       std::filesystem::remove(meta_path);
-    } catch (const std::exception& e) {
-        spdlog::warn("Failed to remove tile files: {}", e.what());
-    }
-    
-    return removed_memory || removed_disk;
+    removed = removed || ContainsOnDisk(coordinates);
+    write_behind_->Enqueue(TileDiskOp{TileDiskOp::Kind::REMOVE, coordinates, nullptr, nullptr});
+    return removed;
 }
 
 void BasicTileCache::Clear() {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    memory_cache_.clear();
-    metadata_cache_.clear();
-    lru_list_.clear();
-    lru_index_.clear();
-    
-    stats_.Reset();
+    // Nothing left to warm up; the access histogram survives in memory
+    StopWarmUp();
+    // Pending writes are dropped; the batch in flight finishes before disk is wiped
+    write_behind_->Discard();
+    memory_.Clear();
+    stats_.Reset(memory_.GetEvictionCount());
     
     // Clear disk cache
+    if (auto packed_store = GetPackedStore()) {
+        packed_store->Clear();
+        spdlog::info("Tile cache cleared");
+        return;
+    }
+    const std::string directory = GetDiskDirectory();
     try {
-        if (std::filesystem::exists(config_.disk_cache_directory)) {
-            std::filesystem::remove_all(config_.disk_cache_directory);
-            std::filesystem::create_directories(config_.disk_cache_directory);
+        if (std::filesystem::exists(directory)) {
+            std::filesystem::remove_all(directory);
+            std::filesystem::create_directories(directory);
         }
     } catch (const std::exception& e) {
         spdlog::warn("Failed to clear disk cache: {}", e.what());
     }
+    if (auto manifest = GetManifest()) {
+        manifest->Clear();
+    }
     
     spdlog::info("Tile cache cleared");
 }
 
 TileCacheStats BasicTileCache::GetStatistics() const {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    TileCacheStats stats = stats_;  // Copy current stats
+    TileCacheStats stats;
+    stats.memory_cache_size = memory_.GetSizeBytes();
+    stats.memory_cache_count = memory_.GetCount();
+    stats.memory_cache_hits = stats_.memory_cache_hits.load();
+    stats.memory_cache_misses = stats_.memory_cache_misses.load();
+    stats.disk_cache_hits = stats_.disk_cache_hits.load();
+    stats.disk_cache_misses = stats_.disk_cache_misses.load();
+    stats.total_requests = stats_.total_requests.load();
+    stats.total_corruptions = stats_.total_corruptions.load();
+    stats.total_evictions = static_cast<std::size_t>(
+        memory_.GetEvictionCount() - stats_.evictions_at_reset.load());
+    stats.pending_disk_writes = write_behind_->Size();
+    stats.warmup_tiles = stats_.warmup_tiles.load();
+    auto ratio = [](std::uint64_t raw, std::uint64_t stored) {
+        return stored > 0 ? static_cast<float>(raw) / static_cast<float>(stored) : 1.0f;
+    };
+    stats.memory_compression_ratio = ratio(stats_.memory_raw_bytes.load(),
+                                           stats_.memory_stored_bytes.load());
+    stats.disk_compression_ratio = ratio(stats_.disk_raw_bytes.load(),
+                                         stats_.disk_stored_bytes.load());
     
-    // Calculate disk usage (mutable operation but returns copy)
-    stats.disk_cache_size = const_cast<BasicTileCache*>(this)->CalculateCurrentDiskUsage();
+    // Calculate disk usage
+    stats.disk_cache_size = CalculateCurrentDiskUsage();
     stats.disk_cache_count = 0;
     
-    // Count disk tiles
-    try {
-        for (const auto& entry : 
-             std::filesystem::recursive_directory_iterator(config_.disk_cache_directory)) {
-            if (entry.path().extension() == ".tile") {
-                stats.disk_cache_count++;
-            }
-        }
-    } catch (const std::exception&) {
-        // Ignore directory iteration errors
+    if (auto packed_store = GetPackedStore()) {
+        stats.disk_cache_count = packed_store->GetStats().tile_count;
+        return stats;
+    }
+    
+    if (auto manifest = GetManifest()) {
+        stats.disk_cache_count = manifest->GetCount();
     }
     
     return stats;
@@ -308,71 +558,90 @@ TileCacheStats BasicTileCache::GetStatistics() const {
 
 bool BasicTileCache::UpdateMetadata(const TileCoordinates& coordinates,
                                     const TileMetadata& metadata) {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    metadata_cache_[coordinates] = std::make_shared<TileMetadata>(metadata);
-    return SaveMetadataToDisk(metadata);
+    auto shared_metadata = std::make_shared<TileMetadata>(metadata);
+    shared_metadata->coordinates = coordinates;
+    
+    // Keep the resident copy in step so Get() sees e.g. a revalidated expiry
+    if (auto resident = memory_.Get(coordinates)) {
+        auto refreshed = std::make_shared<TileData>(*resident);
+        const auto compression = refreshed->metadata.compression;
+        refreshed->metadata = *shared_metadata;
+        refreshed->metadata.compression = compression;
+        memory_.Put(std::move(refreshed));
+        memory_.PutMetadata(shared_metadata);
+    }
+    if (write_behind_enabled_) {
+        write_behind_->Enqueue(TileDiskOp{TileDiskOp::Kind::WRITE_METADATA, coordinates,
+                                          nullptr, shared_metadata});
+        return true;
+    }
+    return SaveMetadataToDisk(*shared_metadata);
 }
 
 std::shared_ptr<TileMetadata> BasicTileCache::GetMetadata(
     const TileCoordinates& coordinates) const {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
     // Check memory cache first
-    auto it = metadata_cache_.find(coordinates);
-    if (it != metadata_cache_.end()) {
-        return it->second;
+    if (auto metadata = memory_.GetMetadata(coordinates)) {
+        return metadata;
+    }
+    
+    if (auto pending = write_behind_->Find(coordinates)) {
+        switch (pending->kind) {
+            case TileDiskOp::Kind::WRITE_TILE:
+                return std::make_shared<TileMetadata>(pending->tile->metadata);
+            case TileDiskOp::Kind::WRITE_METADATA:
+                return std::make_shared<TileMetadata>(*pending->metadata);
+            case TileDiskOp::Kind::REMOVE:
+                return nullptr;
+        }
     }
     
-    // Load from disk
-    auto disk_metadata = const_cast<BasicTileCache*>(this)->LoadMetadataFromDisk(coordinates);
+    // Load from disk (no lock held). Not cached: the tile is not in memory,
+    // so no eviction would ever drop it again.
+    auto disk_metadata = LoadMetadataFromDisk(coordinates);
     if (disk_metadata) {
-        auto shared_metadata = std::shared_ptr<TileMetadata>(disk_metadata.release());
-        // Use const_cast to modify cache in const method - this is logical since
-        // we're just adding a cached result, not changing the logical state
-        const_cast<std::unordered_map<TileCoordinates, std::shared_ptr<TileMetadata>, TileCoordinatesHash>&>(metadata_cache_)[coordinates] = shared_metadata;
-        return shared_metadata;
+        return std::shared_ptr<TileMetadata>(disk_metadata.release());
     }
     
     return nullptr;
 }
 
 std::size_t BasicTileCache::Cleanup() {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
     std::size_t cleaned_count = 0;
     
-    // Clean expired tiles
-    for (auto it = memory_cache_.begin(); it != memory_cache_.end();) {
-        if (IsTileExpired(it->second->metadata)) {
-            Remove(it->first);
-            ++cleaned_count;
-            it = memory_cache_.begin(); // Restart iterator
-        } else {
-            ++it;
-        }
+    // Scan a disk tier that matches memory
+    write_behind_->Flush();
+    
+    // Clean expired tiles (snapshot first, then remove without holding shard locks)
+    const auto expired = memory_.CollectIf(
+        [this](const TileCoordinates&, const TileData& tile) {
+            return IsTileExpired(tile.metadata);
+        });
+    for (const auto& coords : expired) {
+        Remove(coords);
+        ++cleaned_count;
     }
     
     // Clean up disk cache
-    try {
-        for (const auto& entry : 
-             std::filesystem::recursive_directory_iterator(config_.disk_cache_directory)) {
-            if (entry.path().extension() == ".meta") {
-                auto metadata = LoadMetadataFromDisk([&entry]() {
-                    // Extract coordinates from path
-                    std::string path = entry.path().string();
-                    // TODO: Parse coordinates from path
-                    TileCoordinates coords{0, 0, 0};
-                    return coords;
-                }());
-                
-                if (metadata && IsTileExpired(*metadata)) {
-                    std::string base_path = entry.path().stem().string();
-                    std::filesystem::remove(entry.path());
-                    std::filesystem::remove(base_path + ".tile");
-                    ++cleaned_count;
-                }
+    if (auto packed_store = GetPackedStore()) {
+        for (const auto& coords : packed_store->GetKeys()) {
+            auto metadata = packed_store->GetMetadata(coords);
+            if (metadata && IsTileExpired(*metadata) && packed_store->Remove(coords)) {
+                ++cleaned_count;
+            }
+        }
+    } else if (auto manifest = GetManifest()) {
+        const auto ttl = static_cast<std::int64_t>(GetConfiguration().tile_ttl);
+        const std::int64_t now = DiskCacheManifest::ToSeconds(std::chrono::system_clock::now());
+        const auto expired_on_disk = manifest->CollectIf(
+            [ttl, now](const TileCoordinates&, const DiskCacheManifest::Entry& entry) {
+                return now - entry.last_modified > ttl && now >= entry.expires_at;
+            });
+        for (const auto& coords : expired_on_disk) {
+            if (RemoveFromDisk(coords)) {
+                ++cleaned_count;
             }
         }
-    } catch (const std::exception& e) {
-        spdlog::warn("Error during disk cleanup: {}", e.what());
     }
     
     if (cleaned_count > 0) {
@@ -382,33 +651,45 @@ std::size_t BasicTileCache::Cleanup() {
     return cleaned_count;
 }
 
+void BasicTileCache::Flush() {
+    write_behind_->Flush();
+}
+
 bool BasicTileCache::SetConfiguration(const TileCacheConfig& config) {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    config_ = config;
+    {
+        std::unique_lock<std::shared_mutex> lock(config_mutex_);
+        config_ = config;
+    }
+    write_behind_enabled_ = config.enable_write_behind;
+    if (!config.enable_write_behind) {
+        write_behind_->Flush();
+    }
     
     // Perform immediate cleanup if limits decreased
-    if (CalculateCurrentMemoryUsage() > config_.max_memory_cache_size) {
-        EvictFromMemory(CalculateCurrentMemoryUsage() - config_.max_memory_cache_size);
+    memory_.SetEvictionStrategy(config.eviction_strategy);
+    memory_.SetMaxCount(config.max_tile_count);
+    memory_.SetMaxBytes(config.max_memory_cache_size);
+    if (auto manifest = GetManifest()) {
+        manifest->SetVictimOrder(ToVictimOrder(config.eviction_strategy));
     }
     
-    if (CalculateCurrentDiskUsage() > config_.max_disk_cache_size) {
-        EvictFromDisk(CalculateCurrentDiskUsage() - config_.max_disk_cache_size);
+    if (auto collector = GetDiskCollector()) {
+        collector->Wake();
+    } else if (CalculateCurrentDiskUsage() > config.max_disk_cache_size) {
+        EvictFromDisk();
     }
     
     return true;
 }
 
 std::size_t BasicTileCache::Preload(const std::vector<TileCoordinates>& coordinates) {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
     std::size_t loaded_count = 0;
     
     for (const auto& coords : coordinates) {
-        if (!Contains(coords)) {
-            auto tile_data = LoadTileFromDisk(coords);
+        if (!memory_.Contains(coords)) {
+            auto tile_data = LoadVerifiedTileFromDisk(coords);
             if (tile_data && tile_data->IsValid()) {
-                auto shared_tile = std::shared_ptr<TileData>(tile_data.release());
-                memory_cache_[coords] = shared_tile;
-                UpdateLRU(coords);
+                memory_.Put(ToMemoryTile(std::move(tile_data)));
                 loaded_count++;
             }
         }
@@ -423,38 +704,244 @@ std::size_t BasicTileCache::Preload(const std::vector<TileCoordinates>& coordina
 
 std::vector<TileCoordinates> BasicTileCache::GetTilesInBounds(
     const BoundingBox2D& bounds) const {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    std::vector<TileCoordinates> tiles_in_bounds;
-    
-    for (const auto& [coords, tile_data] : memory_cache_) {
-        if (tile_data && tile_data->IsValid()) {
-            BoundingBox2D tile_bounds = TileMathematics::GetTileBounds(coords);
-            if (bounds.Intersects(tile_bounds)) {
-                tiles_in_bounds.push_back(coords);
-            }
-        }
+    return memory_.CollectInBounds(bounds);
+}
+
+std::vector<TileCoordinates> BasicTileCache::GetHottestTiles(std::size_t max_count) const {
+    if (auto histogram = GetHistogram()) {
+        return histogram->GetHottest(max_count);
     }
-    
-    return tiles_in_bounds;
+    return {};
 }
 
 std::vector<TileCoordinates> BasicTileCache::GetTilesAtZoom(
     std::uint8_t zoom_level) const {
-    std::lock_guard<std::recursive_mutex> lock(mutex_);
-    std::vector<TileCoordinates> tiles_at_zoom;
+    return memory_.CollectAtZoom(zoom_level);
+}
+
+void BasicTileCache::WriteBatch(const std::vector<TileDiskOp>& batch) {
+    auto packed_store = GetPackedStore();
+    
+    // Packed backend: append all tiles of the batch in one go
+    std::vector<std::shared_ptr<const TileData>> packed_tiles;
+    
+    for (const auto& op : batch) {
+        switch (op.kind) {
+            case TileDiskOp::Kind::WRITE_TILE:
+                if (packed_store) {
+                    if (auto disk = ToDiskTile(*op.tile)) {
+                        packed_tiles.push_back(std::make_shared<const TileData>(std::move(*disk)));
+                    } else {
+                        spdlog::warn("Failed to save tile to disk cache: {}/{}/{}",
+                                     op.coordinates.x, op.coordinates.y, op.coordinates.zoom);
+                    }
+                    break;
+                }
+                if (!PersistTile(*op.tile)) {
+                    spdlog::warn("Failed to save tile to disk cache: {}/{}/{}",
+                                 op.coordinates.x, op.coordinates.y, op.coordinates.zoom);
+                }
+                break;
+            case TileDiskOp::Kind::WRITE_METADATA:
+                SaveMetadataToDisk(*op.metadata);
+                break;
+            case TileDiskOp::Kind::REMOVE:
+                RemoveFromDisk(op.coordinates);
+                break;
+        }
+    }
+    
+    if (!packed_tiles.empty() &&
+        packed_store->PutBatch(packed_tiles) != packed_tiles.size()) {
+        spdlog::warn("Failed to save {} tiles to packed disk cache",
+                     packed_tiles.size());
+    }
+    EnforceDiskBudget();
+}
+
+bool BasicTileCache::ContainsOnDisk(const TileCoordinates& coordinates) const {
+    if (auto packed_store = GetPackedStore()) {
+        return packed_store->Contains(coordinates);
+    }
+    std::string file_path = GetTileFilePath(coordinates);
+    return std::filesystem::exists(file_path);
+}
+
+bool BasicTileCache::RemoveFromDisk(const TileCoordinates& coordinates) const {
+    if (auto packed_store = GetPackedStore()) {
+        return packed_store->Remove(coordinates);
+    }
+    if (auto manifest = GetManifest()) {
+        manifest->Remove(coordinates);
+    }
+    std::string tile_path = GetTileFilePath(coordinates);
+    std::string meta_path = GetMetadataFilePath(coordinates);
+    
+    try {
+        const bool removed_tile = std::filesystem::remove(tile_path);
+        const bool removed_meta = std::filesystem::remove(meta_path);
+        return removed_tile || removed_meta;
+    } catch (const std::exception& e) {
+        spdlog::warn("Failed to remove tile files: {}", e.what());
+        return false;
+    }
+}
+
+std::shared_ptr<PackedTileStore> BasicTileCache::GetPackedStore() const {
+    std::shared_lock<std::shared_mutex> lock(config_mutex_);
+    return packed_store_;
+}
+
+std::shared_ptr<DiskCacheManifest> BasicTileCache::GetManifest() const {
+    std::shared_lock<std::shared_mutex> lock(config_mutex_);
+    return manifest_;
+}
+
+std::shared_ptr<DiskCacheCollector> BasicTileCache::GetDiskCollector() const {
+    std::shared_lock<std::shared_mutex> lock(config_mutex_);
+    return disk_collector_;
+}
+
+std::shared_ptr<TileAccessHistogram> BasicTileCache::GetHistogram() const {
+    std::shared_lock<std::shared_mutex> lock(config_mutex_);
+    return histogram_;
+}
+
+void BasicTileCache::RecordAccess(const TileCoordinates& coordinates) {
+    if (auto histogram = GetHistogram()) {
+        histogram->Record(coordinates);
+    }
+}
+
+void BasicTileCache::StopWarmUp() {
+    warmup_stop_ = true;
+    if (warmup_thread_.joinable()) {
+        warmup_thread_.join();
+    }
+}
+
+void BasicTileCache::RunWarmUp(const TileAccessHistogram& histogram,
+                               const TileCacheConfig& config) {
+    const auto start = std::chrono::steady_clock::now();
+    const auto deadline = start + std::chrono::milliseconds(config.warmup_time_budget_ms);
+    // Leave the rest of the memory tier to the tiles this session asks for
+    const std::size_t byte_budget = std::min(config.warmup_memory_budget,
+                                             config.max_memory_cache_size);
+    const std::size_t max_tiles = std::min(config.warmup_max_tiles, config.max_tile_count);
+
+    std::size_t bytes = 0;
+    std::size_t promoted = 0;
+    for (const auto& coords : histogram.GetHottest(max_tiles)) {
+        if (warmup_stop_ || std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+        if (memory_.Contains(coords)) {
+            continue;
+        }
+        auto tile = LoadVerifiedTileFromDisk(coords);
+        if (!tile || !tile->IsValid()) {
+            continue;
+        }
+        if (bytes + tile->data.size() > byte_budget) {
+            break;
+        }
+        bytes += tile->data.size();
+        memory_.Put(ToMemoryTile(std::move(tile)));
+        ++promoted;
+    }
+
+    stats_.warmup_tiles += promoted;
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    spdlog::info("Tile cache warm-up: {} tiles ({} KB) promoted in {} ms",
+                 promoted, bytes / 1024, elapsed.count());
+}
+
+std::shared_ptr<DiskCacheCollector> BasicTileCache::MakeDiskCollector(
+    std::shared_ptr<DiskCacheManifest> manifest, const TileCacheConfig& config) {
+    DiskCacheCollectorConfig collector_config;
+    collector_config.max_deletions_per_tick = std::max<std::size_t>(config.cleanup_batch_size, 1);
+    collector_config.expiry_scan_interval = std::chrono::seconds(config.cleanup_interval);
+    
+    return std::make_shared<DiskCacheCollector>(
+        std::move(manifest),
+        [this] {
+            const TileCacheConfig current = GetConfiguration();
+            return DiskCacheBudget{current.max_disk_cache_size, current.tile_ttl,
+                                   current.eviction_strategy};
+        },
+        [this](const TileCoordinates& coords) {
+            // A tile waiting for the I/O thread was just written: not a victim
+            return !write_behind_->Find(coords) && RemoveFromDisk(coords);
+        },
+        collector_config);
+}
+
+std::vector<std::pair<TileCoordinates, DiskCacheManifest::Entry>>
+BasicTileCache::ScanDiskDirectory() const {
+    std::vector<std::pair<TileCoordinates, DiskCacheManifest::Entry>> entries;
+    const std::filesystem::path directory = GetDiskDirectory();
     
-    for (const auto& [coords, tile_data] : memory_cache_) {
-        if (coords.zoom == zoom_level && tile_data && tile_data->IsValid()) {
-            tiles_at_zoom.push_back(coords);
+    try {
+        for (const auto& zoom_dir : std::filesystem::directory_iterator(directory)) {
+            if (!zoom_dir.is_directory()) {
+                continue;
+            }
+            const int zoom = std::atoi(zoom_dir.path().filename().c_str());
+            for (const auto& file : std::filesystem::directory_iterator(zoom_dir.path())) {
+                if (file.path().extension() != ".tile") {
+                    continue;
+                }
+                // File names are "<x>_<y>.tile"
+                int x = 0;
+                int y = 0;
+                if (std::sscanf(file.path().stem().c_str(), "%d_%d", &x, &y) != 2) {
+                    continue;
+                }
+                const TileCoordinates coords(x, y, zoom);
+                
+                DiskCacheManifest::Entry entry;
+                entry.tile_size = file.file_size();
+                std::error_code error;
+                const auto meta_size = std::filesystem::file_size(GetMetadataFilePath(coords), error);
+                if (!error) {
+                    entry.metadata_size = static_cast<std::uint32_t>(meta_size);
+                }
+                if (auto metadata = LoadMetadataFromDisk(coords)) {
+                    entry.last_access = DiskCacheManifest::ToSeconds(metadata->last_access);
+                    entry.last_modified = DiskCacheManifest::ToSeconds(metadata->last_modified);
+                    entry.expires_at = DiskCacheManifest::ToSeconds(metadata->expires_at);
+                    entry.checksum = metadata->checksum;
+                }
+                entries.emplace_back(coords, entry);
+            }
         }
+    } catch (const std::exception& e) {
+        spdlog::warn("Error while scanning disk cache: {}", e.what());
     }
     
-    return tiles_at_zoom;
+    return entries;
+}
+
+void BasicTileCache::EnforceDiskBudget() {
+    if (CalculateCurrentDiskUsage() <= GetConfiguration().max_disk_cache_size) {
+        return;
+    }
+    if (auto collector = GetDiskCollector()) {
+        collector->Wake();  // Evicts in batches off this thread
+        return;
+    }
+    EvictFromDisk();
+}
+
+std::string BasicTileCache::GetDiskDirectory() const {
+    std::shared_lock<std::shared_mutex> lock(config_mutex_);
+    return config_.disk_cache_directory;
 }
 
 std::string BasicTileCache::GetTileFilePath(const TileCoordinates& coordinates) const {
     std::ostringstream oss;
-    oss << config_.disk_cache_directory << "/" 
+    oss << GetDiskDirectory() << "/" 
         << static_cast<int>(coordinates.zoom) << "/"
         << coordinates.x << "_" << coordinates.y << ".tile";
     return oss.str();
@@ -462,62 +949,190 @@ std::string BasicTileCache::GetTileFilePath(const TileCoordinates& coordinates)
 
 std::string BasicTileCache::GetMetadataFilePath(const TileCoordinates& coordinates) const {
     std::ostringstream oss;
-    oss << config_.disk_cache_directory << "/" 
+    oss << GetDiskDirectory() << "/" 
         << static_cast<int>(coordinates.zoom) << "/"
         << coordinates.x << "_" << coordinates.y << ".meta";
     return oss.str();
 }
 
-std::vector<std::uint8_t> BasicTileCache::CompressData(
-    const std::vector<std::uint8_t>& data,
+std::optional<std::vector<std::uint8_t>> BasicTileCache::CompressData(
+    std::span<const std::uint8_t> data,
     TileMetadata::Compression type) const {
-    
-    // TODO: Implement actual compression based on type
-    // For now, return data as-is
-    (void)type;  // Suppress unused parameter warning
-    return data;
+    std::shared_ptr<const ZstdDictionary> dictionary;
+    if (type == TileMetadata::Compression::ZSTD) {
+        std::shared_lock<std::shared_mutex> lock(config_mutex_);
+        dictionary = zstd_dictionary_;
+    }
+    return CompressTileData(data, type, 0, dictionary.get());
 }
 
-std::vector<std::uint8_t> BasicTileCache::DecompressData(
-    const std::vector<std::uint8_t>& data,
+std::optional<std::vector<std::uint8_t>> BasicTileCache::DecompressData(
+    std::span<const std::uint8_t> data,
     TileMetadata::Compression type) const {
+    std::shared_ptr<const ZstdDictionary> dictionary;
+    if (type == TileMetadata::Compression::ZSTD) {
+        std::shared_lock<std::shared_mutex> lock(config_mutex_);
+        dictionary = zstd_dictionary_;
+    }
+    return DecompressTileData(data, type, dictionary.get());
+}
+
+namespace {
+
+/// Keep a compressed copy only if it saves at least 1/8 of the bytes
+bool WorthCompressing(std::size_t raw_size, std::size_t compressed_size) {
+    return compressed_size < raw_size - raw_size / 8;
+}
+
+} // namespace
+
+std::shared_ptr<const TileData> BasicTileCache::ToMemoryTile(std::shared_ptr<TileData> tile) {
+    const auto type = GetConfiguration().memory_compression;
+    const std::size_t raw_size = tile->data.size();
+    if (type != TileMetadata::Compression::NONE && !tile->is_compressed &&
+        IsCompressionAvailable(type)) {
+        auto compressed = CompressData(tile->data, type);
+        if (compressed && WorthCompressing(raw_size, compressed->size())) {
+            tile->data = std::move(*compressed);
+            tile->is_compressed = true;
+            tile->metadata.compression = type;
+        }
+    }
+    stats_.memory_raw_bytes += raw_size;
+    stats_.memory_stored_bytes += tile->data.size();
+    return tile;
+}
+
+std::optional<TileData> BasicTileCache::Materialize(const TileData& tile) const {
+    if (!tile.is_compressed) {
+        return tile;
+    }
+    auto data = DecompressData(tile.data, tile.metadata.compression);
+    if (!data) {
+        spdlog::error("Failed to decompress cached tile {}/{}/{}",
+                      tile.metadata.coordinates.x, tile.metadata.coordinates.y,
+                      tile.metadata.coordinates.zoom);
+        return std::nullopt;
+    }
+    TileData raw;
+    raw.metadata = tile.metadata;
+    raw.metadata.compression = TileMetadata::Compression::NONE;
+    raw.data = std::move(*data);
+    raw.width = tile.width;
+    raw.height = tile.height;
+    raw.channels = tile.channels;
+    raw.loaded = tile.loaded;
+    return raw;
+}
+
+std::optional<TileData> BasicTileCache::ToDiskTile(const TileData& tile) {
+    auto materialized = Materialize(tile);
+    if (!materialized) {
+        return std::nullopt;
+    }
+    TileData& disk = *materialized;
+    const TileCacheConfig config = GetConfiguration();
+    const std::size_t raw_size = disk.data.size();
     
-    // TODO: Implement actual decompression based on type
-    // For now, return data as-is
-    (void)type;  // Suppress unused parameter warning
-    return data;
+    disk.metadata.compression = TileMetadata::Compression::NONE;
+    if (config.enable_compression &&
+        config.default_compression != TileMetadata::Compression::NONE &&
+        IsCompressionAvailable(config.default_compression)) {
+        auto compressed = CompressData(disk.data, config.default_compression);
+        if (compressed && WorthCompressing(raw_size, compressed->size())) {
+            disk.data = std::move(*compressed);
+            disk.is_compressed = true;
+            disk.metadata.compression = config.default_compression;
+        }
+    }
+    stats_.disk_raw_bytes += raw_size;
+    stats_.disk_stored_bytes += disk.data.size();
+    return materialized;
+}
+
+bool BasicTileCache::PersistTile(const TileData& tile) {
+    const auto disk = ToDiskTile(tile);
+    if (!disk) {
+        return false;
+    }
+    // Packed records carry their metadata
+    if (!GetPackedStore()) {
+        SaveMetadataToDisk(disk->metadata);
+    }
+    return SaveTileToDisk(*disk);
 }
 
 std::uint32_t BasicTileCache::CalculateChecksum(
-    const std::vector<std::uint8_t>& data) const {
+    std::span<const std::uint8_t> data) const {
     
-    // Simple checksum calculation
-    std::uint32_t checksum = 0;
-    for (std::uint8_t byte : data) {
-        checksum = checksum * 31 + byte;
+    return Crc32c(data);
+}
+
+std::string BasicTileCache::MakeTempPath(const std::string& final_path) const {
+    return final_path + ".tmp" + std::to_string(temp_file_counter_.fetch_add(1));
+}
+
+bool BasicTileCache::CommitTempFile(const std::string& temp_path,
+                                    const std::string& final_path) const {
+    // rename() replaces atomically: readers never see a partially written file
+    std::error_code error;
+    std::filesystem::rename(temp_path, final_path, error);
+    if (error) {
+        std::filesystem::remove(temp_path, error);
+        return false;
     }
-    return checksum;
+    return true;
 }
 
+namespace {
+
+/// Tile files: u64 header (payload size, compression in the top byte), payload
+constexpr int kCompressionShift = 56;
+constexpr std::uint64_t kPayloadSizeMask = (std::uint64_t{1} << kCompressionShift) - 1;
+
+} // namespace
+
 bool BasicTileCache::SaveTileToDisk(const TileData& tile_data) const {
+    if (auto packed_store = GetPackedStore()) {
+        return packed_store->Put(tile_data.metadata, tile_data.data);
+    }
+    
     const auto& coords = tile_data.metadata.coordinates;
-    std::string file_path = GetTileFilePath(coords);
+    const std::string file_path = GetTileFilePath(coords);
+    const std::string temp_path = MakeTempPath(file_path);
     
     try {
-        std::ofstream file(file_path, std::ios::binary);
-        if (!file) {
-            return false;
+        {
+            std::ofstream file(temp_path, std::ios::binary);
+            if (!file) {
+                return false;
+            }
+            
+            // Write data size; the top byte records the payload compression
+            const std::uint64_t data_size = tile_data.data.size();
+            const std::uint64_t header = data_size |
+                (static_cast<std::uint64_t>(tile_data.metadata.compression) << kCompressionShift);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            
+            // Write actual data
+            file.write(reinterpret_cast<const char*>(tile_data.data.data()), 
+                       data_size);
+            
+            if (!file.good()) {
+                file.close();
+                std::filesystem::remove(temp_path);
+                return false;
+            }
         }
         
-        // Write data size
-        std::uint64_t data_size = tile_data.data.size();
-        file.write(reinterpret_cast<const char*>(&data_size), sizeof(data_size));
-        
-        // Write actual data
-        file.write(reinterpret_cast<const char*>(tile_data.data.data()), 
-                   data_size);
-        
-        return file.good();
+        if (!CommitTempFile(temp_path, file_path)) {
+            return false;
+        }
+        if (auto manifest = GetManifest()) {
+            manifest->RecordTile(coords, sizeof(std::uint64_t) + tile_data.data.size(),
+                                 tile_data.metadata.checksum);
+        }
+        return true;
     } catch (const std::exception& e) {
         spdlog::error("Failed to save tile to disk: {}", e.what());
         return false;
@@ -527,6 +1142,19 @@ bool BasicTileCache::SaveTileToDisk(const TileData& tile_data) const {
 std::unique_ptr<TileData> BasicTileCache::LoadTileFromDisk(
     const TileCoordinates& coordinates) const {
     
+    if (auto packed_store = GetPackedStore()) {
+        auto view = packed_store->Get(coordinates);
+        if (!view) {
+            return nullptr;
+        }
+        auto tile_data = std::make_unique<TileData>(view->Metadata());
+        tile_data->data = view->Buffer();  // Zero-copy: shares the segment mapping
+        tile_data->is_compressed =
+            tile_data->metadata.compression != TileMetadata::Compression::NONE;
+        tile_data->loaded = true;
+        return tile_data;
+    }
+    
     std::string file_path = GetTileFilePath(coordinates);
     
     try {
@@ -538,21 +1166,41 @@ std::unique_ptr<TileData> BasicTileCache::LoadTileFromDisk(
         auto tile_data = std::make_unique<TileData>();
         tile_data->metadata.coordinates = coordinates;
         
-        // Read data size
-        std::uint64_t data_size;
-        file.read(reinterpret_cast<char*>(&data_size), sizeof(data_size));
+        // Read data size and compression
+        std::uint64_t header;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!file.good()) {
+            return nullptr;
+        }
+        const std::uint64_t data_size = header & kPayloadSizeMask;
+        tile_data->metadata.compression =
+            static_cast<TileMetadata::Compression>(header >> kCompressionShift);
+        tile_data->is_compressed =
+            tile_data->metadata.compression != TileMetadata::Compression::NONE;
         
         // Read actual data
-        tile_data->data.resize(data_size);
-        file.read(reinterpret_cast<char*>(tile_data->data.data()), data_size);
+        std::vector<std::uint8_t> data(data_size);
+        file.read(reinterpret_cast<char*>(data.data()), data_size);
         
         if (!file.good()) {
             return nullptr;
         }
+        tile_data->data = std::move(data);
         
         tile_data->metadata.file_size = data_size;
         tile_data->loaded = true;
         
+        // Checksum and freshness come from the manifest; no metadata file read
+        if (auto manifest = GetManifest()) {
+            if (auto entry = manifest->Find(coordinates)) {
+                tile_data->metadata.checksum = entry->checksum;
+                tile_data->metadata.last_modified = std::chrono::system_clock::time_point(
+                    std::chrono::seconds(entry->last_modified));
+                tile_data->metadata.expires_at = std::chrono::system_clock::time_point(
+                    std::chrono::seconds(entry->expires_at));
+            }
+        }
+        
         return tile_data;
     } catch (const std::exception& e) {
         spdlog::error("Failed to load tile from disk: {}", e.what());
@@ -560,12 +1208,53 @@ std::unique_ptr<TileData> BasicTileCache::LoadTileFromDisk(
     }
 }
 
+std::unique_ptr<TileData> BasicTileCache::LoadVerifiedTileFromDisk(
+    const TileCoordinates& coordinates) {
+    auto tile_data = LoadTileFromDisk(coordinates);
+    if (!tile_data) {
+        return nullptr;
+    }
+    
+    // Undecodable payloads and checksum mismatches are both corruption
+    bool corrupt = false;
+    if (tile_data->is_compressed) {
+        if (auto raw = DecompressData(tile_data->data, tile_data->metadata.compression)) {
+            tile_data->data = std::move(*raw);
+            tile_data->is_compressed = false;
+            tile_data->metadata.compression = TileMetadata::Compression::NONE;
+            tile_data->metadata.file_size = tile_data->data.size();
+        } else {
+            corrupt = true;
+        }
+    }
+    
+    // Verified once per disk read; memory hits are trusted
+    if (!corrupt && GetConfiguration().enable_integrity_check &&
+        tile_data->metadata.checksum != 0) {
+        corrupt = CalculateChecksum(tile_data->data) != tile_data->metadata.checksum;
+    }
+    
+    if (corrupt) {
+        stats_.total_corruptions++;
+        spdlog::warn("Corrupted tile in disk cache: {}/{}/{}",
+                     coordinates.x, coordinates.y, coordinates.zoom);
+        RemoveFromDisk(coordinates);
+        return nullptr;
+    }
+    return tile_data;
+}
+
 bool BasicTileCache::SaveMetadataToDisk(const TileMetadata& metadata) const {
+    if (auto packed_store = GetPackedStore()) {
+        return packed_store->UpdateMetadata(metadata);
+    }
+    
     const auto& coords = metadata.coordinates;
-    std::string file_path = GetMetadataFilePath(coords);
+    const std::string file_path = GetMetadataFilePath(coords);
+    const std::string temp_path = MakeTempPath(file_path);
     
     try {
-        std::ofstream file(file_path, std::ios::binary);
+        std::ofstream file(temp_path, std::ios::binary);
         if (!file) {
             return false;
         }
@@ -603,7 +1292,25 @@ bool BasicTileCache::SaveMetadataToDisk(const TileMetadata& metadata) const {
         auto access_time = std::chrono::system_clock::to_time_t(metadata.last_access);
         file.write(reinterpret_cast<const char*>(&access_time), sizeof(access_time));
         
-        return file.good();
+        std::uint32_t validator_size = metadata.server_last_modified.size();
+        file.write(reinterpret_cast<const char*>(&validator_size), sizeof(validator_size));
+        file.write(metadata.server_last_modified.c_str(), validator_size);
+        
+        const bool written = file.good();
+        const auto file_size = static_cast<std::uint32_t>(file.tellp());
+        file.close();
+        if (!written) {
+            std::filesystem::remove(temp_path);
+            return false;
+        }
+        if (!CommitTempFile(temp_path, file_path)) {
+            return false;
+        }
+        if (auto manifest = GetManifest()) {
+            manifest->RecordMetadata(coords, file_size, metadata.last_modified,
+                                     metadata.expires_at);
+        }
+        return true;
     } catch (const std::exception& e) {
         spdlog::error("Failed to save metadata to disk: {}", e.what());
         return false;
@@ -613,6 +1320,11 @@ bool BasicTileCache::SaveMetadataToDisk(const TileMetadata& metadata) const {
 std::unique_ptr<TileMetadata> BasicTileCache::LoadMetadataFromDisk(
     const TileCoordinates& coordinates) const {
     
+    if (auto packed_store = GetPackedStore()) {
+        auto metadata = packed_store->GetMetadata(coordinates);
+        return metadata ? std::make_unique<TileMetadata>(*metadata) : nullptr;
+    }
+    
     std::string file_path = GetMetadataFilePath(coordinates);
     
     try {
@@ -660,104 +1372,90 @@ std::unique_ptr<TileMetadata> BasicTileCache::LoadMetadataFromDisk(
         std::time_t access_time;
         file.read(reinterpret_cast<char*>(&access_time), sizeof(access_time));
         metadata->last_access = std::chrono::system_clock::from_time_t(access_time);
+        if (!file.good()) {
+            return nullptr;
+        }
         
-        return file.good() ? std::move(metadata) : nullptr;
+        // Trailing field: absent from files written before it existed
+        std::uint32_t validator_size = 0;
+        if (file.read(reinterpret_cast<char*>(&validator_size), sizeof(validator_size))) {
+            metadata->server_last_modified.resize(validator_size);
+            file.read(metadata->server_last_modified.data(), validator_size);
+            if (!file) {
+                metadata->server_last_modified.clear();
+            }
+        }
+        return metadata;
     } catch (const std::exception& e) {
         spdlog::error("Failed to load metadata from disk: {}", e.what());
         return nullptr;
     }
 }
 
-void BasicTileCache::UpdateLRU(const TileCoordinates& coordinates) const {
-    auto it = lru_index_.find(coordinates);
+void BasicTileCache::EvictFromDisk() {
+    // Single flight: concurrent callers would pick victims against the same usage
+    std::unique_lock<std::mutex> lock(eviction_mutex_, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return;
+    }
+    const std::size_t limit = GetConfiguration().max_disk_cache_size;
     
-    if (it != lru_index_.end()) {
-        // Move to end (most recently used)
-        std::size_t old_index = it->second;
-        lru_list_.erase(lru_list_.begin() + old_index);
-        lru_list_.push_back(coordinates);
-        
-        // Update indices
-        for (std::size_t i = old_index; i < lru_list_.size(); ++i) {
-            lru_index_[lru_list_[i]] = i;
-        }
-        lru_index_[coordinates] = lru_list_.size() - 1;
-    } else {
-        // Add to end
-        lru_list_.push_back(coordinates);
-        lru_index_[coordinates] = lru_list_.size() - 1;
+    if (auto packed_store = GetPackedStore()) {
+        // Segments go oldest-first; the store drops whole files, not single tiles
+        packed_store->EvictToFit(limit);
+        return;
+    }
+    auto manifest = GetManifest();
+    if (!manifest) {
+        return;
     }
-}
-
-void BasicTileCache::EvictFromMemory(std::size_t required_space) {
-    std::size_t freed_space = 0;
     
-    while (freed_space < required_space && !lru_list_.empty()) {
-        // Remove least recently used (front of list)
-        TileCoordinates coords_to_evict = lru_list_.front();
-        lru_list_.erase(lru_list_.begin());
-        lru_index_.erase(coords_to_evict);
-        
-        // Update indices
-        for (auto& [coords, index] : lru_index_) {
-            if (index > 0) {
-                --index;
+    // Victims come from the manifest's ordered index; writes that land while
+    // evicting are caught by the next round
+    std::size_t freed = 0;
+    std::size_t evicted = 0;
+    for (;;) {
+        const std::uint64_t usage = manifest->GetTotalSize();
+        if (usage <= limit) {
+            break;
+        }
+        std::size_t round = 0;
+        for (const auto& [coords, entry] : manifest->CollectVictims(usage - limit)) {
+            if (RemoveFromDisk(coords)) {
+                freed += static_cast<std::size_t>(entry.GetDiskSize());
+                ++round;
             }
         }
-        
-        // Remove from memory cache
-        auto it = memory_cache_.find(coords_to_evict);
-        if (it != memory_cache_.end()) {
-            freed_space += it->second->GetDataSize();
-            stats_.memory_cache_size -= it->second->GetDataSize();
-            stats_.memory_cache_count--;
-            stats_.total_evictions++;
-            
-            memory_cache_.erase(it);
+        if (round == 0) {
+            break;
         }
+        evicted += round;
     }
-}
-
-void BasicTileCache::EvictFromDisk(std::size_t required_space) {
-    (void)required_space;  // Suppress unused parameter warning
-    // TODO: Implement disk eviction logic
-    // This would involve analyzing file sizes and removing oldest/largest files
-    spdlog::warn("Disk eviction not yet implemented");
+    spdlog::debug("Evicted {} tiles ({} bytes) from disk cache", evicted, freed);
 }
 
 bool BasicTileCache::IsTileExpired(const TileMetadata& metadata) const {
     auto now = std::chrono::system_clock::now();
+    if (now < metadata.expires_at) {
+        return false;  // Server freshness outlasts the TTL
+    }
+    
     auto age = std::chrono::duration_cast<std::chrono::seconds>(
         now - metadata.last_modified).count();
     
+    std::shared_lock<std::shared_mutex> lock(config_mutex_);
     return static_cast<std::uint64_t>(age) > config_.tile_ttl;
 }
 
-std::size_t BasicTileCache::CalculateCurrentMemoryUsage() const {
-    std::size_t total_size = 0;
-    for (const auto& [coords, tile_data] : memory_cache_) {
-        if (tile_data) {
-            total_size += tile_data->GetDataSize();
-        }
-    }
-    return total_size;
-}
-
 std::size_t BasicTileCache::CalculateCurrentDiskUsage() const {
-    std::size_t total_size = 0;
-    
-    try {
-        for (const auto& entry : 
-             std::filesystem::recursive_directory_iterator(config_.disk_cache_directory)) {
-            if (entry.is_regular_file()) {
-                total_size += entry.file_size();
-            }
-        }
-    } catch (const std::exception&) {
-        // Ignore directory iteration errors
+    if (auto packed_store = GetPackedStore()) {
+        return packed_store->GetDiskUsage();
     }
     
-    return total_size;
+    if (auto manifest = GetManifest()) {
+        return static_cast<std::size_t>(manifest->GetTotalSize());
+    }
+    return 0;
 }
 
 } // namespace earth_map
@@ -0,0 +1,313 @@
+/**
+ * @file tile_compression.cpp
+ * @brief Implementation of tile compression codecs
+ */
+
+#include <earth_map/data/tile_compression.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+
+#ifdef EARTH_MAP_HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef EARTH_MAP_HAVE_LZ4
+#include <lz4.h>
+#endif
+#ifdef EARTH_MAP_HAVE_ZSTD
+#include <zstd.h>
+#include <zdict.h>
+#endif
+
+namespace earth_map {
+
+namespace {
+
+/// Refuse to inflate beyond this (corrupt or hostile input)
+constexpr std::size_t kMaxDecompressedSize = 256 * 1024 * 1024;
+
+#ifdef EARTH_MAP_HAVE_ZLIB
+
+std::optional<std::vector<std::uint8_t>> ZlibCompress(std::span<const std::uint8_t> data,
+                                                      bool gzip, int level) {
+    z_stream stream{};
+    const int window_bits = gzip ? 15 + 16 : 15;
+    if (deflateInit2(&stream, level > 0 ? level : Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                     window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return std::nullopt;
+    }
+    std::vector<std::uint8_t> out(deflateBound(&stream, static_cast<uLong>(data.size())));
+    stream.next_in = const_cast<Bytef*>(data.data());
+    stream.avail_in = static_cast<uInt>(data.size());
+    stream.next_out = out.data();
+    stream.avail_out = static_cast<uInt>(out.size());
+    const int result = deflate(&stream, Z_FINISH);
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+        return std::nullopt;
+    }
+    out.resize(stream.total_out);
+    return out;
+}
+
+std::optional<std::vector<std::uint8_t>> ZlibDecompress(std::span<const std::uint8_t> data) {
+    z_stream stream{};
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) {  // Auto-detect gzip or zlib header
+        return std::nullopt;
+    }
+    std::vector<std::uint8_t> out(std::max<std::size_t>(data.size() * 4, 1024));
+    stream.next_in = const_cast<Bytef*>(data.data());
+    stream.avail_in = static_cast<uInt>(data.size());
+    int result = Z_OK;
+    while (result == Z_OK) {
+        if (stream.total_out == out.size()) {
+            if (out.size() >= kMaxDecompressedSize) {
+                break;
+            }
+            out.resize(out.size() * 2);
+        }
+        stream.next_out = out.data() + stream.total_out;
+        stream.avail_out = static_cast<uInt>(out.size() - stream.total_out);
+        result = inflate(&stream, Z_NO_FLUSH);
+    }
+    inflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+        return std::nullopt;
+    }
+    out.resize(stream.total_out);
+    return out;
+}
+
+#endif
+
+#ifdef EARTH_MAP_HAVE_LZ4
+
+std::optional<std::vector<std::uint8_t>> Lz4Compress(std::span<const std::uint8_t> data,
+                                                     int level) {
+    if (data.size() > static_cast<std::size_t>(LZ4_MAX_INPUT_SIZE)) {
+        return std::nullopt;
+    }
+    const auto size = static_cast<std::uint32_t>(data.size());
+    std::vector<std::uint8_t> out(sizeof(size) + LZ4_compressBound(static_cast<int>(size)));
+    std::memcpy(out.data(), &size, sizeof(size));
+    // LZ4 "acceleration": higher is faster; level 0 keeps the default
+    const int written = LZ4_compress_fast(
+        reinterpret_cast<const char*>(data.data()),
+        reinterpret_cast<char*>(out.data() + sizeof(size)),
+        static_cast<int>(size), static_cast<int>(out.size() - sizeof(size)),
+        level > 0 ? level : 1);
+    if (written <= 0) {
+        return std::nullopt;
+    }
+    out.resize(sizeof(size) + static_cast<std::size_t>(written));
+    return out;
+}
+
+std::optional<std::vector<std::uint8_t>> Lz4Decompress(std::span<const std::uint8_t> data) {
+    std::uint32_t size = 0;
+    if (data.size() < sizeof(size)) {
+        return std::nullopt;
+    }
+    std::memcpy(&size, data.data(), sizeof(size));
+    if (size > kMaxDecompressedSize) {
+        return std::nullopt;
+    }
+    std::vector<std::uint8_t> out(size);
+    const int read = LZ4_decompress_safe(
+        reinterpret_cast<const char*>(data.data() + sizeof(size)),
+        reinterpret_cast<char*>(out.data()),
+        static_cast<int>(data.size() - sizeof(size)), static_cast<int>(size));
+    if (read < 0 || static_cast<std::uint32_t>(read) != size) {
+        return std::nullopt;
+    }
+    return out;
+}
+
+#endif
+
+} // namespace
+
+ZstdDictionary::ZstdDictionary(std::vector<std::uint8_t> bytes)
+    : bytes_(std::move(bytes)) {
+#ifdef EARTH_MAP_HAVE_ZSTD
+    id_ = ZDICT_getDictID(bytes_.data(), bytes_.size());
+    compress_dict_ = ZSTD_createCDict(bytes_.data(), bytes_.size(), ZSTD_CLEVEL_DEFAULT);
+    decompress_dict_ = ZSTD_createDDict(bytes_.data(), bytes_.size());
+#endif
+}
+
+ZstdDictionary::~ZstdDictionary() {
+#ifdef EARTH_MAP_HAVE_ZSTD
+    ZSTD_freeCDict(static_cast<ZSTD_CDict*>(compress_dict_));
+    ZSTD_freeDDict(static_cast<ZSTD_DDict*>(decompress_dict_));
+#endif
+}
+
+std::shared_ptr<const ZstdDictionary> ZstdDictionary::FromBytes(std::vector<std::uint8_t> bytes) {
+#ifdef EARTH_MAP_HAVE_ZSTD
+    if (bytes.empty()) {
+        return nullptr;
+    }
+    std::shared_ptr<const ZstdDictionary> dictionary(new ZstdDictionary(std::move(bytes)));
+    if (!dictionary->compress_dict_ || !dictionary->decompress_dict_) {
+        return nullptr;
+    }
+    return dictionary;
+#else
+    (void)bytes;
+    return nullptr;
+#endif
+}
+
+std::shared_ptr<const ZstdDictionary> ZstdDictionary::Train(
+    const std::vector<std::vector<std::uint8_t>>& samples, std::size_t capacity) {
+#ifdef EARTH_MAP_HAVE_ZSTD
+    std::vector<std::uint8_t> joined;
+    std::vector<std::size_t> sizes;
+    sizes.reserve(samples.size());
+    for (const auto& sample : samples) {
+        joined.insert(joined.end(), sample.begin(), sample.end());
+        sizes.push_back(sample.size());
+    }
+    std::vector<std::uint8_t> bytes(capacity);
+    const std::size_t size = ZDICT_trainFromBuffer(bytes.data(), bytes.size(), joined.data(),
+                                                   sizes.data(),
+                                                   static_cast<unsigned>(sizes.size()));
+    if (ZDICT_isError(size)) {
+        spdlog::warn("zstd dictionary training failed: {}", ZDICT_getErrorName(size));
+        return nullptr;
+    }
+    bytes.resize(size);
+    return FromBytes(std::move(bytes));
+#else
+    (void)samples;
+    (void)capacity;
+    return nullptr;
+#endif
+}
+
+bool IsCompressionAvailable(TileMetadata::Compression type) {
+    switch (type) {
+        case TileMetadata::Compression::NONE:
+            return true;
+        case TileMetadata::Compression::GZIP:
+        case TileMetadata::Compression::DEFLATE:
+#ifdef EARTH_MAP_HAVE_ZLIB
+            return true;
+#else
+            return false;
+#endif
+        case TileMetadata::Compression::LZ4:
+#ifdef EARTH_MAP_HAVE_LZ4
+            return true;
+#else
+            return false;
+#endif
+        case TileMetadata::Compression::ZSTD:
+#ifdef EARTH_MAP_HAVE_ZSTD
+            return true;
+#else
+            return false;
+#endif
+        case TileMetadata::Compression::BROTLI:
+            return false;
+    }
+    return false;
+}
+
+std::optional<std::vector<std::uint8_t>> CompressTileData(
+    std::span<const std::uint8_t> data, TileMetadata::Compression type,
+    int level, const ZstdDictionary* dictionary) {
+    (void)level;
+    (void)dictionary;
+    switch (type) {
+        case TileMetadata::Compression::NONE:
+            return std::vector<std::uint8_t>(data.begin(), data.end());
+#ifdef EARTH_MAP_HAVE_ZLIB
+        case TileMetadata::Compression::GZIP:
+            return ZlibCompress(data, true, level);
+        case TileMetadata::Compression::DEFLATE:
+            return ZlibCompress(data, false, level);
+#endif
+#ifdef EARTH_MAP_HAVE_LZ4
+        case TileMetadata::Compression::LZ4:
+            return Lz4Compress(data, level);
+#endif
+#ifdef EARTH_MAP_HAVE_ZSTD
+        case TileMetadata::Compression::ZSTD: {
+            std::vector<std::uint8_t> out(ZSTD_compressBound(data.size()));
+            ZSTD_CCtx* context = ZSTD_createCCtx();
+            std::size_t written;
+            if (dictionary && dictionary->compress_dict_) {
+                written = ZSTD_compress_usingCDict(
+                    context, out.data(), out.size(), data.data(), data.size(),
+                    static_cast<const ZSTD_CDict*>(dictionary->compress_dict_));
+            } else {
+                written = ZSTD_compressCCtx(context, out.data(), out.size(), data.data(),
+                                            data.size(),
+                                            level > 0 ? level : ZSTD_CLEVEL_DEFAULT);
+            }
+            ZSTD_freeCCtx(context);
+            if (ZSTD_isError(written)) {
+                return std::nullopt;
+            }
+            out.resize(written);
+            return out;
+        }
+#endif
+        default:
+            return std::nullopt;
+    }
+}
+
+std::optional<std::vector<std::uint8_t>> DecompressTileData(
+    std::span<const std::uint8_t> data, TileMetadata::Compression type,
+    const ZstdDictionary* dictionary) {
+    (void)dictionary;
+    switch (type) {
+        case TileMetadata::Compression::NONE:
+            return std::vector<std::uint8_t>(data.begin(), data.end());
+#ifdef EARTH_MAP_HAVE_ZLIB
+        case TileMetadata::Compression::GZIP:
+        case TileMetadata::Compression::DEFLATE:
+            return ZlibDecompress(data);
+#endif
+#ifdef EARTH_MAP_HAVE_LZ4
+        case TileMetadata::Compression::LZ4:
+            return Lz4Decompress(data);
+#endif
+#ifdef EARTH_MAP_HAVE_ZSTD
+        case TileMetadata::Compression::ZSTD: {
+            const unsigned long long size = ZSTD_getFrameContentSize(data.data(), data.size());
+            if (size == ZSTD_CONTENTSIZE_ERROR || size == ZSTD_CONTENTSIZE_UNKNOWN ||
+                size > kMaxDecompressedSize) {
+                return std::nullopt;
+            }
+            // A frame written with a dictionary needs that same dictionary
+            const unsigned frame_dict = ZSTD_getDictID_fromFrame(data.data(), data.size());
+            const bool use_dictionary = dictionary && dictionary->decompress_dict_ &&
+                                        frame_dict != 0;
+            if (frame_dict != 0 && (!use_dictionary || frame_dict != dictionary->id_)) {
+                return std::nullopt;
+            }
+            std::vector<std::uint8_t> out(static_cast<std::size_t>(size));
+            ZSTD_DCtx* context = ZSTD_createDCtx();
+            const std::size_t read = use_dictionary
+                ? ZSTD_decompress_usingDDict(
+                      context, out.data(), out.size(), data.data(), data.size(),
+                      static_cast<const ZSTD_DDict*>(dictionary->decompress_dict_))
+                : ZSTD_decompressDCtx(context, out.data(), out.size(), data.data(),
+                                      data.size());
+            ZSTD_freeDCtx(context);
+            if (ZSTD_isError(read) || read != out.size()) {
+                return std::nullopt;
+            }
+            return out;
+        }
+#endif
+        default:
+            return std::nullopt;
+    }
+}
+
+} // namespace earth_map
@@ -6,9 +6,14 @@
 #include <earth_map/data/tile_index.h>
 #include <earth_map/math/tile_mathematics.h>
 #include <algorithm>
+#include <array>
+#include <cmath>
 #include <stack>
 #include <optional>
 #include <chrono>
+#include <future>
+#include <thread>
+#include <unordered_set>
 #include <spdlog/spdlog.h>
 
 namespace earth_map {
@@ -234,13 +239,127 @@ QuadtreeNode::NodeStats QuadtreeNode::GetStatistics() const {
     return stats;
 }
 
+namespace {
+
+/// Quadkey code of a tile (see QuadtreeKey): codes sort by zoom, then Z-order
+std::uint64_t EncodeTile(const TileCoordinates& tile) {
+    return QuadtreeKey(tile).code;
+}
+
+std::int32_t CodeZoom(std::uint64_t code) {
+    return QuadtreeKey::FromCode(code).GetZoom();
+}
+
+TileCoordinates DecodeTile(std::uint64_t code) {
+    return QuadtreeKey::FromCode(code).ToTileCoordinates();
+}
+
+/// First code of a zoom level (the end of the previous one)
+std::uint64_t ZoomBegin(std::int32_t zoom) {
+    return std::uint64_t{1} << (2 * zoom);
+}
+
+/// Inputs this small are sorted with std::sort
+constexpr std::size_t kRadixSortMin = 1u << 12;
+
+/// Inputs this small are radix sorted on the calling thread
+constexpr std::size_t kParallelSortMin = 1u << 18;
+
 /**
- * @brief Basic tile index implementation
+ * @brief LSD radix sort of 64-bit keys, 8 bits per pass
+ *
+ * Passes over bytes that every key shares are skipped (codes of low
+ * zoom levels leave the high bytes zero). Large inputs histogram and
+ * scatter in parallel chunks: each chunk writes its keys of a bucket
+ * after those of the chunks before it, so every pass stays stable.
  */
-class BasicTileIndex : public TileIndex {
+void RadixSort(std::vector<std::uint64_t>& keys) {
+    if (keys.size() < kRadixSortMin) {
+        std::sort(keys.begin(), keys.end());
+        return;
+    }
+    const std::size_t chunk_count =
+        keys.size() < kParallelSortMin ? 1 : std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t chunk_size = (keys.size() + chunk_count - 1) / chunk_count;
+    const auto for_each_chunk = [&](const auto& work) {
+        std::vector<std::future<void>> tasks;
+        for (std::size_t chunk = 1; chunk < chunk_count; ++chunk) {
+            tasks.push_back(std::async(std::launch::async, work, chunk));
+        }
+        work(0);
+        for (std::future<void>& task : tasks) {
+            task.get();
+        }
+    };
+
+    std::uint64_t varying = 0;
+    for (const std::uint64_t key : keys) {
+        varying |= key ^ keys.front();
+    }
+
+    std::vector<std::uint64_t> buffer(keys.size());
+    std::vector<std::array<std::size_t, 256>> counts(chunk_count);
+    for (int shift = 0; shift < 64; shift += 8) {
+        if (((varying >> shift) & 0xFF) == 0) {
+            continue;
+        }
+        for_each_chunk([&](std::size_t chunk) {
+            std::array<std::size_t, 256>& count = counts[chunk];
+            count.fill(0);
+            const std::size_t end = std::min(keys.size(), (chunk + 1) * chunk_size);
+            for (std::size_t i = chunk * chunk_size; i < end; ++i) {
+                ++count[(keys[i] >> shift) & 0xFF];
+            }
+        });
+        // Exclusive prefix sums, bucket-major then chunk
+        std::size_t offset = 0;
+        for (std::size_t bucket = 0; bucket < 256; ++bucket) {
+            for (std::array<std::size_t, 256>& count : counts) {
+                const std::size_t n = count[bucket];
+                count[bucket] = offset;
+                offset += n;
+            }
+        }
+        for_each_chunk([&](std::size_t chunk) {
+            std::array<std::size_t, 256>& next = counts[chunk];
+            const std::size_t end = std::min(keys.size(), (chunk + 1) * chunk_size);
+            for (std::size_t i = chunk * chunk_size; i < end; ++i) {
+                buffer[next[(keys[i] >> shift) & 0xFF]++] = keys[i];
+            }
+        });
+        keys.swap(buffer);
+    }
+}
+
+/// Normalized Web Mercator y of a latitude (0 at the north edge, as tile rows)
+double NormalizedTileY(double latitude) {
+    constexpr double kMaxLatitude = 85.05112878;
+    const double sin_lat = std::sin(std::clamp(latitude, -kMaxLatitude, kMaxLatitude) * M_PI / 180.0);
+    return 0.5 - std::log((1.0 + sin_lat) / (1.0 - sin_lat)) / (4.0 * M_PI);
+}
+
+/// Tile column or row of a normalized Web Mercator coordinate, clamped
+std::int32_t ToTile(double normalized, std::int32_t tiles) {
+    return static_cast<std::int32_t>(
+        std::clamp(std::floor(normalized * tiles), 0.0, static_cast<double>(tiles - 1)));
+}
+
+} // namespace
+
+/**
+ * @brief Linear quadtree tile index
+ *
+ * Tiles are kept as a sorted array of quadkey codes (8 bytes per tile).
+ * A zoom level is a contiguous run found by binary search; a bounds query
+ * descends the implicit quadtree over a level, binary searching each
+ * cell's code range, and copies whole runs for cells inside the bounds.
+ * Edits collect in small hash sets merged into the array before the next
+ * query, or once they reach an eighth of it.
+ */
+class LinearTileIndex : public TileIndex {
 public:
-    explicit BasicTileIndex(const TileIndexConfig& config) : config_(config) {}
-    ~BasicTileIndex() override = default;
+    explicit LinearTileIndex(const TileIndexConfig& config) : config_(config) {}
+    ~LinearTileIndex() override = default;
     
     bool Initialize(const TileIndexConfig& config) override;
     bool Insert(const TileCoordinates& tile) override;
@@ -253,6 +372,10 @@ public:
     std::vector<TileCoordinates> Query(const BoundingBox2D& bounds,
                                        std::int32_t min_zoom,
                                        std::int32_t max_zoom) const override;
+    void Query(const BoundingBox2D& bounds,
+               std::int32_t min_zoom,
+               std::int32_t max_zoom,
+               std::pmr::vector<TileCoordinates>& results) const override;
     
     std::vector<TileCoordinates> QueryVisible(
         const glm::vec3& camera_position,
@@ -281,116 +404,122 @@ public:
     void Update() override;
 
 private:
+    /// Below this, edits are merged at the next query rather than on arrival
+    static constexpr std::size_t MIN_PENDING_EDITS = 4096;
+
     TileIndexConfig config_;
-    std::shared_ptr<QuadtreeNode> root_;
-    std::unordered_map<TileCoordinates, BoundingBox2D, TileCoordinatesHash> tile_bounds_;
+    bool initialized_ = false;
+    
+    /// Sorted quadkey codes; pending edits are merged in before queries
+    mutable std::vector<std::uint64_t> codes_;
+    mutable std::unordered_set<std::uint64_t> pending_inserts_;   ///< Not in codes_
+    mutable std::unordered_set<std::uint64_t> pending_removals_;  ///< In codes_
     
     // Statistics tracking
     mutable std::size_t query_count_ = 0;
-    mutable std::uint64_t total_query_time_ms_ = 0;
+    mutable std::uint64_t total_query_time_us_ = 0;
     
     // Internal methods
-    BoundingBox2D GetWorldBounds() const;
-    void UpdateStatistics(const TileCoordinates& tile, bool added);
-    std::vector<TileCoordinates> FilterByZoom(const std::vector<TileCoordinates>& tiles,
-                                              std::int32_t zoom_level) const;
-    std::vector<TileCoordinates> FilterByZoomRange(const std::vector<TileCoordinates>& tiles,
-                                                   std::int32_t min_zoom,
-                                                   std::int32_t max_zoom) const;
+    void MergePending() const;
+    void MergePendingIfLarge() const;
+    /// Append the tiles of one zoom; scratch comes from the results' allocator
+    template <typename Results>
+    void QueryZoom(const BoundingBox2D& bounds, std::int32_t zoom, Results& results) const;
+    template <typename Results>
+    void QueryZoomRange(const BoundingBox2D& bounds,
+                        std::int32_t min_zoom,
+                        std::int32_t max_zoom,
+                        Results& results) const;
+    std::pair<std::size_t, std::size_t> ZoomRange(std::int32_t min_zoom,
+                                                  std::int32_t max_zoom) const;
 };
 
+void TileIndex::Query(const BoundingBox2D& bounds,
+                      std::int32_t min_zoom,
+                      std::int32_t max_zoom,
+                      std::pmr::vector<TileCoordinates>& results) const {
+    const std::vector<TileCoordinates> tiles = Query(bounds, min_zoom, max_zoom);
+    results.insert(results.end(), tiles.begin(), tiles.end());
+}
+
 // Factory function
 std::unique_ptr<TileIndex> CreateTileIndex(const TileIndexConfig& config) {
-    return std::make_unique<BasicTileIndex>(config);
+    return std::make_unique<LinearTileIndex>(config);
 }
 
-bool BasicTileIndex::Initialize(const TileIndexConfig& config) {
+bool LinearTileIndex::Initialize(const TileIndexConfig& config) {
     config_ = config;
+    Clear();
+    initialized_ = true;
     
-    // Create root node covering entire world
-    BoundingBox2D world_bounds = GetWorldBounds();
-    root_ = std::make_shared<QuadtreeNode>(
-        world_bounds, 0, config_.max_tiles_per_node, config_.max_quadtree_depth);
-    
-    tile_bounds_.clear();
-    
-    spdlog::info("Tile index initialized with world bounds: [{}, {}] to [{}, {}]",
-                 world_bounds.min.x, world_bounds.min.y,
-                 world_bounds.max.x, world_bounds.max.y);
+    spdlog::info("Tile index initialized (linear quadtree)");
     
     return true;
 }
 
-bool BasicTileIndex::Insert(const TileCoordinates& tile) {
-    if (!root_) {
+bool LinearTileIndex::Insert(const TileCoordinates& tile) {
+    if (!initialized_ || !tile.IsValid()) {
         return false;
     }
     
-    // Store tile bounds for faster access
-    BoundingBox2D bounds = TileMathematics::GetTileBounds(tile);
-    tile_bounds_[tile] = bounds;
-    
-    bool success = root_->Insert(tile);
-    if (success) {
-        UpdateStatistics(tile, true);
+    const std::uint64_t code = EncodeTile(tile);
+    if (pending_removals_.erase(code) == 0 &&
+        !std::binary_search(codes_.begin(), codes_.end(), code)) {
+        pending_inserts_.insert(code);
+        MergePendingIfLarge();
     }
-    
-    return success;
+    return true;
 }
 
-bool BasicTileIndex::Remove(const TileCoordinates& tile) {
-    if (!root_) {
+bool LinearTileIndex::Remove(const TileCoordinates& tile) {
+    if (!Contains(tile)) {
         return false;
     }
     
-    bool success = root_->Remove(tile);
-    if (success) {
-        tile_bounds_.erase(tile);
-        UpdateStatistics(tile, false);
+    const std::uint64_t code = EncodeTile(tile);
+    if (pending_inserts_.erase(code) == 0) {
+        pending_removals_.insert(code);
+        MergePendingIfLarge();
     }
-    
-    return success;
+    return true;
 }
 
-bool BasicTileIndex::Update(const TileCoordinates& old_tile, const TileCoordinates& new_tile) {
+bool LinearTileIndex::Update(const TileCoordinates& old_tile, const TileCoordinates& new_tile) {
     if (Remove(old_tile)) {
         return Insert(new_tile);
     }
     return false;
 }
 
-std::vector<TileCoordinates> BasicTileIndex::Query(const BoundingBox2D& bounds) const {
-    auto start_time = std::chrono::steady_clock::now();
-    
+std::vector<TileCoordinates> LinearTileIndex::Query(const BoundingBox2D& bounds) const {
     std::vector<TileCoordinates> results;
-    if (root_) {
-        results = root_->Query(bounds);
-    }
-    
-    // Update statistics
-    auto end_time = std::chrono::steady_clock::now();
-    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-    
-    query_count_++;
-    total_query_time_ms_ += duration.count();
-    
+    QueryZoomRange(bounds, 0, 30, results);
+    return results;
+}
+
+std::vector<TileCoordinates> LinearTileIndex::Query(const BoundingBox2D& bounds,
+                                                    std::int32_t zoom_level) const {
+    std::vector<TileCoordinates> results;
+    QueryZoomRange(bounds, zoom_level, zoom_level, results);
     return results;
 }
 
-std::vector<TileCoordinates> BasicTileIndex::Query(const BoundingBox2D& bounds,
-                                                   std::int32_t zoom_level) const {
-    auto all_tiles = Query(bounds);
-    return FilterByZoom(all_tiles, zoom_level);
+std::vector<TileCoordinates> LinearTileIndex::Query(const BoundingBox2D& bounds,
+                                                    std::int32_t min_zoom,
+                                                    std::int32_t max_zoom) const {
+    std::vector<TileCoordinates> results;
+    QueryZoomRange(bounds, min_zoom, max_zoom, results);
+    return results;
 }
 
-std::vector<TileCoordinates> BasicTileIndex::Query(const BoundingBox2D& bounds,
-                                                   std::int32_t min_zoom,
-                                                   std::int32_t max_zoom) const {
-    auto all_tiles = Query(bounds);
-    return FilterByZoomRange(all_tiles, min_zoom, max_zoom);
+void LinearTileIndex::Query(const BoundingBox2D& bounds,
+                            std::int32_t min_zoom,
+                            std::int32_t max_zoom,
+                            std::pmr::vector<TileCoordinates>& results) const {
+    QueryZoomRange(bounds, min_zoom, max_zoom, results);
 }
 
-std::vector<TileCoordinates> BasicTileIndex::QueryVisible(
+std::vector<TileCoordinates> LinearTileIndex::QueryVisible(
     const glm::vec3& camera_position,
     const glm::mat4& view_matrix,
     const glm::mat4& projection_matrix,
@@ -413,20 +542,23 @@ std::vector<TileCoordinates> BasicTileIndex::QueryVisible(
     return Query(visible_bounds);
 }
 
-std::vector<TileCoordinates> BasicTileIndex::GetTilesAtZoom(std::int32_t zoom_level) const {
-    BoundingBox2D world_bounds = GetWorldBounds();
-    auto all_tiles = Query(world_bounds);
-    return FilterByZoom(all_tiles, zoom_level);
+std::vector<TileCoordinates> LinearTileIndex::GetTilesAtZoom(std::int32_t zoom_level) const {
+    return GetTilesInRange(zoom_level, zoom_level);
 }
 
-std::vector<TileCoordinates> BasicTileIndex::GetTilesInRange(std::int32_t min_zoom,
-                                                            std::int32_t max_zoom) const {
-    BoundingBox2D world_bounds = GetWorldBounds();
-    auto all_tiles = Query(world_bounds);
-    return FilterByZoomRange(all_tiles, min_zoom, max_zoom);
+std::vector<TileCoordinates> LinearTileIndex::GetTilesInRange(std::int32_t min_zoom,
+                                                             std::int32_t max_zoom) const {
+    MergePending();
+    const auto [first, last] = ZoomRange(min_zoom, max_zoom);
+    std::vector<TileCoordinates> tiles;
+    tiles.reserve(last - first);
+    for (std::size_t i = first; i < last; ++i) {
+        tiles.push_back(DecodeTile(codes_[i]));
+    }
+    return tiles;
 }
 
-std::array<TileCoordinates, 8> BasicTileIndex::GetNeighbors(const TileCoordinates& tile) const {
+std::array<TileCoordinates, 8> LinearTileIndex::GetNeighbors(const TileCoordinates& tile) const {
     std::array<TileCoordinates, 8> neighbors;
     
     // Neighbor offsets (N, NE, E, SE, S, SW, W, NW)
@@ -452,7 +584,7 @@ std::array<TileCoordinates, 8> BasicTileIndex::GetNeighbors(const TileCoordinate
     return neighbors;
 }
 
-std::optional<TileCoordinates> BasicTileIndex::GetParent(const TileCoordinates& tile) const {
+std::optional<TileCoordinates> LinearTileIndex::GetParent(const TileCoordinates& tile) const {
     if (tile.zoom == 0) {
         return std::nullopt;  // Root level has no parent
     }
@@ -464,7 +596,7 @@ std::optional<TileCoordinates> BasicTileIndex::GetParent(const TileCoordinates&
     );
 }
 
-std::array<TileCoordinates, 4> BasicTileIndex::GetChildren(const TileCoordinates& tile) const {
+std::array<TileCoordinates, 4> LinearTileIndex::GetChildren(const TileCoordinates& tile) const {
     std::array<TileCoordinates, 4> children;
     
     for (int i = 0; i < 4; ++i) {
@@ -476,135 +608,217 @@ std::array<TileCoordinates, 4> BasicTileIndex::GetChildren(const TileCoordinates
     return children;
 }
 
-void BasicTileIndex::Clear() {
-    if (root_) {
-        root_->Clear();
-    }
-    tile_bounds_.clear();
+void LinearTileIndex::Clear() {
+    codes_.clear();
+    codes_.shrink_to_fit();
+    pending_inserts_.clear();
+    pending_removals_.clear();
     
     query_count_ = 0;
-    total_query_time_ms_ = 0;
+    total_query_time_us_ = 0;
     
     spdlog::info("Tile index cleared");
 }
 
-void BasicTileIndex::Rebuild() {
-    // Store current tiles
-    std::vector<TileCoordinates> current_tiles;
-    if (root_) {
-        current_tiles = root_->GetAllTiles();
+void LinearTileIndex::Rebuild() {
+    // Sort every code afresh (parallel radix sort) rather than merging
+    for (const std::uint64_t code : pending_inserts_) {
+        codes_.push_back(code);
     }
-    
-    // Reinitialize
-    Initialize(config_);
-    
-    // Re-insert all tiles
-    for (const auto& tile : current_tiles) {
-        Insert(tile);
+    if (!pending_removals_.empty()) {
+        std::erase_if(codes_, [&](std::uint64_t code) { return pending_removals_.count(code) > 0; });
     }
+    pending_inserts_.clear();
+    pending_removals_.clear();
+    RadixSort(codes_);
+    codes_.shrink_to_fit();
     
-    spdlog::info("Tile index rebuilt with {} tiles", current_tiles.size());
+    spdlog::info("Tile index rebuilt with {} tiles", codes_.size());
 }
 
-BasicTileIndex::IndexStats BasicTileIndex::GetStatistics() const {
+LinearTileIndex::IndexStats LinearTileIndex::GetStatistics() const {
+    MergePending();
     IndexStats stats;
+    stats.total_tiles = codes_.size();
     
-    if (root_) {
-        auto node_stats = root_->GetStatistics();
-        stats.total_tiles = node_stats.tile_count;
-        stats.total_nodes = node_stats.node_count;
-        stats.leaf_nodes = node_stats.leaf_count;
-        stats.max_depth = node_stats.max_depth;
+    // Nodes of the implicit quadtree: every cell holding a tile or an ancestor of one
+    std::unordered_set<std::uint64_t> cells;
+    for (const std::uint64_t code : codes_) {
+        for (std::uint64_t cell = code; cell != 0 && cells.insert(cell).second; cell >>= 2) {
+        }
+        stats.tiles_per_zoom[CodeZoom(code)]++;
+    }
+    stats.total_nodes = cells.size();
+    for (const std::uint64_t cell : cells) {
+        bool leaf = true;
+        for (std::uint64_t child = cell << 2; leaf && child < (cell << 2) + 4; ++child) {
+            leaf = cells.count(child) == 0;
+        }
+        stats.leaf_nodes += leaf ? 1 : 0;
     }
+    stats.max_depth = codes_.empty() ? 0 : static_cast<std::size_t>(CodeZoom(codes_.back()));
     
     stats.query_count = query_count_;
     
     if (query_count_ > 0) {
-        stats.average_query_time_ms = static_cast<float>(total_query_time_ms_) / query_count_;
-    }
-    
-    // Count tiles per zoom level
-    for (const auto& [tile, bounds] : tile_bounds_) {
-        stats.tiles_per_zoom[tile.zoom]++;
+        stats.average_query_time_ms =
+            static_cast<float>(total_query_time_us_) / 1000.0f / query_count_;
     }
     
     return stats;
 }
 
-bool BasicTileIndex::SetConfiguration(const TileIndexConfig& config) {
+bool LinearTileIndex::SetConfiguration(const TileIndexConfig& config) {
     config_ = config;
-    
-    // Rebuild if needed
-    if (root_) {
-        Rebuild();
-    }
-    
     return true;
 }
 
-bool BasicTileIndex::Contains(const TileCoordinates& tile) const {
-    return tile_bounds_.find(tile) != tile_bounds_.end();
+bool LinearTileIndex::Contains(const TileCoordinates& tile) const {
+    if (!tile.IsValid()) {
+        return false;
+    }
+    const std::uint64_t code = EncodeTile(tile);
+    if (pending_inserts_.count(code) > 0) {
+        return true;
+    }
+    return pending_removals_.count(code) == 0 &&
+           std::binary_search(codes_.begin(), codes_.end(), code);
+}
+
+std::size_t LinearTileIndex::GetTileCount() const {
+    return codes_.size() + pending_inserts_.size() - pending_removals_.size();
 }
 
-std::size_t BasicTileIndex::GetTileCount() const {
-    return tile_bounds_.size();
+void LinearTileIndex::Update() {
+    // Periodic maintenance: fold edits into the sorted array between frames
+    MergePending();
 }
 
-void BasicTileIndex::Update() {
-    // Periodic maintenance tasks
-    if (config_.enable_auto_rebuild) {
-        // Check if rebuild is needed based on some heuristic
-        // For now, skip this optimization
+void LinearTileIndex::MergePending() const {
+    if (!pending_removals_.empty()) {
+        std::erase_if(codes_, [&](std::uint64_t code) { return pending_removals_.count(code) > 0; });
+        pending_removals_.clear();
+    }
+    if (pending_inserts_.empty()) {
+        return;
     }
+    std::vector<std::uint64_t> inserts(pending_inserts_.begin(), pending_inserts_.end());
+    pending_inserts_.clear();
+    RadixSort(inserts);
+    const std::size_t middle = codes_.size();
+    codes_.insert(codes_.end(), inserts.begin(), inserts.end());
+    std::inplace_merge(codes_.begin(), codes_.begin() + static_cast<std::ptrdiff_t>(middle),
+                       codes_.end());
 }
 
-BoundingBox2D BasicTileIndex::GetWorldBounds() const {
-    BoundingBox2D world_bounds;
-    world_bounds.min = glm::dvec2(-180.0, -85.05112878);  // Web Mercator bounds
-    world_bounds.max = glm::dvec2(180.0, 85.05112878);
-    return world_bounds;
+void LinearTileIndex::MergePendingIfLarge() const {
+    const std::size_t pending = pending_inserts_.size() + pending_removals_.size();
+    if (pending >= std::max(MIN_PENDING_EDITS, codes_.size() / 8)) {
+        MergePending();
+    }
 }
 
-void BasicTileIndex::UpdateStatistics(const TileCoordinates& tile, bool added) {
-    // Suppress unused parameter warnings for now
-    (void)tile;
-    (void)added;
-    
-    // Statistics are updated lazily in GetStatistics()
-    // This could be optimized to maintain running counts
+std::pair<std::size_t, std::size_t> LinearTileIndex::ZoomRange(std::int32_t min_zoom,
+                                                               std::int32_t max_zoom) const {
+    min_zoom = std::max(min_zoom, 0);
+    max_zoom = std::min(max_zoom, 30);
+    if (min_zoom > max_zoom) {
+        return {0, 0};
+    }
+    const auto first = std::lower_bound(codes_.begin(), codes_.end(), ZoomBegin(min_zoom));
+    const auto last = std::lower_bound(first, codes_.end(), ZoomBegin(max_zoom + 1));
+    return {static_cast<std::size_t>(first - codes_.begin()),
+            static_cast<std::size_t>(last - codes_.begin())};
 }
 
-std::vector<TileCoordinates> BasicTileIndex::FilterByZoom(
-    const std::vector<TileCoordinates>& tiles,
-    std::int32_t zoom_level) const {
-    
-    std::vector<TileCoordinates> filtered;
-    filtered.reserve(tiles.size());
+template <typename Results>
+void LinearTileIndex::QueryZoomRange(const BoundingBox2D& bounds,
+                                     std::int32_t min_zoom,
+                                     std::int32_t max_zoom,
+                                     Results& results) const {
+    auto start_time = std::chrono::steady_clock::now();
     
-    for (const auto& tile : tiles) {
-        if (tile.zoom == zoom_level) {
-            filtered.push_back(tile);
+    MergePending();
+    if (bounds.IsValid()) {
+        for (std::int32_t zoom = std::max(min_zoom, 0); zoom <= std::min(max_zoom, 30); ++zoom) {
+            QueryZoom(bounds, zoom, results);
         }
     }
     
-    return filtered;
-}
-
-std::vector<TileCoordinates> BasicTileIndex::FilterByZoomRange(
-    const std::vector<TileCoordinates>& tiles,
-    std::int32_t min_zoom,
-    std::int32_t max_zoom) const {
-    
-    std::vector<TileCoordinates> filtered;
-    filtered.reserve(tiles.size());
+    // Update statistics
+    auto end_time = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
     
-    for (const auto& tile : tiles) {
-        if (tile.zoom >= min_zoom && tile.zoom <= max_zoom) {
-            filtered.push_back(tile);
+    query_count_++;
+    total_query_time_us_ += duration.count();
+}
+
+template <typename Results>
+void LinearTileIndex::QueryZoom(const BoundingBox2D& bounds, std::int32_t zoom,
+                                Results& results) const {
+    const auto [level_first, level_last] = ZoomRange(zoom, zoom);
+    if (level_first == level_last) {
+        return;
+    }
+    
+    // Tiles around the bounds, one extra on each side; the outer ring is checked exactly
+    const std::int32_t tiles = std::int32_t{1} << zoom;
+    const std::int32_t x0 = std::max(0, ToTile((bounds.min.x + 180.0) / 360.0, tiles) - 1);
+    const std::int32_t x1 = std::min(tiles - 1, ToTile((bounds.max.x + 180.0) / 360.0, tiles) + 1);
+    const std::int32_t y0 = std::max(0, ToTile(NormalizedTileY(bounds.max.y), tiles) - 1);
+    const std::int32_t y1 = std::min(tiles - 1, ToTile(NormalizedTileY(bounds.min.y), tiles) + 1);
+    const auto emit = [&](std::uint64_t code) {
+        const TileCoordinates tile = DecodeTile(code);
+        const bool ring = tile.x == x0 || tile.x == x1 || tile.y == y0 || tile.y == y1;
+        if (!ring || TileMathematics::GetTileBounds(tile).Intersects(bounds)) {
+            results.push_back(tile);
+        }
+    };
+    
+    // Descend the implicit quadtree; a cell's tiles of this zoom are one code range
+    struct Cell {
+        std::uint64_t code;
+        std::int32_t level;
+        std::int32_t x, y;
+        std::size_t first, last;  ///< Bounds on the position of its codes
+    };
+    using CellAllocator = typename std::allocator_traits<
+        typename Results::allocator_type>::template rebind_alloc<Cell>;
+    std::vector<Cell, CellAllocator> stack(CellAllocator(results.get_allocator()));
+    stack.push_back({1, 0, 0, 0, level_first, level_last});
+    while (!stack.empty()) {
+        const Cell cell = stack.back();
+        stack.pop_back();
+        const std::int32_t depth = zoom - cell.level;
+        const std::int32_t cx0 = cell.x << depth;
+        const std::int32_t cx1 = cx0 + (std::int32_t{1} << depth) - 1;
+        const std::int32_t cy0 = cell.y << depth;
+        const std::int32_t cy1 = cy0 + (std::int32_t{1} << depth) - 1;
+        if (cx1 < x0 || cx0 > x1 || cy1 < y0 || cy0 > y1) {
+            continue;
+        }
+        const auto begin = codes_.begin();
+        const auto first = std::lower_bound(begin + cell.first, begin + cell.last,
+                                            cell.code << (2 * depth));
+        const auto last = std::lower_bound(first, begin + cell.last,
+                                           (cell.code + 1) << (2 * depth));
+        if (first == last) {
+            continue;
+        }
+        if (cx0 >= x0 && cx1 <= x1 && cy0 >= y0 && cy1 <= y1) {
+            for (auto it = first; it != last; ++it) {
+                emit(*it);
+            }
+            continue;
+        }
+        for (std::uint64_t quadrant = 4; quadrant-- > 0;) {
+            stack.push_back({(cell.code << 2) | quadrant, cell.level + 1,
+                             (cell.x << 1) | static_cast<std::int32_t>(quadrant & 1),
+                             (cell.y << 1) | static_cast<std::int32_t>(quadrant >> 1),
+                             static_cast<std::size_t>(first - begin),
+                             static_cast<std::size_t>(last - begin)});
         }
     }
-    
-    return filtered;
 }
 
 } // namespace earth_map
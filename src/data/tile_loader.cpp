@@ -1,21 +1,26 @@
 /**
  * @file tile_loader.cpp
- * @brief Tile loading system implementation with libcurl support and thread pool
+ * @brief Tile loading system implementation on the multiplexed libcurl download engine
  */
 
 #include <earth_map/data/tile_loader.h>
+#include <earth_map/data/crc32c.h>
+#include <earth_map/data/http_download_engine.h>
+#include <earth_map/data/retry_policy.h>
+#include <earth_map/data/single_flight.h>
 #include <earth_map/math/tile_mathematics.h>
 #include <algorithm>
+#include <cmath>
 #include <sstream>
 #include <iomanip>
 #include <random>
-#include <thread>
 #include <future>
+#include <mutex>
+#include <optional>
 #include <set>
+#include <stdexcept>
 #include <unordered_set>
 #include <regex>
-#include <queue>
-#include <condition_variable>
 #include <atomic>
 #include <curl/curl.h>
 #include <spdlog/spdlog.h>
@@ -57,119 +62,151 @@ std::shared_ptr<TileProvider> CartoDBPositron = CreateCartoDBPositron();
 } // namespace TileProviders
 
 /**
- * @brief Download task for thread pool
+ * @brief State of one tile download across retries
+ *
+ * Captures everything needed from the provider up front so the download
+ * engine's completion callbacks never touch the provider map.
  */
-struct DownloadTask {
+struct DownloadJob {
     TileCoordinates coordinates;
     std::string provider_name;
-    std::shared_ptr<std::promise<TileLoadResult>> promise;
-    TileLoadCallback callback;
-    
-    DownloadTask(const TileCoordinates& coords, 
-                const std::string& provider,
-                std::shared_ptr<std::promise<TileLoadResult>> prom,
-                TileLoadCallback cb)
-        : coordinates(coords), provider_name(provider), promise(prom), callback(cb) {}
+    std::string url;
+    std::string host;
+    std::vector<std::pair<std::string, std::string>> headers;
+    std::string content_type;
+    std::uint32_t max_retries = 0;
+    std::uint32_t scheduling_weight = 1;
+    RetryBackoff backoff;
+    std::uint32_t attempt = 0;
+    std::uint64_t start_time_ms = 0;
+    std::atomic<bool> cancelled{false};
+    std::atomic<HttpRequestId> request_id{0};
+    std::function<void(const TileLoadResult&)> on_complete;
+    
+    /// Hedging: mirror of url (empty = none) and the race of the current attempt
+    std::string mirror_url;
+    std::string mirror_host;
+    std::atomic<HttpRequestId> hedge_request_id{0};
+    std::atomic<std::uint32_t> round{0};         ///< Attempt round; stale answers are ignored
+    std::atomic<std::uint32_t> outstanding{0};   ///< Requests of the round still unanswered
+    std::chrono::steady_clock::time_point hedge_at{};  ///< Hedge start of this round (if any)
+    
+    /// Cached metadata being revalidated (conditional request), if any
+    std::optional<TileMetadata> revalidating;
+    
+    /// Provider variant downloaded (kNoVariant: the provider has none)
+    std::size_t variant = TileVariantSelector::kNoVariant;
+    std::string variant_name;
+    bool degraded = false;  ///< Cheaper than the preferred variant
 };
 
+namespace {
+
 /**
- * @brief Thread pool for tile downloading
+ * @brief Check whether a cached tile is past its freshness lifetime
+ *
+ * Tiles cached before expires_at was recorded fall back to the cache TTL.
  */
-class ThreadPool {
-public:
-    explicit ThreadPool(std::size_t num_threads) : stop_(false) {
-        for (std::size_t i = 0; i < num_threads; ++i) {
-            workers_.emplace_back([this] {
-                while (true) {
-                    std::function<void()> task;
-                    
-                    {
-                        std::unique_lock<std::mutex> lock(queue_mutex_);
-                        condition_.wait(lock, [this] { 
-                            return stop_ || !tasks_.empty(); 
-                        });
-                        
-                        if (stop_ && tasks_.empty()) {
-                            return;
-                        }
-                        
-                        task = std::move(tasks_.front());
-                        tasks_.pop();
-                    }
-                    
-                    task();
-                }
-            });
-        }
-    }
-    
-    ~ThreadPool() {
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            stop_ = true;
-        }
-        
-        condition_.notify_all();
-        
-        for (auto& worker : workers_) {
-            worker.join();
-        }
-    }
-    
-    template<class F>
-    void enqueue(F&& f) {
-        {
-            std::unique_lock<std::mutex> lock(queue_mutex_);
-            tasks_.emplace(std::forward<F>(f));
-        }
-        
-        condition_.notify_one();
-    }
-    
-    std::size_t GetQueueSize() const {
-        std::unique_lock<std::mutex> lock(queue_mutex_);
-        return tasks_.size();
+bool IsStale(const TileMetadata& metadata, std::uint64_t ttl_seconds) {
+    const auto now = std::chrono::system_clock::now();
+    if (metadata.expires_at.time_since_epoch().count() != 0) {
+        return now >= metadata.expires_at;
     }
+    return now - metadata.last_modified > std::chrono::seconds(ttl_seconds);
+}
+
+/**
+ * @brief Check whether a failed response is worth retrying
+ *
+ * Transport errors, timeouts, throttling and server errors are transient;
+ * other 4xx answers (404 and friends) will not change on a retry.
+ */
+bool IsRetryable(const HttpResponse& response) {
+    const std::uint32_t status = response.status_code;
+    return response.success || status == 0 || status == 408 || status == 429 || status >= 500;
+}
+
+/**
+ * @brief Check whether a failed response says the host is unhealthy
+ */
+bool IsHostFailure(const HttpResponse& response) {
+    return !response.success && IsRetryable(response);
+}
+
+/// Uniform random value in [0, 1) for retry jitter
+double RandomUnit() {
+    thread_local std::mt19937 generator{std::random_device{}()};
+    return std::uniform_real_distribution<double>(0.0, 1.0)(generator);
+}
+
+CircuitBreakerConfig ToCircuitBreakerConfig(const TileLoaderConfig& config) {
+    CircuitBreakerConfig breaker;
+    breaker.failure_threshold = config.circuit_breaker_threshold;
+    breaker.cooldown = std::chrono::milliseconds(config.circuit_breaker_cooldown);
+    return breaker;
+}
+
+TileVariantSelectorConfig ToVariantSelectorConfig(const TileLoaderConfig& config) {
+    TileVariantSelectorConfig selector;
+    selector.required_pixel_scale = config.required_pixel_scale;
+    selector.target_latency = std::chrono::milliseconds(config.variant_target_latency);
+    return selector;
+}
+
+} // namespace
+
+/**
+ * @brief Key of a coalesced load: the same tile from two providers is two loads
+ */
+struct TileRequestKey {
+    std::string provider_name;
+    TileCoordinates coordinates;
     
-    std::size_t GetThreadCount() const {
-        return workers_.size();
+    bool operator==(const TileRequestKey& other) const {
+        return coordinates == other.coordinates && provider_name == other.provider_name;
     }
+};
 
-private:
-    std::vector<std::thread> workers_;
-    std::queue<std::function<void()>> tasks_;
-    mutable std::mutex queue_mutex_;
-    std::condition_variable condition_;
-    bool stop_;
+struct TileRequestKeyHash {
+    std::size_t operator()(const TileRequestKey& key) const {
+        return TileCoordinatesHash{}(key.coordinates) ^
+               (std::hash<std::string>{}(key.provider_name) << 1);
+    }
 };
 
 /**
- * @brief libcurl write callback
+ * @brief Download started by the leader of a coalesced load (for cancellation)
  */
-size_t WriteCallback(void* contents, size_t size, size_t nmemb, std::vector<uint8_t>* userp) {
-    size_t total_size = size * nmemb;
-    userp->insert(userp->end(), static_cast<uint8_t*>(contents), 
-                  static_cast<uint8_t*>(contents) + total_size);
-    return total_size;
-}
+struct ActiveLoad {
+    std::uint64_t call_id = 0;
+    std::shared_ptr<DownloadJob> job;
+};
+
+using TileLoadFlights = SingleFlight<TileRequestKey, TileLoadResult, TileRequestKeyHash>;
 
 /**
- * @brief Basic tile loader implementation with thread pool and libcurl
+ * @brief Basic tile loader implementation on top of the multiplexed download engine
  */
 class BasicTileLoader : public TileLoader {
 public:
     explicit BasicTileLoader(const TileLoaderConfig& config) 
-        : config_(config), thread_pool_(config_.max_concurrent_downloads) {
-        // Initialize curl globally
+        : config_(config)
+        , variant_selector_(ToVariantSelectorConfig(config))
+        , circuit_breaker_(ToCircuitBreakerConfig(config)) {
+        // Initialize curl globally before the engine creates its multi handle
         curl_global_init(CURL_GLOBAL_DEFAULT);
+        engine_ = CreateHttpDownloadEngine(config_);
     }
     
     ~BasicTileLoader() override {
+        // Stop the event loop (and resolve outstanding loads) while curl is still initialized
+        engine_.reset();
         curl_global_cleanup();
     }
     
     bool Initialize(const TileLoaderConfig& config) override;
     void SetTileCache(std::shared_ptr<TileCache> cache) override;
+    std::shared_ptr<TileCache> GetTileCache() const override { return tile_cache_; }
 
     bool AddProvider(std::shared_ptr<TileProvider> provider) override;
     bool RemoveProvider(const std::string& name) override;
@@ -189,6 +226,14 @@ public:
         TileLoadCallback callback = nullptr,
         const std::string& provider_name = "") override;
     
+    std::shared_future<TileLoadResult> LoadTileShared(
+        const TileCoordinates& coordinates,
+        const std::string& provider_name = "") override;
+    
+    void LoadTileWithCallback(const TileCoordinates& coordinates,
+                              TileLoadCallback callback,
+                              const std::string& provider_name = "") override;
+    
     bool CancelLoad(const TileCoordinates& coordinates) override;
     void CancelAllLoads() override;
     
@@ -205,34 +250,71 @@ public:
     
     bool SetDefaultProvider(const std::string& name) override;
     std::string GetDefaultProvider() const override;
+    
+    void SetRefinementCallback(TileLoadCallback callback) override;
 
 private:
     TileLoaderConfig config_;
     std::shared_ptr<TileCache> tile_cache_;
     std::unordered_map<std::string, std::shared_ptr<TileProvider>> providers_;
     std::string default_provider_{"OpenStreetMap"};
+    
+    mutable std::mutex stats_mutex_;
     TileLoaderStats stats_;
-    ThreadPool thread_pool_;
+    TileVariantSelector variant_selector_;  ///< Guarded by stats_mutex_
     
-    // Async loading state
+    // Loads in flight: every requester of a (provider, tile) shares one download
+    TileLoadFlights flights_;
     mutable std::mutex loading_mutex_;
-    std::unordered_set<TileCoordinates, TileCoordinatesHash> loading_tiles_;
-    std::map<TileCoordinates, std::shared_ptr<std::promise<TileLoadResult>>> active_loads_;
+    std::unordered_map<TileRequestKey, ActiveLoad, TileRequestKeyHash> active_loads_;
+    std::unordered_set<TileCoordinates, TileCoordinatesHash> revalidating_tiles_;
+    
+    // Tiles downloaded in a cheaper variant, by variant; refined one at a time on an idle link
+    std::unordered_map<TileRequestKey, std::size_t, TileRequestKeyHash> degraded_tiles_;
+    bool refining_ = false;
+    TileLoadCallback refinement_callback_;
+    
+    // Fails requests fast for hosts that keep failing
+    HostCircuitBreaker circuit_breaker_;
+    
+    /// Declared last so it is destroyed first while the state above is alive
+    std::unique_ptr<HttpDownloadEngine> engine_;
     
     // Internal methods
-    TileLoadResult LoadTileInternal(const TileCoordinates& coordinates,
-                                   const std::string& provider_name);
-    bool DownloadTile(const std::string& url, 
-                     const std::vector<std::pair<std::string, std::string>>& headers,
-                     std::vector<std::uint8_t>& data,
-                     std::uint32_t& status_code);
-    CURL* CreateCurlHandle() const;
-    void SetupCurlHandle(CURL* curl, const std::string& url,
-                        const std::vector<std::pair<std::string, std::string>>& headers,
-                        std::vector<std::uint8_t>& data) const;
+    std::optional<TileLoadResult> LoadFromCache(const TileCoordinates& coordinates,
+                                                const std::string& provider_name);
+    std::shared_future<TileLoadResult> JoinLoad(const TileCoordinates& coordinates,
+                                                const std::string& provider_name,
+                                                TileLoadFlights::Listener listener);
+    std::shared_future<TileLoadResult> JoinFlight(const TileCoordinates& coordinates,
+                                                  const std::string& provider_name,
+                                                  TileLoadFlights::Listener listener);
+    std::size_t CancelFlights(const std::function<bool(const TileRequestKey&)>& predicate);
+    std::shared_ptr<DownloadJob> StartDownload(const TileCoordinates& coordinates,
+                                               const std::string& provider_name,
+                                               std::function<void(const TileLoadResult&)> on_complete);
+    std::shared_ptr<DownloadJob> CreateJob(const TileCoordinates& coordinates,
+                                           const std::string& provider_name,
+                                           const TileProvider& provider,
+                                           std::size_t variant = TileVariantSelector::kNoVariant) const;
+    std::pair<std::size_t, std::size_t> SelectVariant(const TileProvider& provider) const;
+    void TrackVariant(const DownloadJob& job);
+    void StartRefinement();
+    void StartRevalidation(const TileCoordinates& coordinates,
+                           const std::string& provider_name,
+                           const TileMetadata& cached);
+    std::chrono::system_clock::time_point ComputeExpiry(const HttpResponse& response) const;
+    std::uint64_t GetTileTtl() const;
+    void SubmitAttempt(const std::shared_ptr<DownloadJob>& job,
+                       std::chrono::steady_clock::time_point not_before);
+    void HandleResponse(const std::shared_ptr<DownloadJob>& job, std::uint32_t round,
+                        bool hedge, HttpResponse&& response);
+    bool AdmitJob(const DownloadJob& job);
+    std::optional<std::chrono::milliseconds> GetHedgeDelay(const std::string& host) const;
+    void RecordLatency(const std::string& host, std::uint64_t latency_ms);
+    void RecordThroughput(std::size_t bytes, std::uint64_t elapsed_ms);
     std::uint64_t GetCurrentTimeMs() const;
     void UpdateStats(const TileLoadResult& result);
-    TileCoordinatesHash hasher_;
 };
 
 // Factory function
@@ -242,8 +324,12 @@ std::unique_ptr<TileLoader> CreateTileLoader(const TileLoaderConfig& config) {
 
 bool BasicTileLoader::Initialize(const TileLoaderConfig& config) {
     config_ = config;
-    
-    // Thread pool is already initialized in constructor with the initial size
+    engine_->SetConfiguration(config_);
+    circuit_breaker_.SetConfig(ToCircuitBreakerConfig(config_));
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        variant_selector_.SetConfig(ToVariantSelectorConfig(config_));
+    }
     
     // Add default providers
     AddProvider(TileProviders::OpenStreetMap);
@@ -256,7 +342,7 @@ bool BasicTileLoader::Initialize(const TileLoaderConfig& config) {
         default_provider_ = providers_.begin()->first;
     }
     
-    spdlog::info("Tile loader initialized with {} providers and {} threads", 
+    spdlog::info("Tile loader initialized with {} providers, up to {} concurrent downloads", 
                 providers_.size(), config_.max_concurrent_downloads);
     return true;
 }
@@ -319,27 +405,9 @@ std::vector<std::string> BasicTileLoader::GetProviderNames() const {
 
 TileLoadResult BasicTileLoader::LoadTile(const TileCoordinates& coordinates,
                                         const std::string& provider_name) {
-    // Commented for now to prevent double increment in UpdateStats
-    // stats_.total_requests++;
-    
-    // Check cache first
-    // TODO: tile_cache_ is null now, investigate later
-    if (tile_cache_) {
-        auto cached_tile = tile_cache_->Get(coordinates);
-        if (cached_tile && cached_tile->IsValid()) {
-            stats_.cached_requests++;
-
-            TileLoadResult result;
-            result.success = true;
-            result.tile_data = std::make_shared<TileData>(std::move(*cached_tile));
-            result.coordinates = coordinates;
-            result.provider_name = provider_name.empty() ? default_provider_ : provider_name;
-
-            return result;
-        }
-    }
-    
-    return LoadTileInternal(coordinates, provider_name);
+    // Blocks until the engine completes the transfer; must not be called
+    // from a completion callback (those run on the engine thread)
+    return JoinLoad(coordinates, provider_name, nullptr).get();
 }
 
 std::future<TileLoadResult> BasicTileLoader::LoadTileAsync(
@@ -350,40 +418,86 @@ std::future<TileLoadResult> BasicTileLoader::LoadTileAsync(
     auto promise = std::make_shared<std::promise<TileLoadResult>>();
     auto future = promise->get_future();
     
-    // Check if already loading
-    {
-        std::lock_guard<std::mutex> lock(loading_mutex_);
-        if (loading_tiles_.find(coordinates) != loading_tiles_.end()) {
-            // Already loading, return existing future
-            auto it = active_loads_.find(coordinates);
-            if (it != active_loads_.end()) {
-                return it->second->get_future();
+    JoinLoad(coordinates, provider_name,
+        [callback = std::move(callback), promise](const TileLoadResult& result) {
+            if (callback) {
+                callback(result);
             }
+            promise->set_value(result);
+        });
+    
+    return future;
+}
+
+std::shared_future<TileLoadResult> BasicTileLoader::LoadTileShared(
+    const TileCoordinates& coordinates,
+    const std::string& provider_name) {
+    return JoinLoad(coordinates, provider_name, nullptr);
+}
+
+void BasicTileLoader::LoadTileWithCallback(const TileCoordinates& coordinates,
+                                           TileLoadCallback callback,
+                                           const std::string& provider_name) {
+    // Cache hits answer inline without a ready promise; misses only add a listener
+    if (auto cached = LoadFromCache(coordinates, provider_name)) {
+        if (callback) {
+            callback(*cached);
         }
-        
-        loading_tiles_.insert(coordinates);
-        active_loads_[coordinates] = promise;
+        return;
     }
+    JoinFlight(coordinates, provider_name, std::move(callback));
+}
+
+std::shared_future<TileLoadResult> BasicTileLoader::JoinLoad(
+    const TileCoordinates& coordinates,
+    const std::string& provider_name,
+    TileLoadFlights::Listener listener) {
     
-    // Enqueue download task
-    thread_pool_.enqueue([this, coordinates, provider_name, callback, promise]() {
-        auto result = LoadTile(coordinates, provider_name);
-        
-        if (callback) {
-            callback(result);
+    if (auto cached = LoadFromCache(coordinates, provider_name)) {
+        if (listener) {
+            listener(*cached);
         }
-        
-        promise->set_value(result);
-        
-        // Clean up loading state
-        {
+        std::promise<TileLoadResult> ready;
+        ready.set_value(std::move(*cached));
+        return ready.get_future().share();
+    }
+    return JoinFlight(coordinates, provider_name, std::move(listener));
+}
+
+std::shared_future<TileLoadResult> BasicTileLoader::JoinFlight(
+    const TileCoordinates& coordinates,
+    const std::string& provider_name,
+    TileLoadFlights::Listener listener) {
+    
+    TileRequestKey key{provider_name.empty() ? default_provider_ : provider_name, coordinates};
+    auto call = flights_.Join(key, std::move(listener));
+    if (!call.leader) {
+        // Same tile already downloading for another view or prefetcher
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.coalesced_requests++;
+        return call.future;
+    }
+    
+    auto job = StartDownload(coordinates, key.provider_name,
+        [this, key, call_id = call.id](const TileLoadResult& result) {
+            flights_.Complete(key, call_id, result);
+            
             std::lock_guard<std::mutex> lock(loading_mutex_);
-            loading_tiles_.erase(coordinates);
-            active_loads_.erase(coordinates);
+            auto it = active_loads_.find(key);
+            if (it != active_loads_.end() && it->second.call_id == call_id) {
+                active_loads_.erase(it);
+            }
+        });
+    
+    // Remember the job so CancelLoad can abort the transfer (unless it already finished)
+    if (job) {
+        std::lock_guard<std::mutex> lock(loading_mutex_);
+        if (flights_.GetCallId(key) == call.id) {
+            active_loads_[key] = ActiveLoad{call.id, job};
         }
-    });
+    }
     
-    return future;
+    return call.future;
 }
 
 std::vector<std::future<TileLoadResult>> BasicTileLoader::LoadTilesAsync(
@@ -392,7 +506,9 @@ std::vector<std::future<TileLoadResult>> BasicTileLoader::LoadTilesAsync(
     const std::string& provider_name) {
     
     std::vector<std::future<TileLoadResult>> futures;
+    futures.reserve(coordinates.size());
     
+    // Every request goes straight to the download engine queue
     for (const auto& coords : coordinates) {
         futures.push_back(LoadTileAsync(coords, callback, provider_name));
     }
@@ -400,91 +516,120 @@ std::vector<std::future<TileLoadResult>> BasicTileLoader::LoadTilesAsync(
     return futures;
 }
 
-bool BasicTileLoader::CancelLoad(const TileCoordinates& coordinates) {
-    std::lock_guard<std::mutex> lock(loading_mutex_);
-    
-    auto it = active_loads_.find(coordinates);
-    if (it != active_loads_.end()) {
-        // Set cancelled result
-        TileLoadResult result;
-        result.success = false;
-        result.error_message = "Load cancelled";
-        result.coordinates = coordinates;
+std::size_t BasicTileLoader::CancelFlights(
+    const std::function<bool(const TileRequestKey&)>& predicate) {
+    std::size_t cancelled = 0;
+    for (const auto& key : flights_.GetKeys()) {
+        if (!predicate(key)) {
+            continue;
+        }
         
-        it->second->set_value(result);
+        ActiveLoad load;
+        const std::uint64_t call_id = flights_.GetCallId(key);
+        {
+            std::lock_guard<std::mutex> lock(loading_mutex_);
+            auto it = active_loads_.find(key);
+            if (it != active_loads_.end() && it->second.call_id == call_id) {
+                load = std::move(it->second);
+                active_loads_.erase(it);
+            }
+        }
         
-        active_loads_.erase(it);
-        loading_tiles_.erase(coordinates);
+        if (load.job) {
+            load.job->cancelled.store(true);
+            engine_->Cancel(load.job->request_id.load());
+            engine_->Cancel(load.job->hedge_request_id.load());
+        }
         
-        return true;
+        // Every requester sharing the load sees the cancellation
+        TileLoadResult result;
+        result.success = false;
+        result.error_message = "Load cancelled";
+        result.coordinates = key.coordinates;
+        result.provider_name = key.provider_name;
+        if (flights_.Complete(key, call_id, result)) {
+            ++cancelled;
+        }
     }
-    
-    return false;
+    return cancelled;
+}
+
+bool BasicTileLoader::CancelLoad(const TileCoordinates& coordinates) {
+    return CancelFlights([&coordinates](const TileRequestKey& key) {
+        return key.coordinates == coordinates;
+    }) > 0;
 }
 
 void BasicTileLoader::CancelAllLoads() {
-    std::lock_guard<std::mutex> lock(loading_mutex_);
-    
-    for (auto& [coords, promise] : active_loads_) {
-        TileLoadResult result;
-        result.success = false;
-        result.error_message = "Load cancelled";
-        result.coordinates = coords;
-        
-        promise->set_value(result);
+    {
+        std::lock_guard<std::mutex> lock(loading_mutex_);
+        revalidating_tiles_.clear();  // Cancelled transfers report nothing back
+        refining_ = false;
     }
-    
-    active_loads_.clear();
-    loading_tiles_.clear();
+    CancelFlights([](const TileRequestKey&) { return true; });
+    engine_->CancelAll();
 }
 
 TileLoaderStats BasicTileLoader::GetStatistics() const {
-    std::lock_guard<std::mutex> lock(loading_mutex_);
+    TileLoaderStats stats;
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats = stats_;
+        stats.throughput_bytes_per_second = variant_selector_.GetThroughput();
+    }
     
-    TileLoaderStats stats = stats_;
-    stats.active_downloads = loading_tiles_.size();
-    stats.queued_downloads = thread_pool_.GetQueueSize();
+    stats.active_downloads = engine_->GetActiveCount();
+    stats.queued_downloads = engine_->GetQueuedCount();
     
     return stats;
 }
 
 bool BasicTileLoader::SetConfiguration(const TileLoaderConfig& config) {
-    if (config.max_concurrent_downloads != config_.max_concurrent_downloads) {
-        // Note: Thread pool size is fixed after construction
-        // In a real implementation, you might recreate the entire loader
-        spdlog::warn("Thread pool size change requires recreating tile loader");
-    }
-    
     config_ = config;
+    engine_->SetConfiguration(config_);
+    circuit_breaker_.SetConfig(ToCircuitBreakerConfig(config_));
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        variant_selector_.SetConfig(ToVariantSelectorConfig(config_));
+    }
     return true;
 }
 
 bool BasicTileLoader::IsLoading(const TileCoordinates& coordinates) const {
-    std::lock_guard<std::mutex> lock(loading_mutex_);
-    return loading_tiles_.find(coordinates) != loading_tiles_.end();
+    const auto keys = flights_.GetKeys();
+    return std::any_of(keys.begin(), keys.end(), [&coordinates](const TileRequestKey& key) {
+        return key.coordinates == coordinates;
+    });
 }
 
 std::vector<TileCoordinates> BasicTileLoader::GetLoadingTiles() const {
-    std::lock_guard<std::mutex> lock(loading_mutex_);
-    
-    std::vector<TileCoordinates> tiles;
-    for (const auto& coords : loading_tiles_) {
-        tiles.push_back(coords);
+    std::unordered_set<TileCoordinates, TileCoordinatesHash> tiles;
+    for (const auto& key : flights_.GetKeys()) {
+        tiles.insert(key.coordinates);
     }
-    
-    return tiles;
+    return std::vector<TileCoordinates>(tiles.begin(), tiles.end());
 }
 
 std::size_t BasicTileLoader::PreloadTiles(const std::vector<TileCoordinates>& coordinates,
                                           const std::string& provider_name) {
-    std::size_t preloaded_count = 0;
+    if (!tile_cache_) {
+        return 0;
+    }
     
+    std::vector<TileCoordinates> missing;
     for (const auto& coords : coordinates) {
-        if (tile_cache_ && !tile_cache_->Contains(coords)) {
-            auto result = LoadTile(coords, provider_name);
-            if (result.success) {
-                preloaded_count++;
-            }
+        if (!tile_cache_->Contains(coords)) {
+            missing.push_back(coords);
+        }
+    }
+    
+    // Issue all downloads at once so they share connections, then wait
+    auto futures = LoadTilesAsync(missing, nullptr, provider_name);
+    
+    std::size_t preloaded_count = 0;
+    for (auto& future : futures) {
+        if (future.valid() && future.get().success) {
+            preloaded_count++;
         }
     }
     
@@ -510,9 +655,105 @@ std::string BasicTileLoader::GetDefaultProvider() const {
     return default_provider_;
 }
 
-TileLoadResult BasicTileLoader::LoadTileInternal(const TileCoordinates& coordinates,
-                                                const std::string& provider_name) {
-    auto start_time = GetCurrentTimeMs();
+void BasicTileLoader::SetRefinementCallback(TileLoadCallback callback) {
+    std::lock_guard<std::mutex> lock(loading_mutex_);
+    refinement_callback_ = std::move(callback);
+}
+
+std::optional<TileLoadResult> BasicTileLoader::LoadFromCache(const TileCoordinates& coordinates,
+                                                             const std::string& provider_name) {
+    if (!tile_cache_) {
+        return std::nullopt;
+    }
+    
+    auto cached_tile = tile_cache_->Get(coordinates);
+    if (!cached_tile || !cached_tile->IsValid()) {
+        return std::nullopt;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.cached_requests++;
+    }
+    
+    TileLoadResult result;
+    result.success = true;
+    result.tile_data = std::make_shared<TileData>(std::move(*cached_tile));
+    result.coordinates = coordinates;
+    result.provider_name = provider_name.empty() ? default_provider_ : provider_name;
+    
+    // Stale-while-revalidate: the expired copy is served now, refreshed later
+    if (config_.enable_revalidation && IsStale(result.tile_data->metadata, GetTileTtl())) {
+        StartRevalidation(coordinates, result.provider_name, result.tile_data->metadata);
+    }
+    
+    return result;
+}
+
+void BasicTileLoader::StartRevalidation(const TileCoordinates& coordinates,
+                                        const std::string& provider_name,
+                                        const TileMetadata& cached) {
+    const TileProvider* provider = GetProvider(provider_name);
+    if (!provider || provider->IsLocal()) {
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(loading_mutex_);
+        if (!revalidating_tiles_.insert(coordinates).second) {
+            return;  // Already revalidating
+        }
+    }
+    
+    // Tiles read back from disk may not carry the etag; the metadata record does
+    auto stored = tile_cache_->GetMetadata(coordinates);
+    TileMetadata validators = stored ? *stored : cached;
+    validators.coordinates = coordinates;
+    
+    // Validators belong to the variant that was cached
+    std::size_t variant = SelectVariant(*provider).second;
+    {
+        std::lock_guard<std::mutex> lock(loading_mutex_);
+        auto it = degraded_tiles_.find(TileRequestKey{provider_name, coordinates});
+        if (it != degraded_tiles_.end()) {
+            variant = it->second;
+        }
+    }
+    
+    auto job = CreateJob(coordinates, provider_name, *provider, variant);
+    if (!validators.etag.empty()) {
+        job->headers.emplace_back("If-None-Match", validators.etag);
+    }
+    // The server's own validator, echoed verbatim; never the local fetch time
+    if (!validators.server_last_modified.empty()) {
+        job->headers.emplace_back("If-Modified-Since", validators.server_last_modified);
+    }
+    job->revalidating = std::move(validators);
+    job->on_complete = [this, coordinates](const TileLoadResult&) {
+        std::lock_guard<std::mutex> lock(loading_mutex_);
+        revalidating_tiles_.erase(coordinates);
+    };
+    
+    if (!AdmitJob(*job)) {
+        // The stale copy keeps being served; a later access tries again
+        job->on_complete(TileLoadResult{});
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.revalidation_requests++;
+    }
+    
+    spdlog::debug("Revalidating expired tile {}/{}/{}",
+                 coordinates.x, coordinates.y, coordinates.zoom);
+    SubmitAttempt(job, std::chrono::steady_clock::time_point{});
+}
+
+std::shared_ptr<DownloadJob> BasicTileLoader::StartDownload(
+    const TileCoordinates& coordinates,
+    const std::string& provider_name,
+    std::function<void(const TileLoadResult&)> on_complete) {
     
     TileLoadResult result;
     result.coordinates = coordinates;
@@ -523,7 +764,8 @@ TileLoadResult BasicTileLoader::LoadTileInternal(const TileCoordinates& coordina
     if (!provider) {
         result.error_message = "Provider not found: " + result.provider_name;
         UpdateStats(result);
-        return result;
+        on_complete(result);
+        return nullptr;
     }
     
     // Validate coordinates
@@ -532,161 +774,423 @@ TileLoadResult BasicTileLoader::LoadTileInternal(const TileCoordinates& coordina
         coordinates.zoom > provider->GetMaxZoom()) {
         result.error_message = "Invalid tile coordinates";
         UpdateStats(result);
-        return result;
+        on_complete(result);
+        return nullptr;
     }
     
-    // Build URL
-    std::string url = provider->BuildTileURL(coordinates);
-    auto headers = provider->GetHeaders();
-    
-    // Download tile
-    std::vector<std::uint8_t> data;
-    std::uint32_t status_code;
-
-    for (std::uint32_t attempt = 0; attempt <= provider->GetMaxRetries(); ++attempt) {
-        result.retry_count = attempt;
-        
-        if (DownloadTile(url, headers, data, status_code)) {
-            spdlog::info("Tile downloaded ok");
-            result.status_code = status_code;
-            break;
-        }
-
-        if (attempt < provider->GetMaxRetries()) {
-            spdlog::warn("Tile download failed, retrying ({}/{}): {}/{}/{}",
-                        attempt + 1, provider->GetMaxRetries(),
-                        coordinates.x, coordinates.y, coordinates.zoom);
+    // Local archives are read in place: no HTTP request, retries or cache write
+    if (provider->IsLocal()) {
+        const std::uint64_t start_time_ms = GetCurrentTimeMs();
+        auto bytes = provider->ReadTile(coordinates);
+        if (bytes && !bytes->empty()) {
+            auto tile_data = std::make_shared<TileData>();
+            tile_data->metadata.coordinates = coordinates;
+            tile_data->metadata.file_size = bytes->size();
+            tile_data->metadata.last_modified = std::chrono::system_clock::now();
+            tile_data->metadata.last_access = tile_data->metadata.last_modified;
+            tile_data->metadata.content_type = "image/" + provider->GetFormat();
+            tile_data->data = std::move(*bytes);
+            tile_data->loaded = true;
             
-            // Wait before retry
-            std::this_thread::sleep_for(
-                std::chrono::milliseconds(provider->GetRetryDelay()));
+            result.success = true;
+            result.tile_data = std::move(tile_data);
+            result.load_time_ms = GetCurrentTimeMs() - start_time_ms;
+        } else {
+            result.status_code = 404;  // Same meaning as the HTTP answer
+            result.error_message = "Tile not found in local archive";
         }
+        UpdateStats(result);
+        on_complete(result);
+        return nullptr;
     }
     
-    if (data.empty()) {
-        spdlog::warn("Tile downloaded error, x: {}, y: {}, z: {}, url: {}", coordinates.x, coordinates.y, coordinates.zoom, url);
-        result.error_message = "Failed to download tile after " + 
-                             std::to_string(result.retry_count) + " attempts";
+    const auto [variant, preferred] = SelectVariant(*provider);
+    auto job = CreateJob(coordinates, result.provider_name, *provider, variant);
+    job->degraded = variant != preferred;
+    if (!AdmitJob(*job)) {
+        result.error_message = "Host temporarily unavailable (circuit open): " + job->host;
         UpdateStats(result);
-        return result;
+        on_complete(result);
+        return nullptr;
     }
+    job->on_complete = std::move(on_complete);
     
-    // Create tile data
-    auto tile_data = std::make_shared<TileData>();
-    tile_data->metadata.coordinates = coordinates;
-    tile_data->metadata.file_size = data.size();
-    tile_data->metadata.last_modified = std::chrono::system_clock::now();
-    tile_data->metadata.last_access = std::chrono::system_clock::now();
-    tile_data->metadata.content_type = "image/" + provider->GetFormat();
-    tile_data->metadata.checksum = 0; // TODO: Calculate actual checksum
-    tile_data->data = std::move(data);
-    
-    // Store in cache
-    if (tile_cache_) {
-        tile_cache_->Put(*tile_data);
+    SubmitAttempt(job, std::chrono::steady_clock::time_point{});
+    return job;
+}
+
+std::shared_ptr<DownloadJob> BasicTileLoader::CreateJob(const TileCoordinates& coordinates,
+                                                        const std::string& provider_name,
+                                                        const TileProvider& provider,
+                                                        std::size_t variant) const {
+    auto job = std::make_shared<DownloadJob>();
+    job->coordinates = coordinates;
+    job->provider_name = provider_name;
+    job->url = provider.BuildTileURL(coordinates);
+    job->content_type = "image/" + provider.GetFormat();
+    const auto variants = provider.GetVariants();
+    if (variant < variants.size()) {
+        job->variant = variant;
+        job->variant_name = variants[variant].name;
+        job->url = provider.BuildVariantURL(coordinates, variant);
+        job->content_type = "image/" + variants[variant].format;
+    }
+    job->host = HostCircuitBreaker::HostFromUrl(job->url);
+    // Mirrors serve the provider's default encoding only
+    if (config_.enable_hedging && job->variant == TileVariantSelector::kNoVariant) {
+        job->mirror_url = provider.BuildMirrorURL(coordinates);
+        job->mirror_host = HostCircuitBreaker::HostFromUrl(job->mirror_url);
+    }
+    job->headers = provider.GetHeaders();
+    job->max_retries = provider.GetMaxRetries();
+    job->scheduling_weight = provider.GetSchedulingWeight();
+    job->backoff.base_delay = std::chrono::milliseconds(provider.GetRetryDelay());
+    job->backoff.max_delay = std::chrono::milliseconds(config_.max_retry_delay);
+    job->backoff.jitter = config_.retry_jitter;
+    job->start_time_ms = GetCurrentTimeMs();
+    return job;
+}
+
+std::pair<std::size_t, std::size_t> BasicTileLoader::SelectVariant(
+    const TileProvider& provider) const {
+    const auto variants = provider.GetVariants();
+    if (variants.empty()) {
+        return {TileVariantSelector::kNoVariant, TileVariantSelector::kNoVariant};
+    }
+    const std::size_t pending = engine_->GetActiveCount() + engine_->GetQueuedCount();
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    const std::size_t preferred = variant_selector_.GetPreferred(variants);
+    return {config_.enable_adaptive_variants ? variant_selector_.Select(variants, pending) : preferred,
+            preferred};
+}
+
+void BasicTileLoader::TrackVariant(const DownloadJob& job) {
+    if (job.variant == TileVariantSelector::kNoVariant) {
+        return;
+    }
+    const TileRequestKey key{job.provider_name, job.coordinates};
+    {
+        std::lock_guard<std::mutex> lock(loading_mutex_);
+        if (!job.degraded) {
+            degraded_tiles_.erase(key);
+        } else if (config_.refine_degraded_tiles &&
+                   (degraded_tiles_.size() < config_.max_degraded_tiles ||
+                    degraded_tiles_.count(key) > 0)) {
+            degraded_tiles_[key] = job.variant;
+        }
+    }
+    if (job.degraded) {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.degraded_loads++;
+    }
+}
+
+void BasicTileLoader::StartRefinement() {
+    // No refinements while the engine shuts down (and resolves outstanding loads)
+    if (!config_.refine_degraded_tiles || !engine_) {
+        return;
+    }
+    const std::size_t pending = engine_->GetActiveCount() + engine_->GetQueuedCount();
+    {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        if (!variant_selector_.IsIdle(pending)) {
+            return;
+        }
     }
     
-    result.success = true;
-    result.tile_data = tile_data;
-    result.load_time_ms = GetCurrentTimeMs() - start_time;
+    TileRequestKey key;
+    {
+        std::lock_guard<std::mutex> lock(loading_mutex_);
+        if (refining_ || degraded_tiles_.empty()) {
+            return;
+        }
+        key = degraded_tiles_.begin()->first;
+        degraded_tiles_.erase(degraded_tiles_.begin());
+        refining_ = true;
+    }
     
-    UpdateStats(result);
+    const TileProvider* provider = GetProvider(key.provider_name);
+    const std::size_t preferred = provider ? SelectVariant(*provider).second
+                                           : TileVariantSelector::kNoVariant;
+    std::shared_ptr<DownloadJob> job;
+    if (preferred != TileVariantSelector::kNoVariant) {
+        job = CreateJob(key.coordinates, key.provider_name, *provider, preferred);
+    }
+    if (!job || !AdmitJob(*job)) {
+        std::lock_guard<std::mutex> lock(loading_mutex_);
+        refining_ = false;
+        return;
+    }
     
-    spdlog::debug("Loaded tile {}/{}/{} in {}ms", 
-                 coordinates.x, coordinates.y, coordinates.zoom, result.load_time_ms);
+    // The refined tile replaces the degraded one in the cache (HandleResponse)
+    job->on_complete = [this](const TileLoadResult& result) {
+        TileLoadCallback callback;
+        {
+            std::lock_guard<std::mutex> lock(loading_mutex_);
+            refining_ = false;
+            callback = refinement_callback_;
+        }
+        if (!result.success || !result.tile_data) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            stats_.refined_loads++;
+        }
+        if (callback) {
+            callback(result);
+        }
+    };
     
-    return result;
+    spdlog::debug("Refining tile {}/{}/{} to variant {}", key.coordinates.x, key.coordinates.y,
+                  key.coordinates.zoom, job->variant_name);
+    SubmitAttempt(job, std::chrono::steady_clock::time_point{});
 }
 
-CURL* BasicTileLoader::CreateCurlHandle() const {
-    CURL* curl = curl_easy_init();
-    if (!curl) {
-        spdlog::error("Failed to initialize curl handle");
-        return nullptr;
+bool BasicTileLoader::AdmitJob(const DownloadJob& job) {
+    if (circuit_breaker_.AllowRequest(job.host)) {
+        return true;
     }
-    
-    // Set common options
-    curl_easy_setopt(curl, CURLOPT_USERAGENT, config_.user_agent.c_str());
-    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, config_.follow_redirects ? 1L : 0L);
-    curl_easy_setopt(curl, CURLOPT_MAXREDIRS, 5L);
-    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, static_cast<long>(config_.timeout));
-    curl_easy_setopt(curl, CURLOPT_TIMEOUT, static_cast<long>(config_.timeout));
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, config_.verify_ssl ? 1L : 0L);
-    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, config_.verify_ssl ? 2L : 0L);
-    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L); // Prevent signals for thread safety
-    curl_easy_setopt(curl, CURLOPT_ACCEPT_ENCODING, ""); // Enable all supported encodings
-    
-    if (config_.enable_http2) {
-        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2_PRIOR_KNOWLEDGE);
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.circuit_rejected_requests++;
+    return false;
+}
+
+void BasicTileLoader::SubmitAttempt(const std::shared_ptr<DownloadJob>& job,
+                                    std::chrono::steady_clock::time_point not_before) {
+    HttpRequest request;
+    request.url = job->url;
+    request.headers = job->headers;
+    request.not_before = not_before;
+    request.flow = job->provider_name;
+    request.flow_weight = job->scheduling_weight;
+    
+    const std::uint32_t round = job->round.fetch_add(1) + 1;
+    std::optional<std::chrono::milliseconds> hedge_delay;
+    if (!job->mirror_url.empty() && circuit_breaker_.AllowRequest(job->mirror_host)) {
+        hedge_delay = GetHedgeDelay(job->host);
+        if (!hedge_delay) {
+            circuit_breaker_.RecordAbandoned(job->mirror_host);
+        }
+    }
+    job->outstanding.store(hedge_delay ? 2 : 1);
+    job->hedge_at = {};
+    job->hedge_request_id.store(0);
+    
+    if (hedge_delay) {
+        // The hedge waits on the engine's timer queue; it is cancelled before
+        // it starts if the primary answers within the host's usual latency.
+        // Submitted first so its id is known before the primary can finish.
+        HttpRequest hedge = request;
+        hedge.url = job->mirror_url;
+        hedge.not_before = std::max(not_before, std::chrono::steady_clock::now()) + *hedge_delay;
+        hedge.on_complete = [this, job, round](HttpResponse&& response) {
+            HandleResponse(job, round, true, std::move(response));
+        };
+        job->hedge_at = hedge.not_before;
+        job->hedge_request_id.store(engine_->Submit(std::move(hedge)));
     }
     
-    return curl;
+    request.on_complete = [this, job, round](HttpResponse&& response) {
+        HandleResponse(job, round, false, std::move(response));
+    };
+    job->request_id.store(engine_->Submit(std::move(request)));
+}
+
+std::optional<std::chrono::milliseconds> BasicTileLoader::GetHedgeDelay(
+    const std::string& host) const {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    auto it = stats_.host_latency.find(host);
+    if (it == stats_.host_latency.end() ||
+        it->second.GetCount() < std::max<std::size_t>(config_.hedge_min_samples, 1)) {
+        return std::nullopt;
+    }
+    const double threshold = std::max(it->second.GetPercentile(config_.hedge_percentile),
+                                      static_cast<double>(config_.hedge_min_delay));
+    return std::chrono::milliseconds(static_cast<std::int64_t>(std::ceil(threshold)));
 }
 
-void BasicTileLoader::SetupCurlHandle(CURL* curl, const std::string& url,
-                                     const std::vector<std::pair<std::string, std::string>>& headers,
-                                     std::vector<std::uint8_t>& data) const {
-    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &data);
+void BasicTileLoader::RecordLatency(const std::string& host, std::uint64_t latency_ms) {
+    if (host.empty()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    stats_.host_latency[host].Record(static_cast<double>(latency_ms));
+}
+
+void BasicTileLoader::RecordThroughput(std::size_t bytes, std::uint64_t elapsed_ms) {
+    // The finished transfer no longer counts as active
+    const std::size_t concurrent = (engine_ ? engine_->GetActiveCount() : 0) + 1;
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    variant_selector_.RecordTransfer(bytes, elapsed_ms, concurrent);
+}
+
+void BasicTileLoader::HandleResponse(const std::shared_ptr<DownloadJob>& job,
+                                     std::uint32_t round, bool hedge,
+                                     HttpResponse&& response) {
+    const std::string& host = hedge ? job->mirror_host : job->host;
+    if (job->cancelled.load() || response.cancelled) {
+        circuit_breaker_.RecordAbandoned(host);
+        if (job->cancelled.load()) {
+            return;
+        }
+    } else if (IsHostFailure(response)) {
+        circuit_breaker_.RecordFailure(host);
+    } else {
+        circuit_breaker_.RecordSuccess(host);
+        RecordLatency(host, response.elapsed_ms);
+        RecordThroughput(response.body.size(), response.elapsed_ms);
+    }
     
-    // Set headers
-    struct curl_slist* header_list = nullptr;
-    for (const auto& [name, value] : headers) {
-        std::string header_str = name + ": " + value;
-        header_list = curl_slist_append(header_list, header_str.c_str());
+    // A loser that finished before its cancellation took effect
+    if (round != job->round.load()) {
+        return;
     }
     
-    if (header_list) {
-        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, header_list);
+    // A retryable failure leaves the race to the other request of the round
+    const bool answered = response.not_modified || (response.success && !response.body.empty());
+    const bool remaining = job->outstanding.fetch_sub(1) > 1;
+    if (remaining && !answered && !response.cancelled && IsRetryable(response)) {
+        return;
     }
     
-    // Set proxy if configured
-    if (!config_.proxy_url.empty()) {
-        curl_easy_setopt(curl, CURLOPT_PROXY, config_.proxy_url.c_str());
+    // Settle the race: cancel the other request and ignore its answer
+    job->round.fetch_add(1);
+    if (remaining) {
+        engine_->Cancel(hedge ? job->request_id.load() : job->hedge_request_id.load());
+        circuit_breaker_.RecordAbandoned(hedge ? job->host : job->mirror_host);
+    }
+    if (job->hedge_request_id.load() != 0 && std::chrono::steady_clock::now() >= job->hedge_at) {
+        std::lock_guard<std::mutex> lock(stats_mutex_);
+        stats_.hedged_requests++;
+        if (hedge && answered) {
+            stats_.hedge_wins++;
+        }
+    }
+    
+    const TileCoordinates& coordinates = job->coordinates;
+    
+    TileLoadResult result;
+    result.coordinates = coordinates;
+    result.provider_name = job->provider_name;
+    result.retry_count = job->attempt;
+    result.status_code = response.status_code;
+    
+    if (response.not_modified && job->revalidating) {
+        // Cached bytes are still current: only their freshness moves forward
+        TileMetadata refreshed = *job->revalidating;
+        refreshed.last_modified = std::chrono::system_clock::now();  // Validated as of now
+        refreshed.expires_at = ComputeExpiry(response);
+        if (!response.etag.empty()) {
+            refreshed.etag = std::move(response.etag);
+        }
+        if (!response.last_modified.empty()) {
+            refreshed.server_last_modified = std::move(response.last_modified);
+        }
+        if (tile_cache_ && response.no_store) {
+            tile_cache_->Remove(coordinates);  // May no longer be kept at all
+        } else if (tile_cache_) {
+            tile_cache_->UpdateMetadata(coordinates, refreshed);
+        }
+        {
+            std::lock_guard<std::mutex> lock(stats_mutex_);
+            stats_.not_modified_responses++;
+        }
         
-        if (!config_.proxy_username.empty()) {
-            curl_easy_setopt(curl, CURLOPT_PROXYUSERNAME, config_.proxy_username.c_str());
-            curl_easy_setopt(curl, CURLOPT_PROXYPASSWORD, config_.proxy_password.c_str());
+        spdlog::debug("Tile {}/{}/{} not modified, fresh for another {}s",
+                     coordinates.x, coordinates.y, coordinates.zoom,
+                     std::chrono::duration_cast<std::chrono::seconds>(
+                         refreshed.expires_at - std::chrono::system_clock::now()).count());
+        result.success = true;
+        job->on_complete(result);
+        return;
+    }
+    
+    if (!response.success || response.body.empty()) {
+        // A host whose circuit just opened gets no further attempts
+        if (!response.cancelled && IsRetryable(response) && job->attempt < job->max_retries &&
+            circuit_breaker_.GetState(host) == HostCircuitBreaker::State::CLOSED) {
+            // A server-supplied Retry-After wins over a shorter backoff
+            auto delay = job->backoff.GetDelay(job->attempt, RandomUnit());
+            if (response.retry_after) {
+                delay = std::max(delay, std::chrono::duration_cast<std::chrono::milliseconds>(
+                                            *response.retry_after));
+            }
+            spdlog::warn("Tile download failed, retrying ({}/{}) in {}ms: {}/{}/{}",
+                        job->attempt + 1, job->max_retries, delay.count(),
+                        coordinates.x, coordinates.y, coordinates.zoom);
+            {
+                std::lock_guard<std::mutex> lock(stats_mutex_);
+                stats_.retried_requests++;
+            }
+            
+            // Re-queue on the engine's timer queue instead of sleeping on the event loop
+            job->attempt++;
+            SubmitAttempt(job, std::chrono::steady_clock::now() + delay);
+            return;
         }
+        
+        spdlog::warn("Tile downloaded error, x: {}, y: {}, z: {}, url: {}",
+                    coordinates.x, coordinates.y, coordinates.zoom, job->url);
+        result.error_message = response.cancelled
+            ? response.error_message
+            : "Failed to download tile after " + std::to_string(job->attempt + 1) +
+              " attempts: " + response.error_message;
+        UpdateStats(result);
+        job->on_complete(result);
+        return;
     }
     
-    // Cleanup will be handled by the caller
-}
-
-bool BasicTileLoader::DownloadTile(const std::string& url,
-                                  const std::vector<std::pair<std::string, std::string>>& headers,
-                                  std::vector<std::uint8_t>& data,
-                                  std::uint32_t& status_code) {
-    CURL* curl = CreateCurlHandle();
-    if (!curl) {
-        return false;
+    // Create tile data
+    auto tile_data = std::make_shared<TileData>();
+    tile_data->metadata.coordinates = coordinates;
+    tile_data->metadata.file_size = response.body.size();
+    tile_data->metadata.last_modified = std::chrono::system_clock::now();
+    tile_data->metadata.last_access = std::chrono::system_clock::now();
+    tile_data->metadata.expires_at = ComputeExpiry(response);
+    tile_data->metadata.etag = std::move(response.etag);
+    tile_data->metadata.server_last_modified = std::move(response.last_modified);
+    tile_data->metadata.content_type = job->content_type;
+    tile_data->data = std::move(response.body);
+    tile_data->metadata.checksum = Crc32c(tile_data->data);
+    
+    // Store in cache, unless the server forbids it
+    if (tile_cache_ && response.no_store) {
+        if (job->revalidating) {
+            tile_cache_->Remove(coordinates);  // Drop the stale copy too
+        }
+    } else if (tile_cache_) {
+        tile_cache_->Put(*tile_data);
     }
     
-    data.clear();
+    result.success = true;
+    result.tile_data = tile_data;
+    result.load_time_ms = GetCurrentTimeMs() - job->start_time_ms;
+    result.variant = job->variant_name;
     
-    SetupCurlHandle(curl, url, headers, data);
+    UpdateStats(result);
+    TrackVariant(*job);
     
-    CURLcode res = curl_easy_perform(curl);
+    spdlog::debug("Loaded tile {}/{}/{} in {}ms", 
+                 coordinates.x, coordinates.y, coordinates.zoom, result.load_time_ms);
     
-    if (res == CURLE_OK) {
-        long response_code;
-        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response_code);
-        status_code = static_cast<std::uint32_t>(response_code);
-        
-        // Check if response is successful (2xx status codes)
-        if (status_code >= 200 && status_code < 300) {
-            curl_easy_cleanup(curl);
-            return true;
-        } else {
-            spdlog::warn("HTTP error {} for URL: {}", status_code, url);
-        }
-    } else {
-        spdlog::error("Curl error: {} for URL: {}", curl_easy_strerror(res), url);
-    }
+    job->on_complete(result);
     
-    curl_easy_cleanup(curl);
-    return false;
+    // The link may have gone idle: spend it on a degraded tile
+    StartRefinement();
+}
+
+std::chrono::system_clock::time_point BasicTileLoader::ComputeExpiry(
+    const HttpResponse& response) const {
+    // Server freshness wins; without it the cache TTL applies
+    const std::chrono::seconds lifetime = response.max_age
+        ? *response.max_age
+        : std::chrono::seconds(GetTileTtl());
+    return std::chrono::system_clock::now() + lifetime;
+}
+
+std::uint64_t BasicTileLoader::GetTileTtl() const {
+    return tile_cache_ ? tile_cache_->GetConfiguration().tile_ttl : TileCacheConfig{}.tile_ttl;
 }
 
 std::uint64_t BasicTileLoader::GetCurrentTimeMs() const {
@@ -695,6 +1199,8 @@ std::uint64_t BasicTileLoader::GetCurrentTimeMs() const {
 }
 
 void BasicTileLoader::UpdateStats(const TileLoadResult& result) {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    
     stats_.total_requests++;
     
     if (result.success) {
@@ -732,7 +1238,53 @@ BasicXYZTileProvider::BasicXYZTileProvider(const std::string& name,
     , user_agent_(user_agent) {}
 
 std::string BasicXYZTileProvider::BuildTileURL(const TileCoordinates& coords) const {
-    std::string url = url_template_;
+    return ExpandTemplate(url_template_, coords,
+                          TileMathematics::GetTileSubdomain(coords, subdomains_));
+}
+
+std::string BasicXYZTileProvider::BuildMirrorURL(const TileCoordinates& coords) const {
+    if (!mirror_templates_.empty()) {
+        const std::size_t index = static_cast<std::size_t>(coords.x + coords.y) %
+                                  mirror_templates_.size();
+        return ExpandTemplate(mirror_templates_[index], coords,
+                              TileMathematics::GetTileSubdomain(coords, subdomains_));
+    }
+
+    // Hedge to the next subdomain shard
+    if (subdomains_.size() > 1 && url_template_.find("{s}") != std::string::npos) {
+        const std::size_t index = (subdomains_.find(
+            TileMathematics::GetTileSubdomain(coords, subdomains_)) + 1) % subdomains_.size();
+        return ExpandTemplate(url_template_, coords, subdomains_[index]);
+    }
+    return {};
+}
+
+void BasicXYZTileProvider::SetMirrorTemplates(std::vector<std::string> templates) {
+    mirror_templates_ = std::move(templates);
+}
+
+void BasicXYZTileProvider::AddVariant(const TileVariant& variant, const std::string& url_template) {
+    variants_.push_back(variant);
+    variant_templates_.push_back(url_template);
+}
+
+std::vector<TileVariant> BasicXYZTileProvider::GetVariants() const {
+    return variants_;
+}
+
+std::string BasicXYZTileProvider::BuildVariantURL(const TileCoordinates& coords,
+                                                  std::size_t variant) const {
+    if (variant >= variant_templates_.size()) {
+        return BuildTileURL(coords);
+    }
+    return ExpandTemplate(variant_templates_[variant], coords,
+                          TileMathematics::GetTileSubdomain(coords, subdomains_));
+}
+
+std::string BasicXYZTileProvider::ExpandTemplate(const std::string& url_template,
+                                                 const TileCoordinates& coords,
+                                                 char subdomain) const {
+    std::string url = url_template;
 
     // Replace placeholders
     url = std::regex_replace(url, std::regex("\\{x\\}"), std::to_string(coords.x));
@@ -740,8 +1292,7 @@ std::string BasicXYZTileProvider::BuildTileURL(const TileCoordinates& coords) co
     url = std::regex_replace(url, std::regex("\\{z\\}"), std::to_string(coords.zoom));
 
     // Replace subdomain placeholder
-    if (!subdomains_.empty()) {
-        char subdomain = TileMathematics::GetTileSubdomain(coords, subdomains_);
+    if (subdomain != '\0') {
         url = std::regex_replace(url, std::regex("\\{s\\}"), std::string(1, subdomain));
     }
 
@@ -799,6 +1350,84 @@ std::string BasicXYZTileProvider::GetName() const {
     return name_;
 }
 
+TimeFrameTileProvider::TimeFrameTileProvider(std::shared_ptr<const TileProvider> base,
+                                             std::string time)
+    : base_(std::move(base)), time_(std::move(time)) {
+    if (!base_) {
+        throw std::invalid_argument("TimeFrameTileProvider needs a base provider");
+    }
+}
+
+std::string TimeFrameTileProvider::ExpandTime(std::string url) const {
+    static const std::string kPlaceholder = "{t}";
+    for (std::size_t pos = url.find(kPlaceholder); pos != std::string::npos;
+         pos = url.find(kPlaceholder, pos + time_.size())) {
+        url.replace(pos, kPlaceholder.size(), time_);
+    }
+    return url;
+}
+
+std::string TimeFrameTileProvider::BuildTileURL(const TileCoordinates& coords) const {
+    return ExpandTime(base_->BuildTileURL(coords));
+}
+
+std::string TimeFrameTileProvider::BuildMirrorURL(const TileCoordinates& coords) const {
+    return ExpandTime(base_->BuildMirrorURL(coords));
+}
+
+std::vector<std::pair<std::string, std::string>> TimeFrameTileProvider::GetHeaders() const {
+    return base_->GetHeaders();
+}
+
+std::string TimeFrameTileProvider::GetAttribution() const {
+    return base_->GetAttribution();
+}
+
+std::string TimeFrameTileProvider::GetName() const {
+    return MakeName(base_->GetName(), time_);
+}
+
+std::int32_t TimeFrameTileProvider::GetMinZoom() const {
+    return base_->GetMinZoom();
+}
+
+std::int32_t TimeFrameTileProvider::GetMaxZoom() const {
+    return base_->GetMaxZoom();
+}
+
+std::string TimeFrameTileProvider::GetFormat() const {
+    return base_->GetFormat();
+}
+
+std::string TimeFrameTileProvider::GetUserAgent() const {
+    return base_->GetUserAgent();
+}
+
+std::uint32_t TimeFrameTileProvider::GetTimeout() const {
+    return base_->GetTimeout();
+}
+
+std::uint32_t TimeFrameTileProvider::GetMaxRetries() const {
+    return base_->GetMaxRetries();
+}
+
+std::uint32_t TimeFrameTileProvider::GetRetryDelay() const {
+    return base_->GetRetryDelay();
+}
+
+std::uint32_t TimeFrameTileProvider::GetSchedulingWeight() const {
+    return base_->GetSchedulingWeight();
+}
+
+std::vector<TileVariant> TimeFrameTileProvider::GetVariants() const {
+    return base_->GetVariants();
+}
+
+std::string TimeFrameTileProvider::BuildVariantURL(const TileCoordinates& coords,
+                                                   std::size_t variant) const {
+    return ExpandTime(base_->BuildVariantURL(coords, variant));
+}
+
 
 
 } // namespace earth_map
@@ -0,0 +1,371 @@
+/**
+ * @file tile_memory_cache.cpp
+ * @brief Implementation of the sharded concurrent in-memory tile store
+ */
+
+#include <earth_map/data/tile_memory_cache.h>
+#include <chrono>
+
+namespace earth_map {
+
+namespace {
+
+std::size_t RoundUpToPowerOfTwo(std::size_t value) {
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+/// splitmix64 finalizer: TileCoordinatesHash keeps zoom in the low bits
+std::uint64_t MixHash(std::uint64_t value) {
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ull;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBull;
+    value ^= value >> 31;
+    return value;
+}
+
+} // namespace
+
+ShardedTileMemoryCache::ShardedTileMemoryCache(std::size_t max_bytes,
+                                               std::size_t shard_count,
+                                               EvictionStrategy strategy)
+    : max_bytes_(max_bytes)
+    , strategy_(strategy) {
+    const std::size_t count = RoundUpToPowerOfTwo(shard_count > 0 ? shard_count : 1);
+    shards_.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        shards_.push_back(std::make_unique<Shard>());
+        shards_.back()->strategy = strategy;
+    }
+    shard_mask_ = count - 1;
+
+    index_ = CreateTileIndex();
+    index_->Initialize(TileIndexConfig{});
+}
+
+ShardedTileMemoryCache::Shard& ShardedTileMemoryCache::ShardFor(
+    const TileCoordinates& coords) const {
+    const std::uint64_t hash = MixHash(TileCoordinatesHash{}(coords));
+    return *shards_[hash & shard_mask_];
+}
+
+std::shared_ptr<const TileData> ShardedTileMemoryCache::Get(const TileCoordinates& coords) {
+    Shard& shard = ShardFor(coords);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    auto it = shard.tiles.find(coords);
+    if (it == shard.tiles.end()) {
+        return nullptr;
+    }
+
+    OnAccess(shard, *it->second);
+
+    auto meta_it = shard.metadata.find(coords);
+    if (meta_it != shard.metadata.end()) {
+        meta_it->second.access_count++;
+        meta_it->second.last_access = std::chrono::system_clock::now();
+    }
+
+    return it->second->tile;
+}
+
+bool ShardedTileMemoryCache::Contains(const TileCoordinates& coords) const {
+    const Shard& shard = ShardFor(coords);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    return shard.tiles.find(coords) != shard.tiles.end();
+}
+
+std::size_t ShardedTileMemoryCache::Put(std::shared_ptr<const TileData> tile) {
+    if (!tile) {
+        return 0;
+    }
+
+    const TileCoordinates coords = tile->metadata.coordinates;
+    const std::size_t size = tile->GetDataSize();
+    const bool valid = tile->IsValid();
+
+    {
+        Shard& shard = ShardFor(coords);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        auto it = shard.tiles.find(coords);
+        if (it != shard.tiles.end()) {
+            // Replace in place: adjust accounting by the size difference
+            const std::size_t old_size = it->second->tile->GetDataSize();
+            if (size >= old_size) {
+                size_bytes_.fetch_add(size - old_size, std::memory_order_relaxed);
+            } else {
+                size_bytes_.fetch_sub(old_size - size, std::memory_order_relaxed);
+            }
+            it->second->tile = std::move(tile);
+            OnReplace(shard, *it->second);
+        } else {
+            Entry& entry = *(shard.tiles[coords] = std::make_unique<Entry>());
+            entry.tile = std::move(tile);
+            entry.coords = coords;
+            entry.hits = 1;
+            entry.tick = ++shard.clock;
+            IndexEntry(shard, entry);
+            count_.fetch_add(1, std::memory_order_relaxed);
+            size_bytes_.fetch_add(size, std::memory_order_relaxed);
+        }
+        UpdateIndex(coords, valid);
+    }
+
+    return EvictToFit(&coords);
+}
+
+bool ShardedTileMemoryCache::Erase(const TileCoordinates& coords) {
+    Shard& shard = ShardFor(coords);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    shard.metadata.erase(coords);
+
+    auto it = shard.tiles.find(coords);
+    if (it == shard.tiles.end()) {
+        return false;
+    }
+    RemoveEntryLocked(shard, it);
+    return true;
+}
+
+void ShardedTileMemoryCache::Clear() {
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        while (!shard->tiles.empty()) {
+            RemoveEntryLocked(*shard, shard->tiles.begin());
+        }
+        shard->metadata.clear();
+    }
+}
+
+std::size_t ShardedTileMemoryCache::SetMaxBytes(std::size_t max_bytes) {
+    max_bytes_.store(max_bytes, std::memory_order_relaxed);
+    return EvictToFit(nullptr);
+}
+
+std::size_t ShardedTileMemoryCache::SetMaxCount(std::size_t max_count) {
+    max_count_.store(max_count, std::memory_order_relaxed);
+    return EvictToFit(nullptr);
+}
+
+void ShardedTileMemoryCache::SetEvictionStrategy(EvictionStrategy strategy) {
+    strategy_.store(strategy, std::memory_order_relaxed);
+
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        if (shard->strategy == strategy) {
+            continue;
+        }
+
+        for (auto& [coords, entry] : shard->tiles) {
+            UnindexEntry(*shard, *entry);
+        }
+        shard->strategy = strategy;
+
+        // Re-link oldest tick first so list order matches the recorded history
+        std::set<std::pair<std::uint64_t, Entry*>> by_tick;
+        for (auto& [coords, entry] : shard->tiles) {
+            by_tick.emplace(entry->tick, entry.get());
+        }
+        for (const auto& [tick, entry] : by_tick) {
+            IndexEntry(*shard, *entry);
+        }
+    }
+}
+
+std::shared_ptr<TileMetadata> ShardedTileMemoryCache::GetMetadata(
+    const TileCoordinates& coords) const {
+    const Shard& shard = ShardFor(coords);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.metadata.find(coords);
+    return it != shard.metadata.end() ? std::make_shared<TileMetadata>(it->second) : nullptr;
+}
+
+void ShardedTileMemoryCache::PutMetadata(std::shared_ptr<TileMetadata> metadata) {
+    if (!metadata) {
+        return;
+    }
+    const TileCoordinates coords = metadata->coordinates;
+    Shard& shard = ShardFor(coords);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.metadata[coords] = *metadata;
+}
+
+std::vector<TileCoordinates> ShardedTileMemoryCache::CollectIf(
+    const std::function<bool(const TileCoordinates&, const TileData&)>& predicate) const {
+    std::vector<TileCoordinates> result;
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->mutex);
+        for (const auto& [coords, entry] : shard->tiles) {
+            if (entry->tile && predicate(coords, *entry->tile)) {
+                result.push_back(coords);
+            }
+        }
+    }
+    return result;
+}
+
+std::vector<TileCoordinates> ShardedTileMemoryCache::CollectAtZoom(std::int32_t zoom) const {
+    std::lock_guard<std::mutex> lock(index_mutex_);
+    return index_->GetTilesAtZoom(zoom);
+}
+
+std::vector<TileCoordinates> ShardedTileMemoryCache::CollectInBounds(
+    const BoundingBox2D& bounds) const {
+    std::lock_guard<std::mutex> lock(index_mutex_);
+    return index_->Query(bounds);
+}
+
+bool ShardedTileMemoryCache::OverBudget() const {
+    return size_bytes_.load(std::memory_order_relaxed) > max_bytes_.load(std::memory_order_relaxed) ||
+           count_.load(std::memory_order_relaxed) > max_count_.load(std::memory_order_relaxed);
+}
+
+std::size_t ShardedTileMemoryCache::EvictToFit(const TileCoordinates* keep) {
+    std::size_t evicted = 0;
+    std::size_t shards_without_victim = 0;
+
+    // Give up once a full round over the shards found nothing to evict
+    while (OverBudget() && shards_without_victim < shards_.size()) {
+        const std::size_t index =
+            eviction_cursor_.fetch_add(1, std::memory_order_relaxed) & shard_mask_;
+        Shard& shard = *shards_[index];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        Entry* victim = FindVictim(shard, keep);
+        if (!victim) {
+            ++shards_without_victim;
+            continue;
+        }
+
+        RemoveEntryLocked(shard, shard.tiles.find(victim->coords));
+        evictions_.fetch_add(1, std::memory_order_relaxed);
+        ++evicted;
+        shards_without_victim = 0;
+    }
+
+    return evicted;
+}
+
+void ShardedTileMemoryCache::RemoveEntryLocked(Shard& shard, EntryMap::iterator it) {
+    size_bytes_.fetch_sub(it->second->tile->GetDataSize(), std::memory_order_relaxed);
+    count_.fetch_sub(1, std::memory_order_relaxed);
+    UnindexEntry(shard, *it->second);
+    UpdateIndex(it->first, false);
+    shard.metadata.erase(it->first);
+    shard.tiles.erase(it);
+}
+
+void ShardedTileMemoryCache::UpdateIndex(const TileCoordinates& coords, bool indexed) {
+    std::lock_guard<std::mutex> lock(index_mutex_);
+    if (indexed) {
+        index_->Insert(coords);
+    } else {
+        index_->Remove(coords);
+    }
+}
+
+bool ShardedTileMemoryCache::UsesList(EvictionStrategy strategy) {
+    return strategy == EvictionStrategy::LRU || strategy == EvictionStrategy::TIME_BASED;
+}
+
+void ShardedTileMemoryCache::LinkFront(Shard& shard, Entry& entry) {
+    entry.prev = nullptr;
+    entry.next = shard.head;
+    if (shard.head) {
+        shard.head->prev = &entry;
+    } else {
+        shard.tail = &entry;
+    }
+    shard.head = &entry;
+}
+
+void ShardedTileMemoryCache::Unlink(Shard& shard, Entry& entry) {
+    if (entry.prev) {
+        entry.prev->next = entry.next;
+    } else {
+        shard.head = entry.next;
+    }
+    if (entry.next) {
+        entry.next->prev = entry.prev;
+    } else {
+        shard.tail = entry.prev;
+    }
+    entry.prev = nullptr;
+    entry.next = nullptr;
+}
+
+void ShardedTileMemoryCache::IndexEntry(Shard& shard, Entry& entry) {
+    if (UsesList(shard.strategy)) {
+        LinkFront(shard, entry);
+        return;
+    }
+
+    std::uint64_t primary = entry.hits;
+    if (shard.strategy == EvictionStrategy::SIZE_BASED) {
+        // Largest first: invert so the biggest tile sorts to begin()
+        primary = std::numeric_limits<std::uint64_t>::max() - entry.tile->GetDataSize();
+    }
+    entry.order_position = shard.order.insert(OrderKey{primary, entry.tick, &entry}).first;
+}
+
+void ShardedTileMemoryCache::UnindexEntry(Shard& shard, Entry& entry) {
+    if (UsesList(shard.strategy)) {
+        Unlink(shard, entry);
+    } else {
+        shard.order.erase(entry.order_position);
+    }
+}
+
+void ShardedTileMemoryCache::OnAccess(Shard& shard, Entry& entry) {
+    ++entry.hits;
+
+    switch (shard.strategy) {
+        case EvictionStrategy::LRU:
+            entry.tick = ++shard.clock;
+            Unlink(shard, entry);
+            LinkFront(shard, entry);
+            break;
+        case EvictionStrategy::LFU:
+            entry.tick = ++shard.clock;
+            UnindexEntry(shard, entry);
+            IndexEntry(shard, entry);
+            break;
+        case EvictionStrategy::SIZE_BASED:
+        case EvictionStrategy::TIME_BASED:
+            // Order depends on size / insertion time only
+            break;
+    }
+}
+
+void ShardedTileMemoryCache::OnReplace(Shard& shard, Entry& entry) {
+    // New data counts as a fresh insertion for every policy
+    UnindexEntry(shard, entry);
+    entry.tick = ++shard.clock;
+    IndexEntry(shard, entry);
+}
+
+ShardedTileMemoryCache::Entry* ShardedTileMemoryCache::FindVictim(
+    const Shard& shard, const TileCoordinates* keep) {
+    // The tile that triggered eviction is never its own victim
+    if (UsesList(shard.strategy)) {
+        Entry* victim = shard.tail;
+        if (victim && keep && victim->coords == *keep) {
+            victim = victim->prev;
+        }
+        return victim;
+    }
+
+    auto it = shard.order.begin();
+    if (it != shard.order.end() && keep && it->entry->coords == *keep) {
+        ++it;
+    }
+    return it != shard.order.end() ? it->entry : nullptr;
+}
+
+} // namespace earth_map
@@ -0,0 +1,207 @@
+/**
+ * @file tile_seeder.cpp
+ * @brief Bulk region download implementation
+ */
+
+#include <earth_map/data/tile_seeder.h>
+#include <earth_map/data/tile_compression.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace earth_map {
+
+namespace {
+
+/// Web Mercator latitude limit in degrees
+constexpr double kMaxMercatorLatitude = 85.0511;
+
+/**
+ * @brief Completions handed from loader threads to the seeding thread
+ */
+struct SeedCompletions {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<TileLoadResult> results;
+    std::size_t in_flight = 0;
+};
+
+} // namespace
+
+TileSeeder::TileSeeder(std::shared_ptr<TileLoader> loader,
+                       std::shared_ptr<PackedTileStore> store,
+                       const TileSeedConfig& config)
+    : loader_(std::move(loader)), store_(std::move(store)), config_(config) {
+    if (!loader_) {
+        throw std::invalid_argument("TileLoader cannot be null");
+    }
+    if (!store_) {
+        throw std::invalid_argument("PackedTileStore cannot be null");
+    }
+}
+
+std::vector<TileCoordinates> TileSeeder::EnumerateTiles(const GeographicBounds& bounds,
+                                                        std::int32_t min_zoom,
+                                                        std::int32_t max_zoom) {
+    if (!bounds.IsValid() || min_zoom > max_zoom) {
+        return {};
+    }
+    // BoundingBox2D holds (longitude, latitude)
+    const BoundingBox2D box(
+        glm::vec2(static_cast<float>(bounds.min.longitude),
+                  static_cast<float>(std::max(bounds.min.latitude, -kMaxMercatorLatitude))),
+        glm::vec2(static_cast<float>(bounds.max.longitude),
+                  static_cast<float>(std::min(bounds.max.latitude, kMaxMercatorLatitude))));
+    return TileMathematics::GetTilesInBoundsMultipleZooms(box, min_zoom, max_zoom);
+}
+
+TileSeedStats TileSeeder::Seed(const GeographicBounds& bounds, std::int32_t min_zoom,
+                               std::int32_t max_zoom, ProgressCallback progress) {
+    return Seed(EnumerateTiles(bounds, min_zoom, max_zoom), std::move(progress));
+}
+
+TileSeedStats TileSeeder::Seed(const std::vector<TileCoordinates>& tiles,
+                               ProgressCallback progress) {
+    cancelled_ = false;
+
+    TileSeedStats stats;
+    stats.total_tiles = tiles.size();
+
+    std::vector<TileCoordinates> pending;
+    pending.reserve(tiles.size());
+    for (const auto& coords : tiles) {
+        if (config_.skip_existing && store_->Contains(coords)) {
+            ++stats.skipped_tiles;
+        } else {
+            pending.push_back(coords);
+        }
+    }
+    if (stats.skipped_tiles > 0) {
+        spdlog::info("Tile seed: {} of {} tiles already stored", stats.skipped_tiles,
+                     stats.total_tiles);
+        if (progress) {
+            progress(stats);
+        }
+    }
+
+    std::vector<std::shared_ptr<const TileData>> batch;
+    const auto flush = [this, &batch, &stats]() {
+        if (batch.empty()) {
+            return;
+        }
+        const std::size_t written = store_->PutBatch(batch);
+        if (written != batch.size()) {
+            spdlog::error("Tile seed: stored {} of {} tiles", written, batch.size());
+            // PutBatch writes in order, so the tail is what failed
+            for (std::size_t i = written; i < batch.size(); ++i) {
+                stats.failures.push_back(batch[i]->metadata.coordinates);
+            }
+            stats.downloaded_tiles -= batch.size() - written;
+            stats.failed_tiles += batch.size() - written;
+        }
+        batch.clear();
+    };
+
+    const auto handle = [this, &stats, &batch, &flush, &progress](TileLoadResult result) {
+        if (!result.success || !result.tile_data) {
+            spdlog::warn("Tile seed: {}/{}/{} failed: {}", result.coordinates.zoom,
+                         result.coordinates.x, result.coordinates.y, result.error_message);
+            ++stats.failed_tiles;
+            stats.failures.push_back(result.coordinates);
+        } else {
+            auto tile = std::make_shared<TileData>(*result.tile_data);
+            tile->metadata.coordinates = result.coordinates;
+            stats.downloaded_bytes += tile->data.size();
+            tile->metadata.compression = TileMetadata::Compression::NONE;
+            if (config_.compression != TileMetadata::Compression::NONE &&
+                IsCompressionAvailable(config_.compression)) {
+                auto compressed = CompressTileData(tile->data, config_.compression);
+                if (compressed && compressed->size() < tile->data.size()) {
+                    tile->data = std::move(*compressed);
+                    tile->is_compressed = true;
+                    tile->metadata.compression = config_.compression;
+                }
+            }
+            ++stats.downloaded_tiles;
+            batch.push_back(std::move(tile));
+            if (batch.size() >= std::max<std::size_t>(1, config_.write_batch_size)) {
+                flush();
+            }
+        }
+        if (progress) {
+            progress(stats);
+        }
+    };
+
+    SeedCompletions completions;
+
+    // Handle finished downloads until fewer than `limit` are in flight
+    const auto drain_until = [&completions, &handle](std::size_t limit) {
+        std::unique_lock<std::mutex> lock(completions.mutex);
+        while (true) {
+            while (!completions.results.empty()) {
+                TileLoadResult result = std::move(completions.results.front());
+                completions.results.pop_front();
+                lock.unlock();
+                handle(std::move(result));
+                lock.lock();
+            }
+            if (completions.in_flight < limit) {
+                return;
+            }
+            completions.cv.wait(lock, [&completions] { return !completions.results.empty(); });
+        }
+    };
+
+    const std::size_t max_parallel = std::max<std::size_t>(1, config_.max_parallel_downloads);
+    const auto interval = config_.max_requests_per_second > 0.0
+        ? std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+              std::chrono::duration<double>(1.0 / config_.max_requests_per_second))
+        : std::chrono::steady_clock::duration::zero();
+    auto next_start = std::chrono::steady_clock::now();
+
+    for (const auto& coords : pending) {
+        drain_until(max_parallel);
+        if (cancelled_) {
+            stats.cancelled = true;
+            break;
+        }
+        // Rate limit: evenly spaced download starts
+        if (interval > std::chrono::steady_clock::duration::zero()) {
+            std::this_thread::sleep_until(next_start);
+            next_start = std::max(next_start + interval, std::chrono::steady_clock::now());
+        }
+        {
+            std::lock_guard<std::mutex> lock(completions.mutex);
+            ++completions.in_flight;
+        }
+        loader_->LoadTileAsync(coords, [&completions, coords](const TileLoadResult& result) {
+            std::lock_guard<std::mutex> lock(completions.mutex);
+            completions.results.push_back(result);
+            completions.results.back().coordinates = coords;
+            --completions.in_flight;
+            completions.cv.notify_all();
+        }, config_.provider_name);
+    }
+
+    // Every download started must finish before the completions go away
+    drain_until(1);
+    flush();
+
+    spdlog::info("Tile seed {}: {} downloaded, {} skipped, {} failed ({} bytes)",
+                 stats.cancelled ? "cancelled" : "finished", stats.downloaded_tiles,
+                 stats.skipped_tiles, stats.failed_tiles, stats.downloaded_bytes);
+    return stats;
+}
+
+void TileSeeder::Cancel() {
+    cancelled_ = true;
+}
+
+} // namespace earth_map
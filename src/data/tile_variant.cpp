@@ -0,0 +1,96 @@
+/**
+ * @file tile_variant.cpp
+ * @brief Implementation of bandwidth-adaptive tile variant selection
+ */
+
+#include <earth_map/data/tile_variant.h>
+#include <algorithm>
+
+namespace earth_map {
+
+TileVariantSelector::TileVariantSelector(const TileVariantSelectorConfig& config)
+    : config_(config) {}
+
+void TileVariantSelector::RecordTransfer(std::size_t bytes, std::uint64_t elapsed_ms,
+                                         std::size_t concurrent) {
+    if (bytes == 0) {
+        return;
+    }
+    // Concurrent transfers split the link: each one sees a share of it
+    const double seconds = static_cast<double>(std::max<std::uint64_t>(elapsed_ms, 1)) / 1000.0;
+    const double sample = static_cast<double>(bytes) / seconds *
+                          static_cast<double>(std::max<std::size_t>(concurrent, 1));
+    const double weight = std::clamp(config_.throughput_smoothing, 0.0, 1.0);
+    throughput_ = throughput_ > 0.0 ? throughput_ + weight * (sample - throughput_) : sample;
+}
+
+std::vector<std::size_t> TileVariantSelector::GetCandidates(
+    const std::vector<TileVariant>& variants) const {
+    std::vector<std::size_t> candidates;
+    float largest_scale = 0.0f;
+    for (std::size_t i = 0; i < variants.size(); ++i) {
+        largest_scale = std::max(largest_scale, variants[i].pixel_scale);
+        if (variants[i].pixel_scale >= config_.required_pixel_scale) {
+            candidates.push_back(i);
+        }
+    }
+    if (candidates.empty()) {
+        for (std::size_t i = 0; i < variants.size(); ++i) {
+            if (variants[i].pixel_scale == largest_scale) {
+                candidates.push_back(i);
+            }
+        }
+    }
+    return candidates;
+}
+
+std::size_t TileVariantSelector::GetPreferred(const std::vector<TileVariant>& variants) const {
+    std::size_t preferred = kNoVariant;
+    for (std::size_t i : GetCandidates(variants)) {
+        const TileVariant& variant = variants[i];
+        if (preferred == kNoVariant || variant.pixel_scale < variants[preferred].pixel_scale ||
+            (variant.pixel_scale == variants[preferred].pixel_scale &&
+             variant.expected_bytes > variants[preferred].expected_bytes)) {
+            preferred = i;
+        }
+    }
+    return preferred;
+}
+
+std::size_t TileVariantSelector::Select(const std::vector<TileVariant>& variants,
+                                        std::size_t pending) const {
+    const std::size_t preferred = GetPreferred(variants);
+    if (preferred == kNoVariant || throughput_ <= 0.0) {
+        return preferred;
+    }
+
+    // Bytes ahead of a new download: each pending one costs about as much
+    const auto arrival_ms = [&](const TileVariant& variant) {
+        return static_cast<double>(variant.expected_bytes) * static_cast<double>(pending + 1) /
+               throughput_ * 1000.0;
+    };
+    const double budget_ms = static_cast<double>(config_.target_latency.count());
+    const std::size_t ceiling = variants[preferred].expected_bytes;
+
+    std::size_t best = kNoVariant;
+    std::size_t cheapest = kNoVariant;
+    for (std::size_t i : GetCandidates(variants)) {
+        const TileVariant& variant = variants[i];
+        if (cheapest == kNoVariant || variant.expected_bytes < variants[cheapest].expected_bytes) {
+            cheapest = i;
+        }
+        // Nothing richer than the preferred variant is worth its bytes
+        if (variant.expected_bytes > ceiling || arrival_ms(variant) > budget_ms) {
+            continue;
+        }
+        if (best == kNoVariant || variant.expected_bytes > variants[best].expected_bytes) {
+            best = i;
+        }
+    }
+    if (variants[preferred].expected_bytes == 0 || arrival_ms(variants[preferred]) <= budget_ms) {
+        return preferred;
+    }
+    return best != kNoVariant ? best : cheapest;
+}
+
+} // namespace earth_map
@@ -0,0 +1,162 @@
+/**
+ * @file tile_write_behind_queue.cpp
+ * @brief Implementation of the tile cache write-behind queue
+ */
+
+#include <earth_map/data/tile_write_behind_queue.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <stdexcept>
+#include <tuple>
+
+namespace earth_map {
+
+TileWriteBehindQueue::TileWriteBehindQueue(std::size_t capacity, BatchWriter writer)
+    : capacity_(std::max<std::size_t>(capacity, 1))
+    , writer_(std::move(writer)) {
+    if (!writer_) {
+        throw std::invalid_argument("TileWriteBehindQueue: writer must not be empty");
+    }
+    thread_ = std::thread(&TileWriteBehindQueue::Run, this);
+}
+
+TileWriteBehindQueue::~TileWriteBehindQueue() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    work_cv_.notify_all();
+    space_cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void TileWriteBehindQueue::Enqueue(TileDiskOp op) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    auto it = pending_.find(op.coordinates);
+    if (it == pending_.end()) {
+        // Backpressure: wait for the I/O thread (never during shutdown)
+        space_cv_.wait(lock, [this] { return stop_ || pending_.size() < capacity_; });
+        it = pending_.find(op.coordinates);
+    }
+
+    if (it != pending_.end()) {
+        ++coalesced_;
+        TileDiskOp& existing = it->second.op;
+        if (op.kind == TileDiskOp::Kind::WRITE_METADATA &&
+            existing.kind == TileDiskOp::Kind::WRITE_TILE) {
+            // Keep the pending data (and its encoding), take the newer metadata
+            auto tile = std::make_shared<TileData>(*existing.tile);
+            const auto compression = tile->metadata.compression;
+            tile->metadata = *op.metadata;
+            tile->metadata.compression = compression;
+            existing.tile = std::move(tile);
+        } else if (op.kind == TileDiskOp::Kind::WRITE_METADATA &&
+                   existing.kind == TileDiskOp::Kind::REMOVE) {
+            // The tile is gone: its metadata must not outlive the removal
+        } else {
+            existing = std::move(op);
+        }
+        it->second.sequence = ++next_sequence_;
+    } else {
+        const TileCoordinates coordinates = op.coordinates;
+        pending_.emplace(coordinates, Pending{std::move(op), ++next_sequence_});
+    }
+
+    lock.unlock();
+    work_cv_.notify_one();
+}
+
+std::optional<TileDiskOp> TileWriteBehindQueue::Find(const TileCoordinates& coordinates) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = pending_.find(coordinates);
+    if (it == pending_.end()) {
+        return std::nullopt;
+    }
+    return it->second.op;
+}
+
+void TileWriteBehindQueue::Flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this] { return pending_.empty() && !writing_; });
+}
+
+void TileWriteBehindQueue::Discard() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    pending_.clear();
+    space_cv_.notify_all();
+    idle_cv_.wait(lock, [this] { return !writing_; });
+}
+
+std::size_t TileWriteBehindQueue::Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_.size();
+}
+
+std::uint64_t TileWriteBehindQueue::GetBatchCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return batches_;
+}
+
+std::uint64_t TileWriteBehindQueue::GetCoalescedCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return coalesced_;
+}
+
+void TileWriteBehindQueue::Run() {
+    std::vector<TileDiskOp> batch;
+    std::vector<std::pair<TileCoordinates, std::uint64_t>> written;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        work_cv_.wait(lock, [this] { return stop_ || !pending_.empty(); });
+        if (pending_.empty()) {
+            break;  // Stopped and fully drained
+        }
+
+        // Snapshot; entries stay pending (and visible to Find) until written
+        batch.clear();
+        written.clear();
+        for (const auto& [coordinates, pending] : pending_) {
+            if (batch.size() >= kMaxBatchSize) {
+                break;
+            }
+            batch.push_back(pending.op);
+            written.emplace_back(coordinates, pending.sequence);
+        }
+        writing_ = true;
+        lock.unlock();
+
+        // Group by zoom directory, then row: neighbours land in the same place
+        std::sort(batch.begin(), batch.end(), [](const TileDiskOp& a, const TileDiskOp& b) {
+            return std::tie(a.coordinates.zoom, a.coordinates.y, a.coordinates.x) <
+                   std::tie(b.coordinates.zoom, b.coordinates.y, b.coordinates.x);
+        });
+
+        try {
+            writer_(batch);
+        } catch (const std::exception& e) {
+            spdlog::error("Tile write-behind batch failed: {}", e.what());
+        }
+
+        lock.lock();
+        for (const auto& [coordinates, sequence] : written) {
+            auto it = pending_.find(coordinates);
+            // Re-queued meanwhile: keep the newer operation
+            if (it != pending_.end() && it->second.sequence == sequence) {
+                pending_.erase(it);
+            }
+        }
+        writing_ = false;
+        ++batches_;
+        space_cv_.notify_all();
+        idle_cv_.notify_all();
+    }
+
+    writing_ = false;
+    idle_cv_.notify_all();
+}
+
+} // namespace earth_map
@@ -1,8 +1,260 @@
 #include "earth_map/math/frustum.h"
 #include <glm/gtc/matrix_inverse.hpp>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define EARTH_MAP_FRUSTUM_X86 1
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define EARTH_MAP_FRUSTUM_NEON 1
+#include <arm_neon.h>
+#endif
 
 namespace earth_map {
 
+namespace {
+
+/// Frustum planes in structure-of-arrays layout, with |normal| precomputed
+struct PlaneSet {
+    float nx[Frustum::COUNT];
+    float ny[Frustum::COUNT];
+    float nz[Frustum::COUNT];
+    float d[Frustum::COUNT];
+    float abs_nx[Frustum::COUNT];
+    float abs_ny[Frustum::COUNT];
+    float abs_nz[Frustum::COUNT];
+};
+
+PlaneSet MakePlaneSet(const std::array<Plane, Frustum::COUNT>& planes) {
+    PlaneSet set;
+    for (std::size_t k = 0; k < Frustum::COUNT; ++k) {
+        set.nx[k] = planes[k].normal.x;
+        set.ny[k] = planes[k].normal.y;
+        set.nz[k] = planes[k].normal.z;
+        set.d[k] = planes[k].distance;
+        set.abs_nx[k] = std::abs(planes[k].normal.x);
+        set.abs_ny[k] = std::abs(planes[k].normal.y);
+        set.abs_nz[k] = std::abs(planes[k].normal.z);
+    }
+    return set;
+}
+
+/**
+ * @brief Test boxes [begin, count) one at a time
+ *
+ * A box is outside a plane when its center is further behind the plane than
+ * its projected radius, sum |n . axis_a| * extent_a (the AABB positive-vertex
+ * test when the axes are the coordinate axes).
+ */
+void IntersectsRangeScalar(const PlaneSet& planes, const FrustumBoxBatch& boxes,
+                           std::size_t begin, std::uint64_t* visible_mask) {
+    const bool oriented = boxes.IsOriented();
+    for (std::size_t i = begin; i < boxes.count; ++i) {
+        const float cx = boxes.center[0][i];
+        const float cy = boxes.center[1][i];
+        const float cz = boxes.center[2][i];
+        const float ex = boxes.extent[0][i];
+        const float ey = boxes.extent[1][i];
+        const float ez = boxes.extent[2][i];
+
+        bool inside = true;
+        for (std::size_t k = 0; k < Frustum::COUNT && inside; ++k) {
+            const float distance = planes.nx[k] * cx + planes.ny[k] * cy + planes.nz[k] * cz + planes.d[k];
+            float radius;
+            if (oriented) {
+                float projected[3];
+                for (int a = 0; a < 3; ++a) {
+                    projected[a] = std::abs(planes.nx[k] * boxes.axis[a][0][i] +
+                                            planes.ny[k] * boxes.axis[a][1][i] +
+                                            planes.nz[k] * boxes.axis[a][2][i]);
+                }
+                radius = projected[0] * ex + projected[1] * ey + projected[2] * ez;
+            } else {
+                radius = planes.abs_nx[k] * ex + planes.abs_ny[k] * ey + planes.abs_nz[k] * ez;
+            }
+            inside = distance + radius >= 0.0f;
+        }
+
+        if (inside) {
+            visible_mask[i / 64] |= std::uint64_t{1} << (i % 64);
+        }
+    }
+}
+
+#if defined(EARTH_MAP_FRUSTUM_X86)
+
+/// Boxes [0, returned) tested four at a time (SSE2 is baseline on x86-64)
+template <bool kOriented>
+std::size_t IntersectsSse2(const PlaneSet& planes, const FrustumBoxBatch& boxes,
+                           std::uint64_t* visible_mask) {
+    const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 zero = _mm_setzero_ps();
+
+    std::size_t i = 0;
+    for (; i + 4 <= boxes.count; i += 4) {
+        const __m128 cx = _mm_loadu_ps(boxes.center[0] + i);
+        const __m128 cy = _mm_loadu_ps(boxes.center[1] + i);
+        const __m128 cz = _mm_loadu_ps(boxes.center[2] + i);
+        const __m128 ex = _mm_loadu_ps(boxes.extent[0] + i);
+        const __m128 ey = _mm_loadu_ps(boxes.extent[1] + i);
+        const __m128 ez = _mm_loadu_ps(boxes.extent[2] + i);
+
+        __m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (std::size_t k = 0; k < Frustum::COUNT; ++k) {
+            const __m128 nx = _mm_set1_ps(planes.nx[k]);
+            const __m128 ny = _mm_set1_ps(planes.ny[k]);
+            const __m128 nz = _mm_set1_ps(planes.nz[k]);
+            const __m128 distance = _mm_add_ps(
+                _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)), _mm_mul_ps(nz, cz)),
+                _mm_set1_ps(planes.d[k]));
+
+            __m128 radius;
+            if constexpr (kOriented) {
+                __m128 projected[3];
+                for (int a = 0; a < 3; ++a) {
+                    const __m128 dot = _mm_add_ps(
+                        _mm_add_ps(_mm_mul_ps(nx, _mm_loadu_ps(boxes.axis[a][0] + i)),
+                                   _mm_mul_ps(ny, _mm_loadu_ps(boxes.axis[a][1] + i))),
+                        _mm_mul_ps(nz, _mm_loadu_ps(boxes.axis[a][2] + i)));
+                    projected[a] = _mm_and_ps(dot, abs_mask);
+                }
+                radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(projected[0], ex), _mm_mul_ps(projected[1], ey)),
+                                    _mm_mul_ps(projected[2], ez));
+            } else {
+                radius = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(planes.abs_nx[k]), ex),
+                               _mm_mul_ps(_mm_set1_ps(planes.abs_ny[k]), ey)),
+                    _mm_mul_ps(_mm_set1_ps(planes.abs_nz[k]), ez));
+            }
+            inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+        }
+
+        const auto bits = static_cast<std::uint64_t>(_mm_movemask_ps(inside));
+        visible_mask[i / 64] |= bits << (i % 64);
+    }
+    return i;
+}
+
+/// Boxes [0, returned) tested eight at a time
+template <bool kOriented>
+__attribute__((target("avx2")))
+std::size_t IntersectsAvx2(const PlaneSet& planes, const FrustumBoxBatch& boxes,
+                           std::uint64_t* visible_mask) {
+    const __m256 abs_mask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7FFFFFFF));
+    const __m256 zero = _mm256_setzero_ps();
+
+    std::size_t i = 0;
+    for (; i + 8 <= boxes.count; i += 8) {
+        const __m256 cx = _mm256_loadu_ps(boxes.center[0] + i);
+        const __m256 cy = _mm256_loadu_ps(boxes.center[1] + i);
+        const __m256 cz = _mm256_loadu_ps(boxes.center[2] + i);
+        const __m256 ex = _mm256_loadu_ps(boxes.extent[0] + i);
+        const __m256 ey = _mm256_loadu_ps(boxes.extent[1] + i);
+        const __m256 ez = _mm256_loadu_ps(boxes.extent[2] + i);
+
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (std::size_t k = 0; k < Frustum::COUNT; ++k) {
+            const __m256 nx = _mm256_set1_ps(planes.nx[k]);
+            const __m256 ny = _mm256_set1_ps(planes.ny[k]);
+            const __m256 nz = _mm256_set1_ps(planes.nz[k]);
+            const __m256 distance = _mm256_add_ps(
+                _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, cx), _mm256_mul_ps(ny, cy)),
+                              _mm256_mul_ps(nz, cz)),
+                _mm256_set1_ps(planes.d[k]));
+
+            __m256 radius;
+            if constexpr (kOriented) {
+                __m256 projected[3];
+                for (int a = 0; a < 3; ++a) {
+                    const __m256 dot = _mm256_add_ps(
+                        _mm256_add_ps(_mm256_mul_ps(nx, _mm256_loadu_ps(boxes.axis[a][0] + i)),
+                                      _mm256_mul_ps(ny, _mm256_loadu_ps(boxes.axis[a][1] + i))),
+                        _mm256_mul_ps(nz, _mm256_loadu_ps(boxes.axis[a][2] + i)));
+                    projected[a] = _mm256_and_ps(dot, abs_mask);
+                }
+                radius = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(projected[0], ex), _mm256_mul_ps(projected[1], ey)),
+                    _mm256_mul_ps(projected[2], ez));
+            } else {
+                radius = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(planes.abs_nx[k]), ex),
+                                  _mm256_mul_ps(_mm256_set1_ps(planes.abs_ny[k]), ey)),
+                    _mm256_mul_ps(_mm256_set1_ps(planes.abs_nz[k]), ez));
+            }
+            inside = _mm256_and_ps(
+                inside, _mm256_cmp_ps(_mm256_add_ps(distance, radius), zero, _CMP_GE_OQ));
+        }
+
+        const auto bits = static_cast<std::uint64_t>(_mm256_movemask_ps(inside));
+        visible_mask[i / 64] |= bits << (i % 64);
+    }
+    return i;
+}
+
+bool DetectAvx2() {
+    return __builtin_cpu_supports("avx2");
+}
+
+const bool kAvx2 = DetectAvx2();
+
+#elif defined(EARTH_MAP_FRUSTUM_NEON)
+
+/// Boxes [0, returned) tested four at a time
+template <bool kOriented>
+std::size_t IntersectsNeon(const PlaneSet& planes, const FrustumBoxBatch& boxes,
+                           std::uint64_t* visible_mask) {
+    const uint32x4_t lane_bits = {1u, 2u, 4u, 8u};
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+
+    std::size_t i = 0;
+    for (; i + 4 <= boxes.count; i += 4) {
+        const float32x4_t cx = vld1q_f32(boxes.center[0] + i);
+        const float32x4_t cy = vld1q_f32(boxes.center[1] + i);
+        const float32x4_t cz = vld1q_f32(boxes.center[2] + i);
+        const float32x4_t ex = vld1q_f32(boxes.extent[0] + i);
+        const float32x4_t ey = vld1q_f32(boxes.extent[1] + i);
+        const float32x4_t ez = vld1q_f32(boxes.extent[2] + i);
+
+        uint32x4_t inside = vdupq_n_u32(0xFFFFFFFFu);
+        for (std::size_t k = 0; k < Frustum::COUNT; ++k) {
+            const float32x4_t nx = vdupq_n_f32(planes.nx[k]);
+            const float32x4_t ny = vdupq_n_f32(planes.ny[k]);
+            const float32x4_t nz = vdupq_n_f32(planes.nz[k]);
+            const float32x4_t distance = vaddq_f32(
+                vaddq_f32(vaddq_f32(vmulq_f32(nx, cx), vmulq_f32(ny, cy)), vmulq_f32(nz, cz)),
+                vdupq_n_f32(planes.d[k]));
+
+            float32x4_t radius;
+            if constexpr (kOriented) {
+                float32x4_t projected[3];
+                for (int a = 0; a < 3; ++a) {
+                    const float32x4_t dot = vaddq_f32(
+                        vaddq_f32(vmulq_f32(nx, vld1q_f32(boxes.axis[a][0] + i)),
+                                  vmulq_f32(ny, vld1q_f32(boxes.axis[a][1] + i))),
+                        vmulq_f32(nz, vld1q_f32(boxes.axis[a][2] + i)));
+                    projected[a] = vabsq_f32(dot);
+                }
+                radius = vaddq_f32(vaddq_f32(vmulq_f32(projected[0], ex), vmulq_f32(projected[1], ey)),
+                                   vmulq_f32(projected[2], ez));
+            } else {
+                radius = vaddq_f32(vaddq_f32(vmulq_f32(vdupq_n_f32(planes.abs_nx[k]), ex),
+                                             vmulq_f32(vdupq_n_f32(planes.abs_ny[k]), ey)),
+                                   vmulq_f32(vdupq_n_f32(planes.abs_nz[k]), ez));
+            }
+            inside = vandq_u32(inside, vcgeq_f32(vaddq_f32(distance, radius), zero));
+        }
+
+        const auto bits = static_cast<std::uint64_t>(vaddvq_u32(vandq_u32(inside, lane_bits)));
+        visible_mask[i / 64] |= bits << (i % 64);
+    }
+    return i;
+}
+
+#endif
+
+} // namespace
+
 void Frustum::Update(const glm::mat4& view_projection) {
     view_projection_matrix_ = view_projection;
 
@@ -37,9 +289,10 @@ void Frustum::Update(const glm::mat4& view_projection) {
                                   view_projection[2][3] - view_projection[2][2]);
     planes[FAR].distance = view_projection[3][3] - view_projection[3][2];
 
-    // Normalize all plane normals
+    // Normalize planes (normal and distance together, so DistanceTo()
+    // returns world-space distances)
     for (auto& plane : planes) {
-        plane.normal = glm::normalize(plane.normal);
+        plane.Normalize();
     }
 }
 
@@ -75,6 +328,45 @@ bool Frustum::Intersects(const BoundingBox& box) const {
     return true;
 }
 
+void Frustum::IntersectsBatch(const FrustumBoxBatch& boxes, std::uint64_t* visible_mask) const {
+    std::fill_n(visible_mask, BatchMaskWords(boxes.count), std::uint64_t{0});
+    const PlaneSet plane_set = MakePlaneSet(planes);
+    const bool oriented = boxes.IsOriented();
+
+    // Full SIMD groups first (group sizes divide 64, so no group straddles
+    // a mask word), then the remainder one box at a time
+    std::size_t done = 0;
+#if defined(EARTH_MAP_FRUSTUM_X86)
+    if (kAvx2) {
+        done = oriented ? IntersectsAvx2<true>(plane_set, boxes, visible_mask)
+                        : IntersectsAvx2<false>(plane_set, boxes, visible_mask);
+    } else {
+        done = oriented ? IntersectsSse2<true>(plane_set, boxes, visible_mask)
+                        : IntersectsSse2<false>(plane_set, boxes, visible_mask);
+    }
+#elif defined(EARTH_MAP_FRUSTUM_NEON)
+    done = oriented ? IntersectsNeon<true>(plane_set, boxes, visible_mask)
+                    : IntersectsNeon<false>(plane_set, boxes, visible_mask);
+#else
+    (void)oriented;
+#endif
+    IntersectsRangeScalar(plane_set, boxes, done, visible_mask);
+}
+
+void Frustum::IntersectsBatchScalar(const FrustumBoxBatch& boxes,
+                                    std::uint64_t* visible_mask) const {
+    std::fill_n(visible_mask, BatchMaskWords(boxes.count), std::uint64_t{0});
+    IntersectsRangeScalar(MakePlaneSet(planes), boxes, 0, visible_mask);
+}
+
+bool Frustum::IsBatchSimdAccelerated() {
+#if defined(EARTH_MAP_FRUSTUM_X86) || defined(EARTH_MAP_FRUSTUM_NEON)
+    return true;
+#else
+    return false;
+#endif
+}
+
 std::array<glm::vec3, 8> Frustum::GetCorners(float near_distance, float far_distance) const {
     (void)near_distance;
     (void)far_distance;
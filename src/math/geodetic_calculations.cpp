@@ -4,8 +4,13 @@
  */
 
 #include "../../include/earth_map/math/geodetic_calculations.h"
+#include "../../include/earth_map/math/polyline_simplification.h"
+#include "../../include/earth_map/math/vector_math.h"
 #include <cmath>
 #include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
 #include <stdexcept>
 #include <glm/glm.hpp>
 
@@ -260,17 +265,366 @@ double GeodeticCalculator::AlongTrackDistance(const Geographic& point,
     return distance_start_to_point * cos_bearing_diff;
 }
 
+// GeodeticCalculator batch implementation
+
+namespace {
+    // Targets evaluated per block, so scratch arrays stay on the stack
+    constexpr std::size_t kGeodeticBlock = 256;
+
+    // Vincenty iteration limits, as in VincentyDistanceAndBearing()
+    constexpr int kVincentyMaxIterations = 100;
+    constexpr double kVincentyTolerance = 1e-12;
+
+    // Ellipsoidal distances run up to 0.7% shorter than great circles on
+    // the semi-major sphere, so the Vincenty pre-filter box is widened
+    constexpr double kVincentyFilterMargin = 1.01;
+
+    void RequireSameSizes(std::size_t count, std::initializer_list<std::size_t> sizes) {
+        for (const std::size_t size : sizes) {
+            if (size != count) {
+                throw std::invalid_argument("GeodeticCalculator batch: span sizes differ");
+            }
+        }
+    }
+
+    inline std::span<double> Scratch(double* data, std::size_t size) {
+        return std::span<double>(data, size);
+    }
+
+    /**
+     * @brief Haversine distances from one origin to a block of targets
+     */
+    void HaversineBlock(const Geographic& origin, const double* latitudes,
+                        const double* longitudes, std::size_t n,
+                        double* distances, double* bearings) {
+        const double lat1_rad = DegreesToRadians(origin.latitude);
+        const double lon1_rad = DegreesToRadians(origin.longitude);
+        const double sin_lat1 = std::sin(lat1_rad);
+        const double cos_lat1 = std::cos(lat1_rad);
+
+        double lat2_rad[kGeodeticBlock];
+        double half_dlat[kGeodeticBlock];
+        double half_dlon[kGeodeticBlock];
+        for (std::size_t j = 0; j < n; ++j) {
+            lat2_rad[j] = DegreesToRadians(latitudes[j]);
+            half_dlat[j] = (lat2_rad[j] - lat1_rad) / 2.0;
+            half_dlon[j] = (DegreesToRadians(longitudes[j]) - lon1_rad) / 2.0;
+        }
+
+        double sin_lat2[kGeodeticBlock];
+        double cos_lat2[kGeodeticBlock];
+        double sin_half_dlat[kGeodeticBlock];
+        double sin_half_dlon[kGeodeticBlock];
+        double cos_half_dlon[kGeodeticBlock];
+        VectorMath::SinCos(Scratch(lat2_rad, n), Scratch(sin_lat2, n), Scratch(cos_lat2, n));
+        // The cosines of half the latitude difference are not needed
+        VectorMath::SinCos(Scratch(half_dlat, n), Scratch(sin_half_dlat, n), Scratch(half_dlat, n));
+        VectorMath::SinCos(Scratch(half_dlon, n), Scratch(sin_half_dlon, n), Scratch(cos_half_dlon, n));
+
+        double root_a[kGeodeticBlock];
+        double root_1_minus_a[kGeodeticBlock];
+        for (std::size_t j = 0; j < n; ++j) {
+            const double a = std::clamp(sin_half_dlat[j] * sin_half_dlat[j] +
+                                        cos_lat1 * cos_lat2[j] * sin_half_dlon[j] * sin_half_dlon[j],
+                                        0.0, 1.0);
+            root_a[j] = std::sqrt(a);
+            root_1_minus_a[j] = std::sqrt(1.0 - a);
+        }
+        VectorMath::Atan2(Scratch(root_a, n), Scratch(root_1_minus_a, n), Scratch(root_a, n));
+        for (std::size_t j = 0; j < n; ++j) {
+            distances[j] = WGS84_SEMI_MAJOR_AXIS * 2.0 * root_a[j];
+        }
+
+        if (bearings == nullptr) {
+            return;
+        }
+        double y[kGeodeticBlock];
+        double x[kGeodeticBlock];
+        for (std::size_t j = 0; j < n; ++j) {
+            const double sin_dlon = 2.0 * sin_half_dlon[j] * cos_half_dlon[j];
+            const double cos_dlon = 1.0 - 2.0 * sin_half_dlon[j] * sin_half_dlon[j];
+            y[j] = sin_dlon * cos_lat2[j];
+            x[j] = cos_lat1 * sin_lat2[j] - sin_lat1 * cos_lat2[j] * cos_dlon;
+        }
+        VectorMath::Atan2(Scratch(y, n), Scratch(x, n), Scratch(y, n));
+        for (std::size_t j = 0; j < n; ++j) {
+            bearings[j] = RadiansToDegrees(NormalizeAngleRadians(y[j]));
+        }
+    }
+
+    /**
+     * @brief Vincenty distances from one origin to a block of targets
+     *
+     * Each iteration evaluates only the targets still in the active list;
+     * a target leaves it when its lambda converges or its points coincide.
+     */
+    void VincentyBlock(const Geographic& origin, const double* latitudes,
+                       const double* longitudes, std::size_t n,
+                       double* distances, double* bearings) {
+        const double a = WGS84_SEMI_MAJOR_AXIS;
+        const double b = WGS84_SEMI_MINOR_AXIS;
+        const double f = WGS84_FLATTENING;
+
+        // Reduced latitude U = atan((1 - f) tan(lat)) via its sine and cosine
+        const auto reduce = [f](double sin_lat, double cos_lat, double& sin_u, double& cos_u) {
+            const double scaled = (1.0 - f) * sin_lat;
+            const double norm = std::sqrt(cos_lat * cos_lat + scaled * scaled);
+            sin_u = scaled / norm;
+            cos_u = cos_lat / norm;
+        };
+        // The origin goes through the same kernel as the targets, so a
+        // target at the origin reduces to exactly the same U and coincides
+        const double lat1_rad = DegreesToRadians(origin.latitude);
+        const double lon1_rad = DegreesToRadians(origin.longitude);
+        double sin_u1;
+        double cos_u1;
+        VectorMath::SinCos({&lat1_rad, 1}, {&sin_u1, 1}, {&cos_u1, 1});
+        reduce(sin_u1, cos_u1, sin_u1, cos_u1);
+
+        double sin_u2[kGeodeticBlock];
+        double cos_u2[kGeodeticBlock];
+        double l[kGeodeticBlock];
+        double lambda[kGeodeticBlock];
+        for (std::size_t j = 0; j < n; ++j) {
+            lambda[j] = DegreesToRadians(latitudes[j]);
+            l[j] = DegreesToRadians(longitudes[j]) - lon1_rad;
+        }
+        VectorMath::SinCos(Scratch(lambda, n), Scratch(sin_u2, n), Scratch(cos_u2, n));
+        for (std::size_t j = 0; j < n; ++j) {
+            reduce(sin_u2[j], cos_u2[j], sin_u2[j], cos_u2[j]);
+            lambda[j] = l[j];
+        }
+
+        // Per-target state of its last iteration
+        enum : std::uint8_t { kActive, kConverged, kCoincident };
+        std::uint8_t status[kGeodeticBlock];
+        double sin_sigma[kGeodeticBlock];
+        double cos_sigma[kGeodeticBlock];
+        double sigma[kGeodeticBlock];
+        double cos2_alpha[kGeodeticBlock];
+        double cos2_sigma_m[kGeodeticBlock];
+        std::uint16_t active[kGeodeticBlock];
+        std::size_t active_count = n;
+        for (std::size_t j = 0; j < n; ++j) {
+            status[j] = kActive;
+            active[j] = static_cast<std::uint16_t>(j);
+        }
+
+        // Scratch indexed by position in the active list
+        double sin_lambda[kGeodeticBlock];
+        double cos_lambda[kGeodeticBlock];
+        double atan_y[kGeodeticBlock];
+        double atan_x[kGeodeticBlock];
+        for (int iteration = 0; iteration < kVincentyMaxIterations && active_count > 0; ++iteration) {
+            for (std::size_t k = 0; k < active_count; ++k) {
+                sin_lambda[k] = lambda[active[k]];
+            }
+            VectorMath::SinCos(Scratch(sin_lambda, active_count), Scratch(sin_lambda, active_count),
+                               Scratch(cos_lambda, active_count));
+            for (std::size_t k = 0; k < active_count; ++k) {
+                const std::size_t j = active[k];
+                const double t1 = cos_u2[j] * sin_lambda[k];
+                const double t2 = cos_u1 * sin_u2[j] - sin_u1 * cos_u2[j] * cos_lambda[k];
+                sin_sigma[j] = std::sqrt(t1 * t1 + t2 * t2);
+                cos_sigma[j] = sin_u1 * sin_u2[j] + cos_u1 * cos_u2[j] * cos_lambda[k];
+                atan_y[k] = sin_sigma[j];
+                atan_x[k] = cos_sigma[j];
+            }
+            VectorMath::Atan2(Scratch(atan_y, active_count), Scratch(atan_x, active_count),
+                              Scratch(atan_y, active_count));
+
+            std::size_t still_active = 0;
+            for (std::size_t k = 0; k < active_count; ++k) {
+                const std::size_t j = active[k];
+                if (sin_sigma[j] == 0.0) {
+                    status[j] = kCoincident;
+                    continue;
+                }
+                sigma[j] = atan_y[k];
+                const double sin_alpha = cos_u1 * cos_u2[j] * sin_lambda[k] / sin_sigma[j];
+                cos2_alpha[j] = 1.0 - sin_alpha * sin_alpha;
+                cos2_sigma_m[j] = cos2_alpha[j] == 0.0
+                    ? 0.0 : cos_sigma[j] - 2.0 * sin_u1 * sin_u2[j] / cos2_alpha[j];
+                const double c = f / 16.0 * cos2_alpha[j] * (4.0 + f * (4.0 - 3.0 * cos2_alpha[j]));
+                const double lambda_prev = lambda[j];
+                lambda[j] = l[j] + (1.0 - c) * f * sin_alpha *
+                    (sigma[j] + c * sin_sigma[j] *
+                     (cos2_sigma_m[j] + c * cos_sigma[j] * (-1.0 + 2.0 * cos2_sigma_m[j] * cos2_sigma_m[j])));
+                if (std::abs(lambda[j] - lambda_prev) < kVincentyTolerance) {
+                    status[j] = kConverged;
+                } else {
+                    active[still_active++] = static_cast<std::uint16_t>(j);
+                }
+            }
+            active_count = still_active;
+        }
+
+        for (std::size_t j = 0; j < n; ++j) {
+            if (status[j] == kCoincident) {
+                distances[j] = 0.0;
+                continue;
+            }
+            if (status[j] == kActive) {
+                distances[j] = std::numeric_limits<double>::quiet_NaN();
+                continue;
+            }
+            const double u2 = cos2_alpha[j] * (a * a - b * b) / (b * b);
+            const double big_a = 1.0 + u2 / 16384.0 * (4096.0 + u2 * (-768.0 + u2 * (320.0 - 175.0 * u2)));
+            const double big_b = u2 / 1024.0 * (256.0 + u2 * (-128.0 + u2 * (74.0 - 47.0 * u2)));
+            const double c2sm = cos2_sigma_m[j];
+            const double delta_sigma = big_b * sin_sigma[j] *
+                (c2sm + big_b / 4.0 *
+                 (cos_sigma[j] * (-1.0 + 2.0 * c2sm * c2sm) -
+                  big_b / 6.0 * c2sm * (-3.0 + 4.0 * sin_sigma[j] * sin_sigma[j]) *
+                  (-3.0 + 4.0 * c2sm * c2sm)));
+            distances[j] = b * big_a * (sigma[j] - delta_sigma);
+        }
+
+        if (bearings == nullptr) {
+            return;
+        }
+        // Bearings use the final lambda, as VincentyDistanceAndBearing() does
+        VectorMath::SinCos(Scratch(lambda, n), Scratch(sin_lambda, n), Scratch(cos_lambda, n));
+        for (std::size_t j = 0; j < n; ++j) {
+            atan_y[j] = cos_u2[j] * sin_lambda[j];
+            atan_x[j] = cos_u1 * sin_u2[j] - sin_u1 * cos_u2[j] * cos_lambda[j];
+        }
+        VectorMath::Atan2(Scratch(atan_y, n), Scratch(atan_x, n), Scratch(atan_y, n));
+        for (std::size_t j = 0; j < n; ++j) {
+            if (status[j] == kConverged) {
+                bearings[j] = RadiansToDegrees(NormalizeAngleRadians(atan_y[j]));
+            } else {
+                bearings[j] = status[j] == kCoincident ? 0.0 : std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+    }
+
+    /**
+     * @brief Run a block function over targets in blocks of kGeodeticBlock
+     */
+    template <typename Block>
+    void ForEachGeodeticBlock(const Geographic& origin,
+                              std::span<const double> latitudes,
+                              std::span<const double> longitudes,
+                              std::span<double> distances,
+                              std::span<double> bearings,
+                              const Block& block) {
+        RequireSameSizes(latitudes.size(), {longitudes.size(), distances.size()});
+        if (!bearings.empty()) {
+            RequireSameSizes(latitudes.size(), {bearings.size()});
+        }
+        for (std::size_t begin = 0; begin < latitudes.size(); begin += kGeodeticBlock) {
+            const std::size_t n = std::min(kGeodeticBlock, latitudes.size() - begin);
+            block(origin, latitudes.data() + begin, longitudes.data() + begin, n,
+                  distances.data() + begin, bearings.empty() ? nullptr : bearings.data() + begin);
+        }
+    }
+}
+
+void GeodeticCalculator::HaversineDistances(const Geographic& origin,
+                                            std::span<const double> latitudes,
+                                            std::span<const double> longitudes,
+                                            std::span<double> distances,
+                                            std::span<double> initial_bearings) {
+    ForEachGeodeticBlock(origin, latitudes, longitudes, distances, initial_bearings, HaversineBlock);
+}
+
+void GeodeticCalculator::VincentyDistances(const Geographic& origin,
+                                           std::span<const double> latitudes,
+                                           std::span<const double> longitudes,
+                                           std::span<double> distances,
+                                           std::span<double> initial_bearings) {
+    ForEachGeodeticBlock(origin, latitudes, longitudes, distances, initial_bearings, VincentyBlock);
+}
+
+void GeodeticCalculator::DistanceMatrix(std::span<const double> latitudes_a,
+                                        std::span<const double> longitudes_a,
+                                        std::span<const double> latitudes_b,
+                                        std::span<const double> longitudes_b,
+                                        std::span<double> distances,
+                                        DistanceFormula formula) {
+    RequireSameSizes(latitudes_a.size(), {longitudes_a.size()});
+    RequireSameSizes(latitudes_b.size(), {longitudes_b.size()});
+    const std::size_t size_b = latitudes_b.size();
+    RequireSameSizes(latitudes_a.size() * size_b, {distances.size()});
+    for (std::size_t i = 0; i < latitudes_a.size(); ++i) {
+        const Geographic origin(latitudes_a[i], longitudes_a[i], 0.0);
+        const std::span<double> row = distances.subspan(i * size_b, size_b);
+        if (formula == DistanceFormula::VINCENTY) {
+            VincentyDistances(origin, latitudes_b, longitudes_b, row);
+        } else {
+            HaversineDistances(origin, latitudes_b, longitudes_b, row);
+        }
+    }
+}
+
+std::vector<std::size_t> GeodeticCalculator::FindWithinDistance(const Geographic& center,
+                                                                 double radius,
+                                                                 std::span<const double> latitudes,
+                                                                 std::span<const double> longitudes,
+                                                                 DistanceFormula formula) {
+    RequireSameSizes(latitudes.size(), {longitudes.size()});
+    const double filter_radius =
+        formula == DistanceFormula::VINCENTY ? radius * kVincentyFilterMargin : radius;
+    const BoundingBox2D box = GeographicBounds::FromCenterRadius(center, filter_radius);
+    const auto in_box = [&box](double lat, double lon) {
+        if (lat < box.min.y || lat > box.max.y) {
+            return false;
+        }
+        // The box may extend past the antimeridian
+        return (lon >= box.min.x && lon <= box.max.x) ||
+               (lon + 360.0 >= box.min.x && lon + 360.0 <= box.max.x) ||
+               (lon - 360.0 >= box.min.x && lon - 360.0 <= box.max.x);
+    };
+
+    std::vector<std::size_t> candidates;
+    std::vector<double> candidate_lats;
+    std::vector<double> candidate_lons;
+    for (std::size_t i = 0; i < latitudes.size(); ++i) {
+        if (in_box(latitudes[i], longitudes[i])) {
+            candidates.push_back(i);
+            candidate_lats.push_back(latitudes[i]);
+            candidate_lons.push_back(longitudes[i]);
+        }
+    }
+
+    std::vector<double> distances(candidates.size());
+    if (formula == DistanceFormula::VINCENTY) {
+        VincentyDistances(center, candidate_lats, candidate_lons, distances);
+    } else {
+        HaversineDistances(center, candidate_lats, candidate_lons, distances);
+    }
+
+    std::vector<std::size_t> within;
+    for (std::size_t k = 0; k < candidates.size(); ++k) {
+        if (distances[k] <= radius) {
+            within.push_back(candidates[k]);
+        }
+    }
+    return within;
+}
+
 // GeographicBounds implementation
 
 BoundingBox2D GeographicBounds::FromCenterRadius(const Geographic& center, double radius) {
-    const Geographic north = GeodeticCalculator::GeodeticCalculator::DestinationPoint(center, 0.0, radius);
-    const Geographic south = GeodeticCalculator::GeodeticCalculator::DestinationPoint(center, 180.0, radius);
-    const Geographic east = GeodeticCalculator::GeodeticCalculator::DestinationPoint(center, 90.0, radius);
-    const Geographic west = GeodeticCalculator::GeodeticCalculator::DestinationPoint(center, 270.0, radius);
-    
+    // Bearings 90 and 270 do not reach the circle's widest longitudes, so
+    // the longitude extent comes from the tangent meridians instead
+    const double angular_radius = radius / WGS84_SEMI_MAJOR_AXIS;
+    const double angular_radius_deg = RadiansToDegrees(angular_radius);
+    const double min_lat = center.latitude - angular_radius_deg;
+    const double max_lat = center.latitude + angular_radius_deg;
+    if (min_lat <= -90.0 || max_lat >= 90.0) {
+        return BoundingBox2D(
+            glm::dvec2(-180.0, std::max(min_lat, -90.0)),
+            glm::dvec2(180.0, std::min(max_lat, 90.0))
+        );
+    }
+
+    const double half_width = RadiansToDegrees(
+        std::asin(std::sin(angular_radius) / std::cos(DegreesToRadians(center.latitude))));
     return BoundingBox2D(
-        glm::dvec2(west.longitude, south.latitude),
-        glm::dvec2(east.longitude, north.latitude)
+        glm::dvec2(center.longitude - half_width, min_lat),
+        glm::dvec2(center.longitude + half_width, max_lat)
     );
 }
 
@@ -372,10 +726,18 @@ BoundingBox2D GeographicBounds::FromProjected(const BoundingBox2D& proj_bounds,
 // GeodeticPath implementation (simplified versions for now)
 
 std::vector<Geographic> GeodeticPath::Simplify(const std::vector<Geographic>& points,
-                                                           double /*tolerance*/) {
-    // Simplified implementation - just return original points
-    // Full Douglas-Peucker algorithm would be implemented here
-    return points;
+                                                           double tolerance) {
+    if (points.size() < 3) return points;
+
+    std::vector<uint32_t> indices;
+    PolylineLod(points).Extract(tolerance, indices);
+
+    std::vector<Geographic> simplified;
+    simplified.reserve(indices.size());
+    for (const uint32_t index : indices) {
+        simplified.push_back(points[index]);
+    }
+    return simplified;
 }
 
 double GeodeticPath::CalculateLength(const std::vector<Geographic>& points) {
@@ -509,14 +871,33 @@ double TerrainCalculator::CalculateAspect(const Geographic& /*center*/,
 
 bool TerrainCalculator::LineOfSight(const Geographic& observer,
                                     const Geographic& target,
-                                    const std::vector<double>& /*terrain_heights*/) {
-    // Simplified line of sight check
-    // Full implementation would check intermediate terrain heights
+                                    const std::vector<double>& terrain_heights) {
     const double distance = GeodeticCalculator::HaversineDistance(observer, target);
     const double vertical_diff = target.altitude - observer.altitude;
-    const double angle = std::atan(vertical_diff / distance);
-    
-    return angle > -0.1;  // Simple threshold check
+
+    if (terrain_heights.empty()) {
+        // No profile: only reject steeply descending sight lines
+        const double angle = std::atan(vertical_diff / distance);
+        return angle > -0.1;
+    }
+
+    // Profile samples are evenly spaced strictly between the endpoints; the
+    // earth's curvature (with standard refraction) lowers them with distance
+    // from the observer, and any sample above the sight line blocks it.
+    // Raster viewsheds over elevation data: see terrain_viewshed.h
+    constexpr double kEffectiveEarthRadius = 6371008.8 / (1.0 - 0.13);
+    const double target_drop = distance * distance / (2.0 * kEffectiveEarthRadius);
+    const double target_slope = (vertical_diff - target_drop) / distance;
+    const double spacing = distance / static_cast<double>(terrain_heights.size() + 1);
+    for (size_t i = 0; i < terrain_heights.size(); ++i) {
+        const double sample_distance = spacing * static_cast<double>(i + 1);
+        const double drop = sample_distance * sample_distance / (2.0 * kEffectiveEarthRadius);
+        const double rise = terrain_heights[i] - observer.altitude - drop;
+        if (rise > target_slope * sample_distance) {
+            return false;
+        }
+    }
+    return true;
 }
 
 std::vector<Geographic> TerrainCalculator::CalculateViewshed(const Geographic& observer,
@@ -0,0 +1,313 @@
+/**
+ * @file packed_hilbert_rtree.cpp
+ * @brief Packed Hilbert R-tree implementation
+ */
+
+#include "earth_map/math/packed_hilbert_rtree.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace earth_map {
+
+namespace {
+
+/// Bits per axis of the Hilbert keys items are sorted by
+constexpr std::uint32_t kHilbertBits = 16;
+
+/// Frustum classification of a box: -1 outside, 0 intersecting, 1 inside
+int Classify(const std::array<Plane, Frustum::COUNT>& planes, const BoundingBox& box) {
+    int result = 1;
+    for (const Plane& plane : planes) {
+        // Box corners farthest along and against the plane normal
+        const glm::vec3 positive(plane.normal.x >= 0.0f ? box.max.x : box.min.x,
+                                 plane.normal.y >= 0.0f ? box.max.y : box.min.y,
+                                 plane.normal.z >= 0.0f ? box.max.z : box.min.z);
+        if (plane.DistanceTo(positive) < 0.0f) {
+            return -1;
+        }
+        const glm::vec3 negative(plane.normal.x >= 0.0f ? box.min.x : box.max.x,
+                                 plane.normal.y >= 0.0f ? box.min.y : box.max.y,
+                                 plane.normal.z >= 0.0f ? box.min.z : box.max.z);
+        if (plane.DistanceTo(negative) < 0.0f) {
+            result = 0;
+        }
+    }
+    return result;
+}
+
+/// Distance along the ray at which it enters a box, if it does
+std::optional<float> RayEnter(const glm::vec3& origin, const glm::vec3& inverse_direction,
+                              const BoundingBox& box, float max_distance) {
+    float enter = 0.0f;
+    float exit = max_distance;
+    for (int axis = 0; axis < 3; ++axis) {
+        const float t0 = (box.min[axis] - origin[axis]) * inverse_direction[axis];
+        const float t1 = (box.max[axis] - origin[axis]) * inverse_direction[axis];
+        // NaN (origin on a slab plane of a parallel ray) keeps the current bounds
+        enter = std::max(enter, std::min(t0, t1));
+        exit = std::min(exit, std::max(t0, t1));
+        if (enter > exit) {
+            return std::nullopt;
+        }
+    }
+    return enter;
+}
+
+/// Spread the low 21 bits of @p value to every third bit
+std::uint64_t SpreadBits(std::uint32_t value) {
+    std::uint64_t bits = value & 0x1FFFFFu;
+    bits = (bits | (bits << 32)) & 0x001F00000000FFFFull;
+    bits = (bits | (bits << 16)) & 0x001F0000FF0000FFull;
+    bits = (bits | (bits << 8)) & 0x100F00F00F00F00Full;
+    bits = (bits | (bits << 4)) & 0x10C30C30C30C30C3ull;
+    bits = (bits | (bits << 2)) & 0x1249249249249249ull;
+    return bits;
+}
+
+} // namespace
+
+std::uint64_t PackedHilbertRTree::HilbertIndex(std::uint32_t x, std::uint32_t y, std::uint32_t z,
+                                               std::uint32_t bits) {
+    // Skilling, "Programming the Hilbert curve" (2004): axes to transposed index
+    std::uint32_t axes[3] = {x, y, z};
+    const std::uint32_t top = 1u << (bits - 1);
+    for (std::uint32_t q = top; q > 1; q >>= 1) {
+        const std::uint32_t p = q - 1;
+        for (std::uint32_t& axis : axes) {
+            // Bit set: invert the low bits of axis 0; clear: exchange them with this axis
+            const std::uint32_t set = 0u - static_cast<std::uint32_t>((axis & q) != 0);
+            const std::uint32_t t = (axes[0] ^ axis) & p & ~set;
+            axes[0] ^= (p & set) | t;
+            axis ^= t;
+        }
+    }
+    axes[1] ^= axes[0];
+    axes[2] ^= axes[1];
+    std::uint32_t t = 0;
+    for (std::uint32_t q = top; q > 1; q >>= 1) {
+        t ^= (q - 1) & (0u - static_cast<std::uint32_t>((axes[2] & q) != 0));
+    }
+    return (SpreadBits(axes[0] ^ t) << 2) | (SpreadBits(axes[1] ^ t) << 1) | SpreadBits(axes[2] ^ t);
+}
+
+std::optional<float> PackedHilbertRTree::PickDistance(const BoundingBox& box,
+                                                     const glm::vec3& origin,
+                                                     const glm::vec3& direction, float radius) {
+    // Closest approach to the box center, then distance from there to the box
+    const float distance = std::max(0.0f, glm::dot(box.GetCenter() - origin, direction));
+    const glm::vec3 closest = origin + direction * distance;
+    const glm::vec3 offset = closest - glm::clamp(closest, box.min, box.max);
+    if (glm::dot(offset, offset) > radius * radius) {
+        return std::nullopt;
+    }
+    return distance;
+}
+
+PackedHilbertRTree::PackedHilbertRTree(std::span<const BoundingBox> boxes, std::uint32_t node_size)
+    : item_count_(boxes.size()), node_size_(std::max<std::uint32_t>(node_size, 2)) {
+    if (boxes.empty()) {
+        return;
+    }
+    if (boxes.size() > std::numeric_limits<std::uint32_t>::max() / 2) {
+        throw std::invalid_argument("PackedHilbertRTree supports up to 2^31 items");
+    }
+
+    // Sort by the Hilbert index of the box centers on a grid over their extent
+    BoundingBox center_bounds;
+    for (const BoundingBox& box : boxes) {
+        center_bounds.Enclose(box.GetCenter());
+    }
+    const float cells = static_cast<float>((1u << kHilbertBits) - 1);
+    const glm::vec3 extent = center_bounds.max - center_bounds.min;
+    glm::vec3 scale(0.0f);
+    for (int axis = 0; axis < 3; ++axis) {
+        if (extent[axis] > 0.0f) {
+            scale[axis] = cells / extent[axis];
+        }
+    }
+
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> order(boxes.size());
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        const glm::vec3 cell = (boxes[i].GetCenter() - center_bounds.min) * scale;
+        order[i] = {HilbertIndex(static_cast<std::uint32_t>(cell.x),
+                                 static_cast<std::uint32_t>(cell.y),
+                                 static_cast<std::uint32_t>(cell.z), kHilbertBits),
+                    static_cast<std::uint32_t>(i)};
+    }
+    std::sort(order.begin(), order.end());
+
+    std::size_t total = boxes.size();
+    for (std::size_t level = boxes.size(); level > 1;) {
+        level = (level + node_size_ - 1) / node_size_;
+        total += level;
+    }
+    boxes_.reserve(total);
+    indices_.reserve(total);
+    for (const auto& [key, item] : order) {
+        boxes_.push_back(boxes[item]);
+        indices_.push_back(item);
+    }
+    level_ends_.push_back(boxes_.size());
+
+    // Pack each level into full parents, bottom-up
+    std::size_t begin = 0;
+    while (boxes_.size() - begin > 1) {
+        const std::size_t end = boxes_.size();
+        for (std::size_t first = begin; first < end; first += node_size_) {
+            BoundingBox node;
+            const std::size_t last = std::min<std::size_t>(first + node_size_, end);
+            for (std::size_t child = first; child < last; ++child) {
+                node.Enclose(boxes_[child]);
+            }
+            boxes_.push_back(node);
+            indices_.push_back(static_cast<std::uint32_t>(first));
+        }
+        begin = end;
+        level_ends_.push_back(boxes_.size());
+    }
+}
+
+std::size_t PackedHilbertRTree::GetMemoryUsage() const {
+    return boxes_.capacity() * sizeof(BoundingBox) +
+           indices_.capacity() * sizeof(std::uint32_t) +
+           level_ends_.capacity() * sizeof(std::size_t);
+}
+
+std::pair<std::size_t, std::size_t> PackedHilbertRTree::Children(std::size_t node,
+                                                                 std::size_t level) const {
+    const std::size_t first = indices_[node];
+    return {first, std::min<std::size_t>(first + node_size_, level_ends_[level - 1])};
+}
+
+std::size_t PackedHilbertRTree::StackCapacity() const {
+    // Depth-first: at most one node's children pending per level
+    return level_ends_.size() * node_size_ + 1;
+}
+
+void PackedHilbertRTree::Query(const BoundingBox& box, std::vector<std::uint32_t>& items) const {
+    if (boxes_.empty()) {
+        return;
+    }
+    std::vector<std::pair<std::size_t, std::size_t>> stack;
+    stack.reserve(StackCapacity());
+    stack.emplace_back(boxes_.size() - 1, level_ends_.size() - 1);
+    while (!stack.empty()) {
+        const auto [node, level] = stack.back();
+        stack.pop_back();
+        if (!boxes_[node].Intersects(box)) {
+            continue;
+        }
+        if (level == 0) {
+            items.push_back(indices_[node]);
+            continue;
+        }
+        const auto [first, last] = Children(node, level);
+        for (std::size_t child = first; child < last; ++child) {
+            stack.emplace_back(child, level - 1);
+        }
+    }
+}
+
+void PackedHilbertRTree::Query(const Frustum& frustum, std::vector<std::uint32_t>& items) const {
+    if (boxes_.empty()) {
+        return;
+    }
+    struct Entry {
+        std::size_t node;
+        std::size_t level;
+        bool inside;  ///< Parent inside the frustum: no test needed
+    };
+    const std::array<Plane, Frustum::COUNT>& planes = frustum.GetPlanes();
+    std::vector<Entry> stack;
+    stack.reserve(StackCapacity());
+    stack.push_back({boxes_.size() - 1, level_ends_.size() - 1, false});
+    while (!stack.empty()) {
+        const Entry entry = stack.back();
+        stack.pop_back();
+        bool inside = entry.inside;
+        if (!inside) {
+            const int classification = Classify(planes, boxes_[entry.node]);
+            if (classification < 0) {
+                continue;
+            }
+            inside = classification > 0;
+        }
+        if (entry.level == 0) {
+            items.push_back(indices_[entry.node]);
+            continue;
+        }
+        const auto [first, last] = Children(entry.node, entry.level);
+        if (inside && entry.level == 1) {
+            for (std::size_t child = first; child < last; ++child) {
+                items.push_back(indices_[child]);
+            }
+            continue;
+        }
+        for (std::size_t child = first; child < last; ++child) {
+            stack.push_back({child, entry.level - 1, inside});
+        }
+    }
+}
+
+std::optional<RayHit> PackedHilbertRTree::Pick(
+    const glm::vec3& origin, const glm::vec3& direction, float radius,
+    const std::function<bool(std::uint32_t)>& accept, float max_distance) const {
+    if (boxes_.empty()) {
+        return std::nullopt;
+    }
+    const glm::vec3 inverse_direction(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+    const glm::vec3 margin(radius);
+
+    // Nearest-first: children are pushed farthest first, with their entry distance
+    struct Entry {
+        std::size_t node;
+        std::size_t level;
+        float enter;
+    };
+    std::optional<RayHit> best;
+    float best_distance = max_distance;
+    std::vector<Entry> stack;
+    stack.reserve(StackCapacity());
+    std::vector<Entry> children;
+    children.reserve(node_size_);
+    stack.push_back({boxes_.size() - 1, level_ends_.size() - 1, 0.0f});
+    while (!stack.empty()) {
+        const Entry entry = stack.back();
+        stack.pop_back();
+        if (entry.enter >= best_distance) {
+            continue;
+        }
+        const BoundingBox& box = boxes_[entry.node];
+        if (entry.level > 0) {
+            const auto [first, last] = Children(entry.node, entry.level);
+            children.clear();
+            for (std::size_t child = first; child < last; ++child) {
+                // Boxes grown by the radius hold every point within it of the box
+                const BoundingBox grown(boxes_[child].min - margin, boxes_[child].max + margin);
+                if (const auto enter = RayEnter(origin, inverse_direction, grown, best_distance)) {
+                    children.push_back({child, entry.level - 1, *enter});
+                }
+            }
+            std::sort(children.begin(), children.end(),
+                      [](const Entry& a, const Entry& b) { return a.enter > b.enter; });
+            stack.insert(stack.end(), children.begin(), children.end());
+            continue;
+        }
+
+        const std::optional<float> distance = PickDistance(box, origin, direction, radius);
+        if (!distance || *distance >= best_distance) {
+            continue;
+        }
+        const std::uint32_t item = indices_[entry.node];
+        if (accept && !accept(item)) {
+            continue;
+        }
+        best = RayHit{item, *distance};
+        best_distance = *distance;
+    }
+    return best;
+}
+
+} // namespace earth_map
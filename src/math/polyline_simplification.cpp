@@ -0,0 +1,374 @@
+/**
+ * @file polyline_simplification.cpp
+ * @brief Multi-LOD polyline simplification implementation
+ */
+
+#include "earth_map/math/polyline_simplification.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+namespace earth_map {
+
+namespace {
+
+/// Sphere radius of GeodeticCalculator::HaversineDistance (WGS84 semi-major axis)
+constexpr double kEarthRadius = 6378137.0;
+
+/// Smallest squared normal of a chord treated as a great circle
+constexpr double kDegenerateChord = 1e-24;
+
+struct Vector {
+    double x;
+    double y;
+    double z;
+};
+
+inline Vector Sub(const Vector& a, const Vector& b) {
+    return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+
+inline double Dot(const Vector& a, const Vector& b) {
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+inline Vector Cross(const Vector& a, const Vector& b) {
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+std::vector<Vector> ToUnitVectors(const std::vector<coordinates::Geographic>& points) {
+    std::vector<Vector> result;
+    result.reserve(points.size());
+    for (const auto& point : points) {
+        const double lat = point.latitude * M_PI / 180.0;
+        const double lon = point.longitude * M_PI / 180.0;
+        result.push_back({std::cos(lat) * std::cos(lon), std::cos(lat) * std::sin(lon),
+                          std::sin(lat)});
+    }
+    return result;
+}
+
+/**
+ * @brief Monotone proxy of an angle: sin² up to 90°, 2 - sin² beyond
+ *
+ * Lets the Douglas-Peucker scan compare distances without inverse trig.
+ */
+inline double AngleProxy(double cos_angle, double sin_squared) {
+    return cos_angle >= 0.0 ? sin_squared : 2.0 - sin_squared;
+}
+
+inline double ProxyToMeters(double proxy) {
+    if (proxy <= 1.0) {
+        return std::asin(std::sqrt(std::max(proxy, 0.0))) * kEarthRadius;
+    }
+    return (M_PI - std::asin(std::sqrt(std::max(2.0 - proxy, 0.0)))) * kEarthRadius;
+}
+
+/**
+ * @brief Douglas-Peucker significance of every vertex, over an explicit stack
+ */
+void RankDouglasPeucker(const std::vector<Vector>& points, std::vector<float>& significance) {
+    struct Range {
+        uint32_t first;
+        uint32_t last;
+        float bound;  ///< Significance of the split that made the range
+    };
+
+    std::vector<Range> stack;
+    stack.push_back({0, static_cast<uint32_t>(points.size() - 1),
+                     std::numeric_limits<float>::infinity()});
+    while (!stack.empty()) {
+        const Range range = stack.back();
+        stack.pop_back();
+        if (range.last - range.first < 2) {
+            continue;
+        }
+
+        const Vector& a = points[range.first];
+        const Vector& b = points[range.last];
+        Vector normal = Cross(a, b);
+        const double normal_squared = Dot(normal, normal);
+        const bool arc = normal_squared > kDegenerateChord;
+        Vector toward_b{};
+        Vector toward_a{};
+        if (arc) {
+            const double scale = 1.0 / std::sqrt(normal_squared);
+            normal = {normal.x * scale, normal.y * scale, normal.z * scale};
+            toward_b = Cross(normal, a);  // Tangent at a, along the arc
+            toward_a = Cross(b, normal);  // Tangent at b, back along the arc
+        }
+
+        // Cross-track distance where the vertex projects onto the arc,
+        // otherwise the distance to the nearer endpoint
+        double best = -1.0;
+        uint32_t split = range.first + 1;
+        for (uint32_t i = range.first + 1; i < range.last; ++i) {
+            const Vector& p = points[i];
+            double proxy;
+            if (arc && Dot(p, toward_b) >= 0.0 && Dot(p, toward_a) >= 0.0) {
+                const double s = Dot(p, normal);
+                proxy = s * s;
+            } else {
+                const Vector da = Sub(p, a);
+                const Vector db = Sub(p, b);
+                const double chord_squared = std::min(Dot(da, da), Dot(db, db));
+                const double cos_angle = 1.0 - 0.5 * chord_squared;
+                proxy = AngleProxy(cos_angle, 1.0 - cos_angle * cos_angle);
+            }
+            if (proxy > best) {
+                best = proxy;
+                split = i;
+            }
+        }
+
+        const float value = std::min(static_cast<float>(ProxyToMeters(best)), range.bound);
+        significance[split] = value;
+        stack.push_back({range.first, split, value});
+        stack.push_back({split, range.last, value});
+    }
+}
+
+/**
+ * @brief Binary min-heap of vertices keyed by value, with in-place key updates
+ *
+ * Values live in the heap entries so sifting does not chase vertex indices.
+ */
+class VertexHeap {
+public:
+    explicit VertexHeap(size_t count) : slot_(count) {}
+
+    bool Empty() const { return heap_.empty(); }
+    uint32_t Top() const { return heap_.front().vertex; }
+    double TopValue() const { return heap_.front().value; }
+
+    void Push(uint32_t vertex, double value) {
+        slot_[vertex] = static_cast<uint32_t>(heap_.size());
+        heap_.push_back({value, vertex});
+    }
+
+    /// Restore heap order after the Push calls
+    void Build() {
+        for (size_t i = heap_.size() / 2; i-- > 0;) {
+            SiftDown(i);
+        }
+    }
+
+    void Pop() {
+        const Entry last = heap_.back();
+        heap_.pop_back();
+        if (!heap_.empty()) {
+            heap_.front() = last;
+            SiftDown(0);
+        }
+    }
+
+    void Update(uint32_t vertex, double value) {
+        const size_t i = slot_[vertex];
+        const double old = heap_[i].value;
+        heap_[i].value = value;
+        if (value < old) {
+            SiftUp(i);
+        } else {
+            SiftDown(i);
+        }
+    }
+
+private:
+    struct Entry {
+        double value;
+        uint32_t vertex;
+    };
+
+    void Place(size_t i, const Entry& entry) {
+        heap_[i] = entry;
+        slot_[entry.vertex] = static_cast<uint32_t>(i);
+    }
+
+    void SiftUp(size_t i) {
+        const Entry entry = heap_[i];
+        while (i > 0) {
+            const size_t parent = (i - 1) / 2;
+            if (heap_[parent].value <= entry.value) {
+                break;
+            }
+            Place(i, heap_[parent]);
+            i = parent;
+        }
+        Place(i, entry);
+    }
+
+    void SiftDown(size_t i) {
+        const Entry entry = heap_[i];
+        const size_t size = heap_.size();
+        while (true) {
+            size_t child = 2 * i + 1;
+            if (child >= size) {
+                break;
+            }
+            if (child + 1 < size && heap_[child + 1].value < heap_[child].value) {
+                ++child;
+            }
+            if (entry.value <= heap_[child].value) {
+                break;
+            }
+            Place(i, heap_[child]);
+            i = child;
+        }
+        Place(i, entry);
+    }
+
+    std::vector<Entry> heap_;
+    std::vector<uint32_t> slot_;  ///< Heap position of each vertex
+};
+
+/**
+ * @brief Visvalingam-Whyatt significance of every vertex, over a min-heap
+ */
+void RankVisvalingam(const std::vector<Vector>& points, std::vector<float>& significance) {
+    const auto count = static_cast<uint32_t>(points.size());
+    std::vector<uint32_t> prev(count);
+    std::vector<uint32_t> next(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        prev[i] = i - 1;
+        next[i] = i + 1;
+    }
+
+    // Square root of the triangle area in square meters
+    const auto effective = [&](uint32_t i) {
+        const Vector& a = points[prev[i]];
+        const Vector& c = points[next[i]];
+        const Vector n = Cross(Sub(points[i], a), Sub(c, a));
+        return std::sqrt(0.5 * std::sqrt(Dot(n, n))) * kEarthRadius;
+    };
+
+    VertexHeap heap(count);
+    for (uint32_t i = 1; i + 1 < count; ++i) {
+        heap.Push(i, effective(i));
+    }
+    heap.Build();
+
+    // Removal values never decrease, so keeping the vertices above a
+    // tolerance reproduces the elimination stopped at that tolerance
+    double removed = 0.0;
+    while (!heap.Empty()) {
+        const uint32_t vertex = heap.Top();
+        removed = std::max(removed, heap.TopValue());
+        significance[vertex] = static_cast<float>(removed);
+        heap.Pop();
+
+        const uint32_t before = prev[vertex];
+        const uint32_t after = next[vertex];
+        next[before] = after;
+        prev[after] = before;
+        for (const uint32_t neighbor : {before, after}) {
+            if (neighbor != 0 && neighbor + 1 != count) {
+                heap.Update(neighbor, effective(neighbor));
+            }
+        }
+    }
+}
+
+} // namespace
+
+PolylineLod::PolylineLod(const std::vector<coordinates::Geographic>& points,
+                         SimplificationMethod method)
+    : method_(method) {
+    if (points.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument("PolylineLod supports at most 2^32 - 1 vertices");
+    }
+    const size_t count = points.size();
+    significance_.assign(count, 0.0f);
+    if (count == 0) {
+        return;
+    }
+    significance_.front() = std::numeric_limits<float>::infinity();
+    significance_.back() = std::numeric_limits<float>::infinity();
+
+    if (count > 2) {
+        const std::vector<Vector> unit = ToUnitVectors(points);
+        if (method == SimplificationMethod::DouglasPeucker) {
+            RankDouglasPeucker(unit, significance_);
+        } else {
+            RankVisvalingam(unit, significance_);
+        }
+    }
+
+    ranked_ = significance_;
+    std::sort(ranked_.begin(), ranked_.end(), std::greater<>());
+
+    // Index lists of the top half, quarter, ... in path order (ties included)
+    for (size_t target = count / 2; target >= 4; target /= 2) {
+        const float threshold = ranked_[target - 1];
+        std::vector<uint32_t> level;
+        level.reserve(target);
+        for (uint32_t i = 0; i < count; ++i) {
+            if (significance_[i] >= threshold) {
+                level.push_back(i);
+            }
+        }
+        levels_.push_back(std::move(level));
+    }
+}
+
+size_t PolylineLod::CountVertices(double tolerance) const noexcept {
+    tolerance = std::min(tolerance, std::numeric_limits<double>::max());
+    const auto end = std::partition_point(ranked_.begin(), ranked_.end(),
+                                          [tolerance](float value) { return value > tolerance; });
+    return static_cast<size_t>(end - ranked_.begin());
+}
+
+void PolylineLod::Extract(double tolerance, std::vector<uint32_t>& indices) const {
+    indices.clear();
+    const size_t count = significance_.size();
+    if (tolerance < 0.0) {
+        indices.resize(count);
+        std::iota(indices.begin(), indices.end(), 0u);
+        return;
+    }
+    tolerance = std::min(tolerance, std::numeric_limits<double>::max());
+
+    // Filter the smallest index list holding every kept vertex
+    const size_t kept = CountVertices(tolerance);
+    indices.reserve(kept);
+    const std::vector<uint32_t>* source = nullptr;
+    for (auto level = levels_.rbegin(); level != levels_.rend(); ++level) {
+        if (level->size() >= kept) {
+            source = &*level;
+            break;
+        }
+    }
+    if (source != nullptr) {
+        for (const uint32_t i : *source) {
+            if (significance_[i] > tolerance) {
+                indices.push_back(i);
+            }
+        }
+    } else {
+        for (uint32_t i = 0; i < count; ++i) {
+            if (significance_[i] > tolerance) {
+                indices.push_back(i);
+            }
+        }
+    }
+}
+
+double PolylineLod::GetToleranceForBudget(size_t max_vertices) const noexcept {
+    max_vertices = std::max<size_t>(max_vertices, 2);
+    if (max_vertices >= ranked_.size()) {
+        return -1.0;
+    }
+    return static_cast<double>(ranked_[max_vertices]);
+}
+
+size_t PolylineLod::GetMemoryUsage() const noexcept {
+    size_t bytes = (significance_.capacity() + ranked_.capacity()) * sizeof(float);
+    for (const auto& level : levels_) {
+        bytes += level.capacity() * sizeof(uint32_t);
+    }
+    return bytes;
+}
+
+} // namespace earth_map
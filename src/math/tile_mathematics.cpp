@@ -23,81 +23,30 @@ namespace {
 
 // QuadtreeKey implementation
 
-QuadtreeKey::QuadtreeKey(const TileCoordinates& tile) {
-    if (!TileValidator::IsValidTile(tile)) {
-        key = "";
+QuadtreeKey::QuadtreeKey(std::string_view quadkey) {
+    if (quadkey.size() > 30) {
         return;
     }
-    
-    key = "";
-    int32_t x = tile.x;
-    int32_t y = tile.y;
-    int32_t zoom = tile.zoom;
-    
-    for (int32_t i = zoom - 1; i >= 0; --i) {
-        int32_t digit = 0;
-        const int32_t mask = 1 << i;
-        
-        if ((x & mask) != 0) digit |= 1;
-        if ((y & mask) != 0) digit |= 2;
-        
-        key += std::to_string(digit);
+    std::uint64_t packed = 1;
+    for (const char digit : quadkey) {
+        if (digit < '0' || digit > '3') {
+            return;  // Invalid quadtree key
+        }
+        packed = (packed << 2) | static_cast<std::uint64_t>(digit - '0');
     }
+    code = packed;
 }
 
-QuadtreeKey::QuadtreeKey(const std::string& quadkey) : key(quadkey) {
-    // Validation will be done in IsValid()
-}
-
-TileCoordinates QuadtreeKey::ToTileCoordinates() const {
+std::string QuadtreeKey::ToString() const {
     if (!IsValid()) {
-        return TileCoordinates();
+        return std::string();
     }
-    
-    int32_t x = 0;
-    int32_t y = 0;
-    const int32_t zoom = static_cast<int32_t>(key.length());
-    
-    for (int32_t i = 0; i < zoom; ++i) {
-        const int digit = key[i] - '0';
-        if (digit < 0 || digit > 3) {
-            return TileCoordinates();  // Invalid quadtree key
-        }
-        
-        x <<= 1;
-        y <<= 1;
-        
-        if ((digit & 1) != 0) x |= 1;
-        if ((digit & 2) != 0) y |= 1;
+    std::string key(static_cast<std::size_t>(GetZoom()), '0');
+    std::uint64_t digits = code;
+    for (auto it = key.rbegin(); it != key.rend(); ++it, digits >>= 2) {
+        *it = static_cast<char>('0' + (digits & 3u));
     }
-    
-    return TileCoordinates(x, y, zoom);
-}
-
-QuadtreeKey QuadtreeKey::GetParent() const {
-    if (key.empty()) return QuadtreeKey();
-    return QuadtreeKey(key.substr(0, key.length() - 1));
-}
-
-std::array<QuadtreeKey, 4> QuadtreeKey::GetChildren() const {
-    const std::string base_key = key;
-    return {
-        QuadtreeKey(base_key + "0"),
-        QuadtreeKey(base_key + "1"),
-        QuadtreeKey(base_key + "2"),
-        QuadtreeKey(base_key + "3")
-    };
-}
-
-bool QuadtreeKey::IsValid() const {
-    if (key.empty()) return false;
-    
-    for (char c : key) {
-        if (c < '0' || c > '3') return false;
-    }
-    
-    const int32_t zoom = static_cast<int32_t>(key.length());
-    return TileValidator::IsSupportedZoom(zoom);
+    return key;
 }
 
 // TileMathematics implementation
@@ -0,0 +1,369 @@
+#include "earth_map/math/vector_math.h"
+#include <bit>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define EARTH_MAP_VECTOR_MATH_X86 1
+#include <immintrin.h>
+#endif
+
+namespace earth_map {
+
+namespace {
+
+// Cody-Waite split of pi/2: the first two parts have 33 significant bits,
+// so q * part is exact for |q| < 2^20
+constexpr double kTwoOverPi = 6.36619772367581382433e-01;
+constexpr double kPiOver2Hi = 1.57079632673412561417e+00;
+constexpr double kPiOver2Mid = 6.07710050630396597660e-11;
+constexpr double kPiOver2Lo = 2.02226624879595063154e-21;
+
+// Adding 1.5 * 2^52 rounds to an integer held in the low mantissa bits
+constexpr double kRoundShift = 6755399441055744.0;
+
+// fdlibm __kernel_sin / __kernel_cos
+constexpr double kS1 = -1.66666666666666324348e-01;
+constexpr double kS2 = 8.33333333332248946124e-03;
+constexpr double kS3 = -1.98412698298579493134e-04;
+constexpr double kS4 = 2.75573137070700676789e-06;
+constexpr double kS5 = -2.50507602534068634195e-08;
+constexpr double kS6 = 1.58969099521155010221e-10;
+constexpr double kC1 = 4.16666666666666019037e-02;
+constexpr double kC2 = -1.38888888888741095749e-03;
+constexpr double kC3 = 2.48015872894767294178e-05;
+constexpr double kC4 = -2.75573143513906633035e-07;
+constexpr double kC5 = 2.08757232129817482790e-09;
+constexpr double kC6 = -1.13596475577881948265e-11;
+
+// Cephes atan
+constexpr double kP0 = -8.750608600031904122785e-01;
+constexpr double kP1 = -1.615753718733365076637e+01;
+constexpr double kP2 = -7.500855792314704667340e+01;
+constexpr double kP3 = -1.228866684490136173410e+02;
+constexpr double kP4 = -6.485021904942025371773e+01;
+constexpr double kQ0 = 2.485846490142306297962e+01;
+constexpr double kQ1 = 1.650270098316988542046e+02;
+constexpr double kQ2 = 4.328810604912902668951e+02;
+constexpr double kQ3 = 4.853903996359136964868e+02;
+constexpr double kQ4 = 1.945506571482613964425e+02;
+constexpr double kAtanSplit = 0.66;
+constexpr double kPiOver4 = 7.85398163397448309616e-01;
+constexpr double kPiOver2 = 1.57079632679489661923e+00;
+constexpr double kPiOver2Tail = 6.12323399573676588613e-17;
+constexpr double kPi = 3.14159265358979311600e+00;
+constexpr double kPiTail = 1.22464679914735317723e-16;
+
+// fdlibm __ieee754_log
+constexpr double kLn2Hi = 6.93147180369123816490e-01;
+constexpr double kLn2Lo = 1.90821492927058770002e-10;
+constexpr double kLg1 = 6.666666666666735130e-01;
+constexpr double kLg2 = 3.999999999940941908e-01;
+constexpr double kLg3 = 2.857142874366239149e-01;
+constexpr double kLg4 = 2.222219843214978396e-01;
+constexpr double kLg5 = 1.818357216161805012e-01;
+constexpr double kLg6 = 1.531383769920937332e-01;
+constexpr double kLg7 = 1.479819860511658591e-01;
+constexpr double kSqrt2 = 1.41421356237309514547e+00;
+constexpr double kExponentBias = 1023.0;
+
+constexpr std::uint64_t kSignBit = 0x8000000000000000ull;
+constexpr std::uint64_t kMantissaBits = 0x000fffffffffffffull;
+constexpr std::uint64_t kOneExponent = 0x3ff0000000000000ull;
+
+/**
+ * @brief One double per lane; used for the remainder and on non-x86 builds
+ *
+ * Masks are doubles with all bits set or clear.
+ */
+struct ScalarLanes {
+    using V = double;
+    static constexpr std::size_t kWidth = 1;
+
+    static V Set(double v) { return v; }
+    static V Load(const double* p) { return *p; }
+    static void Store(double* p, V v) { *p = v; }
+
+    static std::uint64_t Bits(V v) { return std::bit_cast<std::uint64_t>(v); }
+    static V FromBits(std::uint64_t bits) { return std::bit_cast<double>(bits); }
+
+    static V And(V a, V b) { return FromBits(Bits(a) & Bits(b)); }
+    static V Xor(V a, V b) { return FromBits(Bits(a) ^ Bits(b)); }
+    static V Abs(V v) { return FromBits(Bits(v) & ~kSignBit); }
+    static V Min(V a, V b) { return a < b ? a : b; }
+    static V Max(V a, V b) { return a < b ? b : a; }
+    static V Less(V a, V b) { return FromBits(a < b ? ~0ull : 0ull); }
+    static V Select(V mask, V a, V b) {
+        return FromBits((Bits(mask) & Bits(a)) | (~Bits(mask) & Bits(b)));
+    }
+
+    /// Sign bit set where bit kBit of the shifted integer is set
+    template <int kBit>
+    static V BitToSign(V shifted) {
+        return FromBits(((Bits(shifted) >> kBit) & 1u) << 63);
+    }
+    /// All bits set where bit kBit of the shifted integer is set
+    template <int kBit>
+    static V BitToMask(V shifted) {
+        return FromBits(0u - ((Bits(shifted) >> kBit) & 1u));
+    }
+
+    /// Biased exponent of a positive normal value, as a double
+    static V Exponent(V v) { return static_cast<double>(Bits(v) >> 52); }
+    /// Significand scaled into [1, 2)
+    static V Significand(V v) { return FromBits((Bits(v) & kMantissaBits) | kOneExponent); }
+};
+
+#ifdef EARTH_MAP_VECTOR_MATH_X86
+
+/// Two doubles per SSE2 register; arithmetic uses the vector operators
+struct Sse2Lanes {
+    using V = __m128d;
+    static constexpr std::size_t kWidth = 2;
+
+    static V Set(double v) { return _mm_set1_pd(v); }
+    static V Load(const double* p) { return _mm_loadu_pd(p); }
+    static void Store(double* p, V v) { _mm_storeu_pd(p, v); }
+
+    static V And(V a, V b) { return _mm_and_pd(a, b); }
+    static V Xor(V a, V b) { return _mm_xor_pd(a, b); }
+    static V Abs(V v) { return _mm_andnot_pd(_mm_set1_pd(-0.0), v); }
+    static V Min(V a, V b) { return _mm_min_pd(a, b); }
+    static V Max(V a, V b) { return _mm_max_pd(a, b); }
+    static V Less(V a, V b) { return _mm_cmplt_pd(a, b); }
+    static V Select(V mask, V a, V b) {
+        return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+    }
+
+    template <int kBit>
+    static V BitToSign(V shifted) {
+        const __m128i bit = _mm_and_si128(_mm_castpd_si128(shifted), _mm_set1_epi64x(1ll << kBit));
+        return _mm_castsi128_pd(_mm_slli_epi64(bit, 63 - kBit));
+    }
+    template <int kBit>
+    static V BitToMask(V shifted) {
+        const __m128i bit = _mm_srli_epi64(
+            _mm_and_si128(_mm_castpd_si128(shifted), _mm_set1_epi64x(1ll << kBit)), kBit);
+        return _mm_castsi128_pd(_mm_sub_epi64(_mm_setzero_si128(), bit));
+    }
+
+    static V Exponent(V v) {
+        // The exponent field ORed into the mantissa of 2^52 converts exactly
+        const __m128i exponent = _mm_srli_epi64(_mm_castpd_si128(v), 52);
+        const __m128d shifted = _mm_castsi128_pd(
+            _mm_or_si128(exponent, _mm_set1_epi64x(0x4330000000000000ll)));
+        return shifted - _mm_set1_pd(4503599627370496.0);
+    }
+    static V Significand(V v) {
+        const __m128i bits = _mm_and_si128(_mm_castpd_si128(v),
+                                           _mm_set1_epi64x(static_cast<long long>(kMantissaBits)));
+        return _mm_castsi128_pd(
+            _mm_or_si128(bits, _mm_set1_epi64x(static_cast<long long>(kOneExponent))));
+    }
+};
+
+using WideLanes = Sse2Lanes;
+
+#else
+
+using WideLanes = ScalarLanes;
+
+#endif
+
+template <typename L>
+void SinCosLanes(typename L::V x, typename L::V& sin_x, typename L::V& cos_x) {
+    using V = typename L::V;
+    const V shift = L::Set(kRoundShift);
+    const V shifted = x * L::Set(kTwoOverPi) + shift;
+    const V q = shifted - shift;
+    V r = x - q * L::Set(kPiOver2Hi);
+    r = r - q * L::Set(kPiOver2Mid);
+    r = r - q * L::Set(kPiOver2Lo);
+
+    const V z = r * r;
+    const V sin_poly =
+        L::Set(kS2) +
+        z * (L::Set(kS3) + z * (L::Set(kS4) + z * (L::Set(kS5) + z * L::Set(kS6))));
+    const V sin_r = r + z * r * (L::Set(kS1) + z * sin_poly);
+
+    const V cos_poly =
+        z * (L::Set(kC1) +
+             z * (L::Set(kC2) +
+                  z * (L::Set(kC3) + z * (L::Set(kC4) + z * (L::Set(kC5) + z * L::Set(kC6))))));
+    const V one = L::Set(1.0);
+    const V half_z = L::Set(0.5) * z;
+    const V w = one - half_z;
+    const V cos_r = w + (((one - w) - half_z) + z * cos_poly);
+
+    // Quadrant q: odd swaps sin and cos; sin is negated in quadrants 2 and 3,
+    // cos in quadrants 1 and 2
+    const V swap = L::template BitToMask<0>(shifted);
+    sin_x = L::Xor(L::Select(swap, cos_r, sin_r), L::template BitToSign<1>(shifted));
+    cos_x = L::Xor(L::Select(swap, sin_r, cos_r), L::template BitToSign<1>(shifted + one));
+}
+
+template <typename L>
+typename L::V Atan2Lanes(typename L::V y, typename L::V x) {
+    using V = typename L::V;
+    const V ax = L::Abs(x);
+    const V ay = L::Abs(y);
+    const V swap = L::Less(ax, ay);
+    const V t = L::Min(ax, ay) / L::Max(ax, ay);
+
+    // atan(t) = pi/4 + atan((t - 1) / (t + 1)) above the split
+    const V one = L::Set(1.0);
+    const V upper = L::Less(L::Set(kAtanSplit), t);
+    const V u = L::Select(upper, (t - one) / (t + one), t);
+    const V z = u * u;
+    const V p = (((L::Set(kP0) * z + L::Set(kP1)) * z + L::Set(kP2)) * z + L::Set(kP3)) * z +
+                L::Set(kP4);
+    const V q = ((((z + L::Set(kQ0)) * z + L::Set(kQ1)) * z + L::Set(kQ2)) * z + L::Set(kQ3)) *
+                    z +
+                L::Set(kQ4);
+    V angle = u + u * (z * p / q);
+    angle = angle + L::And(upper, L::Set(0.5 * kPiOver2Tail));
+    angle = angle + L::And(upper, L::Set(kPiOver4));
+
+    // Undo the octant reduction: swap for |y| > |x|, reflect for x < 0
+    angle = L::Select(swap, (L::Set(kPiOver2) - angle) + L::Set(kPiOver2Tail), angle);
+    angle = L::Select(L::Less(x, L::Set(0.0)), (L::Set(kPi) - angle) + L::Set(kPiTail), angle);
+    return L::Xor(angle, L::And(y, L::Set(-0.0)));
+}
+
+template <typename L>
+typename L::V LogLanes(typename L::V x) {
+    using V = typename L::V;
+    const V one = L::Set(1.0);
+    V m = L::Significand(x);
+    V k = L::Exponent(x) - L::Set(kExponentBias);
+    const V high = L::Less(L::Set(kSqrt2), m);
+    m = L::Select(high, m * L::Set(0.5), m);
+    k = k + L::And(high, one);
+
+    const V f = m - one;
+    const V s = f / (L::Set(2.0) + f);
+    const V z = s * s;
+    const V w = z * z;
+    const V t1 = w * (L::Set(kLg2) + w * (L::Set(kLg4) + w * L::Set(kLg6)));
+    const V t2 = z * (L::Set(kLg1) + w * (L::Set(kLg3) + w * (L::Set(kLg5) + w * L::Set(kLg7))));
+    const V r = t2 + t1;
+    const V half_f2 = L::Set(0.5) * f * f;
+    return k * L::Set(kLn2Hi) - ((half_f2 - (s * (half_f2 + r) + k * L::Set(kLn2Lo))) - f);
+}
+
+bool SinCosInRange(double x) {
+    return std::abs(x) <= VectorMath::kMaxSinCosArgument;
+}
+
+bool Atan2InRange(double y, double x) {
+    return std::isfinite(x) && std::isfinite(y) && (x != 0.0 || y != 0.0);
+}
+
+bool LogInRange(double x) {
+    return x >= DBL_MIN && x <= DBL_MAX;
+}
+
+/**
+ * @brief Run a lane kernel over whole registers, then the remainder
+ *
+ * Each group of inputs is copied before its outputs are stored, so outputs
+ * may alias the inputs; out-of-range elements are redone with the fallback.
+ */
+template <typename L, typename Kernel, typename Fallback>
+void ForEachGroup(std::size_t count, const Kernel& kernel, const Fallback& fallback) {
+    std::size_t i = 0;
+    for (; i + L::kWidth <= count; i += L::kWidth) {
+        kernel.template operator()<L>(i, fallback);
+    }
+    for (; i < count; ++i) {
+        kernel.template operator()<ScalarLanes>(i, fallback);
+    }
+}
+
+void RequireSameSize(std::size_t a, std::size_t b, const char* what) {
+    if (a != b) {
+        throw std::invalid_argument(what);
+    }
+}
+
+} // namespace
+
+void VectorMath::SinCos(std::span<const double> x, std::span<double> sin_out,
+                        std::span<double> cos_out) {
+    RequireSameSize(x.size(), sin_out.size(), "VectorMath::SinCos: span sizes differ");
+    RequireSameSize(x.size(), cos_out.size(), "VectorMath::SinCos: span sizes differ");
+    const auto kernel = [&]<typename L>(std::size_t i, const auto& fallback) {
+        double in[L::kWidth];
+        for (std::size_t j = 0; j < L::kWidth; ++j) {
+            in[j] = x[i + j];
+        }
+        typename L::V s;
+        typename L::V c;
+        SinCosLanes<L>(L::Load(in), s, c);
+        L::Store(&sin_out[i], s);
+        L::Store(&cos_out[i], c);
+        for (std::size_t j = 0; j < L::kWidth; ++j) {
+            if (!SinCosInRange(in[j])) {
+                fallback(i + j, in[j]);
+            }
+        }
+    };
+    ForEachGroup<WideLanes>(x.size(), kernel, [&](std::size_t i, double value) {
+        sin_out[i] = std::sin(value);
+        cos_out[i] = std::cos(value);
+    });
+}
+
+void VectorMath::Atan2(std::span<const double> y, std::span<const double> x,
+                       std::span<double> out) {
+    RequireSameSize(y.size(), x.size(), "VectorMath::Atan2: span sizes differ");
+    RequireSameSize(y.size(), out.size(), "VectorMath::Atan2: span sizes differ");
+    const auto kernel = [&]<typename L>(std::size_t i, const auto& fallback) {
+        double in_y[L::kWidth];
+        double in_x[L::kWidth];
+        for (std::size_t j = 0; j < L::kWidth; ++j) {
+            in_y[j] = y[i + j];
+            in_x[j] = x[i + j];
+        }
+        L::Store(&out[i], Atan2Lanes<L>(L::Load(in_y), L::Load(in_x)));
+        for (std::size_t j = 0; j < L::kWidth; ++j) {
+            if (!Atan2InRange(in_y[j], in_x[j])) {
+                fallback(i + j, in_y[j], in_x[j]);
+            }
+        }
+    };
+    ForEachGroup<WideLanes>(y.size(), kernel, [&](std::size_t i, double in_y, double in_x) {
+        out[i] = std::atan2(in_y, in_x);
+    });
+}
+
+void VectorMath::Log(std::span<const double> x, std::span<double> out) {
+    RequireSameSize(x.size(), out.size(), "VectorMath::Log: span sizes differ");
+    const auto kernel = [&]<typename L>(std::size_t i, const auto& fallback) {
+        double in[L::kWidth];
+        for (std::size_t j = 0; j < L::kWidth; ++j) {
+            in[j] = x[i + j];
+        }
+        L::Store(&out[i], LogLanes<L>(L::Load(in)));
+        for (std::size_t j = 0; j < L::kWidth; ++j) {
+            if (!LogInRange(in[j])) {
+                fallback(i + j, in[j]);
+            }
+        }
+    };
+    ForEachGroup<WideLanes>(x.size(), kernel, [&](std::size_t i, double value) {
+        out[i] = std::log(value);
+    });
+}
+
+bool VectorMath::IsSimdAccelerated() {
+#ifdef EARTH_MAP_VECTOR_MATH_X86
+    return true;
+#else
+    return false;
+#endif
+}
+
+} // namespace earth_map
@@ -0,0 +1,253 @@
+/**
+ * @file egl_context.cpp
+ * @brief EGL-backed headless OpenGL contexts
+ */
+
+#include <earth_map/platform/opengl_context.h>
+#include <spdlog/spdlog.h>
+
+#ifdef EARTH_MAP_HAVE_EGL
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <cstring>
+#include <sstream>
+#include <utility>
+#include <vector>
+#endif
+
+namespace earth_map {
+
+#ifdef EARTH_MAP_HAVE_EGL
+
+namespace {
+
+bool HasExtension(const char* extensions, const char* name) {
+    if (extensions == nullptr) {
+        return false;
+    }
+    const std::size_t length = std::strlen(name);
+    for (const char* start = extensions; (start = std::strstr(start, name)) != nullptr;
+         start += length) {
+        const bool starts_word = start == extensions || start[-1] == ' ';
+        const bool ends_word = start[length] == ' ' || start[length] == '\0';
+        if (starts_word && ends_word) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Display for headless rendering: the surfaceless platform if the
+ *        client supports it (no X server or DRM master needed), else the default
+ */
+EGLDisplay OpenHeadlessDisplay() {
+    const char* client_extensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (HasExtension(client_extensions, "EGL_MESA_platform_surfaceless")) {
+        const auto get_platform_display = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (get_platform_display != nullptr) {
+            EGLDisplay display =
+                get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (display != EGL_NO_DISPLAY) {
+                return display;
+            }
+        }
+    }
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+/**
+ * @brief Headless EGL context, current through a pbuffer or no surface at all
+ */
+class EGLHeadlessContext : public OpenGLContext {
+public:
+    explicit EGLHeadlessContext(const OpenGLConfig& config) : config_(config) {}
+
+    ~EGLHeadlessContext() override {
+        if (display_ == EGL_NO_DISPLAY) {
+            return;
+        }
+        if (eglGetCurrentContext() == context_) {
+            eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        }
+        if (surface_ != EGL_NO_SURFACE) {
+            eglDestroySurface(display_, surface_);
+        }
+        if (context_ != EGL_NO_CONTEXT) {
+            eglDestroyContext(display_, context_);
+        }
+        eglTerminate(display_);
+    }
+
+    EGLHeadlessContext(const EGLHeadlessContext&) = delete;
+    EGLHeadlessContext& operator=(const EGLHeadlessContext&) = delete;
+
+    bool Initialize() override {
+        if (context_ != EGL_NO_CONTEXT) {
+            return true;
+        }
+        display_ = OpenHeadlessDisplay();
+        EGLint major = 0;
+        EGLint minor = 0;
+        if (display_ == EGL_NO_DISPLAY || eglInitialize(display_, &major, &minor) != EGL_TRUE) {
+            Report("no EGL display available");
+            display_ = EGL_NO_DISPLAY;
+            return false;
+        }
+        if (eglBindAPI(EGL_OPENGL_API) != EGL_TRUE) {
+            Report("EGL display does not support desktop OpenGL");
+            return false;
+        }
+
+        const EGLint config_attributes[] = {
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8,
+            EGL_DEPTH_SIZE, static_cast<EGLint>(config_.depth_bits),
+            EGL_STENCIL_SIZE, static_cast<EGLint>(config_.stencil_bits),
+            EGL_NONE
+        };
+        EGLConfig egl_config = nullptr;
+        EGLint config_count = 0;
+        if (eglChooseConfig(display_, config_attributes, &egl_config, 1, &config_count) != EGL_TRUE ||
+            config_count == 0) {
+            Report("no matching EGL config");
+            return false;
+        }
+
+        std::vector<EGLint> context_attributes = {
+            EGL_CONTEXT_MAJOR_VERSION, static_cast<EGLint>(config_.version_major),
+            EGL_CONTEXT_MINOR_VERSION, static_cast<EGLint>(config_.version_minor),
+            EGL_CONTEXT_OPENGL_PROFILE_MASK,
+            config_.core_profile ? EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT
+                                 : EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT,
+        };
+        if (config_.debug_context) {
+            context_attributes.insert(context_attributes.end(), {EGL_CONTEXT_OPENGL_DEBUG, EGL_TRUE});
+        }
+        if (config_.forward_compatible) {
+            context_attributes.insert(context_attributes.end(),
+                                      {EGL_CONTEXT_OPENGL_FORWARD_COMPATIBLE, EGL_TRUE});
+        }
+        context_attributes.push_back(EGL_NONE);
+        context_ = eglCreateContext(display_, egl_config, EGL_NO_CONTEXT, context_attributes.data());
+        if (context_ == EGL_NO_CONTEXT) {
+            Report("failed to create EGL context");
+            return false;
+        }
+
+        // Everything is drawn into framebuffer objects: no surface is
+        // needed where the driver allows it
+        if (!HasExtension(eglQueryString(display_, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context")) {
+            const EGLint pbuffer_attributes[] = {EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE};
+            surface_ = eglCreatePbufferSurface(display_, egl_config, pbuffer_attributes);
+            if (surface_ == EGL_NO_SURFACE) {
+                Report("failed to create EGL pbuffer");
+                return false;
+            }
+        }
+        spdlog::info("Headless EGL {}.{} context created ({})", major, minor,
+                     surface_ == EGL_NO_SURFACE ? "surfaceless" : "pbuffer");
+        return true;
+    }
+
+    bool MakeCurrent() override {
+        if (context_ == EGL_NO_CONTEXT) {
+            return false;
+        }
+        if (eglMakeCurrent(display_, surface_, surface_, context_) != EGL_TRUE) {
+            Report("failed to make EGL context current");
+            return false;
+        }
+        return true;
+    }
+
+    bool ReleaseCurrent() override {
+        if (display_ == EGL_NO_DISPLAY) {
+            return eglGetCurrentContext() == EGL_NO_CONTEXT;
+        }
+        eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        return eglGetCurrentContext() == EGL_NO_CONTEXT;
+    }
+
+    bool SwapBuffers() override {
+        // Offscreen: nothing is ever presented
+        return false;
+    }
+
+    bool IsValid() const override { return context_ != EGL_NO_CONTEXT; }
+
+    std::pair<std::uint32_t, std::uint32_t> GetActualVersion() const override {
+        if (context_ == EGL_NO_CONTEXT) {
+            return {0, 0};
+        }
+        // EGL reports only what was requested; creation fails below it
+        return {config_.version_major, config_.version_minor};
+    }
+
+    bool IsExtensionSupported(const std::string& extension_name) const override {
+        return display_ != EGL_NO_DISPLAY &&
+               HasExtension(eglQueryString(display_, EGL_EXTENSIONS), extension_name.c_str());
+    }
+
+    void SetErrorCallback(OpenGLErrorCallback callback) override {
+        error_callback_ = std::move(callback);
+    }
+
+    bool SetVSyncEnabled(bool /*enabled*/) override {
+        // No surface is presented
+        return false;
+    }
+
+    std::string GetContextInfo() const override {
+        std::ostringstream oss;
+        oss << "EGL headless context, OpenGL " << config_.version_major << "."
+            << config_.version_minor
+            << (surface_ == EGL_NO_SURFACE ? " (surfaceless)" : " (pbuffer)");
+        if (display_ != EGL_NO_DISPLAY) {
+            if (const char* vendor = eglQueryString(display_, EGL_VENDOR)) {
+                oss << ", " << vendor;
+            }
+        }
+        return oss.str();
+    }
+
+    void* GetNativeHandle() const override { return context_; }
+
+private:
+    void Report(const char* message) const {
+        const EGLint error = eglGetError();
+        spdlog::warn("Headless context: {} (EGL error 0x{:x})", message, error);
+        if (error_callback_) {
+            error_callback_(static_cast<std::uint32_t>(error), message);
+        }
+    }
+
+    OpenGLConfig config_;
+    EGLDisplay display_ = EGL_NO_DISPLAY;
+    EGLContext context_ = EGL_NO_CONTEXT;
+    EGLSurface surface_ = EGL_NO_SURFACE;
+    OpenGLErrorCallback error_callback_;
+};
+
+} // namespace
+
+std::unique_ptr<OpenGLContext> OpenGLContext::CreateHeadless(const OpenGLConfig& config) {
+    auto context = std::make_unique<EGLHeadlessContext>(config);
+    if (!context->Initialize()) {
+        return nullptr;
+    }
+    return context;
+}
+
+#else
+
+std::unique_ptr<OpenGLContext> OpenGLContext::CreateHeadless(const OpenGLConfig& /*config*/) {
+    spdlog::warn("CreateHeadless: built without EARTH_MAP_WITH_EGL");
+    return nullptr;
+}
+
+#endif // EARTH_MAP_HAVE_EGL
+
+} // namespace earth_map
@@ -0,0 +1,133 @@
+/**
+ * @file opengl_context.cpp
+ * @brief GLFW-backed shared OpenGL contexts
+ */
+
+#include <earth_map/platform/opengl_context.h>
+#include <GLFW/glfw3.h>
+#include <spdlog/spdlog.h>
+#include <sstream>
+#include <utility>
+
+namespace earth_map {
+
+namespace {
+
+/**
+ * @brief Hidden 1x1 GLFW window whose context shares objects with another
+ */
+class GLFWSharedContext : public OpenGLContext {
+public:
+    explicit GLFWSharedContext(GLFWwindow* window) : window_(window) {}
+
+    ~GLFWSharedContext() override {
+        if (window_ != nullptr) {
+            glfwDestroyWindow(window_);
+        }
+    }
+
+    GLFWSharedContext(const GLFWSharedContext&) = delete;
+    GLFWSharedContext& operator=(const GLFWSharedContext&) = delete;
+
+    bool Initialize() override { return window_ != nullptr; }
+
+    bool MakeCurrent() override {
+        if (window_ == nullptr) {
+            return false;
+        }
+        glfwMakeContextCurrent(window_);
+        if (glfwGetCurrentContext() != window_) {
+            if (error_callback_) {
+                error_callback_(0, "failed to make shared context current");
+            }
+            return false;
+        }
+        return true;
+    }
+
+    bool ReleaseCurrent() override {
+        glfwMakeContextCurrent(nullptr);
+        return glfwGetCurrentContext() == nullptr;
+    }
+
+    bool SwapBuffers() override {
+        // Offscreen: nothing is ever presented
+        return false;
+    }
+
+    bool IsValid() const override { return window_ != nullptr; }
+
+    std::pair<std::uint32_t, std::uint32_t> GetActualVersion() const override {
+        if (window_ == nullptr) {
+            return {0, 0};
+        }
+        return {static_cast<std::uint32_t>(glfwGetWindowAttrib(window_, GLFW_CONTEXT_VERSION_MAJOR)),
+                static_cast<std::uint32_t>(glfwGetWindowAttrib(window_, GLFW_CONTEXT_VERSION_MINOR))};
+    }
+
+    bool IsExtensionSupported(const std::string& extension_name) const override {
+        // Needs this context current on the calling thread
+        return glfwGetCurrentContext() == window_ &&
+               glfwExtensionSupported(extension_name.c_str()) == GLFW_TRUE;
+    }
+
+    void SetErrorCallback(OpenGLErrorCallback callback) override {
+        error_callback_ = std::move(callback);
+    }
+
+    bool SetVSyncEnabled(bool enabled) override {
+        if (glfwGetCurrentContext() != window_) {
+            return false;
+        }
+        glfwSwapInterval(enabled ? 1 : 0);
+        return true;
+    }
+
+    std::string GetContextInfo() const override {
+        const auto [major, minor] = GetActualVersion();
+        std::ostringstream oss;
+        oss << "GLFW shared context, OpenGL " << major << "." << minor;
+        return oss.str();
+    }
+
+    void* GetNativeHandle() const override { return window_; }
+
+private:
+    GLFWwindow* window_;
+    OpenGLErrorCallback error_callback_;
+};
+
+} // namespace
+
+std::unique_ptr<OpenGLContext> OpenGLContext::CreateSharedWithCurrent() {
+    GLFWwindow* current = glfwGetCurrentContext();
+    if (current == nullptr) {
+        spdlog::warn("CreateSharedWithCurrent: no GLFW context is current");
+        return nullptr;
+    }
+
+    // Sharing requires a compatible context: copy version and profile
+    glfwDefaultWindowHints();
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR,
+                   glfwGetWindowAttrib(current, GLFW_CONTEXT_VERSION_MAJOR));
+    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR,
+                   glfwGetWindowAttrib(current, GLFW_CONTEXT_VERSION_MINOR));
+    glfwWindowHint(GLFW_OPENGL_PROFILE, glfwGetWindowAttrib(current, GLFW_OPENGL_PROFILE));
+    glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT,
+                   glfwGetWindowAttrib(current, GLFW_OPENGL_FORWARD_COMPAT));
+
+    GLFWwindow* window = glfwCreateWindow(1, 1, "earth_map shared context", nullptr, current);
+    glfwDefaultWindowHints();
+
+    // glfwCreateWindow leaves the current context alone, but be explicit
+    glfwMakeContextCurrent(current);
+
+    if (window == nullptr) {
+        spdlog::warn("CreateSharedWithCurrent: failed to create shared context");
+        return nullptr;
+    }
+    return std::make_unique<GLFWSharedContext>(window);
+}
+
+} // namespace earth_map
@@ -0,0 +1,118 @@
+/**
+ * @file adaptive_quality_controller.cpp
+ * @brief Implementation of the frame-time quality controller
+ */
+
+#include <earth_map/renderer/adaptive_quality_controller.h>
+#include <earth_map/renderer/lod_manager.h>
+#include <algorithm>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+namespace earth_map {
+
+AdaptiveQualityConfig MakeAdaptiveQualityConfig(const LODParams& params) {
+    AdaptiveQualityConfig config;
+    config.enabled = params.enable_adaptive;
+    if (params.target_fps > 0.0f) {
+        config.target_frame_ms = 1000.0 / static_cast<double>(params.target_fps);
+    }
+    if (params.max_gpu_time > 0.0f) {
+        config.target_gpu_ms = static_cast<double>(params.max_gpu_time);
+    }
+    return config;
+}
+
+AdaptiveQualityController::AdaptiveQualityController(const AdaptiveQualityConfig& config)
+    : config_(config) {
+}
+
+bool AdaptiveQualityController::Update(double cpu_frame_ms, double gpu_frame_ms) {
+    if (!config_.enabled) {
+        return false;
+    }
+
+    if (!has_samples_) {
+        cpu_ms_ = cpu_frame_ms;
+        gpu_ms_ = gpu_frame_ms;
+        has_samples_ = true;
+    } else {
+        cpu_ms_ += config_.smoothing * (cpu_frame_ms - cpu_ms_);
+        gpu_ms_ += config_.smoothing * (gpu_frame_ms - gpu_ms_);
+    }
+
+    const double load = GetLoad();
+    frames_over_ = load > config_.degrade_load ? frames_over_ + 1 : 0;
+    frames_under_ = load < config_.improve_load ? frames_under_ + 1 : 0;
+
+    std::uint32_t level = level_;
+    if (frames_over_ >= config_.degrade_frames && level_ < config_.max_level) {
+        ++level;
+    } else if (frames_under_ >= config_.improve_frames && level_ > 0) {
+        --level;
+    }
+    if (level == level_) {
+        return false;
+    }
+
+    spdlog::debug("Adaptive quality level {} -> {} (load {:.2f})", level_, level, load);
+    level_ = level;
+    frames_over_ = 0;
+    frames_under_ = 0;
+    return true;
+}
+
+TileRenderConfig AdaptiveQualityController::Apply(const TileRenderConfig& full_quality) const {
+    const QualitySettings settings = GetSettings();
+    TileRenderConfig config = full_quality;
+    config.selection.max_texel_error *= settings.texel_error_scale;
+    config.max_visible_tiles = std::max<std::uint32_t>(1, static_cast<std::uint32_t>(
+        std::lround(full_quality.max_visible_tiles * settings.tile_count_scale)));
+    config.upload_budget_us = std::max<std::uint32_t>(1, static_cast<std::uint32_t>(
+        std::lround(full_quality.upload_budget_us * settings.upload_budget_scale)));
+    return config;
+}
+
+QualitySettings AdaptiveQualityController::GetSettings(std::uint32_t level) const {
+    level = std::min(level, config_.max_level);
+    const float steps = static_cast<float>(level);
+
+    QualitySettings settings;
+    settings.texel_error_scale = std::pow(config_.texel_error_step, steps);
+    settings.tile_count_scale = std::pow(config_.tile_count_step, steps);
+    settings.upload_budget_scale = std::pow(config_.upload_budget_step, steps);
+
+    // Resolution is the most visible loss: only the coarser half of the levels drops it
+    const std::uint32_t first_scaled = config_.max_level / 2;
+    if (config_.scale_resolution && level > first_scaled) {
+        settings.resolution_scale = std::max(
+            config_.min_resolution_scale,
+            1.0f - config_.resolution_step * static_cast<float>(level - first_scaled));
+    }
+    return settings;
+}
+
+double AdaptiveQualityController::GetLoad() const {
+    const double cpu_load = config_.target_frame_ms > 0.0 ? cpu_ms_ / config_.target_frame_ms : 0.0;
+    const double gpu_load = config_.target_gpu_ms > 0.0 ? gpu_ms_ / config_.target_gpu_ms : 0.0;
+    return std::max(cpu_load, gpu_load);
+}
+
+void AdaptiveQualityController::Reset() {
+    level_ = 0;
+    cpu_ms_ = 0.0;
+    gpu_ms_ = 0.0;
+    has_samples_ = false;
+    frames_over_ = 0;
+    frames_under_ = 0;
+}
+
+void AdaptiveQualityController::SetConfig(const AdaptiveQualityConfig& config) {
+    config_ = config;
+    level_ = std::min(level_, config_.max_level);
+    if (!config_.enabled) {
+        Reset();
+    }
+}
+
+} // namespace earth_map
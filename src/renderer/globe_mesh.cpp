@@ -4,17 +4,259 @@
  */
 
 #include <earth_map/renderer/globe_mesh.h>
+#include <earth_map/renderer/globe_mesh_cache.h>
 #include <earth_map/renderer/elevation_manager.h>
 #include <earth_map/math/bounding_box.h>
+#include <earth_map/math/frustum.h>
 #include <earth_map/coordinates/coordinate_mapper.h>
+#include <earth_map/math/projection.h>
+#include <earth_map/constants.h>
 #include <cmath>
 #include <algorithm>
+#include <array>
+#include <functional>
+#include <future>
+#include <limits>
+#include <span>
 #include <stdexcept>
-#include <unordered_map>
+#include <thread>
+#include <utility>
+#include <vector>
 #include <spdlog/spdlog.h>
 
 namespace earth_map {
 
+namespace {
+
+// 20 faces of the standard icosahedron with CCW winding (from outside)
+// so that face normals point outward, matching OpenGL's default GL_FRONT_FACE = GL_CCW
+constexpr std::array<std::array<std::uint32_t, 3>, 20> kIcosahedronFaces = {{
+    // Top cap (5 triangles around vertex 5)
+    {5, 0, 11}, {5, 1, 0}, {5, 9, 1}, {5, 4, 9}, {5, 11, 4},
+
+    // Upper belt (5 triangles)
+    {0, 10, 11}, {0, 7, 10}, {1, 7, 0}, {1, 8, 7}, {9, 8, 1},
+
+    // Lower belt (5 triangles)
+    {4, 3, 9}, {9, 3, 8}, {8, 6, 7}, {7, 6, 10}, {10, 2, 11},
+
+    // Bottom cap (5 triangles around vertex 2)
+    {2, 3, 4}, {2, 6, 3}, {2, 10, 6}, {2, 4, 11}, {3, 6, 8}
+}};
+
+// Subdivision levels from which Generate() splits the faces across threads
+constexpr std::uint8_t kParallelSubdivisionLevel = 5;
+
+// A parent merges once its error falls this far below the split threshold,
+// so triangles near the threshold do not split and merge on alternate frames
+constexpr float kLodMergeHysteresis = 0.75f;
+
+std::uint64_t EdgeKey(std::uint32_t a, std::uint32_t b) {
+    return (static_cast<std::uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+}
+
+// Post-transform cache modeled by the triangle order optimization (LRU)
+constexpr std::size_t kOptimizerCacheSize = 32;
+
+// Cache reported by the ACMR statistics (FIFO, as in most GPUs' estimates)
+constexpr std::size_t kAcmrCacheSize = 16;
+
+// Vertices one 16-bit index chunk can address
+constexpr std::size_t kIndexChunkVertices = 65536;
+
+// More chunks than this per icosahedron face and 32-bit indices draw faster
+constexpr std::size_t kMaxIndexChunksPerFace = 4;
+
+/**
+ * @brief Vertex shader invocations per triangle with a FIFO cache
+ */
+float AnalyzeVertexCache(const std::vector<std::uint32_t>& indices, std::size_t vertex_count) {
+    if (indices.size() < 3) {
+        return 0.0f;
+    }
+    // Timestamp of each vertex's entry into the cache
+    std::vector<std::size_t> cached_at(vertex_count, std::numeric_limits<std::size_t>::max());
+    std::size_t misses = 0;
+    for (const std::uint32_t index : indices) {
+        const std::size_t entered = cached_at[index];
+        if (entered == std::numeric_limits<std::size_t>::max() || misses - entered >= kAcmrCacheSize) {
+            cached_at[index] = misses++;
+        }
+    }
+    return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
+
+/**
+ * @brief Score tables of Forsyth's "Linear-speed vertex cache optimisation"
+ */
+struct ForsythScores {
+    static constexpr std::size_t kMaxValence = 32;
+
+    std::array<float, kOptimizerCacheSize> cache{};
+    std::array<float, kMaxValence> valence{};
+
+    ForsythScores() {
+        for (std::size_t i = 0; i < cache.size(); ++i) {
+            // The last triangle's vertices score alike, so its orientation does not matter
+            cache[i] = i < 3 ? 0.75f : std::pow(1.0f - static_cast<float>(i - 3) /
+                                                        static_cast<float>(kOptimizerCacheSize - 3), 1.5f);
+        }
+        for (std::size_t i = 1; i < valence.size(); ++i) {
+            // Vertices with few triangles left are finished first
+            valence[i] = 2.0f / std::sqrt(static_cast<float>(i));
+        }
+    }
+
+    float Vertex(std::int32_t cache_position, std::uint32_t live_triangles) const {
+        if (live_triangles == 0) {
+            return -1.0f;
+        }
+        const float from_cache = cache_position < 0 ? 0.0f : cache[static_cast<std::size_t>(cache_position)];
+        return from_cache + valence[std::min<std::size_t>(live_triangles, kMaxValence - 1)];
+    }
+};
+
+/**
+ * @brief Reorder triangles in place for the post-transform vertex cache
+ *
+ * Greedy: emits the triangle whose vertices score highest, where recently
+ * used vertices and vertices with few remaining triangles score high.
+ */
+void OptimizeTriangleOrder(std::span<GlobeTriangle> triangles) {
+    static const ForsythScores scores;
+    const std::size_t triangle_count = triangles.size();
+    if (triangle_count < 2) {
+        return;
+    }
+
+    // Local vertex numbering keeps the tables the size of the range
+    std::vector<std::uint32_t> unique;
+    unique.reserve(triangle_count * 3);
+    for (const GlobeTriangle& triangle : triangles) {
+        unique.insert(unique.end(), triangle.vertices, triangle.vertices + 3);
+    }
+    std::sort(unique.begin(), unique.end());
+    unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+    const std::size_t vertex_count = unique.size();
+
+    std::vector<std::uint32_t> corners(triangle_count * 3);
+    std::vector<std::uint32_t> live(vertex_count, 0);
+    for (std::size_t t = 0; t < triangle_count; ++t) {
+        for (int k = 0; k < 3; ++k) {
+            const auto local = static_cast<std::uint32_t>(
+                std::lower_bound(unique.begin(), unique.end(), triangles[t].vertices[k]) - unique.begin());
+            corners[t * 3 + k] = local;
+            ++live[local];
+        }
+    }
+
+    // Triangles of each vertex; the first live[v] entries are not yet emitted
+    std::vector<std::uint32_t> adjacency_offsets(vertex_count + 1, 0);
+    for (std::size_t v = 0; v < vertex_count; ++v) {
+        adjacency_offsets[v + 1] = adjacency_offsets[v] + live[v];
+    }
+    std::vector<std::uint32_t> adjacency(triangle_count * 3);
+    {
+        std::vector<std::uint32_t> fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+        for (std::size_t t = 0; t < triangle_count; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                adjacency[fill[corners[t * 3 + k]]++] = static_cast<std::uint32_t>(t);
+            }
+        }
+    }
+
+    std::vector<std::int32_t> cache_position(vertex_count, -1);
+    std::vector<float> vertex_score(vertex_count);
+    for (std::size_t v = 0; v < vertex_count; ++v) {
+        vertex_score[v] = scores.Vertex(-1, live[v]);
+    }
+    std::vector<std::uint8_t> emitted(triangle_count, 0);
+
+    std::vector<std::uint32_t> order;
+    order.reserve(triangle_count);
+    std::vector<std::uint32_t> cache;
+    std::vector<std::uint32_t> next_cache;
+    cache.reserve(kOptimizerCacheSize + 3);
+    next_cache.reserve(kOptimizerCacheSize + 3);
+    std::size_t cursor = 0;
+    std::size_t best = triangle_count;
+
+    while (order.size() < triangle_count) {
+        if (best == triangle_count) {
+            // Nothing in the cache has triangles left: continue in input order
+            while (emitted[cursor]) {
+                ++cursor;
+            }
+            best = cursor;
+        }
+        order.push_back(static_cast<std::uint32_t>(best));
+        emitted[best] = 1;
+
+        const std::uint32_t* tri = &corners[best * 3];
+        for (int k = 0; k < 3; ++k) {
+            const std::uint32_t v = tri[k];
+            std::uint32_t* begin = &adjacency[adjacency_offsets[v]];
+            std::uint32_t* last = begin + live[v] - 1;
+            *std::find(begin, last + 1, static_cast<std::uint32_t>(best)) = *last;
+            *last = static_cast<std::uint32_t>(best);
+            --live[v];
+        }
+
+        // The emitted triangle's vertices move to the front of the LRU cache
+        next_cache.assign(tri, tri + 3);
+        for (const std::uint32_t v : cache) {
+            if (v != tri[0] && v != tri[1] && v != tri[2]) {
+                next_cache.push_back(v);
+            }
+        }
+        for (std::size_t i = kOptimizerCacheSize; i < next_cache.size(); ++i) {
+            cache_position[next_cache[i]] = -1;
+            vertex_score[next_cache[i]] = scores.Vertex(-1, live[next_cache[i]]);
+        }
+        next_cache.resize(std::min(next_cache.size(), kOptimizerCacheSize));
+        for (std::size_t i = 0; i < next_cache.size(); ++i) {
+            cache_position[next_cache[i]] = static_cast<std::int32_t>(i);
+            vertex_score[next_cache[i]] = scores.Vertex(static_cast<std::int32_t>(i), live[next_cache[i]]);
+        }
+        std::swap(cache, next_cache);
+
+        // The next triangle is the best one touching the cache
+        best = triangle_count;
+        float best_score = -1.0f;
+        for (const std::uint32_t v : cache) {
+            const std::uint32_t* adjacent = &adjacency[adjacency_offsets[v]];
+            for (std::uint32_t i = 0; i < live[v]; ++i) {
+                const std::uint32_t* c = &corners[adjacent[i] * 3];
+                const float score = vertex_score[c[0]] + vertex_score[c[1]] + vertex_score[c[2]];
+                if (score > best_score) {
+                    best_score = score;
+                    best = adjacent[i];
+                }
+            }
+        }
+    }
+
+    std::vector<GlobeTriangle> reordered;
+    reordered.reserve(triangle_count);
+    for (const std::uint32_t t : order) {
+        reordered.push_back(triangles[t]);
+    }
+    std::copy(reordered.begin(), reordered.end(), triangles.begin());
+}
+
+} // namespace
+
+/**
+ * @brief Camera state shared by the LOD updates of one frame
+ */
+struct IcosahedronGlobeMesh::LodView {
+    glm::vec3 camera_position;
+    glm::mat4 view_matrix;
+    glm::mat4 projection_matrix;
+    glm::vec2 viewport_size;
+    Frustum frustum;
+};
+
 // Factory function
 std::unique_ptr<GlobeMesh> GlobeMesh::Create(const GlobeMeshParams& params) {
     return std::make_unique<IcosahedronGlobeMesh>(params);
@@ -31,6 +273,38 @@ bool IcosahedronGlobeMesh::Generate() {
         vertices_.clear();
         triangles_.clear();
         vertex_indices_.clear();
+        vertex_indices16_.clear();
+        index_chunks_.clear();
+        acmr_before_ = acmr_after_ = 0.0f;
+        midpoint_cache_.clear();
+
+        // Adaptive LOD rebuilds its hierarchy on the next UpdateLOD()
+        lod_nodes_.clear();
+        lod_slot_nodes_.clear();
+        lod_edges_.clear();
+        lod_free_blocks_.clear();
+        lod_released_blocks_.clear();
+        lod_dirty_nodes_.clear();
+        dirty_index_ranges_.clear();
+
+        // Uniform meshes depend only on params_, displaced ones on elevation data too
+        const bool cacheable = mesh_cache_ && !elevation_manager_;
+        const std::uint64_t cache_key = cacheable ? GlobeMeshCache::MakeKey(params_) : 0;
+        if (cacheable) {
+            if (auto cached = mesh_cache_->Load(cache_key)) {
+                vertices_ = std::move(cached->vertices);
+                triangles_ = std::move(cached->triangles);
+                vertex_indices_ = std::move(cached->indices);
+                vertex_indices16_ = std::move(cached->indices16);
+                index_chunks_ = std::move(cached->index_chunks);
+                acmr_before_ = cached->acmr_before;
+                acmr_after_ = cached->acmr_after;
+                MarkMeshReplaced();
+                spdlog::info("Globe mesh loaded from cache: {} vertices, {} triangles",
+                             vertices_.size(), triangles_.size());
+                return true;
+            }
+        }
         
         // Generate base icosahedron
         GenerateIcosahedron();
@@ -73,7 +347,14 @@ bool IcosahedronGlobeMesh::Generate() {
             spdlog::error("Generated mesh failed validation");
             return false;
         }
+
+        if (cacheable) {
+            mesh_cache_->Store(cache_key, {vertices_, triangles_, vertex_indices_,
+                                           vertex_indices16_, index_chunks_,
+                                           acmr_before_, acmr_after_});
+        }
         
+        MarkMeshReplaced();
         spdlog::info("Globe mesh generated: {} vertices, {} triangles", 
                    vertices_.size(), triangles_.size());
         return true;
@@ -157,31 +438,16 @@ void IcosahedronGlobeMesh::GenerateIcosahedron() {
         vertex.normal = glm::normalize(pos);  // For sphere, normal = normalized position
         vertex.geographic = PositionToGeographic(pos);
         vertex.texcoord = GeographicToUV(vertex.geographic);
+        vertex.mercator = GeographicToMercator(vertex.geographic);
         vertex.lod_level = 0;
         vertex.edge_flags = 0;
 
         vertices_.push_back(vertex);
     }
 
-    // Define 20 faces of standard icosahedron with CCW winding (from outside)
-    // so that face normals point outward, matching OpenGL's default GL_FRONT_FACE = GL_CCW
-    std::vector<std::array<int, 3>> faces = {
-        // Top cap (5 triangles around vertex 5)
-        {5, 0, 11}, {5, 1, 0}, {5, 9, 1}, {5, 4, 9}, {5, 11, 4},
-
-        // Upper belt (5 triangles)
-        {0, 10, 11}, {0, 7, 10}, {1, 7, 0}, {1, 8, 7}, {9, 8, 1},
-
-        // Lower belt (5 triangles)
-        {4, 3, 9}, {9, 3, 8}, {8, 6, 7}, {7, 6, 10}, {10, 2, 11},
-
-        // Bottom cap (5 triangles around vertex 2)
-        {2, 3, 4}, {2, 6, 3}, {2, 10, 6}, {2, 4, 11}, {3, 6, 8}
-    };
-    
     // Create GlobeTriangle objects
-    triangles_.reserve(faces.size());
-    for (const auto& face : faces) {
+    triangles_.reserve(kIcosahedronFaces.size());
+    for (const auto& face : kIcosahedronFaces) {
         GlobeTriangle triangle;
         triangle.vertices[0] = face[0];
         triangle.vertices[1] = face[1];
@@ -199,88 +465,168 @@ void IcosahedronGlobeMesh::GenerateIcosahedron() {
 
 void IcosahedronGlobeMesh::SubdivideToLevel(std::uint8_t target_level) {
     if (target_level == 0) return;
-    
-    for (std::uint8_t level = 1; level <= target_level; ++level) {
-        spdlog::debug("Subdividing to level {}", level);
-        std::vector<GlobeTriangle> new_triangles;
-        new_triangles.reserve(triangles_.size() * 4);
-        
-        for (const auto& triangle : triangles_) {
-            if (triangle.lod_level >= level) {
-                // Triangle already at this level, keep as is
-                new_triangles.push_back(triangle);
-                continue;
+
+    // Each base face becomes a triangular grid of n x n triangles. Grid
+    // points get fixed global indices: the 12 corners, then the interior
+    // points of each of the 30 edges in canonical (lower to higher corner)
+    // order, then the interior points of each face. Faces are independent
+    // and write disjoint parts of preallocated buffers.
+    const std::uint32_t n = 1u << target_level;
+    const std::size_t edge_points = n - 1;
+    const std::size_t face_points = static_cast<std::size_t>(n - 1) * (n - 2) / 2;
+
+    // Edges in first-use order; the first face using an edge writes its points
+    std::vector<std::array<std::uint32_t, 2>> edges;
+    std::array<std::array<std::uint32_t, 3>, kIcosahedronFaces.size()> face_edges;
+    std::vector<std::uint32_t> edge_owners;
+    for (std::uint32_t face = 0; face < kIcosahedronFaces.size(); ++face) {
+        const auto& c = kIcosahedronFaces[face];
+        const std::array<std::array<std::uint32_t, 2>, 3> face_corners = {{
+            {c[0], c[1]}, {c[1], c[2]}, {c[0], c[2]}
+        }};
+        for (int e = 0; e < 3; ++e) {
+            const std::array<std::uint32_t, 2> edge = {std::min(face_corners[e][0], face_corners[e][1]),
+                                                       std::max(face_corners[e][0], face_corners[e][1])};
+            const auto it = std::find(edges.begin(), edges.end(), edge);
+            face_edges[face][e] = static_cast<std::uint32_t>(it - edges.begin());
+            if (it == edges.end()) {
+                edges.push_back(edge);
+                edge_owners.push_back(face);
             }
-            
-            // Get vertex indices
-            std::uint32_t v0 = triangle.vertices[0];
-            std::uint32_t v1 = triangle.vertices[1];
-            std::uint32_t v2 = triangle.vertices[2];
-            
-            // Create midpoint vertices
-            std::uint32_t v01 = CreateMidpointVertex(v0, v1);
-            std::uint32_t v12 = CreateMidpointVertex(v1, v2);
-            std::uint32_t v20 = CreateMidpointVertex(v2, v0);
-            
-            // Create 4 new triangles
-            GlobeTriangle t1, t2, t3, t4;
-            
-            // Triangle 1 (top)
-            t1.vertices[0] = v0;
-            t1.vertices[1] = v01;
-            t1.vertices[2] = v20;
-            t1.lod_level = level;
-            
-            // Triangle 2 (right)
-            t2.vertices[0] = v01;
-            t2.vertices[1] = v1;
-            t2.vertices[2] = v12;
-            t2.lod_level = level;
-            
-            // Triangle 3 (bottom)
-            t3.vertices[0] = v20;
-            t3.vertices[1] = v12;
-            t3.vertices[2] = v2;
-            t3.lod_level = level;
-            
-            // Triangle 4 (center)
-            t4.vertices[0] = v01;
-            t4.vertices[1] = v12;
-            t4.vertices[2] = v20;
-            t4.lod_level = level;
-            
-            // Calculate bounds for new triangles
-            t1.bounds = CalculateTriangleBounds(t1);
-            t2.bounds = CalculateTriangleBounds(t2);
-            t3.bounds = CalculateTriangleBounds(t3);
-            t4.bounds = CalculateTriangleBounds(t4);
-            
-            new_triangles.push_back(t1);
-            new_triangles.push_back(t2);
-            new_triangles.push_back(t3);
-            new_triangles.push_back(t4);
         }
-        
-        triangles_ = std::move(new_triangles);
-    }
-    
-    // Update LOD levels for vertices (take max of adjacent triangles)
-    for (auto& vertex : vertices_) {
-        vertex.lod_level = 0;
     }
-    
-    for (const auto& triangle : triangles_) {
-        for (int i = 0; i < 3; ++i) {
-            vertices_[triangle.vertices[i]].lod_level = 
-                std::max(vertices_[triangle.vertices[i]].lod_level, triangle.lod_level);
+
+    const std::size_t corner_count = vertices_.size();
+    const std::size_t face_base = corner_count + edges.size() * edge_points;
+    vertices_.resize(face_base + kIcosahedronFaces.size() * face_points);
+    std::vector<GlobeTriangle> triangles(kIcosahedronFaces.size() * n * n);
+
+    const auto subdivide_face = [&](std::uint32_t face) {
+        const auto& c = kIcosahedronFaces[face];
+        const std::uint32_t stride = n + 1;
+        const auto at = [stride](std::uint32_t i, std::uint32_t j) { return j * stride + i; };
+
+        // Point (i, j) lies i steps from corner 0 towards corner 1 and j
+        // steps towards corner 2. Points are midpoints of the coarser grid,
+        // computed level by level exactly as recursive subdivision would.
+        std::vector<GlobeVertex> grid(static_cast<std::size_t>(stride) * stride);
+        grid[at(0, 0)] = vertices_[c[0]];
+        grid[at(n, 0)] = vertices_[c[1]];
+        grid[at(0, n)] = vertices_[c[2]];
+        for (std::uint32_t step = n / 2; step >= 1; step /= 2) {
+            for (std::uint32_t j = 0; j <= n; j += step) {
+                for (std::uint32_t i = 0; i + j <= n; i += step) {
+                    const bool i_odd = (i / step) % 2 == 1;
+                    const bool j_odd = (j / step) % 2 == 1;
+                    if (!i_odd && !j_odd) {
+                        continue;  // Point of the coarser grid
+                    }
+                    std::size_t a;
+                    std::size_t b;
+                    if (i_odd && j_odd) {
+                        a = at(i - step, j + step);
+                        b = at(i + step, j - step);
+                    } else if (i_odd) {
+                        a = at(i - step, j);
+                        b = at(i + step, j);
+                    } else {
+                        a = at(i, j - step);
+                        b = at(i, j + step);
+                    }
+                    const glm::vec3 midpoint = (grid[a].position + grid[b].position) * 0.5f;
+                    grid[at(i, j)].position = glm::normalize(midpoint) * static_cast<float>(params_.radius);
+                }
+            }
+        }
+
+        // Global index of a grid point, and whether this face writes it
+        const auto on_edge = [&](int e, std::uint32_t from, std::uint32_t t) {
+            const std::uint32_t edge = face_edges[face][e];
+            const std::uint32_t offset = from == edges[edge][0] ? t : n - t;
+            return static_cast<std::uint32_t>(corner_count + edge * edge_points + offset - 1);
+        };
+        const auto global_index = [&](std::uint32_t i, std::uint32_t j) -> std::pair<std::uint32_t, bool> {
+            if (i == 0 && j == 0) return {c[0], false};
+            if (i == n && j == 0) return {c[1], false};
+            if (i == 0 && j == n) return {c[2], false};
+            if (j == 0) return {on_edge(0, c[0], i), edge_owners[face_edges[face][0]] == face};
+            if (i + j == n) return {on_edge(1, c[1], j), edge_owners[face_edges[face][1]] == face};
+            if (i == 0) return {on_edge(2, c[0], j), edge_owners[face_edges[face][2]] == face};
+            const std::size_t row = (j - 1) * static_cast<std::size_t>(n - 1) - (j - 1) * static_cast<std::size_t>(j) / 2;
+            return {static_cast<std::uint32_t>(face_base + face * face_points + row + i - 1), true};
+        };
+
+        std::vector<std::uint32_t> indices(grid.size());
+        for (std::uint32_t j = 0; j <= n; ++j) {
+            for (std::uint32_t i = 0; i + j <= n; ++i) {
+                GlobeVertex& vertex = grid[at(i, j)];
+                const auto [index, owned] = global_index(i, j);
+                indices[at(i, j)] = index;
+                if (index < corner_count) {
+                    continue;
+                }
+                vertex.normal = glm::normalize(vertex.position);
+                vertex.geographic = PositionToGeographic(vertex.position);
+                vertex.texcoord = GeographicToUV(vertex.geographic);
+                vertex.mercator = GeographicToMercator(vertex.geographic);
+                vertex.lod_level = target_level;
+                vertex.edge_flags = 0;
+                if (owned) {
+                    vertices_[index] = vertex;
+                }
+            }
         }
+
+        // Upward and downward triangles keep the face winding
+        GlobeTriangle* out = triangles.data() + static_cast<std::size_t>(face) * n * n;
+        const auto emit = [&](std::size_t a, std::size_t b, std::size_t d) {
+            GlobeTriangle& triangle = *out++;
+            const std::size_t points[3] = {a, b, d};
+            for (int k = 0; k < 3; ++k) {
+                triangle.vertices[k] = indices[points[k]];
+                const glm::vec2& geo = grid[points[k]].geographic;
+                triangle.bounds.min = k == 0 ? geo : glm::min(triangle.bounds.min, geo);
+                triangle.bounds.max = k == 0 ? geo : glm::max(triangle.bounds.max, geo);
+            }
+            triangle.lod_level = target_level;
+        };
+        for (std::uint32_t j = 0; j < n; ++j) {
+            for (std::uint32_t i = 0; i + j < n; ++i) {
+                emit(at(i, j), at(i + 1, j), at(i, j + 1));
+                if (i + j + 1 < n) {
+                    emit(at(i + 1, j), at(i + 1, j + 1), at(i, j + 1));
+                }
+            }
+        }
+    };
+
+    const std::size_t face_count = kIcosahedronFaces.size();
+    const std::size_t chunk_count = target_level < kParallelSubdivisionLevel
+        ? 1 : std::min<std::size_t>(face_count, std::max(1u, std::thread::hardware_concurrency()));
+    const auto work = [&](std::size_t chunk) {
+        for (std::size_t face = chunk; face < face_count; face += chunk_count) {
+            subdivide_face(static_cast<std::uint32_t>(face));
+        }
+    };
+    std::vector<std::future<void>> tasks;
+    for (std::size_t chunk = 1; chunk < chunk_count; ++chunk) {
+        tasks.push_back(std::async(std::launch::async, work, chunk));
+    }
+    work(0);
+    for (std::future<void>& task : tasks) {
+        task.get();
+    }
+
+    triangles_ = std::move(triangles);
+    for (std::size_t i = 0; i < corner_count; ++i) {
+        vertices_[i].lod_level = target_level;
     }
 }
 
 std::size_t IcosahedronGlobeMesh::CreateMidpointVertex(std::size_t v1, std::size_t v2) {
     // Create a key for the edge to avoid duplicate vertices
-    std::uint64_t edge_key = (static_cast<std::uint64_t>(std::min(v1, v2)) << 32) | 
-                             static_cast<std::uint64_t>(std::max(v1, v2));
+    const std::uint64_t edge_key = EdgeKey(static_cast<std::uint32_t>(v1),
+                                           static_cast<std::uint32_t>(v2));
     
     auto it = midpoint_cache_.find(edge_key);
     if (it != midpoint_cache_.end()) {
@@ -301,6 +647,7 @@ std::size_t IcosahedronGlobeMesh::CreateMidpointVertex(std::size_t v1, std::size
     vertex.normal = glm::normalize(midpoint);
     vertex.geographic = PositionToGeographic(midpoint);
     vertex.texcoord = GeographicToUV(vertex.geographic);
+    vertex.mercator = GeographicToMercator(vertex.geographic);
     vertex.lod_level = std::max(vertices_[v1].lod_level, vertices_[v2].lod_level) + 1;
     vertex.edge_flags = 0;
 
@@ -308,7 +655,7 @@ std::size_t IcosahedronGlobeMesh::CreateMidpointVertex(std::size_t v1, std::size
     vertices_.push_back(vertex);
     
     // Cache the midpoint
-    midpoint_cache_[edge_key] = new_vertex_index;
+    midpoint_cache_[edge_key] = static_cast<std::uint32_t>(new_vertex_index);
     
     return new_vertex_index;
 }
@@ -337,7 +684,30 @@ glm::vec2 IcosahedronGlobeMesh::GeographicToUV(const glm::vec2& geographic) cons
     return glm::vec2(u, v);
 }
 
+glm::vec2 IcosahedronGlobeMesh::GeographicToMercator(const glm::vec2& geographic) const {
+    // Same mapping as tile addressing: tile = floor(mercator * 2^zoom).
+    // Latitude is clamped to the Web Mercator limit; beyond it the edge row
+    // of tiles is stretched to the pole.
+    const double lat = std::clamp(static_cast<double>(geographic.y),
+                                  -WebMercatorProjection::MAX_LATITUDE,
+                                  WebMercatorProjection::MAX_LATITUDE) * constants::math::DEG_TO_RAD;
+    const double x = (static_cast<double>(geographic.x) + 180.0) / 360.0;
+    const double y = (1.0 - std::log(std::tan(constants::math::PI / 4.0 + lat / 2.0)) / constants::math::PI) / 2.0;
+
+    return glm::vec2(static_cast<float>(std::clamp(x, 0.0, 1.0)),
+                     static_cast<float>(std::clamp(y, 0.0, 1.0)));
+}
+
 void IcosahedronGlobeMesh::GenerateVertexIndices() {
+    if (!lod_nodes_.empty()) {
+        // Adaptive LOD layout: one block per leaf
+        vertex_indices_.resize(triangles_.size() * kIndicesPerLodTriangle);
+        for (const std::uint32_t node : lod_slot_nodes_) {
+            WriteLodIndices(node);
+        }
+        return;
+    }
+
     vertex_indices_.clear();
     vertex_indices_.reserve(triangles_.size() * 3);
     
@@ -371,98 +741,562 @@ bool IcosahedronGlobeMesh::UpdateLOD(const glm::vec3& camera_position,
                                    const glm::mat4& view_matrix,
                                    const glm::mat4& projection_matrix,
                                    const glm::vec2& viewport_size) {
-    (void)view_matrix;  // Reserved for future frustum-based LOD
-
     if (!params_.enable_adaptive) {
         return true;  // Adaptive LOD disabled, nothing to do
     }
 
-    // Track whether mesh was regenerated (for potential GPU buffer updates)
-    [[maybe_unused]] bool mesh_changed = false;
-
-    // Calculate camera distance from globe center
-    // Note: mesh uses normalized radius 1.0, not WGS84 radius
-    const float camera_distance = glm::length(camera_position);
-    const float normalized_radius = 1.0f;  // Mesh uses unit sphere
-
-    // Determine target subdivision level based on camera distance
-    // Closer camera = higher subdivision (more detail)
-    std::uint8_t target_level = 0;
-    if (camera_distance < normalized_radius * 1.01f) {
-        target_level = params_.max_subdivision_level;  // Very close - max detail
-    } else if (camera_distance < normalized_radius * 1.1f) {
-        target_level = std::min(static_cast<std::uint8_t>(params_.max_subdivision_level - 1),
-                               static_cast<std::uint8_t>(7));
-    } else if (camera_distance < normalized_radius * 1.5f) {
-        target_level = std::min(static_cast<std::uint8_t>(params_.max_subdivision_level - 2),
-                               static_cast<std::uint8_t>(5));
-    } else if (camera_distance < normalized_radius * 3.0f) {
-        target_level = std::min(static_cast<std::uint8_t>(params_.max_subdivision_level - 3),
-                               static_cast<std::uint8_t>(4));
-    } else if (camera_distance < normalized_radius * 10.0f) {
-        target_level = 3;
-    } else {
-        target_level = 2;  // Far away - low detail
-    }
+    const LodView view{camera_position, view_matrix, projection_matrix, viewport_size,
+                       Frustum(projection_matrix * view_matrix)};
+    const std::size_t first_new_vertex = vertices_.size();
+    dirty_index_ranges_.clear();
 
-    // Clamp to valid range
-    target_level = std::max(target_level, static_cast<std::uint8_t>(1));
-    target_level = std::min(target_level, params_.max_subdivision_level);
+    // The first update replaces the uniformly subdivided mesh and refines
+    // from the base faces without an operation limit
+    const bool rebuild = lod_nodes_.empty();
+    if (rebuild) {
+        BuildLodHierarchy(view);
+    }
 
-    // Check if we need to regenerate the mesh at a different detail level
-    // by examining the current average LOD level
-    std::uint8_t current_avg_level = 0;
-    if (!triangles_.empty()) {
-        std::uint32_t total_level = 0;
-        for (const auto& tri : triangles_) {
-            total_level += tri.lod_level;
+    // Frustum-cull all triangle bounding boxes in one batch
+    const std::size_t triangle_count = triangles_.size();
+    for (int axis = 0; axis < 3; ++axis) {
+        cull_centers_[axis].resize(triangle_count);
+        cull_extents_[axis].resize(triangle_count);
+    }
+    for (std::size_t i = 0; i < triangle_count; ++i) {
+        const GlobeTriangle& triangle = triangles_[i];
+        const glm::vec3& a = vertices_[triangle.vertices[0]].position;
+        const glm::vec3& b = vertices_[triangle.vertices[1]].position;
+        const glm::vec3& c = vertices_[triangle.vertices[2]].position;
+        const glm::vec3 box_min = glm::min(a, glm::min(b, c));
+        const glm::vec3 box_max = glm::max(a, glm::max(b, c));
+        for (int axis = 0; axis < 3; ++axis) {
+            cull_centers_[axis][i] = (box_min[axis] + box_max[axis]) * 0.5f;
+            cull_extents_[axis][i] = (box_max[axis] - box_min[axis]) * 0.5f;
         }
-        current_avg_level = static_cast<std::uint8_t>(total_level / triangles_.size());
     }
 
-    // If target level differs significantly from current, regenerate
-    if (std::abs(static_cast<int>(target_level) - static_cast<int>(current_avg_level)) >= 1) {
-        spdlog::debug("Adaptive LOD: changing from level {} to {} (camera distance: {:.2f})",
-                     current_avg_level, target_level, camera_distance);
-
-        // Store old params and update subdivision level
-        GlobeMeshParams old_params = params_;
-        params_.max_subdivision_level = target_level;
-
-        // Clear current mesh
-        vertices_.clear();
-        triangles_.clear();
-        midpoint_cache_.clear();
-
-        // Regenerate mesh at new detail level
-        GenerateIcosahedron();
-        SubdivideToLevel(target_level);
-        GenerateVertexIndices();
-
-        // Restore max subdivision level for future reference
-        params_.max_subdivision_level = old_params.max_subdivision_level;
-
-        mesh_changed = true;
-        spdlog::info("Adaptive LOD: mesh regenerated with {} vertices, {} triangles at level {}",
-                    vertices_.size(), triangles_.size(), target_level);
+    FrustumBoxBatch boxes;
+    for (int axis = 0; axis < 3; ++axis) {
+        boxes.center[axis] = cull_centers_[axis].data();
+        boxes.extent[axis] = cull_extents_[axis].data();
     }
+    boxes.count = triangle_count;
+    cull_mask_.resize(Frustum::BatchMaskWords(triangle_count));
+    view.frustum.IntersectsBatch(boxes, cull_mask_.data());
 
     // Update triangle visibility and screen errors for fine-grained LOD
-    for (auto& triangle : triangles_) {
+    for (std::size_t i = 0; i < triangle_count; ++i) {
+        GlobeTriangle& triangle = triangles_[i];
         triangle.screen_error = CalculateScreenError(triangle, camera_position,
                                                      view_matrix, projection_matrix, viewport_size);
-        // Mark triangles that are facing the camera as visible
+        // Mark triangles that are in the frustum and facing the camera as visible
         glm::vec3 triangle_center = (vertices_[triangle.vertices[0]].position +
                                     vertices_[triangle.vertices[1]].position +
                                     vertices_[triangle.vertices[2]].position) / 3.0f;
         glm::vec3 to_camera = glm::normalize(camera_position - triangle_center);
         glm::vec3 triangle_normal = glm::normalize(triangle_center);  // For sphere, normal = center
-        triangle.visible = glm::dot(to_camera, triangle_normal) > -0.2f;  // Allow some backface
+        const bool in_frustum = (cull_mask_[i / 64] >> (i % 64)) & 1u;
+        triangle.visible = in_frustum &&
+                           glm::dot(to_camera, triangle_normal) > -0.2f;  // Allow some backface
     }
 
+    RefineLod(view, rebuild ? 0 : params_.lod_max_operations);
+    FlushLodChanges(first_new_vertex);
+    if (rebuild) {
+        MarkMeshReplaced();
+    } else if (!dirty_index_ranges_.empty() || vertices_.size() > first_new_vertex) {
+        // The GPU copy of the previous revision catches up with the dirty ranges
+        dirty_base_revision_ = revision_++;
+    }
     return true;
 }
 
+void IcosahedronGlobeMesh::BuildLodHierarchy(const LodView& view) {
+    // Only the base vertices of an earlier Generate() are kept; the
+    // hierarchy creates its midpoints on demand
+    if (vertices_.size() < 12) {
+        vertices_.clear();
+        triangles_.clear();
+        GenerateIcosahedron();
+    }
+    vertices_.resize(12);
+    midpoint_cache_.clear();
+
+    triangles_.clear();
+    lod_nodes_.clear();
+    lod_slot_nodes_.clear();
+    lod_edges_.clear();
+    lod_free_blocks_.clear();
+    lod_released_blocks_.clear();
+    lod_dirty_nodes_.clear();
+
+    lod_nodes_.resize(kIcosahedronFaces.size());
+    for (std::uint32_t i = 0; i < kIcosahedronFaces.size(); ++i) {
+        lod_nodes_[i].vertices = kIcosahedronFaces[i];
+        AddLodLeaf(i, kNoLodNode, view);
+    }
+}
+
+void IcosahedronGlobeMesh::RefineLod(const LodView& view, std::size_t max_operations) {
+    if (max_operations == 0) {
+        max_operations = std::numeric_limits<std::size_t>::max();
+    }
+    const float split_threshold = params_.max_screen_error;
+    const float merge_threshold = params_.max_screen_error * kLodMergeHysteresis;
+    const auto split_order = [](const LodCandidate& a, const LodCandidate& b) {
+        return a.priority < b.priority;  // Largest error on top
+    };
+    const auto merge_order = [](const LodCandidate& a, const LodCandidate& b) {
+        return a.priority > b.priority;  // Smallest error on top
+    };
+
+    // Parents whose children are all leaves, found through their first child
+    lod_merge_queue_.clear();
+    for (const std::uint32_t leaf : lod_slot_nodes_) {
+        const std::uint32_t parent = lod_nodes_[leaf].parent;
+        if (parent != kNoLodNode && lod_nodes_[parent].first_child == leaf &&
+            CanMergeLodNode(parent)) {
+            lod_merge_queue_.push_back({LodPriority(lod_nodes_[parent], view), parent});
+        }
+    }
+    std::make_heap(lod_merge_queue_.begin(), lod_merge_queue_.end(), merge_order);
+
+    // Coarsen first, freeing budget for refinement. Candidates below the
+    // merge threshold are used up here; the rest can still be traded for
+    // higher-priority splits once the budget is reached.
+    std::size_t operations = 0;
+    std::size_t merges = 0;
+    while (!lod_merge_queue_.empty() && operations < max_operations &&
+           lod_merge_queue_.front().priority < merge_threshold) {
+        std::pop_heap(lod_merge_queue_.begin(), lod_merge_queue_.end(), merge_order);
+        const std::uint32_t node = lod_merge_queue_.back().node;
+        lod_merge_queue_.pop_back();
+        if (!CanMergeLodNode(node)) {
+            continue;
+        }
+        MergeLodNode(node, view);
+        ++operations;
+        ++merges;
+
+        const std::uint32_t parent = lod_nodes_[node].parent;
+        if (parent != kNoLodNode && CanMergeLodNode(parent)) {
+            lod_merge_queue_.push_back({LodPriority(lod_nodes_[parent], view), parent});
+            std::push_heap(lod_merge_queue_.begin(), lod_merge_queue_.end(), merge_order);
+        }
+    }
+
+    // Leaves above the threshold, built after merging so merged parents
+    // are not split again in the same frame
+    lod_split_queue_.clear();
+    for (std::size_t slot = 0; slot < triangles_.size(); ++slot) {
+        const GlobeTriangle& triangle = triangles_[slot];
+        const float priority = triangle.visible ? triangle.screen_error : 0.0f;
+        if (priority > split_threshold && triangle.lod_level < params_.max_subdivision_level) {
+            lod_split_queue_.push_back({priority, lod_slot_nodes_[slot]});
+        }
+    }
+    std::make_heap(lod_split_queue_.begin(), lod_split_queue_.end(), split_order);
+
+    std::size_t splits = 0;
+    while (!lod_split_queue_.empty() && operations < max_operations) {
+        std::pop_heap(lod_split_queue_.begin(), lod_split_queue_.end(), split_order);
+        const LodCandidate candidate = lod_split_queue_.back();
+        lod_split_queue_.pop_back();
+        // Skip nodes split by a neighbor or merged away since being queued
+        const LodNode& target = lod_nodes_[candidate.node];
+        if (target.slot == kNoLodNode) {
+            continue;
+        }
+
+        const std::size_t operations_before = operations;
+        const std::size_t merges_before = merges;
+        bool split = SplitLodNode(candidate.node, view, operations);
+        // At the budget, trade the lowest-error sibling groups for this split
+        while (!split && !lod_merge_queue_.empty() && operations < max_operations &&
+               lod_merge_queue_.front().priority < candidate.priority * kLodMergeHysteresis) {
+            std::pop_heap(lod_merge_queue_.begin(), lod_merge_queue_.end(), merge_order);
+            const std::uint32_t node = lod_merge_queue_.back().node;
+            lod_merge_queue_.pop_back();
+            if (node == lod_nodes_[candidate.node].parent || !CanMergeLodNode(node)) {
+                continue;
+            }
+            MergeLodNode(node, view);
+            ++operations;
+            ++merges;
+            split = SplitLodNode(candidate.node, view, operations);
+        }
+        if (!split) {
+            break;  // Triangle budget reached
+        }
+        splits += operations - operations_before - (merges - merges_before);
+
+        // Keep refining the children within this frame while they need it
+        const std::uint32_t first_child = lod_nodes_[candidate.node].first_child;
+        for (std::uint32_t child = first_child; child < first_child + 4; ++child) {
+            const GlobeTriangle& triangle = triangles_[lod_nodes_[child].slot];
+            const float priority = triangle.visible ? triangle.screen_error : 0.0f;
+            if (priority > split_threshold && triangle.lod_level < params_.max_subdivision_level) {
+                lod_split_queue_.push_back({priority, child});
+                std::push_heap(lod_split_queue_.begin(), lod_split_queue_.end(), split_order);
+            }
+        }
+    }
+
+    if (splits > 0 || merges > 0) {
+        spdlog::debug("Adaptive LOD: {} splits, {} merges, {} triangles",
+                      splits, merges, triangles_.size());
+    }
+}
+
+bool IcosahedronGlobeMesh::SplitLodNode(std::uint32_t node, const LodView& view,
+                                        std::size_t& operations) {
+    // Children may differ by at most one level from their neighbors
+    for (int edge = 0; edge < 3; ++edge) {
+        const std::uint32_t a = lod_nodes_[node].vertices[edge];
+        const std::uint32_t b = lod_nodes_[node].vertices[(edge + 1) % 3];
+        if (LodEdgePartner(a, b, node) != kNoLodNode || IsLodEdgeSplit(a, b)) {
+            continue;
+        }
+        const std::uint32_t neighbor = CoarserLodNeighbor(node, edge);
+        if (neighbor == kNoLodNode || !SplitLodNode(neighbor, view, operations)) {
+            return false;
+        }
+    }
+    if (triangles_.size() + 3 > params_.lod_triangle_budget) {
+        return false;
+    }
+
+    const std::array<std::uint32_t, 3> v = lod_nodes_[node].vertices;
+    std::array<std::uint32_t, 3> mid;
+    for (int edge = 0; edge < 3; ++edge) {
+        mid[edge] = static_cast<std::uint32_t>(CreateMidpointVertex(v[edge], v[(edge + 1) % 3]));
+        // Same-level neighbors now fan out to the new midpoint
+        const std::uint32_t partner = LodEdgePartner(v[edge], v[(edge + 1) % 3], node);
+        if (partner != kNoLodNode) {
+            lod_dirty_nodes_.push_back(partner);
+        }
+    }
+
+    std::uint32_t first_child;
+    if (!lod_free_blocks_.empty()) {
+        first_child = lod_free_blocks_.back();
+        lod_free_blocks_.pop_back();
+    } else {
+        first_child = static_cast<std::uint32_t>(lod_nodes_.size());
+        lod_nodes_.resize(lod_nodes_.size() + 4);
+    }
+
+    // Same layout as SubdivideToLevel(): three corners, then the center
+    const std::array<std::array<std::uint32_t, 3>, 4> children = {{
+        {v[0], mid[0], mid[2]},
+        {mid[0], v[1], mid[1]},
+        {mid[2], mid[1], v[2]},
+        {mid[0], mid[1], mid[2]}
+    }};
+    const std::uint32_t slot = lod_nodes_[node].slot;
+    UnregisterLodEdges(node);
+    lod_nodes_[node].slot = kNoLodNode;
+    lod_nodes_[node].first_child = first_child;
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        LodNode& child = lod_nodes_[first_child + i];
+        child.vertices = children[i];
+        child.parent = node;
+        child.first_child = kNoLodNode;
+        child.level = static_cast<std::uint8_t>(lod_nodes_[node].level + 1);
+        AddLodLeaf(first_child + i, i == 0 ? slot : kNoLodNode, view);
+    }
+    ++operations;
+    return true;
+}
+
+void IcosahedronGlobeMesh::MergeLodNode(std::uint32_t node, const LodView& view) {
+    const std::uint32_t first_child = lod_nodes_[node].first_child;
+
+    // Neighbors at the node's level stop fanning to the children's
+    // midpoints; neighbors at the children's level start fanning
+    const std::array<std::uint32_t, 3> v = lod_nodes_[node].vertices;
+    for (int edge = 0; edge < 3; ++edge) {
+        const std::uint32_t a = v[edge];
+        const std::uint32_t b = v[(edge + 1) % 3];
+        const std::uint32_t mid = midpoint_cache_.find(EdgeKey(a, b))->second;
+        for (const std::uint64_t key : {EdgeKey(a, b), EdgeKey(a, mid), EdgeKey(mid, b)}) {
+            const auto it = lod_edges_.find(key);
+            if (it == lod_edges_.end()) {
+                continue;
+            }
+            for (const std::uint32_t owner : it->second) {
+                if (owner != kNoLodNode && (owner < first_child || owner >= first_child + 4)) {
+                    lod_dirty_nodes_.push_back(owner);
+                }
+            }
+        }
+    }
+
+    std::array<std::uint32_t, 3> released_slots;
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        LodNode& child = lod_nodes_[first_child + i];
+        UnregisterLodEdges(first_child + i);
+        if (i > 0) {
+            released_slots[i - 1] = child.slot;
+        }
+    }
+    const std::uint32_t slot = lod_nodes_[first_child].slot;
+    for (std::uint32_t i = 0; i < 4; ++i) {
+        // Released nodes are not reused until the end of the frame, so
+        // queued candidates referring to them can be recognized and skipped
+        lod_nodes_[first_child + i] = LodNode{};
+    }
+    lod_released_blocks_.push_back(first_child);
+
+    lod_nodes_[node].first_child = kNoLodNode;
+    AddLodLeaf(node, slot, view);
+
+    // Fill the freed slots from the end, highest first
+    std::sort(released_slots.begin(), released_slots.end(), std::greater<>());
+    for (const std::uint32_t released : released_slots) {
+        ReleaseLodSlot(released);
+    }
+}
+
+bool IcosahedronGlobeMesh::CanMergeLodNode(std::uint32_t node) const {
+    const LodNode& parent = lod_nodes_[node];
+    if (parent.first_child == kNoLodNode) {
+        return false;
+    }
+    for (std::uint32_t child = parent.first_child; child < parent.first_child + 4; ++child) {
+        if (lod_nodes_[child].first_child != kNoLodNode) {
+            return false;
+        }
+    }
+    // After merging, no neighbor may be more than one level finer
+    for (int edge = 0; edge < 3; ++edge) {
+        const std::uint32_t a = parent.vertices[edge];
+        const std::uint32_t b = parent.vertices[(edge + 1) % 3];
+        const std::uint32_t mid = midpoint_cache_.find(EdgeKey(a, b))->second;
+        if (IsLodEdgeSplit(a, mid) || IsLodEdgeSplit(mid, b)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+float IcosahedronGlobeMesh::LodPriority(const LodNode& node, const LodView& view) const {
+    const glm::vec3& a = vertices_[node.vertices[0]].position;
+    const glm::vec3& b = vertices_[node.vertices[1]].position;
+    const glm::vec3& c = vertices_[node.vertices[2]].position;
+    const glm::vec3 center = (a + b + c) / 3.0f;
+    const bool facing = glm::dot(glm::normalize(view.camera_position - center),
+                                 glm::normalize(center)) > -0.2f;
+    if (!facing ||
+        !view.frustum.Intersects(BoundingBox(glm::min(a, glm::min(b, c)),
+                                             glm::max(a, glm::max(b, c))))) {
+        return 0.0f;
+    }
+
+    GlobeTriangle triangle;
+    std::copy(node.vertices.begin(), node.vertices.end(), triangle.vertices);
+    return CalculateScreenError(triangle, view.camera_position, view.view_matrix,
+                                view.projection_matrix, view.viewport_size);
+}
+
+void IcosahedronGlobeMesh::AddLodLeaf(std::uint32_t node, std::uint32_t slot,
+                                      const LodView& view) {
+    GlobeTriangle triangle;
+    std::copy(lod_nodes_[node].vertices.begin(), lod_nodes_[node].vertices.end(),
+              triangle.vertices);
+    triangle.lod_level = lod_nodes_[node].level;
+    triangle.bounds = CalculateTriangleBounds(triangle);
+    triangle.screen_error = LodPriority(lod_nodes_[node], view);
+    triangle.visible = triangle.screen_error > 0.0f;
+
+    if (slot == kNoLodNode) {
+        slot = static_cast<std::uint32_t>(triangles_.size());
+        triangles_.push_back(triangle);
+        lod_slot_nodes_.push_back(node);
+    } else {
+        triangles_[slot] = triangle;
+        lod_slot_nodes_[slot] = node;
+    }
+    lod_nodes_[node].slot = slot;
+    RegisterLodEdges(node);
+    lod_dirty_nodes_.push_back(node);
+}
+
+void IcosahedronGlobeMesh::ReleaseLodSlot(std::uint32_t slot) {
+    const std::uint32_t last = static_cast<std::uint32_t>(triangles_.size() - 1);
+    if (slot != last) {
+        triangles_[slot] = triangles_[last];
+        lod_slot_nodes_[slot] = lod_slot_nodes_[last];
+        lod_nodes_[lod_slot_nodes_[slot]].slot = slot;
+        lod_dirty_nodes_.push_back(lod_slot_nodes_[slot]);
+    }
+    triangles_.pop_back();
+    lod_slot_nodes_.pop_back();
+}
+
+void IcosahedronGlobeMesh::RegisterLodEdges(std::uint32_t node) {
+    const std::array<std::uint32_t, 3>& v = lod_nodes_[node].vertices;
+    for (int edge = 0; edge < 3; ++edge) {
+        auto [it, inserted] = lod_edges_.try_emplace(EdgeKey(v[edge], v[(edge + 1) % 3]),
+                                                     std::array<std::uint32_t, 2>{kNoLodNode, kNoLodNode});
+        (it->second[0] == kNoLodNode ? it->second[0] : it->second[1]) = node;
+    }
+}
+
+void IcosahedronGlobeMesh::UnregisterLodEdges(std::uint32_t node) {
+    const std::array<std::uint32_t, 3>& v = lod_nodes_[node].vertices;
+    for (int edge = 0; edge < 3; ++edge) {
+        const std::uint64_t key = EdgeKey(v[edge], v[(edge + 1) % 3]);
+        auto it = lod_edges_.find(key);
+        if (it == lod_edges_.end()) {
+            continue;
+        }
+        std::array<std::uint32_t, 2>& owners = it->second;
+        if (owners[0] == node) {
+            owners[0] = owners[1];
+        }
+        owners[1] = kNoLodNode;
+        if (owners[0] == kNoLodNode) {
+            lod_edges_.erase(key);
+        }
+    }
+}
+
+std::uint32_t IcosahedronGlobeMesh::LodEdgePartner(std::uint32_t a, std::uint32_t b,
+                                                   std::uint32_t node) const {
+    const auto it = lod_edges_.find(EdgeKey(a, b));
+    if (it == lod_edges_.end()) {
+        return kNoLodNode;
+    }
+    return it->second[0] == node ? it->second[1] : it->second[0];
+}
+
+bool IcosahedronGlobeMesh::IsLodEdgeSplit(std::uint32_t a, std::uint32_t b) const {
+    // Halves of the edge belong to leaves only while the far side is finer;
+    // the midpoint vertex itself outlives merges
+    const auto mid = midpoint_cache_.find(EdgeKey(a, b));
+    return mid != midpoint_cache_.end() && lod_edges_.contains(EdgeKey(a, mid->second));
+}
+
+std::uint32_t IcosahedronGlobeMesh::CoarserLodNeighbor(std::uint32_t node, int edge) const {
+    const LodNode& child = lod_nodes_[node];
+    if (child.parent == kNoLodNode) {
+        return kNoLodNode;
+    }
+    // The edge is half of a parent edge; the coarser leaf owns the whole one
+    const std::uint64_t key = EdgeKey(child.vertices[edge], child.vertices[(edge + 1) % 3]);
+    const LodNode& parent = lod_nodes_[child.parent];
+    for (int parent_edge = 0; parent_edge < 3; ++parent_edge) {
+        const std::uint32_t a = parent.vertices[parent_edge];
+        const std::uint32_t b = parent.vertices[(parent_edge + 1) % 3];
+        const std::uint32_t mid = midpoint_cache_.find(EdgeKey(a, b))->second;
+        if (key == EdgeKey(a, mid) || key == EdgeKey(mid, b)) {
+            return LodEdgePartner(a, b, kNoLodNode);
+        }
+    }
+    return kNoLodNode;
+}
+
+void IcosahedronGlobeMesh::WriteLodIndices(std::uint32_t node) {
+    const std::array<std::uint32_t, 3>& v = lod_nodes_[node].vertices;
+    std::array<std::uint32_t, 3> mid;
+    int split_count = 0;
+    int split_edge = 0;
+    int whole_edge = 0;
+    for (int edge = 0; edge < 3; ++edge) {
+        const std::uint32_t a = v[edge];
+        const std::uint32_t b = v[(edge + 1) % 3];
+        if (IsLodEdgeSplit(a, b)) {
+            mid[edge] = midpoint_cache_.find(EdgeKey(a, b))->second;
+            split_edge = edge;
+            ++split_count;
+        } else {
+            mid[edge] = kNoLodNode;
+            whole_edge = edge;
+        }
+    }
+
+    std::uint32_t* out = vertex_indices_.data() + lod_nodes_[node].slot * kIndicesPerLodTriangle;
+    std::size_t written = 0;
+    const auto emit = [&](std::uint32_t a, std::uint32_t b, std::uint32_t c) {
+        out[written++] = a;
+        out[written++] = b;
+        out[written++] = c;
+    };
+    // Sub-triangles keep the winding of the leaf
+    switch (split_count) {
+        case 0:
+            emit(v[0], v[1], v[2]);
+            break;
+        case 1: {
+            const int i = split_edge;
+            emit(v[i], mid[i], v[(i + 2) % 3]);
+            emit(mid[i], v[(i + 1) % 3], v[(i + 2) % 3]);
+            break;
+        }
+        case 2: {
+            // Edges r and r + 1 are split and meet at vertex r + 1
+            const int r = (whole_edge + 1) % 3;
+            emit(v[r], mid[r], mid[(r + 1) % 3]);
+            emit(mid[r], v[(r + 1) % 3], mid[(r + 1) % 3]);
+            emit(v[r], mid[(r + 1) % 3], v[(r + 2) % 3]);
+            break;
+        }
+        default:
+            emit(v[0], mid[0], mid[2]);
+            emit(mid[0], v[1], mid[1]);
+            emit(mid[2], mid[1], v[2]);
+            emit(mid[0], mid[1], mid[2]);
+            break;
+    }
+    // Pad with degenerate triangles, which the GPU discards
+    while (written < kIndicesPerLodTriangle) {
+        out[written++] = v[0];
+    }
+}
+
+void IcosahedronGlobeMesh::FlushLodChanges(std::size_t first_new_vertex) {
+    if (elevation_manager_ && vertices_.size() > first_new_vertex) {
+        std::vector<GlobeVertex> added(vertices_.begin() + static_cast<std::ptrdiff_t>(first_new_vertex),
+                                       vertices_.end());
+        elevation_manager_->ApplyElevationToMesh(added, params_.radius);
+        elevation_manager_->GenerateNormals(added);
+        std::copy(added.begin(), added.end(),
+                  vertices_.begin() + static_cast<std::ptrdiff_t>(first_new_vertex));
+    }
+
+    lod_free_blocks_.insert(lod_free_blocks_.end(), lod_released_blocks_.begin(),
+                            lod_released_blocks_.end());
+    lod_released_blocks_.clear();
+
+    // Rewrite the blocks of dirty nodes that are still leaves
+    vertex_indices_.resize(triangles_.size() * kIndicesPerLodTriangle);
+    std::vector<std::uint32_t> slots;
+    slots.reserve(lod_dirty_nodes_.size());
+    for (const std::uint32_t node : lod_dirty_nodes_) {
+        if (lod_nodes_[node].slot != kNoLodNode) {
+            slots.push_back(lod_nodes_[node].slot);
+        }
+    }
+    lod_dirty_nodes_.clear();
+    std::sort(slots.begin(), slots.end());
+    slots.erase(std::unique(slots.begin(), slots.end()), slots.end());
+
+    for (std::size_t i = 0; i < slots.size(); ++i) {
+        WriteLodIndices(lod_slot_nodes_[slots[i]]);
+        if (i > 0 && slots[i] == slots[i - 1] + 1) {
+            dirty_index_ranges_.back().count += kIndicesPerLodTriangle;
+        } else {
+            dirty_index_ranges_.push_back({slots[i] * kIndicesPerLodTriangle, kIndicesPerLodTriangle});
+        }
+    }
+}
+
+const std::vector<GlobeIndexRange>& IcosahedronGlobeMesh::GetDirtyIndexRanges() const {
+    return dirty_index_ranges_;
+}
+
 float IcosahedronGlobeMesh::CalculateScreenError(const GlobeTriangle& triangle,
                                                  const glm::vec3& camera_position,
                                                  const glm::mat4& view_matrix,
@@ -530,10 +1364,31 @@ const std::vector<GlobeTriangle>& IcosahedronGlobeMesh::GetTriangles() const {
     return triangles_;
 }
 
-std::vector<std::uint32_t> IcosahedronGlobeMesh::GetVertexIndices() const {
+const std::vector<std::uint32_t>& IcosahedronGlobeMesh::GetVertexIndices() const {
     return vertex_indices_;
 }
 
+const std::vector<std::uint16_t>& IcosahedronGlobeMesh::GetVertexIndices16() const {
+    return vertex_indices16_;
+}
+
+const std::vector<GlobeIndexChunk>& IcosahedronGlobeMesh::GetIndexChunks() const {
+    return index_chunks_;
+}
+
+std::uint64_t IcosahedronGlobeMesh::GetRevision() const {
+    return revision_;
+}
+
+std::uint64_t IcosahedronGlobeMesh::GetDirtyBaseRevision() const {
+    return dirty_base_revision_;
+}
+
+void IcosahedronGlobeMesh::MarkMeshReplaced() {
+    ++revision_;
+    dirty_base_revision_ = kNoBaseRevision;
+}
+
 GlobeMeshParams IcosahedronGlobeMesh::GetParameters() const {
     return params_;
 }
@@ -570,6 +1425,16 @@ std::pair<std::size_t, std::size_t> IcosahedronGlobeMesh::GetStatistics() const
     return {vertices_.size(), triangles_.size()};
 }
 
+GlobeMeshStatistics IcosahedronGlobeMesh::GetDetailedStatistics() const {
+    GlobeMeshStatistics stats;
+    stats.vertex_count = vertices_.size();
+    stats.triangle_count = triangles_.size();
+    stats.acmr_before = acmr_before_;
+    stats.acmr_after = acmr_after_;
+    stats.index_chunks = index_chunks_.size();
+    return stats;
+}
+
 bool IcosahedronGlobeMesh::Validate() const {
     // Check basic mesh integrity
     if (vertices_.empty() || triangles_.empty()) {
@@ -606,12 +1471,130 @@ bool IcosahedronGlobeMesh::Validate() const {
 }
 
 bool IcosahedronGlobeMesh::Optimize() {
-    // TODO: Implement vertex cache optimization
-    // For now, just generate vertex indices
+    vertex_indices16_.clear();
+    index_chunks_.clear();
     GenerateVertexIndices();
+    if (!lod_nodes_.empty()) {
+        // Adaptive LOD blocks keep their slots for incremental index updates
+        acmr_before_ = acmr_after_ = AnalyzeVertexCache(vertex_indices_, vertices_.size());
+        MarkMeshReplaced();
+        return true;
+    }
+
+    acmr_before_ = AnalyzeVertexCache(vertex_indices_, vertices_.size());
+    OptimizeVertexOrder();
+    GenerateVertexIndices();
+    acmr_after_ = AnalyzeVertexCache(vertex_indices_, vertices_.size());
+    BuildIndexChunks();
+    MarkMeshReplaced();
+
+    spdlog::info("Mesh optimized: ACMR {:.3f} -> {:.3f}, {} 16-bit index chunks",
+                 acmr_before_, acmr_after_, index_chunks_.size());
     return true;
 }
 
+void IcosahedronGlobeMesh::OptimizeVertexOrder() {
+    // Static meshes hold the faces' triangles in 20 equal runs; each run is
+    // reordered on its own, so faces can go to different threads
+    const std::size_t face_count = kIcosahedronFaces.size();
+    const std::size_t run_count = triangles_.size() % face_count == 0 ? face_count : 1;
+    const std::size_t run_length = triangles_.size() / run_count;
+    const std::size_t chunk_count = params_.max_subdivision_level < kParallelSubdivisionLevel
+        ? 1 : std::min<std::size_t>(run_count, std::max(1u, std::thread::hardware_concurrency()));
+    const auto work = [&](std::size_t chunk) {
+        for (std::size_t run = chunk; run < run_count; run += chunk_count) {
+            OptimizeTriangleOrder(std::span<GlobeTriangle>(triangles_).subspan(run * run_length, run_length));
+        }
+    };
+    std::vector<std::future<void>> tasks;
+    for (std::size_t chunk = 1; chunk < chunk_count; ++chunk) {
+        tasks.push_back(std::async(std::launch::async, work, chunk));
+    }
+    work(0);
+    for (std::future<void>& task : tasks) {
+        task.get();
+    }
+
+    // Vertices in first-use order, after the corners
+    constexpr std::uint32_t kUnassigned = std::numeric_limits<std::uint32_t>::max();
+    const std::size_t pinned = std::min<std::size_t>(12, vertices_.size());
+    std::vector<std::uint32_t> remap(vertices_.size(), kUnassigned);
+    for (std::uint32_t i = 0; i < pinned; ++i) {
+        remap[i] = i;
+    }
+    std::uint32_t next = static_cast<std::uint32_t>(pinned);
+    for (GlobeTriangle& triangle : triangles_) {
+        for (std::uint32_t& index : triangle.vertices) {
+            if (remap[index] == kUnassigned) {
+                remap[index] = next++;
+            }
+            index = remap[index];
+        }
+    }
+    // Unreferenced vertices go last
+    for (std::uint32_t& target : remap) {
+        if (target == kUnassigned) {
+            target = next++;
+        }
+    }
+
+    std::vector<GlobeVertex> reordered(vertices_.size());
+    for (std::size_t i = 0; i < vertices_.size(); ++i) {
+        reordered[remap[i]] = vertices_[i];
+    }
+    vertices_ = std::move(reordered);
+    for (auto& [edge, midpoint] : midpoint_cache_) {
+        midpoint = remap[midpoint];
+    }
+}
+
+void IcosahedronGlobeMesh::BuildIndexChunks() {
+    vertex_indices16_.clear();
+    index_chunks_.clear();
+    if (vertex_indices_.empty()) {
+        return;
+    }
+
+    // Greedy: a chunk grows while its vertices span at most 65536 indices
+    const std::size_t max_chunks = kMaxIndexChunksPerFace * kIcosahedronFaces.size();
+    std::size_t chunk_begin = 0;
+    std::uint32_t low = std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t high = 0;
+    const auto close_chunk = [&](std::size_t end) {
+        index_chunks_.push_back({chunk_begin, end - chunk_begin, low});
+        chunk_begin = end;
+    };
+    for (std::size_t i = 0; i < vertex_indices_.size(); i += 3) {
+        const std::uint32_t* tri = &vertex_indices_[i];
+        const std::uint32_t tri_low = std::min({tri[0], tri[1], tri[2]});
+        const std::uint32_t tri_high = std::max({tri[0], tri[1], tri[2]});
+        if (static_cast<std::size_t>(std::max(high, tri_high)) - std::min(low, tri_low) >= kIndexChunkVertices) {
+            if (static_cast<std::size_t>(tri_high) - tri_low >= kIndexChunkVertices) {
+                index_chunks_.clear();  // No chunk can hold this triangle
+                return;
+            }
+            close_chunk(i);
+            if (index_chunks_.size() >= max_chunks) {
+                index_chunks_.clear();
+                return;
+            }
+            low = tri_low;
+            high = tri_high;
+        } else {
+            low = std::min(low, tri_low);
+            high = std::max(high, tri_high);
+        }
+    }
+    close_chunk(vertex_indices_.size());
+
+    vertex_indices16_.resize(vertex_indices_.size());
+    for (const GlobeIndexChunk& chunk : index_chunks_) {
+        for (std::size_t i = chunk.first; i < chunk.first + chunk.count; ++i) {
+            vertex_indices16_[i] = static_cast<std::uint16_t>(vertex_indices_[i] - chunk.base_vertex);
+        }
+    }
+}
+
 BoundingBox2D IcosahedronGlobeMesh::CalculateBounds() const {
     if (vertices_.empty()) {
         return BoundingBox2D();
@@ -676,6 +1659,10 @@ void IcosahedronGlobeMesh::SetElevationManager(std::shared_ptr<ElevationManager>
     spdlog::info("Elevation manager set for globe mesh");
 }
 
+void IcosahedronGlobeMesh::SetMeshCache(std::shared_ptr<GlobeMeshCache> cache) {
+    mesh_cache_ = std::move(cache);
+}
+
 void IcosahedronGlobeMesh::ApplyElevation() {
     if (!elevation_manager_) {
         spdlog::warn("ApplyElevation called but elevation manager is not set");
@@ -0,0 +1,235 @@
+/**
+ * @file globe_mesh_cache.cpp
+ * @brief On-disk globe mesh cache implementation
+ */
+
+#include <earth_map/renderer/globe_mesh_cache.h>
+#include <earth_map/data/crc32c.h>
+#include <spdlog/spdlog.h>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace earth_map {
+
+namespace {
+
+static_assert(std::is_trivially_copyable_v<GlobeVertex> &&
+              std::is_trivially_copyable_v<GlobeTriangle> &&
+              std::is_trivially_copyable_v<GlobeIndexChunk>,
+              "Mesh arrays are written in their in-memory layout");
+
+constexpr std::uint32_t kMagic = 0x4d474d45;  // "EMGM"
+constexpr std::uint32_t kFileVersion = 1;
+
+/// File header, followed by the vertex, triangle, index, 16-bit index and chunk arrays
+struct FileHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t vertex_size;
+    std::uint32_t triangle_size;
+    std::uint32_t chunk_size;
+    std::uint32_t checksum;  ///< CRC32C of the arrays
+    std::uint64_t key;
+    std::uint64_t vertex_count;
+    std::uint64_t triangle_count;
+    std::uint64_t index_count;
+    std::uint64_t index16_count;
+    std::uint64_t chunk_count;
+    float acmr_before;
+    float acmr_after;
+};
+
+constexpr std::uint64_t kFnvOffset = 14695981039346656037ULL;
+constexpr std::uint64_t kFnvPrime = 1099511628211ULL;
+
+template <typename T>
+std::uint64_t HashValue(const T& value, std::uint64_t hash) {
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        hash ^= bytes[i];
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+template <typename T>
+std::span<const std::uint8_t> AsBytes(std::span<const T> values) {
+    return {reinterpret_cast<const std::uint8_t*>(values.data()), values.size_bytes()};
+}
+
+std::uint32_t Checksum(const GlobeMeshArraysView& mesh) {
+    std::uint32_t crc = Crc32c(AsBytes(mesh.vertices));
+    crc = Crc32c(AsBytes(mesh.triangles), crc);
+    crc = Crc32c(AsBytes(mesh.indices), crc);
+    crc = Crc32c(AsBytes(mesh.indices16), crc);
+    return Crc32c(AsBytes(mesh.index_chunks), crc);
+}
+
+/// Copy @p count elements from @p cursor into @p out and advance the cursor
+template <typename T>
+void ReadArray(const std::uint8_t*& cursor, std::uint64_t count, std::vector<T>& out) {
+    out.resize(count);
+    std::memcpy(out.data(), cursor, count * sizeof(T));
+    cursor += count * sizeof(T);
+}
+
+} // namespace
+
+GlobeMeshCache::GlobeMeshCache(std::string directory)
+    : directory_(std::move(directory)) {
+}
+
+std::uint64_t GlobeMeshCache::MakeKey(const GlobeMeshParams& params) {
+    // Fields are hashed one by one: struct padding is indeterminate
+    std::uint64_t hash = kFnvOffset;
+    hash = HashValue(kFileVersion, hash);
+    hash = HashValue(static_cast<std::uint32_t>(sizeof(GlobeVertex)), hash);
+    hash = HashValue(static_cast<std::uint32_t>(sizeof(GlobeTriangle)), hash);
+    hash = HashValue(params.radius, hash);
+    hash = HashValue(params.max_subdivision_level, hash);
+    hash = HashValue(params.base_vertices, hash);
+    hash = HashValue(params.enable_adaptive, hash);
+    hash = HashValue(params.max_screen_error, hash);
+    hash = HashValue(params.quality, hash);
+    hash = HashValue(params.enable_crack_prevention, hash);
+    hash = HashValue(params.min_coastal_level, hash);
+    return HashValue(params.max_edge_length, hash);
+}
+
+std::optional<GlobeMeshArrays> GlobeMeshCache::Load(std::uint64_t key) const {
+    const std::string path = GetPath(key);
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+    struct stat file_stat {};
+    if (::fstat(fd, &file_stat) != 0 ||
+        static_cast<std::size_t>(file_stat.st_size) < sizeof(FileHeader)) {
+        ::close(fd);
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+    const auto size = static_cast<std::size_t>(file_stat.st_size);
+    void* address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (address == MAP_FAILED) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+    // Every array is copied out front to back
+    ::madvise(address, size, MADV_SEQUENTIAL);
+
+    FileHeader header{};
+    std::memcpy(&header, address, sizeof(header));
+    // Counts beyond the file size would overflow the size check
+    const bool counts_fit = header.vertex_count <= size && header.triangle_count <= size &&
+                            header.index_count <= size && header.index16_count <= size &&
+                            header.chunk_count <= size;
+    const std::uint64_t expected_size = sizeof(FileHeader) +
+        header.vertex_count * sizeof(GlobeVertex) +
+        header.triangle_count * sizeof(GlobeTriangle) +
+        header.index_count * sizeof(std::uint32_t) +
+        header.index16_count * sizeof(std::uint16_t) +
+        header.chunk_count * sizeof(GlobeIndexChunk);
+
+    std::optional<GlobeMeshArrays> mesh;
+    if (header.magic == kMagic && header.version == kFileVersion && header.key == key &&
+        header.vertex_size == sizeof(GlobeVertex) &&
+        header.triangle_size == sizeof(GlobeTriangle) &&
+        header.chunk_size == sizeof(GlobeIndexChunk) && counts_fit && expected_size == size) {
+        mesh.emplace();
+        const auto* cursor = static_cast<const std::uint8_t*>(address) + sizeof(FileHeader);
+        ReadArray(cursor, header.vertex_count, mesh->vertices);
+        ReadArray(cursor, header.triangle_count, mesh->triangles);
+        ReadArray(cursor, header.index_count, mesh->indices);
+        ReadArray(cursor, header.index16_count, mesh->indices16);
+        ReadArray(cursor, header.chunk_count, mesh->index_chunks);
+        mesh->acmr_before = header.acmr_before;
+        mesh->acmr_after = header.acmr_after;
+
+        const GlobeMeshArraysView view{mesh->vertices, mesh->triangles, mesh->indices,
+                                       mesh->indices16, mesh->index_chunks};
+        if (Checksum(view) != header.checksum) {
+            mesh.reset();
+        }
+    }
+    ::munmap(address, size);
+
+    if (!mesh) {
+        spdlog::warn("Discarding corrupt globe mesh cache file {}", path);
+        rejected_.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return mesh;
+}
+
+bool GlobeMeshCache::Store(std::uint64_t key, const GlobeMeshArraysView& mesh) const {
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+
+    const std::string path = GetPath(key);
+    const std::string temp_path =
+        path + ".tmp" + std::to_string(temp_counter_.fetch_add(1, std::memory_order_relaxed));
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        const FileHeader header{kMagic, kFileVersion,
+                                static_cast<std::uint32_t>(sizeof(GlobeVertex)),
+                                static_cast<std::uint32_t>(sizeof(GlobeTriangle)),
+                                static_cast<std::uint32_t>(sizeof(GlobeIndexChunk)),
+                                Checksum(mesh), key,
+                                mesh.vertices.size(), mesh.triangles.size(),
+                                mesh.indices.size(), mesh.indices16.size(),
+                                mesh.index_chunks.size(), mesh.acmr_before, mesh.acmr_after};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        const auto write = [&](std::span<const std::uint8_t> bytes) {
+            file.write(reinterpret_cast<const char*>(bytes.data()),
+                       static_cast<std::streamsize>(bytes.size()));
+        };
+        write(AsBytes(mesh.vertices));
+        write(AsBytes(mesh.triangles));
+        write(AsBytes(mesh.indices));
+        write(AsBytes(mesh.indices16));
+        write(AsBytes(mesh.index_chunks));
+        if (!file) {
+            file.close();
+            std::filesystem::remove(temp_path, error);
+            spdlog::warn("Cannot write globe mesh cache file {}", path);
+            return false;
+        }
+    }
+
+    // rename() replaces atomically: a concurrent Load() sees the old or the new file
+    std::filesystem::rename(temp_path, path, error);
+    if (error) {
+        std::filesystem::remove(temp_path, error);
+        return false;
+    }
+    stores_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+GlobeMeshCacheStats GlobeMeshCache::GetStats() const {
+    GlobeMeshCacheStats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.rejected = rejected_.load(std::memory_order_relaxed);
+    stats.stores = stores_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::string GlobeMeshCache::GetPath(std::uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.mesh", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(directory_) / name).string();
+}
+
+} // namespace earth_map
@@ -0,0 +1,82 @@
+/**
+ * @file globe_vertex_format.cpp
+ * @brief Packed GPU vertex layout for the globe mesh
+ */
+
+#include <earth_map/renderer/globe_vertex_format.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace earth_map {
+
+namespace {
+
+/// Sign that maps zero to +1, as in the shaders
+float SignNotZero(float value) {
+    return value >= 0.0f ? 1.0f : -1.0f;
+}
+
+std::int16_t ToSnorm16(float value) {
+    return static_cast<std::int16_t>(std::lround(std::clamp(value, -1.0f, 1.0f) * 32767.0f));
+}
+
+} // namespace
+
+std::array<std::int16_t, 2> EncodeOctahedralNormal(const glm::vec3& normal) {
+    const float l1 = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+    if (!(l1 > 0.0f)) {
+        return {0, 32767};  // Degenerate normal: +Y
+    }
+    float x = normal.x / l1;
+    float y = normal.y / l1;
+    // The lower hemisphere folds over the diagonals
+    if (normal.z < 0.0f) {
+        const float folded_x = (1.0f - std::abs(y)) * SignNotZero(x);
+        const float folded_y = (1.0f - std::abs(x)) * SignNotZero(y);
+        x = folded_x;
+        y = folded_y;
+    }
+    return {ToSnorm16(x), ToSnorm16(y)};
+}
+
+glm::vec3 DecodeOctahedralNormal(const std::array<std::int16_t, 2>& encoded) {
+    const float x = std::max(encoded[0] / 32767.0f, -1.0f);
+    const float y = std::max(encoded[1] / 32767.0f, -1.0f);
+    glm::vec3 normal(x, y, 1.0f - std::abs(x) - std::abs(y));
+    if (normal.z < 0.0f) {
+        normal.x = (1.0f - std::abs(y)) * SignNotZero(x);
+        normal.y = (1.0f - std::abs(x)) * SignNotZero(y);
+    }
+    return glm::normalize(normal);
+}
+
+glm::vec2 DirectionToMercator(const glm::vec3& direction) {
+    constexpr float kPi = 3.14159265358979f;
+    constexpr float kMaxLatitude = 1.48442222974871f;  // 85.05112878 degrees
+    const glm::vec3 unit = glm::normalize(direction);
+    const float lon = (unit.x == 0.0f && unit.z == 0.0f) ? 0.0f : std::atan2(unit.x, unit.z);
+    const float lat = std::clamp(std::asin(std::clamp(unit.y, -1.0f, 1.0f)),
+                                 -kMaxLatitude, kMaxLatitude);
+    return glm::vec2((lon + kPi) / (2.0f * kPi),
+                     (1.0f - std::log(std::tan(0.25f * kPi + 0.5f * lat)) / kPi) * 0.5f);
+}
+
+void PackGlobeVertices(std::span<const GlobeVertex> vertices,
+                       std::span<PackedGlobeVertex> packed) {
+    if (packed.size() != vertices.size()) {
+        throw std::invalid_argument("PackGlobeVertices: span sizes differ");
+    }
+    for (std::size_t i = 0; i < vertices.size(); ++i) {
+        packed[i].position = vertices[i].position;
+        packed[i].normal = EncodeOctahedralNormal(vertices[i].normal);
+    }
+}
+
+std::vector<PackedGlobeVertex> PackGlobeVertices(std::span<const GlobeVertex> vertices) {
+    std::vector<PackedGlobeVertex> packed(vertices.size());
+    PackGlobeVertices(vertices, packed);
+    return packed;
+}
+
+} // namespace earth_map
@@ -0,0 +1,176 @@
+/**
+ * @file gpu_frame_profiler.cpp
+ * @brief Implementation of the per-pass CPU/GPU frame timer
+ */
+
+#include <earth_map/renderer/gpu_frame_profiler.h>
+#include <GL/glew.h>
+
+#ifdef EARTH_MAP_HAVE_TRACY
+#include <tracy/Tracy.hpp>
+#endif
+
+namespace earth_map {
+
+namespace {
+
+constexpr std::array<const char*, kRenderPassCount> kPassNames = {
+    "uploads", "indirection_flush", "globe", "tile_feedback", "placemarks", "labels",
+    "mini_map"};
+
+#ifdef EARTH_MAP_HAVE_TRACY
+// Tracy keys plots by pointer: one literal per plot
+constexpr std::array<const char*, kRenderPassCount> kCpuPlotNames = {
+    "cpu uploads", "cpu indirection_flush", "cpu globe", "cpu tile_feedback",
+    "cpu placemarks", "cpu labels", "cpu mini_map"};
+constexpr std::array<const char*, kRenderPassCount> kGpuPlotNames = {
+    "gpu uploads", "gpu indirection_flush", "gpu globe", "gpu tile_feedback",
+    "gpu placemarks", "gpu labels", "gpu mini_map"};
+#endif
+
+double ElapsedMs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - since).count();
+}
+
+} // namespace
+
+const char* GetRenderPassName(RenderPass pass) {
+    return kPassNames[static_cast<std::size_t>(pass)];
+}
+
+GpuFrameProfiler::GpuFrameProfiler(bool use_timer_queries)
+    : use_timer_queries_(use_timer_queries) {
+    if (!use_timer_queries_) {
+        return;
+    }
+    for (QuerySet& set : query_sets_) {
+        for (PassQueries& queries : set) {
+            glGenQueries(1, &queries.begin);
+            glGenQueries(1, &queries.end);
+        }
+    }
+}
+
+GpuFrameProfiler::~GpuFrameProfiler() {
+    if (!use_timer_queries_) {
+        return;
+    }
+    for (QuerySet& set : query_sets_) {
+        for (PassQueries& queries : set) {
+            if (queries.begin != 0) {
+                glDeleteQueries(1, &queries.begin);
+            }
+            if (queries.end != 0) {
+                glDeleteQueries(1, &queries.end);
+            }
+        }
+    }
+}
+
+void GpuFrameProfiler::BeginFrame() {
+    CollectQueries();
+
+    frame_index_ = (frame_index_ + 1) % kQueryFrames;
+    for (PassQueries& queries : query_sets_[frame_index_]) {
+        queries.issued = false;
+    }
+    frame_cpu_ms_.fill(0.0);
+    frame_start_ = Clock::now();
+}
+
+void GpuFrameProfiler::EndFrame() {
+    cpu_frame_ms_ = ElapsedMs(frame_start_);
+    for (std::size_t pass = 0; pass < kRenderPassCount; ++pass) {
+        timings_[pass].cpu_ms = frame_cpu_ms_[pass];
+    }
+    PublishTracy();
+}
+
+void GpuFrameProfiler::BeginPass(RenderPass pass) {
+    const std::size_t index = static_cast<std::size_t>(pass);
+    pass_start_[index] = Clock::now();
+
+    // A set still in flight from two frames ago is skipped, not waited for;
+    // a pass entered again this frame keeps its first begin timestamp
+    PassQueries& queries = query_sets_[frame_index_][index];
+    if (use_timer_queries_ && !queries.pending && !queries.issued && queries.begin != 0) {
+        glQueryCounter(queries.begin, GL_TIMESTAMP);
+    }
+}
+
+void GpuFrameProfiler::EndPass(RenderPass pass) {
+    const std::size_t index = static_cast<std::size_t>(pass);
+    frame_cpu_ms_[index] += ElapsedMs(pass_start_[index]);
+
+    PassQueries& queries = query_sets_[frame_index_][index];
+    if (use_timer_queries_ && !queries.pending && queries.end != 0) {
+        glQueryCounter(queries.end, GL_TIMESTAMP);
+        queries.issued = true;
+    }
+}
+
+void GpuFrameProfiler::CollectQueries() {
+    if (!use_timer_queries_) {
+        return;
+    }
+
+    // Sets whose end timestamps were recorded become pending at frame end
+    for (PassQueries& queries : query_sets_[frame_index_]) {
+        queries.pending = queries.pending || queries.issued;
+    }
+
+    // Oldest set first, so the newest complete frame is reported last
+    for (std::size_t i = 1; i <= kQueryFrames; ++i) {
+        QuerySet& set = query_sets_[(frame_index_ + i) % kQueryFrames];
+
+        // Timestamps complete in order: the last one done means all are
+        std::size_t last = kRenderPassCount;
+        for (std::size_t pass = 0; pass < kRenderPassCount; ++pass) {
+            if (set[pass].pending) {
+                last = pass;
+            }
+        }
+        if (last == kRenderPassCount) {
+            continue;
+        }
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuiv(set[last].end, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE) {
+            continue;
+        }
+
+        double frame_gpu_ms = 0.0;
+        for (std::size_t pass = 0; pass <= last; ++pass) {
+            PassQueries& queries = set[pass];
+            if (!queries.pending) {
+                continue;
+            }
+            GLuint64 begin_ns = 0;
+            GLuint64 end_ns = 0;
+            glGetQueryObjectui64v(queries.begin, GL_QUERY_RESULT, &begin_ns);
+            glGetQueryObjectui64v(queries.end, GL_QUERY_RESULT, &end_ns);
+            queries.pending = false;
+
+            const double gpu_ms = end_ns > begin_ns
+                ? static_cast<double>(end_ns - begin_ns) / 1e6 : 0.0;
+            timings_[pass].gpu_ms = gpu_ms;
+            frame_gpu_ms += gpu_ms;
+        }
+        gpu_frame_ms_ = frame_gpu_ms;
+    }
+}
+
+void GpuFrameProfiler::PublishTracy() const {
+#ifdef EARTH_MAP_HAVE_TRACY
+    for (std::size_t pass = 0; pass < kRenderPassCount; ++pass) {
+        TracyPlot(kCpuPlotNames[pass], timings_[pass].cpu_ms);
+        if (use_timer_queries_) {
+            TracyPlot(kGpuPlotNames[pass], timings_[pass].gpu_ms);
+        }
+    }
+    FrameMark;
+#endif
+}
+
+} // namespace earth_map
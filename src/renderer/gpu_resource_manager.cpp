@@ -0,0 +1,253 @@
+/**
+ * @file gpu_resource_manager.cpp
+ * @brief GPU-resident globe mesh buffers
+ */
+
+#include <earth_map/renderer/gpu_resource_manager.h>
+#include <earth_map/renderer/globe_vertex_format.h>
+#include <GL/glew.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstddef>
+#include <unordered_map>
+
+namespace earth_map {
+
+namespace {
+
+/**
+ * @brief Buffer size for a full upload: exact at first, with headroom once
+ *        the mesh outgrew its buffer
+ */
+std::size_t GrowCapacity(std::size_t needed, std::size_t capacity) {
+    if (capacity == 0) {
+        return needed;
+    }
+    return needed <= capacity ? capacity : needed + needed / 2;
+}
+
+std::size_t IndexSize(std::uint32_t index_type) {
+    return index_type == GL_UNSIGNED_SHORT ? sizeof(std::uint16_t) : sizeof(std::uint32_t);
+}
+
+} // namespace
+
+class GPUResourceManagerImpl : public GPUResourceManager {
+public:
+    ~GPUResourceManagerImpl() override {
+        Release();
+    }
+
+    const GPUMesh* SyncGlobeMesh(const GlobeMesh& mesh) override {
+        stats_.last_sync_bytes = 0;
+        const auto it = meshes_.find(&mesh);
+        GPUMesh* gpu_mesh = it != meshes_.end() ? &it->second : nullptr;
+
+        switch (PlanSync(gpu_mesh, mesh)) {
+            case GPUMeshSync::CURRENT:
+                return gpu_mesh;
+            case GPUMeshSync::INCREMENTAL:
+                UploadChanges(*gpu_mesh, mesh);
+                ++stats_.incremental_uploads;
+                return gpu_mesh;
+            case GPUMeshSync::FULL:
+                break;
+        }
+
+        if (mesh.GetVertices().empty() || mesh.GetVertexIndices().empty()) {
+            spdlog::error("GPUResourceManager: globe mesh has no geometry");
+            return nullptr;
+        }
+        if (!gpu_mesh) {
+            gpu_mesh = &meshes_[&mesh];
+            CreateVertexArray(*gpu_mesh);
+        }
+        UploadAll(*gpu_mesh, mesh);
+        ++stats_.full_uploads;
+        return gpu_mesh;
+    }
+
+    const GPUMesh* GetGlobeMesh(const GlobeMesh& mesh) const override {
+        const auto it = meshes_.find(&mesh);
+        return it != meshes_.end() ? &it->second : nullptr;
+    }
+
+    void ReleaseGlobeMesh(const GlobeMesh& mesh) override {
+        const auto it = meshes_.find(&mesh);
+        if (it != meshes_.end()) {
+            DeleteBuffers(it->second);
+            meshes_.erase(it);
+        }
+    }
+
+    void Release() override {
+        for (auto& [mesh, gpu_mesh] : meshes_) {
+            DeleteBuffers(gpu_mesh);
+        }
+        meshes_.clear();
+    }
+
+    GPUResourceStats GetStats() const override {
+        GPUResourceStats stats = stats_;
+        stats.meshes = meshes_.size();
+        stats.buffer_bytes = 0;
+        for (const auto& [mesh, gpu_mesh] : meshes_) {
+            stats.buffer_bytes += gpu_mesh.vertex_capacity * sizeof(PackedGlobeVertex) +
+                                  gpu_mesh.index_capacity * IndexSize(gpu_mesh.index_type);
+        }
+        return stats;
+    }
+
+private:
+    static void CreateVertexArray(GPUMesh& gpu_mesh) {
+        glGenVertexArrays(1, &gpu_mesh.vao);
+        glGenBuffers(1, &gpu_mesh.vertex_buffer);
+        glGenBuffers(1, &gpu_mesh.index_buffer);
+
+        glBindVertexArray(gpu_mesh.vao);
+        glBindBuffer(GL_ARRAY_BUFFER, gpu_mesh.vertex_buffer);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gpu_mesh.index_buffer);
+
+        // Position (location = 0)
+        constexpr GLsizei stride = sizeof(PackedGlobeVertex);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride,
+                              (void*)offsetof(PackedGlobeVertex, position));
+        glEnableVertexAttribArray(0);
+
+        // Octahedral normal (location = 1)
+        glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, stride,
+                              (void*)offsetof(PackedGlobeVertex, normal));
+        glEnableVertexAttribArray(1);
+
+        glBindVertexArray(0);
+    }
+
+    static void DeleteBuffers(GPUMesh& gpu_mesh) {
+        if (gpu_mesh.vao != 0) {
+            glDeleteVertexArrays(1, &gpu_mesh.vao);
+        }
+        if (gpu_mesh.vertex_buffer != 0) {
+            glDeleteBuffers(1, &gpu_mesh.vertex_buffer);
+        }
+        if (gpu_mesh.index_buffer != 0) {
+            glDeleteBuffers(1, &gpu_mesh.index_buffer);
+        }
+        gpu_mesh = GPUMesh{};
+    }
+
+    void UploadAll(GPUMesh& gpu_mesh, const GlobeMesh& mesh) {
+        const std::vector<PackedGlobeVertex> vertices = PackGlobeVertices(mesh.GetVertices());
+        const auto& indices = mesh.GetVertexIndices();
+        const auto& indices16 = mesh.GetVertexIndices16();
+        const auto& chunks = mesh.GetIndexChunks();
+        const bool use_16bit = !chunks.empty() && indices16.size() == indices.size();
+        const std::uint32_t index_type = use_16bit ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+        // Index buffers are bound through the vertex array
+        glBindVertexArray(gpu_mesh.vao);
+
+        glBindBuffer(GL_ARRAY_BUFFER, gpu_mesh.vertex_buffer);
+        const std::size_t vertex_capacity = GrowCapacity(vertices.size(), gpu_mesh.vertex_capacity);
+        if (vertex_capacity != gpu_mesh.vertex_capacity) {
+            glBufferData(GL_ARRAY_BUFFER, vertex_capacity * sizeof(PackedGlobeVertex),
+                         nullptr, GL_DYNAMIC_DRAW);
+            gpu_mesh.vertex_capacity = vertex_capacity;
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(PackedGlobeVertex), vertices.data());
+
+        // A new index type needs a buffer of its own size
+        const std::size_t index_capacity = index_type == gpu_mesh.index_type
+            ? GrowCapacity(indices.size(), gpu_mesh.index_capacity) : indices.size();
+        if (index_capacity != gpu_mesh.index_capacity || index_type != gpu_mesh.index_type) {
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, index_capacity * IndexSize(index_type),
+                         nullptr, GL_DYNAMIC_DRAW);
+            gpu_mesh.index_capacity = index_capacity;
+        }
+        if (use_16bit) {
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indices16.size() * sizeof(std::uint16_t),
+                            indices16.data());
+            gpu_mesh.chunks = chunks;
+        } else {
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indices.size() * sizeof(std::uint32_t),
+                            indices.data());
+            gpu_mesh.chunks = {GlobeIndexChunk{0, indices.size(), 0}};
+        }
+        glBindVertexArray(0);
+
+        gpu_mesh.index_type = index_type;
+        gpu_mesh.vertex_count = vertices.size();
+        gpu_mesh.index_count = indices.size();
+        gpu_mesh.revision = mesh.GetRevision();
+        stats_.last_sync_bytes = vertices.size() * sizeof(PackedGlobeVertex) +
+                                 indices.size() * IndexSize(index_type);
+
+        spdlog::info("GPUResourceManager: uploaded globe mesh, {} vertices, {} {}-bit indices in {} chunks",
+                     gpu_mesh.vertex_count, gpu_mesh.index_count, use_16bit ? 16 : 32,
+                     gpu_mesh.chunks.size());
+    }
+
+    void UploadChanges(GPUMesh& gpu_mesh, const GlobeMesh& mesh) {
+        const auto& vertices = mesh.GetVertices();
+        const auto& indices = mesh.GetVertexIndices();
+        std::size_t bytes = 0;
+
+        if (vertices.size() > gpu_mesh.vertex_count) {
+            const std::vector<PackedGlobeVertex> appended = PackGlobeVertices(
+                std::span<const GlobeVertex>(vertices).subspan(gpu_mesh.vertex_count));
+            glBindBuffer(GL_ARRAY_BUFFER, gpu_mesh.vertex_buffer);
+            glBufferSubData(GL_ARRAY_BUFFER, gpu_mesh.vertex_count * sizeof(PackedGlobeVertex),
+                            appended.size() * sizeof(PackedGlobeVertex), appended.data());
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            bytes += appended.size() * sizeof(PackedGlobeVertex);
+        }
+
+        glBindVertexArray(gpu_mesh.vao);
+        for (const GlobeIndexRange& range : mesh.GetDirtyIndexRanges()) {
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, range.first * sizeof(std::uint32_t),
+                            range.count * sizeof(std::uint32_t), indices.data() + range.first);
+            bytes += range.count * sizeof(std::uint32_t);
+        }
+        glBindVertexArray(0);
+
+        gpu_mesh.vertex_count = vertices.size();
+        gpu_mesh.index_count = indices.size();
+        gpu_mesh.chunks = {GlobeIndexChunk{0, indices.size(), 0}};
+        gpu_mesh.revision = mesh.GetRevision();
+        stats_.last_sync_bytes = bytes;
+    }
+
+    std::unordered_map<const GlobeMesh*, GPUMesh> meshes_;
+    GPUResourceStats stats_;
+};
+
+std::unique_ptr<GPUResourceManager> GPUResourceManager::Create() {
+    return std::make_unique<GPUResourceManagerImpl>();
+}
+
+void GPUResourceManager::DrawGlobeMesh(const GPUMesh& gpu_mesh) {
+    const std::size_t index_size = IndexSize(gpu_mesh.index_type);
+    for (const GlobeIndexChunk& chunk : gpu_mesh.chunks) {
+        glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(chunk.count), gpu_mesh.index_type,
+                                 (void*)(chunk.first * index_size),
+                                 static_cast<GLint>(chunk.base_vertex));
+    }
+}
+
+GPUMeshSync GPUResourceManager::PlanSync(const GPUMesh* gpu_mesh, const GlobeMesh& mesh) {
+    if (!gpu_mesh) {
+        return GPUMeshSync::FULL;
+    }
+    if (gpu_mesh->revision == mesh.GetRevision()) {
+        return GPUMeshSync::CURRENT;
+    }
+    // Incremental updates patch 32-bit indices in buffers that still fit
+    const bool patchable = gpu_mesh->revision == mesh.GetDirtyBaseRevision() &&
+                           gpu_mesh->index_type == GL_UNSIGNED_INT &&
+                           mesh.GetIndexChunks().empty() &&
+                           mesh.GetVertices().size() >= gpu_mesh->vertex_count &&
+                           mesh.GetVertices().size() <= gpu_mesh->vertex_capacity &&
+                           mesh.GetVertexIndices().size() <= gpu_mesh->index_capacity;
+    return patchable ? GPUMeshSync::INCREMENTAL : GPUMeshSync::FULL;
+}
+
+} // namespace earth_map
@@ -0,0 +1,193 @@
+/**
+ * @file glyph_atlas.cpp
+ * @brief SDF glyph rasterization with stb_truetype
+ */
+
+#include <earth_map/renderer/labels/glyph_atlas.h>
+#include <spdlog/spdlog.h>
+#include <fstream>
+#include <iterator>
+
+#define STB_TRUETYPE_IMPLEMENTATION
+#include <stb_truetype.h>
+
+namespace earth_map {
+
+namespace {
+
+/// Texel value on the outline (0.5 after normalization)
+constexpr unsigned char kOnEdgeValue = 128;
+
+} // namespace
+
+/**
+ * @brief Font bytes and the stb_truetype face reading them
+ */
+struct GlyphAtlas::Font {
+    std::vector<std::uint8_t> data;
+    stbtt_fontinfo info{};
+    float scale = 0.0f;   ///< Font units to base-size pixels
+};
+
+GlyphAtlas::GlyphAtlas(std::uint32_t atlas_size, float pixel_size, int padding, bool skip_gl_init)
+    : atlas_(atlas_size, atlas_size, 1, ShelfTextureAtlas::kDefaultPadding, skip_gl_init)
+    , pixel_size_(pixel_size)
+    , padding_(padding) {}
+
+GlyphAtlas::~GlyphAtlas() = default;
+
+bool GlyphAtlas::LoadFont(std::vector<std::uint8_t> font_data) {
+    auto font = std::make_unique<Font>();
+    font->data = std::move(font_data);
+    if (font->data.empty()) {
+        return false;
+    }
+    const int offset = stbtt_GetFontOffsetForIndex(font->data.data(), 0);
+    if (offset < 0 || !stbtt_InitFont(&font->info, font->data.data(), offset)) {
+        spdlog::warn("GlyphAtlas: not a readable TrueType/OpenType font");
+        return false;
+    }
+    font->scale = stbtt_ScaleForPixelHeight(&font->info, pixel_size_);
+
+    int ascent = 0;
+    int descent = 0;
+    int line_gap = 0;
+    stbtt_GetFontVMetrics(&font->info, &ascent, &descent, &line_gap);
+    ascent_ = static_cast<float>(ascent) * font->scale;
+    descent_ = static_cast<float>(descent) * font->scale;
+    line_height_ = static_cast<float>(ascent - descent + line_gap) * font->scale;
+
+    font_ = std::move(font);
+    Clear();
+    return true;
+}
+
+bool GlyphAtlas::LoadFontFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        spdlog::warn("GlyphAtlas: cannot open font {}", path);
+        return false;
+    }
+    std::vector<std::uint8_t> data((std::istreambuf_iterator<char>(file)),
+                                   std::istreambuf_iterator<char>());
+    return LoadFont(std::move(data));
+}
+
+bool GlyphAtlas::HasFont() const {
+    return font_ != nullptr;
+}
+
+const GlyphMetrics* GlyphAtlas::GetGlyph(char32_t codepoint) {
+    auto it = glyphs_.find(codepoint);
+    if (it != glyphs_.end()) {
+        return &it->second;
+    }
+    if (!font_) {
+        return nullptr;
+    }
+
+    const int code = static_cast<int>(codepoint);
+    GlyphMetrics glyph;
+    int advance = 0;
+    int left_bearing = 0;
+    stbtt_GetCodepointHMetrics(&font_->info, code, &advance, &left_bearing);
+    glyph.advance = static_cast<float>(advance) * font_->scale;
+
+    // Distance falls from 128 on the outline to 0 at `padding` pixels outside
+    int width = 0;
+    int height = 0;
+    int x_offset = 0;
+    int y_offset = 0;
+    unsigned char* sdf = stbtt_GetCodepointSDF(
+        &font_->info, font_->scale, code, padding_, kOnEdgeValue,
+        static_cast<float>(kOnEdgeValue) / static_cast<float>(padding_),
+        &width, &height, &x_offset, &y_offset);
+
+    if (sdf != nullptr) {
+        const auto region = atlas_.Allocate(static_cast<std::uint32_t>(width),
+                                            static_cast<std::uint32_t>(height));
+        if (!region) {
+            stbtt_FreeSDF(sdf, nullptr);
+            if (!full_) {
+                spdlog::debug("GlyphAtlas full after {} glyphs", glyphs_.size());
+            }
+            full_ = true;
+            return nullptr;
+        }
+        atlas_.Upload(*region, sdf);
+        stbtt_FreeSDF(sdf, nullptr);
+
+        glyph.region = *region;
+        glyph.offset = glm::vec2(static_cast<float>(x_offset), static_cast<float>(y_offset));
+        glyph.size = glm::vec2(static_cast<float>(width), static_cast<float>(height));
+        glyph.has_bitmap = true;
+    }
+
+    return &glyphs_.emplace(codepoint, glyph).first->second;
+}
+
+float GlyphAtlas::GetKerning(char32_t left, char32_t right) const {
+    if (!font_) {
+        return 0.0f;
+    }
+    return static_cast<float>(stbtt_GetCodepointKernAdvance(
+               &font_->info, static_cast<int>(left), static_cast<int>(right))) * font_->scale;
+}
+
+void GlyphAtlas::Clear() {
+    glyphs_.clear();
+    atlas_.Reset();
+    full_ = false;
+    ++generation_;
+}
+
+std::u32string GlyphAtlas::DecodeUtf8(std::string_view text) {
+    constexpr char32_t kReplacement = 0xFFFD;
+
+    std::u32string codepoints;
+    codepoints.reserve(text.size());
+    std::size_t i = 0;
+    while (i < text.size()) {
+        const auto lead = static_cast<unsigned char>(text[i]);
+        std::size_t length = 0;
+        char32_t codepoint = 0;
+        if (lead < 0x80) {
+            length = 1;
+            codepoint = lead;
+        } else if ((lead & 0xE0) == 0xC0) {
+            length = 2;
+            codepoint = lead & 0x1F;
+        } else if ((lead & 0xF0) == 0xE0) {
+            length = 3;
+            codepoint = lead & 0x0F;
+        } else if ((lead & 0xF8) == 0xF0) {
+            length = 4;
+            codepoint = lead & 0x07;
+        } else {
+            codepoints.push_back(kReplacement);
+            ++i;
+            continue;
+        }
+
+        bool valid = i + length <= text.size();
+        for (std::size_t k = 1; valid && k < length; ++k) {
+            const auto next = static_cast<unsigned char>(text[i + k]);
+            valid = (next & 0xC0) == 0x80;
+            codepoint = (codepoint << 6) | (next & 0x3F);
+        }
+        // Reject overlong forms, surrogates and values past U+10FFFF
+        static constexpr char32_t kMinimum[] = {0, 0, 0x80, 0x800, 0x10000};
+        valid = valid && codepoint >= kMinimum[length] && codepoint <= 0x10FFFF &&
+                !(codepoint >= 0xD800 && codepoint <= 0xDFFF);
+        if (!valid) {
+            codepoints.push_back(kReplacement);
+            ++i;
+            continue;
+        }
+        codepoints.push_back(codepoint);
+        i += length;
+    }
+    return codepoints;
+}
+
+} // namespace earth_map
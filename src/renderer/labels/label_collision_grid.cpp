@@ -0,0 +1,91 @@
+/**
+ * @file label_collision_grid.cpp
+ * @brief Implementation of the screen-space label collision grid
+ */
+
+#include <earth_map/renderer/labels/label_collision_grid.h>
+#include <algorithm>
+#include <cmath>
+
+namespace earth_map {
+
+LabelCollisionGrid::LabelCollisionGrid(float cell_size)
+    : cell_size_(std::max(cell_size, 1.0f))
+    , inverse_cell_size_(1.0f / cell_size_) {}
+
+void LabelCollisionGrid::BeginFrame(float viewport_width, float viewport_height) {
+    boxes_.clear();
+    tests_ = 0;
+
+    if (viewport_width != viewport_width_ || viewport_height != viewport_height_) {
+        viewport_width_ = viewport_width;
+        viewport_height_ = viewport_height;
+        columns_ = std::max(1, static_cast<int>(std::ceil(viewport_width * inverse_cell_size_)));
+        rows_ = std::max(1, static_cast<int>(std::ceil(viewport_height * inverse_cell_size_)));
+        cells_.assign(static_cast<std::size_t>(columns_) * rows_, Cell{});
+    }
+
+    // Every cell's boxes become stale at once
+    if (++generation_ == 0) {
+        for (Cell& cell : cells_) {
+            cell.generation = 0;
+            cell.boxes.clear();
+        }
+        generation_ = 1;
+    }
+}
+
+LabelCollisionGrid::CellRange LabelCollisionGrid::CellsOf(const LabelBox& box) const {
+    CellRange range;
+    if (box.max_x <= 0.0f || box.max_y <= 0.0f ||
+        box.min_x >= viewport_width_ || box.min_y >= viewport_height_) {
+        return range;   // Off screen: empty
+    }
+    range.x0 = std::clamp(static_cast<int>(box.min_x * inverse_cell_size_), 0, columns_ - 1);
+    range.y0 = std::clamp(static_cast<int>(box.min_y * inverse_cell_size_), 0, rows_ - 1);
+    range.x1 = std::clamp(static_cast<int>(box.max_x * inverse_cell_size_), 0, columns_ - 1);
+    range.y1 = std::clamp(static_cast<int>(box.max_y * inverse_cell_size_), 0, rows_ - 1);
+    return range;
+}
+
+bool LabelCollisionGrid::Collides(const LabelBox& box) const {
+    const CellRange range = CellsOf(box);
+    for (int y = range.y0; y <= range.y1; ++y) {
+        for (int x = range.x0; x <= range.x1; ++x) {
+            const Cell& cell = cells_[static_cast<std::size_t>(y) * columns_ + x];
+            if (cell.generation != generation_) {
+                continue;
+            }
+            for (const std::uint32_t index : cell.boxes) {
+                ++tests_;
+                if (boxes_[index].Overlaps(box)) {
+                    return true;
+                }
+            }
+        }
+    }
+    return false;
+}
+
+bool LabelCollisionGrid::TryInsert(const LabelBox& box) {
+    const CellRange range = CellsOf(box);
+    if (range.x1 < range.x0 || Collides(box)) {
+        return false;
+    }
+
+    const auto index = static_cast<std::uint32_t>(boxes_.size());
+    boxes_.push_back(box);
+    for (int y = range.y0; y <= range.y1; ++y) {
+        for (int x = range.x0; x <= range.x1; ++x) {
+            Cell& cell = cells_[static_cast<std::size_t>(y) * columns_ + x];
+            if (cell.generation != generation_) {
+                cell.generation = generation_;
+                cell.boxes.clear();
+            }
+            cell.boxes.push_back(index);
+        }
+    }
+    return true;
+}
+
+} // namespace earth_map
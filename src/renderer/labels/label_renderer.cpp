@@ -0,0 +1,494 @@
+/**
+ * @file label_renderer.cpp
+ * @brief Collision-placed SDF label renderer implementation
+ */
+
+#include <earth_map/renderer/labels/label_renderer.h>
+#include <earth_map/renderer/labels/glyph_atlas.h>
+#include <earth_map/renderer/labels/label_collision_grid.h>
+#include <earth_map/renderer/placemark_store.h>
+#include <earth_map/renderer/shader_loader.h>
+#include <earth_map/constants.h>
+#include <GL/glew.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace earth_map {
+
+namespace {
+
+/**
+ * @brief Per-glyph instance: screen rectangle, atlas UVs and colors
+ */
+struct GlyphInstance {
+    glm::vec4 rect;           ///< Screen pixels (x0, y0, x1, y1), y down
+    glm::vec4 uv;             ///< Atlas UVs (u0, v0, u1, v1)
+    std::uint32_t color;      ///< RGBA8
+    std::uint32_t halo_color; ///< RGBA8
+    float scale;              ///< Screen pixels per base-size pixel
+};
+
+constexpr GLsizeiptr kInstanceBytes = sizeof(GlyphInstance);
+
+// One instance per glyph; the quad's corners come from gl_VertexID
+constexpr const char* kGlyphVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec4 aRect;
+layout (location = 1) in vec4 aUV;
+layout (location = 2) in vec4 aColor;
+layout (location = 3) in vec4 aHaloColor;
+layout (location = 4) in float aScale;
+
+uniform vec2 uViewport;
+
+out vec2 TexCoord;
+out vec4 Color;
+out vec4 HaloColor;
+out float Scale;
+
+void main() {
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    vec2 pixel = mix(aRect.xy, aRect.zw, corner);
+    gl_Position = vec4(pixel.x / uViewport.x * 2.0 - 1.0, 1.0 - pixel.y / uViewport.y * 2.0,
+                       0.0, 1.0);
+    TexCoord = mix(aUV.xy, aUV.zw, corner);
+    Color = aColor;
+    HaloColor = aHaloColor;
+    Scale = aScale;
+}
+)";
+
+// Field value 0.5 is the outline; the halo edge lies uHaloWidth screen pixels outside it
+constexpr const char* kGlyphFragmentShader = R"(
+#version 330 core
+in vec2 TexCoord;
+in vec4 Color;
+in vec4 HaloColor;
+in float Scale;
+
+uniform sampler2D uAtlas;
+uniform float uFieldPerPixel;
+uniform float uHaloWidth;
+
+out vec4 FragColor;
+
+void main() {
+    float field = texture(uAtlas, TexCoord).r;
+    float smoothing = max(fwidth(field) * 0.75, 1e-3);
+    float fill = smoothstep(0.5 - smoothing, 0.5 + smoothing, field);
+    float halo_edge = max(0.5 - uHaloWidth * uFieldPerPixel / Scale, smoothing);
+    float halo = smoothstep(halo_edge - smoothing, halo_edge + smoothing, field) * HaloColor.a;
+    float alpha = mix(halo, Color.a, fill);
+    if (alpha <= 0.0) {
+        discard;
+    }
+    vec3 rgb = mix(HaloColor.rgb, Color.rgb, fill);
+    FragColor = vec4(rgb, alpha);
+}
+)";
+
+/**
+ * @brief Glyph quad of a laid-out label, in base-size pixels from the box's top-left
+ */
+struct GlyphQuad {
+    glm::vec4 rect;
+    glm::vec4 uv;
+};
+
+} // namespace
+
+class LabelRendererImpl : public LabelRenderer {
+public:
+    explicit LabelRendererImpl(const LabelRenderConfig& config)
+        : config_(config)
+        , grid_(config.collision_cell_pixels) {}
+
+    ~LabelRendererImpl() override {
+        if (vao_) {
+            glDeleteVertexArrays(1, &vao_);
+            vao_ = 0;
+        }
+        if (instance_buffer_) {
+            glDeleteBuffers(1, &instance_buffer_);
+            instance_buffer_ = 0;
+        }
+        if (program_) {
+            glDeleteProgram(program_);
+            program_ = 0;
+        }
+    }
+
+    bool Initialize() override {
+        if (initialized_) {
+            return true;
+        }
+        program_ = ShaderLoader::CreateProgram(kGlyphVertexShader, kGlyphFragmentShader,
+                                               "label_glyphs");
+        if (program_ == 0) {
+            spdlog::error("Failed to create label shader program");
+            return false;
+        }
+        viewport_loc_ = glGetUniformLocation(program_, "uViewport");
+        atlas_loc_ = glGetUniformLocation(program_, "uAtlas");
+        field_per_pixel_loc_ = glGetUniformLocation(program_, "uFieldPerPixel");
+        halo_width_loc_ = glGetUniformLocation(program_, "uHaloWidth");
+
+        glyphs_ = std::make_unique<GlyphAtlas>(config_.atlas_size, config_.sdf_pixel_size,
+                                               config_.sdf_padding);
+        if (!config_.font_path.empty() && !glyphs_->LoadFontFile(config_.font_path)) {
+            spdlog::warn("Label font {} not loaded; labels are hidden until a font is",
+                         config_.font_path);
+        }
+        initialized_ = true;
+        return true;
+    }
+
+    bool LoadFontFile(const std::string& path) override {
+        if (!glyphs_) {
+            config_.font_path = path;
+            return true;   // Loaded by Initialize()
+        }
+        return glyphs_->LoadFontFile(path);
+    }
+
+    LabelId AddLabel(const LabelDesc& desc) override {
+        LabelId id;
+        if (!free_ids_.empty()) {
+            id = free_ids_.back();
+            free_ids_.pop_back();
+        } else {
+            id = static_cast<LabelId>(labels_.size());
+            labels_.emplace_back();
+        }
+
+        Label& label = labels_[id];
+        label = Label{};
+        label.desc = desc;
+        label.world = PlacemarkStore::ToWorldMeters(desc.position) /
+                      constants::geodetic::EARTH_MEAN_RADIUS;
+        label.codepoints = GlyphAtlas::DecodeUtf8(desc.text);
+        label.active = true;
+        ++label_count_;
+        order_dirty_ = true;
+        return id;
+    }
+
+    bool RemoveLabel(LabelId id) override {
+        if (id >= labels_.size() || !labels_[id].active) {
+            return false;
+        }
+        labels_[id] = Label{};
+        free_ids_.push_back(id);
+        --label_count_;
+        order_dirty_ = true;
+        return true;
+    }
+
+    void Clear() override {
+        labels_.clear();
+        free_ids_.clear();
+        order_.clear();
+        label_count_ = 0;
+        order_dirty_ = false;
+    }
+
+    std::size_t GetLabelCount() const override {
+        return label_count_;
+    }
+
+    bool IsLabelPlaced(LabelId id) const override {
+        return id < labels_.size() && labels_[id].active && labels_[id].placed;
+    }
+
+    void Render(const glm::mat4& view_matrix, const glm::mat4& projection_matrix,
+                const glm::vec3& camera_position, std::uint32_t viewport_width,
+                std::uint32_t viewport_height) override {
+        stats_ = LabelRenderStats{};
+        stats_.atlas_rebuilds = atlas_rebuilds_;
+        if (!initialized_ || !glyphs_->HasFont() || viewport_width == 0 || viewport_height == 0) {
+            return;
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        PlaceLabels(view_matrix, projection_matrix, camera_position,
+                    static_cast<float>(viewport_width), static_cast<float>(viewport_height));
+        stats_.placement_ms = std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - start).count();
+        stats_.glyphs_cached = glyphs_->GetGlyphCount();
+        stats_.collision_tests = grid_.GetTestCount();
+
+        if (instances_.empty()) {
+            return;
+        }
+        UploadInstances();
+
+        const GLboolean blend = glIsEnabled(GL_BLEND);
+        const GLboolean depth_test = glIsEnabled(GL_DEPTH_TEST);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glDisable(GL_DEPTH_TEST);
+
+        glUseProgram(program_);
+        glUniform2f(viewport_loc_, static_cast<float>(viewport_width),
+                    static_cast<float>(viewport_height));
+        glUniform1f(field_per_pixel_loc_, 0.5f / static_cast<float>(glyphs_->GetPadding()));
+        glUniform1f(halo_width_loc_, config_.halo_width_pixels);
+        glActiveTexture(GL_TEXTURE0);
+        glBindTexture(GL_TEXTURE_2D, glyphs_->GetAtlas().GetAtlasTextureID());
+        glUniform1i(atlas_loc_, 0);
+
+        glBindVertexArray(vao_);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, static_cast<GLsizei>(instances_.size()));
+        ++stats_.draw_calls;
+        stats_.glyphs_rendered = instances_.size();
+
+        glBindVertexArray(0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glUseProgram(0);
+        if (!blend) glDisable(GL_BLEND);
+        if (depth_test) glEnable(GL_DEPTH_TEST);
+    }
+
+    LabelRenderStats GetStats() const override {
+        return stats_;
+    }
+
+private:
+    /**
+     * @brief A label and its cached layout
+     */
+    struct Label {
+        LabelDesc desc;
+        glm::dvec3 world{0.0};            ///< Anchor in world units (globe radius 1)
+        std::u32string codepoints;
+        std::vector<GlyphQuad> quads;     ///< Layout in base-size pixels
+        glm::vec2 box_size{0.0f};         ///< Text box in base-size pixels
+        std::uint64_t layout_generation = 0;  ///< Glyph atlas generation of the layout
+        bool active = false;
+        bool placed = false;              ///< Drawn in the last frame
+        bool placed_now = false;          ///< Placed in the frame being built
+    };
+
+    /**
+     * @brief Sort the active labels by descending priority (stable by handle)
+     */
+    void SortLabels() {
+        order_.clear();
+        order_.reserve(label_count_);
+        for (LabelId id = 0; id < labels_.size(); ++id) {
+            if (labels_[id].active) {
+                order_.push_back(id);
+            }
+        }
+        std::stable_sort(order_.begin(), order_.end(), [this](LabelId a, LabelId b) {
+            return labels_[a].desc.priority > labels_[b].desc.priority;
+        });
+        order_dirty_ = false;
+    }
+
+    /**
+     * @brief Lay out a label's glyphs with the current atlas
+     *
+     * @return false if a glyph did not fit in the atlas
+     */
+    bool Layout(Label& label) {
+        label.quads.clear();
+        const float ascent = glyphs_->GetAscent();
+        const float line_height = glyphs_->GetLineHeight();
+
+        float pen = 0.0f;
+        float width = 0.0f;
+        int line = 0;
+        char32_t previous = 0;
+        for (const char32_t codepoint : label.codepoints) {
+            if (codepoint == U'\n') {
+                width = std::max(width, pen);
+                pen = 0.0f;
+                ++line;
+                previous = 0;
+                continue;
+            }
+            if (previous != 0) {
+                pen += glyphs_->GetKerning(previous, codepoint);
+            }
+            const GlyphMetrics* glyph = glyphs_->GetGlyph(codepoint);
+            if (glyph == nullptr) {
+                return false;
+            }
+            if (glyph->has_bitmap) {
+                const float x0 = pen + glyph->offset.x;
+                const float y0 = ascent + static_cast<float>(line) * line_height + glyph->offset.y;
+                label.quads.push_back(GlyphQuad{
+                    glm::vec4(x0, y0, x0 + glyph->size.x, y0 + glyph->size.y),
+                    glyph->region.uv});
+            }
+            pen += glyph->advance;
+            previous = codepoint;
+        }
+        width = std::max(width, pen);
+        label.box_size = glm::vec2(width, ascent - glyphs_->GetDescent() +
+                                              static_cast<float>(line) * line_height);
+        label.layout_generation = glyphs_->GetGeneration();
+        return true;
+    }
+
+    /**
+     * @brief Project, cull and place the labels; fill instances_ for the placed ones
+     */
+    void PlaceLabels(const glm::mat4& view_matrix, const glm::mat4& projection_matrix,
+                     const glm::vec3& camera_position, float viewport_width,
+                     float viewport_height) {
+        instances_.clear();
+
+        // A glyph missed the atlas last frame: rebuild it with the glyphs in use
+        if (glyphs_->IsFull()) {
+            glyphs_->Clear();
+            stats_.atlas_rebuilds = ++atlas_rebuilds_;
+        }
+        if (order_dirty_) {
+            SortLabels();
+        }
+
+        grid_.BeginFrame(viewport_width, viewport_height);
+        const glm::dmat4 view_projection = glm::dmat4(projection_matrix) * glm::dmat4(view_matrix);
+        const glm::dvec3 eye(camera_position);
+        const float padding = config_.label_padding_pixels;
+        const float inverse_base = 1.0f / glyphs_->GetPixelSize();
+
+        const auto place = [&](Label& label) {
+            label.placed_now = false;
+            ++stats_.candidates;
+
+            // The eye is below the label's horizon plane: behind the globe
+            const glm::dvec3& world = label.world;
+            const glm::dvec4 clip = view_projection * glm::dvec4(world, 1.0);
+            if (glm::dot(world, world - eye) > 0.0 || clip.w <= 0.0) {
+                ++stats_.culled;
+                return;
+            }
+            const float screen_x = static_cast<float>((clip.x / clip.w * 0.5 + 0.5) * viewport_width) +
+                                   label.desc.offset_pixels.x;
+            const float screen_y = static_cast<float>((0.5 - clip.y / clip.w * 0.5) * viewport_height) +
+                                   label.desc.offset_pixels.y;
+
+            if (label.layout_generation != glyphs_->GetGeneration() && !Layout(label)) {
+                label.layout_generation = 0;
+                return;
+            }
+
+            const float scale = label.desc.size_pixels * inverse_base;
+            const glm::vec2 size = label.box_size * scale;
+            const float left = std::round(screen_x - label.desc.anchor.x * size.x);
+            const float top = std::round(screen_y - label.desc.anchor.y * size.y);
+            const LabelBox box{left - padding, top - padding,
+                               left + size.x + padding, top + size.y + padding};
+            if (box.max_x <= 0.0f || box.max_y <= 0.0f ||
+                box.min_x >= viewport_width || box.min_y >= viewport_height) {
+                ++stats_.culled;
+                return;
+            }
+            if (!grid_.TryInsert(box)) {
+                return;
+            }
+
+            label.placed_now = true;
+            ++stats_.placed;
+            const std::uint32_t color = PlacemarkStore::PackColor(label.desc.color);
+            const std::uint32_t halo = PlacemarkStore::PackColor(label.desc.halo_color);
+            for (const GlyphQuad& quad : label.quads) {
+                instances_.push_back(GlyphInstance{
+                    glm::vec4(left + quad.rect.x * scale, top + quad.rect.y * scale,
+                              left + quad.rect.z * scale, top + quad.rect.w * scale),
+                    quad.uv, color, halo, scale});
+            }
+        };
+
+        // Within a priority, labels shown last frame go first: stable while panning
+        for (std::size_t begin = 0; begin < order_.size();) {
+            const float priority = labels_[order_[begin]].desc.priority;
+            std::size_t end = begin + 1;
+            while (end < order_.size() && labels_[order_[end]].desc.priority == priority) {
+                ++end;
+            }
+            for (const bool previously_placed : {true, false}) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    Label& label = labels_[order_[i]];
+                    if (label.placed == previously_placed) {
+                        place(label);
+                    }
+                }
+            }
+            begin = end;
+        }
+        for (const LabelId id : order_) {
+            labels_[id].placed = labels_[id].placed_now;
+        }
+    }
+
+    void UploadInstances() {
+        if (vao_ == 0) {
+            glGenVertexArrays(1, &vao_);
+            glGenBuffers(1, &instance_buffer_);
+            glBindVertexArray(vao_);
+            glBindBuffer(GL_ARRAY_BUFFER, instance_buffer_);
+            glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, kInstanceBytes,
+                                  (void*)offsetof(GlyphInstance, rect));
+            glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, kInstanceBytes,
+                                  (void*)offsetof(GlyphInstance, uv));
+            glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, kInstanceBytes,
+                                  (void*)offsetof(GlyphInstance, color));
+            glVertexAttribPointer(3, 4, GL_UNSIGNED_BYTE, GL_TRUE, kInstanceBytes,
+                                  (void*)offsetof(GlyphInstance, halo_color));
+            glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, kInstanceBytes,
+                                  (void*)offsetof(GlyphInstance, scale));
+            for (GLuint attribute = 0; attribute < 5; ++attribute) {
+                glEnableVertexAttribArray(attribute);
+                glVertexAttribDivisor(attribute, 1);
+            }
+            glBindVertexArray(0);
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, instance_buffer_);
+        if (instances_.size() > capacity_) {
+            capacity_ = std::max<std::size_t>(
+                {instances_.size(), capacity_ * 2, config_.initial_capacity});
+            glBufferData(GL_ARRAY_BUFFER, capacity_ * kInstanceBytes, nullptr, GL_DYNAMIC_DRAW);
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, 0, instances_.size() * kInstanceBytes, instances_.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    LabelRenderConfig config_;
+    bool initialized_ = false;
+
+    std::vector<Label> labels_;
+    std::vector<LabelId> free_ids_;
+    std::size_t label_count_ = 0;
+    std::vector<LabelId> order_;      ///< Active labels by descending priority
+    bool order_dirty_ = false;
+
+    std::unique_ptr<GlyphAtlas> glyphs_;
+    std::uint64_t atlas_rebuilds_ = 0;
+    LabelCollisionGrid grid_;
+    std::vector<GlyphInstance> instances_;
+    LabelRenderStats stats_;
+
+    std::uint32_t program_ = 0;
+    GLint viewport_loc_ = -1;
+    GLint atlas_loc_ = -1;
+    GLint field_per_pixel_loc_ = -1;
+    GLint halo_width_loc_ = -1;
+    std::uint32_t vao_ = 0;
+    std::uint32_t instance_buffer_ = 0;
+    std::size_t capacity_ = 0;
+};
+
+std::unique_ptr<LabelRenderer> LabelRenderer::Create(const LabelRenderConfig& config) {
+    return std::make_unique<LabelRendererImpl>(config);
+}
+
+} // namespace earth_map
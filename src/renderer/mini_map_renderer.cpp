@@ -4,6 +4,7 @@
 #include "earth_map/coordinates/coordinate_mapper.h"
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <spdlog/spdlog.h>
@@ -62,6 +63,19 @@ glm::vec2 WorldToUV(const glm::vec3& world_pos) {
     return glm::vec2(u, v);
 }
 
+constexpr std::uint64_t kFnvOffset = 14695981039346656037ULL;
+constexpr std::uint64_t kFnvPrime = 1099511628211ULL;
+
+std::uint64_t HashFloats(const float* values, std::size_t count, std::uint64_t hash) {
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint32_t bits;
+        std::memcpy(&bits, &values[i], sizeof(bits));
+        hash ^= bits;
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
 }
 
 namespace earth_map {
@@ -79,6 +93,12 @@ MiniMapRenderer::~MiniMapRenderer() {
     if (vbo_ != 0) glDeleteBuffers(1, &vbo_);
     if (grid_vao_ != 0) glDeleteVertexArrays(1, &grid_vao_);
     if (grid_vbo_ != 0) glDeleteBuffers(1, &grid_vbo_);
+    if (marker_vao_ != 0) glDeleteVertexArrays(1, &marker_vao_);
+    if (marker_vbo_ != 0) glDeleteBuffers(1, &marker_vbo_);
+    if (frustum_vao_ != 0) glDeleteVertexArrays(1, &frustum_vao_);
+    if (frustum_vbo_ != 0) glDeleteBuffers(1, &frustum_vbo_);
+    if (overlay_vao_ != 0) glDeleteVertexArrays(1, &overlay_vao_);
+    if (overlay_vbo_ != 0) glDeleteBuffers(1, &overlay_vbo_);
 }
 
 bool MiniMapRenderer::Initialize(uint32_t shader_program) {
@@ -92,6 +112,11 @@ bool MiniMapRenderer::Initialize(uint32_t shader_program) {
     }
 
     shader_program_ = shader_program;
+    projection_location_ = glGetUniformLocation(shader_program_, "uProjection");
+    model_location_ = glGetUniformLocation(shader_program_, "uModel");
+    texture_location_ = glGetUniformLocation(shader_program_, "uTexture");
+    color_location_ = glGetUniformLocation(shader_program_, "uColor");
+    use_texture_location_ = glGetUniformLocation(shader_program_, "uUseTexture");
 
     try {
         // Load Earth texture
@@ -138,17 +163,30 @@ void MiniMapRenderer::Update(CameraController* camera_controller,
                             [[maybe_unused]] uint32_t screen_width, [[maybe_unused]] uint32_t screen_height) {
     if (!initialized_ || !camera_controller) return;
 
-    camera_controller_ = camera_controller;
+    if (camera_controller != camera_controller_) {
+        camera_controller_ = camera_controller;
+        dirty_ = true;
+    }
     UpdateCameraPosition(camera_controller);
 }
 
-void MiniMapRenderer::Render(float aspect_ratio) {
+bool MiniMapRenderer::Render(float aspect_ratio) {
     if (!initialized_) {
         spdlog::warn("[minimap] Render: not initialized");
-        return;
+        return false;
     }
 
-
+    // The cached texture stays valid until the camera or the aspect changes
+    std::uint64_t state_hash = kFnvOffset;
+    if (camera_controller_) {
+        const glm::mat4 view = camera_controller_->GetViewMatrix();
+        const glm::mat4 projection = camera_controller_->GetProjectionMatrix(aspect_ratio);
+        state_hash = HashFloats(glm::value_ptr(view), 16, state_hash);
+        state_hash = HashFloats(glm::value_ptr(projection), 16, state_hash);
+    }
+    if (!dirty_ && state_hash == rendered_state_hash_) {
+        return false;
+    }
 
     // Save current viewport
     GLint viewport[4];
@@ -161,6 +199,11 @@ void MiniMapRenderer::Render(float aspect_ratio) {
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f); // Black background
     glClear(GL_COLOR_BUFFER_BIT);
 
+    // Every pass draws in the same orthographic space
+    glUseProgram(shader_program_);
+    const glm::mat4 projection = glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f);
+    glUniformMatrix4fv(projection_location_, 1, GL_FALSE, glm::value_ptr(projection));
+
     RenderGlobe();
     if (config_.show_grid) {
         RenderGrid();
@@ -173,7 +216,16 @@ void MiniMapRenderer::Render(float aspect_ratio) {
     // Restore viewport
     glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
 
+    rendered_state_hash_ = state_hash;
+    dirty_ = false;
+    ++render_count_;
+    return true;
+}
 
+void MiniMapRenderer::DrawOverlayQuad() const {
+    if (overlay_vao_ == 0) return;
+    glBindVertexArray(overlay_vao_);
+    glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
 }
 
 bool MiniMapRenderer::LoadEarthTexture() {
@@ -286,6 +338,55 @@ void MiniMapRenderer::CreateGeometry() {
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
     glEnableVertexAttribArray(0);
+
+    // Camera marker: a small quad placed by uModel
+    const std::array<float, 12> marker_vertices = {
+        -0.02f,  0.02f, 0.0f,
+         0.02f,  0.02f, 0.0f,
+         0.02f, -0.02f, 0.0f,
+        -0.02f, -0.02f, 0.0f
+    };
+
+    glGenVertexArrays(1, &marker_vao_);
+    glGenBuffers(1, &marker_vbo_);
+
+    glBindVertexArray(marker_vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, marker_vbo_);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(marker_vertices), marker_vertices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+    glEnableVertexAttribArray(0);
+
+    // Frustum outline: up to 4 segments, rewritten when the camera moves
+    glGenVertexArrays(1, &frustum_vao_);
+    glGenBuffers(1, &frustum_vbo_);
+
+    glBindVertexArray(frustum_vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, frustum_vbo_);
+    glBufferData(GL_ARRAY_BUFFER, kMaxFrustumVertices * 3 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+    glEnableVertexAttribArray(0);
+
+    // Screen quad the renderer composites the texture with ([0, 1], V flipped)
+    const std::array<float, 20> overlay_vertices = {
+        // positions        // tex coords
+        0.0f, 0.0f, 0.0f,   0.0f, 1.0f,  // bottom-left
+        1.0f, 0.0f, 0.0f,   1.0f, 1.0f,  // bottom-right
+        1.0f, 1.0f, 0.0f,   1.0f, 0.0f,  // top-right
+        0.0f, 1.0f, 0.0f,   0.0f, 0.0f   // top-left
+    };
+
+    glGenVertexArrays(1, &overlay_vao_);
+    glGenBuffers(1, &overlay_vbo_);
+
+    glBindVertexArray(overlay_vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, overlay_vbo_);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(overlay_vertices), overlay_vertices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+
+    glBindVertexArray(0);
 }
 
 void MiniMapRenderer::UpdateCameraPosition(CameraController* camera_controller) {
@@ -304,68 +405,27 @@ void MiniMapRenderer::UpdateCameraPosition(CameraController* camera_controller)
 
 
 void MiniMapRenderer::RenderGlobe() {
-
-
-    glUseProgram(shader_program_);
-
-    // Set up orthographic projection
-    glm::mat4 projection = glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f);
-    glm::mat4 model = glm::mat4(1.0f);
-    glUniformMatrix4fv(glGetUniformLocation(shader_program_, "uProjection"), 1, GL_FALSE, glm::value_ptr(projection));
-    glUniformMatrix4fv(glGetUniformLocation(shader_program_, "uModel"), 1, GL_FALSE, glm::value_ptr(model));
+    const glm::mat4 model(1.0f);
+    glUniformMatrix4fv(model_location_, 1, GL_FALSE, glm::value_ptr(model));
 
     // Bind texture
     glActiveTexture(GL_TEXTURE0);
     glBindTexture(GL_TEXTURE_2D, earth_texture_);
-    glUniform1i(glGetUniformLocation(shader_program_, "uTexture"), 0);
+    glUniform1i(texture_location_, 0);
 
     // Use texture with white tint
-    glUniform4f(glGetUniformLocation(shader_program_, "uColor"), 1.0f, 1.0f, 1.0f, 1.0f);
-    glUniform1i(glGetUniformLocation(shader_program_, "uUseTexture"), 1);  // Enable texture sampling
-
-
-
-    // Create temporary quad for full texture coverage
-    std::vector<float> quad_vertices = {
-        // positions        // tex coords (not used for debug red)
-        -1.0f, -1.0f, 0.0f,  0.0f, 0.0f,  // bottom-left
-         1.0f, -1.0f, 0.0f,  1.0f, 0.0f,  // bottom-right
-         1.0f,  1.0f, 0.0f,  1.0f, 1.0f,  // top-right
-        -1.0f,  1.0f, 0.0f,  0.0f, 1.0f   // top-left
-    };
-
-    GLuint tempVAO, tempVBO;
-    glGenVertexArrays(1, &tempVAO);
-    glGenBuffers(1, &tempVBO);
-
-    glBindVertexArray(tempVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, tempVBO);
-    glBufferData(GL_ARRAY_BUFFER, quad_vertices.size() * sizeof(float), quad_vertices.data(), GL_STATIC_DRAW);
-
-    // Position attribute (location 0)
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    // Texture coord attribute (location 1) - not used for debug red
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+    glUniform4f(color_location_, 1.0f, 1.0f, 1.0f, 1.0f);
+    glUniform1i(use_texture_location_, 1);  // Enable texture sampling
 
-    // Render quad covering entire texture
+    // Quad covering the entire texture
+    glBindVertexArray(vao_);
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-
-    // Clean up
-    glDeleteBuffers(1, &tempVBO);
-    glDeleteVertexArrays(1, &tempVAO);
-
-
 }
 
 void MiniMapRenderer::RenderGrid() {
-    glUseProgram(shader_program_);
-
     // Set grid color with opacity
-    glUniform4f(glGetUniformLocation(shader_program_, "uColor"), 1.0f, 1.0f, 1.0f, config_.grid_opacity);
-    glUniform1i(glGetUniformLocation(shader_program_, "uUseTexture"), 0);
+    glUniform4f(color_location_, 1.0f, 1.0f, 1.0f, config_.grid_opacity);
+    glUniform1i(use_texture_location_, 0);
 
     // Disable texture
     glBindTexture(GL_TEXTURE_2D, 0);
@@ -376,47 +436,24 @@ void MiniMapRenderer::RenderGrid() {
 }
 
 void MiniMapRenderer::RenderCameraPosition() {
-    // Render red dot at camera position
-    glUseProgram(shader_program_);
-
     // Set red color
-    glUniform4f(glGetUniformLocation(shader_program_, "uColor"), 1.0f, 0.0f, 0.0f, 1.0f);
-    glUniform1i(glGetUniformLocation(shader_program_, "uUseTexture"), 0);
+    glUniform4f(color_location_, 1.0f, 0.0f, 0.0f, 1.0f);
+    glUniform1i(use_texture_location_, 0);
 
     // Disable texture
     glBindTexture(GL_TEXTURE_2D, 0);
 
-    // Create small quad for camera position marker
-    std::vector<float> marker_vertices = {
-        -0.02f,  0.02f, 0.0f,
-         0.02f,  0.02f, 0.0f,
-         0.02f, -0.02f, 0.0f,
-        -0.02f, -0.02f, 0.0f
-    };
-
     // Position the marker
     glm::mat4 model = glm::translate(glm::mat4(1.0f),
         glm::vec3(2.0f * (camera_position_pixels_.x / config_.width) - 1.0f,
                   1.0f - 2.0f * (camera_position_pixels_.y / config_.height),
                   0.0f));
 
-    glUniformMatrix4fv(glGetUniformLocation(shader_program_, "uModel"), 1, GL_FALSE, glm::value_ptr(model));
+    glUniformMatrix4fv(model_location_, 1, GL_FALSE, glm::value_ptr(model));
 
     // Render marker
-    GLuint temp_vao, temp_vbo;
-    glGenVertexArrays(1, &temp_vao);
-    glGenBuffers(1, &temp_vbo);
-
-    glBindVertexArray(temp_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, temp_vbo);
-    glBufferData(GL_ARRAY_BUFFER, marker_vertices.size() * sizeof(float), marker_vertices.data(), GL_STATIC_DRAW);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
-    glEnableVertexAttribArray(0);
-
+    glBindVertexArray(marker_vao_);
     glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-
-    glDeleteBuffers(1, &temp_vbo);
-    glDeleteVertexArrays(1, &temp_vao);
 }
 
 void MiniMapRenderer::RenderFrustum(float aspect_ratio) {
@@ -432,7 +469,8 @@ void MiniMapRenderer::RenderFrustum(float aspect_ratio) {
     glm::vec3 camera_pos = camera_controller_->GetPosition();
 
     // Far plane corners are indices 4-7
-    std::vector<glm::vec3> frustum_intersections;
+    std::array<glm::vec3, 4> frustum_intersections;
+    std::size_t intersection_count = 0;
 
     // For each far corner, compute ray intersection with Earth
     for (int i = 4; i < 8; ++i) {
@@ -441,54 +479,41 @@ void MiniMapRenderer::RenderFrustum(float aspect_ratio) {
         glm::vec3 intersection = RaySphereIntersection(camera_pos, ray_dir, glm::vec3(0.0f), 1.0f);
 
         if (glm::length(intersection) > 0.0f) {
-            frustum_intersections.push_back(intersection);
+            frustum_intersections[intersection_count++] = intersection;
         }
     }
 
-    if (frustum_intersections.size() < 3) return; // Not enough points for rendering
-
     // Render trapezoid outline connecting frustum intersections
-    if (frustum_intersections.size() >= 4) {
-        glUseProgram(shader_program_);
-        glUniform4f(glGetUniformLocation(shader_program_, "uColor"), 1.0f, 1.0f, 1.0f, 1.0f); // White lines
-        glUniform1i(glGetUniformLocation(shader_program_, "uUseTexture"), 0);
-        glBindTexture(GL_TEXTURE_2D, 0);
-
-        // Set up orthographic projection (same as globe)
-        glm::mat4 projection = glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f);
-        glUniformMatrix4fv(glGetUniformLocation(shader_program_, "uProjection"), 1, GL_FALSE, glm::value_ptr(projection));
-
-        // Create trapezoid by connecting the 4 intersection points
-        std::vector<float> trapezoid_vertices;
-        for (size_t i = 0; i < frustum_intersections.size(); ++i) {
-            glm::vec2 uv1 = WorldToUV(frustum_intersections[i]);
-            glm::vec2 uv2 = WorldToUV(frustum_intersections[(i + 1) % frustum_intersections.size()]);
-
-            // Convert UV to NDC (-1 to 1)
-            float x1 = 2.0f * uv1.x - 1.0f;
-            float y1 = 2.0f * uv1.y - 1.0f;
-            float x2 = 2.0f * uv2.x - 1.0f;
-            float y2 = 2.0f * uv2.y - 1.0f;
-
-            trapezoid_vertices.insert(trapezoid_vertices.end(), {x1, y1, 0.0f, x2, y2, 0.0f});
-        }
+    if (intersection_count < 4) return;
 
-        // Render trapezoid outline
-        GLuint temp_vao, temp_vbo;
-        glGenVertexArrays(1, &temp_vao);
-        glGenBuffers(1, &temp_vbo);
+    glUniform4f(color_location_, 1.0f, 1.0f, 1.0f, 1.0f); // White lines
+    glUniform1i(use_texture_location_, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
 
-        glBindVertexArray(temp_vao);
-        glBindBuffer(GL_ARRAY_BUFFER, temp_vbo);
-        glBufferData(GL_ARRAY_BUFFER, trapezoid_vertices.size() * sizeof(float), trapezoid_vertices.data(), GL_STATIC_DRAW);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
-        glEnableVertexAttribArray(0);
+    const glm::mat4 model(1.0f);
+    glUniformMatrix4fv(model_location_, 1, GL_FALSE, glm::value_ptr(model));
+
+    // Create trapezoid by connecting the 4 intersection points
+    std::array<float, kMaxFrustumVertices * 3> trapezoid_vertices{};
+    std::size_t vertex_count = 0;
+    for (std::size_t i = 0; i < intersection_count; ++i) {
+        glm::vec2 uv1 = WorldToUV(frustum_intersections[i]);
+        glm::vec2 uv2 = WorldToUV(frustum_intersections[(i + 1) % intersection_count]);
+
+        // Convert UV to NDC (-1 to 1)
+        for (const glm::vec2& uv : {uv1, uv2}) {
+            trapezoid_vertices[vertex_count * 3] = 2.0f * uv.x - 1.0f;
+            trapezoid_vertices[vertex_count * 3 + 1] = 2.0f * uv.y - 1.0f;
+            ++vertex_count;
+        }
+    }
 
-        glDrawArrays(GL_LINES, 0, trapezoid_vertices.size() / 3);
+    // Rewrite the persistent outline buffer
+    glBindBuffer(GL_ARRAY_BUFFER, frustum_vbo_);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, vertex_count * 3 * sizeof(float), trapezoid_vertices.data());
 
-        glDeleteBuffers(1, &temp_vbo);
-        glDeleteVertexArrays(1, &temp_vao);
-    }
+    glBindVertexArray(frustum_vao_);
+    glDrawArrays(GL_LINES, 0, static_cast<GLsizei>(vertex_count));
 }
 
 glm::vec2 MiniMapRenderer::LatLonToPixel(float latitude, float longitude) const {
@@ -526,6 +551,7 @@ void MiniMapRenderer::SetSize(uint32_t width, uint32_t height) {
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture_, 0);
         glBindFramebuffer(GL_FRAMEBUFFER, 0);
     }
+    dirty_ = true;
 }
 
 void MiniMapRenderer::SetOffset(uint32_t offset_x, uint32_t offset_y) {
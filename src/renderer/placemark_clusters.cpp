@@ -0,0 +1,247 @@
+/**
+ * @file placemark_clusters.cpp
+ * @brief Placemark cluster hierarchy implementation
+ */
+
+#include <earth_map/renderer/placemark_clusters.h>
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace earth_map {
+
+namespace {
+
+/// Latitude where Web Mercator reaches y = 0 and y = 1
+constexpr double kMaxMercatorLatitude = 85.051128779806592;
+
+/// Smaller ranges are sorted on the calling thread
+constexpr std::size_t kParallelSortMin = 1u << 16;
+
+/// Levels of KD-tree sorting that fork a thread per half
+int ParallelDepth() {
+    int depth = 0;
+    for (unsigned threads = std::max(1u, std::thread::hardware_concurrency()); threads > 1;
+         threads >>= 1) {
+        ++depth;
+    }
+    return depth;
+}
+
+} // namespace
+
+glm::dvec2 PlacemarkClusterIndex::ToMercator(const glm::dvec3& world) {
+    const double length = glm::length(world);
+    if (length == 0.0) {
+        return glm::dvec2(0.5);
+    }
+    const double max_sin = std::sin(kMaxMercatorLatitude * M_PI / 180.0);
+    const double sin_lat = std::clamp(world.y / length, -max_sin, max_sin);
+    const double lon = std::atan2(world.x, world.z);
+    return glm::dvec2(lon / (2.0 * M_PI) + 0.5,
+                      0.5 - std::log((1.0 + sin_lat) / (1.0 - sin_lat)) / (4.0 * M_PI));
+}
+
+glm::dvec3 PlacemarkClusterIndex::FromMercator(const glm::dvec2& mercator) {
+    const double lon = (mercator.x - 0.5) * 2.0 * M_PI;
+    const double lat = std::atan(std::sinh((0.5 - mercator.y) * 2.0 * M_PI));
+    return glm::dvec3(std::cos(lat) * std::sin(lon), std::sin(lat), std::cos(lat) * std::cos(lon));
+}
+
+PlacemarkClusterIndex::PlacemarkClusterIndex(std::span<const glm::dvec3> positions,
+                                             std::span<const PlacemarkId> ids,
+                                             const PlacemarkClusterOptions& options)
+    : options_(options), point_count_(positions.size()) {
+    if (positions.size() != ids.size()) {
+        throw std::invalid_argument("PlacemarkClusterIndex needs one id per position");
+    }
+    options_.min_zoom = std::max(options_.min_zoom, 0);
+    options_.max_zoom = std::max(options_.max_zoom, options_.min_zoom);
+    options_.node_size = std::max<std::uint32_t>(options_.node_size, 1);
+
+    auto finer = std::make_shared<Level>();
+    finer->reserve(positions.size());
+    for (std::size_t i = 0; i < positions.size(); ++i) {
+        finer->push_back({ToMercator(positions[i]), 1, ids[i]});
+    }
+    const int parallel_depth = ParallelDepth();
+    SortKd(*finer, 0, parallel_depth);
+
+    levels_.resize(static_cast<std::size_t>(options_.max_zoom - options_.min_zoom + 1));
+    for (int zoom = options_.max_zoom; zoom >= options_.min_zoom; --zoom) {
+        Level level = Cluster(*finer, zoom);
+        if (level.size() != finer->size()) {
+            SortKd(level, 0, parallel_depth);
+            finer = std::make_shared<Level>(std::move(level));
+        }
+        levels_[static_cast<std::size_t>(zoom - options_.min_zoom)] = finer;
+    }
+}
+
+std::size_t PlacemarkClusterIndex::GetClusterCount(int zoom) const {
+    return levels_.empty() ? 0 : GetLevel(zoom).size();
+}
+
+std::size_t PlacemarkClusterIndex::GetMemoryUsage() const {
+    std::size_t bytes = levels_.capacity() * sizeof(levels_.front());
+    for (std::size_t i = 0; i < levels_.size(); ++i) {
+        if (i == 0 || levels_[i] != levels_[i - 1]) {
+            bytes += levels_[i]->capacity() * sizeof(PlacemarkCluster);
+        }
+    }
+    return bytes;
+}
+
+const PlacemarkClusterIndex::Level& PlacemarkClusterIndex::GetLevel(int zoom) const {
+    zoom = std::clamp(zoom, options_.min_zoom, options_.max_zoom);
+    return *levels_[static_cast<std::size_t>(zoom - options_.min_zoom)];
+}
+
+void PlacemarkClusterIndex::Query(int zoom, const glm::dvec2& min, const glm::dvec2& max,
+                                  std::vector<PlacemarkCluster>& clusters) const {
+    if (levels_.empty()) {
+        return;
+    }
+    const Level& level = GetLevel(zoom);
+    const auto inside = [&](const glm::dvec2& p) {
+        return p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y;
+    };
+
+    // Ranges [begin, end) split at their middle along axis, as sorted by SortKd
+    struct Range {
+        std::size_t begin;
+        std::size_t end;
+        int axis;
+    };
+    std::vector<Range> stack{{0, level.size(), 0}};
+    while (!stack.empty()) {
+        const Range range = stack.back();
+        stack.pop_back();
+        if (range.end - range.begin <= options_.node_size) {
+            for (std::size_t i = range.begin; i < range.end; ++i) {
+                if (inside(level[i].mercator)) {
+                    clusters.push_back(level[i]);
+                }
+            }
+            continue;
+        }
+        const std::size_t middle = range.begin + (range.end - range.begin) / 2;
+        const glm::dvec2& split = level[middle].mercator;
+        if (inside(split)) {
+            clusters.push_back(level[middle]);
+        }
+        if (min[range.axis] <= split[range.axis]) {
+            stack.push_back({range.begin, middle, 1 - range.axis});
+        }
+        if (max[range.axis] >= split[range.axis]) {
+            stack.push_back({middle + 1, range.end, 1 - range.axis});
+        }
+    }
+}
+
+void PlacemarkClusterIndex::Within(const Level& level, const glm::dvec2& center, double radius,
+                                   std::vector<std::uint32_t>& found) const {
+    const double radius_squared = radius * radius;
+    const auto near = [&](const glm::dvec2& p) {
+        const glm::dvec2 d = p - center;
+        return glm::dot(d, d) <= radius_squared;
+    };
+
+    struct Range {
+        std::size_t begin;
+        std::size_t end;
+        int axis;
+    };
+    std::vector<Range> stack{{0, level.size(), 0}};
+    while (!stack.empty()) {
+        const Range range = stack.back();
+        stack.pop_back();
+        if (range.end - range.begin <= options_.node_size) {
+            for (std::size_t i = range.begin; i < range.end; ++i) {
+                if (near(level[i].mercator)) {
+                    found.push_back(static_cast<std::uint32_t>(i));
+                }
+            }
+            continue;
+        }
+        const std::size_t middle = range.begin + (range.end - range.begin) / 2;
+        const glm::dvec2& split = level[middle].mercator;
+        if (near(split)) {
+            found.push_back(static_cast<std::uint32_t>(middle));
+        }
+        if (center[range.axis] - radius <= split[range.axis]) {
+            stack.push_back({range.begin, middle, 1 - range.axis});
+        }
+        if (center[range.axis] + radius >= split[range.axis]) {
+            stack.push_back({middle + 1, range.end, 1 - range.axis});
+        }
+    }
+}
+
+PlacemarkClusterIndex::Level PlacemarkClusterIndex::Cluster(const Level& level, int zoom) const {
+    const double radius = options_.radius_pixels / (options_.tile_extent * std::ldexp(1.0, zoom));
+    Level coarser;
+    coarser.reserve(level.size());
+    std::vector<std::uint8_t> claimed(level.size(), 0);
+    std::vector<std::uint32_t> neighbors;
+    for (std::size_t i = 0; i < level.size(); ++i) {
+        if (claimed[i]) {
+            continue;
+        }
+        claimed[i] = 1;
+        const PlacemarkCluster& seed = level[i];
+        neighbors.clear();
+        Within(level, seed.mercator, radius, neighbors);
+
+        std::uint64_t count = seed.count;
+        for (const std::uint32_t neighbor : neighbors) {
+            count += claimed[neighbor] ? 0 : level[neighbor].count;
+        }
+        if (count == seed.count || count < options_.min_points) {
+            // Unclaimed neighbors are left to seed or join clusters of their own
+            coarser.push_back(seed);
+            continue;
+        }
+
+        glm::dvec2 weighted = seed.mercator * static_cast<double>(seed.count);
+        for (const std::uint32_t neighbor : neighbors) {
+            if (!claimed[neighbor]) {
+                claimed[neighbor] = 1;
+                weighted += level[neighbor].mercator * static_cast<double>(level[neighbor].count);
+            }
+        }
+        coarser.push_back({weighted / static_cast<double>(count), static_cast<std::uint32_t>(count),
+                           PlacemarkStore::INVALID_ID});
+    }
+    return coarser;
+}
+
+void PlacemarkClusterIndex::SortKd(std::span<PlacemarkCluster> clusters, int axis,
+                                   int parallel_depth) const {
+    if (clusters.size() <= options_.node_size) {
+        return;
+    }
+    const std::size_t middle = clusters.size() / 2;
+    std::nth_element(clusters.begin(), clusters.begin() + static_cast<std::ptrdiff_t>(middle),
+                     clusters.end(), [axis](const PlacemarkCluster& a, const PlacemarkCluster& b) {
+                         return a.mercator[axis] < b.mercator[axis];
+                     });
+    const std::span<PlacemarkCluster> below = clusters.first(middle);
+    const std::span<PlacemarkCluster> above = clusters.subspan(middle + 1);
+    if (parallel_depth > 0 && clusters.size() >= kParallelSortMin) {
+        // The halves are disjoint: sort one on another thread
+        std::future<void> task = std::async(std::launch::async, [&]() {
+            SortKd(below, 1 - axis, parallel_depth - 1);
+        });
+        SortKd(above, 1 - axis, parallel_depth - 1);
+        task.get();
+        return;
+    }
+    SortKd(below, 1 - axis, 0);
+    SortKd(above, 1 - axis, 0);
+}
+
+} // namespace earth_map
@@ -0,0 +1,629 @@
+/**
+ * @file placemark_renderer.cpp
+ * @brief GPU-instanced placemark renderer implementation
+ */
+
+#include <earth_map/renderer/placemark_renderer.h>
+#include <earth_map/renderer/shader_loader.h>
+#include <earth_map/constants.h>
+#include <GL/glew.h>
+#include <glm/gtc/type_ptr.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <future>
+#include <vector>
+
+namespace earth_map {
+
+namespace {
+
+constexpr GLsizeiptr kPositionBytes = 3 * sizeof(float);
+constexpr GLsizeiptr kColorBytes = sizeof(std::uint32_t);
+constexpr GLsizeiptr kClusterBytes = 4 * sizeof(float);
+
+// Placemarks are relative to their style center, and the center relative to
+// the eye is computed in double on the CPU: the shader only adds small floats
+constexpr const char* kPointVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 aOffset;
+layout (location = 1) in vec4 aColor;
+
+uniform mat4 uViewRotation;
+uniform mat4 uProjection;
+uniform vec3 uCenterFromEye;
+uniform vec3 uCenter;
+uniform float uMetersToWorld;
+uniform float uSize;
+uniform vec4 uStyleColor;
+
+out vec4 Color;
+out vec2 TexCoord;
+
+void main() {
+    vec3 fromEye = aOffset + uCenterFromEye;
+    // The eye is below the placemark's horizon plane: behind the globe
+    bool hidden = dot(uCenter + aOffset, fromEye) > 0.0;
+    gl_Position = hidden ? vec4(0.0, 0.0, 2.0, 1.0)
+                         : uProjection * uViewRotation * vec4(fromEye * uMetersToWorld, 1.0);
+    gl_PointSize = uSize;
+    Color = aColor * uStyleColor;
+    TexCoord = vec2(0.0);
+}
+)";
+
+// One instance per placemark; the quad's corners come from gl_VertexID
+constexpr const char* kBillboardVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 aOffset;
+layout (location = 1) in vec4 aColor;
+
+uniform mat4 uViewRotation;
+uniform mat4 uProjection;
+uniform vec3 uCenterFromEye;
+uniform vec3 uCenter;
+uniform float uMetersToWorld;
+uniform float uSize;
+uniform vec4 uStyleColor;
+uniform vec2 uViewport;
+uniform vec2 uAnchor;
+
+out vec4 Color;
+out vec2 TexCoord;
+
+void main() {
+    vec2 corner = vec2(float(gl_VertexID & 1), float(gl_VertexID >> 1));
+    vec3 fromEye = aOffset + uCenterFromEye;
+    bool hidden = dot(uCenter + aOffset, fromEye) > 0.0;
+    vec4 clip = uProjection * uViewRotation * vec4(fromEye * uMetersToWorld, 1.0);
+    clip.xy += (corner - uAnchor) * (2.0 * uSize / uViewport) * clip.w;
+    gl_Position = hidden ? vec4(0.0, 0.0, 2.0, 1.0) : clip;
+    Color = aColor * uStyleColor;
+    TexCoord = vec2(corner.x, 1.0 - corner.y);
+}
+)";
+
+// Clusters: one point per cluster, sized by its count
+constexpr const char* kClusterVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 aOffset;
+layout (location = 1) in float aCount;
+
+uniform mat4 uViewRotation;
+uniform mat4 uProjection;
+uniform vec3 uCenterFromEye;
+uniform vec3 uCenter;
+uniform float uMetersToWorld;
+uniform float uSize;
+uniform vec4 uStyleColor;
+
+out vec4 Color;
+out vec2 TexCoord;
+
+void main() {
+    vec3 fromEye = aOffset + uCenterFromEye;
+    bool hidden = dot(uCenter + aOffset, fromEye) > 0.0;
+    gl_Position = hidden ? vec4(0.0, 0.0, 2.0, 1.0)
+                         : uProjection * uViewRotation * vec4(fromEye * uMetersToWorld, 1.0);
+    gl_PointSize = uSize * (1.0 + 0.5 * log2(aCount));
+    Color = uStyleColor;
+    TexCoord = vec2(0.0);
+}
+)";
+
+constexpr const char* kPlacemarkFragmentShader = R"(
+#version 330 core
+in vec4 Color;
+in vec2 TexCoord;
+
+uniform bool uPoints;
+uniform bool uUseTexture;
+uniform sampler2D uTexture;
+
+out vec4 FragColor;
+
+void main() {
+    vec4 color = Color;
+    if (uPoints) {
+        if (length(gl_PointCoord - vec2(0.5)) > 0.5) {
+            discard;
+        }
+    } else if (uUseTexture) {
+        color *= texture(uTexture, TexCoord);
+    }
+    if (color.a <= 0.0) {
+        discard;
+    }
+    FragColor = color;
+}
+)";
+
+struct UniformLocations {
+    GLint view_rotation = -1;
+    GLint projection = -1;
+    GLint center_from_eye = -1;
+    GLint center = -1;
+    GLint meters_to_world = -1;
+    GLint size = -1;
+    GLint style_color = -1;
+    GLint viewport = -1;
+    GLint anchor = -1;
+    GLint points = -1;
+    GLint use_texture = -1;
+    GLint texture = -1;
+};
+
+UniformLocations QueryUniformLocations(std::uint32_t program) {
+    UniformLocations locs;
+    locs.view_rotation = glGetUniformLocation(program, "uViewRotation");
+    locs.projection = glGetUniformLocation(program, "uProjection");
+    locs.center_from_eye = glGetUniformLocation(program, "uCenterFromEye");
+    locs.center = glGetUniformLocation(program, "uCenter");
+    locs.meters_to_world = glGetUniformLocation(program, "uMetersToWorld");
+    locs.size = glGetUniformLocation(program, "uSize");
+    locs.style_color = glGetUniformLocation(program, "uStyleColor");
+    locs.viewport = glGetUniformLocation(program, "uViewport");
+    locs.anchor = glGetUniformLocation(program, "uAnchor");
+    locs.points = glGetUniformLocation(program, "uPoints");
+    locs.use_texture = glGetUniformLocation(program, "uUseTexture");
+    locs.texture = glGetUniformLocation(program, "uTexture");
+    return locs;
+}
+
+/**
+ * @brief Web Mercator zoom whose pixels match the screen's below the camera
+ *
+ * @param eye Camera position in world units (globe radius 1)
+ */
+double ViewZoom(const glm::mat4& projection, const glm::dvec3& eye, std::uint32_t viewport_height,
+                float tile_extent) {
+    const double distance = glm::length(eye);
+    const double altitude = std::max(distance - 1.0, 1e-9);
+    const double cos_latitude = std::max(std::hypot(eye.x, eye.z) / distance, 1e-3);
+    // Screen pixels per radian of ground against Mercator pixels per radian at zoom 0
+    const double screen = 0.5 * viewport_height * projection[1][1] / altitude;
+    return std::log2(screen * 2.0 * M_PI * cos_latitude / tile_extent);
+}
+
+/**
+ * @brief Tiles of a zoom level around the view (the cluster query key)
+ */
+struct ClusterView {
+    int zoom = -1;
+    std::int64_t x0 = 0, x1 = 0;  ///< Tile columns [x0, x1), may wrap past [0, 2^zoom)
+    std::int64_t y0 = 0, y1 = 0;  ///< Tile rows [y0, y1)
+
+    bool operator==(const ClusterView&) const = default;
+};
+
+} // namespace
+
+class PlacemarkRendererImpl : public PlacemarkRenderer {
+public:
+    explicit PlacemarkRendererImpl(const PlacemarkRenderConfig& config) : config_(config) {}
+
+    ~PlacemarkRendererImpl() override {
+        for (GpuStyle& gpu : gpu_styles_) {
+            ReleaseStyle(gpu);
+        }
+        if (cluster_vao_) {
+            glDeleteVertexArrays(1, &cluster_vao_);
+            cluster_vao_ = 0;
+        }
+        if (cluster_buffer_) {
+            glDeleteBuffers(1, &cluster_buffer_);
+            cluster_buffer_ = 0;
+        }
+        for (std::uint32_t* program : {&point_program_, &billboard_program_, &cluster_program_}) {
+            if (*program) {
+                glDeleteProgram(*program);
+                *program = 0;
+            }
+        }
+    }
+
+    bool Initialize() override {
+        if (initialized_) {
+            return true;
+        }
+        const std::array<ShaderProgramSource, 3> sources = {{
+            {kPointVertexShader, kPlacemarkFragmentShader, "placemark_point"},
+            {kBillboardVertexShader, kPlacemarkFragmentShader, "placemark_billboard"},
+            {kClusterVertexShader, kPlacemarkFragmentShader, "placemark_cluster"},
+        }};
+        const std::vector<std::uint32_t> programs = ShaderLoader::CreatePrograms(sources);
+        point_program_ = programs[0];
+        billboard_program_ = programs[1];
+        cluster_program_ = programs[2];
+        if (point_program_ == 0 || billboard_program_ == 0 || cluster_program_ == 0) {
+            spdlog::error("Failed to create placemark shader programs");
+            return false;
+        }
+        point_locs_ = QueryUniformLocations(point_program_);
+        billboard_locs_ = QueryUniformLocations(billboard_program_);
+        cluster_locs_ = QueryUniformLocations(cluster_program_);
+        initialized_ = true;
+        return true;
+    }
+
+    PlacemarkStore& GetStore() override {
+        return store_;
+    }
+
+    void BuildClusters() override {
+        if (cluster_build_.valid()) {
+            // Started again once the running build completes
+            rebuild_clusters_ = true;
+            return;
+        }
+        std::vector<glm::dvec3> positions;
+        std::vector<PlacemarkId> ids;
+        positions.reserve(store_.GetCount());
+        ids.reserve(store_.GetCount());
+        for (PlacemarkStyleId style = 0; style < store_.GetStyleCount(); ++style) {
+            const glm::dvec3& center = store_.GetCenter(style);
+            const std::vector<float>& offsets = store_.GetPositions(style);
+            const std::vector<PlacemarkId>& style_ids = store_.GetIds(style);
+            for (std::size_t slot = 0; slot < store_.GetCount(style); ++slot) {
+                positions.push_back(center + glm::dvec3(offsets[3 * slot], offsets[3 * slot + 1],
+                                                        offsets[3 * slot + 2]));
+                ids.push_back(style_ids[slot]);
+            }
+        }
+        cluster_build_ = std::async(
+            std::launch::async,
+            [positions = std::move(positions), ids = std::move(ids), options = config_.clusters]() {
+                return std::make_shared<const PlacemarkClusterIndex>(positions, ids, options);
+            });
+    }
+
+    void Render(const glm::mat4& view_matrix, const glm::mat4& projection_matrix,
+                const glm::vec3& camera_position, std::uint32_t viewport_width,
+                std::uint32_t viewport_height) override {
+        stats_ = PlacemarkRenderStats{};
+        if (!initialized_) {
+            return;
+        }
+
+        constexpr double kEarthRadius = constants::geodetic::EARTH_MEAN_RADIUS;
+        const glm::dvec3 eye = glm::dvec3(camera_position) * kEarthRadius;
+        const glm::mat4 view_rotation = glm::mat4(glm::mat3(view_matrix));
+
+        const GLboolean blend = glIsEnabled(GL_BLEND);
+        const GLboolean point_size = glIsEnabled(GL_PROGRAM_POINT_SIZE);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glEnable(GL_PROGRAM_POINT_SIZE);
+
+        UpdateClusters();
+        const bool clustered =
+            clusters_ && RenderClusters(view_rotation, projection_matrix, camera_position, eye,
+                                        viewport_width, viewport_height);
+
+        gpu_styles_.resize(store_.GetStyleCount());
+        for (PlacemarkStyleId style = 0; style < gpu_styles_.size(); ++style) {
+            Upload(style);
+            const auto count = static_cast<GLsizei>(store_.GetCount(style));
+            if (count == 0 || clustered) {
+                continue;
+            }
+
+            const PlacemarkStyle& appearance = store_.GetStyle(style);
+            const bool points = appearance.shape == PlacemarkShape::POINT;
+            const UniformLocations& locs = points ? point_locs_ : billboard_locs_;
+            glUseProgram(points ? point_program_ : billboard_program_);
+
+            const glm::dvec3& center = store_.GetCenter(style);
+            const glm::vec3 center_from_eye(center - eye);
+            const glm::vec3 center_float(center);
+            glUniformMatrix4fv(locs.view_rotation, 1, GL_FALSE, glm::value_ptr(view_rotation));
+            glUniformMatrix4fv(locs.projection, 1, GL_FALSE, glm::value_ptr(projection_matrix));
+            glUniform3fv(locs.center_from_eye, 1, glm::value_ptr(center_from_eye));
+            glUniform3fv(locs.center, 1, glm::value_ptr(center_float));
+            glUniform1f(locs.meters_to_world, static_cast<float>(1.0 / kEarthRadius));
+            glUniform1f(locs.size, appearance.size_pixels);
+            glUniform4fv(locs.style_color, 1, glm::value_ptr(appearance.color));
+            glUniform1i(locs.points, points ? 1 : 0);
+
+            glBindVertexArray(gpu_styles_[style].vao);
+            if (points) {
+                glUniform1i(locs.use_texture, 0);
+                glDrawArrays(GL_POINTS, 0, count);
+            } else {
+                glUniform2f(locs.viewport, static_cast<float>(viewport_width),
+                            static_cast<float>(viewport_height));
+                glUniform2fv(locs.anchor, 1, glm::value_ptr(appearance.anchor));
+                glUniform1i(locs.use_texture, appearance.texture != 0 ? 1 : 0);
+                if (appearance.texture != 0) {
+                    glActiveTexture(GL_TEXTURE0);
+                    glBindTexture(GL_TEXTURE_2D, appearance.texture);
+                    glUniform1i(locs.texture, 0);
+                }
+                glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, count);
+            }
+            ++stats_.draw_calls;
+            stats_.placemarks_rendered += static_cast<std::size_t>(count);
+        }
+        glBindVertexArray(0);
+        glUseProgram(0);
+
+        if (!blend) glDisable(GL_BLEND);
+        if (!point_size) glDisable(GL_PROGRAM_POINT_SIZE);
+
+        for (const GpuStyle& gpu : gpu_styles_) {
+            stats_.gpu_memory_bytes += gpu.capacity * (kPositionBytes + kColorBytes);
+        }
+        stats_.gpu_memory_bytes += cluster_capacity_ * kClusterBytes;
+    }
+
+    PlacemarkRenderStats GetStats() const override {
+        return stats_;
+    }
+
+private:
+    /**
+     * @brief Persistent instance buffers of one style
+     */
+    struct GpuStyle {
+        std::uint32_t vao = 0;
+        std::uint32_t positions = 0;
+        std::uint32_t colors = 0;
+        std::size_t capacity = 0;  ///< Slots allocated in both buffers
+    };
+
+    void CreateStyle(PlacemarkStyleId style) {
+        GpuStyle& gpu = gpu_styles_[style];
+        const GLuint divisor = store_.GetStyle(style).shape == PlacemarkShape::POINT ? 0 : 1;
+        glGenVertexArrays(1, &gpu.vao);
+        glGenBuffers(1, &gpu.positions);
+        glGenBuffers(1, &gpu.colors);
+        glBindVertexArray(gpu.vao);
+
+        glBindBuffer(GL_ARRAY_BUFFER, gpu.positions);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, kPositionBytes, (void*)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribDivisor(0, divisor);
+
+        glBindBuffer(GL_ARRAY_BUFFER, gpu.colors);
+        glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, kColorBytes, (void*)0);
+        glEnableVertexAttribArray(1);
+        glVertexAttribDivisor(1, divisor);
+
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    /**
+     * @brief Adopt a completed cluster build; drop clusters the store outgrew
+     */
+    void UpdateClusters() {
+        if (cluster_build_.valid() &&
+            cluster_build_.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            clusters_ = cluster_build_.get();
+            cluster_view_ = ClusterView{};
+            if (rebuild_clusters_) {
+                rebuild_clusters_ = false;
+                BuildClusters();
+            }
+        }
+        if (clusters_ && clusters_->GetPointCount() != store_.GetCount()) {
+            clusters_.reset();
+            cluster_view_ = ClusterView{};
+        }
+    }
+
+    /**
+     * @brief Draw the clusters around the view if its zoom is clustered
+     *
+     * The clusters are queried and uploaded again only when the view moves
+     * to other tiles of the zoom level.
+     *
+     * @return true if clusters were drawn in place of the placemarks
+     */
+    bool RenderClusters(const glm::mat4& view_rotation, const glm::mat4& projection,
+                        const glm::vec3& camera_position, const glm::dvec3& eye,
+                        std::uint32_t viewport_width, std::uint32_t viewport_height) {
+        const PlacemarkClusterOptions& options = clusters_->GetOptions();
+        const double zoom = ViewZoom(projection, glm::dvec3(camera_position), viewport_height,
+                                     options.tile_extent);
+        if (!std::isfinite(zoom) || zoom >= options.max_zoom + 1) {
+            return false;
+        }
+
+        // Tiles within twice the screen's half diagonal (tilted views see farther)
+        ClusterView view;
+        view.zoom = std::max(static_cast<int>(std::floor(zoom)), options.min_zoom);
+        const std::int64_t tiles = std::int64_t{1} << view.zoom;
+        const glm::dvec2 center = PlacemarkClusterIndex::ToMercator(glm::dvec3(camera_position));
+        const double reach = std::hypot(viewport_width, viewport_height) /
+                             (options.tile_extent * std::exp2(zoom)) * static_cast<double>(tiles);
+        view.x0 = static_cast<std::int64_t>(std::floor(center.x * tiles - reach));
+        view.x1 = static_cast<std::int64_t>(std::ceil(center.x * tiles + reach));
+        view.y0 = std::max<std::int64_t>(0, static_cast<std::int64_t>(std::floor(center.y * tiles - reach)));
+        view.y1 = std::min(tiles, static_cast<std::int64_t>(std::ceil(center.y * tiles + reach)));
+        if (view.x1 - view.x0 >= tiles) {
+            view.x0 = 0;
+            view.x1 = tiles;
+        }
+        if (!(view == cluster_view_)) {
+            cluster_view_ = view;
+            UploadClusters(view);
+        }
+
+        glUseProgram(cluster_program_);
+        const glm::vec3 center_from_eye(cluster_center_ - eye);
+        const glm::vec3 center_float(cluster_center_);
+        glUniformMatrix4fv(cluster_locs_.view_rotation, 1, GL_FALSE, glm::value_ptr(view_rotation));
+        glUniformMatrix4fv(cluster_locs_.projection, 1, GL_FALSE, glm::value_ptr(projection));
+        glUniform3fv(cluster_locs_.center_from_eye, 1, glm::value_ptr(center_from_eye));
+        glUniform3fv(cluster_locs_.center, 1, glm::value_ptr(center_float));
+        glUniform1f(cluster_locs_.meters_to_world,
+                    static_cast<float>(1.0 / constants::geodetic::EARTH_MEAN_RADIUS));
+        glUniform1f(cluster_locs_.size, config_.cluster_size_pixels);
+        glUniform4fv(cluster_locs_.style_color, 1, glm::value_ptr(config_.cluster_color));
+        glUniform1i(cluster_locs_.points, 1);
+        glUniform1i(cluster_locs_.use_texture, 0);
+        if (cluster_count_ > 0) {
+            glBindVertexArray(cluster_vao_);
+            glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(cluster_count_));
+            ++stats_.draw_calls;
+        }
+        stats_.placemarks_rendered += cluster_count_;
+        stats_.clusters_rendered += cluster_count_;
+        return true;
+    }
+
+    /**
+     * @brief Query the clusters of a view and upload them relative to its center
+     */
+    void UploadClusters(const ClusterView& view) {
+        const double tiles = std::ldexp(1.0, view.zoom);
+        const double y0 = static_cast<double>(view.y0) / tiles;
+        const double y1 = static_cast<double>(view.y1) / tiles;
+        cluster_scratch_.clear();
+        // Columns past either edge wrap around the antimeridian
+        for (std::int64_t shift = -1; shift <= 1; ++shift) {
+            const double x0 = std::max(0.0, static_cast<double>(view.x0) / tiles + shift);
+            const double x1 = std::min(1.0, static_cast<double>(view.x1) / tiles + shift);
+            if (x0 < x1) {
+                clusters_->Query(view.zoom, glm::dvec2(x0, y0), glm::dvec2(x1, y1),
+                                 cluster_scratch_);
+            }
+        }
+
+        const glm::dvec2 center(0.5 * static_cast<double>(view.x0 + view.x1) / tiles,
+                                0.5 * (y0 + y1));
+        constexpr double kEarthRadius = constants::geodetic::EARTH_MEAN_RADIUS;
+        cluster_center_ = PlacemarkClusterIndex::FromMercator(center) * kEarthRadius;
+        cluster_vertices_.clear();
+        cluster_vertices_.reserve(4 * cluster_scratch_.size());
+        for (const PlacemarkCluster& cluster : cluster_scratch_) {
+            const glm::vec3 offset(PlacemarkClusterIndex::FromMercator(cluster.mercator) *
+                                       kEarthRadius - cluster_center_);
+            cluster_vertices_.insert(cluster_vertices_.end(),
+                                     {offset.x, offset.y, offset.z,
+                                      static_cast<float>(cluster.count)});
+        }
+        cluster_count_ = cluster_scratch_.size();
+
+        if (cluster_vao_ == 0) {
+            glGenVertexArrays(1, &cluster_vao_);
+            glGenBuffers(1, &cluster_buffer_);
+            glBindVertexArray(cluster_vao_);
+            glBindBuffer(GL_ARRAY_BUFFER, cluster_buffer_);
+            glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, kClusterBytes, (void*)0);
+            glEnableVertexAttribArray(0);
+            glVertexAttribPointer(1, 1, GL_FLOAT, GL_FALSE, kClusterBytes,
+                                  (void*)(3 * sizeof(float)));
+            glEnableVertexAttribArray(1);
+            glBindVertexArray(0);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, cluster_buffer_);
+        if (cluster_count_ > cluster_capacity_) {
+            cluster_capacity_ = std::max<std::size_t>(
+                {cluster_count_, cluster_capacity_ * 2, config_.initial_capacity});
+            glBufferData(GL_ARRAY_BUFFER, cluster_capacity_ * kClusterBytes, nullptr,
+                         GL_DYNAMIC_DRAW);
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, 0, cluster_count_ * kClusterBytes,
+                        cluster_vertices_.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        ++stats_.buffer_updates;
+        stats_.uploaded_bytes += cluster_count_ * kClusterBytes;
+    }
+
+    static void ReleaseStyle(GpuStyle& gpu) {
+        if (gpu.vao) {
+            glDeleteVertexArrays(1, &gpu.vao);
+            gpu.vao = 0;
+        }
+        for (std::uint32_t* buffer : {&gpu.positions, &gpu.colors}) {
+            if (*buffer) {
+                glDeleteBuffers(1, buffer);
+                *buffer = 0;
+            }
+        }
+        gpu.capacity = 0;
+    }
+
+    /**
+     * @brief Bring a style's buffers up to date with the store
+     *
+     * Edited slots are uploaded run by run; the buffers are reallocated
+     * (and fully uploaded) only when the style outgrows them.
+     */
+    void Upload(PlacemarkStyleId style) {
+        GpuStyle& gpu = gpu_styles_[style];
+        const std::size_t count = store_.GetCount(style);
+        if (gpu.vao == 0) {
+            if (count == 0) {
+                return;
+            }
+            CreateStyle(style);
+        }
+
+        const std::vector<float>& positions = store_.GetPositions(style);
+        const std::vector<std::uint32_t>& colors = store_.GetColors(style);
+        const std::vector<PlacemarkUploadRange> ranges =
+            store_.TakeDirtyRanges(style, config_.merge_gap);
+
+        if (count > gpu.capacity) {
+            gpu.capacity = std::max<std::size_t>({count, gpu.capacity * 2, config_.initial_capacity});
+            glBindBuffer(GL_ARRAY_BUFFER, gpu.positions);
+            glBufferData(GL_ARRAY_BUFFER, gpu.capacity * kPositionBytes, nullptr, GL_DYNAMIC_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, count * kPositionBytes, positions.data());
+            glBindBuffer(GL_ARRAY_BUFFER, gpu.colors);
+            glBufferData(GL_ARRAY_BUFFER, gpu.capacity * kColorBytes, nullptr, GL_DYNAMIC_DRAW);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, count * kColorBytes, colors.data());
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+            stats_.uploaded_bytes += count * (kPositionBytes + kColorBytes);
+            return;
+        }
+
+        for (const PlacemarkUploadRange& range : ranges) {
+            glBindBuffer(GL_ARRAY_BUFFER, gpu.positions);
+            glBufferSubData(GL_ARRAY_BUFFER, range.first * kPositionBytes,
+                            range.count * kPositionBytes, positions.data() + 3 * range.first);
+            glBindBuffer(GL_ARRAY_BUFFER, gpu.colors);
+            glBufferSubData(GL_ARRAY_BUFFER, range.first * kColorBytes,
+                            range.count * kColorBytes, colors.data() + range.first);
+            stats_.buffer_updates += 2;
+            stats_.uploaded_bytes += range.count * (kPositionBytes + kColorBytes);
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    PlacemarkRenderConfig config_;
+    PlacemarkStore store_;
+    std::vector<GpuStyle> gpu_styles_;
+    PlacemarkRenderStats stats_;
+    bool initialized_ = false;
+
+    std::uint32_t point_program_ = 0;
+    std::uint32_t billboard_program_ = 0;
+    std::uint32_t cluster_program_ = 0;
+    UniformLocations point_locs_;
+    UniformLocations billboard_locs_;
+    UniformLocations cluster_locs_;
+
+    // Clusters
+    std::future<std::shared_ptr<const PlacemarkClusterIndex>> cluster_build_;
+    bool rebuild_clusters_ = false;
+    std::shared_ptr<const PlacemarkClusterIndex> clusters_;
+    ClusterView cluster_view_;              ///< View of the uploaded clusters
+    glm::dvec3 cluster_center_{0.0};        ///< Meters; the uploaded offsets are from it
+    std::size_t cluster_count_ = 0;
+    std::size_t cluster_capacity_ = 0;
+    std::uint32_t cluster_vao_ = 0;
+    std::uint32_t cluster_buffer_ = 0;
+    std::vector<PlacemarkCluster> cluster_scratch_;
+    std::vector<float> cluster_vertices_;
+};
+
+std::unique_ptr<PlacemarkRenderer> PlacemarkRenderer::Create(const PlacemarkRenderConfig& config) {
+    return std::make_unique<PlacemarkRendererImpl>(config);
+}
+
+} // namespace earth_map
@@ -0,0 +1,169 @@
+#include <earth_map/renderer/placemark_store.h>
+#include <earth_map/constants.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace earth_map {
+
+std::uint32_t PlacemarkStore::PackColor(const glm::vec4& color) {
+    const auto channel = [](float value) {
+        return static_cast<std::uint32_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * 255.0f));
+    };
+    // Bytes R, G, B, A in memory order on little-endian hosts
+    return channel(color.x) | (channel(color.y) << 8) | (channel(color.z) << 16) |
+           (channel(color.w) << 24);
+}
+
+glm::dvec3 PlacemarkStore::ToWorldMeters(const coordinates::Geographic& position) {
+    const double lat = position.latitude * M_PI / 180.0;
+    const double lon = position.longitude * M_PI / 180.0;
+    const double radius = constants::geodetic::EARTH_MEAN_RADIUS + position.altitude;
+    return glm::dvec3(radius * std::cos(lat) * std::sin(lon), radius * std::sin(lat),
+                      radius * std::cos(lat) * std::cos(lon));
+}
+
+PlacemarkStyleId PlacemarkStore::AddStyle(const PlacemarkStyle& style) {
+    StyleData data;
+    data.style = style;
+    if (style.center) {
+        data.center = ToWorldMeters(*style.center);
+        data.has_center = true;
+    }
+    styles_.push_back(std::move(data));
+    return static_cast<PlacemarkStyleId>(styles_.size() - 1);
+}
+
+PlacemarkId PlacemarkStore::Add(PlacemarkStyleId style, const coordinates::Geographic& position,
+                                std::uint32_t color) {
+    if (style >= styles_.size()) {
+        throw std::out_of_range("Unknown placemark style");
+    }
+    StyleData& data = styles_[style];
+    if (!data.has_center) {
+        data.center = ToWorldMeters(position);
+        data.has_center = true;
+    }
+
+    PlacemarkId id;
+    if (!free_ids_.empty()) {
+        id = free_ids_.back();
+        free_ids_.pop_back();
+    } else {
+        id = static_cast<PlacemarkId>(locations_.size());
+        locations_.emplace_back();
+    }
+
+    const auto slot = static_cast<std::uint32_t>(data.ids.size());
+    locations_[id] = Location{style, slot, true};
+    data.ids.push_back(id);
+    data.positions.resize(data.positions.size() + 3);
+    data.colors.push_back(color);
+    data.dirty.push_back(0);
+    WritePosition(data, slot, position);
+    MarkDirty(data, slot);
+    ++count_;
+    return id;
+}
+
+bool PlacemarkStore::Update(PlacemarkId id, const coordinates::Geographic& position) {
+    if (!Contains(id)) {
+        return false;
+    }
+    const Location& location = locations_[id];
+    StyleData& data = styles_[location.style];
+    WritePosition(data, location.slot, position);
+    MarkDirty(data, location.slot);
+    return true;
+}
+
+bool PlacemarkStore::SetColor(PlacemarkId id, std::uint32_t color) {
+    if (!Contains(id)) {
+        return false;
+    }
+    const Location& location = locations_[id];
+    StyleData& data = styles_[location.style];
+    data.colors[location.slot] = color;
+    MarkDirty(data, location.slot);
+    return true;
+}
+
+bool PlacemarkStore::Remove(PlacemarkId id) {
+    if (!Contains(id)) {
+        return false;
+    }
+    Location& location = locations_[id];
+    StyleData& data = styles_[location.style];
+    const std::uint32_t slot = location.slot;
+    const auto last = static_cast<std::uint32_t>(data.ids.size() - 1);
+    if (slot != last) {
+        const PlacemarkId moved = data.ids[last];
+        data.ids[slot] = moved;
+        std::copy_n(data.positions.begin() + 3 * last, 3, data.positions.begin() + 3 * slot);
+        data.colors[slot] = data.colors[last];
+        locations_[moved].slot = slot;
+        MarkDirty(data, slot);
+    }
+    data.ids.pop_back();
+    data.positions.resize(3 * static_cast<std::size_t>(last));
+    data.colors.pop_back();
+    // The last slot's flag stays in dirty_slots until taken, then is dropped
+    data.dirty.pop_back();
+
+    location.live = false;
+    free_ids_.push_back(id);
+    --count_;
+    return true;
+}
+
+bool PlacemarkStore::Contains(PlacemarkId id) const {
+    return id < locations_.size() && locations_[id].live;
+}
+
+std::vector<PlacemarkUploadRange> PlacemarkStore::TakeDirtyRanges(PlacemarkStyleId style,
+                                                                  std::uint32_t merge_gap) {
+    StyleData& data = styles_[style];
+    std::vector<std::uint32_t>& slots = data.dirty_slots;
+    std::sort(slots.begin(), slots.end());
+
+    std::vector<PlacemarkUploadRange> ranges;
+    const auto count = static_cast<std::uint32_t>(data.ids.size());
+    for (const std::uint32_t slot : slots) {
+        if (slot >= count) {
+            break;
+        }
+        data.dirty[slot] = 0;
+        if (!ranges.empty()) {
+            PlacemarkUploadRange& back = ranges.back();
+            const std::uint32_t end = back.first + back.count;
+            if (slot == end - 1) {
+                continue;  // Duplicate of a slot removed and re-added
+            }
+            if (slot - end <= merge_gap) {
+                back.count = slot - back.first + 1;
+                continue;
+            }
+        }
+        ranges.push_back({slot, 1});
+    }
+    slots.clear();
+    return ranges;
+}
+
+void PlacemarkStore::WritePosition(StyleData& data, std::uint32_t slot,
+                                   const coordinates::Geographic& position) {
+    const glm::dvec3 offset = ToWorldMeters(position) - data.center;
+    float* out = &data.positions[3 * static_cast<std::size_t>(slot)];
+    out[0] = static_cast<float>(offset.x);
+    out[1] = static_cast<float>(offset.y);
+    out[2] = static_cast<float>(offset.z);
+}
+
+void PlacemarkStore::MarkDirty(StyleData& data, std::uint32_t slot) {
+    if (!data.dirty[slot]) {
+        data.dirty[slot] = 1;
+        data.dirty_slots.push_back(slot);
+    }
+}
+
+} // namespace earth_map
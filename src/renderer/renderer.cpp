@@ -1,21 +1,32 @@
 #include <earth_map/renderer/renderer.h>
 #include <earth_map/renderer/shader_loader.h>
+#include <earth_map/renderer/shader_program_cache.h>
 #include <earth_map/renderer/elevation_manager.h>
 #include <earth_map/data/elevation_provider.h>
 #include <earth_map/earth_map.h>
 #include <earth_map/constants.h>
 #include <earth_map/platform/opengl_context.h>
 #include <earth_map/renderer/tile_renderer.h>
+#include <earth_map/renderer/tile_request_merger.h>
 #include <earth_map/renderer/globe_mesh.h>
+#include <earth_map/renderer/globe_mesh_cache.h>
+#include <earth_map/renderer/gpu_resource_manager.h>
+#include <earth_map/renderer/gpu_frame_profiler.h>
+#include <earth_map/renderer/adaptive_quality_controller.h>
 #include <earth_map/renderer/mini_map_renderer.h>
+#include <earth_map/renderer/placemark_renderer.h>
+#include <earth_map/renderer/labels/label_renderer.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <spdlog/spdlog.h>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
+#include <algorithm>
 #include <stdexcept>
 #include <vector>
 #include <array>
+#include <filesystem>
+#include <future>
 
 namespace earth_map {
 
@@ -23,8 +34,7 @@ namespace earth_map {
 const char* BASIC_VERTEX_SHADER = R"(
 #version 330 core
 layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
-layout (location = 2) in vec2 aTexCoord;
+layout (location = 1) in vec2 aNormal;  // Octahedral (PackedGlobeVertex)
 
 uniform mat4 uModel;
 uniform mat4 uView;
@@ -34,10 +44,25 @@ out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoord;
 
+const float PI = 3.14159265358979;
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) {
+        n.xy = (1.0 - abs(e.yx)) * vec2(e.x >= 0.0 ? 1.0 : -1.0, e.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return normalize(n);
+}
+
 void main() {
     FragPos = vec3(uModel * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(uModel))) * aNormal;
-    TexCoord = aTexCoord;
+    Normal = mat3(transpose(inverse(uModel))) * octDecode(aNormal);
+
+    // Equirectangular texture coordinates from the direction
+    vec3 direction = normalize(aPos);
+    float lon = (direction.x == 0.0 && direction.z == 0.0) ? 0.0 : atan(direction.x, direction.z);
+    float lat = asin(clamp(direction.y, -1.0, 1.0));
+    TexCoord = vec2((lon + PI) / (2.0 * PI), (lat + 0.5 * PI) / PI);
     
     gl_Position = uProjection * uView * vec4(FragPos, 1.0);
 }
@@ -116,6 +141,15 @@ void main() {
 }
 )";
 
+/**
+ * @brief View drawn after the main view, with tiles of its own selection
+ */
+struct RenderView {
+    std::uint32_t id = 0;
+    RenderViewConfig config;
+    std::unique_ptr<TileRenderer> tiles;
+};
+
 /**
  * @brief Basic renderer implementation
  */
@@ -139,7 +173,14 @@ public:
         
         try {
             // Initialize GLEW
-            if (glewInit() != GLEW_OK) {
+            const GLenum glew_status = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+            // A headless (EGL) context has no GLX display; the GL entry points still load
+            const bool glew_loaded = glew_status == GLEW_OK || glew_status == GLEW_ERROR_NO_GLX_DISPLAY;
+#else
+            const bool glew_loaded = glew_status == GLEW_OK;
+#endif
+            if (!glew_loaded) {
                 spdlog::error("Failed to initialize GLEW");
                 return false;
             }
@@ -147,61 +188,29 @@ public:
             // Check OpenGL version
             const GLubyte* version = glGetString(GL_VERSION);
             spdlog::info("OpenGL Version: {}", reinterpret_cast<const char*>(version));
-            
-            if (!LoadShaders()) {
-                spdlog::error("Failed to load shaders");
-                return false;
-            }
 
-            // Create elevation manager if enabled
-            if (config_.elevation_config.enabled) {
-                spdlog::info("Creating elevation manager (elevation rendering enabled)");
-                try {
-                    // Create elevation provider with SRTM loader
-                    auto elevation_provider = ElevationProvider::Create(config_.srtm_loader_config);
-
-                    // Create elevation manager
-                    elevation_manager_ = ElevationManager::Create(elevation_provider);
-                    if (!elevation_manager_->Initialize(config_.elevation_config)) {
-                        spdlog::error("Failed to initialize elevation manager");
-                        return false;
-                    }
-
-                    spdlog::info("Elevation manager created successfully");
-                } catch (const std::exception& e) {
-                    spdlog::error("Exception creating elevation manager: {}", e.what());
-                    return false;
-                }
-            } else {
-                spdlog::info("Elevation rendering disabled");
+            // Every program created from here on is restored from its binary when cached
+            if (config_.cache_shader_binaries && !config_.cache_directory.empty()) {
+                ShaderLoader::SetProgramCache(std::make_shared<ShaderProgramCache>(
+                    (std::filesystem::path(config_.cache_directory) / "shaders").string(),
+                    ShaderLoader::QueryDriverId()));
             }
+            
+            // The globe mesh (and the SRTM warm-up its displacement needs) is
+            // GL-free: build it on a worker while the shaders compile here
+            auto geometry = std::async(std::launch::async, [this] { return BuildGlobeGeometry(); });
 
-            // Create icosahedron globe mesh with normalized radius
-            GlobeMeshParams params;
-            params.radius = static_cast<double>(constants::rendering::NORMALIZED_GLOBE_RADIUS);
-            params.max_subdivision_level = constants::rendering::DEFAULT_GLOBE_SUBDIVISION;
-            params.enable_adaptive = false;  // Start simple, can enable later
-            params.quality = MeshQuality::HIGH;
-            params.enable_crack_prevention = true;
-
-            globe_mesh_ = GlobeMesh::Create(params);
-
-            // Set elevation manager on globe mesh before generation
-            if (elevation_manager_) {
-                auto icosahedron_mesh = dynamic_cast<IcosahedronGlobeMesh*>(globe_mesh_.get());
-                if (icosahedron_mesh) {
-                    icosahedron_mesh->SetElevationManager(elevation_manager_);
-                }
-            }
+            const bool shaders_loaded = LoadShaders();
+            gpu_resources_ = GPUResourceManager::Create();
+            profiler_ = std::make_unique<GpuFrameProfiler>(true);
 
-            if (!globe_mesh_->Generate()) {
-                spdlog::error("Failed to generate globe mesh");
+            if (!geometry.get()) {
+                return false;
+            }
+            if (!shaders_loaded) {
+                spdlog::error("Failed to load shaders");
                 return false;
             }
-
-            spdlog::info("Globe mesh generated with {} vertices and {} triangles",
-                globe_mesh_->GetVertices().size(),
-                globe_mesh_->GetTriangles().size());
 
             SetupOpenGLState();
 
@@ -216,7 +225,10 @@ public:
         spdlog::info("Viewport set to {}x{}", config_.screen_width, config_.screen_height);
 
     // Initialize tile renderer
-        tile_renderer_ = TileRenderer::Create();
+        TileRenderConfig tile_render_config;
+        tile_render_config.terrain.enabled =
+            elevation_manager_ && config_.elevation_config.gpu_terrain;
+        tile_renderer_ = TileRenderer::Create(tile_render_config);
         if (!tile_renderer_ || !tile_renderer_->Initialize()) {
             spdlog::error("Failed to create or initialize tile renderer");
             return false;
@@ -224,8 +236,31 @@ public:
 
         // CRITICAL: Set the icosahedron mesh on tile renderer
         // Tile renderer MUST use this mesh, not generate its own
+        tile_renderer_->SetGPUResourceManager(gpu_resources_.get());
+        tile_renderer_->SetFrameProfiler(profiler_.get());
+        tile_renderer_->SetRequestMerger(&request_merger_);
+        full_quality_tiles_ = tile_render_config;
+        quality_controller_.SetConfig(config_.adaptive_quality);
+        quality_controller_.Reset();
         tile_renderer_->SetGlobeMesh(globe_mesh_.get());
+        tile_renderer_->SetViewportSize(config_.screen_width, config_.screen_height);
         spdlog::info("Icosahedron mesh provided to tile renderer");
+        if (tile_render_config.terrain.enabled) {
+            tile_renderer_->SetElevationManager(elevation_manager_.get());
+            spdlog::info("Elevation displaces terrain patches on the GPU");
+        }
+
+        placemark_renderer_ = PlacemarkRenderer::Create();
+        if (!placemark_renderer_->Initialize()) {
+            spdlog::error("Failed to initialize placemark renderer");
+            return false;
+        }
+
+        label_renderer_ = LabelRenderer::Create();
+        if (!label_renderer_->Initialize()) {
+            spdlog::error("Failed to initialize label renderer");
+            return false;
+        }
 
         // Initialize mini-map renderer with valid shader program
         MiniMapRenderer::Config mini_map_config;
@@ -263,12 +298,17 @@ public:
         }
 
         // SINGLE RENDERING PATH: Always use tile renderer
-        // Tile renderer now uses the icosahedron mesh (with elevation displacement)
+        // Tile renderer uses the icosahedron mesh, or terrain patches displaced on the GPU
         // Missing tiles are handled by base color in shader (no fallback mesh needed)
+        const FrameSnapshot snapshot = MakeSnapshot(view_matrix, projection_matrix, frustum);
         if (tile_renderer_) {
+            // Tile selection runs on a worker while BeginFrame() uploads textures
+            tile_renderer_->BeginTileSelection(snapshot);
+
             tile_renderer_->BeginFrame();
+            tile_renderer_->SetCameraVelocity(snapshot.camera_velocity);
             tile_renderer_->UpdateVisibleTiles(view_matrix, projection_matrix,
-                                                 camera_controller_->GetPosition(), frustum);
+                                                 snapshot.camera_position, frustum);
             tile_renderer_->RenderTiles(view_matrix, projection_matrix);
             tile_renderer_->EndFrame();
         } else {
@@ -276,6 +316,23 @@ public:
             spdlog::error("Tile renderer not available - nothing to render");
         }
 
+        // Placemarks over the globe, depth-tested against it
+        if (placemark_renderer_) {
+            GpuFrameProfiler::Scope scope(profiler_.get(), RenderPass::PLACEMARKS);
+            placemark_renderer_->Render(view_matrix, projection_matrix,
+                                        snapshot.camera_position,
+                                        config_.screen_width, config_.screen_height);
+            stats_.placemarks_rendered = placemark_renderer_->GetStats().placemarks_rendered;
+        }
+
+        // Labels last, as a screen overlay placed without overlaps
+        if (label_renderer_) {
+            GpuFrameProfiler::Scope scope(profiler_.get(), RenderPass::LABELS);
+            label_renderer_->Render(view_matrix, projection_matrix, snapshot.camera_position,
+                                    config_.screen_width, config_.screen_height);
+            stats_.labels_placed = label_renderer_->GetStats().placed;
+        }
+
         // OLD: Fallback rendering removed - tile renderer handles everything now
         // No more dual-mesh system!
         /*
@@ -394,6 +451,9 @@ public:
 
     
     void BeginFrame() override {
+        if (profiler_) {
+            profiler_->BeginFrame();
+        }
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
         glClearColor(0.1f, 0.1f, 0.2f, 1.0f);
     }
@@ -401,12 +461,42 @@ public:
     void EndFrame() override {
         // Update stats (simplified)
         stats_.draw_calls = 1;
-        if (globe_mesh_) {
-            stats_.triangles_rendered = globe_mesh_->GetVertexIndices().size() / 3;
-            stats_.vertices_processed = globe_mesh_->GetVertices().size();
+        if (const GPUMesh* gpu_mesh = globe_mesh_ ? gpu_resources_->GetGlobeMesh(*globe_mesh_) : nullptr) {
+            stats_.draw_calls = static_cast<std::uint32_t>(gpu_mesh->chunks.size());
+            stats_.triangles_rendered = static_cast<std::uint32_t>(gpu_mesh->index_count / 3);
+            stats_.vertices_processed = static_cast<std::uint32_t>(gpu_mesh->vertex_count);
+            stats_.gpu_memory_mb = gpu_resources_->GetStats().buffer_bytes / (1024 * 1024);
+        }
+
+        if (profiler_) {
+            profiler_->EndFrame();
+            stats_.frame_time_ms = profiler_->GetCpuFrameMs();
+            stats_.gpu_frame_time_ms = profiler_->GetGpuFrameMs();
+            stats_.pass_timings = profiler_->GetTimings();
+            UpdateQuality();
         }
     }
     
+    void UpdateQuality() {
+        if (!quality_controller_.Update(profiler_->GetCpuFrameMs(), profiler_->GetGpuFrameMs())) {
+            return;
+        }
+        const QualitySettings settings = quality_controller_.GetSettings();
+        stats_.quality_level = quality_controller_.GetLevel();
+        stats_.resolution_scale = settings.resolution_scale;
+        if (tile_renderer_) {
+            // Keep fields set by others since; the controller owns only the quality ones
+            TileRenderConfig config = tile_renderer_->GetConfig();
+            const TileRenderConfig scaled = quality_controller_.Apply(full_quality_tiles_);
+            config.max_visible_tiles = scaled.max_visible_tiles;
+            config.upload_budget_us = scaled.upload_budget_us;
+            config.selection.max_texel_error = scaled.selection.max_texel_error;
+            tile_renderer_->SetConfig(config);
+        }
+        spdlog::info("Adaptive quality level {} (load {:.2f})",
+                     stats_.quality_level, quality_controller_.GetLoad());
+    }
+
     void Render() override {
         if (!initialized_) {
             return;
@@ -439,11 +529,17 @@ public:
 
         // Render mini-map overlay
         if (mini_map_enabled_ && mini_map_renderer_ && camera_controller_) {
-            mini_map_renderer_->Render(static_cast<float>(config_.screen_width) / config_.screen_height); // Render mini-map to texture
+            GpuFrameProfiler::Scope scope(profiler_.get(), RenderPass::MINI_MAP);
             mini_map_renderer_->Update(camera_controller_, config_.screen_width, config_.screen_height);
+            // Redraws the mini-map texture only if the camera moved
+            mini_map_renderer_->Render(static_cast<float>(config_.screen_width) / config_.screen_height);
             RenderMiniMapOverlay();
         }
 
+        RenderViews();
+        // One request generation for the tiles of every view
+        request_merger_.Flush();
+
         spdlog::debug("Renderer::Render() - EndFrame");
         EndFrame();
         spdlog::debug("Renderer::Render() - complete");
@@ -453,6 +549,9 @@ public:
         config_.screen_width = width;
         config_.screen_height = height;
         glViewport(0, 0, width, height);
+        if (tile_renderer_) {
+            tile_renderer_->SetViewportSize(width, height);
+        }
         spdlog::debug("Renderer resized to {}x{}", width, height);
     }
     
@@ -482,6 +581,92 @@ public:
         return tile_renderer_.get();
     }
 
+    bool PrepareTiles(const glm::mat4& view_matrix, const glm::mat4& projection_matrix) override {
+        if (!initialized_ || !tile_renderer_) {
+            return false;
+        }
+        const FrameSnapshot snapshot =
+            MakeSnapshot(view_matrix, projection_matrix, Frustum(projection_matrix * view_matrix));
+        tile_renderer_->BeginTileSelection(snapshot);
+        tile_renderer_->BeginFrame();
+        tile_renderer_->SetCameraVelocity(snapshot.camera_velocity);
+        tile_renderer_->UpdateVisibleTiles(view_matrix, projection_matrix,
+                                           snapshot.camera_position, snapshot.frustum);
+        tile_renderer_->EndFrame();
+        request_merger_.Flush();
+
+        const TileRenderStats tiles = tile_renderer_->GetStats();
+        return tiles.visible_tiles > 0 && tiles.ready_tiles == tiles.visible_tiles;
+    }
+
+    void SetTileSystem(TileManager* tile_manager, TileTextureCoordinator* coordinator) override {
+        tile_manager_ = tile_manager;
+        texture_coordinator_ = coordinator;
+        request_merger_.SetCoordinator(coordinator);
+        if (tile_renderer_) {
+            tile_renderer_->SetTileManager(tile_manager);
+            tile_renderer_->SetTextureCoordinator(coordinator);
+        }
+        for (RenderView& view : views_) {
+            view.tiles->SetTileManager(tile_manager);
+            view.tiles->SetTextureCoordinator(coordinator);
+        }
+    }
+
+    std::uint32_t AddView(const RenderViewConfig& config) override {
+        ValidateView(config);
+        if (!initialized_) {
+            throw std::invalid_argument("Renderer: AddView() before Initialize()");
+        }
+
+        // Same settings as the main view's tiles; the main view uploads
+        TileRenderConfig tile_config = full_quality_tiles_;
+        tile_config.process_uploads = false;
+        auto tiles = TileRenderer::Create(tile_config);
+        if (!tiles->Initialize()) {
+            throw std::runtime_error("Renderer: cannot initialize the tile renderer of a view");
+        }
+        tiles->SetGPUResourceManager(gpu_resources_.get());
+        tiles->SetGlobeMesh(globe_mesh_.get());
+        if (tile_config.terrain.enabled) {
+            tiles->SetElevationManager(elevation_manager_.get());
+        }
+        if (texture_coordinator_) {
+            tiles->SetTileManager(tile_manager_);
+            tiles->SetTextureCoordinator(texture_coordinator_);
+        }
+        tiles->SetRequestMerger(&request_merger_, config.priority_weight);
+        tiles->SetViewportSize(config.width, config.height);
+
+        const std::uint32_t id = next_view_id_++;
+        views_.push_back({id, config, std::move(tiles)});
+        spdlog::info("Added view {} ({}x{}, weight {})", id, config.width, config.height,
+                     config.priority_weight);
+        return id;
+    }
+
+    bool UpdateView(std::uint32_t id, const RenderViewConfig& config) override {
+        ValidateView(config);
+        RenderView* view = FindView(id);
+        if (!view) {
+            return false;
+        }
+        view->config = config;
+        view->tiles->SetRequestMerger(&request_merger_, config.priority_weight);
+        view->tiles->SetViewportSize(config.width, config.height);
+        return true;
+    }
+
+    bool RemoveView(std::uint32_t id) override {
+        const auto it = std::find_if(views_.begin(), views_.end(),
+                                     [id](const RenderView& view) { return view.id == id; });
+        if (it == views_.end()) {
+            return false;
+        }
+        views_.erase(it);
+        return true;
+    }
+
     ElevationManager* GetElevationManager() override {
         return elevation_manager_.get();
     }
@@ -495,7 +680,11 @@ public:
     }
 
     PlacemarkRenderer* GetPlacemarkRenderer() override {
-        return nullptr;
+        return placemark_renderer_.get();
+    }
+
+    LabelRenderer* GetLabelRenderer() override {
+        return label_renderer_.get();
     }
 
     LODManager* GetLODManager() override {
@@ -503,9 +692,106 @@ public:
     }
 
     GPUResourceManager* GetGPUResourceManager() override {
+        return gpu_resources_.get();
+    }
+
+    /**
+     * @brief Camera state of a main-view frame, read once
+     *
+     * The camera position comes from the view matrix, so views rendered
+     * with explicit matrices (RenderScene(), PrepareTiles()) need no camera.
+     */
+    FrameSnapshot MakeSnapshot(const glm::mat4& view_matrix, const glm::mat4& projection_matrix,
+                               const Frustum& frustum) {
+        FrameSnapshot snapshot;
+        snapshot.frame_index = ++frame_index_;
+        snapshot.view = view_matrix;
+        snapshot.projection = projection_matrix;
+        snapshot.frustum = frustum;
+        snapshot.camera_position = glm::vec3(glm::inverse(view_matrix)[3]);
+        if (camera_controller_) {
+            snapshot.camera_velocity = camera_controller_->GetVelocity();
+        }
+        snapshot.viewport_width = config_.screen_width;
+        snapshot.viewport_height = config_.screen_height;
+        return snapshot;
+    }
+
+    static void ValidateView(const RenderViewConfig& config) {
+        if (!config.camera || config.width == 0 || config.height == 0) {
+            throw std::invalid_argument("Renderer: a view needs a camera and a non-empty viewport");
+        }
+        if (!(config.priority_weight > 0.0f)) {
+            throw std::invalid_argument("Renderer: view priority weight must be positive");
+        }
+    }
+
+    RenderView* FindView(std::uint32_t id) {
+        for (RenderView& view : views_) {
+            if (view.id == id) {
+                return &view;
+            }
+        }
         return nullptr;
     }
 
+    /**
+     * @brief Draw the additional views into their framebuffers
+     *
+     * Each view selects and draws its tiles with its own camera; uploads
+     * and the request generation are left to the main view and Render().
+     */
+    void RenderViews() {
+        if (views_.empty()) {
+            return;
+        }
+
+        GLint previous_framebuffer = 0;
+        GLint viewport[4];
+        glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous_framebuffer);
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        const GLboolean scissor_test = glIsEnabled(GL_SCISSOR_TEST);
+        glEnable(GL_SCISSOR_TEST);
+
+        for (RenderView& view : views_) {
+            const RenderViewConfig& config = view.config;
+            glBindFramebuffer(GL_FRAMEBUFFER, config.framebuffer);
+            glViewport(config.x, config.y, config.width, config.height);
+            glScissor(config.x, config.y, config.width, config.height);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+            const float aspect_ratio = static_cast<float>(config.width) / config.height;
+            FrameSnapshot snapshot;
+            snapshot.frame_index = frame_index_;
+            snapshot.view = config.camera->GetViewMatrix();
+            snapshot.projection = config.camera->GetProjectionMatrix(aspect_ratio);
+            snapshot.frustum = config.camera->GetFrustum(aspect_ratio);
+            snapshot.camera_position = config.camera->GetPosition();
+            snapshot.camera_velocity = config.camera->GetVelocity();
+            snapshot.viewport_width = config.width;
+            snapshot.viewport_height = config.height;
+
+            view.tiles->BeginTileSelection(snapshot);
+            view.tiles->BeginFrame();
+            view.tiles->SetCameraVelocity(snapshot.camera_velocity);
+            view.tiles->UpdateVisibleTiles(snapshot.view, snapshot.projection,
+                                           snapshot.camera_position, snapshot.frustum);
+            view.tiles->RenderTiles(snapshot.view, snapshot.projection);
+            view.tiles->EndFrame();
+
+            if (config.draw_placemarks && placemark_renderer_) {
+                placemark_renderer_->Render(snapshot.view, snapshot.projection,
+                                            snapshot.camera_position, config.width, config.height);
+            }
+        }
+
+        if (!scissor_test) {
+            glDisable(GL_SCISSOR_TEST);
+        }
+        glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previous_framebuffer));
+        glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    }
+
     void RenderMiniMapOverlay() {
         if (!mini_map_renderer_) return;
 
@@ -556,38 +842,8 @@ public:
         glUniform4f(glGetUniformLocation(minimap_shader_program_, "uColor"), 1.0f, 1.0f, 1.0f, 1.0f);
         glUniform1i(glGetUniformLocation(minimap_shader_program_, "uUseTexture"), 1);
 
-        // Create screen quad vertices (0-1 space) with flipped texture V coordinates
-        std::vector<float> quad_vertices = {
-            // positions        // tex coords
-            0.0f, 0.0f, 0.0f,   0.0f, 1.0f,  // bottom-left -> tex 0,1 (flipped)
-            1.0f, 0.0f, 0.0f,   1.0f, 1.0f,  // bottom-right -> tex 1,1 (flipped)
-            1.0f, 1.0f, 0.0f,   1.0f, 0.0f,  // top-right -> tex 1,0 (flipped)
-            0.0f, 1.0f, 0.0f,   0.0f, 0.0f   // top-left -> tex 0,0 (flipped)
-        };
-
-        // Create temporary VAO for screen quad
-        GLuint tempVAO, tempVBO;
-        glGenVertexArrays(1, &tempVAO);
-        glGenBuffers(1, &tempVBO);
-
-        glBindVertexArray(tempVAO);
-        glBindBuffer(GL_ARRAY_BUFFER, tempVBO);
-        glBufferData(GL_ARRAY_BUFFER, quad_vertices.size() * sizeof(float), quad_vertices.data(), GL_STATIC_DRAW);
-
-        // Position attribute (location 0)
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
-
-        // Texture coord attribute (location 1)
-        glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
-        glEnableVertexAttribArray(1);
-
-        // Render quad
-        glDrawArrays(GL_TRIANGLE_FAN, 0, 4);
-
-        // Clean up
-        glDeleteBuffers(1, &tempVBO);
-        glDeleteVertexArrays(1, &tempVAO);
+        // Screen quad (0-1 space) with flipped texture V coordinates
+        mini_map_renderer_->DrawOverlayQuad();
 
         // Restore GL states
         if (depthTest) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
@@ -599,43 +855,111 @@ private:
     Configuration config_;
     bool initialized_ = false;
     RenderStats stats_;
+    std::uint64_t frame_index_ = 0;  // Frames rendered, stamped on FrameSnapshot
     
     // OpenGL objects
     std::uint32_t shader_program_ = 0;
     std::uint32_t minimap_shader_program_ = 0;
-    std::uint32_t vao_ = 0;
-    std::uint32_t vbo_ = 0;
-    std::uint32_t ebo_ = 0;
-    
-    // Globe mesh (icosahedron-based)
+    // Globe mesh (icosahedron-based) and the GPU buffers of meshes
     std::unique_ptr<GlobeMesh> globe_mesh_;
+    std::unique_ptr<GPUResourceManager> gpu_resources_;
+    std::unique_ptr<GpuFrameProfiler> profiler_;  // Per-pass CPU/GPU timings
+    AdaptiveQualityController quality_controller_;  // Fed by profiler_
+    TileRenderConfig full_quality_tiles_;  // Tile config at quality level 0
 
     // Expected mesh counts for corruption detection
     std::size_t expected_globe_vertex_count_ = 0;
     std::size_t expected_globe_index_count_ = 0;
 
     std::unique_ptr<TileRenderer> tile_renderer_;
+    TileManager* tile_manager_ = nullptr;                   // Shared by all views
+    TileTextureCoordinator* texture_coordinator_ = nullptr; // Shared by all views
+    TileRequestMerger request_merger_;  // Tile requests of the main view and views_, flushed per frame
+
+    std::vector<RenderView> views_;
+    std::uint32_t next_view_id_ = 1;
+
+    std::unique_ptr<PlacemarkRenderer> placemark_renderer_;
+    std::unique_ptr<LabelRenderer> label_renderer_;
     std::shared_ptr<MiniMapRenderer> mini_map_renderer_;
     std::shared_ptr<ElevationManager> elevation_manager_;
     CameraController* camera_controller_ = nullptr;
     bool mini_map_enabled_ = false;
 
-    bool LoadShaders() {
-        shader_program_ = ShaderLoader::CreateProgram(
-            BASIC_VERTEX_SHADER, BASIC_FRAGMENT_SHADER, "basic");
-        if (shader_program_ == 0) {
-            return false;
+    /**
+     * @brief Create the elevation manager and generate the globe mesh
+     *
+     * Touches no GL state, so Initialize() runs it off the GL thread.
+     */
+    bool BuildGlobeGeometry() {
+        // Create elevation manager if enabled
+        if (config_.elevation_config.enabled) {
+            spdlog::info("Creating elevation manager (elevation rendering enabled)");
+            try {
+                // Create elevation provider with SRTM loader
+                auto elevation_provider = ElevationProvider::Create(config_.srtm_loader_config);
+
+                // Create elevation manager
+                elevation_manager_ = ElevationManager::Create(elevation_provider);
+                if (!elevation_manager_->Initialize(config_.elevation_config)) {
+                    spdlog::error("Failed to initialize elevation manager");
+                    return false;
+                }
+
+                spdlog::info("Elevation manager created successfully");
+            } catch (const std::exception& e) {
+                spdlog::error("Exception creating elevation manager: {}", e.what());
+                return false;
+            }
+        } else {
+            spdlog::info("Elevation rendering disabled");
+        }
+
+        // Create icosahedron globe mesh with normalized radius
+        GlobeMeshParams params;
+        params.radius = static_cast<double>(constants::rendering::NORMALIZED_GLOBE_RADIUS);
+        params.max_subdivision_level = constants::rendering::DEFAULT_GLOBE_SUBDIVISION;
+        params.enable_adaptive = false;  // Start simple, can enable later
+        params.quality = MeshQuality::HIGH;
+        params.enable_crack_prevention = true;
+
+        globe_mesh_ = GlobeMesh::Create(params);
+
+        auto icosahedron_mesh = dynamic_cast<IcosahedronGlobeMesh*>(globe_mesh_.get());
+        if (icosahedron_mesh) {
+            // Set elevation manager on globe mesh before generation (CPU
+            // displacement; GPU terrain patches leave the mesh undisplaced)
+            if (elevation_manager_ && !config_.elevation_config.gpu_terrain) {
+                icosahedron_mesh->SetElevationManager(elevation_manager_);
+            }
+            if (config_.cache_globe_mesh && !config_.cache_directory.empty()) {
+                icosahedron_mesh->SetMeshCache(std::make_shared<GlobeMeshCache>(
+                    (std::filesystem::path(config_.cache_directory) / "meshes").string()));
+            }
         }
 
-        minimap_shader_program_ = ShaderLoader::CreateProgram(
-            MINIMAP_VERTEX_SHADER, MINIMAP_FRAGMENT_SHADER, "minimap");
-        if (minimap_shader_program_ == 0) {
+        if (!globe_mesh_->Generate()) {
+            spdlog::error("Failed to generate globe mesh");
             return false;
         }
 
+        spdlog::info("Globe mesh generated with {} vertices and {} triangles",
+            globe_mesh_->GetVertices().size(),
+            globe_mesh_->GetTriangles().size());
         return true;
     }
 
+    bool LoadShaders() {
+        const std::array<ShaderProgramSource, 2> sources = {{
+            {BASIC_VERTEX_SHADER, BASIC_FRAGMENT_SHADER, "basic"},
+            {MINIMAP_VERTEX_SHADER, MINIMAP_FRAGMENT_SHADER, "minimap"},
+        }};
+        const std::vector<std::uint32_t> programs = ShaderLoader::CreatePrograms(sources);
+        shader_program_ = programs[0];
+        minimap_shader_program_ = programs[1];
+        return shader_program_ != 0 && minimap_shader_program_ != 0;
+    }
+
 
     void SetupOpenGLState() {
         if (!globe_mesh_) {
@@ -643,65 +967,11 @@ private:
             return;
         }
 
-        // Convert GlobeVertex data to OpenGL format
-        const auto& vertices = globe_mesh_->GetVertices();
-        const auto& indices = globe_mesh_->GetVertexIndices();
-
-        // Flatten vertex data: position(3) + normal(3) + texcoord(2) = 8 floats per vertex
-        std::vector<float> vertex_data;
-        vertex_data.reserve(vertices.size() * 8);
-
-        for (const auto& vertex : vertices) {
-            // Position
-            vertex_data.push_back(vertex.position.x);
-            vertex_data.push_back(vertex.position.y);
-            vertex_data.push_back(vertex.position.z);
-            // Normal
-            vertex_data.push_back(vertex.normal.x);
-            vertex_data.push_back(vertex.normal.y);
-            vertex_data.push_back(vertex.normal.z);
-            // Texcoord
-            vertex_data.push_back(vertex.texcoord.x);
-            vertex_data.push_back(vertex.texcoord.y);
+        // The globe's buffers live in the GPU resource manager, shared with the tile renderer
+        if (!gpu_resources_->SyncGlobeMesh(*globe_mesh_)) {
+            spdlog::error("Failed to upload globe mesh to GPU");
         }
 
-        // Create VAO, VBO, EBO
-        glGenVertexArrays(1, &vao_);
-        glGenBuffers(1, &vbo_);
-        glGenBuffers(1, &ebo_);
-
-        // Bind VAO
-        glBindVertexArray(vao_);
-
-        // Bind and fill VBO
-        glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-        glBufferData(GL_ARRAY_BUFFER, vertex_data.size() * sizeof(float),
-                    vertex_data.data(), GL_STATIC_DRAW);
-
-        // Bind and fill EBO
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(std::uint32_t),
-                    indices.data(), GL_STATIC_DRAW);
-
-        // Set vertex attributes
-        // Position (location = 0)
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
-
-        // Normal (location = 1)
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-        glEnableVertexAttribArray(1);
-
-        // Texture coordinates (location = 2)
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-        glEnableVertexAttribArray(2);
-
-        // Unbind VAO
-        glBindVertexArray(0);
-
-        spdlog::info("Globe mesh uploaded to GPU: {} vertices, {} indices",
-            vertices.size(), indices.size());
-
         // Enable depth testing
         glEnable(GL_DEPTH_TEST);
         glDepthFunc(GL_LESS);
@@ -718,17 +988,15 @@ private:
     }
     
     void Cleanup() {
-        if (vao_) {
-            glDeleteVertexArrays(1, &vao_);
-            vao_ = 0;
-        }
-        if (vbo_) {
-            glDeleteBuffers(1, &vbo_);
-            vbo_ = 0;
-        }
-        if (ebo_) {
-            glDeleteBuffers(1, &ebo_);
-            ebo_ = 0;
+        // Joins the terrain elevation builds still reading from elevation_manager_
+        views_.clear();
+        tile_renderer_.reset();
+        placemark_renderer_.reset();
+        label_renderer_.reset();
+        profiler_.reset();
+
+        if (gpu_resources_) {
+            gpu_resources_->Release();
         }
         if (shader_program_) {
             glDeleteProgram(shader_program_);
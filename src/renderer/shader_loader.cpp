@@ -4,69 +4,234 @@
  */
 
 #include <earth_map/renderer/shader_loader.h>
+#include <earth_map/renderer/shader_program_cache.h>
 #include <spdlog/spdlog.h>
 #include <GL/glew.h>
 #include <array>
+#include <mutex>
 
 namespace earth_map {
 
-std::uint32_t ShaderLoader::CompileShader(std::uint32_t type,
-                                          const char* source,
-                                          const std::string& shader_name) {
-    const std::uint32_t shader = glCreateShader(type);
-    glShaderSource(shader, 1, &source, nullptr);
-    glCompileShader(shader);
+namespace {
 
-    std::int32_t success = 0;
-    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
-    if (!success) {
-        std::array<char, 1024> info_log{};
-        glGetShaderInfoLog(shader, static_cast<GLsizei>(info_log.size()), nullptr, info_log.data());
-        spdlog::error("{} compilation failed: {}", shader_name, info_log.data());
-        glDeleteShader(shader);
-        return 0;
+std::mutex cache_mutex;
+std::shared_ptr<ShaderProgramCache> program_cache;
+
+std::string GetGlString(GLenum name) {
+    const GLubyte* value = glGetString(name);
+    return value ? reinterpret_cast<const char*>(value) : "";
+}
+
+bool SupportsProgramBinaries() {
+    if (!GLEW_VERSION_4_1 && !GLEW_ARB_get_program_binary) {
+        return false;
     }
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+} // namespace
+
+void ShaderLoader::SetProgramCache(std::shared_ptr<ShaderProgramCache> cache) {
+    if (cache && !SupportsProgramBinaries()) {
+        spdlog::info("Driver offers no program binary format, shaders compile at every start");
+        cache.reset();
+    }
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    program_cache = std::move(cache);
+}
+
+std::shared_ptr<ShaderProgramCache> ShaderLoader::GetProgramCache() {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    return program_cache;
+}
 
-    return shader;
+std::string ShaderLoader::QueryDriverId() {
+    return GetGlString(GL_VENDOR) + "|" + GetGlString(GL_RENDERER) + "|" + GetGlString(GL_VERSION);
 }
 
 std::uint32_t ShaderLoader::CreateProgram(const char* vertex_source,
                                           const char* fragment_source,
                                           const std::string& program_name) {
-    const std::uint32_t vertex_shader = CompileShader(
-        GL_VERTEX_SHADER, vertex_source, program_name + " vertex");
-    if (vertex_shader == 0) {
-        return 0;
+    const ShaderProgramSource source{vertex_source, fragment_source, program_name};
+    return CreatePrograms(std::span(&source, 1)).front();
+}
+
+std::vector<std::uint32_t> ShaderLoader::CreatePrograms(
+    std::span<const ShaderProgramSource> sources) {
+    EnableParallelCompile();
+    const std::shared_ptr<ShaderProgramCache> cache = GetProgramCache();
+
+    std::vector<std::uint32_t> programs(sources.size(), 0);
+    std::vector<PendingProgram> pending(sources.size());
+
+    // Submit every compile and link first: the driver may build them in
+    // parallel, and checking a status is what waits for one to finish
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        if (cache) {
+            const std::uint64_t key = cache->MakeKey(sources[i].vertex_source,
+                                                     sources[i].fragment_source);
+            programs[i] = LoadCachedProgram(*cache, key);
+            if (programs[i] != 0) {
+                spdlog::info("{} shader program loaded from binary cache", sources[i].name);
+                continue;
+            }
+            cache->RecordMiss();
+            pending[i] = SubmitProgram(sources[i], true);
+            pending[i].cache_key = key;
+        } else {
+            pending[i] = SubmitProgram(sources[i], false);
+        }
     }
 
-    const std::uint32_t fragment_shader = CompileShader(
-        GL_FRAGMENT_SHADER, fragment_source, program_name + " fragment");
-    if (fragment_shader == 0) {
-        glDeleteShader(vertex_shader);
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        if (pending[i].program != 0) {
+            programs[i] = FinishProgram(pending[i], sources[i], cache.get());
+        }
+    }
+    return programs;
+}
+
+std::uint32_t ShaderLoader::CreateComputeProgram(const char* compute_source,
+                                                 const std::string& program_name) {
+    const std::uint32_t shader = glCreateShader(GL_COMPUTE_SHADER);
+    glShaderSource(shader, 1, &compute_source, nullptr);
+    glCompileShader(shader);
+    if (!CheckShader(shader, program_name + " compute")) {
+        glDeleteShader(shader);
         return 0;
     }
 
     const std::uint32_t program = glCreateProgram();
-    glAttachShader(program, vertex_shader);
-    glAttachShader(program, fragment_shader);
+    glAttachShader(program, shader);
     glLinkProgram(program);
-
-    // Shaders can be deleted after linking
-    glDeleteShader(vertex_shader);
-    glDeleteShader(fragment_shader);
+    glDeleteShader(shader);
 
     std::int32_t success = 0;
     glGetProgramiv(program, GL_LINK_STATUS, &success);
     if (!success) {
         std::array<char, 1024> info_log{};
-        glGetProgramInfoLog(program, static_cast<GLsizei>(info_log.size()), nullptr, info_log.data());
+        glGetProgramInfoLog(program, static_cast<GLsizei>(info_log.size()), nullptr,
+                            info_log.data());
         spdlog::error("{} program linking failed: {}", program_name, info_log.data());
         glDeleteProgram(program);
         return 0;
     }
+    spdlog::info("{} compute program linked successfully", program_name);
+    return program;
+}
 
-    spdlog::info("{} shader program linked successfully", program_name);
+std::uint32_t ShaderLoader::LoadCachedProgram(const ShaderProgramCache& cache, std::uint64_t key) {
+    const std::optional<ShaderProgramBinary> binary = cache.Load(key);
+    if (!binary) {
+        return 0;
+    }
+
+    const std::uint32_t program = glCreateProgram();
+    glProgramBinary(program, binary->format, binary->data.data(),
+                    static_cast<GLsizei>(binary->data.size()));
+
+    // Drivers refuse binaries of another driver build; compile from source then
+    std::int32_t success = 0;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        glDeleteProgram(program);
+        cache.RecordRejected();
+        return 0;
+    }
+    cache.RecordHit();
     return program;
 }
 
+ShaderLoader::PendingProgram ShaderLoader::SubmitProgram(const ShaderProgramSource& source,
+                                                         bool retrievable) {
+    PendingProgram pending;
+    pending.vertex_shader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(pending.vertex_shader, 1, &source.vertex_source, nullptr);
+    glCompileShader(pending.vertex_shader);
+
+    pending.fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(pending.fragment_shader, 1, &source.fragment_source, nullptr);
+    glCompileShader(pending.fragment_shader);
+
+    pending.program = glCreateProgram();
+    if (retrievable) {
+        glProgramParameteri(pending.program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glAttachShader(pending.program, pending.vertex_shader);
+    glAttachShader(pending.program, pending.fragment_shader);
+    glLinkProgram(pending.program);
+    return pending;
+}
+
+std::uint32_t ShaderLoader::FinishProgram(PendingProgram& pending,
+                                          const ShaderProgramSource& source,
+                                          ShaderProgramCache* cache) {
+    std::int32_t success = 0;
+    glGetProgramiv(pending.program, GL_LINK_STATUS, &success);
+
+    // A failed link is reported through the shader that did not compile, if any
+    const bool compiled = CheckShader(pending.vertex_shader, source.name + " vertex") &&
+                          CheckShader(pending.fragment_shader, source.name + " fragment");
+
+    // Shaders can be deleted after linking
+    glDeleteShader(pending.vertex_shader);
+    glDeleteShader(pending.fragment_shader);
+
+    if (!success) {
+        if (compiled) {
+            std::array<char, 1024> info_log{};
+            glGetProgramInfoLog(pending.program, static_cast<GLsizei>(info_log.size()), nullptr,
+                                info_log.data());
+            spdlog::error("{} program linking failed: {}", source.name, info_log.data());
+        }
+        glDeleteProgram(pending.program);
+        return 0;
+    }
+
+    if (cache) {
+        std::int32_t length = 0;
+        glGetProgramiv(pending.program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length > 0) {
+            ShaderProgramBinary binary;
+            binary.data.resize(static_cast<std::size_t>(length));
+            GLenum format = 0;
+            glGetProgramBinary(pending.program, length, nullptr, &format, binary.data.data());
+            binary.format = format;
+            cache->Store(pending.cache_key, binary);
+        }
+    }
+
+    spdlog::info("{} shader program linked successfully", source.name);
+    return pending.program;
+}
+
+bool ShaderLoader::CheckShader(std::uint32_t shader, const std::string& shader_name) {
+    std::int32_t success = 0;
+    glGetShaderiv(shader, GL_COMPILE_STATUS, &success);
+    if (!success) {
+        std::array<char, 1024> info_log{};
+        glGetShaderInfoLog(shader, static_cast<GLsizei>(info_log.size()), nullptr, info_log.data());
+        spdlog::error("{} compilation failed: {}", shader_name, info_log.data());
+        return false;
+    }
+    return true;
+}
+
+void ShaderLoader::EnableParallelCompile() {
+    // Once per process: the thread count is context state, and the renderer
+    // creates programs on one context
+    static std::once_flag enabled;
+    std::call_once(enabled, [] {
+        if (GLEW_KHR_parallel_shader_compile) {
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);  // Driver's choice
+            spdlog::info("Parallel shader compilation enabled");
+        } else if (GLEW_ARB_parallel_shader_compile) {
+            glMaxShaderCompilerThreadsARB(0xFFFFFFFFu);
+            spdlog::info("Parallel shader compilation enabled");
+        }
+    });
+}
+
 } // namespace earth_map
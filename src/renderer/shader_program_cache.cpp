@@ -0,0 +1,130 @@
+/**
+ * @file shader_program_cache.cpp
+ * @brief On-disk program binary cache implementation
+ */
+
+#include <earth_map/renderer/shader_program_cache.h>
+#include <earth_map/data/crc32c.h>
+#include <spdlog/spdlog.h>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+
+namespace earth_map {
+
+namespace {
+
+constexpr std::uint32_t kMagic = 0x42534d45;  // "EMSB"
+constexpr std::uint32_t kFileVersion = 1;
+
+/// Binary file header, followed by `size` bytes of program binary
+struct FileHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t format;
+    std::uint32_t size;
+    std::uint32_t checksum;  ///< CRC32C of the binary
+};
+
+constexpr std::uint64_t kFnvOffset = 14695981039346656037ULL;
+constexpr std::uint64_t kFnvPrime = 1099511628211ULL;
+
+std::uint64_t Fnv1a64(std::string_view bytes, std::uint64_t hash) {
+    for (const char c : bytes) {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= kFnvPrime;
+    }
+    return hash;
+}
+
+} // namespace
+
+ShaderProgramCache::ShaderProgramCache(std::string directory, std::string driver_id)
+    : directory_(std::move(directory)), driver_id_(std::move(driver_id)) {
+}
+
+std::uint64_t ShaderProgramCache::MakeKey(std::string_view vertex_source,
+                                          std::string_view fragment_source) const {
+    // Separators keep ("ab", "c") and ("a", "bc") apart
+    std::uint64_t hash = Fnv1a64(driver_id_, kFnvOffset);
+    hash = Fnv1a64(std::string_view("\0", 1), hash);
+    hash = Fnv1a64(vertex_source, hash);
+    hash = Fnv1a64(std::string_view("\0", 1), hash);
+    return Fnv1a64(fragment_source, hash);
+}
+
+std::optional<ShaderProgramBinary> ShaderProgramCache::Load(std::uint64_t key) const {
+    std::ifstream file(GetPath(key), std::ios::binary);
+    if (!file) {
+        return std::nullopt;
+    }
+
+    FileHeader header{};
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+        header.magic != kMagic || header.version != kFileVersion) {
+        RecordRejected();
+        return std::nullopt;
+    }
+
+    ShaderProgramBinary binary;
+    binary.format = header.format;
+    binary.data.resize(header.size);
+    if (!file.read(reinterpret_cast<char*>(binary.data.data()),
+                   static_cast<std::streamsize>(binary.data.size())) ||
+        Crc32c(binary.data) != header.checksum) {
+        spdlog::warn("Discarding corrupt shader binary {}", GetPath(key));
+        RecordRejected();
+        return std::nullopt;
+    }
+    return binary;
+}
+
+bool ShaderProgramCache::Store(std::uint64_t key, const ShaderProgramBinary& binary) const {
+    std::error_code error;
+    std::filesystem::create_directories(directory_, error);
+
+    const std::string path = GetPath(key);
+    const std::string temp_path =
+        path + ".tmp" + std::to_string(temp_counter_.fetch_add(1, std::memory_order_relaxed));
+    {
+        std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+        const FileHeader header{kMagic, kFileVersion, binary.format,
+                                static_cast<std::uint32_t>(binary.data.size()),
+                                Crc32c(binary.data)};
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(binary.data.data()),
+                   static_cast<std::streamsize>(binary.data.size()));
+        if (!file) {
+            file.close();
+            std::filesystem::remove(temp_path, error);
+            spdlog::warn("Cannot write shader binary {}", path);
+            return false;
+        }
+    }
+
+    // rename() replaces atomically: a concurrent Load() sees the old or the new file
+    std::filesystem::rename(temp_path, path, error);
+    if (error) {
+        std::filesystem::remove(temp_path, error);
+        return false;
+    }
+    stores_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+ShaderProgramCacheStats ShaderProgramCache::GetStats() const {
+    ShaderProgramCacheStats stats;
+    stats.hits = hits_.load(std::memory_order_relaxed);
+    stats.misses = misses_.load(std::memory_order_relaxed);
+    stats.rejected = rejected_.load(std::memory_order_relaxed);
+    stats.stores = stores_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::string ShaderProgramCache::GetPath(std::uint64_t key) const {
+    char name[32];
+    std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+    return (std::filesystem::path(directory_) / name).string();
+}
+
+} // namespace earth_map
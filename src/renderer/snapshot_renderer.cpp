@@ -0,0 +1,288 @@
+/**
+ * @file snapshot_renderer.cpp
+ * @brief Batch offscreen rendering implementation
+ */
+
+#include <earth_map/renderer/snapshot_renderer.h>
+#include <earth_map/renderer/texture_atlas/decode_thread_pool.h>
+#include <earth_map/math/frustum.h>
+#include <spdlog/spdlog.h>
+#include <GL/glew.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+namespace earth_map {
+
+namespace {
+
+void AppendToVector(void* context, void* data, int size) {
+    auto* out = static_cast<std::vector<std::uint8_t>*>(context);
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    out->insert(out->end(), bytes, bytes + size);
+}
+
+} // namespace
+
+std::vector<std::uint8_t> EncodeSnapshotPng(std::span<const std::uint8_t> rgba,
+                                            std::uint32_t width, std::uint32_t height) {
+    std::vector<std::uint8_t> png;
+    if (width == 0 || height == 0 || rgba.size() < std::size_t{width} * height * 4) {
+        return png;
+    }
+    png.reserve(rgba.size() / 2);
+    const int stride = static_cast<int>(width * 4);
+    if (stbi_write_png_to_func(AppendToVector, &png, static_cast<int>(width),
+                               static_cast<int>(height), 4, rgba.data(), stride) == 0) {
+        png.clear();
+    }
+    return png;
+}
+
+SnapshotRenderer::SnapshotRenderer(Renderer& renderer, const SnapshotConfig& config)
+    : renderer_(renderer), config_(config) {
+    if (config_.readback_slots == 0) {
+        throw std::invalid_argument("SnapshotRenderer: readback_slots must be at least 1");
+    }
+    encoders_ = std::make_unique<DecodeThreadPool>(config_.encode_threads);
+    max_pending_images_ = config_.max_pending_images > 0
+        ? config_.max_pending_images
+        : 2 * encoders_->GetThreadCount();
+
+    slots_.resize(config_.readback_slots);
+    for (ReadbackSlot& slot : slots_) {
+        glGenBuffers(1, &slot.buffer);
+    }
+}
+
+SnapshotRenderer::~SnapshotRenderer() {
+    WaitForEncodes(0);
+    encoders_->Shutdown();
+    ReleaseGL();
+}
+
+std::size_t SnapshotRenderer::RenderBatch(std::span<const SnapshotView> views,
+                                          const SnapshotCallback& on_image) {
+    std::uint32_t max_width = 0;
+    std::uint32_t max_height = 0;
+    for (const SnapshotView& view : views) {
+        if (view.width == 0 || view.height == 0) {
+            throw std::invalid_argument("SnapshotRenderer: views need a non-empty size");
+        }
+        max_width = std::max(max_width, view.width);
+        max_height = std::max(max_height, view.height);
+    }
+    if (views.empty()) {
+        return 0;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    GLint previous_framebuffer = 0;
+    GLint previous_viewport[4];
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previous_framebuffer);
+    glGetIntegerv(GL_VIEWPORT, previous_viewport);
+    EnsureFramebuffer(max_width, max_height);
+
+    for (std::size_t i = 0; i < views.size(); ++i) {
+        const SnapshotView& view = views[i];
+
+        // The slot's previous view was read back readback_slots views ago
+        ReadbackSlot& slot = slots_[i % slots_.size()];
+        if (slot.busy) {
+            FinishReadback(slot, on_image);
+        }
+
+        renderer_.Resize(view.width, view.height);
+        const bool tiles_complete = WaitForTiles(view);
+
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+        glViewport(0, 0, static_cast<GLsizei>(view.width), static_cast<GLsizei>(view.height));
+        glClearColor(config_.clear_color.x, config_.clear_color.y, config_.clear_color.z,
+                     config_.clear_color.w);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        renderer_.RenderScene(view.view, view.projection, Frustum(view.projection * view.view));
+
+        slot.index = i;
+        slot.width = view.width;
+        slot.height = view.height;
+        slot.tiles_complete = tiles_complete;
+        StartReadback(slot);
+    }
+
+    // Remaining slots in the order their views were drawn
+    for (std::size_t i = 0; i < slots_.size(); ++i) {
+        ReadbackSlot& slot = slots_[(views.size() + i) % slots_.size()];
+        if (slot.busy) {
+            FinishReadback(slot, on_image);
+        }
+    }
+    WaitForEncodes(0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previous_framebuffer));
+    renderer_.Resize(static_cast<std::uint32_t>(previous_viewport[2]),
+                     static_cast<std::uint32_t>(previous_viewport[3]));
+    glViewport(previous_viewport[0], previous_viewport[1], previous_viewport[2],
+               previous_viewport[3]);
+
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.images_per_second = seconds > 0.0 ? static_cast<double>(views.size()) / seconds : 0.0;
+    return views.size();
+}
+
+SnapshotStats SnapshotRenderer::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void SnapshotRenderer::EnsureFramebuffer(std::uint32_t width, std::uint32_t height) {
+    if (framebuffer_ != 0 && width <= framebuffer_width_ && height <= framebuffer_height_) {
+        return;
+    }
+    width = std::max(width, framebuffer_width_);
+    height = std::max(height, framebuffer_height_);
+
+    if (framebuffer_ == 0) {
+        glGenFramebuffers(1, &framebuffer_);
+        glGenRenderbuffers(1, &color_buffer_);
+        glGenRenderbuffers(1, &depth_buffer_);
+    }
+    glBindRenderbuffer(GL_RENDERBUFFER, color_buffer_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, static_cast<GLsizei>(width),
+                          static_cast<GLsizei>(height));
+    glBindRenderbuffer(GL_RENDERBUFFER, depth_buffer_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, static_cast<GLsizei>(width),
+                          static_cast<GLsizei>(height));
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color_buffer_);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER,
+                              depth_buffer_);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        throw std::runtime_error("SnapshotRenderer: incomplete framebuffer");
+    }
+    framebuffer_width_ = width;
+    framebuffer_height_ = height;
+}
+
+bool SnapshotRenderer::WaitForTiles(const SnapshotView& view) {
+    const auto deadline = std::chrono::steady_clock::now() + config_.tile_wait;
+    while (!renderer_.PrepareTiles(view.view, view.projection)) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++stats_.tile_wait_timeouts;
+            return false;
+        }
+        // Loads and decodes run on the tile workers meanwhile
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+void SnapshotRenderer::StartReadback(ReadbackSlot& slot) {
+    const std::size_t size = std::size_t{slot.width} * slot.height * 4;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    if (slot.capacity < size) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_READ);
+        slot.capacity = size;
+    }
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    // Into the buffer: returns without waiting for the GPU
+    glReadPixels(0, 0, static_cast<GLsizei>(slot.width), static_cast<GLsizei>(slot.height),
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.busy = true;
+}
+
+void SnapshotRenderer::FinishReadback(ReadbackSlot& slot, const SnapshotCallback& on_image) {
+    // Bound the images waiting for an encoder before taking another
+    WaitForEncodes(max_pending_images_ - 1);
+
+    auto fence = static_cast<GLsync>(slot.fence);
+    while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000) == GL_TIMEOUT_EXPIRED) {
+    }
+    glDeleteSync(fence);
+    slot.fence = nullptr;
+    slot.busy = false;
+
+    SnapshotImage image;
+    image.index = slot.index;
+    image.width = slot.width;
+    image.height = slot.height;
+    image.format = config_.format;
+    image.tiles_complete = slot.tiles_complete;
+
+    // GL rows are bottom-up; images are top row first
+    const std::size_t row = std::size_t{slot.width} * 4;
+    std::vector<std::uint8_t> pixels(row * slot.height);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    const auto* mapped = static_cast<const std::uint8_t*>(
+        glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(pixels.size()),
+                         GL_MAP_READ_BIT));
+    if (mapped != nullptr) {
+        for (std::uint32_t y = 0; y < slot.height; ++y) {
+            std::memcpy(pixels.data() + y * row, mapped + (slot.height - 1 - y) * row, row);
+        }
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    } else {
+        spdlog::warn("SnapshotRenderer: cannot map the readback buffer of image {}", slot.index);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++pending_encodes_;
+    }
+    const bool submitted = encoders_->Submit(
+        [this, &on_image, image = std::move(image), pixels = std::move(pixels)]() mutable {
+            if (image.format == SnapshotFormat::PNG) {
+                image.data = EncodeSnapshotPng(pixels, image.width, image.height);
+            } else {
+                image.data = std::move(pixels);
+            }
+            on_image(std::move(image));
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++stats_.images;
+            --pending_encodes_;
+            encoded_.notify_all();
+        });
+    if (!submitted) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --pending_encodes_;
+    }
+}
+
+void SnapshotRenderer::WaitForEncodes(std::size_t max_pending) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    encoded_.wait(lock, [&] { return pending_encodes_ <= max_pending; });
+}
+
+void SnapshotRenderer::ReleaseGL() {
+    for (ReadbackSlot& slot : slots_) {
+        if (slot.fence != nullptr) {
+            glDeleteSync(static_cast<GLsync>(slot.fence));
+        }
+        if (slot.buffer != 0) {
+            glDeleteBuffers(1, &slot.buffer);
+        }
+    }
+    slots_.clear();
+    if (framebuffer_ != 0) {
+        glDeleteFramebuffers(1, &framebuffer_);
+        glDeleteRenderbuffers(1, &color_buffer_);
+        glDeleteRenderbuffers(1, &depth_buffer_);
+        framebuffer_ = 0;
+    }
+}
+
+} // namespace earth_map
@@ -0,0 +1,293 @@
+/**
+ * @file terrain_cull_pass.cpp
+ * @brief GPU-driven terrain patch culling implementation
+ */
+
+#include <earth_map/renderer/terrain_cull_pass.h>
+#include <earth_map/renderer/shader_loader.h>
+#include <earth_map/math/frustum.h>
+#include <GL/glew.h>
+#include <glm/gtc/type_ptr.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+
+namespace earth_map {
+
+namespace {
+
+/// GLuints per DrawElementsIndirectCommand
+constexpr std::size_t kCommandWords = 5;
+
+// One invocation per tile. Instances are kTerrainInstanceFloats floats
+// (x, y, zoom, layer, window offset, window scale); commands are
+// DrawElementsIndirectCommand as plain uints.
+constexpr const char* kCullComputeShader = R"(
+#version 430 core
+layout (local_size_x = 64) in;
+
+layout (std430, binding = 0) readonly buffer Candidates { float candidates[]; };
+layout (std430, binding = 1) writeonly buffer Visible { float visible[]; };
+layout (std430, binding = 2) buffer Commands { uint commands[]; };
+
+uniform uint uTileCount;
+uniform uint uLevelCount;
+uniform float uResolution;      // grid quads per edge at the finest level
+uniform vec4 uPlanes[6];        // inward normal, distance
+uniform vec3 uCameraPosition;   // globe radii
+uniform float uPixelsPerUnit;
+uniform float uMinRadius;       // lowest terrain
+uniform float uMaxRadius;       // highest terrain
+uniform float uSkirtDepth;      // fraction of the tile width
+uniform float uMaxQuadPixels;
+
+const float PI = 3.14159265358979;
+const uint INSTANCE_FLOATS = 7u;
+
+vec3 directionOf(float lon, float lat) {
+    float cosLat = cos(lat);
+    return vec3(cosLat * sin(lon), sin(lat), cosLat * cos(lon));
+}
+
+float latitudeOf(float mercatorY) {
+    return atan(sinh(PI * (1.0 - 2.0 * mercatorY)));
+}
+
+void main() {
+    uint id = gl_GlobalInvocationID.x;
+    if (id >= uTileCount) return;
+    uint base = id * INSTANCE_FLOATS;
+    vec3 tile = vec3(candidates[base], candidates[base + 1u], candidates[base + 2u]);
+
+    float n = exp2(tile.z);
+    float west = tile.x / n * 2.0 * PI - PI;
+    float east = (tile.x + 1.0) / n * 2.0 * PI - PI;
+    // The outer tile rows reach the poles, as in the terrain vertex shader
+    float north = tile.y == 0.0 ? 0.5 * PI : latitudeOf(tile.y / n);
+    float south = tile.y == n - 1.0 ? -0.5 * PI : latitudeOf((tile.y + 1.0) / n);
+
+    // Bounding sphere of the tile's shell between its skirts and the highest terrain
+    float low = uMinRadius - uSkirtDepth * 2.0 * PI / n;
+    vec3 axis = directionOf(0.5 * (west + east), 0.5 * (north + south));
+    float cosAngle = min(min(dot(axis, directionOf(west, north)), dot(axis, directionOf(east, north))),
+                         min(dot(axis, directionOf(west, south)), dot(axis, directionOf(east, south))));
+    float h = 0.5 * (low * cosAngle + uMaxRadius);
+    vec3 center = axis * h;
+    float radius = sqrt(max(max(low * low + h * h - 2.0 * low * h * cosAngle,
+                                uMaxRadius * uMaxRadius + h * h - 2.0 * uMaxRadius * h * cosAngle),
+                            (uMaxRadius - h) * (uMaxRadius - h)));
+
+    // Zoom 0 and 1 tiles span too much of the globe for corner bounds
+    if (tile.z >= 2.0) {
+        for (int i = 0; i < 6; ++i) {
+            if (dot(uPlanes[i].xyz, center) + uPlanes[i].w < -radius) return;
+        }
+
+        float cameraDistance = length(uCameraPosition);
+        if (cameraDistance > uMinRadius) {
+            float horizon = acos(uMinRadius / cameraDistance) + acos(uMinRadius / uMaxRadius);
+            float toTile = acos(clamp(dot(axis, uCameraPosition / cameraDistance), -1.0, 1.0));
+            if (toTile - acos(clamp(cosAngle, -1.0, 1.0)) > horizon) return;
+        }
+    }
+
+    // Screen size of a finest-level quad, measured where the tile is widest
+    float equatorward = (north > 0.0 && south < 0.0) ? 0.0 : min(abs(north), abs(south));
+    float extent = max((east - west) * cos(equatorward), north - south) * uMaxRadius;
+    float distance = max(length(uCameraPosition - center) - radius, 1e-5);
+    float quadPixels = extent / uResolution * uPixelsPerUnit / distance;
+
+    uint level = 0u;
+    while (level + 1u < uLevelCount && quadPixels * exp2(float(level + 1u)) <= uMaxQuadPixels) {
+        ++level;
+    }
+
+    uint slot = commands[level * 5u + 4u] + atomicAdd(commands[level * 5u + 1u], 1u);
+    uint target = slot * INSTANCE_FLOATS;
+    for (uint i = 0u; i < INSTANCE_FLOATS; ++i) {
+        visible[target + i] = candidates[base + i];
+    }
+}
+)";
+
+} // namespace
+
+TerrainCullPass::~TerrainCullPass() {
+    Release();
+}
+
+bool TerrainCullPass::IsSupported() {
+    // Compute shaders, storage buffers, multi-draw indirect and base instances
+    return GLEW_VERSION_4_3;
+}
+
+bool TerrainCullPass::Initialize(std::uint32_t patch_vertex_buffer,
+                                 std::uint32_t patch_index_buffer,
+                                 std::span<const TerrainPatchLod> lods,
+                                 std::uint32_t resolution) {
+    if (IsInitialized()) {
+        return true;
+    }
+    if (lods.empty() || !IsSupported()) {
+        return false;
+    }
+    program_ = ShaderLoader::CreateComputeProgram(kCullComputeShader, "terrain_cull");
+    if (program_ == 0) {
+        return false;
+    }
+    tile_count_location_ = glGetUniformLocation(program_, "uTileCount");
+    level_count_location_ = glGetUniformLocation(program_, "uLevelCount");
+    resolution_location_ = glGetUniformLocation(program_, "uResolution");
+    planes_location_ = glGetUniformLocation(program_, "uPlanes");
+    camera_location_ = glGetUniformLocation(program_, "uCameraPosition");
+    pixels_per_unit_location_ = glGetUniformLocation(program_, "uPixelsPerUnit");
+    min_radius_location_ = glGetUniformLocation(program_, "uMinRadius");
+    max_radius_location_ = glGetUniformLocation(program_, "uMaxRadius");
+    max_quad_pixels_location_ = glGetUniformLocation(program_, "uMaxQuadPixels");
+    skirt_depth_location_ = glGetUniformLocation(program_, "uSkirtDepth");
+
+    lods_.assign(lods.begin(), lods.end());
+    resolution_ = std::max(resolution, 1u);
+
+    glGenBuffers(1, &candidate_buffer_);
+    glGenBuffers(1, &visible_buffer_);
+    glGenBuffers(1, &command_buffer_);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, command_buffer_);
+    glBufferData(GL_DRAW_INDIRECT_BUFFER,
+                 static_cast<GLsizeiptr>(lods_.size() * kCommandWords * sizeof(GLuint)), nullptr,
+                 GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    // The patch, with the instance attributes read from the survivors
+    glGenVertexArrays(1, &vao_);
+    glBindVertexArray(vao_);
+    glBindBuffer(GL_ARRAY_BUFFER, patch_vertex_buffer);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+    glEnableVertexAttribArray(0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, patch_index_buffer);
+
+    constexpr GLsizei stride = kTerrainInstanceFloats * sizeof(float);
+    glBindBuffer(GL_ARRAY_BUFFER, visible_buffer_);
+    glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, stride, (void*)0);
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(4, 1);
+    glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, stride, (void*)(4 * sizeof(float)));
+    glEnableVertexAttribArray(5);
+    glVertexAttribDivisor(5, 1);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    spdlog::info("Terrain GPU culling initialized: {} patch densities", lods_.size());
+    return true;
+}
+
+void TerrainCullPass::Cull(std::span<const float> instances, const TerrainCullParams& params) {
+    tile_count_ = instances.size() / kTerrainInstanceFloats;
+    if (!IsInitialized() || tile_count_ == 0) {
+        return;
+    }
+
+    // Each level can take every tile
+    if (tile_count_ > visible_capacity_) {
+        visible_capacity_ = std::max(tile_count_, 2 * visible_capacity_);
+        glBindBuffer(GL_ARRAY_BUFFER, visible_buffer_);
+        glBufferData(GL_ARRAY_BUFFER,
+                     static_cast<GLsizeiptr>(lods_.size() * visible_capacity_ *
+                                             kTerrainInstanceFloats * sizeof(float)),
+                     nullptr, GL_DYNAMIC_COPY);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    // Orphaned every frame: the previous frame's cull may still read it
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, candidate_buffer_);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(instances.size_bytes()),
+                 instances.data(), GL_STREAM_DRAW);
+    const std::vector<std::uint32_t> commands = MakeCommands(lods_, tile_count_);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, command_buffer_);
+    glBufferSubData(GL_SHADER_STORAGE_BUFFER, 0,
+                    static_cast<GLsizeiptr>(commands.size() * sizeof(std::uint32_t)),
+                    commands.data());
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    std::array<glm::vec4, Frustum::COUNT> planes;
+    const Frustum frustum(params.view_projection);
+    for (std::size_t i = 0; i < planes.size(); ++i) {
+        planes[i] = glm::vec4(frustum.planes[i].normal, frustum.planes[i].distance);
+    }
+
+    GLint previous_program = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &previous_program);
+    glUseProgram(program_);
+    glUniform1ui(tile_count_location_, static_cast<GLuint>(tile_count_));
+    glUniform1ui(level_count_location_, static_cast<GLuint>(lods_.size()));
+    glUniform1f(resolution_location_, static_cast<float>(resolution_));
+    glUniform4fv(planes_location_, static_cast<GLsizei>(planes.size()),
+                 glm::value_ptr(planes[0]));
+    glUniform3fv(camera_location_, 1, glm::value_ptr(params.camera_position));
+    glUniform1f(pixels_per_unit_location_, params.pixels_per_unit);
+    glUniform1f(min_radius_location_, 1.0f + std::min(params.min_height, 0.0f));
+    glUniform1f(max_radius_location_, 1.0f + std::max(params.max_height, 0.0f));
+    glUniform1f(max_quad_pixels_location_, params.max_quad_pixels);
+    glUniform1f(skirt_depth_location_, params.skirt_depth);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, candidate_buffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, visible_buffer_);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, command_buffer_);
+    const auto groups = static_cast<GLuint>((tile_count_ + kWorkgroupSize - 1) / kWorkgroupSize);
+    glDispatchCompute(groups, 1, 1);
+    // The draw reads the commands and the survivors as vertex attributes
+    glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT);
+    for (GLuint binding = 0; binding < 3; ++binding) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, binding, 0);
+    }
+    glUseProgram(static_cast<GLuint>(previous_program));
+}
+
+void TerrainCullPass::Draw() const {
+    if (!IsInitialized() || tile_count_ == 0) {
+        return;
+    }
+    glBindVertexArray(vao_);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, command_buffer_);
+    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr,
+                                static_cast<GLsizei>(lods_.size()), 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    glBindVertexArray(0);
+}
+
+void TerrainCullPass::Release() {
+    if (vao_) {
+        glDeleteVertexArrays(1, &vao_);
+        vao_ = 0;
+    }
+    for (std::uint32_t* buffer : {&candidate_buffer_, &visible_buffer_, &command_buffer_}) {
+        if (*buffer) {
+            glDeleteBuffers(1, buffer);
+            *buffer = 0;
+        }
+    }
+    if (program_) {
+        glDeleteProgram(program_);
+        program_ = 0;
+    }
+    visible_capacity_ = 0;
+    tile_count_ = 0;
+    lods_.clear();
+}
+
+std::vector<std::uint32_t> TerrainCullPass::MakeCommands(std::span<const TerrainPatchLod> lods,
+                                                         std::size_t tile_count) {
+    std::vector<std::uint32_t> commands;
+    commands.reserve(lods.size() * kCommandWords);
+    for (std::size_t level = 0; level < lods.size(); ++level) {
+        commands.insert(commands.end(), {
+            lods[level].index_count,
+            0u,  // instanceCount, counted by the shader
+            lods[level].first_index,
+            0u,  // baseVertex
+            static_cast<std::uint32_t>(level * tile_count)});
+    }
+    return commands;
+}
+
+} // namespace earth_map
@@ -0,0 +1,262 @@
+/**
+ * @file terrain_elevation_pool.cpp
+ * @brief Tile-aligned elevation texture array implementation
+ */
+
+#include <earth_map/renderer/terrain_elevation_pool.h>
+#include <earth_map/data/elevation_provider.h>
+#include <earth_map/constants.h>
+#include <earth_map/renderer/texture_atlas/decode_thread_pool.h>
+#include <GL/glew.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace earth_map {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+constexpr double kRadToDeg = 180.0 / kPi;
+
+} // namespace
+
+TerrainElevationPool::TerrainElevationPool(std::uint32_t samples, std::uint32_t max_layers,
+                                           bool skip_gl_init, int worker_threads)
+    : samples_(std::max(samples, 2u))
+    , max_layers_(std::max(max_layers, 1u))
+    , skip_gl_init_(skip_gl_init)
+    , layers_(max_layers_) {
+    free_layers_.reserve(max_layers_);
+    for (std::uint32_t layer = max_layers_; layer > 0; --layer) {
+        free_layers_.push_back(static_cast<int>(layer - 1));
+    }
+    if (worker_threads > 0) {
+        workers_ = std::make_unique<DecodeThreadPool>(worker_threads);
+    }
+
+    if (skip_gl_init_) {
+        return;
+    }
+
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    texture_id_ = texture;
+    glBindTexture(GL_TEXTURE_2D_ARRAY, texture_id_);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R16F,
+                 static_cast<GLsizei>(samples_), static_cast<GLsizei>(samples_),
+                 static_cast<GLsizei>(max_layers_), 0, GL_RED, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    spdlog::info("Terrain elevation pool: {} layers of {}x{} samples ({} KB)",
+                 max_layers_, samples_, samples_,
+                 static_cast<std::size_t>(samples_) * samples_ * max_layers_ * 2 / 1024);
+}
+
+TerrainElevationPool::~TerrainElevationPool() {
+    // Queued builds return without sampling; running ones finish
+    ++generation_;
+    workers_.reset();
+
+    if (texture_id_ != 0) {
+        GLuint texture = texture_id_;
+        glDeleteTextures(1, &texture);
+    }
+}
+
+std::vector<float> TerrainElevationPool::SampleTile(const ElevationProvider& provider,
+                                                    const TileCoordinates& coords,
+                                                    std::uint32_t samples,
+                                                    float min_elevation,
+                                                    float max_elevation) {
+    samples = std::max(samples, 2u);
+    const double n = static_cast<double>(std::int64_t{1} << coords.zoom);
+    const double step = 1.0 / static_cast<double>(samples - 1);
+
+    std::vector<coordinates::Geographic> points;
+    points.reserve(static_cast<std::size_t>(samples) * samples);
+    double min_cos_latitude = 1.0;
+    for (std::uint32_t j = 0; j < samples; ++j) {
+        const double mercator_y = (coords.y + j * step) / n;
+        const double lat = std::atan(std::sinh(kPi * (1.0 - 2.0 * mercator_y))) * kRadToDeg;
+        min_cos_latitude = std::min(min_cos_latitude, std::cos(lat / kRadToDeg));
+        for (std::uint32_t i = 0; i < samples; ++i) {
+            const double mercator_x = (coords.x + i * step) / n;
+            points.emplace_back(lat, mercator_x * 360.0 - 180.0);
+        }
+    }
+
+    // Ground spacing of the samples where it is finest (the poleward edge),
+    // so the provider reads no coarser pyramid level than the tile resolves
+    const double ground_resolution = 2.0 * kPi * constants::geodetic::EARTH_SEMI_MAJOR_AXIS *
+                                     min_cos_latitude / (n * static_cast<double>(samples - 1));
+    const std::vector<ElevationQuery> results = provider.GetElevations(points, ground_resolution);
+    std::vector<float> heights(points.size(), 0.0f);
+    for (std::size_t i = 0; i < heights.size() && i < results.size(); ++i) {
+        if (results[i].valid) {
+            heights[i] = std::clamp(results[i].elevation_meters, min_elevation, max_elevation);
+        }
+    }
+    return heights;
+}
+
+std::size_t TerrainElevationPool::Update(const std::vector<TileCoordinates>& tiles,
+                                         const ElevationProvider& provider,
+                                         std::size_t max_uploads,
+                                         float min_elevation,
+                                         float max_elevation) {
+    ++update_counter_;
+
+    // Pin everything already resident before building evicts anything
+    std::vector<TileCoordinates> missing;
+    TileSet requested;
+    for (const TileCoordinates& tile : tiles) {
+        if (!requested.insert(tile).second) {
+            continue;
+        }
+        const int layer = GetLayer(tile);
+        if (layer >= 0) {
+            Touch(layer);
+        } else {
+            missing.push_back(tile);
+        }
+    }
+
+    std::size_t uploaded = 0;
+    if (!workers_) {
+        for (const TileCoordinates& tile : missing) {
+            if (uploaded >= max_uploads || !HasAvailableLayer()) {
+                break;
+            }
+            const std::vector<float> heights =
+                SampleTile(provider, tile, samples_, min_elevation, max_elevation);
+            UploadTile(tile, heights.data());
+            ++uploaded;
+        }
+        return uploaded;
+    }
+
+    // Upload finished builds, coarsest first; the rest wait for the next call
+    std::vector<Build> finished;
+    {
+        std::lock_guard<std::mutex> lock(finished_mutex_);
+        finished.swap(finished_);
+    }
+    std::stable_sort(finished.begin(), finished.end(), [](const Build& a, const Build& b) {
+        return a.coords.zoom < b.coords.zoom;
+    });
+    std::vector<Build> deferred;
+    const std::uint64_t generation = generation_.load();
+    for (Build& build : finished) {
+        if (build.generation != generation || !requested.contains(build.coords)) {
+            pending_.erase(build.coords);
+        } else if (uploaded < max_uploads && HasAvailableLayer()) {
+            pending_.erase(build.coords);
+            UploadTile(build.coords, build.heights.data());
+            ++uploaded;
+        } else {
+            deferred.push_back(std::move(build));
+        }
+    }
+    if (!deferred.empty()) {
+        std::lock_guard<std::mutex> lock(finished_mutex_);
+        for (Build& build : deferred) {
+            finished_.push_back(std::move(build));
+        }
+    }
+
+    // Queue missing tiles while workers have room and a layer could take them
+    const std::size_t max_pending = workers_->GetThreadCount() * kMaxPendingBuildsPerWorker;
+    for (const TileCoordinates& tile : missing) {
+        if (pending_.size() >= max_pending || !HasAvailableLayer()) {
+            break;
+        }
+        if (GetLayer(tile) >= 0 || !pending_.insert(tile).second) {
+            continue;
+        }
+        const std::uint32_t samples = samples_;
+        const bool queued = workers_->Submit(
+            [this, &provider, tile, generation, samples, min_elevation, max_elevation] {
+                if (generation_.load() != generation) {
+                    return;  // Cleared or shutting down
+                }
+                Build build{tile, generation,
+                            SampleTile(provider, tile, samples, min_elevation, max_elevation)};
+                std::lock_guard<std::mutex> lock(finished_mutex_);
+                finished_.push_back(std::move(build));
+            });
+        if (!queued) {
+            pending_.erase(tile);
+        }
+    }
+    return uploaded;
+}
+
+int TerrainElevationPool::UploadTile(const TileCoordinates& coords, const float* heights) {
+    int layer = GetLayer(coords);
+    if (layer < 0) {
+        if (!free_layers_.empty()) {
+            layer = free_layers_.back();
+            free_layers_.pop_back();
+        } else {
+            layer = lru_order_.back();
+            if (layers_[layer].last_update == update_counter_) {
+                return -1;
+            }
+            lru_order_.pop_back();
+            coord_to_layer_.erase(layers_[layer].coords);
+        }
+        layers_[layer].coords = coords;
+        lru_order_.push_front(layer);
+        layers_[layer].lru_it = lru_order_.begin();
+        coord_to_layer_[coords] = layer;
+    }
+    Touch(layer);
+
+    if (!skip_gl_init_) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture_id_);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer,
+                        static_cast<GLsizei>(samples_), static_cast<GLsizei>(samples_), 1,
+                        GL_RED, GL_FLOAT, heights);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    }
+    return layer;
+}
+
+int TerrainElevationPool::GetLayer(const TileCoordinates& coords) const {
+    const auto it = coord_to_layer_.find(coords);
+    return it != coord_to_layer_.end() ? it->second : -1;
+}
+
+void TerrainElevationPool::Clear() {
+    ++generation_;
+    pending_.clear();
+    {
+        std::lock_guard<std::mutex> lock(finished_mutex_);
+        finished_.clear();
+    }
+    coord_to_layer_.clear();
+    lru_order_.clear();
+    free_layers_.clear();
+    for (std::uint32_t layer = max_layers_; layer > 0; --layer) {
+        free_layers_.push_back(static_cast<int>(layer - 1));
+    }
+}
+
+bool TerrainElevationPool::HasAvailableLayer() const {
+    return !free_layers_.empty() || layers_[lru_order_.back()].last_update != update_counter_;
+}
+
+void TerrainElevationPool::Touch(int layer) {
+    Layer& slot = layers_[layer];
+    slot.last_update = update_counter_;
+    lru_order_.splice(lru_order_.begin(), lru_order_, slot.lru_it);
+}
+
+} // namespace earth_map
@@ -0,0 +1,102 @@
+/**
+ * @file terrain_patch.cpp
+ * @brief Shared terrain patch implementation
+ */
+
+#include <earth_map/renderer/terrain_patch.h>
+#include <algorithm>
+
+namespace earth_map {
+
+TerrainPatchGeometry TerrainPatch::Generate(std::uint32_t resolution, std::uint32_t lod_levels) {
+    resolution = std::max(resolution, 1u);
+    lod_levels = std::max(lod_levels, 1u);
+    const std::uint32_t side = resolution + 1;
+
+    TerrainPatchGeometry patch;
+    patch.grid_vertex_count = side * side;
+    patch.vertices.reserve(patch.grid_vertex_count + 4 * resolution);
+    patch.indices.reserve(6 * resolution * resolution + 24 * resolution);
+
+    for (std::uint32_t j = 0; j < side; ++j) {
+        for (std::uint32_t i = 0; i < side; ++i) {
+            // Divided rather than stepped: the last row and column are exactly 1
+            patch.vertices.emplace_back(static_cast<float>(i) / static_cast<float>(resolution),
+                                        static_cast<float>(j) / static_cast<float>(resolution),
+                                        0.0f);
+        }
+    }
+
+    // Border walked clockwise seen from above: east along the north edge,
+    // south along the east edge, west along the south edge, north along
+    // the west edge
+    std::vector<std::uint32_t> border;
+    border.reserve(4 * resolution);
+    for (std::uint32_t i = 0; i < resolution; ++i) {
+        border.push_back(i);
+    }
+    for (std::uint32_t j = 0; j < resolution; ++j) {
+        border.push_back(j * side + resolution);
+    }
+    for (std::uint32_t i = resolution; i > 0; --i) {
+        border.push_back(resolution * side + i);
+    }
+    for (std::uint32_t j = resolution; j > 0; --j) {
+        border.push_back(j * side);
+    }
+
+    // One lowered twin per border vertex
+    const std::uint32_t first_skirt = patch.grid_vertex_count;
+    for (const std::uint32_t index : border) {
+        const glm::vec3& top = patch.vertices[index];
+        patch.vertices.emplace_back(top.x, top.y, 1.0f);
+    }
+
+    const auto count = static_cast<std::uint32_t>(border.size());
+    for (std::uint32_t step = 1; patch.lods.size() < lod_levels && step <= resolution &&
+                                 resolution % step == 0;
+         step *= 2) {
+        TerrainPatchLod lod;
+        lod.first_index = static_cast<std::uint32_t>(patch.indices.size());
+        lod.step = step;
+
+        // v grows southward, so (a, c, b) is counter-clockwise seen from above
+        for (std::uint32_t j = 0; j < resolution; j += step) {
+            for (std::uint32_t i = 0; i < resolution; i += step) {
+                const std::uint32_t a = j * side + i;
+                const std::uint32_t b = a + step;
+                const std::uint32_t c = a + step * side;
+                const std::uint32_t d = c + step;
+                patch.indices.insert(patch.indices.end(), {a, c, b, b, c, d});
+            }
+        }
+
+        // Each edge segment p -> q gets a wall facing away from the tile
+        for (std::uint32_t k = 0; k < count; k += step) {
+            const std::uint32_t next = (k + step) % count;
+            const std::uint32_t p = border[k];
+            const std::uint32_t q = border[next];
+            const std::uint32_t p_skirt = first_skirt + k;
+            const std::uint32_t q_skirt = first_skirt + next;
+            patch.indices.insert(patch.indices.end(), {p, q, p_skirt, q, q_skirt, p_skirt});
+        }
+        lod.index_count = static_cast<std::uint32_t>(patch.indices.size()) - lod.first_index;
+        patch.lods.push_back(lod);
+    }
+    return patch;
+}
+
+TerrainElevationWindow TerrainPatch::GetElevationWindow(const TileCoordinates& tile,
+                                                        std::int32_t source_zoom) {
+    const std::int32_t depth = tile.zoom - std::clamp(source_zoom, 0, tile.zoom);
+    const std::int32_t mask = (1 << depth) - 1;
+
+    TerrainElevationWindow window;
+    window.source = TileCoordinates(tile.x >> depth, tile.y >> depth, tile.zoom - depth);
+    window.scale = 1.0f / static_cast<float>(1 << depth);
+    window.offset = glm::vec2(static_cast<float>(tile.x & mask),
+                              static_cast<float>(tile.y & mask)) * window.scale;
+    return window;
+}
+
+} // namespace earth_map
@@ -0,0 +1,87 @@
+/**
+ * @file basemap_pack.cpp
+ * @brief Basemap pack decoding implementation
+ */
+
+#include <earth_map/renderer/texture_atlas/basemap_pack.h>
+#include <earth_map/data/pmtiles_archive.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <optional>
+#include <thread>
+
+namespace earth_map {
+
+std::vector<ResidentTile> DecodeBasemapPack(const std::string& path, int max_zoom) {
+    PMTilesArchive archive(path);
+    if (!archive.Open()) {
+        return {};
+    }
+    const PMTilesHeader& header = archive.GetHeader();
+    if (header.tile_compression != PMTilesHeader::Compression::NONE &&
+        header.tile_compression != PMTilesHeader::Compression::UNKNOWN) {
+        spdlog::warn("Basemap pack {} has compressed tiles, ignoring it", path);
+        return {};
+    }
+    if (header.tile_type == PMTilesHeader::TileType::MVT) {
+        spdlog::warn("Basemap pack {} holds vector tiles, ignoring it", path);
+        return {};
+    }
+
+    std::vector<TileCoordinates> coords;
+    const int last_zoom = std::min<int>(max_zoom, header.max_zoom);
+    for (int zoom = header.min_zoom; zoom <= last_zoom; ++zoom) {
+        const std::int32_t count = 1 << zoom;
+        for (std::int32_t y = 0; y < count; ++y) {
+            for (std::int32_t x = 0; x < count; ++x) {
+                if (archive.Contains({x, y, zoom})) {
+                    coords.emplace_back(x, y, zoom);
+                }
+            }
+        }
+    }
+    archive.Prefetch(coords);
+
+    // Tiles are handed out one at a time: JPEG and PNG decode times differ a lot
+    const auto decoders = ImageDecoderRegistry::CreateDefault();
+    std::vector<std::optional<ResidentTile>> decoded(coords.size());
+    std::atomic<std::size_t> next{0};
+    const auto work = [&] {
+        for (std::size_t i = next.fetch_add(1); i < coords.size(); i = next.fetch_add(1)) {
+            const auto bytes = archive.GetTile(coords[i]);
+            ResidentTile tile{coords[i], {}};
+            if (bytes && decoders->Decode(bytes->data(), bytes->size(), tile.image)) {
+                decoded[i] = std::move(tile);
+            }
+        }
+    };
+    const std::size_t thread_count =
+        std::min<std::size_t>(coords.size(), std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::future<void>> tasks;
+    for (std::size_t thread = 1; thread < thread_count; ++thread) {
+        tasks.push_back(std::async(std::launch::async, work));
+    }
+    work();
+    for (std::future<void>& task : tasks) {
+        task.get();
+    }
+
+    std::vector<ResidentTile> tiles;
+    tiles.reserve(decoded.size());
+    for (std::optional<ResidentTile>& tile : decoded) {
+        if (tile) {
+            tiles.push_back(std::move(*tile));
+        }
+    }
+    if (tiles.size() < coords.size()) {
+        spdlog::warn("Basemap pack {}: {} of {} tiles failed to decode", path,
+                     coords.size() - tiles.size(), coords.size());
+    }
+    spdlog::info("Decoded {} basemap tiles (z{}-z{}) from {}", tiles.size(),
+                 static_cast<int>(header.min_zoom), last_zoom, path);
+    return tiles;
+}
+
+} // namespace earth_map
@@ -0,0 +1,140 @@
+/**
+ * @file decode_thread_pool.cpp
+ * @brief Implementation of the work-stealing decode thread pool
+ */
+
+#include <earth_map/renderer/texture_atlas/decode_thread_pool.h>
+#include <spdlog/spdlog.h>
+
+namespace earth_map {
+
+namespace {
+
+/// Pool and worker index of the current thread (null outside pool workers)
+thread_local const DecodeThreadPool* tls_pool = nullptr;
+thread_local std::size_t tls_worker_index = 0;
+
+} // namespace
+
+DecodeThreadPool::DecodeThreadPool(int num_threads) {
+    if (num_threads < 1) {
+        num_threads = static_cast<int>(std::thread::hardware_concurrency());
+        if (num_threads < 1) {
+            num_threads = 1;
+        }
+    }
+
+    workers_.reserve(num_threads);
+    for (int i = 0; i < num_threads; ++i) {
+        workers_.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    threads_.reserve(num_threads);
+    for (int i = 0; i < num_threads; ++i) {
+        threads_.emplace_back(&DecodeThreadPool::WorkerThreadMain, this,
+                              static_cast<std::size_t>(i));
+    }
+
+    spdlog::info("DecodeThreadPool started with {} worker threads", num_threads);
+}
+
+DecodeThreadPool::~DecodeThreadPool() {
+    Shutdown();
+}
+
+bool DecodeThreadPool::Submit(Task task) {
+    if (!task) {
+        return false;
+    }
+
+    const std::size_t index = (tls_pool == this)
+        ? tls_worker_index
+        : next_queue_.fetch_add(1) % workers_.size();
+
+    // Publish under sleep_mutex_ so a worker checking the predicate cannot
+    // miss the wakeup and Shutdown() cannot slip in between check and push
+    {
+        std::lock_guard<std::mutex> sleep_lock(sleep_mutex_);
+        if (shutdown_flag_.load()) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> queue_lock(workers_[index]->mutex);
+        workers_[index]->tasks.push_back(std::move(task));
+        pending_.fetch_add(1);
+    }
+    sleep_cv_.notify_one();
+
+    return true;
+}
+
+void DecodeThreadPool::Shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        shutdown_flag_.store(true);
+    }
+    sleep_cv_.notify_all();
+
+    for (auto& thread : threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
+void DecodeThreadPool::WorkerThreadMain(std::size_t index) {
+    tls_pool = this;
+    tls_worker_index = index;
+
+    while (true) {
+        Task task;
+        if (TryPopLocal(index, task) || TrySteal(index, task)) {
+            pending_.fetch_sub(1);
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleep_cv_.wait(lock, [this]() {
+            return pending_.load() > 0 || shutdown_flag_.load();
+        });
+
+        // Exit only once every queued task has run
+        if (shutdown_flag_.load() && pending_.load() == 0) {
+            break;
+        }
+    }
+
+    tls_pool = nullptr;
+}
+
+bool DecodeThreadPool::TryPopLocal(std::size_t index, Task& task) {
+    WorkerQueue& queue = *workers_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    return true;
+}
+
+bool DecodeThreadPool::TrySteal(std::size_t thief, Task& task) {
+    const std::size_t count = workers_.size();
+    for (std::size_t offset = 1; offset < count; ++offset) {
+        WorkerQueue& victim = *workers_[(thief + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) {
+            continue;
+        }
+
+        task = std::move(victim.tasks.back());
+        victim.tasks.pop_back();
+        steal_count_.fetch_add(1);
+        return true;
+    }
+    return false;
+}
+
+} // namespace earth_map
@@ -1,39 +1,189 @@
 /**
  * @file gl_upload_queue.cpp
- * @brief Implementation of thread-safe GL upload queue
+ * @brief Implementation of the lock-free bounded GL upload queue
  */
 
 #include <earth_map/renderer/texture_atlas/gl_upload_queue.h>
+#include <chrono>
+#include <thread>
 #include <utility>
 
 namespace earth_map {
 
-void GLUploadQueue::Push(std::unique_ptr<GLUploadCommand> cmd) {
-    if (!cmd) {
-        return; // Ignore null commands
+namespace {
+
+/// How often a blocked producer re-checks whether the queue was closed
+constexpr std::chrono::milliseconds kClosedPollInterval{10};
+
+std::size_t RoundUpToPowerOfTwo(std::size_t value) {
+    std::size_t result = 2;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+} // namespace
+
+GLUploadQueue::GLUploadQueue(std::size_t capacity)
+    : capacity_(RoundUpToPowerOfTwo(capacity))
+    , mask_(capacity_ - 1)
+    , cells_(std::make_unique<Cell[]>(capacity_))
+    , free_cells_(static_cast<std::ptrdiff_t>(capacity_)) {
+
+    for (std::size_t i = 0; i < capacity_; ++i) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+GLUploadQueue::~GLUploadQueue() {
+    while (GLUploadCommand* command = Dequeue()) {
+        delete command;
+    }
+}
+
+bool GLUploadQueue::Push(std::unique_ptr<GLUploadCommand> cmd) {
+    if (!cmd || IsClosed()) {
+        return false; // Ignore null commands
+    }
+
+    // Reserve a free cell; wait while the ring is full
+    if (!free_cells_.try_acquire()) {
+        blocked_pushes_.fetch_add(1, std::memory_order_relaxed);
+        while (!free_cells_.try_acquire_for(kClosedPollInterval)) {
+            if (IsClosed()) {
+                return false;
+            }
+        }
+    }
+
+    Enqueue(cmd.release());
+    return true;
+}
+
+bool GLUploadQueue::TryPush(std::unique_ptr<GLUploadCommand> cmd) {
+    if (!cmd || IsClosed()) {
+        return false;
+    }
+
+    if (free_cells_.try_acquire()) {
+        Enqueue(cmd.release());
+        return true;
     }
 
-    std::lock_guard<std::mutex> lock(mutex_);
-    queue_.push_back(std::move(cmd));
+    // Ring is full: spill instead of waiting for the consumer
+    overflow_pushes_.fetch_add(1, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(overflow_mutex_);
+    overflow_.push_back(std::move(cmd));
+    overflow_size_.fetch_add(1, std::memory_order_release);
+    return true;
 }
 
 std::unique_ptr<GLUploadCommand> GLUploadQueue::TryPop() {
-    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto command = PopOverflow()) {
+        return command;
+    }
+    return std::unique_ptr<GLUploadCommand>(Dequeue());
+}
+
+std::size_t GLUploadQueue::TryPopN(std::vector<std::unique_ptr<GLUploadCommand>>& out,
+                                   std::size_t max_count) {
+    std::size_t popped = 0;
+    while (popped < max_count) {
+        if (auto command = PopOverflow()) {
+            out.push_back(std::move(command));
+            ++popped;
+            continue;
+        }
+        GLUploadCommand* command = Dequeue();
+        if (!command) {
+            break;
+        }
+        out.emplace_back(command);
+        ++popped;
+    }
+    return popped;
+}
 
-    if (queue_.empty()) {
+void GLUploadQueue::Close() {
+    closed_.store(true, std::memory_order_release);
+}
+
+std::size_t GLUploadQueue::Size() const {
+    const std::size_t tail = dequeue_pos_.load(std::memory_order_acquire);
+    const std::size_t head = enqueue_pos_.load(std::memory_order_acquire);
+    const std::size_t ring = head > tail ? head - tail : 0;
+    return ring + overflow_size_.load(std::memory_order_acquire);
+}
+
+std::unique_ptr<GLUploadCommand> GLUploadQueue::PopOverflow() {
+    if (overflow_size_.load(std::memory_order_acquire) == 0) {
         return nullptr;
     }
+    std::lock_guard<std::mutex> lock(overflow_mutex_);
+    if (overflow_.empty()) {
+        return nullptr;
+    }
+    auto command = std::move(overflow_.front());
+    overflow_.pop_front();
+    overflow_size_.fetch_sub(1, std::memory_order_release);
+    return command;
+}
+
+void GLUploadQueue::Enqueue(GLUploadCommand* command) {
+    std::size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
 
-    // Pop from front (FIFO)
-    auto cmd = std::move(queue_.front());
-    queue_.pop_front();
+    while (true) {
+        cell = &cells_[pos & mask_];
+        const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+
+        if (diff == 0) {
+            // Cell is free for this position: claim it
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // A free cell is reserved but its consumer has not published it yet
+            std::this_thread::yield();
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        } else {
+            // Another producer claimed this position
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
 
-    return cmd;
+    cell->command = command;
+    cell->sequence.store(pos + 1, std::memory_order_release);
 }
 
-std::size_t GLUploadQueue::Size() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return queue_.size();
+GLUploadCommand* GLUploadQueue::Dequeue() {
+    std::size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+
+    while (true) {
+        cell = &cells_[pos & mask_];
+        const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+
+        if (diff == 0) {
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Empty (or the producer of this cell has not finished writing)
+            return nullptr;
+        } else {
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    GLUploadCommand* command = cell->command;
+    cell->command = nullptr;
+    cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+    free_cells_.release();
+    return command;
 }
 
 } // namespace earth_map
@@ -0,0 +1,559 @@
+/**
+ * @file image_decoder.cpp
+ * @brief Image decoder backends and format dispatch
+ */
+
+#include <earth_map/renderer/texture_atlas/image_decoder.h>
+#include <spdlog/spdlog.h>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+namespace earth_map {
+
+namespace {
+
+/**
+ * @brief Per-thread cache of stb_image's large allocations
+ *
+ * stb allocates the output image and its zlib/IDCT scratch with malloc on
+ * every decode. Decode threads see the same few sizes over and over, so
+ * freed blocks of at least kMinCachedSize are kept for the next decode on
+ * the same thread instead of going back to the heap. Each block carries a
+ * header recording its usable size.
+ */
+class StbBlockCache {
+public:
+    static constexpr std::size_t kMinCachedSize = 64 * 1024;
+    static constexpr std::size_t kMaxCachedBlocks = 4;
+
+    ~StbBlockCache() {
+        for (std::size_t i = 0; i < count_; ++i) {
+            std::free(blocks_[i]);
+        }
+    }
+
+    void* Allocate(std::size_t size) {
+        // Smallest cached block that fits
+        std::size_t best = count_;
+        for (std::size_t i = 0; i < count_; ++i) {
+            if (Capacity(blocks_[i]) >= size &&
+                (best == count_ || Capacity(blocks_[i]) < Capacity(blocks_[best]))) {
+                best = i;
+            }
+        }
+        if (best != count_) {
+            void* block = blocks_[best];
+            blocks_[best] = blocks_[--count_];
+            return Payload(block);
+        }
+
+        void* block = std::malloc(sizeof(Header) + size);
+        if (!block) {
+            return nullptr;
+        }
+        static_cast<Header*>(block)->capacity = size;
+        return Payload(block);
+    }
+
+    void* Reallocate(void* ptr, std::size_t size) {
+        if (!ptr) {
+            return Allocate(size);
+        }
+        const std::size_t capacity = Capacity(Block(ptr));
+        if (capacity >= size) {
+            return ptr;
+        }
+        void* grown = Allocate(size);
+        if (grown) {
+            std::memcpy(grown, ptr, capacity);
+            Free(ptr);
+        }
+        return grown;
+    }
+
+    void Free(void* ptr) {
+        if (!ptr) {
+            return;
+        }
+        void* block = Block(ptr);
+        if (Capacity(block) < kMinCachedSize) {
+            std::free(block);
+            return;
+        }
+        if (count_ == kMaxCachedBlocks) {
+            // Keep the larger blocks: they are the expensive ones to map
+            std::size_t smallest = 0;
+            for (std::size_t i = 1; i < count_; ++i) {
+                if (Capacity(blocks_[i]) < Capacity(blocks_[smallest])) {
+                    smallest = i;
+                }
+            }
+            if (Capacity(blocks_[smallest]) >= Capacity(block)) {
+                std::free(block);
+                return;
+            }
+            std::free(blocks_[smallest]);
+            blocks_[smallest] = blocks_[--count_];
+        }
+        blocks_[count_++] = block;
+    }
+
+private:
+    struct alignas(std::max_align_t) Header {
+        std::size_t capacity;
+    };
+
+    static void* Payload(void* block) { return static_cast<Header*>(block) + 1; }
+    static void* Block(void* payload) { return static_cast<Header*>(payload) - 1; }
+    static std::size_t Capacity(void* block) { return static_cast<Header*>(block)->capacity; }
+
+    std::array<void*, kMaxCachedBlocks> blocks_{};
+    std::size_t count_ = 0;
+};
+
+StbBlockCache& GetStbBlockCache() {
+    thread_local StbBlockCache cache;
+    return cache;
+}
+
+void* StbMalloc(std::size_t size) { return GetStbBlockCache().Allocate(size); }
+void* StbRealloc(void* ptr, std::size_t size) { return GetStbBlockCache().Reallocate(ptr, size); }
+void StbFree(void* ptr) { GetStbBlockCache().Free(ptr); }
+
+} // namespace
+
+} // namespace earth_map
+
+#define STBI_MALLOC(size) earth_map::StbMalloc(size)
+#define STBI_REALLOC(ptr, size) earth_map::StbRealloc(ptr, size)
+#define STBI_FREE(ptr) earth_map::StbFree(ptr)
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+
+#ifdef EARTH_MAP_HAVE_TURBOJPEG
+#include <turbojpeg.h>
+#endif
+
+#ifdef EARTH_MAP_HAVE_SPNG
+#include <spng.h>
+#endif
+
+namespace earth_map {
+
+namespace {
+
+/// All backends output RGBA8 for GL_RGBA8 texture pool compatibility
+constexpr int kOutputChannels = 4;
+
+/**
+ * @brief stb_image backend (scalar, supports PNG/JPEG and more)
+ */
+class StbImageDecoder : public ImageDecoder {
+public:
+    const char* GetName() const override { return "stb_image"; }
+
+    bool Supports(ImageFormat format) const override {
+        // stb has no WebP support; Unknown is still worth a try (BMP, TGA, ...)
+        return format != ImageFormat::WebP;
+    }
+
+    bool Decode(const std::uint8_t* data, std::size_t size, DecodedImage& out) override {
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+
+        unsigned char* decoded_data = stbi_load_from_memory(
+            data,
+            static_cast<int>(size),
+            &width,
+            &height,
+            &channels,
+            kOutputChannels
+        );
+
+        if (!decoded_data) {
+            const char* error = stbi_failure_reason();
+            spdlog::debug("stb_image decode failed: {}", error ? error : "unknown error");
+            return false;
+        }
+
+        // stbi returns original channel count in 'channels' even when forcing,
+        // so use the actual output channel count
+        const std::size_t decoded_size =
+            static_cast<std::size_t>(width) * height * kOutputChannels;
+        out.pixels.assign(decoded_data, decoded_data + decoded_size);
+        out.width = static_cast<std::uint32_t>(width);
+        out.height = static_cast<std::uint32_t>(height);
+        out.channels = static_cast<std::uint8_t>(kOutputChannels);
+
+        stbi_image_free(decoded_data);
+        return true;
+    }
+};
+
+#ifdef EARTH_MAP_HAVE_TURBOJPEG
+
+/**
+ * @brief libjpeg-turbo backend (SIMD IDCT and color conversion)
+ */
+class TurboJpegDecoder : public ImageDecoder {
+public:
+    const char* GetName() const override { return "libjpeg-turbo"; }
+
+    bool Supports(ImageFormat format) const override {
+        return format == ImageFormat::JPEG;
+    }
+
+    bool Decode(const std::uint8_t* data, std::size_t size, DecodedImage& out) override {
+        return DecodeInto(data, size, nullptr, 0, out);
+    }
+
+    bool DecodeInto(const std::uint8_t* data, std::size_t size,
+                    std::uint8_t* dst, std::size_t capacity, DecodedImage& out) override {
+        // One handle per decode thread; handles are not thread-safe
+        struct Handle {
+            tjhandle handle = tjInitDecompress();
+            ~Handle() {
+                if (handle) {
+                    tjDestroy(handle);
+                }
+            }
+        };
+        thread_local Handle tls_handle;
+
+        if (!tls_handle.handle) {
+            return false;
+        }
+
+        int width = 0;
+        int height = 0;
+        int subsampling = 0;
+        int colorspace = 0;
+        if (tjDecompressHeader3(tls_handle.handle, data, static_cast<unsigned long>(size),
+                                &width, &height, &subsampling, &colorspace) != 0) {
+            spdlog::debug("libjpeg-turbo header failed: {}", tjGetErrorStr2(tls_handle.handle));
+            return false;
+        }
+
+        const std::size_t decoded_size =
+            static_cast<std::size_t>(width) * height * kOutputChannels;
+        std::uint8_t* target = dst;
+        if (!target) {
+            out.pixels.resize(decoded_size);
+            target = out.pixels.data();
+        } else if (decoded_size > capacity) {
+            return false;
+        }
+
+        if (tjDecompress2(tls_handle.handle, data, static_cast<unsigned long>(size),
+                          target, width, 0, height, TJPF_RGBA, 0) != 0) {
+            spdlog::debug("libjpeg-turbo decode failed: {}", tjGetErrorStr2(tls_handle.handle));
+            return false;
+        }
+
+        out.width = static_cast<std::uint32_t>(width);
+        out.height = static_cast<std::uint32_t>(height);
+        out.channels = static_cast<std::uint8_t>(kOutputChannels);
+        return true;
+    }
+};
+
+#endif // EARTH_MAP_HAVE_TURBOJPEG
+
+#ifdef EARTH_MAP_HAVE_SPNG
+
+/**
+ * @brief libspng backend (SIMD filters, faster inflate)
+ */
+class SpngDecoder : public ImageDecoder {
+public:
+    const char* GetName() const override { return "libspng"; }
+
+    bool Supports(ImageFormat format) const override {
+        return format == ImageFormat::PNG;
+    }
+
+    bool Decode(const std::uint8_t* data, std::size_t size, DecodedImage& out) override {
+        return DecodeInto(data, size, nullptr, 0, out);
+    }
+
+    bool DecodeInto(const std::uint8_t* data, std::size_t size,
+                    std::uint8_t* dst, std::size_t capacity, DecodedImage& out) override {
+        std::unique_ptr<spng_ctx, decltype(&spng_ctx_free)> ctx(spng_ctx_new(0), &spng_ctx_free);
+        if (!ctx) {
+            return false;
+        }
+
+        int result = spng_set_png_buffer(ctx.get(), data, size);
+
+        spng_ihdr ihdr{};
+        if (result == 0) {
+            result = spng_get_ihdr(ctx.get(), &ihdr);
+        }
+
+        std::size_t decoded_size = 0;
+        if (result == 0) {
+            result = spng_decoded_image_size(ctx.get(), SPNG_FMT_RGBA8, &decoded_size);
+        }
+
+        std::uint8_t* target = dst;
+        if (result == 0) {
+            if (!target) {
+                out.pixels.resize(decoded_size);
+                target = out.pixels.data();
+            } else if (decoded_size > capacity) {
+                return false;
+            }
+            result = spng_decode_image(ctx.get(), target, decoded_size,
+                                       SPNG_FMT_RGBA8, SPNG_DECODE_TRNS);
+        }
+
+        if (result != 0) {
+            spdlog::debug("libspng decode failed: {}", spng_strerror(result));
+            return false;
+        }
+
+        out.width = ihdr.width;
+        out.height = ihdr.height;
+        out.channels = static_cast<std::uint8_t>(kOutputChannels);
+        return true;
+    }
+};
+
+#endif // EARTH_MAP_HAVE_SPNG
+
+void UpdateMax(std::atomic<std::uint64_t>& target, std::uint64_t value) {
+    std::uint64_t current = target.load();
+    while (value > current && !target.compare_exchange_weak(current, value)) {
+    }
+}
+
+} // namespace
+
+const char* ImageFormatName(ImageFormat format) {
+    switch (format) {
+        case ImageFormat::PNG:
+            return "png";
+        case ImageFormat::JPEG:
+            return "jpeg";
+        case ImageFormat::WebP:
+            return "webp";
+        case ImageFormat::Unknown:
+        default:
+            return "unknown";
+    }
+}
+
+ImageFormat DetectImageFormat(const std::uint8_t* data, std::size_t size) {
+    static constexpr std::uint8_t kPngSignature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+    if (!data) {
+        return ImageFormat::Unknown;
+    }
+    if (size >= sizeof(kPngSignature) &&
+        std::memcmp(data, kPngSignature, sizeof(kPngSignature)) == 0) {
+        return ImageFormat::PNG;
+    }
+    if (size >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF) {
+        return ImageFormat::JPEG;
+    }
+    if (size >= 12 && std::memcmp(data, "RIFF", 4) == 0 && std::memcmp(data + 8, "WEBP", 4) == 0) {
+        return ImageFormat::WebP;
+    }
+    return ImageFormat::Unknown;
+}
+
+bool ReadImageSize(const std::uint8_t* data, std::size_t size,
+                   std::uint32_t& width, std::uint32_t& height) {
+    const auto be16 = [data](std::size_t at) {
+        return static_cast<std::uint32_t>(data[at] << 8 | data[at + 1]);
+    };
+    const auto le16 = [data](std::size_t at) {
+        return static_cast<std::uint32_t>(data[at] | data[at + 1] << 8);
+    };
+
+    switch (DetectImageFormat(data, size)) {
+    case ImageFormat::PNG:
+        // IHDR is always the first chunk
+        if (size < 24) {
+            return false;
+        }
+        width = be16(16) << 16 | be16(18);
+        height = be16(20) << 16 | be16(22);
+        return true;
+    case ImageFormat::JPEG:
+        // Walk the marker segments up to the frame header (SOF0-SOF15 but DHT, JPG, DAC)
+        for (std::size_t at = 2; at + 4 <= size;) {
+            if (data[at] != 0xFF) {
+                return false;
+            }
+            const std::uint8_t marker = data[at + 1];
+            if (marker == 0xFF) {
+                ++at;
+                continue;
+            }
+            if (marker >= 0xC0 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 &&
+                marker != 0xCC) {
+                if (at + 9 > size) {
+                    return false;
+                }
+                height = be16(at + 5);
+                width = be16(at + 7);
+                return true;
+            }
+            at += 2 + be16(at + 2);
+        }
+        return false;
+    case ImageFormat::WebP:
+        if (size >= 30 && std::memcmp(data + 12, "VP8 ", 4) == 0) {
+            width = le16(26) & 0x3FFF;
+            height = le16(28) & 0x3FFF;
+            return true;
+        }
+        if (size >= 25 && std::memcmp(data + 12, "VP8L", 4) == 0) {
+            const std::uint32_t bits = le16(21) | le16(23) << 16;
+            width = (bits & 0x3FFF) + 1;
+            height = (bits >> 14 & 0x3FFF) + 1;
+            return true;
+        }
+        if (size >= 30 && std::memcmp(data + 12, "VP8X", 4) == 0) {
+            width = (le16(24) | static_cast<std::uint32_t>(data[26]) << 16) + 1;
+            height = (le16(27) | static_cast<std::uint32_t>(data[29]) << 16) + 1;
+            return true;
+        }
+        return false;
+    case ImageFormat::Unknown:
+        break;
+    }
+    return false;
+}
+
+bool ImageDecoder::DecodeInto(const std::uint8_t* data, std::size_t size,
+                              std::uint8_t* dst, std::size_t capacity, DecodedImage& out) {
+    if (!dst || !Decode(data, size, out)) {
+        return false;
+    }
+    if (out.pixels.size() > capacity) {
+        spdlog::debug("{}: decoded image ({} bytes) exceeds target buffer ({} bytes)",
+                      GetName(), out.pixels.size(), capacity);
+        return false;
+    }
+
+    std::memcpy(dst, out.pixels.data(), out.pixels.size());
+    out.pixels.clear();
+    return true;
+}
+
+std::unique_ptr<ImageDecoder> CreateStbImageDecoder() {
+    return std::make_unique<StbImageDecoder>();
+}
+
+std::unique_ptr<ImageDecoder> CreateTurboJpegDecoder() {
+#ifdef EARTH_MAP_HAVE_TURBOJPEG
+    return std::make_unique<TurboJpegDecoder>();
+#else
+    return nullptr;
+#endif
+}
+
+std::unique_ptr<ImageDecoder> CreateSpngDecoder() {
+#ifdef EARTH_MAP_HAVE_SPNG
+    return std::make_unique<SpngDecoder>();
+#else
+    return nullptr;
+#endif
+}
+
+std::unique_ptr<ImageDecoderRegistry> ImageDecoderRegistry::CreateDefault() {
+    auto registry = std::make_unique<ImageDecoderRegistry>();
+    registry->Register(CreateTurboJpegDecoder());
+    registry->Register(CreateSpngDecoder());
+    registry->Register(CreateStbImageDecoder());
+    return registry;
+}
+
+void ImageDecoderRegistry::Register(std::unique_ptr<ImageDecoder> decoder) {
+    if (!decoder) {
+        return;
+    }
+    spdlog::debug("Registered image decoder: {}", decoder->GetName());
+    decoders_.push_back(std::move(decoder));
+}
+
+template <typename DecodeFn>
+bool ImageDecoderRegistry::DecodeWith(const std::uint8_t* data, std::size_t size,
+                                      DecodeFn&& decode) {
+    const ImageFormat format = DetectImageFormat(data, size);
+    AtomicFormatStats& stats = stats_[static_cast<std::size_t>(format)];
+
+    if (!data || size == 0) {
+        stats.failed.fetch_add(1);
+        return false;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (const auto& decoder : decoders_) {
+        if (!decoder->Supports(format)) {
+            continue;
+        }
+        if (!decode(*decoder)) {
+            continue;
+        }
+
+        const auto elapsed_us = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - start).count());
+        stats.decoded.fetch_add(1);
+        stats.total_decode_us.fetch_add(elapsed_us);
+        UpdateMax(stats.max_decode_us, elapsed_us);
+
+        spdlog::trace("Decoded {} image with {} in {} us",
+                      ImageFormatName(format), decoder->GetName(), elapsed_us);
+        return true;
+    }
+
+    stats.failed.fetch_add(1);
+    spdlog::warn("No decoder could decode {} image ({} bytes)", ImageFormatName(format), size);
+    return false;
+}
+
+bool ImageDecoderRegistry::Decode(const std::uint8_t* data, std::size_t size,
+                                  DecodedImage& out) {
+    return DecodeWith(data, size, [&](ImageDecoder& decoder) {
+        return decoder.Decode(data, size, out);
+    });
+}
+
+bool ImageDecoderRegistry::DecodeInto(const std::uint8_t* data, std::size_t size,
+                                      std::uint8_t* dst, std::size_t capacity,
+                                      DecodedImage& out) {
+    return DecodeWith(data, size, [&](ImageDecoder& decoder) {
+        return decoder.DecodeInto(data, size, dst, capacity, out);
+    });
+}
+
+std::vector<std::string> ImageDecoderRegistry::GetDecoderNames(ImageFormat format) const {
+    std::vector<std::string> names;
+    for (const auto& decoder : decoders_) {
+        if (decoder->Supports(format)) {
+            names.emplace_back(decoder->GetName());
+        }
+    }
+    return names;
+}
+
+ImageDecodeStats ImageDecoderRegistry::GetStats() const {
+    ImageDecodeStats snapshot;
+    for (std::size_t i = 0; i < kImageFormatCount; ++i) {
+        snapshot.per_format[i].decoded = stats_[i].decoded.load();
+        snapshot.per_format[i].failed = stats_[i].failed.load();
+        snapshot.per_format[i].total_decode_us = stats_[i].total_decode_us.load();
+        snapshot.per_format[i].max_decode_us = stats_[i].max_decode_us.load();
+    }
+    return snapshot;
+}
+
+} // namespace earth_map
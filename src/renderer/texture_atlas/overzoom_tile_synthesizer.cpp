@@ -0,0 +1,153 @@
+/**
+ * @file overzoom_tile_synthesizer.cpp
+ * @brief Implementation of overzoomed tile synthesis
+ */
+
+#include <earth_map/renderer/texture_atlas/overzoom_tile_synthesizer.h>
+#include <algorithm>
+#include <cmath>
+
+namespace earth_map {
+
+namespace {
+
+/**
+ * @brief Bilinear sample position along one axis
+ *
+ * Maps output pixel @p out (of @p size) of the cell at @p offset within a
+ * 2^levels subdivision onto ancestor pixels, clamped to the ancestor image.
+ */
+struct AxisSample {
+    std::uint32_t lo;
+    std::uint32_t hi;
+    float weight;  ///< Weight of hi
+};
+
+AxisSample SampleAxis(std::uint32_t out, std::uint32_t size,
+                      std::int64_t offset, std::int64_t scale) {
+    // Pixel center in ancestor pixels
+    const double center = (static_cast<double>(offset) * size + out + 0.5) /
+                          static_cast<double>(scale) - 0.5;
+    const double clamped = std::clamp(center, 0.0, static_cast<double>(size - 1));
+    const double lo = std::floor(clamped);
+
+    AxisSample sample;
+    sample.lo = static_cast<std::uint32_t>(lo);
+    sample.hi = std::min(sample.lo + 1, size - 1);
+    sample.weight = static_cast<float>(clamped - lo);
+    return sample;
+}
+
+} // namespace
+
+OverzoomTileSynthesizer::OverzoomTileSynthesizer(std::size_t max_cached_sources)
+    : max_cached_sources_(max_cached_sources) {}
+
+std::optional<TileCoordinates> OverzoomTileSynthesizer::GetSourceTile(
+    const TileCoordinates& target, std::int32_t max_zoom) {
+    const std::int32_t levels = target.zoom - max_zoom;
+    if (levels <= 0 || levels > kMaxOverzoomLevels || max_zoom < 0) {
+        return std::nullopt;
+    }
+    return TileCoordinates(target.x >> levels, target.y >> levels, max_zoom);
+}
+
+bool OverzoomTileSynthesizer::Synthesize(const DecodedImage& source_image,
+                                         const TileCoordinates& source,
+                                         const TileCoordinates& target,
+                                         std::uint8_t* dst,
+                                         std::size_t capacity) {
+    const std::int32_t levels = target.zoom - source.zoom;
+    if (levels < 0 || levels > kMaxOverzoomLevels || dst == nullptr) {
+        return false;
+    }
+
+    const std::uint32_t width = source_image.width;
+    const std::uint32_t height = source_image.height;
+    const std::uint32_t channels = source_image.channels;
+    const std::size_t size = static_cast<std::size_t>(width) * height * channels;
+    if (size == 0 || source_image.pixels.size() < size || size > capacity) {
+        return false;
+    }
+
+    // Target's cell inside the ancestor's 2^levels x 2^levels subdivision
+    const std::int64_t scale = std::int64_t{1} << levels;
+    const std::int64_t offset_x = target.x - (static_cast<std::int64_t>(source.x) << levels);
+    const std::int64_t offset_y = target.y - (static_cast<std::int64_t>(source.y) << levels);
+    if (offset_x < 0 || offset_x >= scale || offset_y < 0 || offset_y >= scale) {
+        return false;
+    }
+
+    const std::uint8_t* src = source_image.pixels.data();
+    const std::size_t row_stride = static_cast<std::size_t>(width) * channels;
+
+    for (std::uint32_t out_y = 0; out_y < height; ++out_y) {
+        const AxisSample sy = SampleAxis(out_y, height, offset_y, scale);
+        const std::uint8_t* row_lo = src + sy.lo * row_stride;
+        const std::uint8_t* row_hi = src + sy.hi * row_stride;
+        std::uint8_t* out = dst + out_y * row_stride;
+
+        for (std::uint32_t out_x = 0; out_x < width; ++out_x) {
+            const AxisSample sx = SampleAxis(out_x, width, offset_x, scale);
+            const std::size_t lo = static_cast<std::size_t>(sx.lo) * channels;
+            const std::size_t hi = static_cast<std::size_t>(sx.hi) * channels;
+
+            for (std::uint32_t c = 0; c < channels; ++c) {
+                const float top = row_lo[lo + c] + (row_lo[hi + c] - row_lo[lo + c]) * sx.weight;
+                const float bottom = row_hi[lo + c] + (row_hi[hi + c] - row_hi[lo + c]) * sx.weight;
+                const float value = top + (bottom - top) * sy.weight;
+                out[static_cast<std::size_t>(out_x) * channels + c] =
+                    static_cast<std::uint8_t>(std::lround(std::clamp(value, 0.0f, 255.0f)));
+            }
+        }
+    }
+
+    return true;
+}
+
+std::shared_ptr<const DecodedImage> OverzoomTileSynthesizer::FindSource(
+    const TileCoordinates& source) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(source);
+    if (it == index_.end()) {
+        return nullptr;
+    }
+    lru_.splice(lru_.begin(), lru_, it->second);
+    return it->second->second;
+}
+
+void OverzoomTileSynthesizer::AddSource(const TileCoordinates& source,
+                                        std::shared_ptr<const DecodedImage> image) {
+    if (max_cached_sources_ == 0 || !image) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = index_.find(source);
+    if (it != index_.end()) {
+        it->second->second = std::move(image);
+        lru_.splice(lru_.begin(), lru_, it->second);
+        return;
+    }
+
+    lru_.emplace_front(source, std::move(image));
+    index_[source] = lru_.begin();
+
+    while (lru_.size() > max_cached_sources_) {
+        index_.erase(lru_.back().first);
+        lru_.pop_back();
+    }
+}
+
+void OverzoomTileSynthesizer::Clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    index_.clear();
+    lru_.clear();
+}
+
+std::size_t OverzoomTileSynthesizer::GetCachedSourceCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return lru_.size();
+}
+
+} // namespace earth_map
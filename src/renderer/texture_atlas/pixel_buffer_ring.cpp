@@ -0,0 +1,162 @@
+/**
+ * @file pixel_buffer_ring.cpp
+ * @brief Implementation of the persistently mapped pixel buffer ring
+ */
+
+#include <earth_map/renderer/texture_atlas/pixel_buffer_ring.h>
+#include <GL/glew.h>
+#include <spdlog/spdlog.h>
+
+namespace earth_map {
+
+PixelBufferRing::PixelBufferRing(std::uint32_t slot_count, std::size_t slot_size,
+                                 bool skip_gl_init)
+    : slot_count_(slot_count > 0 ? slot_count : 1)
+    , slot_size_(slot_size) {
+
+    if (skip_gl_init || !CreateMappedBuffer()) {
+        cpu_storage_.resize(static_cast<std::size_t>(slot_count_) * slot_size_);
+        base_ = cpu_storage_.data();
+    }
+
+    free_slots_.reserve(slot_count_);
+    // Pushed in reverse so slot 0 is handed out first
+    for (std::uint32_t i = slot_count_; i-- > 0;) {
+        free_slots_.push_back(i);
+    }
+
+    spdlog::debug("PixelBufferRing: {} slots x {} bytes ({})", slot_count_, slot_size_,
+                  buffer_id_ != 0 ? "persistent PBO" : "CPU memory");
+}
+
+PixelBufferRing::~PixelBufferRing() {
+    if (buffer_id_ == 0) {
+        return;
+    }
+
+    for (const auto& fenced : fenced_slots_) {
+        glDeleteSync(static_cast<GLsync>(fenced.fence));
+    }
+    fenced_slots_.clear();
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer_id_);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glDeleteBuffers(1, &buffer_id_);
+    buffer_id_ = 0;
+}
+
+bool PixelBufferRing::CreateMappedBuffer() {
+    if (!GLEW_ARB_buffer_storage && !GLEW_VERSION_4_4) {
+        spdlog::info("PixelBufferRing: ARB_buffer_storage unavailable, using CPU staging");
+        return false;
+    }
+
+    const GLsizeiptr total_size = static_cast<GLsizeiptr>(slot_count_) *
+                                  static_cast<GLsizeiptr>(slot_size_);
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+    glGenBuffers(1, &buffer_id_);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer_id_);
+    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, total_size, nullptr, flags);
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, total_size, flags);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (!mapped) {
+        spdlog::warn("PixelBufferRing: persistent mapping failed, using CPU staging");
+        glDeleteBuffers(1, &buffer_id_);
+        buffer_id_ = 0;
+        return false;
+    }
+
+    base_ = static_cast<std::uint8_t*>(mapped);
+    return true;
+}
+
+PixelSlotHandle PixelBufferRing::Acquire(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(free_mutex_);
+    if (!free_cv_.wait_for(lock, timeout, [this]() { return !free_slots_.empty(); })) {
+        return PixelSlotHandle{};
+    }
+
+    PixelSlotHandle slot;
+    slot.index = free_slots_.back();
+    free_slots_.pop_back();
+    return slot;
+}
+
+PixelSlotHandle PixelBufferRing::TryAcquire() {
+    return Acquire(std::chrono::milliseconds(0));
+}
+
+void PixelBufferRing::Release(PixelSlotHandle slot) {
+    if (!slot.IsValid() || slot.index >= slot_count_) {
+        return;
+    }
+    PushFree(slot.index);
+}
+
+std::uint8_t* PixelBufferRing::GetSlotData(PixelSlotHandle slot) const {
+    if (!slot.IsValid() || slot.index >= slot_count_) {
+        return nullptr;
+    }
+    return base_ + GetSlotOffset(slot);
+}
+
+void PixelBufferRing::FenceAndRelease(PixelSlotHandle slot) {
+    if (!slot.IsValid() || slot.index >= slot_count_) {
+        return;
+    }
+
+    // CPU slots are copied by the driver during the upload call itself
+    if (buffer_id_ == 0) {
+        PushFree(slot.index);
+        return;
+    }
+
+    GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    if (!fence) {
+        // Cannot track completion: wait for the GPU rather than risk overwriting
+        glFinish();
+        PushFree(slot.index);
+        return;
+    }
+    fenced_slots_.push_back(FencedSlot{slot.index, fence});
+}
+
+std::size_t PixelBufferRing::Reclaim() {
+    std::size_t reclaimed = 0;
+
+    // Fences complete in submission order, so stop at the first pending one
+    while (!fenced_slots_.empty()) {
+        const FencedSlot& front = fenced_slots_.front();
+        GLsync fence = static_cast<GLsync>(front.fence);
+        const GLenum status = glClientWaitSync(fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED &&
+            status != GL_WAIT_FAILED) {
+            break;
+        }
+
+        glDeleteSync(fence);
+        PushFree(front.index);
+        fenced_slots_.pop_front();
+        ++reclaimed;
+    }
+
+    return reclaimed;
+}
+
+std::size_t PixelBufferRing::GetFreeCount() const {
+    std::lock_guard<std::mutex> lock(free_mutex_);
+    return free_slots_.size();
+}
+
+void PixelBufferRing::PushFree(std::uint32_t index) {
+    {
+        std::lock_guard<std::mutex> lock(free_mutex_);
+        free_slots_.push_back(index);
+    }
+    free_cv_.notify_one();
+}
+
+} // namespace earth_map
@@ -0,0 +1,220 @@
+/**
+ * @file shelf_texture_atlas.cpp
+ * @brief Implementation of the shelf-packed texture atlas
+ */
+
+#include <earth_map/renderer/texture_atlas/shelf_texture_atlas.h>
+#include <GL/glew.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace earth_map {
+
+ShelfTextureAtlas::ShelfTextureAtlas(std::uint32_t atlas_width,
+                                     std::uint32_t atlas_height,
+                                     std::uint8_t channels,
+                                     std::uint32_t padding,
+                                     bool skip_gl_init)
+    : atlas_width_(atlas_width)
+    , atlas_height_(atlas_height)
+    , channels_(channels == 4 ? 4 : 1)
+    , padding_(padding)
+    , skip_gl_init_(skip_gl_init) {
+
+    // Create OpenGL atlas texture (unless skipped for testing)
+    if (!skip_gl_init_) {
+        CreateAtlasTexture();
+    }
+
+    spdlog::debug("ShelfTextureAtlas initialized: {}x{} atlas, {} channel(s)",
+                  atlas_width_, atlas_height_, channels_);
+}
+
+ShelfTextureAtlas::~ShelfTextureAtlas() {
+    if (atlas_texture_id_ != 0 && !skip_gl_init_) {
+        glDeleteTextures(1, &atlas_texture_id_);
+        atlas_texture_id_ = 0;
+    }
+}
+
+void ShelfTextureAtlas::CreateAtlasTexture() {
+    glGenTextures(1, &atlas_texture_id_);
+    glBindTexture(GL_TEXTURE_2D, atlas_texture_id_);
+
+    // Zero-filled so that unused texels and padding sample as empty
+    const std::vector<std::uint8_t> zeros(
+        static_cast<std::size_t>(atlas_width_) * atlas_height_ * channels_, 0);
+    const GLenum format = channels_ == 4 ? GL_RGBA : GL_RED;
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, channels_ == 4 ? GL_RGBA8 : GL_R8,
+                 atlas_width_, atlas_height_, 0, format, GL_UNSIGNED_BYTE, zeros.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    spdlog::debug("Created shelf atlas texture: ID={}, size={}x{}",
+                  atlas_texture_id_, atlas_width_, atlas_height_);
+}
+
+std::optional<ShelfAtlasRegion> ShelfTextureAtlas::Allocate(std::uint32_t width,
+                                                            std::uint32_t height) {
+    if (width == 0 || height == 0) {
+        return std::nullopt;
+    }
+    const std::uint32_t padded_width = width + 2 * padding_;
+    const std::uint32_t padded_height = height + 2 * padding_;
+    if (padded_width > atlas_width_ || padded_height > atlas_height_) {
+        return std::nullopt;
+    }
+
+    // Best fit among shelves that waste at most half their height
+    std::uint32_t best = std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t best_height = std::numeric_limits<std::uint32_t>::max();
+    std::uint32_t fallback = std::numeric_limits<std::uint32_t>::max();
+    for (std::uint32_t i = 0; i < shelves_.size(); ++i) {
+        const Shelf& shelf = shelves_[i];
+        if (shelf.height < padded_height || shelf.cursor + padded_width > atlas_width_) {
+            continue;
+        }
+        if (shelf.height <= padded_height + padded_height / 2) {
+            if (shelf.height < best_height) {
+                best = i;
+                best_height = shelf.height;
+            }
+        } else if (fallback == std::numeric_limits<std::uint32_t>::max()) {
+            fallback = i;
+        }
+    }
+    if (best != std::numeric_limits<std::uint32_t>::max()) {
+        return Place(best, width, height);
+    }
+
+    // Open a new shelf below the last one
+    if (free_y_ + padded_height <= atlas_height_) {
+        Shelf shelf;
+        shelf.y = free_y_;
+        shelf.height = padded_height;
+        shelves_.push_back(shelf);
+        free_y_ += padded_height;
+        return Place(static_cast<std::uint32_t>(shelves_.size() - 1), width, height);
+    }
+
+    // Out of height: settle for a taller shelf
+    if (fallback != std::numeric_limits<std::uint32_t>::max()) {
+        return Place(fallback, width, height);
+    }
+    return std::nullopt;
+}
+
+ShelfAtlasRegion ShelfTextureAtlas::Place(std::uint32_t shelf_index, std::uint32_t width,
+                                          std::uint32_t height) {
+    Shelf& shelf = shelves_[shelf_index];
+    const std::uint32_t padded_width = width + 2 * padding_;
+
+    ShelfAtlasRegion region;
+    region.x = shelf.cursor + padding_;
+    region.y = shelf.y + padding_;
+    region.width = width;
+    region.height = height;
+    region.shelf = shelf_index;
+    region.uv = glm::vec4(static_cast<float>(region.x) / static_cast<float>(atlas_width_),
+                          static_cast<float>(region.y) / static_cast<float>(atlas_height_),
+                          static_cast<float>(region.x + width) / static_cast<float>(atlas_width_),
+                          static_cast<float>(region.y + height) / static_cast<float>(atlas_height_));
+
+    shelf.cursor += padded_width;
+    ++shelf.regions;
+    shelf.used_pixels += static_cast<std::size_t>(padded_width) * (height + 2 * padding_);
+    return region;
+}
+
+void ShelfTextureAtlas::Release(const ShelfAtlasRegion& region) {
+    if (region.shelf >= shelves_.size()) {
+        return;
+    }
+    Shelf& shelf = shelves_[region.shelf];
+    if (shelf.regions == 0) {
+        return;
+    }
+
+    const std::size_t area = static_cast<std::size_t>(region.width + 2 * padding_) *
+                             (region.height + 2 * padding_);
+    --shelf.regions;
+    shelf.used_pixels -= std::min(shelf.used_pixels, area);
+    if (shelf.regions > 0) {
+        return;
+    }
+
+    // Empty shelf: reuse it from the left edge
+    shelf.cursor = 0;
+    shelf.used_pixels = 0;
+
+    // Give empty shelves at the bottom back to the free height
+    while (!shelves_.empty() && shelves_.back().regions == 0) {
+        free_y_ = shelves_.back().y;
+        shelves_.pop_back();
+    }
+}
+
+bool ShelfTextureAtlas::Upload(const ShelfAtlasRegion& region, const std::uint8_t* pixels) {
+    if (!pixels || region.width == 0 || region.height == 0 || region.shelf >= shelves_.size()) {
+        return false;
+    }
+    if (skip_gl_init_ || atlas_texture_id_ == 0) {
+        return true;
+    }
+
+    // Region plus its cleared padding, uploaded as one rectangle
+    const std::uint32_t padded_width = region.width + 2 * padding_;
+    const std::uint32_t padded_height = region.height + 2 * padding_;
+    const std::size_t row_bytes = static_cast<std::size_t>(region.width) * channels_;
+    const std::size_t padded_row_bytes = static_cast<std::size_t>(padded_width) * channels_;
+    staging_.assign(padded_row_bytes * padded_height, 0);
+    for (std::uint32_t row = 0; row < region.height; ++row) {
+        std::memcpy(staging_.data() + (row + padding_) * padded_row_bytes + padding_ * channels_,
+                    pixels + row * row_bytes, row_bytes);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, atlas_texture_id_);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0,
+                    static_cast<GLint>(region.x - padding_), static_cast<GLint>(region.y - padding_),
+                    static_cast<GLsizei>(padded_width), static_cast<GLsizei>(padded_height),
+                    channels_ == 4 ? GL_RGBA : GL_RED, GL_UNSIGNED_BYTE, staging_.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    const GLenum error = glGetError();
+    if (error != GL_NO_ERROR) {
+        spdlog::error("OpenGL error during shelf atlas upload: {}", error);
+        return false;
+    }
+    return true;
+}
+
+void ShelfTextureAtlas::Reset() {
+    shelves_.clear();
+    free_y_ = 0;
+    ++resets_;
+}
+
+ShelfAtlasStats ShelfTextureAtlas::GetStats() const {
+    ShelfAtlasStats stats;
+    stats.shelves = shelves_.size();
+    for (const Shelf& shelf : shelves_) {
+        stats.regions += shelf.regions;
+        stats.used_pixels += shelf.used_pixels;
+    }
+    stats.shelf_pixels = static_cast<std::size_t>(free_y_) * atlas_width_;
+    stats.resets = resets_;
+    return stats;
+}
+
+} // namespace earth_map
@@ -0,0 +1,195 @@
+/**
+ * @file tile_block_compressor.cpp
+ * @brief Implementation of BC1 tile compression
+ */
+
+#include <earth_map/renderer/texture_atlas/tile_block_compressor.h>
+#include <algorithm>
+#include <array>
+
+namespace earth_map {
+
+namespace {
+
+constexpr std::uint32_t kBlockTexels = 16;
+
+using Color = std::array<int, 3>;
+
+std::uint16_t PackRGB565(const Color& c) {
+    return static_cast<std::uint16_t>(((c[0] >> 3) << 11) | ((c[1] >> 2) << 5) | (c[2] >> 3));
+}
+
+/// Expand a 5:6:5 endpoint to 8 bits per channel the way the hardware does
+Color UnpackRGB565(std::uint16_t packed) {
+    const int r = (packed >> 11) & 0x1F;
+    const int g = (packed >> 5) & 0x3F;
+    const int b = packed & 0x1F;
+    return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+/// Palette in index order: c0, c1, then the 4-color (c0 > c1) or 3-color interpolants
+std::array<Color, 4> BuildPalette(std::uint16_t packed0, std::uint16_t packed1) {
+    const Color c0 = UnpackRGB565(packed0);
+    const Color c1 = UnpackRGB565(packed1);
+    std::array<Color, 4> palette{c0, c1, Color{}, Color{}};
+    for (int ch = 0; ch < 3; ++ch) {
+        if (packed0 > packed1) {
+            palette[2][ch] = (2 * c0[ch] + c1[ch]) / 3;
+            palette[3][ch] = (c0[ch] + 2 * c1[ch]) / 3;
+        } else {
+            palette[2][ch] = (c0[ch] + c1[ch]) / 2;
+            palette[3][ch] = 0;
+        }
+    }
+    return palette;
+}
+
+void WriteLE16(std::uint8_t* dst, std::uint16_t value) {
+    dst[0] = static_cast<std::uint8_t>(value);
+    dst[1] = static_cast<std::uint8_t>(value >> 8);
+}
+
+} // namespace
+
+std::size_t TileBlockCompressor::GetEncodedSize(TileTextureFormat format,
+                                                std::uint32_t width, std::uint32_t height) {
+    switch (format) {
+    case TileTextureFormat::RGBA8:
+        return static_cast<std::size_t>(width) * height * 4;
+    case TileTextureFormat::BC1:
+        if (width % kBlockSize != 0 || height % kBlockSize != 0) {
+            return 0;
+        }
+        return static_cast<std::size_t>(width / kBlockSize) * (height / kBlockSize) *
+               kBC1BlockBytes;
+    }
+    return 0;
+}
+
+bool TileBlockCompressor::CompressBC1(const std::uint8_t* src, std::uint32_t width,
+                                      std::uint32_t height, std::uint8_t channels,
+                                      std::uint8_t* dst, std::size_t capacity) {
+    const std::size_t size = GetEncodedSize(TileTextureFormat::BC1, width, height);
+    if (src == nullptr || dst == nullptr || size == 0 || size > capacity ||
+        (channels != 3 && channels != 4)) {
+        return false;
+    }
+
+    const std::size_t row_stride = static_cast<std::size_t>(width) * channels;
+    std::array<std::uint8_t, kBlockTexels * 4> rgba{};
+    std::uint8_t* out = dst;
+
+    for (std::uint32_t by = 0; by < height; by += kBlockSize) {
+        for (std::uint32_t bx = 0; bx < width; bx += kBlockSize) {
+            // Gather the whole block before writing (dst may alias src)
+            for (std::uint32_t y = 0; y < kBlockSize; ++y) {
+                const std::uint8_t* row = src + (by + y) * row_stride + bx * channels;
+                for (std::uint32_t x = 0; x < kBlockSize; ++x) {
+                    std::uint8_t* texel = &rgba[(y * kBlockSize + x) * 4];
+                    texel[0] = row[x * channels + 0];
+                    texel[1] = row[x * channels + 1];
+                    texel[2] = row[x * channels + 2];
+                    texel[3] = 255;
+                }
+            }
+            EncodeBC1Block(rgba.data(), out);
+            out += kBC1BlockBytes;
+        }
+    }
+    return true;
+}
+
+void TileBlockCompressor::EncodeBC1Block(const std::uint8_t* rgba, std::uint8_t* block) {
+    Color lo{255, 255, 255};
+    Color hi{0, 0, 0};
+    Color sum{0, 0, 0};
+    for (std::uint32_t i = 0; i < kBlockTexels; ++i) {
+        for (int ch = 0; ch < 3; ++ch) {
+            const int v = rgba[i * 4 + ch];
+            lo[ch] = std::min(lo[ch], v);
+            hi[ch] = std::max(hi[ch], v);
+            sum[ch] += v;
+        }
+    }
+
+    // The bounding box diagonal runs from lo to hi in every channel; flip red
+    // and blue where they fall as green rises so the endpoints follow the
+    // block's actual color gradient
+    int cov_rg = 0;
+    int cov_bg = 0;
+    for (std::uint32_t i = 0; i < kBlockTexels; ++i) {
+        const int dr = rgba[i * 4 + 0] - sum[0] / static_cast<int>(kBlockTexels);
+        const int dg = rgba[i * 4 + 1] - sum[1] / static_cast<int>(kBlockTexels);
+        const int db = rgba[i * 4 + 2] - sum[2] / static_cast<int>(kBlockTexels);
+        cov_rg += dr * dg;
+        cov_bg += db * dg;
+    }
+    if (cov_rg < 0) {
+        std::swap(lo[0], hi[0]);
+    }
+    if (cov_bg < 0) {
+        std::swap(lo[2], hi[2]);
+    }
+
+    // Inset the endpoints by 1/16 of the range: the interpolated palette
+    // then covers the box instead of overshooting its outliers
+    for (int ch = 0; ch < 3; ++ch) {
+        const int inset = (hi[ch] - lo[ch]) / 16;
+        hi[ch] = std::clamp(hi[ch] - inset, 0, 255);
+        lo[ch] = std::clamp(lo[ch] + inset, 0, 255);
+    }
+
+    std::uint16_t packed0 = PackRGB565(hi);
+    std::uint16_t packed1 = PackRGB565(lo);
+    if (packed0 < packed1) {
+        std::swap(packed0, packed1);
+    }
+
+    WriteLE16(block + 0, packed0);
+    WriteLE16(block + 2, packed1);
+
+    std::uint32_t indices = 0;
+    if (packed0 != packed1) {
+        const std::array<Color, 4> palette = BuildPalette(packed0, packed1);
+        for (std::uint32_t i = 0; i < kBlockTexels; ++i) {
+            int best_index = 0;
+            int best_error = -1;
+            for (int p = 0; p < 4; ++p) {
+                int error = 0;
+                for (int ch = 0; ch < 3; ++ch) {
+                    const int d = rgba[i * 4 + ch] - palette[p][ch];
+                    error += d * d;
+                }
+                if (best_error < 0 || error < best_error) {
+                    best_error = error;
+                    best_index = p;
+                }
+            }
+            indices |= static_cast<std::uint32_t>(best_index) << (2 * i);
+        }
+    }
+    // Equal endpoints: every texel takes index 0 (the single color)
+
+    WriteLE16(block + 4, static_cast<std::uint16_t>(indices));
+    WriteLE16(block + 6, static_cast<std::uint16_t>(indices >> 16));
+}
+
+void TileBlockCompressor::DecodeBC1Block(const std::uint8_t* block, std::uint8_t* rgba) {
+    const auto packed0 = static_cast<std::uint16_t>(block[0] | (block[1] << 8));
+    const auto packed1 = static_cast<std::uint16_t>(block[2] | (block[3] << 8));
+    const std::uint32_t indices = static_cast<std::uint32_t>(block[4]) |
+                                  (static_cast<std::uint32_t>(block[5]) << 8) |
+                                  (static_cast<std::uint32_t>(block[6]) << 16) |
+                                  (static_cast<std::uint32_t>(block[7]) << 24);
+
+    const std::array<Color, 4> palette = BuildPalette(packed0, packed1);
+    for (std::uint32_t i = 0; i < kBlockTexels; ++i) {
+        const Color& c = palette[(indices >> (2 * i)) & 0x3];
+        rgba[i * 4 + 0] = static_cast<std::uint8_t>(c[0]);
+        rgba[i * 4 + 1] = static_cast<std::uint8_t>(c[1]);
+        rgba[i * 4 + 2] = static_cast<std::uint8_t>(c[2]);
+        rgba[i * 4 + 3] = 255;
+    }
+}
+
+} // namespace earth_map
@@ -0,0 +1,148 @@
+/**
+ * @file tile_buffer_pool.cpp
+ * @brief Implementation of the decode buffer and upload command pool
+ */
+
+#include <earth_map/renderer/texture_atlas/tile_buffer_pool.h>
+#include <bit>
+
+namespace earth_map {
+
+namespace {
+
+/**
+ * @brief Largest class whose capacity fits in @p capacity (kSizeClassCount = none)
+ */
+std::size_t FloorSizeClass(std::size_t capacity) {
+    if (capacity < TileBufferPool::kMinSizeClass) {
+        return TileBufferPool::kSizeClassCount;
+    }
+    const std::size_t size_class =
+        static_cast<std::size_t>(std::bit_width(capacity / TileBufferPool::kMinSizeClass)) - 1;
+    return size_class < TileBufferPool::kSizeClassCount ? size_class
+                                                        : TileBufferPool::kSizeClassCount;
+}
+
+} // namespace
+
+TileBufferPool::TileBufferPool(std::size_t max_buffers_per_class, std::size_t max_commands)
+    : max_buffers_per_class_(max_buffers_per_class)
+    , max_commands_(max_commands) {}
+
+std::size_t TileBufferPool::SizeClassFor(std::size_t size) {
+    if (size <= kMinSizeClass) {
+        return 0;
+    }
+    const std::size_t units = (size + kMinSizeClass - 1) / kMinSizeClass;
+    const std::size_t size_class = static_cast<std::size_t>(std::bit_width(units - 1));
+    return size_class < kSizeClassCount ? size_class : kSizeClassCount;
+}
+
+std::vector<std::uint8_t> TileBufferPool::AcquireBuffer(std::size_t size) {
+    const std::size_t size_class = SizeClassFor(size);
+
+    if (size_class < kSizeClassCount) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& free_list = buffers_[size_class];
+        if (!free_list.empty()) {
+            std::vector<std::uint8_t> buffer = std::move(free_list.back());
+            free_list.pop_back();
+            pooled_bytes_ -= buffer.capacity();
+            ++buffer_hits_;
+            return buffer;
+        }
+        ++buffer_misses_;
+    } else {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++buffer_misses_;
+    }
+
+    // Allocate outside the lock; oversized requests are served but never pooled
+    std::vector<std::uint8_t> buffer;
+    buffer.reserve(size_class < kSizeClassCount ? SizeClassCapacity(size_class) : size);
+    return buffer;
+}
+
+void TileBufferPool::ReleaseBuffer(std::vector<std::uint8_t>&& buffer) {
+    const std::size_t size_class = FloorSizeClass(buffer.capacity());
+    if (size_class >= kSizeClassCount) {
+        return;
+    }
+
+    buffer.clear();
+    std::vector<std::uint8_t> dropped;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto& free_list = buffers_[size_class];
+        if (free_list.size() >= max_buffers_per_class_) {
+            dropped = std::move(buffer);
+        } else {
+            pooled_bytes_ += buffer.capacity();
+            free_list.push_back(std::move(buffer));
+        }
+    }
+    // dropped is freed here, outside the lock
+}
+
+std::unique_ptr<GLUploadCommand> TileBufferPool::AcquireCommand(const TileCoordinates& coords) {
+    std::unique_ptr<GLUploadCommand> command;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!commands_.empty()) {
+            command = std::move(commands_.back());
+            commands_.pop_back();
+            ++command_hits_;
+        } else {
+            ++command_misses_;
+        }
+    }
+
+    if (!command) {
+        return std::make_unique<GLUploadCommand>(coords);
+    }
+    *command = GLUploadCommand(coords);
+    return command;
+}
+
+void TileBufferPool::ReleaseCommand(std::unique_ptr<GLUploadCommand> command) {
+    if (!command) {
+        return;
+    }
+
+    // Release captured state now, not when the command is next reused
+    *command = GLUploadCommand();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (commands_.size() < max_commands_) {
+        commands_.push_back(std::move(command));
+    }
+}
+
+void TileBufferPool::Clear() {
+    std::array<std::vector<std::vector<std::uint8_t>>, kSizeClassCount> buffers;
+    std::vector<std::unique_ptr<GLUploadCommand>> commands;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffers.swap(buffers_);
+        commands.swap(commands_);
+        pooled_bytes_ = 0;
+    }
+}
+
+TileBufferPoolStats TileBufferPool::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    TileBufferPoolStats stats;
+    stats.buffer_hits = buffer_hits_;
+    stats.buffer_misses = buffer_misses_;
+    stats.command_hits = command_hits_;
+    stats.command_misses = command_misses_;
+    for (const auto& free_list : buffers_) {
+        stats.pooled_buffers += free_list.size();
+    }
+    stats.pooled_bytes = pooled_bytes_;
+    stats.pooled_commands = commands_.size();
+    return stats;
+}
+
+} // namespace earth_map
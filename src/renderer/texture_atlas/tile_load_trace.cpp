@@ -0,0 +1,166 @@
+/**
+ * @file tile_load_trace.cpp
+ * @brief Tile load trace aggregation and Chrome trace export
+ */
+
+#include <earth_map/renderer/texture_atlas/tile_load_trace.h>
+#include <spdlog/spdlog.h>
+#include <fstream>
+
+namespace earth_map {
+
+namespace {
+
+constexpr std::array<const char*, kTileLoadStageCount> kStageNames = {
+    "requested", "fetch_started", "fetched", "decoded", "staged", "uploaded", "first_rendered"};
+
+/// Phase ending at each stage (none ends at REQUESTED)
+constexpr std::array<const char*, kTileLoadStageCount> kPhaseNames = {
+    "", "queue", "fetch", "decode", "stage", "upload", "render"};
+
+constexpr std::array<const char*, kTileLoadOutcomeCount> kOutcomeNames = {
+    "rendered", "failed", "cancelled", "evicted"};
+
+double Milliseconds(TileLoadTrace::Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+} // namespace
+
+const char* GetTileLoadStageName(TileLoadStage stage) {
+    return kStageNames[static_cast<std::size_t>(stage)];
+}
+
+const char* GetTileLoadPhaseName(TileLoadStage stage) {
+    return kPhaseNames[static_cast<std::size_t>(stage)];
+}
+
+TileLoadTracer::TileLoadTracer(const TileLoadTraceConfig& config)
+    : enabled_(config.enabled)
+    , origin_(TileLoadTrace::Clock::now())
+    , config_(config) {}
+
+void TileLoadTracer::SetConfig(const TileLoadTraceConfig& config) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+    while (recorded_.size() > config_.max_recorded_traces) {
+        recorded_.pop_front();
+    }
+    enabled_.store(config.enabled, std::memory_order_relaxed);
+}
+
+TileLoadTraceConfig TileLoadTracer::GetConfig() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_;
+}
+
+std::shared_ptr<TileLoadTrace> TileLoadTracer::Begin(const TileCoordinates& coords) const {
+    if (!IsEnabled()) {
+        return nullptr;
+    }
+    auto trace = std::make_shared<TileLoadTrace>(coords);
+    trace->Mark(TileLoadStage::REQUESTED);
+    return trace;
+}
+
+void TileLoadTracer::Finish(const TileLoadTrace& trace, TileLoadOutcome outcome) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (std::size_t stage = 1; stage < kTileLoadStageCount; ++stage) {
+        const auto start = static_cast<TileLoadStage>(stage - 1);
+        const auto end = static_cast<TileLoadStage>(stage);
+        if (trace.HasReached(start) && trace.HasReached(end)) {
+            stats_.phase_latency[stage - 1].Record(
+                Milliseconds(trace.stamps[stage] - trace.stamps[stage - 1]));
+        }
+    }
+    if (outcome == TileLoadOutcome::RENDERED &&
+        trace.HasReached(TileLoadStage::FIRST_RENDERED)) {
+        stats_.time_to_render.Record(Milliseconds(
+            trace.stamps[static_cast<std::size_t>(TileLoadStage::FIRST_RENDERED)] -
+            trace.stamps[static_cast<std::size_t>(TileLoadStage::REQUESTED)]));
+    }
+    stats_.outcomes[static_cast<std::size_t>(outcome)]++;
+
+    if (config_.max_recorded_traces > 0) {
+        if (recorded_.size() >= config_.max_recorded_traces) {
+            recorded_.pop_front();
+        }
+        recorded_.push_back(RecordedTrace{trace, outcome});
+    }
+}
+
+TileLoadTraceStats TileLoadTracer::GetStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void TileLoadTracer::Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_ = TileLoadTraceStats{};
+    recorded_.clear();
+}
+
+void TileLoadTracer::WriteChromeTrace(std::ostream& out) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto micros = [this](TileLoadTrace::Clock::time_point time) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(time - origin_).count();
+    };
+
+    // Async events ("b"/"e") with one id per trace: viewers draw every tile
+    // on its own track, phases nested under the whole load
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    const auto event = [&](const char* name, char phase, std::size_t id, long long ts,
+                           const std::string& args) {
+        out << (first ? "" : ",") << "\n{\"name\":\"" << name << "\",\"cat\":\"tile\",\"ph\":\""
+            << phase << "\",\"id\":" << id << ",\"pid\":1,\"tid\":1,\"ts\":" << ts;
+        if (!args.empty()) {
+            out << ",\"args\":{" << args << "}";
+        }
+        out << "}";
+        first = false;
+    };
+
+    std::size_t id = 0;
+    for (const RecordedTrace& recorded : recorded_) {
+        const TileLoadTrace& trace = recorded.trace;
+        ++id;
+        std::size_t last = 0;
+        for (std::size_t stage = 0; stage < kTileLoadStageCount; ++stage) {
+            if (trace.HasReached(static_cast<TileLoadStage>(stage))) {
+                last = stage;
+            }
+        }
+        const std::string tile = "tile " + std::to_string(trace.coords.zoom) + "/" +
+                                 std::to_string(trace.coords.x) + "/" +
+                                 std::to_string(trace.coords.y);
+        const std::string args =
+            std::string("\"outcome\":\"") + kOutcomeNames[static_cast<std::size_t>(recorded.outcome)] +
+            "\",\"source\":\"" + (trace.from_network ? "network" : "cache") + "\"";
+
+        event(tile.c_str(), 'b', id, micros(trace.stamps[0]), args);
+        std::size_t previous = 0;
+        for (std::size_t stage = 1; stage <= last; ++stage) {
+            if (!trace.HasReached(static_cast<TileLoadStage>(stage))) {
+                continue;
+            }
+            event(kPhaseNames[stage], 'b', id, micros(trace.stamps[previous]), "");
+            event(kPhaseNames[stage], 'e', id, micros(trace.stamps[stage]), "");
+            previous = stage;
+        }
+        event(tile.c_str(), 'e', id, micros(trace.stamps[last]), "");
+    }
+    out << "\n]}\n";
+}
+
+bool TileLoadTracer::WriteChromeTrace(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        spdlog::warn("Cannot write tile load trace to {}", path);
+        return false;
+    }
+    WriteChromeTrace(file);
+    return static_cast<bool>(file);
+}
+
+} // namespace earth_map
@@ -5,19 +5,54 @@
 
 #include <earth_map/renderer/texture_atlas/tile_load_worker_pool.h>
 #include <spdlog/spdlog.h>
-#define STB_IMAGE_IMPLEMENTATION
-#include <stb_image.h>
+#include <algorithm>
+#include <bit>
+#include <cstring>
 
 namespace earth_map {
 
+namespace {
+
+/// Bytes per slot of the fallback ring (256x256 RGBA8)
+constexpr std::size_t kDefaultSlotSize = 256 * 256 * 4;
+
+/// How long a decode thread waits for the GL thread to free a slot
+constexpr std::chrono::milliseconds kSlotAcquireTimeout{100};
+
+/// The provider has no such tile, as opposed to a transient failure
+bool IsMissingTile(const TileLoadResult& result) {
+    return result.status_code == 404 || result.status_code == 410 ||
+           result.status_code == 204 || (result.success && !result.tile_data);
+}
+
+void MarkStage(const TileLoadRequest& request, TileLoadStage stage) {
+    if (request.trace) {
+        request.trace->Mark(stage);
+    }
+}
+
+void MarkFetched(const TileLoadRequest& request, bool from_network) {
+    if (request.trace) {
+        request.trace->Mark(TileLoadStage::FETCHED);
+        request.trace->from_network = from_network;
+    }
+}
+
+} // namespace
+
 TileLoadWorkerPool::TileLoadWorkerPool(
     std::shared_ptr<TileCache> cache,
     std::shared_ptr<TileLoader> loader,
     std::shared_ptr<GLUploadQueue> upload_queue,
-    int num_threads)
+    int num_decode_threads,
+    std::size_t max_in_flight_fetches,
+    std::shared_ptr<PixelBufferRing> pixel_ring)
     : cache_(std::move(cache))
     , loader_(std::move(loader))
     , upload_queue_(std::move(upload_queue))
+    , pixel_ring_(std::move(pixel_ring))
+    , buffer_pool_(std::make_shared<TileBufferPool>())
+    , max_in_flight_fetches_(max_in_flight_fetches)
     , shutdown_flag_(false) {
 
     if (!cache_) {
@@ -32,18 +67,24 @@ TileLoadWorkerPool::TileLoadWorkerPool(
         throw std::invalid_argument("GLUploadQueue cannot be null");
     }
 
-    if (num_threads < 1) {
-        num_threads = 1;
-        spdlog::warn("TileLoadWorkerPool: num_threads < 1, defaulting to 1");
+    // Download concurrency follows the loader unless overridden
+    if (max_in_flight_fetches_ == 0) {
+        max_in_flight_fetches_ = std::max<std::size_t>(
+            1, loader_->GetConfiguration().max_concurrent_downloads);
     }
 
-    // Start worker threads
-    workers_.reserve(num_threads);
-    for (int i = 0; i < num_threads; ++i) {
-        workers_.emplace_back(&TileLoadWorkerPool::WorkerThreadMain, this);
+    if (!pixel_ring_) {
+        pixel_ring_ = std::make_shared<PixelBufferRing>(
+            PixelBufferRing::kDefaultSlotCount, kDefaultSlotSize, true);
     }
 
-    spdlog::info("TileLoadWorkerPool started with {} worker threads", num_threads);
+    decoders_ = ImageDecoderRegistry::CreateDefault();
+    overzoom_ = std::make_unique<OverzoomTileSynthesizer>();
+    decode_pool_ = std::make_unique<DecodeThreadPool>(num_decode_threads);
+    fetch_thread_ = std::thread(&TileLoadWorkerPool::FetchThreadMain, this);
+
+    spdlog::info("TileLoadWorkerPool started: {} decode threads, {} fetches in flight",
+                 decode_pool_->GetThreadCount(), max_in_flight_fetches_);
 }
 
 TileLoadWorkerPool::~TileLoadWorkerPool() {
@@ -54,15 +95,37 @@ void TileLoadWorkerPool::Shutdown() {
     // Signal shutdown
     shutdown_flag_.store(true);
 
-    // Wake all workers
+    // Wake the dispatcher
     queue_cv_.notify_all();
 
-    // Wait for all workers to finish
-    for (auto& worker : workers_) {
-        if (worker.joinable()) {
-            worker.join();
+    // Dispatcher exits once the queue is drained into fetches
+    if (fetch_thread_.joinable()) {
+        fetch_thread_.join();
+    }
+
+    // Cancel downloads still running instead of waiting for the network;
+    // downloads started from now on fail right away
+    std::vector<TileCoordinates> downloads;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        cancel_downloads_ = true;
+        downloads.reserve(downloads_.size());
+        for (const auto& [coords, count] : downloads_) {
+            downloads.push_back(coords);
         }
     }
+    for (const TileCoordinates& coords : downloads) {
+        loader_->CancelLoad(coords);
+    }
+
+    // Wait for fetches in flight: their callbacks still reference this pool
+    {
+        std::unique_lock<std::mutex> lock(queue_mutex_);
+        queue_cv_.wait(lock, [this]() { return in_flight_fetches_ == 0; });
+    }
+
+    // Run remaining decodes and join decode threads
+    decode_pool_->Shutdown();
 
     spdlog::info("TileLoadWorkerPool shutdown complete");
 }
@@ -74,158 +137,755 @@ void TileLoadWorkerPool::SubmitRequest(
 
     std::lock_guard<std::mutex> lock(queue_mutex_);
 
-    // Check if tile is already queued or being processed (deduplication)
+    // Already being fetched or decoded: nothing to refresh (deduplication)
     if (in_flight_.find(coords) != in_flight_.end()) {
-        spdlog::trace("Tile {} already queued or processing, skipping", coords.GetKey());
+        spdlog::trace("Tile {} already processing, skipping", coords.GetKey());
         return;
     }
 
-    // Add to in-flight set
-    in_flight_.insert(coords);
+    // Insert, or refresh priority and generation of an already queued request
+    // (which keeps its trace)
+    TileLoadRequest request(coords, priority, std::move(on_complete), generation_);
+    if (tracer_ && !request_queue_.Contains(coords)) {
+        request.trace = tracer_->Begin(coords);
+    }
+    const bool added = request_queue_.Push(std::move(request));
 
-    // Add to priority queue
-    request_queue_.emplace(coords, priority, std::move(on_complete));
+    if (!added) {
+        spdlog::trace("Refreshed queued tile {} with priority {}", coords.GetKey(), priority);
+        return;
+    }
 
     spdlog::trace("Submitted tile {} with priority {}", coords.GetKey(), priority);
 
-    // Notify one worker
-    queue_cv_.notify_one();
+    // Notify the dispatcher
+    queue_cv_.notify_all();
+}
+
+bool TileLoadWorkerPool::UpdatePriority(const TileCoordinates& coords, int priority) {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (!request_queue_.Contains(coords)) {
+        return false;
+    }
+
+    // Re-stamp with the current generation: a reprioritized tile is still wanted
+    request_queue_.Push(TileLoadRequest(coords, priority, nullptr, generation_));
+    return true;
+}
+
+bool TileLoadWorkerPool::CancelRequest(const TileCoordinates& coords) {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    const auto cancelled = request_queue_.Take(coords);
+    if (!cancelled) {
+        return false;
+    }
+    if (cancelled->trace && tracer_) {
+        tracer_->Finish(*cancelled->trace, TileLoadOutcome::CANCELLED);
+    }
+    spdlog::trace("Cancelled queued tile {}", coords.GetKey());
+    return true;
+}
+
+std::uint64_t TileLoadWorkerPool::AdvanceGeneration() {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    return ++generation_;
+}
+
+std::uint64_t TileLoadWorkerPool::GetGeneration() const {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    return generation_;
+}
+
+std::vector<TileCoordinates> TileLoadWorkerPool::CancelStaleRequests() {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    std::vector<TileLoadRequest> requests;
+    request_queue_.DropOlderThan(generation_, requests);
+
+    std::vector<TileCoordinates> dropped;
+    dropped.reserve(requests.size());
+    for (const TileLoadRequest& request : requests) {
+        if (request.trace && tracer_) {
+            tracer_->Finish(*request.trace, TileLoadOutcome::CANCELLED);
+        }
+        dropped.push_back(request.coords);
+    }
+    if (!dropped.empty()) {
+        spdlog::debug("Dropped {} stale tile requests", dropped.size());
+    }
+    return dropped;
+}
+
+void TileLoadWorkerPool::SetTracer(std::shared_ptr<TileLoadTracer> tracer) {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    tracer_ = std::move(tracer);
 }
 
 std::size_t TileLoadWorkerPool::GetPendingCount() const {
     std::lock_guard<std::mutex> lock(queue_mutex_);
-    return request_queue_.size();
+    return request_queue_.Size();
+}
+
+std::size_t TileLoadWorkerPool::GetInFlightFetchCount() const {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    return in_flight_fetches_;
 }
 
-void TileLoadWorkerPool::WorkerThreadMain() {
-    spdlog::debug("Worker thread started");
+void TileLoadWorkerPool::FetchThreadMain() {
+    spdlog::debug("Fetch dispatcher thread started");
 
     while (true) {
         TileLoadRequest request;
-        bool have_request = false;
 
-        // Wait for request or shutdown
+        // Wait for a request and a free fetch slot, or shutdown
         {
             std::unique_lock<std::mutex> lock(queue_mutex_);
 
             queue_cv_.wait(lock, [this]() {
-                return !request_queue_.empty() || shutdown_flag_.load();
+                const bool can_fetch = !request_queue_.Empty() &&
+                                       in_flight_fetches_ < max_in_flight_fetches_;
+                return can_fetch || (shutdown_flag_.load() && request_queue_.Empty());
             });
 
-            // Get request from queue
-            if (!request_queue_.empty()) {
-                request = request_queue_.top();
-                request_queue_.pop();
-                have_request = true;
-            } else if (shutdown_flag_.load()) {
+            auto next = request_queue_.Pop();
+            if (!next) {
                 // Queue is empty and shutdown requested - exit
                 break;
             }
-        }
-
-        // Process request outside of lock
-        if (have_request) {
-            ProcessRequest(request);
 
-            // Remove from in-flight set
-            {
-                std::lock_guard<std::mutex> lock(queue_mutex_);
-                in_flight_.erase(request.coords);
-            }
+            request = std::move(*next);
+            MarkStage(request, TileLoadStage::FETCH_STARTED);
+            in_flight_.insert(request.coords);
+            ++in_flight_fetches_;
         }
+
+        // Start fetch outside of lock (callbacks may run synchronously)
+        StartFetch(request);
     }
 
-    spdlog::debug("Worker thread exiting");
+    spdlog::debug("Fetch dispatcher thread exiting");
 }
 
-void TileLoadWorkerPool::ProcessRequest(const TileLoadRequest& request) {
+void TileLoadWorkerPool::StartFetch(const TileLoadRequest& request) {
     const auto& coords = request.coords;
-    spdlog::trace("Processing tile load request: {}", coords.GetKey());
+    spdlog::trace("Fetching tile: {}", coords.GetKey());
 
-    // Step 1: Check cache
-    std::optional<TileData> cached_data;
-    bool cache_hit = false;
+    // Vector tiles are drawn from their ancestor instead of being synthesized
+    const bool vector_tiles = GetVectorTileStyles() != nullptr;
+
+    // Beyond the provider's max zoom: build from the ancestor, no doomed request
+    const auto source = vector_tiles ? std::nullopt : GetOverzoomSource(coords);
+    if (source) {
+        StartOverzoomFetch(request, *source);
+        return;
+    }
 
+    // Step 1: Check cache
     if (cache_) {
-        cached_data = cache_->Get(coords);
-        cache_hit = cached_data.has_value();
-        if (cache_hit) {
+        auto cached_data = cache_->Get(coords);
+        if (cached_data.has_value()) {
             spdlog::trace("Cache hit for tile {}", coords.GetKey());
+            ScheduleDecode(request, std::make_shared<TileData>(std::move(*cached_data)), false);
+            return;
         }
     }
 
-    TileData tile_data;
-    if (cache_hit) {
-        tile_data = std::move(*cached_data);
-    } else {
-        tile_data.metadata.coordinates = coords;
+    // Zooming out over cached children: build the parent from them
+    if (!vector_tiles && TryStartPyramidBuild(request)) {
+        return;
     }
 
-    // Step 2: Load from network if cache miss
-    if (!cache_hit) {
-        spdlog::trace("Cache miss for tile {}, loading from network", coords.GetKey());
+    // Step 2: Start async download on cache miss
+    StartDownload(request, false);
+}
+
+void TileLoadWorkerPool::StartDownload(const TileLoadRequest& request, bool has_preview) {
+    const auto& coords = request.coords;
+    spdlog::trace("Cache miss for tile {}, loading from network", coords.GetKey());
 
-        // Use loader to download tile
-        auto load_result = loader_->LoadTile(coords, "");  // Empty provider = default
+    if (!BeginDownload(coords)) {
+        TileLoadResult cancelled;
+        cancelled.coordinates = coords;
+        cancelled.error_message = "Load cancelled";
+        OnFetchComplete(request, cancelled, has_preview);
+        return;
+    }
 
-        if (!load_result.success) {
-            spdlog::warn("Failed to load tile {}: {}", coords.GetKey(), load_result.error_message);
-            // Enqueue an empty command so ProcessUploads sees the failure and
-            // resets the tile from Loading back to NotLoaded (via its existing
-            // upload-failed path). Without this the tile stays Loading forever.
-            upload_queue_->Push(std::make_unique<GLUploadCommand>(coords));
-            return;
+    try {
+        // Returned future is not needed: completion arrives via the callback.
+        // A download already in flight for this tile (another view, a
+        // prefetcher) is joined rather than repeated.
+        loader_->LoadTileAsync(coords,
+            [this, request, has_preview](const TileLoadResult& result) {
+                EndDownload(request.coords);
+                OnFetchComplete(request, result, has_preview);
+            },
+            GetProviderName());
+    } catch (const std::exception& e) {
+        spdlog::warn("Failed to start load for tile {}: {}", coords.GetKey(), e.what());
+        EndDownload(coords);
+        if (has_preview) {
+            FinishTrace(request, TileLoadOutcome::FAILED);
+            FinishFetch(request);
+        } else {
+            FailFetch(request);
         }
+    }
+}
 
-        if (!load_result.tile_data) {
-            spdlog::warn("Loaded tile {} but data is null", coords.GetKey());
-            upload_queue_->Push(std::make_unique<GLUploadCommand>(coords));
-            return;
-        }
-        tile_data = *load_result.tile_data;
+void TileLoadWorkerPool::OnFetchComplete(const TileLoadRequest& request,
+                                         const TileLoadResult& result,
+                                         bool has_preview) {
+    const auto& coords = request.coords;
+
+    // The parent built from its children stays on screen
+    if (has_preview && (!result.success || !result.tile_data)) {
+        spdlog::debug("Keeping tile {} built from children: {}",
+                      coords.GetKey(), result.error_message);
+        FinishTrace(request, TileLoadOutcome::FAILED);
+        FinishFetch(request);
+        return;
+    }
+
+    if (!result.success) {
+        spdlog::warn("Failed to load tile {}: {}", coords.GetKey(), result.error_message);
+        FailFetch(request);
+        return;
+    }
+
+    if (!result.tile_data) {
+        spdlog::warn("Loaded tile {} but data is null", coords.GetKey());
+        FailFetch(request);
+        return;
+    }
+
+    // Copy: the loader may share this TileData with other consumers
+    ScheduleDecode(request, std::make_shared<TileData>(*result.tile_data), true);
+}
+
+void TileLoadWorkerPool::ScheduleDecode(const TileLoadRequest& request,
+                                        std::shared_ptr<TileData> tile_data,
+                                        bool from_network) {
+    MarkFetched(request, from_network);
+    const bool submitted = decode_pool_->Submit(
+        [this, request, tile_data = std::move(tile_data), from_network]() mutable {
+            DecodeAndQueue(request, std::move(tile_data), from_network);
+        });
+
+    if (!submitted) {
+        FailFetch(request);
+        return;
+    }
+
+    ReleaseFetchSlot();
+}
 
+void TileLoadWorkerPool::FailFetch(const TileLoadRequest& request) {
+    PushFailedUpload(request);
+    FinishRequest(request.coords);
+    ReleaseFetchSlot();
+}
+
+void TileLoadWorkerPool::PushFailedUpload(const TileLoadRequest& request) {
+    // Enqueue an empty command so ProcessUploads sees the failure and
+    // resets the tile from Loading back to NotLoaded (via its existing
+    // upload-failed path). Without this the tile stays Loading forever.
+    // Never blocks: failures are also reported from the loader's I/O thread.
+    auto cmd = buffer_pool_->AcquireCommand(request.coords);
+    cmd->trace = request.trace;
+    upload_queue_->TryPush(std::move(cmd));
+}
+
+void TileLoadWorkerPool::FinishTrace(const TileLoadRequest& request, TileLoadOutcome outcome) {
+    if (!request.trace) {
+        return;
+    }
+    std::shared_ptr<TileLoadTracer> tracer;
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        tracer = tracer_;
+    }
+    if (tracer) {
+        tracer->Finish(*request.trace, outcome);
+    }
+}
+
+void TileLoadWorkerPool::FinishFetch(const TileLoadRequest& request) {
+    if (request.on_complete) {
+        request.on_complete(request.coords);
+    }
+    FinishRequest(request.coords);
+    ReleaseFetchSlot();
+}
+
+void TileLoadWorkerPool::ReleaseFetchSlot() {
+    // Dispatcher and Shutdown() both wait on queue_cv_. Notify under the
+    // lock: once the count reaches zero Shutdown() may return and the pool
+    // be destroyed, so nothing here may touch it after unlocking.
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    --in_flight_fetches_;
+    queue_cv_.notify_all();
+}
+
+bool TileLoadWorkerPool::BeginDownload(const TileCoordinates& coords) {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (cancel_downloads_) {
+        return false;
+    }
+    ++downloads_[coords];
+    return true;
+}
+
+void TileLoadWorkerPool::EndDownload(const TileCoordinates& coords) {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    const auto it = downloads_.find(coords);
+    if (it != downloads_.end() && --it->second == 0) {
+        downloads_.erase(it);
+    }
+}
+
+void TileLoadWorkerPool::FinishRequest(const TileCoordinates& coords) {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    in_flight_.erase(coords);
+}
+
+void TileLoadWorkerPool::DecodeAndQueue(const TileLoadRequest& request,
+                                        std::shared_ptr<TileData> tile_data,
+                                        bool from_network) {
+    if (from_network) {
         // TODO: hardcoded 'loaded', basically we are loaded, but it is weird
         // Think about another loading indication
         // E.g. separated from disk/network loading, because now we have 'bool success' (http status) and 'bool loaded'
-        tile_data.loaded = true;
+        tile_data->loaded = true;
 
         // Put in cache for future use
-        if (cache_ && tile_data.loaded) {
-            cache_->Put(tile_data);
+        if (cache_ && tile_data->loaded) {
+            cache_->Put(*tile_data);
         }
     }
 
-    // Step 3: Decode image data
-    if (!DecodeImage(tile_data)) {
-        spdlog::warn("Failed to decode image for tile {}", coords.GetKey());
-        // Enqueue an empty command so ProcessUploads resets the tile state.
-        upload_queue_->Push(std::make_unique<GLUploadCommand>(coords));
+    if (const auto styles = GetVectorTileStyles()) {
+        TessellateAndQueue(request, *tile_data, *styles);
+        return;
+    }
+
+    StageAndQueue(request, [this, &tile_data](PixelSlotHandle slot, GLUploadCommand& cmd) {
+        return DecodeImage(*tile_data, slot, cmd);
+    });
+}
+
+void TileLoadWorkerPool::TessellateAndQueue(const TileLoadRequest& request,
+                                            const TileData& tile_data,
+                                            const std::vector<VectorTileStyle>& styles) {
+    const auto& coords = request.coords;
+    const auto tile = DecodeMvtTile(tile_data.data);
+    if (!tile) {
+        spdlog::warn("Failed to decode vector tile {}", coords.GetKey());
+        PushFailedUpload(request);
+        FinishRequest(coords);
         return;
     }
+    MarkStage(request, TileLoadStage::DECODED);
 
-    // Step 4: Create GL upload command
-    auto upload_cmd = std::make_unique<GLUploadCommand>();
-    upload_cmd->coords = coords;
-    upload_cmd->pixel_data = std::move(tile_data.data);
-    upload_cmd->width = tile_data.width;
-    upload_cmd->height = tile_data.height;
-    upload_cmd->channels = tile_data.channels;
+    auto mesh = std::make_shared<VectorTileMesh>(TessellateVectorTile(*tile, styles));
+    MarkStage(request, TileLoadStage::STAGED);
 
-    // Step 5: Push to GL upload queue
+    auto upload_cmd = buffer_pool_->AcquireCommand(coords);
+    upload_cmd->mesh = std::move(mesh);
+    upload_cmd->trace = request.trace;
     upload_queue_->Push(std::move(upload_cmd));
 
+    if (request.on_complete) {
+        request.on_complete(coords);
+    }
+    FinishRequest(coords);
+}
+
+void TileLoadWorkerPool::StageAndQueue(
+    const TileLoadRequest& request,
+    const std::function<bool(PixelSlotHandle, GLUploadCommand&)>& fill) {
+    const auto& coords = request.coords;
+
+    if (!StageUpload(request, fill)) {
+        PushFailedUpload(request);
+        FinishRequest(coords);
+        return;
+    }
+
     // Step 6: Execute callback if provided
     if (request.on_complete) {
         request.on_complete(coords);
     }
 
+    FinishRequest(coords);
+
     spdlog::trace("Tile {} loaded, decoded, and queued for upload", coords.GetKey());
 }
 
-bool TileLoadWorkerPool::DecodeImage(TileData& tile_data) {
-    // If image is already decoded (width/height set), skip
+bool TileLoadWorkerPool::StageUpload(
+    const TileLoadRequest& request,
+    const std::function<bool(PixelSlotHandle, GLUploadCommand&)>& fill) {
+    const auto& coords = request.coords;
+    // Step 3: Take a staging slot; the GL thread frees them as uploads retire
+    const PixelSlotHandle slot = pixel_ring_->Acquire(kSlotAcquireTimeout);
+    if (!slot.IsValid()) {
+        spdlog::debug("No free pixel slot for tile {}, will be re-requested", coords.GetKey());
+        return false;
+    }
+
+    // Step 4: Decode image data directly into the slot
+    auto upload_cmd = buffer_pool_->AcquireCommand(coords);
+    if (!fill(slot, *upload_cmd)) {
+        spdlog::warn("Failed to decode image for tile {}", coords.GetKey());
+        pixel_ring_->Release(slot);
+        buffer_pool_->ReleaseCommand(std::move(upload_cmd));
+        return false;
+    }
+    MarkStage(request, TileLoadStage::DECODED);
+
+    // Downsample the mip chain next to the tile, then block-compress it in
+    // place, so the GL thread only uploads
+    const TileTextureFormat format = upload_format_.load();
+    const std::uint32_t levels = upload_mip_levels_.load();
+    if (levels > 1 || format == TileTextureFormat::BC1) {
+        std::uint8_t* data = pixel_ring_->GetSlotData(slot);
+        if (upload_cmd->width != upload_cmd->height ||
+            !TileMipChain::Build(data, upload_cmd->width, upload_cmd->channels, levels, format,
+                                 pixel_ring_->GetSlotSize())) {
+            spdlog::warn("Failed to build {} mip levels for tile {} ({}x{}x{})", levels,
+                         coords.GetKey(), upload_cmd->width, upload_cmd->height,
+                         upload_cmd->channels);
+            pixel_ring_->Release(slot);
+            buffer_pool_->ReleaseCommand(std::move(upload_cmd));
+            return false;
+        }
+        upload_cmd->format = format;
+        upload_cmd->mip_levels = levels;
+    }
+    upload_cmd->slot = slot;
+    upload_cmd->trace = request.trace;
+    MarkStage(request, TileLoadStage::STAGED);
+
+    // Step 5: Push to GL upload queue (waits while the queue is full)
+    if (!upload_queue_->Push(std::move(upload_cmd))) {
+        // Queue closed during shutdown: nobody will upload from the slot
+        pixel_ring_->Release(slot);
+    }
+    return true;
+}
+
+void TileLoadWorkerPool::SetVectorTileStyles(
+    std::shared_ptr<const std::vector<VectorTileStyle>> styles) {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    vector_styles_ = std::move(styles);
+}
+
+std::shared_ptr<const std::vector<VectorTileStyle>> TileLoadWorkerPool::GetVectorTileStyles() const {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    return vector_styles_;
+}
+
+void TileLoadWorkerPool::SetProviderName(const std::string& name) {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        provider_name_ = name;
+    }
+    overzoom_->Clear();
+}
+
+std::string TileLoadWorkerPool::GetProviderName() const {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    return provider_name_;
+}
+
+void TileLoadWorkerPool::SetPyramidConfig(const TilePyramidConfig& config) {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    pyramid_config_ = config;
+}
+
+TilePyramidConfig TileLoadWorkerPool::GetPyramidConfig() const {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    return pyramid_config_;
+}
+
+bool TileLoadWorkerPool::TryStartPyramidBuild(const TileLoadRequest& request) {
+    const TilePyramidConfig config = GetPyramidConfig();
+    if (!config.enabled || !cache_) {
+        return false;
+    }
+
+    // Cheap presence check first: most tiles have no cached children
+    const auto children = request.coords.GetChildren();
+    for (const TileCoordinates& child : children) {
+        if (!cache_->Contains(child)) {
+            return false;
+        }
+    }
+
+    std::array<std::shared_ptr<TileData>, 4> child_data;
+    for (std::size_t i = 0; i < children.size(); ++i) {
+        auto cached = cache_->Get(children[i]);
+        if (!cached.has_value()) {
+            return false;  // Evicted since Contains()
+        }
+        child_data[i] = std::make_shared<TileData>(std::move(*cached));
+    }
+
+    const bool then_fetch = !config.skip_network_fetch;
+    MarkFetched(request, false);
+    const bool submitted = decode_pool_->Submit(
+        [this, request, child_data = std::move(child_data), then_fetch]() {
+            BuildParentAndQueue(request, child_data, then_fetch);
+        });
+    if (!submitted) {
+        FailFetch(request);
+    }
+    return true;
+}
+
+void TileLoadWorkerPool::BuildParentAndQueue(
+    const TileLoadRequest& request,
+    const std::array<std::shared_ptr<TileData>, 4>& child_data,
+    bool then_fetch) {
+    // Children are scratch: their pixels go back to the pool once the
+    // parent is built, whichever way this function returns
+    struct PooledImages {
+        TileBufferPool& pool;
+        std::array<DecodedImage, 4> images;
+        ~PooledImages() {
+            for (DecodedImage& image : images) {
+                pool.ReleaseBuffer(std::move(image.pixels));
+            }
+        }
+    } pooled{*buffer_pool_, {}};
+    auto& images = pooled.images;
+
+    TilePyramidBuilder::Children children{};
+    bool decoded = true;
+    for (std::size_t i = 0; i < images.size() && decoded; ++i) {
+        images[i].pixels = buffer_pool_->AcquireBuffer(pixel_ring_->GetSlotSize());
+        decoded = DecodeToImage(*child_data[i], images[i]);
+        children[i] = &images[i];
+    }
+
+    const auto fill = [this, &children](PixelSlotHandle slot, GLUploadCommand& cmd) {
+        if (!TilePyramidBuilder::BuildParent(children, pixel_ring_->GetSlotData(slot),
+                                             pixel_ring_->GetSlotSize())) {
+            return false;
+        }
+        cmd.width = children[0]->width;
+        cmd.height = children[0]->height;
+        cmd.channels = children[0]->channels;
+        return true;
+    };
+
+    if (!then_fetch) {
+        // The built parent replaces the download; fall back to it if unusable
+        if (decoded && StageUpload(request, fill)) {
+            pyramid_built_tiles_.fetch_add(1);
+            FinishFetch(request);
+        } else {
+            StartDownload(request, false);
+        }
+        return;
+    }
+
+    // Show the built parent now; the real tile replaces its pool layer later.
+    // The trace stays with the download, the tile the request asked for.
+    TileLoadRequest preview = request;
+    preview.trace = nullptr;
+    const bool has_preview = decoded && StageUpload(preview, fill);
+    if (has_preview) {
+        pyramid_built_tiles_.fetch_add(1);
+    }
+    StartDownload(request, has_preview);
+}
+
+std::optional<TileCoordinates> TileLoadWorkerPool::GetOverzoomSource(
+    const TileCoordinates& coords) const {
+    const TileProvider* provider = loader_->GetProvider(GetProviderName());
+    if (!provider || coords.zoom <= provider->GetMaxZoom()) {
+        return std::nullopt;
+    }
+    return OverzoomTileSynthesizer::GetSourceTile(coords, provider->GetMaxZoom());
+}
+
+void TileLoadWorkerPool::StartOverzoomFetch(const TileLoadRequest& request,
+                                            const TileCoordinates& source) {
+    // Siblings of a recent overzoomed tile crop from the same decoded pixels
+    if (auto image = overzoom_->FindSource(source)) {
+        ScheduleOverzoom(request, source, nullptr, std::move(image), false);
+        return;
+    }
+
+    if (cache_) {
+        auto cached_data = cache_->Get(source);
+        if (cached_data.has_value()) {
+            ScheduleOverzoom(request, source,
+                             std::make_shared<TileData>(std::move(*cached_data)), nullptr, false);
+            return;
+        }
+    }
+
+    spdlog::trace("Overzoomed tile {} needs ancestor {}, loading from network",
+                  request.coords.GetKey(), source.GetKey());
+
+    if (!BeginDownload(source)) {
+        FailFetch(request);
+        return;
+    }
+
+    try {
+        loader_->LoadTileAsync(source,
+            [this, request, source](const TileLoadResult& result) {
+                EndDownload(source);
+                OnOverzoomFetchComplete(request, source, result);
+            },
+            GetProviderName());
+    } catch (const std::exception& e) {
+        spdlog::warn("Failed to start load for ancestor {} of tile {}: {}",
+                     source.GetKey(), request.coords.GetKey(), e.what());
+        EndDownload(source);
+        FailFetch(request);
+    }
+}
+
+void TileLoadWorkerPool::OnOverzoomFetchComplete(const TileLoadRequest& request,
+                                                 const TileCoordinates& source,
+                                                 const TileLoadResult& result) {
+    if (result.success && result.tile_data) {
+        ScheduleOverzoom(request, source, std::make_shared<TileData>(*result.tile_data),
+                         nullptr, true);
+        return;
+    }
+
+    // The provider lacks this ancestor (e.g. sparse coverage): try its parent.
+    // Transient failures were already retried by the loader and end here.
+    const TileProvider* provider = loader_->GetProvider(GetProviderName());
+    const TileCoordinates parent = source.GetParent();
+    const bool can_climb = IsMissingTile(result) && provider &&
+        parent.zoom >= provider->GetMinZoom() &&
+        request.coords.zoom - parent.zoom <= OverzoomTileSynthesizer::kMaxOverzoomLevels;
+    if (can_climb) {
+        spdlog::debug("Ancestor {} of tile {} unavailable, trying {}",
+                      source.GetKey(), request.coords.GetKey(), parent.GetKey());
+        // The next lookup reads the cache: keep it off the loader's I/O thread
+        if (!decode_pool_->Submit([this, request, parent] {
+                StartOverzoomFetch(request, parent);
+            })) {
+            FailFetch(request);
+        }
+        return;
+    }
+
+    spdlog::warn("Failed to load ancestor for overzoomed tile {}: {}",
+                 request.coords.GetKey(), result.error_message);
+    FailFetch(request);
+}
+
+void TileLoadWorkerPool::ScheduleOverzoom(const TileLoadRequest& request,
+                                          const TileCoordinates& source,
+                                          std::shared_ptr<TileData> source_data,
+                                          std::shared_ptr<const DecodedImage> source_image,
+                                          bool from_network) {
+    MarkFetched(request, from_network);
+    const bool submitted = decode_pool_->Submit(
+        [this, request, source, source_data = std::move(source_data),
+         source_image = std::move(source_image), from_network]() mutable {
+            SynthesizeAndQueue(request, source, std::move(source_data),
+                               std::move(source_image), from_network);
+        });
+
+    if (!submitted) {
+        FailFetch(request);
+        return;
+    }
+
+    ReleaseFetchSlot();
+}
+
+void TileLoadWorkerPool::SynthesizeAndQueue(const TileLoadRequest& request,
+                                            const TileCoordinates& source,
+                                            std::shared_ptr<TileData> source_data,
+                                            std::shared_ptr<const DecodedImage> source_image,
+                                            bool from_network) {
+    // The ancestor is a regular tile: cache its bytes like any download
+    if (from_network && source_data && cache_) {
+        source_data->loaded = true;
+        cache_->Put(*source_data);
+    }
+
+    if (!source_image) {
+        auto decoded = std::make_shared<DecodedImage>();
+        if (!source_data || !DecodeToImage(*source_data, *decoded)) {
+            spdlog::warn("Failed to decode ancestor {} of tile {}",
+                         source.GetKey(), request.coords.GetKey());
+            PushFailedUpload(request);
+            FinishRequest(request.coords);
+            return;
+        }
+        overzoom_->AddSource(source, decoded);
+        source_image = std::move(decoded);
+    }
+
+    StageAndQueue(request, [this, &request, &source, &source_image](
+                               PixelSlotHandle slot, GLUploadCommand& cmd) {
+        if (!OverzoomTileSynthesizer::Synthesize(*source_image, source, request.coords,
+                                                 pixel_ring_->GetSlotData(slot),
+                                                 pixel_ring_->GetSlotSize())) {
+            return false;
+        }
+        cmd.width = source_image->width;
+        cmd.height = source_image->height;
+        cmd.channels = source_image->channels;
+        overzoomed_tiles_.fetch_add(1);
+        return true;
+    });
+}
+
+bool TileLoadWorkerPool::DecodeToImage(const TileData& tile_data, DecodedImage& image) {
     if (tile_data.width > 0 && tile_data.height > 0) {
-        spdlog::trace("Image already decoded ({}x{})", tile_data.width, tile_data.height);
+        const std::size_t size = static_cast<std::size_t>(tile_data.width) *
+                                 tile_data.height * tile_data.channels;
+        if (size == 0 || tile_data.data.size() < size) {
+            return false;
+        }
+        image.pixels.assign(tile_data.data.begin(), tile_data.data.begin() + size);
+        image.width = tile_data.width;
+        image.height = tile_data.height;
+        image.channels = tile_data.channels;
+        return true;
+    }
+
+    if (tile_data.data.empty()) {
+        return false;
+    }
+    return decoders_->Decode(tile_data.data.data(), tile_data.data.size(), image);
+}
+
+bool TileLoadWorkerPool::DecodeImage(const TileData& tile_data, PixelSlotHandle slot,
+                                     GLUploadCommand& cmd) {
+    std::uint8_t* dst = pixel_ring_->GetSlotData(slot);
+    const std::size_t capacity = pixel_ring_->GetSlotSize();
+    const std::uint32_t tile_size = upload_tile_size_.load();
+
+    // If image is already decoded (width/height set), only stage the pixels
+    if (tile_data.width > 0 && tile_data.height > 0) {
+        const std::size_t size = static_cast<std::size_t>(tile_data.width) *
+                                 tile_data.height * tile_data.channels;
+        if (tile_size > 0 && tile_data.width > tile_size && size > 0 &&
+            tile_data.data.size() >= size && tile_data.width == tile_data.height) {
+            return ShrinkToTile(tile_data.data.data(), tile_data.width, tile_data.channels,
+                                tile_size, dst, capacity, cmd);
+        }
+        if (size == 0 || tile_data.data.size() < size || size > capacity) {
+            spdlog::warn("Decoded image ({}x{}x{}) does not fit a {} byte slot",
+                         tile_data.width, tile_data.height, tile_data.channels, capacity);
+            return false;
+        }
+        std::memcpy(dst, tile_data.data.data(), size);
+        cmd.width = tile_data.width;
+        cmd.height = tile_data.height;
+        cmd.channels = tile_data.channels;
         return true;
     }
 
@@ -234,48 +894,86 @@ bool TileLoadWorkerPool::DecodeImage(TileData& tile_data) {
         return false;
     }
 
-    // Use stb_image to decode
-    int width = 0;
-    int height = 0;
-    int channels = 0;
-
-    // Decode image, forcing RGBA (4 channels) for GL_RGBA8 texture pool compatibility
-    constexpr int kDesiredChannels = 4;
-    unsigned char* decoded_data = stbi_load_from_memory(
-        tile_data.data.data(),
-        static_cast<int>(tile_data.data.size()),
-        &width,
-        &height,
-        &channels,
-        kDesiredChannels
-    );
-
-    if (!decoded_data) {
-        const char* error = stbi_failure_reason();
-        spdlog::warn("stb_image decode failed: {}", error ? error : "unknown error");
+    // A variant richer than the pool's tiles (@2x) does not fit a slot:
+    // decode it aside and reduce it into the slot
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+    if (tile_size > 0 &&
+        ReadImageSize(tile_data.data.data(), tile_data.data.size(), width, height) &&
+        width > tile_size) {
+        DecodedImage image;
+        image.pixels = buffer_pool_->AcquireBuffer(static_cast<std::size_t>(width) * height * 4);
+        const bool shrunk =
+            decoders_->Decode(tile_data.data.data(), tile_data.data.size(), image) &&
+            image.width == image.height &&
+            ShrinkToTile(image.pixels.data(), image.width, image.channels, tile_size, dst,
+                         capacity, cmd);
+        buffer_pool_->ReleaseBuffer(std::move(image.pixels));
+        return shrunk;
+    }
+
+    // Backend is chosen by format (SIMD backends first, stb_image fallback).
+    // Backends that cannot decode in place stage through a pooled buffer.
+    DecodedImage image;
+    image.pixels = buffer_pool_->AcquireBuffer(capacity);
+    const bool decoded = decoders_->DecodeInto(tile_data.data.data(), tile_data.data.size(),
+                                               dst, capacity, image);
+    buffer_pool_->ReleaseBuffer(std::move(image.pixels));
+    if (!decoded) {
         return false;
     }
 
-    // stbi returns original channel count in 'channels' even when forcing,
-    // so override to the actual output channel count
-    channels = kDesiredChannels;
+    cmd.width = image.width;
+    cmd.height = image.height;
+    cmd.channels = image.channels;
 
-    // Update tile_data with decoded info
-    tile_data.width = static_cast<std::uint32_t>(width);
-    tile_data.height = static_cast<std::uint32_t>(height);
-    tile_data.channels = static_cast<std::uint8_t>(channels);
+    spdlog::trace("Decoded image: {}x{}, {} channels into slot {}",
+                  cmd.width, cmd.height, cmd.channels, slot.index);
 
-    // Copy decoded data to tile_data
-    const std::size_t decoded_size = width * height * channels;
-    tile_data.data.assign(decoded_data, decoded_data + decoded_size);
+    return true;
+}
 
-    // Free stb_image memory
-    stbi_image_free(decoded_data);
+bool TileLoadWorkerPool::ShrinkToTile(const std::uint8_t* src, std::uint32_t size,
+                                      std::uint8_t channels, std::uint32_t tile_size,
+                                      std::uint8_t* dst, std::size_t capacity,
+                                      GLUploadCommand& cmd) {
+    const std::size_t tile_bytes = static_cast<std::size_t>(tile_size) * tile_size * channels;
+    if (size % tile_size != 0 || !std::has_single_bit(size / tile_size) || tile_bytes > capacity) {
+        spdlog::warn("Cannot reduce a {}x{} image to a {}px tile", size, size, tile_size);
+        return false;
+    }
 
-    spdlog::trace("Decoded image: {}x{}, {} channels, {} bytes",
-                  width, height, channels, decoded_size);
+    // Each 2x2 box pass halves the image; the last one writes into the slot
+    std::vector<std::uint8_t> scratch[2];
+    const std::uint8_t* level = src;
+    for (std::uint32_t level_size = size; level_size > tile_size; level_size /= 2) {
+        std::uint8_t* out = dst;
+        if (level_size / 2 > tile_size) {
+            std::vector<std::uint8_t>& next = scratch[level == scratch[0].data() ? 1 : 0];
+            const std::size_t half = level_size / 2;
+            if (next.empty()) {
+                next = buffer_pool_->AcquireBuffer(half * half * channels);
+            }
+            next.resize(half * half * channels);
+            out = next.data();
+        }
+        TileMipChain::Downsample(level, level_size, channels, out);
+        level = out;
+    }
+    for (std::vector<std::uint8_t>& buffer : scratch) {
+        if (buffer.capacity() > 0) {
+            buffer_pool_->ReleaseBuffer(std::move(buffer));
+        }
+    }
 
+    cmd.width = tile_size;
+    cmd.height = tile_size;
+    cmd.channels = channels;
     return true;
 }
 
+ImageDecodeStats TileLoadWorkerPool::GetDecodeStats() const {
+    return decoders_->GetStats();
+}
+
 } // namespace earth_map
@@ -0,0 +1,105 @@
+/**
+ * @file tile_mip_chain.cpp
+ * @brief Implementation of per-tile mip chain generation
+ */
+
+#include <earth_map/renderer/texture_atlas/tile_mip_chain.h>
+#include <algorithm>
+#include <bit>
+
+namespace earth_map {
+
+std::uint32_t TileMipChain::GetMaxLevels(TileTextureFormat format, std::uint32_t size) {
+    if (!std::has_single_bit(size)) {
+        return 1;
+    }
+    if (format == TileTextureFormat::BC1) {
+        if (size < TileBlockCompressor::kBlockSize) {
+            return 1;
+        }
+        return static_cast<std::uint32_t>(std::bit_width(size / TileBlockCompressor::kBlockSize));
+    }
+    return static_cast<std::uint32_t>(std::bit_width(size));
+}
+
+std::size_t TileMipChain::GetLevelOffset(TileTextureFormat format, std::uint32_t size,
+                                         std::uint32_t level) {
+    std::size_t offset = 0;
+    for (std::uint32_t l = 0; l < level; ++l) {
+        const std::uint32_t level_size = std::max<std::uint32_t>(1, size >> l);
+        offset += TileBlockCompressor::GetEncodedSize(format, level_size, level_size);
+    }
+    return offset;
+}
+
+bool TileMipChain::Build(std::uint8_t* data, std::uint32_t size, std::uint8_t channels,
+                         std::uint32_t levels, TileTextureFormat format, std::size_t capacity) {
+    if (data == nullptr || levels == 0 || levels > GetMaxLevels(format, size)) {
+        return false;
+    }
+    if (channels != 4 && !(channels == 3 && format == TileTextureFormat::BC1)) {
+        return false;
+    }
+
+    // Uncompressed chain, back to back
+    std::size_t unpacked_size = 0;
+    for (std::uint32_t l = 0; l < levels; ++l) {
+        const std::size_t level_size = size >> l;
+        unpacked_size += level_size * level_size * channels;
+    }
+    if (unpacked_size > capacity) {
+        return false;
+    }
+
+    std::size_t offset = static_cast<std::size_t>(size) * size * channels;
+    const std::uint8_t* src = data;
+    for (std::uint32_t l = 1; l < levels; ++l) {
+        const std::uint32_t src_size = size >> (l - 1);
+        std::uint8_t* dst = data + offset;
+        Downsample(src, src_size, channels, dst);
+        src = dst;
+        offset += static_cast<std::size_t>(src_size / 2) * (src_size / 2) * channels;
+    }
+
+    if (format != TileTextureFormat::BC1) {
+        return true;
+    }
+
+    // Level 0 compresses in place; every later level's blocks end before its
+    // own pixels start, since a packed level is 1/8 (1/6 for RGB) of its pixels
+    std::size_t src_offset = 0;
+    std::size_t dst_offset = 0;
+    for (std::uint32_t l = 0; l < levels; ++l) {
+        const std::uint32_t level_size = size >> l;
+        if (!TileBlockCompressor::CompressBC1(data + src_offset, level_size, level_size, channels,
+                                              data + dst_offset, capacity - dst_offset)) {
+            return false;
+        }
+        src_offset += static_cast<std::size_t>(level_size) * level_size * channels;
+        dst_offset += TileBlockCompressor::GetEncodedSize(format, level_size, level_size);
+    }
+    return true;
+}
+
+void TileMipChain::Downsample(const std::uint8_t* src, std::uint32_t size, std::uint8_t channels,
+                              std::uint8_t* dst) {
+    const std::uint32_t half = size / 2;
+    const std::size_t src_stride = static_cast<std::size_t>(size) * channels;
+    const std::size_t dst_stride = static_cast<std::size_t>(half) * channels;
+
+    for (std::uint32_t y = 0; y < half; ++y) {
+        const std::uint8_t* row0 = src + (2 * y) * src_stride;
+        const std::uint8_t* row1 = row0 + src_stride;
+        std::uint8_t* out = dst + y * dst_stride;
+        for (std::uint32_t x = 0; x < half; ++x) {
+            const std::uint8_t* top = row0 + 2 * x * channels;
+            const std::uint8_t* bottom = row1 + 2 * x * channels;
+            for (std::uint8_t c = 0; c < channels; ++c) {
+                const unsigned sum = top[c] + top[c + channels] + bottom[c] + bottom[c + channels];
+                out[x * channels + c] = static_cast<std::uint8_t>((sum + 2) / 4);
+            }
+        }
+    }
+}
+
+} // namespace earth_map
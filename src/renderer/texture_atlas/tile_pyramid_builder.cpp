@@ -0,0 +1,70 @@
+/**
+ * @file tile_pyramid_builder.cpp
+ * @brief Implementation of parent-from-children downsampling
+ */
+
+#include <earth_map/renderer/texture_atlas/tile_pyramid_builder.h>
+
+namespace earth_map {
+
+namespace {
+
+/// Child pixels averaged into one parent pixel (2x2 box filter)
+constexpr std::uint32_t kBoxSamples = 4;
+
+} // namespace
+
+bool TilePyramidBuilder::BuildParent(const Children& children, std::uint8_t* dst,
+                                     std::size_t capacity) {
+    if (dst == nullptr || children[0] == nullptr) {
+        return false;
+    }
+
+    const std::uint32_t width = children[0]->width;
+    const std::uint32_t height = children[0]->height;
+    const std::uint32_t channels = children[0]->channels;
+    const std::size_t size = static_cast<std::size_t>(width) * height * channels;
+    if (size == 0 || size > capacity || width % 2 != 0 || height % 2 != 0) {
+        return false;
+    }
+
+    for (const DecodedImage* child : children) {
+        if (child == nullptr || child->width != width || child->height != height ||
+            child->channels != channels || child->pixels.size() < size) {
+            return false;
+        }
+    }
+
+    const std::uint32_t half_width = width / 2;
+    const std::uint32_t half_height = height / 2;
+    const std::size_t row_stride = static_cast<std::size_t>(width) * channels;
+
+    for (std::uint32_t quadrant = 0; quadrant < children.size(); ++quadrant) {
+        const std::uint8_t* src = children[quadrant]->pixels.data();
+        const std::uint32_t origin_x = (quadrant % 2) * half_width;
+        const std::uint32_t origin_y = (quadrant / 2) * half_height;
+
+        for (std::uint32_t y = 0; y < half_height; ++y) {
+            const std::uint8_t* row0 = src + static_cast<std::size_t>(2 * y) * row_stride;
+            const std::uint8_t* row1 = row0 + row_stride;
+            std::uint8_t* out = dst + (origin_y + y) * row_stride +
+                                static_cast<std::size_t>(origin_x) * channels;
+
+            for (std::uint32_t x = 0; x < half_width; ++x) {
+                const std::size_t left = static_cast<std::size_t>(2 * x) * channels;
+                const std::size_t right = left + channels;
+                for (std::uint32_t c = 0; c < channels; ++c) {
+                    const std::uint32_t sum = row0[left + c] + row0[right + c] +
+                                              row1[left + c] + row1[right + c];
+                    // Round to nearest
+                    out[static_cast<std::size_t>(x) * channels + c] =
+                        static_cast<std::uint8_t>((sum + kBoxSamples / 2) / kBoxSamples);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+} // namespace earth_map
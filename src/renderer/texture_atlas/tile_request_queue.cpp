@@ -0,0 +1,185 @@
+/**
+ * @file tile_request_queue.cpp
+ * @brief Implementation of the indexed tile request priority queue
+ */
+
+#include <earth_map/renderer/texture_atlas/tile_request_queue.h>
+#include <utility>
+
+namespace earth_map {
+
+bool TileRequestQueue::Push(TileLoadRequest request) {
+    auto it = index_.find(request.coords);
+    if (it != index_.end()) {
+        const std::size_t slot = it->second;
+        Entry& entry = heap_[slot];
+        entry.request.priority = request.priority;
+        entry.request.generation = request.generation;
+        if (request.on_complete) {
+            entry.request.on_complete = std::move(request.on_complete);
+        }
+        if (request.trace) {
+            entry.request.trace = std::move(request.trace);
+        }
+        SiftUp(slot);
+        SiftDown(index_[entry.request.coords]);
+        return false;
+    }
+
+    const TileCoordinates coords = request.coords;
+    heap_.push_back(Entry{std::move(request), next_sequence_++});
+    index_[coords] = heap_.size() - 1;
+    SiftUp(heap_.size() - 1);
+    return true;
+}
+
+std::optional<TileLoadRequest> TileRequestQueue::Pop() {
+    if (heap_.empty()) {
+        return std::nullopt;
+    }
+    return RemoveAt(0);
+}
+
+bool TileRequestQueue::UpdatePriority(const TileCoordinates& coords, int priority) {
+    auto it = index_.find(coords);
+    if (it == index_.end()) {
+        return false;
+    }
+
+    const std::size_t slot = it->second;
+    heap_[slot].request.priority = priority;
+    SiftUp(slot);
+    SiftDown(index_[coords]);
+    return true;
+}
+
+bool TileRequestQueue::Cancel(const TileCoordinates& coords) {
+    return Take(coords).has_value();
+}
+
+std::optional<TileLoadRequest> TileRequestQueue::Take(const TileCoordinates& coords) {
+    auto it = index_.find(coords);
+    if (it == index_.end()) {
+        return std::nullopt;
+    }
+
+    return RemoveAt(it->second);
+}
+
+std::vector<TileCoordinates> TileRequestQueue::DropOlderThan(std::uint64_t generation) {
+    std::vector<TileLoadRequest> requests;
+    DropOlderThan(generation, requests);
+
+    std::vector<TileCoordinates> dropped;
+    dropped.reserve(requests.size());
+    for (const TileLoadRequest& request : requests) {
+        dropped.push_back(request.coords);
+    }
+    return dropped;
+}
+
+void TileRequestQueue::DropOlderThan(std::uint64_t generation,
+                                     std::vector<TileLoadRequest>& dropped) {
+    const std::size_t dropped_before = dropped.size();
+
+    // Partition survivors in place, then rebuild the heap once: O(n)
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < heap_.size(); ++i) {
+        if (heap_[i].request.generation < generation) {
+            index_.erase(heap_[i].request.coords);
+            dropped.push_back(std::move(heap_[i].request));
+            continue;
+        }
+        if (kept != i) {
+            heap_[kept] = std::move(heap_[i]);
+        }
+        ++kept;
+    }
+
+    if (dropped.size() == dropped_before) {
+        return;
+    }
+
+    heap_.resize(kept);
+    for (std::size_t i = 0; i < heap_.size(); ++i) {
+        index_[heap_[i].request.coords] = i;
+    }
+    for (std::size_t i = heap_.size() / 2; i-- > 0;) {
+        SiftDown(i);
+    }
+}
+
+void TileRequestQueue::Clear() {
+    heap_.clear();
+    index_.clear();
+}
+
+bool TileRequestQueue::Before(const Entry& a, const Entry& b) {
+    if (a.request.priority != b.request.priority) {
+        return a.request.priority < b.request.priority;
+    }
+    if (a.request.generation != b.request.generation) {
+        return a.request.generation > b.request.generation;
+    }
+    return a.sequence < b.sequence;
+}
+
+void TileRequestQueue::SiftUp(std::size_t slot) {
+    while (slot > 0) {
+        const std::size_t parent = (slot - 1) / 2;
+        if (!Before(heap_[slot], heap_[parent])) {
+            break;
+        }
+        Swap(slot, parent);
+        slot = parent;
+    }
+}
+
+void TileRequestQueue::SiftDown(std::size_t slot) {
+    const std::size_t size = heap_.size();
+    while (true) {
+        const std::size_t left = slot * 2 + 1;
+        const std::size_t right = left + 1;
+        std::size_t best = slot;
+
+        if (left < size && Before(heap_[left], heap_[best])) {
+            best = left;
+        }
+        if (right < size && Before(heap_[right], heap_[best])) {
+            best = right;
+        }
+        if (best == slot) {
+            break;
+        }
+        Swap(slot, best);
+        slot = best;
+    }
+}
+
+void TileRequestQueue::Swap(std::size_t a, std::size_t b) {
+    std::swap(heap_[a], heap_[b]);
+    index_[heap_[a].request.coords] = a;
+    index_[heap_[b].request.coords] = b;
+}
+
+TileLoadRequest TileRequestQueue::RemoveAt(std::size_t slot) {
+    const std::size_t last = heap_.size() - 1;
+    if (slot != last) {
+        Swap(slot, last);
+    }
+
+    TileLoadRequest request = std::move(heap_.back().request);
+    heap_.pop_back();
+    index_.erase(request.coords);
+
+    if (slot < heap_.size()) {
+        // The former last entry now sits at slot and may need to move either way
+        const TileCoordinates moved = heap_[slot].request.coords;
+        SiftUp(slot);
+        SiftDown(index_[moved]);
+    }
+
+    return request;
+}
+
+} // namespace earth_map
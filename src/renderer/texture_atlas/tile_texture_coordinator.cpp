@@ -5,6 +5,12 @@
 
 #include <earth_map/renderer/texture_atlas/tile_texture_coordinator.h>
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <thread>
 
 namespace earth_map {
 
@@ -12,70 +18,240 @@ TileTextureCoordinator::TileTextureCoordinator(
     std::shared_ptr<TileCache> cache,
     std::shared_ptr<TileLoader> loader,
     int num_worker_threads,
-    bool skip_gl_init)
+    bool skip_gl_init,
+    TileTextureFormat pool_format,
+    bool mipmapped_pool)
+    : tracer_(std::make_shared<TileLoadTracer>())
+    , shared_pool_(std::make_shared<SharedPool>())
+    , tile_pool_(nullptr)
+    , pool_mutex_(shared_pool_->mutex)
+    , skip_gl_init_(skip_gl_init)
 {
     if (!loader) {
         spdlog::error("TileTextureCoordinator: null loader provided");
         throw std::invalid_argument("TileLoader cannot be null");
     }
 
-    // Create upload queue (shared between workers and GL thread)
-    upload_queue_ = std::make_shared<GLUploadQueue>();
-
-    // Create tile texture pool (replaces atlas for tile rendering)
-    tile_pool_ = std::make_unique<TileTexturePool>(
+    // Create tile texture pool (replaces atlas for tile rendering). It can
+    // grow to every layer an indirection entry addresses; the VRAM budget
+    // decides how far it does.
+    shared_pool_->pool = std::make_unique<TileTexturePool>(
         kDefaultTileSize,
-        kDefaultMaxPoolLayers,
-        skip_gl_init
+        IndirectionTextureManager::kMaxLayerIndex + 1u,
+        skip_gl_init,
+        pool_format,
+        // The pool clamps the chain to what its (possibly fallback) format allows
+        mipmapped_pool ? TileMipChain::GetMaxLevels(TileTextureFormat::RGBA8, kDefaultTileSize)
+                       : 1u
     );
+    tile_pool_ = shared_pool_->pool.get();
+    shared_pool_->users.push_back(this);
 
-    if (tile_pool_->GetMaxLayers() >= IndirectionTextureManager::kInvalidLayer) {
+    if (tile_pool_->GetMaxLayers() > IndirectionTextureManager::kMaxLayerIndex + 1u) {
         throw std::invalid_argument(
-            "Pool max_layers must be less than indirection sentinel value (0xFFFF)");
+            "Pool max_layers exceeds the layers a resolved indirection entry can address (8192)");
     }
 
+    if (skip_gl_init) {
+        tile_pool_->SetBudgetLayers(kDefaultMaxPoolLayers);
+    } else {
+        SetVramBudget(0);
+    }
+
+    InitializePipeline(std::move(cache), std::move(loader), num_worker_threads);
+
+    spdlog::info("TileTextureCoordinator initialized with {} decode threads (tile pool + indirection)",
+                 worker_pool_->GetDecodeThreadCount());
+}
+
+TileTextureCoordinator::TileTextureCoordinator(
+    TileTextureCoordinator& base,
+    std::shared_ptr<TileCache> cache,
+    std::shared_ptr<TileLoader> loader,
+    int num_worker_threads)
+    : tracer_(std::make_shared<TileLoadTracer>())
+    , shared_pool_(base.shared_pool_)
+    , tile_pool_(base.tile_pool_)
+    , pool_mutex_(shared_pool_->mutex)
+    , pool_namespace_(static_cast<std::int32_t>(shared_pool_->users.size()))
+    , skip_gl_init_(base.skip_gl_init_)
+{
+    ancestor_levels_.store(base.ancestor_levels_.load());
+    InitializePipeline(std::move(cache), std::move(loader), num_worker_threads);
+    shared_pool_->users.push_back(this);
+}
+
+void TileTextureCoordinator::InitializePipeline(
+    std::shared_ptr<TileCache> cache,
+    std::shared_ptr<TileLoader> loader,
+    int num_worker_threads)
+{
+    // Create upload queue (shared between workers and GL thread)
+    upload_queue_ = std::make_shared<GLUploadQueue>();
+
     // Create indirection texture manager
-    indirection_manager_ = std::make_unique<IndirectionTextureManager>(skip_gl_init);
+    indirection_manager_ = std::make_unique<IndirectionTextureManager>(skip_gl_init_);
+
+    // Create upload scheduler (GL timer queries unless GL is skipped)
+    upload_scheduler_ = std::make_unique<TileUploadScheduler>(
+        TileUploadSchedulerConfig{}, skip_gl_init_);
+
+    // Create staging ring (decode threads write, GL thread uploads from it).
+    // Slots hold the tile's uncompressed mip chain while it is built.
+    pixel_ring_ = std::make_shared<PixelBufferRing>(
+        PixelBufferRing::kDefaultSlotCount,
+        TileMipChain::GetLevelOffset(TileTextureFormat::RGBA8, kDefaultTileSize,
+                                     tile_pool_->GetMipLevels()),
+        skip_gl_init_
+    );
 
     // Create worker pool
     worker_pool_ = std::make_unique<TileLoadWorkerPool>(
-        cache,
-        loader,
+        std::move(cache),
+        std::move(loader),
         upload_queue_,
-        num_worker_threads
+        num_worker_threads,
+        0,
+        pixel_ring_
     );
 
-    spdlog::info("TileTextureCoordinator initialized with {} workers (tile pool + indirection)",
-                 num_worker_threads);
+    // Decode threads transcode (and reduce @2x variants) to what the pool holds
+    worker_pool_->SetUploadFormat(tile_pool_->GetFormat());
+    worker_pool_->SetUploadMipLevels(tile_pool_->GetMipLevels());
+    worker_pool_->SetUploadTileSize(tile_pool_->GetTileSize());
+    worker_pool_->SetTracer(tracer_);
+
+    // Uploaded commands go back to the pool the workers take them from
+    upload_scheduler_->SetRecycler(MakeCommandRecycler());
 }
 
 TileTextureCoordinator::~TileTextureCoordinator() {
     spdlog::info("TileTextureCoordinator shutting down");
+
+    // Overlays upload into the pool through this coordinator's calls
+    if (!overlays_.empty() || time_series_) {
+        overlays_.clear();
+        time_series_.reset();
+        shared_pool_->users.resize(1);
+    }
+
+    // No more uploads will be processed: unblock workers waiting on a full queue
+    upload_queue_->Close();
+
+    // Stop uploading before the pool and the staging ring go away
+    upload_thread_.reset();
+}
+
+TileUploadScheduler::RecycleFn TileTextureCoordinator::MakeCommandRecycler() const {
+    // Owns a reference: the scheduler may outlive the worker pool on shutdown
+    return [pool = worker_pool_->GetBufferPool()](std::unique_ptr<GLUploadCommand> cmd) {
+        pool->ReleaseCommand(std::move(cmd));
+    };
+}
+
+bool TileTextureCoordinator::StartUploadThread(std::unique_ptr<OpenGLContext> context) {
+    if (upload_thread_) {
+        return true;
+    }
+
+    // Timer queries belong to one context: the upload thread measures CPU
+    // time instead. Nothing can be staged while uploads ran synchronously.
+    auto render_scheduler = std::move(upload_scheduler_);
+    upload_scheduler_ = std::make_unique<TileUploadScheduler>(TileUploadSchedulerConfig{}, true);
+    upload_scheduler_->SetFocus(upload_focus_);
+    upload_scheduler_->SetRecycler(MakeCommandRecycler());
+
+    auto thread = std::make_unique<TileUploadThread>(
+        std::move(context),
+        [this](std::vector<CompletedTileUpload>& completed) { return RunUploadBatch(completed); },
+        skip_gl_init_);
+    if (!thread->IsRunning()) {
+        upload_scheduler_ = std::move(render_scheduler);
+        spdlog::warn("Tile upload thread unavailable, uploading on the render thread");
+        return false;
+    }
+
+    upload_thread_ = std::move(thread);
+    return true;
 }
 
 void TileTextureCoordinator::RequestTiles(
-    const std::vector<TileCoordinates>& tiles,
+    std::span<const TileCoordinates> tiles,
     int priority)
 {
     if (tiles.empty()) {
         return;
     }
 
-    // Step 1: Find tiles that need loading (read lock)
-    std::vector<TileCoordinates> to_load;
+    for (const OverlayLayer& overlay : overlays_) {
+        overlay.coordinator->RequestTiles(tiles, priority);
+    }
+    if (time_series_) {
+        RequestTimeSeriesTiles(tiles, priority);
+    }
+
+    // Step 1: Find tiles that need loading (read lock). Missing ancestors
+    // within the fallback chain go first, coarsest first, so the shader has
+    // something to fall back to after one round trip.
+    struct PendingRequest {
+        TileCoordinates coords;
+        int priority;
+    };
+    std::vector<PendingRequest> to_load;
+    std::vector<PendingRequest> to_refresh;
     {
         std::shared_lock<std::shared_mutex> lock(state_mutex_);
 
-        for (const auto& coords : tiles) {
+        const auto classify = [this](const TileCoordinates& coords, int tile_priority,
+                                     std::vector<PendingRequest>& load,
+                                     std::vector<PendingRequest>& refresh) {
             auto it = tile_states_.find(coords);
-
             if (it == tile_states_.end() ||
                 it->second.status == TileStatus::NotLoaded) {
-                to_load.push_back(coords);
+                load.push_back({coords, tile_priority});
+            } else if (it->second.status == TileStatus::Loading) {
+                refresh.push_back({coords, tile_priority});
+            } else {
+                return false;
             }
+            return true;
+        };
+
+        const int ancestor_levels = ancestor_levels_.load();
+        if (ancestor_levels > 0) {
+            // Shared ancestors are visited once; the requested tiles themselves
+            // are never re-added as somebody's ancestor
+            TileSet seen;
+            seen.insert(tiles.begin(), tiles.end());
+            for (const auto& coords : tiles) {
+                TileCoordinates ancestor = coords;
+                for (int level = 1; level <= ancestor_levels && ancestor.zoom > 0; ++level) {
+                    ancestor = ancestor.GetParent();
+                    // A loaded ancestor already covers everything above it
+                    if (!seen.insert(ancestor).second ||
+                        !classify(ancestor, priority - level * kAncestorPriorityStep,
+                                  to_load, to_refresh)) {
+                        break;
+                    }
+                }
+            }
+            std::stable_sort(to_load.begin(), to_load.end(),
+                [](const PendingRequest& a, const PendingRequest& b) {
+                    return a.priority < b.priority;
+                });
+        }
+
+        for (const auto& coords : tiles) {
+            classify(coords, priority, to_load, to_refresh);
         }
     }
 
+    // Tiles still waiting in the worker queue take the new priority and
+    // generation; ones already picked up by a worker are left alone
+    for (const auto& request : to_refresh) {
+        worker_pool_->UpdatePriority(request.coords, request.priority);
+    }
+
     if (to_load.empty()) {
         return;
     }
@@ -90,32 +266,79 @@ void TileTextureCoordinator::RequestTiles(
         return;
     }
 
-    // Step 3: Mark tiles as Loading and submit to worker pool (write lock)
+    // Step 3: Mark tiles as Loading and submit to worker pool (write lock).
+    // Ancestors come first, so backpressure drops the finest tiles.
     {
         std::unique_lock<std::shared_mutex> lock(state_mutex_);
 
-        for (const auto& coords : to_load) {
+        for (const auto& request : to_load) {
             if (pending_load_count_.load() >= kMaxPendingLoads) {
                 break;
             }
 
-            auto& state = tile_states_[coords];
+            auto& state = tile_states_[request.coords];
             if (state.status == TileStatus::NotLoaded) {
                 state.status = TileStatus::Loading;
                 state.request_time = std::chrono::steady_clock::now();
                 pending_load_count_.fetch_add(1);
 
-                worker_pool_->SubmitRequest(coords, priority,
+                worker_pool_->SubmitRequest(request.coords, request.priority,
                     [this](const TileCoordinates& loaded_coords) {
                         this->OnTileLoadComplete(loaded_coords);
                     });
 
-                spdlog::trace("Requested tile {}", coords.GetKey());
+                spdlog::trace("Requested tile {}", request.coords.GetKey());
             }
         }
     }
 }
 
+std::uint64_t TileTextureCoordinator::BeginRequestGeneration() {
+    for (const OverlayLayer& overlay : overlays_) {
+        overlay.coordinator->BeginRequestGeneration();
+    }
+    if (time_series_) {
+        for (const auto& slot : time_series_->slots) {
+            slot->BeginRequestGeneration();
+        }
+    }
+    return worker_pool_->AdvanceGeneration();
+}
+
+std::size_t TileTextureCoordinator::CancelStaleRequests() {
+    std::size_t overlay_cancelled = 0;
+    for (const OverlayLayer& overlay : overlays_) {
+        overlay_cancelled += overlay.coordinator->CancelStaleRequests();
+    }
+    if (time_series_) {
+        for (const auto& slot : time_series_->slots) {
+            overlay_cancelled += slot->CancelStaleRequests();
+        }
+    }
+
+    const auto dropped = worker_pool_->CancelStaleRequests();
+    if (dropped.empty()) {
+        return overlay_cancelled;
+    }
+
+    // Dropped requests never reached a worker, so no upload command will
+    // arrive for them: return them to NotLoaded here
+    std::unique_lock<std::shared_mutex> lock(state_mutex_);
+
+    std::size_t cancelled = 0;
+    for (const auto& coords : dropped) {
+        auto it = tile_states_.find(coords);
+        if (it != tile_states_.end() && it->second.status == TileStatus::Loading) {
+            tile_states_.erase(it);
+            pending_load_count_.fetch_sub(1);
+            ++cancelled;
+        }
+    }
+
+    spdlog::debug("Cancelled {} stale tile requests", cancelled);
+    return cancelled + overlay_cancelled;
+}
+
 bool TileTextureCoordinator::IsTileReady(const TileCoordinates& coords) const {
     std::shared_lock<std::shared_mutex> lock(state_mutex_);
     auto it = tile_states_.find(coords);
@@ -133,8 +356,129 @@ glm::vec4 TileTextureCoordinator::GetTileUV(const TileCoordinates& coords) const
     return glm::vec4(0.0f, 0.0f, 0.0f, 0.0f);
 }
 
-std::uint32_t TileTextureCoordinator::GetTilePoolTextureID() const {
-    return tile_pool_->GetTextureArrayID();
+void TileTextureCoordinator::QueryTiles(std::span<const TileCoordinates> tiles,
+                                        std::span<TileState> states) const {
+    if (tiles.size() != states.size()) {
+        throw std::invalid_argument("QueryTiles needs one state per tile");
+    }
+    std::shared_lock<std::shared_mutex> lock(state_mutex_);
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        auto it = tile_states_.find(tiles[i]);
+        states[i] = it != tile_states_.end() ? it->second : TileState{};
+    }
+}
+
+std::uint32_t TileTextureCoordinator::GetTilePoolTextureID(std::size_t array) const {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    return tile_pool_->GetTextureArrayID(array);
+}
+
+std::uint32_t TileTextureCoordinator::GetTilePoolLayersPerArray() const {
+    return tile_pool_->GetLayersPerArray();
+}
+
+void TileTextureCoordinator::SetVramBudget(std::size_t bytes) {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    const std::size_t layer_bytes = tile_pool_->GetLayerBytes();
+    std::size_t layers = kDefaultMaxPoolLayers;
+    if (bytes > 0) {
+        layers = bytes / layer_bytes;
+    } else if (const std::size_t free_vram = TileTexturePool::QueryAvailableVideoMemory();
+               free_vram > 0) {
+        layers = static_cast<std::size_t>(static_cast<double>(free_vram) *
+                                          kAutoVramBudgetFraction) / layer_bytes;
+    }
+
+    tile_pool_->SetBudgetLayers(static_cast<std::uint32_t>(
+        std::min<std::size_t>(layers, tile_pool_->GetMaxLayers())));
+
+    spdlog::info("Tile pool VRAM budget: {} layers ({} MB)", tile_pool_->GetBudgetLayers(),
+                 tile_pool_->GetBudgetLayers() * layer_bytes / (1024 * 1024));
+}
+
+std::size_t TileTextureCoordinator::GetVramBudget() const {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    return static_cast<std::size_t>(tile_pool_->GetBudgetLayers()) * tile_pool_->GetLayerBytes();
+}
+
+std::size_t TileTextureCoordinator::GetVramUsage() const {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    return tile_pool_->GetOccupiedLayers() * tile_pool_->GetLayerBytes();
+}
+
+std::size_t TileTextureCoordinator::ShedTiles(std::size_t bytes) {
+    std::vector<TileCoordinates> victims;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        const std::size_t layer_bytes = tile_pool_->GetLayerBytes();
+        const std::size_t keep = bytes / layer_bytes;
+        const std::size_t occupied = tile_pool_->GetOccupiedLayers();
+        if (occupied > keep) {
+            victims = tile_pool_->GetEvictionCandidates(occupied - keep, EvictionImportance());
+        }
+    }
+    for (const TileCoordinates& key : victims) {
+        EvictPoolKey(key);
+    }
+    return victims.size();
+}
+
+void TileTextureCoordinator::UpdateEvictionPriorities(std::span<const TileCoordinates> visible,
+                                                      const TileCoordinates& focus) {
+    if (time_series_) {
+        std::lock_guard<std::mutex> lock(time_series_mutex_);
+        time_series_->visible.clear();
+        time_series_->visible.insert(visible.begin(), visible.end());
+    }
+
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    TileEvictionPolicy& policy = shared_pool_->eviction_policy;
+    policy.SetMaxProtectedTiles(static_cast<std::size_t>(
+        static_cast<double>(tile_pool_->GetBudgetLayers()) * kMaxProtectedPoolFraction));
+    policy.Update(visible, focus);
+
+    // Visible tiles of every layer are the most recently used
+    for (std::size_t ns = 0; ns < shared_pool_->users.size(); ++ns) {
+        const auto zoom_offset = static_cast<std::int32_t>(ns) * kPoolNamespaceZoomStride;
+        for (const TileCoordinates& tile : visible) {
+            tile_pool_->TouchTile({tile.x, tile.y, tile.zoom + zoom_offset});
+        }
+    }
+}
+
+TileStateMapSizes TileTextureCoordinator::GetStateMapSizes() const {
+    TileStateMapSizes sizes;
+    sizes.tile_states = GetTileCount();
+    {
+        std::lock_guard<std::mutex> lock(trace_mutex_);
+        sizes.awaiting_render = awaiting_render_.size();
+    }
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    sizes.pool_tiles = tile_pool_->GetOccupiedLayers();
+    return sizes;
+}
+
+std::size_t TileTextureCoordinator::GetProtectedTileCount() const {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    return shared_pool_->eviction_policy.GetProtectedCount();
+}
+
+TileImportanceFn TileTextureCoordinator::EvictionImportance() const {
+    const TileEvictionPolicy* policy = &shared_pool_->eviction_policy;
+    const std::vector<bool>* reserved = &shared_pool_->reserved_namespaces;
+    return [policy, reserved](const TileCoordinates& key) {
+        // Time-series frames manage their own region of the pool
+        const auto ns = static_cast<std::size_t>(key.zoom / kPoolNamespaceZoomStride);
+        if (ns < reserved->size() && (*reserved)[ns]) {
+            return std::numeric_limits<float>::infinity();
+        }
+        return policy->Score({key.x, key.y, key.zoom % kPoolNamespaceZoomStride});
+    };
+}
+
+void TileTextureCoordinator::SetMaxAnisotropy(float anisotropy) {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    tile_pool_->SetMaxAnisotropy(anisotropy);
 }
 
 std::uint32_t TileTextureCoordinator::GetIndirectionTextureID(int zoom) const {
@@ -145,100 +489,365 @@ glm::ivec2 TileTextureCoordinator::GetIndirectionOffset(int zoom) const {
     return indirection_manager_->GetWindowOffset(zoom);
 }
 
+glm::ivec2 TileTextureCoordinator::GetIndirectionSize(int zoom) const {
+    return indirection_manager_->GetTextureSize(zoom);
+}
+
 void TileTextureCoordinator::UpdateIndirectionWindowCenter(
     int zoom, int center_tile_x, int center_tile_y) {
     indirection_manager_->UpdateWindowCenter(zoom, center_tile_x, center_tile_y);
+    for (const OverlayLayer& overlay : overlays_) {
+        overlay.coordinator->UpdateIndirectionWindowCenter(zoom, center_tile_x, center_tile_y);
+    }
+    if (time_series_) {
+        for (const auto& slot : time_series_->slots) {
+            slot->UpdateIndirectionWindowCenter(zoom, center_tile_x, center_tile_y);
+        }
+    }
+}
+
+void TileTextureCoordinator::FlushIndirectionUpdates() {
+    indirection_manager_->FlushUploads();
+    for (const OverlayLayer& overlay : overlays_) {
+        overlay.coordinator->FlushIndirectionUpdates();
+    }
+    if (time_series_) {
+        for (const auto& slot : time_series_->slots) {
+            slot->FlushIndirectionUpdates();
+        }
+    }
 }
 
 int TileTextureCoordinator::GetTileLayerIndex(const TileCoordinates& coords) const {
-    return tile_pool_->GetLayerIndex(coords);
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    return tile_pool_->GetLayerIndex(PoolKey(coords));
 }
 
 std::uint32_t TileTextureCoordinator::GetAtlasTextureID() const {
+    std::lock_guard<std::mutex> lock(pool_mutex_);
     return tile_pool_->GetTextureArrayID();
 }
 
-void TileTextureCoordinator::ProcessUploads(int max_uploads_per_frame) {
-    if (max_uploads_per_frame <= 0) {
-        return;
+void TileTextureCoordinator::ProcessUploads(std::chrono::microseconds frame_budget) {
+    // A lowered budget is honored before new tiles take layers. The upload
+    // thread cannot evict (indirection entries live here), so keep layers
+    // free for it while tiles are on their way.
+    const std::size_t headroom =
+        upload_thread_ && pending_load_count_.load() > 0 ? kUploadThreadHeadroomLayers : 0;
+    while (true) {
+        std::vector<TileCoordinates> victims;
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex_);
+            if (tile_pool_->IsOverBudget() ||
+                tile_pool_->GetFreeLayers() < std::min<std::size_t>(
+                    headroom, tile_pool_->GetBudgetLayers() / 2)) {
+                victims = tile_pool_->GetEvictionCandidates(kEvictionBatchLayers,
+                                                            EvictionImportance());
+            }
+        }
+        if (victims.empty()) {
+            break;
+        }
+        for (const TileCoordinates& key : victims) {
+            EvictPoolKey(key);
+        }
     }
 
-    for (int i = 0; i < max_uploads_per_frame; ++i) {
-        auto cmd = upload_queue_->TryPop();
-        if (!cmd) {
-            break;
+    // Frames move through the ring before their slots take uploads
+    if (time_series_) {
+        std::lock_guard<std::mutex> lock(time_series_mutex_);
+        UpdateTimeSeriesLocked();
+    }
+
+    // The layers split the frame's budget; frame slots split their layer's
+    if (!overlays_.empty() || time_series_) {
+        frame_budget /= static_cast<int>(GetOverlayCount() + 1);
+        for (const OverlayLayer& overlay : overlays_) {
+            overlay.coordinator->ProcessUploads(frame_budget);
+        }
+        if (time_series_) {
+            const auto slot_budget = frame_budget / static_cast<int>(time_series_->slots.size());
+            for (const auto& slot : time_series_->slots) {
+                slot->ProcessUploads(slot_budget);
+            }
         }
+    }
 
-        // Upload to tile pool
-        int layer = tile_pool_->UploadTile(
-            cmd->coords,
-            cmd->pixel_data.data(),
-            cmd->width,
-            cmd->height,
-            cmd->channels
-        );
+    if (upload_thread_) {
+        // Pixels were transferred on the upload thread; only flip state here
+        upload_thread_->Publish([this](CompletedTileUpload& upload) {
+            FinishUpload(upload.coords, upload.layer, upload.on_complete, upload.trace);
+        });
+        return;
+    }
 
-        // Pool full — evict LRU tile and retry
-        if (layer < 0 && tile_pool_->GetFreeLayers() == 0) {
-            auto candidate = tile_pool_->GetEvictionCandidate();
-            if (candidate.has_value()) {
-                indirection_manager_->ClearTile(*candidate);
-                tile_pool_->EvictTile(*candidate);
+    // Free slots whose earlier uploads the GPU has finished reading
+    pixel_ring_->Reclaim();
 
-                {
-                    std::unique_lock<std::shared_mutex> lock(state_mutex_);
-                    tile_states_.erase(*candidate);
-                }
+    upload_scheduler_->RunFrame(*upload_queue_, frame_budget,
+        [this](GLUploadCommand& cmd) {
+            FinishUpload(cmd.coords, UploadToPool(cmd, true), cmd.on_complete, cmd.trace);
+        });
+}
 
-                spdlog::debug("Evicted LRU tile {} to make room for {}",
-                              candidate->GetKey(), cmd->coords.GetKey());
+bool TileTextureCoordinator::RunUploadBatch(std::vector<CompletedTileUpload>& completed) {
+    pixel_ring_->Reclaim();
 
-                layer = tile_pool_->UploadTile(
-                    cmd->coords,
-                    cmd->pixel_data.data(),
-                    cmd->width,
-                    cmd->height,
-                    cmd->channels
-                );
+    {
+        std::lock_guard<std::mutex> lock(upload_focus_mutex_);
+        upload_scheduler_->SetFocus(upload_focus_);
+    }
+
+    const std::size_t count = upload_scheduler_->RunFrame(*upload_queue_, kDefaultUploadBudget,
+        [this, &completed](GLUploadCommand& cmd) {
+            const int layer = UploadToPool(cmd, false);
+            completed.push_back(CompletedTileUpload{cmd.coords, layer, std::move(cmd.on_complete),
+                                                    std::move(cmd.trace)});
+        });
+
+    std::lock_guard<std::mutex> lock(upload_focus_mutex_);
+    upload_stats_ = upload_scheduler_->GetStats();
+    return count > 0;
+}
+
+std::size_t TileTextureCoordinator::WarmUpView(std::span<const TileCoordinates> view_tiles,
+                                               std::size_t max_tiles, int priority) {
+    const std::shared_ptr<TileCache> cache = worker_pool_->GetCache();
+    if (!cache || view_tiles.empty() || max_tiles == 0) {
+        return 0;
+    }
+
+    // Tiles overlap when the finer one lies inside the coarser one
+    const auto overlaps = [](const TileCoordinates& a, const TileCoordinates& b) {
+        const TileCoordinates& fine = a.zoom >= b.zoom ? a : b;
+        const TileCoordinates& coarse = a.zoom >= b.zoom ? b : a;
+        const int shift = fine.zoom - coarse.zoom;
+        return (fine.x >> shift) == coarse.x && (fine.y >> shift) == coarse.y;
+    };
+
+    std::vector<TileCoordinates> warm;
+    for (const TileCoordinates& hot : cache->GetHottestTiles(kWarmUpCandidateTiles)) {
+        if (std::any_of(view_tiles.begin(), view_tiles.end(),
+                        [&](const TileCoordinates& view) { return overlaps(hot, view); })) {
+            warm.push_back(hot);
+            if (warm.size() == max_tiles) {
+                break;
             }
         }
+    }
 
-        if (layer >= 0) {
-            // Update indirection texture
-            indirection_manager_->SetTileLayer(
-                cmd->coords,
-                static_cast<std::uint16_t>(layer));
+    RequestTiles(warm, priority);
+    spdlog::debug("Warm-up requested {} hot tiles for the initial view", warm.size());
+    return warm.size();
+}
 
-            // Update state to Loaded and decrement pending counter
+void TileTextureCoordinator::SetAncestorLevels(int levels) {
+    for (const OverlayLayer& overlay : overlays_) {
+        overlay.coordinator->SetAncestorLevels(levels);
+    }
+    if (time_series_) {
+        for (const auto& slot : time_series_->slots) {
+            slot->SetAncestorLevels(levels);
+        }
+    }
+    ancestor_levels_.store(std::max(levels, 0));
+}
+
+void TileTextureCoordinator::SetUploadFocus(const TileCoordinates& focus) {
+    for (const OverlayLayer& overlay : overlays_) {
+        overlay.coordinator->SetUploadFocus(focus);
+    }
+    if (time_series_) {
+        for (const auto& slot : time_series_->slots) {
+            slot->SetUploadFocus(focus);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(upload_focus_mutex_);
+    upload_focus_ = focus;
+    if (!upload_thread_) {
+        upload_scheduler_->SetFocus(focus);
+    }
+}
+
+TileUploadStats TileTextureCoordinator::GetUploadStats() const {
+    std::lock_guard<std::mutex> lock(upload_focus_mutex_);
+    return upload_thread_ ? upload_stats_ : upload_scheduler_->GetStats();
+}
+
+int TileTextureCoordinator::UploadToPool(GLUploadCommand& cmd, bool allow_evict) {
+    // No slot = the worker failed to load the tile
+    if (!cmd.slot.IsValid()) {
+        return -1;
+    }
+
+    int layer = -1;
+    std::vector<TileCoordinates> victims;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        layer = UploadFromSlot(cmd);
+        if (layer < 0 && allow_evict && tile_pool_->GetFreeLayers() == 0) {
+            victims = tile_pool_->GetEvictionCandidates(kEvictionBatchLayers,
+                                                        EvictionImportance());
+        }
+    }
+
+    // Pool full — evict a batch of the least important tiles (of any layer),
+    // so the next uploads find free layers, and retry
+    if (!victims.empty()) {
+        for (const TileCoordinates& key : victims) {
+            EvictPoolKey(key);
+        }
+
+        spdlog::debug("Evicted {} tiles to make room for {}", victims.size(),
+                      cmd.coords.GetKey());
+
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        layer = UploadFromSlot(cmd);
+    }
+
+    // Slot is reusable once the GPU has consumed the upload
+    pixel_ring_->FenceAndRelease(cmd.slot);
+    return layer;
+}
+
+void TileTextureCoordinator::FinishUpload(
+    const TileCoordinates& coords,
+    int layer,
+    const std::function<void(const TileCoordinates&)>& on_complete,
+    const std::shared_ptr<TileLoadTrace>& trace) {
+
+    // An upload published late may have lost its layer to an eviction since
+    if (layer >= 0 && upload_thread_) {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        if (tile_pool_->GetLayerIndex(PoolKey(coords)) != layer) {
+            layer = -1;
+        }
+    }
+
+    if (layer >= 0) {
+        // Update indirection texture
+        indirection_manager_->SetTileLayer(
+            coords,
+            static_cast<std::uint16_t>(layer));
+
+        // Update state to Loaded and decrement pending counter
+        bool loaded = false;
+        {
             std::unique_lock<std::shared_mutex> lock(state_mutex_);
 
-            auto it = tile_states_.find(cmd->coords);
+            auto it = tile_states_.find(coords);
             if (it != tile_states_.end() && it->second.status == TileStatus::Loading) {
                 it->second.status = TileStatus::Loaded;
                 it->second.pool_layer = layer;
                 pending_load_count_.fetch_sub(1);
+                loaded = true;
 
                 spdlog::trace("Tile {} uploaded to pool layer {}",
-                             cmd->coords.GetKey(), layer);
+                             coords.GetKey(), layer);
             }
-        } else {
-            // Upload failed — remove from pending state
-            std::unique_lock<std::shared_mutex> lock(state_mutex_);
-            auto it = tile_states_.find(cmd->coords);
-            if (it != tile_states_.end() && it->second.status == TileStatus::Loading) {
-                tile_states_.erase(it);
-                pending_load_count_.fetch_sub(1);
-            }
-            spdlog::warn("Failed to upload tile {} to pool", cmd->coords.GetKey());
         }
 
-        if (cmd->on_complete) {
-            cmd->on_complete(cmd->coords);
+        if (trace) {
+            trace->Mark(TileLoadStage::UPLOADED);
+            if (loaded) {
+                // The render phase ends with the first frame drawing the tile
+                std::lock_guard<std::mutex> lock(trace_mutex_);
+                awaiting_render_[coords] = trace;
+            } else {
+                tracer_->Finish(*trace, TileLoadOutcome::CANCELLED);
+            }
+        }
+    } else {
+        // Upload failed — remove from pending state
+        std::unique_lock<std::shared_mutex> lock(state_mutex_);
+        auto it = tile_states_.find(coords);
+        if (it != tile_states_.end() && it->second.status == TileStatus::Loading) {
+            tile_states_.erase(it);
+            pending_load_count_.fetch_sub(1);
+        }
+        spdlog::warn("Failed to upload tile {} to pool", coords.GetKey());
+        if (trace) {
+            tracer_->Finish(*trace, TileLoadOutcome::FAILED);
         }
     }
+
+    if (on_complete) {
+        on_complete(coords);
+    }
+}
+
+void TileTextureCoordinator::EvictPoolTile(const TileCoordinates& coords) {
+    indirection_manager_->ClearTile(coords);
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        tile_pool_->EvictTile(PoolKey(coords));
+    }
+    ForgetTile(coords);
+}
+
+void TileTextureCoordinator::EvictPoolKey(const TileCoordinates& key) {
+    const std::int32_t ns = key.zoom / kPoolNamespaceZoomStride;
+    const TileCoordinates coords{key.x, key.y, key.zoom % kPoolNamespaceZoomStride};
+    if (ns < 0 || static_cast<std::size_t>(ns) >= shared_pool_->users.size()) {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        tile_pool_->EvictTile(key);
+        return;
+    }
+    shared_pool_->users[static_cast<std::size_t>(ns)]->EvictPoolTile(coords);
+}
+
+void TileTextureCoordinator::ForgetTile(const TileCoordinates& coords) {
+    FinishAwaitingTrace(coords);
+
+    std::unique_lock<std::shared_mutex> lock(state_mutex_);
+    auto it = tile_states_.find(coords);
+    if (it == tile_states_.end()) {
+        return;
+    }
+    // Uploaded but not yet published: it never reaches Loaded now
+    if (it->second.status == TileStatus::Loading) {
+        pending_load_count_.fetch_sub(1);
+    }
+    tile_states_.erase(it);
+}
+
+int TileTextureCoordinator::UploadFromSlot(const GLUploadCommand& cmd) {
+    if (pixel_ring_->IsPersistentlyMapped()) {
+        return tile_pool_->UploadTileFromBuffer(
+            PoolKey(cmd.coords),
+            pixel_ring_->GetBufferID(),
+            pixel_ring_->GetSlotOffset(cmd.slot),
+            cmd.width,
+            cmd.height,
+            cmd.channels,
+            cmd.format,
+            cmd.mip_levels
+        );
+    }
+
+    return tile_pool_->UploadTile(
+        PoolKey(cmd.coords),
+        pixel_ring_->GetSlotData(cmd.slot),
+        cmd.width,
+        cmd.height,
+        cmd.channels,
+        cmd.format,
+        cmd.mip_levels
+    );
 }
 
 std::size_t TileTextureCoordinator::EvictUnusedTiles(std::chrono::seconds max_age) {
+    std::size_t evicted = 0;
+    for (const OverlayLayer& overlay : overlays_) {
+        evicted += overlay.coordinator->EvictUnusedTiles(max_age);
+    }
+    if (time_series_) {
+        for (const auto& slot : time_series_->slots) {
+            evicted += slot->EvictUnusedTiles(max_age);
+        }
+    }
+
     const auto now = std::chrono::steady_clock::now();
     std::vector<TileCoordinates> to_evict;
 
@@ -249,11 +858,13 @@ std::size_t TileTextureCoordinator::EvictUnusedTiles(std::chrono::seconds max_ag
             if (state.status == TileStatus::Loaded) {
                 // Use the pool's last-used timestamp (updated by TouchTile)
                 // rather than request_time, so actively rendered tiles survive.
-                const auto last_used = tile_pool_->GetLastUsedTime(coords);
+                std::lock_guard<std::mutex> pool_lock(pool_mutex_);
+                const TileCoordinates key = PoolKey(coords);
+                const auto last_used = tile_pool_->GetLastUsedTime(key);
                 const auto age = std::chrono::duration_cast<std::chrono::seconds>(
                     now - last_used);
 
-                if (age > max_age) {
+                if (age > max_age && !tile_pool_->IsTilePinned(key)) {
                     to_evict.push_back(coords);
                 }
             }
@@ -261,12 +872,11 @@ std::size_t TileTextureCoordinator::EvictUnusedTiles(std::chrono::seconds max_ag
     }
 
     if (to_evict.empty()) {
-        return 0;
+        return evicted;
     }
 
     std::unique_lock<std::shared_mutex> lock(state_mutex_);
 
-    std::size_t evicted = 0;
     for (const auto& coords : to_evict) {
         // Re-check state — may have changed between lock upgrade
         auto it = tile_states_.find(coords);
@@ -278,10 +888,14 @@ std::size_t TileTextureCoordinator::EvictUnusedTiles(std::chrono::seconds max_ag
         indirection_manager_->ClearTile(coords);
 
         // Evict from tile pool
-        tile_pool_->EvictTile(coords);
+        {
+            std::lock_guard<std::mutex> pool_lock(pool_mutex_);
+            tile_pool_->EvictTile(PoolKey(coords));
+        }
 
         // Remove from state map
         tile_states_.erase(it);
+        FinishAwaitingTrace(coords);
         ++evicted;
 
         spdlog::debug("Evicted old tile {}", coords.GetKey());
@@ -290,6 +904,84 @@ std::size_t TileTextureCoordinator::EvictUnusedTiles(std::chrono::seconds max_ag
     return evicted;
 }
 
+std::size_t TileTextureCoordinator::AddResidentTiles(std::vector<ResidentTile>& tiles) {
+    const TileTextureFormat format = tile_pool_->GetFormat();
+    const std::uint32_t levels = tile_pool_->GetMipLevels();
+    const std::uint32_t tile_size = tile_pool_->GetTileSize();
+
+    // Same transcoding as the decode threads: mip chain, then BC1 in place
+    std::vector<char> usable(tiles.size(), 0);
+    const auto transcode = [&](std::size_t first, std::size_t step) {
+        for (std::size_t i = first; i < tiles.size(); i += step) {
+            DecodedImage& image = tiles[i].image;
+            if (image.width != tile_size || image.height != tile_size) {
+                continue;
+            }
+            if (levels > 1 || format == TileTextureFormat::BC1) {
+                const std::size_t capacity =
+                    TileMipChain::GetLevelOffset(TileTextureFormat::RGBA8, tile_size, levels);
+                image.pixels.resize(std::max(image.pixels.size(), capacity));
+                if (!TileMipChain::Build(image.pixels.data(), tile_size, image.channels, levels,
+                                         format, image.pixels.size())) {
+                    continue;
+                }
+            }
+            usable[i] = 1;
+        }
+    };
+    const std::size_t thread_count = std::min<std::size_t>(
+        tiles.size(), std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<std::future<void>> tasks;
+    for (std::size_t thread = 1; thread < thread_count; ++thread) {
+        tasks.push_back(std::async(std::launch::async, transcode, thread, thread_count));
+    }
+    transcode(0, std::max<std::size_t>(thread_count, 1));
+    for (std::future<void>& task : tasks) {
+        task.get();
+    }
+
+    std::size_t added = 0;
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        if (!usable[i]) {
+            spdlog::warn("Resident tile {} is not a {}x{} image, skipped",
+                         tiles[i].coords.GetKey(), tile_size, tile_size);
+            continue;
+        }
+        const ResidentTile& tile = tiles[i];
+        int layer = -1;
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex_);
+            if (tile_pool_->GetFreeLayers() == 0) {
+                spdlog::warn("Tile pool full after {} resident tiles", added);
+                break;
+            }
+            layer = tile_pool_->UploadTile(PoolKey(tile.coords), tile.image.pixels.data(),
+                                           tile_size, tile_size, tile.image.channels, format,
+                                           levels);
+            if (layer >= 0) {
+                tile_pool_->PinTile(PoolKey(tile.coords));
+            }
+        }
+        if (layer < 0) {
+            continue;
+        }
+
+        indirection_manager_->SetTileLayer(tile.coords, static_cast<std::uint16_t>(layer));
+        std::unique_lock<std::shared_mutex> lock(state_mutex_);
+        TileState& state = tile_states_[tile.coords];
+        if (state.status == TileStatus::Loading) {
+            // The pending load finds the tile Loaded and leaves it alone
+            pending_load_count_.fetch_sub(1);
+        }
+        state.status = TileStatus::Loaded;
+        state.pool_layer = layer;
+        ++added;
+    }
+
+    spdlog::info("{} resident tiles uploaded to the tile pool", added);
+    return added;
+}
+
 TileTextureCoordinator::TileStatus
 TileTextureCoordinator::GetTileStatus(const TileCoordinates& coords) const {
     std::shared_lock<std::shared_mutex> lock(state_mutex_);
@@ -302,6 +994,322 @@ TileTextureCoordinator::GetTileStatus(const TileCoordinates& coords) const {
     return it->second.status;
 }
 
+void TileTextureCoordinator::MarkTilesRendered(std::span<const TileCoordinates> tiles) {
+    for (const OverlayLayer& overlay : overlays_) {
+        overlay.coordinator->MarkTilesRendered(tiles);
+    }
+    if (time_series_) {
+        // Only the slot drawn rendered anything
+        TileTextureCoordinator* shown = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(time_series_mutex_);
+            shown = time_series_->slots[time_series_->shown_slot].get();
+        }
+        shown->MarkTilesRendered(tiles);
+    }
+
+    std::lock_guard<std::mutex> lock(trace_mutex_);
+    if (awaiting_render_.empty()) {
+        return;
+    }
+    for (const TileCoordinates& coords : tiles) {
+        auto it = awaiting_render_.find(coords);
+        if (it == awaiting_render_.end()) {
+            continue;
+        }
+        it->second->Mark(TileLoadStage::FIRST_RENDERED);
+        tracer_->Finish(*it->second, TileLoadOutcome::RENDERED);
+        awaiting_render_.erase(it);
+    }
+}
+
+void TileTextureCoordinator::FinishAwaitingTrace(const TileCoordinates& coords) {
+    std::lock_guard<std::mutex> lock(trace_mutex_);
+    auto it = awaiting_render_.find(coords);
+    if (it == awaiting_render_.end()) {
+        return;
+    }
+    tracer_->Finish(*it->second, TileLoadOutcome::EVICTED);
+    awaiting_render_.erase(it);
+}
+
+int TileTextureCoordinator::AddOverlayLayer(
+    std::shared_ptr<TileCache> cache,
+    std::shared_ptr<TileLoader> loader,
+    float opacity,
+    int num_worker_threads)
+{
+    if (pool_namespace_ != 0) {
+        throw std::invalid_argument("Overlay layers are added to the base coordinator");
+    }
+    if (!loader) {
+        throw std::invalid_argument("TileLoader cannot be null");
+    }
+    if (GetOverlayCount() >= kMaxOverlayLayers) {
+        spdlog::warn("TileTextureCoordinator: {} overlay layers in use, overlay not added",
+                     kMaxOverlayLayers);
+        return -1;
+    }
+
+    // Private constructor: not reachable through make_unique
+    OverlayLayer overlay;
+    overlay.coordinator.reset(new TileTextureCoordinator(
+        *this, std::move(cache), std::move(loader), num_worker_threads));
+    overlay.opacity = std::clamp(opacity, 0.0f, 1.0f);
+    overlays_.push_back(std::move(overlay));
+
+    spdlog::info("Overlay layer {} added ({} decode threads, shared tile pool)",
+                 overlays_.size() - 1,
+                 overlays_.back().coordinator->worker_pool_->GetDecodeThreadCount());
+    return static_cast<int>(overlays_.size() - 1);
+}
+
+TileTextureCoordinator* TileTextureCoordinator::GetOverlay(std::size_t index) const {
+    if (index < overlays_.size()) {
+        return overlays_[index].coordinator.get();
+    }
+    if (index == overlays_.size() && time_series_) {
+        std::lock_guard<std::mutex> lock(time_series_mutex_);
+        return time_series_->slots[time_series_->shown_slot].get();
+    }
+    return nullptr;
+}
+
+void TileTextureCoordinator::SetOverlayOpacity(std::size_t index, float opacity) {
+    if (index < overlays_.size()) {
+        overlays_[index].opacity = std::clamp(opacity, 0.0f, 1.0f);
+    } else if (index == overlays_.size() && time_series_) {
+        time_series_->opacity = std::clamp(opacity, 0.0f, 1.0f);
+    }
+}
+
+float TileTextureCoordinator::GetOverlayOpacity(std::size_t index) const {
+    if (index < overlays_.size()) {
+        return overlays_[index].opacity;
+    }
+    return index == overlays_.size() && time_series_ ? time_series_->opacity : 0.0f;
+}
+
+int TileTextureCoordinator::AddTimeSeriesLayer(
+    std::shared_ptr<TileLoader> loader,
+    std::shared_ptr<const TileProvider> provider,
+    const TimeSeriesLayerConfig& config,
+    float opacity,
+    int num_worker_threads)
+{
+    if (pool_namespace_ != 0) {
+        throw std::invalid_argument("Time-series layers are added to the base coordinator");
+    }
+    if (!loader || !provider) {
+        throw std::invalid_argument("Time-series layer needs a loader and a provider");
+    }
+    // Caches key tiles by coordinates only: every frame would read the first frame's tile
+    if (loader->GetTileCache()) {
+        throw std::invalid_argument("Time-series layer loader must not have a tile cache");
+    }
+    if (config.frame_times.empty()) {
+        throw std::invalid_argument("Time-series layer needs at least one frame");
+    }
+    if (time_series_) {
+        throw std::invalid_argument("Only one time-series layer is supported");
+    }
+    if (GetOverlayCount() >= kMaxOverlayLayers) {
+        spdlog::warn("TileTextureCoordinator: {} overlay layers in use, time series not added",
+                     kMaxOverlayLayers);
+        return -1;
+    }
+
+    auto layer = std::make_unique<TimeSeriesLayer>();
+    layer->config = config;
+    layer->opacity = std::clamp(opacity, 0.0f, 1.0f);
+    for (const std::string& time : config.frame_times) {
+        auto frame = std::make_shared<TimeFrameTileProvider>(provider, time);
+        layer->provider_names.push_back(frame->GetName());
+        if (!loader->AddProvider(std::move(frame))) {
+            spdlog::warn("Time-series frame {} not registered with the loader",
+                         layer->provider_names.back());
+        }
+    }
+
+    // One slot per frame of the window; frame slots have no cache of their own
+    const std::size_t slot_count =
+        std::min(config.prefetch_frames + 1, config.frame_times.size());
+    for (std::size_t i = 0; i < slot_count; ++i) {
+        std::unique_ptr<TileTextureCoordinator> slot(new TileTextureCoordinator(
+            *this, nullptr, loader, num_worker_threads));
+        slot->worker_pool_->SetProviderName(layer->provider_names[i]);
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex_);
+            auto& reserved = shared_pool_->reserved_namespaces;
+            reserved.resize(shared_pool_->users.size(), false);
+            reserved[static_cast<std::size_t>(slot->pool_namespace_)] = true;
+        }
+        layer->slots.push_back(std::move(slot));
+        layer->slot_frames.push_back(i);
+    }
+    time_series_ = std::move(layer);
+
+    spdlog::info("Time-series layer added: {} frames, {} frame slots", config.frame_times.size(),
+                 slot_count);
+    return static_cast<int>(GetOverlayCount() - 1);
+}
+
+void TileTextureCoordinator::SetAnimationTime(std::chrono::duration<double> time) {
+    if (!time_series_) {
+        return;
+    }
+    const double frame_seconds =
+        std::chrono::duration<double>(time_series_->config.frame_duration).count();
+    if (frame_seconds <= 0.0 || time.count() < 0.0) {
+        return;
+    }
+    SetTimeSeriesFrame(static_cast<std::size_t>(std::floor(time.count() / frame_seconds)));
+}
+
+void TileTextureCoordinator::SetTimeSeriesFrame(std::size_t frame) {
+    if (!time_series_) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(time_series_mutex_);
+    frame %= time_series_->config.frame_times.size();
+    if (frame == time_series_->current_frame) {
+        return;
+    }
+    time_series_->current_frame = frame;
+    UpdateTimeSeriesLocked();
+}
+
+std::size_t TileTextureCoordinator::GetTimeSeriesFrame() const {
+    if (!time_series_) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(time_series_mutex_);
+    return time_series_->current_frame;
+}
+
+TileTextureCoordinator* TileTextureCoordinator::GetTimeSeriesFrameLayer(std::size_t frame) const {
+    if (!time_series_) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(time_series_mutex_);
+    for (std::size_t slot = 0; slot < time_series_->slots.size(); ++slot) {
+        if (time_series_->slot_frames[slot] == frame) {
+            return time_series_->slots[slot].get();
+        }
+    }
+    return nullptr;
+}
+
+std::optional<std::size_t> TileTextureCoordinator::GetFrameDistanceLocked(
+    std::size_t frame) const {
+    const std::size_t frame_count = time_series_->config.frame_times.size();
+    const std::size_t distance =
+        (frame + frame_count - time_series_->current_frame) % frame_count;
+    if (distance >= time_series_->slots.size()) {
+        return std::nullopt;
+    }
+    return distance;
+}
+
+std::size_t TileTextureCoordinator::GetFrameSlotLayersLocked() const {
+    std::size_t budget = 0;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        budget = tile_pool_->GetBudgetLayers();
+    }
+    const double region = static_cast<double>(budget) *
+                          std::clamp(time_series_->config.pool_fraction, 0.0, 1.0);
+    return static_cast<std::size_t>(region) / time_series_->slots.size();
+}
+
+void TileTextureCoordinator::UpdateTimeSeriesLocked() {
+    TimeSeriesLayer& series = *time_series_;
+    const std::size_t frame_count = series.config.frame_times.size();
+
+    // Frames of the window without a slot take one whose frame was left
+    // behind, once the loads of that frame have drained
+    for (std::size_t distance = 0; distance < series.slots.size(); ++distance) {
+        const std::size_t frame = (series.current_frame + distance) % frame_count;
+        if (std::find(series.slot_frames.begin(), series.slot_frames.end(), frame) !=
+            series.slot_frames.end()) {
+            continue;
+        }
+        for (std::size_t slot = 0; slot < series.slots.size(); ++slot) {
+            TileTextureCoordinator& layer = *series.slots[slot];
+            if (GetFrameDistanceLocked(series.slot_frames[slot]) ||
+                layer.pending_load_count_.load() > 0) {
+                continue;
+            }
+            layer.TrimTiles({}, 0);
+            layer.worker_pool_->SetProviderName(series.provider_names[frame]);
+            series.slot_frames[slot] = frame;
+            spdlog::debug("Time-series frame {} loads into slot {}", frame, slot);
+            break;
+        }
+    }
+
+    for (std::size_t slot = 0; slot < series.slots.size(); ++slot) {
+        if (series.slot_frames[slot] == series.current_frame) {
+            series.shown_slot = slot;
+        }
+    }
+
+    // Tiles that left the view go first when a slot outgrows its region
+    const std::size_t slot_layers = GetFrameSlotLayersLocked();
+    for (const auto& slot : series.slots) {
+        slot->TrimTiles(series.visible, slot_layers);
+    }
+}
+
+void TileTextureCoordinator::RequestTimeSeriesTiles(std::span<const TileCoordinates> tiles,
+                                                    int priority) {
+    std::lock_guard<std::mutex> lock(time_series_mutex_);
+    TimeSeriesLayer& series = *time_series_;
+    const std::size_t slot_layers = GetFrameSlotLayersLocked();
+
+    for (std::size_t slot = 0; slot < series.slots.size(); ++slot) {
+        const auto distance = GetFrameDistanceLocked(series.slot_frames[slot]);
+        if (!distance) {
+            continue;  // Waits to be handed to a frame of the window
+        }
+        TileTextureCoordinator& layer = *series.slots[slot];
+        // Frames ahead only load while their region has room; the shown one always does
+        if (*distance > 0 && layer.GetTileCount() >= slot_layers) {
+            continue;
+        }
+        layer.RequestTiles(tiles, priority +
+                                  static_cast<int>(*distance) * kTimeSeriesFramePriorityStep);
+    }
+}
+
+std::size_t TileTextureCoordinator::GetTileCount() const {
+    std::shared_lock<std::shared_mutex> lock(state_mutex_);
+    return tile_states_.size();
+}
+
+void TileTextureCoordinator::TrimTiles(const TileSet& keep, std::size_t max_tiles) {
+    std::vector<TileCoordinates> victims;
+    {
+        std::shared_lock<std::shared_mutex> lock(state_mutex_);
+        if (tile_states_.size() <= max_tiles) {
+            return;
+        }
+        std::size_t excess = tile_states_.size() - max_tiles;
+        for (const auto& [coords, state] : tile_states_) {
+            if (excess == 0) {
+                break;
+            }
+            if (state.status == TileStatus::Loaded && !keep.contains(coords)) {
+                victims.push_back(coords);
+                --excess;
+            }
+        }
+    }
+    for (const TileCoordinates& coords : victims) {
+        EvictPoolTile(coords);
+    }
+}
+
 void TileTextureCoordinator::OnTileLoadComplete(const TileCoordinates& coords) {
     spdlog::trace("Tile {} load complete, queued for upload", coords.GetKey());
 }
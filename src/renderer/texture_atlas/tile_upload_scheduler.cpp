@@ -0,0 +1,240 @@
+/**
+ * @file tile_upload_scheduler.cpp
+ * @brief Implementation of the time-budgeted tile upload scheduler
+ */
+
+#include <earth_map/renderer/texture_atlas/tile_upload_scheduler.h>
+#include <GL/glew.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cstdlib>
+
+namespace earth_map {
+
+namespace {
+
+double ElapsedUs(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double, std::micro>(
+        std::chrono::steady_clock::now() - since).count();
+}
+
+} // namespace
+
+TileUploadScheduler::TileUploadScheduler(const TileUploadSchedulerConfig& config,
+                                         bool skip_gl_init)
+    : config_(config)
+    , use_timer_queries_(!skip_gl_init)
+    , cpu_cost_us_(config.initial_upload_cost_us)
+    , window_start_(std::chrono::steady_clock::now()) {
+
+    config_.cost_smoothing = std::clamp(config_.cost_smoothing, 0.01, 1.0);
+
+    if (use_timer_queries_) {
+        for (auto& query : queries_) {
+            glGenQueries(1, &query.id);
+        }
+    }
+}
+
+TileUploadScheduler::~TileUploadScheduler() {
+    if (!use_timer_queries_) {
+        return;
+    }
+    for (auto& query : queries_) {
+        if (query.id != 0) {
+            glDeleteQueries(1, &query.id);
+        }
+    }
+}
+
+void TileUploadScheduler::SetFocus(const TileCoordinates& focus) {
+    focus_ = focus;
+}
+
+std::uint64_t TileUploadScheduler::PriorityKey(const TileCoordinates& coords) const {
+    const std::int32_t zoom = std::clamp(coords.zoom, 0, 30);
+    const std::int32_t focus_zoom = std::clamp(focus_.zoom, 0, 30);
+
+    // Focus tile projected to the zoom of the candidate
+    std::int64_t focus_x = focus_.x;
+    std::int64_t focus_y = focus_.y;
+    if (zoom <= focus_zoom) {
+        focus_x >>= (focus_zoom - zoom);
+        focus_y >>= (focus_zoom - zoom);
+    } else {
+        const int shift = zoom - focus_zoom;
+        const std::int64_t half = (std::int64_t{1} << shift) >> 1;
+        focus_x = (focus_x << shift) + half;
+        focus_y = (focus_y << shift) + half;
+    }
+
+    // Chebyshev distance in tiles, wrapping around the antimeridian
+    const std::int64_t n = std::int64_t{1} << zoom;
+    std::int64_t dx = std::llabs(coords.x - focus_x);
+    dx = std::min(dx, n - dx);
+    const std::int64_t dy = std::llabs(coords.y - focus_y);
+    const std::uint64_t distance = static_cast<std::uint64_t>(std::max<std::int64_t>(
+        0, std::max(dx, dy)));
+
+    return (static_cast<std::uint64_t>(zoom) << 40) |
+           std::min<std::uint64_t>(distance, (std::uint64_t{1} << 40) - 1);
+}
+
+std::size_t TileUploadScheduler::RunFrame(GLUploadQueue& queue,
+                                          std::chrono::microseconds budget,
+                                          const UploadFn& upload) {
+    CollectTimerQueries();
+
+    // One batch pop for everything workers queued since the last frame
+    queue.TryPopN(staged_, queue.Capacity());
+
+    // Failed loads carry no pixels: report them right away, outside the budget
+    std::size_t handled = 0;
+    auto failures = std::stable_partition(staged_.begin(), staged_.end(),
+        [](const std::unique_ptr<GLUploadCommand>& cmd) { return cmd->slot.IsValid(); });
+    for (auto it = failures; it != staged_.end(); ++it) {
+        upload(**it);
+        ++handled;
+    }
+    Retire(failures, staged_.end());
+
+    if (staged_.empty()) {
+        uploads_last_frame_ = 0;
+        UpdateRate(0);
+        return handled;
+    }
+
+    std::stable_sort(staged_.begin(), staged_.end(),
+        [this](const std::unique_ptr<GLUploadCommand>& a,
+               const std::unique_ptr<GLUploadCommand>& b) {
+            return PriorityKey(a->coords) < PriorityKey(b->coords);
+        });
+
+    TimerQuery* query = nullptr;
+    if (use_timer_queries_ && !queries_[next_query_].pending && queries_[next_query_].id != 0) {
+        query = &queries_[next_query_];
+        glBeginQuery(GL_TIME_ELAPSED, query->id);
+    }
+
+    const double budget_us = static_cast<double>(budget.count());
+    const auto frame_start = std::chrono::steady_clock::now();
+    std::size_t uploaded = 0;
+
+    while (uploaded < staged_.size()) {
+        const double estimate_us = std::max(cpu_cost_us_, gpu_cost_us_);
+        if (uploaded > 0 && ElapsedUs(frame_start) + estimate_us > budget_us) {
+            break;
+        }
+
+        const auto upload_start = std::chrono::steady_clock::now();
+        upload(*staged_[uploaded]);
+        RecordCost(ElapsedUs(upload_start), cpu_cost_us_);
+        ++uploaded;
+    }
+
+    Retire(staged_.begin(), staged_.begin() + static_cast<std::ptrdiff_t>(uploaded));
+
+    const double frame_us = ElapsedUs(frame_start);
+    const bool overrun = frame_us > budget_us;
+    if (overrun) {
+        ++budget_overruns_;
+        spdlog::trace("Upload budget overrun: {:.0f} us for {} uploads (budget {} us)",
+                      frame_us, uploaded, budget.count());
+    }
+
+    if (query) {
+        glEndQuery(GL_TIME_ELAPSED);
+        query->uploads = uploaded;
+        query->budget_us = budget.count();
+        query->cpu_overrun = overrun;
+        query->pending = true;
+        next_query_ = (next_query_ + 1) % kTimerQueryCount;
+    }
+
+    total_uploads_ += uploaded;
+    uploads_last_frame_ = uploaded;
+    UpdateRate(uploaded);
+
+    return handled + uploaded;
+}
+
+void TileUploadScheduler::Retire(std::vector<std::unique_ptr<GLUploadCommand>>::iterator first,
+                                 std::vector<std::unique_ptr<GLUploadCommand>>::iterator last) {
+    if (recycle_) {
+        for (auto it = first; it != last; ++it) {
+            recycle_(std::move(*it));
+        }
+    }
+    staged_.erase(first, last);
+}
+
+void TileUploadScheduler::CollectTimerQueries() {
+    if (!use_timer_queries_) {
+        return;
+    }
+
+    // Oldest query first; later ones cannot be ready before it
+    for (std::size_t i = 0; i < kTimerQueryCount; ++i) {
+        TimerQuery& query = queries_[(next_query_ + i) % kTimerQueryCount];
+        if (!query.pending) {
+            continue;
+        }
+
+        GLuint available = GL_FALSE;
+        glGetQueryObjectuiv(query.id, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE) {
+            break;
+        }
+
+        GLuint64 elapsed_ns = 0;
+        glGetQueryObjectui64v(query.id, GL_QUERY_RESULT, &elapsed_ns);
+        query.pending = false;
+
+        const double elapsed_us = static_cast<double>(elapsed_ns) / 1000.0;
+        if (query.uploads > 0) {
+            RecordCost(elapsed_us / static_cast<double>(query.uploads), gpu_cost_us_);
+        }
+
+        // Count the frame once, whichever clock noticed the overrun
+        if (!query.cpu_overrun && elapsed_us > static_cast<double>(query.budget_us)) {
+            ++budget_overruns_;
+        }
+    }
+}
+
+void TileUploadScheduler::RecordCost(double sample_us, double& average_us) const {
+    if (average_us <= 0.0) {
+        average_us = sample_us;
+        return;
+    }
+    average_us += config_.cost_smoothing * (sample_us - average_us);
+}
+
+void TileUploadScheduler::UpdateRate(std::size_t uploads) {
+    window_uploads_ += uploads;
+
+    const auto now = std::chrono::steady_clock::now();
+    const auto window = now - window_start_;
+    if (window < config_.rate_window) {
+        return;
+    }
+
+    uploads_per_second_ = static_cast<double>(window_uploads_) /
+                          std::chrono::duration<double>(window).count();
+    window_uploads_ = 0;
+    window_start_ = now;
+}
+
+TileUploadStats TileUploadScheduler::GetStats() const {
+    TileUploadStats stats;
+    stats.uploads_per_second = uploads_per_second_;
+    stats.uploads_last_frame = uploads_last_frame_;
+    stats.total_uploads = total_uploads_;
+    stats.budget_overruns = budget_overruns_;
+    stats.estimated_upload_cost_us = std::max(cpu_cost_us_, gpu_cost_us_);
+    stats.gpu_upload_cost_us = gpu_cost_us_;
+    stats.staged_uploads = staged_.size();
+    return stats;
+}
+
+} // namespace earth_map
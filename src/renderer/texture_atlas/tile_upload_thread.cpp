@@ -0,0 +1,146 @@
+/**
+ * @file tile_upload_thread.cpp
+ * @brief Implementation of the shared-context tile upload thread
+ */
+
+#include <earth_map/renderer/texture_atlas/tile_upload_thread.h>
+#include <GL/glew.h>
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+
+namespace earth_map {
+
+TileUploadThread::TileUploadThread(std::unique_ptr<OpenGLContext> context, BatchFn batch,
+                                   bool skip_gl_init)
+    : context_(std::move(context))
+    , batch_(std::move(batch))
+    , skip_gl_init_(skip_gl_init) {
+    if (!batch_) {
+        throw std::invalid_argument("TileUploadThread: batch function must not be empty");
+    }
+    thread_ = std::thread(&TileUploadThread::Run, this);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return started_; });
+}
+
+TileUploadThread::~TileUploadThread() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    // Sync objects are shared: the caller's context can delete them
+    if (!skip_gl_init_) {
+        for (const Batch& batch : batches_) {
+            if (batch.fence != nullptr) {
+                glDeleteSync(static_cast<GLsync>(batch.fence));
+            }
+        }
+    }
+}
+
+void TileUploadThread::Run() {
+    const bool has_context =
+        context_ ? context_->MakeCurrent() : skip_gl_init_;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        started_ = true;
+        running_ = has_context;
+    }
+    cv_.notify_all();
+    if (!has_context) {
+        spdlog::error("TileUploadThread: could not make the upload context current");
+        return;
+    }
+    spdlog::info("Tile upload thread started");
+
+    std::vector<CompletedTileUpload> uploads;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stop_) {
+                break;
+            }
+        }
+
+        uploads.clear();
+        const bool worked = batch_(uploads);
+
+        if (!uploads.empty()) {
+            void* fence = nullptr;
+            if (!skip_gl_init_) {
+                fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                if (fence == nullptr) {
+                    // Cannot track completion: wait here instead of on the render thread
+                    glFinish();
+                } else {
+                    // The fence must reach the GPU before another context can wait on it
+                    glFlush();
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            batches_.push_back(Batch{fence, std::move(uploads)});
+            ++batch_count_;
+            uploads = {};
+        }
+
+        if (!worked) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait_for(lock, kIdleWait, [this] { return stop_; });
+        }
+    }
+
+    if (context_) {
+        context_->ReleaseCurrent();
+    }
+    spdlog::info("Tile upload thread stopped");
+}
+
+std::size_t TileUploadThread::Publish(const PublishFn& publish) {
+    std::vector<Batch> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Fences signal in submission order: stop at the first pending one
+        while (!batches_.empty()) {
+            Batch& front = batches_.front();
+            if (front.fence != nullptr && !skip_gl_init_) {
+                const GLenum status =
+                    glClientWaitSync(static_cast<GLsync>(front.fence), 0, 0);
+                if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED &&
+                    status != GL_WAIT_FAILED) {
+                    break;
+                }
+                glDeleteSync(static_cast<GLsync>(front.fence));
+            }
+            ready.push_back(std::move(front));
+            batches_.pop_front();
+        }
+    }
+
+    std::size_t published = 0;
+    for (Batch& batch : ready) {
+        for (CompletedTileUpload& upload : batch.uploads) {
+            publish(upload);
+            ++published;
+        }
+    }
+    return published;
+}
+
+std::size_t TileUploadThread::GetPendingBatchCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return batches_.size();
+}
+
+std::uint64_t TileUploadThread::GetBatchCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return batch_count_;
+}
+
+} // namespace earth_map
@@ -0,0 +1,337 @@
+/**
+ * @file tile_feedback_pass.cpp
+ * @brief GPU tile feedback pass implementation
+ */
+
+#include <earth_map/renderer/tile_feedback_pass.h>
+#include <earth_map/renderer/shader_loader.h>
+#include <GL/glew.h>
+#include <glm/gtc/type_ptr.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <unordered_map>
+
+namespace earth_map {
+
+namespace {
+
+/// Bit position of (zoom + 1) in the G channel
+constexpr std::uint32_t kZoomShift = 24;
+constexpr std::uint32_t kRowMask = (1u << kZoomShift) - 1u;
+
+constexpr const char* kFeedbackVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 aPos;
+
+uniform mat4 uView;
+uniform mat4 uProjection;
+
+out vec3 WorldPos;
+
+void main() {
+    WorldPos = aPos;
+    gl_Position = uProjection * uView * vec4(aPos, 1.0);
+}
+)";
+
+constexpr const char* kFeedbackFragmentShader = R"(
+#version 330 core
+in vec3 WorldPos;
+
+layout (location = 0) out uvec2 Feedback;
+
+uniform int uMinZoom;
+uniform int uMaxZoom;
+uniform float uLodBias;
+uniform float uPixelScale;
+uniform float uTileSize;
+
+const float PI = 3.14159265359;
+const float MAX_MERCATOR_LAT = 1.4844222;  // 85.0511 degrees
+
+vec2 worldToMercator(vec3 pos) {
+    vec3 n = normalize(pos);
+    float lon = atan(n.x, n.z);
+    float lat = clamp(asin(n.y), -MAX_MERCATOR_LAT, MAX_MERCATOR_LAT);
+    return vec2(lon / (2.0 * PI) + 0.5,
+                (1.0 - log(tan(PI / 4.0 + lat / 2.0)) / PI) / 2.0);
+}
+
+void main() {
+    vec2 uv = worldToMercator(WorldPos);
+
+    // Mercator units per full-resolution pixel; longitude wraps at the antimeridian
+    vec2 dx = dFdx(uv);
+    vec2 dy = dFdy(uv);
+    dx.x -= round(dx.x);
+    dy.x -= round(dy.x);
+    float footprint = max(length(dx), length(dy)) / uPixelScale;
+
+    // Zoom at which one texel covers about one pixel
+    float ideal = -log2(max(footprint * uTileSize, 1e-12));
+    int zoom = clamp(int(floor(ideal + 0.5 + uLodBias)), uMinZoom, uMaxZoom);
+
+    int n = 1 << zoom;
+    ivec2 tile = clamp(ivec2(floor(uv * float(n))), ivec2(0), ivec2(n - 1));
+    Feedback = uvec2(uint(tile.x), uint(tile.y) | (uint(zoom + 1) << 24));
+}
+)";
+
+} // namespace
+
+TileFeedbackPass::~TileFeedbackPass() {
+    Release();
+}
+
+bool TileFeedbackPass::Initialize(const TileFeedbackConfig& config) {
+    config_ = config;
+    if (program_ != 0) {
+        return true;
+    }
+
+    program_ = ShaderLoader::CreateProgram(
+        kFeedbackVertexShader, kFeedbackFragmentShader, "tile_feedback");
+    if (program_ == 0) {
+        spdlog::error("TileFeedbackPass: failed to create feedback shader program");
+        return false;
+    }
+
+    view_location_ = glGetUniformLocation(program_, "uView");
+    projection_location_ = glGetUniformLocation(program_, "uProjection");
+    min_zoom_location_ = glGetUniformLocation(program_, "uMinZoom");
+    max_zoom_location_ = glGetUniformLocation(program_, "uMaxZoom");
+    lod_bias_location_ = glGetUniformLocation(program_, "uLodBias");
+    pixel_scale_location_ = glGetUniformLocation(program_, "uPixelScale");
+    tile_size_location_ = glGetUniformLocation(program_, "uTileSize");
+    return true;
+}
+
+void TileFeedbackPass::Release() {
+    for (Readback& readback : readbacks_) {
+        if (readback.fence != nullptr) {
+            glDeleteSync(static_cast<GLsync>(readback.fence));
+        }
+        if (readback.buffer != 0) {
+            glDeleteBuffers(1, &readback.buffer);
+        }
+        readback = Readback{};
+    }
+    if (framebuffer_ != 0) {
+        glDeleteFramebuffers(1, &framebuffer_);
+        framebuffer_ = 0;
+    }
+    if (color_texture_ != 0) {
+        glDeleteTextures(1, &color_texture_);
+        color_texture_ = 0;
+    }
+    if (depth_buffer_ != 0) {
+        glDeleteRenderbuffers(1, &depth_buffer_);
+        depth_buffer_ = 0;
+    }
+    if (program_ != 0) {
+        glDeleteProgram(program_);
+        program_ = 0;
+    }
+    target_width_ = 0;
+    target_height_ = 0;
+}
+
+bool TileFeedbackPass::EnsureTarget(std::uint32_t width, std::uint32_t height) {
+    if (framebuffer_ != 0 && width == target_width_ && height == target_height_) {
+        return true;
+    }
+
+    if (framebuffer_ == 0) {
+        glGenFramebuffers(1, &framebuffer_);
+        glGenTextures(1, &color_texture_);
+        glGenRenderbuffers(1, &depth_buffer_);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, color_texture_);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RG32UI, static_cast<GLsizei>(width),
+                 static_cast<GLsizei>(height), 0, GL_RG_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, depth_buffer_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, static_cast<GLsizei>(width),
+                          static_cast<GLsizei>(height));
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, color_texture_, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depth_buffer_);
+    const GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        spdlog::error("TileFeedbackPass: feedback framebuffer incomplete (0x{:x})", status);
+        target_width_ = 0;
+        target_height_ = 0;
+        return false;
+    }
+
+    target_width_ = width;
+    target_height_ = height;
+    spdlog::debug("TileFeedbackPass: feedback target {}x{}", width, height);
+    return true;
+}
+
+void TileFeedbackPass::Render(const GPUMesh& globe,
+                              const glm::mat4& view_matrix, const glm::mat4& projection_matrix,
+                              std::int32_t min_zoom, std::int32_t max_zoom) {
+    if (program_ == 0 || globe.vao == 0 || globe.index_count == 0) {
+        return;
+    }
+
+    GLint previous_framebuffer = 0;
+    GLint previous_viewport[4] = {0, 0, 0, 0};
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previous_framebuffer);
+    glGetIntegerv(GL_VIEWPORT, previous_viewport);
+
+    const std::uint32_t downscale = std::max<std::uint32_t>(config_.downscale, 1);
+    const std::uint32_t width = std::max<std::uint32_t>(
+        static_cast<std::uint32_t>(std::max(previous_viewport[2], 1)) / downscale, 1);
+    const std::uint32_t height = std::max<std::uint32_t>(
+        static_cast<std::uint32_t>(std::max(previous_viewport[3], 1)) / downscale, 1);
+
+    if (EnsureTarget(width, height)) {
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer_);
+        glViewport(0, 0, static_cast<GLsizei>(width), static_cast<GLsizei>(height));
+
+        const GLuint clear_color[4] = {0, 0, 0, 0};
+        glClearBufferuiv(GL_COLOR, 0, clear_color);
+        glClear(GL_DEPTH_BUFFER_BIT);
+
+        glUseProgram(program_);
+        glUniformMatrix4fv(view_location_, 1, GL_FALSE, glm::value_ptr(view_matrix));
+        glUniformMatrix4fv(projection_location_, 1, GL_FALSE, glm::value_ptr(projection_matrix));
+        glUniform1i(min_zoom_location_, std::min(min_zoom, max_zoom));
+        glUniform1i(max_zoom_location_, max_zoom);
+        glUniform1f(lod_bias_location_, config_.lod_bias);
+        glUniform1f(pixel_scale_location_, static_cast<float>(downscale));
+        glUniform1f(tile_size_location_, static_cast<float>(std::max<std::uint32_t>(config_.tile_size, 1)));
+
+        glBindVertexArray(globe.vao);
+        GPUResourceManager::DrawGlobeMesh(globe);
+        glBindVertexArray(0);
+
+        QueueReadback();
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, static_cast<GLuint>(previous_framebuffer));
+    glViewport(previous_viewport[0], previous_viewport[1], previous_viewport[2], previous_viewport[3]);
+}
+
+void TileFeedbackPass::QueueReadback() {
+    Readback& readback = readbacks_[next_readback_];
+    if (readback.fence != nullptr) {
+        // Every buffer still waits for the GPU: skip this frame's readback
+        // rather than stall on it
+        return;
+    }
+    next_readback_ = (next_readback_ + 1) % kReadbackDepth;
+
+    const std::size_t texel_count = static_cast<std::size_t>(target_width_) * target_height_;
+    const std::size_t bytes = texel_count * 2 * sizeof(std::uint32_t);
+
+    if (readback.buffer == 0) {
+        glGenBuffers(1, &readback.buffer);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+    if (readback.capacity < bytes) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_READ);
+        readback.capacity = bytes;
+    }
+
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glReadPixels(0, 0, static_cast<GLsizei>(target_width_), static_cast<GLsizei>(target_height_),
+                 GL_RG_INTEGER, GL_UNSIGNED_INT, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    readback.texel_count = texel_count;
+    readback.sequence = next_sequence_++;
+    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+bool TileFeedbackPass::Collect(std::vector<TileCoordinates>& tiles) {
+    // Retire every finished readback; only the newest one is decoded
+    Readback* newest = nullptr;
+    for (Readback& readback : readbacks_) {
+        if (readback.fence == nullptr) {
+            continue;
+        }
+        GLsync fence = static_cast<GLsync>(readback.fence);
+        const GLenum status = glClientWaitSync(fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            continue;
+        }
+        glDeleteSync(fence);
+        readback.fence = nullptr;
+
+        if (readback.sequence > last_collected_sequence_ &&
+            (newest == nullptr || readback.sequence > newest->sequence)) {
+            newest = &readback;
+        }
+    }
+    if (newest == nullptr) {
+        return false;
+    }
+    last_collected_sequence_ = newest->sequence;
+
+    const std::size_t bytes = newest->texel_count * 2 * sizeof(std::uint32_t);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, newest->buffer);
+    const void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0,
+                                        static_cast<GLsizeiptr>(bytes), GL_MAP_READ_BIT);
+    bool collected = false;
+    if (data != nullptr) {
+        DecodeTexels({static_cast<const std::uint32_t*>(data), newest->texel_count * 2}, tiles);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        collected = true;
+    } else {
+        spdlog::warn("TileFeedbackPass: failed to map feedback readback");
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return collected;
+}
+
+std::array<std::uint32_t, 2> TileFeedbackPass::EncodeTexel(const TileCoordinates& tile) {
+    return {static_cast<std::uint32_t>(tile.x),
+            (static_cast<std::uint32_t>(tile.y) & kRowMask) |
+                (static_cast<std::uint32_t>(tile.zoom + 1) << kZoomShift)};
+}
+
+void TileFeedbackPass::DecodeTexels(std::span<const std::uint32_t> texels,
+                                    std::vector<TileCoordinates>& tiles) {
+    std::unordered_map<TileCoordinates, std::uint32_t, TileCoordinatesHash> coverage;
+    for (std::size_t i = 0; i + 1 < texels.size(); i += 2) {
+        const std::uint32_t zoom_plus_one = texels[i + 1] >> kZoomShift;
+        if (zoom_plus_one == 0) {
+            continue;  // Background
+        }
+        const TileCoordinates tile(static_cast<std::int32_t>(texels[i]),
+                                   static_cast<std::int32_t>(texels[i + 1] & kRowMask),
+                                   static_cast<std::int32_t>(zoom_plus_one) - 1);
+        if (tile.IsValid()) {
+            ++coverage[tile];
+        }
+    }
+
+    std::vector<std::pair<TileCoordinates, std::uint32_t>> ranked(coverage.begin(), coverage.end());
+    std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) {
+        if (a.second != b.second) {
+            return a.second > b.second;
+        }
+        if (a.first.zoom != b.first.zoom) {
+            return a.first.zoom > b.first.zoom;
+        }
+        return a.first.y != b.first.y ? a.first.y < b.first.y : a.first.x < b.first.x;
+    });
+
+    tiles.clear();
+    tiles.reserve(ranked.size());
+    for (const auto& entry : ranked) {
+        tiles.push_back(entry.first);
+    }
+}
+
+} // namespace earth_map
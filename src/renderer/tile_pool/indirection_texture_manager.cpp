@@ -5,6 +5,7 @@
 
 #include <earth_map/renderer/tile_pool/indirection_texture_manager.h>
 #include <GL/glew.h>
+#include <glm/common.hpp>
 #include <spdlog/spdlog.h>
 #include <algorithm>
 #include <cstring>
@@ -48,10 +49,13 @@ IndirectionTextureManager::~IndirectionTextureManager() {
         if (dummy_texture_id_ != 0) {
             glDeleteTextures(1, &dummy_texture_id_);
         }
+        if (upload_buffer_ != 0) {
+            glDeleteBuffers(1, &upload_buffer_);
+        }
     }
 }
 
-void IndirectionTextureManager::CreateZoomTexture(int zoom) {
+void IndirectionTextureManager::CreateZoomTexture(int zoom, glm::ivec2 window_offset) {
     if (zoom < 0 || zoom > 30) {
         spdlog::error("IndirectionTextureManager: zoom {} out of valid range [0, 30]", zoom);
         return;
@@ -70,8 +74,24 @@ void IndirectionTextureManager::CreateZoomTexture(int zoom) {
         zt.height = dim;
     }
 
-    // Allocate CPU-side data initialized to kInvalidLayer
+    if (zt.windowed) {
+        zt.window_offset = window_offset;
+    }
+
+    // Allocate CPU-side data initialized to kInvalidLayer, and resolve the
+    // new level against tiles already loaded at coarser zooms
     zt.data.resize(zt.width * zt.height, kInvalidLayer);
+    zt.resolved.resize(zt.width * zt.height, kInvalidLayer);
+    zt.blocks_x = (zt.width + kDirtyBlockSize - 1) / kDirtyBlockSize;
+    zt.blocks_y = (zt.height + kDirtyBlockSize - 1) / kDirtyBlockSize;
+    zt.dirty_blocks.assign(zt.blocks_x * zt.blocks_y, 0);
+    const glm::ivec2 first_tile = zt.windowed ? zt.window_offset : glm::ivec2(0);
+    ResolveRegion(zt, first_tile,
+                  first_tile + glm::ivec2(static_cast<int>(zt.width), static_cast<int>(zt.height)));
+
+    // The initial image below carries the resolved entries
+    std::fill(zt.dirty_blocks.begin(), zt.dirty_blocks.end(), 0);
+    zt.dirty = false;
 
     // Allocate GL texture
     if (!skip_gl_init_) {
@@ -87,7 +107,7 @@ void IndirectionTextureManager::CreateZoomTexture(int zoom) {
             0,
             GL_RED_INTEGER,
             GL_UNSIGNED_SHORT,
-            zt.data.data());
+            zt.resolved.data());
 
         // Integer textures must use NEAREST filtering
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -107,15 +127,246 @@ void IndirectionTextureManager::CreateZoomTexture(int zoom) {
 void IndirectionTextureManager::ClearZoomTextureData(ZoomTexture& zt) {
     std::fill(zt.data.begin(), zt.data.end(), kInvalidLayer);
 
-    if (!skip_gl_init_ && zt.texture_id != 0) {
-        glBindTexture(GL_TEXTURE_2D, zt.texture_id);
-        glTexSubImage2D(
-            GL_TEXTURE_2D, 0, 0, 0,
-            static_cast<GLsizei>(zt.width),
-            static_cast<GLsizei>(zt.height),
-            GL_RED_INTEGER, GL_UNSIGNED_SHORT,
-            zt.data.data());
-        glBindTexture(GL_TEXTURE_2D, 0);
+    // Coarser levels may still cover the tiles
+    const glm::ivec2 first_tile = zt.windowed ? zt.window_offset : glm::ivec2(0);
+    ResolveRegion(zt, first_tile,
+                  first_tile + glm::ivec2(static_cast<int>(zt.width), static_cast<int>(zt.height)));
+}
+
+void IndirectionTextureManager::ResetTiles(ZoomTexture& zt, glm::ivec2 lo, glm::ivec2 hi) {
+    for (int y = lo.y; y < hi.y; ++y) {
+        for (int x = lo.x; x < hi.x; ++x) {
+            if (IsTileInWindow(zt, x, y)) {
+                const glm::ivec2 texel = TileToTexel(zt, x, y);
+                zt.data[texel.y * zt.width + texel.x] = kInvalidLayer;
+            }
+        }
+    }
+    ResolveRegion(zt, lo, hi);
+}
+
+void IndirectionTextureManager::ResolveRegion(ZoomTexture& zt, glm::ivec2 lo, glm::ivec2 hi) {
+    const glm::ivec2 size(static_cast<int>(zt.width), static_cast<int>(zt.height));
+    const glm::ivec2 window_lo = zt.windowed ? zt.window_offset : glm::ivec2(0);
+    lo = glm::max(lo, window_lo);
+    hi = glm::min(hi, window_lo + size);
+    if (lo.x >= hi.x || lo.y >= hi.y) {
+        return;
+    }
+
+    // Split at the wrap-around of toroidal addressing so that each piece
+    // maps onto a contiguous texel rectangle (full levels never wrap)
+    const glm::ivec2 seam = lo - TileToTexel(zt, lo.x, lo.y) + size;
+    const int xs[3] = {lo.x, std::min(hi.x, seam.x), hi.x};
+    const int ys[3] = {lo.y, std::min(hi.y, seam.y), hi.y};
+
+    for (int py = 0; py < 2; ++py) {
+        for (int px = 0; px < 2; ++px) {
+            const glm::ivec2 piece_lo(xs[px], ys[py]);
+            const glm::ivec2 piece_hi(xs[px + 1], ys[py + 1]);
+            if (piece_lo.x >= piece_hi.x || piece_lo.y >= piece_hi.y) {
+                continue;
+            }
+            const glm::ivec2 shift = TileToTexel(zt, piece_lo.x, piece_lo.y) - piece_lo;
+
+            for (int y = piece_lo.y; y < piece_hi.y; ++y) {
+                std::fill_n(zt.resolved.begin() + ((y + shift.y) * size.x + piece_lo.x + shift.x),
+                            piece_hi.x - piece_lo.x, kInvalidLayer);
+            }
+
+            // Coarsest first, so finer tiles overwrite what their ancestors wrote
+            for (int up = std::min(kMaxAncestorDepth, zt.zoom); up >= 0; --up) {
+                const ZoomTexture* source = &zt;
+                if (up > 0) {
+                    auto it = zoom_textures_.find(zt.zoom - up);
+                    if (it == zoom_textures_.end()) {
+                        continue;
+                    }
+                    source = &it->second;
+                }
+
+                // Source tiles over the piece (arithmetic shift floors
+                // negative window coordinates too), limited to the source window
+                const glm::ivec2 source_lo = source->windowed ? source->window_offset : glm::ivec2(0);
+                const glm::ivec2 first = glm::max(piece_lo >> up, source_lo);
+                const glm::ivec2 last = glm::min(
+                    ((piece_hi - 1) >> up) + 1,
+                    source_lo + glm::ivec2(static_cast<int>(source->width),
+                                           static_cast<int>(source->height)));
+
+                const int span = 1 << up;
+                for (int ay = first.y; ay < last.y; ++ay) {
+                    for (int ax = first.x; ax < last.x; ++ax) {
+                        const glm::ivec2 source_texel = TileToTexel(*source, ax, ay);
+                        const std::uint16_t layer =
+                            source->data[source_texel.y * source->width + source_texel.x];
+                        if (layer == kInvalidLayer) {
+                            continue;
+                        }
+
+                        const std::uint16_t entry = EncodeResolved(layer, up);
+                        const int x0 = std::max(ax * span, piece_lo.x) + shift.x;
+                        const int x1 = std::min((ax + 1) * span, piece_hi.x) + shift.x;
+                        const int y0 = std::max(ay * span, piece_lo.y) + shift.y;
+                        const int y1 = std::min((ay + 1) * span, piece_hi.y) + shift.y;
+                        for (int y = y0; y < y1; ++y) {
+                            std::fill_n(zt.resolved.begin() + (y * size.x + x0), x1 - x0, entry);
+                        }
+                    }
+                }
+            }
+
+            MarkDirty(zt, piece_lo + shift, piece_hi + shift);
+        }
+    }
+}
+
+void IndirectionTextureManager::MarkDirty(ZoomTexture& zt, glm::ivec2 lo, glm::ivec2 hi) {
+    const int block = static_cast<int>(kDirtyBlockSize);
+    for (int by = lo.y / block; by <= (hi.y - 1) / block; ++by) {
+        for (int bx = lo.x / block; bx <= (hi.x - 1) / block; ++bx) {
+            zt.dirty_blocks[by * zt.blocks_x + bx] = 1;
+        }
+    }
+    zt.dirty = true;
+}
+
+void IndirectionTextureManager::CollectDirtyRects(ZoomTexture& zt, std::vector<UploadRect>& rects) {
+    // Runs of dirty blocks along each block row; a run with the same extent
+    // as one in the row above extends that rectangle downward
+    struct OpenRect {
+        int bx0;
+        int bx1;
+        int by0;
+    };
+    std::vector<OpenRect> open;
+    std::vector<OpenRect> next;
+
+    const int block = static_cast<int>(kDirtyBlockSize);
+    const glm::ivec2 size(static_cast<int>(zt.width), static_cast<int>(zt.height));
+    const auto emit = [&](const OpenRect& r, int by_end) {
+        rects.push_back({&zt, {r.bx0 * block, r.by0 * block},
+                         glm::min(glm::ivec2(r.bx1 * block, by_end * block), size)});
+    };
+
+    const int blocks_x = static_cast<int>(zt.blocks_x);
+    const int blocks_y = static_cast<int>(zt.blocks_y);
+    for (int by = 0; by <= blocks_y; ++by) {
+        next.clear();
+        for (int bx = 0; by < blocks_y && bx < blocks_x; ++bx) {
+            if (!zt.dirty_blocks[by * blocks_x + bx]) {
+                continue;
+            }
+            const int bx0 = bx;
+            while (bx < blocks_x && zt.dirty_blocks[by * blocks_x + bx]) {
+                ++bx;
+            }
+            auto it = std::find_if(open.begin(), open.end(), [&](const OpenRect& r) {
+                return r.bx0 == bx0 && r.bx1 == bx;
+            });
+            if (it != open.end()) {
+                next.push_back(*it);
+                it->bx1 = -1;  // Continued
+            } else {
+                next.push_back({bx0, bx, by});
+            }
+        }
+        for (const OpenRect& r : open) {
+            if (r.bx1 >= 0) {
+                emit(r, by);
+            }
+        }
+        std::swap(open, next);
+    }
+
+    std::fill(zt.dirty_blocks.begin(), zt.dirty_blocks.end(), 0);
+    zt.dirty = false;
+}
+
+std::size_t IndirectionTextureManager::FlushUploads() {
+    upload_rects_.clear();
+    for (auto& [zoom, zt] : zoom_textures_) {
+        if (zt.dirty) {
+            CollectDirtyRects(zt, upload_rects_);
+        }
+    }
+
+    std::size_t texels = 0;
+    for (const UploadRect& rect : upload_rects_) {
+        const glm::ivec2 extent = rect.hi - rect.lo;
+        texels += static_cast<std::size_t>(extent.x) * extent.y;
+    }
+    if (upload_rects_.empty() || skip_gl_init_) {
+        return texels;
+    }
+
+    // Pack every rectangle into one orphaned unpack buffer, then issue the
+    // texture updates from it
+    if (upload_buffer_ == 0) {
+        glGenBuffers(1, &upload_buffer_);
+    }
+    const std::size_t bytes = texels * sizeof(std::uint16_t);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, upload_buffer_);
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr, GL_STREAM_DRAW);
+    auto* staging = static_cast<std::uint16_t*>(glMapBufferRange(
+        GL_PIXEL_UNPACK_BUFFER, 0, static_cast<GLsizeiptr>(bytes),
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+
+    if (staging != nullptr) {
+        std::vector<std::size_t> offsets;
+        offsets.reserve(upload_rects_.size());
+        std::size_t offset = 0;
+        for (const UploadRect& rect : upload_rects_) {
+            offsets.push_back(offset);
+            const int width = rect.hi.x - rect.lo.x;
+            for (int y = rect.lo.y; y < rect.hi.y; ++y) {
+                std::memcpy(staging + offset,
+                            &rect.texture->resolved[y * rect.texture->width + rect.lo.x],
+                            width * sizeof(std::uint16_t));
+                offset += width;
+            }
+        }
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+        for (std::size_t i = 0; i < upload_rects_.size(); ++i) {
+            const UploadRect& rect = upload_rects_[i];
+            glBindTexture(GL_TEXTURE_2D, rect.texture->texture_id);
+            glTexSubImage2D(
+                GL_TEXTURE_2D, 0,
+                rect.lo.x, rect.lo.y, rect.hi.x - rect.lo.x, rect.hi.y - rect.lo.y,
+                GL_RED_INTEGER, GL_UNSIGNED_SHORT,
+                reinterpret_cast<const void*>(offsets[i] * sizeof(std::uint16_t)));
+        }
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    } else {
+        // Mapping failed: upload straight from the CPU mirrors
+        spdlog::warn("IndirectionTextureManager: failed to map upload buffer");
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        for (const UploadRect& rect : upload_rects_) {
+            glPixelStorei(GL_UNPACK_ROW_LENGTH, static_cast<GLint>(rect.texture->width));
+            glBindTexture(GL_TEXTURE_2D, rect.texture->texture_id);
+            glTexSubImage2D(
+                GL_TEXTURE_2D, 0,
+                rect.lo.x, rect.lo.y, rect.hi.x - rect.lo.x, rect.hi.y - rect.lo.y,
+                GL_RED_INTEGER, GL_UNSIGNED_SHORT,
+                &rect.texture->resolved[rect.lo.y * rect.texture->width + rect.lo.x]);
+        }
+        glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    return texels;
+}
+
+void IndirectionTextureManager::ResolveDescendants(const TileCoordinates& coords) {
+    for (int down = 0; down <= kMaxAncestorDepth; ++down) {
+        auto it = zoom_textures_.find(coords.zoom + down);
+        if (it == zoom_textures_.end()) {
+            continue;
+        }
+        const int span = 1 << down;
+        const glm::ivec2 lo(coords.x * span, coords.y * span);
+        ResolveRegion(it->second, lo, lo + glm::ivec2(span));
     }
 }
 
@@ -140,7 +391,9 @@ glm::ivec2 IndirectionTextureManager::TileToTexel(
     const ZoomTexture& zt, int tile_x, int tile_y) const {
 
     if (zt.windowed) {
-        return {tile_x - zt.window_offset.x, tile_y - zt.window_offset.y};
+        // Sizes are powers of two: the mask is a positive modulo, negative
+        // tile coordinates included
+        return {tile_x & static_cast<int>(zt.width - 1), tile_y & static_cast<int>(zt.height - 1)};
     }
     return {tile_x, tile_y};
 }
@@ -162,51 +415,54 @@ void IndirectionTextureManager::SetTileLayer(
         return;  // Outside window — silently ignore
     }
 
+    if (layer_index > kMaxLayerIndex) {
+        spdlog::error("IndirectionTextureManager: layer {} exceeds resolvable maximum {}",
+                      layer_index, kMaxLayerIndex);
+        return;
+    }
+
     const glm::ivec2 texel = TileToTexel(zt, coords.x, coords.y);
     const std::size_t idx = texel.y * zt.width + texel.x;
     zt.data[idx] = layer_index;
 
-    // Update GL texture
-    if (!skip_gl_init_ && zt.texture_id != 0) {
-        glBindTexture(GL_TEXTURE_2D, zt.texture_id);
-        glTexSubImage2D(
-            GL_TEXTURE_2D, 0,
-            texel.x, texel.y, 1, 1,
-            GL_RED_INTEGER, GL_UNSIGNED_SHORT,
-            &layer_index);
-        glBindTexture(GL_TEXTURE_2D, 0);
-    }
+    // Update the tile's texel and every finer texel that may now resolve to it
+    ResolveDescendants(coords);
 }
 
 void IndirectionTextureManager::ClearTile(const TileCoordinates& coords) {
+    auto it = zoom_textures_.find(coords.zoom);
+    if (it != zoom_textures_.end()) {
+        ZoomTexture& zt = it->second;
+        if (IsTileInWindow(zt, coords.x, coords.y)) {
+            const glm::ivec2 texel = TileToTexel(zt, coords.x, coords.y);
+            zt.data[texel.y * zt.width + texel.x] = kInvalidLayer;
+        }
+    }
+
+    // Finer texels may still resolve to the evicted layer even when the tile
+    // itself has left its own window
+    ResolveDescendants(coords);
+}
+
+std::uint16_t IndirectionTextureManager::GetTileLayer(
+    const TileCoordinates& coords) const {
+
     auto it = zoom_textures_.find(coords.zoom);
     if (it == zoom_textures_.end()) {
-        return;
+        return kInvalidLayer;
     }
 
-    ZoomTexture& zt = it->second;
+    const ZoomTexture& zt = it->second;
 
     if (!IsTileInWindow(zt, coords.x, coords.y)) {
-        return;
+        return kInvalidLayer;
     }
 
     const glm::ivec2 texel = TileToTexel(zt, coords.x, coords.y);
-    const std::size_t idx = texel.y * zt.width + texel.x;
-    zt.data[idx] = kInvalidLayer;
-
-    if (!skip_gl_init_ && zt.texture_id != 0) {
-        const std::uint16_t invalid = kInvalidLayer;
-        glBindTexture(GL_TEXTURE_2D, zt.texture_id);
-        glTexSubImage2D(
-            GL_TEXTURE_2D, 0,
-            texel.x, texel.y, 1, 1,
-            GL_RED_INTEGER, GL_UNSIGNED_SHORT,
-            &invalid);
-        glBindTexture(GL_TEXTURE_2D, 0);
-    }
+    return zt.data[texel.y * zt.width + texel.x];
 }
 
-std::uint16_t IndirectionTextureManager::GetTileLayer(
+std::uint16_t IndirectionTextureManager::GetResolvedEntry(
     const TileCoordinates& coords) const {
 
     auto it = zoom_textures_.find(coords.zoom);
@@ -221,7 +477,7 @@ std::uint16_t IndirectionTextureManager::GetTileLayer(
     }
 
     const glm::ivec2 texel = TileToTexel(zt, coords.x, coords.y);
-    return zt.data[texel.y * zt.width + texel.x];
+    return zt.resolved[texel.y * zt.width + texel.x];
 }
 
 std::uint32_t IndirectionTextureManager::GetTextureID(int zoom) const {
@@ -232,43 +488,20 @@ std::uint32_t IndirectionTextureManager::GetTextureID(int zoom) const {
     return it->second.texture_id;
 }
 
-glm::ivec2 IndirectionTextureManager::GetWindowOffset(int zoom) const {
+glm::ivec2 IndirectionTextureManager::GetTextureSize(int zoom) const {
     auto it = zoom_textures_.find(zoom);
     if (it == zoom_textures_.end()) {
         return {0, 0};
     }
-    return it->second.window_offset;
+    return {static_cast<int>(it->second.width), static_cast<int>(it->second.height)};
 }
 
-void IndirectionTextureManager::ShiftWindowData(
-    ZoomTexture& zt, int dx, int dy) {
-
-    const int w = static_cast<int>(zt.width);
-    const int h = static_cast<int>(zt.height);
-
-    // Create a new buffer initialized to kInvalidLayer
-    std::vector<std::uint16_t> new_data(w * h, kInvalidLayer);
-
-    // Copy overlapping region from old data to new positions.
-    // Old texel (ox, oy) maps to new texel (ox - dx, oy - dy).
-    // Source region in old buffer: the part that maps to valid new positions.
-    const int src_x0 = std::max(0, dx);
-    const int src_y0 = std::max(0, dy);
-    const int src_x1 = std::min(w, w + dx);
-    const int src_y1 = std::min(h, h + dy);
-
-    for (int oy = src_y0; oy < src_y1; ++oy) {
-        const int ny = oy - dy;
-        const int copy_width = src_x1 - src_x0;
-        if (copy_width > 0) {
-            std::memcpy(
-                &new_data[ny * w + (src_x0 - dx)],
-                &zt.data[oy * w + src_x0],
-                copy_width * sizeof(std::uint16_t));
-        }
+glm::ivec2 IndirectionTextureManager::GetWindowOffset(int zoom) const {
+    auto it = zoom_textures_.find(zoom);
+    if (it == zoom_textures_.end()) {
+        return {0, 0};
     }
-
-    zt.data = std::move(new_data);
+    return it->second.window_offset;
 }
 
 void IndirectionTextureManager::UpdateWindowCenter(
@@ -284,9 +517,7 @@ void IndirectionTextureManager::UpdateWindowCenter(
     auto it = zoom_textures_.find(zoom);
     if (it == zoom_textures_.end()) {
         // Create texture with this offset
-        CreateZoomTexture(zoom);
-        it = zoom_textures_.find(zoom);
-        it->second.window_offset = new_offset;
+        CreateZoomTexture(zoom, new_offset);
         return;
     }
 
@@ -300,34 +531,26 @@ void IndirectionTextureManager::UpdateWindowCenter(
 
     const int w = static_cast<int>(zt.width);
     const int h = static_cast<int>(zt.height);
+    zt.window_offset = new_offset;
 
     if (std::abs(delta.x) >= w || std::abs(delta.y) >= h) {
         // No overlap — clear everything
         ClearZoomTextureData(zt);
-        zt.window_offset = new_offset;
         return;
     }
 
-    // Smart shift: move overlapping data, clear newly exposed strips.
-    //
-    // The texel at position (lx, ly) stores the layer for tile
-    // (lx + offset.x, ly + offset.y). When offset shifts by (dx, dy),
-    // the data that was at texel (lx, ly) now belongs at texel (lx - dx, ly - dy).
-    // We shift the buffer accordingly and clear the exposed strips.
-
-    ShiftWindowData(zt, delta.x, delta.y);
-    zt.window_offset = new_offset;
-
-    // Upload entire buffer to GPU (the shifted data + cleared strips)
-    if (!skip_gl_init_ && zt.texture_id != 0) {
-        glBindTexture(GL_TEXTURE_2D, zt.texture_id);
-        glTexSubImage2D(
-            GL_TEXTURE_2D, 0, 0, 0,
-            static_cast<GLsizei>(zt.width),
-            static_cast<GLsizei>(zt.height),
-            GL_RED_INTEGER, GL_UNSIGNED_SHORT,
-            zt.data.data());
-        glBindTexture(GL_TEXTURE_2D, 0);
+    // Toroidal addressing: tiles staying in the window keep their texels.
+    // Only the columns and rows entering the window take over the texels of
+    // those that left, so only those are cleared and resolved.
+    if (delta.x > 0) {
+        ResetTiles(zt, {old_offset.x + w, new_offset.y}, new_offset + glm::ivec2(w, h));
+    } else if (delta.x < 0) {
+        ResetTiles(zt, new_offset, {old_offset.x, new_offset.y + h});
+    }
+    if (delta.y > 0) {
+        ResetTiles(zt, {new_offset.x, old_offset.y + h}, new_offset + glm::ivec2(w, h));
+    } else if (delta.y < 0) {
+        ResetTiles(zt, new_offset, {new_offset.x + w, old_offset.y});
     }
 }
 
@@ -0,0 +1,84 @@
+/**
+ * @file tile_eviction_policy.cpp
+ * @brief Screen importance scoring of pool tiles
+ */
+
+#include <earth_map/renderer/tile_pool/tile_eviction_policy.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+
+namespace earth_map {
+
+namespace {
+
+/// Tiles that are not visible score at most this (below kVisibleScore)
+constexpr float kHiddenScoreWeight = 0.5f;
+
+/// Largest shift applied when comparing tiles of different zooms
+constexpr int kMaxZoomShift = 30;
+
+/// Tiles between two tiles of one zoom, wrapping around the antimeridian
+std::int64_t TileDistance(const TileCoordinates& a, const TileCoordinates& b) {
+    const std::int64_t columns = std::int64_t{1} << std::clamp(a.zoom, 0, kMaxZoomShift);
+    std::int64_t dx = std::llabs(static_cast<std::int64_t>(a.x) - b.x) % columns;
+    dx = std::min(dx, columns - dx);
+    const std::int64_t dy = std::llabs(static_cast<std::int64_t>(a.y) - b.y);
+    return std::max(dx, dy);
+}
+
+/// A tile's coordinates at a coarser zoom
+TileCoordinates AtZoom(const TileCoordinates& coords, int zoom) {
+    const int shift = std::clamp(coords.zoom - zoom, 0, kMaxZoomShift);
+    return {coords.x >> shift, coords.y >> shift, coords.zoom - shift};
+}
+
+} // namespace
+
+TileEvictionPolicy::TileEvictionPolicy(const TileEvictionPolicyConfig& config)
+    : config_(config) {
+    config_.protected_ancestor_levels = std::max(config_.protected_ancestor_levels, 0);
+}
+
+void TileEvictionPolicy::Update(std::span<const TileCoordinates> visible,
+                                const TileCoordinates& focus) {
+    visible_.clear();
+    visible_.insert(visible.begin(), visible.end());
+    focus_ = focus;
+    has_focus_ = true;
+
+    // Parents first: under the cap, the nearest fallbacks stay protected
+    protected_.clear();
+    for (int level = 1; level <= config_.protected_ancestor_levels; ++level) {
+        for (const TileCoordinates& tile : visible) {
+            if (protected_.size() >= config_.max_protected_tiles) {
+                return;
+            }
+            if (tile.zoom - level >= 0) {
+                protected_.insert(AtZoom(tile, tile.zoom - level));
+            }
+        }
+    }
+}
+
+float TileEvictionPolicy::Score(const TileCoordinates& coords) const {
+    if (!has_focus_) {
+        return 0.0f;
+    }
+    if (protected_.contains(coords)) {
+        return kProtected;
+    }
+
+    const int zoom = std::min(coords.zoom, focus_.zoom);
+    const auto distance = TileDistance(AtZoom(coords, zoom), AtZoom(focus_, zoom));
+    const int zoom_gap = std::abs(coords.zoom - focus_.zoom);
+    const float nearness = 1.0f / (static_cast<float>(distance + 1) *
+                                   static_cast<float>(zoom_gap + 1));
+
+    if (visible_.contains(coords)) {
+        return kVisibleScore + nearness;
+    }
+    return kHiddenScoreWeight * nearness;
+}
+
+} // namespace earth_map
@@ -4,77 +4,310 @@
  */
 
 #include <earth_map/renderer/tile_pool/tile_texture_pool.h>
+#include <earth_map/renderer/texture_atlas/tile_mip_chain.h>
 #include <GL/glew.h>
 #include <spdlog/spdlog.h>
 #include <algorithm>
+#include <bit>
+#include <limits>
+#include <tuple>
 
 namespace earth_map {
 
 TileTexturePool::TileTexturePool(
     std::uint32_t tile_size,
     std::uint32_t max_layers,
-    bool skip_gl_init)
+    bool skip_gl_init,
+    TileTextureFormat format,
+    std::uint32_t mip_levels)
     : tile_size_(tile_size)
-    , max_layers_(max_layers)
-    , skip_gl_init_(skip_gl_init) {
+    , max_layers_(std::max<std::uint32_t>(1, max_layers))
+    , skip_gl_init_(skip_gl_init)
+    , format_(format)
+    , mip_levels_(mip_levels) {
+
+    // Smallest power of two that spreads max_layers over kMaxArrays arrays
+    const std::uint32_t per_array =
+        (max_layers_ + static_cast<std::uint32_t>(kMaxArrays) - 1) /
+        static_cast<std::uint32_t>(kMaxArrays);
+    layers_per_array_ = std::bit_ceil(per_array);
+
+    if (!skip_gl_init_) {
+        GLint driver_max_layers = 0;
+        glGetIntegerv(GL_MAX_ARRAY_TEXTURE_LAYERS, &driver_max_layers);
+        if (driver_max_layers > 0 &&
+            layers_per_array_ > static_cast<std::uint32_t>(driver_max_layers)) {
+            layers_per_array_ = std::bit_floor(static_cast<std::uint32_t>(driver_max_layers));
+            max_layers_ = std::min<std::uint32_t>(
+                max_layers_, layers_per_array_ * static_cast<std::uint32_t>(kMaxArrays));
+            spdlog::warn("TileTexturePool: driver allows {} layers per array, capping pool at {}",
+                         driver_max_layers, max_layers_);
+        }
+
+        if (format_ == TileTextureFormat::BC1 &&
+            (!GLEW_EXT_texture_compression_s3tc ||
+             TileBlockCompressor::GetEncodedSize(format_, tile_size_, tile_size_) == 0)) {
+            spdlog::warn("TileTexturePool: BC1 unavailable for {}px tiles, using RGBA8", tile_size_);
+            format_ = TileTextureFormat::RGBA8;
+        }
+    }
+
+    mip_levels_ = std::clamp<std::uint32_t>(
+        mip_levels_, 1, TileMipChain::GetMaxLevels(format_, tile_size_));
+    budget_layers_ = max_layers_;
 
     layers_.reserve(max_layers_);
     for (std::uint32_t i = 0; i < max_layers_; ++i) {
         layers_.emplace_back(static_cast<int>(i));
-        free_layers_.push(static_cast<int>(i));
     }
 
-    if (!skip_gl_init_) {
-        CreateTextureArray();
-    }
-
-    spdlog::debug("TileTexturePool initialized: {}x{} tile size, {} layers",
-                  tile_size_, tile_size_, max_layers_);
+    spdlog::debug("TileTexturePool initialized: {}x{} tile size, {} layers ({} per array), "
+                  "{} mip levels{}",
+                  tile_size_, tile_size_, max_layers_, layers_per_array_, mip_levels_,
+                  format_ == TileTextureFormat::BC1 ? " (BC1)" : "");
 }
 
 TileTexturePool::~TileTexturePool() {
-    if (texture_array_id_ != 0 && !skip_gl_init_) {
-        glDeleteTextures(1, &texture_array_id_);
-        texture_array_id_ = 0;
+    for (std::size_t i = 0; i < arrays_.size(); ++i) {
+        ReleaseArray(i);
     }
 }
 
-void TileTexturePool::CreateTextureArray() {
-    glGenTextures(1, &texture_array_id_);
-    glBindTexture(GL_TEXTURE_2D_ARRAY, texture_array_id_);
+std::size_t TileTexturePool::GetLayerBytes() const {
+    return TileMipChain::GetLevelOffset(format_, tile_size_, mip_levels_);
+}
 
-    glTexImage3D(
-        GL_TEXTURE_2D_ARRAY,
-        0,
-        GL_RGBA8,
-        static_cast<GLsizei>(tile_size_),
-        static_cast<GLsizei>(tile_size_),
-        static_cast<GLsizei>(max_layers_),
-        0,
-        GL_RGBA,
-        GL_UNSIGNED_BYTE,
-        nullptr);
+void TileTexturePool::SetMaxAnisotropy(float anisotropy) {
+    max_anisotropy_ = std::max(1.0f, anisotropy);
+    if (skip_gl_init_) {
+        return;
+    }
+    if (!GLEW_EXT_texture_filter_anisotropic) {
+        max_anisotropy_ = 1.0f;
+        return;
+    }
 
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    GLfloat driver_max = 1.0f;
+    glGetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY_EXT, &driver_max);
+    max_anisotropy_ = std::min(max_anisotropy_, driver_max);
 
+    for (const ArrayPage& page : arrays_) {
+        if (page.texture_id != 0) {
+            glBindTexture(GL_TEXTURE_2D_ARRAY, page.texture_id);
+            ApplyAnisotropy(page.texture_id);
+        }
+    }
     glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
+
+void TileTexturePool::ApplyAnisotropy(std::uint32_t texture_id) const {
+    // Expects texture_id bound to GL_TEXTURE_2D_ARRAY
+    if (texture_id != 0 && GLEW_EXT_texture_filter_anisotropic) {
+        glTexParameterf(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_ANISOTROPY_EXT, max_anisotropy_);
+    }
+}
+
+std::size_t TileTexturePool::GetAllocatedArrayCount() const {
+    return static_cast<std::size_t>(std::count_if(arrays_.begin(), arrays_.end(),
+        [](const ArrayPage& page) { return page.depth > 0; }));
+}
+
+std::size_t TileTexturePool::QueryAvailableVideoMemory() {
+    GLint free_kb = 0;
+    if (GLEW_NVX_gpu_memory_info) {
+        glGetIntegerv(GL_GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX, &free_kb);
+    } else if (GLEW_ATI_meminfo) {
+        // Total free, largest free block, total free auxiliary, largest auxiliary block
+        GLint info[4] = {0, 0, 0, 0};
+        glGetIntegerv(GL_TEXTURE_FREE_MEMORY_ATI, info);
+        free_kb = info[0];
+    }
+    return free_kb > 0 ? static_cast<std::size_t>(free_kb) * 1024 : 0;
+}
+
+void TileTexturePool::SetBudgetLayers(std::uint32_t layers) {
+    budget_layers_ = std::clamp<std::uint32_t>(layers, 1, max_layers_);
+    ReleaseExcessArrays();
+}
+
+bool TileTexturePool::IsOverBudget() const {
+    if (coord_to_layer_.size() > budget_layers_) {
+        return true;
+    }
+    for (std::size_t i = FirstExcessArray(); i < arrays_.size(); ++i) {
+        if (arrays_[i].occupied > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t TileTexturePool::FirstExcessArray() const {
+    std::uint32_t covered = 0;
+    for (std::size_t i = 0; i < arrays_.size(); ++i) {
+        covered += arrays_[i].depth;
+        if (covered >= budget_layers_) {
+            return i + 1;
+        }
+    }
+    return arrays_.size();
+}
+
+void TileTexturePool::ReleaseExcessArrays() {
+    for (std::size_t i = FirstExcessArray(); i < arrays_.size(); ++i) {
+        if (arrays_[i].depth > 0 && arrays_[i].occupied == 0) {
+            ReleaseArray(i);
+        }
+    }
+}
 
-    spdlog::debug("Created texture array: ID={}, {}x{} x {} layers",
-                  texture_array_id_, tile_size_, tile_size_, max_layers_);
+bool TileTexturePool::Grow() {
+    for (std::size_t i = 0; i < arrays_.size(); ++i) {
+        const std::uint32_t first = static_cast<std::uint32_t>(i) * layers_per_array_;
+        if (first >= max_layers_) {
+            break;
+        }
+        const std::uint32_t capacity = std::min(layers_per_array_, max_layers_ - first);
+
+        ArrayPage& page = arrays_[i];
+        // A texture cannot be resized in place: only empty arrays are reallocated
+        if (page.depth == capacity || (page.depth > 0 && page.occupied > 0)) {
+            continue;
+        }
+
+        const std::uint32_t others = allocated_layers_ - page.depth;
+        if (others >= budget_layers_) {
+            return false;
+        }
+        const std::uint32_t needed = budget_layers_ - others;
+        const std::uint32_t rounded =
+            (needed + kArrayGrowthLayers - 1) / kArrayGrowthLayers * kArrayGrowthLayers;
+        const std::uint32_t depth = std::min(rounded, capacity);
+        if (depth <= page.depth) {
+            continue;
+        }
+
+        ReleaseArray(i);
+        AllocateArray(i, depth);
+        return arrays_[i].depth > 0;
+    }
+    return false;
+}
+
+void TileTexturePool::AllocateArray(std::size_t array, std::uint32_t depth) {
+    ArrayPage& page = arrays_[array];
+
+    if (!skip_gl_init_) {
+        while (glGetError() != GL_NO_ERROR) {}
+
+        glGenTextures(1, &page.texture_id);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, page.texture_id);
+
+        // Every level is allocated up front so the array is mipmap-complete
+        for (std::uint32_t level = 0; level < mip_levels_; ++level) {
+            const GLsizei level_size = static_cast<GLsizei>(tile_size_ >> level);
+            if (format_ == TileTextureFormat::BC1) {
+                const std::size_t level_bytes = TileBlockCompressor::GetEncodedSize(
+                    format_, tile_size_ >> level, tile_size_ >> level);
+                glCompressedTexImage3D(
+                    GL_TEXTURE_2D_ARRAY,
+                    static_cast<GLint>(level),
+                    GL_COMPRESSED_RGB_S3TC_DXT1_EXT,
+                    level_size,
+                    level_size,
+                    static_cast<GLsizei>(depth),
+                    0,
+                    static_cast<GLsizei>(level_bytes * depth),
+                    nullptr);
+            } else {
+                glTexImage3D(
+                    GL_TEXTURE_2D_ARRAY,
+                    static_cast<GLint>(level),
+                    GL_RGBA8,
+                    level_size,
+                    level_size,
+                    static_cast<GLsizei>(depth),
+                    0,
+                    GL_RGBA,
+                    GL_UNSIGNED_BYTE,
+                    nullptr);
+            }
+        }
+
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_BASE_LEVEL, 0);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL,
+                        static_cast<GLint>(mip_levels_ - 1));
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER,
+                        mip_levels_ > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+        const GLenum error = glGetError();
+        if (error != GL_NO_ERROR) {
+            // Typically GL_OUT_OF_MEMORY: the budget overestimated the VRAM
+            glDeleteTextures(1, &page.texture_id);
+            page.texture_id = 0;
+            budget_layers_ = std::max<std::uint32_t>(1, allocated_layers_);
+            spdlog::error("GL error {} allocating {} pool layers, budget lowered to {}",
+                          error, depth, budget_layers_);
+            return;
+        }
+    }
+
+    page.depth = depth;
+    page.occupied = 0;
+    allocated_layers_ += depth;
+
+    const int first = static_cast<int>(array * layers_per_array_);
+    for (int layer = first; layer < first + static_cast<int>(depth); ++layer) {
+        free_layers_.insert(free_layers_.end(), layer);
+    }
+
+    spdlog::debug("Created texture array {}: ID={}, {}x{} x {} layers, {} mip levels",
+                  array, page.texture_id, tile_size_, tile_size_, depth, mip_levels_);
+}
+
+void TileTexturePool::ReleaseArray(std::size_t array) {
+    ArrayPage& page = arrays_[array];
+    if (page.depth == 0) {
+        return;
+    }
+
+    const int first = static_cast<int>(array * layers_per_array_);
+    free_layers_.erase(free_layers_.lower_bound(first),
+                       free_layers_.lower_bound(first + static_cast<int>(page.depth)));
+
+    if (page.texture_id != 0 && !skip_gl_init_) {
+        glDeleteTextures(1, &page.texture_id);
+    }
+    allocated_layers_ -= page.depth;
+    page = ArrayPage{};
+
+    spdlog::debug("Released texture array {}", array);
 }
 
 int TileTexturePool::AllocateLayer() {
-    if (!free_layers_.empty()) {
-        const int layer = free_layers_.front();
-        free_layers_.pop();
-        return layer;
+    // Budget used up — caller must evict explicitly via EvictTile()
+    if (coord_to_layer_.size() >= budget_layers_) {
+        return -1;
+    }
+
+    // Only arrays within the budget take new tiles, so the others can drain
+    const auto fits = [this]() {
+        return !free_layers_.empty() &&
+               static_cast<std::size_t>(*free_layers_.begin()) <
+                   FirstExcessArray() * layers_per_array_;
+    };
+    if (!fits() && (!Grow() || !fits())) {
+        return -1;
     }
 
-    // Pool is full — caller must evict explicitly via EvictTile()
-    return -1;
+    const int layer = *free_layers_.begin();
+    free_layers_.erase(free_layers_.begin());
+    return layer;
 }
 
 void TileTexturePool::FreeLayer(int layer_index) {
@@ -84,10 +317,17 @@ void TileTexturePool::FreeLayer(int layer_index) {
 
     LayerSlot& slot = layers_[layer_index];
     if (slot.occupied) {
-        lru_order_.erase(slot.lru_it);
+        if (slot.pinned) {
+            slot.pinned = false;
+            --pinned_count_;
+        } else {
+            lru_order_.erase(slot.lru_it);
+        }
         coord_to_layer_.erase(slot.coords);
         slot.occupied = false;
-        free_layers_.push(layer_index);
+        free_layers_.insert(layer_index);
+        --arrays_[layer_index / layers_per_array_].occupied;
+        ReleaseExcessArrays();
     }
 }
 
@@ -96,7 +336,9 @@ int TileTexturePool::UploadTile(
     const std::uint8_t* pixel_data,
     std::uint32_t width,
     std::uint32_t height,
-    std::uint8_t channels) {
+    std::uint8_t channels,
+    TileTextureFormat format,
+    std::uint32_t mip_levels) {
 
     if (!pixel_data) {
         spdlog::warn("TileTexturePool::UploadTile: null pixel data for tile {}",
@@ -104,13 +346,59 @@ int TileTexturePool::UploadTile(
         return -1;
     }
 
+    return UploadLayer(coords, pixel_data, 0, width, height, channels, format, mip_levels);
+}
+
+int TileTexturePool::UploadTileFromBuffer(
+    const TileCoordinates& coords,
+    std::uint32_t buffer_id,
+    std::size_t offset,
+    std::uint32_t width,
+    std::uint32_t height,
+    std::uint8_t channels,
+    TileTextureFormat format,
+    std::uint32_t mip_levels) {
+
+    if (buffer_id == 0) {
+        spdlog::warn("TileTexturePool::UploadTileFromBuffer: no buffer for tile {}",
+                     coords.GetKey());
+        return -1;
+    }
+
+    // With an unpack buffer bound, the pointer argument is a byte offset
+    return UploadLayer(coords, reinterpret_cast<const void*>(offset), buffer_id,
+                       width, height, channels, format, mip_levels);
+}
+
+int TileTexturePool::UploadLayer(
+    const TileCoordinates& coords,
+    const void* pixels,
+    std::uint32_t unpack_buffer,
+    std::uint32_t width,
+    std::uint32_t height,
+    std::uint8_t channels,
+    TileTextureFormat format,
+    std::uint32_t mip_levels) {
+
     if (width != tile_size_ || height != tile_size_) {
         spdlog::warn("TileTexturePool::UploadTile: size mismatch (expected {}x{}, got {}x{})",
                      tile_size_, tile_size_, width, height);
         return -1;
     }
 
-    if (channels != 4) {
+    if (format != format_) {
+        spdlog::warn("TileTexturePool::UploadTile: format mismatch for tile {}",
+                     coords.GetKey());
+        return -1;
+    }
+
+    if (mip_levels != mip_levels_) {
+        spdlog::warn("TileTexturePool::UploadTile: expected {} mip levels, got {} for tile {}",
+                     mip_levels_, mip_levels, coords.GetKey());
+        return -1;
+    }
+
+    if (format_ == TileTextureFormat::RGBA8 && channels != 4) {
         spdlog::warn("TileTexturePool::UploadTile: expected 4 channels (RGBA), got {}",
                      channels);
         return -1;
@@ -123,13 +411,16 @@ int TileTexturePool::UploadTile(
     if (it != coord_to_layer_.end()) {
         layer_index = it->second;
         // Move to front of LRU (most recently used)
-        lru_order_.splice(lru_order_.begin(), lru_order_, layers_[layer_index].lru_it);
+        if (!layers_[layer_index].pinned) {
+            lru_order_.splice(lru_order_.begin(), lru_order_, layers_[layer_index].lru_it);
+        }
     } else {
         layer_index = AllocateLayer();
         if (layer_index < 0) {
             return -1;
         }
         coord_to_layer_[coords] = layer_index;
+        ++arrays_[layer_index / layers_per_array_].occupied;
         layers_[layer_index].coords = coords;
         layers_[layer_index].occupied = true;
         // Insert at front of LRU
@@ -140,28 +431,54 @@ int TileTexturePool::UploadTile(
     layers_[layer_index].last_used = std::chrono::steady_clock::now();
 
     // Upload to GL
-    if (!skip_gl_init_ && texture_array_id_ != 0) {
+    const ArrayPage& page = arrays_[layer_index / layers_per_array_];
+    const GLint array_layer = static_cast<GLint>(layer_index % layers_per_array_);
+    if (!skip_gl_init_ && page.texture_id != 0) {
         // Clear any stale GL errors from previous operations (e.g. render pass
         // binding texture 0 to usampler2D uniforms before indirection textures
         // are allocated). Without this, glGetError() below would pick up errors
         // unrelated to the actual upload.
         while (glGetError() != GL_NO_ERROR) {}
 
-        glBindTexture(GL_TEXTURE_2D_ARRAY, texture_array_id_);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, page.texture_id);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, unpack_buffer);
         glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
 
-        glTexSubImage3D(
-            GL_TEXTURE_2D_ARRAY,
-            0,
-            0, 0, layer_index,
-            static_cast<GLsizei>(tile_size_),
-            static_cast<GLsizei>(tile_size_),
-            1,
-            GL_RGBA,
-            GL_UNSIGNED_BYTE,
-            pixel_data);
+        // Levels are packed back to back (TileMipChain layout); pixels is a
+        // client pointer or a byte offset into the unpack buffer
+        const auto base = reinterpret_cast<std::uintptr_t>(pixels);
+        for (std::uint32_t level = 0; level < mip_levels_; ++level) {
+            const std::uint32_t level_size = tile_size_ >> level;
+            const void* level_pixels = reinterpret_cast<const void*>(
+                base + TileMipChain::GetLevelOffset(format_, tile_size_, level));
+            if (format_ == TileTextureFormat::BC1) {
+                glCompressedTexSubImage3D(
+                    GL_TEXTURE_2D_ARRAY,
+                    static_cast<GLint>(level),
+                    0, 0, array_layer,
+                    static_cast<GLsizei>(level_size),
+                    static_cast<GLsizei>(level_size),
+                    1,
+                    GL_COMPRESSED_RGB_S3TC_DXT1_EXT,
+                    static_cast<GLsizei>(TileBlockCompressor::GetEncodedSize(
+                        format_, level_size, level_size)),
+                    level_pixels);
+            } else {
+                glTexSubImage3D(
+                    GL_TEXTURE_2D_ARRAY,
+                    static_cast<GLint>(level),
+                    0, 0, array_layer,
+                    static_cast<GLsizei>(level_size),
+                    static_cast<GLsizei>(level_size),
+                    1,
+                    GL_RGBA,
+                    GL_UNSIGNED_BYTE,
+                    level_pixels);
+            }
+        }
 
         glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
         glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 
         const GLenum error = glGetError();
@@ -207,16 +524,89 @@ std::optional<TileCoordinates> TileTexturePool::GetEvictionCandidate() const {
     if (lru_order_.empty()) {
         return std::nullopt;
     }
+
+    // Draining arrays beyond the budget comes first: they are released once empty
+    const std::size_t excess = FirstExcessArray();
+    const bool draining = std::any_of(arrays_.begin() + static_cast<std::ptrdiff_t>(excess),
+                                      arrays_.end(),
+                                      [](const ArrayPage& page) { return page.occupied > 0; });
+    if (draining) {
+        for (auto it = lru_order_.rbegin(); it != lru_order_.rend(); ++it) {
+            if (static_cast<std::size_t>(*it) / layers_per_array_ >= excess) {
+                return layers_[*it].coords;
+            }
+        }
+    }
     return layers_[lru_order_.back()].coords;
 }
 
+std::vector<TileCoordinates> TileTexturePool::GetEvictionCandidates(
+    std::size_t count, const TileImportanceFn& importance) const {
+    std::vector<TileCoordinates> victims;
+    if (count == 0 || lru_order_.empty()) {
+        return victims;
+    }
+
+    struct Candidate {
+        bool kept;        ///< In an array the budget keeps
+        float importance;
+        std::size_t age;  ///< Position from the LRU end
+        int layer;
+    };
+    const std::size_t excess = FirstExcessArray();
+    std::vector<Candidate> candidates;
+    candidates.reserve(lru_order_.size());
+    std::size_t age = 0;
+    for (auto it = lru_order_.rbegin(); it != lru_order_.rend(); ++it, ++age) {
+        const float score = importance ? importance(layers_[*it].coords) : 0.0f;
+        if (score == std::numeric_limits<float>::infinity()) {
+            continue;
+        }
+        const bool kept = static_cast<std::size_t>(*it) / layers_per_array_ < excess;
+        candidates.push_back({kept, score, age, *it});
+    }
+
+    const auto order = [](const Candidate& a, const Candidate& b) {
+        return std::tie(a.kept, a.importance, a.age) < std::tie(b.kept, b.importance, b.age);
+    };
+    const std::size_t taken = std::min(count, candidates.size());
+    std::partial_sort(candidates.begin(),
+                      candidates.begin() + static_cast<std::ptrdiff_t>(taken),
+                      candidates.end(), order);
+    victims.reserve(taken);
+    for (std::size_t i = 0; i < taken; ++i) {
+        victims.push_back(layers_[candidates[i].layer].coords);
+    }
+    return victims;
+}
+
 void TileTexturePool::TouchTile(const TileCoordinates& coords) {
     auto it = coord_to_layer_.find(coords);
     if (it != coord_to_layer_.end()) {
         LayerSlot& slot = layers_[it->second];
         slot.last_used = std::chrono::steady_clock::now();
-        lru_order_.splice(lru_order_.begin(), lru_order_, slot.lru_it);
+        if (!slot.pinned) {
+            lru_order_.splice(lru_order_.begin(), lru_order_, slot.lru_it);
+        }
+    }
+}
+
+void TileTexturePool::PinTile(const TileCoordinates& coords) {
+    auto it = coord_to_layer_.find(coords);
+    if (it == coord_to_layer_.end()) {
+        return;
+    }
+    LayerSlot& slot = layers_[it->second];
+    if (!slot.pinned) {
+        lru_order_.erase(slot.lru_it);
+        slot.pinned = true;
+        ++pinned_count_;
     }
 }
 
+bool TileTexturePool::IsTilePinned(const TileCoordinates& coords) const {
+    auto it = coord_to_layer_.find(coords);
+    return it != coord_to_layer_.end() && layers_[it->second].pinned;
+}
+
 } // namespace earth_map
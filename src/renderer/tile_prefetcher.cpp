@@ -0,0 +1,293 @@
+/**
+ * @file tile_prefetcher.cpp
+ * @brief Predictive tile prefetching implementation
+ */
+
+#include <earth_map/renderer/tile_prefetcher.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <utility>
+
+namespace earth_map {
+
+namespace {
+
+/// Predicted positions never go below this distance from the globe center
+constexpr float kMinCameraDistance = 1.0f + 1e-6f;
+
+/// Camera within this distance of the destination has arrived
+constexpr float kArrivalDistance = 1e-5f;
+
+/// Web Mercator latitude limit in degrees
+constexpr double kMaxMercatorLatitude = 85.0511;
+
+/**
+ * @brief Interpolate between two camera positions along the globe
+ *
+ * Directions are interpolated on the unit sphere and distances linearly, so
+ * the path of a long flight follows the surface instead of cutting through
+ * the globe.
+ */
+glm::vec3 InterpolateOverGlobe(const glm::vec3& from, const glm::vec3& to, float t) {
+    const float from_distance = glm::length(from);
+    const float to_distance = glm::length(to);
+    if (from_distance <= 0.0f || to_distance <= 0.0f) {
+        return glm::mix(from, to, t);
+    }
+    const glm::vec3 from_dir = from / from_distance;
+    const glm::vec3 to_dir = to / to_distance;
+    const float angle = std::acos(std::clamp(glm::dot(from_dir, to_dir), -1.0f, 1.0f));
+
+    glm::vec3 direction;
+    if (angle < 1e-4f || std::sin(angle) < 1e-4f) {
+        direction = glm::normalize(glm::mix(from_dir, to_dir, t));
+        if (!std::isfinite(direction.x)) {
+            direction = t < 0.5f ? from_dir : to_dir;
+        }
+    } else {
+        const float sin_angle = std::sin(angle);
+        direction = (std::sin((1.0f - t) * angle) / sin_angle) * from_dir +
+                    (std::sin(t * angle) / sin_angle) * to_dir;
+    }
+    return direction * glm::mix(from_distance, to_distance, t);
+}
+
+} // namespace
+
+TilePrefetcher::TilePrefetcher(const TilePrefetchConfig& config, ZoomFunction zoom_for_distance)
+    : config_(config), zoom_for_distance_(std::move(zoom_for_distance)) {
+    if (!zoom_for_distance_) {
+        throw std::invalid_argument("TilePrefetcher: zoom function must not be empty");
+    }
+}
+
+void TilePrefetcher::SetDestination(const glm::vec3& position, float duration_seconds) {
+    destination_ = Destination{position, std::max(0.0f, duration_seconds)};
+}
+
+void TilePrefetcher::ClearDestination() {
+    destination_.reset();
+}
+
+void TilePrefetcher::Reset() {
+    destination_.reset();
+    active_tiles_.clear();
+    bandwidth_tokens_ = 0.0;
+    stats_.active_tiles = 0;
+}
+
+void TilePrefetcher::SetConfig(const TilePrefetchConfig& config) {
+    config_ = config;
+    bandwidth_tokens_ = std::min(bandwidth_tokens_,
+                                 static_cast<double>(config_.max_tiles_per_second));
+}
+
+std::vector<TileCoordinates> TilePrefetcher::Update(
+    const glm::vec3& camera_position, const glm::vec3& velocity, float delta_time,
+    std::span<const TileCoordinates> visible_tiles) {
+    if (!config_.enabled) {
+        active_tiles_.clear();
+        stats_.active_tiles = 0;
+        return {};
+    }
+
+    // Token bucket: refill at the bandwidth budget, burst of at most one second
+    const double rate = static_cast<double>(config_.max_tiles_per_second);
+    bandwidth_tokens_ = std::min(rate, bandwidth_tokens_ +
+                                       rate * static_cast<double>(std::max(0.0f, delta_time)));
+
+    if (destination_) {
+        destination_->remaining_seconds -= std::max(0.0f, delta_time);
+        const bool arrived =
+            glm::length(camera_position - destination_->position) < kArrivalDistance;
+        if (arrived || destination_->remaining_seconds < -config_.lookahead_seconds) {
+            destination_.reset();
+        }
+    }
+
+    const TileSet visible(visible_tiles.begin(), visible_tiles.end());
+    TileSet seen;
+    std::vector<TileCoordinates> candidates;
+
+    // Tiles around the predicted positions: the whole trajectory ring by ring
+    // (nearest in time first within a ring), so a tight budget still covers
+    // the path before widening it
+    std::vector<TileCoordinates> predicted_centers;
+    for (const glm::vec3& position : PredictPositions(camera_position, velocity)) {
+        const int predicted_zoom = zoom_for_distance_(glm::length(position));
+        predicted_centers.push_back(WorldToTile(position, predicted_zoom));
+    }
+    for (std::int32_t ring = 0; ring <= std::max(0, config_.ring_radius); ++ring) {
+        for (const TileCoordinates& predicted_center : predicted_centers) {
+            AddRing(predicted_center, ring, visible, seen, candidates);
+        }
+    }
+
+    const int zoom = zoom_for_distance_(glm::length(camera_position));
+    const TileCoordinates center = WorldToTile(camera_position, zoom);
+
+    // Parent level: coarser fallback coverage for the current view, nearest first
+    if (config_.prefetch_parent_level && zoom > 0) {
+        const TileCoordinates parent_center = center.GetParent();
+        std::vector<TileCoordinates> parents;
+        for (const TileCoordinates& tile : visible_tiles) {
+            if (tile.zoom != zoom) {
+                continue;
+            }
+            const TileCoordinates parent = tile.GetParent();
+            if (!visible.count(parent) && seen.insert(parent).second) {
+                parents.push_back(parent);
+            }
+        }
+        std::stable_sort(parents.begin(), parents.end(),
+                         [&parent_center](const TileCoordinates& a, const TileCoordinates& b) {
+                             return TileMathematics::TileDistance(a, parent_center) <
+                                    TileMathematics::TileDistance(b, parent_center);
+                         });
+        candidates.insert(candidates.end(), parents.begin(), parents.end());
+    }
+
+    // Child level: detail for a zoom-in around the view center
+    if (config_.prefetch_child_level && TileValidator::IsSupportedZoom(zoom + 1)) {
+        const std::int32_t n = 1 << zoom;
+        for (std::int32_t ring = 0; ring <= 1; ++ring) {
+            for (std::int32_t dy = -ring; dy <= ring; ++dy) {
+                for (std::int32_t dx = -ring; dx <= ring; ++dx) {
+                    if (std::max(std::abs(dx), std::abs(dy)) != ring) {
+                        continue;
+                    }
+                    const std::int32_t y = center.y + dy;
+                    if (y < 0 || y >= n) {
+                        continue;
+                    }
+                    const TileCoordinates tile(((center.x + dx) % n + n) % n, y, zoom);
+                    for (const TileCoordinates& child : tile.GetChildren()) {
+                        if (!visible.count(child) && seen.insert(child).second) {
+                            candidates.push_back(child);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Admit candidates within the memory and bandwidth budgets. Tiles already
+    // in the working set are renewed without spending bandwidth; tiles that
+    // are no longer predicted (or became visible) leave it.
+    const std::size_t capacity = GetMaxActiveTiles();
+    TileSet next_active;
+    std::vector<TileCoordinates> result;
+    for (const TileCoordinates& tile : candidates) {
+        if (next_active.size() >= capacity) {
+            ++stats_.deferred_tiles;
+            continue;
+        }
+        if (!active_tiles_.count(tile)) {
+            if (bandwidth_tokens_ < 1.0) {
+                ++stats_.deferred_tiles;
+                continue;
+            }
+            bandwidth_tokens_ -= 1.0;
+            ++stats_.admitted_tiles;
+        }
+        next_active.insert(tile);
+        result.push_back(tile);
+    }
+
+    active_tiles_ = std::move(next_active);
+    stats_.active_tiles = active_tiles_.size();
+    return result;
+}
+
+TileCoordinates TilePrefetcher::WorldToTile(const glm::vec3& position, std::int32_t zoom) {
+    const std::int32_t n = 1 << zoom;
+    const float distance = glm::length(position);
+    if (distance <= 0.0f) {
+        return TileCoordinates(0, 0, zoom);
+    }
+    const glm::vec3 direction = position / distance;
+    const double lon = glm::degrees(std::atan2(static_cast<double>(direction.x),
+                                               static_cast<double>(direction.z)));
+    const double lat = glm::degrees(std::asin(
+        std::clamp(static_cast<double>(direction.y), -1.0, 1.0)));
+    const std::int32_t x = std::clamp(
+        static_cast<std::int32_t>(((lon + 180.0) / 360.0) * n), 0, n - 1);
+    const double lat_rad = glm::radians(std::clamp(lat, -kMaxMercatorLatitude,
+                                                   kMaxMercatorLatitude));
+    const std::int32_t y = std::clamp(
+        static_cast<std::int32_t>(
+            ((1.0 - std::log(std::tan(M_PI / 4.0 + lat_rad / 2.0)) / M_PI) / 2.0) * n),
+        0, n - 1);
+    return TileCoordinates(x, y, zoom);
+}
+
+std::vector<glm::vec3> TilePrefetcher::PredictPositions(const glm::vec3& camera_position,
+                                                        const glm::vec3& velocity) const {
+    std::vector<glm::vec3> positions;
+    const std::uint32_t samples = std::max<std::uint32_t>(1, config_.lookahead_samples);
+
+    if (destination_) {
+        const float remaining = std::max(0.0f, destination_->remaining_seconds);
+        for (std::uint32_t i = 1; i <= samples; ++i) {
+            const float t = config_.lookahead_seconds * static_cast<float>(i) /
+                            static_cast<float>(samples);
+            const float fraction = remaining > 0.0f ? std::min(1.0f, t / remaining) : 1.0f;
+            if (fraction >= 1.0f) {
+                break;
+            }
+            positions.push_back(InterpolateOverGlobe(camera_position,
+                                                     destination_->position, fraction));
+        }
+        positions.push_back(destination_->position);
+        return positions;
+    }
+
+    if (glm::length(velocity) < config_.min_speed) {
+        return positions;
+    }
+    for (std::uint32_t i = 1; i <= samples; ++i) {
+        const float t = config_.lookahead_seconds * static_cast<float>(i) /
+                        static_cast<float>(samples);
+        glm::vec3 position = camera_position + velocity * t;
+        const float distance = glm::length(position);
+        if (distance < kMinCameraDistance) {
+            position = distance > 0.0f ? position * (kMinCameraDistance / distance)
+                                       : camera_position;
+        }
+        positions.push_back(position);
+    }
+    return positions;
+}
+
+void TilePrefetcher::AddRing(const TileCoordinates& center, std::int32_t ring,
+                             const TileSet& visible, TileSet& seen,
+                             std::vector<TileCoordinates>& candidates) const {
+    const std::int32_t n = 1 << center.zoom;
+    if (ring > n / 2) {
+        return;
+    }
+    for (std::int32_t dy = -ring; dy <= ring; ++dy) {
+        for (std::int32_t dx = -ring; dx <= ring; ++dx) {
+            if (std::max(std::abs(dx), std::abs(dy)) != ring) {
+                continue;
+            }
+            const std::int32_t y = center.y + dy;
+            if (y < 0 || y >= n) {
+                continue;
+            }
+            // Longitude wraps around the antimeridian
+            const TileCoordinates tile(((center.x + dx) % n + n) % n, y, center.zoom);
+            if (!visible.count(tile) && seen.insert(tile).second) {
+                candidates.push_back(tile);
+            }
+        }
+    }
+}
+
+std::size_t TilePrefetcher::GetMaxActiveTiles() const {
+    return config_.tile_bytes > 0 ? config_.memory_budget_bytes / config_.tile_bytes : 0;
+}
+
+} // namespace earth_map
@@ -4,20 +4,33 @@
  */
 
 #include <earth_map/renderer/tile_renderer.h>
+#include <earth_map/renderer/tile_feedback_pass.h>
+#include <earth_map/renderer/tile_prefetcher.h>
+#include <earth_map/renderer/tile_selector.h>
+#include <earth_map/renderer/tile_selection_worker.h>
+#include <earth_map/renderer/tile_request_merger.h>
 #include <earth_map/renderer/globe_mesh.h>
+#include <earth_map/renderer/gpu_resource_manager.h>
+#include <earth_map/renderer/gpu_frame_profiler.h>
+#include <earth_map/renderer/elevation_manager.h>
+#include <earth_map/renderer/terrain_elevation_pool.h>
+#include <earth_map/renderer/terrain_cull_pass.h>
 #include <earth_map/renderer/shader_loader.h>
 #include <earth_map/math/projection.h>
 #include <earth_map/math/tile_mathematics.h>
 #include <earth_map/renderer/texture_atlas/tile_texture_coordinator.h>
 #include <earth_map/renderer/tile_pool/indirection_texture_manager.h>
-#include <earth_map/coordinates/coordinate_mapper.h>
+#include <earth_map/core/frame_arena.h>
 #include <earth_map/constants.h>
 #include <spdlog/spdlog.h>
 #include <GL/glew.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <algorithm>
+#include <bit>
+#include <chrono>
 #include <cmath>
+#include <optional>
 #include <stdexcept>
 #include <unordered_map>
 #include <cstddef>
@@ -28,9 +41,23 @@ namespace {
 
 constexpr int kDefaultTileSize = 256;
 constexpr int kDefaultZoomLevel = 2;
-constexpr int kMaxFallbackLevels = 5;
+constexpr int kMaxFallbackLevels = TileRenderer::kMaxFallbackLevels;
+// One sampler per tile pool texture array (uTilePool[8] in the shader)
+constexpr std::size_t kPoolArrays = TileTexturePool::kMaxArrays;
+static_assert(kPoolArrays == 8, "uTilePool sampler count in the fragment shader");
+// One indirection sampler per overlay layer (uOverlayIndirection0-2 in the shader)
+constexpr int kMaxOverlayLayers = static_cast<int>(TileTextureCoordinator::kMaxOverlayLayers);
+static_assert(kMaxOverlayLayers == 3, "uOverlayIndirection sampler count in the fragment shader");
+// Fragment samplers stay within the 16 units every GL 3.3 context has
+static_assert(kPoolArrays + kMaxFallbackLevels + kMaxOverlayLayers <= 16,
+              "tile fragment shader samplers");
+// Elevation array unit, after the pool's and the indirection textures'
+constexpr GLenum kElevationUnit =
+    static_cast<GLenum>(kPoolArrays + kMaxFallbackLevels + kMaxOverlayLayers);
 constexpr glm::vec3 kDefaultLightPosition{2.0f, 2.0f, 2.0f};
 
+constexpr int kPrefetchPriorityOffset = TileRenderer::kPrefetchPriorityOffset;
+
 constexpr int kMinZoom = 0;
 constexpr int kMaxZoom = 21;
 
@@ -42,6 +69,21 @@ constexpr float kZoomAltitudeScale =
      / static_cast<float>(constants::geodetic::EARTH_MEAN_RADIUS))
     * static_cast<float>(1u << kMaxZoom);
 
+// Viewport height assumed until SetViewportSize() is called
+constexpr std::uint32_t kDefaultViewportHeight = 1080;
+
+/**
+ * @brief Limit the selected zoom span to what the tile shader can reach
+ *
+ * The shader looks a texel up at the finest visible zoom, whose pre-resolved
+ * indirection entry reaches ancestors at most kMaxAncestorDepth levels up.
+ */
+TileSelectionConfig ClampToFallbackReach(TileSelectionConfig config) {
+    config.max_zoom_span = std::clamp(
+        config.max_zoom_span, 0, IndirectionTextureManager::kMaxAncestorDepth);
+    return config;
+}
+
 } // namespace
 
 /**
@@ -64,11 +106,21 @@ struct TileRenderState {
 class TileRendererImpl : public TileRenderer {
 public:
     explicit TileRendererImpl(const TileRenderConfig& config)
-        : config_(config), frame_counter_(0) {
+        : config_(config), frame_counter_(0),
+          prefetcher_(config.prefetch, [this](float distance) {
+              return CalculateOptimalZoom(distance);
+          }),
+          selector_(ClampToFallbackReach(config.selection)),
+          selection_worker_([this](const FrameSnapshot& snapshot, int zoom_level,
+                                   std::pmr::vector<TileCoordinates>& tiles) {
+              SelectCoveringTiles(snapshot.projection, snapshot.camera_position,
+                                  snapshot.frustum, zoom_level, tiles);
+          }) {
         spdlog::info("Creating tile renderer with max tiles: {}", config.max_visible_tiles);
     }
     
     ~TileRendererImpl() override {
+        WaitForSelection();
         Cleanup();
     }
     
@@ -85,6 +137,10 @@ public:
                 return false;
             }
             
+            if (config_.feedback.enabled && !feedback_pass_.Initialize(config_.feedback)) {
+                spdlog::warn("Tile feedback pass unavailable, selecting tiles on the CPU");
+            }
+
             initialized_ = true;
             spdlog::info("Tile renderer initialized successfully");
             return true;
@@ -101,13 +157,23 @@ public:
         }
 
         frame_counter_++;
+        // Last frame's temporaries are gone; reuse their memory
+        frame_arena_.Reset();
         stats_.render_time_ms = 0.0f;
         stats_.rendered_tiles = 0;
         stats_.texture_binds = 0;
 
-        // Process GL uploads from worker threads (must be on GL thread)
-        if (texture_coordinator_) {
-            texture_coordinator_->ProcessUploads(100);  // Upload up to 5 tiles per frame for 60 FPS (changed)
+        // Process GL uploads from worker threads (must be on GL thread),
+        // closest and coarsest tiles first, within the frame's upload budget
+        if (texture_coordinator_ && config_.process_uploads) {
+            GpuFrameProfiler::Scope scope(profiler_, RenderPass::UPLOADS);
+            texture_coordinator_->ProcessUploads(
+                std::chrono::microseconds(config_.upload_budget_us));
+
+            const TileUploadStats upload_stats = texture_coordinator_->GetUploadStats();
+            stats_.tiles_loaded_this_frame = upload_stats.uploads_last_frame;
+            stats_.uploads_per_second = static_cast<float>(upload_stats.uploads_per_second);
+            stats_.upload_budget_overruns = upload_stats.budget_overruns;
         }
 
     }
@@ -119,6 +185,9 @@ public:
         
         // Update statistics
         stats_.visible_tiles = visible_tiles_.size();
+        stats_.ready_tiles = static_cast<std::size_t>(std::count_if(
+            visible_tiles_.begin(), visible_tiles_.end(),
+            [](const TileRenderState& tile) { return tile.is_ready; }));
         
         // Calculate average LOD
         if (visible_tiles_.size() > 0) {
@@ -138,9 +207,21 @@ public:
 
     void SetTextureCoordinator(TileTextureCoordinator* coordinator) override {
         texture_coordinator_ = coordinator;
+        if (texture_coordinator_) {
+            // Load the shader's fallback chain before the tiles themselves
+            texture_coordinator_->SetAncestorLevels(kMaxFallbackLevels - 1);
+        }
         spdlog::info("Tile renderer: texture coordinator set");
     }
 
+    void SetRequestMerger(TileRequestMerger* merger, float weight) override {
+        if (!(weight > 0.0f)) {
+            throw std::invalid_argument("TileRenderer: view weight must be positive");
+        }
+        request_merger_ = merger;
+        request_weight_ = weight;
+    }
+
     void SetGlobeMesh(GlobeMesh* globe_mesh) override {
         if (!globe_mesh) {
             spdlog::error("Tile renderer: cannot set null globe mesh");
@@ -148,13 +229,59 @@ public:
         }
 
         globe_mesh_ = globe_mesh;
-        mesh_uploaded_to_gpu_ = false;  // Mark for re-upload
+        globe_gpu_mesh_ = nullptr;  // Synced on the next frame
 
         spdlog::info("Tile renderer: globe mesh set ({} vertices, {} triangles)",
                      globe_mesh_->GetVertices().size(),
                      globe_mesh_->GetTriangles().size());
     }
 
+    void SetGPUResourceManager(GPUResourceManager* manager) override {
+        if (manager == gpu_resources_) {
+            return;
+        }
+        globe_gpu_mesh_ = nullptr;
+        owned_gpu_resources_.reset();
+        gpu_resources_ = manager;
+    }
+
+    void SetFrameProfiler(GpuFrameProfiler* profiler) override {
+        profiler_ = profiler;
+    }
+
+    void SetElevationManager(ElevationManager* manager) override {
+        elevation_manager_ = manager;
+        if (elevation_pool_) {
+            elevation_pool_->Clear();
+        }
+    }
+
+    void SetViewportSize(std::uint32_t /*width*/, std::uint32_t height) override {
+        WaitForSelection();
+        if (height > 0) {
+            viewport_height_ = height;
+        }
+    }
+
+    void BeginTileSelection(const FrameSnapshot& snapshot) override {
+        WaitForSelection();
+        // The feedback result of the last frame predicts this one's; if the
+        // prediction misses, UpdateVisibleTiles() selects inline
+        const bool needs_selection = !has_feedback_ || feedback_tiles_.empty() ||
+                                     config_.terrain.enabled;
+        if (!initialized_ || !tile_manager_ || !config_.async_selection || !needs_selection) {
+            return;
+        }
+        const int zoom_level = CalculateOptimalZoom(glm::length(snapshot.camera_position));
+        if (snapshot.viewport_height > 0) {
+            viewport_height_ = snapshot.viewport_height;
+        }
+        // Only the worker touches the selector until WaitForSelection(); it
+        // reads config_ and viewport_height_, which their setters leave alone
+        // while a selection runs
+        selection_worker_.Start(snapshot, zoom_level);
+    }
+
     void UpdateVisibleTiles(const glm::mat4& view_matrix,
                         const glm::mat4& projection_matrix,
                         const glm::vec3& camera_position,
@@ -162,6 +289,11 @@ public:
         if (!initialized_ || !tile_manager_) {
             return;
         }
+
+        // A selection started by BeginTileSelection() for this camera
+        const std::pmr::vector<TileCoordinates>* async_selected =
+            selection_worker_.Take(view_matrix, projection_matrix, camera_position);
+        const bool has_async_selection = async_selected != nullptr;
         
         // Clear previous visible tiles
         visible_tiles_.clear();
@@ -171,71 +303,125 @@ public:
         
         // Estimate optimal zoom level based on distance
         const int zoom_level = CalculateOptimalZoom(camera_distance);
+        current_zoom_level_ = zoom_level;
         
-        // Collect visible tile coordinates
-        // Using int64_t to avoid overflow, because with zoom_level 20, n equals 1048576 and n * n gives 0 with int32_t
-        const int64_t n = 1 << zoom_level;
-        std::vector<TileCoordinates> visible_tile_coords;
+        // Collect visible tile coordinates (frame temporaries live in the arena)
+        std::pmr::vector<TileCoordinates> visible_tile_coords(frame_arena_.GetResource());
+
+        // The GPU feedback result, when there is one, reports exactly the
+        // tiles that cover pixels. It lags a frame or two behind the camera;
+        // until the first readback arrives the CPU paths below are used.
+        if (feedback_pass_.IsInitialized() && feedback_pass_.Collect(feedback_tiles_)) {
+            has_feedback_ = true;
+        }
 
-        if (n * n <= 256) {
-            // At low zoom (≤4), request all tiles — cheap and guarantees full coverage.
-            // This avoids issues with CalculateVisibleGeographicBounds() ray-sphere
-            // intersection failures that cause missing tiles.
-            visible_tile_coords.reserve(n * n);
-            for (int32_t x = 0; x < n; ++x) {
-                for (int32_t y = 0; y < n; ++y) {
-                    visible_tile_coords.emplace_back(x, y, zoom_level);
-                }
-            }
+        const bool use_feedback = has_feedback_ && !feedback_tiles_.empty();
+        if (use_feedback) {
+            const std::size_t count = std::min<std::size_t>(
+                feedback_tiles_.size(), config_.max_visible_tiles);
+            visible_tile_coords.assign(feedback_tiles_.begin(), feedback_tiles_.begin() + count);
+        } else if (has_async_selection) {
+            visible_tile_coords.assign(async_selected->begin(), async_selected->end());
         } else {
-            // At higher zoom, use visibility bounds and frustum culling
-            const BoundingBox2D visible_bounds = CalculateVisibleGeographicBounds(
-                camera_position, view_matrix, projection_matrix);
-            const std::vector<TileCoordinates> candidate_tiles =
-                tile_manager_->GetTilesInBounds(visible_bounds, zoom_level);
-
-            spdlog::info("Tag. Candidate tiles: {} with n = {} and zoom level = {}", candidate_tiles.size(), n, zoom_level);
+            SelectCoveringTiles(projection_matrix, camera_position, frustum, zoom_level,
+                                visible_tile_coords);
+        }
 
-            const std::size_t max_tiles_for_frame =
-                static_cast<std::size_t>(config_.max_visible_tiles);
+        // Terrain patches need a gap-free cover of the view, which the
+        // lagging feedback result is not
+        if (config_.terrain.enabled) {
+            if (use_feedback && has_async_selection) {
+                terrain_tiles_.assign(async_selected->begin(), async_selected->end());
+            } else if (use_feedback) {
+                std::pmr::vector<TileCoordinates> covering(frame_arena_.GetResource());
+                SelectCoveringTiles(projection_matrix, camera_position, frustum, zoom_level,
+                                    covering);
+                terrain_tiles_.assign(covering.begin(), covering.end());
+            } else {
+                terrain_tiles_.assign(visible_tile_coords.begin(), visible_tile_coords.end());
+            }
+        }
 
-            for (const TileCoordinates& tile_coords : candidate_tiles) {
-                if (visible_tile_coords.size() >= max_tiles_for_frame) break;
-                if (IsTileInFrustum(tile_coords, frustum)) {
-                    visible_tile_coords.push_back(tile_coords);
-                }
+        // Camera position as tile coordinates at the current zoom: uploads are
+        // ordered around it, and it centers the indirection window for
+        // windowed zoom levels (13+), including the coarser zooms the
+        // selector may have picked.
+        if (texture_coordinator_) {
+            const TileCoordinates center =
+                TilePrefetcher::WorldToTile(camera_position, zoom_level);
+            texture_coordinator_->SetUploadFocus(center);
+            // Evict around the same focus; the fallbacks of visible tiles stay
+            texture_coordinator_->UpdateEvictionPriorities(visible_tile_coords, center);
+            int coarsest_zoom = zoom_level;
+            if (has_feedback_) {
+                coarsest_zoom = zoom_level - (kMaxFallbackLevels - 1);
+            } else if (config_.selection.enabled) {
+                coarsest_zoom = zoom_level - selector_.GetConfig().max_zoom_span;
+            }
+            for (int zoom = std::max(coarsest_zoom,
+                                     IndirectionTextureManager::kMaxFullIndirectionZoom + 1);
+                 zoom <= zoom_level; ++zoom) {
+                const TileCoordinates zoom_center =
+                    TilePrefetcher::WorldToTile(camera_position, zoom);
+                texture_coordinator_->UpdateIndirectionWindowCenter(
+                    zoom, zoom_center.x, zoom_center.y);
             }
         }
 
-        // Update indirection window center for windowed zoom levels (13+).
-        // Converts camera position to tile coordinates at the current zoom.
-        if (texture_coordinator_ && zoom_level > IndirectionTextureManager::kMaxFullIndirectionZoom) {
-            const glm::vec3 cam_dir = glm::normalize(camera_position);
-            const double lon = glm::degrees(std::atan2(
-                static_cast<double>(cam_dir.x), static_cast<double>(cam_dir.z)));
-            const double lat = glm::degrees(std::asin(
-                static_cast<double>(cam_dir.y)));
-            const int n = 1 << zoom_level;
-            const int center_x = std::clamp(
-                static_cast<int>(((lon + 180.0) / 360.0) * n), 0, n - 1);
-            const double lat_rad = glm::radians(glm::clamp(lat, -85.0511, 85.0511));
-            const int center_y = std::clamp(
-                static_cast<int>(
-                    ((1.0 - std::log(std::tan(M_PI / 4.0 + lat_rad / 2.0)) / M_PI) / 2.0) * n),
-                0, n - 1);
-            texture_coordinator_->UpdateIndirectionWindowCenter(
-                zoom_level, center_x, center_y);
-        }
-
-        // Request all visible tiles from texture coordinator (idempotent, lock-free)
-        if (texture_coordinator_ && !visible_tile_coords.empty()) {
+        // Time since the previous update drives the prefetch bandwidth budget
+        const auto now = std::chrono::steady_clock::now();
+        const float delta_time = last_update_time_
+            ? std::chrono::duration<float>(now - *last_update_time_).count()
+            : 0.0f;
+        last_update_time_ = now;
+
+        // Request all visible tiles from texture coordinator (idempotent, lock-free).
+        // Each update is a new request generation; queued loads for tiles that
+        // left the view are dropped before workers spend time on them.
+        // With a shared merger the requests join those of the other views
+        // and the merger's owner opens the frame's generation.
+        if (texture_coordinator_) {
             // Calculate priority based on camera distance (closer = lower number = higher priority)
-            int priority = static_cast<int>(camera_distance * 10.0f);
-            texture_coordinator_->RequestTiles(visible_tile_coords, priority);
+            const int priority = static_cast<int>(camera_distance * 10.0f);
+            if (!request_merger_) {
+                texture_coordinator_->BeginRequestGeneration();
+            }
+            if (!visible_tile_coords.empty()) {
+                if (request_merger_) {
+                    request_merger_->Submit(visible_tile_coords, priority, request_weight_);
+                } else {
+                    texture_coordinator_->RequestTiles(visible_tile_coords, priority);
+                }
+            }
+
+            // Tiles about to enter the view, in the same generation so they stay
+            // queued while they remain predicted
+            const std::vector<TileCoordinates> prefetch_tiles = prefetcher_.Update(
+                camera_position, camera_velocity_, delta_time, visible_tile_coords);
+            if (!prefetch_tiles.empty()) {
+                const int prefetch_priority = priority + kPrefetchPriorityOffset;
+                if (request_merger_) {
+                    request_merger_->Submit(prefetch_tiles, prefetch_priority, request_weight_);
+                } else {
+                    texture_coordinator_->RequestTiles(prefetch_tiles, prefetch_priority);
+                }
+            }
+            stats_.prefetch_tiles = prefetch_tiles.size();
+            stats_.prefetch_deferred_tiles = prefetcher_.GetStats().deferred_tiles;
+
+            if (!request_merger_) {
+                texture_coordinator_->CancelStaleRequests();
+            }
         }
 
-        // Build visible tiles list with UV coords from coordinator
-        for (const TileCoordinates& tile_coords : visible_tile_coords) {
+        // Build visible tiles list with UV coords from coordinator, whose
+        // states are looked up under one lock for the whole frame
+        if (texture_coordinator_) {
+            visible_tile_states_.resize(visible_tile_coords.size());
+            texture_coordinator_->QueryTiles(visible_tile_coords, visible_tile_states_);
+        }
+        for (std::size_t i = 0; i < visible_tile_coords.size(); ++i) {
+                const TileCoordinates& tile_coords = visible_tile_coords[i];
                 TileRenderState tile_state;
                 tile_state.coordinates = tile_coords;
                 tile_state.geographic_bounds = TileMathematics::GetTileBounds(tile_coords);
@@ -246,8 +432,11 @@ public:
 
                 // Get UV coordinates and ready state from coordinator
                 if (texture_coordinator_) {
-                    tile_state.uv_coords = texture_coordinator_->GetTileUV(tile_coords);
-                    tile_state.is_ready = texture_coordinator_->IsTileReady(tile_coords);
+                    // Array layers span the full [0,1] UV range once loaded
+                    tile_state.is_ready = visible_tile_states_[i].status ==
+                                          TileTextureCoordinator::TileStatus::Loaded;
+                    tile_state.uv_coords = tile_state.is_ready ? glm::vec4(0.0f, 0.0f, 1.0f, 1.0f)
+                                                               : glm::vec4(0.0f);
                 } else {
                     // Default UV coords (full texture)
                     tile_state.uv_coords = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
@@ -263,6 +452,11 @@ public:
                      return a.load_priority < b.load_priority;
                  });
 
+        if (!visible_tiles_.empty()) {
+            stats_.finest_visible_zoom = visible_tiles_.front().coordinates.zoom;
+            stats_.coarsest_visible_zoom = visible_tiles_.back().coordinates.zoom;
+        }
+
         // Track visible tiles for change detection
         bool tiles_changed = false;
 
@@ -294,19 +488,26 @@ public:
             return;
         }
 
+        // Terrain patches replace the globe mesh once tiles are selected
+        const bool draw_terrain = terrain_program_ != 0 && !terrain_tiles_.empty();
+        stats_.terrain_patches = 0;
+
         // CRITICAL: Must have globe mesh to render on
-        if (!globe_mesh_) {
+        if (!globe_mesh_ && !draw_terrain) {
             spdlog::warn("Tile renderer: no globe mesh set, cannot render tiles");
             return;
         }
 
         // Upload mesh to GPU if not yet done or if mesh changed
-        if (!mesh_uploaded_to_gpu_) {
-            if (!UploadMeshToGPU()) {
+        // Bring the GPU copy of the mesh up to date (nothing to do unless it changed)
+        if (globe_mesh_) {
+            globe_gpu_mesh_ = GetGPUResources().SyncGlobeMesh(*globe_mesh_);
+            if (!globe_gpu_mesh_ && !draw_terrain) {
                 spdlog::error("Tile renderer: failed to upload mesh to GPU");
                 return;
             }
         }
+        const UniformLocations& locs = draw_terrain ? terrain_uniform_locs_ : uniform_locs_;
 
         // If no visible tiles, render with base color
         // (Don't skip rendering - globe should always be visible)
@@ -321,16 +522,16 @@ public:
         glCullFace(GL_BACK);
         
         // Set up shader for textured rendering
-        glUseProgram(tile_shader_program_);
+        glUseProgram(draw_terrain ? terrain_program_ : tile_shader_program_);
         
         // Set matrices
-        glUniformMatrix4fv(uniform_locs_.view, 1, GL_FALSE, glm::value_ptr(view_matrix));
-        glUniformMatrix4fv(uniform_locs_.projection, 1, GL_FALSE, glm::value_ptr(projection_matrix));
-        glUniformMatrix4fv(uniform_locs_.model, 1, GL_FALSE, glm::value_ptr(glm::mat4(1.0f)));
+        glUniformMatrix4fv(locs.view, 1, GL_FALSE, glm::value_ptr(view_matrix));
+        glUniformMatrix4fv(locs.projection, 1, GL_FALSE, glm::value_ptr(projection_matrix));
+        glUniformMatrix4fv(locs.model, 1, GL_FALSE, glm::value_ptr(glm::mat4(1.0f)));
 
         // Set lighting uniforms
-        glUniform3f(uniform_locs_.light_pos, kDefaultLightPosition.x, kDefaultLightPosition.y, kDefaultLightPosition.z);
-        glUniform3f(uniform_locs_.light_color, 1.0f, 1.0f, 1.0f);
+        glUniform3f(locs.light_pos, kDefaultLightPosition.x, kDefaultLightPosition.y, kDefaultLightPosition.z);
+        glUniform3f(locs.light_color, 1.0f, 1.0f, 1.0f);
 
         // Get current zoom level from visible tiles (or use default)
         int current_zoom = kDefaultZoomLevel;
@@ -339,50 +540,118 @@ public:
         }
 
         // Set zoom and fallback level uniforms
-        glUniform1i(uniform_locs_.zoom_level, current_zoom);
+        glUniform1i(locs.zoom_level, current_zoom);
 
         const int num_fallback = std::min(kMaxFallbackLevels, current_zoom + 1);
-        glUniform1i(uniform_locs_.num_fallback_levels, num_fallback);
+        glUniform1i(locs.num_fallback_levels, num_fallback);
+
+        // Bind tile pool texture arrays to units 0..kPoolArrays-1
+        // (unallocated arrays bind 0; no indirection entry points into them)
+        GLint pool_units[kPoolArrays];
+        for (std::size_t array = 0; array < kPoolArrays; ++array) {
+            glActiveTexture(GL_TEXTURE0 + static_cast<GLenum>(array));
+            std::uint32_t pool_texture_id = 0;
+            if (texture_coordinator_) {
+                pool_texture_id = texture_coordinator_->GetTilePoolTextureID(array);
+            }
+            glBindTexture(GL_TEXTURE_2D_ARRAY, pool_texture_id);
+            pool_units[array] = static_cast<GLint>(array);
+        }
+        glUniform1iv(locs.tile_pool, static_cast<GLsizei>(kPoolArrays), pool_units);
 
-        // Bind tile pool texture array to unit 0
-        glActiveTexture(GL_TEXTURE0);
-        std::uint32_t pool_texture_id = 0;
+        const std::uint32_t layers_per_array =
+            texture_coordinator_ ? texture_coordinator_->GetTilePoolLayersPerArray() : 1u;
+        glUniform1i(locs.pool_layer_shift, std::countr_zero(layers_per_array));
+
+        // This frame's indirection changes, as a few merged uploads
         if (texture_coordinator_) {
-            pool_texture_id = texture_coordinator_->GetTilePoolTextureID();
+            GpuFrameProfiler::Scope scope(profiler_, RenderPass::INDIRECTION_FLUSH);
+            texture_coordinator_->FlushIndirectionUpdates();
         }
-        glBindTexture(GL_TEXTURE_2D_ARRAY, pool_texture_id);
-
-        glUniform1i(uniform_locs_.tile_pool, 0);
 
-        // Bind indirection textures for zoom Z through Z-(N-1) to units 1..N.
+        // Bind indirection textures for zoom Z through Z-(N-1) to the units
+        // after the pool's.
         // Always bind ALL 5 units to valid GL_TEXTURE_2D targets.
         // Unused levels get the dummy 1x1 texture (kInvalidLayer).
         // This prevents undefined behavior from sampler/target type mismatch
-        // (usampler2D pointing at GL_TEXTURE_2D_ARRAY on unit 0).
+        // (usampler2D pointing at GL_TEXTURE_2D_ARRAY on a pool unit).
         for (int level = 0; level < kMaxFallbackLevels; ++level) {
             const int zoom = current_zoom - level;
-            const GLint tex_unit = 1 + level;
+            const GLint tex_unit = static_cast<GLint>(kPoolArrays) + level;
 
             glActiveTexture(GL_TEXTURE0 + tex_unit);
 
             std::uint32_t indirection_id = 0;
             glm::ivec2 offset(0, 0);
+            glm::ivec2 size(0, 0);  // Unallocated levels are skipped without a fetch
             if (texture_coordinator_ && zoom >= 0) {
                 indirection_id = texture_coordinator_->GetIndirectionTextureID(zoom);
                 offset = texture_coordinator_->GetIndirectionOffset(zoom);
+                size = texture_coordinator_->GetIndirectionSize(zoom);
             } else if (texture_coordinator_) {
                 indirection_id = texture_coordinator_->GetIndirectionTextureID(-1);
             }
 
             glBindTexture(GL_TEXTURE_2D, indirection_id);
-            glUniform1i(uniform_locs_.indirection[level], tex_unit);
-            glUniform2i(uniform_locs_.indirection_offset[level], offset.x, offset.y);
+            glUniform1i(locs.indirection[level], tex_unit);
+            glUniform2i(locs.indirection_offset[level], offset.x, offset.y);
+            glUniform2i(locs.indirection_size[level], size.x, size.y);
         }
 
-        // Render globe mesh with atlas texture
-        glBindVertexArray(globe_vao_);
-        glDrawElements(GL_TRIANGLES, globe_indices_.size(), GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
+        // Overlay layers: one indirection texture each, at the current zoom
+        // (their entries are resolved to loaded ancestors too). Missing
+        // layers get the dummy texture, like unused fallback levels.
+        const std::size_t overlay_count =
+            texture_coordinator_ ? texture_coordinator_->GetOverlayCount() : 0;
+        GLint overlay_offsets[kMaxOverlayLayers * 2] = {};
+        GLint overlay_sizes[kMaxOverlayLayers * 2] = {};
+        GLfloat overlay_opacities[kMaxOverlayLayers] = {};
+        for (int layer = 0; layer < kMaxOverlayLayers; ++layer) {
+            const GLint tex_unit = static_cast<GLint>(kPoolArrays) + kMaxFallbackLevels + layer;
+            glActiveTexture(GL_TEXTURE0 + tex_unit);
+
+            std::uint32_t indirection_id = 0;
+            if (static_cast<std::size_t>(layer) < overlay_count) {
+                const TileTextureCoordinator* overlay = texture_coordinator_->GetOverlay(layer);
+                indirection_id = overlay->GetIndirectionTextureID(current_zoom);
+                const glm::ivec2 offset = overlay->GetIndirectionOffset(current_zoom);
+                const glm::ivec2 size = overlay->GetIndirectionSize(current_zoom);
+                overlay_offsets[layer * 2] = offset.x;
+                overlay_offsets[layer * 2 + 1] = offset.y;
+                overlay_sizes[layer * 2] = size.x;
+                overlay_sizes[layer * 2 + 1] = size.y;
+                overlay_opacities[layer] = texture_coordinator_->GetOverlayOpacity(layer);
+            } else if (texture_coordinator_) {
+                indirection_id = texture_coordinator_->GetIndirectionTextureID(-1);
+            }
+
+            glBindTexture(GL_TEXTURE_2D, indirection_id);
+            glUniform1i(locs.overlay_indirection[layer], tex_unit);
+        }
+        glUniform1i(locs.overlay_count, static_cast<GLint>(overlay_count));
+        glUniform2iv(locs.overlay_offset, kMaxOverlayLayers, overlay_offsets);
+        glUniform2iv(locs.overlay_size, kMaxOverlayLayers, overlay_sizes);
+        glUniform1fv(locs.overlay_opacity, kMaxOverlayLayers, overlay_opacities);
+
+        if (draw_terrain) {
+            GpuFrameProfiler::Scope scope(profiler_, RenderPass::GLOBE);
+            RenderTerrainPatches(locs, view_matrix, projection_matrix);
+        } else {
+            // Render globe mesh with atlas texture
+            GpuFrameProfiler::Scope scope(profiler_, RenderPass::GLOBE);
+            glBindVertexArray(globe_gpu_mesh_->vao);
+            GPUResourceManager::DrawGlobeMesh(*globe_gpu_mesh_);
+            glBindVertexArray(0);
+        }
+
+        // Tile feedback for the next frames, within the zooms the shader can
+        // fall back through from the estimated zoom
+        if (feedback_pass_.IsInitialized() && globe_gpu_mesh_) {
+            GpuFrameProfiler::Scope scope(profiler_, RenderPass::TILE_FEEDBACK);
+            feedback_pass_.Render(*globe_gpu_mesh_, view_matrix, projection_matrix,
+                                  std::max(kMinZoom, current_zoom_level_ - (kMaxFallbackLevels - 1)),
+                                  current_zoom_level_);
+        }
         
         // Restore previous OpenGL state
         if (!depth_test_enabled) {
@@ -392,8 +661,21 @@ public:
             glDisable(GL_CULL_FACE);
         }
         
+        // Tiles drawn for the first time end their load traces
+        if (texture_coordinator_ && texture_coordinator_->IsTracingTiles()) {
+            std::pmr::vector<TileCoordinates> drawn(frame_arena_.GetResource());
+            for (const auto& tile : visible_tiles_) {
+                if (tile.is_ready) {
+                    drawn.push_back(tile.coordinates);
+                }
+            }
+            texture_coordinator_->MarkTilesRendered(drawn);
+        }
+
         stats_.rendered_tiles = visible_tiles_.size();
-        stats_.texture_binds = 1 + kMaxFallbackLevels;  // tile pool + indirection textures
+        stats_.texture_binds = static_cast<std::size_t>(kPoolArrays) + kMaxFallbackLevels  // tile pool + indirection textures
+            + kMaxOverlayLayers                                                            // overlay indirection textures
+            + (draw_terrain ? 1 : 0);                                                      // elevation array
     }
     
     TileRenderStats GetStats() const override {
@@ -404,14 +686,56 @@ public:
         return config_;
     }
     
+    void SetCameraVelocity(const glm::vec3& velocity) override {
+        camera_velocity_ = velocity;
+    }
+
+    void PrefetchDestination(const glm::vec3& destination, float duration_seconds) override {
+        prefetcher_.SetDestination(destination, duration_seconds);
+    }
+
     void SetConfig(const TileRenderConfig& config) override {
+        WaitForSelection();
+        const TerrainConfig previous_terrain = config_.terrain;
         config_ = config;
+        if (initialized_ &&
+            (config_.terrain.enabled != (terrain_program_ != 0) ||
+             config_.terrain.patch_resolution != previous_terrain.patch_resolution ||
+             config_.terrain.max_elevation_tiles != previous_terrain.max_elevation_tiles ||
+             config_.terrain.elevation_workers != previous_terrain.elevation_workers ||
+             config_.terrain.gpu_culling != previous_terrain.gpu_culling ||
+             config_.terrain.lod_levels != previous_terrain.lod_levels)) {
+            ReleaseTerrain();
+            if (config_.terrain.enabled && !InitializeTerrain()) {
+                spdlog::warn("Terrain patches unavailable, drawing the globe mesh");
+            }
+        }
+        if (!config_.terrain.enabled) {
+            terrain_tiles_.clear();
+        }
+        prefetcher_.SetConfig(config_.prefetch);
+        selector_.SetConfig(ClampToFallbackReach(config_.selection));
+        if (config_.feedback.enabled) {
+            if (initialized_ && !feedback_pass_.Initialize(config_.feedback)) {
+                spdlog::warn("Tile feedback pass unavailable, selecting tiles on the CPU");
+            }
+            feedback_pass_.SetConfig(config_.feedback);
+        } else {
+            feedback_pass_.Release();
+            feedback_tiles_.clear();
+            has_feedback_ = false;
+        }
         spdlog::info("Tile renderer config updated: max_tiles={}", 
                     config_.max_visible_tiles);
     }
     
     void ClearCache() override {
         visible_tiles_.clear();
+        terrain_tiles_.clear();
+        if (elevation_pool_) {
+            elevation_pool_->Clear();
+        }
+        prefetcher_.Reset();
         // Cache cleared
         spdlog::info("Tile renderer cache cleared");
     }
@@ -436,14 +760,37 @@ private:
     TileRenderConfig config_;
     TileManager* tile_manager_ = nullptr;
     TileTextureCoordinator* texture_coordinator_ = nullptr;
+    TileRequestMerger* request_merger_ = nullptr;  // Shared with other views, may be null
+    float request_weight_ = 1.0f;
+    GpuFrameProfiler* profiler_ = nullptr;  // Owned by the renderer, may be null
     GlobeMesh* globe_mesh_ = nullptr;  // External globe mesh to render on
+    ElevationManager* elevation_manager_ = nullptr;  // Terrain displacement source
     bool initialized_ = false;
-    bool mesh_uploaded_to_gpu_ = false;  // Track if mesh data is on GPU
     std::uint64_t frame_counter_ = 0;
     std::vector<TileRenderState> visible_tiles_;
+    std::vector<TileTextureCoordinator::TileState> visible_tile_states_;  // Reused per frame
+    FrameArena frame_arena_;  // Per-frame temporaries, reset in BeginFrame
     TileRenderStats stats_;
     
     std::vector<TileCoordinates> last_visible_tiles_;
+
+    // Predictive prefetch
+    TilePrefetcher prefetcher_;
+    glm::vec3 camera_velocity_{0.0f};
+    std::optional<std::chrono::steady_clock::time_point> last_update_time_;
+
+    // Screen-space-error tile selection
+    TileSelector selector_;
+    std::uint32_t viewport_height_ = kDefaultViewportHeight;
+
+    // Selection running on a worker (BeginTileSelection)
+    TileSelectionWorker selection_worker_;
+
+    // GPU tile feedback (opt-in)
+    TileFeedbackPass feedback_pass_;
+    std::vector<TileCoordinates> feedback_tiles_;
+    bool has_feedback_ = false;
+    int current_zoom_level_ = kDefaultZoomLevel;
     
     // OpenGL objects
     std::uint32_t tile_shader_program_ = 0;
@@ -458,20 +805,46 @@ private:
         GLint zoom_level = -1;
         GLint num_fallback_levels = -1;
         GLint tile_pool = -1;
+        GLint pool_layer_shift = -1;
         GLint indirection[5] = {-1, -1, -1, -1, -1};
         GLint indirection_offset[5] = {-1, -1, -1, -1, -1};
+        GLint indirection_size[5] = {-1, -1, -1, -1, -1};
+        GLint overlay_indirection[3] = {-1, -1, -1};
+        GLint overlay_offset = -1;
+        GLint overlay_size = -1;
+        GLint overlay_opacity = -1;
+        GLint overlay_count = -1;
+        // Terrain program only
+        GLint elevation = -1;
+        GLint elevation_samples = -1;
+        GLint height_scale = -1;
+        GLint skirt_depth = -1;
+        GLint terrain_normals = -1;
     } uniform_locs_;
-    std::uint32_t globe_vao_ = 0;
-    std::uint32_t globe_vbo_ = 0;
-    std::uint32_t globe_ebo_ = 0;
-    std::vector<unsigned int> globe_indices_;
+    // GPU copy of globe_mesh_, in the renderer's manager or one of our own
+    GPUResourceManager* gpu_resources_ = nullptr;
+    std::unique_ptr<GPUResourceManager> owned_gpu_resources_;
+    const GPUMesh* globe_gpu_mesh_ = nullptr;
+
+    // Chunked-LOD terrain (TerrainConfig::enabled): one instance of the
+    // shared patch per tile of terrain_tiles_
+    std::vector<TileCoordinates> terrain_tiles_;
+    std::unique_ptr<TerrainElevationPool> elevation_pool_;
+    std::vector<float> terrain_instances_;
+    std::uint32_t terrain_program_ = 0;
+    UniformLocations terrain_uniform_locs_;
+    std::uint32_t terrain_vao_ = 0;
+    std::uint32_t terrain_vbo_ = 0;
+    std::uint32_t terrain_ebo_ = 0;
+    std::uint32_t terrain_instance_vbo_ = 0;
+    GLsizei terrain_index_count_ = 0;  // Full-density level
+    TerrainCullPass terrain_cull_pass_;  // GL 4.3+ with TerrainConfig::gpu_culling
     
     // Tile atlas vertex shader source
     static constexpr const char* kTileVertexShader = R"(
 #version 330 core
 layout (location = 0) in vec3 aPos;
-layout (location = 1) in vec3 aNormal;
-layout (location = 2) in vec2 aTexCoord;
+layout (location = 1) in vec2 aNormal;  // Octahedral (PackedGlobeVertex)
 
 uniform mat4 uModel;
 uniform mat4 uView;
@@ -480,25 +853,58 @@ uniform mat4 uProjection;
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoord;
+out vec3 Direction;
+
+const float PI = 3.14159265358979;
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0) {
+        n.xy = (1.0 - abs(e.yx)) * vec2(e.x >= 0.0 ? 1.0 : -1.0, e.y >= 0.0 ? 1.0 : -1.0);
+    }
+    return normalize(n);
+}
 
 void main() {
     FragPos = vec3(uModel * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(uModel))) * aNormal;
-    TexCoord = aTexCoord;
+    Normal = mat3(transpose(inverse(uModel))) * octDecode(aNormal);
+
+    // Texture coordinates follow from the direction (longitude 0 on +Z,
+    // east towards +X, north on +Y), as on the CPU. Web Mercator is not
+    // linear across a triangle: the fragment shader projects the direction.
+    vec3 direction = normalize(aPos);
+    float lon = (direction.x == 0.0 && direction.z == 0.0) ? 0.0 : atan(direction.x, direction.z);
+    float lat = asin(clamp(direction.y, -1.0, 1.0));
+    TexCoord = vec2((lon + PI) / (2.0 * PI), (lat + 0.5 * PI) / PI);
+    Direction = direction;
     gl_Position = uProjection * uView * vec4(FragPos, 1.0);
 }
 )";
 
     // Tile pool + indirection fragment shader
+    //
+    // Web Mercator is projected per fragment from the interpolated direction
+    // (DirectionToMercator on the CPU): interpolating the projected vertices
+    // shifts the imagery inside coarse triangles. Indirection textures are
+    // pre-resolved on the CPU: each texel already holds the finest loaded
+    // ancestor and its level delta, so a fragment does at most one
+    // indirection fetch and one pool sample. Coarser levels are only
+    // consulted when the fragment lies outside a finer level's window.
+    //
+    // Overlay layers sample the same pool through their own indirection
+    // texture at the current zoom and are blended over the base imagery, in
+    // order, before lighting: N layers cost N extra fetches, not N passes.
     static constexpr const char* kTileFragmentShader = R"(
 #version 330 core
 in vec3 FragPos;
 in vec3 Normal;
 in vec2 TexCoord;
+in vec3 Direction;
 
 out vec4 FragColor;
 
-uniform sampler2DArray uTilePool;
+uniform sampler2DArray uTilePool[8];
+uniform int uPoolLayerShift;
 uniform usampler2D uIndirection0;
 uniform usampler2D uIndirection1;
 uniform usampler2D uIndirection2;
@@ -511,38 +917,98 @@ uniform ivec2 uIndirectionOffset1;
 uniform ivec2 uIndirectionOffset2;
 uniform ivec2 uIndirectionOffset3;
 uniform ivec2 uIndirectionOffset4;
+uniform ivec2 uIndirectionSize0;
+uniform ivec2 uIndirectionSize1;
+uniform ivec2 uIndirectionSize2;
+uniform ivec2 uIndirectionSize3;
+uniform ivec2 uIndirectionSize4;
+uniform usampler2D uOverlayIndirection0;
+uniform usampler2D uOverlayIndirection1;
+uniform usampler2D uOverlayIndirection2;
+uniform ivec2 uOverlayOffset[3];
+uniform ivec2 uOverlaySize[3];
+uniform float uOverlayOpacity[3];
+uniform int uOverlayCount;
 uniform vec3 uLightPos;
 uniform vec3 uLightColor;
 
-vec2 worldToGeo(vec3 pos) {
-    vec3 n = normalize(pos);
-    return vec2(atan(n.x, n.z) * 180.0 / 3.14159265359,
-                asin(n.y) * 180.0 / 3.14159265359);
+const uint INVALID_ENTRY = 0xFFFFu;
+const uint LAYER_MASK = 0x1FFFu;
+const uint LEVELS_UP_SHIFT = 13u;
+const float PI = 3.14159265358979;
+const float MAX_LATITUDE = 1.48442222974871;  // 85.05112878 degrees
+
+// Normalized Web Mercator of the fragment's direction (x east, y south).
+// Longitude jumps at the antimeridian: next to it, the same longitude with
+// the seam moved to the prime meridian varies smoothly, so use whichever
+// varies less across the quad.
+vec2 mercatorCoord() {
+    vec3 direction = normalize(Direction);
+    float lon = (direction.x == 0.0 && direction.z == 0.0) ? 0.0 : atan(direction.x, direction.z);
+    float lat = clamp(asin(clamp(direction.y, -1.0, 1.0)), -MAX_LATITUDE, MAX_LATITUDE);
+    float x = (lon + PI) / (2.0 * PI);
+    float shiftedX = fract(x + 0.5);
+    if (fwidth(x) > fwidth(shiftedX)) x = fract(shiftedX + 0.5);
+    return vec2(x, (1.0 - log(tan(0.25 * PI + 0.5 * lat)) / PI) * 0.5);
+}
+
+// Windowed levels are addressed toroidally (texel = tile mod size); sizes
+// are powers of two and full levels never wrap
+bool windowTexel(int level, ivec2 tile, out ivec2 texel) {
+    ivec2 local;
+    ivec2 size;
+    if      (level == 0) { local = tile - uIndirectionOffset0; size = uIndirectionSize0; }
+    else if (level == 1) { local = tile - uIndirectionOffset1; size = uIndirectionSize1; }
+    else if (level == 2) { local = tile - uIndirectionOffset2; size = uIndirectionSize2; }
+    else if (level == 3) { local = tile - uIndirectionOffset3; size = uIndirectionSize3; }
+    else                 { local = tile - uIndirectionOffset4; size = uIndirectionSize4; }
+    texel = tile & (size - 1);
+    return all(greaterThanEqual(local, ivec2(0))) && all(lessThan(local, size));
 }
 
-void geoToTileAndFrac(vec2 geo, int zoom, out ivec2 tile, out vec2 frac) {
-    const float PI = 3.14159265359;
-    int n = 1 << zoom;
-    float fx = ((geo.x + 180.0) / 360.0) * float(n);
-    float lat_rad = clamp(geo.y, -85.0511, 85.0511) * PI / 180.0;
-    float fy = ((1.0 - log(tan(PI / 4.0 + lat_rad / 2.0)) / PI) / 2.0) * float(n);
-    tile = ivec2(clamp(int(floor(fx)), 0, n - 1), clamp(int(floor(fy)), 0, n - 1));
-    frac = vec2(fract(fx), fract(fy));
+// Pool layers are spread over arrays of 1 << uPoolLayerShift layers.
+// Sampler arrays may only be indexed by constants in GLSL 3.30, and the
+// branch is not uniform: implicit derivatives are undefined here, so the
+// mip level (and anisotropy) comes from gradients taken in main().
+vec4 samplePool(uint layer, vec2 uv, vec2 dx, vec2 dy) {
+    int array = int(layer) >> uPoolLayerShift;
+    vec3 coord = vec3(uv, float(int(layer) & ((1 << uPoolLayerShift) - 1)));
+    if      (array == 0) return textureGrad(uTilePool[0], coord, dx, dy);
+    else if (array == 1) return textureGrad(uTilePool[1], coord, dx, dy);
+    else if (array == 2) return textureGrad(uTilePool[2], coord, dx, dy);
+    else if (array == 3) return textureGrad(uTilePool[3], coord, dx, dy);
+    else if (array == 4) return textureGrad(uTilePool[4], coord, dx, dy);
+    else if (array == 5) return textureGrad(uTilePool[5], coord, dx, dy);
+    else if (array == 6) return textureGrad(uTilePool[6], coord, dx, dy);
+    else                 return textureGrad(uTilePool[7], coord, dx, dy);
 }
 
-uint safeFetch(usampler2D tex, ivec2 coord) {
-    ivec2 sz = textureSize(tex, 0);
-    if (coord.x < 0 || coord.y < 0 || coord.x >= sz.x || coord.y >= sz.y)
-        return 0xFFFFu;
-    return texelFetch(tex, coord, 0).r;
+uint fetchEntry(int level, ivec2 texel) {
+    if      (level == 0) return texelFetch(uIndirection0, texel, 0).r;
+    else if (level == 1) return texelFetch(uIndirection1, texel, 0).r;
+    else if (level == 2) return texelFetch(uIndirection2, texel, 0).r;
+    else if (level == 3) return texelFetch(uIndirection3, texel, 0).r;
+    else                 return texelFetch(uIndirection4, texel, 0).r;
 }
 
-uint lookupLayer(int level, ivec2 tile) {
-    if      (level == 0) return safeFetch(uIndirection0, tile - uIndirectionOffset0);
-    else if (level == 1) return safeFetch(uIndirection1, tile - uIndirectionOffset1);
-    else if (level == 2) return safeFetch(uIndirection2, tile - uIndirectionOffset2);
-    else if (level == 3) return safeFetch(uIndirection3, tile - uIndirectionOffset3);
-    else                 return safeFetch(uIndirection4, tile - uIndirectionOffset4);
+uint fetchOverlayEntry(int layer, ivec2 texel) {
+    if      (layer == 0) return texelFetch(uOverlayIndirection0, texel, 0).r;
+    else if (layer == 1) return texelFetch(uOverlayIndirection1, texel, 0).r;
+    else                 return texelFetch(uOverlayIndirection2, texel, 0).r;
+}
+
+// Color of an overlay at the fragment; alpha 0 where the layer has no tile
+vec4 sampleOverlay(int layer, vec2 mercator, vec2 dx, vec2 dy) {
+    int n = 1 << uZoomLevel;
+    ivec2 tile = clamp(ivec2(floor(mercator * float(n))), ivec2(0), ivec2(n - 1));
+    ivec2 local = tile - uOverlayOffset[layer];
+    ivec2 size = uOverlaySize[layer];
+    if (any(lessThan(local, ivec2(0))) || any(greaterThanEqual(local, size))) return vec4(0.0);
+
+    uint entry = fetchOverlayEntry(layer, tile & (size - 1));
+    if (entry == INVALID_ENTRY) return vec4(0.0);
+    float scale = float(n >> int(entry >> LEVELS_UP_SHIFT));
+    return samplePool(entry & LAYER_MASK, fract(mercator * scale), dx * scale, dy * scale);
 }
 
 void main() {
@@ -553,27 +1019,118 @@ void main() {
     float diff = max(dot(norm, lightDir), 0.0);
     vec3 diffuse = diff * uLightColor;
 
-    vec2 geo = worldToGeo(FragPos);
+    vec2 mercator = mercatorCoord();
+    // Mercator is continuous across tile edges, unlike the per-tile fract()
+    vec2 mercatorDx = dFdx(mercator);
+    vec2 mercatorDy = dFdy(mercator);
 
+    vec4 color = vec4(0.85, 0.82, 0.75, 1.0);
     for (int level = 0; level < uNumFallbackLevels; level++) {
         int zoom = uZoomLevel - level;
         if (zoom < 0) break;
 
-        ivec2 tile;
-        vec2 frac;
-        geoToTileAndFrac(geo, zoom, tile, frac);
+        int n = 1 << zoom;
+        ivec2 tile = clamp(ivec2(floor(mercator * float(n))), ivec2(0), ivec2(n - 1));
+        ivec2 texel;
+        if (!windowTexel(level, tile, texel)) continue;
+
+        // The entry already accounts for coarser levels: no further lookups
+        uint entry = fetchEntry(level, texel);
+        if (entry != INVALID_ENTRY) {
+            int levelsUp = int(entry >> LEVELS_UP_SHIFT);
+            float scale = float(n >> levelsUp);
+            vec2 frac = fract(mercator * scale);
+            color = samplePool(entry & LAYER_MASK, frac,
+                               mercatorDx * scale, mercatorDy * scale);
+        }
+        break;
+    }
 
-        uint layerIdx = lookupLayer(level, tile);
+    for (int layer = 0; layer < uOverlayCount; layer++) {
+        if (uOverlayOpacity[layer] <= 0.0) continue;
+        vec4 overlay = sampleOverlay(layer, mercator, mercatorDx, mercatorDy);
+        color.rgb = mix(color.rgb, overlay.rgb, overlay.a * uOverlayOpacity[layer]);
+    }
 
-        if (layerIdx != 0xFFFFu) {
-            vec4 texColor = texture(uTilePool, vec3(frac, float(layerIdx)));
-            FragColor = vec4((ambient + diffuse) * texColor.rgb, texColor.a);
-            return;
-        }
+    FragColor = vec4((ambient + diffuse) * color.rgb, color.a);
+}
+)";
+
+    // Terrain patch vertex shader (paired with kTileFragmentShader)
+    //
+    // One instance per tile: the shared patch is placed on the tile's part
+    // of the globe and displaced along the surface normal by the elevation
+    // array. Tiles finer than the elevation zoom read a window of an
+    // ancestor's layer; layer -1 leaves the tile flat.
+    static constexpr const char* kTerrainVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 aPatch;           // u east, v south, skirt
+layout (location = 4) in vec4 aTile;            // x, y, zoom, elevation layer
+layout (location = 5) in vec3 aElevationWindow; // offset, scale in the layer
+
+uniform mat4 uView;
+uniform mat4 uProjection;
+uniform sampler2DArray uElevation;
+uniform float uElevationSamples;
+uniform float uHeightScale;  // globe radii per meter (0 = flat)
+uniform float uSkirtDepth;   // fraction of the tile width
+uniform bool uTerrainNormals;
+
+out vec3 FragPos;
+out vec3 Normal;
+out vec2 TexCoord;
+out vec3 Direction;
+
+const float PI = 3.14159265358979;
+
+float heightAt(vec2 uv) {
+    if (aTile.w < 0.0) return 0.0;
+    vec2 st = aElevationWindow.xy + clamp(uv, 0.0, 1.0) * aElevationWindow.z;
+    // Sample i sits at texel center i, so grid vertices hit samples exactly
+    vec2 texel = (st * (uElevationSamples - 1.0) + 0.5) / uElevationSamples;
+    return texture(uElevation, vec3(texel, aTile.w)).r * uHeightScale;
+}
+
+// Longitude and latitude in radians
+vec2 geographicAt(vec2 uv) {
+    vec2 mercator = (aTile.xy + uv) / exp2(aTile.z);
+    return vec2(mercator.x * 2.0 * PI - PI, atan(sinh(PI * (1.0 - 2.0 * mercator.y))));
+}
+
+vec3 directionOf(vec2 geographic) {
+    float cosLat = cos(geographic.y);
+    return vec3(cosLat * sin(geographic.x), sin(geographic.y), cosLat * cos(geographic.x));
+}
+
+vec3 surfaceAt(vec2 uv) {
+    return directionOf(geographicAt(uv)) * (1.0 + heightAt(uv));
+}
+
+void main() {
+    vec2 uv = aPatch.xy;
+    float n = exp2(aTile.z);
+    vec2 geographic = geographicAt(uv);
+    // The outer tile rows reach the poles, as on the globe mesh
+    if (uv.y == 0.0 && aTile.y == 0.0) geographic.y = 0.5 * PI;
+    if (uv.y == 1.0 && aTile.y == n - 1.0) geographic.y = -0.5 * PI;
+    vec3 up = directionOf(geographic);
+
+    // Skirts hang below the edge to hide cracks next to other zooms
+    vec3 position = up * (1.0 + heightAt(uv) - aPatch.z * uSkirtDepth * 2.0 * PI / n);
+
+    Normal = up;
+    if (uTerrainNormals && aTile.w >= 0.0) {
+        float d = 1.0 / (uElevationSamples - 1.0);
+        vec3 east = surfaceAt(uv + vec2(d, 0.0)) - surfaceAt(uv - vec2(d, 0.0));
+        vec3 north = surfaceAt(uv - vec2(0.0, d)) - surfaceAt(uv + vec2(0.0, d));
+        vec3 surfaceNormal = cross(east, north);
+        if (dot(surfaceNormal, surfaceNormal) > 0.0) Normal = normalize(surfaceNormal);
     }
 
-    vec3 baseColor = vec3(0.85, 0.82, 0.75);
-    FragColor = vec4((ambient + diffuse) * baseColor, 1.0);
+    FragPos = position;
+    TexCoord = vec2((geographic.x + PI) / (2.0 * PI), (geographic.y + 0.5 * PI) / PI);
+    Direction = up;
+    gl_Position = uProjection * uView * vec4(position, 1.0);
 }
 )";
 
@@ -587,14 +1144,32 @@ void main() {
         }
 
         // Cache uniform locations
-        uniform_locs_.view = glGetUniformLocation(tile_shader_program_, "uView");
-        uniform_locs_.projection = glGetUniformLocation(tile_shader_program_, "uProjection");
-        uniform_locs_.model = glGetUniformLocation(tile_shader_program_, "uModel");
-        uniform_locs_.light_pos = glGetUniformLocation(tile_shader_program_, "uLightPos");
-        uniform_locs_.light_color = glGetUniformLocation(tile_shader_program_, "uLightColor");
-        uniform_locs_.zoom_level = glGetUniformLocation(tile_shader_program_, "uZoomLevel");
-        uniform_locs_.num_fallback_levels = glGetUniformLocation(tile_shader_program_, "uNumFallbackLevels");
-        uniform_locs_.tile_pool = glGetUniformLocation(tile_shader_program_, "uTilePool");
+        uniform_locs_ = QueryUniformLocations(tile_shader_program_);
+
+        if (config_.terrain.enabled && !InitializeTerrain()) {
+            spdlog::warn("Terrain patches unavailable, drawing the globe mesh");
+        }
+
+        spdlog::info("Tile renderer OpenGL state initialized (mesh will be uploaded when provided)");
+        return true;
+    }
+
+    static UniformLocations QueryUniformLocations(std::uint32_t program) {
+        UniformLocations locs;
+        locs.view = glGetUniformLocation(program, "uView");
+        locs.projection = glGetUniformLocation(program, "uProjection");
+        locs.model = glGetUniformLocation(program, "uModel");
+        locs.light_pos = glGetUniformLocation(program, "uLightPos");
+        locs.light_color = glGetUniformLocation(program, "uLightColor");
+        locs.zoom_level = glGetUniformLocation(program, "uZoomLevel");
+        locs.num_fallback_levels = glGetUniformLocation(program, "uNumFallbackLevels");
+        locs.tile_pool = glGetUniformLocation(program, "uTilePool");
+        locs.pool_layer_shift = glGetUniformLocation(program, "uPoolLayerShift");
+        locs.elevation = glGetUniformLocation(program, "uElevation");
+        locs.elevation_samples = glGetUniformLocation(program, "uElevationSamples");
+        locs.height_scale = glGetUniformLocation(program, "uHeightScale");
+        locs.skirt_depth = glGetUniformLocation(program, "uSkirtDepth");
+        locs.terrain_normals = glGetUniformLocation(program, "uTerrainNormals");
 
         const char* indirection_names[] = {
             "uIndirection0", "uIndirection1", "uIndirection2",
@@ -604,212 +1179,264 @@ void main() {
             "uIndirectionOffset0", "uIndirectionOffset1", "uIndirectionOffset2",
             "uIndirectionOffset3", "uIndirectionOffset4"
         };
+        const char* size_names[] = {
+            "uIndirectionSize0", "uIndirectionSize1", "uIndirectionSize2",
+            "uIndirectionSize3", "uIndirectionSize4"
+        };
         for (int i = 0; i < kMaxFallbackLevels; ++i) {
-            uniform_locs_.indirection[i] = glGetUniformLocation(tile_shader_program_, indirection_names[i]);
-            uniform_locs_.indirection_offset[i] = glGetUniformLocation(tile_shader_program_, offset_names[i]);
+            locs.indirection[i] = glGetUniformLocation(program, indirection_names[i]);
+            locs.indirection_offset[i] = glGetUniformLocation(program, offset_names[i]);
+            locs.indirection_size[i] = glGetUniformLocation(program, size_names[i]);
         }
 
-        spdlog::info("Tile renderer OpenGL state initialized (mesh will be uploaded when provided)");
-        return true;
+        const char* overlay_names[] = {
+            "uOverlayIndirection0", "uOverlayIndirection1", "uOverlayIndirection2"
+        };
+        for (int i = 0; i < kMaxOverlayLayers; ++i) {
+            locs.overlay_indirection[i] = glGetUniformLocation(program, overlay_names[i]);
+        }
+        locs.overlay_offset = glGetUniformLocation(program, "uOverlayOffset");
+        locs.overlay_size = glGetUniformLocation(program, "uOverlaySize");
+        locs.overlay_opacity = glGetUniformLocation(program, "uOverlayOpacity");
+        locs.overlay_count = glGetUniformLocation(program, "uOverlayCount");
+        return locs;
     }
-    
-    bool UploadMeshToGPU() {
-        // Upload the provided icosahedron mesh to GPU
-        // This replaces the old sphere generation - we now use the actual displaced globe mesh
 
-        if (!globe_mesh_) {
-            spdlog::error("UploadMeshToGPU: no globe mesh available");
+    bool InitializeTerrain() {
+        terrain_program_ = ShaderLoader::CreateProgram(
+            kTerrainVertexShader, kTileFragmentShader, "tile_terrain");
+        if (terrain_program_ == 0) {
+            spdlog::error("Failed to create terrain patch shader program");
             return false;
         }
+        terrain_uniform_locs_ = QueryUniformLocations(terrain_program_);
+
+        const bool gpu_culling = config_.terrain.gpu_culling && TerrainCullPass::IsSupported();
+        const TerrainPatchGeometry patch = TerrainPatch::Generate(
+            config_.terrain.patch_resolution, gpu_culling ? config_.terrain.lod_levels : 1);
+        terrain_index_count_ = static_cast<GLsizei>(patch.lods.front().index_count);
+        elevation_pool_ = std::make_unique<TerrainElevationPool>(
+            config_.terrain.patch_resolution + 1, config_.terrain.max_elevation_tiles, false,
+            config_.terrain.elevation_workers);
+
+        glGenVertexArrays(1, &terrain_vao_);
+        glGenBuffers(1, &terrain_vbo_);
+        glGenBuffers(1, &terrain_ebo_);
+        glGenBuffers(1, &terrain_instance_vbo_);
+        glBindVertexArray(terrain_vao_);
+
+        glBindBuffer(GL_ARRAY_BUFFER, terrain_vbo_);
+        glBufferData(GL_ARRAY_BUFFER, patch.vertices.size() * sizeof(glm::vec3),
+                     patch.vertices.data(), GL_STATIC_DRAW);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+        glEnableVertexAttribArray(0);
 
-        const auto& mesh_vertices = globe_mesh_->GetVertices();
-        const auto& mesh_indices = globe_mesh_->GetVertexIndices();
-
-        if (mesh_vertices.empty() || mesh_indices.empty()) {
-            spdlog::error("UploadMeshToGPU: globe mesh has no geometry");
-            return false;
-        }
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, terrain_ebo_);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, patch.indices.size() * sizeof(std::uint32_t),
+                     patch.indices.data(), GL_STATIC_DRAW);
 
-        spdlog::info("Uploading globe mesh to GPU: {} vertices, {} indices",
-                     mesh_vertices.size(), mesh_indices.size());
+        // Per-instance tile (location = 4) and elevation window (location = 5)
+        constexpr GLsizei stride = kTerrainInstanceFloats * sizeof(float);
+        glBindBuffer(GL_ARRAY_BUFFER, terrain_instance_vbo_);
+        glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, stride, (void*)0);
+        glEnableVertexAttribArray(4);
+        glVertexAttribDivisor(4, 1);
+        glVertexAttribPointer(5, 3, GL_FLOAT, GL_FALSE, stride, (void*)(4 * sizeof(float)));
+        glEnableVertexAttribArray(5);
+        glVertexAttribDivisor(5, 1);
 
-        // Convert GlobeVertex to flat array for OpenGL
-        // Format: position(3) + normal(3) + texcoord(2) = 8 floats per vertex
-        std::vector<float> vertices;
-        vertices.reserve(mesh_vertices.size() * 8);
+        glBindVertexArray(0);
 
-        for (const auto& vertex : mesh_vertices) {
-            // Position
-            vertices.push_back(vertex.position.x);
-            vertices.push_back(vertex.position.y);
-            vertices.push_back(vertex.position.z);
-            // Normal
-            vertices.push_back(vertex.normal.x);
-            vertices.push_back(vertex.normal.y);
-            vertices.push_back(vertex.normal.z);
-            // Texture coordinates
-            vertices.push_back(vertex.texcoord.x);
-            vertices.push_back(vertex.texcoord.y);
+        if (gpu_culling && !terrain_cull_pass_.Initialize(terrain_vbo_, terrain_ebo_, patch.lods,
+                                                           config_.terrain.patch_resolution)) {
+            spdlog::warn("Terrain GPU culling unavailable, drawing every selected patch");
         }
 
-        // Store indices for rendering
-        globe_indices_.clear();
-        globe_indices_.reserve(mesh_indices.size());
-        for (const auto& index : mesh_indices) {
-            globe_indices_.push_back(static_cast<unsigned int>(index));
-        }
+        spdlog::info("Terrain patches initialized: {} vertices, {} indices per patch",
+                     patch.vertices.size(), terrain_index_count_);
+        return true;
+    }
 
-        // Clean up old GPU resources if they exist
-        if (globe_vao_ != 0) {
-            glDeleteVertexArrays(1, &globe_vao_);
-            globe_vao_ = 0;
+    void ReleaseTerrain() {
+        terrain_cull_pass_.Release();
+        elevation_pool_.reset();
+        if (terrain_vao_) {
+            glDeleteVertexArrays(1, &terrain_vao_);
+            terrain_vao_ = 0;
         }
-        if (globe_vbo_ != 0) {
-            glDeleteBuffers(1, &globe_vbo_);
-            globe_vbo_ = 0;
+        for (std::uint32_t* buffer : {&terrain_vbo_, &terrain_ebo_, &terrain_instance_vbo_}) {
+            if (*buffer) {
+                glDeleteBuffers(1, buffer);
+                *buffer = 0;
+            }
         }
-        if (globe_ebo_ != 0) {
-            glDeleteBuffers(1, &globe_ebo_);
-            globe_ebo_ = 0;
+        if (terrain_program_) {
+            glDeleteProgram(terrain_program_);
+            terrain_program_ = 0;
         }
+        terrain_index_count_ = 0;
+    }
 
-        // Create OpenGL objects
-        glGenVertexArrays(1, &globe_vao_);
-        glGenBuffers(1, &globe_vbo_);
-        glGenBuffers(1, &globe_ebo_);
-
-        // Bind VAO
-        glBindVertexArray(globe_vao_);
-
-        // Bind and fill VBO
-        glBindBuffer(GL_ARRAY_BUFFER, globe_vbo_);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float),
-                    vertices.data(), GL_STATIC_DRAW);
+    /**
+     * @brief Bring the elevation of terrain_tiles_ up to date and draw one patch per tile
+     *
+     * Called with the terrain program bound and the tile textures set up.
+     * With the cull pass the GPU drops hidden patches and picks each
+     * patch's density; otherwise every tile is drawn at full density.
+     */
+    void RenderTerrainPatches(const UniformLocations& locs, const glm::mat4& view_matrix,
+                              const glm::mat4& projection_matrix) {
+        const TerrainConfig& terrain = config_.terrain;
+        const ElevationProvider* provider =
+            elevation_manager_ && elevation_manager_->IsEnabled()
+                ? elevation_manager_->GetElevationProvider()
+                : nullptr;
+
+        float height_scale = 0.0f;
+        bool terrain_normals = false;
+        TerrainCullParams cull;
+        if (provider) {
+            const ElevationConfig elevation = elevation_manager_->GetConfiguration();
+            height_scale = elevation.exaggeration_factor /
+                           static_cast<float>(constants::geodetic::EARTH_MEAN_RADIUS);
+            terrain_normals = elevation.generate_normals;
+            cull.min_height = elevation.min_elevation * height_scale;
+            cull.max_height = elevation.max_elevation * height_scale;
+
+            // Coarsest first: fine tiles fall back to their ancestors meanwhile
+            std::vector<TileCoordinates> sources;
+            sources.reserve(terrain_tiles_.size());
+            for (const TileCoordinates& tile : terrain_tiles_) {
+                sources.push_back(TerrainPatch::GetElevationWindow(
+                    tile, std::min(tile.zoom, terrain.max_elevation_zoom)).source);
+            }
+            std::stable_sort(sources.begin(), sources.end(),
+                             [](const TileCoordinates& a, const TileCoordinates& b) {
+                                 return a.zoom < b.zoom;
+                             });
+            elevation_pool_->Update(sources, *provider, terrain.max_elevation_uploads,
+                                    elevation.min_elevation, elevation.max_elevation);
+        }
 
-        // Bind and fill EBO
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, globe_ebo_);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, globe_indices_.size() * sizeof(unsigned int),
-                    globe_indices_.data(), GL_STATIC_DRAW);
-        
-        // Set vertex attributes
-        // Position (location = 0)
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
-        glEnableVertexAttribArray(0);
+        terrain_instances_.clear();
+        terrain_instances_.reserve(terrain_tiles_.size() * kTerrainInstanceFloats);
+        for (const TileCoordinates& tile : terrain_tiles_) {
+            TerrainElevationWindow window;
+            int layer = -1;
+            if (provider) {
+                for (int zoom = std::min(tile.zoom, terrain.max_elevation_zoom);
+                     zoom >= 0 && layer < 0; --zoom) {
+                    window = TerrainPatch::GetElevationWindow(tile, zoom);
+                    layer = elevation_pool_->GetLayer(window.source);
+                }
+            }
+            terrain_instances_.insert(terrain_instances_.end(), {
+                static_cast<float>(tile.x), static_cast<float>(tile.y),
+                static_cast<float>(tile.zoom), static_cast<float>(layer),
+                window.offset.x, window.offset.y, window.scale});
+        }
 
-        // Normal (location = 1)
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
-        glEnableVertexAttribArray(1);
+        glActiveTexture(GL_TEXTURE0 + kElevationUnit);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, elevation_pool_->GetTextureID());
+        glUniform1i(locs.elevation, static_cast<GLint>(kElevationUnit));
+        glUniform1f(locs.elevation_samples, static_cast<float>(elevation_pool_->GetSamples()));
+        glUniform1f(locs.height_scale, height_scale);
+        glUniform1f(locs.skirt_depth, terrain.skirt_depth);
+        glUniform1i(locs.terrain_normals, terrain_normals ? 1 : 0);
+
+        if (terrain_cull_pass_.IsInitialized()) {
+            cull.view_projection = projection_matrix * view_matrix;
+            cull.camera_position = glm::vec3(glm::inverse(view_matrix)[3]);
+            cull.pixels_per_unit =
+                0.5f * static_cast<float>(viewport_height_) * projection_matrix[1][1];
+            cull.skirt_depth = terrain.skirt_depth;
+            cull.max_quad_pixels = terrain.max_quad_pixels;
+            terrain_cull_pass_.Cull(terrain_instances_, cull);
+            terrain_cull_pass_.Draw();
+            stats_.terrain_patches = terrain_tiles_.size();
+            return;
+        }
 
-        // Texture coordinates (location = 2)
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-        glEnableVertexAttribArray(2);
+        // Orphaned every frame: the previous frame's instances may still be in use
+        glBindBuffer(GL_ARRAY_BUFFER, terrain_instance_vbo_);
+        glBufferData(GL_ARRAY_BUFFER, terrain_instances_.size() * sizeof(float),
+                     terrain_instances_.data(), GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-        // Unbind VAO
+        glBindVertexArray(terrain_vao_);
+        glDrawElementsInstanced(GL_TRIANGLES, terrain_index_count_, GL_UNSIGNED_INT, 0,
+                                static_cast<GLsizei>(terrain_tiles_.size()));
         glBindVertexArray(0);
 
-        mesh_uploaded_to_gpu_ = true;
-
-        spdlog::info("Globe mesh uploaded to GPU: {} vertices, {} indices",
-                    vertices.size() / 8, globe_indices_.size());
-
-        return true;
+        stats_.terrain_patches = terrain_tiles_.size();
     }
     
-    void Cleanup() {
-        if (globe_vao_) {
-            glDeleteVertexArrays(1, &globe_vao_);
-            globe_vao_ = 0;
+    GPUResourceManager& GetGPUResources() {
+        if (!gpu_resources_) {
+            owned_gpu_resources_ = GPUResourceManager::Create();
+            gpu_resources_ = owned_gpu_resources_.get();
         }
-        if (globe_vbo_) {
-            glDeleteBuffers(1, &globe_vbo_);
-            globe_vbo_ = 0;
-        }
-        if (globe_ebo_) {
-            glDeleteBuffers(1, &globe_ebo_);
-            globe_ebo_ = 0;
+        return *gpu_resources_;
+    }
+
+    void Cleanup() {
+        feedback_pass_.Release();
+        ReleaseTerrain();
+        // A shared manager's buffers belong to the renderer
+        globe_gpu_mesh_ = nullptr;
+        if (owned_gpu_resources_) {
+            owned_gpu_resources_->Release();
         }
         if (tile_shader_program_) {
             glDeleteProgram(tile_shader_program_);
             tile_shader_program_ = 0;
         }
     }
-    int CalculateOptimalZoom(float camera_distance) const {
-        const float altitude = camera_distance - 1.0f;
 
-        if (altitude <= 0.0f) {
-            return kMaxZoom;
-        }
-
-        // Single logarithmic mapping: zoom = log2(K / altitude).
-        // K (kZoomAltitudeScale) is calibrated so that min camera altitude
-        // maps to kMaxZoom. Each doubling of altitude drops zoom by 1,
-        // matching the tile pyramid where each level doubles tile count.
-        const float zoom = std::log2(kZoomAltitudeScale / altitude);
-
-        spdlog::info("Tag. Picked zoom: {} for camera distance: {}", zoom, camera_distance);
-        return std::clamp(static_cast<int>(zoom), kMinZoom, kMaxZoom);
+    void WaitForSelection() {
+        selection_worker_.Wait();
     }
-    
-    BoundingBox2D CalculateVisibleGeographicBounds(const glm::vec3& camera_position,
-                                               const glm::mat4& view_matrix,
-                                               const glm::mat4& projection_matrix) const {
-        // Convert camera position to World coordinate type
-        using namespace coordinates;
-        World camera_world(camera_position);
-
-        // Use centralized CoordinateMapper for visibility calculation
-        GeographicBounds geo_bounds = CoordinateMapper::CalculateVisibleGeographicBounds(
-            camera_world, view_matrix, projection_matrix, 1.0f);
-
-        // Convert GeographicBounds to legacy BoundingBox2D format
-        // BoundingBox2D uses (longitude, latitude) in x, y components
-        // Original min/max
-        glm::dvec2 min(geo_bounds.min.longitude, geo_bounds.min.latitude);
-        glm::dvec2 max(geo_bounds.max.longitude, geo_bounds.max.latitude);
-
-        // // Center of the bounds
-        // glm::dvec2 center = (min + max) * 0.5;
 
-        // // Half extents
-        // glm::dvec2 half_extents = (max - min) * 0.5;
-
-        // // Scale factor: keep 20% (reduce by 80%)
-        // constexpr double scale = 0.2;
-
-        // half_extents *= scale;
-
-        // // New reduced bounds
-        // glm::dvec2 reduced_min = center - half_extents;
-        // glm::dvec2 reduced_max = center + half_extents;
-
-        // return BoundingBox2D(reduced_min, reduced_max);
-        return BoundingBox2D(min, max);
+    /**
+     * @brief Visible tiles selected on the CPU, covering the view without gaps
+     */
+    void SelectCoveringTiles(const glm::mat4& projection_matrix,
+                             const glm::vec3& camera_position,
+                             const Frustum& frustum,
+                             int zoom_level,
+                             std::pmr::vector<TileCoordinates>& tiles) {
+        // Using int64_t to avoid overflow, because with zoom_level 20, n equals 1048576 and n * n gives 0 with int32_t
+        const int64_t n = 1 << zoom_level;
+        tiles.clear();
+        if (n * n <= 256) {
+            // At low zoom (≤4) tiles are too large for the quadtree descent to
+            // cull much; the analytic visible region bounds them tightly, even
+            // at grazing angles
+            const coordinates::VisibleRegion region =
+                coordinates::CoordinateMapper::CalculateVisibleRegion(
+                    coordinates::World(camera_position), frustum);
+            selector_.SelectInRegion(camera_position, frustum, region, zoom_level,
+                                     static_cast<std::size_t>(config_.max_visible_tiles), tiles);
+        } else if (config_.selection.enabled) {
+            // Mixed zoom: near tiles at zoom_level, tiles toward the horizon of
+            // a tilted view only as fine as their screen-space error needs
+            const float focal_length_px = TileSelector::FocalLengthPixels(
+                projection_matrix, static_cast<float>(viewport_height_));
+            selector_.Select(
+                camera_position, frustum, focal_length_px, zoom_level,
+                static_cast<std::size_t>(config_.max_visible_tiles), tiles);
+        } else {
+            // Single zoom: same top-down frustum and horizon culling
+            selector_.SelectAtZoom(
+                camera_position, frustum, zoom_level,
+                static_cast<std::size_t>(config_.max_visible_tiles), tiles);
+        }
     }
-    
-    bool IsTileInFrustum(const TileCoordinates& tile, const Frustum& frustum) const {
-        // Calculate tile's geographic bounds
-        const BoundingBox2D bounds = TileMathematics::GetTileBounds(tile);
-        const glm::dvec2 center = bounds.GetCenter();
-
-        // Convert tile center to 3D position on unit sphere
-        const double lon_rad = glm::radians(center.x);
-        const double lat_rad = glm::radians(center.y);
-
-        // Calculate 3D position on unit sphere (Earth radius = 1.0)
-        const glm::vec3 tile_center = glm::vec3(
-            static_cast<float>(std::cos(lat_rad) * std::sin(lon_rad)),
-            static_cast<float>(std::sin(lat_rad)),
-            static_cast<float>(std::cos(lat_rad) * std::cos(lon_rad))
-        );
-
-        // Estimate tile radius on sphere surface based on zoom level
-        // Higher zoom = smaller tiles = smaller bounding sphere
-        // At zoom 0, tile covers 180 degrees, at zoom n, tile covers 180/2^n degrees
-        const float tile_angular_size = 180.0f / static_cast<float>(1 << tile.zoom);
-        const float tile_radius = glm::radians(tile_angular_size) * 0.5f;  // Half the angular size
-
-        // Use frustum sphere intersection test
-        return frustum.Intersects(tile_center, tile_radius);
+
+    int CalculateOptimalZoom(float camera_distance) const {
+        const int zoom = ZoomForCameraDistance(camera_distance);
+        spdlog::info("Tag. Picked zoom: {} for camera distance: {}", zoom, camera_distance);
+        return zoom;
     }
     
     float CalculateTileLOD(const TileCoordinates& tile, float /*camera_distance*/) const {
@@ -825,6 +1452,21 @@ void main() {
 };
 // Note: TriggerTileLoading() removed - tile loading now handled by TileTextureCoordinator
 
+int TileRenderer::ZoomForCameraDistance(float camera_distance) {
+    const float altitude = camera_distance - 1.0f;
+
+    if (altitude <= 0.0f) {
+        return kMaxZoom;
+    }
+
+    // Single logarithmic mapping: zoom = log2(K / altitude).
+    // K (kZoomAltitudeScale) is calibrated so that min camera altitude
+    // maps to kMaxZoom. Each doubling of altitude drops zoom by 1,
+    // matching the tile pyramid where each level doubles tile count.
+    const float zoom = std::log2(kZoomAltitudeScale / altitude);
+    return std::clamp(static_cast<int>(zoom), kMinZoom, kMaxZoom);
+}
+
 // Factory function
 std::unique_ptr<TileRenderer> TileRenderer::Create(const TileRenderConfig& config) {
     return std::make_unique<TileRendererImpl>(config);
@@ -0,0 +1,81 @@
+/**
+ * @file tile_request_merger.cpp
+ * @brief Per-frame tile request merge implementation
+ */
+
+#include <earth_map/renderer/tile_request_merger.h>
+#include <earth_map/renderer/texture_atlas/tile_texture_coordinator.h>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace earth_map {
+
+TileRequestMerger::TileRequestMerger(TileTextureCoordinator* coordinator)
+    : coordinator_(coordinator) {
+}
+
+void TileRequestMerger::Submit(std::span<const TileCoordinates> tiles, int priority, float weight) {
+    if (!(weight > 0.0f)) {
+        throw std::invalid_argument("TileRequestMerger: view weight must be positive");
+    }
+    const int weighted = static_cast<int>(std::lround(static_cast<float>(priority) / weight));
+    submitted_tiles_ += tiles.size();
+    for (const TileCoordinates& coords : tiles) {
+        const auto [it, inserted] = best_priority_.try_emplace(coords, weighted);
+        if (!inserted) {
+            it->second = std::min(it->second, weighted);
+        }
+    }
+}
+
+std::vector<MergedTileRequest> TileRequestMerger::TakeMerged() {
+    std::vector<MergedTileRequest> merged;
+    merged.reserve(best_priority_.size());
+    for (const auto& [coords, priority] : best_priority_) {
+        merged.push_back({coords, priority});
+    }
+    // Stable order within a priority keeps the worker queue deterministic
+    std::sort(merged.begin(), merged.end(),
+              [](const MergedTileRequest& a, const MergedTileRequest& b) {
+                  if (a.priority != b.priority) {
+                      return a.priority < b.priority;
+                  }
+                  if (a.coords.zoom != b.coords.zoom) {
+                      return a.coords.zoom < b.coords.zoom;
+                  }
+                  return a.coords.y != b.coords.y ? a.coords.y < b.coords.y
+                                                  : a.coords.x < b.coords.x;
+              });
+
+    stats_.submitted_tiles = submitted_tiles_;
+    stats_.unique_tiles = merged.size();
+    stats_.merged_duplicates += submitted_tiles_ - merged.size();
+    submitted_tiles_ = 0;
+    best_priority_.clear();
+    return merged;
+}
+
+std::size_t TileRequestMerger::Flush() {
+    const std::vector<MergedTileRequest> merged = TakeMerged();
+    if (!coordinator_) {
+        return merged.size();
+    }
+
+    coordinator_->BeginRequestGeneration();
+    std::vector<TileCoordinates> batch;
+    for (std::size_t begin = 0; begin < merged.size();) {
+        const int priority = merged[begin].priority;
+        batch.clear();
+        std::size_t end = begin;
+        for (; end < merged.size() && merged[end].priority == priority; ++end) {
+            batch.push_back(merged[end].coords);
+        }
+        coordinator_->RequestTiles(batch, priority);
+        begin = end;
+    }
+    coordinator_->CancelStaleRequests();
+    return merged.size();
+}
+
+} // namespace earth_map
@@ -0,0 +1,86 @@
+/**
+ * @file tile_selection_worker.cpp
+ * @brief Implementation of the persistent tile selection thread
+ */
+
+#include <earth_map/renderer/tile_selection_worker.h>
+#include <stdexcept>
+
+namespace earth_map {
+
+TileSelectionWorker::TileSelectionWorker(SelectFn select)
+    : select_(std::move(select)) {
+    if (!select_) {
+        throw std::invalid_argument("TileSelectionWorker: select function must not be empty");
+    }
+    thread_ = std::thread(&TileSelectionWorker::Run, this);
+}
+
+TileSelectionWorker::~TileSelectionWorker() {
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return !requested_ && !running_; });
+        stop_ = true;
+    }
+    cv_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void TileSelectionWorker::Start(const FrameSnapshot& snapshot, int zoom_level) {
+    Wait();
+    // The worker is idle: the snapshot and result are the render thread's
+    snapshot_ = snapshot;
+    zoom_level_ = zoom_level;
+    has_selection_ = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        requested_ = true;
+    }
+    cv_.notify_all();
+}
+
+void TileSelectionWorker::Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return !requested_ && !running_; });
+}
+
+const std::pmr::vector<TileCoordinates>* TileSelectionWorker::Take(
+    const glm::mat4& view, const glm::mat4& projection, const glm::vec3& camera_position) {
+    if (!has_selection_) {
+        return nullptr;
+    }
+    Wait();
+    has_selection_ = false;
+    const bool matches = snapshot_.view == view && snapshot_.projection == projection &&
+                         snapshot_.camera_position == camera_position;
+    return matches ? &selected_ : nullptr;
+}
+
+std::uint64_t TileSelectionWorker::GetRunCount() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return run_count_;
+}
+
+void TileSelectionWorker::Run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this] { return requested_ || stop_; });
+        if (stop_) {
+            return;
+        }
+        requested_ = false;
+        running_ = true;
+        lock.unlock();
+
+        select_(snapshot_, zoom_level_, selected_);
+
+        lock.lock();
+        running_ = false;
+        ++run_count_;
+        cv_.notify_all();
+    }
+}
+
+} // namespace earth_map
@@ -0,0 +1,356 @@
+/**
+ * @file tile_selector.cpp
+ * @brief Screen-space-error driven tile selection implementation
+ */
+
+#include <earth_map/renderer/tile_selector.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <utility>
+
+namespace earth_map {
+
+namespace {
+
+constexpr double kPi = 3.14159265358979323846;
+
+/// Nearest-point distances are clamped to this to keep the error finite
+constexpr float kMinErrorDistance = 1e-6f;
+
+/// Samples per tile edge for the bounding sphere
+constexpr int kBoundSamples = 3;
+
+/// Upper bound on the up-front reservation for the queue and the result
+constexpr std::size_t kMaxReservedTiles = 4096;
+
+/// Tile row edge to latitude in radians (Web Mercator)
+double TileYToLatitude(double y, double n) {
+    return std::atan(std::sinh(kPi * (1.0 - 2.0 * y / n)));
+}
+
+/// Tile column holding a longitude in degrees
+std::int64_t LongitudeToTileX(double longitude, std::int64_t n) {
+    const auto x = static_cast<std::int64_t>(std::floor((longitude + 180.0) / 360.0 * n));
+    return std::clamp<std::int64_t>(x, 0, n - 1);
+}
+
+/// Tile row holding a latitude in degrees (Web Mercator, row 0 at the north)
+std::int64_t LatitudeToTileY(double latitude, std::int64_t n) {
+    const double lat = std::clamp(latitude, -WebMercatorProjection::MAX_LATITUDE,
+                                  WebMercatorProjection::MAX_LATITUDE) * kPi / 180.0;
+    const double mercator = std::log(std::tan(lat) + 1.0 / std::cos(lat));
+    const auto y = static_cast<std::int64_t>(std::floor((1.0 - mercator / kPi) / 2.0 * n));
+    return std::clamp<std::int64_t>(y, 0, n - 1);
+}
+
+/// Geographic position (radians) on the unit globe, y up
+glm::dvec3 GeographicToWorld(double lon, double lat) {
+    const double cos_lat = std::cos(lat);
+    return glm::dvec3(cos_lat * std::sin(lon), std::sin(lat), cos_lat * std::cos(lon));
+}
+
+/**
+ * @brief Distance along @p direction at which a point hides @p position
+ *
+ * Both in occluder-scaled space. A point at this distance along the
+ * direction is below the horizon exactly when @p position is; the largest
+ * value over a tile's samples gives the tile's horizon occlusion point.
+ * Positions below the occluder surface are treated as on it.
+ *
+ * @return Distance, or a non-positive value if there is none (the
+ *         position is 90 degrees or more away from the direction)
+ */
+double HorizonPointDistance(const glm::dvec3& position, const glm::dvec3& direction) {
+    const double magnitude_squared = std::max(1.0, glm::dot(position, position));
+    const double magnitude = std::sqrt(magnitude_squared);
+    const glm::dvec3 position_direction = glm::normalize(position);
+
+    const double cos_alpha = glm::dot(position_direction, direction);
+    const double sin_alpha = glm::length(glm::cross(position_direction, direction));
+    const double cos_beta = 1.0 / magnitude;
+    const double sin_beta = std::sqrt(magnitude_squared - 1.0) * cos_beta;
+
+    const double denominator = cos_alpha * cos_beta - sin_alpha * sin_beta;
+    return denominator > 0.0 ? 1.0 / denominator : 0.0;
+}
+
+/// Quadtree node waiting for a refine decision, ordered by screen-space error
+struct Candidate {
+    TileCoordinates tile;
+    float error;
+
+    bool operator<(const Candidate& other) const { return error < other.error; }
+};
+
+} // namespace
+
+TileSelector::TileSelector(const TileSelectionConfig& config) : config_(config) {}
+
+TileSelector::TileBound TileSelector::ComputeBound(const TileCoordinates& tile,
+                                                  float occluder_radius) {
+    const double n = static_cast<double>(std::int64_t{1} << tile.zoom);
+    const double lon_min = tile.x / n * 2.0 * kPi - kPi;
+    const double lon_max = (tile.x + 1) / n * 2.0 * kPi - kPi;
+    const double lat_max = TileYToLatitude(tile.y, n);
+    const double lat_min = TileYToLatitude(tile.y + 1, n);
+
+    glm::dvec3 samples[kBoundSamples * kBoundSamples];
+    glm::dvec3 centroid(0.0);
+    for (int j = 0; j < kBoundSamples; ++j) {
+        const double lat = lat_min + (lat_max - lat_min) * j / (kBoundSamples - 1);
+        for (int i = 0; i < kBoundSamples; ++i) {
+            const double lon = lon_min + (lon_max - lon_min) * i / (kBoundSamples - 1);
+            samples[j * kBoundSamples + i] = GeographicToWorld(lon, lat);
+            centroid += samples[j * kBoundSamples + i];
+        }
+    }
+    centroid /= static_cast<double>(kBoundSamples * kBoundSamples);
+
+    double radius = 0.0;
+    for (const glm::dvec3& sample : samples) {
+        radius = std::max(radius, glm::length(sample - centroid));
+    }
+
+    // The surface bulges between samples by at most the sagitta of the
+    // widest sample spacing
+    const double spacing = std::max(lon_max - lon_min, lat_max - lat_min) / (kBoundSamples - 1);
+    const float sagitta = static_cast<float>(1.0 - std::cos(std::min(spacing, kPi) * 0.5));
+
+    TileBound bound;
+    bound.center = glm::vec3(centroid);
+    bound.radius = static_cast<float>(radius) + sagitta;
+
+    if (occluder_radius > 0.0f && glm::length(centroid) > 0.0) {
+        const glm::dvec3 direction = glm::normalize(centroid);
+        const double scale = 1.0 / occluder_radius;
+        double distance = 0.0;
+        bool valid = true;
+        for (const glm::dvec3& sample : samples) {
+            const double sample_distance = HorizonPointDistance(sample * scale, direction);
+            if (sample_distance <= 0.0) {
+                valid = false;
+                break;
+            }
+            distance = std::max(distance, sample_distance);
+        }
+        if (valid) {
+            bound.horizon_point = glm::vec3(direction * distance);
+            bound.has_horizon_point = true;
+        }
+    }
+    return bound;
+}
+
+bool TileSelector::IsBelowHorizon(const glm::vec3& scaled_camera, const glm::vec3& scaled_point) {
+    // Squared distance from the camera to its horizon circle
+    const float horizon_distance_squared = glm::dot(scaled_camera, scaled_camera) - 1.0f;
+    if (horizon_distance_squared <= 0.0f) {
+        return false;  // Camera inside the occluder
+    }
+
+    // Hidden if the point is beyond the horizon plane and inside the
+    // occluder's shadow cone
+    const glm::vec3 to_point = scaled_point - scaled_camera;
+    const float along_view = -glm::dot(to_point, scaled_camera);
+    return along_view > horizon_distance_squared &&
+           along_view * along_view / glm::dot(to_point, to_point) > horizon_distance_squared;
+}
+
+float TileSelector::FocalLengthPixels(const glm::mat4& projection, float viewport_height) {
+    return projection[1][1] * viewport_height * 0.5f;
+}
+
+float TileSelector::CalculateScreenSpaceError(const TileCoordinates& tile,
+                                              const glm::vec3& camera_position,
+                                              float focal_length_px) const {
+    return ErrorForBound(tile, ComputeBound(tile), camera_position, focal_length_px);
+}
+
+float TileSelector::ErrorForBound(const TileCoordinates& tile, const TileBound& bound,
+                                  const glm::vec3& camera_position,
+                                  float focal_length_px) const {
+    const double n = static_cast<double>(std::int64_t{1} << tile.zoom);
+    const double lat_north = TileYToLatitude(tile.y, n);
+    const double lat_south = TileYToLatitude(tile.y + 1, n);
+
+    // Texels are widest on the tile's edge closest to the equator
+    const double nearest_lat = (lat_north > 0.0 && lat_south < 0.0)
+        ? 0.0
+        : std::min(std::abs(lat_north), std::abs(lat_south));
+    const double texel_size =
+        2.0 * kPi * std::cos(nearest_lat) / (n * std::max<std::uint32_t>(config_.tile_size, 1));
+
+    const float distance = std::max(
+        glm::length(camera_position - bound.center) - bound.radius, kMinErrorDistance);
+
+    return static_cast<float>(texel_size) * focal_length_px / distance;
+}
+
+std::vector<TileCoordinates> TileSelector::Select(const glm::vec3& camera_position,
+                                                  const Frustum& frustum,
+                                                  float focal_length_px,
+                                                  std::int32_t max_zoom,
+                                                  std::size_t max_tiles) {
+    std::pmr::vector<TileCoordinates> selected;
+    Select(camera_position, frustum, focal_length_px, max_zoom, max_tiles, selected);
+    return std::vector<TileCoordinates>(selected.begin(), selected.end());
+}
+
+std::vector<TileCoordinates> TileSelector::SelectAtZoom(const glm::vec3& camera_position,
+                                                        const Frustum& frustum,
+                                                        std::int32_t zoom,
+                                                        std::size_t max_tiles) {
+    std::pmr::vector<TileCoordinates> selected;
+    SelectAtZoom(camera_position, frustum, zoom, max_tiles, selected);
+    return std::vector<TileCoordinates>(selected.begin(), selected.end());
+}
+
+void TileSelector::Select(const glm::vec3& camera_position, const Frustum& frustum,
+                          float focal_length_px, std::int32_t max_zoom, std::size_t max_tiles,
+                          std::pmr::vector<TileCoordinates>& selected) {
+    const std::int32_t min_zoom = std::max(0, max_zoom - std::max(0, config_.max_zoom_span));
+    Traverse(camera_position, frustum, focal_length_px, min_zoom, max_zoom, max_tiles, selected);
+}
+
+void TileSelector::SelectAtZoom(const glm::vec3& camera_position, const Frustum& frustum,
+                                std::int32_t zoom, std::size_t max_tiles,
+                                std::pmr::vector<TileCoordinates>& selected) {
+    // Error still orders the descent, so a budget cut keeps the nearest tiles
+    constexpr float kUnitFocalLength = 1.0f;
+    Traverse(camera_position, frustum, kUnitFocalLength, zoom, zoom, max_tiles, selected);
+}
+
+void TileSelector::SelectInRegion(const glm::vec3& camera_position, const Frustum& frustum,
+                                  const coordinates::VisibleRegion& region, std::int32_t zoom,
+                                  std::size_t max_tiles,
+                                  std::pmr::vector<TileCoordinates>& selected) {
+    stats_ = TileSelectionStats{};
+    stats_.coarsest_zoom = stats_.finest_zoom = zoom;
+    selected.clear();
+    if (zoom < 0 || max_tiles == 0 || region.IsEmpty()) {
+        return;
+    }
+
+    const float occluder_radius = config_.occluder_radius;
+    const bool horizon_culling = config_.horizon_culling && occluder_radius > 0.0f;
+    const glm::vec3 scaled_camera =
+        horizon_culling ? camera_position / occluder_radius : glm::vec3(0.0f);
+
+    const std::int64_t n = std::int64_t{1} << zoom;
+    const std::int64_t y_begin = LatitudeToTileY(region.bounds.max.latitude, n);
+    const std::int64_t y_end = LatitudeToTileY(region.bounds.min.latitude, n);
+    const std::int64_t x_west = LongitudeToTileX(region.west_longitude, n);
+    const std::int64_t x_east = LongitudeToTileX(region.east_longitude, n);
+    const std::int64_t columns = region.CrossesAntimeridian() ? n - x_west + x_east + 1
+                                                              : x_east - x_west + 1;
+
+    std::pmr::vector<std::pair<float, TileCoordinates>> candidates(selected.get_allocator());
+    for (std::int64_t y = y_begin; y <= y_end; ++y) {
+        for (std::int64_t column = 0; column < columns; ++column) {
+            const TileCoordinates tile(static_cast<std::int32_t>((x_west + column) % n),
+                                       static_cast<std::int32_t>(y), zoom);
+            ++stats_.visited_nodes;
+            const TileBound bound = ComputeBound(tile, occluder_radius);
+            if (!frustum.Intersects(bound.center, bound.radius)) {
+                ++stats_.culled_nodes;
+                continue;
+            }
+            if (horizon_culling && bound.has_horizon_point &&
+                IsBelowHorizon(scaled_camera, bound.horizon_point)) {
+                ++stats_.horizon_culled_nodes;
+                continue;
+            }
+            candidates.emplace_back(glm::length(bound.center - camera_position), tile);
+        }
+    }
+
+    if (candidates.size() > max_tiles) {
+        stats_.budget_limited = true;
+        std::nth_element(candidates.begin(), candidates.begin() + max_tiles, candidates.end(),
+                         [](const auto& a, const auto& b) { return a.first < b.first; });
+        candidates.resize(max_tiles);
+    }
+    selected.reserve(candidates.size());
+    for (const auto& candidate : candidates) {
+        selected.push_back(candidate.second);
+    }
+}
+
+void TileSelector::Traverse(const glm::vec3& camera_position,
+                            const Frustum& frustum,
+                            float focal_length_px,
+                            std::int32_t min_zoom,
+                            std::int32_t max_zoom,
+                            std::size_t max_tiles,
+                            std::pmr::vector<TileCoordinates>& selected) {
+    stats_ = TileSelectionStats{};
+    selected.clear();
+    if (max_zoom < 0 || max_tiles == 0) {
+        return;
+    }
+
+    const float occluder_radius = config_.occluder_radius;
+    const bool horizon_culling = config_.horizon_culling && occluder_radius > 0.0f;
+    const glm::vec3 scaled_camera =
+        horizon_culling ? camera_position / occluder_radius : glm::vec3(0.0f);
+
+    // Refine the largest error first so a budget cut leaves the error evenly
+    // spread instead of exhausting the budget on one corner of the view
+    // Reserved up front: a growing vector would strand its old blocks in an arena
+    selected.reserve(std::min(max_tiles, kMaxReservedTiles));
+    std::pmr::vector<Candidate> queue_storage(selected.get_allocator());
+    queue_storage.reserve(std::min<std::size_t>(max_tiles, kMaxReservedTiles));
+    std::priority_queue<Candidate, std::pmr::vector<Candidate>> queue(std::less<Candidate>(),
+                                                                      std::move(queue_storage));
+    const TileCoordinates root(0, 0, 0);
+    queue.push({root, ErrorForBound(root, ComputeBound(root, occluder_radius),
+                                    camera_position, focal_length_px)});
+
+    while (!queue.empty()) {
+        const Candidate candidate = queue.top();
+        queue.pop();
+        const TileCoordinates& tile = candidate.tile;
+        ++stats_.visited_nodes;
+
+        const bool wants_refine = tile.zoom < max_zoom &&
+            (tile.zoom < min_zoom || candidate.error > config_.max_texel_error);
+        // Splitting replaces one tile with up to four
+        const bool fits_budget = selected.size() + queue.size() + 4 <= max_tiles;
+        if (wants_refine && !fits_budget) {
+            stats_.budget_limited = true;
+        }
+
+        if (!wants_refine || !fits_budget) {
+            selected.push_back(tile);
+            continue;
+        }
+
+        // Culled children take their whole subtree with them
+        for (const TileCoordinates& child : tile.GetChildren()) {
+            const TileBound bound = ComputeBound(child, occluder_radius);
+            if (!frustum.Intersects(bound.center, bound.radius)) {
+                ++stats_.culled_nodes;
+                continue;
+            }
+            if (horizon_culling && bound.has_horizon_point &&
+                IsBelowHorizon(scaled_camera, bound.horizon_point)) {
+                ++stats_.horizon_culled_nodes;
+                continue;
+            }
+            queue.push({child, ErrorForBound(child, bound, camera_position, focal_length_px)});
+        }
+    }
+
+    std::sort(selected.begin(), selected.end(),
+              [](const TileCoordinates& a, const TileCoordinates& b) {
+                  return a.zoom > b.zoom;
+              });
+    if (!selected.empty()) {
+        stats_.finest_zoom = selected.front().zoom;
+        stats_.coarsest_zoom = selected.back().zoom;
+    }
+}
+
+} // namespace earth_map
@@ -0,0 +1,168 @@
+/**
+ * @file vector_tile_arena.cpp
+ * @brief Shared vector tile GPU buffers implementation
+ */
+
+#include <earth_map/renderer/vector_tile/vector_tile_arena.h>
+#include <GL/glew.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <iterator>
+
+namespace earth_map {
+
+VectorTileArena::RangeAllocator::RangeAllocator(std::uint32_t capacity)
+    : capacity_(std::max(capacity, 1u)) {
+    free_.emplace(0u, capacity_);
+}
+
+std::optional<std::uint32_t> VectorTileArena::RangeAllocator::Allocate(std::uint32_t count) {
+    if (count == 0) {
+        return 0u;
+    }
+    for (auto it = free_.begin(); it != free_.end(); ++it) {
+        if (it->second < count) {
+            continue;
+        }
+        const std::uint32_t offset = it->first;
+        const std::uint32_t remaining = it->second - count;
+        free_.erase(it);
+        if (remaining > 0) {
+            free_.emplace(offset + count, remaining);
+        }
+        used_ += count;
+        return offset;
+    }
+    return std::nullopt;
+}
+
+void VectorTileArena::RangeAllocator::Free(std::uint32_t offset, std::uint32_t count) {
+    if (count == 0) {
+        return;
+    }
+    used_ -= count;
+    auto next = free_.lower_bound(offset);
+    if (next != free_.begin()) {
+        const auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            offset = prev->first;
+            count += prev->second;
+            free_.erase(prev);
+        }
+    }
+    if (next != free_.end() && offset + count == next->first) {
+        count += next->second;
+        free_.erase(next);
+    }
+    free_.emplace(offset, count);
+}
+
+VectorTileArena::VectorTileArena(std::uint32_t max_vertices, std::uint32_t max_indices,
+                                 bool skip_gl_init)
+    : vertices_(max_vertices)
+    , indices_(max_indices)
+    , skip_gl_init_(skip_gl_init) {
+    if (skip_gl_init_) {
+        return;
+    }
+
+    GLuint handles[2] = {0, 0};
+    glGenBuffers(2, handles);
+    vertex_buffer_ = handles[0];
+    index_buffer_ = handles[1];
+    GLuint vertex_array = 0;
+    glGenVertexArrays(1, &vertex_array);
+    vertex_array_ = vertex_array;
+
+    glBindVertexArray(vertex_array_);
+    glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
+    glBufferData(GL_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(GetMaxVertices()) * sizeof(VectorTileVertex),
+                 nullptr, GL_DYNAMIC_DRAW);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(VectorTileVertex),
+                          (void*)offsetof(VectorTileVertex, position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(VectorTileVertex),
+                          (void*)offsetof(VectorTileVertex, extrude));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(VectorTileVertex),
+                          (void*)offsetof(VectorTileVertex, style));
+    glEnableVertexAttribArray(2);
+    // The element binding is part of the VAO
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer_);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER,
+                 static_cast<GLsizeiptr>(GetMaxIndices()) * sizeof(std::uint32_t),
+                 nullptr, GL_DYNAMIC_DRAW);
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+
+    spdlog::info("Vector tile arena: {} vertices, {} indices ({} KB)", GetMaxVertices(),
+                 GetMaxIndices(), GetGpuMemoryBytes() / 1024);
+}
+
+VectorTileArena::~VectorTileArena() {
+    if (vertex_array_ != 0) {
+        GLuint vertex_array = vertex_array_;
+        glDeleteVertexArrays(1, &vertex_array);
+    }
+    if (vertex_buffer_ != 0 || index_buffer_ != 0) {
+        const GLuint handles[2] = {vertex_buffer_, index_buffer_};
+        glDeleteBuffers(2, handles);
+    }
+}
+
+std::optional<VectorTileAllocation> VectorTileArena::Upload(const VectorTileMesh& mesh) {
+    if (mesh.vertices.size() > GetMaxVertices() || mesh.indices.size() > GetMaxIndices()) {
+        return std::nullopt;
+    }
+    VectorTileAllocation allocation;
+    allocation.vertex_count = static_cast<std::uint32_t>(mesh.vertices.size());
+    allocation.index_count = static_cast<std::uint32_t>(mesh.indices.size());
+    allocation.fill_index_count = static_cast<std::uint32_t>(mesh.fill_index_count);
+
+    const auto first_vertex = vertices_.Allocate(allocation.vertex_count);
+    if (!first_vertex) {
+        return std::nullopt;
+    }
+    const auto first_index = indices_.Allocate(allocation.index_count);
+    if (!first_index) {
+        vertices_.Free(*first_vertex, allocation.vertex_count);
+        return std::nullopt;
+    }
+    allocation.first_vertex = *first_vertex;
+    allocation.first_index = *first_index;
+
+    if (!skip_gl_init_ && allocation.index_count > 0) {
+        glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer_);
+        glBufferSubData(GL_ARRAY_BUFFER,
+                        static_cast<GLintptr>(allocation.first_vertex) * sizeof(VectorTileVertex),
+                        static_cast<GLsizeiptr>(allocation.vertex_count) * sizeof(VectorTileVertex),
+                        mesh.vertices.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        // Binding the element buffer outside a VAO would change the VAO bound
+        glBindVertexArray(0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer_);
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER,
+                        static_cast<GLintptr>(allocation.first_index) * sizeof(std::uint32_t),
+                        static_cast<GLsizeiptr>(allocation.index_count) * sizeof(std::uint32_t),
+                        mesh.indices.data());
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+    }
+    return allocation;
+}
+
+void VectorTileArena::Free(const VectorTileAllocation& allocation) {
+    vertices_.Free(allocation.first_vertex, allocation.vertex_count);
+    indices_.Free(allocation.first_index, allocation.index_count);
+}
+
+std::size_t VectorTileArena::GetGpuMemoryBytes() const {
+    if (skip_gl_init_) {
+        return 0;
+    }
+    return static_cast<std::size_t>(GetMaxVertices()) * sizeof(VectorTileVertex) +
+           static_cast<std::size_t>(GetMaxIndices()) * sizeof(std::uint32_t);
+}
+
+} // namespace earth_map
@@ -0,0 +1,398 @@
+/**
+ * @file vector_tile_layer.cpp
+ * @brief Vector tile layer implementation
+ */
+
+#include <earth_map/renderer/vector_tile/vector_tile_layer.h>
+#include <earth_map/core/flat_hash_map.h>
+#include <earth_map/data/tile_cache.h>
+#include <earth_map/data/tile_loader.h>
+#include <earth_map/renderer/shader_loader.h>
+#include <earth_map/renderer/texture_atlas/gl_upload_queue.h>
+#include <earth_map/renderer/texture_atlas/pixel_buffer_ring.h>
+#include <earth_map/renderer/texture_atlas/tile_load_worker_pool.h>
+#include <earth_map/renderer/vector_tile/vector_tile_arena.h>
+#include <GL/glew.h>
+#include <glm/gtc/type_ptr.hpp>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace earth_map {
+
+namespace {
+
+// Tile units go through Web Mercator onto the unit globe. Mercator is
+// conformal, so a line's normal in tile units maps to the same direction in
+// the east/north tangent plane; its screen direction comes from the
+// derivative of the projection, and the line is widened in pixels there.
+constexpr const char* kVectorTileVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec2 aPosition;
+layout (location = 1) in vec2 aExtrude;
+layout (location = 2) in float aStyle;
+
+uniform mat4 uViewProjection;
+uniform vec3 uTile;
+uniform vec2 uViewport;
+uniform bool uLines;
+uniform vec4 uFillColor[16];
+uniform vec4 uLineColor[16];
+uniform float uLineWidth[16];
+
+out vec4 Color;
+
+const float PI = 3.14159265358979;
+// Slightly above the surface so fills do not z-fight with the globe
+const float LIFT = 1.000002;
+
+void main() {
+    int style = int(aStyle + 0.5);
+    vec2 mercator = uTile.xy + aPosition * uTile.z;
+    float lon = (mercator.x - 0.5) * 2.0 * PI;
+    float lat = atan(sinh((0.5 - mercator.y) * 2.0 * PI));
+    vec3 world = LIFT * vec3(cos(lat) * sin(lon), sin(lat), cos(lat) * cos(lon));
+    vec4 clip = uViewProjection * vec4(world, 1.0);
+
+    if (uLines) {
+        vec3 east = vec3(cos(lon), 0.0, -sin(lon));
+        vec3 north = vec3(-sin(lat) * sin(lon), cos(lat), -sin(lat) * cos(lon));
+        vec4 along = uViewProjection * vec4(east * aExtrude.x - north * aExtrude.y, 0.0);
+        vec2 screen = (along.xy * clip.w - clip.xy * along.w) * uViewport;
+        if (dot(screen, screen) > 0.0) {
+            clip.xy += normalize(screen) / uViewport * uLineWidth[style] * clip.w;
+        }
+        Color = uLineColor[style];
+    } else {
+        Color = uFillColor[style];
+    }
+    gl_Position = clip;
+}
+)";
+
+constexpr const char* kVectorTileFragmentShader = R"(
+#version 330 core
+in vec4 Color;
+
+out vec4 FragColor;
+
+void main() {
+    if (Color.a <= 0.0) {
+        discard;
+    }
+    FragColor = Color;
+}
+)";
+
+struct UniformLocations {
+    GLint view_projection = -1;
+    GLint tile = -1;
+    GLint viewport = -1;
+    GLint lines = -1;
+    GLint fill_color = -1;
+    GLint line_color = -1;
+    GLint line_width = -1;
+};
+
+} // namespace
+
+class VectorTileLayerImpl : public VectorTileLayer {
+public:
+    VectorTileLayerImpl(std::shared_ptr<TileCache> cache, std::shared_ptr<TileLoader> loader,
+                        const VectorTileLayerConfig& config, bool skip_gl_init)
+        : max_zoom_(MaxZoom(*loader))
+        , skip_gl_init_(skip_gl_init)
+        , arena_(config.max_vertices, config.max_indices, skip_gl_init) {
+        upload_queue_ = std::make_shared<GLUploadQueue>();
+        // Meshes travel in the commands: the pool's staging ring stays unused
+        worker_pool_ = std::make_unique<TileLoadWorkerPool>(
+            std::move(cache), std::move(loader), upload_queue_, config.worker_threads, 0,
+            std::make_shared<PixelBufferRing>(1, 1, true));
+        SetStyles(config.styles);
+    }
+
+    ~VectorTileLayerImpl() override {
+        // Workers may be blocked pushing to a full queue
+        upload_queue_->Close();
+        worker_pool_->Shutdown();
+        if (program_) {
+            glDeleteProgram(program_);
+            program_ = 0;
+        }
+    }
+
+    bool Initialize() override {
+        if (program_ != 0 || skip_gl_init_) {
+            return true;
+        }
+        program_ = ShaderLoader::CreateProgram(kVectorTileVertexShader, kVectorTileFragmentShader,
+                                               "vector_tile");
+        if (program_ == 0) {
+            spdlog::error("Failed to create vector tile shader program");
+            return false;
+        }
+        locs_.view_projection = glGetUniformLocation(program_, "uViewProjection");
+        locs_.tile = glGetUniformLocation(program_, "uTile");
+        locs_.viewport = glGetUniformLocation(program_, "uViewport");
+        locs_.lines = glGetUniformLocation(program_, "uLines");
+        locs_.fill_color = glGetUniformLocation(program_, "uFillColor");
+        locs_.line_color = glGetUniformLocation(program_, "uLineColor");
+        locs_.line_width = glGetUniformLocation(program_, "uLineWidth");
+        return true;
+    }
+
+    void SetStyles(const std::vector<VectorTileStyle>& styles) override {
+        if (styles.size() > kMaxVectorTileStyles) {
+            spdlog::warn("Vector tile layer: only the first {} of {} styles are used",
+                         kMaxVectorTileStyles, styles.size());
+        }
+        styles_ = styles;
+        styles_.resize(std::min(styles_.size(), kMaxVectorTileStyles));
+        worker_pool_->SetVectorTileStyles(
+            std::make_shared<const std::vector<VectorTileStyle>>(styles_));
+
+        // Tessellated with the old styles
+        for (const auto& [coords, tile] : tiles_) {
+            if (tile.loaded) {
+                arena_.Free(tile.allocation);
+            }
+        }
+        tiles_.clear();
+    }
+
+    void RequestTiles(const std::vector<TileCoordinates>& tiles) override {
+        ++frame_;
+        frame_tiles_.clear();
+        frame_tiles_.reserve(tiles.size());
+        worker_pool_->AdvanceGeneration();
+
+        int priority = 0;
+        for (TileCoordinates coords : tiles) {
+            while (coords.zoom > max_zoom_) {
+                coords = coords.GetParent();
+            }
+            frame_tiles_.push_back(coords);
+
+            auto [it, inserted] = tiles_.try_emplace(coords);
+            it->second.last_used = frame_;
+            if (!it->second.loaded) {
+                // New or still loading: (re)submitting renews its generation
+                worker_pool_->SubmitRequest(coords, priority++);
+            }
+        }
+
+        for (const TileCoordinates& coords : worker_pool_->CancelStaleRequests()) {
+            const auto it = tiles_.find(coords);
+            if (it != tiles_.end() && !it->second.loaded) {
+                tiles_.erase(it);
+            }
+        }
+    }
+
+    std::size_t ProcessUploads(std::size_t max_uploads) override {
+        std::size_t uploaded = 0;
+        while (uploaded < max_uploads) {
+            std::unique_ptr<GLUploadCommand> cmd = upload_queue_->TryPop();
+            if (!cmd) {
+                break;
+            }
+            const auto it = tiles_.find(cmd->coords);
+            // Dropped (styles changed, request cancelled) or already resident
+            if (it == tiles_.end() || it->second.loaded) {
+                continue;
+            }
+            if (!cmd->mesh) {
+                // Failed load: requested again if still wanted
+                tiles_.erase(it);
+                continue;
+            }
+
+            std::optional<VectorTileAllocation> allocation = arena_.Upload(*cmd->mesh);
+            while (!allocation && EvictLeastRecentlyUsed()) {
+                allocation = arena_.Upload(*cmd->mesh);
+            }
+            // Evictions erase from the map and may move its entries
+            const auto tile = tiles_.find(cmd->coords);
+            if (!allocation) {
+                spdlog::warn("Vector tile {} ({} vertices, {} indices) does not fit the arena",
+                             cmd->coords.GetKey(), cmd->mesh->vertices.size(),
+                             cmd->mesh->indices.size());
+                tiles_.erase(tile);
+                continue;
+            }
+            tile->second.loaded = true;
+            tile->second.allocation = *allocation;
+            ++uploaded;
+        }
+        return uploaded;
+    }
+
+    bool IsTileLoaded(const TileCoordinates& coords) const override {
+        const auto it = tiles_.find(coords);
+        return it != tiles_.end() && it->second.loaded;
+    }
+
+    void Render(const glm::mat4& view_matrix, const glm::mat4& projection_matrix,
+                const glm::vec3& /*camera_position*/, std::uint32_t viewport_width,
+                std::uint32_t viewport_height) override {
+        stats_ = VectorTileRenderStats{};
+        stats_.used_vertices = arena_.GetUsedVertices();
+        stats_.used_indices = arena_.GetUsedIndices();
+        stats_.gpu_memory_bytes = arena_.GetGpuMemoryBytes();
+
+        // Each tile, or its nearest resident ancestor, once
+        draw_tiles_.clear();
+        drawn_.clear();
+        for (const TileCoordinates& requested : frame_tiles_) {
+            TileCoordinates coords = requested;
+            auto it = tiles_.find(coords);
+            while ((it == tiles_.end() || !it->second.loaded) && coords.zoom > 0) {
+                coords = coords.GetParent();
+                it = tiles_.find(coords);
+            }
+            if (it == tiles_.end() || !it->second.loaded) {
+                continue;
+            }
+            it->second.last_used = frame_;
+            if (drawn_.insert(coords).second) {
+                draw_tiles_.emplace_back(coords, it->second.allocation);
+                if (!(coords == requested)) {
+                    ++stats_.fallback_tiles;
+                }
+            }
+        }
+        stats_.tiles_rendered = draw_tiles_.size();
+        for (const auto& [coords, tile] : tiles_) {
+            stats_.resident_tiles += tile.loaded ? 1 : 0;
+        }
+        if (program_ == 0 || draw_tiles_.empty()) {
+            return;
+        }
+
+        const GLboolean blend = glIsEnabled(GL_BLEND);
+        const GLboolean cull = glIsEnabled(GL_CULL_FACE);
+        GLboolean depth_mask = GL_TRUE;
+        glGetBooleanv(GL_DEPTH_WRITEMASK, &depth_mask);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        // Fill winding flips with the tile's orientation on screen
+        glDisable(GL_CULL_FACE);
+        // Overlaid on the globe: test against its depth, leave it unchanged
+        glDepthMask(GL_FALSE);
+
+        glUseProgram(program_);
+        const glm::mat4 view_projection = projection_matrix * view_matrix;
+        glUniformMatrix4fv(locs_.view_projection, 1, GL_FALSE, glm::value_ptr(view_projection));
+        glUniform2f(locs_.viewport, static_cast<float>(viewport_width),
+                    static_cast<float>(viewport_height));
+        std::array<glm::vec4, kMaxVectorTileStyles> fill_colors{};
+        std::array<glm::vec4, kMaxVectorTileStyles> line_colors{};
+        std::array<float, kMaxVectorTileStyles> line_widths{};
+        for (std::size_t s = 0; s < styles_.size(); ++s) {
+            fill_colors[s] = styles_[s].fill_color;
+            line_colors[s] = styles_[s].line_color;
+            line_widths[s] = styles_[s].line_width;
+        }
+        glUniform4fv(locs_.fill_color, kMaxVectorTileStyles, glm::value_ptr(fill_colors[0]));
+        glUniform4fv(locs_.line_color, kMaxVectorTileStyles, glm::value_ptr(line_colors[0]));
+        glUniform1fv(locs_.line_width, kMaxVectorTileStyles, line_widths.data());
+
+        glBindVertexArray(arena_.GetVertexArray());
+        // Lines of every tile over fills of every tile
+        for (const bool lines : {false, true}) {
+            glUniform1i(locs_.lines, lines ? 1 : 0);
+            for (const auto& [coords, allocation] : draw_tiles_) {
+                const std::uint32_t first = lines ? allocation.fill_index_count : 0;
+                const std::uint32_t count = lines ? allocation.index_count - first
+                                                  : allocation.fill_index_count;
+                if (count == 0) {
+                    continue;
+                }
+                const float size = 1.0f / static_cast<float>(std::int64_t{1} << coords.zoom);
+                glUniform3f(locs_.tile, static_cast<float>(coords.x) * size,
+                            static_cast<float>(coords.y) * size, size);
+                glDrawElementsBaseVertex(
+                    GL_TRIANGLES, static_cast<GLsizei>(count), GL_UNSIGNED_INT,
+                    reinterpret_cast<void*>(static_cast<std::uintptr_t>(allocation.first_index + first) *
+                                            sizeof(std::uint32_t)),
+                    static_cast<GLint>(allocation.first_vertex));
+                ++stats_.draw_calls;
+            }
+        }
+        glBindVertexArray(0);
+        glUseProgram(0);
+
+        glDepthMask(depth_mask);
+        if (cull) glEnable(GL_CULL_FACE);
+        if (!blend) glDisable(GL_BLEND);
+    }
+
+    VectorTileRenderStats GetStats() const override {
+        return stats_;
+    }
+
+private:
+    struct TileState {
+        bool loaded = false;               ///< false while loading
+        VectorTileAllocation allocation;
+        std::uint64_t last_used = 0;       ///< Frame it was last requested or drawn
+    };
+
+    static std::int32_t MaxZoom(const TileLoader& loader) {
+        const TileProvider* provider = loader.GetProvider("");
+        return provider ? provider->GetMaxZoom() : std::numeric_limits<std::int32_t>::max();
+    }
+
+    /// Evict the least recently used resident tile not used this frame
+    bool EvictLeastRecentlyUsed() {
+        auto victim = tiles_.end();
+        for (auto it = tiles_.begin(); it != tiles_.end(); ++it) {
+            if (it->second.loaded && it->second.last_used < frame_ &&
+                (victim == tiles_.end() || it->second.last_used < victim->second.last_used)) {
+                victim = it;
+            }
+        }
+        if (victim == tiles_.end()) {
+            return false;
+        }
+        arena_.Free(victim->second.allocation);
+        tiles_.erase(victim);
+        return true;
+    }
+
+    std::int32_t max_zoom_;
+    bool skip_gl_init_;
+    std::vector<VectorTileStyle> styles_;
+    VectorTileArena arena_;
+    std::shared_ptr<GLUploadQueue> upload_queue_;
+    std::unique_ptr<TileLoadWorkerPool> worker_pool_;
+
+    /// Loading and resident tiles
+    TileMap<TileState> tiles_;
+    std::uint64_t frame_ = 0;
+    std::vector<TileCoordinates> frame_tiles_;
+
+    /// Render scratch
+    std::vector<std::pair<TileCoordinates, VectorTileAllocation>> draw_tiles_;
+    TileSet drawn_;
+
+    std::uint32_t program_ = 0;
+    UniformLocations locs_;
+    VectorTileRenderStats stats_;
+};
+
+std::unique_ptr<VectorTileLayer> VectorTileLayer::Create(std::shared_ptr<TileCache> cache,
+                                                         std::shared_ptr<TileLoader> loader,
+                                                         const VectorTileLayerConfig& config,
+                                                         bool skip_gl_init) {
+    if (!loader) {
+        throw std::invalid_argument("VectorTileLayer needs a tile loader");
+    }
+    return std::make_unique<VectorTileLayerImpl>(std::move(cache), std::move(loader), config,
+                                                 skip_gl_init);
+}
+
+} // namespace earth_map
@@ -0,0 +1,522 @@
+/**
+ * @file vector_tile_mesh.cpp
+ * @brief Vector tile tessellation implementation
+ */
+
+#include <earth_map/renderer/vector_tile/vector_tile_mesh.h>
+#include <algorithm>
+#include <cmath>
+
+namespace earth_map {
+
+namespace {
+
+/// Rings and segments shorter or smaller than this (tile units) are dropped
+constexpr float kEpsilon = 1e-7f;
+
+float Cross(const glm::vec2& a, const glm::vec2& b, const glm::vec2& c) {
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+bool SamePoint(const glm::vec2& a, const glm::vec2& b) {
+    return a.x == b.x && a.y == b.y;
+}
+
+/**
+ * @brief Doubly linked polygon outline for ear clipping
+ *
+ * Nodes are never freed; removed nodes are just unlinked. Bridges add
+ * copies of their two endpoints sharing the original vertex index.
+ */
+class EarClipper {
+public:
+    /// Append a ring as its own cycle; returns one of its nodes, or -1
+    int AddRing(std::span<const glm::vec2> ring, std::uint32_t first_index, bool clockwise) {
+        const std::size_t count = ring.size();
+        int first = -1;
+        int last = -1;
+        for (std::size_t n = 0; n < count; ++n) {
+            const std::size_t i = clockwise ? count - 1 - n : n;
+            if (last >= 0 && SamePoint(nodes_[static_cast<std::size_t>(last)].p, ring[i])) {
+                continue;
+            }
+            const int node = Push(ring[i], first_index + static_cast<std::uint32_t>(i));
+            if (first < 0) {
+                first = node;
+            } else {
+                Link(last, node);
+            }
+            last = node;
+        }
+        if (first < 0) {
+            return -1;
+        }
+        Link(last, first);
+        if (first != last && SamePoint(At(first).p, At(last).p)) {
+            Remove(last);
+        }
+        return CycleLength(first) >= 3 ? first : -1;
+    }
+
+    /// Join a hole cycle to the outer cycle through a bridge edge
+    bool MergeHole(int outer, int hole) {
+        // The hole's leftmost vertex bridges to the nearest outer vertex it sees
+        int m = hole;
+        for (int n = At(hole).next; n != hole; n = At(n).next) {
+            if (At(n).p.x < At(m).p.x || (At(n).p.x == At(m).p.x && At(n).p.y < At(m).p.y)) {
+                m = n;
+            }
+        }
+
+        std::vector<int> candidates;
+        int n = outer;
+        do {
+            candidates.push_back(n);
+            n = At(n).next;
+        } while (n != outer);
+        const glm::vec2 mp = At(m).p;
+        std::sort(candidates.begin(), candidates.end(), [&](int a, int b) {
+            const glm::vec2 da = At(a).p - mp;
+            const glm::vec2 db = At(b).p - mp;
+            return da.x * da.x + da.y * da.y < db.x * db.x + db.y * db.y;
+        });
+
+        for (const int p : candidates) {
+            if (LocallyInside(p, At(m).p) && LocallyInside(m, At(p).p) &&
+                !CrossesAnyEdge(outer, At(p).p, mp) && !CrossesAnyEdge(m, At(p).p, mp) &&
+                !CrossesPendingHoles(At(p).p, mp)) {
+                Split(p, m);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Holes not yet merged (their edges block bridges too)
+    void SetPendingHoles(std::vector<int> holes) { pending_holes_ = std::move(holes); }
+    void PopPendingHole() { pending_holes_.erase(pending_holes_.begin()); }
+
+    /// Clip ears off the cycle until one triangle is left
+    void Triangulate(int start, std::vector<std::uint32_t>& out) {
+        int remaining = CycleLength(start);
+        int ear = start;
+        int stop = ear;
+        bool filtered = false;
+        while (remaining > 2) {
+            const int prev = At(ear).prev;
+            const int next = At(ear).next;
+            if (IsEar(prev, ear, next)) {
+                out.push_back(At(prev).index);
+                out.push_back(At(ear).index);
+                out.push_back(At(next).index);
+                Remove(ear);
+                --remaining;
+                ear = next;
+                stop = next;
+                filtered = false;
+                continue;
+            }
+
+            ear = next;
+            if (ear != stop) {
+                continue;
+            }
+
+            // A full pass found no ear: drop flat vertices, then force one
+            if (!filtered) {
+                const int before = remaining;
+                ear = FilterFlat(ear, remaining);
+                stop = ear;
+                filtered = true;
+                if (remaining < before) {
+                    continue;
+                }
+            }
+            const int p = At(ear).prev;
+            const int q = At(ear).next;
+            if (Cross(At(p).p, At(ear).p, At(q).p) > 0.0f) {
+                out.push_back(At(p).index);
+                out.push_back(At(ear).index);
+                out.push_back(At(q).index);
+            }
+            Remove(ear);
+            --remaining;
+            ear = q;
+            stop = q;
+            filtered = false;
+        }
+    }
+
+private:
+    struct Node {
+        glm::vec2 p;
+        std::uint32_t index;
+        int prev = -1;
+        int next = -1;
+    };
+
+    Node& At(int node) { return nodes_[static_cast<std::size_t>(node)]; }
+
+    int Push(const glm::vec2& p, std::uint32_t index) {
+        nodes_.push_back(Node{p, index});
+        return static_cast<int>(nodes_.size() - 1);
+    }
+
+    void Link(int a, int b) {
+        At(a).next = b;
+        At(b).prev = a;
+    }
+
+    void Remove(int node) {
+        Link(At(node).prev, At(node).next);
+    }
+
+    int CycleLength(int start) {
+        int count = 0;
+        int n = start;
+        do {
+            ++count;
+            n = At(n).next;
+        } while (n != start);
+        return count;
+    }
+
+    /// Remove duplicate and collinear vertices; returns a node still linked
+    int FilterFlat(int start, int& remaining) {
+        int n = start;
+        int checked = 0;
+        while (remaining > 2 && checked < remaining) {
+            const int prev = At(n).prev;
+            const int next = At(n).next;
+            if (SamePoint(At(n).p, At(next).p) || Cross(At(prev).p, At(n).p, At(next).p) == 0.0f) {
+                Remove(n);
+                --remaining;
+                n = prev;
+                checked = 0;
+            } else {
+                n = next;
+                ++checked;
+            }
+        }
+        return n;
+    }
+
+    bool IsEar(int a, int b, int c) {
+        const glm::vec2 pa = At(a).p;
+        const glm::vec2 pb = At(b).p;
+        const glm::vec2 pc = At(c).p;
+        if (Cross(pa, pb, pc) <= 0.0f) {
+            return false;  // Reflex or flat
+        }
+        const float min_x = std::min({pa.x, pb.x, pc.x});
+        const float max_x = std::max({pa.x, pb.x, pc.x});
+        const float min_y = std::min({pa.y, pb.y, pc.y});
+        const float max_y = std::max({pa.y, pb.y, pc.y});
+
+        // Only reflex vertices can lie inside a convex ear
+        for (int n = At(c).next; n != a; n = At(n).next) {
+            const glm::vec2 p = At(n).p;
+            if (p.x < min_x || p.x > max_x || p.y < min_y || p.y > max_y ||
+                SamePoint(p, pa) || SamePoint(p, pb) || SamePoint(p, pc)) {
+                continue;
+            }
+            if (Cross(pa, pb, p) >= 0.0f && Cross(pb, pc, p) >= 0.0f && Cross(pc, pa, p) >= 0.0f &&
+                Cross(At(At(n).prev).p, p, At(At(n).next).p) <= 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Whether the direction from node a towards b lies inside the polygon at a
+    bool LocallyInside(int a, const glm::vec2& b) {
+        const glm::vec2 prev = At(At(a).prev).p;
+        const glm::vec2 p = At(a).p;
+        const glm::vec2 next = At(At(a).next).p;
+        if (Cross(prev, p, next) >= 0.0f) {
+            return Cross(p, next, b) >= 0.0f && Cross(prev, p, b) >= 0.0f;
+        }
+        return Cross(p, next, b) >= 0.0f || Cross(prev, p, b) >= 0.0f;
+    }
+
+    static bool SegmentsCross(const glm::vec2& p1, const glm::vec2& q1,
+                              const glm::vec2& p2, const glm::vec2& q2) {
+        // Segments sharing an endpoint do not block a bridge
+        if (SamePoint(p1, p2) || SamePoint(p1, q2) || SamePoint(q1, p2) || SamePoint(q1, q2)) {
+            return false;
+        }
+        const float d1 = Cross(p1, q1, p2);
+        const float d2 = Cross(p1, q1, q2);
+        const float d3 = Cross(p2, q2, p1);
+        const float d4 = Cross(p2, q2, q1);
+        return ((d1 > 0.0f) != (d2 > 0.0f)) && ((d3 > 0.0f) != (d4 > 0.0f)) &&
+               d1 != 0.0f && d2 != 0.0f && d3 != 0.0f && d4 != 0.0f;
+    }
+
+    bool CrossesAnyEdge(int start, const glm::vec2& a, const glm::vec2& b) {
+        int n = start;
+        do {
+            if (SegmentsCross(a, b, At(n).p, At(At(n).next).p)) {
+                return true;
+            }
+            n = At(n).next;
+        } while (n != start);
+        return false;
+    }
+
+    bool CrossesPendingHoles(const glm::vec2& a, const glm::vec2& b) {
+        for (std::size_t i = 1; i < pending_holes_.size(); ++i) {
+            if (CrossesAnyEdge(pending_holes_[i], a, b)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Link a to b and back through copies of both (earcut's splitPolygon)
+    void Split(int a, int b) {
+        const int a2 = Push(At(a).p, At(a).index);
+        const int b2 = Push(At(b).p, At(b).index);
+        const int an = At(a).next;
+        const int bp = At(b).prev;
+        Link(a, b);
+        Link(a2, an);
+        Link(b2, a2);
+        Link(bp, b2);
+    }
+
+    std::vector<Node> nodes_;
+    std::vector<int> pending_holes_;
+};
+
+/// Liang-Barsky clip of a segment to the tile square; false if it misses
+bool ClipSegmentToTile(glm::vec2& a, glm::vec2& b) {
+    const glm::vec2 d = b - a;
+    float t0 = 0.0f;
+    float t1 = 1.0f;
+    const float p[4] = {-d.x, d.x, -d.y, d.y};
+    const float q[4] = {a.x, 1.0f - a.x, a.y, 1.0f - a.y};
+    for (int i = 0; i < 4; ++i) {
+        if (p[i] == 0.0f) {
+            if (q[i] < 0.0f) {
+                return false;
+            }
+            continue;
+        }
+        const float t = q[i] / p[i];
+        if (p[i] < 0.0f) {
+            t0 = std::max(t0, t);
+        } else {
+            t1 = std::min(t1, t);
+        }
+        if (t0 > t1) {
+            return false;
+        }
+    }
+    const glm::vec2 start = a;
+    a = start + d * t0;
+    b = start + d * t1;
+    return true;
+}
+
+void AppendLine(std::span<const glm::vec2> points, bool closed, float style,
+                std::vector<VectorTileVertex>& vertices, std::vector<std::uint32_t>& indices) {
+    const std::size_t segments = closed ? points.size() : points.size() - 1;
+    for (std::size_t i = 0; i < segments; ++i) {
+        glm::vec2 a = points[i];
+        glm::vec2 b = points[(i + 1) % points.size()];
+        if (!ClipSegmentToTile(a, b)) {
+            continue;
+        }
+        const glm::vec2 d = b - a;
+        const float length = std::sqrt(d.x * d.x + d.y * d.y);
+        if (length < kEpsilon) {
+            continue;
+        }
+        const glm::vec2 normal(-d.y / length, d.x / length);
+        const auto base = static_cast<std::uint32_t>(vertices.size());
+        vertices.push_back({a, normal, style});
+        vertices.push_back({a, -normal, style});
+        vertices.push_back({b, normal, style});
+        vertices.push_back({b, -normal, style});
+        for (const std::uint32_t i_quad : {0u, 1u, 2u, 2u, 1u, 3u}) {
+            indices.push_back(base + i_quad);
+        }
+    }
+}
+
+void AppendPolygonFill(std::span<const std::vector<glm::vec2>> rings, float style,
+                       std::vector<VectorTileVertex>& vertices,
+                       std::vector<std::uint32_t>& indices) {
+    std::vector<std::vector<glm::vec2>> clipped;
+    clipped.reserve(rings.size());
+    for (const auto& ring : rings) {
+        std::vector<glm::vec2> part = ClipRingToTile(ring);
+        if (part.size() >= 3 && std::abs(MvtRingArea(part)) > kEpsilon * kEpsilon) {
+            clipped.push_back(std::move(part));
+        } else if (clipped.empty()) {
+            return;  // The exterior ring lies outside the tile
+        }
+    }
+
+    const auto base = static_cast<std::uint32_t>(vertices.size());
+    const std::vector<std::uint32_t> triangles = TriangulatePolygon(clipped);
+    if (triangles.empty()) {
+        return;
+    }
+    for (const auto& ring : clipped) {
+        for (const glm::vec2& p : ring) {
+            vertices.push_back({p, glm::vec2(0.0f), style});
+        }
+    }
+    for (const std::uint32_t index : triangles) {
+        indices.push_back(base + index);
+    }
+}
+
+} // namespace
+
+std::vector<std::uint32_t> TriangulatePolygon(std::span<const std::vector<glm::vec2>> rings) {
+    std::vector<std::uint32_t> triangles;
+    if (rings.empty() || rings.front().size() < 3) {
+        return triangles;
+    }
+
+    EarClipper clipper;
+    // Exterior counter-clockwise in the cross product's sense, holes opposite
+    const int outer = clipper.AddRing(rings.front(), 0, MvtRingArea(rings.front()) < 0.0);
+    if (outer < 0) {
+        return triangles;
+    }
+
+    std::vector<std::pair<float, int>> holes;
+    std::uint32_t first_index = static_cast<std::uint32_t>(rings.front().size());
+    for (std::size_t r = 1; r < rings.size(); ++r) {
+        const auto& ring = rings[r];
+        const int hole = ring.size() >= 3
+            ? clipper.AddRing(ring, first_index, MvtRingArea(ring) > 0.0)
+            : -1;
+        first_index += static_cast<std::uint32_t>(ring.size());
+        if (hole >= 0) {
+            const float left = std::min_element(ring.begin(), ring.end(),
+                [](const glm::vec2& a, const glm::vec2& b) { return a.x < b.x; })->x;
+            holes.emplace_back(left, hole);
+        }
+    }
+
+    // Left to right, so bridges of later holes can pass earlier ones
+    std::sort(holes.begin(), holes.end());
+    std::vector<int> pending;
+    for (const auto& hole : holes) {
+        pending.push_back(hole.second);
+    }
+    clipper.SetPendingHoles(pending);
+    for (const auto& hole : holes) {
+        clipper.MergeHole(outer, hole.second);
+        clipper.PopPendingHole();
+    }
+
+    clipper.Triangulate(outer, triangles);
+    return triangles;
+}
+
+std::vector<glm::vec2> ClipRingToTile(std::span<const glm::vec2> ring) {
+    std::vector<glm::vec2> output(ring.begin(), ring.end());
+    const bool inside_tile = std::all_of(ring.begin(), ring.end(), [](const glm::vec2& p) {
+        return p.x >= 0.0f && p.x <= 1.0f && p.y >= 0.0f && p.y <= 1.0f;
+    });
+    if (inside_tile) {
+        return output;
+    }
+
+    // Edges x >= 0, x <= 1, y >= 0, y <= 1
+    for (int edge = 0; edge < 4 && !output.empty(); ++edge) {
+        const int axis = edge / 2;
+        const bool keep_below = (edge % 2) == 1;
+        const float bound = keep_below ? 1.0f : 0.0f;
+        const auto coord = [axis](const glm::vec2& p) { return axis == 0 ? p.x : p.y; };
+        const auto inside = [&](const glm::vec2& p) {
+            return keep_below ? coord(p) <= bound : coord(p) >= bound;
+        };
+
+        std::vector<glm::vec2> input;
+        input.swap(output);
+        for (std::size_t i = 0; i < input.size(); ++i) {
+            const glm::vec2& current = input[i];
+            const glm::vec2& previous = input[(i + input.size() - 1) % input.size()];
+            const bool current_in = inside(current);
+            if (current_in != inside(previous)) {
+                const float t = (bound - coord(previous)) / (coord(current) - coord(previous));
+                output.push_back(previous + (current - previous) * t);
+            }
+            if (current_in) {
+                output.push_back(current);
+            }
+        }
+    }
+    return output;
+}
+
+VectorTileMesh TessellateVectorTile(const MvtTile& tile, std::span<const VectorTileStyle> styles) {
+    const std::size_t style_count = std::min(styles.size(), kMaxVectorTileStyles);
+    std::vector<VectorTileVertex> line_vertices;
+    std::vector<std::uint32_t> line_indices;
+    VectorTileMesh mesh;
+
+    for (const MvtLayer& layer : tile.layers) {
+        std::size_t s = 0;
+        while (s < style_count && styles[s].layer != layer.name) {
+            ++s;
+        }
+        if (s == style_count) {
+            continue;
+        }
+        const VectorTileStyle& style = styles[s];
+        const auto style_index = static_cast<float>(s);
+        const bool fill = style.fill_color.w > 0.0f;
+        const bool lines = style.line_width > 0.0f;
+
+        for (const MvtFeature& feature : layer.features) {
+            if (feature.type == MvtGeometryType::LINESTRING && lines) {
+                for (const auto& part : feature.geometry) {
+                    if (part.size() >= 2) {
+                        AppendLine(part, false, style_index, line_vertices, line_indices);
+                    }
+                }
+            } else if (feature.type == MvtGeometryType::POLYGON) {
+                if (lines && style.outline_polygons) {
+                    for (const auto& ring : feature.geometry) {
+                        AppendLine(ring, true, style_index, line_vertices, line_indices);
+                    }
+                }
+                if (!fill) {
+                    continue;
+                }
+                // An exterior ring and the holes after it form one polygon
+                std::size_t first = 0;
+                while (first < feature.geometry.size()) {
+                    std::size_t end = first + 1;
+                    while (end < feature.geometry.size() &&
+                           MvtRingArea(feature.geometry[end]) <= 0.0) {
+                        ++end;
+                    }
+                    AppendPolygonFill(
+                        std::span<const std::vector<glm::vec2>>(feature.geometry).subspan(
+                            first, end - first),
+                        style_index, mesh.vertices, mesh.indices);
+                    first = end;
+                }
+            }
+        }
+    }
+
+    mesh.fill_index_count = mesh.indices.size();
+    const auto line_base = static_cast<std::uint32_t>(mesh.vertices.size());
+    mesh.vertices.insert(mesh.vertices.end(), line_vertices.begin(), line_vertices.end());
+    for (const std::uint32_t index : line_indices) {
+        mesh.indices.push_back(line_base + index);
+    }
+    return mesh;
+}
+
+} // namespace earth_map
@@ -0,0 +1,110 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#include <earth_map/data/compressed_elevation_tile.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace earth_map {
+namespace {
+
+/// Terrain-like tile: smooth relief, a little noise and a few voids
+std::unique_ptr<SRTMTileData> CreateTerrainTile(SRTMResolution resolution) {
+    auto tile = std::make_unique<SRTMTileData>(SRTMMetadata({46, 7}, resolution));
+    auto& data = tile->GetRawData();
+    const size_t samples = tile->GetMetadata().samples_per_side;
+    const double scale = 1201.0 / static_cast<double>(samples);
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> noise(-1, 1);
+    for (size_t y = 0; y < samples; ++y) {
+        for (size_t x = 0; x < samples; ++x) {
+            const double u = static_cast<double>(x) * scale;
+            const double v = static_cast<double>(y) * scale;
+            data[y * samples + x] = static_cast<int16_t>(
+                1800.0 + 900.0 * std::sin(u * 0.013) * std::cos(v * 0.021) +
+                150.0 * std::sin(u * 0.07 + v * 0.05) + noise(rng));
+        }
+    }
+    for (size_t i = 12345; i < data.size(); i += 100003) {
+        data[i] = -32768;
+    }
+    tile->SetHasVoids(true);
+    tile->SetValid(true);
+    return tile;
+}
+
+void ExpectSameSamples(const SRTMTileData& actual, const SRTMTileData& expected) {
+    ASSERT_EQ(actual.GetMetadata().samples_per_side, expected.GetMetadata().samples_per_side);
+    EXPECT_TRUE(std::equal(actual.GetSamples().begin(), actual.GetSamples().end(),
+                           expected.GetSamples().begin(), expected.GetSamples().end()));
+}
+
+TEST(CompressedElevationTileTest, RoundTripIsLosslessAndCompact) {
+    for (const auto resolution : {SRTMResolution::SRTM3, SRTMResolution::SRTM1}) {
+        const auto tile = CreateTerrainTile(resolution);
+        const CompressedElevationTile compressed(*tile);
+        EXPECT_TRUE(compressed.IsValid());
+        EXPECT_EQ(compressed.GetMetadata().coordinates, tile->GetMetadata().coordinates);
+
+        // 3601 and 1201 are not multiples of the block size: partial edge blocks
+        EXPECT_EQ(compressed.GetBlocksPerSide(),
+                  (tile->GetMetadata().samples_per_side + 63) / 64);
+
+        const auto decompressed = compressed.Decompress();
+        ASSERT_NE(decompressed, nullptr);
+        EXPECT_TRUE(decompressed->IsValid());
+        EXPECT_TRUE(decompressed->GetMetadata().has_voids);
+        ExpectSameSamples(*decompressed, *tile);
+
+        EXPECT_LT(compressed.GetSizeBytes() * 3, tile->GetMetadata().file_size);
+    }
+}
+
+TEST(CompressedElevationTileTest, ExtremeValuesRoundTrip) {
+    // Full-range jumps need the widest residuals
+    SRTMTileData tile(SRTMMetadata({0, 0}, SRTMResolution::SRTM3, 4));
+    auto& data = tile.GetRawData();
+    const int16_t values[] = {-32768, 32767, -32767, 0, 1, -1};
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = values[(i * 7 + i / 76) % 6];
+    }
+    tile.SetValid(true);
+
+    const CompressedElevationTile compressed(tile);
+    ExpectSameSamples(*compressed.Decompress(), tile);
+}
+
+TEST(CompressedElevationTileTest, DecodeSingleBlock) {
+    const auto tile = CreateTerrainTile(SRTMResolution::SRTM3);
+    const CompressedElevationTile compressed(*tile);
+
+    // Block (18, 2) is the 49-sample wide column at the east edge
+    std::vector<int16_t> block(64 * 64, 0);
+    ASSERT_TRUE(compressed.DecodeBlock(18, 2, block));
+    for (size_t y = 0; y < 64; ++y) {
+        for (size_t x = 0; x < 49; ++x) {
+            ASSERT_EQ(block[y * 64 + x],
+                      tile->GetSample(18 * 64 + x, 2 * 64 + y).elevation_meters);
+        }
+    }
+
+    EXPECT_FALSE(compressed.DecodeBlock(19, 0, block));
+    std::vector<int16_t> too_small(100);
+    EXPECT_FALSE(compressed.DecodeBlock(0, 0, too_small));
+}
+
+TEST(CompressedElevationTileTest, InvalidTile) {
+    SRTMTileData tile(SRTMMetadata({0, 0}, SRTMResolution::SRTM3));
+    const CompressedElevationTile compressed(tile);
+    EXPECT_FALSE(compressed.IsValid());
+    EXPECT_FALSE(compressed.Decompress()->IsValid());
+    std::vector<int16_t> block(64 * 64);
+    EXPECT_FALSE(compressed.DecodeBlock(0, 0, block));
+}
+
+} // anonymous namespace
+} // namespace earth_map
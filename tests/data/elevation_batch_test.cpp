@@ -0,0 +1,226 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#include <earth_map/data/elevation_batch.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+
+namespace earth_map {
+namespace {
+
+using namespace coordinates;
+
+/// In-memory SRTM3 tiles with a gradient pattern, counting lookups per tile
+class FakeTileSource {
+public:
+    explicit FakeTileSource(std::vector<SRTMCoordinates> available)
+        : available_(std::move(available)) {}
+
+    std::shared_ptr<SRTMTileData> Lookup(const SRTMCoordinates& coords) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ++lookups_[{coords.latitude, coords.longitude}];
+        if (std::find(available_.begin(), available_.end(), coords) == available_.end()) {
+            return nullptr;
+        }
+        auto& tile = tiles_[{coords.latitude, coords.longitude}];
+        if (!tile) {
+            tile = std::make_shared<SRTMTileData>(SRTMMetadata(coords, SRTMResolution::SRTM3));
+            auto& data = tile->GetRawData();
+            const size_t samples = tile->GetMetadata().samples_per_side;
+            for (size_t y = 0; y < samples; ++y) {
+                for (size_t x = 0; x < samples; ++x) {
+                    data[y * samples + x] = static_cast<int16_t>(
+                        coords.latitude * 10 + static_cast<int>(y / 4 + x / 3));
+                }
+            }
+            data[600 * samples + 600] = -32768;  // One void in the middle
+            tile->SetValid(true);
+        }
+        return tile;
+    }
+
+    SRTMTileLookup AsLookup() {
+        return [this](const SRTMCoordinates& coords) { return Lookup(coords); };
+    }
+
+    int LookupCount(const SRTMCoordinates& coords) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return lookups_[{coords.latitude, coords.longitude}];
+    }
+
+private:
+    std::vector<SRTMCoordinates> available_;
+    std::mutex mutex_;
+    std::map<std::pair<int32_t, int32_t>, std::shared_ptr<SRTMTileData>> tiles_;
+    std::map<std::pair<int32_t, int32_t>, int> lookups_;
+};
+
+/// Reference: the single-point path of ElevationProvider::GetElevation
+ElevationQuery QueryOne(FakeTileSource& source, double latitude, double longitude) {
+    ElevationQuery result;
+    result.latitude = latitude;
+    result.longitude = longitude;
+    const double lat = NormalizeLatitude(latitude);
+    const double lon = NormalizeLongitude(longitude);
+    if (!(lat >= -90.0 && lat <= 90.0 && lon >= -180.0 && lon <= 180.0)) {
+        return result;
+    }
+    result.source_tile = GeographicToSRTMTile(lat, lon);
+    const auto tile = source.Lookup(result.source_tile);
+    if (!tile) {
+        return result;
+    }
+    const auto [lat_fraction, lon_fraction] = GeographicToTileFraction(lat, lon, result.source_tile);
+    result.elevation_meters = tile->InterpolateElevation(lat_fraction, lon_fraction);
+    result.valid = true;
+    return result;
+}
+
+void ExpectSameResults(const std::vector<ElevationQuery>& actual,
+                       const std::vector<ElevationQuery>& expected) {
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); ++i) {
+        EXPECT_EQ(actual[i].valid, expected[i].valid) << "point " << i;
+        EXPECT_EQ(actual[i].elevation_meters, expected[i].elevation_meters) << "point " << i;
+        EXPECT_EQ(actual[i].latitude, expected[i].latitude) << "point " << i;
+        EXPECT_EQ(actual[i].longitude, expected[i].longitude) << "point " << i;
+        if (expected[i].valid) {
+            EXPECT_EQ(actual[i].source_tile, expected[i].source_tile) << "point " << i;
+        }
+    }
+}
+
+TEST(ElevationBatchTest, MortonEncodeInterleavesBits) {
+    EXPECT_EQ(MortonEncode(0, 0), 0u);
+    EXPECT_EQ(MortonEncode(1, 0), 1u);
+    EXPECT_EQ(MortonEncode(0, 1), 2u);
+    EXPECT_EQ(MortonEncode(3, 3), 15u);
+    EXPECT_EQ(MortonEncode(0xFFFF, 0), 0x55555555u);
+    EXPECT_EQ(MortonEncode(0, 0xFFFF), 0xAAAAAAAAu);
+}
+
+TEST(ElevationBatchTest, EmptyBatch) {
+    FakeTileSource source({});
+    EXPECT_TRUE(SampleElevationBatch({}, source.AsLookup()).empty());
+}
+
+TEST(ElevationBatchTest, MatchesSingleQueriesInInputOrder) {
+    FakeTileSource source({{37, -122}, {38, -122}, {27, 86}});
+
+    std::vector<Geographic> points = {
+        {37.5, -121.5},   // Tile (37, -122)
+        {27.25, 86.75},   // Tile (27, 86)
+        {38.1, -121.9},   // Tile (38, -122)
+        {37.0, -122.0},   // Tile corner
+        {10.0, 10.0},     // Tile not available
+        {37.5, 238.5},    // Wrapped longitude: tile (37, -122)
+        {95.0, 0.0},      // Clamped to the pole
+        {37.5, -121.5},   // Duplicate
+    };
+    // The void sample and its neighborhood
+    points.emplace_back(37.0 + (1.0 - 600.0 / 1200.0), -122.0 + 600.0 / 1200.0);
+    points.emplace_back(37.0 + (1.0 - 601.5 / 1200.0), -122.0 + 601.5 / 1200.0);
+
+    std::vector<ElevationQuery> expected;
+    for (const auto& point : points) {
+        expected.push_back(QueryOne(source, point.latitude, point.longitude));
+    }
+
+    ExpectSameResults(SampleElevationBatch(points, source.AsLookup()), expected);
+    EXPECT_FALSE(expected[4].valid);
+    EXPECT_TRUE(expected[5].valid);
+    EXPECT_EQ(expected[8].elevation_meters, 0.0f);
+}
+
+TEST(ElevationBatchTest, LooksUpEachTileOnce) {
+    FakeTileSource source({{37, -122}, {27, 86}});
+
+    std::vector<Geographic> points;
+    for (int i = 0; i < 1000; ++i) {
+        const double t = i / 1000.0;
+        points.emplace_back(37.0 + t, -122.0 + t);
+        points.emplace_back(27.0 + t, 86.0 + (1.0 - t) * 0.999);
+        points.emplace_back(5.5, 5.5);
+    }
+
+    const auto results = SampleElevationBatch(points, source.AsLookup());
+    EXPECT_EQ(source.LookupCount({37, -122}), 1);
+    EXPECT_EQ(source.LookupCount({27, 86}), 1);
+    EXPECT_EQ(source.LookupCount({5, 5}), 1);
+    EXPECT_TRUE(results[0].valid);
+    EXPECT_FALSE(results[2].valid);
+}
+
+TEST(ElevationBatchTest, ParallelBatchMatchesSerialBatch) {
+    FakeTileSource source({{37, -122}, {37, -121}, {38, -122}, {38, -121}});
+
+    // Scattered points over four tiles plus some without data
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<double> lat(36.5, 39.0);
+    std::uniform_real_distribution<double> lon(-122.0, -119.5);
+    std::vector<Geographic> points;
+    for (int i = 0; i < 200000; ++i) {
+        points.emplace_back(lat(rng), lon(rng));
+    }
+
+    ElevationBatchConfig serial;
+    serial.max_threads = 1;
+    ElevationBatchConfig parallel;
+    parallel.max_threads = 4;
+    parallel.min_points_per_thread = 1000;
+
+    const auto expected = SampleElevationBatch(points, source.AsLookup(), serial);
+    ExpectSameResults(SampleElevationBatch(points, source.AsLookup(), parallel), expected);
+
+    // Spot-check against single queries
+    for (size_t i = 0; i < points.size(); i += 997) {
+        const auto single = QueryOne(source, points[i].latitude, points[i].longitude);
+        EXPECT_EQ(expected[i].valid, single.valid);
+        EXPECT_EQ(expected[i].elevation_meters, single.elevation_meters);
+    }
+}
+
+TEST(ElevationBatchTest, ConcurrentBatchesMatchSerialBatch) {
+    FakeTileSource source({{37, -122}, {37, -121}});
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> lat(37.0, 38.0);
+    std::uniform_real_distribution<double> lon(-122.0, -120.0);
+    std::vector<Geographic> points;
+    for (int i = 0; i < 50000; ++i) {
+        points.emplace_back(lat(rng), lon(rng));
+    }
+
+    ElevationBatchConfig serial;
+    serial.max_threads = 1;
+    ElevationBatchConfig parallel;
+    parallel.max_threads = 4;
+    parallel.min_points_per_thread = 1000;
+    const auto expected = SampleElevationBatch(points, source.AsLookup(), serial);
+
+    // Batches that find the shared workers busy run on their own thread
+    std::vector<std::vector<ElevationQuery>> results(4);
+    std::vector<std::thread> callers;
+    for (auto& result : results) {
+        callers.emplace_back([&]() {
+            for (int round = 0; round < 5; ++round) {
+                result = SampleElevationBatch(points, source.AsLookup(), parallel);
+            }
+        });
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+    for (const auto& result : results) {
+        ExpectSameResults(result, expected);
+    }
+}
+
+} // anonymous namespace
+} // namespace earth_map
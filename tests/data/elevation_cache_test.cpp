@@ -2,10 +2,13 @@
 // SPDX-License-Identifier: MIT
 
 #include <earth_map/data/elevation_cache.h>
+#include <earth_map/data/compressed_elevation_tile.h>
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <filesystem>
+#include <fstream>
 #include <thread>
 
 namespace earth_map {
@@ -226,6 +229,153 @@ TEST_F(ElevationCacheTest, DiskCacheWriteAndRead) {
     EXPECT_EQ(sample.elevation_meters, expected_elevation);
 }
 
+TEST_F(ElevationCacheTest, DiskCacheMapsNativeFiles) {
+    ElevationCacheConfig config;
+    config.disk_cache_directory = cache_directory_;
+    config.enable_disk_cache = true;
+
+    auto cache = ElevationCache::Create(config);
+    ASSERT_NE(cache, nullptr);
+
+    const SRTMCoordinates coords{37, -122};
+    auto tile = CreateTestTile(coords, 1500);
+    EXPECT_TRUE(cache->Put(*tile));
+    cache->ClearMemoryCache();
+
+    // The disk hit views the cache file instead of parsing it
+    auto retrieved = cache->Get(coords);
+    ASSERT_TRUE(retrieved.has_value());
+    EXPECT_TRUE(retrieved.value()->IsMapped());
+    EXPECT_EQ(retrieved.value()->GetSample(5, 7).elevation_meters,
+              tile->GetSample(5, 7).elevation_meters);
+
+    // Removing the file leaves the mapped tile readable
+    EXPECT_TRUE(cache->Remove(coords));
+    EXPECT_FALSE(cache->Contains(coords));
+    EXPECT_EQ(retrieved.value()->GetSample(5, 7).elevation_meters,
+              tile->GetSample(5, 7).elevation_meters);
+}
+
+TEST_F(ElevationCacheTest, LegacyHGTCacheFilesAreConverted) {
+    ElevationCacheConfig config;
+    config.disk_cache_directory = cache_directory_;
+    config.enable_disk_cache = true;
+
+    auto cache = ElevationCache::Create(config);
+    ASSERT_NE(cache, nullptr);
+
+    // Big-endian HGT file as written by earlier versions of the cache
+    const SRTMCoordinates coords{27, 86};
+    auto tile = CreateTestTile(coords, 2000);
+    const auto samples = tile->GetSamples();
+    std::vector<char> big_endian(samples.size() * 2);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        big_endian[i * 2] = static_cast<char>((samples[i] >> 8) & 0xFF);
+        big_endian[i * 2 + 1] = static_cast<char>(samples[i] & 0xFF);
+    }
+    const std::string legacy_path = cache_directory_ + "/" + FormatSRTMFilename(coords);
+    {
+        std::ofstream file(legacy_path, std::ios::binary);
+        file.write(big_endian.data(), static_cast<std::streamsize>(big_endian.size()));
+    }
+    EXPECT_TRUE(cache->Contains(coords));
+
+    auto retrieved = cache->Get(coords);
+    ASSERT_TRUE(retrieved.has_value());
+    EXPECT_EQ(retrieved.value()->GetSample(3, 4).elevation_meters,
+              tile->GetSample(3, 4).elevation_meters);
+
+    // Rewritten in the native form
+    EXPECT_FALSE(std::filesystem::exists(legacy_path));
+    EXPECT_TRUE(std::filesystem::exists(legacy_path + ".native"));
+}
+
+TEST_F(ElevationCacheTest, PyramidLevelsAreCachedSeparately) {
+    ElevationCacheConfig config;
+    config.disk_cache_directory = cache_directory_;
+    config.enable_disk_cache = true;
+
+    auto cache = ElevationCache::Create(config);
+    ASSERT_NE(cache, nullptr);
+
+    const SRTMCoordinates coords{37, -122};
+    auto tile = CreateTestTile(coords, 1500);
+    auto overview = tile->Downsample(3);
+    ASSERT_NE(overview, nullptr);
+    EXPECT_TRUE(cache->Put(*overview));
+
+    // Only the overview is cached
+    EXPECT_FALSE(cache->Contains(coords));
+    EXPECT_FALSE(cache->Get(coords).has_value());
+    EXPECT_FALSE(cache->Get(coords, 2).has_value());
+
+    EXPECT_TRUE(cache->Put(*tile));
+    cache->ClearMemoryCache();
+
+    auto level3 = cache->Get(coords, 3);
+    ASSERT_TRUE(level3.has_value());
+    EXPECT_EQ(level3.value()->GetMetadata().level, 3u);
+    EXPECT_EQ(level3.value()->GetMetadata().samples_per_side, 151u);
+    EXPECT_TRUE(level3.value()->IsMapped());
+    auto level0 = cache->Get(coords);
+    ASSERT_TRUE(level0.has_value());
+    EXPECT_EQ(level0.value()->GetMetadata().samples_per_side, 1201u);
+    EXPECT_EQ(cache->GetStatistics().memory_cache_size_bytes,
+              tile->GetMetadata().file_size + overview->GetMetadata().file_size);
+
+    // Removing a tile removes its levels
+    EXPECT_TRUE(cache->Remove(coords));
+    EXPECT_FALSE(cache->Get(coords, 3).has_value());
+    EXPECT_TRUE(std::filesystem::is_empty(cache_directory_));
+}
+
+TEST_F(ElevationCacheTest, CompressedMemoryTiles) {
+    ElevationCacheConfig config;
+    config.disk_cache_directory = cache_directory_;
+    config.enable_disk_cache = false;
+    config.compress_memory_tiles = true;
+    config.hot_tile_count = 1;
+
+    std::vector<std::unique_ptr<SRTMTileData>> tiles;
+    config.max_memory_cache_size = 0;
+    for (int i = 0; i < 6; ++i) {
+        tiles.push_back(CreateTestTile({i, 10}, static_cast<int16_t>(100 * i)));
+        config.max_memory_cache_size += CompressedElevationTile(*tiles.back()).GetSizeBytes();
+    }
+    // Uncompressed, the budget would not even hold three tiles
+    ASSERT_LT(config.max_memory_cache_size, 3 * GetExpectedFileSize(SRTMResolution::SRTM3));
+
+    auto cache = ElevationCache::Create(config);
+    ASSERT_NE(cache, nullptr);
+    for (const auto& tile : tiles) {
+        EXPECT_TRUE(cache->Put(*tile));
+    }
+
+    // All six fit compressed
+    auto stats = cache->GetStatistics();
+    EXPECT_EQ(stats.tile_count_memory, 6u);
+    EXPECT_EQ(stats.evictions, 0u);
+    EXPECT_LE(stats.memory_cache_size_bytes, config.max_memory_cache_size);
+
+    // The last tile is hot; the others are decoded on access
+    for (int i = 5; i >= 0; --i) {
+        auto retrieved = cache->Get({i, 10});
+        ASSERT_TRUE(retrieved.has_value());
+        EXPECT_EQ(retrieved.value()->GetSample(17, 33).elevation_meters,
+                  tiles[static_cast<size_t>(i)]->GetSample(17, 33).elevation_meters);
+        EXPECT_TRUE(std::equal(retrieved.value()->GetSamples().begin(),
+                               retrieved.value()->GetSamples().end(),
+                               tiles[static_cast<size_t>(i)]->GetSamples().begin()));
+    }
+    stats = cache->GetStatistics();
+    EXPECT_EQ(stats.memory_cache_hits, 6u);
+    EXPECT_EQ(stats.decompressions, 5u);
+
+    // Repeated access to the hot tile does not decode again
+    EXPECT_TRUE(cache->Get({0, 10}).has_value());
+    EXPECT_EQ(cache->GetStatistics().decompressions, 5u);
+}
+
 TEST_F(ElevationCacheTest, MemoryAndDiskCacheHits) {
     ElevationCacheConfig config;
     config.disk_cache_directory = cache_directory_;
@@ -444,5 +594,83 @@ TEST_F(ElevationCacheTest, MultipleGetsUpdateLRU) {
     EXPECT_TRUE(cache->Contains(coords1));
 }
 
+TEST_F(ElevationCacheTest, ClockEvictionKeepsHitTiles) {
+    ElevationCacheConfig config;
+    config.disk_cache_directory = cache_directory_;
+    config.enable_disk_cache = false;
+    config.max_memory_cache_size = 4 * GetExpectedFileSize(SRTMResolution::SRTM3);
+
+    auto cache = ElevationCache::Create(config);
+    ASSERT_NE(cache, nullptr);
+
+    // The tile read between insertions survives every sweep
+    const SRTMCoordinates hot{0, 0};
+    EXPECT_TRUE(cache->Put(*CreateTestTile(hot)));
+    for (int lat = 1; lat <= 20; ++lat) {
+        EXPECT_TRUE(cache->Get(hot).has_value());
+        EXPECT_TRUE(cache->Put(*CreateTestTile({lat, 0})));
+        EXPECT_TRUE(cache->Contains(hot));
+    }
+
+    const auto stats = cache->GetStatistics();
+    EXPECT_EQ(stats.tile_count_memory, 4u);
+    EXPECT_EQ(stats.evictions, 17u);
+    EXPECT_EQ(stats.memory_cache_hits, 20u);
+    EXPECT_LE(stats.memory_cache_size_bytes, config.max_memory_cache_size);
+}
+
+TEST_F(ElevationCacheTest, ConcurrentGetsDuringEviction) {
+    ElevationCacheConfig config;
+    config.disk_cache_directory = cache_directory_;
+    config.enable_disk_cache = false;
+    config.max_memory_cache_size = 6 * GetExpectedFileSize(SRTMResolution::SRTM3);
+
+    auto cache = ElevationCache::Create(config);
+    ASSERT_NE(cache, nullptr);
+
+    std::vector<std::shared_ptr<SRTMTileData>> tiles;
+    for (int lat = 0; lat < 12; ++lat) {
+        tiles.push_back(CreateTestTile({lat, 0}, static_cast<int16_t>(100 * lat)));
+    }
+    for (int lat = 0; lat < 4; ++lat) {
+        EXPECT_TRUE(cache->Put(*tiles[static_cast<size_t>(lat)]));
+    }
+
+    // Readers see either a miss or the tile they asked for
+    std::atomic<uint64_t> hits{0};
+    std::atomic<bool> mismatch{false};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&, t]() {
+            for (int i = 0; i < 2000; ++i) {
+                const int lat = (i * 7 + t) % 12;
+                const auto tile = cache->Get({lat, 0});
+                if (tile.has_value()) {
+                    ++hits;
+                    if (tile.value()->GetSample(5, 5).elevation_meters !=
+                        tiles[static_cast<size_t>(lat)]->GetSample(5, 5).elevation_meters) {
+                        mismatch = true;
+                    }
+                }
+            }
+        });
+    }
+    for (int round = 0; round < 3; ++round) {
+        for (const auto& tile : tiles) {
+            EXPECT_TRUE(cache->Put(*tile));
+        }
+    }
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_FALSE(mismatch);
+    const auto stats = cache->GetStatistics();
+    EXPECT_EQ(stats.memory_cache_hits, hits.load());
+    EXPECT_EQ(stats.memory_cache_hits + stats.cache_misses, 4u * 2000u);
+    EXPECT_LE(stats.tile_count_memory, 6u);
+    EXPECT_LE(stats.memory_cache_size_bytes, config.max_memory_cache_size);
+}
+
 } // anonymous namespace
 } // namespace earth_map
@@ -0,0 +1,162 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#include <earth_map/data/elevation_data.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+
+namespace earth_map {
+namespace {
+
+/// SRTM3 tile with a rough pattern and scattered voids
+std::unique_ptr<SRTMTileData> CreateTile() {
+    auto tile = std::make_unique<SRTMTileData>(SRTMMetadata({46, 7}, SRTMResolution::SRTM3));
+    auto& data = tile->GetRawData();
+    const size_t samples = tile->GetMetadata().samples_per_side;
+    for (size_t y = 0; y < samples; ++y) {
+        for (size_t x = 0; x < samples; ++x) {
+            data[y * samples + x] = static_cast<int16_t>(
+                2000.0 + 1500.0 * std::sin(x * 0.031) * std::cos(y * 0.017) -
+                static_cast<double>((x * 7 + y * 13) % 50));
+        }
+    }
+    for (size_t i = 0; i < data.size(); i += 997) {
+        data[i] = -32768;
+    }
+    // Negative elevations (e.g. the Dead Sea) sign-extend correctly
+    for (size_t y = 1; y <= 2; ++y) {
+        for (size_t x = 1; x <= 2; ++x) {
+            data[y * samples + x] = -400;
+        }
+    }
+    tile->SetValid(true);
+    return tile;
+}
+
+TEST(SRTMTileDataTest, BatchInterpolationMatchesSinglePoints) {
+    const auto tile = CreateTile();
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> fraction(0.0, 1.0);
+    std::vector<double> lat;
+    std::vector<double> lon;
+    for (int i = 0; i < 10003; ++i) {
+        lat.push_back(fraction(rng));
+        lon.push_back(fraction(rng));
+    }
+    // Edges, corners, out-of-range and NaN fractions are clamped
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    for (const auto& [la, lo] : std::vector<std::pair<double, double>>{
+             {0.0, 0.0}, {1.0, 1.0}, {0.999999, 0.0}, {-0.5, 1.5}, {nan, 0.5}, {0.5, nan},
+             {1.0 - 1.5 / 1200.0, 1.5 / 1200.0}}) {
+        lat.push_back(la);
+        lon.push_back(lo);
+    }
+
+    std::vector<float> batch(lat.size());
+    std::vector<float> scalar(lat.size());
+    tile->InterpolateElevations(lat, lon, batch);
+    tile->InterpolateElevationsScalar(lat, lon, scalar);
+
+    size_t voids = 0;
+    for (size_t i = 0; i < lat.size(); ++i) {
+        EXPECT_EQ(batch[i], scalar[i]) << "point " << i;
+        if (std::isnan(lat[i]) || std::isnan(lon[i])) {
+            continue;  // InterpolateElevation does not define NaN input
+        }
+        const float reference = tile->InterpolateElevation(lat[i], lon[i]);
+        EXPECT_EQ(batch[i], reference) << "point " << i;
+        voids += reference == 0.0f ? 1 : 0;
+    }
+    EXPECT_GT(voids, 0u);  // Void masking was exercised
+
+    // The point inside the negative block
+    EXPECT_EQ(batch.back(), -400.0f);
+}
+
+TEST(SRTMTileDataTest, BatchInterpolationEdgeCases) {
+    const auto tile = CreateTile();
+    const std::vector<double> lat = {0.25, 0.5, 0.75};
+    const std::vector<double> lon = {0.25, 0.5};
+
+    // Only the shortest span is processed
+    std::vector<float> out(3, -1.0f);
+    tile->InterpolateElevations(lat, lon, out);
+    EXPECT_NE(out[0], -1.0f);
+    EXPECT_NE(out[1], -1.0f);
+    EXPECT_EQ(out[2], -1.0f);
+
+    // An invalid tile yields sea level
+    SRTMTileData empty(SRTMMetadata({0, 0}, SRTMResolution::SRTM3));
+    empty.InterpolateElevations(lat, lon, out);
+    EXPECT_EQ(out[0], 0.0f);
+    EXPECT_EQ(out[1], 0.0f);
+}
+
+TEST(SRTMTileDataTest, PyramidLevelGeometry) {
+    EXPECT_EQ(GetPyramidSamplesPerSide(SRTMResolution::SRTM3, 0), 1201u);
+    EXPECT_EQ(GetPyramidSamplesPerSide(SRTMResolution::SRTM3, 1), 601u);
+    EXPECT_EQ(GetPyramidSamplesPerSide(SRTMResolution::SRTM3, 4), 76u);
+    EXPECT_EQ(GetPyramidSamplesPerSide(SRTMResolution::SRTM3, 8), 5u);
+    EXPECT_EQ(GetPyramidSamplesPerSide(SRTMResolution::SRTM1, 8), 15u);
+    EXPECT_EQ(GetPyramidSamplesPerSide(SRTMResolution::SRTM3, 40), 2u);
+
+    const SRTMMetadata metadata({1, 2}, SRTMResolution::SRTM3, 3);
+    EXPECT_EQ(metadata.level, 3u);
+    EXPECT_EQ(metadata.samples_per_side, 151u);
+    EXPECT_EQ(metadata.file_size, 151u * 151u * 2u);
+
+    // SRTM3 level 0 is ~93 m apart, level 1 ~185 m, level 8 ~28 km
+    EXPECT_EQ(SelectPyramidLevel(SRTMResolution::SRTM3, 30.0), 0u);
+    EXPECT_EQ(SelectPyramidLevel(SRTMResolution::SRTM3, 200.0), 1u);
+    EXPECT_EQ(SelectPyramidLevel(SRTMResolution::SRTM1, 200.0), 2u);
+    EXPECT_EQ(SelectPyramidLevel(SRTMResolution::SRTM3, 1.0e6), kMaxElevationPyramidLevel);
+    EXPECT_EQ(SelectPyramidLevel(SRTMResolution::SRTM3, std::nan("")), 0u);
+}
+
+TEST(SRTMTileDataTest, DownsampleFiltersAndSkipsVoids) {
+    // A plane survives the (linear) tent filter exactly
+    SRTMTileData plane(SRTMMetadata({46, 7}, SRTMResolution::SRTM3));
+    auto& data = plane.GetRawData();
+    for (size_t y = 0; y < 1201; ++y) {
+        for (size_t x = 0; x < 1201; ++x) {
+            data[y * 1201 + x] = static_cast<int16_t>(x + 2 * y);
+        }
+    }
+    data[0] = -32768;  // A lone void is filled from its neighbors
+    for (size_t y = 1100; y < 1201; ++y) {
+        for (size_t x = 1100; x < 1201; ++x) {
+            data[y * 1201 + x] = -32768;  // A large hole stays a hole
+        }
+    }
+    plane.SetValid(true);
+
+    const auto level1 = plane.Downsample(1);
+    ASSERT_NE(level1, nullptr);
+    EXPECT_EQ(level1->GetMetadata().level, 1u);
+    EXPECT_EQ(level1->GetMetadata().samples_per_side, 601u);
+    EXPECT_EQ(level1->GetSample(10, 20).elevation_meters, 20 + 2 * 40);
+    EXPECT_TRUE(level1->GetSample(0, 0).is_valid);
+    EXPECT_FALSE(level1->GetSample(600, 600).is_valid);
+    EXPECT_TRUE(level1->GetMetadata().has_voids);
+
+    // Levels chain, and sampling a coarse level matches the source
+    const auto level4 = level1->Downsample(4);
+    ASSERT_NE(level4, nullptr);
+    EXPECT_EQ(level4->GetMetadata().samples_per_side, 76u);
+    EXPECT_NEAR(level4->InterpolateElevation(0.5, 0.3),
+                plane.InterpolateElevation(0.5, 0.3), 1.0f);
+
+    // Only coarser, valid levels
+    EXPECT_EQ(level4->Downsample(4), nullptr);
+    EXPECT_EQ(level4->Downsample(kMaxElevationPyramidLevel + 1), nullptr);
+    SRTMTileData invalid(SRTMMetadata({0, 0}, SRTMResolution::SRTM3));
+    EXPECT_EQ(invalid.Downsample(1), nullptr);
+}
+
+} // anonymous namespace
+} // namespace earth_map
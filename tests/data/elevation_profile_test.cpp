@@ -0,0 +1,159 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#include <earth_map/data/elevation_provider.h>
+#include <earth_map/math/geodetic_calculations.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <stdexcept>
+
+namespace earth_map {
+namespace {
+
+using namespace coordinates;
+
+/// Provider with elevation = latitude * 100 m, missing west of 7°E; records
+/// the size and resolution of each batch query
+class FakeElevationProvider : public ElevationProvider {
+public:
+    ElevationQuery GetElevation(double latitude, double longitude) const override {
+        ElevationQuery query;
+        query.latitude = latitude;
+        query.longitude = longitude;
+        query.valid = longitude >= 7.0;
+        query.elevation_meters = static_cast<float>(latitude * 100.0);
+        return query;
+    }
+
+    std::vector<ElevationQuery> GetElevations(
+        const std::vector<Geographic>& points) const override {
+        std::vector<ElevationQuery> results;
+        results.reserve(points.size());
+        for (const auto& point : points) {
+            results.push_back(GetElevation(point.latitude, point.longitude));
+        }
+        return results;
+    }
+
+    std::vector<ElevationQuery> GetElevations(const std::vector<Geographic>& points,
+                                              double ground_resolution) const override {
+        batch_sizes.push_back(points.size());
+        resolution = ground_resolution;
+        return GetElevations(points);
+    }
+
+    size_t PreloadRegion(const coordinates::GeographicBounds& /*bounds*/) override { return 0; }
+    std::shared_ptr<ElevationPreload> PreloadRegionAsync(
+        const coordinates::GeographicBounds& /*bounds*/,
+        const std::optional<Geographic>& /*focus*/) override {
+        return nullptr;
+    }
+    bool IsAvailable(double /*latitude*/, double /*longitude*/) const override { return true; }
+    ElevationCacheStats GetCacheStatistics() const override { return {}; }
+    SRTMLoaderStats GetLoaderStatistics() const override { return {}; }
+    void ClearCache() override {}
+
+    mutable std::vector<size_t> batch_sizes;
+    mutable double resolution = 0.0;
+};
+
+/// Every sample of a path
+std::vector<Geographic> SampleAll(GeodesicPathSampler& sampler, size_t chunk = 7) {
+    std::vector<Geographic> result;
+    std::vector<Geographic> buffer(chunk);
+    while (const size_t count = sampler.Next(buffer)) {
+        result.insert(result.end(), buffer.begin(), buffer.begin() + count);
+    }
+    return result;
+}
+
+TEST(GeodesicPathSamplerTest, WalksAMeridianAtFixedSpacing) {
+    const std::vector<Geographic> path = {Geographic(10.0, 20.0), Geographic(11.0, 20.0)};
+    GeodesicPathSampler sampler(path, 1000.0);
+    const double length = GeodeticCalculator::HaversineDistance(path[0], path[1]);
+    EXPECT_NEAR(sampler.GetLength(), length, 1e-6);
+    ASSERT_EQ(sampler.GetSampleCount(), static_cast<size_t>(std::floor(length / 1000.0)) + 1);
+
+    const std::vector<Geographic> points = SampleAll(sampler);
+    ASSERT_EQ(points.size(), sampler.GetSampleCount());
+    EXPECT_EQ(sampler.GetEmittedCount(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        EXPECT_NEAR(points[i].longitude, 20.0, 1e-9);
+        EXPECT_NEAR(GeodeticCalculator::HaversineDistance(path[0], points[i]), i * 1000.0, 1e-4);
+    }
+}
+
+TEST(GeodesicPathSamplerTest, CarriesSpacingAcrossLegs) {
+    // An oblique leg, a repeated vertex, then a leg along the equator
+    const std::vector<Geographic> path = {Geographic(1.0, -1.0), Geographic(0.0, 0.0),
+                                          Geographic(0.0, 0.0), Geographic(0.0, 0.5)};
+    GeodesicPathSampler sampler(path, 2500.0);
+    const double first = GeodeticCalculator::HaversineDistance(path[0], path[1]);
+    const double second = GeodeticCalculator::HaversineDistance(path[2], path[3]);
+    EXPECT_NEAR(sampler.GetLength(), first + second, 1e-6);
+
+    const std::vector<Geographic> points = SampleAll(sampler, 3);
+    ASSERT_EQ(points.size(), sampler.GetSampleCount());
+    for (size_t i = 0; i < points.size(); ++i) {
+        const double distance = i * 2500.0;
+        if (distance <= first) {
+            EXPECT_NEAR(GeodeticCalculator::HaversineDistance(path[0], points[i]), distance, 1e-4);
+            EXPECT_NEAR(GeodeticCalculator::HaversineDistance(points[i], path[1]),
+                        first - distance, 1e-4);
+        } else {
+            EXPECT_NEAR(points[i].latitude, 0.0, 1e-9);
+            EXPECT_NEAR(GeodeticCalculator::HaversineDistance(path[2], points[i]),
+                        distance - first, 1e-4);
+        }
+    }
+}
+
+TEST(GeodesicPathSamplerTest, HandlesDegeneratePaths) {
+    GeodesicPathSampler empty({}, 10.0);
+    EXPECT_EQ(empty.GetSampleCount(), 0u);
+    EXPECT_TRUE(SampleAll(empty).empty());
+
+    GeodesicPathSampler single({Geographic(45.0, 7.0)}, 10.0);
+    const std::vector<Geographic> points = SampleAll(single);
+    ASSERT_EQ(points.size(), 1u);
+    EXPECT_NEAR(points[0].latitude, 45.0, 1e-9);
+    EXPECT_NEAR(points[0].longitude, 7.0, 1e-9);
+
+    EXPECT_THROW(GeodesicPathSampler({Geographic(0.0, 0.0)}, 0.0), std::invalid_argument);
+    EXPECT_THROW(GeodesicPathSampler({Geographic(0.0, 0.0)}, -1.0), std::invalid_argument);
+}
+
+TEST(ElevationProfileTest, SamplesThroughBatchQueries) {
+    const FakeElevationProvider provider;
+    // About 445 km east along 30°N from 5°E: the first ~190 km are missing
+    const std::vector<Geographic> path = {Geographic(30.0, 5.0), Geographic(30.0, 9.5),
+                                          Geographic(30.0, 9.6)};
+    const ElevationProfile profile = provider.GetElevationProfile(path, 5.0);
+    EXPECT_DOUBLE_EQ(profile.spacing_meters, 5.0);
+    EXPECT_NEAR(profile.length_meters, GeodesicPathSampler(path, 5.0).GetLength(), 1e-9);
+    ASSERT_EQ(profile.elevations.size(), GeodesicPathSampler(path, 5.0).GetSampleCount());
+
+    // Bounded batches at the profile spacing
+    ASSERT_GT(provider.batch_sizes.size(), 1u);
+    EXPECT_EQ(provider.batch_sizes.front(), 65536u);
+    EXPECT_DOUBLE_EQ(provider.resolution, 5.0);
+
+    size_t missing = 0;
+    for (const float elevation : profile.elevations) {
+        if (std::isnan(elevation)) {
+            ++missing;
+        } else {
+            // Great circles bulge toward the pole between vertices
+            EXPECT_GE(elevation, 3000.0f - 1e-3f);
+            EXPECT_LT(elevation, 3010.0f);
+        }
+    }
+    EXPECT_EQ(profile.missing_samples, missing);
+    EXPECT_TRUE(std::isnan(profile.elevations.front()));
+    EXPECT_FALSE(std::isnan(profile.elevations.back()));
+}
+
+} // namespace
+} // namespace earth_map
@@ -295,6 +295,82 @@ TEST_F(ElevationProviderTest, PreloadRegionInvalidBounds) {
     EXPECT_EQ(loaded, 0u);
 }
 
+TEST_F(ElevationProviderTest, PreloadRegionAsyncReportsProgress) {
+    // 3x3 region with four tiles available
+    CreateTestHGTFile({37, -122}, 1500);
+    CreateTestHGTFile({37, -121}, 1600);
+    CreateTestHGTFile({38, -122}, 1700);
+    CreateTestHGTFile({39, -120}, 1800);
+
+    auto provider = CreateProvider();
+    ASSERT_NE(provider, nullptr);
+
+    GeographicBounds bounds({37.0, -122.0}, {39.5, -119.5});
+    const auto preload = provider->PreloadRegionAsync(bounds, Geographic(37.5, -121.5));
+    ASSERT_NE(preload, nullptr);
+    EXPECT_EQ(preload->GetTotalTiles(), 9u);
+
+    EXPECT_EQ(preload->Wait(), 4u);
+    EXPECT_TRUE(preload->IsDone());
+    EXPECT_EQ(preload->GetCompletedTiles(), 9u);
+    EXPECT_EQ(preload->GetLoadedTiles(), 4u);
+    EXPECT_TRUE(provider->IsAvailable(39.5, -119.5));
+
+    // Cached tiles count as loaded without reloading
+    const size_t loads = provider->GetLoaderStatistics().tiles_loaded;
+    EXPECT_EQ(provider->PreloadRegionAsync(bounds)->Wait(), 4u);
+    EXPECT_EQ(provider->GetLoaderStatistics().tiles_loaded, loads);
+
+    // Invalid bounds finish immediately
+    const auto empty = provider->PreloadRegionAsync(GeographicBounds({50.0, -120.0}, {40.0, -130.0}));
+    EXPECT_TRUE(empty->IsDone());
+    EXPECT_EQ(empty->GetTotalTiles(), 0u);
+}
+
+TEST_F(ElevationProviderTest, RegionTilesNearestFocusFirst) {
+    GeographicBounds bounds({37.0, -122.0}, {39.5, -119.5});
+
+    const auto tiles = GetRegionTiles(bounds, Geographic(39.2, -119.8));
+    ASSERT_EQ(tiles.size(), 9u);
+    EXPECT_EQ(tiles.front(), (SRTMCoordinates{39, -120}));
+    EXPECT_EQ(tiles.back(), (SRTMCoordinates{37, -122}));
+
+    // Neighbors across the antimeridian are near
+    const auto wrapped = GetRegionTiles(GeographicBounds({0.0, -180.0}, {0.5, 179.5}),
+                                        Geographic(0.5, 179.9));
+    ASSERT_EQ(wrapped.size(), 360u);
+    EXPECT_EQ(wrapped[0], (SRTMCoordinates{0, 179}));
+    EXPECT_EQ(wrapped[1], (SRTMCoordinates{0, -180}));
+
+    EXPECT_TRUE(GetRegionTiles(GeographicBounds({50.0, -120.0}, {40.0, -130.0}),
+                               Geographic(45.0, -125.0)).empty());
+}
+
+TEST_F(ElevationProviderTest, PreloadRegionAsyncCancel) {
+    CreateTestHGTFile({37, -122}, 1500);
+
+    auto provider = CreateProvider();
+    ASSERT_NE(provider, nullptr);
+
+    // A large region of missing tiles: cancelling stops issuing loads
+    GeographicBounds bounds({0.0, 0.0}, {19.5, 19.5});
+    const auto preload = provider->PreloadRegionAsync(bounds);
+    preload->Cancel();
+    EXPECT_EQ(preload->Wait(), 0u);
+    EXPECT_TRUE(preload->IsDone());
+    const size_t completed = preload->GetCompletedTiles();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(preload->GetCompletedTiles(), completed);
+
+    // Destroying the provider cancels preloads in flight; handles stay usable
+    const auto pending = provider->PreloadRegionAsync(bounds);
+    const auto loading = provider->PreloadRegionAsync(GeographicBounds({37.0, -122.0}, {37.5, -121.5}));
+    provider.reset();
+    EXPECT_TRUE(pending->IsDone());
+    EXPECT_TRUE(loading->IsDone());
+    EXPECT_LE(loading->Wait(), 1u);
+}
+
 TEST_F(ElevationProviderTest, IsAvailableCached) {
     // Create test tile
     CreateTestHGTFile({37, -122}, 1500);
@@ -708,6 +784,49 @@ TEST_F(ElevationProviderTest, ConcurrentIsAvailable) {
     EXPECT_EQ(available_count, num_threads * 100);
 }
 
+TEST_F(ElevationProviderTest, CoarseQueriesReadPyramidLevels) {
+    CreateTestHGTFile({37, -122}, 1500);
+
+    std::vector<Geographic> points;
+    for (int i = 0; i < 20; ++i) {
+        points.emplace_back(37.05 + i * 0.045, -121.95 + i * 0.045);
+    }
+
+    // ~5 km apart: SRTM3 level 5 (38 samples, ~3 km spacing)
+    {
+        auto provider = CreateProvider();
+        ASSERT_NE(provider, nullptr);
+        const auto fine = provider->GetElevations(points);
+        const auto coarse = provider->GetElevations(points, 5000.0);
+        ASSERT_EQ(coarse.size(), points.size());
+        for (size_t i = 0; i < points.size(); ++i) {
+            EXPECT_TRUE(coarse[i].valid);
+            EXPECT_EQ(coarse[i].source_tile, (SRTMCoordinates{37, -122}));
+            EXPECT_NEAR(coarse[i].elevation_meters, fine[i].elevation_meters, 5.0f);
+        }
+
+        // Full-resolution spacing reads the source tile
+        const auto same = provider->GetElevations(points, 10.0);
+        for (size_t i = 0; i < points.size(); ++i) {
+            EXPECT_EQ(same[i].elevation_meters, fine[i].elevation_meters);
+        }
+    }
+
+    // Every level was persisted: later sessions no longer need the full tile
+    for (uint32_t level = 1; level <= kMaxElevationPyramidLevel; ++level) {
+        EXPECT_TRUE(std::filesystem::exists(test_cache_directory_ + "/N37W122.hgt.L" +
+                                            std::to_string(level) + ".native"));
+    }
+    std::filesystem::remove(test_data_directory_ + "/N37W122.hgt");
+    std::filesystem::remove(test_cache_directory_ + "/N37W122.hgt.native");
+
+    auto provider = CreateProvider();
+    ASSERT_NE(provider, nullptr);
+    EXPECT_TRUE(provider->GetElevations(points, 50000.0)[0].valid);
+    EXPECT_FALSE(provider->GetElevations(points)[0].valid);
+    EXPECT_EQ(provider->GetLoaderStatistics().tiles_loaded, 0u);
+}
+
 TEST_F(ElevationProviderTest, ConcurrentClearCache) {
     // Create test tile
     CreateTestHGTFile({37, -122}, 1500);
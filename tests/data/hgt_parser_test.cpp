@@ -6,6 +6,8 @@
 #include <gtest/gtest.h>
 
 #include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <vector>
 
 namespace earth_map {
@@ -238,5 +240,138 @@ TEST(HGTParserTest, InterpolationBasic) {
     EXPECT_GT(elevation_11, 0.0f);
 }
 
+TEST(HGTParserTest, SwapMatchesPerSampleConversion) {
+    // Every 16-bit pattern, with voids inside the SIMD groups and in the tail
+    auto data = CreateSyntheticSRTM3Data();
+    for (size_t i = 0; i < 65536; ++i) {
+        data[i * 2] = static_cast<uint8_t>(i >> 8);
+        data[i * 2 + 1] = static_cast<uint8_t>(i & 0xFF);
+    }
+    std::vector<uint8_t> no_voids = data;
+    for (size_t i = 0; i < no_voids.size(); i += 2) {
+        if (no_voids[i] == 0x80 && no_voids[i + 1] == 0x00) {
+            no_voids[i] = 0x7F;
+        }
+    }
+
+    auto tile = HGTParser::Parse(no_voids, {0, 0});
+    ASSERT_NE(tile, nullptr);
+    EXPECT_FALSE(tile->GetMetadata().has_voids);
+    const auto samples = tile->GetSamples();
+    for (size_t i = 0; i < samples.size(); ++i) {
+        ASSERT_EQ(samples[i], static_cast<int16_t>((no_voids[i * 2] << 8) | no_voids[i * 2 + 1]))
+            << "sample " << i;
+    }
+
+    // A void in the scalar tail (1201^2 is not a multiple of 8) is detected
+    const size_t last = samples.size() - 1;
+    no_voids[last * 2] = 0x80;
+    no_voids[last * 2 + 1] = 0x00;
+    tile = HGTParser::Parse(no_voids, {0, 0});
+    ASSERT_NE(tile, nullptr);
+    EXPECT_TRUE(tile->GetMetadata().has_voids);
+}
+
+/// Temporary directory removed with the fixture
+class HGTParserFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() / "earth_map_hgt_parser_test";
+        std::filesystem::create_directories(directory_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    std::string PathOf(const std::string& name) const {
+        return (directory_ / name).string();
+    }
+
+    std::filesystem::path directory_;
+};
+
+TEST_F(HGTParserFileTest, ParseFileMatchesParse) {
+    const auto data = CreateSyntheticSRTM3Data(1200);
+    {
+        std::ofstream file(PathOf("N10E020.hgt"), std::ios::binary);
+        file.write(reinterpret_cast<const char*>(data.data()),
+                   static_cast<std::streamsize>(data.size()));
+    }
+
+    const auto from_file = HGTParser::ParseFile(PathOf("N10E020.hgt"));
+    const auto from_memory = HGTParser::Parse(data, {10, 20});
+    ASSERT_NE(from_file, nullptr);
+    ASSERT_NE(from_memory, nullptr);
+    EXPECT_EQ(from_file->GetMetadata().coordinates, (SRTMCoordinates{10, 20}));
+    EXPECT_FALSE(from_file->IsMapped());
+    EXPECT_TRUE(std::equal(from_file->GetSamples().begin(), from_file->GetSamples().end(),
+                           from_memory->GetSamples().begin(), from_memory->GetSamples().end()));
+
+    // Missing and truncated files
+    EXPECT_EQ(HGTParser::ParseFile(PathOf("N11E020.hgt")), nullptr);
+    std::filesystem::resize_file(PathOf("N10E020.hgt"), data.size() - 2);
+    EXPECT_EQ(HGTParser::ParseFile(PathOf("N10E020.hgt")), nullptr);
+}
+
+TEST_F(HGTParserFileTest, NativeFileIsMappedInPlace) {
+    auto data = CreateSyntheticSRTM3Data(300);
+    data[200] = 0x80;  // One void, filled by the parser
+    data[201] = 0x00;
+    const auto tile = HGTParser::Parse(data, {-34, 18});
+    ASSERT_NE(tile, nullptr);
+
+    const std::string path = PathOf("S34E018.hgt.native");
+    ASSERT_TRUE(HGTParser::WriteNativeFile(*tile, path));
+    EXPECT_EQ(std::filesystem::file_size(path), 32u + 1201u * 1201u * 2u);
+
+    auto mapped = HGTParser::MapNativeFile(path, {-34, 18});
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_TRUE(mapped->IsMapped());
+    EXPECT_TRUE(mapped->IsValid());
+    EXPECT_TRUE(mapped->GetMetadata().has_voids);
+    EXPECT_EQ(mapped->GetMetadata().resolution, SRTMResolution::SRTM3);
+    EXPECT_TRUE(std::equal(mapped->GetSamples().begin(), mapped->GetSamples().end(),
+                           tile->GetSamples().begin(), tile->GetSamples().end()));
+    EXPECT_EQ(mapped->InterpolateElevation(0.3, 0.7), tile->InterpolateElevation(0.3, 0.7));
+
+    // Rewriting the file leaves the existing mapping intact
+    const auto first_sample = mapped->GetSample(0, 0).elevation_meters;
+    const auto other = HGTParser::Parse(CreateSyntheticSRTM3Data(900), {-34, 18});
+    ASSERT_TRUE(HGTParser::WriteNativeFile(*other, path));
+    EXPECT_EQ(mapped->GetSample(0, 0).elevation_meters, first_sample);
+
+    // Mutable access copies the samples out of the mapping
+    mapped->GetRawData()[0] = 42;
+    EXPECT_FALSE(mapped->IsMapped());
+    EXPECT_EQ(mapped->GetSample(0, 0).elevation_meters, 42);
+    EXPECT_EQ(mapped->GetSample(1, 0).elevation_meters, tile->GetSample(1, 0).elevation_meters);
+
+    // Other coordinates and damaged files are rejected
+    EXPECT_EQ(HGTParser::MapNativeFile(path, {-33, 18}), nullptr);
+    EXPECT_EQ(HGTParser::MapNativeFile(PathOf("missing.native"), {-34, 18}), nullptr);
+    std::filesystem::resize_file(path, 1000);
+    EXPECT_EQ(HGTParser::MapNativeFile(path, {-34, 18}), nullptr);
+}
+
+TEST_F(HGTParserFileTest, NativeFileKeepsPyramidLevel) {
+    const auto tile = HGTParser::Parse(CreateSyntheticSRTM1Data(), {5, 6});
+    ASSERT_NE(tile, nullptr);
+    const auto overview = tile->Downsample(5);
+    ASSERT_NE(overview, nullptr);
+
+    const std::string path = PathOf("N05E006.hgt.L5.native");
+    ASSERT_TRUE(HGTParser::WriteNativeFile(*overview, path));
+    EXPECT_EQ(HGTParser::MapNativeFile(path, {5, 6}), nullptr);  // Not level 0
+
+    const auto mapped = HGTParser::MapNativeFile(path, {5, 6}, 5);
+    ASSERT_NE(mapped, nullptr);
+    EXPECT_EQ(mapped->GetMetadata().level, 5u);
+    EXPECT_EQ(mapped->GetMetadata().resolution, SRTMResolution::SRTM1);
+    EXPECT_EQ(mapped->GetMetadata().samples_per_side, 113u);
+    EXPECT_EQ(mapped->GetSample(50, 60).elevation_meters,
+              overview->GetSample(50, 60).elevation_meters);
+}
+
 } // anonymous namespace
 } // namespace earth_map
@@ -0,0 +1,212 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#include <earth_map/data/kml_stream_parser.h>
+#include <earth_map/data/kml_loader.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace earth_map {
+namespace {
+
+constexpr const char* kDocument = R"(<?xml version="1.0" encoding="UTF-8"?>
+<kml xmlns="http://www.opengis.net/kml/2.2">
+<!-- exported <Placemark> list -->
+<Document>
+  <name>Sites</name>
+  <Style id="red"><IconStyle><scale>1.2</scale></IconStyle></Style>
+  <Folder>
+    <Placemark id="a">
+      <name>Tom &amp; Jerry&#x27;s &#233;</name>
+      <styleUrl>#red</styleUrl>
+      <description><![CDATA[<b>not a tag</b>]]></description>
+      <Point><coordinates>8.5,47.25,410</coordinates></Point>
+    </Placemark>
+    <Placemark>
+      <name><![CDATA[Route <1>]]></name>
+      <LineString>
+        <tessellate>1</tessellate>
+        <coordinates>
+          8.0,47.0 8.1,47.1,5
+          8.2,47.2
+        </coordinates>
+      </LineString>
+    </Placemark>
+    <kml:Placemark>
+      <kml:name>Lake</kml:name>
+      <MultiGeometry>
+        <Polygon>
+          <outerBoundaryIs><LinearRing><coordinates>0,0 1,0 1,1 0,0</coordinates></LinearRing></outerBoundaryIs>
+          <innerBoundaryIs><LinearRing><coordinates>0.2,0.2 0.3,0.2 0.2,0.3 0.2,0.2</coordinates></LinearRing></innerBoundaryIs>
+        </Polygon>
+        <Point><coordinates>5,5</coordinates></Point>
+      </MultiGeometry>
+    </kml:Placemark>
+    <Placemark><name>No geometry</name></Placemark>
+    <Placemark><name>Bad</name><Point><coordinates>8.5;47</coordinates></Point></Placemark>
+    <Placemark><Point/></Placemark>
+  </Folder>
+</Document>
+</kml>
+)";
+
+/// Parse @p document fed in chunks of @p chunk_size bytes
+std::vector<KmlPlacemark> ParseInChunks(const std::string& document, size_t chunk_size) {
+    std::vector<KmlPlacemark> placemarks;
+    KmlStreamParser parser([&](KmlPlacemark&& placemark) {
+        placemarks.push_back(std::move(placemark));
+    });
+    for (size_t pos = 0; pos < document.size(); pos += chunk_size) {
+        const size_t size = std::min(chunk_size, document.size() - pos);
+        EXPECT_TRUE(parser.Write(std::span<const char>(document.data() + pos, size)))
+            << parser.GetError();
+    }
+    EXPECT_TRUE(parser.Finish()) << parser.GetError();
+    EXPECT_EQ(parser.GetSkippedCount(), 3u);
+    return placemarks;
+}
+
+TEST(KmlStreamParserTest, ReadsPlacemarksAtAnyChunkSize) {
+    for (const size_t chunk_size : {size_t{1}, size_t{2}, size_t{7}, size_t{64}, size_t{1} << 20}) {
+        SCOPED_TRACE(chunk_size);
+        const std::vector<KmlPlacemark> placemarks = ParseInChunks(kDocument, chunk_size);
+        ASSERT_EQ(placemarks.size(), 3u);
+
+        EXPECT_EQ(placemarks[0].name, "Tom & Jerry's \xC3\xA9");
+        EXPECT_EQ(placemarks[0].style_url, "#red");
+        EXPECT_EQ(placemarks[0].geometry, KmlGeometryType::POINT);
+        ASSERT_EQ(placemarks[0].coordinates.size(), 1u);
+        EXPECT_DOUBLE_EQ(placemarks[0].coordinates[0].latitude, 47.25);
+        EXPECT_DOUBLE_EQ(placemarks[0].coordinates[0].longitude, 8.5);
+        EXPECT_DOUBLE_EQ(placemarks[0].coordinates[0].altitude, 410.0);
+
+        EXPECT_EQ(placemarks[1].name, "Route <1>");
+        EXPECT_EQ(placemarks[1].geometry, KmlGeometryType::LINE_STRING);
+        ASSERT_EQ(placemarks[1].coordinates.size(), 3u);
+        EXPECT_DOUBLE_EQ(placemarks[1].coordinates[1].latitude, 47.1);
+        EXPECT_DOUBLE_EQ(placemarks[1].coordinates[1].altitude, 5.0);
+        EXPECT_DOUBLE_EQ(placemarks[1].coordinates[2].altitude, 0.0);
+
+        // First geometry of the MultiGeometry, outer boundary only
+        EXPECT_EQ(placemarks[2].name, "Lake");
+        EXPECT_EQ(placemarks[2].geometry, KmlGeometryType::POLYGON);
+        EXPECT_EQ(placemarks[2].coordinates.size(), 4u);
+    }
+}
+
+TEST(KmlStreamParserTest, RejectsMalformedDocuments) {
+    std::vector<KmlPlacemark> placemarks;
+    const auto collect = [&](KmlPlacemark&& placemark) {
+        placemarks.push_back(std::move(placemark));
+    };
+
+    KmlStreamParser mismatched(collect);
+    const std::string bad = "<kml><Placemark><Point></Placemark></kml>";
+    EXPECT_FALSE(mismatched.Write(bad));
+    EXPECT_NE(mismatched.GetError().find("</Placemark>"), std::string::npos);
+    EXPECT_FALSE(mismatched.Write(std::string_view("<kml/>")));
+    EXPECT_FALSE(mismatched.Finish());
+
+    KmlStreamParser truncated(collect);
+    const std::string head = "<kml><Document><Placemark><Point><coordinates>1,2";
+    EXPECT_TRUE(truncated.Write(head));
+    EXPECT_FALSE(truncated.Finish());
+    EXPECT_TRUE(placemarks.empty());
+}
+
+class KmlLoadJobTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() / "earth_map_kml_loader_test";
+        std::filesystem::create_directories(directory_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    std::string WriteFile(const std::string& name, const std::string& content) const {
+        const std::string path = (directory_ / name).string();
+        std::ofstream(path, std::ios::binary) << content;
+        return path;
+    }
+
+    std::filesystem::path directory_;
+};
+
+TEST_F(KmlLoadJobTest, HandsOverBoundedBatches) {
+    std::string document = "<kml><Document>";
+    for (int i = 0; i < 1000; ++i) {
+        document += "<Placemark><name>p" + std::to_string(i) +
+                    "</name><Point><coordinates>" + std::to_string(i % 360 - 180) +
+                    ",10</coordinates></Point></Placemark>\n";
+    }
+    document += "</Document></kml>";
+    const std::string path = WriteFile("points.kml", document);
+
+    KmlLoadOptions options;
+    options.batch_size = 64;
+    options.max_queued_batches = 2;
+    options.chunk_bytes = 1000;
+    KmlLoadJob job(path, options);
+
+    std::vector<KmlPlacemark> batch;
+    size_t total = 0;
+    size_t batches = 0;
+    while (!job.IsDone()) {
+        if (!job.TakeBatch(batch)) {
+            std::this_thread::yield();
+            continue;
+        }
+        EXPECT_LE(batch.size(), options.batch_size);
+        EXPECT_EQ(batch.front().name, "p" + std::to_string(total));
+        total += batch.size();
+        ++batches;
+    }
+    EXPECT_TRUE(job.GetError().empty()) << job.GetError();
+    EXPECT_EQ(total, 1000u);
+    EXPECT_GE(batches, 1000u / options.batch_size);
+    EXPECT_EQ(job.GetPlacemarkCount(), 1000u);
+    EXPECT_EQ(job.GetBytesRead(), document.size());
+    EXPECT_EQ(job.GetTotalBytes(), document.size());
+}
+
+TEST_F(KmlLoadJobTest, ReportsUnreadableFiles) {
+    KmlLoadJob missing((directory_ / "missing.kml").string());
+    KmlLoadJob malformed(WriteFile("bad.kml", "<kml><Document></kml>"));
+    for (KmlLoadJob* job : {&missing, &malformed}) {
+        while (!job->IsDone()) {
+            std::this_thread::yield();
+        }
+        EXPECT_FALSE(job->GetError().empty());
+    }
+}
+
+TEST_F(KmlLoadJobTest, CancelStopsABlockedReader) {
+    std::string document = "<kml>";
+    for (int i = 0; i < 100; ++i) {
+        document += "<Placemark><Point><coordinates>1,2</coordinates></Point></Placemark>";
+    }
+    document += "</kml>";
+
+    KmlLoadOptions options;
+    options.batch_size = 1;
+    options.max_queued_batches = 1;
+    auto job = std::make_unique<KmlLoadJob>(WriteFile("many.kml", document), options);
+    std::vector<KmlPlacemark> batch;
+    while (!job->TakeBatch(batch)) {
+        std::this_thread::yield();
+    }
+    job->Cancel();
+    job.reset();  // Joins the reader blocked on the full queue
+}
+
+} // namespace
+} // namespace earth_map
@@ -0,0 +1,200 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#include <earth_map/data/srtm_stream_decoder.h>
+#include <earth_map/data/hgt_parser.h>
+#include <earth_map/data/tile_compression.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace earth_map {
+namespace {
+
+/// SRTM3 tile as stored in an HGT file (big-endian), with a few voids
+std::vector<uint8_t> CreateHGT() {
+    constexpr size_t samples = 1201;
+    std::vector<uint8_t> data(samples * samples * 2);
+    for (size_t y = 0; y < samples; ++y) {
+        for (size_t x = 0; x < samples; ++x) {
+            const size_t i = y * samples + x;
+            const int16_t elevation =
+                (i % 50007 == 0) ? int16_t{-32768} : static_cast<int16_t>(800 + y / 3 + x / 5);
+            data[i * 2] = static_cast<uint8_t>((elevation >> 8) & 0xFF);
+            data[i * 2 + 1] = static_cast<uint8_t>(elevation & 0xFF);
+        }
+    }
+    return data;
+}
+
+uint32_t Crc32(std::span<const uint8_t> data) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (const uint8_t byte : data) {
+        crc ^= byte;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+void PutLE(std::vector<uint8_t>& out, uint32_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+/// Zip archive holding one entry (local header, data, then a stand-in for
+/// the central directory, which the decoder never reads)
+std::vector<uint8_t> CreateZip(std::span<const uint8_t> entry_data, uint16_t method,
+                               uint32_t crc, uint32_t uncompressed_size,
+                               bool data_descriptor = false) {
+    const std::string name = "N37W122.hgt";
+    std::vector<uint8_t> zip = {'P', 'K', 0x03, 0x04};
+    PutLE(zip, 20, 2);                                      // Version needed
+    PutLE(zip, data_descriptor ? 1u << 3 : 0u, 2);          // Flags
+    PutLE(zip, method, 2);
+    PutLE(zip, 0, 4);                                       // Time and date
+    PutLE(zip, data_descriptor ? 0 : crc, 4);
+    PutLE(zip, data_descriptor ? 0 : static_cast<uint32_t>(entry_data.size()), 4);
+    PutLE(zip, data_descriptor ? 0 : uncompressed_size, 4);
+    PutLE(zip, static_cast<uint32_t>(name.size()), 2);
+    PutLE(zip, 4, 2);                                       // Extra field length
+    zip.insert(zip.end(), name.begin(), name.end());
+    PutLE(zip, 0xCAFE, 4);                                  // Extra field
+    zip.insert(zip.end(), entry_data.begin(), entry_data.end());
+    const uint8_t trailer[] = {'P', 'K', 0x01, 0x02, 0xDE, 0xAD, 0xBE, 0xEF};
+    zip.insert(zip.end(), std::begin(trailer), std::end(trailer));
+    return zip;
+}
+
+/// Feed a body in chunks of varying size, as a download would
+std::unique_ptr<SRTMTileData> Decode(SRTMStreamDecoder& decoder, std::span<const uint8_t> body) {
+    size_t offset = 0;
+    for (size_t chunk = 1; offset < body.size(); chunk = chunk * 7 % 16381 + 1) {
+        const size_t size = std::min(chunk, body.size() - offset);
+        if (!decoder.Write(body.subspan(offset, size))) {
+            break;
+        }
+        offset += size;
+    }
+    return decoder.Finish();
+}
+
+void ExpectSameTile(const SRTMTileData* actual, const SRTMTileData& expected) {
+    ASSERT_NE(actual, nullptr);
+    EXPECT_TRUE(actual->IsValid());
+    EXPECT_EQ(actual->GetMetadata().coordinates, expected.GetMetadata().coordinates);
+    EXPECT_EQ(actual->GetMetadata().samples_per_side, expected.GetMetadata().samples_per_side);
+    EXPECT_EQ(actual->GetMetadata().has_voids, expected.GetMetadata().has_voids);
+    EXPECT_TRUE(std::equal(actual->GetSamples().begin(), actual->GetSamples().end(),
+                           expected.GetSamples().begin(), expected.GetSamples().end()));
+}
+
+class SRTMStreamDecoderTest : public ::testing::Test {
+protected:
+    const SRTMCoordinates coords_{37, -122};
+    const std::vector<uint8_t> hgt_ = CreateHGT();
+    const std::unique_ptr<SRTMTileData> expected_ = HGTParser::Parse(hgt_, coords_);
+};
+
+TEST_F(SRTMStreamDecoderTest, PlainBodyMatchesParse) {
+    ASSERT_NE(expected_, nullptr);
+    ASSERT_TRUE(expected_->GetMetadata().has_voids);
+
+    SRTMStreamDecoder decoder(coords_);
+    const auto tile = Decode(decoder, hgt_);
+    ExpectSameTile(tile.get(), *expected_);
+    EXPECT_EQ(decoder.GetBytesReceived(), hgt_.size());
+    EXPECT_TRUE(decoder.GetError().empty());
+
+    // Expecting SRTM1 sizes the buffer down at the end
+    SRTMStreamDecoder srtm1_decoder(coords_, SRTMResolution::SRTM1);
+    ExpectSameTile(Decode(srtm1_decoder, hgt_).get(), *expected_);
+}
+
+TEST_F(SRTMStreamDecoderTest, StoredZipEntry) {
+    const auto zip = CreateZip(hgt_, 0, Crc32(hgt_), static_cast<uint32_t>(hgt_.size()));
+    SRTMStreamDecoder decoder(coords_);
+    ExpectSameTile(Decode(decoder, zip).get(), *expected_);
+}
+
+TEST_F(SRTMStreamDecoderTest, CompressedBodies) {
+    if (!SRTMStreamDecoder::SupportsCompression()) {
+        SRTMStreamDecoder decoder(coords_);
+        EXPECT_EQ(Decode(decoder, std::vector<uint8_t>{0x1F, 0x8B, 8, 0, 0, 0}), nullptr);
+        EXPECT_FALSE(decoder.GetError().empty());
+        GTEST_SKIP() << "zlib not built in";
+    }
+
+    const auto gzip = CompressTileData(hgt_, TileMetadata::Compression::GZIP);
+    ASSERT_TRUE(gzip.has_value());
+    EXPECT_LT(gzip->size() * 3, hgt_.size());  // What the download saves
+    {
+        SRTMStreamDecoder decoder(coords_);
+        ExpectSameTile(Decode(decoder, *gzip).get(), *expected_);
+        EXPECT_EQ(decoder.GetBytesReceived(), gzip->size());
+    }
+
+    // A zip entry holds the raw deflate data of the gzip member (between
+    // its 10-byte header and 8-byte trailer)
+    const std::span<const uint8_t> deflated(gzip->data() + 10, gzip->size() - 18);
+    const uint32_t crc = Crc32(hgt_);
+    for (const bool data_descriptor : {false, true}) {
+        const auto zip = CreateZip(deflated, 8, crc, static_cast<uint32_t>(hgt_.size()),
+                                   data_descriptor);
+        SRTMStreamDecoder decoder(coords_);
+        ExpectSameTile(Decode(decoder, zip).get(), *expected_);
+    }
+
+    // Checksums are verified
+    const auto corrupt = CreateZip(deflated, 8, crc ^ 1, static_cast<uint32_t>(hgt_.size()));
+    SRTMStreamDecoder decoder(coords_);
+    EXPECT_EQ(Decode(decoder, corrupt), nullptr);
+    EXPECT_NE(decoder.GetError().find("checksum"), std::string::npos);
+
+    // Truncated streams are rejected
+    SRTMStreamDecoder truncated(coords_);
+    EXPECT_EQ(Decode(truncated, std::span<const uint8_t>(*gzip).first(gzip->size() / 2)),
+              nullptr);
+    EXPECT_NE(truncated.GetError().find("truncated"), std::string::npos);
+}
+
+TEST_F(SRTMStreamDecoderTest, RejectsMalformedBodies) {
+    // Not a tile size
+    SRTMStreamDecoder short_body(coords_);
+    EXPECT_EQ(Decode(short_body, std::span<const uint8_t>(hgt_).first(1000)), nullptr);
+    EXPECT_FALSE(short_body.GetError().empty());
+
+    SRTMStreamDecoder tiny_body(coords_);
+    EXPECT_EQ(Decode(tiny_body, std::vector<uint8_t>{'<', 'h'}), nullptr);
+
+    // Larger than any tile: stops while downloading
+    std::vector<uint8_t> huge(GetExpectedFileSize(SRTMResolution::SRTM1) + 2, 0);
+    SRTMStreamDecoder huge_body(coords_);
+    EXPECT_FALSE(huge_body.Write(huge));
+    EXPECT_EQ(huge_body.Finish(), nullptr);
+
+    // Stored entry with a bad checksum, truncated, or of the wrong size
+    const uint32_t size = static_cast<uint32_t>(hgt_.size());
+    if (SRTMStreamDecoder::SupportsCompression()) {
+        SRTMStreamDecoder bad_crc(coords_);
+        EXPECT_EQ(Decode(bad_crc, CreateZip(hgt_, 0, Crc32(hgt_) + 1, size)), nullptr);
+    }
+    SRTMStreamDecoder truncated(coords_);
+    EXPECT_EQ(Decode(truncated, CreateZip(std::span<const uint8_t>(hgt_).first(size / 2), 0,
+                                          Crc32(hgt_), size)),
+              nullptr);
+    SRTMStreamDecoder wrong_size(coords_);
+    EXPECT_EQ(Decode(wrong_size, CreateZip(hgt_, 0, Crc32(hgt_), 12345)), nullptr);
+
+    // Unsupported method (bzip2)
+    SRTMStreamDecoder bzip2(coords_);
+    EXPECT_EQ(Decode(bzip2, CreateZip(hgt_, 12, Crc32(hgt_), size)), nullptr);
+    EXPECT_NE(bzip2.GetError().find("method"), std::string::npos);
+}
+
+} // anonymous namespace
+} // namespace earth_map
@@ -0,0 +1,207 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#include <earth_map/data/terrain_ray_caster.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace earth_map {
+namespace {
+
+using namespace coordinates;
+
+/// SRTM3 tile N45E007 with a 2 km Gaussian peak (sigma 100 samples, about
+/// 9 km) at its center over a 200 m plain, plus a void in one corner
+std::shared_ptr<const SRTMTileData> CreateMountainTile() {
+    const SRTMMetadata metadata(SRTMCoordinates{45, 7}, SRTMResolution::SRTM3);
+    const size_t samples = metadata.samples_per_side;
+    std::vector<int16_t> data(samples * samples);
+    for (size_t y = 0; y < samples; ++y) {
+        for (size_t x = 0; x < samples; ++x) {
+            const double dx = static_cast<double>(x) - 600.0;
+            const double dy = static_cast<double>(y) - 600.0;
+            data[y * samples + x] = static_cast<int16_t>(
+                std::lround(200.0 + 2000.0 * std::exp(-(dx * dx + dy * dy) / (100.0 * 100.0))));
+        }
+    }
+    data[0] = -32768;
+    auto tile = std::make_shared<SRTMTileData>(metadata, std::move(data));
+    tile->SetValid(true);
+    return tile;
+}
+
+/// World position (CoordinateMapper axes) of a point, in meters
+glm::dvec3 ToWorld(const Geographic& point, double radius = 6371008.8) {
+    const double lat = point.latitude * M_PI / 180.0;
+    const double lon = point.longitude * M_PI / 180.0;
+    const double r = radius + point.altitude;
+    return glm::dvec3(r * std::cos(lat) * std::sin(lon), r * std::sin(lat),
+                      r * std::cos(lat) * std::cos(lon));
+}
+
+class TerrainRayCasterTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        tile_ = CreateMountainTile();
+        pyramid_ = std::make_shared<ElevationMinMaxPyramid>(tile_);
+    }
+
+    std::shared_ptr<const SRTMTileData> tile_;
+    std::shared_ptr<const ElevationMinMaxPyramid> pyramid_;
+};
+
+TEST_F(TerrainRayCasterTest, PyramidRangesBoundTheSamples) {
+    EXPECT_EQ(pyramid_->GetLevelCount(), 12u);  // 1200 cells -> one 2048-cell block
+    EXPECT_FLOAT_EQ(pyramid_->GetRange().first, 0.0f);  // The void
+    EXPECT_FLOAT_EQ(pyramid_->GetRange().second, 2200.0f);
+    EXPECT_GT(pyramid_->GetMemoryUsage(), 300u * 300u * 4u);
+    EXPECT_LT(pyramid_->GetMemoryUsage(), 1201u * 1201u * 2u / 4u);
+
+    // Every range covers the samples under its region, at every scale
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> fraction(0.0, 1.0);
+    std::uniform_real_distribution<double> extent(0.0, 0.3);
+    const auto samples = tile_->GetSamples();
+    for (int i = 0; i < 200; ++i) {
+        const double lat_min = fraction(rng);
+        const double lon_min = fraction(rng);
+        const double size = std::pow(extent(rng), 2.0);
+        const double lat_max = std::min(1.0, lat_min + size);
+        const double lon_max = std::min(1.0, lon_min + size);
+        const auto [low, high] = pyramid_->QueryRange(lat_min, lat_max, lon_min, lon_max);
+
+        const auto x0 = static_cast<size_t>(std::ceil(lon_min * 1200.0));
+        const auto x1 = static_cast<size_t>(std::floor(lon_max * 1200.0));
+        const auto y0 = static_cast<size_t>(std::ceil((1.0 - lat_max) * 1200.0));
+        const auto y1 = static_cast<size_t>(std::floor((1.0 - lat_min) * 1200.0));
+        for (size_t y = y0; y <= y1; ++y) {
+            for (size_t x = x0; x <= x1; ++x) {
+                const int16_t value = samples[y * 1201 + x];
+                EXPECT_LE(low, value == -32768 ? 0 : value);
+                EXPECT_GE(high, value == -32768 ? 0 : value);
+            }
+        }
+    }
+
+    // Small regions read fine levels, not the whole tile
+    const auto [low, high] = pyramid_->QueryRange(0.9, 0.901, 0.9, 0.901);
+    EXPECT_FLOAT_EQ(low, 200.0f);
+    EXPECT_FLOAT_EQ(high, 200.0f);
+}
+
+TEST_F(TerrainRayCasterTest, PicksTerrainBelowTheCamera) {
+    const TerrainRayCaster caster({pyramid_});
+    ASSERT_EQ(caster.GetTileCount(), 1u);
+
+    // Straight down onto the peak, in normalized globe units
+    const Geographic peak(45.5, 7.5, 0.0);
+    const glm::dvec3 above = ToWorld(Geographic(45.5, 7.5, 50000.0)) / 6371008.8;
+    const auto hit = caster.Intersect(above, -above, 1.0);
+    ASSERT_TRUE(hit.has_value());
+    EXPECT_NEAR(hit->position.latitude, peak.latitude, 1e-9);
+    EXPECT_NEAR(hit->position.longitude, peak.longitude, 1e-9);
+    EXPECT_NEAR(hit->position.altitude, 2200.0, 0.01);
+    EXPECT_NEAR(hit->distance * glm::length(above) * 6371008.8, 50000.0 - 2200.0, 0.01);
+
+    // Off the tile the terrain is the missing elevation (sea level)
+    const glm::dvec3 sea = ToWorld(Geographic(40.0, 0.0, 1000.0));
+    const auto sea_hit = caster.Intersect(sea, -sea, 6371008.8);
+    ASSERT_TRUE(sea_hit.has_value());
+    EXPECT_NEAR(sea_hit->position.altitude, 0.0, 1e-6);
+    EXPECT_NEAR(sea_hit->distance, 1000.0 / (6371008.8 + 1000.0), 1e-9);
+
+    // Rays pointing away from the globe miss
+    EXPECT_FALSE(caster.Intersect(above, above, 1.0).has_value());
+}
+
+TEST_F(TerrainRayCasterTest, SlantedRaysMatchRayMarching) {
+    const TerrainRayCaster caster({pyramid_});
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> offset(-0.2, 0.2);
+    std::uniform_real_distribution<double> altitude(2500.0, 6000.0);
+
+    for (int i = 0; i < 20; ++i) {
+        // From above a point near the peak toward a point on the plain
+        const glm::dvec3 origin =
+            ToWorld(Geographic(45.5 + offset(rng), 7.5 + offset(rng), altitude(rng)));
+        const glm::dvec3 target = ToWorld(Geographic(45.5 + offset(rng), 7.5 + offset(rng), 0.0));
+        const glm::dvec3 direction = glm::normalize(target - origin);
+        const auto hit = caster.Intersect(origin, direction, 6371008.8);
+        ASSERT_TRUE(hit.has_value());
+
+        // Reference: march 1 m steps until the ray is below the terrain
+        double marched = 0.0;
+        for (double t = 0.0; t < 100000.0; t += 1.0) {
+            const glm::dvec3 p = origin + direction * t;
+            const double length = glm::length(p);
+            const double lat = std::asin(p.y / length) * 180.0 / M_PI;
+            const double lon = std::atan2(p.x, p.z) * 180.0 / M_PI;
+            if (length - 6371008.8 <= caster.GetElevation(lat, lon)) {
+                marched = t;
+                break;
+            }
+        }
+        EXPECT_NEAR(hit->distance, marched, 1.0) << "ray " << i;
+        EXPECT_NEAR(hit->position.altitude,
+                    caster.GetElevation(hit->position.latitude, hit->position.longitude), 0.1);
+    }
+}
+
+TEST_F(TerrainRayCasterTest, LineOfSightAcrossTheMountain) {
+    TerrainRayCasterConfig config;
+    config.refraction_coefficient = 0.0;
+    const TerrainRayCaster caster({pyramid_}, config);
+
+    // Observers 800 m above the plain, 30 - 50 km apart around the peak
+    const Geographic west(45.5, 7.2, 1000.0);
+    const Geographic east(45.5, 7.8, 1000.0);
+    const Geographic north(45.8, 7.5, 1000.0);
+    const Geographic south(45.2, 7.5, 1000.0);
+    EXPECT_FALSE(caster.LineOfSight(west, east));
+    EXPECT_FALSE(caster.LineOfSight(east, west));
+    EXPECT_TRUE(caster.LineOfSight(west, north));
+    EXPECT_TRUE(caster.LineOfSight(west, Geographic(45.5, 7.5, 3000.0)));  // Above the peak
+
+    // A point on the mountainside sees down the slope
+    const float slope = caster.GetElevation(45.5, 7.45);
+    EXPECT_TRUE(caster.LineOfSight(Geographic(45.5, 7.45, slope), west));
+    EXPECT_FALSE(caster.LineOfSight(Geographic(45.5, 7.45, slope), east));
+
+    const std::vector<SightLine> lines = {{west, east}, {west, north}, {north, south}};
+    const std::vector<uint8_t> visible = caster.LineOfSight(lines);
+    ASSERT_EQ(visible.size(), 3u);
+    EXPECT_EQ(visible[0], 0);
+    EXPECT_EQ(visible[1], 1);
+    EXPECT_EQ(visible[2], 0);
+}
+
+TEST_F(TerrainRayCasterTest, LineOfSightFollowsTheEarthsCurvature) {
+    // 20 km over sea level, outside any tile
+    TerrainRayCasterConfig config;
+    config.refraction_coefficient = 0.0;
+    const TerrainRayCaster caster({}, config);
+    EXPECT_FALSE(caster.LineOfSight(Geographic(0.0, 0.0, 2.0), Geographic(0.18, 0.0, 2.0)));
+    EXPECT_TRUE(caster.LineOfSight(Geographic(0.0, 0.0, 10.0), Geographic(0.18, 0.0, 10.0)));
+
+    // Masts 2 m high see each other 2 x sqrt(2 R h / (1 - k)) apart:
+    // 10.1 km without refraction, 14.3 km with k = 0.5
+    EXPECT_FALSE(caster.LineOfSight(Geographic(0.0, 0.0, 2.0), Geographic(0.12, 0.0, 2.0)));
+    config.refraction_coefficient = 0.5;
+    const TerrainRayCaster refracted({}, config);
+    EXPECT_TRUE(refracted.LineOfSight(Geographic(0.0, 0.0, 2.0), Geographic(0.12, 0.0, 2.0)));
+    EXPECT_FALSE(refracted.LineOfSight(Geographic(0.0, 0.0, 2.0), Geographic(0.14, 0.0, 2.0)));
+}
+
+TEST_F(TerrainRayCasterTest, RejectsInvalidTiles) {
+    EXPECT_THROW(ElevationMinMaxPyramid(nullptr), std::invalid_argument);
+    auto invalid = std::make_shared<SRTMTileData>(
+        SRTMMetadata(SRTMCoordinates{0, 0}, SRTMResolution::SRTM3));
+    EXPECT_THROW(ElevationMinMaxPyramid{invalid}, std::invalid_argument);
+}
+
+} // namespace
+} // namespace earth_map
@@ -0,0 +1,283 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#include <earth_map/data/terrain_tile_provider.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+
+namespace earth_map {
+namespace {
+
+using namespace coordinates;
+
+void PutLE(std::vector<uint8_t>& out, uint32_t value, size_t bytes) {
+    for (size_t i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+void PutFloat(std::vector<uint8_t>& out, float value) {
+    uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    PutLE(out, bits, 4);
+}
+
+uint16_t ZigZag(int32_t value) {
+    return static_cast<uint16_t>((value << 1) ^ (value >> 31));
+}
+
+/// Quantized-mesh tile of a plane, 100 m in the south-west corner rising
+/// 60 m to the east and 20 m to the north (a 3x3 grid of vertices, so the
+/// decoder sees delta and high-water-mark encoding at work)
+std::vector<uint8_t> CreatePlaneMesh() {
+    std::vector<uint8_t> mesh(24, 0);  // Center
+    PutFloat(mesh, 100.0f);            // Minimum height
+    PutFloat(mesh, 180.0f);            // Maximum height
+    mesh.resize(88, 0);                // Bounding sphere, horizon occlusion point
+
+    // Two triangles per grid cell, in grid vertex numbers (row-major from the south)
+    std::vector<uint32_t> triangles;
+    for (uint32_t row = 0; row < 2; ++row) {
+        for (uint32_t column = 0; column < 2; ++column) {
+            const uint32_t sw = row * 3 + column;
+            triangles.insert(triangles.end(), {sw, sw + 1, sw + 4, sw, sw + 4, sw + 3});
+        }
+    }
+
+    // High-water-mark encoding numbers vertices in order of first use
+    std::vector<uint32_t> grid_vertex;
+    std::vector<uint32_t> indices;
+    for (const uint32_t vertex : triangles) {
+        const auto it = std::find(grid_vertex.begin(), grid_vertex.end(), vertex);
+        indices.push_back(static_cast<uint32_t>(it - grid_vertex.begin()));
+        if (it == grid_vertex.end()) {
+            grid_vertex.push_back(vertex);
+        }
+    }
+
+    std::vector<uint16_t> us, vs, hs;
+    for (const uint32_t vertex : grid_vertex) {
+        us.push_back(static_cast<uint16_t>(vertex % 3 * 32767 / 2));
+        vs.push_back(static_cast<uint16_t>(vertex / 3 * 32767 / 2));
+        // 60 * u + 20 * v of the 80 m above the minimum
+        hs.push_back(static_cast<uint16_t>(std::lround(
+            (60.0 * us.back() + 20.0 * vs.back()) / 80.0)));
+    }
+    PutLE(mesh, static_cast<uint32_t>(grid_vertex.size()), 4);
+    for (const auto* values : {&us, &vs, &hs}) {
+        int32_t previous = 0;
+        for (const uint16_t value : *values) {
+            PutLE(mesh, ZigZag(value - previous), 2);
+            previous = value;
+        }
+    }
+
+    PutLE(mesh, static_cast<uint32_t>(indices.size() / 3), 4);
+    uint32_t highest = 0;
+    for (const uint32_t index : indices) {
+        PutLE(mesh, highest - index, 2);
+        if (index == highest) {
+            ++highest;
+        }
+    }
+    return mesh;
+}
+
+/// Height of the plane mesh at a tile position (v from the north)
+double PlaneHeight(double u, double v) {
+    return 100.0 + 60.0 * u + 20.0 * (1.0 - v);
+}
+
+/// Local tile source serving the plane mesh for every tile
+class PlaneMeshProvider : public TileProvider {
+public:
+    std::string BuildTileURL(const TileCoordinates&) const override { return {}; }
+    std::string GetName() const override { return "terrain"; }
+    bool IsLocal() const override { return true; }
+
+    std::optional<TileBuffer> ReadTile(const TileCoordinates& coords) const override {
+        ++reads;
+        if (coords.x == missing_x) {
+            return std::nullopt;
+        }
+        return CreatePlaneMesh();
+    }
+
+    mutable std::atomic<int> reads{0};
+    int32_t missing_x = -1;
+};
+
+TEST(TerrainTileTest, LocatesTilesInBothSchemes) {
+    const auto mercator = LocateTerrainTile(TerrainTileEncoding::TERRAIN_RGB, 0.0, 0.0, 0);
+    EXPECT_EQ(mercator.tile, TileCoordinates(0, 0, 0));
+    EXPECT_NEAR(mercator.u, 0.5, 1e-12);
+    EXPECT_NEAR(mercator.v, 0.5, 1e-12);
+
+    // XYZ rows count from the north; latitudes clamp to the Mercator square
+    const auto north = LocateTerrainTile(TerrainTileEncoding::TERRAIN_RGB, 89.0, -180.0, 3);
+    EXPECT_EQ(north.tile, TileCoordinates(0, 0, 3));
+    EXPECT_NEAR(north.v, 0.0, 1e-9);
+
+    // Geographic TMS: two tiles at zoom 0, rows count from the south
+    const auto east = LocateTerrainTile(TerrainTileEncoding::QUANTIZED_MESH, 45.0, 90.0, 0);
+    EXPECT_EQ(east.tile, TileCoordinates(1, 0, 0));
+    EXPECT_NEAR(east.u, 0.5, 1e-12);
+    EXPECT_NEAR(east.v, 0.25, 1e-12);
+
+    const auto south = LocateTerrainTile(TerrainTileEncoding::QUANTIZED_MESH, -45.0, -180.0, 1);
+    EXPECT_EQ(south.tile, TileCoordinates(0, 0, 1));
+    EXPECT_NEAR(south.v, 0.5, 1e-12);
+    const auto northern = LocateTerrainTile(TerrainTileEncoding::QUANTIZED_MESH, 45.0, 179.9, 1);
+    EXPECT_EQ(northern.tile, TileCoordinates(3, 1, 1));
+}
+
+TEST(TerrainTileTest, DecodesTerrainRGB) {
+    // 0 m, 10 m, -10000 m, 100000 * 0.1 - 10000 + 0.1 m
+    const std::vector<uint8_t> rgba = {
+        0x01, 0x86, 0xA0, 0xFF,  0x01, 0x87, 0x04, 0xFF,
+        0x00, 0x00, 0x00, 0xFF,  0x01, 0x86, 0xA1, 0xFF,
+    };
+    const auto heightmap = DecodeTerrainRGB(TileCoordinates(1, 2, 3), rgba, 2, 2);
+    ASSERT_NE(heightmap, nullptr);
+    EXPECT_EQ(heightmap->GetCoordinates(), TileCoordinates(1, 2, 3));
+    EXPECT_NEAR(heightmap->GetHeights()[0], 0.0f, 1e-3);
+    EXPECT_NEAR(heightmap->GetHeights()[1], 10.0f, 1e-3);
+    EXPECT_NEAR(heightmap->GetHeights()[2], -10000.0f, 1e-3);
+    EXPECT_NEAR(heightmap->GetHeights()[3], 0.1f, 1e-3);
+
+    // Pixels are areas: their centers sit a quarter of the way in
+    EXPECT_NEAR(heightmap->Sample(0.25, 0.25), 0.0f, 1e-3);
+    EXPECT_NEAR(heightmap->Sample(0.0, 0.0), 0.0f, 1e-3);
+    EXPECT_NEAR(heightmap->Sample(0.5, 0.25), 5.0f, 1e-3);
+
+    EXPECT_EQ(DecodeTerrainRGB(TileCoordinates(), rgba, 3, 2), nullptr);
+}
+
+TEST(TerrainTileTest, RasterizesQuantizedMesh) {
+    const auto mesh = CreatePlaneMesh();
+    const auto heightmap = DecodeQuantizedMesh(TileCoordinates(0, 0, 0), mesh, 17);
+    ASSERT_NE(heightmap, nullptr);
+    EXPECT_EQ(heightmap->GetWidth(), 17u);
+    EXPECT_EQ(heightmap->GetHeight(), 17u);
+
+    for (const double u : {0.0, 0.3, 0.5, 0.77, 1.0}) {
+        for (const double v : {0.0, 0.1, 0.5, 0.9, 1.0}) {
+            EXPECT_NEAR(heightmap->Sample(u, v), PlaneHeight(u, v), 0.05) << u << ", " << v;
+        }
+    }
+}
+
+TEST(TerrainTileTest, RejectsMalformedMeshes) {
+    const auto mesh = CreatePlaneMesh();
+    EXPECT_EQ(DecodeQuantizedMesh(TileCoordinates(), std::span(mesh).first(100)), nullptr);
+    EXPECT_EQ(DecodeQuantizedMesh(TileCoordinates(), std::span(mesh).first(mesh.size() - 1)),
+              nullptr);
+    EXPECT_EQ(DecodeQuantizedMesh(TileCoordinates(), mesh, 1), nullptr);
+
+    // First index code must be 0 (high-water mark starts at vertex 0)
+    auto bad_index = mesh;
+    bad_index[bad_index.size() - 24 * 2] = 5;
+    EXPECT_EQ(DecodeQuantizedMesh(TileCoordinates(), bad_index), nullptr);
+}
+
+class TerrainTileProviderTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        tiles_ = std::make_shared<PlaneMeshProvider>();
+        loader_ = CreateTileLoader(TileLoaderConfig{});
+        ASSERT_TRUE(loader_->AddProvider(tiles_));
+
+        config_.encoding = TerrainTileEncoding::QUANTIZED_MESH;
+        config_.max_zoom = 4;
+        config_.tile_size = 32;
+        config_.decode_threads = 2;
+    }
+
+    std::shared_ptr<PlaneMeshProvider> tiles_;
+    std::shared_ptr<TileLoader> loader_;
+    TerrainTileProviderConfig config_;
+};
+
+TEST_F(TerrainTileProviderTest, QueriesThroughTileLoader) {
+    const auto provider = CreateTerrainTileElevationProvider(loader_, config_);
+
+    EXPECT_FALSE(provider->IsAvailable(37.5, -122.3));
+    const ElevationQuery query = provider->GetElevation(37.5, -122.3);
+    ASSERT_TRUE(query.valid);
+    const auto position = LocateTerrainTile(config_.encoding, 37.5, -122.3, 4);
+    EXPECT_NEAR(query.elevation_meters, PlaneHeight(position.u, position.v), 0.05);
+    EXPECT_EQ(query.source_tile, (SRTMCoordinates{37, -123}));
+    EXPECT_TRUE(provider->IsAvailable(37.5, -122.3));
+
+    // Batches fetch each tile once, and decoded tiles are reused
+    const std::vector<Geographic> points = {
+        Geographic(37.5, -122.3), Geographic(37.6, -122.2), Geographic(-33.9, 151.2),
+    };
+    const auto results = provider->GetElevations(points);
+    ASSERT_EQ(results.size(), points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        ASSERT_TRUE(results[i].valid);
+        const auto expected = LocateTerrainTile(config_.encoding, points[i].latitude,
+                                                points[i].longitude, 4);
+        EXPECT_NEAR(results[i].elevation_meters, PlaneHeight(expected.u, expected.v), 0.05);
+    }
+    EXPECT_EQ(tiles_->reads.load(), 2);
+    EXPECT_EQ(provider->GetLoaderStatistics().tiles_loaded, 2u);
+    EXPECT_EQ(provider->GetCacheStatistics().tile_count_memory, 2u);
+
+    // Coarse spacing reads a coarser zoom
+    const auto coarse = provider->GetElevations({Geographic(37.5, -122.3)}, 500000.0);
+    ASSERT_TRUE(coarse.front().valid);
+    EXPECT_EQ(tiles_->reads.load(), 3);
+
+    provider->ClearCache();
+    EXPECT_FALSE(provider->IsAvailable(37.5, -122.3));
+    EXPECT_EQ(provider->GetCacheStatistics().tile_count_memory, 0u);
+}
+
+TEST_F(TerrainTileProviderTest, ReportsMissingTiles) {
+    tiles_->missing_x = 0;
+    const auto provider = CreateTerrainTileElevationProvider(loader_, config_);
+    EXPECT_FALSE(provider->GetElevation(10.0, -179.9).valid);
+    EXPECT_TRUE(provider->GetElevation(10.0, 0.5).valid);
+    EXPECT_EQ(provider->GetLoaderStatistics().tiles_failed, 1u);
+}
+
+TEST_F(TerrainTileProviderTest, PreloadsRegions) {
+    config_.max_decoded_tiles = 3;
+    config_.preload_window = 1;
+    const auto provider = CreateTerrainTileElevationProvider(loader_, config_);
+
+    // 11.25° tiles at zoom 4: the region spans 2 x 2 of them
+    const GeographicBounds bounds(Geographic(12.0, 12.0), Geographic(30.0, 30.0));
+    const auto preload = provider->PreloadRegionAsync(bounds, Geographic(13.0, 13.0));
+    EXPECT_EQ(preload->GetTotalTiles(), 4u);
+    EXPECT_EQ(preload->Wait(), 4u);
+    EXPECT_TRUE(preload->IsDone());
+    EXPECT_EQ(preload->GetCompletedTiles(), 4u);
+
+    // One load at a time, nearest first: only the first one was evicted
+    EXPECT_FALSE(provider->IsAvailable(13.0, 13.0));
+    EXPECT_TRUE(provider->IsAvailable(28.0, 28.0));
+    EXPECT_EQ(provider->GetCacheStatistics().evictions, 1u);
+
+    EXPECT_EQ(provider->PreloadRegionAsync(GeographicBounds())->Wait(), 0u);
+}
+
+TEST_F(TerrainTileProviderTest, RequiresKnownProvider) {
+    config_.provider_name = "missing";
+    EXPECT_THROW(static_cast<void>(CreateTerrainTileElevationProvider(loader_, config_)),
+                 std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(CreateTerrainTileElevationProvider(nullptr)),
+                 std::invalid_argument);
+}
+
+} // anonymous namespace
+} // namespace earth_map
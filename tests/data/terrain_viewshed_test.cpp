@@ -0,0 +1,201 @@
+// Copyright (c) 2025 Earth Map Project
+// SPDX-License-Identifier: MIT
+
+#include <earth_map/data/terrain_viewshed.h>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace earth_map {
+namespace {
+
+using namespace coordinates;
+
+/// Flat grid of the configuration's size at @p height
+std::vector<float> FlatGrid(const ViewshedConfig& config, float height) {
+    const size_t size = 2 * GetViewshedRadiusCells(config) + 1;
+    return std::vector<float>(size * size, height);
+}
+
+/// Elevation = 500 m between 0.01° and 0.011° latitude, 0 m elsewhere
+class RidgeElevationProvider : public ElevationProvider {
+public:
+    ElevationQuery GetElevation(double latitude, double longitude) const override {
+        ElevationQuery query;
+        query.latitude = latitude;
+        query.longitude = longitude;
+        query.valid = true;
+        query.elevation_meters = latitude > 0.01 && latitude < 0.011 ? 500.0f : 0.0f;
+        return query;
+    }
+
+    std::vector<ElevationQuery> GetElevations(const std::vector<Geographic>& points) const override {
+        std::vector<ElevationQuery> results;
+        results.reserve(points.size());
+        for (const auto& point : points) {
+            results.push_back(GetElevation(point.latitude, point.longitude));
+        }
+        return results;
+    }
+
+    size_t PreloadRegion(const GeographicBounds& /*bounds*/) override { return 0; }
+    std::shared_ptr<ElevationPreload> PreloadRegionAsync(
+        const GeographicBounds& /*bounds*/,
+        const std::optional<Geographic>& /*focus*/) override {
+        return nullptr;
+    }
+    bool IsAvailable(double /*latitude*/, double /*longitude*/) const override { return true; }
+    ElevationCacheStats GetCacheStatistics() const override { return {}; }
+    SRTMLoaderStats GetLoaderStatistics() const override { return {}; }
+    void ClearCache() override {}
+};
+
+TEST(TerrainViewshedTest, FlatTerrainIsVisibleWithinRadius) {
+    ViewshedConfig config;
+    config.max_distance_meters = 3000.0;
+    config.cell_size_meters = 30.0;
+    config.earth_curvature = false;
+
+    const ViewshedRaster raster = ComputeViewshed(FlatGrid(config, 100.0f), Geographic(45.0, 7.0), config);
+    ASSERT_EQ(raster.GetRadiusCells(), 100u);
+    ASSERT_EQ(raster.GetSize(), 201u);
+
+    // Every sight line reaches every cell inside the circle exactly
+    size_t inside = 0;
+    for (uint32_t row = 0; row < raster.GetSize(); ++row) {
+        for (uint32_t column = 0; column < raster.GetSize(); ++column) {
+            const double dx = static_cast<double>(column) - 100.0;
+            const double dy = static_cast<double>(row) - 100.0;
+            const bool in_range = dx * dx + dy * dy <= 100.0 * 100.0;
+            inside += in_range ? 1 : 0;
+            EXPECT_EQ(raster.IsVisible(column, row), in_range) << column << ", " << row;
+        }
+    }
+    EXPECT_EQ(raster.CountVisible(), inside);
+    EXPECT_FALSE(raster.IsVisible(201, 0));
+}
+
+TEST(TerrainViewshedTest, RidgeHidesTerrainBehindIt) {
+    ViewshedConfig config;
+    config.max_distance_meters = 3000.0;
+    config.cell_size_meters = 30.0;
+    config.observer_height_meters = 10.0;
+    config.earth_curvature = false;
+
+    // A 50 m wall 20 cells east of the observer
+    const uint32_t size = 2 * GetViewshedRadiusCells(config) + 1;
+    std::vector<float> heights = FlatGrid(config, 0.0f);
+    for (uint32_t row = 0; row < size; ++row) {
+        heights[static_cast<size_t>(row) * size + 120] = 50.0f;
+    }
+
+    const ViewshedRaster raster = ComputeViewshed(heights, Geographic(0.0, 0.0), config);
+    EXPECT_TRUE(raster.IsVisible(110, 100));   // In front of the wall
+    EXPECT_TRUE(raster.IsVisible(120, 100));   // The wall itself
+    EXPECT_FALSE(raster.IsVisible(121, 100));  // Right behind it
+    EXPECT_FALSE(raster.IsVisible(190, 100));  // Far behind it
+    EXPECT_FALSE(raster.IsVisible(190, 130));
+    EXPECT_TRUE(raster.IsVisible(10, 100));    // Behind the observer
+
+    // The shadow deepens with distance: a sight line over the wall rises
+    // 40 m per 600 m, so 60 m targets clear it at 630 m but not at 1500 m
+    config.target_height_meters = 60.0;
+    const ViewshedRaster high = ComputeViewshed(heights, Geographic(0.0, 0.0), config);
+    EXPECT_TRUE(high.IsVisible(121, 100));
+    EXPECT_FALSE(high.IsVisible(150, 100));
+}
+
+TEST(TerrainViewshedTest, EarthCurvatureHidesTheHorizon) {
+    ViewshedConfig config;
+    config.max_distance_meters = 30000.0;
+    config.cell_size_meters = 100.0;
+    config.observer_height_meters = 10.0;
+    config.refraction_coefficient = 0.0;
+
+    // Horizon of a 10 m observer over a sea-level sphere: sqrt(2 R h) ≈ 11.3 km
+    const ViewshedRaster raster = ComputeViewshed(FlatGrid(config, 0.0f), Geographic(0.0, 0.0), config);
+    EXPECT_TRUE(raster.IsVisible(300 + 100, 300));
+    EXPECT_FALSE(raster.IsVisible(300 + 130, 300));
+    EXPECT_FALSE(raster.IsVisible(300, 300 - 200));
+
+    // Refraction bends sight lines over it: the horizon moves out to
+    // sqrt(2 R h / (1 - k)) ≈ 16 km for k = 0.5
+    config.refraction_coefficient = 0.5;
+    const ViewshedRaster refracted =
+        ComputeViewshed(FlatGrid(config, 0.0f), Geographic(0.0, 0.0), config);
+    EXPECT_TRUE(refracted.IsVisible(300 + 150, 300));
+    EXPECT_FALSE(refracted.IsVisible(300 + 170, 300));
+
+    config.earth_curvature = false;
+    const ViewshedRaster flat = ComputeViewshed(FlatGrid(config, 0.0f), Geographic(0.0, 0.0), config);
+    EXPECT_TRUE(flat.IsVisible(300 + 290, 300));
+}
+
+TEST(TerrainViewshedTest, ResultDoesNotDependOnThreads) {
+    ViewshedConfig config;
+    config.max_distance_meters = 6000.0;
+    config.cell_size_meters = 30.0;
+    std::vector<float> heights = FlatGrid(config, 0.0f);
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> noise(0.0f, 80.0f);
+    for (float& height : heights) {
+        height = noise(rng);
+    }
+
+    config.max_threads = 1;
+    const ViewshedRaster serial = ComputeViewshed(heights, Geographic(10.0, 10.0), config);
+    config.max_threads = 8;
+    const ViewshedRaster parallel = ComputeViewshed(heights, Geographic(10.0, 10.0), config);
+    ASSERT_EQ(serial.GetBits().size(), parallel.GetBits().size());
+    EXPECT_TRUE(std::equal(serial.GetBits().begin(), serial.GetBits().end(),
+                           parallel.GetBits().begin()));
+    EXPECT_GT(serial.CountVisible(), 0u);
+    EXPECT_LT(serial.CountVisible(), heights.size());
+}
+
+TEST(TerrainViewshedTest, SamplesElevationProvider) {
+    ViewshedConfig config;
+    config.max_distance_meters = 3000.0;
+    config.cell_size_meters = 30.0;
+
+    // The ridge runs east-west 1.1 - 1.2 km north of the observer
+    RidgeElevationProvider provider;
+    const ViewshedRaster raster = ComputeViewshed(provider, Geographic(0.0, 0.0), config);
+    EXPECT_TRUE(raster.IsVisibleAt(0.005, 0.0));
+    EXPECT_TRUE(raster.IsVisibleAt(0.01004, 0.0));  // Its near edge
+    EXPECT_FALSE(raster.IsVisibleAt(0.02, 0.0));
+    EXPECT_FALSE(raster.IsVisibleAt(0.02, 0.005));
+    EXPECT_TRUE(raster.IsVisibleAt(-0.02, 0.0));
+    EXPECT_FALSE(raster.IsVisibleAt(0.0, 0.05));  // Beyond the raster
+
+    // Cell centers map back to their cells
+    uint32_t column = 0;
+    uint32_t row = 0;
+    const Geographic center = raster.GetCellCenter(37, 150);
+    ASSERT_TRUE(raster.FindCell(center.latitude, center.longitude, column, row));
+    EXPECT_EQ(column, 37u);
+    EXPECT_EQ(row, 150u);
+    EXPECT_NEAR(raster.GetCellCenter(100, 0).latitude, 3000.0 / 110574.0, 1e-6);
+}
+
+TEST(TerrainViewshedTest, RejectsInvalidConfigurations) {
+    ViewshedConfig config;
+    config.cell_size_meters = 0.0;
+    EXPECT_THROW((void)GetViewshedRadiusCells(config), std::invalid_argument);
+
+    config.cell_size_meters = 1.0;
+    config.max_distance_meters = 1e6;
+    EXPECT_THROW((void)GetViewshedRadiusCells(config), std::invalid_argument);
+
+    config.max_distance_meters = 300.0;
+    const std::vector<float> heights(10, 0.0f);
+    EXPECT_THROW((void)ComputeViewshed(heights, Geographic(0.0, 0.0), config),
+                 std::invalid_argument);
+}
+
+} // namespace
+} // namespace earth_map
@@ -0,0 +1,203 @@
+#pragma once
+
+/**
+ * @file benchmark_datasets.h
+ * @brief Deterministic synthetic inputs for the earth_map benchmarks
+ *
+ * Every generator takes a seed, so runs compare the same data.
+ */
+
+#include <earth_map/coordinates/coordinate_spaces.h>
+#include <earth_map/math/tile_mathematics.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace earth_map::tests {
+
+/// Dataset sizes the point-based benchmarks sweep
+inline constexpr std::int64_t kSmallDataset = 1 << 10;
+inline constexpr std::int64_t kLargeDataset = 1 << 16;
+
+/// Most threads the contention benchmarks use
+inline int MaxBenchmarkThreads() {
+    return static_cast<int>(std::max(2u, std::min(8u, std::thread::hardware_concurrency())));
+}
+
+/**
+ * @brief Points uniformly spread over the Web Mercator latitude range
+ */
+inline std::vector<coordinates::Geographic> RandomGeographicPoints(std::size_t count,
+                                                                   std::uint32_t seed = 1) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> latitude(-85.0, 85.0);
+    std::uniform_real_distribution<double> longitude(-180.0, 180.0);
+    std::vector<coordinates::Geographic> points;
+    points.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        points.emplace_back(latitude(rng), longitude(rng));
+    }
+    return points;
+}
+
+/**
+ * @brief Distinct tiles at one zoom level, clustered like a viewed region
+ */
+inline std::vector<TileCoordinates> RandomTiles(std::size_t count, std::int32_t zoom,
+                                                std::uint32_t seed = 1) {
+    std::mt19937 rng(seed);
+    const std::int32_t tiles = 1 << zoom;
+    const std::int32_t span = std::max(1, std::min(tiles, static_cast<std::int32_t>(
+        2 * std::sqrt(static_cast<double>(count)) + 1)));
+    std::uniform_int_distribution<std::int32_t> origin(0, tiles - span);
+    const std::int32_t x0 = origin(rng);
+    const std::int32_t y0 = origin(rng);
+    std::uniform_int_distribution<std::int32_t> offset(0, span - 1);
+
+    std::vector<TileCoordinates> result;
+    std::vector<bool> taken(static_cast<std::size_t>(span) * span, false);
+    const std::size_t wanted = std::min(count, taken.size());
+    while (result.size() < wanted) {
+        const std::int32_t dx = offset(rng);
+        const std::int32_t dy = offset(rng);
+        const std::size_t cell = static_cast<std::size_t>(dy) * span + dx;
+        if (!taken[cell]) {
+            taken[cell] = true;
+            result.emplace_back(x0 + dx, y0 + dy, zoom);
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief Big-endian HGT file contents with rolling terrain
+ *
+ * @param samples_per_side 1201 (SRTM3) or 3601 (SRTM1)
+ */
+inline std::vector<std::uint8_t> SyntheticHgt(std::size_t samples_per_side) {
+    std::vector<std::uint8_t> data(samples_per_side * samples_per_side * 2);
+    for (std::size_t y = 0; y < samples_per_side; ++y) {
+        for (std::size_t x = 0; x < samples_per_side; ++x) {
+            const auto elevation = static_cast<std::int16_t>(
+                1000.0 + 400.0 * std::sin(x * 0.01) * std::cos(y * 0.013) + (x ^ y) % 17);
+            const std::size_t i = (y * samples_per_side + x) * 2;
+            data[i] = static_cast<std::uint8_t>((elevation >> 8) & 0xFF);
+            data[i + 1] = static_cast<std::uint8_t>(elevation & 0xFF);
+        }
+    }
+    return data;
+}
+
+namespace detail {
+
+inline std::uint32_t PngCrc(const std::uint8_t* data, std::size_t size, std::uint32_t crc = 0) {
+    crc = ~crc;
+    for (std::size_t i = 0; i < size; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+inline void PutBigEndian32(std::vector<std::uint8_t>& out, std::uint32_t value) {
+    out.push_back(static_cast<std::uint8_t>(value >> 24));
+    out.push_back(static_cast<std::uint8_t>(value >> 16));
+    out.push_back(static_cast<std::uint8_t>(value >> 8));
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+inline void PutPngChunk(std::vector<std::uint8_t>& out, const char* type,
+                        const std::vector<std::uint8_t>& payload) {
+    PutBigEndian32(out, static_cast<std::uint32_t>(payload.size()));
+    const std::size_t type_offset = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), payload.begin(), payload.end());
+    PutBigEndian32(out, PngCrc(out.data() + type_offset, 4 + payload.size()));
+}
+
+} // namespace detail
+
+/**
+ * @brief RGBA PNG of a tile-like gradient
+ *
+ * The zlib stream uses stored deflate blocks, so no compressor is needed;
+ * decoding still runs the full PNG path (chunks, inflate, unfiltering).
+ */
+inline std::vector<std::uint8_t> SyntheticPng(std::uint32_t width, std::uint32_t height) {
+    std::vector<std::uint8_t> raw;
+    raw.reserve(static_cast<std::size_t>(height) * (width * 4 + 1));
+    for (std::uint32_t y = 0; y < height; ++y) {
+        raw.push_back(0);  // Filter: none
+        for (std::uint32_t x = 0; x < width; ++x) {
+            raw.push_back(static_cast<std::uint8_t>(x));
+            raw.push_back(static_cast<std::uint8_t>(y));
+            raw.push_back(static_cast<std::uint8_t>((x * 7) ^ (y * 3)));
+            raw.push_back(255);
+        }
+    }
+
+    std::vector<std::uint8_t> zlib = {0x78, 0x01};
+    for (std::size_t offset = 0; offset < raw.size();) {
+        const std::size_t length = std::min<std::size_t>(65535, raw.size() - offset);
+        zlib.push_back(offset + length == raw.size() ? 1 : 0);
+        zlib.push_back(static_cast<std::uint8_t>(length));
+        zlib.push_back(static_cast<std::uint8_t>(length >> 8));
+        zlib.push_back(static_cast<std::uint8_t>(~length));
+        zlib.push_back(static_cast<std::uint8_t>(~length >> 8));
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + length);
+        offset += length;
+    }
+    std::uint32_t a = 1;
+    std::uint32_t b = 0;
+    for (const std::uint8_t byte : raw) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    detail::PutBigEndian32(zlib, (b << 16) | a);
+
+    std::vector<std::uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    std::vector<std::uint8_t> header;
+    detail::PutBigEndian32(header, width);
+    detail::PutBigEndian32(header, height);
+    header.insert(header.end(), {8, 6, 0, 0, 0});  // 8-bit RGBA, no interlace
+    detail::PutPngChunk(png, "IHDR", header);
+    detail::PutPngChunk(png, "IDAT", zlib);
+    detail::PutPngChunk(png, "IEND", {});
+    return png;
+}
+
+/**
+ * @brief Scratch directory removed when the benchmark ends
+ */
+class ScratchDirectory {
+public:
+    explicit ScratchDirectory(const std::string& name)
+        : path_(std::filesystem::temp_directory_path() / name) {
+        std::filesystem::remove_all(path_);
+        std::filesystem::create_directories(path_);
+    }
+
+    ~ScratchDirectory() {
+        std::error_code error;
+        std::filesystem::remove_all(path_, error);
+    }
+
+    ScratchDirectory(const ScratchDirectory&) = delete;
+    ScratchDirectory& operator=(const ScratchDirectory&) = delete;
+
+    const std::filesystem::path& Path() const { return path_; }
+
+private:
+    std::filesystem::path path_;
+};
+
+} // namespace earth_map::tests
@@ -0,0 +1,23 @@
+/**
+ * @file benchmark_main.cpp
+ * @brief Entry point of earth_map_benchmarks
+ *
+ * Usage: earth_map_benchmarks [--benchmark_filter=<regex>]
+ *        [--benchmark_format=json --benchmark_out=<file>]
+ */
+
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+
+int main(int argc, char** argv) {
+    // Per-call info logs (mesh generation, cache setup) would swamp the timings
+    spdlog::set_level(spdlog::level::warn);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+/**
+ * @file camera_flight.h
+ * @brief Camera placement and flights as MapInteraction performs them, for
+ *        the replay and soak harnesses
+ */
+
+#include <earth_map/coordinates/coordinate_mapper.h>
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace earth_map::tests {
+
+inline constexpr double kEarthRadiusMeters = 6371000.0;
+
+/// Camera position above a location, as MapInteraction places it
+inline glm::vec3 CameraPositionAbove(double latitude, double longitude, double altitude) {
+    const glm::vec3 direction = coordinates::CoordinateMapper::GeographicToWorld(
+        coordinates::Geographic(latitude, longitude), 1.0f).Direction();
+    return direction * (1.0f + static_cast<float>(altitude / kEarthRadiusMeters));
+}
+
+/**
+ * @brief Camera flight along the great circle, easing in and out
+ */
+struct Flight {
+    glm::vec3 from{0.0f};
+    glm::vec3 to{0.0f};
+    double start = 0.0;
+    double duration = 0.0;
+
+    bool Done(double time) const { return time >= start + duration; }
+
+    glm::vec3 PositionAt(double time) const {
+        float s = duration > 0.0
+            ? static_cast<float>(std::clamp((time - start) / duration, 0.0, 1.0))
+            : 1.0f;
+        s = s * s * (3.0f - 2.0f * s);
+        const glm::vec3 a = glm::normalize(from);
+        const glm::vec3 b = glm::normalize(to);
+        const float angle = std::acos(std::clamp(glm::dot(a, b), -1.0f, 1.0f));
+        const glm::vec3 direction = std::sin(angle) < 1e-4f
+            ? (s < 0.5f ? a : b)
+            : (std::sin((1.0f - s) * angle) * a + std::sin(s * angle) * b) / std::sin(angle);
+        return direction * (glm::length(from) + s * (glm::length(to) - glm::length(from)));
+    }
+};
+
+} // namespace earth_map::tests
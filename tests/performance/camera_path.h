@@ -0,0 +1,237 @@
+#pragma once
+
+/**
+ * @file camera_path.h
+ * @brief Recorded camera trajectories for the streaming replay benchmark
+ *
+ * A path is a text file, one timed step per line ('#' starts a comment):
+ *
+ *   name <text>
+ *   screen <width> <height>
+ *   <seconds> input <type> <x> <y> <dx> <dy> <button> <key> <scroll_delta>
+ *   <seconds> view <latitude> <longitude> <altitude_m>
+ *   <seconds> fly_to <latitude> <longitude> <altitude_m> <duration_s>
+ *   <seconds> end
+ *
+ * input replays an InputEvent through CameraController::ProcessInput();
+ * <type> is the InputEvent::Type name (mouse_move, mouse_scroll, ...).
+ * view jumps like MapInteraction::SetCameraView() and fly_to flies like
+ * MapInteraction::FlyToLocation(). end marks the end of the recording.
+ * WriteCameraPath() writes the same format, so an application can record
+ * its input by collecting steps and saving them.
+ */
+
+#include <earth_map/renderer/camera.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace earth_map::tests {
+
+/**
+ * @brief One timed step of a camera path
+ */
+struct CameraPathStep {
+    enum class Kind : std::uint8_t {
+        INPUT,   ///< Replay input
+        VIEW,    ///< Jump to a location
+        FLY_TO,  ///< Fly to a location
+        END      ///< End of the recording
+    };
+
+    double time = 0.0;  ///< Seconds since the start of the path
+    Kind kind = Kind::END;
+    InputEvent input{};
+
+    double latitude = 0.0;   ///< VIEW and FLY_TO target
+    double longitude = 0.0;
+    double altitude = 0.0;   ///< Meters above the surface
+    double duration = 0.0;   ///< FLY_TO travel time in seconds
+};
+
+/**
+ * @brief Recorded camera trajectory
+ */
+struct CameraPath {
+    std::string name;
+    std::uint32_t screen_width = 1920;
+    std::uint32_t screen_height = 1080;
+    std::vector<CameraPathStep> steps;  ///< Sorted by time
+
+    /// Time of the last step in seconds
+    double Duration() const { return steps.empty() ? 0.0 : steps.back().time; }
+};
+
+namespace detail {
+
+inline constexpr std::array<std::pair<std::string_view, InputEvent::Type>, 10> kInputTypeNames = {{
+    {"mouse_move", InputEvent::Type::MOUSE_MOVE},
+    {"mouse_press", InputEvent::Type::MOUSE_BUTTON_PRESS},
+    {"mouse_release", InputEvent::Type::MOUSE_BUTTON_RELEASE},
+    {"mouse_scroll", InputEvent::Type::MOUSE_SCROLL},
+    {"key_press", InputEvent::Type::KEY_PRESS},
+    {"key_release", InputEvent::Type::KEY_RELEASE},
+    {"touch_start", InputEvent::Type::TOUCH_START},
+    {"touch_move", InputEvent::Type::TOUCH_MOVE},
+    {"touch_end", InputEvent::Type::TOUCH_END},
+    {"double_click", InputEvent::Type::DOUBLE_CLICK},
+}};
+
+inline std::optional<InputEvent::Type> ParseInputType(std::string_view name) {
+    for (const auto& [type_name, type] : kInputTypeNames) {
+        if (type_name == name) {
+            return type;
+        }
+    }
+    return std::nullopt;
+}
+
+inline std::string_view InputTypeName(InputEvent::Type type) {
+    for (const auto& [type_name, candidate] : kInputTypeNames) {
+        if (candidate == type) {
+            return type_name;
+        }
+    }
+    return "mouse_move";
+}
+
+} // namespace detail
+
+/**
+ * @brief Parse a camera path
+ *
+ * @param text Path file contents
+ * @param fallback_name Name used when the file has no name line
+ * @throws std::runtime_error on a malformed line
+ */
+inline CameraPath ParseCameraPath(const std::string& text, const std::string& fallback_name = "path") {
+    CameraPath path;
+    path.name = fallback_name;
+    std::istringstream lines(text);
+    std::string line;
+    int line_number = 0;
+    while (std::getline(lines, line)) {
+        ++line_number;
+        line = line.substr(0, line.find('#'));
+        std::istringstream fields(line);
+        std::string first;
+        if (!(fields >> first)) {
+            continue;
+        }
+        const auto fail = [&](const std::string& what) {
+            throw std::runtime_error("camera path line " + std::to_string(line_number) + ": " + what);
+        };
+
+        if (first == "name") {
+            std::getline(fields >> std::ws, path.name);
+            continue;
+        }
+        if (first == "screen") {
+            if (!(fields >> path.screen_width >> path.screen_height)) {
+                fail("expected screen <width> <height>");
+            }
+            continue;
+        }
+
+        CameraPathStep step;
+        std::string kind;
+        try {
+            step.time = std::stod(first);
+        } catch (const std::exception&) {
+            fail("expected a time");
+        }
+        fields >> kind;
+        if (kind == "input") {
+            std::string type;
+            fields >> type;
+            const auto parsed = detail::ParseInputType(type);
+            if (!parsed) {
+                fail("unknown input type '" + type + "'");
+            }
+            step.kind = CameraPathStep::Kind::INPUT;
+            step.input.type = *parsed;
+            if (!(fields >> step.input.x >> step.input.y >> step.input.dx >> step.input.dy >>
+                  step.input.button >> step.input.key >> step.input.scroll_delta)) {
+                fail("expected x y dx dy button key scroll_delta");
+            }
+            step.input.timestamp = static_cast<std::uint64_t>(step.time * 1000.0);
+        } else if (kind == "view") {
+            step.kind = CameraPathStep::Kind::VIEW;
+            if (!(fields >> step.latitude >> step.longitude >> step.altitude)) {
+                fail("expected latitude longitude altitude");
+            }
+        } else if (kind == "fly_to") {
+            step.kind = CameraPathStep::Kind::FLY_TO;
+            if (!(fields >> step.latitude >> step.longitude >> step.altitude >> step.duration)) {
+                fail("expected latitude longitude altitude duration");
+            }
+        } else if (kind == "end") {
+            step.kind = CameraPathStep::Kind::END;
+        } else {
+            fail("unknown step '" + kind + "'");
+        }
+        path.steps.push_back(step);
+    }
+    std::stable_sort(path.steps.begin(), path.steps.end(),
+                     [](const CameraPathStep& a, const CameraPathStep& b) { return a.time < b.time; });
+    return path;
+}
+
+/**
+ * @brief Load a camera path file
+ *
+ * @throws std::runtime_error if the file cannot be read or is malformed
+ */
+inline CameraPath LoadCameraPath(const std::string& file_path) {
+    std::ifstream file(file_path);
+    if (!file) {
+        throw std::runtime_error("cannot read camera path " + file_path);
+    }
+    std::ostringstream text;
+    text << file.rdbuf();
+    std::string stem = file_path.substr(file_path.find_last_of('/') + 1);
+    stem = stem.substr(0, stem.find('.'));
+    return ParseCameraPath(text.str(), stem);
+}
+
+/**
+ * @brief Write a camera path in the format ParseCameraPath() reads
+ */
+inline void WriteCameraPath(std::ostream& out, const CameraPath& path) {
+    out << "name " << path.name << "\n";
+    out << "screen " << path.screen_width << " " << path.screen_height << "\n";
+    for (const CameraPathStep& step : path.steps) {
+        out << step.time << " ";
+        switch (step.kind) {
+            case CameraPathStep::Kind::INPUT:
+                out << "input " << detail::InputTypeName(step.input.type) << " "
+                    << step.input.x << " " << step.input.y << " "
+                    << step.input.dx << " " << step.input.dy << " "
+                    << step.input.button << " " << step.input.key << " "
+                    << step.input.scroll_delta << "\n";
+                break;
+            case CameraPathStep::Kind::VIEW:
+                out << "view " << step.latitude << " " << step.longitude << " "
+                    << step.altitude << "\n";
+                break;
+            case CameraPathStep::Kind::FLY_TO:
+                out << "fly_to " << step.latitude << " " << step.longitude << " "
+                    << step.altitude << " " << step.duration << "\n";
+                break;
+            case CameraPathStep::Kind::END:
+                out << "end\n";
+                break;
+        }
+    }
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,271 @@
+/**
+ * @file data_benchmark.cpp
+ * @brief Tile cache contention, tile index queries and SRTM parsing/sampling
+ */
+
+#include "benchmark_datasets.h"
+
+#include <benchmark/benchmark.h>
+#include <earth_map/data/hgt_parser.h>
+#include <earth_map/data/tile_cache.h>
+#include <earth_map/data/tile_index.h>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <random>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+constexpr std::int32_t kIndexZoom = 12;
+constexpr std::size_t kTileBytes = 16 * 1024;
+
+TileData MakeTileData(const TileCoordinates& coordinates) {
+    std::vector<std::uint8_t> bytes(kTileBytes);
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<std::uint8_t>(i * 31 + coordinates.x + coordinates.y);
+    }
+    TileData tile;
+    tile.metadata.coordinates = coordinates;
+    tile.metadata.file_size = bytes.size();
+    tile.metadata.last_modified = std::chrono::system_clock::now();
+    tile.metadata.last_access = tile.metadata.last_modified;
+    tile.metadata.content_type = "image/png";
+    tile.data = std::move(bytes);
+    tile.width = 256;
+    tile.height = 256;
+    tile.channels = 4;
+    return tile;
+}
+
+/**
+ * @brief BasicTileCache holding range(0) tiles, shared by ThreadRange threads
+ *
+ * Thread 0 creates the cache in SetUp() and destroys it in TearDown(); the
+ * other threads touch it only inside the timing loop, which starts and
+ * ends with a barrier.
+ */
+class TileCacheFixture : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        if (state.thread_index() != 0) {
+            return;
+        }
+        directory_ = std::make_unique<ScratchDirectory>("earth_map_cache_benchmark");
+        TileCacheConfig config;
+        config.disk_cache_directory = (directory_->Path() / "tiles").string();
+        config.max_memory_cache_size = 1024 * 1024 * 1024;
+        config.max_tile_count = 1 << 20;
+        config.enable_compression = false;
+        cache_ = CreateTileCache(config);
+        cache_->Initialize(config);
+
+        tiles_ = RandomTiles(static_cast<std::size_t>(state.range(0)), kIndexZoom);
+        for (const TileCoordinates& tile : tiles_) {
+            cache_->Put(MakeTileData(tile));
+        }
+        cache_->Flush();
+    }
+
+    void TearDown(const benchmark::State& state) override {
+        if (state.thread_index() != 0) {
+            return;
+        }
+        cache_.reset();
+        directory_.reset();
+    }
+
+protected:
+    std::unique_ptr<ScratchDirectory> directory_;
+    std::unique_ptr<TileCache> cache_;
+    std::vector<TileCoordinates> tiles_;
+};
+
+/**
+ * @brief Linear quadtree TileIndex with range(0) tiles in one region
+ */
+class TileIndexFixture : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        tiles_ = RandomTiles(static_cast<std::size_t>(state.range(0)), kIndexZoom);
+        index_ = CreateTileIndex();
+        index_->Initialize(TileIndexConfig{});
+        for (const TileCoordinates& tile : tiles_) {
+            index_->Insert(tile);
+        }
+        index_->Rebuild();
+
+        // The middle of the region: about a quarter of the tiles
+        const auto [min_x, max_x] = std::minmax_element(
+            tiles_.begin(), tiles_.end(), [](const auto& a, const auto& b) { return a.x < b.x; });
+        const auto [min_y, max_y] = std::minmax_element(
+            tiles_.begin(), tiles_.end(), [](const auto& a, const auto& b) { return a.y < b.y; });
+        const std::int32_t span_x = max_x->x - min_x->x;
+        const std::int32_t span_y = max_y->y - min_y->y;
+        const BoundingBox2D north_west = TileMathematics::GetTileBounds(
+            TileCoordinates(min_x->x + span_x / 4, min_y->y + span_y / 4, kIndexZoom));
+        const BoundingBox2D south_east = TileMathematics::GetTileBounds(
+            TileCoordinates(min_x->x + 3 * span_x / 4, min_y->y + 3 * span_y / 4, kIndexZoom));
+        query_bounds_ = BoundingBox2D(glm::vec2(north_west.min.x, south_east.min.y),
+                                      glm::vec2(south_east.max.x, north_west.max.y));
+    }
+
+    void TearDown(const benchmark::State&) override {
+        index_.reset();
+    }
+
+protected:
+    std::vector<TileCoordinates> tiles_;
+    std::unique_ptr<TileIndex> index_;
+    BoundingBox2D query_bounds_;
+};
+
+/**
+ * @brief Parsed SRTM tile and range(0) random sample positions
+ */
+class SrtmFixture : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        if (state.thread_index() != 0) {
+            return;
+        }
+        if (!tile_) {
+            tile_ = HGTParser::Parse(SyntheticHgt(1201), SRTMCoordinates{37, -122});
+        }
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> fraction(0.0, 1.0);
+        const auto count = static_cast<std::size_t>(state.range(0));
+        lat_fractions_.resize(count);
+        lon_fractions_.resize(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            lat_fractions_[i] = fraction(rng);
+            lon_fractions_[i] = fraction(rng);
+        }
+    }
+
+protected:
+    std::unique_ptr<SRTMTileData> tile_;
+    std::vector<double> lat_fractions_;
+    std::vector<double> lon_fractions_;
+};
+
+} // namespace
+
+BENCHMARK_DEFINE_F(TileCacheFixture, Get)(benchmark::State& state) {
+    std::size_t next = static_cast<std::size_t>(state.thread_index()) * 7919;
+    std::size_t hits = 0;
+    for (auto _ : state) {
+        const std::optional<TileData> tile = cache_->Get(tiles_[next++ % tiles_.size()]);
+        hits += tile.has_value();
+        benchmark::DoNotOptimize(tile);
+    }
+    state.counters["hit_rate"] = benchmark::Counter(
+        static_cast<double>(hits), benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_REGISTER_F(TileCacheFixture, Get)
+    ->Arg(256)->Arg(4096)
+    ->ThreadRange(1, MaxBenchmarkThreads())
+    ->UseRealTime();
+
+/// One Put of an already cached tile every eight Gets, as while panning
+BENCHMARK_DEFINE_F(TileCacheFixture, GetPutMix)(benchmark::State& state) {
+    std::size_t next = static_cast<std::size_t>(state.thread_index()) * 7919;
+    std::optional<TileData> replacement;
+    for (auto _ : state) {
+        const TileCoordinates& coordinates = tiles_[next++ % tiles_.size()];
+        if (next % 8 == 0) {
+            if (!replacement) {
+                state.PauseTiming();
+                replacement = MakeTileData(coordinates);
+                state.ResumeTiming();
+            }
+            replacement->metadata.coordinates = coordinates;
+            benchmark::DoNotOptimize(cache_->Put(*replacement));
+        } else {
+            benchmark::DoNotOptimize(cache_->Get(coordinates));
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_REGISTER_F(TileCacheFixture, GetPutMix)
+    ->Arg(256)->Arg(4096)
+    ->ThreadRange(1, MaxBenchmarkThreads())
+    ->UseRealTime();
+
+BENCHMARK_DEFINE_F(TileIndexFixture, QueryBounds)(benchmark::State& state) {
+    std::size_t found = 0;
+    for (auto _ : state) {
+        const auto result = index_->Query(query_bounds_, kIndexZoom);
+        found = result.size();
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.counters["tiles"] = static_cast<double>(found);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(found));
+}
+BENCHMARK_REGISTER_F(TileIndexFixture, QueryBounds)->RangeMultiplier(8)->Range(1 << 9, 1 << 18);
+
+BENCHMARK_DEFINE_F(TileIndexFixture, GetTilesAtZoom)(benchmark::State& state) {
+    for (auto _ : state) {
+        const auto result = index_->GetTilesAtZoom(kIndexZoom);
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(tiles_.size()));
+}
+BENCHMARK_REGISTER_F(TileIndexFixture, GetTilesAtZoom)->RangeMultiplier(8)->Range(1 << 9, 1 << 18);
+
+BENCHMARK_DEFINE_F(TileIndexFixture, Contains)(benchmark::State& state) {
+    std::size_t next = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index_->Contains(tiles_[next++ % tiles_.size()]));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_REGISTER_F(TileIndexFixture, Contains)->RangeMultiplier(8)->Range(1 << 9, 1 << 18);
+
+/// HGTParser::Parse of an SRTM3 (1201) or SRTM1 (3601) tile, one per thread
+static void BM_HGTParserParse(benchmark::State& state) {
+    static const std::vector<std::uint8_t> srtm3 = SyntheticHgt(1201);
+    static const std::vector<std::uint8_t> srtm1 = SyntheticHgt(3601);
+    const std::vector<std::uint8_t>& data = state.range(0) == 1201 ? srtm3 : srtm1;
+    for (auto _ : state) {
+        auto tile = HGTParser::Parse(data, SRTMCoordinates{37, -122});
+        benchmark::DoNotOptimize(tile.get());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(data.size()));
+}
+BENCHMARK(BM_HGTParserParse)
+    ->Arg(1201)->Arg(3601)
+    ->ThreadRange(1, MaxBenchmarkThreads())
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_DEFINE_F(SrtmFixture, InterpolateElevation)(benchmark::State& state) {
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < lat_fractions_.size(); ++i) {
+            benchmark::DoNotOptimize(tile_->InterpolateElevation(lat_fractions_[i], lon_fractions_[i]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(lat_fractions_.size()));
+}
+BENCHMARK_REGISTER_F(SrtmFixture, InterpolateElevation)
+    ->Arg(kSmallDataset)->Arg(kLargeDataset)
+    ->ThreadRange(1, MaxBenchmarkThreads())
+    ->UseRealTime();
+
+BENCHMARK_DEFINE_F(SrtmFixture, InterpolateElevations)(benchmark::State& state) {
+    std::vector<float> elevations(lat_fractions_.size());
+    for (auto _ : state) {
+        tile_->InterpolateElevations(lat_fractions_, lon_fractions_, elevations);
+        benchmark::ClobberMemory();
+    }
+    state.counters["simd"] = SRTMTileData::IsBatchSimdAccelerated() ? 1.0 : 0.0;
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(elevations.size()));
+}
+BENCHMARK_REGISTER_F(SrtmFixture, InterpolateElevations)
+    ->Arg(kSmallDataset)->Arg(kLargeDataset);
+
+} // namespace earth_map::tests
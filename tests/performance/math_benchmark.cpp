@@ -0,0 +1,195 @@
+/**
+ * @file math_benchmark.cpp
+ * @brief TileMathematics and CoordinateMapper conversion throughput
+ */
+
+#include "benchmark_datasets.h"
+
+#include <benchmark/benchmark.h>
+#include <earth_map/coordinates/coordinate_mapper.h>
+#include <earth_map/math/tile_mathematics.h>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+using coordinates::CoordinateMapper;
+using coordinates::Geographic;
+using coordinates::World;
+
+/**
+ * @brief Random points, sized by the first benchmark argument
+ *
+ * Every thread runs SetUp(); thread 0 builds the points, and the others
+ * see them once the timing loop starts (a barrier). Multi-threaded
+ * benchmarks therefore read the points only inside the loop.
+ */
+class PointsFixture : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        if (state.thread_index() != 0) {
+            return;
+        }
+        points_ = RandomGeographicPoints(static_cast<std::size_t>(state.range(0)));
+        latitudes_.clear();
+        longitudes_.clear();
+        for (const Geographic& point : points_) {
+            latitudes_.push_back(point.latitude);
+            longitudes_.push_back(point.longitude);
+        }
+    }
+
+protected:
+    std::vector<Geographic> points_;
+    std::vector<double> latitudes_;
+    std::vector<double> longitudes_;
+};
+
+} // namespace
+
+BENCHMARK_DEFINE_F(PointsFixture, GeographicToTile)(benchmark::State& state) {
+    const auto zoom = static_cast<std::int32_t>(state.range(1));
+    for (auto _ : state) {
+        for (const Geographic& point : points_) {
+            benchmark::DoNotOptimize(TileMathematics::GeographicToTile(point, zoom));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(points_.size()));
+}
+BENCHMARK_REGISTER_F(PointsFixture, GeographicToTile)
+    ->ArgsProduct({{kSmallDataset, kLargeDataset}, {5, 18}})
+    ->ThreadRange(1, MaxBenchmarkThreads())
+    ->UseRealTime();
+
+BENCHMARK_DEFINE_F(PointsFixture, TileBoundsRoundTrip)(benchmark::State& state) {
+    const auto zoom = static_cast<std::int32_t>(state.range(1));
+    std::vector<TileCoordinates> tiles;
+    for (const Geographic& point : points_) {
+        tiles.push_back(TileMathematics::GeographicToTile(point, zoom));
+    }
+    for (auto _ : state) {
+        for (const TileCoordinates& tile : tiles) {
+            benchmark::DoNotOptimize(TileMathematics::GetTileBounds(tile));
+            benchmark::DoNotOptimize(TileMathematics::TileToGeographic(tile));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(tiles.size()));
+}
+BENCHMARK_REGISTER_F(PointsFixture, TileBoundsRoundTrip)
+    ->ArgsProduct({{kSmallDataset, kLargeDataset}, {5, 18}});
+
+BENCHMARK_DEFINE_F(PointsFixture, QuadtreeKeyRoundTrip)(benchmark::State& state) {
+    const auto zoom = static_cast<std::int32_t>(state.range(1));
+    std::vector<TileCoordinates> tiles;
+    for (const Geographic& point : points_) {
+        tiles.push_back(TileMathematics::GeographicToTile(point, zoom));
+    }
+    for (auto _ : state) {
+        for (const TileCoordinates& tile : tiles) {
+            benchmark::DoNotOptimize(QuadtreeKey(tile).ToTileCoordinates());
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(tiles.size()));
+}
+BENCHMARK_REGISTER_F(PointsFixture, QuadtreeKeyRoundTrip)
+    ->ArgsProduct({{kSmallDataset, kLargeDataset}, {5, 18}});
+
+/// Tiles covering a viewport-sized box, by zoom level
+static void BM_TileMathematicsTilesInBounds(benchmark::State& state) {
+    const auto zoom = static_cast<std::int32_t>(state.range(0));
+    const BoundingBox2D bounds(glm::vec2(5.0f, 45.0f), glm::vec2(15.0f, 52.0f));
+    std::size_t tiles = 0;
+    for (auto _ : state) {
+        const auto result = TileMathematics::GetTilesInBounds(bounds, zoom);
+        tiles = result.size();
+        benchmark::DoNotOptimize(result.data());
+    }
+    state.counters["tiles"] = static_cast<double>(tiles);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(tiles));
+}
+BENCHMARK(BM_TileMathematicsTilesInBounds)->DenseRange(6, 12, 2);
+
+BENCHMARK_DEFINE_F(PointsFixture, GeographicToWorld)(benchmark::State& state) {
+    for (auto _ : state) {
+        for (const Geographic& point : points_) {
+            benchmark::DoNotOptimize(CoordinateMapper::GeographicToWorld(point));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(points_.size()));
+}
+BENCHMARK_REGISTER_F(PointsFixture, GeographicToWorld)
+    ->Arg(kSmallDataset)->Arg(kLargeDataset)
+    ->ThreadRange(1, MaxBenchmarkThreads())
+    ->UseRealTime();
+
+BENCHMARK_DEFINE_F(PointsFixture, GeographicToWorldBatch)(benchmark::State& state) {
+    std::vector<float> x(points_.size());
+    std::vector<float> y(points_.size());
+    std::vector<float> z(points_.size());
+    for (auto _ : state) {
+        CoordinateMapper::GeographicToWorld(latitudes_, longitudes_, x, y, z);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(points_.size()));
+}
+BENCHMARK_REGISTER_F(PointsFixture, GeographicToWorldBatch)
+    ->Arg(kSmallDataset)->Arg(kLargeDataset);
+
+BENCHMARK_DEFINE_F(PointsFixture, WorldToGeographic)(benchmark::State& state) {
+    std::vector<World> positions;
+    for (const Geographic& point : points_) {
+        positions.push_back(CoordinateMapper::GeographicToWorld(point));
+    }
+    for (auto _ : state) {
+        for (const World& position : positions) {
+            benchmark::DoNotOptimize(CoordinateMapper::WorldToGeographic(position));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(positions.size()));
+}
+BENCHMARK_REGISTER_F(PointsFixture, WorldToGeographic)
+    ->Arg(kSmallDataset)->Arg(kLargeDataset);
+
+BENCHMARK_DEFINE_F(PointsFixture, WorldToGeographicBatch)(benchmark::State& state) {
+    const std::size_t count = points_.size();
+    std::vector<float> x(count);
+    std::vector<float> y(count);
+    std::vector<float> z(count);
+    CoordinateMapper::GeographicToWorld(latitudes_, longitudes_, x, y, z);
+    std::vector<double> latitudes(count);
+    std::vector<double> longitudes(count);
+    std::vector<double> altitudes(count);
+    for (auto _ : state) {
+        CoordinateMapper::WorldToGeographic(x, y, z, latitudes, longitudes, altitudes);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+}
+BENCHMARK_REGISTER_F(PointsFixture, WorldToGeographicBatch)
+    ->Arg(kSmallDataset)->Arg(kLargeDataset);
+
+BENCHMARK_DEFINE_F(PointsFixture, GeographicToProjected)(benchmark::State& state) {
+    for (auto _ : state) {
+        for (const Geographic& point : points_) {
+            benchmark::DoNotOptimize(CoordinateMapper::GeographicToProjected(point));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(points_.size()));
+}
+BENCHMARK_REGISTER_F(PointsFixture, GeographicToProjected)
+    ->Arg(kSmallDataset)->Arg(kLargeDataset);
+
+BENCHMARK_DEFINE_F(PointsFixture, GeographicToProjectedBatch)(benchmark::State& state) {
+    std::vector<double> x(points_.size());
+    std::vector<double> y(points_.size());
+    for (auto _ : state) {
+        CoordinateMapper::GeographicToProjected(latitudes_, longitudes_, x, y);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(points_.size()));
+}
+BENCHMARK_REGISTER_F(PointsFixture, GeographicToProjectedBatch)
+    ->Arg(kSmallDataset)->Arg(kLargeDataset);
+
+} // namespace earth_map::tests
@@ -0,0 +1,239 @@
+#pragma once
+
+/**
+ * @file mock_tile_server.h
+ * @brief Loopback XYZ tile server with a simulated network for the replay benchmark
+ *
+ * Every GET /{z}/{x}/{y}.png is answered with a synthetic PNG after a
+ * lognormal first-byte latency. Bodies share one link of fixed bandwidth,
+ * so concurrent downloads slow each other down as on a real connection,
+ * and a fraction of requests fail (HTTP 500) or are dropped mid-request
+ * (connection closed without a response).
+ *
+ * The synthetic PNG is stored uncompressed (about 256 KB), so the link is
+ * charged as if it were a typical compressed raster tile of
+ * kWireTileBytes; transfer times then match the profile's bandwidth.
+ */
+
+#include "benchmark_datasets.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace earth_map::tests {
+
+/**
+ * @brief Simulated network between the loader and the tile server
+ */
+struct NetworkProfile {
+    std::string name;
+    double median_latency_ms = 20.0;    ///< Median time to first byte
+    double latency_sigma = 0.5;         ///< Lognormal shape; 0 makes latency constant
+    double bandwidth_mbps = 100.0;      ///< Shared downstream link, megabits per second
+    double error_rate = 0.0;            ///< Fraction answered with HTTP 500
+    double reset_rate = 0.0;            ///< Fraction closed without a response
+};
+
+/// Profiles the replay benchmark runs each camera path under
+inline std::vector<NetworkProfile> DefaultNetworkProfiles() {
+    return {
+        {"lan", 2.0, 0.2, 1000.0, 0.0, 0.0},
+        {"broadband", 40.0, 0.5, 50.0, 0.002, 0.002},
+        {"mobile", 120.0, 0.8, 8.0, 0.01, 0.01},
+    };
+}
+
+/**
+ * @brief Tile server statistics
+ */
+struct MockTileServerStats {
+    std::size_t requests = 0;        ///< Requests received
+    std::size_t responses = 0;       ///< Tiles served
+    std::size_t errors = 0;          ///< HTTP 500 answers
+    std::size_t resets = 0;          ///< Connections dropped without a response
+    std::size_t bytes_sent = 0;      ///< Response bytes, headers included
+};
+
+/**
+ * @brief Serves tiles from a background thread, one thread per connection
+ */
+class MockTileServer {
+public:
+    explicit MockTileServer(const NetworkProfile& profile, std::uint32_t seed = 1)
+        : profile_(profile), rng_(seed), tile_(SyntheticPng(256, 256)) {
+        listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        listen(listen_fd_, 128);
+        socklen_t length = sizeof(address);
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&address), &length);
+        port_ = ntohs(address.sin_port);
+        thread_ = std::thread([this] { Run(); });
+    }
+
+    ~MockTileServer() {
+        stop_ = true;
+        thread_.join();
+        for (std::thread& connection : connections_) {
+            connection.join();
+        }
+        close(listen_fd_);
+    }
+
+    MockTileServer(const MockTileServer&) = delete;
+    MockTileServer& operator=(const MockTileServer&) = delete;
+
+    std::string BaseUrl() const { return "http://127.0.0.1:" + std::to_string(port_); }
+
+    MockTileServerStats GetStats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    /// Bytes a connection writes per reservation of the shared link
+    static constexpr std::size_t kChunkBytes = 16 * 1024;
+
+    /// Size the link charges for one tile body
+    static constexpr double kWireTileBytes = 32.0 * 1024.0;
+
+    enum class Outcome { SERVE, ERROR, RESET };
+
+    void Run() {
+        while (!stop_) {
+            pollfd descriptor{listen_fd_, POLLIN, 0};
+            if (poll(&descriptor, 1, 20) <= 0) {
+                continue;
+            }
+            const int client = accept(listen_fd_, nullptr, nullptr);
+            if (client < 0) {
+                continue;
+            }
+            connections_.emplace_back([this, client] { Serve(client); });
+        }
+    }
+
+    void Serve(int client) {
+        std::string request;
+        char buffer[1024];
+        while (request.find("\r\n\r\n") == std::string::npos) {
+            pollfd descriptor{client, POLLIN, 0};
+            if (stop_ || poll(&descriptor, 1, 20) < 0) {
+                break;
+            }
+            if (!(descriptor.revents & POLLIN)) {
+                continue;
+            }
+            const ssize_t received = recv(client, buffer, sizeof(buffer), 0);
+            if (received <= 0) {
+                break;
+            }
+            request.append(buffer, static_cast<std::size_t>(received));
+        }
+
+        Outcome outcome = Outcome::SERVE;
+        Clock::duration latency{};
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ++stats_.requests;
+            const double roll = std::uniform_real_distribution<double>(0.0, 1.0)(rng_);
+            if (roll < profile_.reset_rate) {
+                outcome = Outcome::RESET;
+                ++stats_.resets;
+            } else if (roll < profile_.reset_rate + profile_.error_rate) {
+                outcome = Outcome::ERROR;
+                ++stats_.errors;
+            }
+            const double factor = profile_.latency_sigma > 0.0
+                ? std::exp(std::normal_distribution<double>(0.0, profile_.latency_sigma)(rng_))
+                : 1.0;
+            latency = std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double, std::milli>(profile_.median_latency_ms * factor));
+        }
+
+        SleepUnlessStopped(Clock::now() + latency);
+        if (outcome == Outcome::RESET || stop_) {
+            close(client);
+            return;
+        }
+
+        std::string response;
+        if (outcome == Outcome::ERROR) {
+            response = "HTTP/1.1 500 Internal Server Error\r\nContent-Length: 0\r\n"
+                       "Connection: close\r\n\r\n";
+        } else {
+            response = "HTTP/1.1 200 OK\r\nContent-Type: image/png\r\nContent-Length: " +
+                       std::to_string(tile_.size()) + "\r\nConnection: close\r\n\r\n";
+            response.append(reinterpret_cast<const char*>(tile_.data()), tile_.size());
+        }
+
+        // Each chunk waits for its turn on the link, so concurrent bodies
+        // share the bandwidth instead of each getting all of it
+        const double bytes_per_second = profile_.bandwidth_mbps * 1e6 / 8.0 *
+            (outcome == Outcome::SERVE ? static_cast<double>(tile_.size()) / kWireTileBytes : 1.0);
+        for (std::size_t offset = 0; offset < response.size() && !stop_;) {
+            const std::size_t length = std::min(kChunkBytes, response.size() - offset);
+            Clock::time_point done;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                const auto transfer = std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(static_cast<double>(length) / bytes_per_second));
+                link_free_at_ = std::max(link_free_at_, Clock::now()) + transfer;
+                done = link_free_at_;
+            }
+            SleepUnlessStopped(done);
+            if (send(client, response.data() + offset, length, MSG_NOSIGNAL) <= 0) {
+                break;
+            }
+            offset += length;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stats_.bytes_sent += response.size();
+            stats_.responses += outcome == Outcome::SERVE;
+        }
+        close(client);
+    }
+
+    void SleepUnlessStopped(Clock::time_point until) const {
+        while (!stop_ && Clock::now() < until) {
+            std::this_thread::sleep_for(std::min<Clock::duration>(
+                until - Clock::now(), std::chrono::milliseconds(20)));
+        }
+    }
+
+    NetworkProfile profile_;
+    int listen_fd_ = -1;
+    std::uint16_t port_ = 0;
+    std::atomic<bool> stop_{false};
+
+    mutable std::mutex mutex_;
+    std::mt19937 rng_;
+    Clock::time_point link_free_at_{};
+    MockTileServerStats stats_;
+
+    const std::vector<std::uint8_t> tile_;
+    std::vector<std::thread> connections_;  ///< Touched by the accept thread only
+    std::thread thread_;
+};
+
+} // namespace earth_map::tests
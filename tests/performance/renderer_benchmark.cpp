@@ -0,0 +1,145 @@
+/**
+ * @file renderer_benchmark.cpp
+ * @brief Tile image decoding, GL upload queue hand-off and globe mesh generation
+ */
+
+#include "benchmark_datasets.h"
+
+#include <benchmark/benchmark.h>
+#include <earth_map/renderer/globe_mesh.h>
+#include <earth_map/renderer/texture_atlas/gl_upload_queue.h>
+#include <earth_map/renderer/texture_atlas/image_decoder.h>
+#include <memory>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+/// Registry shared by all decode threads, as in the tile load worker pool
+ImageDecoderRegistry& SharedDecoders() {
+    static const std::unique_ptr<ImageDecoderRegistry> registry = ImageDecoderRegistry::CreateDefault();
+    return *registry;
+}
+
+const std::vector<std::uint8_t>& EncodedTile(std::int64_t size) {
+    static const std::vector<std::uint8_t> tile256 = SyntheticPng(256, 256);
+    static const std::vector<std::uint8_t> tile512 = SyntheticPng(512, 512);
+    return size == 256 ? tile256 : tile512;
+}
+
+} // namespace
+
+/// PNG tile decode to RGBA8, by tile size, with one decode per thread
+static void BM_ImageDecode(benchmark::State& state) {
+    const std::vector<std::uint8_t>& encoded = EncodedTile(state.range(0));
+    DecodedImage image;
+    for (auto _ : state) {
+        if (!SharedDecoders().Decode(encoded.data(), encoded.size(), image)) {
+            state.SkipWithError("decode failed");
+            break;
+        }
+        benchmark::DoNotOptimize(image.pixels.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0) * state.range(0) * 4);
+}
+BENCHMARK(BM_ImageDecode)
+    ->Arg(256)->Arg(512)
+    ->ThreadRange(1, MaxBenchmarkThreads())
+    ->UseRealTime();
+
+/// Decode straight into a staging buffer, as the worker pool does
+static void BM_ImageDecodeInto(benchmark::State& state) {
+    const std::vector<std::uint8_t>& encoded = EncodedTile(state.range(0));
+    std::vector<std::uint8_t> staging(static_cast<std::size_t>(state.range(0) * state.range(0) * 4));
+    DecodedImage image;
+    for (auto _ : state) {
+        if (!SharedDecoders().DecodeInto(encoded.data(), encoded.size(),
+                                         staging.data(), staging.size(), image)) {
+            state.SkipWithError("decode failed");
+            break;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(staging.size()));
+}
+BENCHMARK(BM_ImageDecodeInto)
+    ->Arg(256)->Arg(512)
+    ->ThreadRange(1, MaxBenchmarkThreads())
+    ->UseRealTime();
+
+/**
+ * @brief GLUploadQueue shared by ThreadRange threads
+ */
+class UploadQueueFixture : public benchmark::Fixture {
+public:
+    void SetUp(const benchmark::State& state) override {
+        if (state.thread_index() == 0) {
+            queue_ = std::make_unique<GLUploadQueue>(static_cast<std::size_t>(state.range(0)));
+        }
+    }
+
+    void TearDown(const benchmark::State& state) override {
+        if (state.thread_index() == 0) {
+            queue_.reset();
+        }
+    }
+
+protected:
+    std::unique_ptr<GLUploadQueue> queue_;
+};
+
+/// Each thread pushes a command and pops one: the ring under contention
+BENCHMARK_DEFINE_F(UploadQueueFixture, PushPop)(benchmark::State& state) {
+    const TileCoordinates coordinates(state.thread_index(), 0, 10);
+    for (auto _ : state) {
+        queue_->Push(std::make_unique<GLUploadCommand>(coordinates));
+        benchmark::DoNotOptimize(queue_->TryPop());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK_REGISTER_F(UploadQueueFixture, PushPop)
+    ->Arg(1024)
+    ->ThreadRange(1, MaxBenchmarkThreads())
+    ->UseRealTime();
+
+/// A frame's worth of commands pushed, then drained by the GL thread in one batch
+BENCHMARK_DEFINE_F(UploadQueueFixture, PushThenPopN)(benchmark::State& state) {
+    const auto batch = static_cast<std::size_t>(state.range(1));
+    std::vector<std::unique_ptr<GLUploadCommand>> popped;
+    popped.reserve(batch);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < batch; ++i) {
+            queue_->Push(std::make_unique<GLUploadCommand>(
+                TileCoordinates(static_cast<std::int32_t>(i), 0, 10)));
+        }
+        popped.clear();
+        queue_->TryPopN(popped, batch);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch));
+}
+BENCHMARK_REGISTER_F(UploadQueueFixture, PushThenPopN)->Args({1024, 16})->Args({1024, 256});
+
+/// IcosahedronGlobeMesh::Generate (subdivision and optimization) by level
+static void BM_GlobeMeshGenerate(benchmark::State& state) {
+    GlobeMeshParams params;
+    params.radius = 1.0;
+    params.max_subdivision_level = static_cast<std::uint8_t>(state.range(0));
+    params.enable_adaptive = false;
+    std::size_t triangles = 0;
+    for (auto _ : state) {
+        IcosahedronGlobeMesh mesh(params);
+        if (!mesh.Generate()) {
+            state.SkipWithError("generate failed");
+            break;
+        }
+        triangles = mesh.GetTriangles().size();
+    }
+    state.counters["triangles"] = static_cast<double>(triangles);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(triangles));
+}
+BENCHMARK(BM_GlobeMeshGenerate)->DenseRange(3, 7)->Unit(benchmark::kMillisecond);
+
+} // namespace earth_map::tests
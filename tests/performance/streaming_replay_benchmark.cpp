@@ -0,0 +1,363 @@
+/**
+ * @file streaming_replay_benchmark.cpp
+ * @brief Camera-move-to-tiles-on-screen latency, replaying recorded camera paths
+ *
+ * Each recorded path (the .path files in tests/performance/camera_paths, or the
+ * directory in EARTH_MAP_CAMERA_PATHS) runs once per network profile. The
+ * replay drives a real CameraController, tile cache, tile loader and
+ * TileTextureCoordinator (without GL) against a MockTileServer, at 60
+ * frames per second in real time. Each frame does what TileRenderer does
+ * between BeginFrame() and EndFrame(): publish uploads, select the
+ * visible tiles, request them and the prefetched ones, and query their
+ * states.
+ *
+ * Counters:
+ * - ttv_p50/p90/p99_ms: time from a tile entering the view to its texture
+ *   being ready
+ * - blank_tile_seconds: visible tiles with neither their texture nor a
+ *   fallback ancestor's, summed over frames
+ * - frame_p50/p99_ms: CPU time of the per-frame streaming work
+ * - bytes_downloaded, requests, errors: as seen by the mock server
+ */
+
+#include "benchmark_datasets.h"
+#include "camera_flight.h"
+#include "camera_path.h"
+#include "mock_tile_server.h"
+
+#include <benchmark/benchmark.h>
+#include <earth_map/core/camera_controller.h>
+#include <earth_map/data/tile_cache.h>
+#include <earth_map/data/tile_loader.h>
+#include <earth_map/earth_map.h>
+#include <earth_map/renderer/texture_atlas/tile_texture_coordinator.h>
+#include <earth_map/renderer/tile_prefetcher.h>
+#include <earth_map/renderer/tile_renderer.h>
+#include <earth_map/renderer/tile_selector.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double kFrameSeconds = 1.0 / 60.0;
+/// Longest wait after the path ends for the last visible tiles to load
+constexpr double kSettleSeconds = 5.0;
+
+std::string CameraPathDirectory() {
+    if (const char* directory = std::getenv("EARTH_MAP_CAMERA_PATHS")) {
+        return directory;
+    }
+#ifdef EARTH_MAP_CAMERA_PATH_DIR
+    return EARTH_MAP_CAMERA_PATH_DIR;
+#else
+    return "tests/performance/camera_paths";
+#endif
+}
+
+double Percentile(std::vector<double> values, double fraction) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    const auto index = static_cast<std::size_t>(fraction * static_cast<double>(values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+    return values[index];
+}
+
+/**
+ * @brief Results of one replay
+ */
+struct ReplayResult {
+    std::vector<double> time_to_visible_ms;
+    std::vector<double> frame_ms;
+    double blank_tile_seconds = 0.0;
+    double replay_seconds = 0.0;
+};
+
+/**
+ * @brief The streaming pipeline of one replay, torn down with it
+ */
+class StreamingReplay {
+public:
+    StreamingReplay(const CameraPath& path, const NetworkProfile& profile)
+        : path_(path),
+          directory_("earth_map_replay_benchmark"),
+          server_(profile),
+          selector_(render_config_.selection),
+          prefetcher_(render_config_.prefetch, &TileRenderer::ZoomForCameraDistance) {
+        TileCacheConfig cache_config;
+        cache_config.disk_cache_directory = (directory_.Path() / "tiles").string();
+        cache_ = std::shared_ptr<TileCache>(CreateTileCache(cache_config));
+        cache_->Initialize(cache_config);
+
+        TileLoaderConfig loader_config;
+        loader_ = std::shared_ptr<TileLoader>(CreateTileLoader(loader_config));
+        loader_->Initialize(loader_config);
+        loader_->SetTileCache(cache_);
+        loader_->AddProvider(std::make_shared<BasicXYZTileProvider>(
+            "Replay", server_.BaseUrl() + "/{z}/{x}/{y}.png"));
+        loader_->SetDefaultProvider("Replay");
+
+        coordinator_ = std::make_unique<TileTextureCoordinator>(cache_, loader_, 0, true);
+
+        Configuration config;
+        config.screen_width = path.screen_width;
+        config.screen_height = path.screen_height;
+        config.enable_opengl_debug = false;
+        camera_.reset(CreateCameraController(config));
+        camera_->Initialize();
+    }
+
+    ~StreamingReplay() {
+        // Workers hold the loader; stop them before the server goes away
+        coordinator_.reset();
+        loader_.reset();
+        cache_.reset();
+    }
+
+    StreamingReplay(const StreamingReplay&) = delete;
+    StreamingReplay& operator=(const StreamingReplay&) = delete;
+
+    ReplayResult Run() {
+        ReplayResult result;
+        const Clock::time_point start = Clock::now();
+        std::size_t next_step = 0;
+        glm::vec3 previous_position = camera_->GetPosition();
+        bool path_ended = path_.steps.empty();
+        double end_time = 0.0;
+
+        for (std::uint64_t frame = 0;; ++frame) {
+            const double time = static_cast<double>(frame) * kFrameSeconds;
+            std::this_thread::sleep_until(
+                start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(time)));
+
+            for (; next_step < path_.steps.size() && path_.steps[next_step].time <= time; ++next_step) {
+                Apply(path_.steps[next_step], time);
+                if (path_.steps[next_step].kind == CameraPathStep::Kind::END) {
+                    path_ended = true;
+                }
+            }
+            if (!path_ended && next_step == path_.steps.size() && (!flight_ || flight_->Done(time))) {
+                path_ended = true;
+            }
+            if (path_ended && end_time == 0.0) {
+                end_time = time;
+            }
+
+            if (flight_) {
+                camera_->SetPosition(flight_->PositionAt(time));
+                if (flight_->Done(time)) {
+                    flight_.reset();
+                }
+            }
+            camera_->Update(static_cast<float>(kFrameSeconds));
+            const glm::vec3 position = camera_->GetPosition();
+            const glm::vec3 velocity = (position - previous_position) / static_cast<float>(kFrameSeconds);
+            previous_position = position;
+
+            const Clock::time_point frame_start = Clock::now();
+            const bool all_loaded = StreamFrame(position, velocity, time, result);
+            result.frame_ms.push_back(
+                std::chrono::duration<double, std::milli>(Clock::now() - frame_start).count());
+
+            if (path_ended && (all_loaded || time - end_time >= kSettleSeconds)) {
+                result.replay_seconds = time;
+                break;
+            }
+        }
+        return result;
+    }
+
+    const MockTileServer& Server() const { return server_; }
+
+private:
+    void Apply(const CameraPathStep& step, double time) {
+        switch (step.kind) {
+            case CameraPathStep::Kind::INPUT:
+                flight_.reset();
+                camera_->ProcessInput(step.input);
+                break;
+            case CameraPathStep::Kind::VIEW:
+                flight_.reset();
+                camera_->SetPosition(CameraPositionAbove(step.latitude, step.longitude, step.altitude));
+                break;
+            case CameraPathStep::Kind::FLY_TO: {
+                const glm::vec3 destination =
+                    CameraPositionAbove(step.latitude, step.longitude, step.altitude);
+                prefetcher_.SetDestination(destination, static_cast<float>(step.duration));
+                flight_ = Flight{camera_->GetPosition(), destination, time, step.duration};
+                break;
+            }
+            case CameraPathStep::Kind::END:
+                break;
+        }
+    }
+
+    /**
+     * @brief TileRenderer's streaming work for one frame
+     *
+     * @return Whether every visible tile is loaded
+     */
+    bool StreamFrame(const glm::vec3& position, const glm::vec3& velocity, double time,
+                     ReplayResult& result) {
+        coordinator_->ProcessUploads(std::chrono::microseconds(render_config_.upload_budget_us));
+
+        const float aspect = static_cast<float>(path_.screen_width) /
+                             static_cast<float>(path_.screen_height);
+        const float camera_distance = glm::length(position);
+        const int zoom = TileRenderer::ZoomForCameraDistance(camera_distance);
+
+        const std::int64_t n = std::int64_t{1} << zoom;
+        visible_.clear();
+        if (n * n <= 256) {
+            for (std::int32_t x = 0; x < n; ++x) {
+                for (std::int32_t y = 0; y < n; ++y) {
+                    visible_.emplace_back(x, y, zoom);
+                }
+            }
+        } else {
+            const float focal_length_px = TileSelector::FocalLengthPixels(
+                camera_->GetProjectionMatrix(aspect), static_cast<float>(path_.screen_height));
+            selector_.Select(position, camera_->GetFrustum(aspect), focal_length_px, zoom,
+                             render_config_.max_visible_tiles, visible_);
+        }
+
+        coordinator_->SetUploadFocus(TilePrefetcher::WorldToTile(position, zoom));
+        coordinator_->BeginRequestGeneration();
+        const int priority = static_cast<int>(camera_distance * 10.0f);
+        coordinator_->RequestTiles(std::span<const TileCoordinates>(visible_), priority);
+        const std::vector<TileCoordinates> prefetch = prefetcher_.Update(
+            position, velocity, static_cast<float>(kFrameSeconds), visible_);
+        if (!prefetch.empty()) {
+            coordinator_->RequestTiles(prefetch, priority + TileRenderer::kPrefetchPriorityOffset);
+        }
+        coordinator_->CancelStaleRequests();
+
+        states_.resize(visible_.size());
+        coordinator_->QueryTiles(visible_, states_);
+
+        // Time to visible counts from the first frame of the current stay
+        // in view; tiles that leave before loading are forgotten
+        std::unordered_map<TileCoordinates, double, TileCoordinatesHash> still_waiting;
+        bool all_loaded = true;
+        for (std::size_t i = 0; i < visible_.size(); ++i) {
+            const TileCoordinates& tile = visible_[i];
+            const auto waiting = waiting_since_.find(tile);
+            if (states_[i].status == TileTextureCoordinator::TileStatus::Loaded) {
+                if (waiting != waiting_since_.end()) {
+                    result.time_to_visible_ms.push_back((time - waiting->second) * 1000.0);
+                }
+                continue;
+            }
+            all_loaded = false;
+            still_waiting.emplace(tile, waiting != waiting_since_.end() ? waiting->second : time);
+            if (!HasLoadedAncestor(tile)) {
+                result.blank_tile_seconds += kFrameSeconds;
+            }
+        }
+        waiting_since_ = std::move(still_waiting);
+        return all_loaded;
+    }
+
+    /// Whether the tile shader has a coarser texture to fall back on
+    bool HasLoadedAncestor(TileCoordinates tile) const {
+        for (int level = 0; level < TileRenderer::kMaxFallbackLevels && tile.zoom > 0; ++level) {
+            tile = TileCoordinates(tile.x / 2, tile.y / 2, tile.zoom - 1);
+            if (coordinator_->GetTileStatus(tile) == TileTextureCoordinator::TileStatus::Loaded) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const CameraPath& path_;
+    TileRenderConfig render_config_;
+    ScratchDirectory directory_;
+    MockTileServer server_;
+    std::shared_ptr<TileCache> cache_;
+    std::shared_ptr<TileLoader> loader_;
+    TileSelector selector_;
+    TilePrefetcher prefetcher_;
+    std::unique_ptr<TileTextureCoordinator> coordinator_;
+    std::unique_ptr<CameraController> camera_;
+    std::optional<Flight> flight_;
+
+    std::pmr::vector<TileCoordinates> visible_;
+    std::vector<TileTextureCoordinator::TileState> states_;
+    std::unordered_map<TileCoordinates, double, TileCoordinatesHash> waiting_since_;
+};
+
+void BM_StreamingReplay(benchmark::State& state, const CameraPath& path, const NetworkProfile& profile) {
+    for (auto _ : state) {
+        StreamingReplay replay(path, profile);
+        const ReplayResult result = replay.Run();
+        state.SetIterationTime(result.replay_seconds);
+
+        const MockTileServerStats server = replay.Server().GetStats();
+        state.counters["ttv_p50_ms"] = Percentile(result.time_to_visible_ms, 0.50);
+        state.counters["ttv_p90_ms"] = Percentile(result.time_to_visible_ms, 0.90);
+        state.counters["ttv_p99_ms"] = Percentile(result.time_to_visible_ms, 0.99);
+        state.counters["tiles_shown"] = static_cast<double>(result.time_to_visible_ms.size());
+        state.counters["blank_tile_seconds"] = result.blank_tile_seconds;
+        state.counters["frame_p50_ms"] = Percentile(result.frame_ms, 0.50);
+        state.counters["frame_p99_ms"] = Percentile(result.frame_ms, 0.99);
+        state.counters["bytes_downloaded"] = static_cast<double>(server.bytes_sent);
+        state.counters["requests"] = static_cast<double>(server.requests);
+        state.counters["errors"] = static_cast<double>(server.errors + server.resets);
+    }
+}
+
+/// One benchmark per recorded path and network profile
+bool RegisterReplayBenchmarks() {
+    static std::vector<CameraPath> paths;
+    static const std::vector<NetworkProfile> profiles = DefaultNetworkProfiles();
+
+    std::error_code error;
+    std::vector<std::filesystem::path> files;
+    for (const auto& entry : std::filesystem::directory_iterator(CameraPathDirectory(), error)) {
+        if (entry.path().extension() == ".path") {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    paths.reserve(files.size());
+    for (const std::filesystem::path& file : files) {
+        try {
+            paths.push_back(LoadCameraPath(file.string()));
+        } catch (const std::exception& e) {
+            std::fprintf(stderr, "Skipping camera path: %s\n", e.what());
+        }
+    }
+
+    for (const CameraPath& path : paths) {
+        for (const NetworkProfile& profile : profiles) {
+            benchmark::RegisterBenchmark(
+                ("BM_StreamingReplay/" + path.name + "/" + profile.name).c_str(),
+                [&path, &profile](benchmark::State& state) { BM_StreamingReplay(state, path, profile); })
+                ->Iterations(1)
+                ->UseManualTime()
+                ->Unit(benchmark::kSecond);
+        }
+    }
+    return true;
+}
+
+[[maybe_unused]] const bool kReplayBenchmarksRegistered = RegisterReplayBenchmarks();
+
+} // namespace
+
+} // namespace earth_map::tests
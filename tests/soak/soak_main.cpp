@@ -0,0 +1,625 @@
+/**
+ * @file soak_main.cpp
+ * @brief Long-session soak harness: hours of random camera flights in accelerated time
+ *
+ * Usage: earth_map_soak [--hours=4] [--acceleration=120] [--sample-minutes=5]
+ *        [--seed=1] [--profile=lan|broadband|mobile] [--csv=<file>]
+ *
+ * Runs the streaming pipeline of the replay benchmark (CameraController,
+ * tile cache, tile loader and TileTextureCoordinator without GL, against a
+ * MockTileServer) under random flights between hotspots and random places,
+ * and feeds an ElevationCache the SRTM cells under each low-altitude stop.
+ * Simulated time advances 1/60 s per frame, at most --acceleration times
+ * faster than real time; downloads still take real time.
+ *
+ * Every --sample-minutes of simulated time the harness samples RSS, the
+ * heap in use and free (glibc), tile and elevation cache sizes, the
+ * coordinator's per-tile maps, texture pool occupancy, pooled decode
+ * buffers, open file descriptors and threads. After the warm-up (first
+ * quarter of the samples), the mean of the last quarter may exceed the
+ * mean of the quarter after the warm-up only by each series' tolerance,
+ * and capped caches must stay under their caps. Exit status: 0 bounded,
+ * 1 unbounded growth, 2 bad arguments or too few samples.
+ */
+
+#include "performance/benchmark_datasets.h"
+#include "performance/camera_flight.h"
+#include "performance/mock_tile_server.h"
+
+#include <earth_map/core/camera_controller.h>
+#include <earth_map/data/elevation_cache.h>
+#include <earth_map/data/tile_cache.h>
+#include <earth_map/data/tile_loader.h>
+#include <earth_map/earth_map.h>
+#include <earth_map/renderer/texture_atlas/tile_texture_coordinator.h>
+#include <earth_map/renderer/tile_prefetcher.h>
+#include <earth_map/renderer/tile_renderer.h>
+#include <earth_map/renderer/tile_selector.h>
+#include <spdlog/spdlog.h>
+#include <unistd.h>
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr double kFrameSeconds = 1.0 / 60.0;
+constexpr double kMegabyte = 1024.0 * 1024.0;
+
+/// Stops below this altitude load the terrain under the camera
+constexpr double kElevationAltitudeMeters = 300000.0;
+
+/**
+ * @brief Command-line options
+ */
+struct SoakOptions {
+    double hours = 4.0;              ///< Simulated session length
+    double acceleration = 120.0;     ///< Simulated seconds per real second, at most
+    double sample_minutes = 5.0;     ///< Simulated time between samples
+    std::uint32_t seed = 1;
+    std::string profile = "lan";     ///< NetworkProfile name
+    std::string csv_path;            ///< Write every sample here if set
+
+    /// Cache caps the run is checked against
+    std::size_t tile_memory_bytes = 64 * 1024 * 1024;
+    std::size_t tile_disk_bytes = 256 * 1024 * 1024;
+    std::size_t elevation_memory_bytes = 64 * 1024 * 1024;
+    std::size_t elevation_disk_bytes = 256 * 1024 * 1024;
+};
+
+/**
+ * @brief Sampled series
+ */
+enum Metric : std::size_t {
+    RSS_MB,
+    HEAP_IN_USE_MB,
+    HEAP_FREE_MB,
+    TILE_MEMORY_MB,
+    TILE_MEMORY_COUNT,
+    TILE_DISK_MB,
+    ELEVATION_MEMORY_MB,
+    ELEVATION_DISK_MB,
+    TILE_STATES,
+    AWAITING_RENDER,
+    POOL_TILES,
+    PENDING_LOADS,
+    POOLED_BUFFER_MB,
+    OPEN_FILES,
+    THREADS,
+    kMetricCount
+};
+
+/**
+ * @brief How much a series may grow after the warm-up
+ */
+struct MetricSpec {
+    const char* name;
+    double relative_tolerance;   ///< Growth allowed as a fraction of the baseline
+    double absolute_tolerance;   ///< Growth allowed in the series' unit
+    double limit = 0.0;          ///< Cap on every sample (0 = none)
+};
+
+constexpr double kUnchecked = std::numeric_limits<double>::infinity();
+
+std::array<MetricSpec, kMetricCount> MetricSpecs(const SoakOptions& options) {
+    // Disk caches grow with the area visited, so only their caps are checked;
+    // the collectors run behind the writes and may overshoot by a tenth
+    const auto cap_mb = [](std::size_t bytes, double slack) {
+        return static_cast<double>(bytes) * slack / kMegabyte;
+    };
+    return {{
+        {"rss_mb", 0.10, 32.0},
+        {"heap_in_use_mb", 0.10, 16.0},
+        {"heap_free_mb", 0.50, 32.0},
+        {"tile_memory_mb", 0.05, 4.0, cap_mb(options.tile_memory_bytes, 1.0)},
+        {"tile_memory_count", 0.25, 64.0},
+        {"tile_disk_mb", kUnchecked, 0.0, cap_mb(options.tile_disk_bytes, 1.1)},
+        {"elevation_memory_mb", 0.05, 4.0, cap_mb(options.elevation_memory_bytes, 1.0)},
+        {"elevation_disk_mb", kUnchecked, 0.0, cap_mb(options.elevation_disk_bytes, 1.1)},
+        {"tile_states", 0.25, 256.0},
+        {"awaiting_render", 0.25, 64.0},
+        {"pool_tiles", 0.10, 64.0},
+        {"pending_loads", 0.50, 256.0},
+        {"pooled_buffer_mb", 0.50, 16.0},
+        {"open_files", 0.0, 8.0},
+        {"threads", 0.0, 2.0},
+    }};
+}
+
+/**
+ * @brief One sample of every series
+ */
+struct Sample {
+    double hours = 0.0;   ///< Simulated time
+    std::array<double, kMetricCount> values{};
+};
+
+/// Resident set size from /proc/self/statm
+double ResidentMegabytes() {
+    std::ifstream statm("/proc/self/statm");
+    std::size_t size = 0;
+    std::size_t resident = 0;
+    statm >> size >> resident;
+    return static_cast<double>(resident) * static_cast<double>(sysconf(_SC_PAGESIZE)) / kMegabyte;
+}
+
+std::size_t OpenFileCount() {
+    std::error_code error;
+    std::size_t count = 0;
+    for (std::filesystem::directory_iterator it("/proc/self/fd", error), end; !error && it != end;
+         it.increment(error)) {
+        ++count;
+    }
+    return count;
+}
+
+std::size_t ThreadCount() {
+    std::ifstream status("/proc/self/status");
+    for (std::string line; std::getline(status, line);) {
+        if (line.rfind("Threads:", 0) == 0) {
+            return static_cast<std::size_t>(std::strtoul(line.c_str() + 8, nullptr, 10));
+        }
+    }
+    return 0;
+}
+
+/// Heap bytes in use and free inside the allocator's arenas (0 without glibc 2.33)
+std::pair<double, double> HeapMegabytes() {
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    const struct mallinfo2 info = mallinfo2();
+    return {static_cast<double>(info.uordblks + info.hblkhd) / kMegabyte,
+            static_cast<double>(info.fordblks) / kMegabyte};
+#else
+    return {0.0, 0.0};
+#endif
+}
+
+/**
+ * @brief Picks the flights of a kiosk session: mostly around popular places
+ */
+class FlightPlanner {
+public:
+    explicit FlightPlanner(std::uint32_t seed) : rng_(seed) {}
+
+    struct Stop {
+        double latitude = 0.0;
+        double longitude = 0.0;
+        double altitude = 0.0;
+        double flight_seconds = 0.0;
+        double dwell_seconds = 0.0;
+    };
+
+    Stop Next() {
+        static constexpr std::array<std::pair<double, double>, 12> kHotspots = {{
+            {48.86, 2.35}, {40.71, -74.01}, {35.68, 139.69}, {-33.87, 151.21},
+            {51.51, -0.13}, {37.77, -122.42}, {-22.91, -43.17}, {55.76, 37.62},
+            {1.35, 103.82}, {30.04, 31.24}, {19.43, -99.13}, {-1.29, 36.82},
+        }};
+        std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+        Stop stop;
+        if (unit(rng_) < 0.7) {
+            const auto& hotspot = kHotspots[static_cast<std::size_t>(unit(rng_) * kHotspots.size())];
+            stop.latitude = hotspot.first + (unit(rng_) - 0.5) * 3.0;
+            stop.longitude = hotspot.second + (unit(rng_) - 0.5) * 3.0;
+        } else {
+            stop.latitude = -70.0 + 140.0 * unit(rng_);
+            stop.longitude = -180.0 + 360.0 * unit(rng_);
+        }
+        // Log-uniform from street level to the whole globe
+        stop.altitude = std::exp(std::log(500.0) + unit(rng_) * (std::log(2.0e7) - std::log(500.0)));
+        stop.flight_seconds = 3.0 + 7.0 * unit(rng_);
+        stop.dwell_seconds = 2.0 + 18.0 * unit(rng_);
+        return stop;
+    }
+
+private:
+    std::mt19937 rng_;
+};
+
+/**
+ * @brief The session under test, torn down with it
+ */
+class SoakSession {
+public:
+    SoakSession(const SoakOptions& options, const NetworkProfile& profile)
+        : options_(options),
+          directory_("earth_map_soak"),
+          server_(profile, options.seed),
+          planner_(options.seed),
+          selector_(render_config_.selection),
+          prefetcher_(render_config_.prefetch, &TileRenderer::ZoomForCameraDistance) {
+        TileCacheConfig cache_config;
+        cache_config.disk_cache_directory = (directory_.Path() / "tiles").string();
+        cache_config.max_memory_cache_size = options.tile_memory_bytes;
+        cache_config.max_disk_cache_size = options.tile_disk_bytes;
+        cache_ = std::shared_ptr<TileCache>(CreateTileCache(cache_config));
+        cache_->Initialize(cache_config);
+
+        TileLoaderConfig loader_config;
+        loader_ = std::shared_ptr<TileLoader>(CreateTileLoader(loader_config));
+        loader_->Initialize(loader_config);
+        loader_->SetTileCache(cache_);
+        loader_->AddProvider(std::make_shared<BasicXYZTileProvider>(
+            "Soak", server_.BaseUrl() + "/{z}/{x}/{y}.png"));
+        loader_->SetDefaultProvider("Soak");
+
+        coordinator_ = std::make_unique<TileTextureCoordinator>(cache_, loader_, 0, true);
+        coordinator_->SetAncestorLevels(TileRenderer::kMaxFallbackLevels - 1);
+
+        ElevationCacheConfig elevation_config;
+        elevation_config.disk_cache_directory = (directory_.Path() / "elevation").string();
+        elevation_config.max_memory_cache_size = options.elevation_memory_bytes;
+        elevation_config.max_disk_cache_size = options.elevation_disk_bytes;
+        elevation_ = ElevationCache::Create(elevation_config);
+        if (!elevation_) {
+            throw std::runtime_error("Cannot create the elevation cache");
+        }
+
+        Configuration config;
+        config.enable_opengl_debug = false;
+        camera_.reset(CreateCameraController(config));
+        camera_->Initialize();
+        screen_width_ = config.screen_width;
+        screen_height_ = config.screen_height;
+    }
+
+    ~SoakSession() {
+        // Workers hold the loader; stop them before the server goes away
+        coordinator_.reset();
+        loader_.reset();
+        cache_.reset();
+    }
+
+    SoakSession(const SoakSession&) = delete;
+    SoakSession& operator=(const SoakSession&) = delete;
+
+    /**
+     * @brief Fly for options.hours of simulated time, calling @p on_sample at each sample
+     */
+    template <typename OnSample>
+    void Run(OnSample&& on_sample) {
+        const double total_seconds = options_.hours * 3600.0;
+        const double sample_seconds = options_.sample_minutes * 60.0;
+        const Clock::time_point start = Clock::now();
+        glm::vec3 previous_position = camera_->GetPosition();
+        double dwell_until = 0.0;
+        double next_sample = sample_seconds;
+
+        for (std::uint64_t frame = 0;; ++frame) {
+            const double time = static_cast<double>(frame) * kFrameSeconds;
+            if (time > total_seconds) {
+                break;
+            }
+            std::this_thread::sleep_until(start + std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double>(time / options_.acceleration)));
+
+            if (!flight_ && time >= dwell_until) {
+                stop_ = planner_.Next();
+                const glm::vec3 destination =
+                    CameraPositionAbove(stop_.latitude, stop_.longitude, stop_.altitude);
+                prefetcher_.SetDestination(destination, static_cast<float>(stop_.flight_seconds));
+                flight_ = Flight{camera_->GetPosition(), destination, time, stop_.flight_seconds};
+            }
+            if (flight_) {
+                camera_->SetPosition(flight_->PositionAt(time));
+                if (flight_->Done(time)) {
+                    flight_.reset();
+                    dwell_until = time + stop_.dwell_seconds;
+                    LoadTerrain(stop_);
+                }
+            }
+            camera_->Update(static_cast<float>(kFrameSeconds));
+            const glm::vec3 position = camera_->GetPosition();
+            const glm::vec3 velocity = (position - previous_position) / static_cast<float>(kFrameSeconds);
+            previous_position = position;
+
+            StreamFrame(position, velocity);
+
+            if (time >= next_sample) {
+                on_sample(TakeSample(time));
+                next_sample += sample_seconds;
+            }
+        }
+    }
+
+private:
+    /**
+     * @brief TileRenderer's streaming work for one frame
+     */
+    void StreamFrame(const glm::vec3& position, const glm::vec3& velocity) {
+        coordinator_->ProcessUploads(std::chrono::microseconds(render_config_.upload_budget_us));
+
+        const float aspect = static_cast<float>(screen_width_) / static_cast<float>(screen_height_);
+        const float camera_distance = glm::length(position);
+        const int zoom = TileRenderer::ZoomForCameraDistance(camera_distance);
+
+        const std::int64_t n = std::int64_t{1} << zoom;
+        visible_.clear();
+        if (n * n <= 256) {
+            for (std::int32_t x = 0; x < n; ++x) {
+                for (std::int32_t y = 0; y < n; ++y) {
+                    visible_.emplace_back(x, y, zoom);
+                }
+            }
+        } else {
+            const float focal_length_px = TileSelector::FocalLengthPixels(
+                camera_->GetProjectionMatrix(aspect), static_cast<float>(screen_height_));
+            selector_.Select(position, camera_->GetFrustum(aspect), focal_length_px, zoom,
+                             render_config_.max_visible_tiles, visible_);
+        }
+
+        const TileCoordinates center = TilePrefetcher::WorldToTile(position, zoom);
+        coordinator_->SetUploadFocus(center);
+        coordinator_->UpdateEvictionPriorities(visible_, center);
+        coordinator_->BeginRequestGeneration();
+        const int priority = static_cast<int>(camera_distance * 10.0f);
+        coordinator_->RequestTiles(std::span<const TileCoordinates>(visible_), priority);
+        const std::vector<TileCoordinates> prefetch = prefetcher_.Update(
+            position, velocity, static_cast<float>(kFrameSeconds), visible_);
+        if (!prefetch.empty()) {
+            coordinator_->RequestTiles(prefetch, priority + TileRenderer::kPrefetchPriorityOffset);
+        }
+        coordinator_->CancelStaleRequests();
+
+        states_.resize(visible_.size());
+        coordinator_->QueryTiles(visible_, states_);
+    }
+
+    /**
+     * @brief Load the SRTM cells around a low stop, as the elevation manager would
+     */
+    void LoadTerrain(const FlightPlanner::Stop& stop) {
+        if (stop.altitude > kElevationAltitudeMeters) {
+            return;
+        }
+        const auto latitude = static_cast<std::int32_t>(std::floor(stop.latitude));
+        const auto longitude = static_cast<std::int32_t>(std::floor(stop.longitude));
+        for (std::int32_t dy = -1; dy <= 1; ++dy) {
+            for (std::int32_t dx = -1; dx <= 1; ++dx) {
+                SRTMCoordinates cell{latitude + dy, longitude + dx};
+                cell.longitude = (cell.longitude + 540) % 360 - 180;
+                if (!cell.IsValid() || elevation_->Get(cell)) {
+                    continue;
+                }
+                const SRTMMetadata metadata(cell, SRTMResolution::SRTM3);
+                std::vector<std::int16_t> samples(metadata.samples_per_side * metadata.samples_per_side);
+                for (std::size_t i = 0; i < samples.size(); ++i) {
+                    samples[i] = static_cast<std::int16_t>(500 + (i * 7) % 300);
+                }
+                elevation_->Put(SRTMTileData(metadata, std::move(samples)));
+            }
+        }
+    }
+
+    Sample TakeSample(double time) const {
+        Sample sample;
+        sample.hours = time / 3600.0;
+        auto& values = sample.values;
+
+        values[RSS_MB] = ResidentMegabytes();
+        std::tie(values[HEAP_IN_USE_MB], values[HEAP_FREE_MB]) = HeapMegabytes();
+
+        const TileCacheStats tiles = cache_->GetStatistics();
+        values[TILE_MEMORY_MB] = static_cast<double>(tiles.memory_cache_size) / kMegabyte;
+        values[TILE_MEMORY_COUNT] = static_cast<double>(tiles.memory_cache_count);
+        values[TILE_DISK_MB] = static_cast<double>(tiles.disk_cache_size) / kMegabyte;
+
+        const ElevationCacheStats elevation = elevation_->GetStatistics();
+        values[ELEVATION_MEMORY_MB] = static_cast<double>(elevation.memory_cache_size_bytes) / kMegabyte;
+        values[ELEVATION_DISK_MB] = static_cast<double>(elevation.disk_cache_size_bytes) / kMegabyte;
+
+        const TileStateMapSizes maps = coordinator_->GetStateMapSizes();
+        values[TILE_STATES] = static_cast<double>(maps.tile_states);
+        values[AWAITING_RENDER] = static_cast<double>(maps.awaiting_render);
+        values[POOL_TILES] = static_cast<double>(maps.pool_tiles);
+        values[PENDING_LOADS] = static_cast<double>(coordinator_->GetPendingLoadCount());
+        values[POOLED_BUFFER_MB] =
+            static_cast<double>(coordinator_->GetBufferPoolStats().pooled_bytes) / kMegabyte;
+
+        values[OPEN_FILES] = static_cast<double>(OpenFileCount());
+        values[THREADS] = static_cast<double>(ThreadCount());
+        return sample;
+    }
+
+    const SoakOptions& options_;
+    TileRenderConfig render_config_;
+    ScratchDirectory directory_;
+    MockTileServer server_;
+    FlightPlanner planner_;
+    std::shared_ptr<TileCache> cache_;
+    std::shared_ptr<TileLoader> loader_;
+    std::unique_ptr<ElevationCache> elevation_;
+    TileSelector selector_;
+    TilePrefetcher prefetcher_;
+    std::unique_ptr<TileTextureCoordinator> coordinator_;
+    std::unique_ptr<CameraController> camera_;
+    std::uint32_t screen_width_ = 0;
+    std::uint32_t screen_height_ = 0;
+
+    std::optional<Flight> flight_;
+    FlightPlanner::Stop stop_;
+    std::pmr::vector<TileCoordinates> visible_;
+    std::vector<TileTextureCoordinator::TileState> states_;
+};
+
+double Mean(const std::vector<Sample>& samples, std::size_t begin, std::size_t end, Metric metric) {
+    double sum = 0.0;
+    for (std::size_t i = begin; i < end; ++i) {
+        sum += samples[i].values[metric];
+    }
+    return sum / static_cast<double>(end - begin);
+}
+
+/**
+ * @brief Describe every series that grew past its tolerance or cap
+ */
+std::vector<std::string> FindUnboundedGrowth(const std::vector<Sample>& samples,
+                                             const std::array<MetricSpec, kMetricCount>& specs) {
+    std::vector<std::string> failures;
+    const std::size_t warmup = samples.size() / 4;
+    const std::size_t window = (samples.size() - warmup) / 4;
+
+    for (std::size_t metric = 0; metric < kMetricCount; ++metric) {
+        const MetricSpec& spec = specs[metric];
+        if (spec.limit > 0.0) {
+            for (const Sample& sample : samples) {
+                if (sample.values[metric] > spec.limit) {
+                    failures.push_back(std::string(spec.name) + " " +
+                                       std::to_string(sample.values[metric]) + " over its cap " +
+                                       std::to_string(spec.limit) + " at " +
+                                       std::to_string(sample.hours) + " h");
+                    break;
+                }
+            }
+        }
+        if (std::isinf(spec.relative_tolerance)) {
+            continue;
+        }
+        const auto id = static_cast<Metric>(metric);
+        const double baseline = Mean(samples, warmup, warmup + window, id);
+        const double latest = Mean(samples, samples.size() - window, samples.size(), id);
+        const double allowed = baseline * (1.0 + spec.relative_tolerance) + spec.absolute_tolerance;
+        if (latest > allowed) {
+            failures.push_back(std::string(spec.name) + " grew from " + std::to_string(baseline) +
+                               " to " + std::to_string(latest) + " (allowed " +
+                               std::to_string(allowed) + ")");
+        }
+    }
+    return failures;
+}
+
+std::optional<SoakOptions> ParseOptions(int argc, char** argv) {
+    SoakOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view argument = argv[i];
+        const std::size_t equals = argument.find('=');
+        if (argument.rfind("--", 0) != 0 || equals == std::string_view::npos) {
+            return std::nullopt;
+        }
+        const std::string_view name = argument.substr(2, equals - 2);
+        const std::string value(argument.substr(equals + 1));
+        if (name == "hours") {
+            options.hours = std::atof(value.c_str());
+        } else if (name == "acceleration") {
+            options.acceleration = std::atof(value.c_str());
+        } else if (name == "sample-minutes") {
+            options.sample_minutes = std::atof(value.c_str());
+        } else if (name == "seed") {
+            options.seed = static_cast<std::uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        } else if (name == "profile") {
+            options.profile = value;
+        } else if (name == "csv") {
+            options.csv_path = value;
+        } else {
+            return std::nullopt;
+        }
+    }
+    if (options.hours <= 0.0 || options.acceleration <= 0.0 || options.sample_minutes <= 0.0) {
+        return std::nullopt;
+    }
+    return options;
+}
+
+} // namespace
+
+} // namespace earth_map::tests
+
+int main(int argc, char** argv) {
+    using namespace earth_map::tests;
+
+    const std::optional<SoakOptions> options = ParseOptions(argc, argv);
+    if (!options) {
+        std::fprintf(stderr,
+                     "Usage: %s [--hours=4] [--acceleration=120] [--sample-minutes=5] [--seed=1]\n"
+                     "       [--profile=lan|broadband|mobile] [--csv=<file>]\n", argv[0]);
+        return 2;
+    }
+    const std::vector<NetworkProfile> profiles = DefaultNetworkProfiles();
+    const auto profile = std::find_if(profiles.begin(), profiles.end(),
+        [&](const NetworkProfile& p) { return p.name == options->profile; });
+    if (profile == profiles.end()) {
+        std::fprintf(stderr, "Unknown network profile: %s\n", options->profile.c_str());
+        return 2;
+    }
+
+    // Per-call info logs would swamp the samples
+    spdlog::set_level(spdlog::level::warn);
+
+    const std::array<MetricSpec, kMetricCount> specs = MetricSpecs(*options);
+    std::FILE* csv = options->csv_path.empty() ? nullptr : std::fopen(options->csv_path.c_str(), "w");
+    if (csv) {
+        std::fprintf(csv, "hours");
+        for (const MetricSpec& spec : specs) {
+            std::fprintf(csv, ",%s", spec.name);
+        }
+        std::fprintf(csv, "\n");
+    }
+
+    std::printf("Soak: %.2f h simulated, up to %.0fx real time, %s network, seed %u\n",
+                options->hours, options->acceleration, profile->name.c_str(), options->seed);
+    std::printf("%7s %9s %9s %6s %9s %9s %9s %7s %6s %6s\n", "hours", "rss_mb", "heap_mb",
+                "frag", "tiles_mb", "elev_mb", "states", "pool", "fds", "thr");
+
+    std::vector<Sample> samples;
+    {
+        SoakSession session(*options, *profile);
+        session.Run([&](const Sample& sample) {
+            const auto& v = sample.values;
+            const double heap = v[HEAP_IN_USE_MB] + v[HEAP_FREE_MB];
+            std::printf("%7.2f %9.1f %9.1f %5.1f%% %9.1f %9.1f %9.0f %7.0f %6.0f %6.0f\n",
+                        sample.hours, v[RSS_MB], v[HEAP_IN_USE_MB],
+                        heap > 0.0 ? 100.0 * v[HEAP_FREE_MB] / heap : 0.0, v[TILE_MEMORY_MB],
+                        v[ELEVATION_MEMORY_MB], v[TILE_STATES], v[POOL_TILES], v[OPEN_FILES],
+                        v[THREADS]);
+            std::fflush(stdout);
+            if (csv) {
+                std::fprintf(csv, "%.4f", sample.hours);
+                for (const double value : v) {
+                    std::fprintf(csv, ",%.3f", value);
+                }
+                std::fprintf(csv, "\n");
+            }
+            samples.push_back(sample);
+        });
+    }
+    if (csv) {
+        std::fclose(csv);
+    }
+
+    if (samples.size() < 8) {
+        std::fprintf(stderr, "Too few samples (%zu) to judge growth; run longer or sample more often\n",
+                     samples.size());
+        return 2;
+    }
+    const std::vector<std::string> failures = FindUnboundedGrowth(samples, specs);
+    for (const std::string& failure : failures) {
+        std::fprintf(stderr, "UNBOUNDED: %s\n", failure.c_str());
+    }
+    std::printf("%s\n", failures.empty() ? "All series bounded" : "Soak failed");
+    return failures.empty() ? 0 : 1;
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+/**
+ * @file loopback_http_server.h
+ * @brief Minimal HTTP/1.1 server on 127.0.0.1 for loader tests
+ */
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace earth_map::tests {
+
+/**
+ * @brief Serves one request per connection from a background thread
+ *
+ * The handler maps the raw request head to a full raw response.
+ */
+class LoopbackHttpServer {
+public:
+    using Handler = std::function<std::string(const std::string& request)>;
+
+    explicit LoopbackHttpServer(Handler handler) : handler_(std::move(handler)) {
+        listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        listen(listen_fd_, 16);
+        socklen_t length = sizeof(address);
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&address), &length);
+        port_ = ntohs(address.sin_port);
+        thread_ = std::thread([this] { Run(); });
+    }
+
+    ~LoopbackHttpServer() {
+        stop_ = true;
+        thread_.join();
+        close(listen_fd_);
+    }
+
+    std::string BaseUrl() const { return "http://127.0.0.1:" + std::to_string(port_); }
+
+    std::vector<std::string> GetRequests() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return requests_;
+    }
+
+private:
+    void Run() {
+        while (!stop_) {
+            pollfd descriptor{listen_fd_, POLLIN, 0};
+            if (poll(&descriptor, 1, 20) <= 0) {
+                continue;
+            }
+            const int client = accept(listen_fd_, nullptr, nullptr);
+            if (client < 0) {
+                continue;
+            }
+            std::string request;
+            char buffer[1024];
+            while (request.find("\r\n\r\n") == std::string::npos) {
+                const ssize_t received = recv(client, buffer, sizeof(buffer), 0);
+                if (received <= 0) {
+                    break;
+                }
+                request.append(buffer, static_cast<std::size_t>(received));
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                requests_.push_back(request);
+            }
+            const std::string response = handler_(request);
+            send(client, response.data(), response.size(), MSG_NOSIGNAL);
+            close(client);
+        }
+    }
+
+    Handler handler_;
+    int listen_fd_ = -1;
+    std::uint16_t port_ = 0;
+    std::atomic<bool> stop_{false};
+    mutable std::mutex mutex_;
+    std::vector<std::string> requests_;
+    std::thread thread_;
+};
+
+} // namespace earth_map::tests
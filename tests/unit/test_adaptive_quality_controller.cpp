@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/adaptive_quality_controller.h>
+#include <earth_map/renderer/lod_manager.h>
+
+namespace earth_map::tests {
+
+namespace {
+
+AdaptiveQualityConfig MakeConfig() {
+    AdaptiveQualityConfig config;
+    config.target_frame_ms = 10.0;
+    config.target_gpu_ms = 10.0;
+    config.degrade_frames = 3;
+    config.improve_frames = 5;
+    config.smoothing = 1.0;  // No smoothing: each frame is the load
+    config.max_level = 4;
+    return config;
+}
+
+/**
+ * @brief Feed @p frames identical frames; return how many changed the level
+ */
+int Feed(AdaptiveQualityController& controller, int frames, double cpu_ms, double gpu_ms) {
+    int changes = 0;
+    for (int i = 0; i < frames; ++i) {
+        changes += controller.Update(cpu_ms, gpu_ms) ? 1 : 0;
+    }
+    return changes;
+}
+
+} // namespace
+
+TEST(AdaptiveQualityControllerTest, DegradesAfterSustainedOverload) {
+    AdaptiveQualityController controller(MakeConfig());
+    EXPECT_EQ(Feed(controller, 2, 20.0, 0.0), 0);
+    EXPECT_EQ(controller.GetLevel(), 0u);
+    EXPECT_TRUE(controller.Update(20.0, 0.0));
+    EXPECT_EQ(controller.GetLevel(), 1u);
+}
+
+TEST(AdaptiveQualityControllerTest, GpuTimeAloneDrivesTheLoad) {
+    AdaptiveQualityController controller(MakeConfig());
+    Feed(controller, 3, 2.0, 15.0);
+    EXPECT_EQ(controller.GetLevel(), 1u);
+    EXPECT_NEAR(controller.GetLoad(), 1.5, 1e-9);
+}
+
+TEST(AdaptiveQualityControllerTest, HysteresisBandHoldsTheLevel) {
+    AdaptiveQualityController controller(MakeConfig());
+    Feed(controller, 3, 20.0, 0.0);
+    ASSERT_EQ(controller.GetLevel(), 1u);
+
+    // Between improve_load and degrade_load nothing changes
+    EXPECT_EQ(Feed(controller, 100, 9.0, 0.0), 0);
+    EXPECT_EQ(controller.GetLevel(), 1u);
+
+    // An overloaded frame interrupts the run of fast ones
+    Feed(controller, 4, 5.0, 0.0);
+    controller.Update(20.0, 0.0);
+    Feed(controller, 4, 5.0, 0.0);
+    EXPECT_EQ(controller.GetLevel(), 1u);
+    Feed(controller, 1, 5.0, 0.0);
+    EXPECT_EQ(controller.GetLevel(), 0u);
+}
+
+TEST(AdaptiveQualityControllerTest, LevelIsClampedToMax) {
+    AdaptiveQualityController controller(MakeConfig());
+    EXPECT_EQ(Feed(controller, 100, 50.0, 50.0), 4);
+    EXPECT_EQ(controller.GetLevel(), 4u);
+
+    controller.Reset();
+    EXPECT_EQ(controller.GetLevel(), 0u);
+    EXPECT_EQ(controller.GetLoad(), 0.0);
+}
+
+TEST(AdaptiveQualityControllerTest, SmoothingIgnoresSingleSpikes) {
+    AdaptiveQualityConfig config = MakeConfig();
+    config.smoothing = 0.1;
+    AdaptiveQualityController controller(config);
+    Feed(controller, 10, 8.0, 0.0);
+    for (int i = 0; i < 10; ++i) {
+        controller.Update(40.0, 0.0);
+        Feed(controller, 29, 8.0, 0.0);
+    }
+    EXPECT_EQ(controller.GetLevel(), 0u);
+}
+
+TEST(AdaptiveQualityControllerTest, ApplyScalesOnlyQualityFields) {
+    AdaptiveQualityController controller(MakeConfig());
+    Feed(controller, 6, 20.0, 0.0);
+    ASSERT_EQ(controller.GetLevel(), 2u);
+
+    TileRenderConfig full;
+    full.max_visible_tiles = 1000;
+    full.upload_budget_us = 2000;
+    full.selection.max_texel_error = 1.0f;
+    full.tile_fade_distance = 3.0f;
+    const TileRenderConfig scaled = controller.Apply(full);
+    EXPECT_GT(scaled.selection.max_texel_error, 1.0f);
+    EXPECT_LT(scaled.max_visible_tiles, 1000u);
+    EXPECT_LT(scaled.upload_budget_us, 2000u);
+    EXPECT_EQ(scaled.tile_fade_distance, 3.0f);
+    EXPECT_EQ(controller.GetSettings().resolution_scale, 1.0f);
+}
+
+TEST(AdaptiveQualityControllerTest, ResolutionScalesOnCoarseLevelsOnly) {
+    AdaptiveQualityConfig config = MakeConfig();
+    config.scale_resolution = true;
+    AdaptiveQualityController controller(config);
+    EXPECT_EQ(controller.GetSettings(2).resolution_scale, 1.0f);
+    EXPECT_LT(controller.GetSettings(3).resolution_scale, 1.0f);
+    EXPECT_GE(controller.GetSettings(4).resolution_scale, config.min_resolution_scale);
+}
+
+TEST(AdaptiveQualityControllerTest, DisabledControllerNeverChanges) {
+    AdaptiveQualityConfig config = MakeConfig();
+    config.enabled = false;
+    AdaptiveQualityController controller(config);
+    EXPECT_EQ(Feed(controller, 100, 100.0, 100.0), 0);
+    EXPECT_EQ(controller.GetLevel(), 0u);
+}
+
+TEST(AdaptiveQualityControllerTest, ConfigFromLodParams) {
+    LODParams params;
+    params.target_fps = 30.0f;
+    params.max_gpu_time = 20.0f;
+    params.enable_adaptive = false;
+    const AdaptiveQualityConfig config = MakeAdaptiveQualityConfig(params);
+    EXPECT_NEAR(config.target_frame_ms, 1000.0 / 30.0, 1e-9);
+    EXPECT_NEAR(config.target_gpu_ms, 20.0, 1e-6);
+    EXPECT_FALSE(config.enabled);
+}
+
+} // namespace earth_map::tests
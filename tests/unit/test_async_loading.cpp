@@ -0,0 +1,240 @@
+#include <gtest/gtest.h>
+#include <earth_map/core/executor.h>
+#include <earth_map/core/task.h>
+#include <earth_map/data/async_loading.h>
+#include <earth_map/renderer/texture_atlas/decode_thread_pool.h>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+/**
+ * @brief SRTM loader whose loads complete when the test says so
+ *
+ * LoadTileAsync answers inline (exercising the base-class
+ * LoadTileWithCallback fallback); with defer_ set, LoadTileWithCallback
+ * parks the callback until CompleteAll().
+ */
+class ManualSRTMLoader : public SRTMLoader {
+public:
+    explicit ManualSRTMLoader(bool defer) : defer_(defer) {}
+
+    bool Initialize(const SRTMLoaderConfig&) override { return true; }
+
+    SRTMLoadResult LoadTile(const SRTMCoordinates& coordinates) override {
+        SRTMLoadResult result;
+        result.success = true;
+        result.coordinates = coordinates;
+        result.file_size_bytes = static_cast<size_t>(coordinates.latitude * 1000 +
+                                                     coordinates.longitude);
+        return result;
+    }
+
+    std::future<SRTMLoadResult> LoadTileAsync(const SRTMCoordinates& coordinates,
+                                              SRTMLoadCallback callback) override {
+        std::promise<SRTMLoadResult> promise;
+        const SRTMLoadResult result = LoadTile(coordinates);
+        if (callback) {
+            callback(result);
+        }
+        promise.set_value(result);
+        return promise.get_future();
+    }
+
+    void LoadTileWithCallback(const SRTMCoordinates& coordinates,
+                              SRTMLoadCallback callback) override {
+        if (!defer_) {
+            SRTMLoader::LoadTileWithCallback(coordinates, std::move(callback));
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        parked_.emplace_back(coordinates, std::move(callback));
+    }
+
+    std::vector<std::future<SRTMLoadResult>> LoadTilesAsync(
+        const std::vector<SRTMCoordinates>&, SRTMLoadCallback) override {
+        return {};
+    }
+
+    bool CancelLoad(const SRTMCoordinates&) override { return false; }
+    void CancelAllLoads() override {}
+    SRTMLoaderStats GetStatistics() const override { return SRTMLoaderStats{}; }
+    SRTMLoaderConfig GetConfiguration() const override { return SRTMLoaderConfig{}; }
+    bool SetConfiguration(const SRTMLoaderConfig&) override { return true; }
+    bool IsLoading(const SRTMCoordinates&) const override { return false; }
+
+    size_t GetPendingLoadCount() const override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return parked_.size();
+    }
+
+    /// Complete every parked load on the calling thread
+    void CompleteAll() {
+        std::vector<std::pair<SRTMCoordinates, SRTMLoadCallback>> parked;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            parked.swap(parked_);
+        }
+        for (auto& [coordinates, callback] : parked) {
+            callback(LoadTile(coordinates));
+        }
+    }
+
+private:
+    const bool defer_;
+    mutable std::mutex mutex_;
+    std::vector<std::pair<SRTMCoordinates, SRTMLoadCallback>> parked_;
+};
+
+Task<int> Constant(int value) {
+    co_return value;
+}
+
+Task<int> Sum(int a, int b) {
+    const int x = co_await Constant(a);
+    const int y = co_await Constant(b);
+    co_return x + y;
+}
+
+Task<int> Throws() {
+    throw std::runtime_error("boom");
+    co_return 0;
+}
+
+Task<std::thread::id> ThreadAfterHop(Executor& executor) {
+    co_await ScheduleOn(executor);
+    co_return std::this_thread::get_id();
+}
+
+} // namespace
+
+TEST(TaskTest, IsLazyUntilAwaited) {
+    bool ran = false;
+    auto task = [](bool* flag) -> Task<void> {
+        *flag = true;
+        co_return;
+    }(&ran);
+
+    EXPECT_FALSE(ran);
+    EXPECT_FALSE(task.IsDone());
+    SyncWait(std::move(task));
+    EXPECT_TRUE(ran);
+}
+
+TEST(TaskTest, AwaitsNestedTasks) {
+    EXPECT_EQ(SyncWait(Sum(2, 40)), 42);
+}
+
+TEST(TaskTest, PropagatesExceptionsToTheAwaiter) {
+    EXPECT_THROW(SyncWait(Throws()), std::runtime_error);
+}
+
+TEST(TaskTest, WhenAllCollectsResultsInOrder) {
+    std::vector<Task<int>> tasks;
+    for (int i = 0; i < 5; ++i) {
+        tasks.push_back(Constant(i * i));
+    }
+
+    const std::vector<int> values = SyncWait(WhenAll(std::move(tasks)));
+    EXPECT_EQ(values, (std::vector<int>{0, 1, 4, 9, 16}));
+}
+
+TEST(TaskTest, WhenAllOfNothingCompletesImmediately) {
+    EXPECT_TRUE(SyncWait(WhenAll(std::vector<Task<int>>{})).empty());
+    SyncWait(WhenAll(std::vector<Task<void>>{}));
+}
+
+TEST(TaskTest, SpawnRunsToCompletion) {
+    std::atomic<int> counter{0};
+    auto increment = [](std::atomic<int>* value) -> Task<void> {
+        value->fetch_add(1);
+        co_return;
+    };
+
+    for (int i = 0; i < 10; ++i) {
+        Spawn(increment(&counter));
+    }
+    EXPECT_EQ(counter.load(), 10);
+}
+
+TEST(ExecutorTest, ScheduleOnMovesToThePool) {
+    DecodeThreadPool pool(2);
+    DecodePoolExecutor executor(pool);
+
+    EXPECT_NE(SyncWait(ThreadAfterHop(executor)), std::this_thread::get_id());
+}
+
+TEST(ExecutorTest, ScheduleOnStoppedPoolContinuesInline) {
+    DecodeThreadPool pool(1);
+    pool.Shutdown();
+    DecodePoolExecutor executor(pool);
+
+    EXPECT_EQ(SyncWait(ThreadAfterHop(executor)), std::this_thread::get_id());
+}
+
+TEST(AsyncLoadingTest, InlineCompletionDoesNotSuspend) {
+    ManualSRTMLoader loader(false);
+
+    const SRTMLoadResult result = SyncWait(LoadElevationTask(loader, SRTMCoordinates{46, 7}));
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(result.coordinates, (SRTMCoordinates{46, 7}));
+    EXPECT_EQ(result.file_size_bytes, 46007u);
+}
+
+TEST(AsyncLoadingTest, WaitsForAllNineTilesWithoutBlockingThreads) {
+    ManualSRTMLoader loader(true);
+
+    std::vector<Task<SRTMLoadResult>> loads;
+    for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+            loads.push_back(LoadElevationTask(loader, SRTMCoordinates{46 + dy, 7 + dx}));
+        }
+    }
+
+    std::atomic<bool> done{false};
+    std::vector<SRTMLoadResult> tiles;
+    auto gather = [](Task<std::vector<SRTMLoadResult>> all, std::vector<SRTMLoadResult>* out,
+                     std::atomic<bool>* flag) -> Task<void> {
+        *out = co_await std::move(all);
+        flag->store(true);
+    };
+    Spawn(gather(WhenAll(std::move(loads)), &tiles, &done));
+
+    // Every load was issued up front; nothing resumes until they complete
+    EXPECT_EQ(loader.GetPendingLoadCount(), 9u);
+    EXPECT_FALSE(done.load());
+
+    std::thread completer([&loader]() { loader.CompleteAll(); });
+    completer.join();
+
+    ASSERT_TRUE(done.load());
+    ASSERT_EQ(tiles.size(), 9u);
+    EXPECT_EQ(tiles.front().coordinates, (SRTMCoordinates{45, 6}));
+    EXPECT_EQ(tiles.back().coordinates, (SRTMCoordinates{47, 8}));
+}
+
+TEST(AsyncLoadingTest, ResumesOnRequestedExecutor) {
+    ManualSRTMLoader loader(true);
+    DecodeThreadPool pool(1);
+    DecodePoolExecutor executor(pool);
+
+    std::promise<std::thread::id> resumed_on;
+    auto load = [](SRTMLoader& srtm, Executor* on,
+                   std::promise<std::thread::id>* out) -> Task<void> {
+        co_await AsyncLoadElevation(srtm, SRTMCoordinates{0, 0}, on);
+        out->set_value(std::this_thread::get_id());
+    };
+    Spawn(load(loader, &executor, &resumed_on));
+
+    loader.CompleteAll();
+    const std::thread::id thread = resumed_on.get_future().get();
+    EXPECT_NE(thread, std::this_thread::get_id());
+}
+
+} // namespace earth_map::tests
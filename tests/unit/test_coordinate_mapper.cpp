@@ -11,6 +11,11 @@
 #include <earth_map/coordinates/coordinate_spaces.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <cmath>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 using namespace earth_map::coordinates;
 using namespace earth_map;
@@ -676,6 +681,77 @@ TEST_F(UtilityFunctionsTest, CalculateVisibleGeographicBounds_CoversReasonableAr
     EXPECT_LT(height, 180.0);
 }
 
+TEST_F(UtilityFunctionsTest, CalculateVisibleRegion_WholeHorizonCapInView) {
+    // From distance 3 the globe fits in the 45° view: the region is the
+    // horizon cap, acos(1/3) ≈ 70.53° around the sub-camera point
+    World camera(0.0f, 0.0f, 3.0f);
+    const VisibleRegion region =
+        CoordinateMapper::CalculateVisibleRegion(camera, view_matrix, proj_matrix);
+
+    ASSERT_EQ(region.rings.size(), 1u);
+    const double horizon = glm::degrees(std::acos(1.0 / 3.0));
+    EXPECT_NEAR(region.bounds.max.latitude, horizon, 1e-3);
+    EXPECT_NEAR(region.bounds.min.latitude, -horizon, 1e-3);
+    EXPECT_NEAR(region.west_longitude, -horizon, 1e-3);
+    EXPECT_NEAR(region.east_longitude, horizon, 1e-3);
+    EXPECT_FALSE(region.CrossesAntimeridian());
+    for (const Geographic& point : region.rings.front()) {
+        const glm::vec3 position = CoordinateMapper::GeographicToCartesian(point);
+        EXPECT_NEAR(glm::degrees(std::acos(position.z)), horizon, 1e-2);
+    }
+}
+
+TEST_F(UtilityFunctionsTest, CalculateVisibleRegion_GrazingViewReachesTheHorizon) {
+    // 0.01 above the equator, looking north along the surface: the frustum's
+    // lower half hits the globe, its upper half looks past the horizon
+    World camera(0.0f, 0.0f, 1.01f);
+    const glm::mat4 view = glm::lookAt(camera.position, camera.position + glm::vec3(0.0f, 1.0f, 0.0f),
+                                       glm::vec3(0.0f, 0.0f, 1.0f));
+    const VisibleRegion region = CoordinateMapper::CalculateVisibleRegion(camera, view, proj_matrix);
+
+    ASSERT_FALSE(region.IsEmpty());
+    EXPECT_GT(region.bounds.min.latitude, 0.0);
+    EXPECT_NEAR(region.bounds.max.latitude, glm::degrees(std::acos(1.0 / 1.01)), 1e-2);
+    EXPECT_LT(region.bounds.Width(), 10.0);
+
+    const GeographicBounds bounds =
+        CoordinateMapper::CalculateVisibleGeographicBounds(camera, view, proj_matrix);
+    EXPECT_NEAR(bounds.max.latitude, region.bounds.max.latitude, 1e-6);
+}
+
+TEST_F(UtilityFunctionsTest, CalculateVisibleRegion_CrossesAntimeridian) {
+    World camera(0.0f, 0.0f, -1.2f);
+    const glm::mat4 view = glm::lookAt(camera.position, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const VisibleRegion region = CoordinateMapper::CalculateVisibleRegion(camera, view, proj_matrix);
+
+    ASSERT_FALSE(region.IsEmpty());
+    EXPECT_TRUE(region.CrossesAntimeridian());
+    EXPECT_GT(region.west_longitude, 170.0);
+    EXPECT_LT(region.east_longitude, -170.0);
+    EXPECT_DOUBLE_EQ(region.bounds.Width(), 360.0);
+}
+
+TEST_F(UtilityFunctionsTest, CalculateVisibleRegion_ContainsPole) {
+    World camera(0.0f, 1.5f, 0.0f);
+    const glm::mat4 view = glm::lookAt(camera.position, glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    const VisibleRegion region = CoordinateMapper::CalculateVisibleRegion(camera, view, proj_matrix);
+
+    EXPECT_TRUE(region.contains_north_pole);
+    EXPECT_FALSE(region.contains_south_pole);
+    EXPECT_DOUBLE_EQ(region.bounds.max.latitude, 90.0);
+    EXPECT_DOUBLE_EQ(region.bounds.Width(), 360.0);
+}
+
+TEST_F(UtilityFunctionsTest, CalculateVisibleRegion_EmptyWhenLookingAway) {
+    World camera(0.0f, 0.0f, 3.0f);
+    const glm::mat4 view = glm::lookAt(camera.position, glm::vec3(0.0f, 0.0f, 6.0f),
+                                       glm::vec3(0.0f, 1.0f, 0.0f));
+
+    EXPECT_TRUE(CoordinateMapper::CalculateVisibleRegion(camera, view, proj_matrix).IsEmpty());
+    EXPECT_FALSE(
+        CoordinateMapper::CalculateVisibleGeographicBounds(camera, view, proj_matrix).IsValid());
+}
+
 // ============================================================================
 // Ray-Casting Bug Regression Tests (Phase 1)
 // ============================================================================
@@ -983,3 +1059,120 @@ TEST_F(RayCastingTest, RoundTrip_GeographicToScreenToGeographic) {
     EXPECT_NEAR(original.latitude, recovered.latitude, TOLERANCE_DEG);
     EXPECT_NEAR(original.longitude, recovered.longitude, TOLERANCE_DEG);
 }
+
+// ============================================================================
+// Batch (structure-of-arrays) Conversions
+// ============================================================================
+
+class BatchConversionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> lat(-90.0, 90.0);
+        std::uniform_real_distribution<double> lon(-180.0, 180.0);
+        // Enough points to take the multi-threaded path
+        const std::size_t count = CoordinateMapper::kParallelBatchMin + 123;
+        for (std::size_t i = 0; i < count; ++i) {
+            latitudes.push_back(lat(rng));
+            longitudes.push_back(lon(rng));
+        }
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        for (const auto& [bad_lat, bad_lon] : std::vector<std::pair<double, double>>{
+                 {91.0, 0.0}, {0.0, -181.0}, {nan, 0.0}, {89.9, 0.0}, {-85.06, 10.0},
+                 {90.0, 0.0}, {0.0, 180.0}}) {
+            latitudes.push_back(bad_lat);
+            longitudes.push_back(bad_lon);
+        }
+    }
+
+    std::vector<double> latitudes;
+    std::vector<double> longitudes;
+};
+
+TEST_F(BatchConversionTest, GeographicToWorld_MatchesScalar) {
+    const std::size_t n = latitudes.size();
+    std::vector<float> x(n), y(n), z(n);
+    CoordinateMapper::GeographicToWorld(latitudes, longitudes, x, y, z, 2.0f);
+    for (std::size_t i = 0; i < n; ++i) {
+        const World expected =
+            CoordinateMapper::GeographicToWorld(Geographic(latitudes[i], longitudes[i], 0.0), 2.0f);
+        ASSERT_NEAR(x[i], expected.position.x, 1e-6f) << i;
+        ASSERT_NEAR(y[i], expected.position.y, 1e-6f) << i;
+        ASSERT_NEAR(z[i], expected.position.z, 1e-6f) << i;
+    }
+
+    std::vector<float> short_out(3);
+    EXPECT_THROW(CoordinateMapper::GeographicToWorld(latitudes, longitudes, short_out, y, z),
+                 std::invalid_argument);
+}
+
+TEST_F(BatchConversionTest, WorldToGeographic_MatchesScalar) {
+    const std::size_t n = latitudes.size();
+    std::vector<float> x(n), y(n), z(n);
+    CoordinateMapper::GeographicToWorld(latitudes, longitudes, x, y, z);
+    // Lift points off the surface and keep one at the origin
+    for (std::size_t i = 0; i < n; ++i) {
+        const float scale = 1.0f + static_cast<float>(i % 7) * 0.1f;
+        x[i] *= scale;
+        y[i] *= scale;
+        z[i] *= scale;
+    }
+
+    std::vector<double> lat(n), lon(n), alt(n);
+    CoordinateMapper::WorldToGeographic(x, y, z, lat, lon, alt);
+    for (std::size_t i = 0; i < n; ++i) {
+        const Geographic expected =
+            CoordinateMapper::WorldToGeographic(World(glm::vec3(x[i], y[i], z[i])));
+        ASSERT_NEAR(alt[i], expected.altitude, 1e-6) << i;
+        // The scalar path takes asin of a float, which is coarse near the
+        // poles; compare against a double-precision reference instead
+        const double horizontal = std::hypot(double{x[i]}, double{z[i]});
+        ASSERT_NEAR(lat[i], glm::degrees(std::atan2(double{y[i]}, horizontal)), 1e-9) << i;
+        ASSERT_NEAR(lon[i], glm::degrees(std::atan2(double{x[i]}, double{z[i]})), 1e-9) << i;
+        if (std::abs(expected.latitude) < 89.0) {
+            ASSERT_NEAR(lat[i], expected.latitude, 1e-3) << i;
+            ASSERT_NEAR(lon[i], expected.longitude, 1e-3) << i;
+        }
+    }
+}
+
+TEST_F(BatchConversionTest, GeographicToProjected_MatchesScalar) {
+    const std::size_t n = latitudes.size();
+    std::vector<double> x(n), y(n);
+    CoordinateMapper::GeographicToProjected(latitudes, longitudes, x, y);
+    for (std::size_t i = 0; i < n; ++i) {
+        const Projected expected =
+            CoordinateMapper::GeographicToProjected(Geographic(latitudes[i], longitudes[i], 0.0));
+        ASSERT_EQ(std::isnan(x[i]), std::isnan(expected.x)) << i;
+        if (!std::isnan(expected.x)) {
+            ASSERT_NEAR(x[i], expected.x, 1e-6) << i;
+            ASSERT_NEAR(y[i], expected.y, 1e-6) << i;
+        }
+    }
+}
+
+TEST_F(BatchConversionTest, WorldToScreen_MatchesScalar) {
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 1.0f, 3.0f), glm::vec3(0.0f),
+                                       glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 proj = glm::perspective(glm::radians(45.0f), 4.0f / 3.0f, 0.1f, 100.0f);
+    const glm::ivec4 viewport(0, 0, 800, 600);
+
+    const std::size_t n = latitudes.size();
+    std::vector<float> x(n), y(n), z(n);
+    CoordinateMapper::GeographicToWorld(latitudes, longitudes, x, y, z);
+    std::vector<double> screen_x(n), screen_y(n);
+    CoordinateMapper::WorldToScreen(x, y, z, view, proj, viewport, screen_x, screen_y);
+
+    std::size_t visible = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const auto expected = CoordinateMapper::WorldToScreen(
+            World(glm::vec3(x[i], y[i], z[i])), view, proj, viewport);
+        ASSERT_EQ(expected.has_value(), !std::isnan(screen_x[i])) << i;
+        if (expected) {
+            ASSERT_DOUBLE_EQ(screen_x[i], expected->x) << i;
+            ASSERT_DOUBLE_EQ(screen_y[i], expected->y) << i;
+            ++visible;
+        }
+    }
+    EXPECT_GT(visible, 0u);
+}
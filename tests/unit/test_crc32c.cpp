@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/crc32c.h>
+#include <earth_map/data/tile_cache.h>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+std::span<const std::uint8_t> Bytes(const std::string& text) {
+    return {reinterpret_cast<const std::uint8_t*>(text.data()), text.size()};
+}
+
+} // namespace
+
+TEST(Crc32cTest, MatchesKnownVectors) {
+    EXPECT_EQ(Crc32c({}), 0u);
+    EXPECT_EQ(Crc32c(Bytes("123456789")), 0xE3069283u);
+    EXPECT_EQ(Crc32cSoftware(Bytes("123456789")), 0xE3069283u);
+
+    const std::vector<std::uint8_t> zeros(32, 0);
+    EXPECT_EQ(Crc32c(zeros), 0x8A9136AAu);
+    const std::vector<std::uint8_t> ones(32, 0xFF);
+    EXPECT_EQ(Crc32c(ones), 0x62A8AB43u);
+}
+
+TEST(Crc32cTest, HardwareMatchesSoftware) {
+    std::mt19937 rng(7);
+    std::vector<std::uint8_t> data(4099);
+    for (auto& byte : data) {
+        byte = static_cast<std::uint8_t>(rng());
+    }
+    // Every length and misalignment up to a few words, then a large block
+    for (std::size_t offset = 0; offset < 8; ++offset) {
+        for (std::size_t size = 0; size < 40; ++size) {
+            const std::span<const std::uint8_t> view(data.data() + offset, size);
+            EXPECT_EQ(Crc32c(view), Crc32cSoftware(view));
+        }
+    }
+    EXPECT_EQ(Crc32c(data), Crc32cSoftware(data));
+}
+
+TEST(Crc32cTest, ChainsAcrossCalls) {
+    const std::string text = "The quick brown fox jumps over the lazy dog";
+    const auto all = Bytes(text);
+    const std::uint32_t first = Crc32c(all.first(10));
+    EXPECT_EQ(Crc32c(all.subspan(10), first), Crc32c(all));
+}
+
+TEST(Crc32cTest, TileCacheDetectsCorruptedDiskTile) {
+    const auto directory = std::filesystem::temp_directory_path() / "earth_map_crc32c_cache";
+    std::filesystem::remove_all(directory);
+
+    TileCacheConfig config;
+    config.disk_cache_directory = directory.string();
+    config.enable_write_behind = false;
+
+    TileData tile;
+    tile.metadata.coordinates = TileCoordinates(3, 4, 5);
+    tile.metadata.last_modified = std::chrono::system_clock::now();
+    tile.data = std::vector<std::uint8_t>(64, 0x5A);
+    tile.metadata.file_size = tile.data.size();
+    {
+        auto cache = CreateTileCache(config);
+        ASSERT_TRUE(cache->Initialize(config));
+        ASSERT_TRUE(cache->Put(tile));
+        ASSERT_NE(cache->GetMetadata(tile.metadata.coordinates)->checksum, 0u);
+    }
+
+    // Intact tile verifies on a cold read
+    {
+        auto cache = CreateTileCache(config);
+        ASSERT_TRUE(cache->Initialize(config));
+        EXPECT_TRUE(cache->Get(tile.metadata.coordinates).has_value());
+        EXPECT_EQ(cache->GetStatistics().total_corruptions, 0u);
+    }
+
+    // Flip one payload byte behind the cache's back
+    {
+        std::fstream file(directory / "5" / "3_4.tile",
+                          std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(sizeof(std::uint64_t) + 10);
+        file.put(0x00);
+    }
+
+    auto cache = CreateTileCache(config);
+    ASSERT_TRUE(cache->Initialize(config));
+    EXPECT_FALSE(cache->Get(tile.metadata.coordinates).has_value());
+    EXPECT_EQ(cache->GetStatistics().total_corruptions, 1u);
+    EXPECT_FALSE(cache->Contains(tile.metadata.coordinates));
+
+    std::filesystem::remove_all(directory);
+}
+
+} // namespace earth_map::tests
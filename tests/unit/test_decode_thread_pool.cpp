@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/texture_atlas/decode_thread_pool.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace earth_map::tests {
+
+TEST(DecodeThreadPoolTest, DefaultsToHardwareConcurrency) {
+    DecodeThreadPool pool;
+
+    const std::size_t expected = std::max(1u, std::thread::hardware_concurrency());
+    EXPECT_EQ(pool.GetThreadCount(), expected);
+}
+
+TEST(DecodeThreadPoolTest, RunsAllSubmittedTasks) {
+    std::atomic<int> counter{0};
+    {
+        DecodeThreadPool pool(4);
+        for (int i = 0; i < 1000; ++i) {
+            EXPECT_TRUE(pool.Submit([&counter]() { counter.fetch_add(1); }));
+        }
+    }  // Destructor drains the queues
+
+    EXPECT_EQ(counter.load(), 1000);
+}
+
+TEST(DecodeThreadPoolTest, RejectsTasksAfterShutdown) {
+    DecodeThreadPool pool(2);
+    pool.Shutdown();
+
+    EXPECT_FALSE(pool.Submit([]() {}));
+    EXPECT_EQ(pool.GetPendingCount(), 0u);
+}
+
+TEST(DecodeThreadPoolTest, IdleWorkersStealFromBusyDeque) {
+    constexpr int kWorkers = 4;
+    DecodeThreadPool pool(kWorkers);
+
+    std::mutex ids_mutex;
+    std::set<std::thread::id> ids;
+    std::atomic<int> done{0};
+
+    // Every nested task lands on the submitting worker's own deque, so any
+    // other worker that runs one of them must have stolen it
+    pool.Submit([&]() {
+        for (int i = 0; i < 64; ++i) {
+            pool.Submit([&]() {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                {
+                    std::lock_guard<std::mutex> lock(ids_mutex);
+                    ids.insert(std::this_thread::get_id());
+                }
+                done.fetch_add(1);
+            });
+        }
+    });
+
+    // Shutdown rejects new tasks, so let the nested submissions finish first
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (done.load() < 64 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    pool.Shutdown();
+
+    EXPECT_EQ(done.load(), 64);
+    EXPECT_GT(ids.size(), 1u);
+    EXPECT_GT(pool.GetStealCount(), 0u);
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/disk_cache_collector.h>
+#include <earth_map/data/disk_cache_manifest.h>
+#include <earth_map/data/tile_cache.h>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace earth_map::tests {
+
+class DiskCacheCollectorTest : public ::testing::Test {
+protected:
+    using Clock = std::chrono::system_clock;
+
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() /
+                     (std::string("earth_map_collector_") +
+                      ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+        manifest_ = std::make_shared<DiskCacheManifest>(directory_.string());
+        manifest_->Load();
+        now_ = Clock::now();
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    /// Index tiles (x, 0, 10) with the given size, last access age and last modification age
+    void AddTile(int32_t x, std::uint64_t size, std::int64_t accessed_ago,
+                 std::int64_t modified_ago = 0) {
+        DiskCacheManifest::Entry entry;
+        entry.tile_size = size;
+        entry.last_access = DiskCacheManifest::ToSeconds(now_) - accessed_ago;
+        entry.last_modified = DiskCacheManifest::ToSeconds(now_) - modified_ago;
+        entries_.emplace_back(TileCoordinates(x, 0, 10), entry);
+        manifest_->Reset(entries_);
+    }
+
+    std::unique_ptr<DiskCacheCollector> MakeCollector(const DiskCacheBudget& budget,
+                                                      std::size_t per_tick = 256) {
+        DiskCacheCollectorConfig config;
+        config.max_deletions_per_tick = per_tick;
+        config.low_water_fraction = 1.0;
+        config.lower_priority = false;
+        return std::make_unique<DiskCacheCollector>(
+            manifest_, [budget] { return budget; },
+            [this](const TileCoordinates& coords) {
+                removed_.push_back(coords);
+                return manifest_->Remove(coords);
+            },
+            config);
+    }
+
+    std::filesystem::path directory_;
+    std::shared_ptr<DiskCacheManifest> manifest_;
+    std::vector<std::pair<TileCoordinates, DiskCacheManifest::Entry>> entries_;
+    std::vector<TileCoordinates> removed_;
+    Clock::time_point now_;
+};
+
+TEST_F(DiskCacheCollectorTest, RejectsMissingArguments) {
+    EXPECT_THROW(DiskCacheCollector(nullptr, [] { return DiskCacheBudget{}; },
+                                    [](const TileCoordinates&) { return true; }),
+                 std::invalid_argument);
+    EXPECT_THROW(DiskCacheCollector(manifest_, {}, [](const TileCoordinates&) { return true; }),
+                 std::invalid_argument);
+}
+
+TEST_F(DiskCacheCollectorTest, EvictsLeastRecentlyUsedDownToBudget) {
+    for (int32_t x = 0; x < 10; ++x) {
+        AddTile(x, 1000, 100 - x);  // x = 0 is the least recently used
+    }
+    auto collector = MakeCollector({6000, 1u << 30, TileCacheConfig::EvictionStrategy::LRU});
+
+    EXPECT_EQ(collector->Collect(now_), 4u);
+    EXPECT_EQ(manifest_->GetTotalSize(), 6000u);
+    ASSERT_EQ(removed_.size(), 4u);
+    EXPECT_EQ(removed_.front(), TileCoordinates(0, 0, 10));
+    EXPECT_EQ(removed_.back(), TileCoordinates(3, 0, 10));
+    EXPECT_EQ(collector->GetStats().evicted, 4u);
+    EXPECT_EQ(collector->GetStats().bytes_freed, 4000u);
+
+    // Within the budget: nothing more to do
+    EXPECT_EQ(collector->Collect(now_), 0u);
+}
+
+TEST_F(DiskCacheCollectorTest, SpreadsDeletionsOverTicks) {
+    for (int32_t x = 0; x < 10; ++x) {
+        AddTile(x, 1000, 100 - x);
+    }
+    auto collector = MakeCollector({5000, 1u << 30, TileCacheConfig::EvictionStrategy::LRU}, 2);
+
+    EXPECT_EQ(collector->Collect(now_), 2u);
+    EXPECT_EQ(manifest_->GetCount(), 8u);
+    EXPECT_EQ(collector->Collect(now_), 2u);
+    EXPECT_EQ(collector->Collect(now_), 1u);
+    EXPECT_EQ(collector->Collect(now_), 0u);
+    EXPECT_EQ(manifest_->GetTotalSize(), 5000u);
+}
+
+TEST_F(DiskCacheCollectorTest, KeepsVictimsReadSinceTheyWereOrdered) {
+    for (int32_t x = 0; x < 4; ++x) {
+        AddTile(x, 1000, 100 - x);
+    }
+    auto collector = MakeCollector({2000, 1u << 30, TileCacheConfig::EvictionStrategy::LRU}, 1);
+
+    EXPECT_EQ(collector->Collect(now_), 1u);
+    EXPECT_EQ(removed_.back(), TileCoordinates(0, 0, 10));
+
+    // The next victim in the order is read before the following tick
+    manifest_->Touch(TileCoordinates(1, 0, 10), now_);
+    EXPECT_EQ(collector->Collect(now_), 1u);
+    EXPECT_EQ(removed_.back(), TileCoordinates(2, 0, 10));
+    EXPECT_TRUE(manifest_->Find(TileCoordinates(1, 0, 10)).has_value());
+}
+
+TEST_F(DiskCacheCollectorTest, RemovesExpiredTilesWithinBudget) {
+    AddTile(0, 1000, 0, 3600);
+    AddTile(1, 1000, 0, 10);
+    auto collector = MakeCollector({1u << 30, 60, TileCacheConfig::EvictionStrategy::LRU});
+
+    EXPECT_EQ(collector->Collect(now_), 1u);
+    ASSERT_EQ(removed_.size(), 1u);
+    EXPECT_EQ(removed_.front(), TileCoordinates(0, 0, 10));
+    EXPECT_EQ(collector->GetStats().expired_removed, 1u);
+
+    // The next listing waits for the scan interval
+    EXPECT_EQ(collector->Collect(now_ + std::chrono::seconds(120)), 0u);
+    EXPECT_EQ(collector->Collect(now_ + std::chrono::hours(2)), 1u);
+}
+
+TEST_F(DiskCacheCollectorTest, ThreadEvictsWhenWoken) {
+    for (int32_t x = 0; x < 4; ++x) {
+        AddTile(x, 1000, 100 - x);
+    }
+    DiskCacheCollectorConfig config;
+    config.tick_interval = std::chrono::hours(1);
+    config.lower_priority = false;
+    DiskCacheCollector collector(
+        manifest_, [] { return DiskCacheBudget{2000, 1u << 30}; },
+        [this](const TileCoordinates& coords) { return manifest_->Remove(coords); }, config);
+
+    collector.Start();
+    collector.Wake();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (manifest_->GetTotalSize() > 1800 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    collector.Stop();
+
+    EXPECT_LE(manifest_->GetTotalSize(), 1800u);  // Default low-water mark: 90%
+}
+
+} // namespace earth_map::tests
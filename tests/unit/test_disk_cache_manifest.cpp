@@ -0,0 +1,265 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/disk_cache_manifest.h>
+#include <earth_map/data/tile_cache.h>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace earth_map::tests {
+
+class DiskCacheManifestTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() /
+                     (std::string("earth_map_manifest_") +
+                      ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    TileData MakeTile(int32_t x, int32_t y, int32_t zoom, std::size_t size) const {
+        TileData tile;
+        tile.metadata.coordinates = TileCoordinates(x, y, zoom);
+        tile.metadata.file_size = size;
+        tile.metadata.last_modified = std::chrono::system_clock::now();
+        tile.data = std::vector<std::uint8_t>(size, static_cast<std::uint8_t>(x));
+        tile.loaded = true;
+        return tile;
+    }
+
+    std::filesystem::path directory_;
+};
+
+TEST_F(DiskCacheManifestTest, FirstLoadReportsMissingManifest) {
+    DiskCacheManifest manifest(directory_.string());
+    EXPECT_FALSE(manifest.Load());
+    EXPECT_EQ(manifest.GetCount(), 0u);
+    EXPECT_EQ(manifest.GetTotalSize(), 0u);
+}
+
+TEST_F(DiskCacheManifestTest, JournalIsReplayedOnLoad) {
+    {
+        DiskCacheManifest manifest(directory_.string());
+        manifest.Load();
+        manifest.RecordTile(TileCoordinates(1, 2, 3), 1000, 42);
+        manifest.RecordMetadata(TileCoordinates(1, 2, 3), 64,
+                                std::chrono::system_clock::now(),
+                                std::chrono::system_clock::now());
+        manifest.RecordTile(TileCoordinates(4, 5, 6), 500, 7);
+        manifest.Remove(TileCoordinates(4, 5, 6));
+        EXPECT_EQ(manifest.GetJournalRecordCount(), 4u);
+    }
+
+    DiskCacheManifest manifest(directory_.string());
+    EXPECT_TRUE(manifest.Load());
+    EXPECT_EQ(manifest.GetCount(), 1u);
+    EXPECT_EQ(manifest.GetTotalSize(), 1064u);
+
+    auto entry = manifest.Find(TileCoordinates(1, 2, 3));
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(entry->checksum, 42u);
+    EXPECT_FALSE(manifest.Find(TileCoordinates(4, 5, 6)).has_value());
+
+    // Loading folds the journal into the snapshot
+    EXPECT_EQ(manifest.GetJournalRecordCount(), 0u);
+    EXPECT_EQ(std::filesystem::file_size(directory_ / "manifest.journal"), 0u);
+}
+
+TEST_F(DiskCacheManifestTest, TornJournalTailIsIgnored) {
+    {
+        DiskCacheManifest manifest(directory_.string());
+        manifest.Load();
+        manifest.RecordTile(TileCoordinates(1, 1, 1), 100, 1);
+        manifest.RecordTile(TileCoordinates(2, 2, 2), 200, 2);
+    }
+    {
+        std::ofstream journal(directory_ / "manifest.journal", std::ios::binary | std::ios::app);
+        journal << "torn";
+    }
+
+    DiskCacheManifest manifest(directory_.string());
+    EXPECT_TRUE(manifest.Load());
+    EXPECT_EQ(manifest.GetCount(), 2u);
+    EXPECT_EQ(manifest.GetTotalSize(), 300u);
+}
+
+TEST_F(DiskCacheManifestTest, CorruptSnapshotForcesRebuild) {
+    {
+        DiskCacheManifest manifest(directory_.string());
+        manifest.Load();
+        manifest.RecordTile(TileCoordinates(1, 1, 1), 100, 1);
+        ASSERT_TRUE(manifest.Checkpoint());
+    }
+    {
+        std::ofstream snapshot(directory_ / "manifest.bin", std::ios::binary | std::ios::trunc);
+        snapshot << std::string(40, 'x');
+    }
+
+    DiskCacheManifest manifest(directory_.string());
+    EXPECT_FALSE(manifest.Load());
+    EXPECT_EQ(manifest.GetCount(), 0u);
+}
+
+TEST_F(DiskCacheManifestTest, JournalIsCheckpointedWhenLarge) {
+    DiskCacheManifest manifest(directory_.string());
+    manifest.Load();
+    for (std::size_t i = 0; i <= DiskCacheManifest::kMinCheckpointRecords; ++i) {
+        manifest.RecordTile(TileCoordinates(1, 1, 1), i, 0);
+    }
+    EXPECT_LT(manifest.GetJournalRecordCount(), DiskCacheManifest::kMinCheckpointRecords);
+    EXPECT_EQ(manifest.GetCount(), 1u);
+    EXPECT_EQ(manifest.GetTotalSize(), DiskCacheManifest::kMinCheckpointRecords);
+}
+
+TEST_F(DiskCacheManifestTest, VictimIndexFollowsOrder) {
+    DiskCacheManifest manifest(directory_.string());
+    manifest.Load();
+    const auto base = std::chrono::system_clock::now();
+    for (int i = 0; i < 5; ++i) {
+        const TileCoordinates coords(i, 0, 4);
+        manifest.RecordTile(coords, 100 * static_cast<std::uint64_t>(i + 1), 0);
+        manifest.RecordMetadata(coords, 0, base - std::chrono::seconds(10 * i), base);
+        manifest.Touch(coords, base + std::chrono::seconds(i));
+    }
+
+    // Tile 0 was touched first; reading it again moves it to the back
+    manifest.Touch(TileCoordinates(0, 0, 4), base + std::chrono::seconds(60));
+    auto victims = manifest.CollectVictims(250);
+    ASSERT_EQ(victims.size(), 2u);
+    EXPECT_EQ(victims[0].first, TileCoordinates(1, 0, 4));
+    EXPECT_EQ(victims[1].first, TileCoordinates(2, 0, 4));
+
+    manifest.SetVictimOrder(DiskCacheManifest::VictimOrder::OLDEST_MODIFIED);
+    victims = manifest.CollectVictims(1);
+    ASSERT_EQ(victims.size(), 1u);
+    EXPECT_EQ(victims[0].first, TileCoordinates(4, 0, 4));
+
+    manifest.SetVictimOrder(DiskCacheManifest::VictimOrder::LARGEST);
+    manifest.Remove(TileCoordinates(4, 0, 4));
+    victims = manifest.CollectVictims(1);
+    ASSERT_EQ(victims.size(), 1u);
+    EXPECT_EQ(victims[0].first, TileCoordinates(3, 0, 4));
+    EXPECT_EQ(victims[0].second.tile_size, 400u);
+
+    EXPECT_EQ(manifest.CollectVictims(1u << 20).size(), 4u);
+    EXPECT_TRUE(manifest.CollectVictims(0).empty());
+}
+
+TEST_F(DiskCacheManifestTest, TileCacheCountsFromManifest) {
+    TileCacheConfig config;
+    config.disk_cache_directory = directory_.string();
+    config.enable_write_behind = false;
+    config.enable_compression = false;
+    {
+        auto cache = CreateTileCache(config);
+        ASSERT_TRUE(cache->Initialize(config));
+        for (int i = 0; i < 10; ++i) {
+            ASSERT_TRUE(cache->Put(MakeTile(i, 0, 4, 100)));
+        }
+        ASSERT_TRUE(cache->Remove(TileCoordinates(0, 0, 4)));
+    }
+
+    auto cache = CreateTileCache(config);
+    ASSERT_TRUE(cache->Initialize(config));
+    const TileCacheStats stats = cache->GetStatistics();
+    EXPECT_EQ(stats.disk_cache_count, 9u);
+    EXPECT_GT(stats.disk_cache_size, 9u * 100u);
+}
+
+TEST_F(DiskCacheManifestTest, TileCacheRebuildsMissingManifest) {
+    TileCacheConfig config;
+    config.disk_cache_directory = directory_.string();
+    config.enable_write_behind = false;
+    config.enable_compression = false;
+    {
+        auto cache = CreateTileCache(config);
+        ASSERT_TRUE(cache->Initialize(config));
+        ASSERT_TRUE(cache->Put(MakeTile(3, 7, 9, 100)));
+    }
+    std::filesystem::remove(directory_ / "manifest.bin");
+    std::filesystem::remove(directory_ / "manifest.journal");
+
+    auto cache = CreateTileCache(config);
+    ASSERT_TRUE(cache->Initialize(config));
+    EXPECT_EQ(cache->GetStatistics().disk_cache_count, 1u);
+}
+
+TEST_F(DiskCacheManifestTest, TileCacheEvictsOverDiskBudget) {
+    TileCacheConfig config;
+    config.disk_cache_directory = directory_.string();
+    config.enable_write_behind = false;
+    config.enable_compression = false;
+    config.max_disk_cache_size = 4096;
+    config.eviction_strategy = TileCacheConfig::EvictionStrategy::TIME_BASED;
+    config.enable_background_cleanup = false;  // Evict on the writing thread
+
+    auto cache = CreateTileCache(config);
+    ASSERT_TRUE(cache->Initialize(config));
+    for (int i = 0; i < 10; ++i) {
+        TileData tile = MakeTile(i, 0, 5, 1000);
+        tile.metadata.last_modified -= std::chrono::seconds(100 - i);  // Oldest first
+        ASSERT_TRUE(cache->Put(tile));
+    }
+
+    const TileCacheStats stats = cache->GetStatistics();
+    EXPECT_LE(stats.disk_cache_size, config.max_disk_cache_size);
+    EXPECT_LT(stats.disk_cache_count, 10u);
+    EXPECT_TRUE(std::filesystem::exists(directory_ / "5" / "9_0.tile"));
+}
+
+TEST_F(DiskCacheManifestTest, ConcurrentWritersDoNotOverEvict) {
+    TileCacheConfig config;
+    config.disk_cache_directory = directory_.string();
+    config.enable_write_behind = false;
+    config.enable_compression = false;
+    config.max_disk_cache_size = 16 * 1024;
+    config.enable_background_cleanup = false;
+
+    auto cache = CreateTileCache(config);
+    ASSERT_TRUE(cache->Initialize(config));
+    std::vector<std::thread> writers;
+    for (int t = 0; t < 4; ++t) {
+        writers.emplace_back([&, t] {
+            for (int i = 0; i < 25; ++i) {
+                cache->Put(MakeTile(t * 100 + i, 0, 7, 1000));
+            }
+        });
+    }
+    for (auto& writer : writers) {
+        writer.join();
+    }
+
+    // Eviction frees what the budget needs, not one excess per writer
+    const TileCacheStats stats = cache->GetStatistics();
+    EXPECT_LE(stats.disk_cache_size, config.max_disk_cache_size);
+    EXPECT_GE(stats.disk_cache_count, 10u);
+}
+
+TEST_F(DiskCacheManifestTest, TileCacheCollectorEvictsOverDiskBudget) {
+    TileCacheConfig config;
+    config.disk_cache_directory = directory_.string();
+    config.enable_write_behind = false;
+    config.enable_compression = false;
+    config.max_disk_cache_size = 4096;
+
+    auto cache = CreateTileCache(config);
+    ASSERT_TRUE(cache->Initialize(config));
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(cache->Put(MakeTile(i, 0, 5, 1000)));
+    }
+
+    // Writers only wake the collector thread
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (cache->GetStatistics().disk_cache_size > config.max_disk_cache_size &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    EXPECT_LE(cache->GetStatistics().disk_cache_size, config.max_disk_cache_size);
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <earth_map/core/flat_hash_map.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+/// Hash sending every key to a handful of buckets, forcing long probe chains
+struct CollidingHash {
+    std::size_t operator()(int key) const { return static_cast<std::size_t>(key & 3); }
+};
+
+} // namespace
+
+TEST(FlatHashMapTest, MatchesUnorderedMapUnderRandomEdits) {
+    FlatHashMap<int, std::string> map;
+    std::unordered_map<int, std::string> expected;
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> key(0, 5000);
+    for (int step = 0; step < 200000; ++step) {
+        const int k = key(rng);
+        switch (rng() % 4) {
+        case 0:
+        case 1:
+            map[k] = std::to_string(step);
+            expected[k] = std::to_string(step);
+            break;
+        case 2:
+            ASSERT_EQ(map.erase(k), expected.erase(k));
+            break;
+        default: {
+            const auto it = map.find(k);
+            const auto expected_it = expected.find(k);
+            ASSERT_EQ(it == map.end(), expected_it == expected.end());
+            if (it != map.end()) {
+                ASSERT_EQ(it->second, expected_it->second);
+            }
+        }
+        }
+        ASSERT_EQ(map.size(), expected.size());
+    }
+
+    std::size_t visited = 0;
+    for (const auto& [k, value] : map) {
+        ASSERT_EQ(expected.at(k), value);
+        ++visited;
+    }
+    EXPECT_EQ(visited, expected.size());
+}
+
+TEST(FlatHashMapTest, SurvivesCollisionsAndTombstones) {
+    FlatHashMap<int, int, CollidingHash> map;
+    for (int round = 0; round < 20; ++round) {
+        for (int i = 0; i < 300; ++i) {
+            EXPECT_TRUE(map.try_emplace(i, i * round).second);
+        }
+        EXPECT_FALSE(map.try_emplace(7, -1).second);
+        for (int i = 0; i < 300; ++i) {
+            ASSERT_EQ(map.find(i)->second, i * round);
+        }
+        // Erasing while iterating keeps the other iterators valid
+        for (auto it = map.begin(); it != map.end();) {
+            it = map.erase(it);
+        }
+        EXPECT_TRUE(map.empty());
+        EXPECT_FALSE(map.contains(5));
+    }
+}
+
+TEST(FlatHashMapTest, MovesAndCopiesOwningValues) {
+    FlatHashMap<int, std::unique_ptr<int>> map;
+    for (int i = 0; i < 1000; ++i) {
+        map[i] = std::make_unique<int>(i);
+    }
+    FlatHashMap<int, std::unique_ptr<int>> moved(std::move(map));
+    ASSERT_EQ(moved.size(), 1000u);
+    EXPECT_EQ(*moved.find(999)->second, 999);
+
+    FlatHashMap<int, std::string> strings;
+    strings.insert({1, "one"});
+    strings.emplace(2, "two");
+    FlatHashMap<int, std::string> copy = strings;
+    strings.clear();
+    EXPECT_EQ(copy.size(), 2u);
+    EXPECT_EQ(copy[2], "two");
+    EXPECT_EQ(strings.count(1), 0u);
+}
+
+TEST(FlatHashMapTest, TileMapKeysByTile) {
+    TileMap<int> tiles;
+    TileSet set;
+    std::unordered_set<TileCoordinates, TileCoordinatesHash> expected;
+    for (std::int32_t zoom = 0; zoom <= 12; ++zoom) {
+        const std::int32_t count = std::min(1 << zoom, 24);
+        for (std::int32_t x = 0; x < count; ++x) {
+            for (std::int32_t y = 0; y < count; ++y) {
+                const TileCoordinates tile(x, y, zoom);
+                tiles[tile] = zoom;
+                set.insert(tile);
+                expected.insert(tile);
+            }
+        }
+    }
+    // Tiles outside the quadtree range still hash
+    const TileCoordinates invalid(-3, 7, 2);
+    set.insert(invalid);
+    expected.insert(invalid);
+
+    EXPECT_EQ(tiles.size() + 1, expected.size());
+    EXPECT_EQ(set.size(), expected.size());
+    for (const TileCoordinates& tile : set) {
+        EXPECT_TRUE(expected.count(tile));
+    }
+    EXPECT_EQ(tiles[TileCoordinates(5, 6, 9)], 9);
+    EXPECT_TRUE(set.contains(invalid));
+    EXPECT_EQ(set.erase(invalid), 1u);
+    EXPECT_FALSE(set.contains(invalid));
+    EXPECT_NE(TileKeyHash{}(TileCoordinates(0, 0, 1)), TileKeyHash{}(TileCoordinates(0, 0, 2)));
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <earth_map/core/frame_arena.h>
+#include <cstdint>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+/// Allocate a frame's worth of temporaries from the arena
+void RunFrame(FrameArena& arena, std::size_t count) {
+    std::pmr::vector<std::uint64_t> values(arena.GetResource());
+    values.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        values.push_back(i);
+    }
+    std::pmr::vector<int> other(count / 2, 7, arena.GetResource());
+    ASSERT_EQ(values.back(), count - 1);
+    ASSERT_EQ(other.front(), 7);
+}
+
+} // namespace
+
+TEST(FrameArenaTest, SmallFramesStayInTheBlock) {
+    FrameArena arena(4096);
+    for (int frame = 0; frame < 10; ++frame) {
+        arena.Reset();
+        RunFrame(arena, 100);
+        EXPECT_EQ(arena.GetOverflowBytes(), 0u);
+    }
+    EXPECT_EQ(arena.GetCapacity(), 4096u);
+}
+
+TEST(FrameArenaTest, GrowsToTheFramePeak) {
+    FrameArena arena(1024);
+    RunFrame(arena, 10000);
+    EXPECT_GT(arena.GetOverflowBytes(), 0u);
+
+    // The next frame of the same size fits in the grown block
+    arena.Reset();
+    EXPECT_EQ(arena.GetOverflowBytes(), 0u);
+    EXPECT_GE(arena.GetCapacity(), 10000 * sizeof(std::uint64_t));
+    RunFrame(arena, 10000);
+    EXPECT_EQ(arena.GetOverflowBytes(), 0u);
+
+    const std::size_t capacity = arena.GetCapacity();
+    arena.Reset();
+    RunFrame(arena, 10);
+    arena.Reset();
+    EXPECT_EQ(arena.GetCapacity(), capacity);
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include <earth_map/math/frustum.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+Frustum MakeFrustum() {
+    const glm::mat4 projection =
+        glm::perspective(glm::radians(60.0f), 4.0f / 3.0f, 0.1f, 50.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 10.0f), glm::vec3(0.0f),
+                                       glm::vec3(0.0f, 1.0f, 0.0f));
+    return Frustum(projection * view);
+}
+
+/// Random boxes around the view volume in SoA layout
+struct Boxes {
+    std::vector<float> center[3];
+    std::vector<float> extent[3];
+    std::vector<float> axis[3][3];
+
+    Boxes(std::size_t count, unsigned seed) {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> position(-30.0f, 30.0f);
+        std::uniform_real_distribution<float> size(0.01f, 3.0f);
+        std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+        for (std::size_t i = 0; i < count; ++i) {
+            for (int c = 0; c < 3; ++c) {
+                center[c].push_back(position(rng));
+                extent[c].push_back(size(rng));
+            }
+            // Rotation about z, then about x
+            const float a = angle(rng);
+            const float b = angle(rng);
+            const glm::vec3 axes[3] = {
+                {std::cos(a), std::sin(a) * std::cos(b), std::sin(a) * std::sin(b)},
+                {-std::sin(a), std::cos(a) * std::cos(b), std::cos(a) * std::sin(b)},
+                {0.0f, -std::sin(b), std::cos(b)},
+            };
+            for (int ax = 0; ax < 3; ++ax) {
+                for (int c = 0; c < 3; ++c) {
+                    axis[ax][c].push_back(axes[ax][c]);
+                }
+            }
+        }
+    }
+
+    FrustumBoxBatch Batch(bool oriented) const {
+        FrustumBoxBatch batch;
+        for (int c = 0; c < 3; ++c) {
+            batch.center[c] = center[c].data();
+            batch.extent[c] = extent[c].data();
+            if (oriented) {
+                for (int ax = 0; ax < 3; ++ax) {
+                    batch.axis[ax][c] = axis[ax][c].data();
+                }
+            }
+        }
+        batch.count = center[0].size();
+        return batch;
+    }
+};
+
+bool Bit(const std::vector<std::uint64_t>& mask, std::size_t i) {
+    return (mask[i / 64] >> (i % 64)) & 1u;
+}
+
+} // namespace
+
+TEST(FrustumBatchTest, AxisAlignedMatchesSingleBoxTest) {
+    const Frustum frustum = MakeFrustum();
+    // Sizes around the SIMD group widths and mask word boundaries
+    for (const std::size_t count : {0u, 1u, 3u, 4u, 7u, 8u, 9u, 63u, 64u, 65u, 1000u}) {
+        const Boxes boxes(count, static_cast<unsigned>(count) + 1);
+        std::vector<std::uint64_t> mask(Frustum::BatchMaskWords(count) + 1, ~std::uint64_t{0});
+
+        frustum.IntersectsBatch(boxes.Batch(false), mask.data());
+
+        for (std::size_t i = 0; i < count; ++i) {
+            const glm::vec3 center(boxes.center[0][i], boxes.center[1][i], boxes.center[2][i]);
+            const glm::vec3 extent(boxes.extent[0][i], boxes.extent[1][i], boxes.extent[2][i]);
+            EXPECT_EQ(Bit(mask, i), frustum.Intersects(BoundingBox(center - extent, center + extent)))
+                << "box " << i << " of " << count;
+        }
+        // Bits past the last box are cleared, words past the mask are untouched
+        if (count % 64 != 0) {
+            EXPECT_EQ(mask[count / 64] >> (count % 64), 0u);
+        }
+        EXPECT_EQ(mask.back(), ~std::uint64_t{0});
+    }
+}
+
+TEST(FrustumBatchTest, OrientedMatchesScalar) {
+    const Frustum frustum = MakeFrustum();
+    const Boxes boxes(1027, 42);
+    const FrustumBoxBatch batch = boxes.Batch(true);
+
+    std::vector<std::uint64_t> simd(Frustum::BatchMaskWords(batch.count));
+    std::vector<std::uint64_t> scalar(simd.size());
+    frustum.IntersectsBatch(batch, simd.data());
+    frustum.IntersectsBatchScalar(batch, scalar.data());
+    EXPECT_EQ(simd, scalar);
+}
+
+TEST(FrustumBatchTest, OrientedBoxWithCornerInsideIsVisible) {
+    const Frustum frustum = MakeFrustum();
+    const Boxes boxes(500, 3);
+    std::vector<std::uint64_t> mask(Frustum::BatchMaskWords(500));
+    frustum.IntersectsBatch(boxes.Batch(true), mask.data());
+
+    for (std::size_t i = 0; i < 500; ++i) {
+        const glm::vec3 center(boxes.center[0][i], boxes.center[1][i], boxes.center[2][i]);
+        bool corner_inside = false;
+        for (int corner = 0; corner < 8; ++corner) {
+            glm::vec3 point = center;
+            for (int ax = 0; ax < 3; ++ax) {
+                const float sign = (corner >> ax) & 1 ? 1.0f : -1.0f;
+                const glm::vec3 axis(boxes.axis[ax][0][i], boxes.axis[ax][1][i], boxes.axis[ax][2][i]);
+                point += axis * (sign * boxes.extent[ax][i]);
+            }
+            corner_inside = corner_inside || frustum.Contains(point);
+        }
+        if (corner_inside) {
+            EXPECT_TRUE(Bit(mask, i)) << "box " << i;
+        }
+    }
+}
+
+} // namespace earth_map::tests
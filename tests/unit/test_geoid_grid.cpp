@@ -0,0 +1,188 @@
+#include <gtest/gtest.h>
+#include <earth_map/coordinates/altitude_reference.h>
+#include <earth_map/coordinates/coordinate_spaces.h>
+#include <earth_map/coordinates/geoid_grid.h>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace earth_map::tests {
+
+using coordinates::AltitudeConverter;
+using coordinates::AltitudeReference;
+using coordinates::Geographic;
+using coordinates::GeoidGrid;
+using coordinates::GeoidInterpolation;
+
+namespace {
+
+constexpr double kOffset = -108.0;
+constexpr double kScale = 0.003;
+
+/// Smooth synthetic undulation in meters
+double SyntheticHeight(double latitude, double longitude) {
+    const double lat = latitude * M_PI / 180.0;
+    const double lon = longitude * M_PI / 180.0;
+    return 10.0 + 40.0 * std::cos(lat) * std::sin(2.0 * lon) + 25.0 * std::sin(lat);
+}
+
+/// Write a GeographicLib-style geoid PGM sampling SyntheticHeight()
+void WriteGeoidPgm(const std::filesystem::path& path, double resolution) {
+    const auto width = static_cast<std::size_t>(std::lround(360.0 / resolution));
+    const auto height = static_cast<std::size_t>(std::lround(180.0 / resolution)) + 1;
+    std::ofstream out(path, std::ios::binary);
+    out << "P5\n# Geoid file in PGM format\n# Offset " << kOffset << "\n# Scale " << kScale
+        << "\n" << width << " " << height << "\n65535\n";
+    for (std::size_t row = 0; row < height; ++row) {
+        for (std::size_t column = 0; column < width; ++column) {
+            const double h = SyntheticHeight(90.0 - row * resolution, column * resolution);
+            const auto raw = static_cast<std::uint16_t>(std::lround((h - kOffset) / kScale));
+            out.put(static_cast<char>(raw >> 8));
+            out.put(static_cast<char>(raw & 0xff));
+        }
+    }
+}
+
+} // namespace
+
+class GeoidGridTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = std::filesystem::temp_directory_path() /
+                ("earth_map_geoid_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                 "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".pgm");
+        WriteGeoidPgm(path_, 1.0);
+    }
+
+    void TearDown() override {
+        AltitudeConverter::SetGeoidModel(nullptr);
+        std::filesystem::remove(path_);
+    }
+
+    std::filesystem::path path_;
+};
+
+TEST_F(GeoidGridTest, LoadsAndInterpolates) {
+    EXPECT_EQ(GeoidGrid::Load(path_.string() + ".missing"), nullptr);
+    {
+        std::ofstream(path_.string() + ".bad") << "P2\n3 3\n255\n";
+        EXPECT_EQ(GeoidGrid::Load(path_.string() + ".bad"), nullptr);
+        std::filesystem::remove(path_.string() + ".bad");
+    }
+
+    const auto grid = GeoidGrid::Load(path_.string());
+    ASSERT_NE(grid, nullptr);
+    EXPECT_EQ(grid->GetWidth(), 360u);
+    EXPECT_EQ(grid->GetHeight(), 181u);
+    EXPECT_DOUBLE_EQ(grid->GetResolution(), 1.0);
+
+    // Grid nodes reproduce the quantized samples
+    EXPECT_NEAR(grid->Sample(12.0, 34.0), SyntheticHeight(12.0, 34.0), kScale);
+    EXPECT_NEAR(grid->Sample(90.0, 0.0), SyntheticHeight(90.0, 0.0), kScale);
+    EXPECT_NEAR(grid->Sample(-90.0, 0.0), SyntheticHeight(-90.0, 0.0), kScale);
+
+    // Longitudes wrap across the antimeridian and the grid seam
+    EXPECT_DOUBLE_EQ(grid->Sample(10.25, -0.5), grid->Sample(10.25, 359.5));
+    EXPECT_DOUBLE_EQ(grid->Sample(10.25, 180.0), grid->Sample(10.25, -180.0));
+
+    // Between nodes, bicubic tracks the smooth surface more closely
+    double bilinear_error = 0.0;
+    double bicubic_error = 0.0;
+    for (double lat = -60.3; lat < 60.0; lat += 7.7) {
+        for (double lon = -179.6; lon < 180.0; lon += 11.3) {
+            const double expected = SyntheticHeight(lat, lon);
+            bilinear_error = std::max(bilinear_error, std::abs(grid->Sample(lat, lon) - expected));
+            bicubic_error = std::max(bicubic_error, std::abs(
+                grid->Sample(lat, lon, GeoidInterpolation::BICUBIC) - expected));
+        }
+    }
+    EXPECT_LT(bilinear_error, 0.1);
+    EXPECT_LT(bicubic_error, bilinear_error);
+}
+
+TEST_F(GeoidGridTest, BatchMatchesSinglePoints) {
+    const auto grid = GeoidGrid::Load(path_.string());
+    ASSERT_NE(grid, nullptr);
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> lat(-90.0, 90.0);
+    std::uniform_real_distribution<double> lon(-540.0, 540.0);
+    std::vector<double> lats(5000);
+    std::vector<double> lons(5000);
+    for (std::size_t i = 0; i < lats.size(); ++i) {
+        lats[i] = lat(rng);
+        lons[i] = lon(rng);
+    }
+
+    std::vector<double> heights(lats.size());
+    for (const GeoidInterpolation interpolation :
+         {GeoidInterpolation::BILINEAR, GeoidInterpolation::BICUBIC}) {
+        grid->SampleBatch(lats, lons, heights, interpolation);
+        for (std::size_t i = 0; i < lats.size(); ++i) {
+            // Cached tiles hold floats
+            ASSERT_NEAR(heights[i], grid->Sample(lats[i], lons[i], interpolation), 1e-4) << i;
+        }
+    }
+
+    std::vector<double> short_out(2);
+    EXPECT_THROW(grid->SampleBatch(lats, lons, short_out), std::invalid_argument);
+}
+
+TEST_F(GeoidGridTest, AltitudeConverterUsesModelInBatches) {
+    const Geographic location(45.5, 100.25, 0.0);
+    const double approximate = AltitudeConverter::GetGeoidHeight(location);
+
+    AltitudeConverter::SetGeoidModel(GeoidGrid::Load(path_.string()),
+                                     GeoidInterpolation::BICUBIC);
+    ASSERT_NE(AltitudeConverter::GetGeoidModel(), nullptr);
+    EXPECT_NEAR(AltitudeConverter::GetGeoidHeight(location),
+                SyntheticHeight(location.latitude, location.longitude), 0.05);
+    EXPECT_NE(AltitudeConverter::GetGeoidHeight(location), approximate);
+
+    std::vector<double> lats;
+    std::vector<double> lons;
+    std::vector<double> altitudes;
+    std::vector<double> terrain;
+    for (int i = 0; i < 1000; ++i) {
+        lats.push_back(-80.0 + 0.16 * i);
+        lons.push_back(-170.0 + 0.34 * i);
+        altitudes.push_back(100.0 + i);
+        terrain.push_back(50.0 + 0.5 * i);
+    }
+
+    const AltitudeReference references[] = {
+        AltitudeReference::WGS84_ELLIPSOID, AltitudeReference::MEAN_SEA_LEVEL,
+        AltitudeReference::TERRAIN, AltitudeReference::ABSOLUTE};
+    std::vector<double> converted(lats.size());
+    for (const AltitudeReference from : references) {
+        for (const AltitudeReference to : references) {
+            AltitudeConverter::Convert(altitudes, from, to, lats, lons, converted, terrain);
+            for (std::size_t i = 0; i < lats.size(); ++i) {
+                const double expected = AltitudeConverter::Convert(
+                    altitudes[i], from, to, Geographic(lats[i], lons[i], 0.0), terrain[i]);
+                ASSERT_NEAR(converted[i], expected, 1e-4) << i;
+            }
+        }
+    }
+
+    // In place, and without terrain when it is not needed
+    std::vector<double> in_place = altitudes;
+    AltitudeConverter::Convert(in_place, AltitudeReference::MEAN_SEA_LEVEL,
+                               AltitudeReference::WGS84_ELLIPSOID, lats, lons, in_place);
+    EXPECT_NEAR(in_place[0], altitudes[0] + AltitudeConverter::GetGeoidHeight(
+                                                Geographic(lats[0], lons[0], 0.0)), 1e-4);
+    EXPECT_THROW(AltitudeConverter::Convert(altitudes, AltitudeReference::TERRAIN,
+                                            AltitudeReference::WGS84_ELLIPSOID, lats, lons,
+                                            converted),
+                 std::invalid_argument);
+
+    AltitudeConverter::SetGeoidModel(nullptr);
+    EXPECT_DOUBLE_EQ(AltitudeConverter::GetGeoidHeight(location), approximate);
+}
+
+} // namespace earth_map::tests
@@ -4,6 +4,7 @@
 #include <thread>
 #include <vector>
 #include <atomic>
+#include <chrono>
 
 namespace earth_map::tests {
 
@@ -13,7 +14,8 @@ namespace earth_map::tests {
 class GLUploadQueueTest : public ::testing::Test {
 protected:
     void SetUp() override {
-        queue_ = std::make_unique<GLUploadQueue>();
+        // Large enough that no test except the backpressure ones fills it
+        queue_ = std::make_unique<GLUploadQueue>(16384);
     }
 
     void TearDown() override {
@@ -33,14 +35,8 @@ protected:
         cmd->height = height;
         cmd->channels = 3;
 
-        // Create dummy pixel data (RGB)
-        const std::size_t data_size = width * height * cmd->channels;
-        cmd->pixel_data.resize(data_size);
-
-        // Fill with test pattern
-        for (std::size_t i = 0; i < data_size; ++i) {
-            cmd->pixel_data[i] = static_cast<std::uint8_t>(i % 256);
-        }
+        // Staging slot derived from coordinates (pixels live in the ring)
+        cmd->slot.index = static_cast<std::uint32_t>(x * 1000 + y);
 
         return cmd;
     }
@@ -111,15 +107,7 @@ TEST_F(GLUploadQueueTest, DataIntegrity) {
     cmd->height = height;
     cmd->channels = channels;
 
-    // Create test pattern
-    const std::size_t data_size = width * height * channels;
-    cmd->pixel_data.resize(data_size);
-    for (std::size_t i = 0; i < data_size; ++i) {
-        cmd->pixel_data[i] = static_cast<std::uint8_t>((i * 13) % 256);
-    }
-
-    // Save copy for verification
-    std::vector<std::uint8_t> original_data = cmd->pixel_data;
+    cmd->slot.index = 17;
 
     queue_->Push(std::move(cmd));
     auto popped = queue_->TryPop();
@@ -128,8 +116,16 @@ TEST_F(GLUploadQueueTest, DataIntegrity) {
     EXPECT_EQ(popped->width, width);
     EXPECT_EQ(popped->height, height);
     EXPECT_EQ(popped->channels, channels);
-    EXPECT_EQ(popped->pixel_data.size(), data_size);
-    EXPECT_EQ(popped->pixel_data, original_data);
+    ASSERT_TRUE(popped->slot.IsValid());
+    EXPECT_EQ(popped->slot.index, 17u);
+}
+
+TEST_F(GLUploadQueueTest, FailureCommandHasNoSlot) {
+    queue_->Push(std::make_unique<GLUploadCommand>(TileCoordinates(1, 2, 3)));
+
+    auto popped = queue_->TryPop();
+    ASSERT_NE(popped, nullptr);
+    EXPECT_FALSE(popped->slot.IsValid());
 }
 
 TEST_F(GLUploadQueueTest, CallbackExecution) {
@@ -283,11 +279,12 @@ TEST_F(GLUploadQueueTest, ThreadSafety_NoDataCorruption) {
     // Verify all commands consumed
     EXPECT_EQ(consumed_commands.size(), num_threads * commands_per_thread);
 
-    // Verify no data corruption (all pixel data intact)
+    // Verify no data corruption (slot still matches its coordinates)
     for (const auto& cmd : consumed_commands) {
         ASSERT_NE(cmd, nullptr);
         EXPECT_TRUE(cmd->coords.IsValid());
-        EXPECT_EQ(cmd->pixel_data.size(), cmd->width * cmd->height * cmd->channels);
+        EXPECT_EQ(cmd->slot.index,
+                  static_cast<std::uint32_t>(cmd->coords.x * 1000 + cmd->coords.y));
     }
 }
 
@@ -296,7 +293,7 @@ TEST_F(GLUploadQueueTest, ThreadSafety_NoDataCorruption) {
 // ============================================================================
 
 TEST_F(GLUploadQueueTest, LargeCommandPayload) {
-    // Test with large image data (4K texture)
+    // Large images (4K texture) travel as a slot handle, not as pixel data
     constexpr std::uint32_t width = 4096;
     constexpr std::uint32_t height = 4096;
     constexpr std::uint8_t channels = 4;
@@ -306,21 +303,16 @@ TEST_F(GLUploadQueueTest, LargeCommandPayload) {
     cmd->width = width;
     cmd->height = height;
     cmd->channels = channels;
-
-    const std::size_t data_size = width * height * channels;
-    cmd->pixel_data.resize(data_size);
-
-    // Fill with pattern
-    for (std::size_t i = 0; i < data_size; ++i) {
-        cmd->pixel_data[i] = static_cast<std::uint8_t>(i % 256);
-    }
+    cmd->slot.index = 3;
 
     queue_->Push(std::move(cmd));
     EXPECT_EQ(queue_->Size(), 1u);
 
     auto popped = queue_->TryPop();
     ASSERT_NE(popped, nullptr);
-    EXPECT_EQ(popped->pixel_data.size(), data_size);
+    EXPECT_EQ(popped->width, width);
+    EXPECT_EQ(popped->height, height);
+    EXPECT_EQ(popped->slot.index, 3u);
 }
 
 TEST_F(GLUploadQueueTest, ManySmallCommands) {
@@ -343,4 +335,164 @@ TEST_F(GLUploadQueueTest, ManySmallCommands) {
     EXPECT_EQ(queue_->Size(), 0u);
 }
 
+// ============================================================================
+// Bounded Ring Tests
+// ============================================================================
+
+TEST(GLUploadQueueRingTest, CapacityRoundsUpToPowerOfTwo) {
+    EXPECT_EQ(GLUploadQueue(100).Capacity(), 128u);
+    EXPECT_EQ(GLUploadQueue(64).Capacity(), 64u);
+    EXPECT_EQ(GLUploadQueue(0).Capacity(), 2u);
+    EXPECT_EQ(GLUploadQueue().Capacity(), GLUploadQueue::kDefaultCapacity);
+}
+
+TEST(GLUploadQueueRingTest, NullCommandRejected) {
+    GLUploadQueue queue(4);
+    EXPECT_FALSE(queue.Push(nullptr));
+    EXPECT_TRUE(queue.Empty());
+}
+
+TEST(GLUploadQueueRingTest, WrapsAroundManyTimes) {
+    GLUploadQueue queue(4);
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(queue.Push(std::make_unique<GLUploadCommand>(TileCoordinates(i, 0, 10))));
+        auto popped = queue.TryPop();
+        ASSERT_NE(popped, nullptr);
+        EXPECT_EQ(popped->coords.x, i);
+    }
+    EXPECT_TRUE(queue.Empty());
+}
+
+TEST(GLUploadQueueRingTest, TryPopNReturnsBatchInOrder) {
+    GLUploadQueue queue(16);
+    for (int i = 0; i < 10; ++i) {
+        queue.Push(std::make_unique<GLUploadCommand>(TileCoordinates(i, 0, 10)));
+    }
+
+    std::vector<std::unique_ptr<GLUploadCommand>> batch;
+    EXPECT_EQ(queue.TryPopN(batch, 4), 4u);
+    EXPECT_EQ(queue.TryPopN(batch, 100), 6u);
+    EXPECT_EQ(queue.TryPopN(batch, 100), 0u);
+
+    ASSERT_EQ(batch.size(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(batch[i]->coords.x, i);
+    }
+}
+
+TEST(GLUploadQueueRingTest, FullQueueBlocksProducerUntilPop) {
+    GLUploadQueue queue(2);
+    ASSERT_TRUE(queue.Push(std::make_unique<GLUploadCommand>(TileCoordinates(0, 0, 1))));
+    ASSERT_TRUE(queue.Push(std::make_unique<GLUploadCommand>(TileCoordinates(1, 0, 1))));
+
+    std::atomic<bool> pushed{false};
+    std::thread producer([&]() {
+        queue.Push(std::make_unique<GLUploadCommand>(TileCoordinates(1, 1, 1)));
+        pushed.store(true);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(pushed.load());
+    EXPECT_EQ(queue.Size(), 2u);
+
+    ASSERT_NE(queue.TryPop(), nullptr);
+    producer.join();
+
+    EXPECT_TRUE(pushed.load());
+    EXPECT_EQ(queue.Size(), 2u);
+    EXPECT_EQ(queue.GetBlockedPushCount(), 1u);
+}
+
+TEST(GLUploadQueueRingTest, CloseReleasesBlockedProducer) {
+    GLUploadQueue queue(2);
+    queue.Push(std::make_unique<GLUploadCommand>(TileCoordinates(0, 0, 1)));
+    queue.Push(std::make_unique<GLUploadCommand>(TileCoordinates(1, 0, 1)));
+
+    std::atomic<int> result{-1};
+    std::thread producer([&]() {
+        result.store(queue.Push(std::make_unique<GLUploadCommand>(TileCoordinates(1, 1, 1))) ? 1 : 0);
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    queue.Close();
+    producer.join();
+
+    EXPECT_EQ(result.load(), 0);
+    EXPECT_TRUE(queue.IsClosed());
+    EXPECT_FALSE(queue.Push(std::make_unique<GLUploadCommand>(TileCoordinates(0, 1, 1))));
+
+    // Already queued commands are still delivered
+    EXPECT_NE(queue.TryPop(), nullptr);
+    EXPECT_NE(queue.TryPop(), nullptr);
+    EXPECT_EQ(queue.TryPop(), nullptr);
+}
+
+TEST(GLUploadQueueRingTest, TryPushSpillsInsteadOfBlocking) {
+    GLUploadQueue queue(2);
+    ASSERT_TRUE(queue.TryPush(std::make_unique<GLUploadCommand>(TileCoordinates(0, 0, 1))));
+    ASSERT_TRUE(queue.TryPush(std::make_unique<GLUploadCommand>(TileCoordinates(1, 0, 1))));
+    EXPECT_EQ(queue.GetOverflowPushCount(), 0u);
+
+    // Ring is full: returns right away instead of waiting for the consumer
+    ASSERT_TRUE(queue.TryPush(std::make_unique<GLUploadCommand>(TileCoordinates(2, 0, 1))));
+    ASSERT_TRUE(queue.TryPush(std::make_unique<GLUploadCommand>(TileCoordinates(3, 0, 1))));
+    EXPECT_EQ(queue.GetOverflowPushCount(), 2u);
+    EXPECT_EQ(queue.GetBlockedPushCount(), 0u);
+    EXPECT_EQ(queue.Size(), 4u);
+
+    // Overflowed commands are drained first, then the ring
+    std::vector<std::unique_ptr<GLUploadCommand>> batch;
+    EXPECT_EQ(queue.TryPopN(batch, 3), 3u);
+    auto last = queue.TryPop();
+    ASSERT_NE(last, nullptr);
+    EXPECT_EQ(batch[0]->coords.x, 2);
+    EXPECT_EQ(batch[1]->coords.x, 3);
+    EXPECT_EQ(batch[2]->coords.x, 0);
+    EXPECT_EQ(last->coords.x, 1);
+    EXPECT_TRUE(queue.Empty());
+
+    queue.Close();
+    EXPECT_FALSE(queue.TryPush(std::make_unique<GLUploadCommand>(TileCoordinates(0, 0, 1))));
+    EXPECT_FALSE(queue.TryPush(nullptr));
+}
+
+TEST(GLUploadQueueRingTest, BoundedUnderProducerPressure) {
+    constexpr int num_producers = 4;
+    constexpr int commands_per_producer = 500;
+    GLUploadQueue queue(8);
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < num_producers; ++t) {
+        producers.emplace_back([&queue, t]() {
+            for (int i = 0; i < commands_per_producer; ++i) {
+                queue.Push(std::make_unique<GLUploadCommand>(TileCoordinates(t, i, 10)));
+            }
+        });
+    }
+
+    // Per-producer FIFO order must hold, and the ring never exceeds capacity
+    std::vector<int> next_index(num_producers, 0);
+    int consumed = 0;
+    std::vector<std::unique_ptr<GLUploadCommand>> batch;
+    while (consumed < num_producers * commands_per_producer) {
+        EXPECT_LE(queue.Size(), queue.Capacity());
+        batch.clear();
+        queue.TryPopN(batch, 3);
+        for (const auto& cmd : batch) {
+            EXPECT_EQ(cmd->coords.y, next_index[cmd->coords.x]);
+            ++next_index[cmd->coords.x];
+            ++consumed;
+        }
+        if (batch.empty()) {
+            std::this_thread::yield();
+        }
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(queue.Empty());
+}
+
 } // namespace earth_map::tests
@@ -5,8 +5,14 @@
 
 #include <gtest/gtest.h>
 #include <earth_map/renderer/globe_mesh.h>
+#include <earth_map/math/tile_mathematics.h>
 #include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
 #include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
 
 using namespace earth_map;
 
@@ -85,6 +91,29 @@ TEST_F(GlobeMeshTest, GeographicCoordinates) {
     }
 }
 
+TEST_F(GlobeMeshTest, MercatorCoordinatesMatchTileAddressing) {
+    auto mesh = GlobeMesh::Create(params_);
+    ASSERT_NE(mesh, nullptr);
+    EXPECT_TRUE(mesh->Generate());
+
+    constexpr int kZoom = 8;
+    const float n = static_cast<float>(1 << kZoom);
+    for (const auto& vertex : mesh->GetVertices()) {
+        EXPECT_GE(vertex.mercator.x, 0.0f);
+        EXPECT_LE(vertex.mercator.x, 1.0f);
+        EXPECT_GE(vertex.mercator.y, 0.0f);
+        EXPECT_LE(vertex.mercator.y, 1.0f);
+        if (std::abs(vertex.geographic.y) > 85.0f || std::abs(vertex.geographic.x) >= 180.0f) {
+            continue;
+        }
+
+        const TileCoordinates tile = TileMathematics::GeographicToTile(
+            Geographic(vertex.geographic.y, vertex.geographic.x), kZoom);
+        EXPECT_NEAR(vertex.mercator.x * n, tile.x + 0.5f, 0.5f + 1e-3f);
+        EXPECT_NEAR(vertex.mercator.y * n, tile.y + 0.5f, 0.5f + 1e-3f);
+    }
+}
+
 TEST_F(GlobeMeshTest, VertexNormals) {
     auto mesh = GlobeMesh::Create(params_);
     ASSERT_NE(mesh, nullptr);
@@ -193,6 +222,243 @@ TEST_F(GlobeMeshTest, VertexIndexGeneration) {
     }
 }
 
+TEST_F(GlobeMeshTest, SubdivisionSharesEdgeVertices) {
+    params_.max_subdivision_level = 5;
+    auto mesh = GlobeMesh::Create(params_);
+    ASSERT_NE(mesh, nullptr);
+    EXPECT_TRUE(mesh->Generate());
+
+    // 10 * 4^level + 2 vertices, each used, and every edge shared by two
+    // triangles wound in opposite directions
+    const auto& vertices = mesh->GetVertices();
+    const auto& triangles = mesh->GetTriangles();
+    EXPECT_EQ(vertices.size(), 10u * 1024u + 2u);
+    EXPECT_EQ(triangles.size(), 20u * 1024u);
+    std::vector<bool> used(vertices.size(), false);
+    std::map<std::pair<std::uint32_t, std::uint32_t>, int> edges;
+    for (const auto& triangle : triangles) {
+        EXPECT_EQ(triangle.lod_level, 5);
+        for (int e = 0; e < 3; ++e) {
+            ASSERT_LT(triangle.vertices[e], vertices.size());
+            used[triangle.vertices[e]] = true;
+            ++edges[{triangle.vertices[e], triangle.vertices[(e + 1) % 3]}];
+        }
+        // Outward-facing
+        const glm::vec3& a = vertices[triangle.vertices[0]].position;
+        const glm::vec3& b = vertices[triangle.vertices[1]].position;
+        const glm::vec3& c = vertices[triangle.vertices[2]].position;
+        EXPECT_GT(glm::dot(glm::cross(b - a, c - a), a + b + c), 0.0f);
+    }
+    for (std::size_t i = 0; i < used.size(); ++i) {
+        EXPECT_TRUE(used[i]) << i;
+        EXPECT_NEAR(glm::length(vertices[i].position), params_.radius, params_.radius * 1e-6);
+    }
+    for (const auto& [edge, count] : edges) {
+        ASSERT_EQ(count, 1) << edge.first << "-" << edge.second;
+        ASSERT_EQ(edges.count({edge.second, edge.first}), 1u) << edge.first << "-" << edge.second;
+    }
+}
+
+TEST_F(GlobeMeshTest, OptimizeImprovesVertexCacheAndUses16BitChunks) {
+    params_.max_subdivision_level = 6;
+    auto mesh = GlobeMesh::Create(params_);
+    ASSERT_NE(mesh, nullptr);
+    EXPECT_TRUE(mesh->Generate());
+
+    // At least 30% fewer vertex shader invocations
+    const auto stats = mesh->GetDetailedStatistics();
+    EXPECT_GT(stats.acmr_before, 0.0f);
+    EXPECT_LT(stats.acmr_after, stats.acmr_before * 0.7f);
+    EXPECT_LT(stats.acmr_after, 0.8f);
+
+    // Corners keep their indices; the rest follow first use
+    const auto& vertices = mesh->GetVertices();
+    const auto indices = mesh->GetVertexIndices();
+    std::uint32_t next_new = 12;
+    for (const std::uint32_t index : indices) {
+        ASSERT_LT(index, vertices.size());
+        if (index >= 12) {
+            ASSERT_LE(index, next_new);
+            next_new = std::max(next_new, index + 1);
+        }
+    }
+    // Only the icosahedron corners have five triangles
+    std::vector<int> valence(vertices.size(), 0);
+    for (const std::uint32_t index : indices) {
+        ++valence[index];
+    }
+    for (std::size_t i = 0; i < valence.size(); ++i) {
+        EXPECT_EQ(valence[i] == 5, i < 12) << i;
+    }
+
+    // 40962 vertices fit a single 16-bit chunk covering the same triangles
+    const auto& chunks = mesh->GetIndexChunks();
+    const auto& indices16 = mesh->GetVertexIndices16();
+    ASSERT_EQ(chunks.size(), 1u);
+    EXPECT_EQ(stats.index_chunks, 1u);
+    ASSERT_EQ(indices16.size(), indices.size());
+    for (const auto& chunk : chunks) {
+        for (std::size_t i = chunk.first; i < chunk.first + chunk.count; ++i) {
+            ASSERT_EQ(chunk.base_vertex + indices16[i], indices[i]) << i;
+        }
+    }
+
+    // At level 7, vertices shared across faces cannot all fall within one
+    // 16-bit window: the mesh keeps 32-bit indices, still reordered
+    params_.max_subdivision_level = 7;
+    mesh = GlobeMesh::Create(params_);
+    EXPECT_TRUE(mesh->Generate());
+    const auto large_stats = mesh->GetDetailedStatistics();
+    ASSERT_TRUE(mesh->GetIndexChunks().empty());
+    EXPECT_EQ(large_stats.index_chunks, 0u);
+    EXPECT_TRUE(mesh->GetVertexIndices16().empty());
+    EXPECT_EQ(mesh->GetVertexIndices().size(), large_stats.triangle_count * 3);
+    EXPECT_LT(large_stats.acmr_after, large_stats.acmr_before * 0.7f);
+}
+
+class AdaptiveLodTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        params_.radius = 1.0;  // Unit sphere, as rendered
+        params_.max_subdivision_level = 9;
+        params_.enable_adaptive = true;
+        params_.max_screen_error = 8.0f;
+        params_.lod_triangle_budget = 30000;
+    }
+
+    /// Update the mesh for a camera at @p eye looking at the globe center
+    void Update(IcosahedronGlobeMesh& mesh, const glm::vec3& eye) const {
+        const glm::mat4 view = glm::lookAt(eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        const glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.01f, 10.0f);
+        ASSERT_TRUE(mesh.UpdateLOD(eye, view, projection, glm::vec2(1280.0f, 720.0f)));
+    }
+
+    /// Average subdivision level of triangles whose center lies along @p direction
+    static float AverageLevel(const IcosahedronGlobeMesh& mesh, const glm::vec3& direction) {
+        float total = 0.0f;
+        int count = 0;
+        for (const GlobeTriangle& triangle : mesh.GetTriangles()) {
+            const glm::vec3 center = mesh.GetVertices()[triangle.vertices[0]].position +
+                                     mesh.GetVertices()[triangle.vertices[1]].position +
+                                     mesh.GetVertices()[triangle.vertices[2]].position;
+            if (glm::dot(glm::normalize(center), direction) > 0.9f) {
+                total += triangle.lod_level;
+                ++count;
+            }
+        }
+        return count > 0 ? total / count : 0.0f;
+    }
+
+    /// Check the emitted triangles close the sphere: every edge is used once in each direction
+    static void ExpectWatertight(const IcosahedronGlobeMesh& mesh) {
+        const std::vector<std::uint32_t> indices = mesh.GetVertexIndices();
+        ASSERT_EQ(indices.size(), mesh.GetTriangles().size() * IcosahedronGlobeMesh::kIndicesPerLodTriangle);
+        std::map<std::pair<std::uint32_t, std::uint32_t>, int> edges;
+        for (std::size_t i = 0; i < indices.size(); i += 3) {
+            const std::uint32_t v[3] = {indices[i], indices[i + 1], indices[i + 2]};
+            if (v[0] == v[1] || v[1] == v[2] || v[2] == v[0]) {
+                continue;  // Padding
+            }
+            for (int e = 0; e < 3; ++e) {
+                ASSERT_LT(v[e], mesh.GetVertices().size());
+                ++edges[{v[e], v[(e + 1) % 3]}];
+            }
+        }
+        for (const auto& [edge, count] : edges) {
+            ASSERT_EQ(count, 1) << edge.first << "-" << edge.second;
+            ASSERT_EQ(edges.count({edge.second, edge.first}), 1u) << edge.first << "-" << edge.second;
+        }
+    }
+
+    GlobeMeshParams params_;
+};
+
+TEST_F(AdaptiveLodTest, RefinesNearCameraWithinBudget) {
+    // Refines from the base faces without a prior Generate()
+    IcosahedronGlobeMesh mesh(params_);
+    const glm::vec3 eye(0.0f, 0.0f, 1.2f);
+    Update(mesh, eye);
+    EXPECT_LE(mesh.GetTriangles().size(), params_.lod_triangle_budget);
+    EXPECT_GT(mesh.GetTriangles().size(), 20u);
+    EXPECT_GT(AverageLevel(mesh, glm::vec3(0.0f, 0.0f, 1.0f)),
+              AverageLevel(mesh, glm::vec3(0.0f, 0.0f, -1.0f)) + 2.0f);
+    EXPECT_TRUE(mesh.Validate());
+    ExpectWatertight(mesh);
+
+    // The first update rewrites the whole buffer
+    ASSERT_EQ(mesh.GetDirtyIndexRanges().size(), 1u);
+    EXPECT_EQ(mesh.GetDirtyIndexRanges()[0].first, 0u);
+    EXPECT_EQ(mesh.GetDirtyIndexRanges()[0].count, mesh.GetVertexIndices().size());
+
+    EXPECT_EQ(mesh.GetDirtyBaseRevision(), GlobeMesh::kNoBaseRevision);
+
+    // A still camera changes nothing
+    const std::size_t triangles = mesh.GetTriangles().size();
+    const std::uint64_t revision = mesh.GetRevision();
+    Update(mesh, eye);
+    EXPECT_TRUE(mesh.GetDirtyIndexRanges().empty());
+    EXPECT_EQ(mesh.GetTriangles().size(), triangles);
+    EXPECT_EQ(mesh.GetRevision(), revision);
+
+    // A small budget caps the triangle count; a generated mesh is replaced
+    params_.lod_triangle_budget = 500;
+    params_.max_subdivision_level = 6;
+    IcosahedronGlobeMesh small(params_);
+    ASSERT_TRUE(small.Generate());
+    Update(small, eye);
+    EXPECT_LE(small.GetTriangles().size(), 500u);
+    EXPECT_GT(small.GetTriangles().size(), 400u);
+    ExpectWatertight(small);
+}
+
+TEST_F(AdaptiveLodTest, DirtyRangesTrackIncrementalChanges) {
+    params_.lod_max_operations = 200;
+    IcosahedronGlobeMesh mesh(params_);
+    Update(mesh, glm::vec3(0.0f, 0.0f, 1.2f));
+
+    // Mirror of the GPU buffer, updated from the dirty ranges only
+    std::vector<std::uint32_t> uploaded = mesh.GetVertexIndices();
+    bool partial_update = false;
+    const glm::vec3 target(1.0f, 0.0f, 0.0f);
+    for (int frame = 0; frame < 200; ++frame) {
+        const float angle = std::min(frame, 20) * 0.05f * static_cast<float>(M_PI) / 2.0f;
+        const std::uint64_t previous_revision = mesh.GetRevision();
+        const std::uint64_t previous_base = mesh.GetDirtyBaseRevision();
+        const std::size_t previous_vertex_count = mesh.GetVertices().size();
+        Update(mesh, 1.2f * glm::vec3(std::sin(angle), 0.0f, std::cos(angle)));
+
+        // The revision advances by exactly one when something changed and the dirty ranges
+        // then apply to the previous revision; an idle frame leaves both untouched
+        const bool changed = !mesh.GetDirtyIndexRanges().empty() ||
+                             mesh.GetVertices().size() != previous_vertex_count;
+        EXPECT_EQ(mesh.GetRevision(), previous_revision + (changed ? 1u : 0u)) << "frame " << frame;
+        EXPECT_EQ(mesh.GetDirtyBaseRevision(), changed ? previous_revision : previous_base)
+            << "frame " << frame;
+
+        const std::vector<std::uint32_t>& indices = mesh.GetVertexIndices();
+        std::size_t dirty = 0;
+        std::size_t previous_end = 0;
+        uploaded.resize(indices.size());
+        for (const GlobeIndexRange& range : mesh.GetDirtyIndexRanges()) {
+            ASSERT_GE(range.first, previous_end);
+            ASSERT_LE(range.first + range.count, indices.size());
+            std::copy(indices.begin() + range.first, indices.begin() + range.first + range.count,
+                      uploaded.begin() + range.first);
+            previous_end = range.first + range.count;
+            dirty += range.count;
+        }
+        ASSERT_EQ(uploaded, indices) << "frame " << frame;
+        partial_update |= dirty > 0 && dirty < indices.size() / 2;
+        EXPECT_LE(mesh.GetTriangles().size(), params_.lod_triangle_budget);
+    }
+    EXPECT_TRUE(partial_update);
+
+    // Detail followed the camera
+    EXPECT_GT(AverageLevel(mesh, target), AverageLevel(mesh, glm::vec3(0.0f, 0.0f, 1.0f)) + 1.0f);
+    EXPECT_TRUE(mesh.Validate());
+    ExpectWatertight(mesh);
+}
+
 class GlobeMeshPerformanceTest : public ::testing::Test {
 protected:
     void SetUp() override {
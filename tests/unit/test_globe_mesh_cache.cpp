@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/globe_mesh.h>
+#include <earth_map/renderer/globe_mesh_cache.h>
+#include <filesystem>
+#include <fstream>
+
+namespace earth_map::tests {
+
+class GlobeMeshCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() /
+                     (std::string("earth_map_meshes_") +
+                      ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(directory_);
+        params_.max_subdivision_level = 3;
+        params_.enable_adaptive = false;
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    std::unique_ptr<IcosahedronGlobeMesh> GenerateWithCache(
+        const std::shared_ptr<GlobeMeshCache>& cache) const {
+        auto mesh = std::make_unique<IcosahedronGlobeMesh>(params_);
+        mesh->SetMeshCache(cache);
+        EXPECT_TRUE(mesh->Generate());
+        return mesh;
+    }
+
+    std::filesystem::path directory_;
+    GlobeMeshParams params_;
+};
+
+TEST_F(GlobeMeshCacheTest, SecondGenerateLoadsIdenticalMesh) {
+    auto cache = std::make_shared<GlobeMeshCache>(directory_.string());
+    const auto generated = GenerateWithCache(cache);
+    EXPECT_EQ(cache->GetStats().misses, 1u);
+    EXPECT_EQ(cache->GetStats().stores, 1u);
+
+    const auto loaded = GenerateWithCache(cache);
+    EXPECT_EQ(cache->GetStats().hits, 1u);
+    ASSERT_EQ(loaded->GetVertices().size(), generated->GetVertices().size());
+    for (std::size_t i = 0; i < loaded->GetVertices().size(); ++i) {
+        EXPECT_EQ(loaded->GetVertices()[i], generated->GetVertices()[i]);
+    }
+    EXPECT_EQ(loaded->GetTriangles().size(), generated->GetTriangles().size());
+    EXPECT_EQ(loaded->GetVertexIndices(), generated->GetVertexIndices());
+    EXPECT_EQ(loaded->GetVertexIndices16(), generated->GetVertexIndices16());
+    EXPECT_EQ(loaded->GetIndexChunks().size(), generated->GetIndexChunks().size());
+    EXPECT_FLOAT_EQ(loaded->GetDetailedStatistics().acmr_after,
+                    generated->GetDetailedStatistics().acmr_after);
+    EXPECT_TRUE(loaded->Validate());
+}
+
+TEST_F(GlobeMeshCacheTest, KeyDependsOnParameters) {
+    GlobeMeshParams other = params_;
+    EXPECT_EQ(GlobeMeshCache::MakeKey(params_), GlobeMeshCache::MakeKey(other));
+    other.max_subdivision_level = 4;
+    EXPECT_NE(GlobeMeshCache::MakeKey(params_), GlobeMeshCache::MakeKey(other));
+    other = params_;
+    other.radius = 1.0;
+    EXPECT_NE(GlobeMeshCache::MakeKey(params_), GlobeMeshCache::MakeKey(other));
+}
+
+TEST_F(GlobeMeshCacheTest, CorruptFileIsRegenerated) {
+    auto cache = std::make_shared<GlobeMeshCache>(directory_.string());
+    const auto generated = GenerateWithCache(cache);
+
+    std::filesystem::path file;
+    for (const auto& entry : std::filesystem::directory_iterator(directory_)) {
+        file = entry.path();
+    }
+    {
+        std::fstream stream(file, std::ios::in | std::ios::out | std::ios::binary);
+        stream.seekp(-1, std::ios::end);
+        stream.put('\x7f');
+    }
+
+    const auto regenerated = GenerateWithCache(cache);
+    EXPECT_EQ(cache->GetStats().rejected, 1u);
+    EXPECT_EQ(cache->GetStats().stores, 2u);
+    EXPECT_EQ(regenerated->GetVertexIndices(), generated->GetVertexIndices());
+
+    // Truncated file
+    std::filesystem::resize_file(file, 16);
+    EXPECT_FALSE(cache->Load(GlobeMeshCache::MakeKey(params_)).has_value());
+    EXPECT_EQ(cache->GetStats().rejected, 2u);
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,160 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/globe_mesh.h>
+#include <earth_map/renderer/globe_vertex_format.h>
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+double AngleBetween(const glm::vec3& a, const glm::vec3& b) {
+    // atan2 stays accurate for tiny angles, where acos of a float dot does not
+    const glm::dvec3 da(a);
+    const glm::dvec3 db(b);
+    return std::atan2(glm::length(glm::cross(da, db)), glm::dot(da, db));
+}
+
+/// CPU copy of the texture coordinate derivation in the globe vertex shader
+glm::vec2 DeriveTexCoord(const glm::vec3& position) {
+    const glm::vec3 direction = glm::normalize(position);
+    const float lon = (direction.x == 0.0f && direction.z == 0.0f)
+        ? 0.0f : std::atan2(direction.x, direction.z);
+    const float lat = std::asin(std::clamp(direction.y, -1.0f, 1.0f));
+    return glm::vec2((lon + static_cast<float>(M_PI)) / (2.0f * static_cast<float>(M_PI)),
+                     (lat + 0.5f * static_cast<float>(M_PI)) / static_cast<float>(M_PI));
+}
+
+/// Web Mercator of a point in double precision, projected radially onto the sphere
+glm::dvec2 ExactMercator(const glm::dvec3& point) {
+    const double lon = std::atan2(point.x, point.z);
+    const double lat = std::asin(point.y / glm::length(point));
+    return glm::dvec2((lon + M_PI) / (2.0 * M_PI),
+                      (1.0 - std::log(std::tan(0.25 * M_PI + 0.5 * lat)) / M_PI) * 0.5);
+}
+
+} // namespace
+
+TEST(GlobeVertexFormatTest, OctahedralNormalsRoundTrip) {
+    std::vector<glm::vec3> normals = {
+        {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1},
+        glm::normalize(glm::vec3(1, 1, -1)), glm::normalize(glm::vec3(-1, -1, -1))};
+    std::mt19937 rng(11);
+    std::normal_distribution<float> component(0.0f, 1.0f);
+    for (int i = 0; i < 20000; ++i) {
+        normals.push_back(glm::normalize(glm::vec3(component(rng), component(rng), component(rng))));
+    }
+
+    double max_error = 0.0;
+    for (const glm::vec3& normal : normals) {
+        const glm::vec3 decoded = DecodeOctahedralNormal(EncodeOctahedralNormal(normal));
+        EXPECT_NEAR(glm::length(decoded), 1.0f, 1e-5f);
+        max_error = std::max(max_error, AngleBetween(normal, decoded));
+    }
+    EXPECT_LT(max_error, 1e-4);
+
+    // Degenerate input still decodes to a unit vector
+    const glm::vec3 fallback = DecodeOctahedralNormal(EncodeOctahedralNormal(glm::vec3(0.0f)));
+    EXPECT_NEAR(glm::length(fallback), 1.0f, 1e-5f);
+}
+
+TEST(GlobeVertexFormatTest, PacksMeshVertices) {
+    static_assert(sizeof(PackedGlobeVertex) == 16);
+    static_assert(offsetof(PackedGlobeVertex, normal) == 12);
+    EXPECT_LE(sizeof(PackedGlobeVertex) * 5 / 2, 10 * sizeof(float));
+
+    GlobeMeshParams params;
+    params.max_subdivision_level = 3;
+    params.enable_adaptive = false;
+    auto mesh = GlobeMesh::Create(params);
+    ASSERT_TRUE(mesh->Generate());
+    const auto& vertices = mesh->GetVertices();
+    ASSERT_FALSE(vertices.empty());
+
+    const std::vector<PackedGlobeVertex> packed = PackGlobeVertices(vertices);
+    ASSERT_EQ(packed.size(), vertices.size());
+    for (std::size_t i = 0; i < vertices.size(); ++i) {
+        EXPECT_EQ(packed[i].position, vertices[i].position);
+        EXPECT_LT(AngleBetween(DecodeOctahedralNormal(packed[i].normal),
+                               glm::normalize(vertices[i].normal)), 1e-4);
+    }
+
+    std::vector<PackedGlobeVertex> short_out(1);
+    EXPECT_THROW(PackGlobeVertices(vertices, short_out), std::invalid_argument);
+}
+
+TEST(GlobeVertexFormatTest, ShaderDerivedCoordinatesMatchMesh) {
+    GlobeMeshParams params;
+    params.max_subdivision_level = 4;
+    params.enable_adaptive = false;
+    auto mesh = GlobeMesh::Create(params);
+    ASSERT_TRUE(mesh->Generate());
+
+    std::size_t compared = 0;
+    for (const GlobeVertex& vertex : mesh->GetVertices()) {
+        // The seam and poles are ambiguous in longitude
+        const glm::vec3 direction = glm::normalize(vertex.position);
+        if (std::abs(direction.y) > 0.999f ||
+            (direction.z < 0.0f && std::abs(direction.x) < 1e-4f)) {
+            continue;
+        }
+        const glm::vec2 texcoord = DeriveTexCoord(vertex.position);
+        const glm::vec2 mercator = DirectionToMercator(vertex.position);
+        EXPECT_NEAR(texcoord.x, vertex.texcoord.x, 1e-5f);
+        EXPECT_NEAR(texcoord.y, vertex.texcoord.y, 1e-5f);
+        EXPECT_NEAR(mercator.x, vertex.mercator.x, 1e-5f);
+        EXPECT_NEAR(mercator.y, vertex.mercator.y, 1e-4f);
+        ++compared;
+    }
+    EXPECT_GT(compared, 2000u);
+}
+
+TEST(GlobeVertexFormatTest, MidTriangleMercatorMatchesProjection) {
+    // Coarse triangles, where Mercator bends most across a triangle
+    GlobeMeshParams params;
+    params.max_subdivision_level = 2;
+    params.enable_adaptive = false;
+    auto mesh = GlobeMesh::Create(params);
+    ASSERT_TRUE(mesh->Generate());
+    const auto& vertices = mesh->GetVertices();
+
+    double fragment_error = 0.0;
+    double vertex_error = 0.0;
+    std::size_t compared = 0;
+    for (const GlobeTriangle& triangle : mesh->GetTriangles()) {
+        const GlobeVertex& a = vertices[triangle.vertices[0]];
+        const GlobeVertex& b = vertices[triangle.vertices[1]];
+        const GlobeVertex& c = vertices[triangle.vertices[2]];
+        // Skip triangles on the antimeridian or beyond the Mercator latitude limit
+        bool skip = false;
+        for (const GlobeVertex* vertex : {&a, &b, &c}) {
+            const glm::vec3 direction = glm::normalize(vertex->position);
+            skip = skip || std::abs(direction.y) > 0.99f || direction.z < 0.0f;
+        }
+        if (skip) {
+            continue;
+        }
+
+        // The fragment at the centroid interpolates the vertex directions
+        const glm::vec3 direction = (glm::normalize(a.position) + glm::normalize(b.position) +
+                                     glm::normalize(c.position)) / 3.0f;
+        const glm::dvec2 exact = ExactMercator(glm::dvec3(direction));
+        const glm::dvec2 per_fragment(DirectionToMercator(direction));
+        const glm::dvec2 per_vertex(glm::vec2((a.mercator + b.mercator + c.mercator) / 3.0f));
+        fragment_error = std::max(fragment_error, glm::length(per_fragment - exact));
+        vertex_error = std::max(vertex_error, glm::length(per_vertex - exact));
+        ++compared;
+    }
+    ASSERT_GT(compared, 20u);
+    // Float precision, not the projection's curvature
+    EXPECT_LT(fragment_error, 1e-6);
+    // What interpolating the projected vertices used to give
+    EXPECT_GT(vertex_error, 100.0 * fragment_error);
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/labels/glyph_atlas.h>
+#include <cstdint>
+#include <vector>
+
+namespace earth_map::tests {
+
+TEST(GlyphAtlasTest, DecodesUtf8) {
+    EXPECT_EQ(GlyphAtlas::DecodeUtf8("Paris"), U"Paris");
+    EXPECT_EQ(GlyphAtlas::DecodeUtf8("Z\xC3\xBCrich"), U"Zürich");
+    EXPECT_EQ(GlyphAtlas::DecodeUtf8("\xE6\x9D\xB1\xE4\xBA\xAC"), U"東京");
+    EXPECT_EQ(GlyphAtlas::DecodeUtf8("\xF0\x9F\x97\xBA"), U"\U0001F5FA");
+    EXPECT_EQ(GlyphAtlas::DecodeUtf8("a\nb"), U"a\nb");
+    EXPECT_TRUE(GlyphAtlas::DecodeUtf8("").empty());
+}
+
+TEST(GlyphAtlasTest, ReplacesInvalidUtf8) {
+    // Stray continuation byte, truncated sequence, overlong '/', surrogate
+    EXPECT_EQ(GlyphAtlas::DecodeUtf8("a\x80" "b"), U"a�b");
+    EXPECT_EQ(GlyphAtlas::DecodeUtf8("a\xC3"), U"a�");
+    EXPECT_EQ(GlyphAtlas::DecodeUtf8("\xC0\xAF"), U"��");
+    EXPECT_EQ(GlyphAtlas::DecodeUtf8("\xED\xA0\x80"), U"���");
+}
+
+TEST(GlyphAtlasTest, RejectsDataThatIsNotAFont) {
+    GlyphAtlas atlas(256, 32.0f, 4, true);
+    EXPECT_FALSE(atlas.LoadFont({}));
+    EXPECT_FALSE(atlas.LoadFont(std::vector<std::uint8_t>(64, 0xAB)));
+    EXPECT_FALSE(atlas.LoadFontFile("/nonexistent/font.ttf"));
+    EXPECT_FALSE(atlas.HasFont());
+}
+
+TEST(GlyphAtlasTest, HasNoGlyphsWithoutAFont) {
+    GlyphAtlas atlas(256, 32.0f, 4, true);
+    EXPECT_EQ(atlas.GetGlyph(U'A'), nullptr);
+    EXPECT_FALSE(atlas.IsFull());
+    EXPECT_EQ(atlas.GetGlyphCount(), 0u);
+}
+
+TEST(GlyphAtlasTest, ClearBumpsTheGeneration) {
+    GlyphAtlas atlas(256, 32.0f, 4, true);
+    const std::uint64_t generation = atlas.GetGeneration();
+    atlas.Clear();
+    EXPECT_EQ(atlas.GetGeneration(), generation + 1);
+    EXPECT_EQ(atlas.GetAtlas().GetStats().resets, 1u);
+}
+
+} // namespace earth_map::tests
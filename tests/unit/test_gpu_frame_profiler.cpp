@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/gpu_frame_profiler.h>
+#include <string>
+#include <thread>
+
+namespace earth_map::tests {
+
+namespace {
+
+void Spin(std::chrono::microseconds duration) {
+    const auto until = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < until) {
+    }
+}
+
+} // namespace
+
+TEST(GpuFrameProfilerTest, PassNames) {
+    EXPECT_EQ(std::string(GetRenderPassName(RenderPass::UPLOADS)), "uploads");
+    EXPECT_EQ(std::string(GetRenderPassName(RenderPass::MINI_MAP)), "mini_map");
+}
+
+TEST(GpuFrameProfilerTest, ScopesMeasureCpuTimePerPass) {
+    GpuFrameProfiler profiler(false);
+    EXPECT_FALSE(profiler.HasGpuTimings());
+
+    profiler.BeginFrame();
+    {
+        GpuFrameProfiler::Scope scope(&profiler, RenderPass::GLOBE);
+        Spin(std::chrono::microseconds(2000));
+    }
+    profiler.EndFrame();
+
+    EXPECT_GE(profiler.GetTiming(RenderPass::GLOBE).cpu_ms, 2.0);
+    EXPECT_EQ(profiler.GetTiming(RenderPass::PLACEMARKS).cpu_ms, 0.0);
+    EXPECT_EQ(profiler.GetTiming(RenderPass::GLOBE).gpu_ms, 0.0);
+    EXPECT_GE(profiler.GetCpuFrameMs(), profiler.GetTiming(RenderPass::GLOBE).cpu_ms);
+    EXPECT_EQ(profiler.GetGpuFrameMs(), 0.0);
+}
+
+TEST(GpuFrameProfilerTest, RepeatedPassAccumulatesWithinFrame) {
+    GpuFrameProfiler profiler(false);
+    profiler.BeginFrame();
+    for (int i = 0; i < 2; ++i) {
+        GpuFrameProfiler::Scope scope(&profiler, RenderPass::UPLOADS);
+        Spin(std::chrono::microseconds(1000));
+    }
+    profiler.EndFrame();
+    EXPECT_GE(profiler.GetTiming(RenderPass::UPLOADS).cpu_ms, 2.0);
+
+    // The next frame starts from zero
+    profiler.BeginFrame();
+    profiler.EndFrame();
+    EXPECT_EQ(profiler.GetTiming(RenderPass::UPLOADS).cpu_ms, 0.0);
+}
+
+TEST(GpuFrameProfilerTest, NullProfilerScopeIsNoOp) {
+    GpuFrameProfiler::Scope scope(nullptr, RenderPass::GLOBE);
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/globe_mesh.h>
+#include <earth_map/renderer/gpu_resource_manager.h>
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace earth_map::tests {
+
+namespace {
+
+GlobeMeshParams AdaptiveParams() {
+    GlobeMeshParams params;
+    params.radius = 1.0;
+    params.max_subdivision_level = 9;
+    params.enable_adaptive = true;
+    params.max_screen_error = 8.0f;
+    params.lod_triangle_budget = 30000;
+    params.lod_max_operations = 200;
+    return params;
+}
+
+bool Update(IcosahedronGlobeMesh& mesh, const glm::vec3& eye) {
+    const glm::mat4 view = glm::lookAt(eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const glm::mat4 projection = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.01f, 10.0f);
+    return mesh.UpdateLOD(eye, view, projection, glm::vec2(1280.0f, 720.0f));
+}
+
+/// GPU copy as a full upload would leave it, with room to spare
+GPUMesh UploadedCopy(const GlobeMesh& mesh) {
+    GPUMesh gpu_mesh;
+    gpu_mesh.index_type = GL_UNSIGNED_INT;
+    gpu_mesh.vertex_count = mesh.GetVertices().size();
+    gpu_mesh.index_count = mesh.GetVertexIndices().size();
+    gpu_mesh.vertex_capacity = gpu_mesh.vertex_count * 2;
+    gpu_mesh.index_capacity = gpu_mesh.index_count * 2;
+    gpu_mesh.revision = mesh.GetRevision();
+    return gpu_mesh;
+}
+
+} // namespace
+
+TEST(GPUResourceManagerTest, UnchangedMeshNeedsNoUpload) {
+    GlobeMeshParams params;
+    params.max_subdivision_level = 4;
+    params.enable_adaptive = false;
+    IcosahedronGlobeMesh mesh(params);
+    ASSERT_TRUE(mesh.Generate());
+
+    EXPECT_EQ(GPUResourceManager::PlanSync(nullptr, mesh), GPUMeshSync::FULL);
+    GPUMesh gpu_mesh = UploadedCopy(mesh);
+    EXPECT_EQ(GPUResourceManager::PlanSync(&gpu_mesh, mesh), GPUMeshSync::CURRENT);
+
+    // Regenerating replaces the mesh
+    ASSERT_TRUE(mesh.Generate());
+    EXPECT_GT(mesh.GetRevision(), gpu_mesh.revision);
+    EXPECT_EQ(mesh.GetDirtyBaseRevision(), GlobeMesh::kNoBaseRevision);
+    EXPECT_EQ(GPUResourceManager::PlanSync(&gpu_mesh, mesh), GPUMeshSync::FULL);
+}
+
+TEST(GPUResourceManagerTest, AdaptiveUpdatesUploadIncrementally) {
+    IcosahedronGlobeMesh mesh(AdaptiveParams());
+    ASSERT_TRUE(Update(mesh, glm::vec3(0.0f, 0.0f, 1.2f)));
+    GPUMesh gpu_mesh = UploadedCopy(mesh);
+
+    // Move the camera until the mesh changes
+    bool changed = false;
+    for (int frame = 1; frame <= 20 && !changed; ++frame) {
+        const float angle = frame * 0.05f;
+        ASSERT_TRUE(Update(mesh, 1.2f * glm::vec3(std::sin(angle), 0.0f, std::cos(angle))));
+        changed = mesh.GetRevision() != gpu_mesh.revision;
+    }
+    ASSERT_TRUE(changed);
+    EXPECT_EQ(GPUResourceManager::PlanSync(&gpu_mesh, mesh), GPUMeshSync::INCREMENTAL);
+
+    // Buffers that are too small, a missed revision or 16-bit indices need a full upload
+    GPUMesh small = gpu_mesh;
+    small.index_capacity = mesh.GetVertexIndices().size() - 1;
+    EXPECT_EQ(GPUResourceManager::PlanSync(&small, mesh), GPUMeshSync::FULL);
+
+    GPUMesh stale = gpu_mesh;
+    --stale.revision;
+    EXPECT_EQ(GPUResourceManager::PlanSync(&stale, mesh), GPUMeshSync::FULL);
+
+    GPUMesh chunked = gpu_mesh;
+    chunked.index_type = GL_UNSIGNED_SHORT;
+    EXPECT_EQ(GPUResourceManager::PlanSync(&chunked, mesh), GPUMeshSync::FULL);
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/tile_loader.h>
+#include "loopback_http_server.h"
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace earth_map::tests {
+
+using namespace std::chrono_literals;
+
+namespace {
+
+std::string Respond(const std::string& body) {
+    return "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(body.size()) +
+           "\r\nConnection: close\r\n\r\n" + body;
+}
+
+} // namespace
+
+TEST(BasicXYZTileProviderMirrorTest, HedgesToNextSubdomain) {
+    BasicXYZTileProvider provider("Sharded", "https://{s}.tiles.test/{z}/{x}/{y}.png", "abc");
+    const TileCoordinates tile(1, 0, 3);
+    EXPECT_EQ(provider.BuildTileURL(tile), "https://b.tiles.test/3/1/0.png");
+    EXPECT_EQ(provider.BuildMirrorURL(tile), "https://c.tiles.test/3/1/0.png");
+
+    BasicXYZTileProvider single("Single", "https://tiles.test/{z}/{x}/{y}.png");
+    EXPECT_TRUE(single.BuildMirrorURL(tile).empty());
+}
+
+TEST(BasicXYZTileProviderMirrorTest, UsesMirrorTemplates) {
+    BasicXYZTileProvider provider("Mirrored", "https://primary.test/{z}/{x}/{y}.png");
+    provider.SetMirrorTemplates({"https://mirror-1.test/{z}/{x}/{y}.png",
+                                 "https://mirror-2.test/{z}/{x}/{y}.png"});
+    EXPECT_EQ(provider.BuildMirrorURL(TileCoordinates(0, 0, 1)), "https://mirror-1.test/1/0/0.png");
+    EXPECT_EQ(provider.BuildMirrorURL(TileCoordinates(1, 0, 1)), "https://mirror-2.test/1/1/0.png");
+}
+
+class HedgedRequestTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        // Zoom 5 tiles are slow on the primary host
+        primary_ = std::make_unique<LoopbackHttpServer>([](const std::string& request) {
+            if (request.find("GET /5/") == 0) {
+                std::this_thread::sleep_for(1000ms);
+            }
+            return Respond("primary");
+        });
+        mirror_ = std::make_unique<LoopbackHttpServer>([](const std::string&) {
+            return Respond("mirror");
+        });
+
+        config_.max_retries = 0;
+        config_.hedge_min_samples = 3;
+        config_.hedge_min_delay = 200;
+        loader_ = CreateTileLoader(config_);
+        ASSERT_TRUE(loader_->Initialize(config_));
+
+        auto provider = std::make_shared<BasicXYZTileProvider>(
+            "Hedged", primary_->BaseUrl() + "/{z}/{x}/{y}.png");
+        provider->SetMirrorTemplates({mirror_->BaseUrl() + "/{z}/{x}/{y}.png"});
+        ASSERT_TRUE(loader_->AddProvider(provider));
+        ASSERT_TRUE(loader_->SetDefaultProvider("Hedged"));
+    }
+
+    void TearDown() override {
+        loader_.reset();
+        primary_.reset();
+        mirror_.reset();
+    }
+
+    /// Fast primary answers build the host's latency histogram
+    void WarmUp() {
+        for (std::int32_t x = 0; x < 3; ++x) {
+            ASSERT_TRUE(loader_->LoadTile(TileCoordinates(x, 0, 2)).success);
+        }
+    }
+
+    std::unique_ptr<LoopbackHttpServer> primary_;
+    std::unique_ptr<LoopbackHttpServer> mirror_;
+    TileLoaderConfig config_;
+    std::unique_ptr<TileLoader> loader_;
+};
+
+TEST_F(HedgedRequestTest, NoHedgeWithoutLatencyHistory) {
+    const TileLoadResult result = loader_->LoadTile(TileCoordinates(0, 0, 1));
+    ASSERT_TRUE(result.success);
+    EXPECT_EQ(std::string(result.tile_data->data.begin(), result.tile_data->data.end()),
+              "primary");
+    EXPECT_TRUE(mirror_->GetRequests().empty());
+
+    const TileLoaderStats stats = loader_->GetStatistics();
+    ASSERT_EQ(stats.host_latency.count(primary_->BaseUrl().substr(7)), 1u);
+    EXPECT_EQ(stats.host_latency.at(primary_->BaseUrl().substr(7)).GetCount(), 1u);
+}
+
+TEST_F(HedgedRequestTest, FastPrimaryCancelsPendingHedge) {
+    WarmUp();
+    ASSERT_TRUE(loader_->LoadTile(TileCoordinates(3, 0, 2)).success);
+
+    // The hedge is cancelled on the timer queue before it starts
+    std::this_thread::sleep_for(300ms);
+    EXPECT_TRUE(mirror_->GetRequests().empty());
+    EXPECT_EQ(loader_->GetStatistics().hedged_requests, 0u);
+}
+
+TEST_F(HedgedRequestTest, SlowPrimaryLosesToMirror) {
+    WarmUp();
+
+    const auto start = std::chrono::steady_clock::now();
+    const TileLoadResult result = loader_->LoadTile(TileCoordinates(0, 0, 5));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    ASSERT_TRUE(result.success);
+    EXPECT_EQ(std::string(result.tile_data->data.begin(), result.tile_data->data.end()),
+              "mirror");
+    EXPECT_LT(elapsed, 800ms);
+    EXPECT_EQ(mirror_->GetRequests().size(), 1u);
+
+    const TileLoaderStats stats = loader_->GetStatistics();
+    EXPECT_EQ(stats.hedged_requests, 1u);
+    EXPECT_EQ(stats.hedge_wins, 1u);
+}
+
+TEST_F(HedgedRequestTest, DisabledHedgingWaitsForPrimary) {
+    config_.enable_hedging = false;
+    ASSERT_TRUE(loader_->SetConfiguration(config_));
+    WarmUp();
+
+    const TileLoadResult result = loader_->LoadTile(TileCoordinates(0, 0, 5));
+    ASSERT_TRUE(result.success);
+    EXPECT_EQ(std::string(result.tile_data->data.begin(), result.tile_data->data.end()),
+              "primary");
+    EXPECT_TRUE(mirror_->GetRequests().empty());
+}
+
+} // namespace earth_map::tests
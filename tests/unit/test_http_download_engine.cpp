@@ -0,0 +1,196 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/http_download_engine.h>
+#include <earth_map/data/tile_loader.h>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace earth_map::tests {
+
+/**
+ * @brief Test fixture for HttpDownloadEngine
+ *
+ * Uses file:// URLs so transfers run through curl_multi without network access.
+ */
+class HttpDownloadEngineTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        test_dir_ = std::filesystem::temp_directory_path() / "earth_map_download_engine_test";
+        std::filesystem::create_directories(test_dir_);
+        engine_ = CreateHttpDownloadEngine(TileLoaderConfig{});
+    }
+
+    void TearDown() override {
+        engine_.reset();
+        std::filesystem::remove_all(test_dir_);
+    }
+
+    /**
+     * @brief Write a file and return its file:// URL
+     */
+    std::string WriteFile(const std::string& relative_path, const std::string& content) {
+        const auto path = test_dir_ / relative_path;
+        std::filesystem::create_directories(path.parent_path());
+        std::ofstream file(path, std::ios::binary);
+        file << content;
+        return "file://" + path.string();
+    }
+
+    /**
+     * @brief Submit a request and return a future for its response
+     */
+    std::future<HttpResponse> Fetch(const std::string& url,
+                                    std::chrono::steady_clock::time_point not_before = {}) {
+        auto promise = std::make_shared<std::promise<HttpResponse>>();
+        auto future = promise->get_future();
+
+        HttpRequest request;
+        request.url = url;
+        request.not_before = not_before;
+        request.on_complete = [promise](HttpResponse&& response) {
+            promise->set_value(std::move(response));
+        };
+        engine_->Submit(std::move(request));
+
+        return future;
+    }
+
+    std::filesystem::path test_dir_;
+    std::unique_ptr<HttpDownloadEngine> engine_;
+};
+
+TEST_F(HttpDownloadEngineTest, FetchesBody) {
+    const std::string url = WriteFile("tile.bin", "tile-bytes");
+
+    auto response = Fetch(url).get();
+
+    EXPECT_TRUE(response.success);
+    EXPECT_FALSE(response.cancelled);
+    EXPECT_EQ(std::string(response.body.begin(), response.body.end()), "tile-bytes");
+    EXPECT_TRUE(response.error_message.empty());
+}
+
+TEST_F(HttpDownloadEngineTest, MissingResourceFails) {
+    auto response = Fetch("file://" + (test_dir_ / "missing.bin").string()).get();
+
+    EXPECT_FALSE(response.success);
+    EXPECT_TRUE(response.body.empty());
+    EXPECT_FALSE(response.error_message.empty());
+}
+
+TEST_F(HttpDownloadEngineTest, ManyRequestsInFlight) {
+    constexpr int kRequestCount = 300;
+
+    std::vector<std::future<HttpResponse>> futures;
+    for (int i = 0; i < kRequestCount; ++i) {
+        futures.push_back(Fetch(WriteFile("many/" + std::to_string(i), std::to_string(i))));
+    }
+
+    for (int i = 0; i < kRequestCount; ++i) {
+        auto response = futures[i].get();
+        ASSERT_TRUE(response.success);
+        EXPECT_EQ(std::string(response.body.begin(), response.body.end()), std::to_string(i));
+    }
+
+    EXPECT_EQ(engine_->GetActiveCount(), 0u);
+    EXPECT_EQ(engine_->GetQueuedCount(), 0u);
+}
+
+TEST_F(HttpDownloadEngineTest, DelayedRequestWaitsForStartTime) {
+    const std::string url = WriteFile("delayed.bin", "x");
+    const auto delay = std::chrono::milliseconds(50);
+    const auto submit_time = std::chrono::steady_clock::now();
+
+    auto response = Fetch(url, submit_time + delay).get();
+
+    EXPECT_TRUE(response.success);
+    EXPECT_GE(std::chrono::steady_clock::now() - submit_time, delay);
+}
+
+TEST_F(HttpDownloadEngineTest, CancelQueuedRequest) {
+    const std::string url = WriteFile("cancel.bin", "x");
+    std::atomic<bool> completed{false};
+
+    HttpRequest request;
+    request.url = url;
+    request.not_before = std::chrono::steady_clock::now() + std::chrono::hours(1);
+    request.on_complete = [&completed](HttpResponse&&) { completed = true; };
+    const HttpRequestId id = engine_->Submit(std::move(request));
+
+    EXPECT_NE(id, 0u);
+    EXPECT_EQ(engine_->GetQueuedCount(), 1u);
+    EXPECT_TRUE(engine_->Cancel(id));
+    EXPECT_FALSE(engine_->Cancel(id));
+    EXPECT_EQ(engine_->GetQueuedCount(), 0u);
+
+    engine_.reset();
+    EXPECT_FALSE(completed);
+}
+
+TEST_F(HttpDownloadEngineTest, ShutdownResolvesOutstandingRequests) {
+    auto future = Fetch(WriteFile("shutdown.bin", "x"),
+                        std::chrono::steady_clock::now() + std::chrono::hours(1));
+
+    engine_.reset();
+
+    auto response = future.get();
+    EXPECT_FALSE(response.success);
+    EXPECT_TRUE(response.cancelled);
+}
+
+TEST_F(HttpDownloadEngineTest, TileLoaderUsesEngineForAsyncBatches) {
+    for (int x = 0; x < 4; ++x) {
+        for (int y = 0; y < 4; ++y) {
+            WriteFile("tiles/2/" + std::to_string(x) + "/" + std::to_string(y) + ".png",
+                      "tile " + std::to_string(x) + "," + std::to_string(y));
+        }
+    }
+
+    TileLoaderConfig config;
+    auto loader = CreateTileLoader(config);
+    ASSERT_TRUE(loader->Initialize(config));
+    ASSERT_TRUE(loader->AddProvider(std::make_shared<BasicXYZTileProvider>(
+        "LocalFiles", "file://" + (test_dir_ / "tiles").string() + "/{z}/{x}/{y}.png")));
+    ASSERT_TRUE(loader->SetDefaultProvider("LocalFiles"));
+
+    std::vector<TileCoordinates> tiles;
+    for (int x = 0; x < 4; ++x) {
+        for (int y = 0; y < 4; ++y) {
+            tiles.emplace_back(x, y, 2);
+        }
+    }
+
+    std::atomic<int> callbacks{0};
+    auto futures = loader->LoadTilesAsync(tiles, [&callbacks](const TileLoadResult&) {
+        callbacks++;
+    });
+    ASSERT_EQ(futures.size(), tiles.size());
+
+    for (std::size_t i = 0; i < futures.size(); ++i) {
+        auto result = futures[i].get();
+        ASSERT_TRUE(result.success) << result.error_message;
+        EXPECT_EQ(result.coordinates, tiles[i]);
+        ASSERT_NE(result.tile_data, nullptr);
+        EXPECT_TRUE(result.tile_data->IsValid());
+    }
+
+    EXPECT_EQ(callbacks.load(), static_cast<int>(tiles.size()));
+    EXPECT_TRUE(loader->GetLoadingTiles().empty());
+
+    auto sync_result = loader->LoadTile(TileCoordinates(1, 2, 2));
+    ASSERT_TRUE(sync_result.success);
+    EXPECT_EQ(std::string(sync_result.tile_data->data.begin(), sync_result.tile_data->data.end()),
+              "tile 1,2");
+
+    auto stats = loader->GetStatistics();
+    EXPECT_EQ(stats.successful_requests, tiles.size() + 1);
+    EXPECT_EQ(stats.failed_requests, 0u);
+}
+
+} // namespace earth_map::tests
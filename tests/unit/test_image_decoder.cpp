@@ -0,0 +1,169 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/texture_atlas/image_decoder.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+const std::vector<std::uint8_t> kPngHeader = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n', 0, 0};
+const std::vector<std::uint8_t> kJpegHeader = {0xFF, 0xD8, 0xFF, 0xE0, 0, 0};
+
+/**
+ * @brief Fake backend producing a 1x1 image, or failing on demand
+ */
+class FakeImageDecoder : public ImageDecoder {
+public:
+    FakeImageDecoder(const char* name, ImageFormat format, bool succeed)
+        : name_(name), format_(format), succeed_(succeed) {}
+
+    const char* GetName() const override { return name_; }
+    bool Supports(ImageFormat format) const override { return format == format_; }
+
+    bool Decode(const std::uint8_t*, std::size_t, DecodedImage& out) override {
+        calls.fetch_add(1);
+        if (!succeed_) {
+            return false;
+        }
+        out.pixels.assign(4, 0xAB);
+        out.width = 1;
+        out.height = 1;
+        out.channels = 4;
+        return true;
+    }
+
+    std::atomic<int> calls{0};
+
+private:
+    const char* name_;
+    ImageFormat format_;
+    bool succeed_;
+};
+
+} // namespace
+
+TEST(ImageDecoderTest, DetectsFormatFromMagicBytes) {
+    EXPECT_EQ(DetectImageFormat(kPngHeader.data(), kPngHeader.size()), ImageFormat::PNG);
+    EXPECT_EQ(DetectImageFormat(kJpegHeader.data(), kJpegHeader.size()), ImageFormat::JPEG);
+
+    const std::vector<std::uint8_t> webp = {'R', 'I', 'F', 'F', 0x10, 0, 0, 0,
+                                            'W', 'E', 'B', 'P', 'V', 'P', '8', ' '};
+    EXPECT_EQ(DetectImageFormat(webp.data(), webp.size()), ImageFormat::WebP);
+
+    const std::vector<std::uint8_t> garbage = {1, 2, 3, 4};
+    EXPECT_EQ(DetectImageFormat(garbage.data(), garbage.size()), ImageFormat::Unknown);
+    EXPECT_EQ(DetectImageFormat(nullptr, 0), ImageFormat::Unknown);
+    EXPECT_EQ(DetectImageFormat(kPngHeader.data(), 4), ImageFormat::Unknown);
+}
+
+TEST(ImageDecoderTest, ReadsSizeFromHeader) {
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+
+    // PNG: signature, IHDR length and type, 512 x 256
+    const std::vector<std::uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n',
+                                           0, 0, 0, 13, 'I', 'H', 'D', 'R',
+                                           0, 0, 2, 0, 0, 0, 1, 0};
+    ASSERT_TRUE(ReadImageSize(png.data(), png.size(), width, height));
+    EXPECT_EQ(width, 512u);
+    EXPECT_EQ(height, 256u);
+    EXPECT_FALSE(ReadImageSize(png.data(), 20, width, height));
+
+    // JPEG: SOI, an APP0 segment to skip, then SOF0 with 480 rows of 640
+    const std::vector<std::uint8_t> jpeg = {0xFF, 0xD8, 0xFF, 0xE0, 0, 4, 0, 0,
+                                            0xFF, 0xC0, 0, 11, 8, 0x01, 0xE0, 0x02, 0x80, 3};
+    ASSERT_TRUE(ReadImageSize(jpeg.data(), jpeg.size(), width, height));
+    EXPECT_EQ(width, 640u);
+    EXPECT_EQ(height, 480u);
+    EXPECT_FALSE(ReadImageSize(jpeg.data(), 12, width, height));
+
+    // WebP (extended): canvas size minus one, 24-bit little endian
+    const std::vector<std::uint8_t> webp = {'R', 'I', 'F', 'F', 0x10, 0, 0, 0,
+                                            'W', 'E', 'B', 'P', 'V', 'P', '8', 'X',
+                                            10, 0, 0, 0, 0, 0, 0, 0,
+                                            0xFF, 0x01, 0, 0xFF, 0x03, 0};
+    ASSERT_TRUE(ReadImageSize(webp.data(), webp.size(), width, height));
+    EXPECT_EQ(width, 512u);
+    EXPECT_EQ(height, 1024u);
+
+    const std::vector<std::uint8_t> garbage = {1, 2, 3, 4};
+    EXPECT_FALSE(ReadImageSize(garbage.data(), garbage.size(), width, height));
+    EXPECT_FALSE(ReadImageSize(nullptr, 0, width, height));
+}
+
+TEST(ImageDecoderTest, DefaultRegistryFallsBackToStb) {
+    auto registry = ImageDecoderRegistry::CreateDefault();
+
+    const auto png = registry->GetDecoderNames(ImageFormat::PNG);
+    const auto jpeg = registry->GetDecoderNames(ImageFormat::JPEG);
+    ASSERT_FALSE(png.empty());
+    ASSERT_FALSE(jpeg.empty());
+    EXPECT_EQ(png.back(), "stb_image");
+    EXPECT_EQ(jpeg.back(), "stb_image");
+
+    // SIMD backends are optional, but preferred whenever built in
+    EXPECT_EQ(CreateSpngDecoder() != nullptr, png.size() == 2u);
+    EXPECT_EQ(CreateTurboJpegDecoder() != nullptr, jpeg.size() == 2u);
+}
+
+TEST(ImageDecoderTest, PrefersEarlierBackendForFormat) {
+    ImageDecoderRegistry registry;
+    auto fast = std::make_unique<FakeImageDecoder>("fast-png", ImageFormat::PNG, true);
+    auto fallback = std::make_unique<FakeImageDecoder>("fallback-png", ImageFormat::PNG, true);
+    auto* fast_ptr = fast.get();
+    auto* fallback_ptr = fallback.get();
+    registry.Register(std::move(fast));
+    registry.Register(std::move(fallback));
+    registry.Register(nullptr);  // Unavailable backends are skipped
+
+    DecodedImage image;
+    ASSERT_TRUE(registry.Decode(kPngHeader.data(), kPngHeader.size(), image));
+
+    EXPECT_EQ(fast_ptr->calls.load(), 1);
+    EXPECT_EQ(fallback_ptr->calls.load(), 0);
+    EXPECT_EQ(image.width, 1u);
+    EXPECT_EQ(image.channels, 4u);
+    EXPECT_EQ(registry.GetDecoderNames(ImageFormat::PNG),
+              (std::vector<std::string>{"fast-png", "fallback-png"}));
+}
+
+TEST(ImageDecoderTest, FallsBackWhenPreferredBackendFails) {
+    ImageDecoderRegistry registry;
+    auto broken = std::make_unique<FakeImageDecoder>("broken-jpeg", ImageFormat::JPEG, false);
+    auto fallback = std::make_unique<FakeImageDecoder>("fallback-jpeg", ImageFormat::JPEG, true);
+    auto* broken_ptr = broken.get();
+    auto* fallback_ptr = fallback.get();
+    registry.Register(std::move(broken));
+    registry.Register(std::move(fallback));
+
+    DecodedImage image;
+    EXPECT_TRUE(registry.Decode(kJpegHeader.data(), kJpegHeader.size(), image));
+    EXPECT_EQ(broken_ptr->calls.load(), 1);
+    EXPECT_EQ(fallback_ptr->calls.load(), 1);
+}
+
+TEST(ImageDecoderTest, RecordsStatsPerFormat) {
+    ImageDecoderRegistry registry;
+    registry.Register(std::make_unique<FakeImageDecoder>("png", ImageFormat::PNG, true));
+
+    DecodedImage image;
+    EXPECT_TRUE(registry.Decode(kPngHeader.data(), kPngHeader.size(), image));
+    EXPECT_TRUE(registry.Decode(kPngHeader.data(), kPngHeader.size(), image));
+    EXPECT_FALSE(registry.Decode(kJpegHeader.data(), kJpegHeader.size(), image));
+    EXPECT_FALSE(registry.Decode(nullptr, 0, image));
+
+    const auto stats = registry.GetStats();
+    EXPECT_EQ(stats.Get(ImageFormat::PNG).decoded, 2u);
+    EXPECT_EQ(stats.Get(ImageFormat::PNG).failed, 0u);
+    EXPECT_GE(stats.Get(ImageFormat::PNG).max_decode_us * 2,
+              stats.Get(ImageFormat::PNG).total_decode_us);
+    EXPECT_EQ(stats.Get(ImageFormat::JPEG).decoded, 0u);
+    EXPECT_EQ(stats.Get(ImageFormat::JPEG).failed, 1u);
+    EXPECT_EQ(stats.Get(ImageFormat::Unknown).failed, 1u);
+    EXPECT_DOUBLE_EQ(stats.Get(ImageFormat::JPEG).GetAverageDecodeUs(), 0.0);
+}
+
+} // namespace earth_map::tests
@@ -309,4 +309,151 @@ TEST_F(IndirectionTextureManagerTest, WindowedMode_WindowSize) {
     EXPECT_EQ(IndirectionTextureManager::kWindowSize, 512u);
 }
 
+
+// ============================================================================
+// Resolution Tests
+// ============================================================================
+
+TEST_F(IndirectionTextureManagerTest, Resolved_OwnLayerHasNoLevelDelta) {
+    TileCoordinates tile(3, 2, 4);
+    manager_->SetTileLayer(tile, 42);
+
+    EXPECT_EQ(manager_->GetResolvedEntry(tile), IndirectionTextureManager::EncodeResolved(42, 0));
+}
+
+TEST_F(IndirectionTextureManagerTest, Resolved_FallsBackToAncestor) {
+    manager_->SetTileLayer(TileCoordinates(1, 1, 2), 7);
+    // Finer level allocated before and after the ancestor loads
+    manager_->SetTileLayer(TileCoordinates(0, 0, 4), 8);
+    manager_->SetTileLayer(TileCoordinates(0, 0, 5), 9);
+
+    EXPECT_EQ(manager_->GetResolvedEntry(TileCoordinates(5, 6, 4)),
+              IndirectionTextureManager::EncodeResolved(7, 2));
+    EXPECT_EQ(manager_->GetResolvedEntry(TileCoordinates(11, 13, 5)),
+              IndirectionTextureManager::EncodeResolved(7, 3));
+    // Outside the ancestor
+    EXPECT_EQ(manager_->GetResolvedEntry(TileCoordinates(9, 1, 4)),
+              IndirectionTextureManager::kInvalidLayer);
+}
+
+TEST_F(IndirectionTextureManagerTest, Resolved_FinerTileWinsOverAncestor) {
+    manager_->SetTileLayer(TileCoordinates(4, 4, 5), 1);
+    manager_->SetTileLayer(TileCoordinates(1, 1, 3), 2);
+    manager_->SetTileLayer(TileCoordinates(2, 2, 4), 3);
+
+    EXPECT_EQ(manager_->GetResolvedEntry(TileCoordinates(4, 4, 5)),
+              IndirectionTextureManager::EncodeResolved(1, 0));
+    EXPECT_EQ(manager_->GetResolvedEntry(TileCoordinates(5, 5, 5)),
+              IndirectionTextureManager::EncodeResolved(3, 1));
+    EXPECT_EQ(manager_->GetResolvedEntry(TileCoordinates(7, 7, 5)),
+              IndirectionTextureManager::EncodeResolved(2, 2));
+}
+
+TEST_F(IndirectionTextureManagerTest, Resolved_ClearFallsBackFurther) {
+    manager_->SetTileLayer(TileCoordinates(0, 0, 1), 1);
+    manager_->SetTileLayer(TileCoordinates(1, 1, 3), 2);
+    manager_->SetTileLayer(TileCoordinates(2, 2, 4), 3);
+
+    manager_->ClearTile(TileCoordinates(1, 1, 3));
+    EXPECT_EQ(manager_->GetResolvedEntry(TileCoordinates(3, 3, 4)),
+              IndirectionTextureManager::EncodeResolved(1, 3));
+    EXPECT_EQ(manager_->GetResolvedEntry(TileCoordinates(2, 2, 4)),
+              IndirectionTextureManager::EncodeResolved(3, 0));
+
+    manager_->ClearTile(TileCoordinates(0, 0, 1));
+    EXPECT_EQ(manager_->GetResolvedEntry(TileCoordinates(3, 3, 4)),
+              IndirectionTextureManager::kInvalidLayer);
+}
+
+TEST_F(IndirectionTextureManagerTest, Resolved_LimitedToMaxAncestorDepth) {
+    constexpr int kDepth = IndirectionTextureManager::kMaxAncestorDepth;
+    manager_->SetTileLayer(TileCoordinates(0, 0, 1), 4);
+    manager_->SetTileLayer(TileCoordinates(1, 1, 1 + kDepth), 5);
+    manager_->SetTileLayer(TileCoordinates(1, 1, 2 + kDepth), 6);
+
+    EXPECT_EQ(manager_->GetResolvedEntry(TileCoordinates(0, 0, 1 + kDepth)),
+              IndirectionTextureManager::EncodeResolved(4, kDepth));
+    EXPECT_EQ(manager_->GetResolvedEntry(TileCoordinates(0, 0, 2 + kDepth)),
+              IndirectionTextureManager::kInvalidLayer);
+}
+
+TEST_F(IndirectionTextureManagerTest, Resolved_WindowShiftResolvesExposedTexels) {
+    // Zoom 12 ancestor covers zoom 15 tiles [16000, 16008) x [12000, 12008)
+    manager_->SetTileLayer(TileCoordinates(2000, 1500, 12), 11);
+    manager_->UpdateWindowCenter(15, 16000 - 300, 12000);
+    EXPECT_EQ(manager_->GetResolvedEntry(TileCoordinates(16004, 12004, 15)),
+              IndirectionTextureManager::kInvalidLayer);
+
+    // Shift so the ancestor's block comes into the window
+    manager_->UpdateWindowCenter(15, 16000, 12000);
+    EXPECT_EQ(manager_->GetResolvedEntry(TileCoordinates(16004, 12004, 15)),
+              IndirectionTextureManager::EncodeResolved(11, 3));
+}
+
+TEST_F(IndirectionTextureManagerTest, Resolved_SizeReportedPerZoom) {
+    EXPECT_EQ(manager_->GetTextureSize(4), glm::ivec2(0, 0));
+    manager_->SetTileLayer(TileCoordinates(3, 2, 4), 1);
+    EXPECT_EQ(manager_->GetTextureSize(4), glm::ivec2(16, 16));
+    manager_->UpdateWindowCenter(14, 100, 100);
+    EXPECT_EQ(manager_->GetTextureSize(14), glm::ivec2(512, 512));
+}
+
+
+// ============================================================================
+// Upload Batching Tests
+// ============================================================================
+
+TEST_F(IndirectionTextureManagerTest, Flush_NothingPendingUploadsNothing) {
+    EXPECT_EQ(manager_->FlushUploads(), 0u);
+    manager_->SetTileLayer(TileCoordinates(3, 2, 4), 1);
+    EXPECT_GT(manager_->FlushUploads(), 0u);
+    EXPECT_EQ(manager_->FlushUploads(), 0u);
+}
+
+TEST_F(IndirectionTextureManagerTest, Flush_BurstOfTilesMergesIntoFewBlocks) {
+    manager_->SetTileLayer(TileCoordinates(0, 0, 10), 0);
+    manager_->FlushUploads();
+
+    // 200 neighbouring tiles: one texel each, all within one dirty block
+    std::uint16_t layer = 1;
+    for (int y = 0; y < 10; ++y) {
+        for (int x = 0; x < 20; ++x) {
+            manager_->SetTileLayer(TileCoordinates(100 + x, 200 + y, 10), layer++);
+        }
+    }
+
+    const std::size_t block = IndirectionTextureManager::kDirtyBlockSize;
+    EXPECT_LE(manager_->FlushUploads(), 2 * block * block);
+}
+
+TEST_F(IndirectionTextureManagerTest, Toroidal_ShiftUploadsOnlyExposedColumns) {
+    manager_->UpdateWindowCenter(15, 16000, 12000);
+    manager_->FlushUploads();
+
+    manager_->UpdateWindowCenter(15, 16003, 12000);
+    const std::size_t window = IndirectionTextureManager::kWindowSize;
+    const std::size_t block = IndirectionTextureManager::kDirtyBlockSize;
+    // 3 new columns: at most two block columns (if they straddle the seam)
+    EXPECT_LE(manager_->FlushUploads(), 2 * block * window);
+}
+
+TEST_F(IndirectionTextureManagerTest, Toroidal_EnteringTilesDoNotInheritLeavingTiles) {
+    manager_->UpdateWindowCenter(15, 16000, 12000);
+    const int first = 16000 - static_cast<int>(IndirectionTextureManager::kWindowSize / 2);
+    const TileCoordinates leaving(first, 12000, 15);
+    const TileCoordinates staying(first + 10, 12000, 15);
+    manager_->SetTileLayer(leaving, 3);
+    manager_->SetTileLayer(staying, 4);
+
+    manager_->UpdateWindowCenter(15, 16005, 12000);
+
+    // The leaving tile's texel now belongs to a tile entering on the east
+    const TileCoordinates entering(first + static_cast<int>(IndirectionTextureManager::kWindowSize),
+                                   12000, 15);
+    EXPECT_EQ(manager_->GetTileLayer(leaving), IndirectionTextureManager::kInvalidLayer);
+    EXPECT_EQ(manager_->GetTileLayer(entering), IndirectionTextureManager::kInvalidLayer);
+    EXPECT_EQ(manager_->GetResolvedEntry(entering), IndirectionTextureManager::kInvalidLayer);
+    EXPECT_EQ(manager_->GetTileLayer(staying), 4u);
+}
+
 } // namespace earth_map::tests
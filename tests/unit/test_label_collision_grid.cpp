@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/labels/label_collision_grid.h>
+
+namespace earth_map::tests {
+
+TEST(LabelCollisionGridTest, RejectsOverlappingBoxes) {
+    LabelCollisionGrid grid(64.0f);
+    grid.BeginFrame(800.0f, 600.0f);
+
+    EXPECT_TRUE(grid.TryInsert({100.0f, 100.0f, 200.0f, 120.0f}));
+    EXPECT_FALSE(grid.TryInsert({150.0f, 110.0f, 250.0f, 130.0f}));
+    EXPECT_TRUE(grid.TryInsert({200.0f, 100.0f, 300.0f, 120.0f}));   // Touching edges is fine
+    EXPECT_EQ(grid.GetBoxCount(), 2u);
+}
+
+TEST(LabelCollisionGridTest, FindsCollisionsAcrossCells) {
+    LabelCollisionGrid grid(32.0f);
+    grid.BeginFrame(512.0f, 512.0f);
+
+    // A wide box spanning many cells collides with a small one in its last cell
+    ASSERT_TRUE(grid.TryInsert({10.0f, 10.0f, 400.0f, 20.0f}));
+    EXPECT_TRUE(grid.Collides({390.0f, 15.0f, 395.0f, 18.0f}));
+    EXPECT_FALSE(grid.Collides({390.0f, 25.0f, 395.0f, 28.0f}));
+}
+
+TEST(LabelCollisionGridTest, BeginFrameForgetsPlacedBoxes) {
+    LabelCollisionGrid grid;
+    grid.BeginFrame(640.0f, 480.0f);
+    ASSERT_TRUE(grid.TryInsert({0.0f, 0.0f, 50.0f, 50.0f}));
+
+    grid.BeginFrame(640.0f, 480.0f);
+    EXPECT_EQ(grid.GetBoxCount(), 0u);
+    EXPECT_FALSE(grid.Collides({10.0f, 10.0f, 20.0f, 20.0f}));
+    EXPECT_TRUE(grid.TryInsert({10.0f, 10.0f, 20.0f, 20.0f}));
+}
+
+TEST(LabelCollisionGridTest, RejectsBoxesOffScreen) {
+    LabelCollisionGrid grid;
+    grid.BeginFrame(640.0f, 480.0f);
+
+    EXPECT_FALSE(grid.TryInsert({-100.0f, 10.0f, -10.0f, 20.0f}));
+    EXPECT_FALSE(grid.TryInsert({10.0f, 500.0f, 20.0f, 520.0f}));
+    EXPECT_TRUE(grid.TryInsert({-10.0f, -10.0f, 10.0f, 10.0f}));   // Partly on screen
+}
+
+TEST(LabelCollisionGridTest, ResizesWithTheViewport) {
+    LabelCollisionGrid grid(64.0f);
+    grid.BeginFrame(640.0f, 480.0f);
+    EXPECT_EQ(grid.GetColumns(), 10);
+    EXPECT_EQ(grid.GetRows(), 8);
+
+    grid.BeginFrame(1000.0f, 100.0f);
+    EXPECT_EQ(grid.GetColumns(), 16);
+    EXPECT_EQ(grid.GetRows(), 2);
+    EXPECT_TRUE(grid.TryInsert({900.0f, 50.0f, 990.0f, 90.0f}));
+}
+
+TEST(LabelCollisionGridTest, TestsOnlyNearbyBoxes) {
+    LabelCollisionGrid grid(64.0f);
+    grid.BeginFrame(1024.0f, 1024.0f);
+
+    // One small box per cell: each insert compares against nothing else
+    for (int y = 0; y < 16; ++y) {
+        for (int x = 0; x < 16; ++x) {
+            const float left = x * 64.0f + 8.0f;
+            const float top = y * 64.0f + 8.0f;
+            ASSERT_TRUE(grid.TryInsert({left, top, left + 40.0f, top + 40.0f}));
+        }
+    }
+    EXPECT_EQ(grid.GetBoxCount(), 256u);
+    EXPECT_EQ(grid.GetTestCount(), 0u);
+
+    EXPECT_TRUE(grid.Collides({10.0f, 10.0f, 20.0f, 20.0f}));
+    EXPECT_EQ(grid.GetTestCount(), 1u);
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/latency_histogram.h>
+
+namespace earth_map::tests {
+
+TEST(LatencyHistogramTest, EmptyHistogramReportsZero) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.GetCount(), 0u);
+    EXPECT_EQ(histogram.GetPercentile(0.95), 0.0);
+    EXPECT_EQ(histogram.GetMean(), 0.0);
+}
+
+TEST(LatencyHistogramTest, PercentilesWithinBucketResolution) {
+    LatencyHistogram histogram;
+    for (int i = 1; i <= 100; ++i) {
+        histogram.Record(static_cast<double>(i));
+    }
+    EXPECT_EQ(histogram.GetCount(), 100u);
+    EXPECT_DOUBLE_EQ(histogram.GetMean(), 50.5);
+    EXPECT_DOUBLE_EQ(histogram.GetMax(), 100.0);
+
+    // Buckets are 19% wide: the reported bound is at most that far above
+    EXPECT_GE(histogram.GetPercentile(0.5), 50.0);
+    EXPECT_LE(histogram.GetPercentile(0.5), 50.0 * 1.19);
+    EXPECT_GE(histogram.GetPercentile(0.95), 95.0);
+    EXPECT_LE(histogram.GetPercentile(0.95), 100.0);
+    EXPECT_DOUBLE_EQ(histogram.GetPercentile(1.0), 100.0);
+}
+
+TEST(LatencyHistogramTest, TailSamplesDominateHighPercentiles) {
+    LatencyHistogram histogram;
+    for (int i = 0; i < 95; ++i) {
+        histogram.Record(10.0);
+    }
+    for (int i = 0; i < 5; ++i) {
+        histogram.Record(2000.0);
+    }
+    EXPECT_LE(histogram.GetPercentile(0.95), 10.0 * 1.19);
+    EXPECT_GE(histogram.GetPercentile(0.99), 2000.0 / 1.19);
+}
+
+TEST(LatencyHistogramTest, ExtremeValuesAreClamped) {
+    LatencyHistogram histogram;
+    histogram.Record(-5.0);
+    histogram.Record(1e9);
+    EXPECT_EQ(histogram.GetCount(), 2u);
+    EXPECT_EQ(histogram.GetPercentile(0.0), LatencyHistogram::GetBucketUpperBound(0));
+    EXPECT_DOUBLE_EQ(histogram.GetPercentile(1.0),
+                     LatencyHistogram::GetBucketUpperBound(LatencyHistogram::kBucketCount - 1));
+}
+
+TEST(LatencyHistogramTest, MergeAndReset) {
+    LatencyHistogram a;
+    LatencyHistogram b;
+    a.Record(5.0);
+    b.Record(500.0);
+    a.Merge(b);
+    EXPECT_EQ(a.GetCount(), 2u);
+    EXPECT_DOUBLE_EQ(a.GetMax(), 500.0);
+
+    a.Reset();
+    EXPECT_EQ(a.GetCount(), 0u);
+    EXPECT_EQ(a.GetMax(), 0.0);
+}
+
+} // namespace earth_map::tests
@@ -5,6 +5,8 @@
 #include "earth_map/math/tile_mathematics.h"
 #include <cmath>
 #include <limits>
+#include <stdexcept>
+#include <vector>
 
 using namespace earth_map;
 using namespace earth_map::coordinates;
@@ -258,6 +260,94 @@ TEST_F(GeodeticCalculatorTest, CrossTrackDistance) {
     EXPECT_NEAR(cross_track, 11100.0, 1000.0);
 }
 
+TEST_F(GeodeticCalculatorTest, BatchDistancesMatchScalar) {
+    std::vector<double> lats;
+    std::vector<double> lons;
+    for (int i = 0; i < 1000; ++i) {
+        // Deterministic spread over the globe, away from the antipode
+        lats.push_back(std::fmod(i * 37.77, 170.0) - 85.0);
+        lons.push_back(std::fmod(i * 91.31, 200.0) - 160.0);
+    }
+    lats.push_back(new_york_.latitude);
+    lons.push_back(new_york_.longitude);
+
+    std::vector<double> distances(lats.size());
+    std::vector<double> bearings(lats.size());
+    GeodeticCalculator::HaversineDistances(new_york_, lats, lons, distances, bearings);
+    for (std::size_t i = 0; i < lats.size(); ++i) {
+        const DistanceResult expected =
+            GeodeticCalculator::HaversineDistanceAndBearing(new_york_, Geographic(lats[i], lons[i], 0.0));
+        ASSERT_NEAR(distances[i], expected.distance, 1e-6) << i;
+        if (expected.distance > 1.0) {
+            ASSERT_NEAR(std::remainder(bearings[i] - expected.initial_bearing, 360.0), 0.0, 1e-9) << i;
+        }
+    }
+
+    GeodeticCalculator::VincentyDistances(new_york_, lats, lons, distances, bearings);
+    for (std::size_t i = 0; i < lats.size(); ++i) {
+        const DistanceResult expected =
+            GeodeticCalculator::VincentyDistanceAndBearing(new_york_, Geographic(lats[i], lons[i], 0.0));
+        ASSERT_NEAR(distances[i], expected.distance, 1e-5) << i;
+        ASSERT_NEAR(std::remainder(bearings[i] - expected.initial_bearing, 360.0), 0.0, 1e-8) << i;
+    }
+
+    // Nearly antipodal points do not converge
+    const std::vector<double> antipode_lat = {-new_york_.latitude};
+    const std::vector<double> antipode_lon = {new_york_.longitude + 180.0};
+    std::vector<double> antipode_distance(1);
+    GeodeticCalculator::VincentyDistances(new_york_, antipode_lat, antipode_lon, antipode_distance);
+    EXPECT_TRUE(std::isnan(antipode_distance[0]));
+
+    std::vector<double> short_out(3);
+    EXPECT_THROW(GeodeticCalculator::HaversineDistances(new_york_, lats, lons, short_out),
+                 std::invalid_argument);
+}
+
+TEST_F(GeodeticCalculatorTest, DistanceMatrixAndRadiusQuery) {
+    const std::vector<double> lats_a = {new_york_.latitude, london_.latitude};
+    const std::vector<double> lons_a = {new_york_.longitude, london_.longitude};
+    const std::vector<double> lats_b = {los_angeles_.latitude, paris_.latitude, london_.latitude};
+    const std::vector<double> lons_b = {los_angeles_.longitude, paris_.longitude, london_.longitude};
+    std::vector<double> matrix(lats_a.size() * lats_b.size());
+    GeodeticCalculator::DistanceMatrix(lats_a, lons_a, lats_b, lons_b, matrix, DistanceFormula::VINCENTY);
+    EXPECT_NEAR(matrix[0], GeodeticCalculator::VincentyDistance(new_york_, los_angeles_), 1e-5);
+    EXPECT_NEAR(matrix[4], GeodeticCalculator::VincentyDistance(london_, paris_), 1e-5);
+    EXPECT_EQ(matrix[5], 0.0);
+
+    // Points on a grid, including across the antimeridian and over the pole
+    std::vector<double> lats;
+    std::vector<double> lons;
+    for (double lat = -89.0; lat <= 89.0; lat += 1.0) {
+        for (double lon = -179.5; lon < 180.0; lon += 1.0) {
+            lats.push_back(lat);
+            lons.push_back(lon);
+        }
+    }
+    const std::vector<Geographic> centers = {
+        london_, Geographic(10.0, 179.0, 0.0), Geographic(85.0, 40.0, 0.0), Geographic(-60.0, -170.0, 0.0)};
+    for (const Geographic& center : centers) {
+        for (const DistanceFormula formula : {DistanceFormula::HAVERSINE, DistanceFormula::VINCENTY}) {
+            const double radius = 900000.0;
+            const std::vector<std::size_t> found =
+                GeodeticCalculator::FindWithinDistance(center, radius, lats, lons, formula);
+
+            std::vector<std::size_t> expected;
+            for (std::size_t i = 0; i < lats.size(); ++i) {
+                const Geographic point(lats[i], lons[i], 0.0);
+                double distance = GeodeticCalculator::HaversineDistance(center, point);
+                if (formula == DistanceFormula::VINCENTY && distance < 2.0 * radius) {
+                    distance = GeodeticCalculator::VincentyDistance(center, point);
+                }
+                if (distance <= radius) {
+                    expected.push_back(i);
+                }
+            }
+            EXPECT_FALSE(expected.empty());
+            EXPECT_EQ(found, expected) << center.latitude << ", " << center.longitude;
+        }
+    }
+}
+
 class GeodeticPathTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -393,6 +483,34 @@ TEST_F(TileMathematicsTest, QuadtreeKey) {
     EXPECT_EQ(parent.ToTileCoordinates(), san_francisco_tile_.GetParent());
 }
 
+TEST_F(TileMathematicsTest, PackedQuadtreeKey) {
+    // Bing's example tile: x 3, y 5, zoom 3 is "213"
+    constexpr QuadtreeKey key(TileCoordinates(3, 5, 3));
+    static_assert(key.GetZoom() == 3);
+    static_assert(key.GetParent() == QuadtreeKey(TileCoordinates(1, 2, 2)));
+    static_assert(key.GetChild(3).ToTileCoordinates() == TileCoordinates(7, 11, 4));
+    static_assert(key.Contains(key.GetChild(1)) && !key.GetChild(1).Contains(key));
+    EXPECT_EQ(key.ToString(), "213");
+    EXPECT_EQ(QuadtreeKey(std::string("213")), key);
+    EXPECT_EQ(QuadtreeKey(std::string_view()).ToTileCoordinates(), TileCoordinates(0, 0, 0));
+    EXPECT_FALSE(QuadtreeKey(std::string("24")).IsValid());
+    EXPECT_FALSE(QuadtreeKey(TileCoordinates(8, 0, 3)).IsValid());
+    EXPECT_FALSE(QuadtreeKey(TileCoordinates(0, 0, 0)).GetParent().IsValid());
+    
+    // Neighbors wrap in x and stop at the poles
+    EXPECT_EQ(key.GetNeighbor(5, 0).ToTileCoordinates(), TileCoordinates(0, 5, 3));
+    EXPECT_EQ(key.GetNeighbor(-1, 2).ToTileCoordinates(), TileCoordinates(2, 7, 3));
+    EXPECT_FALSE(key.GetNeighbor(0, 3).IsValid());
+    
+    // Round trips at the deepest zoom, in the same order as the strings
+    const TileCoordinates deep((1 << 30) - 1, 12345, 30);
+    const QuadtreeKey deep_key(deep);
+    EXPECT_EQ(deep_key.ToTileCoordinates(), deep);
+    EXPECT_EQ(QuadtreeKey(deep_key.ToString()), deep_key);
+    EXPECT_LT(key, key.GetChild(0));
+    EXPECT_LT(key.GetChild(0), key.GetChild(1));
+}
+
 TEST_F(TileMathematicsTest, GroundResolution) {
     const double resolution = TileMathematics::CalculateGroundResolution(10, 37.7749);
     EXPECT_GT(resolution, 0);
@@ -429,4 +547,17 @@ TEST_F(TerrainCalculatorTest, LineOfSight) {
     
     // Should have line of sight since target is higher
     EXPECT_TRUE(TerrainCalculator::LineOfSight(observer, target));
-}
\ No newline at end of file
+}
+
+TEST_F(TerrainCalculatorTest, LineOfSightOverTerrain) {
+    // Sight line rises 100 m over ~111 m: about 150 m at the middle sample
+    EXPECT_TRUE(TerrainCalculator::LineOfSight(low_point_, high_point_, {110.0, 140.0, 160.0}));
+    EXPECT_FALSE(TerrainCalculator::LineOfSight(low_point_, high_point_, {110.0, 180.0, 160.0}));
+
+    // 20 km over a sea-level sphere: the bulge blocks 2 m masts, not 100 m ones
+    const std::vector<double> sea(99, 0.0);
+    EXPECT_FALSE(TerrainCalculator::LineOfSight(Geographic(0.0, 0.0, 2.0),
+                                                Geographic(0.18, 0.0, 2.0), sea));
+    EXPECT_TRUE(TerrainCalculator::LineOfSight(Geographic(0.0, 0.0, 100.0),
+                                               Geographic(0.18, 0.0, 100.0), sea));
+}
@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+#include <earth_map/core/memory_budget_manager.h>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+namespace earth_map::tests {
+
+namespace {
+
+constexpr std::size_t kMb = 1024 * 1024;
+
+/// LRU cache stand-in: holds bytes up to its budget and counts lookups
+struct FakeCache {
+    std::size_t budget = 0;
+    std::size_t used = 0;
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+
+    void Fill() { used = budget; }
+
+    void SetBudget(std::size_t bytes) {
+        budget = bytes;
+        used = std::min(used, budget);
+    }
+};
+
+MemoryConsumer MakeConsumer(const std::string& name, FakeCache& cache, std::size_t initial,
+                            MemoryTier tier = MemoryTier::RAM) {
+    MemoryConsumer consumer;
+    consumer.name = name;
+    consumer.tier = tier;
+    consumer.initial_bytes = initial;
+    consumer.sample = [&cache] {
+        return MemoryConsumerUsage{cache.used, cache.hits, cache.misses};
+    };
+    consumer.set_budget = [&cache](std::size_t bytes) { cache.SetBudget(bytes); };
+    return consumer;
+}
+
+MemoryBudgetConfig NoPressureConfig() {
+    MemoryBudgetConfig config;
+    config.pressure_source = [] { return MemoryPressure::NONE; };
+    return config;
+}
+
+} // namespace
+
+TEST(MemoryBudgetManagerTest, SplitsTierInProportionToInitialSizes) {
+    MemoryBudgetConfig config = NoPressureConfig();
+    config.ram_budget_bytes = 300 * kMb;
+    MemoryBudgetManager manager(config);
+    FakeCache tiles;
+    FakeCache elevation;
+    manager.Register(MakeConsumer("tiles", tiles, 100 * kMb));
+    manager.Register(MakeConsumer("elevation", elevation, 200 * kMb));
+
+    EXPECT_EQ(tiles.budget, 100 * kMb);
+    EXPECT_EQ(elevation.budget, 200 * kMb);
+
+    manager.SetTierBudget(MemoryTier::RAM, 150 * kMb);
+    EXPECT_EQ(tiles.budget, 50 * kMb);
+    EXPECT_EQ(elevation.budget, 100 * kMb);
+}
+
+TEST(MemoryBudgetManagerTest, TierBudgetDefaultsToSumOfInitialSizes) {
+    MemoryBudgetManager manager(NoPressureConfig());
+    FakeCache pool;
+    FakeCache tiles;
+    manager.Register(MakeConsumer("pool", pool, 64 * kMb, MemoryTier::VRAM));
+    manager.Register(MakeConsumer("tiles", tiles, 100 * kMb));
+
+    EXPECT_EQ(manager.GetTierBudget(MemoryTier::VRAM), 64 * kMb);
+    EXPECT_EQ(manager.GetTierBudget(MemoryTier::RAM), 100 * kMb);
+    EXPECT_EQ(pool.budget, 64 * kMb);
+}
+
+TEST(MemoryBudgetManagerTest, UnregisterGivesBudgetToRemainingConsumers) {
+    MemoryBudgetConfig config = NoPressureConfig();
+    config.ram_budget_bytes = 200 * kMb;
+    MemoryBudgetManager manager(config);
+    FakeCache first;
+    FakeCache second;
+    manager.Register(MakeConsumer("first", first, 100 * kMb));
+    const auto id = manager.Register(MakeConsumer("second", second, 100 * kMb));
+    EXPECT_EQ(first.budget, 100 * kMb);
+
+    manager.Unregister(id);
+    EXPECT_EQ(first.budget, 200 * kMb);
+    EXPECT_EQ(manager.GetStatus().size(), 1u);
+}
+
+TEST(MemoryBudgetManagerTest, RegisterRejectsMissingCallbacks) {
+    MemoryBudgetManager manager(NoPressureConfig());
+    MemoryConsumer consumer;
+    consumer.name = "broken";
+    EXPECT_THROW(manager.Register(consumer), std::invalid_argument);
+}
+
+TEST(MemoryBudgetManagerTest, RebalanceMovesBudgetToTheFullCacheThatMisses) {
+    MemoryBudgetConfig config = NoPressureConfig();
+    config.ram_budget_bytes = 200 * kMb;
+    config.rebalance_step = 0.1;
+    MemoryBudgetManager manager(config);
+    FakeCache busy;
+    FakeCache idle;
+    manager.Register(MakeConsumer("busy", busy, 100 * kMb));
+    manager.Register(MakeConsumer("idle", idle, 100 * kMb));
+    busy.Fill();
+    idle.Fill();
+
+    busy.misses += 1000;
+    idle.misses += 10;
+    EXPECT_EQ(manager.Rebalance(), 1u);
+
+    EXPECT_EQ(busy.budget, 120 * kMb);
+    EXPECT_EQ(idle.budget, 80 * kMb);
+    EXPECT_EQ(busy.budget + idle.budget, 200 * kMb);
+}
+
+TEST(MemoryBudgetManagerTest, RebalanceIgnoresMissesOfCachesWithRoom) {
+    MemoryBudgetConfig config = NoPressureConfig();
+    config.ram_budget_bytes = 200 * kMb;
+    MemoryBudgetManager manager(config);
+    FakeCache cold;
+    FakeCache warm;
+    manager.Register(MakeConsumer("cold", cold, 100 * kMb));
+    manager.Register(MakeConsumer("warm", warm, 100 * kMb));
+    warm.Fill();
+
+    // Misses of a cache that is not full are data it never held
+    cold.misses += 1000;
+    EXPECT_EQ(manager.Rebalance(), 0u);
+    EXPECT_EQ(cold.budget, 100 * kMb);
+    EXPECT_EQ(warm.budget, 100 * kMb);
+}
+
+TEST(MemoryBudgetManagerTest, RebalanceRespectsHysteresisAndLimits) {
+    MemoryBudgetConfig config = NoPressureConfig();
+    config.ram_budget_bytes = 200 * kMb;
+    config.rebalance_step = 0.5;
+    config.rebalance_hysteresis = 2.0;
+    MemoryBudgetManager manager(config);
+    FakeCache a;
+    FakeCache b;
+    MemoryConsumer consumer_a = MakeConsumer("a", a, 100 * kMb);
+    consumer_a.max_bytes = 130 * kMb;
+    MemoryConsumer consumer_b = MakeConsumer("b", b, 100 * kMb);
+    consumer_b.min_bytes = 90 * kMb;
+    manager.Register(std::move(consumer_a));
+    manager.Register(std::move(consumer_b));
+    a.Fill();
+    b.Fill();
+
+    // Within the hysteresis: nothing moves
+    a.misses += 150;
+    b.misses += 100;
+    EXPECT_EQ(manager.Rebalance(), 0u);
+
+    // Beyond it: the step is capped by b's minimum
+    a.misses += 1000;
+    b.misses += 10;
+    EXPECT_EQ(manager.Rebalance(), 1u);
+    EXPECT_EQ(a.budget, 110 * kMb);
+    EXPECT_EQ(b.budget, 90 * kMb);
+}
+
+TEST(MemoryBudgetManagerTest, ModeratePressureShedsInShedOrderAndKeepsBudgets) {
+    MemoryBudgetConfig config = NoPressureConfig();
+    config.ram_budget_bytes = 200 * kMb;
+    MemoryBudgetManager manager(config);
+    FakeCache first;
+    FakeCache last;
+    MemoryConsumer consumer_first = MakeConsumer("first", first, 100 * kMb);
+    consumer_first.shed_order = 0;
+    MemoryConsumer consumer_last = MakeConsumer("last", last, 100 * kMb);
+    consumer_last.shed_order = 1;
+    manager.Register(std::move(consumer_last));
+    manager.Register(std::move(consumer_first));
+    first.Fill();
+    last.Fill();
+
+    // Halving the first consumer releases a quarter of the held bytes
+    EXPECT_EQ(manager.OnMemoryPressure(MemoryPressure::MODERATE), 50 * kMb);
+    EXPECT_EQ(first.used, 50 * kMb);
+    EXPECT_EQ(last.used, 100 * kMb);
+    EXPECT_EQ(first.budget, 100 * kMb);
+}
+
+TEST(MemoryBudgetManagerTest, CriticalPressureShedsEveryTierToMinimums) {
+    MemoryBudgetManager manager(NoPressureConfig());
+    FakeCache ram;
+    FakeCache vram;
+    std::size_t shed_target = SIZE_MAX;
+    MemoryConsumer ram_consumer = MakeConsumer("ram", ram, 100 * kMb);
+    ram_consumer.min_bytes = 10 * kMb;
+    MemoryConsumer vram_consumer = MakeConsumer("vram", vram, 64 * kMb, MemoryTier::VRAM);
+    vram_consumer.shed = [&](std::size_t bytes) {
+        shed_target = bytes;
+        vram.used = std::min(vram.used, bytes);
+    };
+    manager.Register(std::move(ram_consumer));
+    manager.Register(std::move(vram_consumer));
+    ram.Fill();
+    vram.Fill();
+
+    EXPECT_EQ(manager.OnMemoryPressure(MemoryPressure::CRITICAL), 90 * kMb + 64 * kMb);
+    EXPECT_EQ(ram.used, 10 * kMb);
+    EXPECT_EQ(shed_target, 0u);
+    EXPECT_EQ(ram.budget, 100 * kMb);
+    EXPECT_EQ(manager.GetUsedBytes(MemoryTier::VRAM), 0u);
+}
+
+TEST(MemoryBudgetManagerTest, PollShedsUnderPressureAndRebalancesWhenDue) {
+    MemoryPressure pressure = MemoryPressure::NONE;
+    MemoryBudgetConfig config;
+    config.ram_budget_bytes = 200 * kMb;
+    config.rebalance_step = 0.1;
+    config.rebalance_interval = std::chrono::seconds(5);
+    config.pressure_interval = std::chrono::seconds(1);
+    config.pressure_source = [&pressure] { return pressure; };
+    MemoryBudgetManager manager(config);
+    FakeCache busy;
+    FakeCache idle;
+    manager.Register(MakeConsumer("busy", busy, 100 * kMb));
+    manager.Register(MakeConsumer("idle", idle, 100 * kMb));
+    busy.Fill();
+    idle.Fill();
+
+    const auto start = std::chrono::steady_clock::now();
+    pressure = MemoryPressure::CRITICAL;
+    manager.Poll(start);
+    EXPECT_EQ(busy.used, 0u);
+    EXPECT_EQ(idle.used, 0u);
+
+    // Pressure gone: the next rebalance waits for its interval
+    pressure = MemoryPressure::NONE;
+    busy.Fill();
+    idle.Fill();
+    busy.misses += 1000;
+    manager.Poll(start + std::chrono::seconds(2));
+    EXPECT_EQ(busy.budget, 100 * kMb);
+    manager.Poll(start + std::chrono::seconds(6));
+    EXPECT_EQ(busy.budget, 120 * kMb);
+    EXPECT_EQ(idle.budget, 80 * kMb);
+}
+
+} // namespace earth_map::tests
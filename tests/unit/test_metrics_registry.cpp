@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+#include <earth_map/core/metrics_registry.h>
+#include <fmt/format.h>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace earth_map::tests {
+
+TEST(MetricsRegistryTest, CounterSumsShardsOfAllThreads) {
+    MetricsRegistry registry;
+    CounterMetric& counter = registry.GetCounter("requests_total", "Requests");
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; ++t) {
+        threads.emplace_back([&counter] {
+            for (int i = 0; i < 1000; ++i) {
+                counter.Increment();
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(counter.GetValue(), 8000u);
+    EXPECT_EQ(&registry.GetCounter("requests_total", "Requests"), &counter);
+}
+
+TEST(MetricsRegistryTest, LabelsSeparateSeries) {
+    MetricsRegistry registry;
+    registry.GetCounter("hits_total", "Hits", {{"level", "memory"}}).Increment(3);
+    registry.GetCounter("hits_total", "Hits", {{"level", "disk"}}).Increment(5);
+
+    const MetricsSnapshot snapshot = registry.Collect();
+    ASSERT_NE(snapshot.Find("hits_total", {{"level", "memory"}}), nullptr);
+    EXPECT_EQ(snapshot.Find("hits_total", {{"level", "memory"}})->value, 3.0);
+    EXPECT_EQ(snapshot.Find("hits_total", {{"level", "disk"}})->value, 5.0);
+    EXPECT_EQ(snapshot.Find("hits_total"), nullptr);
+}
+
+TEST(MetricsRegistryTest, NameKeepsItsType) {
+    MetricsRegistry registry;
+    registry.GetGauge("queue_depth", "Depth");
+    EXPECT_THROW(registry.GetCounter("queue_depth", "Depth"), std::invalid_argument);
+}
+
+TEST(MetricsRegistryTest, HistogramMergesShards) {
+    MetricsRegistry registry;
+    HistogramMetric& histogram = registry.GetHistogram("latency_ms", "Latency");
+    std::thread other([&histogram] { histogram.Record(100.0); });
+    other.join();
+    histogram.Record(1.0);
+    histogram.Record(2.0);
+
+    const LatencyHistogram snapshot = histogram.Snapshot();
+    EXPECT_EQ(snapshot.GetCount(), 3u);
+    EXPECT_DOUBLE_EQ(snapshot.GetSum(), 103.0);
+    EXPECT_DOUBLE_EQ(snapshot.GetMax(), 100.0);
+}
+
+TEST(MetricsRegistryTest, CollectorsRunOnCollectUntilRemoved) {
+    MetricsRegistry registry;
+    int value = 7;
+    const std::size_t id = registry.AddCollector([&value](MetricsSnapshot& out) {
+        out.AddGauge("tiles", "Tiles", value);
+    });
+    EXPECT_EQ(registry.Collect().Find("tiles")->value, 7.0);
+    value = 9;
+    EXPECT_EQ(registry.Collect().Find("tiles")->value, 9.0);
+
+    registry.RemoveCollector(id);
+    EXPECT_EQ(registry.Collect().Find("tiles"), nullptr);
+}
+
+TEST(MetricsRegistryTest, PrometheusGroupsSeriesUnderOneHeader) {
+    MetricsSnapshot snapshot;
+    snapshot.AddCounter("hits_total", "Cache hits", 3, {{"level", "memory"}});
+    snapshot.AddGauge("bytes", "Size", 1.5);
+    snapshot.AddCounter("hits_total", "Cache hits", 5, {{"level", "di\"sk"}});
+
+    std::ostringstream out;
+    snapshot.WritePrometheus(out);
+    const std::string text = out.str();
+    EXPECT_NE(text.find("# HELP hits_total Cache hits\n# TYPE hits_total counter\n"
+                        "hits_total{level=\"memory\"} 3\nhits_total{level=\"di\\\"sk\"} 5\n"),
+              std::string::npos);
+    EXPECT_NE(text.find("# TYPE bytes gauge\nbytes 1.5\n"), std::string::npos);
+    EXPECT_EQ(text.find("# TYPE hits_total", text.find("# TYPE hits_total") + 1), std::string::npos);
+}
+
+TEST(MetricsRegistryTest, PrometheusHistogramBucketsAreCumulative) {
+    LatencyHistogram histogram;
+    histogram.Record(0.005);
+    histogram.Record(50.0);
+    MetricsSnapshot snapshot;
+    snapshot.AddHistogram("load_ms", "Load time", histogram, {{"host", "a"}});
+
+    std::ostringstream out;
+    snapshot.WritePrometheus(out);
+    const std::string text = out.str();
+    EXPECT_NE(text.find("# TYPE load_ms histogram"), std::string::npos);
+    EXPECT_NE(text.find("load_ms_bucket{host=\"a\",le=\"+Inf\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("load_ms_count{host=\"a\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("load_ms_sum{host=\"a\"} 50.005\n"), std::string::npos);
+
+    // The first exported bucket (le of bucket 3) already holds the fast sample
+    const std::string first_bucket = "load_ms_bucket{host=\"a\",le=\"" +
+        fmt::format("{}", LatencyHistogram::GetBucketUpperBound(3)) + "\"} 1\n";
+    EXPECT_NE(text.find(first_bucket), std::string::npos);
+}
+
+TEST(MetricsRegistryTest, JsonListsEveryMetric) {
+    MetricsRegistry registry;
+    registry.GetCounter("frames_total", "Frames").Increment(2);
+    registry.GetHistogram("frame_ms", "Frame \"time\"").Record(4.0);
+
+    const std::string json = registry.ExportJson();
+    EXPECT_EQ(json.rfind("{\"metrics\":[", 0), 0u);
+    EXPECT_NE(json.find("\"name\":\"frames_total\",\"type\":\"counter\""), std::string::npos);
+    EXPECT_NE(json.find("\"value\":2"), std::string::npos);
+    EXPECT_NE(json.find("\"help\":\"Frame \\\"time\\\"\""), std::string::npos);
+    EXPECT_NE(json.find("\"count\":1"), std::string::npos);
+}
+
+} // namespace earth_map::tests
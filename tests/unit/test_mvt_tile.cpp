@@ -0,0 +1,174 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/mvt_tile.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+using Bytes = std::vector<std::uint8_t>;
+
+void PutVarint(Bytes& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+void PutKey(Bytes& out, std::uint32_t field, std::uint32_t wire_type) {
+    PutVarint(out, (field << 3) | wire_type);
+}
+
+void PutBytes(Bytes& out, std::uint32_t field, const Bytes& bytes) {
+    PutKey(out, field, 2);
+    PutVarint(out, bytes.size());
+    out.insert(out.end(), bytes.begin(), bytes.end());
+}
+
+void PutString(Bytes& out, std::uint32_t field, const std::string& text) {
+    PutBytes(out, field, Bytes(text.begin(), text.end()));
+}
+
+void PutPacked(Bytes& out, std::uint32_t field, const std::vector<std::uint32_t>& values) {
+    Bytes packed;
+    for (const std::uint32_t value : values) {
+        PutVarint(packed, value);
+    }
+    PutBytes(out, field, packed);
+}
+
+std::uint32_t Command(std::uint32_t id, std::uint32_t count) { return id | (count << 3); }
+std::uint32_t Zig(std::int32_t value) {
+    return static_cast<std::uint32_t>((value << 1) ^ (value >> 31));
+}
+
+Bytes Feature(std::uint64_t id, std::uint32_t type, const std::vector<std::uint32_t>& tags,
+              const std::vector<std::uint32_t>& geometry) {
+    Bytes out;
+    PutKey(out, 1, 0);
+    PutVarint(out, id);
+    PutPacked(out, 2, tags);
+    PutKey(out, 3, 0);
+    PutVarint(out, type);
+    PutPacked(out, 4, geometry);
+    return out;
+}
+
+/// Layer "water": a 10x10 square with a 2x2 hole and a two-segment line
+Bytes WaterLayer() {
+    Bytes layer;
+    PutKey(layer, 15, 0);
+    PutVarint(layer, 2);
+    PutString(layer, 1, "water");
+
+    // Exterior (0,0) (10,0) (10,10) (0,10), clockwise with y down;
+    // hole (4,4) (4,6) (6,6) (6,4), counter-clockwise
+    PutBytes(layer, 2, Feature(7, 3, {0, 0, 1, 1}, {
+        Command(1, 1), Zig(0), Zig(0),
+        Command(2, 3), Zig(10), Zig(0), Zig(0), Zig(10), Zig(-10), Zig(0),
+        Command(7, 1),
+        Command(1, 1), Zig(4), Zig(-6),
+        Command(2, 3), Zig(0), Zig(2), Zig(2), Zig(0), Zig(0), Zig(-2),
+        Command(7, 1)}));
+    PutBytes(layer, 2, Feature(8, 2, {0, 2}, {
+        Command(1, 1), Zig(2), Zig(2),
+        Command(2, 2), Zig(4), Zig(0), Zig(0), Zig(4)}));
+
+    PutString(layer, 3, "class");
+    PutString(layer, 3, "depth");
+    Bytes lake;
+    PutString(lake, 1, "lake");
+    PutBytes(layer, 4, lake);
+    Bytes depth;
+    PutKey(depth, 6, 0);
+    PutVarint(depth, Zig(-12));
+    PutBytes(layer, 4, depth);
+    Bytes river;
+    PutString(river, 1, "river");
+    PutBytes(layer, 4, river);
+
+    // Extent after the features
+    PutKey(layer, 5, 0);
+    PutVarint(layer, 10);
+    return layer;
+}
+
+} // namespace
+
+TEST(MvtTileTest, DecodesLayersFeaturesAndGeometry) {
+    Bytes tile_bytes;
+    PutBytes(tile_bytes, 3, WaterLayer());
+    Bytes roads;
+    PutString(roads, 1, "roads");
+    PutBytes(tile_bytes, 3, roads);
+
+    const auto tile = DecodeMvtTile(tile_bytes);
+    ASSERT_TRUE(tile.has_value());
+    ASSERT_EQ(tile->layers.size(), 2u);
+    EXPECT_EQ(tile->FindLayer("roads")->features.size(), 0u);
+    EXPECT_EQ(tile->FindLayer("buildings"), nullptr);
+
+    const MvtLayer& water = *tile->FindLayer("water");
+    EXPECT_EQ(water.version, 2u);
+    EXPECT_EQ(water.extent, 10u);
+    ASSERT_EQ(water.features.size(), 2u);
+
+    const MvtFeature& polygon = water.features[0];
+    EXPECT_EQ(polygon.id, 7u);
+    EXPECT_EQ(polygon.type, MvtGeometryType::POLYGON);
+    ASSERT_EQ(polygon.geometry.size(), 2u);
+    ASSERT_EQ(polygon.geometry[0].size(), 4u);
+    EXPECT_FLOAT_EQ(polygon.geometry[0][2].x, 1.0f);
+    EXPECT_FLOAT_EQ(polygon.geometry[0][2].y, 1.0f);
+    EXPECT_FLOAT_EQ(polygon.geometry[1][0].x, 0.4f);
+    EXPECT_FLOAT_EQ(polygon.geometry[1][0].y, 0.4f);
+    EXPECT_GT(MvtRingArea(polygon.geometry[0]), 0.0);
+    EXPECT_LT(MvtRingArea(polygon.geometry[1]), 0.0);
+    EXPECT_NEAR(MvtRingArea(polygon.geometry[1]), -0.04, 1e-6);
+
+    const MvtValue* lake = water.GetProperty(polygon, "class");
+    ASSERT_NE(lake, nullptr);
+    EXPECT_EQ(std::get<std::string>(*lake), "lake");
+    EXPECT_EQ(std::get<std::int64_t>(*water.GetProperty(polygon, "depth")), -12);
+    EXPECT_EQ(water.GetProperty(polygon, "name"), nullptr);
+
+    const MvtFeature& line = water.features[1];
+    EXPECT_EQ(line.type, MvtGeometryType::LINESTRING);
+    ASSERT_EQ(line.geometry.size(), 1u);
+    ASSERT_EQ(line.geometry[0].size(), 3u);
+    EXPECT_FLOAT_EQ(line.geometry[0][2].x, 0.6f);
+    EXPECT_FLOAT_EQ(line.geometry[0][2].y, 0.6f);
+    EXPECT_EQ(std::get<std::string>(*water.GetProperty(line, "class")), "river");
+}
+
+TEST(MvtTileTest, DropsMalformedFeaturesAndRejectsMalformedTiles) {
+    Bytes layer;
+    PutString(layer, 1, "points");
+    // LineTo before any MoveTo
+    PutBytes(layer, 2, Feature(1, 1, {}, {Command(2, 1), Zig(1), Zig(1)}));
+    // Two points in one part
+    PutBytes(layer, 2, Feature(2, 1, {}, {Command(1, 2), Zig(1), Zig(1), Zig(2), Zig(2)}));
+    Bytes tile_bytes;
+    PutBytes(tile_bytes, 3, layer);
+
+    const auto tile = DecodeMvtTile(tile_bytes);
+    ASSERT_TRUE(tile.has_value());
+    ASSERT_EQ(tile->layers[0].features.size(), 1u);
+    EXPECT_EQ(tile->layers[0].features[0].id, 2u);
+    ASSERT_EQ(tile->layers[0].features[0].geometry.size(), 1u);
+    EXPECT_EQ(tile->layers[0].features[0].geometry[0].size(), 2u);
+
+    // A layer length running past the end of the data
+    Bytes truncated(tile_bytes.begin(), tile_bytes.end() - 3);
+    EXPECT_FALSE(DecodeMvtTile(truncated).has_value());
+
+    // Empty data is an empty tile
+    const auto empty = DecodeMvtTile({});
+    ASSERT_TRUE(empty.has_value());
+    EXPECT_TRUE(empty->layers.empty());
+}
+
+} // namespace earth_map::tests
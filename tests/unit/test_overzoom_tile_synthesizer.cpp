@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/texture_atlas/overzoom_tile_synthesizer.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+/// 4x4 single-channel image where each 2x2 quadrant has its own value
+DecodedImage MakeQuadrantImage() {
+    DecodedImage image;
+    image.width = 4;
+    image.height = 4;
+    image.channels = 1;
+    image.pixels = {
+        10, 10, 20, 20,
+        10, 10, 20, 20,
+        30, 30, 40, 40,
+        30, 30, 40, 40,
+    };
+    return image;
+}
+
+} // namespace
+
+TEST(OverzoomTileSynthesizerTest, SourceIsAncestorAtMaxZoom) {
+    const auto source = OverzoomTileSynthesizer::GetSourceTile(TileCoordinates(13, 6, 4), 2);
+    ASSERT_TRUE(source.has_value());
+    EXPECT_EQ(*source, TileCoordinates(3, 1, 2));
+
+    // Within the provider's range, or too deep to be useful
+    EXPECT_FALSE(OverzoomTileSynthesizer::GetSourceTile(TileCoordinates(1, 1, 2), 2));
+    EXPECT_FALSE(OverzoomTileSynthesizer::GetSourceTile(
+        TileCoordinates(0, 0, 2 + OverzoomTileSynthesizer::kMaxOverzoomLevels + 1), 2));
+}
+
+TEST(OverzoomTileSynthesizerTest, CropsQuadrantOfAncestor) {
+    const DecodedImage image = MakeQuadrantImage();
+    const TileCoordinates source(0, 0, 0);
+    std::vector<std::uint8_t> out(16, 0);
+
+    // Child (1, 1) covers the bottom-right quadrant: interior pixels keep its value
+    ASSERT_TRUE(OverzoomTileSynthesizer::Synthesize(
+        image, source, TileCoordinates(1, 1, 1), out.data(), out.size()));
+    EXPECT_EQ(out[3 * 4 + 3], 40);
+    EXPECT_EQ(out[2 * 4 + 2], 40);
+
+    // The edge facing a neighbour quadrant blends towards it (no hard seam)
+    EXPECT_GT(out[0], 10);
+    EXPECT_LT(out[0], 40);
+}
+
+TEST(OverzoomTileSynthesizerTest, RejectsTargetOutsideSource) {
+    const DecodedImage image = MakeQuadrantImage();
+    std::vector<std::uint8_t> out(16, 0);
+
+    EXPECT_FALSE(OverzoomTileSynthesizer::Synthesize(
+        image, TileCoordinates(0, 0, 1), TileCoordinates(2, 0, 2), out.data(), out.size()));
+    EXPECT_FALSE(OverzoomTileSynthesizer::Synthesize(
+        image, TileCoordinates(0, 0, 0), TileCoordinates(0, 0, 1), out.data(), out.size() - 1));
+}
+
+TEST(OverzoomTileSynthesizerTest, DecodedSourcesAreEvictedLeastRecentlyUsed) {
+    OverzoomTileSynthesizer synthesizer(2);
+    const auto image = std::make_shared<const DecodedImage>(MakeQuadrantImage());
+
+    synthesizer.AddSource(TileCoordinates(0, 0, 18), image);
+    synthesizer.AddSource(TileCoordinates(1, 0, 18), image);
+    ASSERT_NE(synthesizer.FindSource(TileCoordinates(0, 0, 18)), nullptr);
+
+    synthesizer.AddSource(TileCoordinates(2, 0, 18), image);
+    EXPECT_EQ(synthesizer.GetCachedSourceCount(), 2u);
+    EXPECT_NE(synthesizer.FindSource(TileCoordinates(0, 0, 18)), nullptr);
+    EXPECT_EQ(synthesizer.FindSource(TileCoordinates(1, 0, 18)), nullptr);
+}
+
+} // namespace earth_map::tests
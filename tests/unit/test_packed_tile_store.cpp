@@ -0,0 +1,509 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/packed_tile_store.h>
+#include <earth_map/data/tile_cache.h>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+std::vector<std::uint8_t> MakeBytes(std::size_t size, std::uint8_t seed) {
+    std::vector<std::uint8_t> bytes(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        bytes[i] = static_cast<std::uint8_t>(seed + i);
+    }
+    return bytes;
+}
+
+TileMetadata MakeMetadata(int32_t x, int32_t y, int32_t zoom, std::size_t size) {
+    TileMetadata metadata(TileCoordinates(x, y, zoom));
+    metadata.file_size = size;
+    metadata.etag = "etag-" + std::to_string(x);
+    metadata.content_type = "image/png";
+    metadata.last_modified = std::chrono::system_clock::now();
+    return metadata;
+}
+
+} // namespace
+
+class PackedTileStoreTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() /
+                     ("earth_map_packed_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) +
+                      "_" + ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(directory_);
+        config_.directory = directory_.string();
+        config_.segment_size = 16 * 1024;
+        config_.background_compaction = false;
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    bool PutTile(PackedTileStore& store, int32_t x, std::size_t size = 1000) {
+        const auto bytes = MakeBytes(size, static_cast<std::uint8_t>(x));
+        return store.Put(MakeMetadata(x, 0, 10, size), bytes);
+    }
+
+    std::filesystem::path directory_;
+    PackedTileStoreConfig config_;
+};
+
+TEST_F(PackedTileStoreTest, PutAndGetRoundTrip) {
+    PackedTileStore store(config_);
+    ASSERT_TRUE(store.Open());
+
+    ASSERT_TRUE(PutTile(store, 7, 1234));
+
+    auto view = store.Get(TileCoordinates(7, 0, 10));
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(view->Data().size(), 1234u);
+    EXPECT_EQ(view->Data()[0], 7u);
+    EXPECT_EQ(view->Metadata().etag, "etag-7");
+    EXPECT_EQ(view->Metadata().content_type, "image/png");
+    EXPECT_EQ(view->Metadata().coordinates, TileCoordinates(7, 0, 10));
+
+    EXPECT_FALSE(store.Get(TileCoordinates(8, 0, 10)).has_value());
+}
+
+TEST_F(PackedTileStoreTest, OverwriteAndRemove) {
+    PackedTileStore store(config_);
+    ASSERT_TRUE(store.Open());
+
+    PutTile(store, 1, 100);
+    PutTile(store, 1, 200);
+    EXPECT_EQ(store.Get(TileCoordinates(1, 0, 10))->Data().size(), 200u);
+    EXPECT_EQ(store.GetStats().tile_count, 1u);
+    EXPECT_GT(store.GetStats().dead_bytes, 0u);
+
+    EXPECT_TRUE(store.Remove(TileCoordinates(1, 0, 10)));
+    EXPECT_FALSE(store.Contains(TileCoordinates(1, 0, 10)));
+    EXPECT_FALSE(store.Remove(TileCoordinates(1, 0, 10)));
+}
+
+TEST_F(PackedTileStoreTest, UpdateMetadataKeepsData) {
+    PackedTileStore store(config_);
+    ASSERT_TRUE(store.Open());
+    PutTile(store, 3, 500);
+
+    TileMetadata metadata = MakeMetadata(3, 0, 10, 500);
+    metadata.etag = "updated";
+    ASSERT_TRUE(store.UpdateMetadata(metadata));
+
+    auto view = store.Get(TileCoordinates(3, 0, 10));
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(view->Metadata().etag, "updated");
+    EXPECT_EQ(view->Data().size(), 500u);
+    EXPECT_EQ(view->Data()[1], 4u);
+
+    EXPECT_FALSE(store.UpdateMetadata(MakeMetadata(99, 0, 10, 1)));
+}
+
+TEST_F(PackedTileStoreTest, UpdateMetadataSurvivesCompactionAndReopen) {
+    {
+        PackedTileStore store(config_);
+        ASSERT_TRUE(store.Open());
+        for (int i = 0; i < 40; ++i) {
+            PutTile(store, i, 1000);
+        }
+        for (int i = 0; i < 2; ++i) {
+            TileMetadata metadata = MakeMetadata(i, 0, 10, 1000);
+            metadata.etag = "updated-" + std::to_string(i);
+            ASSERT_TRUE(store.UpdateMetadata(metadata));
+        }
+
+        // Only the first segment's tiles 0 and 1 stay live; their metadata
+        // lives in a later segment until compaction folds it back in
+        const std::size_t usage_before_overwrite = store.GetDiskUsage();
+        for (int i = 2; i < 40; ++i) {
+            PutTile(store, i, 1001);
+        }
+        EXPECT_GT(store.GetDiskUsage(), usage_before_overwrite);
+        EXPECT_GT(store.Compact(), 0u);
+
+        auto view = store.Get(TileCoordinates(0, 0, 10));
+        ASSERT_TRUE(view.has_value());
+        EXPECT_EQ(view->Metadata().etag, "updated-0");
+        EXPECT_EQ(view->Data().size(), 1000u);
+    }
+
+    PackedTileStore reopened(config_);
+    ASSERT_TRUE(reopened.Open());
+    EXPECT_EQ(reopened.GetStats().tile_count, 40u);
+    for (int i = 0; i < 2; ++i) {
+        auto view = reopened.Get(TileCoordinates(i, 0, 10));
+        ASSERT_TRUE(view.has_value());
+        EXPECT_EQ(view->Metadata().etag, "updated-" + std::to_string(i));
+        EXPECT_EQ(view->Data()[0], static_cast<std::uint8_t>(i));
+    }
+    EXPECT_EQ(reopened.GetMetadata(TileCoordinates(2, 0, 10))->etag, "etag-2");
+}
+
+TEST_F(PackedTileStoreTest, EvictToFitDropsOldestSegments) {
+    PackedTileStore store(config_);
+    ASSERT_TRUE(store.Open());
+    for (int i = 0; i < 80; ++i) {
+        ASSERT_TRUE(PutTile(store, i, 1000));
+    }
+    ASSERT_GT(store.GetStats().segment_count, 3u);
+
+    const std::size_t budget = 2 * config_.segment_size;
+    const std::size_t evicted = store.EvictToFit(budget);
+    EXPECT_GT(evicted, 0u);
+    EXPECT_LE(store.GetDiskUsage(), budget);
+    EXPECT_EQ(store.GetStats().tile_count, 80u - evicted);
+
+    // Oldest writes go first; the newest survive
+    EXPECT_FALSE(store.Contains(TileCoordinates(0, 0, 10)));
+    EXPECT_TRUE(store.Contains(TileCoordinates(79, 0, 10)));
+    EXPECT_EQ(store.EvictToFit(budget), 0u);
+
+    store.Close();
+    PackedTileStore reopened(config_);
+    ASSERT_TRUE(reopened.Open());
+    EXPECT_EQ(reopened.GetStats().tile_count, 80u - evicted);
+    EXPECT_FALSE(reopened.Contains(TileCoordinates(0, 0, 10)));
+}
+
+TEST_F(PackedTileStoreTest, RollsOverToNewSegments) {
+    PackedTileStore store(config_);
+    ASSERT_TRUE(store.Open());
+
+    for (int i = 0; i < 40; ++i) {
+        ASSERT_TRUE(PutTile(store, i, 1000));
+    }
+    EXPECT_GT(store.GetStats().segment_count, 1u);
+
+    // Record larger than a segment gets a segment of its own
+    ASSERT_TRUE(PutTile(store, 100, 40 * 1024));
+    EXPECT_EQ(store.Get(TileCoordinates(100, 0, 10))->Data().size(), 40u * 1024u);
+
+    for (int i = 0; i < 40; ++i) {
+        EXPECT_TRUE(store.Contains(TileCoordinates(i, 0, 10)));
+    }
+}
+
+TEST_F(PackedTileStoreTest, ReopenRecoversIndex) {
+    {
+        PackedTileStore store(config_);
+        ASSERT_TRUE(store.Open());
+        for (int i = 0; i < 30; ++i) {
+            PutTile(store, i, 900);
+        }
+        PutTile(store, 5, 300);
+        store.Remove(TileCoordinates(6, 0, 10));
+    }
+
+    PackedTileStore reopened(config_);
+    ASSERT_TRUE(reopened.Open());
+    EXPECT_EQ(reopened.GetStats().tile_count, 29u);
+    EXPECT_EQ(reopened.Get(TileCoordinates(5, 0, 10))->Data().size(), 300u);
+    EXPECT_FALSE(reopened.Contains(TileCoordinates(6, 0, 10)));
+    EXPECT_EQ(reopened.Get(TileCoordinates(29, 0, 10))->Data()[0], 29u);
+}
+
+TEST_F(PackedTileStoreTest, TornTailIsIgnoredOnReopen) {
+    {
+        PackedTileStore store(config_);
+        ASSERT_TRUE(store.Open());
+        PutTile(store, 1, 100);
+        PutTile(store, 2, 100);
+    }
+
+    // Simulate a crash mid-append: garbage after the last complete record
+    std::filesystem::path segment;
+    for (const auto& entry : std::filesystem::directory_iterator(directory_)) {
+        segment = entry.path();
+    }
+    ASSERT_FALSE(segment.empty());
+    {
+        std::ofstream file(segment, std::ios::binary | std::ios::app);
+        const char garbage[40] = {'E', 'T', 'P', 'K', 1};
+        file.write(garbage, sizeof(garbage));
+    }
+
+    PackedTileStore reopened(config_);
+    ASSERT_TRUE(reopened.Open());
+    EXPECT_EQ(reopened.GetStats().tile_count, 2u);
+    ASSERT_TRUE(PutTile(reopened, 3, 100));
+    EXPECT_TRUE(reopened.Contains(TileCoordinates(3, 0, 10)));
+}
+
+TEST_F(PackedTileStoreTest, CompactionReclaimsDeadSegments) {
+    PackedTileStore store(config_);
+    ASSERT_TRUE(store.Open());
+
+    // Fill several segments, then overwrite everything
+    for (int round = 0; round < 2; ++round) {
+        for (int i = 0; i < 40; ++i) {
+            PutTile(store, i, 1000 + static_cast<std::size_t>(round));
+        }
+    }
+    store.Remove(TileCoordinates(0, 0, 10));
+
+    auto held = store.Get(TileCoordinates(1, 0, 10));
+    ASSERT_TRUE(held.has_value());
+
+    const std::size_t usage_before = store.GetDiskUsage();
+    EXPECT_GT(store.Compact(), 0u);
+    EXPECT_LT(store.GetDiskUsage(), usage_before);
+    EXPECT_EQ(store.GetStats().tile_count, 39u);
+
+    for (int i = 1; i < 40; ++i) {
+        auto view = store.Get(TileCoordinates(i, 0, 10));
+        ASSERT_TRUE(view.has_value());
+        EXPECT_EQ(view->Data().size(), 1001u);
+    }
+
+    // Views taken before compaction stay readable
+    EXPECT_EQ(held->Data()[0], 1u);
+
+    // Removal survives compaction and reopen
+    store.Close();
+    PackedTileStore reopened(config_);
+    ASSERT_TRUE(reopened.Open());
+    EXPECT_FALSE(reopened.Contains(TileCoordinates(0, 0, 10)));
+    EXPECT_EQ(reopened.GetStats().tile_count, 39u);
+}
+
+TEST_F(PackedTileStoreTest, BackgroundCompactionRuns) {
+    config_.background_compaction = true;
+    config_.compaction_interval = std::chrono::milliseconds(10);
+    PackedTileStore store(config_);
+    ASSERT_TRUE(store.Open());
+
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 0; i < 30; ++i) {
+            PutTile(store, i, 1000);
+        }
+    }
+
+    for (int i = 0; i < 200 && store.GetStats().compacted_segments == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_GT(store.GetStats().compacted_segments, 0u);
+    EXPECT_EQ(store.GetStats().tile_count, 30u);
+}
+
+TEST_F(PackedTileStoreTest, ConcurrentReadersAndWriter) {
+    PackedTileStore store(config_);
+    ASSERT_TRUE(store.Open());
+    for (int i = 0; i < 20; ++i) {
+        PutTile(store, i, 600);
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<int> bad_reads{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t) {
+        readers.emplace_back([&]() {
+            while (!done.load()) {
+                for (int i = 0; i < 20; ++i) {
+                    auto view = store.Get(TileCoordinates(i, 0, 10));
+                    if (!view || view->Data().size() != 600u ||
+                        view->Data()[0] != static_cast<std::uint8_t>(i)) {
+                        bad_reads++;
+                    }
+                }
+            }
+        });
+    }
+
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 20; ++i) {
+            PutTile(store, i, 600);
+        }
+        store.Compact();
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_EQ(bad_reads.load(), 0);
+}
+
+TEST_F(PackedTileStoreTest, SharedStoresSeeEachOthersWrites) {
+    // Two instances on one directory stand in for two processes: their flocks conflict
+    config_.shared = true;
+    PackedTileStore first(config_);
+    PackedTileStore second(config_);
+    ASSERT_TRUE(first.Open());
+    ASSERT_TRUE(second.Open());
+
+    ASSERT_TRUE(PutTile(first, 3, 500));
+    auto view = second.Get(TileCoordinates(3, 0, 10));
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(view->Data().size(), 500u);
+    EXPECT_EQ(view->Data()[0], 3u);
+
+    // Both append to the same head segment
+    ASSERT_TRUE(PutTile(second, 4, 600));
+    ASSERT_TRUE(PutTile(first, 5, 700));
+    EXPECT_TRUE(first.Contains(TileCoordinates(4, 0, 10)));
+    EXPECT_TRUE(second.Contains(TileCoordinates(5, 0, 10)));
+    EXPECT_EQ(first.GetStats().segment_count, 1u);
+
+    EXPECT_TRUE(second.Remove(TileCoordinates(3, 0, 10)));
+    EXPECT_FALSE(first.Contains(TileCoordinates(3, 0, 10)));
+    EXPECT_EQ(view->Data()[0], 3u);  // Views outlive removal
+
+    // Rolling over to new segments, from either side
+    for (int i = 0; i < 40; ++i) {
+        PutTile(i % 2 ? first : second, 100 + i, 1000);
+    }
+    EXPECT_EQ(first.GetStats().tile_count, 42u);
+    EXPECT_EQ(second.GetStats().tile_count, 42u);
+    EXPECT_EQ(first.GetStats().segment_count, second.GetStats().segment_count);
+    EXPECT_EQ(second.Get(TileCoordinates(139, 0, 10))->Data()[0], 139u);
+}
+
+TEST_F(PackedTileStoreTest, SharedStoresPropagateClearAndCompaction) {
+    config_.shared = true;
+    PackedTileStore first(config_);
+    PackedTileStore second(config_);
+    ASSERT_TRUE(first.Open());
+    ASSERT_TRUE(second.Open());
+
+    for (int round = 0; round < 2; ++round) {
+        for (int i = 0; i < 40; ++i) {
+            PutTile(round ? second : first, i, 1000 + static_cast<std::size_t>(round));
+        }
+    }
+    auto held = second.Get(TileCoordinates(1, 0, 10));
+    ASSERT_TRUE(held.has_value());
+
+    EXPECT_GT(first.Compact(), 0u);
+    EXPECT_EQ(second.Compact(), 0u);  // Already compacted by the other store
+    EXPECT_EQ(second.GetStats().tile_count, 40u);
+    EXPECT_EQ(second.GetDiskUsage(), first.GetDiskUsage());
+    for (int i = 0; i < 40; ++i) {
+        auto view = second.Get(TileCoordinates(i, 0, 10));
+        ASSERT_TRUE(view.has_value());
+        EXPECT_EQ(view->Data().size(), 1001u);
+    }
+    EXPECT_EQ(held->Data()[0], 1u);
+
+    second.Clear();
+    EXPECT_FALSE(first.Contains(TileCoordinates(1, 0, 10)));
+    EXPECT_EQ(first.GetStats().tile_count, 0u);
+
+    ASSERT_TRUE(PutTile(first, 9, 300));
+    EXPECT_TRUE(second.Contains(TileCoordinates(9, 0, 10)));
+}
+
+TEST_F(PackedTileStoreTest, SharedStoreReopensPublishedLog) {
+    config_.shared = true;
+    {
+        PackedTileStore writer(config_);
+        ASSERT_TRUE(writer.Open());
+        for (int i = 0; i < 30; ++i) {
+            PutTile(writer, i, 1000);
+        }
+        writer.Remove(TileCoordinates(0, 0, 10));
+    }
+
+    // A reader attached while a new writer reopens the log
+    PackedTileStore reader(config_);
+    ASSERT_TRUE(reader.Open());
+    PackedTileStore writer(config_);
+    ASSERT_TRUE(writer.Open());
+    EXPECT_EQ(writer.GetStats().tile_count, 29u);
+    EXPECT_FALSE(writer.Contains(TileCoordinates(0, 0, 10)));
+
+    ASSERT_TRUE(PutTile(writer, 50, 2000));
+    EXPECT_EQ(reader.Get(TileCoordinates(50, 0, 10))->Data().size(), 2000u);
+    EXPECT_EQ(reader.GetStats().tile_count, 30u);
+}
+
+TEST_F(PackedTileStoreTest, TileCacheUsesPackedBackend) {
+    TileCacheConfig config;
+    config.disk_cache_directory = directory_.string();
+    config.disk_backend = TileCacheConfig::DiskBackend::PACKED;
+    config.packed_segment_size = 64 * 1024;
+
+    TileData tile;
+    tile.metadata = MakeMetadata(4, 5, 6, 256);
+    tile.data = MakeBytes(256, 42);
+    tile.loaded = true;
+
+    {
+        auto cache = CreateTileCache(config);
+        ASSERT_TRUE(cache->Initialize(config));
+        ASSERT_TRUE(cache->Put(tile));
+        cache->Flush();
+        EXPECT_EQ(cache->GetStatistics().disk_cache_count, 1u);
+    }
+
+    // A fresh cache has an empty memory tier and must read the packed store
+    auto cache = CreateTileCache(config);
+    ASSERT_TRUE(cache->Initialize(config));
+    EXPECT_TRUE(cache->Contains(TileCoordinates(4, 5, 6)));
+
+    auto loaded = cache->Get(TileCoordinates(4, 5, 6));
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->data, tile.data);
+    EXPECT_EQ(cache->GetStatistics().disk_cache_hits, 1u);
+
+    auto metadata = cache->GetMetadata(TileCoordinates(4, 5, 6));
+    ASSERT_NE(metadata, nullptr);
+    EXPECT_EQ(metadata->etag, "etag-4");
+
+    EXPECT_TRUE(cache->Remove(TileCoordinates(4, 5, 6)));
+    EXPECT_FALSE(cache->Contains(TileCoordinates(4, 5, 6)));
+}
+
+TEST_F(PackedTileStoreTest, TileCacheKeepsPackedBackendWithinBudget) {
+    TileCacheConfig config;
+    config.disk_cache_directory = directory_.string();
+    config.disk_backend = TileCacheConfig::DiskBackend::PACKED;
+    config.packed_segment_size = 64 * 1024;
+    config.max_disk_cache_size = 256 * 1024;
+    config.enable_write_behind = false;
+
+    auto cache = CreateTileCache(config);
+    ASSERT_TRUE(cache->Initialize(config));
+    for (int i = 0; i < 100; ++i) {
+        TileData tile;
+        tile.metadata = MakeMetadata(i, 0, 12, 8 * 1024);
+        tile.data = MakeBytes(8 * 1024, static_cast<std::uint8_t>(i));
+        tile.loaded = true;
+        ASSERT_TRUE(cache->Put(tile));
+    }
+    cache->Flush();
+
+    const auto stats = cache->GetStatistics();
+    EXPECT_LE(stats.disk_cache_size, config.max_disk_cache_size);
+    EXPECT_LT(stats.disk_cache_count, 100u);
+}
+
+TEST_F(PackedTileStoreTest, TileCachesShareDiskCache) {
+    TileCacheConfig config;
+    config.disk_cache_directory = directory_.string();
+    config.shared_disk_cache = true;
+    config.enable_write_behind = false;
+
+    auto fetcher = CreateTileCache(config);
+    auto viewer = CreateTileCache(config);
+    ASSERT_TRUE(fetcher->Initialize(config));
+    ASSERT_TRUE(viewer->Initialize(config));
+
+    TileData tile;
+    tile.metadata = MakeMetadata(4, 5, 6, 256);
+    tile.data = MakeBytes(256, 42);
+    tile.loaded = true;
+    ASSERT_TRUE(fetcher->Put(tile));
+
+    // Downloaded by one cache, served from disk by the other
+    auto loaded = viewer->Get(TileCoordinates(4, 5, 6));
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->data, tile.data);
+    EXPECT_EQ(viewer->GetStatistics().disk_cache_hits, 1u);
+}
+
+} // namespace earth_map::tests
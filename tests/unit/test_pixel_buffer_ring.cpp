@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/texture_atlas/pixel_buffer_ring.h>
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <thread>
+
+namespace earth_map::tests {
+
+namespace {
+
+constexpr std::size_t kSlotSize = 64 * 64 * 4;
+
+} // namespace
+
+TEST(PixelBufferRingTest, CpuBackedWithoutGL) {
+    PixelBufferRing ring(4, kSlotSize, true);
+
+    EXPECT_FALSE(ring.IsPersistentlyMapped());
+    EXPECT_EQ(ring.GetBufferID(), 0u);
+    EXPECT_EQ(ring.GetSlotCount(), 4u);
+    EXPECT_EQ(ring.GetSlotSize(), kSlotSize);
+    EXPECT_EQ(ring.GetFreeCount(), 4u);
+}
+
+TEST(PixelBufferRingTest, AcquireHandsOutDistinctSlots) {
+    PixelBufferRing ring(4, kSlotSize, true);
+
+    std::set<std::uint32_t> indices;
+    std::set<std::uint8_t*> pointers;
+    for (int i = 0; i < 4; ++i) {
+        const PixelSlotHandle slot = ring.TryAcquire();
+        ASSERT_TRUE(slot.IsValid());
+        indices.insert(slot.index);
+        pointers.insert(ring.GetSlotData(slot));
+        EXPECT_EQ(ring.GetSlotOffset(slot), slot.index * kSlotSize);
+    }
+
+    EXPECT_EQ(indices.size(), 4u);
+    EXPECT_EQ(pointers.size(), 4u);
+    EXPECT_EQ(ring.GetFreeCount(), 0u);
+    EXPECT_FALSE(ring.TryAcquire().IsValid());
+}
+
+TEST(PixelBufferRingTest, SlotsDoNotOverlap) {
+    PixelBufferRing ring(2, kSlotSize, true);
+
+    const PixelSlotHandle a = ring.TryAcquire();
+    const PixelSlotHandle b = ring.TryAcquire();
+    std::fill_n(ring.GetSlotData(a), kSlotSize, std::uint8_t{0xAA});
+    std::fill_n(ring.GetSlotData(b), kSlotSize, std::uint8_t{0x55});
+
+    EXPECT_EQ(ring.GetSlotData(a)[kSlotSize - 1], 0xAA);
+    EXPECT_EQ(ring.GetSlotData(b)[0], 0x55);
+}
+
+TEST(PixelBufferRingTest, ReleaseReturnsSlot) {
+    PixelBufferRing ring(1, kSlotSize, true);
+
+    const PixelSlotHandle slot = ring.TryAcquire();
+    ASSERT_TRUE(slot.IsValid());
+    EXPECT_FALSE(ring.TryAcquire().IsValid());
+
+    ring.Release(slot);
+    EXPECT_EQ(ring.GetFreeCount(), 1u);
+    EXPECT_TRUE(ring.TryAcquire().IsValid());
+}
+
+TEST(PixelBufferRingTest, FenceAndReleaseFreesCpuSlotImmediately) {
+    PixelBufferRing ring(1, kSlotSize, true);
+
+    const PixelSlotHandle slot = ring.TryAcquire();
+    ring.FenceAndRelease(slot);
+
+    EXPECT_EQ(ring.GetFreeCount(), 1u);
+    EXPECT_EQ(ring.Reclaim(), 0u);
+}
+
+TEST(PixelBufferRingTest, InvalidHandlesAreIgnored) {
+    PixelBufferRing ring(2, kSlotSize, true);
+
+    ring.Release(PixelSlotHandle{});
+    ring.FenceAndRelease(PixelSlotHandle{});
+    PixelSlotHandle out_of_range;
+    out_of_range.index = 7;
+    ring.Release(out_of_range);
+
+    EXPECT_EQ(ring.GetFreeCount(), 2u);
+    EXPECT_EQ(ring.GetSlotData(PixelSlotHandle{}), nullptr);
+}
+
+TEST(PixelBufferRingTest, AcquireTimesOutWhenExhausted) {
+    PixelBufferRing ring(1, kSlotSize, true);
+    ASSERT_TRUE(ring.TryAcquire().IsValid());
+
+    const auto start = std::chrono::steady_clock::now();
+    const PixelSlotHandle slot = ring.Acquire(std::chrono::milliseconds(20));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_FALSE(slot.IsValid());
+    EXPECT_GE(elapsed, std::chrono::milliseconds(20));
+}
+
+TEST(PixelBufferRingTest, AcquireWakesWhenSlotReleased) {
+    PixelBufferRing ring(1, kSlotSize, true);
+    const PixelSlotHandle held = ring.TryAcquire();
+    ASSERT_TRUE(held.IsValid());
+
+    std::thread releaser([&ring, held]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        ring.Release(held);
+    });
+
+    const PixelSlotHandle slot = ring.Acquire(std::chrono::seconds(5));
+    releaser.join();
+
+    ASSERT_TRUE(slot.IsValid());
+    EXPECT_EQ(slot.index, held.index);
+}
+
+} // namespace earth_map::tests
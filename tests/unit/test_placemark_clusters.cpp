@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/placemark_clusters.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+glm::dvec3 ToWorld(double latitude, double longitude) {
+    return PlacemarkStore::ToWorldMeters(coordinates::Geographic(latitude, longitude, 0.0));
+}
+
+struct Points {
+    std::vector<glm::dvec3> positions;
+    std::vector<PlacemarkId> ids;
+};
+
+/// Dense blobs around a few cities plus uniform noise
+Points MakePoints(std::size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> spread(0.0, 0.5);
+    std::uniform_real_distribution<double> latitude(-80.0, 80.0);
+    std::uniform_real_distribution<double> longitude(-180.0, 180.0);
+    const double cities[][2] = {{48.85, 2.35}, {40.71, -74.0}, {35.68, 139.69}, {-33.87, 151.2}};
+    Points points;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (i % 5 == 0) {
+            points.positions.push_back(ToWorld(latitude(rng), longitude(rng)));
+        } else {
+            const double* city = cities[i % 4];
+            points.positions.push_back(ToWorld(city[0] + spread(rng), city[1] + spread(rng)));
+        }
+        points.ids.push_back(static_cast<PlacemarkId>(i * 3));
+    }
+    return points;
+}
+
+std::vector<PlacemarkCluster> QueryAll(const PlacemarkClusterIndex& index, int zoom) {
+    std::vector<PlacemarkCluster> clusters;
+    index.Query(zoom, glm::dvec2(0.0), glm::dvec2(1.0), clusters);
+    return clusters;
+}
+
+} // namespace
+
+TEST(PlacemarkClusterIndexTest, MercatorRoundTrips) {
+    const glm::dvec2 origin = PlacemarkClusterIndex::ToMercator(ToWorld(0.0, 0.0));
+    EXPECT_NEAR(origin.x, 0.5, 1e-12);
+    EXPECT_NEAR(origin.y, 0.5, 1e-12);
+    const glm::dvec2 north_east = PlacemarkClusterIndex::ToMercator(ToWorld(60.0, 90.0));
+    EXPECT_NEAR(north_east.x, 0.75, 1e-12);
+    EXPECT_LT(north_east.y, 0.5);
+    EXPECT_NEAR(PlacemarkClusterIndex::ToMercator(ToWorld(89.9, 0.0)).y, 0.0, 1e-9);
+
+    const glm::dvec3 world = glm::normalize(ToWorld(-41.3, 174.8));
+    const glm::dvec3 back =
+        PlacemarkClusterIndex::FromMercator(PlacemarkClusterIndex::ToMercator(world));
+    EXPECT_NEAR(glm::length(back - world), 0.0, 1e-12);
+}
+
+TEST(PlacemarkClusterIndexTest, LevelsConservePlacemarks) {
+    const Points points = MakePoints(20000, 3);
+    const PlacemarkClusterIndex index(points.positions, points.ids);
+    const PlacemarkClusterOptions& options = index.GetOptions();
+    EXPECT_EQ(index.GetPointCount(), points.positions.size());
+
+    std::size_t previous = 0;
+    for (int zoom = options.min_zoom; zoom <= options.max_zoom; ++zoom) {
+        SCOPED_TRACE(zoom);
+        const std::vector<PlacemarkCluster> clusters = QueryAll(index, zoom);
+        ASSERT_EQ(clusters.size(), index.GetClusterCount(zoom));
+        EXPECT_GE(clusters.size(), previous);
+        previous = clusters.size();
+
+        std::size_t total = 0;
+        for (const PlacemarkCluster& cluster : clusters) {
+            total += cluster.count;
+            EXPECT_EQ(cluster.id == PlacemarkStore::INVALID_ID, cluster.count > 1);
+        }
+        EXPECT_EQ(total, points.positions.size());
+    }
+
+    // About one cluster per radius at zoom 0; nothing left to merge deep in
+    const double cells = options.tile_extent / options.radius_pixels;
+    EXPECT_LE(index.GetClusterCount(0), static_cast<std::size_t>(4.0 * cells * cells));
+    EXPECT_LT(index.GetClusterCount(3), points.positions.size() / 10);
+    EXPECT_GT(index.GetClusterCount(options.max_zoom), points.positions.size() / 2);
+}
+
+TEST(PlacemarkClusterIndexTest, ClustersOfALevelAreSeparated) {
+    const Points points = MakePoints(5000, 5);
+    const PlacemarkClusterIndex index(points.positions, points.ids);
+    const PlacemarkClusterOptions& options = index.GetOptions();
+    for (const int zoom : {2, 6, 10}) {
+        SCOPED_TRACE(zoom);
+        const double radius = options.radius_pixels / (options.tile_extent * std::ldexp(1.0, zoom));
+        const std::vector<PlacemarkCluster> clusters = QueryAll(index, zoom);
+        // A seed claims every free point within the radius, so two singles never stay that close
+        for (std::size_t i = 0; i < clusters.size(); ++i) {
+            for (std::size_t j = i + 1; j < clusters.size(); ++j) {
+                if (clusters[i].count == 1 && clusters[j].count == 1) {
+                    ASSERT_GT(glm::length(clusters[i].mercator - clusters[j].mercator), radius);
+                }
+            }
+        }
+    }
+}
+
+TEST(PlacemarkClusterIndexTest, QueryMatchesBruteForce) {
+    const Points points = MakePoints(30000, 7);
+    PlacemarkClusterOptions options;
+    options.node_size = 8;
+    const PlacemarkClusterIndex index(points.positions, points.ids, options);
+    const glm::dvec2 min(0.45, 0.3);
+    const glm::dvec2 max(0.6, 0.45);
+    for (const int zoom : {1, 5, 9, 14, 40}) {
+        SCOPED_TRACE(zoom);
+        std::set<std::pair<double, double>> expected;
+        for (const PlacemarkCluster& cluster : QueryAll(index, zoom)) {
+            const glm::dvec2& p = cluster.mercator;
+            if (p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y) {
+                expected.emplace(p.x, p.y);
+            }
+        }
+        std::vector<PlacemarkCluster> found;
+        index.Query(zoom, min, max, found);
+        std::set<std::pair<double, double>> actual;
+        for (const PlacemarkCluster& cluster : found) {
+            actual.emplace(cluster.mercator.x, cluster.mercator.y);
+        }
+        EXPECT_EQ(found.size(), expected.size());
+        EXPECT_EQ(actual, expected);
+    }
+}
+
+TEST(PlacemarkClusterIndexTest, SinglesKeepTheirIds) {
+    const std::vector<glm::dvec3> positions = {ToWorld(10.0, 10.0), ToWorld(-50.0, -120.0)};
+    const std::vector<PlacemarkId> ids = {7, 42};
+    const PlacemarkClusterIndex index(positions, ids);
+    const std::vector<PlacemarkCluster> clusters = QueryAll(index, 0);
+    ASSERT_EQ(clusters.size(), 2u);
+    std::set<PlacemarkId> found;
+    for (const PlacemarkCluster& cluster : clusters) {
+        EXPECT_EQ(cluster.count, 1u);
+        found.insert(cluster.id);
+    }
+    EXPECT_EQ(found, (std::set<PlacemarkId>{7, 42}));
+
+    const PlacemarkClusterIndex empty;
+    EXPECT_EQ(empty.GetClusterCount(3), 0u);
+    EXPECT_TRUE(QueryAll(empty, 3).empty());
+}
+
+} // namespace earth_map::tests
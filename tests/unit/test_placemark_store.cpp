@@ -0,0 +1,136 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/placemark_store.h>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+using coordinates::Geographic;
+
+/// Position of a slot in meters (world axes)
+glm::dvec3 SlotPosition(const PlacemarkStore& store, PlacemarkStyleId style, std::uint32_t slot) {
+    const std::vector<float>& positions = store.GetPositions(style);
+    return store.GetCenter(style) + glm::dvec3(positions[3 * slot], positions[3 * slot + 1],
+                                               positions[3 * slot + 2]);
+}
+
+} // namespace
+
+TEST(PlacemarkStoreTest, GroupsPlacemarksByStyleRelativeToCenter) {
+    PlacemarkStore store;
+    const PlacemarkStyleId points = store.AddStyle(PlacemarkStyle{});
+    PlacemarkStyle billboard;
+    billboard.shape = PlacemarkShape::BILLBOARD;
+    billboard.center = Geographic(0.0, 0.0, 0.0);
+    const PlacemarkStyleId billboards = store.AddStyle(billboard);
+    ASSERT_EQ(store.GetStyleCount(), 2u);
+
+    const PlacemarkId a = store.Add(points, Geographic(47.0, 8.0, 500.0));
+    const PlacemarkId b = store.Add(points, Geographic(47.001, 8.001, 500.0), 0xFF0000FFu);
+    const PlacemarkId c = store.Add(billboards, Geographic(0.0, 90.0, 0.0));
+    EXPECT_EQ(store.GetCount(), 3u);
+    EXPECT_EQ(store.GetCount(points), 2u);
+    EXPECT_EQ(store.GetCount(billboards), 1u);
+    EXPECT_EQ(store.GetColors(points)[store.GetSlot(b)], 0xFF0000FFu);
+
+    // The first placemark centers its style: small offsets keep float precision
+    const glm::dvec3 expected_b = PlacemarkStore::ToWorldMeters(Geographic(47.001, 8.001, 500.0));
+    EXPECT_EQ(SlotPosition(store, points, store.GetSlot(a)),
+              PlacemarkStore::ToWorldMeters(Geographic(47.0, 8.0, 500.0)));
+    EXPECT_LT(glm::length(SlotPosition(store, points, store.GetSlot(b)) - expected_b), 1e-3);
+
+    // World axes: longitude 0 on +Z, 90°E on +X, north on +Y
+    EXPECT_NEAR(store.GetCenter(billboards).z, 6371000.0, 1e-6);
+    const glm::dvec3 east = SlotPosition(store, billboards, store.GetSlot(c));
+    EXPECT_NEAR(east.x, 6371000.0, 1.0);
+    EXPECT_NEAR(east.z, 0.0, 1.0);
+
+    EXPECT_THROW(store.Add(7, Geographic(0.0, 0.0)), std::out_of_range);
+}
+
+TEST(PlacemarkStoreTest, EditsBecomeMergedDirtyRuns) {
+    PlacemarkStore store;
+    const PlacemarkStyleId style = store.AddStyle(PlacemarkStyle{});
+    std::vector<PlacemarkId> ids;
+    for (int i = 0; i < 1000; ++i) {
+        ids.push_back(store.Add(style, Geographic(10.0 + i * 1e-4, 20.0)));
+    }
+
+    // Everything added is dirty once
+    std::vector<PlacemarkUploadRange> ranges = store.TakeDirtyRanges(style);
+    ASSERT_EQ(ranges.size(), 1u);
+    EXPECT_EQ(ranges[0].first, 0u);
+    EXPECT_EQ(ranges[0].count, 1000u);
+    EXPECT_TRUE(store.TakeDirtyRanges(style).empty());
+
+    // Nearby edits merge; distant ones upload separately
+    EXPECT_TRUE(store.Update(ids[10], Geographic(11.0, 21.0)));
+    EXPECT_TRUE(store.SetColor(ids[12], 0x80FFFFFFu));
+    EXPECT_TRUE(store.Update(ids[10], Geographic(11.5, 21.0)));
+    EXPECT_TRUE(store.Update(ids[900], Geographic(11.0, 21.0)));
+    ranges = store.TakeDirtyRanges(style, 4);
+    ASSERT_EQ(ranges.size(), 2u);
+    EXPECT_EQ(ranges[0].first, 10u);
+    EXPECT_EQ(ranges[0].count, 3u);
+    EXPECT_EQ(ranges[1].first, 900u);
+    EXPECT_EQ(ranges[1].count, 1u);
+    ranges = store.TakeDirtyRanges(style);
+    EXPECT_TRUE(ranges.empty());
+
+    EXPECT_LT(glm::length(SlotPosition(store, style, 10) -
+                          PlacemarkStore::ToWorldMeters(Geographic(11.5, 21.0))), 0.1);
+}
+
+TEST(PlacemarkStoreTest, RemovalMovesTheLastSlot) {
+    PlacemarkStore store;
+    const PlacemarkStyleId style = store.AddStyle(PlacemarkStyle{});
+    const PlacemarkId a = store.Add(style, Geographic(0.0, 0.0), 1u);
+    const PlacemarkId b = store.Add(style, Geographic(0.0, 1.0), 2u);
+    const PlacemarkId c = store.Add(style, Geographic(0.0, 2.0), 3u);
+    store.TakeDirtyRanges(style);
+
+    EXPECT_TRUE(store.Remove(a));
+    EXPECT_FALSE(store.Remove(a));
+    EXPECT_FALSE(store.Contains(a));
+    EXPECT_FALSE(store.Update(a, Geographic(1.0, 1.0)));
+    EXPECT_EQ(store.GetCount(style), 2u);
+    EXPECT_EQ(store.GetSlot(c), 0u);
+    EXPECT_EQ(store.GetColors(style)[0], 3u);
+    EXPECT_EQ(store.GetSlot(b), 1u);
+
+    // Only the refilled slot uploads; the freed tail is not drawn
+    std::vector<PlacemarkUploadRange> ranges = store.TakeDirtyRanges(style);
+    ASSERT_EQ(ranges.size(), 1u);
+    EXPECT_EQ(ranges[0].first, 0u);
+    EXPECT_EQ(ranges[0].count, 1u);
+
+    // Handles are reused; an edited tail slot removed and re-added uploads once
+    EXPECT_TRUE(store.Update(b, Geographic(5.0, 5.0)));
+    EXPECT_TRUE(store.Remove(b));
+    const PlacemarkId d = store.Add(style, Geographic(0.0, 3.0), 4u);
+    EXPECT_EQ(d, b);
+    EXPECT_EQ(store.GetSlot(d), 1u);
+    ranges = store.TakeDirtyRanges(style);
+    ASSERT_EQ(ranges.size(), 1u);
+    EXPECT_EQ(ranges[0].first, 1u);
+    EXPECT_EQ(ranges[0].count, 1u);
+
+    EXPECT_TRUE(store.Remove(c));
+    EXPECT_TRUE(store.Remove(d));
+    EXPECT_EQ(store.GetCount(), 0u);
+    EXPECT_TRUE(store.TakeDirtyRanges(style).empty());
+}
+
+TEST(PlacemarkStoreTest, PacksColorsAsRgbaBytes) {
+    const std::uint32_t packed = PlacemarkStore::PackColor(glm::vec4(1.0f, 0.5f, 0.0f, 2.0f));
+    const auto* bytes = reinterpret_cast<const std::uint8_t*>(&packed);
+    EXPECT_EQ(bytes[0], 255);
+    EXPECT_EQ(bytes[1], 128);
+    EXPECT_EQ(bytes[2], 0);
+    EXPECT_EQ(bytes[3], 255);
+}
+
+} // namespace earth_map::tests
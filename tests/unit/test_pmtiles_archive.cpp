@@ -0,0 +1,269 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/pmtiles_archive.h>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+struct Entry {
+    std::uint64_t tile_id;
+    std::uint64_t offset;
+    std::uint64_t length;
+    std::uint64_t run_length;
+};
+
+void PutVarint(std::vector<std::uint8_t>& out, std::uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+std::vector<std::uint8_t> EncodeDirectory(const std::vector<Entry>& entries) {
+    std::vector<std::uint8_t> out;
+    PutVarint(out, entries.size());
+    std::uint64_t last_id = 0;
+    for (const auto& entry : entries) {
+        PutVarint(out, entry.tile_id - last_id);
+        last_id = entry.tile_id;
+    }
+    for (const auto& entry : entries) {
+        PutVarint(out, entry.run_length);
+    }
+    for (const auto& entry : entries) {
+        PutVarint(out, entry.length);
+    }
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        const bool contiguous = i > 0 &&
+            entries[i].offset == entries[i - 1].offset + entries[i - 1].length;
+        PutVarint(out, contiguous ? 0 : entries[i].offset + 1);
+    }
+    return out;
+}
+
+template <typename T>
+void PutLE(std::vector<std::uint8_t>& out, std::size_t at, T value) {
+    std::memcpy(out.data() + at, &value, sizeof(T));
+}
+
+/// Build an uncompressed PMTiles v3 file: header, root dir, leaf dirs, tile data
+void WriteArchive(const std::filesystem::path& path,
+                  const std::vector<std::uint8_t>& root,
+                  const std::vector<std::uint8_t>& leaves,
+                  const std::vector<std::uint8_t>& tiles,
+                  std::uint8_t min_zoom, std::uint8_t max_zoom,
+                  std::uint8_t tile_compression = 1) {
+    std::vector<std::uint8_t> file(PMTilesArchive::kHeaderSize, 0);
+    std::memcpy(file.data(), "PMTiles", 7);
+    file[7] = 3;
+
+    const std::uint64_t root_offset = PMTilesArchive::kHeaderSize;
+    const std::uint64_t leaf_offset = root_offset + root.size();
+    const std::uint64_t tile_offset = leaf_offset + leaves.size();
+    PutLE<std::uint64_t>(file, 8, root_offset);
+    PutLE<std::uint64_t>(file, 16, root.size());
+    PutLE<std::uint64_t>(file, 24, tile_offset + tiles.size());
+    PutLE<std::uint64_t>(file, 32, 0);
+    PutLE<std::uint64_t>(file, 40, leaf_offset);
+    PutLE<std::uint64_t>(file, 48, leaves.size());
+    PutLE<std::uint64_t>(file, 56, tile_offset);
+    PutLE<std::uint64_t>(file, 64, tiles.size());
+    file[96] = 1;  // clustered
+    file[97] = 1;  // internal compression: none
+    file[98] = tile_compression;
+    file[99] = 2;  // png
+    file[100] = min_zoom;
+    file[101] = max_zoom;
+
+    file.insert(file.end(), root.begin(), root.end());
+    file.insert(file.end(), leaves.begin(), leaves.end());
+    file.insert(file.end(), tiles.begin(), tiles.end());
+
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(file.data()), static_cast<std::streamsize>(file.size()));
+}
+
+} // namespace
+
+class PMTilesArchiveTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        path_ = std::filesystem::temp_directory_path() /
+                (std::string("earth_map_") +
+                 ::testing::UnitTest::GetInstance()->current_test_info()->name() + ".pmtiles");
+    }
+
+    void TearDown() override {
+        std::filesystem::remove(path_);
+    }
+
+    /// Tiles 0..4 (z0 and all of z1), each 10 bytes filled with its tile id
+    void WriteSimpleArchive(std::uint8_t tile_compression = 1) {
+        std::vector<std::uint8_t> tiles;
+        std::vector<Entry> entries;
+        for (std::uint64_t id = 0; id < 5; ++id) {
+            entries.push_back({id, tiles.size(), 10, 1});
+            tiles.insert(tiles.end(), 10, static_cast<std::uint8_t>(id));
+        }
+        WriteArchive(path_, EncodeDirectory(entries), {}, tiles, 0, 1, tile_compression);
+    }
+
+    std::filesystem::path path_;
+};
+
+TEST_F(PMTilesArchiveTest, TileIdFollowsHilbertCurve) {
+    EXPECT_EQ(PMTilesArchive::TileId(TileCoordinates(0, 0, 0)), 0u);
+    EXPECT_EQ(PMTilesArchive::TileId(TileCoordinates(0, 0, 1)), 1u);
+    EXPECT_EQ(PMTilesArchive::TileId(TileCoordinates(0, 1, 1)), 2u);
+    EXPECT_EQ(PMTilesArchive::TileId(TileCoordinates(1, 1, 1)), 3u);
+    EXPECT_EQ(PMTilesArchive::TileId(TileCoordinates(1, 0, 1)), 4u);
+    EXPECT_EQ(PMTilesArchive::TileId(TileCoordinates(0, 0, 2)), 5u);
+    EXPECT_EQ(PMTilesArchive::TileId(TileCoordinates(3, 0, 2)), 20u);
+}
+
+TEST_F(PMTilesArchiveTest, ReadsTilesFromRootDirectory) {
+    WriteSimpleArchive();
+    PMTilesArchive archive(path_.string());
+    ASSERT_TRUE(archive.Open());
+
+    EXPECT_TRUE(archive.GetHeader().clustered);
+    EXPECT_EQ(archive.GetHeader().tile_type, PMTilesHeader::TileType::PNG);
+
+    auto tile = archive.GetTile(TileCoordinates(1, 1, 1));
+    ASSERT_TRUE(tile.has_value());
+    ASSERT_EQ(tile->size(), 10u);
+    EXPECT_EQ((*tile)[0], 3u);
+
+    EXPECT_FALSE(archive.GetTile(TileCoordinates(0, 0, 2)).has_value());
+    EXPECT_FALSE(archive.GetTile(TileCoordinates(5, 5, 1)).has_value());
+}
+
+TEST_F(PMTilesArchiveTest, RunLengthSharesTileData) {
+    // All four z1 tiles point at the same bytes (e.g. ocean)
+    std::vector<std::uint8_t> tiles(8, 0xAB);
+    WriteArchive(path_, EncodeDirectory({{1, 0, 8, 4}}), {}, tiles, 1, 1);
+
+    PMTilesArchive archive(path_.string());
+    ASSERT_TRUE(archive.Open());
+    for (int x = 0; x < 2; ++x) {
+        for (int y = 0; y < 2; ++y) {
+            auto tile = archive.GetTile(TileCoordinates(x, y, 1));
+            ASSERT_TRUE(tile.has_value());
+            EXPECT_EQ((*tile)[0], 0xABu);
+        }
+    }
+}
+
+TEST_F(PMTilesArchiveTest, FollowsLeafDirectories) {
+    std::vector<std::uint8_t> tiles;
+    std::vector<Entry> leaf_a;
+    std::vector<Entry> leaf_b;
+    for (std::uint64_t id = 5; id < 21; ++id) {
+        auto& leaf = id < 13 ? leaf_a : leaf_b;
+        leaf.push_back({id, tiles.size(), 4, 1});
+        tiles.insert(tiles.end(), 4, static_cast<std::uint8_t>(id));
+    }
+
+    const auto encoded_a = EncodeDirectory(leaf_a);
+    const auto encoded_b = EncodeDirectory(leaf_b);
+    std::vector<std::uint8_t> leaves = encoded_a;
+    leaves.insert(leaves.end(), encoded_b.begin(), encoded_b.end());
+
+    const auto root = EncodeDirectory({
+        {5, 0, encoded_a.size(), 0},
+        {13, encoded_a.size(), encoded_b.size(), 0},
+    });
+    WriteArchive(path_, root, leaves, tiles, 2, 2);
+
+    PMTilesArchive archive(path_.string());
+    ASSERT_TRUE(archive.Open());
+
+    auto tile = archive.GetTile(TileCoordinates(3, 0, 2));  // tile id 20
+    ASSERT_TRUE(tile.has_value());
+    EXPECT_EQ((*tile)[0], 20u);
+
+    tile = archive.GetTile(TileCoordinates(0, 0, 2));  // tile id 5
+    ASSERT_TRUE(tile.has_value());
+    EXPECT_EQ((*tile)[0], 5u);
+}
+
+TEST_F(PMTilesArchiveTest, PrefetchMergesClusteredTiles) {
+    WriteSimpleArchive();
+    PMTilesArchive archive(path_.string());
+    ASSERT_TRUE(archive.Open());
+
+    const std::size_t ranges = archive.Prefetch({
+        TileCoordinates(0, 0, 1), TileCoordinates(1, 0, 1),
+        TileCoordinates(1, 1, 1), TileCoordinates(0, 0, 0)});
+    EXPECT_EQ(ranges, 1u);
+}
+
+TEST_F(PMTilesArchiveTest, RejectsNonArchives) {
+    {
+        std::ofstream out(path_, std::ios::binary);
+        out << std::string(200, 'x');
+    }
+    PMTilesArchive archive(path_.string());
+    EXPECT_FALSE(archive.Open());
+
+    PMTilesArchive missing(path_.string() + ".missing");
+    EXPECT_FALSE(missing.Open());
+}
+
+TEST_F(PMTilesArchiveTest, LoaderReadsLocalProviderWithoutHttp) {
+    WriteSimpleArchive();
+    auto provider = CreatePMTilesTileProvider(path_.string(), "offline");
+    ASSERT_NE(provider, nullptr);
+    EXPECT_TRUE(provider->IsLocal());
+    EXPECT_EQ(provider->GetMaxZoom(), 1);
+    EXPECT_EQ(provider->GetFormat(), "png");
+
+    auto loader = CreateTileLoader(TileLoaderConfig{});
+    ASSERT_TRUE(loader->AddProvider(provider));
+
+    const TileLoadResult hit = loader->LoadTile(TileCoordinates(1, 0, 1), "offline");
+    ASSERT_TRUE(hit.success);
+    ASSERT_NE(hit.tile_data, nullptr);
+    EXPECT_EQ(hit.tile_data->data, std::vector<std::uint8_t>(10, 4));
+
+    const TileLoadResult miss = loader->LoadTile(TileCoordinates(2, 2, 2), "offline");
+    EXPECT_FALSE(miss.success);
+}
+
+TEST_F(PMTilesArchiveTest, ProviderReadsUncompressedTilesInPlace) {
+    WriteSimpleArchive();
+    auto provider = CreatePMTilesTileProvider(path_.string(), "offline");
+    ASSERT_NE(provider, nullptr);
+
+    auto tile = provider->ReadTile(TileCoordinates(1, 1, 1));
+    ASSERT_TRUE(tile.has_value());
+    EXPECT_EQ(*tile, std::vector<std::uint8_t>(10, 3));
+    EXPECT_EQ(tile->data(), provider->GetArchive()->GetTile(TileCoordinates(1, 1, 1))->data());
+
+    // The view keeps the mapping alive after the provider is gone
+    provider.reset();
+    EXPECT_EQ((*tile)[9], 3u);
+}
+
+TEST_F(PMTilesArchiveTest, ProviderDecompressesPerTileCompression) {
+    WriteSimpleArchive(4);  // zstd: not a codec the archive reader has
+    auto provider = CreatePMTilesTileProvider(path_.string(), "offline");
+    ASSERT_NE(provider, nullptr);
+    EXPECT_EQ(provider->GetArchive()->GetHeader().tile_compression,
+              PMTilesHeader::Compression::ZSTD);
+
+    // Compressed bytes are never handed out as if they were the tile
+    EXPECT_TRUE(provider->GetArchive()->GetTile(TileCoordinates(1, 1, 1)).has_value());
+    EXPECT_FALSE(provider->ReadTile(TileCoordinates(1, 1, 1)).has_value());
+}
+
+TEST_F(PMTilesArchiveTest, ProviderRequiresArchive) {
+    EXPECT_THROW(PMTilesTileProvider("offline", nullptr), std::invalid_argument);
+}
+
+} // namespace earth_map::tests
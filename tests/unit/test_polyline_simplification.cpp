@@ -0,0 +1,220 @@
+#include <gtest/gtest.h>
+#include <earth_map/math/polyline_simplification.h>
+#include <earth_map/math/geodetic_calculations.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+constexpr double kRadius = 6378137.0;
+
+/// Random-walk GPS track around 47°N 8°E with steps of a few meters
+std::vector<Geographic> MakeTrack(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<double> turn(0.0, 0.3);
+    std::uniform_real_distribution<double> step(1.0, 8.0);
+    std::vector<Geographic> track;
+    double lat = 47.0;
+    double lon = 8.0;
+    double heading = 0.0;
+    for (size_t i = 0; i < count; ++i) {
+        track.emplace_back(lat, lon, 0.0);
+        heading += turn(rng);
+        const double distance = step(rng) / kRadius * 180.0 / M_PI;
+        lat += distance * std::cos(heading);
+        lon += distance * std::sin(heading) / std::cos(lat * M_PI / 180.0);
+    }
+    return track;
+}
+
+struct Unit {
+    double x, y, z;
+};
+
+Unit ToUnit(const Geographic& point) {
+    const double lat = point.latitude * M_PI / 180.0;
+    const double lon = point.longitude * M_PI / 180.0;
+    return {std::cos(lat) * std::cos(lon), std::cos(lat) * std::sin(lon), std::sin(lat)};
+}
+
+double Dot(const Unit& a, const Unit& b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+
+Unit Cross(const Unit& a, const Unit& b) {
+    return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+}
+
+double Angle(const Unit& a, const Unit& b) {
+    const Unit c = Cross(a, b);
+    return std::atan2(std::sqrt(Dot(c, c)), Dot(a, b));
+}
+
+/// Distance from p to the great-circle arc a-b in meters
+double ArcDistance(const Unit& p, const Unit& a, const Unit& b) {
+    Unit n = Cross(a, b);
+    const double length = std::sqrt(Dot(n, n));
+    n = {n.x / length, n.y / length, n.z / length};
+    if (Dot(p, Cross(n, a)) >= 0.0 && Dot(p, Cross(b, n)) >= 0.0) {
+        return std::asin(std::abs(Dot(p, n))) * kRadius;
+    }
+    return std::min(Angle(p, a), Angle(p, b)) * kRadius;
+}
+
+/// Recursive Douglas-Peucker reference
+void ReferenceDouglasPeucker(const std::vector<Unit>& points, size_t first, size_t last,
+                             double tolerance, std::vector<uint32_t>& kept) {
+    double best = -1.0;
+    size_t split = first;
+    for (size_t i = first + 1; i < last; ++i) {
+        const double distance = ArcDistance(points[i], points[first], points[last]);
+        if (distance > best) {
+            best = distance;
+            split = i;
+        }
+    }
+    if (best > tolerance) {
+        ReferenceDouglasPeucker(points, first, split, tolerance, kept);
+        kept.push_back(static_cast<uint32_t>(split));
+        ReferenceDouglasPeucker(points, split, last, tolerance, kept);
+    }
+}
+
+/// Visvalingam reference: drop the smallest triangle until all exceed the tolerance
+std::vector<uint32_t> ReferenceVisvalingam(const std::vector<Unit>& points, double tolerance) {
+    std::vector<uint32_t> kept(points.size());
+    for (uint32_t i = 0; i < kept.size(); ++i) {
+        kept[i] = i;
+    }
+    while (kept.size() > 2) {
+        double smallest = std::numeric_limits<double>::max();
+        size_t victim = 0;
+        for (size_t i = 1; i + 1 < kept.size(); ++i) {
+            const Unit& a = points[kept[i - 1]];
+            const Unit& b = points[kept[i]];
+            const Unit& c = points[kept[i + 1]];
+            const Unit n = Cross({b.x - a.x, b.y - a.y, b.z - a.z}, {c.x - a.x, c.y - a.y, c.z - a.z});
+            const double effective = std::sqrt(0.5 * std::sqrt(Dot(n, n))) * kRadius;
+            if (effective < smallest) {
+                smallest = effective;
+                victim = i;
+            }
+        }
+        if (smallest > tolerance) {
+            break;
+        }
+        kept.erase(kept.begin() + static_cast<std::ptrdiff_t>(victim));
+    }
+    return kept;
+}
+
+std::vector<Unit> ToUnits(const std::vector<Geographic>& points) {
+    std::vector<Unit> units;
+    for (const auto& point : points) {
+        units.push_back(ToUnit(point));
+    }
+    return units;
+}
+
+} // namespace
+
+TEST(PolylineSimplificationTest, MatchesDouglasPeuckerAtEveryTolerance) {
+    const std::vector<Geographic> track = MakeTrack(3000, 7);
+    const std::vector<Unit> units = ToUnits(track);
+    const PolylineLod lod(track);
+    ASSERT_EQ(lod.GetPointCount(), track.size());
+
+    std::vector<uint32_t> indices;
+    for (const double tolerance : {0.05, 0.5, 2.0, 10.0, 40.0, 200.0, 1000.0}) {
+        std::vector<uint32_t> expected = {0};
+        ReferenceDouglasPeucker(units, 0, units.size() - 1, tolerance, expected);
+        expected.push_back(static_cast<uint32_t>(units.size() - 1));
+
+        lod.Extract(tolerance, indices);
+        EXPECT_EQ(indices, expected) << "tolerance " << tolerance;
+        EXPECT_EQ(lod.CountVertices(tolerance), expected.size());
+    }
+}
+
+TEST(PolylineSimplificationTest, MatchesVisvalingamAtEveryTolerance) {
+    const std::vector<Geographic> track = MakeTrack(400, 3);
+    const std::vector<Unit> units = ToUnits(track);
+    const PolylineLod lod(track, SimplificationMethod::Visvalingam);
+    EXPECT_EQ(lod.GetMethod(), SimplificationMethod::Visvalingam);
+
+    std::vector<uint32_t> indices;
+    for (const double tolerance : {0.5, 2.0, 5.0, 20.0, 100.0}) {
+        lod.Extract(tolerance, indices);
+        EXPECT_EQ(indices, ReferenceVisvalingam(units, tolerance)) << "tolerance " << tolerance;
+    }
+}
+
+TEST(PolylineSimplificationTest, LevelsAreNestedAndFollowTheBudget) {
+    const std::vector<Geographic> track = MakeTrack(100000, 11);
+    const PolylineLod lod(track);
+    EXPECT_LT(lod.GetMemoryUsage(), track.size() * 13);
+
+    // Coarser tolerances keep subsets; endpoints are always kept
+    std::vector<uint32_t> fine;
+    std::vector<uint32_t> coarse;
+    lod.Extract(1.0, fine);
+    for (const double tolerance : {3.0, 30.0, 300.0, 3000.0, 1e12}) {
+        lod.Extract(tolerance, coarse);
+        ASSERT_GE(coarse.size(), 2u);
+        EXPECT_EQ(coarse.front(), 0u);
+        EXPECT_EQ(coarse.back(), track.size() - 1);
+        EXPECT_LE(coarse.size(), fine.size());
+        EXPECT_TRUE(std::includes(fine.begin(), fine.end(), coarse.begin(), coarse.end()));
+        fine = coarse;
+    }
+
+    // Douglas-Peucker ties a vertex to its parent split, so budgets are
+    // met from below
+    for (const size_t budget : {2u, 10u, 1000u, 50000u}) {
+        lod.Extract(lod.GetToleranceForBudget(budget), coarse);
+        EXPECT_LE(coarse.size(), budget);
+        EXPECT_GE(coarse.size(), budget / 2);
+    }
+    lod.Extract(-1.0, coarse);
+    EXPECT_EQ(coarse.size(), track.size());
+}
+
+TEST(PolylineSimplificationTest, DropsCollinearAndDegeneratePoints) {
+    // Points on the equator lie on the chord's great circle
+    std::vector<Geographic> equator;
+    for (int i = 0; i <= 10; ++i) {
+        equator.emplace_back(0.0, i * 0.1, 0.0);
+    }
+    std::vector<uint32_t> indices;
+    PolylineLod(equator).Extract(0.0, indices);
+    EXPECT_EQ(indices, (std::vector<uint32_t>{0, 10}));
+
+    // A closed loop keeps its farthest point
+    const std::vector<Geographic> loop = {Geographic(0.0, 0.0), Geographic(0.0, 0.01),
+                                          Geographic(0.01, 0.01), Geographic(0.0, 0.0)};
+    PolylineLod(loop).Extract(1000.0, indices);
+    EXPECT_EQ(indices, (std::vector<uint32_t>{0, 2, 3}));
+
+    PolylineLod(std::vector<Geographic>{}).Extract(1.0, indices);
+    EXPECT_TRUE(indices.empty());
+    PolylineLod(std::vector<Geographic>{Geographic(1.0, 2.0)}).Extract(1.0, indices);
+    EXPECT_EQ(indices, (std::vector<uint32_t>{0}));
+}
+
+TEST(PolylineSimplificationTest, GeodeticPathSimplifyUsesDouglasPeucker) {
+    const std::vector<Geographic> track = MakeTrack(2000, 5);
+    const std::vector<Geographic> simplified = GeodeticPath::Simplify(track, 20.0);
+    std::vector<uint32_t> indices;
+    PolylineLod(track).Extract(20.0, indices);
+    ASSERT_EQ(simplified.size(), indices.size());
+    ASSERT_LT(simplified.size(), track.size() / 4);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        EXPECT_EQ(simplified[i].latitude, track[indices[i]].latitude);
+        EXPECT_EQ(simplified[i].longitude, track[indices[i]].longitude);
+    }
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/request_scheduler.h>
+#include <earth_map/data/http_download_engine.h>
+#include "loopback_http_server.h"
+#include <chrono>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+
+namespace earth_map::tests {
+
+using namespace std::chrono_literals;
+
+namespace {
+
+HttpRequest MakeRequest(const std::string& url, const std::string& flow = "",
+                        std::uint32_t weight = 1) {
+    HttpRequest request;
+    request.url = url;
+    request.flow = flow;
+    request.flow_weight = weight;
+    return request;
+}
+
+} // namespace
+
+class RequestSchedulerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config_.max_requests_per_host = 0;
+        now_ = RequestScheduler::Clock::now();
+    }
+
+    RequestSchedulerConfig config_;
+    RequestScheduler::Clock::time_point now_;
+};
+
+TEST_F(RequestSchedulerTest, WeightedFairAcrossFlows) {
+    RequestScheduler scheduler(config_);
+    HttpRequestId id = 1;
+    for (int i = 0; i < 30; ++i) {
+        scheduler.Push(id++, MakeRequest("http://a.test/" + std::to_string(i), "Imagery", 2));
+        scheduler.Push(id++, MakeRequest("http://b.test/" + std::to_string(i), "Labels", 1));
+    }
+    EXPECT_EQ(scheduler.GetQueuedCount(), 60u);
+
+    std::map<std::string, int> picks;
+    for (int i = 0; i < 30; ++i) {
+        auto entry = scheduler.PopNext(now_);
+        ASSERT_TRUE(entry.has_value());
+        picks[entry->request.flow]++;
+        scheduler.Release(entry->host);
+    }
+    EXPECT_EQ(picks["Imagery"], 20);
+    EXPECT_EQ(picks["Labels"], 10);
+}
+
+TEST_F(RequestSchedulerTest, FlowKeepsFifoOrder) {
+    RequestScheduler scheduler(config_);
+    scheduler.Push(1, MakeRequest("http://a.test/1"));
+    scheduler.Push(2, MakeRequest("http://b.test/2"));
+    scheduler.Push(3, MakeRequest("http://a.test/3"));
+
+    EXPECT_EQ(scheduler.PopNext(now_)->id, 1u);
+    EXPECT_EQ(scheduler.PopNext(now_)->id, 2u);
+    EXPECT_EQ(scheduler.PopNext(now_)->id, 3u);
+    EXPECT_FALSE(scheduler.PopNext(now_).has_value());
+}
+
+TEST_F(RequestSchedulerTest, HostAtCapDoesNotBlockOtherHosts) {
+    config_.max_requests_per_host = 2;
+    RequestScheduler scheduler(config_);
+    for (HttpRequestId id = 1; id <= 4; ++id) {
+        scheduler.Push(id, MakeRequest("http://slow.test/" + std::to_string(id), "Slow"));
+    }
+    scheduler.Push(5, MakeRequest("http://a.tiles.test/5", "Sharded"));
+    scheduler.Push(6, MakeRequest("http://b.tiles.test/6", "Sharded"));
+
+    std::vector<HttpRequestId> started;
+    while (auto entry = scheduler.PopNext(now_)) {
+        started.push_back(entry->id);
+    }
+    // Two slow requests and both shards; the other slow ones wait
+    EXPECT_EQ(started.size(), 4u);
+    EXPECT_EQ(scheduler.GetActiveCount("slow.test"), 2u);
+    EXPECT_FALSE(scheduler.GetNextEligibleTime(now_).has_value());
+
+    scheduler.Release("slow.test");
+    auto next = scheduler.PopNext(now_);
+    ASSERT_TRUE(next.has_value());
+    EXPECT_EQ(next->id, 3u);
+}
+
+TEST_F(RequestSchedulerTest, TokenBucketLimitsStartRate) {
+    config_.requests_per_second = 10.0;
+    config_.burst = 2;
+    RequestScheduler scheduler(config_);
+    for (HttpRequestId id = 1; id <= 4; ++id) {
+        scheduler.Push(id, MakeRequest("http://rate.test/" + std::to_string(id)));
+    }
+
+    EXPECT_TRUE(scheduler.PopNext(now_).has_value());
+    EXPECT_TRUE(scheduler.PopNext(now_).has_value());
+    EXPECT_FALSE(scheduler.PopNext(now_).has_value());
+
+    // One token refills every 100 ms
+    auto next = scheduler.GetNextEligibleTime(now_);
+    ASSERT_TRUE(next.has_value());
+    EXPECT_NEAR(std::chrono::duration<double>(*next - now_).count(), 0.1, 0.001);
+    EXPECT_FALSE(scheduler.PopNext(now_ + 50ms).has_value());
+    EXPECT_TRUE(scheduler.PopNext(now_ + 100ms).has_value());
+}
+
+TEST_F(RequestSchedulerTest, ThrottledHostWaitsUntilReleaseTime) {
+    RequestScheduler scheduler(config_);
+    scheduler.ThrottleHost("busy.test", now_ + 2s);
+    scheduler.Push(1, MakeRequest("http://busy.test/1"));
+    scheduler.Push(2, MakeRequest("http://idle.test/2"));
+
+    auto entry = scheduler.PopNext(now_);
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(entry->id, 2u);
+    EXPECT_FALSE(scheduler.PopNext(now_ + 1s).has_value());
+    EXPECT_EQ(scheduler.GetNextEligibleTime(now_), now_ + 2s);
+    EXPECT_TRUE(scheduler.PopNext(now_ + 2s).has_value());
+}
+
+TEST_F(RequestSchedulerTest, RemoveAndClear) {
+    RequestScheduler scheduler(config_);
+    scheduler.Push(1, MakeRequest("http://a.test/1", "A"));
+    scheduler.Push(2, MakeRequest("http://a.test/2", "B"));
+    scheduler.Push(3, MakeRequest("file:///tmp/3", "B"));
+
+    EXPECT_TRUE(scheduler.Remove(2));
+    EXPECT_FALSE(scheduler.Remove(2));
+    EXPECT_EQ(scheduler.GetQueuedCount(), 2u);
+
+    EXPECT_EQ(scheduler.Clear().size(), 2u);
+    EXPECT_EQ(scheduler.GetQueuedCount(), 0u);
+    EXPECT_FALSE(scheduler.PopNext(now_).has_value());
+}
+
+TEST(HttpDownloadEngineThrottleTest, ReportsRetryAfter) {
+    LoopbackHttpServer server([](const std::string&) {
+        return std::string("HTTP/1.1 429 Too Many Requests\r\nRetry-After: 7\r\n"
+                           "Content-Length: 0\r\nConnection: close\r\n\r\n");
+    });
+    auto engine = CreateHttpDownloadEngine(TileLoaderConfig{});
+
+    auto promise = std::make_shared<std::promise<HttpResponse>>();
+    auto future = promise->get_future();
+    HttpRequest request = MakeRequest(server.BaseUrl() + "/tile.png");
+    request.on_complete = [promise](HttpResponse&& response) {
+        promise->set_value(std::move(response));
+    };
+    engine->Submit(std::move(request));
+
+    const HttpResponse response = future.get();
+    EXPECT_FALSE(response.success);
+    EXPECT_EQ(response.status_code, 429u);
+    ASSERT_TRUE(response.retry_after.has_value());
+    EXPECT_EQ(*response.retry_after, 7s);
+}
+
+} // namespace earth_map::tests
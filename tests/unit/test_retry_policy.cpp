@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/retry_policy.h>
+#include <earth_map/data/tile_loader.h>
+#include "loopback_http_server.h"
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace earth_map::tests {
+
+using namespace std::chrono_literals;
+
+namespace {
+
+std::string Respond(int status, const std::string& body = "") {
+    const std::string reason = status == 200 ? "OK" : "Error";
+    return "HTTP/1.1 " + std::to_string(status) + " " + reason +
+           "\r\nContent-Length: " + std::to_string(body.size()) +
+           "\r\nConnection: close\r\n\r\n" + body;
+}
+
+/// XYZ provider with a short retry delay so tests do not wait for seconds
+class FastRetryProvider : public BasicXYZTileProvider {
+public:
+    using BasicXYZTileProvider::BasicXYZTileProvider;
+    std::uint32_t GetMaxRetries() const override { return 2; }
+    std::uint32_t GetRetryDelay() const override { return 10; }
+};
+
+} // namespace
+
+TEST(RetryBackoffTest, DoublesUpToTheCap) {
+    RetryBackoff backoff;
+    backoff.base_delay = 100ms;
+    backoff.max_delay = 1000ms;
+    backoff.jitter = 0.0f;
+
+    EXPECT_EQ(backoff.GetDelay(0, 0.5), 100ms);
+    EXPECT_EQ(backoff.GetDelay(1, 0.5), 200ms);
+    EXPECT_EQ(backoff.GetDelay(3, 0.5), 800ms);
+    EXPECT_EQ(backoff.GetDelay(4, 0.5), 1000ms);
+    EXPECT_EQ(backoff.GetDelay(1000, 0.5), 1000ms);
+}
+
+TEST(RetryBackoffTest, JitterShortensWithinBounds) {
+    RetryBackoff backoff;
+    backoff.base_delay = 400ms;
+    backoff.max_delay = 10000ms;
+    backoff.jitter = 0.5f;
+
+    EXPECT_EQ(backoff.GetDelay(0, 0.0), 400ms);
+    EXPECT_EQ(backoff.GetDelay(0, 0.5), 300ms);
+    EXPECT_GE(backoff.GetDelay(0, 0.999), 200ms);
+
+    backoff.jitter = 1.0f;
+    EXPECT_LE(backoff.GetDelay(2, 0.999), 2ms);
+}
+
+TEST(HostCircuitBreakerTest, OpensAfterConsecutiveFailures) {
+    CircuitBreakerConfig config;
+    config.failure_threshold = 3;
+    config.cooldown = 1000ms;
+    HostCircuitBreaker breaker(config);
+    const auto now = HostCircuitBreaker::Clock::now();
+
+    breaker.RecordFailure("a", now);
+    breaker.RecordFailure("a", now);
+    breaker.RecordSuccess("a");  // Resets the streak
+    breaker.RecordFailure("a", now);
+    breaker.RecordFailure("a", now);
+    EXPECT_TRUE(breaker.AllowRequest("a", now));
+
+    breaker.RecordFailure("a", now);
+    EXPECT_EQ(breaker.GetState("a", now), HostCircuitBreaker::State::OPEN);
+    EXPECT_FALSE(breaker.AllowRequest("a", now + 500ms));
+
+    // Other hosts are unaffected
+    EXPECT_TRUE(breaker.AllowRequest("b", now));
+    EXPECT_TRUE(breaker.AllowRequest("", now));
+}
+
+TEST(HostCircuitBreakerTest, HalfOpenAllowsOneProbe) {
+    CircuitBreakerConfig config;
+    config.failure_threshold = 1;
+    config.cooldown = 1000ms;
+    HostCircuitBreaker breaker(config);
+    const auto now = HostCircuitBreaker::Clock::now();
+
+    breaker.RecordFailure("a", now);
+    const auto later = now + 1000ms;
+    EXPECT_EQ(breaker.GetState("a", later), HostCircuitBreaker::State::HALF_OPEN);
+    EXPECT_TRUE(breaker.AllowRequest("a", later));
+    EXPECT_FALSE(breaker.AllowRequest("a", later));
+
+    // An abandoned probe hands the slot to the next request
+    breaker.RecordAbandoned("a");
+    EXPECT_TRUE(breaker.AllowRequest("a", later));
+
+    // A failed probe reopens the circuit
+    breaker.RecordFailure("a", later);
+    EXPECT_FALSE(breaker.AllowRequest("a", later + 999ms));
+
+    // A successful probe closes it
+    EXPECT_TRUE(breaker.AllowRequest("a", later + 1000ms));
+    breaker.RecordSuccess("a");
+    EXPECT_EQ(breaker.GetState("a", later + 1000ms), HostCircuitBreaker::State::CLOSED);
+    EXPECT_TRUE(breaker.AllowRequest("a", later + 1000ms));
+}
+
+TEST(HostCircuitBreakerTest, ZeroThresholdNeverOpens) {
+    CircuitBreakerConfig config;
+    config.failure_threshold = 0;
+    HostCircuitBreaker breaker(config);
+    for (int i = 0; i < 100; ++i) {
+        breaker.RecordFailure("a");
+    }
+    EXPECT_TRUE(breaker.AllowRequest("a"));
+}
+
+TEST(HostCircuitBreakerTest, ExtractsHostFromUrl) {
+    EXPECT_EQ(HostCircuitBreaker::HostFromUrl("https://Tile.Example.org/1/2/3.png"),
+              "tile.example.org");
+    EXPECT_EQ(HostCircuitBreaker::HostFromUrl("http://127.0.0.1:8080/a?b"), "127.0.0.1:8080");
+    EXPECT_EQ(HostCircuitBreaker::HostFromUrl("http://user:pw@host.net"), "host.net");
+    EXPECT_EQ(HostCircuitBreaker::HostFromUrl("file:///tmp/tiles/1/2/3.png"), "");
+    EXPECT_EQ(HostCircuitBreaker::HostFromUrl("not a url"), "");
+}
+
+class TileLoaderRetryTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        config_.circuit_breaker_threshold = 2;
+        config_.circuit_breaker_cooldown = 60000;
+        loader_ = CreateTileLoader(config_);
+        ASSERT_TRUE(loader_->Initialize(config_));
+    }
+
+    void AddProvider(const std::string& name, const LoopbackHttpServer& server) {
+        ASSERT_TRUE(loader_->AddProvider(std::make_shared<FastRetryProvider>(
+            name, server.BaseUrl() + "/{z}/{x}/{y}.png")));
+    }
+
+    TileLoaderConfig config_;
+    std::unique_ptr<TileLoader> loader_;
+};
+
+TEST_F(TileLoaderRetryTest, RetriesTransientErrorsOnly) {
+    config_.circuit_breaker_threshold = 0;
+    ASSERT_TRUE(loader_->SetConfiguration(config_));
+    LoopbackHttpServer flaky([](const std::string& request) {
+        return Respond(request.find("/1/") != std::string::npos ? 503 : 404);
+    });
+    AddProvider("Flaky", flaky);
+
+    const TileLoadResult unavailable = loader_->LoadTile(TileCoordinates(0, 0, 1), "Flaky");
+    EXPECT_FALSE(unavailable.success);
+    EXPECT_EQ(unavailable.retry_count, 2u);
+    EXPECT_EQ(flaky.GetRequests().size(), 3u);
+
+    // A 404 will not change on a retry
+    const TileLoadResult missing = loader_->LoadTile(TileCoordinates(0, 0, 2), "Flaky");
+    EXPECT_FALSE(missing.success);
+    EXPECT_EQ(missing.retry_count, 0u);
+    EXPECT_EQ(flaky.GetRequests().size(), 4u);
+    EXPECT_EQ(loader_->GetStatistics().retried_requests, 2u);
+}
+
+TEST_F(TileLoaderRetryTest, OpenCircuitFailsFastWithoutAffectingOtherHosts) {
+    LoopbackHttpServer failing([](const std::string&) { return Respond(503); });
+    LoopbackHttpServer healthy([](const std::string&) { return Respond(200, "tile"); });
+    AddProvider("Failing", failing);
+    AddProvider("Healthy", healthy);
+
+    // Two failed attempts open the circuit; the remaining retry is dropped
+    EXPECT_FALSE(loader_->LoadTile(TileCoordinates(0, 0, 1), "Failing").success);
+    EXPECT_EQ(failing.GetRequests().size(), 2u);
+
+    const TileLoadResult rejected = loader_->LoadTile(TileCoordinates(1, 0, 1), "Failing");
+    EXPECT_FALSE(rejected.success);
+    EXPECT_NE(rejected.error_message.find("circuit open"), std::string::npos);
+    EXPECT_EQ(failing.GetRequests().size(), 2u);
+    EXPECT_EQ(loader_->GetStatistics().circuit_rejected_requests, 1u);
+
+    EXPECT_TRUE(loader_->LoadTile(TileCoordinates(0, 0, 1), "Healthy").success);
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,221 @@
+#include <gtest/gtest.h>
+#include <earth_map/core/scene_index.h>
+#include <earth_map/math/packed_hilbert_rtree.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+Frustum MakeFrustum() {
+    const glm::mat4 projection =
+        glm::perspective(glm::radians(60.0f), 4.0f / 3.0f, 0.1f, 50.0f);
+    const glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 10.0f), glm::vec3(0.0f),
+                                       glm::vec3(0.0f, 1.0f, 0.0f));
+    return Frustum(projection * view);
+}
+
+/// Random boxes (a third of them points) around the view volume
+std::vector<BoundingBox> MakeBoxes(std::size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-30.0f, 30.0f);
+    std::uniform_real_distribution<float> size(0.0f, 2.0f);
+    std::vector<BoundingBox> boxes;
+    for (std::size_t i = 0; i < count; ++i) {
+        const glm::vec3 min(position(rng), position(rng), position(rng));
+        const glm::vec3 extent = i % 3 == 0 ? glm::vec3(0.0f)
+                                            : glm::vec3(size(rng), size(rng), size(rng));
+        boxes.emplace_back(min, min + extent);
+    }
+    return boxes;
+}
+
+std::vector<std::uint32_t> Sorted(std::vector<std::uint32_t> items) {
+    std::sort(items.begin(), items.end());
+    return items;
+}
+
+} // namespace
+
+TEST(PackedHilbertRTreeTest, HilbertIndexWalksAdjacentCells) {
+    constexpr std::uint32_t bits = 3;
+    constexpr std::uint32_t side = 1u << bits;
+    std::vector<glm::ivec3> cells(side * side * side, glm::ivec3(-1));
+    for (std::uint32_t x = 0; x < side; ++x) {
+        for (std::uint32_t y = 0; y < side; ++y) {
+            for (std::uint32_t z = 0; z < side; ++z) {
+                const std::uint64_t index = PackedHilbertRTree::HilbertIndex(x, y, z, bits);
+                ASSERT_LT(index, cells.size());
+                ASSERT_EQ(cells[index].x, -1) << "index " << index << " used twice";
+                cells[index] = glm::ivec3(x, y, z);
+            }
+        }
+    }
+    for (std::size_t i = 1; i < cells.size(); ++i) {
+        const glm::ivec3 step = cells[i] - cells[i - 1];
+        EXPECT_EQ(std::abs(step.x) + std::abs(step.y) + std::abs(step.z), 1) << "at " << i;
+    }
+}
+
+TEST(PackedHilbertRTreeTest, QueriesMatchBruteForce) {
+    const std::vector<BoundingBox> boxes = MakeBoxes(5000, 7);
+    const Frustum frustum = MakeFrustum();
+    for (const std::uint32_t node_size : {2u, 16u}) {
+        SCOPED_TRACE(node_size);
+        const PackedHilbertRTree tree(boxes, node_size);
+        EXPECT_EQ(tree.GetItemCount(), boxes.size());
+
+        const BoundingBox query(glm::vec3(-5.0f, -2.0f, -8.0f), glm::vec3(4.0f, 6.0f, 1.0f));
+        std::vector<std::uint32_t> expected_box;
+        std::vector<std::uint32_t> expected_frustum;
+        for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+            if (boxes[i].Intersects(query)) {
+                expected_box.push_back(i);
+            }
+            if (frustum.Intersects(boxes[i])) {
+                expected_frustum.push_back(i);
+            }
+        }
+        ASSERT_FALSE(expected_frustum.empty());
+
+        std::vector<std::uint32_t> items;
+        tree.Query(query, items);
+        EXPECT_EQ(Sorted(items), expected_box);
+        items.clear();
+        tree.Query(frustum, items);
+        EXPECT_EQ(Sorted(items), expected_frustum);
+    }
+
+    const PackedHilbertRTree empty;
+    std::vector<std::uint32_t> items;
+    empty.Query(frustum, items);
+    EXPECT_TRUE(items.empty());
+    EXPECT_FALSE(empty.Pick(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), 1.0f));
+}
+
+TEST(PackedHilbertRTreeTest, PickFindsTheNearestItemNearTheRay) {
+    const std::vector<BoundingBox> boxes = MakeBoxes(5000, 11);
+    const PackedHilbertRTree tree(boxes);
+    const glm::vec3 origin(0.5f, -0.25f, 40.0f);
+    const glm::vec3 direction = glm::normalize(glm::vec3(0.1f, 0.05f, -1.0f));
+    const float radius = 0.5f;
+
+    std::optional<RayHit> expected;
+    for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+        const std::optional<float> distance =
+            PackedHilbertRTree::PickDistance(boxes[i], origin, direction, radius);
+        if (distance && (!expected || *distance < expected->distance)) {
+            expected = RayHit{i, *distance};
+        }
+    }
+    ASSERT_TRUE(expected);
+    const std::optional<RayHit> hit = tree.Pick(origin, direction, radius);
+    ASSERT_TRUE(hit);
+    EXPECT_EQ(hit->item, expected->item);
+    EXPECT_FLOAT_EQ(hit->distance, expected->distance);
+
+    // Rejected items are skipped
+    const std::optional<RayHit> next = tree.Pick(
+        origin, direction, radius, [&](std::uint32_t item) { return item != expected->item; });
+    ASSERT_TRUE(next);
+    EXPECT_NE(next->item, expected->item);
+    EXPECT_GE(next->distance, expected->distance);
+}
+
+TEST(SceneIndexTest, EditsMatchBruteForce) {
+    const std::vector<BoundingBox> boxes = MakeBoxes(3000, 3);
+    const Frustum frustum = MakeFrustum();
+    SceneIndex index(64);
+    std::unordered_map<SceneObjectId, BoundingBox> live;
+
+    const auto check = [&]() {
+        ASSERT_EQ(index.GetCount(), live.size());
+        std::set<SceneObjectId> expected;
+        for (const auto& [id, box] : live) {
+            if (frustum.Intersects(box)) {
+                expected.insert(id);
+            }
+        }
+        std::vector<SceneObjectId> visible;
+        index.QueryVisible(frustum, visible);
+        EXPECT_EQ(visible.size(), expected.size());
+        EXPECT_EQ(std::set<SceneObjectId>(visible.begin(), visible.end()), expected);
+    };
+
+    std::mt19937 rng(5);
+    for (SceneObjectId id = 0; id < 2000; ++id) {
+        index.Insert(id, boxes[id]);
+        live[id] = boxes[id];
+    }
+    check();
+    EXPECT_LE(index.GetTreeCount(), 6u);
+
+    // Moves, removals and reinserts across trees and the overlay
+    for (int step = 0; step < 3000; ++step) {
+        const auto id = static_cast<SceneObjectId>(rng() % 2500);
+        const BoundingBox& box = boxes[rng() % boxes.size()];
+        if (rng() % 3 == 0) {
+            EXPECT_EQ(index.Remove(id), live.erase(id) == 1);
+        } else {
+            index.Insert(id, box);
+            live[id] = box;
+        }
+        EXPECT_EQ(index.Contains(id), live.count(id) == 1);
+    }
+    check();
+
+    // Pick agrees with a scan of the live objects
+    const glm::vec3 origin(0.0f, 0.0f, 40.0f);
+    const glm::vec3 direction(0.0f, 0.0f, -1.0f);
+    std::optional<ScenePick> expected;
+    for (const auto& [id, box] : live) {
+        const std::optional<float> distance =
+            PackedHilbertRTree::PickDistance(box, origin, direction, 1.0f);
+        if (distance && (!expected || *distance < expected->distance)) {
+            expected = ScenePick{id, *distance};
+        }
+    }
+    const std::optional<ScenePick> pick = index.Pick(origin, direction, 1.0f);
+    ASSERT_EQ(pick.has_value(), expected.has_value());
+    if (pick) {
+        EXPECT_FLOAT_EQ(pick->distance, expected->distance);
+    }
+
+    index.Compact();
+    EXPECT_EQ(index.GetTreeCount(), 1u);
+    check();
+
+    index.Clear();
+    live.clear();
+    check();
+}
+
+TEST(SceneIndexTest, BuildBulkLoadsOneTree) {
+    std::vector<SceneIndexEntry> entries;
+    const std::vector<BoundingBox> boxes = MakeBoxes(1000, 9);
+    for (SceneObjectId id = 0; id < boxes.size(); ++id) {
+        entries.push_back({id * 2, boxes[id]});
+    }
+    SceneIndex index;
+    index.Build(entries);
+    EXPECT_EQ(index.GetCount(), entries.size());
+    EXPECT_EQ(index.GetTreeCount(), 1u);
+    EXPECT_TRUE(index.Contains(10));
+    EXPECT_FALSE(index.Contains(11));
+
+    std::vector<SceneObjectId> found;
+    index.Query(boxes[5], found);
+    EXPECT_NE(std::find(found.begin(), found.end(), 10u), found.end());
+    EXPECT_TRUE(index.Remove(10));
+    found.clear();
+    index.Query(boxes[5], found);
+    EXPECT_EQ(std::find(found.begin(), found.end(), 10u), found.end());
+}
+
+} // namespace earth_map::tests
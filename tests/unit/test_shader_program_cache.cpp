@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/shader_program_cache.h>
+#include <filesystem>
+#include <fstream>
+
+namespace earth_map::tests {
+
+class ShaderProgramCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() /
+                     (std::string("earth_map_shaders_") +
+                      ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(directory_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    static ShaderProgramBinary MakeBinary(std::uint32_t format, std::size_t size) {
+        ShaderProgramBinary binary;
+        binary.format = format;
+        for (std::size_t i = 0; i < size; ++i) {
+            binary.data.push_back(static_cast<std::uint8_t>(i * 7));
+        }
+        return binary;
+    }
+
+    std::filesystem::path directory_;
+};
+
+TEST_F(ShaderProgramCacheTest, StoredBinaryLoadsBack) {
+    ShaderProgramCache cache(directory_.string(), "vendor|renderer|4.6");
+    const std::uint64_t key = cache.MakeKey("void main() {}", "out vec4 c; void main() {}");
+    EXPECT_FALSE(cache.Load(key).has_value());
+
+    ASSERT_TRUE(cache.Store(key, MakeBinary(0x1234, 300)));
+    const auto loaded = cache.Load(key);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->format, 0x1234u);
+    EXPECT_EQ(loaded->data, MakeBinary(0x1234, 300).data);
+    EXPECT_EQ(cache.GetStats().stores, 1u);
+}
+
+TEST_F(ShaderProgramCacheTest, KeyDependsOnSourcesAndDriver) {
+    const ShaderProgramCache cache(directory_.string(), "mesa|iris|4.6 Mesa 23.1");
+    const ShaderProgramCache updated(directory_.string(), "mesa|iris|4.6 Mesa 23.2");
+    const std::uint64_t key = cache.MakeKey("ab", "c");
+    EXPECT_EQ(key, cache.MakeKey("ab", "c"));
+    EXPECT_NE(key, cache.MakeKey("a", "bc"));
+    EXPECT_NE(key, cache.MakeKey("ab", "d"));
+    EXPECT_NE(key, updated.MakeKey("ab", "c"));
+}
+
+TEST_F(ShaderProgramCacheTest, CorruptFileIsRejected) {
+    ShaderProgramCache cache(directory_.string(), "driver");
+    const std::uint64_t key = cache.MakeKey("v", "f");
+    ASSERT_TRUE(cache.Store(key, MakeBinary(1, 64)));
+
+    // Flip one byte of the binary behind the header
+    std::filesystem::path file;
+    for (const auto& entry : std::filesystem::directory_iterator(directory_)) {
+        file = entry.path();
+    }
+    {
+        std::fstream stream(file, std::ios::in | std::ios::out | std::ios::binary);
+        stream.seekp(-1, std::ios::end);
+        stream.put('\x7f');
+    }
+    EXPECT_FALSE(cache.Load(key).has_value());
+    EXPECT_EQ(cache.GetStats().rejected, 1u);
+
+    // Truncated file
+    std::filesystem::resize_file(file, 8);
+    EXPECT_FALSE(cache.Load(key).has_value());
+    EXPECT_EQ(cache.GetStats().rejected, 2u);
+}
+
+TEST_F(ShaderProgramCacheTest, StoreReplacesPreviousBinary) {
+    ShaderProgramCache cache(directory_.string(), "driver");
+    const std::uint64_t key = cache.MakeKey("v", "f");
+    ASSERT_TRUE(cache.Store(key, MakeBinary(1, 10)));
+    ASSERT_TRUE(cache.Store(key, MakeBinary(2, 20)));
+    const auto loaded = cache.Load(key);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_EQ(loaded->format, 2u);
+    EXPECT_EQ(loaded->data.size(), 20u);
+    EXPECT_EQ(std::distance(std::filesystem::directory_iterator(directory_),
+                            std::filesystem::directory_iterator{}), 1);
+}
+
+} // namespace earth_map::tests
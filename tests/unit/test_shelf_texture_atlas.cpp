@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/texture_atlas/shelf_texture_atlas.h>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+bool Disjoint(const ShelfAtlasRegion& a, const ShelfAtlasRegion& b) {
+    return a.x + a.width <= b.x || b.x + b.width <= a.x ||
+           a.y + a.height <= b.y || b.y + b.height <= a.y;
+}
+
+} // namespace
+
+TEST(ShelfTextureAtlasTest, AllocatedRegionsDoNotOverlap) {
+    ShelfTextureAtlas atlas(256, 256, 1, 1, true);
+
+    std::vector<ShelfAtlasRegion> regions;
+    for (std::uint32_t i = 0; i < 40; ++i) {
+        const auto region = atlas.Allocate(8 + i % 5 * 3, 10 + i % 3 * 4);
+        ASSERT_TRUE(region.has_value());
+        EXPECT_LE(region->x + region->width + 1, 256u);
+        EXPECT_LE(region->y + region->height + 1, 256u);
+        regions.push_back(*region);
+    }
+    for (std::size_t i = 0; i < regions.size(); ++i) {
+        for (std::size_t j = i + 1; j < regions.size(); ++j) {
+            EXPECT_TRUE(Disjoint(regions[i], regions[j])) << i << " and " << j;
+        }
+    }
+    EXPECT_EQ(atlas.GetStats().regions, regions.size());
+}
+
+TEST(ShelfTextureAtlasTest, UVsCoverTheRegion) {
+    ShelfTextureAtlas atlas(128, 64, 1, 1, true);
+    const auto region = atlas.Allocate(16, 8);
+    ASSERT_TRUE(region.has_value());
+
+    EXPECT_FLOAT_EQ(region->uv.x, static_cast<float>(region->x) / 128.0f);
+    EXPECT_FLOAT_EQ(region->uv.y, static_cast<float>(region->y) / 64.0f);
+    EXPECT_FLOAT_EQ(region->uv.z, static_cast<float>(region->x + 16) / 128.0f);
+    EXPECT_FLOAT_EQ(region->uv.w, static_cast<float>(region->y + 8) / 64.0f);
+}
+
+TEST(ShelfTextureAtlasTest, SimilarHeightsShareAShelf) {
+    ShelfTextureAtlas atlas(256, 256, 1, 1, true);
+    const auto a = atlas.Allocate(10, 20);
+    const auto b = atlas.Allocate(10, 18);
+    const auto c = atlas.Allocate(10, 4);   // Would waste most of the tall shelf
+
+    ASSERT_TRUE(a && b && c);
+    EXPECT_EQ(a->shelf, b->shelf);
+    EXPECT_NE(a->shelf, c->shelf);
+    EXPECT_EQ(atlas.GetStats().shelves, 2u);
+}
+
+TEST(ShelfTextureAtlasTest, ReturnsNulloptWhenFull) {
+    ShelfTextureAtlas atlas(64, 64, 1, 1, true);
+    EXPECT_FALSE(atlas.Allocate(64, 8).has_value());   // Too wide with padding
+
+    std::size_t allocated = 0;
+    while (atlas.Allocate(14, 14)) {
+        ++allocated;
+    }
+    EXPECT_EQ(allocated, 16u);   // 4 x 4 padded 16-pixel cells
+    EXPECT_FALSE(atlas.Allocate(1, 1).has_value());
+}
+
+TEST(ShelfTextureAtlasTest, ReleasedShelfIsReused) {
+    ShelfTextureAtlas atlas(64, 64, 1, 1, true);
+    std::vector<ShelfAtlasRegion> regions;
+    while (auto region = atlas.Allocate(14, 14)) {
+        regions.push_back(*region);
+    }
+    ASSERT_EQ(regions.size(), 16u);
+
+    // Release the first shelf entirely; it restarts from its left edge
+    for (const ShelfAtlasRegion& region : regions) {
+        if (region.shelf == regions.front().shelf) {
+            atlas.Release(region);
+        }
+    }
+    const auto reused = atlas.Allocate(14, 14);
+    ASSERT_TRUE(reused.has_value());
+    EXPECT_EQ(reused->shelf, regions.front().shelf);
+    EXPECT_EQ(reused->x, regions.front().x);
+    EXPECT_EQ(atlas.GetStats().regions, 13u);
+}
+
+TEST(ShelfTextureAtlasTest, ResetEmptiesTheAtlas) {
+    ShelfTextureAtlas atlas(64, 64, 1, 1, true);
+    while (atlas.Allocate(14, 14)) {
+    }
+    atlas.Reset();
+
+    const ShelfAtlasStats stats = atlas.GetStats();
+    EXPECT_EQ(stats.shelves, 0u);
+    EXPECT_EQ(stats.regions, 0u);
+    EXPECT_EQ(stats.used_pixels, 0u);
+    EXPECT_EQ(stats.resets, 1u);
+    EXPECT_TRUE(atlas.Allocate(62, 62).has_value());
+}
+
+TEST(ShelfTextureAtlasTest, UploadValidatesItsArguments) {
+    ShelfTextureAtlas atlas(64, 64, 1, 1, true);
+    const auto region = atlas.Allocate(4, 4);
+    ASSERT_TRUE(region.has_value());
+    const std::vector<std::uint8_t> pixels(16, 255);
+
+    EXPECT_TRUE(atlas.Upload(*region, pixels.data()));
+    EXPECT_FALSE(atlas.Upload(*region, nullptr));
+    EXPECT_FALSE(atlas.Upload(ShelfAtlasRegion{}, pixels.data()));
+}
+
+} // namespace earth_map::tests
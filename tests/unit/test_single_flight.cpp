@@ -0,0 +1,171 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/single_flight.h>
+#include <earth_map/data/tile_loader.h>
+#include "loopback_http_server.h"
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace earth_map::tests {
+
+TEST(SingleFlightTest, FirstCallerLeadsOthersJoin) {
+    SingleFlight<int, std::string> flights;
+
+    auto leader = flights.Join(7);
+    auto follower = flights.Join(7);
+    auto other = flights.Join(8);
+
+    EXPECT_TRUE(leader.leader);
+    EXPECT_FALSE(follower.leader);
+    EXPECT_TRUE(other.leader);
+    EXPECT_EQ(leader.id, follower.id);
+    EXPECT_EQ(flights.Size(), 2u);
+    EXPECT_EQ(flights.GetCoalescedCount(), 1u);
+
+    EXPECT_TRUE(flights.Complete(7, leader.id, "tile"));
+    EXPECT_EQ(leader.future.get(), "tile");
+    EXPECT_EQ(follower.future.get(), "tile");
+    EXPECT_FALSE(flights.Contains(7));
+    EXPECT_TRUE(flights.Contains(8));
+}
+
+TEST(SingleFlightTest, ListenersRunBeforeFutureIsReady) {
+    SingleFlight<int, int> flights;
+    std::vector<int> seen;
+
+    auto leader = flights.Join(1, [&seen](const int& value) { seen.push_back(value); });
+    flights.Join(1, [&seen, &leader](const int& value) {
+        // The shared future is not ready while listeners run
+        EXPECT_NE(leader.future.wait_for(std::chrono::seconds(0)), std::future_status::ready);
+        seen.push_back(value * 10);
+    });
+
+    flights.Complete(1, leader.id, 4);
+    EXPECT_EQ(seen, (std::vector<int>{4, 40}));
+    EXPECT_EQ(leader.future.get(), 4);
+}
+
+TEST(SingleFlightTest, StaleCompletionIsIgnored) {
+    SingleFlight<int, int> flights;
+
+    auto first = flights.Join(3);
+    ASSERT_TRUE(flights.Complete(3, first.id, 1));
+
+    // A new call for the same key must not be resolved by the old leader
+    auto second = flights.Join(3);
+    EXPECT_TRUE(second.leader);
+    EXPECT_NE(second.id, first.id);
+    EXPECT_FALSE(flights.Complete(3, first.id, 99));
+    EXPECT_TRUE(flights.Contains(3));
+
+    EXPECT_TRUE(flights.Complete(3, second.id, 2));
+    EXPECT_EQ(second.future.get(), 2);
+}
+
+TEST(SingleFlightTest, ConcurrentJoinersShareOneLeader) {
+    SingleFlight<int, int> flights;
+    std::atomic<int> leaders{0};
+    std::vector<std::shared_future<int>> futures(16);
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i < futures.size(); ++i) {
+        threads.emplace_back([&flights, &leaders, &futures, i] {
+            auto call = flights.Join(42);
+            futures[i] = call.future;
+            if (call.leader) {
+                leaders++;
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+                flights.Complete(42, call.id, 5);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    // Joiners that arrive after completion lead a new call of their own
+    EXPECT_GE(leaders.load(), 1);
+    for (auto& future : futures) {
+        EXPECT_EQ(future.get(), 5);
+    }
+    EXPECT_EQ(flights.Size(), 0u);
+}
+
+TEST(SingleFlightTest, TileLoaderSharesOneDownloadPerTile) {
+    LoopbackHttpServer server([](const std::string&) {
+        // Slow enough for every requester to arrive while the download is in flight
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        return std::string("HTTP/1.1 200 OK\r\nContent-Length: 4\r\n"
+                           "Connection: close\r\n\r\ntile");
+    });
+
+    TileLoaderConfig config;
+    auto loader = CreateTileLoader(config);
+    ASSERT_TRUE(loader->Initialize(config));
+    ASSERT_TRUE(loader->AddProvider(std::make_shared<BasicXYZTileProvider>(
+        "Loopback", server.BaseUrl() + "/{z}/{x}/{y}.png")));
+    ASSERT_TRUE(loader->SetDefaultProvider("Loopback"));
+    const TileCoordinates coords(1, 1, 2);
+
+    std::atomic<int> callbacks{0};
+    auto async_a = loader->LoadTileAsync(coords, [&callbacks](const TileLoadResult& result) {
+        EXPECT_TRUE(result.success);
+        callbacks++;
+    });
+    auto async_b = loader->LoadTileAsync(coords, [&callbacks](const TileLoadResult&) {
+        callbacks++;
+    });
+    auto shared = loader->LoadTileShared(coords);
+    auto sync = std::async(std::launch::async, [&loader, &coords] {
+        return loader->LoadTile(coords);
+    });
+
+    EXPECT_TRUE(async_a.get().success);
+    EXPECT_TRUE(async_b.get().success);
+    EXPECT_TRUE(shared.get().success);
+    const TileLoadResult sync_result = sync.get();
+    ASSERT_TRUE(sync_result.success) << sync_result.error_message;
+    EXPECT_EQ(std::string(sync_result.tile_data->data.begin(), sync_result.tile_data->data.end()),
+              "tile");
+
+    EXPECT_EQ(callbacks.load(), 2);
+    EXPECT_EQ(server.GetRequests().size(), 1u);
+
+    const auto stats = loader->GetStatistics();
+    EXPECT_EQ(stats.coalesced_requests, 3u);
+    EXPECT_EQ(stats.successful_requests, 1u);
+    EXPECT_FALSE(loader->IsLoading(coords));
+}
+
+TEST(SingleFlightTest, TileLoaderCancelResolvesEveryRequester) {
+    LoopbackHttpServer server([](const std::string&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        return std::string("HTTP/1.1 200 OK\r\nContent-Length: 4\r\n"
+                           "Connection: close\r\n\r\ntile");
+    });
+
+    TileLoaderConfig config;
+    auto loader = CreateTileLoader(config);
+    ASSERT_TRUE(loader->Initialize(config));
+    ASSERT_TRUE(loader->AddProvider(std::make_shared<BasicXYZTileProvider>(
+        "Loopback", server.BaseUrl() + "/{z}/{x}/{y}.png")));
+    ASSERT_TRUE(loader->SetDefaultProvider("Loopback"));
+    const TileCoordinates coords(0, 1, 1);
+
+    auto first = loader->LoadTileAsync(coords);
+    auto second = loader->LoadTileShared(coords);
+    EXPECT_TRUE(loader->IsLoading(coords));
+
+    EXPECT_TRUE(loader->CancelLoad(coords));
+    const TileLoadResult first_result = first.get();
+    EXPECT_FALSE(first_result.success);
+    EXPECT_EQ(first_result.error_message, "Load cancelled");
+    EXPECT_FALSE(second.get().success);
+    EXPECT_FALSE(loader->IsLoading(coords));
+    EXPECT_FALSE(loader->CancelLoad(coords));
+}
+
+} // namespace earth_map::tests
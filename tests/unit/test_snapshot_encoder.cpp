@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/snapshot_renderer.h>
+#include <earth_map/renderer/texture_atlas/image_decoder.h>
+#include <cstdint>
+#include <vector>
+
+namespace earth_map::tests {
+
+TEST(SnapshotEncoderTest, PngRoundTripsThroughDecoder) {
+    constexpr std::uint32_t kWidth = 3;
+    constexpr std::uint32_t kHeight = 2;
+    std::vector<std::uint8_t> rgba;
+    for (std::uint32_t i = 0; i < kWidth * kHeight; ++i) {
+        rgba.insert(rgba.end(), {static_cast<std::uint8_t>(i * 40), static_cast<std::uint8_t>(255 - i),
+                                 static_cast<std::uint8_t>(i), 255});
+    }
+
+    const std::vector<std::uint8_t> png = EncodeSnapshotPng(rgba, kWidth, kHeight);
+    ASSERT_FALSE(png.empty());
+    EXPECT_EQ(DetectImageFormat(png.data(), png.size()), ImageFormat::PNG);
+
+    DecodedImage decoded;
+    ASSERT_TRUE(ImageDecoderRegistry::CreateDefault()->Decode(png.data(), png.size(), decoded));
+    EXPECT_EQ(decoded.width, kWidth);
+    EXPECT_EQ(decoded.height, kHeight);
+    EXPECT_EQ(decoded.pixels, rgba);
+}
+
+TEST(SnapshotEncoderTest, RejectsShortOrEmptyInput) {
+    const std::vector<std::uint8_t> rgba(4 * 4, 0);
+    EXPECT_TRUE(EncodeSnapshotPng(rgba, 0, 4).empty());
+    EXPECT_TRUE(EncodeSnapshotPng(rgba, 4, 4).empty());
+    EXPECT_FALSE(EncodeSnapshotPng(rgba, 2, 2).empty());
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,28 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/terrain_cull_pass.h>
+#include <cstdint>
+#include <vector>
+
+namespace earth_map::tests {
+
+TEST(TerrainCullPassTest, CommandsGiveEachLevelItsOwnInstanceRange) {
+    const TerrainPatchGeometry patch = TerrainPatch::Generate(8, 3);
+    ASSERT_EQ(patch.lods.size(), 3u);
+
+    const std::vector<std::uint32_t> commands = TerrainCullPass::MakeCommands(patch.lods, 40);
+    ASSERT_EQ(commands.size(), 3u * 5u);
+    for (std::size_t level = 0; level < patch.lods.size(); ++level) {
+        const std::uint32_t* command = commands.data() + level * 5;
+        EXPECT_EQ(command[0], patch.lods[level].index_count);
+        EXPECT_EQ(command[1], 0u);  // Counted by the shader
+        EXPECT_EQ(command[2], patch.lods[level].first_index);
+        EXPECT_EQ(command[3], 0u);
+        EXPECT_EQ(command[4], level * 40u);
+    }
+}
+
+TEST(TerrainCullPassTest, NoLevelsNoCommands) {
+    EXPECT_TRUE(TerrainCullPass::MakeCommands({}, 10).empty());
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/terrain_elevation_pool.h>
+#include <earth_map/data/elevation_provider.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+/// Elevation = latitude * 100 m, no data west of -170 degrees
+class FakeElevationProvider : public ElevationProvider {
+public:
+    ElevationQuery GetElevation(double latitude, double longitude) const override {
+        ElevationQuery query;
+        query.latitude = latitude;
+        query.longitude = longitude;
+        query.valid = longitude >= -170.0;
+        query.elevation_meters = static_cast<float>(latitude * 100.0);
+        return query;
+    }
+
+    std::vector<ElevationQuery> GetElevations(
+        const std::vector<coordinates::Geographic>& points) const override {
+        batch_count.fetch_add(1);
+        std::vector<ElevationQuery> results;
+        results.reserve(points.size());
+        for (const auto& point : points) {
+            results.push_back(GetElevation(point.latitude, point.longitude));
+        }
+        return results;
+    }
+
+    size_t PreloadRegion(const coordinates::GeographicBounds& /*bounds*/) override { return 0; }
+    std::shared_ptr<ElevationPreload> PreloadRegionAsync(
+        const coordinates::GeographicBounds& /*bounds*/,
+        const std::optional<coordinates::Geographic>& /*focus*/) override {
+        return nullptr;
+    }
+    bool IsAvailable(double /*latitude*/, double /*longitude*/) const override { return true; }
+    ElevationCacheStats GetCacheStatistics() const override { return {}; }
+    SRTMLoaderStats GetLoaderStatistics() const override { return {}; }
+    void ClearCache() override {}
+
+    mutable std::atomic<int> batch_count{0};
+};
+
+} // namespace
+
+TEST(TerrainElevationPoolTest, SamplesTileGridNorthToSouth) {
+    FakeElevationProvider provider;
+    // Zoom 1 tile (1, 0): longitudes 0..180, latitudes 85.05..0
+    const std::vector<float> heights =
+        TerrainElevationPool::SampleTile(provider, TileCoordinates(1, 0, 1), 3, -500.0f, 9000.0f);
+    ASSERT_EQ(heights.size(), 9u);
+    EXPECT_NEAR(heights[0], 8505.1f, 1.0f);  // North-west corner: Mercator limit
+    EXPECT_NEAR(heights[3], 6651.9f, 1.0f);  // Middle row: Mercator y = 0.25
+    EXPECT_NEAR(heights[8], 0.0f, 1e-3f);    // South-east corner: equator
+    EXPECT_EQ(heights[0], heights[2]);       // Rows share a latitude
+
+    // Clamped to the configured range
+    const std::vector<float> clamped =
+        TerrainElevationPool::SampleTile(provider, TileCoordinates(1, 0, 1), 3, -500.0f, 5000.0f);
+    EXPECT_EQ(clamped[0], 5000.0f);
+}
+
+TEST(TerrainElevationPoolTest, MissingDataIsSeaLevel) {
+    FakeElevationProvider provider;
+    // Tile (0, 0) at zoom 3 spans -180..-135: its west column has no data
+    const std::vector<float> heights =
+        TerrainElevationPool::SampleTile(provider, TileCoordinates(0, 0, 3), 5, -500.0f, 9000.0f);
+    EXPECT_EQ(heights[0], 0.0f);
+    EXPECT_GT(heights[4], 0.0f);
+}
+
+TEST(TerrainElevationPoolTest, BuildsMissingTilesWithinBudget) {
+    FakeElevationProvider provider;
+    TerrainElevationPool pool(5, 8, true);
+
+    const std::vector<TileCoordinates> tiles = {
+        TileCoordinates(0, 0, 0), TileCoordinates(0, 0, 1), TileCoordinates(0, 0, 1),
+        TileCoordinates(1, 1, 1)};
+    EXPECT_EQ(pool.Update(tiles, provider, 2, -500.0f, 9000.0f), 2u);
+    EXPECT_GE(pool.GetLayer(TileCoordinates(0, 0, 0)), 0);
+    EXPECT_GE(pool.GetLayer(TileCoordinates(0, 0, 1)), 0);
+    EXPECT_EQ(pool.GetLayer(TileCoordinates(1, 1, 1)), -1);
+
+    // Resident tiles are not rebuilt; duplicates were built once
+    EXPECT_EQ(pool.Update(tiles, provider, 2, -500.0f, 9000.0f), 1u);
+    EXPECT_EQ(provider.batch_count.load(), 3);
+    EXPECT_EQ(pool.GetResidentTiles(), 3u);
+}
+
+TEST(TerrainElevationPoolTest, EvictsLeastRecentlyUsedButNotCurrentTiles) {
+    FakeElevationProvider provider;
+    TerrainElevationPool pool(2, 2, true);
+
+    pool.Update({TileCoordinates(0, 0, 1)}, provider, 4, -500.0f, 9000.0f);
+    pool.Update({TileCoordinates(1, 0, 1)}, provider, 4, -500.0f, 9000.0f);
+
+    // (0, 0, 1) is the LRU tile: replaced
+    pool.Update({TileCoordinates(1, 0, 1), TileCoordinates(0, 1, 1)}, provider, 4,
+                -500.0f, 9000.0f);
+    EXPECT_EQ(pool.GetLayer(TileCoordinates(0, 0, 1)), -1);
+    EXPECT_GE(pool.GetLayer(TileCoordinates(1, 0, 1)), 0);
+    EXPECT_GE(pool.GetLayer(TileCoordinates(0, 1, 1)), 0);
+
+    // Three tiles wanted, two layers: the third waits instead of evicting
+    EXPECT_EQ(pool.Update({TileCoordinates(1, 0, 1), TileCoordinates(0, 1, 1),
+                           TileCoordinates(1, 1, 1)},
+                          provider, 4, -500.0f, 9000.0f),
+              0u);
+    EXPECT_EQ(pool.GetLayer(TileCoordinates(1, 1, 1)), -1);
+    EXPECT_EQ(pool.GetResidentTiles(), 2u);
+
+    pool.Clear();
+    EXPECT_EQ(pool.GetResidentTiles(), 0u);
+    EXPECT_EQ(pool.GetLayer(TileCoordinates(1, 0, 1)), -1);
+}
+
+TEST(TerrainElevationPoolTest, WorkersSampleAndLaterUpdatesUpload) {
+    FakeElevationProvider provider;
+    TerrainElevationPool pool(5, 8, true, 2);
+
+    const std::vector<TileCoordinates> tiles = {
+        TileCoordinates(0, 0, 0), TileCoordinates(0, 0, 1), TileCoordinates(1, 0, 1)};
+
+    // The first update only queues the builds
+    EXPECT_EQ(pool.Update(tiles, provider, 8, -500.0f, 9000.0f), 0u);
+    EXPECT_EQ(pool.GetPendingBuilds(), 3u);
+
+    // Later updates upload them, at most max_uploads at a time
+    std::size_t uploaded = 0;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (pool.GetResidentTiles() < tiles.size() && std::chrono::steady_clock::now() < deadline) {
+        const std::size_t count = pool.Update(tiles, provider, 1, -500.0f, 9000.0f);
+        EXPECT_LE(count, 1u);
+        uploaded += count;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(uploaded, 3u);
+    EXPECT_EQ(pool.GetPendingBuilds(), 0u);
+    EXPECT_EQ(provider.batch_count.load(), 3);
+}
+
+TEST(TerrainElevationPoolTest, DropsBuildsNoLongerRequested) {
+    FakeElevationProvider provider;
+    TerrainElevationPool pool(5, 8, true, 1);
+
+    pool.Update({TileCoordinates(0, 0, 1)}, provider, 8, -500.0f, 9000.0f);
+    while (provider.batch_count.load() < 1) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));  // Build handed back
+
+    // The view moved on before the build was uploaded
+    EXPECT_EQ(pool.Update({TileCoordinates(1, 1, 1)}, provider, 8, -500.0f, 9000.0f), 0u);
+    EXPECT_EQ(pool.GetLayer(TileCoordinates(0, 0, 1)), -1);
+    EXPECT_EQ(pool.GetPendingBuilds(), 1u);  // Only (1, 1, 1)
+
+    pool.Clear();
+    EXPECT_EQ(pool.GetPendingBuilds(), 0u);
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/terrain_patch.h>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+
+namespace earth_map::tests {
+
+namespace {
+
+/// Twice the signed area in the (u, -v) plane: positive = counter-clockwise seen from above
+float SignedArea(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+    const glm::vec2 ab(b.x - a.x, -(b.y - a.y));
+    const glm::vec2 ac(c.x - a.x, -(c.y - a.y));
+    return ab.x * ac.y - ab.y * ac.x;
+}
+
+} // namespace
+
+TEST(TerrainPatchTest, GridAndSkirtCounts) {
+    const TerrainPatchGeometry patch = TerrainPatch::Generate(4);
+    EXPECT_EQ(patch.grid_vertex_count, 25u);
+    EXPECT_EQ(patch.vertices.size(), 25u + 16u);  // One skirt twin per border vertex
+    EXPECT_EQ(patch.indices.size(), 6u * 16u + 6u * 16u);
+
+    for (const std::uint32_t index : patch.indices) {
+        EXPECT_LT(index, patch.vertices.size());
+    }
+
+    // Corners are exact so the pole rows and tile edges line up
+    EXPECT_EQ(patch.vertices[0], glm::vec3(0.0f, 0.0f, 0.0f));
+    EXPECT_EQ(patch.vertices[24], glm::vec3(1.0f, 1.0f, 0.0f));
+    const TerrainPatchGeometry odd = TerrainPatch::Generate(30);
+    EXPECT_EQ(odd.vertices[odd.grid_vertex_count - 1], glm::vec3(1.0f, 1.0f, 0.0f));
+
+    // Resolution 0 is raised to a single quad
+    EXPECT_EQ(TerrainPatch::Generate(0).grid_vertex_count, 4u);
+}
+
+TEST(TerrainPatchTest, GridTrianglesAreCounterClockwise) {
+    const TerrainPatchGeometry patch = TerrainPatch::Generate(3);
+    const std::size_t grid_indices = 6u * 3u * 3u;
+    for (std::size_t i = 0; i < grid_indices; i += 3) {
+        EXPECT_GT(SignedArea(patch.vertices[patch.indices[i]],
+                             patch.vertices[patch.indices[i + 1]],
+                             patch.vertices[patch.indices[i + 2]]), 0.0f);
+    }
+}
+
+TEST(TerrainPatchTest, SkirtsFaceAwayFromTheTile) {
+    const TerrainPatchGeometry patch = TerrainPatch::Generate(3);
+    const std::size_t grid_indices = 6u * 3u * 3u;
+
+    // Skirt twins sit on the border, below their grid vertex
+    for (std::size_t i = patch.grid_vertex_count; i < patch.vertices.size(); ++i) {
+        const glm::vec3& skirt = patch.vertices[i];
+        EXPECT_EQ(skirt.z, 1.0f);
+        EXPECT_TRUE(skirt.x == 0.0f || skirt.x == 1.0f || skirt.y == 0.0f || skirt.y == 1.0f);
+    }
+
+    // Each wall triangle, lifted to 3D (u east, -v north, skirt down), has
+    // its normal pointing out of the tile
+    for (std::size_t i = grid_indices; i < patch.indices.size(); i += 3) {
+        glm::vec3 corners[3];
+        for (int k = 0; k < 3; ++k) {
+            const glm::vec3& v = patch.vertices[patch.indices[i + k]];
+            corners[k] = glm::vec3(v.x, -v.y, -v.z);
+        }
+        const glm::vec3 normal = glm::cross(corners[1] - corners[0], corners[2] - corners[0]);
+        const glm::vec3 center = (corners[0] + corners[1] + corners[2]) / 3.0f;
+        const glm::vec2 outward(center.x - 0.5f, center.y + 0.5f);
+        EXPECT_GT(normal.x * outward.x + normal.y * outward.y, 0.0f);
+        EXPECT_NEAR(normal.z, 0.0f, 1e-6f);
+    }
+}
+
+TEST(TerrainPatchTest, EveryBorderEdgeHasOneWall) {
+    const TerrainPatchGeometry patch = TerrainPatch::Generate(2);
+    const std::size_t grid_indices = 6u * 2u * 2u;
+
+    // Count the grid-to-grid edges of wall triangles: one per border segment
+    std::map<std::pair<std::uint32_t, std::uint32_t>, int> edges;
+    for (std::size_t i = grid_indices; i < patch.indices.size(); i += 3) {
+        for (int k = 0; k < 3; ++k) {
+            const std::uint32_t a = patch.indices[i + k];
+            const std::uint32_t b = patch.indices[i + (k + 1) % 3];
+            if (a < patch.grid_vertex_count && b < patch.grid_vertex_count) {
+                ++edges[{std::min(a, b), std::max(a, b)}];
+            }
+        }
+    }
+    EXPECT_EQ(edges.size(), 8u);
+    for (const auto& [edge, count] : edges) {
+        EXPECT_EQ(count, 1);
+    }
+}
+
+TEST(TerrainPatchTest, CoarseLevelsShareVerticesAndCorners) {
+    const TerrainPatchGeometry patch = TerrainPatch::Generate(4, 4);
+
+    // Steps 1, 2 and 4; step 8 would exceed the resolution
+    ASSERT_EQ(patch.lods.size(), 3u);
+    EXPECT_EQ(patch.vertices.size(), 25u + 16u);
+    std::uint32_t next_index = 0;
+    for (std::size_t level = 0; level < patch.lods.size(); ++level) {
+        const TerrainPatchLod& lod = patch.lods[level];
+        const std::uint32_t quads = 4 / lod.step;
+        EXPECT_EQ(lod.step, 1u << level);
+        EXPECT_EQ(lod.first_index, next_index);
+        EXPECT_EQ(lod.index_count, 6u * quads * quads + 6u * 4u * quads);
+        next_index += lod.index_count;
+
+        // Coarse levels only use grid vertices on their own lattice
+        for (std::uint32_t i = lod.first_index; i < lod.first_index + lod.index_count; ++i) {
+            const glm::vec3& vertex = patch.vertices[patch.indices[i]];
+            EXPECT_EQ(std::fmod(vertex.x * 4.0f, static_cast<float>(lod.step)), 0.0f);
+            EXPECT_EQ(std::fmod(vertex.y * 4.0f, static_cast<float>(lod.step)), 0.0f);
+        }
+    }
+    EXPECT_EQ(next_index, patch.indices.size());
+
+    // The coarsest level of a 4x4 grid is one quad with four walls
+    EXPECT_EQ(patch.lods.back().index_count, 6u + 24u);
+
+    // Levels stop where the resolution is no longer divisible
+    EXPECT_EQ(TerrainPatch::Generate(6, 4).lods.size(), 2u);
+    EXPECT_EQ(TerrainPatch::Generate(4).lods.size(), 1u);
+}
+
+TEST(TerrainPatchTest, ElevationWindowUsesAncestor) {
+    // Same zoom: the whole tile
+    TerrainElevationWindow window = TerrainPatch::GetElevationWindow(TileCoordinates(5, 9, 4), 4);
+    EXPECT_EQ(window.source, TileCoordinates(5, 9, 4));
+    EXPECT_EQ(window.offset, glm::vec2(0.0f));
+    EXPECT_EQ(window.scale, 1.0f);
+
+    // Two levels up: a quarter of the ancestor, at the tile's position in it
+    window = TerrainPatch::GetElevationWindow(TileCoordinates(7, 10, 6), 4);
+    EXPECT_EQ(window.source, TileCoordinates(1, 2, 4));
+    EXPECT_EQ(window.scale, 0.25f);
+    EXPECT_EQ(window.offset, glm::vec2(0.75f, 0.5f));
+
+    // Source zooms beyond the range are clamped
+    EXPECT_EQ(TerrainPatch::GetElevationWindow(TileCoordinates(3, 1, 2), 9).source,
+              TileCoordinates(3, 1, 2));
+    window = TerrainPatch::GetElevationWindow(TileCoordinates(3, 1, 2), -1);
+    EXPECT_EQ(window.source, TileCoordinates(0, 0, 0));
+    EXPECT_EQ(window.offset, glm::vec2(0.75f, 0.25f));
+}
+
+} // namespace earth_map::tests
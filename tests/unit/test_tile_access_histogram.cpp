@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/tile_access_histogram.h>
+#include <earth_map/data/tile_cache.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+
+namespace earth_map::tests {
+
+class TileAccessHistogramTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() /
+                     (std::string("earth_map_histogram_") +
+                      ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    TileData MakeTile(int32_t x, int32_t y, int32_t zoom, std::size_t size) const {
+        TileData tile;
+        tile.metadata.coordinates = TileCoordinates(x, y, zoom);
+        tile.metadata.file_size = size;
+        tile.metadata.last_modified = std::chrono::system_clock::now();
+        tile.data = std::vector<std::uint8_t>(size, static_cast<std::uint8_t>(x));
+        tile.loaded = true;
+        return tile;
+    }
+
+    std::filesystem::path directory_;
+};
+
+TEST_F(TileAccessHistogramTest, FirstLoadStartsEmpty) {
+    TileAccessHistogram histogram(directory_.string());
+    EXPECT_FALSE(histogram.Load());
+    EXPECT_EQ(histogram.GetCount(), 0u);
+    EXPECT_TRUE(histogram.GetHottest(10).empty());
+}
+
+TEST_F(TileAccessHistogramTest, RanksBySessionHits) {
+    TileAccessHistogram histogram(directory_.string());
+    for (int i = 0; i < 3; ++i) {
+        histogram.Record(TileCoordinates(1, 1, 5));
+    }
+    histogram.Record(TileCoordinates(2, 2, 5));
+    for (int i = 0; i < 5; ++i) {
+        histogram.Record(TileCoordinates(3, 3, 5));
+    }
+
+    const auto hottest = histogram.GetHottest(2);
+    ASSERT_EQ(hottest.size(), 2u);
+    EXPECT_EQ(hottest[0], TileCoordinates(3, 3, 5));
+    EXPECT_EQ(hottest[1], TileCoordinates(1, 1, 5));
+    EXPECT_FLOAT_EQ(histogram.GetScore(TileCoordinates(2, 2, 5)), 1.0f);
+}
+
+TEST_F(TileAccessHistogramTest, ScoresDecayOncePerSession) {
+    {
+        TileAccessHistogram histogram(directory_.string(), 0.5f);
+        histogram.Load();
+        for (int i = 0; i < 4; ++i) {
+            histogram.Record(TileCoordinates(1, 1, 5));
+        }
+        // Saving twice must not decay twice
+        EXPECT_TRUE(histogram.Save());
+        EXPECT_TRUE(histogram.Save());
+    }
+    {
+        TileAccessHistogram histogram(directory_.string(), 0.5f);
+        EXPECT_TRUE(histogram.Load());
+        EXPECT_FLOAT_EQ(histogram.GetScore(TileCoordinates(1, 1, 5)), 4.0f);
+        histogram.Save();
+    }
+    TileAccessHistogram histogram(directory_.string(), 0.5f);
+    EXPECT_TRUE(histogram.Load());
+    EXPECT_FLOAT_EQ(histogram.GetScore(TileCoordinates(1, 1, 5)), 2.0f);
+}
+
+TEST_F(TileAccessHistogramTest, ForgetsTilesUnusedForManySessions) {
+    {
+        TileAccessHistogram histogram(directory_.string(), 0.5f);
+        histogram.Record(TileCoordinates(1, 1, 5));
+        histogram.Save();
+    }
+    // 1 → 0.5 → 0.25 → 0.125 → 0.0625 → dropped below kMinScore
+    for (int session = 0; session < 5; ++session) {
+        TileAccessHistogram histogram(directory_.string(), 0.5f);
+        histogram.Load();
+        histogram.Save();
+    }
+    TileAccessHistogram histogram(directory_.string(), 0.5f);
+    histogram.Load();
+    EXPECT_EQ(histogram.GetCount(), 0u);
+}
+
+TEST_F(TileAccessHistogramTest, SaveKeepsOnlyTheHottestTiles) {
+    {
+        TileAccessHistogram histogram(directory_.string(), 0.7f, 2);
+        for (int x = 0; x < 5; ++x) {
+            for (int i = 0; i <= x; ++i) {
+                histogram.Record(TileCoordinates(x, 0, 4));
+            }
+        }
+        histogram.Save();
+    }
+    TileAccessHistogram histogram(directory_.string(), 0.7f, 2);
+    histogram.Load();
+    const auto hottest = histogram.GetHottest(10);
+    ASSERT_EQ(hottest.size(), 2u);
+    EXPECT_EQ(hottest[0], TileCoordinates(4, 0, 4));
+    EXPECT_EQ(hottest[1], TileCoordinates(3, 0, 4));
+}
+
+TEST_F(TileAccessHistogramTest, CorruptFileIsIgnored) {
+    {
+        std::ofstream file(directory_ / "access_histogram.bin", std::ios::binary);
+        file << "not a histogram at all";
+    }
+    TileAccessHistogram histogram(directory_.string());
+    EXPECT_FALSE(histogram.Load());
+    EXPECT_EQ(histogram.GetCount(), 0u);
+}
+
+TEST_F(TileAccessHistogramTest, CacheWarmsUpHottestTilesOfLastSession) {
+    TileCacheConfig config;
+    config.disk_cache_directory = directory_.string();
+    config.enable_background_cleanup = false;
+    config.enable_write_behind = false;
+    config.warmup_max_tiles = 2;
+
+    {
+        auto cache = CreateTileCache(config);
+        ASSERT_TRUE(cache->Initialize(config));
+        for (int x = 0; x < 4; ++x) {
+            ASSERT_TRUE(cache->Put(MakeTile(x, 0, 6, 1024)));
+        }
+        // Tile 2 is used most, then tile 0
+        for (int i = 0; i < 3; ++i) {
+            cache->Get(TileCoordinates(2, 0, 6));
+        }
+        cache->Get(TileCoordinates(0, 0, 6));
+    }
+
+    auto cache = CreateTileCache(config);
+    ASSERT_TRUE(cache->Initialize(config));
+    const auto hottest = cache->GetHottestTiles(10);
+    ASSERT_EQ(hottest.size(), 2u);
+    EXPECT_EQ(hottest[0], TileCoordinates(2, 0, 6));
+
+    // Promoted into memory by the background warm-up
+    for (int attempt = 0; attempt < 100 && cache->GetStatistics().warmup_tiles < 2; ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    const TileCacheStats stats = cache->GetStatistics();
+    EXPECT_EQ(stats.warmup_tiles, 2u);
+    EXPECT_EQ(stats.memory_cache_count, 2u);
+    cache->Get(TileCoordinates(2, 0, 6));
+    EXPECT_EQ(cache->GetStatistics().memory_cache_hits, 1u);
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/texture_atlas/tile_block_compressor.h>
+#include <array>
+#include <cstdlib>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+std::array<std::uint8_t, 64> DecodeBlockAt(const std::vector<std::uint8_t>& blocks,
+                                           std::size_t index) {
+    std::array<std::uint8_t, 64> rgba{};
+    TileBlockCompressor::DecodeBC1Block(
+        blocks.data() + index * TileBlockCompressor::kBC1BlockBytes, rgba.data());
+    return rgba;
+}
+
+} // namespace
+
+TEST(TileBlockCompressorTest, EncodedSizes) {
+    EXPECT_EQ(TileBlockCompressor::GetEncodedSize(TileTextureFormat::RGBA8, 256, 256),
+              256u * 256u * 4u);
+    EXPECT_EQ(TileBlockCompressor::GetEncodedSize(TileTextureFormat::BC1, 256, 256),
+              256u * 256u / 2u);
+    EXPECT_EQ(TileBlockCompressor::GetEncodedSize(TileTextureFormat::BC1, 6, 8), 0u);
+}
+
+TEST(TileBlockCompressorTest, SolidBlockRoundTripsExactly) {
+    // 5:6:5-representable color
+    std::array<std::uint8_t, 64> rgba{};
+    for (std::size_t i = 0; i < 16; ++i) {
+        rgba[i * 4 + 0] = 255;
+        rgba[i * 4 + 1] = 130;
+        rgba[i * 4 + 2] = 0;
+        rgba[i * 4 + 3] = 255;
+    }
+
+    std::array<std::uint8_t, 8> block{};
+    TileBlockCompressor::EncodeBC1Block(rgba.data(), block.data());
+    std::array<std::uint8_t, 64> decoded{};
+    TileBlockCompressor::DecodeBC1Block(block.data(), decoded.data());
+    EXPECT_EQ(decoded, rgba);
+}
+
+TEST(TileBlockCompressorTest, TwoColorBlockKeepsBothColors) {
+    std::array<std::uint8_t, 64> rgba{};
+    for (std::size_t i = 0; i < 16; ++i) {
+        const bool land = (i % 4) < 2;
+        rgba[i * 4 + 0] = land ? 200 : 30;
+        rgba[i * 4 + 1] = land ? 180 : 60;
+        rgba[i * 4 + 2] = land ? 120 : 160;
+        rgba[i * 4 + 3] = 255;
+    }
+
+    std::array<std::uint8_t, 8> block{};
+    TileBlockCompressor::EncodeBC1Block(rgba.data(), block.data());
+    std::array<std::uint8_t, 64> decoded{};
+    TileBlockCompressor::DecodeBC1Block(block.data(), decoded.data());
+    for (std::size_t i = 0; i < 64; ++i) {
+        EXPECT_LE(std::abs(decoded[i] - rgba[i]), 24) << "byte " << i;
+    }
+}
+
+TEST(TileBlockCompressorTest, CompressesInPlaceLikeOutOfPlace) {
+    constexpr std::uint32_t kSize = 16;
+    std::vector<std::uint8_t> pixels(kSize * kSize * 4);
+    for (std::uint32_t y = 0; y < kSize; ++y) {
+        for (std::uint32_t x = 0; x < kSize; ++x) {
+            std::uint8_t* p = &pixels[(y * kSize + x) * 4];
+            const std::uint32_t t = x + y;
+            p[0] = static_cast<std::uint8_t>(t * 8);
+            p[1] = static_cast<std::uint8_t>(40 + t * 4);
+            p[2] = static_cast<std::uint8_t>(255 - t * 8);
+            p[3] = 255;
+        }
+    }
+
+    const std::size_t size = TileBlockCompressor::GetEncodedSize(TileTextureFormat::BC1, kSize, kSize);
+    std::vector<std::uint8_t> separate(size);
+    ASSERT_TRUE(TileBlockCompressor::CompressBC1(pixels.data(), kSize, kSize, 4,
+                                                 separate.data(), separate.size()));
+
+    std::vector<std::uint8_t> in_place = pixels;
+    ASSERT_TRUE(TileBlockCompressor::CompressBC1(in_place.data(), kSize, kSize, 4,
+                                                 in_place.data(), in_place.size()));
+    in_place.resize(size);
+    EXPECT_EQ(in_place, separate);
+
+    // A ramp along one color direction decodes close to the source
+    const auto first = DecodeBlockAt(separate, 0);
+    for (std::uint32_t y = 0; y < 4; ++y) {
+        for (std::uint32_t x = 0; x < 4; ++x) {
+            for (std::uint32_t ch = 0; ch < 3; ++ch) {
+                EXPECT_LE(std::abs(first[(y * 4 + x) * 4 + ch] -
+                                   pixels[(y * kSize + x) * 4 + ch]), 12);
+            }
+        }
+    }
+}
+
+TEST(TileBlockCompressorTest, RejectsUnsupportedInput) {
+    std::vector<std::uint8_t> pixels(8 * 8 * 4);
+    std::vector<std::uint8_t> out(8 * 8 / 2);
+    EXPECT_FALSE(TileBlockCompressor::CompressBC1(pixels.data(), 8, 8, 1, out.data(), out.size()));
+    EXPECT_FALSE(TileBlockCompressor::CompressBC1(pixels.data(), 8, 6, 4, out.data(), out.size()));
+    EXPECT_FALSE(TileBlockCompressor::CompressBC1(pixels.data(), 8, 8, 4, out.data(), out.size() - 1));
+}
+
+} // namespace earth_map::tests
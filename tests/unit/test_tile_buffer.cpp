@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/tile_buffer.h>
+#include <earth_map/data/tile_cache.h>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+namespace earth_map::tests {
+
+TEST(TileBufferTest, TakesOwnershipWithoutCopying) {
+    std::vector<std::uint8_t> bytes(1024, 0x11);
+    const std::uint8_t* original = bytes.data();
+
+    TileBuffer buffer(std::move(bytes));
+    EXPECT_EQ(buffer.data(), original);
+    EXPECT_EQ(buffer.size(), 1024u);
+    EXPECT_EQ(buffer.UseCount(), 1);
+
+    // Copies share the storage
+    TileBuffer copy = buffer;
+    EXPECT_TRUE(copy.SharesStorageWith(buffer));
+    EXPECT_EQ(buffer.UseCount(), 2);
+}
+
+TEST(TileBufferTest, ExplicitCopyAllocatesNewStorage) {
+    const std::vector<std::uint8_t> bytes = {1, 2, 3};
+    TileBuffer buffer(bytes);
+    EXPECT_NE(buffer.data(), bytes.data());
+    EXPECT_EQ(buffer.ToVector(), bytes);
+
+    const TileBuffer copied = TileBuffer::CopyOf(buffer.Span());
+    EXPECT_FALSE(copied.SharesStorageWith(buffer));
+    EXPECT_EQ(copied, buffer);
+}
+
+TEST(TileBufferTest, WrapKeepsOwnerAlive) {
+    auto owner = std::make_shared<std::vector<std::uint8_t>>(std::vector<std::uint8_t>{9, 8, 7, 6});
+    std::weak_ptr<std::vector<std::uint8_t>> watch = owner;
+
+    TileBuffer view = TileBuffer::Wrap(owner, std::span<const std::uint8_t>(*owner).subspan(1, 2));
+    owner.reset();
+    ASSERT_FALSE(watch.expired());
+    EXPECT_EQ(view.size(), 2u);
+    EXPECT_EQ(view[0], 8);
+    EXPECT_EQ(view[1], 7);
+
+    view = TileBuffer();
+    EXPECT_TRUE(watch.expired());
+}
+
+TEST(TileBufferTest, SliceSharesStorageAndClamps) {
+    const TileBuffer buffer = {0, 1, 2, 3, 4, 5};
+
+    const TileBuffer slice = buffer.Slice(2, 3);
+    EXPECT_EQ(slice, TileBuffer({2, 3, 4}));
+    EXPECT_EQ(slice.data(), buffer.data() + 2);
+    EXPECT_EQ(buffer.UseCount(), 2);
+
+    EXPECT_EQ(buffer.Slice(4, 100).size(), 2u);
+    EXPECT_TRUE(buffer.Slice(6, 1).empty());
+}
+
+TEST(TileBufferTest, EmptyBuffersCompareEqual) {
+    EXPECT_EQ(TileBuffer(), TileBuffer(std::vector<std::uint8_t>{}));
+    EXPECT_NE(TileBuffer({1}), TileBuffer());
+    EXPECT_NE(TileBuffer({1, 2}), TileBuffer({1, 3}));
+    EXPECT_EQ(TileBuffer().UseCount(), 0);
+}
+
+TEST(TileBufferTest, MemoryCacheSharesBytesWithCaller) {
+    const auto directory = std::filesystem::temp_directory_path() / "earth_map_tile_buffer";
+    std::filesystem::remove_all(directory);
+    TileCacheConfig config;
+    config.disk_cache_directory = directory.string();
+    auto cache = CreateTileCache(config);
+    ASSERT_TRUE(cache->Initialize(config));
+
+    TileData tile;
+    tile.metadata.coordinates = TileCoordinates(1, 2, 3);
+    tile.metadata.file_size = 4096;
+    tile.data = std::vector<std::uint8_t>(4096, 0x42);
+    tile.loaded = true;
+    ASSERT_TRUE(cache->Put(tile));
+
+    auto cached = cache->Get(tile.metadata.coordinates);
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_TRUE(cached->data.SharesStorageWith(tile.data));
+
+    cache.reset();
+    std::filesystem::remove_all(directory);
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/texture_atlas/tile_buffer_pool.h>
+#include <thread>
+#include <vector>
+
+namespace earth_map::tests {
+
+TEST(TileBufferPoolTest, SizeClassesArePowersOfTwo) {
+    EXPECT_EQ(TileBufferPool::SizeClassFor(0), 0u);
+    EXPECT_EQ(TileBufferPool::SizeClassFor(TileBufferPool::kMinSizeClass), 0u);
+    EXPECT_EQ(TileBufferPool::SizeClassFor(TileBufferPool::kMinSizeClass + 1), 1u);
+    EXPECT_EQ(TileBufferPool::SizeClassFor(256 * 256 * 4), 6u);
+    EXPECT_EQ(TileBufferPool::SizeClassCapacity(6), 256u * 256u * 4u);
+    EXPECT_EQ(TileBufferPool::SizeClassFor(std::size_t{1} << 40),
+              TileBufferPool::kSizeClassCount);
+}
+
+TEST(TileBufferPoolTest, AcquireRoundsCapacityUpToClass) {
+    TileBufferPool pool;
+
+    const std::vector<std::uint8_t> buffer = pool.AcquireBuffer(5000);
+
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_GE(buffer.capacity(), TileBufferPool::SizeClassCapacity(1));
+}
+
+TEST(TileBufferPoolTest, ReleasedBufferIsReused) {
+    TileBufferPool pool;
+
+    std::vector<std::uint8_t> buffer = pool.AcquireBuffer(256 * 256 * 4);
+    buffer.resize(1000, 7);
+    const std::uint8_t* data = buffer.data();
+    pool.ReleaseBuffer(std::move(buffer));
+
+    EXPECT_EQ(pool.GetStats().pooled_buffers, 1u);
+
+    // Any size of the same class gets the same allocation back, emptied
+    const std::vector<std::uint8_t> reused = pool.AcquireBuffer(200 * 256 * 4);
+    EXPECT_EQ(reused.data(), data);
+    EXPECT_TRUE(reused.empty());
+
+    const TileBufferPoolStats stats = pool.GetStats();
+    EXPECT_EQ(stats.buffer_hits, 1u);
+    EXPECT_EQ(stats.buffer_misses, 1u);
+    EXPECT_EQ(stats.pooled_buffers, 0u);
+    EXPECT_EQ(stats.pooled_bytes, 0u);
+}
+
+TEST(TileBufferPoolTest, SmallerClassDoesNotServeLargerRequest) {
+    TileBufferPool pool;
+
+    pool.ReleaseBuffer(pool.AcquireBuffer(8192));
+    const std::vector<std::uint8_t> buffer = pool.AcquireBuffer(65536);
+
+    EXPECT_GE(buffer.capacity(), 65536u);
+    EXPECT_EQ(pool.GetStats().buffer_hits, 0u);
+    EXPECT_EQ(pool.GetStats().pooled_buffers, 1u);
+}
+
+TEST(TileBufferPoolTest, DropsTinyBuffersAndRespectsClassCap) {
+    TileBufferPool pool(2, 4);
+
+    std::vector<std::uint8_t> tiny(16);
+    pool.ReleaseBuffer(std::move(tiny));
+    EXPECT_EQ(pool.GetStats().pooled_buffers, 0u);
+
+    for (int i = 0; i < 5; ++i) {
+        pool.ReleaseBuffer(std::vector<std::uint8_t>(8192));
+    }
+    const TileBufferPoolStats stats = pool.GetStats();
+    EXPECT_EQ(stats.pooled_buffers, 2u);
+    EXPECT_EQ(stats.pooled_bytes, 2u * 8192u);
+}
+
+TEST(TileBufferPoolTest, ReleasedCommandIsResetAndReused) {
+    TileBufferPool pool;
+
+    auto cmd = pool.AcquireCommand(TileCoordinates(1, 2, 3));
+    EXPECT_EQ(cmd->coords, TileCoordinates(1, 2, 3));
+    cmd->slot.index = 5;
+    cmd->width = 256;
+    cmd->mip_levels = 9;
+    auto trace = std::make_shared<TileLoadTrace>(TileCoordinates(1, 2, 3));
+    cmd->trace = trace;
+    GLUploadCommand* raw = cmd.get();
+
+    pool.ReleaseCommand(std::move(cmd));
+    // Pooled commands keep nothing alive
+    EXPECT_EQ(trace.use_count(), 1);
+
+    auto reused = pool.AcquireCommand(TileCoordinates(4, 5, 6));
+    EXPECT_EQ(reused.get(), raw);
+    EXPECT_EQ(reused->coords, TileCoordinates(4, 5, 6));
+    EXPECT_FALSE(reused->slot.IsValid());
+    EXPECT_EQ(reused->width, 0u);
+    EXPECT_EQ(reused->mip_levels, 1u);
+    EXPECT_EQ(reused->trace, nullptr);
+
+    const TileBufferPoolStats stats = pool.GetStats();
+    EXPECT_EQ(stats.command_hits, 1u);
+    EXPECT_EQ(stats.command_misses, 1u);
+}
+
+TEST(TileBufferPoolTest, CommandListIsCapped) {
+    TileBufferPool pool(1, 2);
+
+    for (int i = 0; i < 4; ++i) {
+        pool.ReleaseCommand(std::make_unique<GLUploadCommand>());
+    }
+    EXPECT_EQ(pool.GetStats().pooled_commands, 2u);
+
+    pool.Clear();
+    EXPECT_EQ(pool.GetStats().pooled_commands, 0u);
+}
+
+TEST(TileBufferPoolTest, ConcurrentAcquireRelease) {
+    TileBufferPool pool;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&pool, t] {
+            for (int i = 0; i < 500; ++i) {
+                auto cmd = pool.AcquireCommand(TileCoordinates(i, t, 10));
+                std::vector<std::uint8_t> buffer = pool.AcquireBuffer(64 * 1024);
+                buffer.resize(64 * 1024);
+                pool.ReleaseBuffer(std::move(buffer));
+                pool.ReleaseCommand(std::move(cmd));
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const TileBufferPoolStats stats = pool.GetStats();
+    EXPECT_EQ(stats.buffer_hits + stats.buffer_misses, 2000u);
+    EXPECT_EQ(stats.command_hits + stats.command_misses, 2000u);
+    EXPECT_LE(stats.command_misses, 4u);
+}
+
+} // namespace earth_map::tests
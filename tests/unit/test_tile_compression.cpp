@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/tile_compression.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+/// Repetitive, vector-tile-like payload that compresses well
+std::vector<std::uint8_t> CompressibleBytes(std::size_t size, std::uint8_t seed = 0) {
+    std::vector<std::uint8_t> bytes(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        bytes[i] = static_cast<std::uint8_t>((i % 17) + seed);
+    }
+    return bytes;
+}
+
+TileData MakeTile(int32_t x, int32_t y, int32_t zoom, std::vector<std::uint8_t> data) {
+    TileData tile;
+    tile.metadata.coordinates = TileCoordinates(x, y, zoom);
+    tile.metadata.file_size = data.size();
+    tile.metadata.last_modified = std::chrono::system_clock::now();
+    tile.data = std::move(data);
+    tile.loaded = true;
+    return tile;
+}
+
+} // namespace
+
+class TileCompressionCodecTest
+    : public ::testing::TestWithParam<TileMetadata::Compression> {};
+
+TEST_P(TileCompressionCodecTest, RoundTrips) {
+    const auto type = GetParam();
+    if (!IsCompressionAvailable(type)) {
+        EXPECT_FALSE(CompressTileData(CompressibleBytes(16), type).has_value());
+        GTEST_SKIP() << "codec not built in";
+    }
+
+    const auto raw = CompressibleBytes(64 * 1024);
+    auto compressed = CompressTileData(raw, type);
+    ASSERT_TRUE(compressed.has_value());
+    if (type != TileMetadata::Compression::NONE) {
+        EXPECT_LT(compressed->size(), raw.size() / 4);
+    }
+
+    auto restored = DecompressTileData(*compressed, type);
+    ASSERT_TRUE(restored.has_value());
+    EXPECT_EQ(*restored, raw);
+
+    // Truncated input is rejected rather than returning garbage
+    if (type != TileMetadata::Compression::NONE) {
+        compressed->resize(compressed->size() / 2);
+        EXPECT_FALSE(DecompressTileData(*compressed, type).has_value());
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Codecs, TileCompressionCodecTest,
+    ::testing::Values(TileMetadata::Compression::NONE, TileMetadata::Compression::GZIP,
+                      TileMetadata::Compression::DEFLATE, TileMetadata::Compression::LZ4,
+                      TileMetadata::Compression::ZSTD));
+
+TEST(TileCompressionTest, ZstdDictionaryRoundTrip) {
+    if (!IsCompressionAvailable(TileMetadata::Compression::ZSTD)) {
+        EXPECT_EQ(ZstdDictionary::Train({CompressibleBytes(100)}), nullptr);
+        GTEST_SKIP() << "zstd not built in";
+    }
+
+    std::vector<std::vector<std::uint8_t>> samples;
+    for (int i = 0; i < 200; ++i) {
+        std::string text = "{\"type\":\"Feature\",\"id\":" + std::to_string(i) +
+                           ",\"properties\":{\"class\":\"road\",\"name\":\"Street " +
+                           std::to_string(i * 7) + "\"}}";
+        samples.emplace_back(text.begin(), text.end());
+    }
+    auto dictionary = ZstdDictionary::Train(samples, 4096);
+    ASSERT_NE(dictionary, nullptr);
+    EXPECT_NE(dictionary->GetId(), 0u);
+
+    const auto& sample = samples[42];
+    auto with_dict = CompressTileData(sample, TileMetadata::Compression::ZSTD, 0, dictionary.get());
+    auto without = CompressTileData(sample, TileMetadata::Compression::ZSTD);
+    ASSERT_TRUE(with_dict && without);
+    EXPECT_LT(with_dict->size(), without->size());
+
+    auto restored = DecompressTileData(*with_dict, TileMetadata::Compression::ZSTD,
+                                       dictionary.get());
+    ASSERT_TRUE(restored.has_value());
+    EXPECT_EQ(*restored, sample);
+
+    // Dictionary frames cannot be read without the dictionary
+    EXPECT_FALSE(DecompressTileData(*with_dict, TileMetadata::Compression::ZSTD).has_value());
+
+    auto reloaded = ZstdDictionary::FromBytes(dictionary->GetBytes());
+    ASSERT_NE(reloaded, nullptr);
+    EXPECT_EQ(reloaded->GetId(), dictionary->GetId());
+}
+
+class TileCacheCompressionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() /
+                     (std::string("earth_map_compression_") +
+                      ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(directory_);
+        config_.disk_cache_directory = directory_.string();
+        config_.enable_write_behind = false;
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    std::filesystem::path directory_;
+    TileCacheConfig config_;
+};
+
+TEST_F(TileCacheCompressionTest, MemoryTierReturnsRawBytes) {
+    config_.memory_compression = TileMetadata::Compression::LZ4;
+    auto cache = CreateTileCache(config_);
+    ASSERT_TRUE(cache->Initialize(config_));
+
+    const auto raw = CompressibleBytes(32 * 1024);
+    ASSERT_TRUE(cache->Put(MakeTile(1, 2, 3, raw)));
+
+    auto tile = cache->Get(TileCoordinates(1, 2, 3));
+    ASSERT_TRUE(tile.has_value());
+    EXPECT_EQ(tile->data, raw);
+    EXPECT_FALSE(tile->is_compressed);
+
+    const TileCacheStats stats = cache->GetStatistics();
+    if (IsCompressionAvailable(TileMetadata::Compression::LZ4)) {
+        EXPECT_GT(stats.memory_compression_ratio, 4.0f);
+        EXPECT_LT(stats.memory_cache_size, raw.size() / 4);
+    } else {
+        EXPECT_FLOAT_EQ(stats.memory_compression_ratio, 1.0f);
+    }
+}
+
+TEST_F(TileCacheCompressionTest, DiskTierRoundTripsAcrossRestart) {
+    config_.default_compression = TileMetadata::Compression::ZSTD;
+    const auto raw = CompressibleBytes(32 * 1024, 3);
+    {
+        auto cache = CreateTileCache(config_);
+        ASSERT_TRUE(cache->Initialize(config_));
+        ASSERT_TRUE(cache->Put(MakeTile(5, 6, 7, raw)));
+        if (IsCompressionAvailable(TileMetadata::Compression::ZSTD)) {
+            EXPECT_GT(cache->GetStatistics().disk_compression_ratio, 4.0f);
+            EXPECT_LT(std::filesystem::file_size(directory_ / "7" / "5_6.tile"), raw.size() / 4);
+        }
+    }
+
+    auto cache = CreateTileCache(config_);
+    ASSERT_TRUE(cache->Initialize(config_));
+    auto tile = cache->Get(TileCoordinates(5, 6, 7));
+    ASSERT_TRUE(tile.has_value());
+    EXPECT_EQ(tile->data, raw);
+    EXPECT_EQ(cache->GetStatistics().total_corruptions, 0u);
+}
+
+TEST_F(TileCacheCompressionTest, UndecodableTileIsAMissNotAnEmptyTile) {
+    auto cache = CreateTileCache(config_);
+    ASSERT_TRUE(cache->Initialize(config_));
+
+    // Claims to be LZ4 but is not: kept as is in memory, refused by the disk tier
+    TileData tile = MakeTile(3, 3, 3, std::vector<std::uint8_t>(64, 0xFF));
+    tile.is_compressed = true;
+    tile.metadata.compression = TileMetadata::Compression::LZ4;
+    cache->Put(tile);
+
+    EXPECT_FALSE(cache->Get(TileCoordinates(3, 3, 3)).has_value());
+    EXPECT_GE(cache->GetStatistics().total_corruptions, 1u);
+    EXPECT_FALSE(std::filesystem::exists(directory_ / "3" / "3_3.tile"));
+}
+
+TEST_F(TileCacheCompressionTest, IncompressibleTilesAreStoredRaw) {
+    config_.default_compression = TileMetadata::Compression::ZSTD;
+    config_.memory_compression = TileMetadata::Compression::LZ4;
+    auto cache = CreateTileCache(config_);
+    ASSERT_TRUE(cache->Initialize(config_));
+
+    // Pseudo-random bytes, like an already compressed PNG/JPEG payload
+    std::vector<std::uint8_t> noise(8192);
+    std::uint32_t state = 12345;
+    for (auto& byte : noise) {
+        state = state * 1664525u + 1013904223u;
+        byte = static_cast<std::uint8_t>(state >> 24);
+    }
+    ASSERT_TRUE(cache->Put(MakeTile(0, 0, 2, noise)));
+
+    const TileCacheStats stats = cache->GetStatistics();
+    EXPECT_FLOAT_EQ(stats.memory_compression_ratio, 1.0f);
+    EXPECT_FLOAT_EQ(stats.disk_compression_ratio, 1.0f);
+    EXPECT_EQ(std::filesystem::file_size(directory_ / "2" / "0_0.tile"),
+              sizeof(std::uint64_t) + noise.size());
+}
+
+} // namespace earth_map::tests
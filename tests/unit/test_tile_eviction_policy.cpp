@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/tile_pool/tile_eviction_policy.h>
+#include <vector>
+
+namespace earth_map::tests {
+
+TEST(TileEvictionPolicyTest, ScoresNothingBeforeTheFirstUpdate) {
+    TileEvictionPolicy policy;
+    EXPECT_EQ(policy.Score(TileCoordinates(3, 4, 5)), 0.0f);
+    EXPECT_EQ(policy.GetProtectedCount(), 0u);
+}
+
+TEST(TileEvictionPolicyTest, ProtectsAncestorsOfVisibleTiles) {
+    TileEvictionPolicy policy;
+    const std::vector<TileCoordinates> visible = {{100, 200, 10}, {101, 200, 10}};
+    policy.Update(visible, TileCoordinates(100, 200, 10));
+
+    // Both tiles share their ancestors: one per level, four levels up
+    EXPECT_EQ(policy.GetProtectedCount(), 4u);
+    EXPECT_TRUE(policy.IsProtected(TileCoordinates(50, 100, 9)));
+    EXPECT_TRUE(policy.IsProtected(TileCoordinates(6, 12, 6)));
+    EXPECT_FALSE(policy.IsProtected(TileCoordinates(3, 6, 5)));
+    EXPECT_EQ(policy.Score(TileCoordinates(12, 25, 7)), TileEvictionPolicy::kProtected);
+}
+
+TEST(TileEvictionPolicyTest, VisibleTilesOutrankHiddenTiles) {
+    TileEvictionPolicy policy;
+    const std::vector<TileCoordinates> visible = {{0, 0, 4}, {15, 15, 4}};
+    policy.Update(visible, TileCoordinates(0, 0, 4));
+
+    const float far_visible = policy.Score(TileCoordinates(15, 15, 4));
+    const float near_hidden = policy.Score(TileCoordinates(1, 0, 4));
+    EXPECT_GE(far_visible, TileEvictionPolicy::kVisibleScore);
+    EXPECT_LT(near_hidden, TileEvictionPolicy::kVisibleScore);
+    EXPECT_GT(policy.Score(TileCoordinates(0, 0, 4)), far_visible);
+}
+
+TEST(TileEvictionPolicyTest, HiddenTilesScoreByDistanceAndZoom) {
+    TileEvictionPolicy policy;
+    const std::vector<TileCoordinates> visible = {{512, 512, 10}};
+    policy.Update(visible, TileCoordinates(512, 512, 10));
+
+    const float near = policy.Score(TileCoordinates(514, 512, 10));
+    const float far = policy.Score(TileCoordinates(600, 512, 10));
+    EXPECT_GT(near, far);
+
+    // Same place, further from the view's zoom
+    const float finer = policy.Score(TileCoordinates(1028, 1024, 11));
+    const float much_finer = policy.Score(TileCoordinates(8224, 8192, 14));
+    EXPECT_GT(finer, much_finer);
+    EXPECT_GT(far, 0.0f);
+}
+
+TEST(TileEvictionPolicyTest, DistanceWrapsAroundTheAntimeridian) {
+    TileEvictionPolicy policy;
+    const std::vector<TileCoordinates> visible = {{0, 8, 4}};
+    policy.Update(visible, TileCoordinates(0, 8, 4));
+
+    // Column 15 is next to column 0
+    EXPECT_EQ(policy.Score(TileCoordinates(15, 8, 4)), policy.Score(TileCoordinates(1, 8, 4)));
+}
+
+TEST(TileEvictionPolicyTest, CapsProtectedTilesNearestLevelsFirst) {
+    TileEvictionPolicyConfig config;
+    config.max_protected_tiles = 2;
+    TileEvictionPolicy policy(config);
+    const std::vector<TileCoordinates> visible = {{0, 0, 10}, {1023, 1023, 10}};
+    policy.Update(visible, TileCoordinates(0, 0, 10));
+
+    EXPECT_EQ(policy.GetProtectedCount(), 2u);
+    EXPECT_TRUE(policy.IsProtected(TileCoordinates(0, 0, 9)));
+    EXPECT_TRUE(policy.IsProtected(TileCoordinates(511, 511, 9)));
+    EXPECT_FALSE(policy.IsProtected(TileCoordinates(0, 0, 8)));
+}
+
+TEST(TileEvictionPolicyTest, UpdateReplacesThePreviousView) {
+    TileEvictionPolicy policy;
+    const std::vector<TileCoordinates> before = {{8, 8, 4}};
+    policy.Update(before, TileCoordinates(8, 8, 4));
+    EXPECT_TRUE(policy.IsProtected(TileCoordinates(4, 4, 3)));
+
+    const std::vector<TileCoordinates> after = {{0, 0, 4}};
+    policy.Update(after, TileCoordinates(0, 0, 4));
+    EXPECT_FALSE(policy.IsProtected(TileCoordinates(4, 4, 3)));
+    EXPECT_LT(policy.Score(TileCoordinates(8, 8, 4)), TileEvictionPolicy::kVisibleScore);
+}
+
+} // namespace earth_map::tests
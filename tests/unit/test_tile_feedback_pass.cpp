@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/tile_feedback_pass.h>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+void Append(std::vector<std::uint32_t>& texels, const TileCoordinates& tile, int count = 1) {
+    const auto texel = TileFeedbackPass::EncodeTexel(tile);
+    for (int i = 0; i < count; ++i) {
+        texels.push_back(texel[0]);
+        texels.push_back(texel[1]);
+    }
+}
+
+} // namespace
+
+TEST(TileFeedbackPassTest, EncodeDecodeRoundTrip) {
+    const std::vector<TileCoordinates> expected = {
+        TileCoordinates(0, 0, 0),
+        TileCoordinates(5, 3, 3),
+        TileCoordinates((1 << 21) - 1, (1 << 21) - 1, 21),
+    };
+    for (const TileCoordinates& tile : expected) {
+        std::vector<std::uint32_t> texels;
+        Append(texels, tile);
+
+        std::vector<TileCoordinates> decoded;
+        TileFeedbackPass::DecodeTexels(texels, decoded);
+        ASSERT_EQ(decoded.size(), 1u);
+        EXPECT_EQ(decoded.front(), tile);
+    }
+}
+
+TEST(TileFeedbackPassTest, ClearedTexelsAreIgnored) {
+    std::vector<std::uint32_t> texels(64, 0u);
+    Append(texels, TileCoordinates(1, 1, 1));
+
+    std::vector<TileCoordinates> decoded = {TileCoordinates(9, 9, 9)};
+    TileFeedbackPass::DecodeTexels(texels, decoded);
+    ASSERT_EQ(decoded.size(), 1u);
+    EXPECT_EQ(decoded.front(), TileCoordinates(1, 1, 1));
+}
+
+TEST(TileFeedbackPassTest, OrdersByCoverageThenFinestZoom) {
+    std::vector<std::uint32_t> texels;
+    Append(texels, TileCoordinates(2, 1, 2), 3);
+    Append(texels, TileCoordinates(4, 2, 3), 3);
+    Append(texels, TileCoordinates(0, 0, 1), 10);
+    Append(texels, TileCoordinates(3, 3, 2), 1);
+
+    std::vector<TileCoordinates> decoded;
+    TileFeedbackPass::DecodeTexels(texels, decoded);
+    ASSERT_EQ(decoded.size(), 4u);
+    EXPECT_EQ(decoded[0], TileCoordinates(0, 0, 1));
+    EXPECT_EQ(decoded[1], TileCoordinates(4, 2, 3));
+    EXPECT_EQ(decoded[2], TileCoordinates(2, 1, 2));
+    EXPECT_EQ(decoded[3], TileCoordinates(3, 3, 2));
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/texture_atlas/tile_load_trace.h>
+#include <earth_map/renderer/texture_atlas/tile_request_queue.h>
+#include <sstream>
+
+namespace earth_map::tests {
+
+namespace {
+
+/**
+ * @brief Build a trace whose stages are @p step_ms apart, up to @p last
+ */
+TileLoadTrace MakeTrace(const TileCoordinates& coords, TileLoadStage last, int step_ms) {
+    TileLoadTrace trace(coords);
+    const auto start = TileLoadTrace::Clock::now();
+    for (std::size_t stage = 0; stage <= static_cast<std::size_t>(last); ++stage) {
+        trace.stamps[stage] = start + std::chrono::milliseconds(step_ms * static_cast<int>(stage));
+    }
+    return trace;
+}
+
+} // namespace
+
+TEST(TileLoadTraceTest, DisabledTracerCreatesNoTraces) {
+    TileLoadTracer tracer;
+    EXPECT_FALSE(tracer.IsEnabled());
+    EXPECT_EQ(tracer.Begin(TileCoordinates(1, 2, 3)), nullptr);
+
+    tracer.SetConfig(TileLoadTraceConfig{true, 16});
+    const auto trace = tracer.Begin(TileCoordinates(1, 2, 3));
+    ASSERT_NE(trace, nullptr);
+    EXPECT_TRUE(trace->HasReached(TileLoadStage::REQUESTED));
+    EXPECT_FALSE(trace->HasReached(TileLoadStage::FETCH_STARTED));
+}
+
+TEST(TileLoadTraceTest, FinishRecordsPhasesAndTimeToRender) {
+    TileLoadTracer tracer(TileLoadTraceConfig{true, 16});
+    tracer.Finish(MakeTrace(TileCoordinates(0, 0, 1), TileLoadStage::FIRST_RENDERED, 10),
+                  TileLoadOutcome::RENDERED);
+
+    const TileLoadTraceStats stats = tracer.GetStats();
+    for (std::size_t stage = 1; stage < kTileLoadStageCount; ++stage) {
+        const LatencyHistogram& phase = stats.GetPhase(static_cast<TileLoadStage>(stage));
+        EXPECT_EQ(phase.GetCount(), 1u) << GetTileLoadPhaseName(static_cast<TileLoadStage>(stage));
+        EXPECT_NEAR(phase.GetMax(), 10.0, 1e-6);
+    }
+    EXPECT_EQ(stats.time_to_render.GetCount(), 1u);
+    EXPECT_NEAR(stats.time_to_render.GetMax(), 60.0, 1e-6);
+    EXPECT_EQ(stats.GetOutcomeCount(TileLoadOutcome::RENDERED), 1u);
+}
+
+TEST(TileLoadTraceTest, UnfinishedPhasesAreSkipped) {
+    TileLoadTracer tracer(TileLoadTraceConfig{true, 16});
+    tracer.Finish(MakeTrace(TileCoordinates(0, 0, 1), TileLoadStage::FETCHED, 5),
+                  TileLoadOutcome::FAILED);
+
+    const TileLoadTraceStats stats = tracer.GetStats();
+    EXPECT_EQ(stats.GetPhase(TileLoadStage::FETCH_STARTED).GetCount(), 1u);
+    EXPECT_EQ(stats.GetPhase(TileLoadStage::FETCHED).GetCount(), 1u);
+    EXPECT_EQ(stats.GetPhase(TileLoadStage::DECODED).GetCount(), 0u);
+    EXPECT_EQ(stats.time_to_render.GetCount(), 0u);
+    EXPECT_EQ(stats.GetOutcomeCount(TileLoadOutcome::FAILED), 1u);
+}
+
+TEST(TileLoadTraceTest, ChromeTraceHasOneTrackPerTile) {
+    TileLoadTracer tracer(TileLoadTraceConfig{true, 16});
+    tracer.Finish(MakeTrace(TileCoordinates(3, 4, 5), TileLoadStage::UPLOADED, 2),
+                  TileLoadOutcome::EVICTED);
+
+    std::ostringstream json;
+    tracer.WriteChromeTrace(json);
+    const std::string text = json.str();
+    EXPECT_NE(text.find("\"traceEvents\""), std::string::npos);
+    EXPECT_NE(text.find("tile 5/3/4"), std::string::npos);
+    EXPECT_NE(text.find("\"name\":\"decode\""), std::string::npos);
+    EXPECT_EQ(text.find("\"name\":\"render\""), std::string::npos);
+    EXPECT_NE(text.find("\"outcome\":\"evicted\""), std::string::npos);
+}
+
+TEST(TileLoadTraceTest, RecordedTracesAreCapped) {
+    TileLoadTracer tracer(TileLoadTraceConfig{true, 2});
+    for (int x = 0; x < 3; ++x) {
+        tracer.Finish(MakeTrace(TileCoordinates(x, 0, 2), TileLoadStage::FETCH_STARTED, 1),
+                      TileLoadOutcome::CANCELLED);
+    }
+    EXPECT_EQ(tracer.GetStats().GetOutcomeCount(TileLoadOutcome::CANCELLED), 3u);
+
+    std::ostringstream json;
+    tracer.WriteChromeTrace(json);
+    EXPECT_EQ(json.str().find("tile 2/0/0"), std::string::npos);
+    EXPECT_NE(json.str().find("tile 2/2/0"), std::string::npos);
+
+    tracer.Reset();
+    EXPECT_EQ(tracer.GetStats().GetOutcomeCount(TileLoadOutcome::CANCELLED), 0u);
+}
+
+TEST(TileLoadTraceTest, RefreshedRequestKeepsItsTrace) {
+    TileLoadTracer tracer(TileLoadTraceConfig{true, 16});
+    TileRequestQueue queue;
+    TileLoadRequest request(TileCoordinates(1, 1, 3), 10);
+    request.trace = tracer.Begin(request.coords);
+    const auto trace = request.trace;
+    queue.Push(std::move(request));
+
+    // A re-request without a trace only refreshes the priority
+    queue.Push(TileLoadRequest(TileCoordinates(1, 1, 3), 5));
+    const auto taken = queue.Take(TileCoordinates(1, 1, 3));
+    ASSERT_TRUE(taken.has_value());
+    EXPECT_EQ(taken->priority, 5);
+    EXPECT_EQ(taken->trace, trace);
+    EXPECT_TRUE(queue.Empty());
+}
+
+} // namespace earth_map::tests
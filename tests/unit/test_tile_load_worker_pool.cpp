@@ -4,10 +4,14 @@
 #include <earth_map/data/tile_cache.h>
 #include <earth_map/data/tile_loader.h>
 #include <earth_map/math/tile_mathematics.h>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <atomic>
 #include <chrono>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace earth_map::tests {
 
@@ -44,10 +48,16 @@ public:
     std::atomic<int> load_count{0};
 
     WorkerPoolMockTileLoader() = default;
-    ~WorkerPoolMockTileLoader() override = default;
+    ~WorkerPoolMockTileLoader() override {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        for (auto& thread : async_threads_) {
+            thread.join();
+        }
+    }
 
     bool Initialize(const TileLoaderConfig&) override { return true; }
     void SetTileCache(std::shared_ptr<TileCache>) override {}
+    std::shared_ptr<TileCache> GetTileCache() const override { return nullptr; }
 
     bool AddProvider(std::shared_ptr<TileProvider>) override { return true; }
     bool SetDefaultProvider(const std::string&) override { return true; }
@@ -75,19 +85,31 @@ public:
 
         // Create fake image data (RGBA)
         const std::size_t data_size = 256 * 256 * 4;
-        result.tile_data->data.resize(data_size);
 
         // Fill with pattern based on tile coords
         const std::uint8_t value = static_cast<std::uint8_t>((coords.x + coords.y + coords.zoom) % 256);
-        std::fill(result.tile_data->data.begin(), result.tile_data->data.end(), value);
+        result.tile_data->data = std::vector<std::uint8_t>(data_size, value);
 
         return result;
     }
 
-    std::future<TileLoadResult> LoadTileAsync(const TileCoordinates&,
-                                              TileLoadCallback,
-                                              const std::string&) override {
-        return std::future<TileLoadResult>();
+    // Asynchronous load - runs LoadTile on its own thread like a network fetch
+    std::future<TileLoadResult> LoadTileAsync(const TileCoordinates& coords,
+                                              TileLoadCallback callback,
+                                              const std::string& provider) override {
+        auto promise = std::make_shared<std::promise<TileLoadResult>>();
+        auto future = promise->get_future();
+
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        async_threads_.emplace_back([this, coords, callback, provider, promise]() {
+            auto result = LoadTile(coords, provider);
+            if (callback) {
+                callback(result);
+            }
+            promise->set_value(std::move(result));
+        });
+
+        return future;
     }
 
     std::vector<std::future<TileLoadResult>> LoadTilesAsync(const std::vector<TileCoordinates>&,
@@ -107,6 +129,94 @@ public:
     bool SetConfiguration(const TileLoaderConfig&) override { return true; }
     bool IsLoading(const TileCoordinates&) const override { return false; }
     std::vector<TileCoordinates> GetLoadingTiles() const override { return {}; }
+
+private:
+    std::mutex async_mutex_;
+    std::vector<std::thread> async_threads_;
+};
+
+/**
+ * @brief Mock TileLoader whose downloads never finish until cancelled
+ */
+class StalledMockTileLoader : public WorkerPoolMockTileLoader {
+public:
+    std::atomic<int> cancel_count{0};
+
+    std::future<TileLoadResult> LoadTileAsync(const TileCoordinates& coords,
+                                              TileLoadCallback callback,
+                                              const std::string&) override {
+        load_count.fetch_add(1);
+        std::lock_guard<std::mutex> lock(stalled_mutex_);
+        stalled_.emplace_back(coords, std::move(callback));
+        return {};
+    }
+
+    bool CancelLoad(const TileCoordinates& coords) override {
+        std::vector<TileLoadCallback> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(stalled_mutex_);
+            for (auto it = stalled_.begin(); it != stalled_.end();) {
+                if (it->first == coords) {
+                    callbacks.push_back(std::move(it->second));
+                    it = stalled_.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        cancel_count.fetch_add(1);
+        for (auto& callback : callbacks) {
+            TileLoadResult result;
+            result.coordinates = coords;
+            result.error_message = "Load cancelled";
+            callback(result);
+        }
+        return !callbacks.empty();
+    }
+
+private:
+    std::mutex stalled_mutex_;
+    std::vector<std::pair<TileCoordinates, TileLoadCallback>> stalled_;
+};
+
+/**
+ * @brief Mock TileLoader whose provider stops at zoom 5 and lacks tiles above zoom 3
+ */
+class SparseMockTileLoader : public WorkerPoolMockTileLoader {
+public:
+    explicit SparseMockTileLoader(int missing_status)
+        : missing_status_(missing_status),
+          provider_(std::make_shared<BasicXYZTileProvider>("sparse", "http://x/{z}/{x}/{y}.png",
+                                                           "", 0, 5)) {}
+
+    const TileProvider* GetProvider(const std::string&) const override { return provider_.get(); }
+
+    TileLoadResult LoadTile(const TileCoordinates& coords, const std::string& provider) override {
+        {
+            std::lock_guard<std::mutex> lock(zooms_mutex_);
+            loaded_zooms_.push_back(coords.zoom);
+        }
+        if (coords.zoom <= 3) {
+            return WorkerPoolMockTileLoader::LoadTile(coords, provider);
+        }
+        load_count.fetch_add(1);
+        TileLoadResult result;
+        result.coordinates = coords;
+        result.status_code = missing_status_;
+        result.error_message = "HTTP " + std::to_string(missing_status_);
+        return result;
+    }
+
+    std::vector<int> GetLoadedZooms() {
+        std::lock_guard<std::mutex> lock(zooms_mutex_);
+        return loaded_zooms_;
+    }
+
+private:
+    int missing_status_;
+    std::shared_ptr<BasicXYZTileProvider> provider_;
+    std::mutex zooms_mutex_;
+    std::vector<int> loaded_zooms_;
 };
 
 /**
@@ -123,7 +233,8 @@ protected:
             cache_,
             loader_,
             upload_queue_,
-            2  // 2 worker threads for testing
+            2,  // 2 decode threads for testing
+            2   // 2 fetches in flight, so later requests stay queued
         );
     }
 
@@ -246,6 +357,24 @@ TEST_F(TileLoadWorkerPoolTest, Shutdown_GracefulCompletion) {
     EXPECT_GE(loader_->load_count.load(), 5);
 }
 
+TEST_F(TileLoadWorkerPoolTest, Shutdown_CancelsStalledDownloads) {
+    auto stalled = std::make_shared<StalledMockTileLoader>();
+    auto pool = std::make_unique<TileLoadWorkerPool>(cache_, stalled, upload_queue_, 2, 2);
+
+    pool->SubmitRequest(TileCoordinates(1, 1, 5), 0);
+    pool->SubmitRequest(TileCoordinates(2, 2, 5), 0);
+
+    // Shutdown returns although no download ever completes on its own
+    auto done = std::async(std::launch::async, [&pool]() { pool->Shutdown(); });
+    ASSERT_EQ(done.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+
+    EXPECT_EQ(stalled->load_count.load(), 2);
+    EXPECT_EQ(stalled->cancel_count.load(), 2);
+    EXPECT_EQ(pool->GetInFlightFetchCount(), 0u);
+    // Both tiles report failure so the GL thread resets them
+    EXPECT_EQ(upload_queue_->Size(), 2u);
+}
+
 TEST_F(TileLoadWorkerPoolTest, ConcurrentSubmission) {
     constexpr int num_threads = 4;
     constexpr int tiles_per_thread = 10;
@@ -299,6 +428,110 @@ TEST_F(TileLoadWorkerPoolTest, WorkerThreads_ProcessInParallel) {
     EXPECT_EQ(loader_->load_count.load(), num_tiles);
 }
 
+TEST_F(TileLoadWorkerPoolTest, CancelRequest_SkipsQueuedTile) {
+    // Keep both workers busy so the remaining tiles stay queued
+    const int num_tiles = 20;
+    for (int i = 0; i < num_tiles; ++i) {
+        pool_->SubmitRequest(TileCoordinates(i, i, 5), 0);
+    }
+
+    const TileCoordinates last(num_tiles - 1, num_tiles - 1, 5);
+    EXPECT_TRUE(pool_->CancelRequest(last));
+    EXPECT_FALSE(pool_->CancelRequest(last));
+
+    pool_.reset();
+
+    EXPECT_EQ(loader_->load_count.load(), num_tiles - 1);
+}
+
+TEST_F(TileLoadWorkerPoolTest, UpdatePriority_ReordersQueuedTile) {
+    const int num_tiles = 20;
+    for (int i = 0; i < num_tiles; ++i) {
+        pool_->SubmitRequest(TileCoordinates(i, i, 5), 10);
+    }
+
+    const TileCoordinates last(num_tiles - 1, num_tiles - 1, 5);
+    std::atomic<bool> last_done{false};
+    std::atomic<int> loads_before_last{-1};
+    EXPECT_TRUE(pool_->UpdatePriority(last, 0));
+    EXPECT_FALSE(pool_->UpdatePriority(TileCoordinates(500, 500, 5), 0));
+
+    // Resubmitting a queued tile keeps it queued once but accepts a callback
+    pool_->SubmitRequest(last, 0, [&](const TileCoordinates&) {
+        loads_before_last.store(loader_->load_count.load());
+        last_done.store(true);
+    });
+
+    pool_.reset();
+
+    EXPECT_TRUE(last_done.load());
+    EXPECT_EQ(loader_->load_count.load(), num_tiles);
+    // Re-prioritized tile jumps ahead of the remaining low-priority backlog
+    EXPECT_LT(loads_before_last.load(), num_tiles / 2);
+}
+
+TEST_F(TileLoadWorkerPoolTest, CancelStaleRequests_DropsOldGeneration) {
+    const int num_tiles = 30;
+    for (int i = 0; i < num_tiles; ++i) {
+        pool_->SubmitRequest(TileCoordinates(i, i, 5), 0);
+    }
+
+    // New generation renews only the first five tiles
+    const std::uint64_t generation = pool_->AdvanceGeneration();
+    EXPECT_EQ(pool_->GetGeneration(), generation);
+    for (int i = 0; i < 5; ++i) {
+        pool_->SubmitRequest(TileCoordinates(i, i, 5), 0);
+    }
+
+    const auto dropped = pool_->CancelStaleRequests();
+    EXPECT_FALSE(dropped.empty());
+    for (const auto& coords : dropped) {
+        EXPECT_GE(coords.x, 5);
+    }
+
+    pool_.reset();
+
+    EXPECT_EQ(loader_->load_count.load(), num_tiles - static_cast<int>(dropped.size()));
+}
+
+// ============================================================================
+// Overzoom Tests
+// ============================================================================
+
+TEST_F(TileLoadWorkerPoolTest, Overzoom_ClimbsPastMissingAncestors) {
+    auto sparse = std::make_shared<SparseMockTileLoader>(404);
+    auto pool = std::make_unique<TileLoadWorkerPool>(cache_, sparse, upload_queue_, 2, 2);
+
+    pool->SubmitRequest(TileCoordinates(80, 80, 7), 0);
+    // Success and failure both end in one upload command; shutdown would cancel the climb
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (upload_queue_->Size() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    pool.reset();
+
+    // Zoom 5 and 4 are missing, zoom 3 is the deepest ancestor the provider has
+    EXPECT_EQ(sparse->GetLoadedZooms(), (std::vector<int>{5, 4, 3}));
+    EXPECT_EQ(upload_queue_->Size(), 1u);
+}
+
+TEST_F(TileLoadWorkerPoolTest, Overzoom_TransientErrorDoesNotClimb) {
+    auto sparse = std::make_shared<SparseMockTileLoader>(503);
+    auto pool = std::make_unique<TileLoadWorkerPool>(cache_, sparse, upload_queue_, 2, 2);
+
+    pool->SubmitRequest(TileCoordinates(80, 80, 7), 0);
+    // Success and failure both end in one upload command; shutdown would cancel the climb
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (upload_queue_->Size() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    pool.reset();
+
+    // A server error says nothing about the parent: the request fails instead
+    EXPECT_EQ(sparse->GetLoadedZooms(), (std::vector<int>{5}));
+    EXPECT_EQ(upload_queue_->Size(), 1u);
+}
+
 // ============================================================================
 // Stress Tests
 // ============================================================================
@@ -7,12 +7,15 @@
  */
 
 #include <gtest/gtest.h>
+#include <earth_map/core/frame_arena.h>
 #include <earth_map/data/tile_cache.h>
 #include <earth_map/data/tile_loader.h>
 #include <earth_map/data/tile_index.h>
 #include <earth_map/data/tile_manager.h>
+#include <algorithm>
 #include <memory>
 #include <filesystem>
+#include <random>
 #include <spdlog/spdlog.h>
 #include <thread>
 #include <chrono>
@@ -52,7 +55,7 @@ protected:
         tile_data.metadata.content_type = "image/png";
         tile_data.metadata.checksum = 12345;
         
-        tile_data.data.assign(content.begin(), content.end());
+        tile_data.data = std::vector<std::uint8_t>(content.begin(), content.end());
         tile_data.is_compressed = false;
         tile_data.width = 256;
         tile_data.height = 256;
@@ -399,6 +402,107 @@ TEST_F(TileManagementTest, TileIndexStatistics) {
     EXPECT_EQ(stats.tiles_per_zoom[2], 16);  // 16 tiles at zoom 2
 }
 
+TEST_F(TileManagementTest, TileIndexQueriesMatchBruteForce) {
+    TileIndexConfig config;
+    auto index = CreateTileIndex(config);
+    ASSERT_TRUE(index->Initialize(config));
+    
+    // Clustered tiles at several zooms, with moves and removals
+    std::mt19937 rng(42);
+    std::vector<TileCoordinates> live;
+    for (int i = 0; i < 20000; ++i) {
+        const int zoom = 3 + static_cast<int>(rng() % 12);
+        const int n = 1 << zoom;
+        const int x = std::min(n - 1, static_cast<int>(n * 0.52) + static_cast<int>(rng() % 40));
+        const int y = std::min(n - 1, static_cast<int>(n * 0.35) + static_cast<int>(rng() % 40));
+        const TileCoordinates tile = CreateTestTile(x, y, zoom);
+        if (!index->Contains(tile)) {
+            live.push_back(tile);
+        }
+        ASSERT_TRUE(index->Insert(tile));
+    }
+    for (std::size_t i = 0; i < live.size(); i += 3) {
+        ASSERT_TRUE(index->Remove(live[i]));
+        EXPECT_FALSE(index->Remove(live[i]));
+    }
+    std::vector<TileCoordinates> expected_live;
+    for (std::size_t i = 0; i < live.size(); ++i) {
+        if (i % 3 != 0) {
+            expected_live.push_back(live[i]);
+        }
+    }
+    EXPECT_EQ(index->GetTileCount(), expected_live.size());
+    EXPECT_FALSE(index->Insert(CreateTestTile(4, 0, 2)));
+    
+    const auto key = [](const TileCoordinates& t) { return std::make_tuple(t.zoom, t.x, t.y); };
+    const auto sorted = [&](std::vector<TileCoordinates> tiles) {
+        std::sort(tiles.begin(), tiles.end(),
+                  [&](const auto& a, const auto& b) { return key(a) < key(b); });
+        return tiles;
+    };
+    
+    BoundingBox2D bounds;
+    bounds.min = glm::dvec2(10.0, 40.0);
+    bounds.max = glm::dvec2(25.0, 52.0);
+    for (const auto& [min_zoom, max_zoom] : {std::pair{0, 30}, std::pair{8, 8}, std::pair{5, 11}}) {
+        SCOPED_TRACE(min_zoom);
+        std::vector<TileCoordinates> expected;
+        for (const TileCoordinates& tile : expected_live) {
+            if (tile.zoom >= min_zoom && tile.zoom <= max_zoom &&
+                TileMathematics::GetTileBounds(tile).Intersects(bounds)) {
+                expected.push_back(tile);
+            }
+        }
+        ASSERT_FALSE(expected.empty());
+        EXPECT_EQ(sorted(index->Query(bounds, min_zoom, max_zoom)), sorted(expected));
+        
+        // Same tiles from the arena-backed overload
+        FrameArena arena;
+        std::pmr::vector<TileCoordinates> pooled(arena.GetResource());
+        index->Query(bounds, min_zoom, max_zoom, pooled);
+        EXPECT_EQ(sorted(std::vector<TileCoordinates>(pooled.begin(), pooled.end())),
+                  sorted(expected));
+    }
+    
+    std::vector<TileCoordinates> at_zoom;
+    std::copy_if(expected_live.begin(), expected_live.end(), std::back_inserter(at_zoom),
+                 [](const TileCoordinates& t) { return t.zoom == 9; });
+    EXPECT_EQ(sorted(index->GetTilesAtZoom(9)), sorted(at_zoom));
+}
+
+TEST_F(TileManagementTest, TileIndexRebuildKeepsLargeIndexSorted) {
+    TileIndexConfig config;
+    auto index = CreateTileIndex(config);
+    ASSERT_TRUE(index->Initialize(config));
+    
+    // Enough tiles for the parallel radix sort
+    std::size_t inserted = 0;
+    for (int zoom = 9; zoom >= 8; --zoom) {
+        const int n = 1 << zoom;
+        for (int y = 0; y < n; ++y) {
+            for (int x = 0; x < n; ++x) {
+                ASSERT_TRUE(index->Insert(CreateTestTile(x, y, zoom)));
+                ++inserted;
+            }
+        }
+    }
+    index->Rebuild();
+    EXPECT_EQ(index->GetTileCount(), inserted);
+    EXPECT_TRUE(index->Contains(CreateTestTile(511, 511, 9)));
+    EXPECT_EQ(index->GetTilesAtZoom(8).size(), 256u * 256u);
+    
+    const auto stats = index->GetStatistics();
+    EXPECT_EQ(stats.total_tiles, inserted);
+    EXPECT_EQ(stats.max_depth, 9u);
+    EXPECT_EQ(stats.leaf_nodes, 512u * 512u);
+    
+    BoundingBox2D bounds;
+    bounds.min = glm::dvec2(-0.5, -0.5);
+    bounds.max = glm::dvec2(0.5, 0.5);
+    // The four tiles around (0, 0) at each zoom
+    EXPECT_EQ(index->Query(bounds).size(), 8u);
+}
+
 // Integration Tests
 TEST_F(TileManagementTest, TileManagerIntegration) {
     // Create components
@@ -533,6 +637,7 @@ TEST_F(TileManagementTest, PerformanceTest) {
 TEST_F(TileManagementTest, ErrorHandling) {
     // Test invalid coordinates
     TileCacheConfig cache_config;
+    cache_config.disk_cache_directory = test_dir_.string() + "/error_cache";
     auto cache = CreateTileCache(cache_config);
     ASSERT_TRUE(cache->Initialize(cache_config));
     
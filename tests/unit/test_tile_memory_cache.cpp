@@ -0,0 +1,358 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/tile_memory_cache.h>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+std::shared_ptr<const TileData> MakeTile(int32_t x, int32_t y, int32_t zoom,
+                                         std::size_t size = 100) {
+    auto tile = std::make_shared<TileData>();
+    tile->metadata.coordinates = TileCoordinates(x, y, zoom);
+    tile->metadata.file_size = size;
+    tile->data = std::vector<std::uint8_t>(size, static_cast<std::uint8_t>(x));
+    tile->loaded = true;
+    return tile;
+}
+
+} // namespace
+
+TEST(ShardedTileMemoryCacheTest, PutAndGet) {
+    ShardedTileMemoryCache cache(1024 * 1024);
+
+    cache.Put(MakeTile(1, 2, 3));
+
+    auto tile = cache.Get(TileCoordinates(1, 2, 3));
+    ASSERT_NE(tile, nullptr);
+    EXPECT_EQ(tile->data.size(), 100u);
+    EXPECT_TRUE(cache.Contains(TileCoordinates(1, 2, 3)));
+    EXPECT_EQ(cache.Get(TileCoordinates(2, 2, 3)), nullptr);
+    EXPECT_EQ(cache.GetCount(), 1u);
+    EXPECT_EQ(cache.GetSizeBytes(), 100u);
+}
+
+TEST(ShardedTileMemoryCacheTest, ShardCountIsPowerOfTwo) {
+    ShardedTileMemoryCache cache(1024, 5);
+    EXPECT_EQ(cache.GetShardCount(), 8u);
+}
+
+TEST(ShardedTileMemoryCacheTest, ReplaceAdjustsAccounting) {
+    ShardedTileMemoryCache cache(1024 * 1024);
+
+    cache.Put(MakeTile(0, 0, 1, 100));
+    cache.Put(MakeTile(0, 0, 1, 300));
+    EXPECT_EQ(cache.GetCount(), 1u);
+    EXPECT_EQ(cache.GetSizeBytes(), 300u);
+
+    cache.Put(MakeTile(0, 0, 1, 50));
+    EXPECT_EQ(cache.GetSizeBytes(), 50u);
+}
+
+TEST(ShardedTileMemoryCacheTest, EvictsToBudgetAndKeepsNewTile) {
+    ShardedTileMemoryCache cache(1000, 4);
+
+    for (int i = 0; i < 20; ++i) {
+        cache.Put(MakeTile(i, 0, 5, 100));
+        EXPECT_TRUE(cache.Contains(TileCoordinates(i, 0, 5)));
+        EXPECT_LE(cache.GetSizeBytes(), 1000u);
+    }
+
+    EXPECT_EQ(cache.GetCount(), 10u);
+    EXPECT_EQ(cache.GetEvictionCount(), 10u);
+}
+
+TEST(ShardedTileMemoryCacheTest, SingleShardEvictsLeastRecentlyUsed) {
+    ShardedTileMemoryCache cache(300, 1);
+
+    cache.Put(MakeTile(0, 0, 2));
+    cache.Put(MakeTile(1, 0, 2));
+    cache.Put(MakeTile(2, 0, 2));
+
+    // Touch the oldest tile so the second one becomes the victim
+    ASSERT_NE(cache.Get(TileCoordinates(0, 0, 2)), nullptr);
+    cache.Put(MakeTile(3, 0, 2));
+
+    EXPECT_TRUE(cache.Contains(TileCoordinates(0, 0, 2)));
+    EXPECT_FALSE(cache.Contains(TileCoordinates(1, 0, 2)));
+    EXPECT_TRUE(cache.Contains(TileCoordinates(2, 0, 2)));
+    EXPECT_TRUE(cache.Contains(TileCoordinates(3, 0, 2)));
+}
+
+TEST(ShardedTileMemoryCacheTest, TileLargerThanBudgetIsKept) {
+    ShardedTileMemoryCache cache(50, 1);
+
+    cache.Put(MakeTile(0, 0, 1, 100));
+    EXPECT_TRUE(cache.Contains(TileCoordinates(0, 0, 1)));
+
+    cache.Put(MakeTile(1, 0, 1, 100));
+    EXPECT_FALSE(cache.Contains(TileCoordinates(0, 0, 1)));
+    EXPECT_TRUE(cache.Contains(TileCoordinates(1, 0, 1)));
+}
+
+TEST(ShardedTileMemoryCacheTest, SetMaxBytesEvicts) {
+    ShardedTileMemoryCache cache(1000);
+    for (int i = 0; i < 10; ++i) {
+        cache.Put(MakeTile(i, 0, 4));
+    }
+
+    EXPECT_EQ(cache.SetMaxBytes(400), 6u);
+    EXPECT_EQ(cache.GetCount(), 4u);
+    EXPECT_LE(cache.GetSizeBytes(), 400u);
+}
+
+TEST(ShardedTileMemoryCacheTest, EraseAndClear) {
+    ShardedTileMemoryCache cache(1024 * 1024);
+    for (int i = 0; i < 8; ++i) {
+        cache.Put(MakeTile(i, 1, 4));
+    }
+
+    EXPECT_TRUE(cache.Erase(TileCoordinates(3, 1, 4)));
+    EXPECT_FALSE(cache.Erase(TileCoordinates(3, 1, 4)));
+    EXPECT_EQ(cache.GetCount(), 7u);
+
+    cache.Clear();
+    EXPECT_EQ(cache.GetCount(), 0u);
+    EXPECT_EQ(cache.GetSizeBytes(), 0u);
+}
+
+TEST(ShardedTileMemoryCacheTest, GetBumpsMetadataAccess) {
+    ShardedTileMemoryCache cache(1024 * 1024);
+    auto tile = MakeTile(4, 4, 4);
+    cache.PutMetadata(std::make_shared<TileMetadata>(tile->metadata));
+    cache.Put(tile);
+
+    cache.Get(TileCoordinates(4, 4, 4));
+    cache.Get(TileCoordinates(4, 4, 4));
+
+    auto metadata = cache.GetMetadata(TileCoordinates(4, 4, 4));
+    ASSERT_NE(metadata, nullptr);
+    EXPECT_EQ(metadata->access_count, 2u);
+
+    cache.Erase(TileCoordinates(4, 4, 4));
+    EXPECT_EQ(cache.GetMetadata(TileCoordinates(4, 4, 4)), nullptr);
+}
+
+TEST(ShardedTileMemoryCacheTest, EvictionDropsMetadata) {
+    ShardedTileMemoryCache cache(250, 1);
+    for (int i = 0; i < 3; ++i) {
+        auto tile = MakeTile(i, 0, 4);
+        cache.PutMetadata(std::make_shared<TileMetadata>(tile->metadata));
+        cache.Put(tile);
+    }
+
+    // Third tile pushed the least recently used one out, with its metadata
+    EXPECT_FALSE(cache.Contains(TileCoordinates(0, 0, 4)));
+    EXPECT_EQ(cache.GetMetadata(TileCoordinates(0, 0, 4)), nullptr);
+    EXPECT_NE(cache.GetMetadata(TileCoordinates(2, 0, 4)), nullptr);
+}
+
+TEST(ShardedTileMemoryCacheTest, MetadataIsReturnedByCopy) {
+    ShardedTileMemoryCache cache(1024 * 1024);
+    auto tile = MakeTile(4, 4, 4);
+    auto stored = std::make_shared<TileMetadata>(tile->metadata);
+    cache.PutMetadata(stored);
+    cache.Put(tile);
+
+    auto before = cache.GetMetadata(TileCoordinates(4, 4, 4));
+    ASSERT_NE(before, nullptr);
+    cache.Get(TileCoordinates(4, 4, 4));
+
+    // Access stats change inside the cache only, never under a reader
+    EXPECT_EQ(before->access_count, 0u);
+    EXPECT_EQ(stored->access_count, 0u);
+    EXPECT_EQ(cache.GetMetadata(TileCoordinates(4, 4, 4))->access_count, 1u);
+}
+
+TEST(ShardedTileMemoryCacheTest, CollectIfVisitsAllShards) {
+    ShardedTileMemoryCache cache(1024 * 1024);
+    for (int i = 0; i < 32; ++i) {
+        cache.Put(MakeTile(i, 0, i % 2 == 0 ? 6 : 7));
+    }
+
+    auto at_zoom_6 = cache.CollectIf([](const TileCoordinates& coords, const TileData&) {
+        return coords.zoom == 6;
+    });
+    EXPECT_EQ(at_zoom_6.size(), 16u);
+}
+
+TEST(ShardedTileMemoryCacheTest, CollectAtZoomFollowsPutEraseAndEviction) {
+    ShardedTileMemoryCache cache(1000, 1);
+    for (int i = 0; i < 8; ++i) {
+        cache.Put(MakeTile(i, 0, 5));
+    }
+    cache.Put(MakeTile(0, 0, 4));
+
+    // Budget of ten tiles: nothing evicted yet
+    EXPECT_EQ(cache.CollectAtZoom(5).size(), 8u);
+    EXPECT_EQ(cache.CollectAtZoom(4).size(), 1u);
+    EXPECT_TRUE(cache.CollectAtZoom(6).empty());
+
+    cache.Erase(TileCoordinates(3, 0, 5));
+    EXPECT_EQ(cache.CollectAtZoom(5).size(), 7u);
+
+    // Two more tiles evict the least recently used one, (0, 0, 5)
+    cache.Put(MakeTile(0, 1, 6));
+    cache.Put(MakeTile(1, 1, 6));
+    cache.Put(MakeTile(2, 1, 6));
+    const auto at_zoom_5 = cache.CollectAtZoom(5);
+    EXPECT_EQ(at_zoom_5.size(), 6u);
+    EXPECT_EQ(std::count(at_zoom_5.begin(), at_zoom_5.end(), TileCoordinates(0, 0, 5)), 0);
+
+    cache.Clear();
+    EXPECT_TRUE(cache.CollectAtZoom(6).empty());
+}
+
+TEST(ShardedTileMemoryCacheTest, CollectInBoundsMatchesTileIntersection) {
+    ShardedTileMemoryCache cache(1024 * 1024);
+    for (int zoom = 2; zoom <= 4; ++zoom) {
+        const int n = 1 << zoom;
+        for (int x = 0; x < n; ++x) {
+            for (int y = 0; y < n; ++y) {
+                cache.Put(MakeTile(x, y, zoom));
+            }
+        }
+    }
+
+    const BoundingBox2D bounds(glm::dvec2(-10.0, 20.0), glm::dvec2(35.0, 50.0));
+    auto expected = cache.CollectIf([&bounds](const TileCoordinates& coords, const TileData&) {
+        return bounds.Intersects(TileMathematics::GetTileBounds(coords));
+    });
+    auto found = cache.CollectInBounds(bounds);
+    std::sort(expected.begin(), expected.end());
+    std::sort(found.begin(), found.end());
+    EXPECT_FALSE(found.empty());
+    EXPECT_EQ(found, expected);
+}
+
+TEST(ShardedTileMemoryCacheTest, InvalidTilesAreNotIndexed) {
+    ShardedTileMemoryCache cache(1024 * 1024);
+    auto empty = std::make_shared<TileData>();
+    empty->metadata.coordinates = TileCoordinates(1, 1, 3);
+    cache.Put(empty);
+    EXPECT_TRUE(cache.Contains(TileCoordinates(1, 1, 3)));
+    EXPECT_TRUE(cache.CollectAtZoom(3).empty());
+
+    // Replacing with valid data indexes the tile
+    cache.Put(MakeTile(1, 1, 3));
+    EXPECT_EQ(cache.CollectAtZoom(3).size(), 1u);
+}
+
+TEST(ShardedTileMemoryCacheTest, CountBudgetEvicts) {
+    ShardedTileMemoryCache cache(1024 * 1024, 1);
+    cache.SetMaxCount(3);
+
+    for (int i = 0; i < 5; ++i) {
+        cache.Put(MakeTile(i, 0, 3));
+    }
+
+    EXPECT_EQ(cache.GetCount(), 3u);
+    EXPECT_FALSE(cache.Contains(TileCoordinates(0, 0, 3)));
+    EXPECT_TRUE(cache.Contains(TileCoordinates(4, 0, 3)));
+}
+
+TEST(ShardedTileMemoryCacheTest, LfuEvictsLeastFrequentlyUsed) {
+    ShardedTileMemoryCache cache(300, 1, ShardedTileMemoryCache::EvictionStrategy::LFU);
+
+    cache.Put(MakeTile(0, 0, 2));
+    cache.Put(MakeTile(1, 0, 2));
+    cache.Put(MakeTile(2, 0, 2));
+
+    // Tile 1 is the most recently used but the least frequently used
+    for (int i = 0; i < 3; ++i) {
+        cache.Get(TileCoordinates(0, 0, 2));
+        cache.Get(TileCoordinates(2, 0, 2));
+    }
+    cache.Get(TileCoordinates(1, 0, 2));
+    cache.Put(MakeTile(3, 0, 2));
+    cache.Put(MakeTile(4, 0, 2));
+
+    // Tile 3 evicts tile 1; tile 4 then evicts tile 3 (one use so far)
+    EXPECT_TRUE(cache.Contains(TileCoordinates(0, 0, 2)));
+    EXPECT_TRUE(cache.Contains(TileCoordinates(2, 0, 2)));
+    EXPECT_FALSE(cache.Contains(TileCoordinates(1, 0, 2)));
+    EXPECT_FALSE(cache.Contains(TileCoordinates(3, 0, 2)));
+    EXPECT_TRUE(cache.Contains(TileCoordinates(4, 0, 2)));
+}
+
+TEST(ShardedTileMemoryCacheTest, SizeBasedEvictsLargestFirst) {
+    ShardedTileMemoryCache cache(1000, 1, ShardedTileMemoryCache::EvictionStrategy::SIZE_BASED);
+
+    cache.Put(MakeTile(0, 0, 2, 100));
+    cache.Put(MakeTile(1, 0, 2, 500));
+    cache.Put(MakeTile(2, 0, 2, 200));
+    cache.Put(MakeTile(3, 0, 2, 300));
+
+    EXPECT_FALSE(cache.Contains(TileCoordinates(1, 0, 2)));
+    EXPECT_EQ(cache.GetSizeBytes(), 600u);
+}
+
+TEST(ShardedTileMemoryCacheTest, TimeBasedIgnoresAccess) {
+    ShardedTileMemoryCache cache(300, 1, ShardedTileMemoryCache::EvictionStrategy::TIME_BASED);
+
+    cache.Put(MakeTile(0, 0, 2));
+    cache.Put(MakeTile(1, 0, 2));
+    cache.Put(MakeTile(2, 0, 2));
+    cache.Get(TileCoordinates(0, 0, 2));
+    cache.Put(MakeTile(3, 0, 2));
+
+    // Oldest insertion goes, even though it was just read
+    EXPECT_FALSE(cache.Contains(TileCoordinates(0, 0, 2)));
+    EXPECT_TRUE(cache.Contains(TileCoordinates(1, 0, 2)));
+}
+
+TEST(ShardedTileMemoryCacheTest, SwitchingStrategyKeepsTiles) {
+    ShardedTileMemoryCache cache(300, 1);
+
+    cache.Put(MakeTile(0, 0, 2));
+    cache.Put(MakeTile(1, 0, 2));
+    cache.Put(MakeTile(2, 0, 2));
+    cache.Get(TileCoordinates(0, 0, 2));
+
+    cache.SetEvictionStrategy(ShardedTileMemoryCache::EvictionStrategy::LFU);
+    EXPECT_EQ(cache.GetEvictionStrategy(), ShardedTileMemoryCache::EvictionStrategy::LFU);
+    EXPECT_EQ(cache.GetCount(), 3u);
+
+    cache.Put(MakeTile(3, 0, 2));
+    EXPECT_TRUE(cache.Contains(TileCoordinates(0, 0, 2)));
+    EXPECT_FALSE(cache.Contains(TileCoordinates(1, 0, 2)));
+
+    cache.SetEvictionStrategy(ShardedTileMemoryCache::EvictionStrategy::LRU);
+    cache.Put(MakeTile(4, 0, 2));
+    EXPECT_EQ(cache.GetCount(), 3u);
+    EXPECT_TRUE(cache.Contains(TileCoordinates(4, 0, 2)));
+}
+
+TEST(ShardedTileMemoryCacheTest, ConcurrentGetAndPut) {
+    ShardedTileMemoryCache cache(64 * 100);
+    constexpr int kThreads = 4;
+    constexpr int kOpsPerThread = 2000;
+    std::atomic<int> hits{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&cache, &hits, t]() {
+            for (int i = 0; i < kOpsPerThread; ++i) {
+                const int x = (i * 7 + t) % 128;
+                if (i % 3 == 0) {
+                    cache.Put(MakeTile(x, t, 8));
+                } else if (auto tile = cache.Get(TileCoordinates(x, t, 8))) {
+                    EXPECT_EQ(tile->data.size(), 100u);
+                    hits++;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_LE(cache.GetSizeBytes(), 64u * 100u);
+    EXPECT_EQ(cache.GetSizeBytes(), cache.GetCount() * 100u);
+    EXPECT_GT(hits.load(), 0);
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/texture_atlas/tile_mip_chain.h>
+#include <algorithm>
+#include <vector>
+
+namespace earth_map::tests {
+
+TEST(TileMipChainTest, LevelCounts) {
+    EXPECT_EQ(TileMipChain::GetMaxLevels(TileTextureFormat::RGBA8, 256), 9u);
+    EXPECT_EQ(TileMipChain::GetMaxLevels(TileTextureFormat::BC1, 256), 7u);  // down to 4x4
+    EXPECT_EQ(TileMipChain::GetMaxLevels(TileTextureFormat::RGBA8, 1), 1u);
+    EXPECT_EQ(TileMipChain::GetMaxLevels(TileTextureFormat::RGBA8, 200), 1u);
+    EXPECT_EQ(TileMipChain::GetMaxLevels(TileTextureFormat::BC1, 2), 1u);
+}
+
+TEST(TileMipChainTest, LevelOffsets) {
+    EXPECT_EQ(TileMipChain::GetLevelOffset(TileTextureFormat::RGBA8, 8, 0), 0u);
+    EXPECT_EQ(TileMipChain::GetLevelOffset(TileTextureFormat::RGBA8, 8, 1), 8u * 8u * 4u);
+    EXPECT_EQ(TileMipChain::GetLevelOffset(TileTextureFormat::RGBA8, 8, 4),
+              (64u + 16u + 4u + 1u) * 4u);
+    EXPECT_EQ(TileMipChain::GetLevelOffset(TileTextureFormat::BC1, 16, 3),
+              (16u + 4u + 1u) * TileBlockCompressor::kBC1BlockBytes);
+}
+
+TEST(TileMipChainTest, DownsampleAveragesQuads) {
+    // 4x4 single channel: each 2x2 quad averages to its own value
+    const std::vector<std::uint8_t> src = {
+        0,   2,   100, 100,
+        4,   6,   100, 100,
+        10,  10,  255, 255,
+        10,  10,  255, 254,
+    };
+    std::vector<std::uint8_t> dst(4);
+    TileMipChain::Downsample(src.data(), 4, 1, dst.data());
+    EXPECT_EQ(dst[0], 3);
+    EXPECT_EQ(dst[1], 100);
+    EXPECT_EQ(dst[2], 10);
+    EXPECT_EQ(dst[3], 255);  // rounds to nearest
+}
+
+TEST(TileMipChainTest, BuildsRgbaChainInPlace) {
+    const std::uint32_t size = 8;
+    const std::size_t chain_size = TileMipChain::GetLevelOffset(TileTextureFormat::RGBA8, size, 4);
+    std::vector<std::uint8_t> data(chain_size, 0);
+    // Left half black, right half white
+    for (std::uint32_t y = 0; y < size; ++y) {
+        for (std::uint32_t x = size / 2; x < size; ++x) {
+            for (int c = 0; c < 4; ++c) {
+                data[(y * size + x) * 4 + c] = 255;
+            }
+        }
+    }
+
+    ASSERT_TRUE(TileMipChain::Build(data.data(), size, 4, 4, TileTextureFormat::RGBA8,
+                                    data.size()));
+
+    // Level 2 (2x2) keeps the split, level 3 (1x1) is mid gray
+    const std::size_t level2 = TileMipChain::GetLevelOffset(TileTextureFormat::RGBA8, size, 2);
+    EXPECT_EQ(data[level2 + 0], 0);
+    EXPECT_EQ(data[level2 + 4], 255);
+    const std::size_t level3 = TileMipChain::GetLevelOffset(TileTextureFormat::RGBA8, size, 3);
+    EXPECT_EQ(data[level3], 128);
+
+    // No room for the chain, or more levels than the size allows
+    EXPECT_FALSE(TileMipChain::Build(data.data(), size, 4, 4, TileTextureFormat::RGBA8,
+                                     size * size * 4));
+    EXPECT_FALSE(TileMipChain::Build(data.data(), size, 4, 5, TileTextureFormat::RGBA8,
+                                     data.size()));
+}
+
+TEST(TileMipChainTest, Bc1ChainMatchesCompressedLevels) {
+    const std::uint32_t size = 16;
+    const std::uint32_t levels = TileMipChain::GetMaxLevels(TileTextureFormat::BC1, size);
+    ASSERT_EQ(levels, 3u);
+
+    std::vector<std::uint8_t> pixels(size * size * 4);
+    for (std::uint32_t i = 0; i < size * size; ++i) {
+        pixels[i * 4 + 0] = static_cast<std::uint8_t>(i % size * 16);
+        pixels[i * 4 + 1] = static_cast<std::uint8_t>(i / size * 16);
+        pixels[i * 4 + 2] = 64;
+        pixels[i * 4 + 3] = 255;
+    }
+
+    // Reference: downsample and compress each level separately
+    std::vector<std::uint8_t> expected;
+    std::vector<std::uint8_t> level = pixels;
+    for (std::uint32_t l = 0; l < levels; ++l) {
+        const std::uint32_t level_size = size >> l;
+        std::vector<std::uint8_t> blocks(
+            TileBlockCompressor::GetEncodedSize(TileTextureFormat::BC1, level_size, level_size));
+        ASSERT_TRUE(TileBlockCompressor::CompressBC1(level.data(), level_size, level_size, 4,
+                                                     blocks.data(), blocks.size()));
+        expected.insert(expected.end(), blocks.begin(), blocks.end());
+
+        std::vector<std::uint8_t> next(level.size() / 4);
+        TileMipChain::Downsample(level.data(), level_size, 4, next.data());
+        level = std::move(next);
+    }
+
+    std::vector<std::uint8_t> data(
+        TileMipChain::GetLevelOffset(TileTextureFormat::RGBA8, size, levels));
+    std::copy(pixels.begin(), pixels.end(), data.begin());
+    ASSERT_TRUE(TileMipChain::Build(data.data(), size, 4, levels, TileTextureFormat::BC1,
+                                    data.size()));
+
+    ASSERT_EQ(expected.size(), TileMipChain::GetLevelOffset(TileTextureFormat::BC1, size, levels));
+    EXPECT_TRUE(std::equal(expected.begin(), expected.end(), data.begin()));
+}
+
+} // namespace earth_map::tests
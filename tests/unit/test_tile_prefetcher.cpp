@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/tile_prefetcher.h>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+constexpr int kZoom = 10;
+
+int FixedZoom(float /*camera_distance*/) {
+    return kZoom;
+}
+
+/// Square of tiles around a center tile at the same zoom
+std::vector<TileCoordinates> Window(const TileCoordinates& center, int radius) {
+    std::vector<TileCoordinates> tiles;
+    for (int dy = -radius; dy <= radius; ++dy) {
+        for (int dx = -radius; dx <= radius; ++dx) {
+            tiles.emplace_back(center.x + dx, center.y + dy, center.zoom);
+        }
+    }
+    return tiles;
+}
+
+bool Contains(const std::vector<TileCoordinates>& tiles, const TileCoordinates& tile) {
+    return std::find(tiles.begin(), tiles.end(), tile) != tiles.end();
+}
+
+} // namespace
+
+class TilePrefetcherTest : public ::testing::Test {
+protected:
+    const glm::vec3 camera_{0.0f, 0.0f, 1.01f};  // Over lon 0, lat 0
+    const TileCoordinates center_ = TilePrefetcher::WorldToTile(camera_, kZoom);
+};
+
+TEST_F(TilePrefetcherTest, RejectsEmptyZoomFunction) {
+    EXPECT_THROW(TilePrefetcher(TilePrefetchConfig{}, nullptr), std::invalid_argument);
+}
+
+TEST_F(TilePrefetcherTest, WorldToTileUsesXyzConvention) {
+    EXPECT_EQ(TilePrefetcher::WorldToTile(glm::vec3(0.0f, 0.0f, 2.0f), 1),
+              TileCoordinates(1, 1, 1));
+    // North-west quadrant: x = -1 is longitude -90, y > 0 is north
+    EXPECT_EQ(TilePrefetcher::WorldToTile(glm::vec3(-1.0f, 0.5f, 0.0f), 2),
+              TileCoordinates(1, 1, 2));
+}
+
+TEST_F(TilePrefetcherTest, StillCameraPrefetchesParentAndChildLevels) {
+    TilePrefetcher prefetcher(TilePrefetchConfig{}, FixedZoom);
+    const auto visible = Window(center_, 2);
+
+    const auto tiles = prefetcher.Update(camera_, glm::vec3(0.0f), 0.5f, visible);
+
+    ASSERT_FALSE(tiles.empty());
+    EXPECT_TRUE(Contains(tiles, center_.GetParent()));
+    for (const auto& child : center_.GetChildren()) {
+        EXPECT_TRUE(Contains(tiles, child));
+    }
+    for (const auto& tile : tiles) {
+        EXPECT_NE(tile.zoom, kZoom);
+        EXPECT_FALSE(Contains(visible, tile));
+    }
+}
+
+TEST_F(TilePrefetcherTest, MovingCameraPrefetchesAhead) {
+    TilePrefetchConfig config;
+    config.prefetch_parent_level = false;
+    config.prefetch_child_level = false;
+    TilePrefetcher prefetcher(config, FixedZoom);
+    const auto visible = Window(center_, 1);
+
+    // Eastward: about 0.1 radians over the lookahead, several z10 tiles
+    const glm::vec3 velocity(0.15f, 0.0f, 0.0f);
+    const auto tiles = prefetcher.Update(camera_, velocity, 0.5f, visible);
+
+    ASSERT_FALSE(tiles.empty());
+    const glm::vec3 predicted = camera_ + velocity * config.lookahead_seconds;
+    EXPECT_TRUE(Contains(tiles, TilePrefetcher::WorldToTile(predicted, kZoom)));
+    for (const auto& tile : tiles) {
+        EXPECT_EQ(tile.zoom, kZoom);
+        EXPECT_GE(tile.x, center_.x);
+        EXPECT_FALSE(Contains(visible, tile));
+    }
+}
+
+TEST_F(TilePrefetcherTest, BandwidthBudgetLimitsNewTiles) {
+    TilePrefetchConfig config;
+    config.max_tiles_per_second = 10;
+    TilePrefetcher prefetcher(config, FixedZoom);
+    const auto visible = Window(center_, 2);
+
+    const auto first = prefetcher.Update(camera_, glm::vec3(0.0f), 0.5f, visible);
+    EXPECT_EQ(first.size(), 5u);
+    EXPECT_EQ(prefetcher.GetStats().admitted_tiles, 5u);
+    EXPECT_GT(prefetcher.GetStats().deferred_tiles, 0u);
+
+    // No time has passed: the admitted tiles are renewed, nothing new is added
+    const auto second = prefetcher.Update(camera_, glm::vec3(0.0f), 0.0f, visible);
+    EXPECT_EQ(second, first);
+    EXPECT_EQ(prefetcher.GetStats().admitted_tiles, 5u);
+}
+
+TEST_F(TilePrefetcherTest, MemoryBudgetCapsWorkingSet) {
+    TilePrefetchConfig config;
+    config.memory_budget_bytes = 4 * config.tile_bytes;
+    TilePrefetcher prefetcher(config, FixedZoom);
+
+    const auto tiles = prefetcher.Update(camera_, glm::vec3(0.15f, 0.0f, 0.0f), 1.0f,
+                                         Window(center_, 1));
+    EXPECT_EQ(tiles.size(), 4u);
+    EXPECT_EQ(prefetcher.GetStats().active_tiles, 4u);
+}
+
+TEST_F(TilePrefetcherTest, DestinationPrefetchesPathAndFootprint) {
+    TilePrefetcher prefetcher(TilePrefetchConfig{}, FixedZoom);
+    const glm::vec3 destination(1.01f, 0.0f, 0.0f);  // Over lon 90
+    prefetcher.SetDestination(destination, 2.0f);
+
+    const auto tiles = prefetcher.Update(camera_, glm::vec3(0.0f), 0.1f, Window(center_, 1));
+    EXPECT_TRUE(Contains(tiles, TilePrefetcher::WorldToTile(destination, kZoom)));
+    EXPECT_TRUE(prefetcher.HasDestination());
+
+    // Arrival clears the destination
+    prefetcher.Update(destination, glm::vec3(0.0f), 0.1f, {});
+    EXPECT_FALSE(prefetcher.HasDestination());
+}
+
+TEST_F(TilePrefetcherTest, DisabledPrefetchRequestsNothing) {
+    TilePrefetchConfig config;
+    config.enabled = false;
+    TilePrefetcher prefetcher(config, FixedZoom);
+
+    EXPECT_TRUE(prefetcher.Update(camera_, glm::vec3(0.2f, 0.0f, 0.0f), 1.0f,
+                                  Window(center_, 1)).empty());
+    EXPECT_EQ(prefetcher.GetStats().active_tiles, 0u);
+}
+
+} // namespace earth_map::tests
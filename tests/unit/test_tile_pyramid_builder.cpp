@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/texture_atlas/tile_pyramid_builder.h>
+#include <cstdint>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+/// 2x2 RGBA image filled with one value per channel
+DecodedImage MakeSolidImage(std::uint8_t value) {
+    DecodedImage image;
+    image.width = 2;
+    image.height = 2;
+    image.channels = 4;
+    image.pixels.assign(2 * 2 * 4, value);
+    return image;
+}
+
+} // namespace
+
+TEST(TilePyramidBuilderTest, ChildrenBecomeQuadrantsOfParent) {
+    const DecodedImage top_left = MakeSolidImage(10);
+    const DecodedImage top_right = MakeSolidImage(20);
+    const DecodedImage bottom_left = MakeSolidImage(30);
+    const DecodedImage bottom_right = MakeSolidImage(40);
+    std::vector<std::uint8_t> parent(2 * 2 * 4, 0);
+
+    ASSERT_TRUE(TilePyramidBuilder::BuildParent(
+        {&top_left, &top_right, &bottom_left, &bottom_right}, parent.data(), parent.size()));
+
+    // One parent pixel per child (row-major, 4 channels)
+    EXPECT_EQ(parent[0], 10);
+    EXPECT_EQ(parent[4], 20);
+    EXPECT_EQ(parent[8], 30);
+    EXPECT_EQ(parent[12], 40);
+}
+
+TEST(TilePyramidBuilderTest, AveragesTwoByTwoBlocks) {
+    DecodedImage child = MakeSolidImage(0);
+    child.pixels[0] = 255;  // One of four samples in the block
+    const DecodedImage other = MakeSolidImage(0);
+    std::vector<std::uint8_t> parent(2 * 2 * 4, 0);
+
+    ASSERT_TRUE(TilePyramidBuilder::BuildParent(
+        {&child, &other, &other, &other}, parent.data(), parent.size()));
+    EXPECT_EQ(parent[0], 64);  // round(255 / 4)
+    EXPECT_EQ(parent[1], 0);
+}
+
+TEST(TilePyramidBuilderTest, RejectsMismatchedChildren) {
+    const DecodedImage child = MakeSolidImage(1);
+    DecodedImage larger = MakeSolidImage(1);
+    larger.width = 4;
+    larger.pixels.resize(4 * 2 * 4);
+    std::vector<std::uint8_t> parent(2 * 2 * 4, 0);
+
+    EXPECT_FALSE(TilePyramidBuilder::BuildParent(
+        {&child, &child, &child, &larger}, parent.data(), parent.size()));
+    EXPECT_FALSE(TilePyramidBuilder::BuildParent(
+        {&child, &child, &child, nullptr}, parent.data(), parent.size()));
+    EXPECT_FALSE(TilePyramidBuilder::BuildParent(
+        {&child, &child, &child, &child}, parent.data(), parent.size() - 1));
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,53 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/tile_request_merger.h>
+#include <stdexcept>
+#include <vector>
+
+namespace earth_map::tests {
+
+TEST(TileRequestMergerTest, DuplicatesKeepTheBestPriority) {
+    TileRequestMerger merger;
+    const std::vector<TileCoordinates> main_view = {{1, 1, 5}, {2, 1, 5}, {3, 1, 5}};
+    const std::vector<TileCoordinates> overview = {{2, 1, 5}, {0, 0, 2}};
+    merger.Submit(main_view, 30);
+    merger.Submit(overview, 10);
+
+    const std::vector<MergedTileRequest> merged = merger.TakeMerged();
+    ASSERT_EQ(merged.size(), 4u);
+    // Lowest priority first, zoom then row then column within a priority
+    EXPECT_EQ(merged[0].coords, TileCoordinates(0, 0, 2));
+    EXPECT_EQ(merged[0].priority, 10);
+    EXPECT_EQ(merged[1].coords, TileCoordinates(2, 1, 5));
+    EXPECT_EQ(merged[1].priority, 10);
+    EXPECT_EQ(merged[2].coords, TileCoordinates(1, 1, 5));
+    EXPECT_EQ(merged[2].priority, 30);
+
+    const TileRequestMergeStats stats = merger.GetStats();
+    EXPECT_EQ(stats.submitted_tiles, 5u);
+    EXPECT_EQ(stats.unique_tiles, 4u);
+    EXPECT_EQ(stats.merged_duplicates, 1u);
+}
+
+TEST(TileRequestMergerTest, WeightScalesPriority) {
+    TileRequestMerger merger;
+    const std::vector<TileCoordinates> tiles = {{4, 4, 6}};
+    merger.Submit(tiles, 40, 0.5f);
+    EXPECT_EQ(merger.TakeMerged().front().priority, 80);
+
+    merger.Submit(tiles, 40, 0.5f);
+    merger.Submit(tiles, 40, 4.0f);
+    EXPECT_EQ(merger.TakeMerged().front().priority, 10);
+
+    EXPECT_THROW(merger.Submit(tiles, 40, 0.0f), std::invalid_argument);
+}
+
+TEST(TileRequestMergerTest, FramesStartEmpty) {
+    TileRequestMerger merger;
+    const std::vector<TileCoordinates> tiles = {{0, 0, 1}, {1, 0, 1}};
+    merger.Submit(tiles, 5);
+    EXPECT_EQ(merger.Flush(), 2u);  // No coordinator: discarded
+    EXPECT_TRUE(merger.TakeMerged().empty());
+    EXPECT_EQ(merger.GetStats().submitted_tiles, 0u);
+}
+
+} // namespace earth_map::tests
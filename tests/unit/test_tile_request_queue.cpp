@@ -0,0 +1,141 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/texture_atlas/tile_request_queue.h>
+#include <algorithm>
+#include <vector>
+
+namespace earth_map::tests {
+
+/**
+ * @brief Test fixture for TileRequestQueue
+ */
+class TileRequestQueueTest : public ::testing::Test {
+protected:
+    /**
+     * @brief Pop every request and return their coordinates in order
+     */
+    std::vector<TileCoordinates> Drain() {
+        std::vector<TileCoordinates> order;
+        while (auto request = queue_.Pop()) {
+            order.push_back(request->coords);
+        }
+        return order;
+    }
+
+    TileRequestQueue queue_;
+};
+
+TEST_F(TileRequestQueueTest, EmptyQueue) {
+    EXPECT_TRUE(queue_.Empty());
+    EXPECT_EQ(queue_.Size(), 0u);
+    EXPECT_FALSE(queue_.Pop().has_value());
+}
+
+TEST_F(TileRequestQueueTest, PopsLowestPriorityNumberFirst) {
+    queue_.Push(TileLoadRequest(TileCoordinates(0, 0, 5), 30));
+    queue_.Push(TileLoadRequest(TileCoordinates(1, 1, 5), 10));
+    queue_.Push(TileLoadRequest(TileCoordinates(2, 2, 5), 20));
+
+    const auto order = Drain();
+    ASSERT_EQ(order.size(), 3u);
+    EXPECT_EQ(order[0], TileCoordinates(1, 1, 5));
+    EXPECT_EQ(order[1], TileCoordinates(2, 2, 5));
+    EXPECT_EQ(order[2], TileCoordinates(0, 0, 5));
+}
+
+TEST_F(TileRequestQueueTest, EqualPriorityIsFifo) {
+    for (int i = 0; i < 10; ++i) {
+        queue_.Push(TileLoadRequest(TileCoordinates(i, 0, 5), 0));
+    }
+
+    const auto order = Drain();
+    ASSERT_EQ(order.size(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(order[i].x, i);
+    }
+}
+
+TEST_F(TileRequestQueueTest, NewerGenerationWinsPriorityTie) {
+    queue_.Push(TileLoadRequest(TileCoordinates(0, 0, 5), 0, nullptr, 1));
+    queue_.Push(TileLoadRequest(TileCoordinates(1, 0, 5), 0, nullptr, 2));
+
+    auto first = queue_.Pop();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->coords, TileCoordinates(1, 0, 5));
+}
+
+TEST_F(TileRequestQueueTest, PushDeduplicatesAndRefreshes) {
+    int callback_calls = 0;
+    const TileCoordinates tile(3, 3, 5);
+
+    EXPECT_TRUE(queue_.Push(TileLoadRequest(tile, 50, [&](const TileCoordinates&) {
+        ++callback_calls;
+    })));
+    queue_.Push(TileLoadRequest(TileCoordinates(4, 4, 5), 10));
+    EXPECT_FALSE(queue_.Push(TileLoadRequest(tile, 0, nullptr, 7)));
+
+    EXPECT_EQ(queue_.Size(), 2u);
+
+    auto first = queue_.Pop();
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->coords, tile);
+    EXPECT_EQ(first->priority, 0);
+    EXPECT_EQ(first->generation, 7u);
+
+    // Original callback survives a refresh without one
+    ASSERT_TRUE(first->on_complete);
+    first->on_complete(first->coords);
+    EXPECT_EQ(callback_calls, 1);
+}
+
+TEST_F(TileRequestQueueTest, UpdatePriorityReorders) {
+    for (int i = 0; i < 8; ++i) {
+        queue_.Push(TileLoadRequest(TileCoordinates(i, 0, 5), 10 + i));
+    }
+
+    EXPECT_TRUE(queue_.UpdatePriority(TileCoordinates(7, 0, 5), 0));
+    EXPECT_TRUE(queue_.UpdatePriority(TileCoordinates(0, 0, 5), 100));
+    EXPECT_FALSE(queue_.UpdatePriority(TileCoordinates(99, 0, 5), 0));
+
+    const auto order = Drain();
+    ASSERT_EQ(order.size(), 8u);
+    EXPECT_EQ(order.front(), TileCoordinates(7, 0, 5));
+    EXPECT_EQ(order.back(), TileCoordinates(0, 0, 5));
+}
+
+TEST_F(TileRequestQueueTest, CancelRemovesEntry) {
+    for (int i = 0; i < 8; ++i) {
+        queue_.Push(TileLoadRequest(TileCoordinates(i, 0, 5), i));
+    }
+
+    EXPECT_TRUE(queue_.Cancel(TileCoordinates(3, 0, 5)));
+    EXPECT_FALSE(queue_.Cancel(TileCoordinates(3, 0, 5)));
+    EXPECT_FALSE(queue_.Contains(TileCoordinates(3, 0, 5)));
+    EXPECT_EQ(queue_.Size(), 7u);
+
+    const auto order = Drain();
+    ASSERT_EQ(order.size(), 7u);
+    EXPECT_TRUE(std::is_sorted(order.begin(), order.end(),
+        [](const TileCoordinates& a, const TileCoordinates& b) { return a.x < b.x; }));
+}
+
+TEST_F(TileRequestQueueTest, DropOlderThanKeepsCurrentGeneration) {
+    for (int i = 0; i < 10; ++i) {
+        queue_.Push(TileLoadRequest(TileCoordinates(i, 0, 5), 10 - i, nullptr, i % 2 ? 2 : 1));
+    }
+
+    auto dropped = queue_.DropOlderThan(2);
+
+    EXPECT_EQ(dropped.size(), 5u);
+    for (const auto& coords : dropped) {
+        EXPECT_EQ(coords.x % 2, 0);
+        EXPECT_FALSE(queue_.Contains(coords));
+    }
+
+    // Heap order still valid for survivors
+    const auto order = Drain();
+    ASSERT_EQ(order.size(), 5u);
+    EXPECT_EQ(order.front(), TileCoordinates(9, 0, 5));
+    EXPECT_EQ(order.back(), TileCoordinates(1, 0, 5));
+}
+
+} // namespace earth_map::tests
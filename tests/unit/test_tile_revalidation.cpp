@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/tile_cache.h>
+#include <earth_map/data/tile_loader.h>
+#include "loopback_http_server.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+namespace earth_map::tests {
+
+/**
+ * @brief Build a raw HTTP response
+ */
+std::string MakeResponse(const std::string& status, const std::string& etag,
+                         const std::string& cache_control, const std::string& body = "",
+                         const std::string& last_modified = "") {
+    return "HTTP/1.1 " + status + "\r\n"
+           "ETag: " + etag + "\r\n"
+           "Cache-Control: " + cache_control + "\r\n" +
+           (last_modified.empty() ? "" : "Last-Modified: " + last_modified + "\r\n") +
+           "Content-Length: " + std::to_string(body.size()) + "\r\n"
+           "Connection: close\r\n\r\n" + body;
+}
+
+/// Server validator, deliberately far from the local clock
+const std::string kLastModified = "Wed, 21 Oct 2015 07:28:00 GMT";
+
+/**
+ * @brief Test fixture wiring a loader and a disk cache to a loopback server
+ */
+class TileRevalidationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() /
+                     (std::string("earth_map_revalidation_") +
+                      ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(directory_);
+    }
+
+    void TearDown() override {
+        loader_.reset();
+        cache_.reset();
+        std::filesystem::remove_all(directory_);
+    }
+
+    void Start(const std::string& base_url) {
+        TileCacheConfig cache_config;
+        cache_config.disk_cache_directory = directory_.string();
+        cache_ = CreateTileCache(cache_config);
+        ASSERT_TRUE(cache_->Initialize(cache_config));
+
+        TileLoaderConfig loader_config;
+        loader_ = CreateTileLoader(loader_config);
+        ASSERT_TRUE(loader_->Initialize(loader_config));
+        loader_->SetTileCache(cache_);
+        ASSERT_TRUE(loader_->AddProvider(std::make_shared<BasicXYZTileProvider>(
+            "Loopback", base_url + "/{z}/{x}/{y}.png")));
+        ASSERT_TRUE(loader_->SetDefaultProvider("Loopback"));
+    }
+
+    /**
+     * @brief Wait until the loader has no revalidation in flight
+     */
+    bool WaitForRevalidation(std::size_t completed) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (std::chrono::steady_clock::now() < deadline) {
+            const auto stats = loader_->GetStatistics();
+            if (stats.not_modified_responses + stats.successful_requests +
+                    stats.failed_requests >= completed) {
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+
+    static std::string ToString(const TileLoadResult& result) {
+        return std::string(result.tile_data->data.begin(), result.tile_data->data.end());
+    }
+
+    std::filesystem::path directory_;
+    std::shared_ptr<TileCache> cache_;
+    std::unique_ptr<TileLoader> loader_;
+};
+
+TEST_F(TileRevalidationTest, NotModifiedOnlyExtendsExpiry) {
+    LoopbackHttpServer server([](const std::string& request) {
+        if (request.find("If-None-Match: \"v1\"") != std::string::npos) {
+            return MakeResponse("304 Not Modified", "\"v1\"", "max-age=3600");
+        }
+        return MakeResponse("200 OK", "\"v1\"", "max-age=0", "tile-v1", kLastModified);
+    });
+    Start(server.BaseUrl());
+    const TileCoordinates coords(1, 2, 3);
+
+    auto first = loader_->LoadTile(coords);
+    ASSERT_TRUE(first.success) << first.error_message;
+    EXPECT_EQ(first.tile_data->metadata.etag, "\"v1\"");
+
+    // Expired (max-age=0): served from cache, revalidated in the background
+    auto second = loader_->LoadTile(coords);
+    ASSERT_TRUE(second.success);
+    EXPECT_EQ(ToString(second), "tile-v1");
+    ASSERT_TRUE(WaitForRevalidation(2));
+
+    auto stats = loader_->GetStatistics();
+    EXPECT_EQ(stats.revalidation_requests, 1u);
+    EXPECT_EQ(stats.not_modified_responses, 1u);
+    EXPECT_EQ(stats.total_bytes_downloaded, 7u);
+
+    const auto requests = server.GetRequests();
+    ASSERT_EQ(requests.size(), 2u);
+    EXPECT_EQ(requests[0].find("If-None-Match"), std::string::npos);
+    EXPECT_NE(requests[1].find("If-None-Match: \"v1\""), std::string::npos);
+    EXPECT_NE(requests[1].find("If-Modified-Since: " + kLastModified), std::string::npos);
+
+    // Fresh again: no further request
+    auto third = loader_->LoadTile(coords);
+    ASSERT_TRUE(third.success);
+    EXPECT_GT(third.tile_data->metadata.expires_at,
+              std::chrono::system_clock::now() + std::chrono::minutes(50));
+    EXPECT_EQ(server.GetRequests().size(), 2u);
+
+    auto metadata = cache_->GetMetadata(coords);
+    ASSERT_NE(metadata, nullptr);
+    EXPECT_GT(metadata->expires_at, std::chrono::system_clock::now() + std::chrono::minutes(50));
+    EXPECT_EQ(metadata->server_last_modified, kLastModified);
+}
+
+TEST_F(TileRevalidationTest, NoValidatorWithoutLastModified) {
+    LoopbackHttpServer server([](const std::string&) {
+        return MakeResponse("200 OK", "\"v1\"", "max-age=0", "tile-v1");
+    });
+    Start(server.BaseUrl());
+    const TileCoordinates coords(2, 2, 3);
+
+    ASSERT_TRUE(loader_->LoadTile(coords).success);
+    ASSERT_TRUE(loader_->LoadTile(coords).success);
+    ASSERT_TRUE(WaitForRevalidation(2));
+
+    // The local fetch time is not a server validator
+    const auto requests = server.GetRequests();
+    ASSERT_EQ(requests.size(), 2u);
+    EXPECT_NE(requests[1].find("If-None-Match: \"v1\""), std::string::npos);
+    EXPECT_EQ(requests[1].find("If-Modified-Since"), std::string::npos);
+}
+
+TEST_F(TileRevalidationTest, NoStoreResponsesAreNotCached) {
+    LoopbackHttpServer server([](const std::string&) {
+        return MakeResponse("200 OK", "\"v1\"", "private, no-store", "tile-v1");
+    });
+    Start(server.BaseUrl());
+    const TileCoordinates coords(3, 3, 3);
+
+    auto first = loader_->LoadTile(coords);
+    ASSERT_TRUE(first.success) << first.error_message;
+    EXPECT_EQ(ToString(first), "tile-v1");
+    cache_->Flush();
+    EXPECT_FALSE(cache_->Contains(coords));
+
+    ASSERT_TRUE(loader_->LoadTile(coords).success);
+    EXPECT_EQ(server.GetRequests().size(), 2u);
+}
+
+TEST_F(TileRevalidationTest, ChangedTileReplacesCachedCopy) {
+    std::atomic<int> version{1};
+    LoopbackHttpServer server([&version](const std::string& request) {
+        const std::string etag = "\"v" + std::to_string(version.load()) + "\"";
+        if (request.find("If-None-Match: " + etag) != std::string::npos) {
+            return MakeResponse("304 Not Modified", etag, "max-age=0");
+        }
+        return MakeResponse("200 OK", etag, "max-age=0", "tile-" + etag);
+    });
+    Start(server.BaseUrl());
+    const TileCoordinates coords(4, 5, 6);
+
+    ASSERT_TRUE(loader_->LoadTile(coords).success);
+    version = 2;
+
+    auto stale = loader_->LoadTile(coords);
+    ASSERT_TRUE(stale.success);
+    EXPECT_EQ(ToString(stale), "tile-\"v1\"");
+    ASSERT_TRUE(WaitForRevalidation(2));
+
+    auto cached = cache_->Get(coords);
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_EQ(std::string(cached->data.begin(), cached->data.end()), "tile-\"v2\"");
+    EXPECT_EQ(cached->metadata.etag, "\"v2\"");
+    EXPECT_EQ(loader_->GetStatistics().not_modified_responses, 0u);
+}
+
+TEST_F(TileRevalidationTest, DisabledRevalidationServesCacheOnly) {
+    LoopbackHttpServer server([](const std::string&) {
+        return MakeResponse("200 OK", "\"v1\"", "no-cache", "tile-v1");
+    });
+    Start(server.BaseUrl());
+    TileLoaderConfig config = loader_->GetConfiguration();
+    config.enable_revalidation = false;
+    ASSERT_TRUE(loader_->SetConfiguration(config));
+    const TileCoordinates coords(0, 0, 1);
+
+    ASSERT_TRUE(loader_->LoadTile(coords).success);
+    ASSERT_TRUE(loader_->LoadTile(coords).success);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    EXPECT_EQ(server.GetRequests().size(), 1u);
+    EXPECT_EQ(loader_->GetStatistics().revalidation_requests, 0u);
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,168 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/tile_seeder.h>
+#include <earth_map/data/tile_cache.h>
+#include "loopback_http_server.h"
+#include <chrono>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+
+namespace earth_map::tests {
+
+namespace {
+
+/// Responds with the request path as the tile body, 404 for zoom 9
+std::string TileResponse(const std::string& request) {
+    const std::size_t start = request.find(' ') + 1;
+    const std::string path = request.substr(start, request.find(' ', start) - start);
+    if (path.rfind("/9/", 0) == 0) {
+        return "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\nConnection: close\r\n\r\n";
+    }
+    return "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(path.size()) +
+           "\r\nConnection: close\r\n\r\n" + path;
+}
+
+const GeographicBounds kRegion(Geographic(-10.0, -10.0), Geographic(10.0, 10.0));
+
+} // namespace
+
+class TileSeederTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() /
+                     (std::string("earth_map_seed_") +
+                      ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(directory_);
+        server_ = std::make_unique<LoopbackHttpServer>(TileResponse);
+
+        TileLoaderConfig loader_config;
+        loader_config.max_retries = 0;
+        loader_ = CreateTileLoader(loader_config);
+        ASSERT_TRUE(loader_->Initialize(loader_config));
+        ASSERT_TRUE(loader_->AddProvider(std::make_shared<BasicXYZTileProvider>(
+            "Loopback", server_->BaseUrl() + "/{z}/{x}/{y}.png")));
+        ASSERT_TRUE(loader_->SetDefaultProvider("Loopback"));
+
+        PackedTileStoreConfig store_config;
+        store_config.directory = (directory_ / "packed").string();
+        store_config.background_compaction = false;
+        store_ = std::make_shared<PackedTileStore>(store_config);
+        ASSERT_TRUE(store_->Open());
+
+        config_.max_requests_per_second = 0.0;
+    }
+
+    void TearDown() override {
+        store_.reset();
+        loader_.reset();
+        server_.reset();
+        std::filesystem::remove_all(directory_);
+    }
+
+    std::filesystem::path directory_;
+    std::unique_ptr<LoopbackHttpServer> server_;
+    std::shared_ptr<TileLoader> loader_;
+    std::shared_ptr<PackedTileStore> store_;
+    TileSeedConfig config_;
+};
+
+TEST_F(TileSeederTest, RejectsNullDependencies) {
+    EXPECT_THROW(TileSeeder(nullptr, store_), std::invalid_argument);
+    EXPECT_THROW(TileSeeder(loader_, nullptr), std::invalid_argument);
+}
+
+TEST_F(TileSeederTest, EnumeratesRegionAcrossZoomLevels) {
+    const auto tiles = TileSeeder::EnumerateTiles(kRegion, 0, 3);
+    // 1 + 4 + 4 + 4: the region straddles the equator and prime meridian
+    EXPECT_EQ(tiles.size(), 13u);
+    EXPECT_EQ(tiles.front(), TileCoordinates(0, 0, 0));
+    EXPECT_TRUE(TileSeeder::EnumerateTiles(GeographicBounds(), 0, 3).empty());
+
+    // Polar latitudes are clamped to the Web Mercator range
+    const GeographicBounds world(Geographic(-90.0, -180.0), Geographic(90.0, 180.0));
+    EXPECT_EQ(TileSeeder::EnumerateTiles(world, 2, 2).size(), 16u);
+}
+
+TEST_F(TileSeederTest, SeedsIntoStoreAndResumes) {
+    TileSeeder seeder(loader_, store_, config_);
+
+    const TileSeedStats first = seeder.Seed(kRegion, 0, 3);
+    EXPECT_EQ(first.total_tiles, 13u);
+    EXPECT_EQ(first.downloaded_tiles, 13u);
+    EXPECT_EQ(first.failed_tiles, 0u);
+    EXPECT_FALSE(first.cancelled);
+
+    auto view = store_->Get(TileCoordinates(1, 1, 1));
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(std::string(view->Data().begin(), view->Data().end()), "/1/1/1.png");
+
+    // Everything is stored: a second run downloads nothing
+    const TileSeedStats second = seeder.Seed(kRegion, 0, 3);
+    EXPECT_EQ(second.skipped_tiles, 13u);
+    EXPECT_EQ(second.downloaded_tiles, 0u);
+    EXPECT_EQ(server_->GetRequests().size(), 13u);
+}
+
+TEST_F(TileSeederTest, CancelledSeedResumesWhereItStopped) {
+    config_.write_batch_size = 2;
+    TileSeeder seeder(loader_, store_, config_);
+
+    const TileSeedStats cancelled = seeder.Seed(kRegion, 0, 3,
+        [&seeder](const TileSeedStats& progress) {
+            if (progress.downloaded_tiles == 3) {
+                seeder.Cancel();
+            }
+        });
+    EXPECT_TRUE(cancelled.cancelled);
+    EXPECT_LT(cancelled.downloaded_tiles, 13u);
+    EXPECT_EQ(store_->GetStats().tile_count, cancelled.downloaded_tiles);
+
+    const TileSeedStats resumed = seeder.Seed(kRegion, 0, 3);
+    EXPECT_FALSE(resumed.cancelled);
+    EXPECT_EQ(resumed.skipped_tiles, cancelled.downloaded_tiles);
+    EXPECT_EQ(resumed.skipped_tiles + resumed.downloaded_tiles, 13u);
+    EXPECT_EQ(store_->GetStats().tile_count, 13u);
+}
+
+TEST_F(TileSeederTest, RecordsFailedTiles) {
+    TileSeeder seeder(loader_, store_, config_);
+
+    const TileSeedStats stats = seeder.Seed(
+        {TileCoordinates(0, 0, 1), TileCoordinates(5, 5, 9), TileCoordinates(1, 0, 1)});
+    EXPECT_EQ(stats.downloaded_tiles, 2u);
+    EXPECT_EQ(stats.failed_tiles, 1u);
+    ASSERT_EQ(stats.failures.size(), 1u);
+    EXPECT_EQ(stats.failures.front(), TileCoordinates(5, 5, 9));
+    EXPECT_FALSE(store_->Contains(TileCoordinates(5, 5, 9)));
+}
+
+TEST_F(TileSeederTest, RateLimitSpacesDownloads) {
+    config_.max_requests_per_second = 20.0;
+    TileSeeder seeder(loader_, store_, config_);
+
+    const auto start = std::chrono::steady_clock::now();
+    const TileSeedStats stats = seeder.Seed(TileSeeder::EnumerateTiles(kRegion, 1, 1));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ(stats.downloaded_tiles, 4u);
+    // Four starts at 20/s are at least three intervals of 50 ms apart
+    EXPECT_GE(elapsed, std::chrono::milliseconds(150));
+}
+
+TEST_F(TileSeederTest, SeededTilesServeFromPackedCache) {
+    TileSeeder seeder(loader_, store_, config_);
+    ASSERT_EQ(seeder.Seed(kRegion, 0, 1).downloaded_tiles, 5u);
+    store_->Close();
+
+    TileCacheConfig cache_config;
+    cache_config.disk_cache_directory = directory_.string();
+    cache_config.disk_backend = TileCacheConfig::DiskBackend::PACKED;
+    auto cache = CreateTileCache(cache_config);
+    ASSERT_TRUE(cache->Initialize(cache_config));
+
+    auto tile = cache->Get(TileCoordinates(0, 1, 1));
+    ASSERT_TRUE(tile.has_value());
+    EXPECT_EQ(std::string(tile->data.begin(), tile->data.end()), "/1/0/1.png");
+}
+
+} // namespace earth_map::tests
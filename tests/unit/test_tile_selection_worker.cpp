@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/tile_selection_worker.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+FrameSnapshot MakeSnapshot(const glm::vec3& eye) {
+    FrameSnapshot snapshot;
+    snapshot.view = glm::lookAt(eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    snapshot.projection = glm::perspective(glm::radians(45.0f), 1.5f, 0.01f, 10.0f);
+    snapshot.camera_position = eye;
+    return snapshot;
+}
+
+/// Selects one tile whose x is the zoom level and whose y marks the snapshot
+void SelectMarker(const FrameSnapshot& snapshot, int zoom_level,
+                  std::pmr::vector<TileCoordinates>& tiles) {
+    tiles.clear();
+    tiles.push_back(TileCoordinates(zoom_level, static_cast<int>(snapshot.camera_position.x),
+                                    zoom_level));
+}
+
+} // namespace
+
+TEST(TileSelectionWorkerTest, RejectsEmptySelectFunction) {
+    EXPECT_THROW(TileSelectionWorker(TileSelectionWorker::SelectFn{}), std::invalid_argument);
+}
+
+TEST(TileSelectionWorkerTest, MatchingCameraTakesSelection) {
+    TileSelectionWorker worker(SelectMarker);
+    const FrameSnapshot snapshot = MakeSnapshot(glm::vec3(3.0f, 0.0f, 2.0f));
+    worker.Start(snapshot, 7);
+    EXPECT_TRUE(worker.HasSelection());
+
+    const std::pmr::vector<TileCoordinates>* tiles =
+        worker.Take(snapshot.view, snapshot.projection, snapshot.camera_position);
+    ASSERT_NE(tiles, nullptr);
+    ASSERT_EQ(tiles->size(), 1u);
+    EXPECT_EQ((*tiles)[0], TileCoordinates(7, 3, 7));
+
+    // Taken once: the next frame without a Start() selects inline
+    EXPECT_FALSE(worker.HasSelection());
+    EXPECT_EQ(worker.Take(snapshot.view, snapshot.projection, snapshot.camera_position),
+              nullptr);
+}
+
+TEST(TileSelectionWorkerTest, DifferentCameraFallsBack) {
+    TileSelectionWorker worker(SelectMarker);
+    const FrameSnapshot snapshot = MakeSnapshot(glm::vec3(3.0f, 0.0f, 2.0f));
+    const FrameSnapshot moved = MakeSnapshot(glm::vec3(3.0f, 0.5f, 2.0f));
+
+    // Each of view, projection and position alone invalidates the selection
+    worker.Start(snapshot, 5);
+    EXPECT_EQ(worker.Take(moved.view, snapshot.projection, snapshot.camera_position), nullptr);
+    worker.Start(snapshot, 5);
+    const glm::mat4 zoomed = glm::perspective(glm::radians(30.0f), 1.5f, 0.01f, 10.0f);
+    EXPECT_EQ(worker.Take(snapshot.view, zoomed, snapshot.camera_position), nullptr);
+    worker.Start(snapshot, 5);
+    EXPECT_EQ(worker.Take(snapshot.view, snapshot.projection, moved.camera_position), nullptr);
+    EXPECT_FALSE(worker.HasSelection());
+
+    // Nothing started: no selection for any camera
+    TileSelectionWorker idle(SelectMarker);
+    EXPECT_EQ(idle.Take(snapshot.view, snapshot.projection, snapshot.camera_position), nullptr);
+    EXPECT_EQ(idle.GetRunCount(), 0u);
+}
+
+TEST(TileSelectionWorkerTest, ReusesOneThreadAcrossFrames) {
+    std::vector<std::thread::id> threads;
+    TileSelectionWorker worker([&](const FrameSnapshot& snapshot, int zoom_level,
+                                   std::pmr::vector<TileCoordinates>& tiles) {
+        threads.push_back(std::this_thread::get_id());
+        SelectMarker(snapshot, zoom_level, tiles);
+    });
+
+    for (int frame = 0; frame < 20; ++frame) {
+        const FrameSnapshot snapshot =
+            MakeSnapshot(glm::vec3(static_cast<float>(frame), 0.0f, 2.0f));
+        worker.Start(snapshot, frame % 10);
+        const std::pmr::vector<TileCoordinates>* tiles =
+            worker.Take(snapshot.view, snapshot.projection, snapshot.camera_position);
+        ASSERT_NE(tiles, nullptr) << "frame " << frame;
+        EXPECT_EQ((*tiles)[0], TileCoordinates(frame % 10, frame, frame % 10))
+            << "frame " << frame;
+    }
+
+    // Wait() orders the worker's writes before these reads
+    worker.Wait();
+    EXPECT_EQ(worker.GetRunCount(), 20u);
+    ASSERT_EQ(threads.size(), 20u);
+    for (const std::thread::id& id : threads) {
+        EXPECT_EQ(id, threads.front());
+        EXPECT_NE(id, std::this_thread::get_id());
+    }
+}
+
+TEST(TileSelectionWorkerTest, StartWaitsForRunningSelection) {
+    std::atomic<int> running{0};
+    std::atomic<int> overlaps{0};
+    TileSelectionWorker worker([&](const FrameSnapshot& snapshot, int zoom_level,
+                                   std::pmr::vector<TileCoordinates>& tiles) {
+        if (running.fetch_add(1) != 0) {
+            ++overlaps;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        SelectMarker(snapshot, zoom_level, tiles);
+        running.fetch_sub(1);
+    });
+
+    // Results of a discarded selection are overwritten, never mixed
+    for (int frame = 0; frame < 5; ++frame) {
+        worker.Start(MakeSnapshot(glm::vec3(static_cast<float>(frame), 0.0f, 2.0f)), 4);
+    }
+    const FrameSnapshot last = MakeSnapshot(glm::vec3(4.0f, 0.0f, 2.0f));
+    const std::pmr::vector<TileCoordinates>* tiles =
+        worker.Take(last.view, last.projection, last.camera_position);
+    ASSERT_NE(tiles, nullptr);
+    ASSERT_EQ(tiles->size(), 1u);
+    EXPECT_EQ((*tiles)[0], TileCoordinates(4, 4, 4));
+    EXPECT_EQ(overlaps.load(), 0);
+    EXPECT_EQ(worker.GetRunCount(), 5u);
+}
+
+} // namespace earth_map::tests
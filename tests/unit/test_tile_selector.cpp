@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/tile_selector.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace earth_map::tests {
+
+namespace {
+
+constexpr float kViewportHeight = 1080.0f;
+
+struct TestView {
+    Frustum frustum;
+    float focal_length_px;
+};
+
+TestView MakeView(const glm::vec3& eye, const glm::vec3& target, const glm::vec3& up,
+                  float fov_degrees = 45.0f) {
+    const glm::mat4 projection =
+        glm::perspective(glm::radians(fov_degrees), 16.0f / 9.0f, 0.0001f, 100.0f);
+    const glm::mat4 view = glm::lookAt(eye, target, up);
+    return {Frustum(projection * view),
+            TileSelector::FocalLengthPixels(projection, kViewportHeight)};
+}
+
+} // namespace
+
+TEST(TileSelectorTest, FocalLengthMatchesFieldOfView) {
+    const glm::mat4 projection =
+        glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 10.0f);
+    // tan(45 deg) = 1: half the viewport height per unit of slope
+    EXPECT_NEAR(TileSelector::FocalLengthPixels(projection, 1000.0f), 500.0f, 1e-2f);
+}
+
+TEST(TileSelectorTest, ErrorHalvesPerZoomLevel) {
+    const TileSelector selector;
+    const glm::vec3 camera(0.0f, 0.0f, 50.0f);
+
+    // Far away, distance barely changes between a tile and its child
+    const float parent = selector.CalculateScreenSpaceError(TileCoordinates(8, 8, 4), camera, 1000.0f);
+    const float child = selector.CalculateScreenSpaceError(TileCoordinates(16, 16, 5), camera, 1000.0f);
+    EXPECT_NEAR(child / parent, 0.5f, 0.02f);
+}
+
+TEST(TileSelectorTest, BoundEnclosesTileCorners) {
+    const TileCoordinates tile(5, 3, 3);
+    const TileSelector::TileBound bound = TileSelector::ComputeBound(tile);
+
+    const double n = 8.0;
+    for (int dy = 0; dy <= 1; ++dy) {
+        for (int dx = 0; dx <= 1; ++dx) {
+            const double lon = (tile.x + dx) / n * 2.0 * M_PI - M_PI;
+            const double lat = std::atan(std::sinh(M_PI * (1.0 - 2.0 * (tile.y + dy) / n)));
+            const glm::vec3 corner(static_cast<float>(std::cos(lat) * std::sin(lon)),
+                                   static_cast<float>(std::sin(lat)),
+                                   static_cast<float>(std::cos(lat) * std::cos(lon)));
+            EXPECT_LE(glm::length(corner - bound.center), bound.radius);
+        }
+    }
+}
+
+TEST(TileSelectorTest, NadirViewSelectsTilesWithinZoomSpan) {
+    TileSelector selector;
+    const glm::vec3 eye(0.0f, 0.0f, 1.05f);
+    const TestView view = MakeView(eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+    const auto tiles = selector.Select(eye, view.frustum, view.focal_length_px, 9, 1000);
+    ASSERT_FALSE(tiles.empty());
+
+    const std::int32_t span = selector.GetConfig().max_zoom_span;
+    for (const TileCoordinates& tile : tiles) {
+        EXPECT_LE(tile.zoom, 9);
+        EXPECT_GE(tile.zoom, 9 - span);
+    }
+    EXPECT_EQ(tiles.front().zoom, selector.GetStats().finest_zoom);
+    EXPECT_FALSE(selector.GetStats().budget_limited);
+}
+
+TEST(TileSelectorTest, TiltedViewCoarsensTowardHorizon) {
+    TileSelector selector;
+    const glm::vec3 eye(0.0f, 0.0f, 1.01f);
+    // Looking north along the surface
+    const TestView view = MakeView(eye, glm::vec3(0.0f, 0.3f, 0.95f), glm::vec3(0.0f, 0.0f, 1.0f));
+
+    const auto tiles = selector.Select(eye, view.frustum, view.focal_length_px, 10, 1000);
+    ASSERT_FALSE(tiles.empty());
+
+    const TileSelectionStats stats = selector.GetStats();
+    EXPECT_EQ(stats.finest_zoom, 10);
+    EXPECT_LT(stats.coarsest_zoom, stats.finest_zoom);
+    EXPECT_GT(stats.culled_nodes, 0u);
+
+    // Finest first
+    EXPECT_TRUE(std::is_sorted(tiles.begin(), tiles.end(),
+                               [](const TileCoordinates& a, const TileCoordinates& b) {
+                                   return a.zoom > b.zoom;
+                               }));
+}
+
+TEST(TileSelectorTest, RespectsTileBudget) {
+    TileSelector selector;
+    const glm::vec3 eye(0.0f, 0.0f, 1.01f);
+    const TestView view = MakeView(eye, glm::vec3(0.0f, 0.3f, 0.95f), glm::vec3(0.0f, 0.0f, 1.0f));
+
+    const auto tiles = selector.Select(eye, view.frustum, view.focal_length_px, 14, 40);
+    EXPECT_LE(tiles.size(), 40u);
+    EXPECT_TRUE(selector.GetStats().budget_limited);
+}
+
+TEST(TileSelectorTest, HorizonHidesFarSideOfGlobe) {
+    const glm::vec3 camera(0.0f, 0.0f, 2.0f);
+
+    // From distance 2 the horizon is 60 degrees from the sub-camera point
+    EXPECT_FALSE(TileSelector::IsBelowHorizon(camera, glm::vec3(0.0f, 0.0f, 1.0f)));
+    EXPECT_FALSE(TileSelector::IsBelowHorizon(camera, glm::vec3(0.8f, 0.0f, 0.6f)));
+    EXPECT_TRUE(TileSelector::IsBelowHorizon(camera, glm::vec3(1.0f, 0.0f, 0.0f)));
+    EXPECT_TRUE(TileSelector::IsBelowHorizon(camera, glm::vec3(0.0f, 0.0f, -1.0f)));
+
+    // Points above the occluder can be seen past the horizon
+    EXPECT_FALSE(TileSelector::IsBelowHorizon(camera, glm::vec3(3.0f, 0.0f, 0.0f)));
+}
+
+TEST(TileSelectorTest, SelectAtZoomCullsTilesBehindHorizon) {
+    TileSelector selector;
+    const glm::vec3 eye(0.0f, 0.0f, 3.0f);
+    // Whole globe in view: only the horizon rejects the far side
+    const TestView view = MakeView(eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f), 90.0f);
+
+    const auto tiles = selector.SelectAtZoom(eye, view.frustum, 5, 4096);
+    ASSERT_FALSE(tiles.empty());
+    EXPECT_LT(tiles.size(), 1024u / 2);
+    EXPECT_GT(selector.GetStats().horizon_culled_nodes, 0u);
+
+    for (const TileCoordinates& tile : tiles) {
+        EXPECT_EQ(tile.zoom, 5);
+        // Every selected tile reaches the visible cap (z > 1/3 on the unit sphere)
+        const TileSelector::TileBound bound = TileSelector::ComputeBound(tile);
+        EXPECT_GT(bound.center.z + bound.radius, 1.0f / 3.0f);
+    }
+}
+
+TEST(TileSelectorTest, HorizonCullingCanBeDisabled) {
+    TileSelectionConfig config;
+    config.horizon_culling = false;
+    TileSelector selector(config);
+    const glm::vec3 eye(0.0f, 0.0f, 3.0f);
+    const TestView view = MakeView(eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f), 90.0f);
+
+    selector.SelectAtZoom(eye, view.frustum, 5, 4096);
+    EXPECT_EQ(selector.GetStats().horizon_culled_nodes, 0u);
+}
+
+TEST(TileSelectorTest, SelectInRegionKeepsTilesOfTheVisibleRegion) {
+    TileSelector selector;
+    const glm::vec3 eye(0.0f, 0.0f, 1.5f);
+    const TestView view = MakeView(eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const coordinates::VisibleRegion region = coordinates::CoordinateMapper::CalculateVisibleRegion(
+        coordinates::World(eye), view.frustum);
+    ASSERT_FALSE(region.IsEmpty());
+
+    std::pmr::vector<TileCoordinates> tiles;
+    selector.SelectInRegion(eye, view.frustum, region, 4, 4096, tiles);
+    ASSERT_FALSE(tiles.empty());
+    EXPECT_LT(tiles.size(), 256u / 4);
+
+    // Every tile overlaps the region's box, and the tile under the camera is in
+    const TileCoordinates nadir(8, 8, 4);
+    EXPECT_NE(std::find(tiles.begin(), tiles.end(), nadir), tiles.end());
+    for (const TileCoordinates& tile : tiles) {
+        EXPECT_EQ(tile.zoom, 4);
+        const double west = tile.x / 16.0 * 360.0 - 180.0;
+        EXPECT_LE(west, region.east_longitude);
+        EXPECT_GE(west + 22.5, region.west_longitude);
+    }
+
+    // A budget keeps the tiles nearest the camera
+    selector.SelectInRegion(eye, view.frustum, region, 4, 1, tiles);
+    ASSERT_EQ(tiles.size(), 1u);
+    EXPECT_TRUE(selector.GetStats().budget_limited);
+}
+
+TEST(TileSelectorTest, SelectInRegionWrapsAroundTheAntimeridian) {
+    TileSelector selector;
+    const glm::vec3 eye(0.0f, 0.0f, -1.2f);
+    const TestView view = MakeView(eye, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    const coordinates::VisibleRegion region = coordinates::CoordinateMapper::CalculateVisibleRegion(
+        coordinates::World(eye), view.frustum);
+    ASSERT_TRUE(region.CrossesAntimeridian());
+
+    std::pmr::vector<TileCoordinates> tiles;
+    selector.SelectInRegion(eye, view.frustum, region, 3, 4096, tiles);
+    const auto has_column = [&tiles](std::int32_t x) {
+        return std::any_of(tiles.begin(), tiles.end(),
+                           [x](const TileCoordinates& tile) { return tile.x == x; });
+    };
+    EXPECT_TRUE(has_column(0));
+    EXPECT_TRUE(has_column(7));
+    EXPECT_FALSE(has_column(4));
+}
+
+} // namespace earth_map::tests
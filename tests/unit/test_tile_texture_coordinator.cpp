@@ -3,7 +3,12 @@
 #include <earth_map/data/tile_cache.h>
 #include <earth_map/data/tile_loader.h>
 #include <earth_map/math/tile_mathematics.h>
+#include <earth_map/platform/opengl_context.h>
+#include <algorithm>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <thread>
 #include <chrono>
 
@@ -36,8 +41,16 @@ public:
  */
 class CoordinatorMockTileLoader : public TileLoader {
 public:
+    ~CoordinatorMockTileLoader() override {
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        for (auto& thread : async_threads_) {
+            thread.join();
+        }
+    }
+
     bool Initialize(const TileLoaderConfig&) override { return true; }
-    void SetTileCache(std::shared_ptr<TileCache>) override {}
+    void SetTileCache(std::shared_ptr<TileCache> cache) override { cache_ = std::move(cache); }
+    std::shared_ptr<TileCache> GetTileCache() const override { return cache_; }
     bool AddProvider(std::shared_ptr<TileProvider>) override { return true; }
     bool SetDefaultProvider(const std::string&) override { return true; }
     bool RemoveProvider(const std::string&) override { return false; }
@@ -59,16 +72,27 @@ public:
         result.tile_data->channels = 4;
 
         const std::size_t data_size = 256 * 256 * 4;
-        result.tile_data->data.resize(data_size);
         const std::uint8_t value = static_cast<std::uint8_t>((coords.x + coords.y) % 256);
-        std::fill(result.tile_data->data.begin(), result.tile_data->data.end(), value);
+        result.tile_data->data = std::vector<std::uint8_t>(data_size, value);
 
         return result;
     }
 
-    std::future<TileLoadResult> LoadTileAsync(const TileCoordinates&, TileLoadCallback,
-                                              const std::string&) override {
-        return std::future<TileLoadResult>();
+    std::future<TileLoadResult> LoadTileAsync(const TileCoordinates& coords, TileLoadCallback callback,
+                                              const std::string& provider) override {
+        auto promise = std::make_shared<std::promise<TileLoadResult>>();
+        auto future = promise->get_future();
+
+        std::lock_guard<std::mutex> lock(async_mutex_);
+        async_threads_.emplace_back([this, coords, callback, provider, promise]() {
+            auto result = LoadTile(coords, provider);
+            if (callback) {
+                callback(result);
+            }
+            promise->set_value(std::move(result));
+        });
+
+        return future;
     }
 
     std::vector<std::future<TileLoadResult>> LoadTilesAsync(const std::vector<TileCoordinates>&,
@@ -80,10 +104,20 @@ public:
     bool CancelLoad(const TileCoordinates&) override { return false; }
     void CancelAllLoads() override {}
     TileLoaderStats GetStatistics() const override { return {}; }
-    TileLoaderConfig GetConfiguration() const override { return {}; }
+    TileLoaderConfig GetConfiguration() const override {
+        // Two fetches in flight so that bulk requests stay queued in the pool
+        TileLoaderConfig config;
+        config.max_concurrent_downloads = 2;
+        return config;
+    }
     bool SetConfiguration(const TileLoaderConfig&) override { return true; }
     bool IsLoading(const TileCoordinates&) const override { return false; }
     std::vector<TileCoordinates> GetLoadingTiles() const override { return {}; }
+
+private:
+    std::shared_ptr<TileCache> cache_;
+    std::mutex async_mutex_;
+    std::vector<std::thread> async_threads_;
 };
 
 /**
@@ -105,9 +139,113 @@ public:
     }
 };
 
+/**
+ * @brief Mock TileLoader that records the provider of each load
+ */
+class CoordinatorRecordingMockTileLoader : public CoordinatorMockTileLoader {
+public:
+    TileLoadResult LoadTile(const TileCoordinates& coords, const std::string& provider) override {
+        {
+            std::lock_guard<std::mutex> lock(providers_mutex_);
+            providers_.push_back(provider);
+        }
+        return CoordinatorMockTileLoader::LoadTile(coords, provider);
+    }
+
+    bool Loaded(const std::string& provider) const {
+        std::lock_guard<std::mutex> lock(providers_mutex_);
+        return std::find(providers_.begin(), providers_.end(), provider) != providers_.end();
+    }
+
+private:
+    mutable std::mutex providers_mutex_;
+    std::vector<std::string> providers_;
+};
+
+/**
+ * @brief Mock TileLoader serving @1x and @2x variants, chosen as BasicTileLoader does
+ *
+ * Returns the chosen variant's pixels already decoded: 256px for @1x,
+ * 512px for @2x.
+ */
+class CoordinatorVariantMockTileLoader : public CoordinatorMockTileLoader {
+public:
+    explicit CoordinatorVariantMockTileLoader(float required_pixel_scale) {
+        TileVariantSelectorConfig config;
+        config.required_pixel_scale = required_pixel_scale;
+        selector_.SetConfig(config);
+        variants_.push_back({"@1x-png", 1.0f, "png", 0, 40000});
+        variants_.push_back({"@2x-jpeg", 2.0f, "jpeg", 85, 60000});
+    }
+
+    TileLoadResult LoadTile(const TileCoordinates& coords, const std::string&) override {
+        const TileVariant& variant = variants_[selector_.Select(variants_, 0)];
+        const std::uint32_t size = static_cast<std::uint32_t>(256.0f * variant.pixel_scale);
+
+        TileLoadResult result;
+        result.success = true;
+        result.coordinates = coords;
+        result.variant = variant.name;
+        result.tile_data = std::make_shared<TileData>();
+        result.tile_data->metadata.coordinates = coords;
+        result.tile_data->loaded = true;
+        result.tile_data->width = size;
+        result.tile_data->height = size;
+        result.tile_data->channels = 4;
+        result.tile_data->data = std::vector<std::uint8_t>(std::size_t{size} * size * 4, 0x80);
+        {
+            std::lock_guard<std::mutex> lock(variants_mutex_);
+            loaded_variants_.push_back(variant.name);
+        }
+        return result;
+    }
+
+    std::vector<std::string> LoadedVariants() const {
+        std::lock_guard<std::mutex> lock(variants_mutex_);
+        return loaded_variants_;
+    }
+
+private:
+    TileVariantSelector selector_;
+    std::vector<TileVariant> variants_;
+    mutable std::mutex variants_mutex_;
+    std::vector<std::string> loaded_variants_;
+};
+
 /**
  * @brief Test fixture for TileTextureCoordinator
  */
+/**
+ * @brief OpenGLContext stand-in that records the thread it was made current on
+ */
+class CoordinatorFakeGLContext : public OpenGLContext {
+public:
+    explicit CoordinatorFakeGLContext(bool can_make_current,
+                                      std::thread::id* current_thread = nullptr)
+        : can_make_current_(can_make_current), current_thread_(current_thread) {}
+
+    bool Initialize() override { return true; }
+    bool MakeCurrent() override {
+        if (current_thread_ != nullptr) {
+            *current_thread_ = std::this_thread::get_id();
+        }
+        return can_make_current_;
+    }
+    bool ReleaseCurrent() override { return true; }
+    bool SwapBuffers() override { return false; }
+    bool IsValid() const override { return true; }
+    std::pair<std::uint32_t, std::uint32_t> GetActualVersion() const override { return {3, 3}; }
+    bool IsExtensionSupported(const std::string&) const override { return false; }
+    void SetErrorCallback(OpenGLErrorCallback) override {}
+    bool SetVSyncEnabled(bool) override { return false; }
+    std::string GetContextInfo() const override { return "fake"; }
+    void* GetNativeHandle() const override { return nullptr; }
+
+private:
+    bool can_make_current_;
+    std::thread::id* current_thread_;
+};
+
 class TileTextureCoordinatorTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -153,7 +291,7 @@ TEST_F(TileTextureCoordinatorTest, RequestSingleTile) {
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
     // Process uploads (simulate GL thread)
-    coordinator_->ProcessUploads(10);
+    coordinator_->ProcessUploads();
 
     // Tile should be ready
     EXPECT_TRUE(coordinator_->IsTileReady(tile));
@@ -171,7 +309,7 @@ TEST_F(TileTextureCoordinatorTest, RequestMultipleTiles) {
     std::this_thread::sleep_for(std::chrono::milliseconds(300));
 
     // Process uploads (simulate GL thread)
-    coordinator_->ProcessUploads(10);
+    coordinator_->ProcessUploads();
 
     // All tiles should be ready
     for (const auto& tile : tiles) {
@@ -191,7 +329,7 @@ TEST_F(TileTextureCoordinatorTest, RequestDuplicateTiles_Idempotent) {
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
 
     // Process uploads
-    coordinator_->ProcessUploads(10);
+    coordinator_->ProcessUploads();
 
     // Should only load once (idempotent)
     EXPECT_TRUE(coordinator_->IsTileReady(tile));
@@ -208,9 +346,61 @@ TEST_F(TileTextureCoordinatorTest, IsTileReady_ReturnsTrueAfterLoad) {
 
     coordinator_->RequestTiles({tile}, 0);
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    coordinator_->ProcessUploads(10);
+    coordinator_->ProcessUploads();
+
+    EXPECT_TRUE(coordinator_->IsTileReady(tile));
+}
+
+TEST_F(TileTextureCoordinatorTest, DoubleScaleVariantIsReducedToThePoolTileSize) {
+    // A 2x device pixel ratio selects the 512px variant; ring slots hold 256px tiles
+    auto loader = std::make_shared<CoordinatorVariantMockTileLoader>(2.0f);
+    TileTextureCoordinator coordinator(cache_, loader, 2, true);
+    const TileCoordinates tile(3, 7, 9);
+
+    coordinator.RequestTiles({tile}, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    coordinator.ProcessUploads();
+
+    EXPECT_EQ(loader->LoadedVariants(), std::vector<std::string>{"@2x-jpeg"});
+    EXPECT_TRUE(coordinator.IsTileReady(tile));
+    EXPECT_GE(coordinator.GetTileLayerIndex(tile), 0);
+}
+
+TEST_F(TileTextureCoordinatorTest, RequestTiles_AddsMissingAncestors) {
+    EXPECT_EQ(coordinator_->GetAncestorLevels(), 0);
+    coordinator_->SetAncestorLevels(2);
 
+    const TileCoordinates tile(4, 4, 5);
+    coordinator_->RequestTiles({tile}, 0);
+
+    // Parent and grandparent are requested with the tile, nothing above them
+    EXPECT_NE(coordinator_->GetTileStatus(TileCoordinates(2, 2, 4)),
+              TileTextureCoordinator::TileStatus::NotLoaded);
+    EXPECT_NE(coordinator_->GetTileStatus(TileCoordinates(1, 1, 3)),
+              TileTextureCoordinator::TileStatus::NotLoaded);
+    EXPECT_EQ(coordinator_->GetTileStatus(TileCoordinates(0, 0, 2)),
+              TileTextureCoordinator::TileStatus::NotLoaded);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    coordinator_->ProcessUploads();
     EXPECT_TRUE(coordinator_->IsTileReady(tile));
+    EXPECT_TRUE(coordinator_->IsTileReady(TileCoordinates(1, 1, 3)));
+}
+
+TEST_F(TileTextureCoordinatorTest, RequestTiles_AncestorWalkStopsAtLoadedTile) {
+    const TileCoordinates parent(4, 4, 5);
+    coordinator_->RequestTiles({parent}, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    coordinator_->ProcessUploads();
+    ASSERT_TRUE(coordinator_->IsTileReady(parent));
+
+    // The loaded parent already covers the child: no need for its ancestors
+    coordinator_->SetAncestorLevels(3);
+    coordinator_->RequestTiles({TileCoordinates(8, 8, 6)}, 0);
+
+    EXPECT_EQ(coordinator_->GetTileStatus(TileCoordinates(2, 2, 4)),
+              TileTextureCoordinator::TileStatus::NotLoaded);
+    EXPECT_EQ(coordinator_->GetPendingLoadCount(), 1u);
 }
 
 // ============================================================================
@@ -222,7 +412,7 @@ TEST_F(TileTextureCoordinatorTest, GetTileUV_LoadedTile) {
 
     coordinator_->RequestTiles({tile}, 0);
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    coordinator_->ProcessUploads(10);
+    coordinator_->ProcessUploads();
 
     glm::vec4 uv = coordinator_->GetTileUV(tile);
 
@@ -245,6 +435,30 @@ TEST_F(TileTextureCoordinatorTest, GetTileUV_UnloadedTile_ReturnsDefault) {
     EXPECT_EQ(uv.w, 0.0f);
 }
 
+TEST_F(TileTextureCoordinatorTest, QueryTiles_MatchesPerTileQueries) {
+    const TileCoordinates loaded(4, 5, 7);
+    const TileCoordinates unknown(40, 50, 9);
+
+    coordinator_->RequestTiles({loaded}, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    coordinator_->ProcessUploads();
+
+    const std::vector<TileCoordinates> tiles = {loaded, unknown, loaded};
+    std::vector<TileTextureCoordinator::TileState> states(tiles.size());
+    coordinator_->QueryTiles(tiles, states);
+
+    for (std::size_t i = 0; i < tiles.size(); ++i) {
+        EXPECT_EQ(states[i].status == TileTextureCoordinator::TileStatus::Loaded,
+                  coordinator_->IsTileReady(tiles[i]));
+    }
+    EXPECT_EQ(states[0].status, TileTextureCoordinator::TileStatus::Loaded);
+    EXPECT_GE(states[0].pool_layer, 0);
+    EXPECT_EQ(states[1].status, TileTextureCoordinator::TileStatus::NotLoaded);
+
+    std::vector<TileTextureCoordinator::TileState> too_few(1);
+    EXPECT_THROW(coordinator_->QueryTiles(tiles, too_few), std::invalid_argument);
+}
+
 // ============================================================================
 // ProcessUploads Tests
 // ============================================================================
@@ -261,7 +475,7 @@ TEST_F(TileTextureCoordinatorTest, ProcessUploads_DrainsQueue) {
     std::this_thread::sleep_for(std::chrono::milliseconds(500));
 
     // Process uploads (simulate GL thread)
-    coordinator_->ProcessUploads(5);  // Process up to 5
+    coordinator_->ProcessUploads();
 
     // After processing, tiles should start becoming ready
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -288,7 +502,7 @@ TEST_F(TileTextureCoordinatorTest, ProcessUploads_MultipleFrames) {
 
     // Process in batches (simulating frame budget)
     for (int frame = 0; frame < 10; ++frame) {
-        coordinator_->ProcessUploads(5);
+        coordinator_->ProcessUploads();
         std::this_thread::sleep_for(std::chrono::milliseconds(16));  // ~60 FPS
     }
 
@@ -322,7 +536,7 @@ TEST_F(TileTextureCoordinatorTest, PoolEviction_WhenFull) {
 
     // Process all uploads
     for (int i = 0; i < 20; ++i) {
-        coordinator_->ProcessUploads(10);
+        coordinator_->ProcessUploads();
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
 
@@ -338,6 +552,287 @@ TEST_F(TileTextureCoordinatorTest, PoolEviction_WhenFull) {
     EXPECT_GE(ready_count, 1);  // At least some should have loaded
 }
 
+TEST_F(TileTextureCoordinatorTest, LoweredVramBudgetEvictsOnProcessUploads) {
+    // Each layer holds a full mip chain
+    const std::size_t layer_bytes = TileMipChain::GetLevelOffset(TileTextureFormat::RGBA8, 256, 9);
+    EXPECT_EQ(coordinator_->GetVramBudget(),
+              TileTextureCoordinator::kDefaultMaxPoolLayers * layer_bytes);
+
+    std::vector<TileCoordinates> tiles;
+    for (int i = 0; i < 20; ++i) {
+        tiles.emplace_back(i, 0, 8);
+    }
+    coordinator_->RequestTiles(tiles, 0);
+
+    std::this_thread::sleep_for(std::chrono::seconds(2));
+    for (int i = 0; i < 20; ++i) {
+        coordinator_->ProcessUploads();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // Room for 4 tiles
+    coordinator_->SetVramBudget(4 * layer_bytes);
+    EXPECT_EQ(coordinator_->GetVramBudget(), 4u * layer_bytes);
+    coordinator_->ProcessUploads();
+
+    int ready_count = 0;
+    for (const auto& tile : tiles) {
+        if (coordinator_->IsTileReady(tile)) {
+            ++ready_count;
+        }
+    }
+    EXPECT_LE(ready_count, 4);
+}
+
+TEST_F(TileTextureCoordinatorTest, ResidentTilesSurviveEviction) {
+    std::vector<ResidentTile> basemap;
+    for (int i = 0; i < 5; ++i) {
+        ResidentTile tile{TileCoordinates(i % 2, i / 2, 2), {}};
+        tile.image.pixels.assign(256 * 256 * 4, static_cast<std::uint8_t>(i * 40));
+        tile.image.width = tile.image.height = 256;
+        tile.image.channels = 4;
+        basemap.push_back(std::move(tile));
+    }
+    // Wrong size: skipped
+    basemap.push_back(ResidentTile{TileCoordinates(3, 3, 2), {{0, 0, 0, 0}, 1, 1, 4}});
+
+    EXPECT_EQ(coordinator_->AddResidentTiles(basemap), 5u);
+    EXPECT_TRUE(coordinator_->IsTileReady(TileCoordinates(0, 0, 2)));
+    EXPECT_FALSE(coordinator_->IsTileReady(TileCoordinates(3, 3, 2)));
+
+    // Requests for resident tiles start no load
+    coordinator_->RequestTiles(std::vector<TileCoordinates>{TileCoordinates(1, 0, 2)}, 0);
+    EXPECT_EQ(coordinator_->GetPendingLoadCount(), 0u);
+
+    // Neither the budget nor age evicts them
+    const std::size_t layer_bytes = TileMipChain::GetLevelOffset(TileTextureFormat::RGBA8, 256, 9);
+    coordinator_->SetVramBudget(2 * layer_bytes);
+    coordinator_->ProcessUploads();
+    EXPECT_EQ(coordinator_->EvictUnusedTiles(std::chrono::seconds(0)), 0u);
+    for (const ResidentTile& tile : basemap) {
+        EXPECT_EQ(coordinator_->IsTileReady(tile.coords), tile.image.width == 256);
+    }
+}
+
+// ============================================================================
+// Overlay Layer Tests
+// ============================================================================
+
+TEST_F(TileTextureCoordinatorTest, OverlayLayersLoadIntoTheSharedPool) {
+    auto overlay_loader = std::make_shared<CoordinatorMockTileLoader>();
+    ASSERT_EQ(coordinator_->AddOverlayLayer(nullptr, overlay_loader, 0.5f, 1), 0);
+    ASSERT_EQ(coordinator_->GetOverlayCount(), 1u);
+    EXPECT_FLOAT_EQ(coordinator_->GetOverlayOpacity(0), 0.5f);
+    coordinator_->SetOverlayOpacity(0, 2.0f);
+    EXPECT_FLOAT_EQ(coordinator_->GetOverlayOpacity(0), 1.0f);
+
+    TileTextureCoordinator* overlay = coordinator_->GetOverlay(0);
+    ASSERT_NE(overlay, nullptr);
+    EXPECT_EQ(coordinator_->GetOverlay(1), nullptr);
+    EXPECT_THROW(overlay->AddOverlayLayer(nullptr, overlay_loader), std::invalid_argument);
+    EXPECT_THROW(coordinator_->AddOverlayLayer(nullptr, nullptr), std::invalid_argument);
+
+    // Requests on the base reach the overlay; both copies of a tile get layers
+    const std::vector<TileCoordinates> tiles{TileCoordinates(1, 2, 4), TileCoordinates(2, 2, 4)};
+    coordinator_->RequestTiles(tiles, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    for (int i = 0; i < 5; ++i) {
+        coordinator_->ProcessUploads();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    for (const TileCoordinates& tile : tiles) {
+        ASSERT_TRUE(coordinator_->IsTileReady(tile));
+        ASSERT_TRUE(overlay->IsTileReady(tile));
+        EXPECT_NE(coordinator_->GetTileLayerIndex(tile), overlay->GetTileLayerIndex(tile));
+    }
+
+    // One budget: evictions may come from either layer, each clearing its own state
+    const std::size_t layer_bytes = TileMipChain::GetLevelOffset(TileTextureFormat::RGBA8, 256, 9);
+    coordinator_->SetVramBudget(2 * layer_bytes);
+    coordinator_->ProcessUploads();
+    int ready_count = 0;
+    for (const TileCoordinates& tile : tiles) {
+        ready_count += coordinator_->IsTileReady(tile) ? 1 : 0;
+        ready_count += overlay->IsTileReady(tile) ? 1 : 0;
+        EXPECT_EQ(overlay->IsTileReady(tile), overlay->GetTileLayerIndex(tile) >= 0);
+    }
+    EXPECT_EQ(ready_count, 2);
+}
+
+TEST_F(TileTextureCoordinatorTest, OverlayLayersAreLimited) {
+    for (std::size_t i = 0; i < TileTextureCoordinator::kMaxOverlayLayers; ++i) {
+        EXPECT_EQ(coordinator_->AddOverlayLayer(
+                      nullptr, std::make_shared<CoordinatorMockTileLoader>(), 1.0f, 1),
+                  static_cast<int>(i));
+    }
+    EXPECT_EQ(coordinator_->AddOverlayLayer(
+                  nullptr, std::make_shared<CoordinatorMockTileLoader>(), 1.0f, 1), -1);
+    EXPECT_EQ(coordinator_->GetOverlayCount(), TileTextureCoordinator::kMaxOverlayLayers);
+}
+
+// ============================================================================
+// Time-Series Layer Tests
+// ============================================================================
+
+TEST(TimeFrameTileProviderTest, FillsTheFrameTimeIntoUrls) {
+    auto radar = std::make_shared<BasicXYZTileProvider>(
+        "Radar", "https://radar.example/{t}/{z}/{x}/{y}.png", "", 0, 7);
+    TimeFrameTileProvider frame(radar, "202610151200");
+
+    EXPECT_EQ(frame.GetName(), "Radar@202610151200");
+    EXPECT_EQ(frame.BuildTileURL(TileCoordinates(1, 2, 3)),
+              "https://radar.example/202610151200/3/1/2.png");
+    EXPECT_EQ(frame.GetMaxZoom(), 7);
+    EXPECT_THROW(TimeFrameTileProvider(nullptr, "0"), std::invalid_argument);
+}
+
+TEST_F(TileTextureCoordinatorTest, TimeSeriesRejectsLoaderWithCache) {
+    auto radar_loader = std::make_shared<CoordinatorRecordingMockTileLoader>();
+    auto radar = std::make_shared<BasicXYZTileProvider>(
+        "Radar", "https://radar.example/{t}/{z}/{x}/{y}.png");
+    TimeSeriesLayerConfig config;
+    config.frame_times = {"t0", "t1"};
+
+    // Caches key tiles by coordinates only: every frame would get frame 0's tile
+    radar_loader->SetTileCache(std::make_shared<CoordinatorMockTileCache>());
+    EXPECT_THROW(coordinator_->AddTimeSeriesLayer(radar_loader, radar, config),
+                 std::invalid_argument);
+    EXPECT_EQ(coordinator_->GetOverlayCount(), 0u);
+    EXPECT_EQ(coordinator_->GetTimeSeriesFrameLayer(0), nullptr);
+
+    radar_loader->SetTileCache(nullptr);
+    EXPECT_EQ(coordinator_->AddTimeSeriesLayer(radar_loader, radar, config, 1.0f, 1), 0);
+    EXPECT_NE(coordinator_->GetTimeSeriesFrameLayer(0), nullptr);
+}
+
+TEST_F(TileTextureCoordinatorTest, TimeSeriesPrefetchesTheNextFrames) {
+    auto radar_loader = std::make_shared<CoordinatorRecordingMockTileLoader>();
+    auto radar = std::make_shared<BasicXYZTileProvider>(
+        "Radar", "https://radar.example/{t}/{z}/{x}/{y}.png");
+    TimeSeriesLayerConfig config;
+    config.frame_times = {"t0", "t1", "t2", "t3"};
+    config.prefetch_frames = 1;
+    config.frame_duration = std::chrono::milliseconds(100);
+
+    EXPECT_THROW(coordinator_->AddTimeSeriesLayer(radar_loader, nullptr, config),
+                 std::invalid_argument);
+    ASSERT_EQ(coordinator_->AddTimeSeriesLayer(radar_loader, radar, config, 0.5f, 1), 0);
+    EXPECT_THROW(coordinator_->AddTimeSeriesLayer(radar_loader, radar, config),
+                 std::invalid_argument);
+    EXPECT_EQ(coordinator_->GetOverlayCount(), 1u);
+    EXPECT_FLOAT_EQ(coordinator_->GetOverlayOpacity(0), 0.5f);
+
+    // The shown frame and the next one have slots
+    TileTextureCoordinator* frame0 = coordinator_->GetTimeSeriesFrameLayer(0);
+    TileTextureCoordinator* frame1 = coordinator_->GetTimeSeriesFrameLayer(1);
+    ASSERT_NE(frame0, nullptr);
+    ASSERT_NE(frame1, nullptr);
+    EXPECT_EQ(coordinator_->GetTimeSeriesFrameLayer(2), nullptr);
+    EXPECT_EQ(coordinator_->GetOverlay(0), frame0);
+
+    const auto load = [this](const std::vector<TileCoordinates>& tiles) {
+        coordinator_->RequestTiles(tiles, 0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+        for (int i = 0; i < 5; ++i) {
+            coordinator_->ProcessUploads();
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    };
+    const std::vector<TileCoordinates> tiles{TileCoordinates(1, 2, 4), TileCoordinates(2, 2, 4)};
+    coordinator_->UpdateEvictionPriorities(tiles, tiles.front());
+    load(tiles);
+
+    for (const TileCoordinates& tile : tiles) {
+        ASSERT_TRUE(frame0->IsTileReady(tile));
+        ASSERT_TRUE(frame1->IsTileReady(tile));
+        EXPECT_NE(frame0->GetTileLayerIndex(tile), frame1->GetTileLayerIndex(tile));
+    }
+    EXPECT_TRUE(radar_loader->Loaded("Radar@t0"));
+    EXPECT_TRUE(radar_loader->Loaded("Radar@t1"));
+    EXPECT_FALSE(radar_loader->Loaded("Radar@t2"));
+
+    // Frame tiles are not pool eviction candidates
+    const std::size_t layer_bytes = TileMipChain::GetLevelOffset(TileTextureFormat::RGBA8, 256, 9);
+    coordinator_->ShedTiles(0);
+    EXPECT_TRUE(frame1->IsTileReady(tiles.front()));
+
+    // The next frame was prefetched: showing it takes no upload
+    coordinator_->SetAnimationTime(std::chrono::milliseconds(150));
+    EXPECT_EQ(coordinator_->GetTimeSeriesFrame(), 1u);
+    EXPECT_EQ(coordinator_->GetOverlay(0), frame1);
+    EXPECT_TRUE(frame1->IsTileReady(tiles.front()));
+
+    // Frame 0's slot moved on to frame 2, emptied, and loads it
+    EXPECT_EQ(coordinator_->GetTimeSeriesFrameLayer(2), frame0);
+    EXPECT_FALSE(frame0->IsTileReady(tiles.front()));
+    load(tiles);
+    EXPECT_TRUE(radar_loader->Loaded("Radar@t2"));
+    EXPECT_TRUE(frame0->IsTileReady(tiles.front()));
+
+    // A slot over its region (half of 4 layers over 2 slots) drops tiles out of view
+    coordinator_->SetVramBudget(4 * layer_bytes);
+    coordinator_->UpdateEvictionPriorities(std::span(tiles).first(1), tiles.front());
+    coordinator_->ProcessUploads();
+    EXPECT_TRUE(frame1->IsTileReady(tiles[0]));
+    EXPECT_FALSE(frame1->IsTileReady(tiles[1]));
+
+    // Playback loops
+    coordinator_->SetAnimationTime(std::chrono::milliseconds(450));
+    EXPECT_EQ(coordinator_->GetTimeSeriesFrame(), 0u);
+    EXPECT_EQ(coordinator_->GetTimeSeriesFrameLayer(0), frame0);
+    EXPECT_EQ(coordinator_->GetOverlay(0), frame0);
+}
+
+// ============================================================================
+// Upload Thread Tests
+// ============================================================================
+
+TEST_F(TileTextureCoordinatorTest, UploadThread_PublishesOnProcessUploads) {
+    std::thread::id upload_thread_id;
+    ASSERT_TRUE(coordinator_->StartUploadThread(
+        std::make_unique<CoordinatorFakeGLContext>(true, &upload_thread_id)));
+    EXPECT_TRUE(coordinator_->IsUploadThreadRunning());
+    EXPECT_NE(upload_thread_id, std::this_thread::get_id());
+
+    std::vector<TileCoordinates> tiles;
+    for (int i = 0; i < 8; ++i) {
+        tiles.emplace_back(i, 1, 6);
+    }
+    coordinator_->RequestTiles(tiles, 0);
+
+    // Uploaded on the thread, Loaded once ProcessUploads() publishes them
+    const auto all_ready = [&]() {
+        return std::all_of(tiles.begin(), tiles.end(),
+                           [&](const auto& tile) { return coordinator_->IsTileReady(tile); });
+    };
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!all_ready() && std::chrono::steady_clock::now() < deadline) {
+        coordinator_->ProcessUploads();
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    EXPECT_EQ(coordinator_->GetUploadStats().total_uploads, tiles.size());
+    for (const auto& tile : tiles) {
+        EXPECT_TRUE(coordinator_->IsTileReady(tile));
+        EXPECT_GE(coordinator_->GetTileLayerIndex(tile), 0);
+    }
+    EXPECT_EQ(coordinator_->GetPendingLoadCount(), 0u);
+}
+
+TEST_F(TileTextureCoordinatorTest, UploadThread_UnusableContextKeepsRenderThreadUploads) {
+    EXPECT_FALSE(coordinator_->StartUploadThread(
+        std::make_unique<CoordinatorFakeGLContext>(false)));
+    EXPECT_FALSE(coordinator_->IsUploadThreadRunning());
+
+    TileCoordinates tile(2, 3, 7);
+    coordinator_->RequestTiles({tile}, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    coordinator_->ProcessUploads();
+
+    EXPECT_TRUE(coordinator_->IsTileReady(tile));
+}
+
 // ============================================================================
 // Concurrent Access Tests
 // ============================================================================
@@ -367,7 +862,7 @@ TEST_F(TileTextureCoordinatorTest, ConcurrentRequests) {
 
     // Process uploads
     for (int i = 0; i < 10; ++i) {
-        coordinator_->ProcessUploads(10);
+        coordinator_->ProcessUploads();
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
 
@@ -409,7 +904,7 @@ TEST_F(TileTextureCoordinatorTest, ConcurrentReadsDuringUploads) {
     // Process uploads concurrently
     std::this_thread::sleep_for(std::chrono::milliseconds(500));
     for (int i = 0; i < 10; ++i) {
-        coordinator_->ProcessUploads(5);
+        coordinator_->ProcessUploads();
         std::this_thread::sleep_for(std::chrono::milliseconds(10));
     }
 
@@ -446,7 +941,7 @@ TEST_F(TileTextureCoordinatorTest, Backpressure_PendingCountTracked) {
 
     // Wait for load to complete and process upload
     std::this_thread::sleep_for(std::chrono::milliseconds(100));
-    coordinator_->ProcessUploads(10);
+    coordinator_->ProcessUploads();
 
     // After upload, pending count should be 0
     EXPECT_EQ(coordinator_->GetPendingLoadCount(), 0u);
@@ -466,6 +961,56 @@ TEST_F(TileTextureCoordinatorTest, Backpressure_FloodDoesNotExceedLimit) {
               TileTextureCoordinator::kMaxPendingLoads);
 }
 
+TEST_F(TileTextureCoordinatorTest, CancelStaleRequests_ResetsTilesLeftOutOfView) {
+    std::vector<TileCoordinates> old_view;
+    for (int i = 0; i < 40; ++i) {
+        old_view.emplace_back(i, i, 8);
+    }
+
+    coordinator_->BeginRequestGeneration();
+    coordinator_->RequestTiles(old_view, 0);
+    EXPECT_EQ(coordinator_->CancelStaleRequests(), 0u);
+
+    // Next update only wants one tile still queued at the end of the old view
+    const TileCoordinates still_visible = old_view.back();
+    coordinator_->BeginRequestGeneration();
+    coordinator_->RequestTiles({still_visible}, 0);
+    const std::size_t cancelled = coordinator_->CancelStaleRequests();
+
+    EXPECT_GT(cancelled, 0u);
+    EXPECT_NE(coordinator_->GetTileStatus(still_visible),
+              TileTextureCoordinator::TileStatus::NotLoaded);
+
+    // Cancelled tiles never produce an upload, so pending count must drain
+    // once the surviving loads are uploaded
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    coordinator_->ProcessUploads();
+
+    EXPECT_EQ(coordinator_->GetPendingLoadCount(), 0u);
+    EXPECT_TRUE(coordinator_->IsTileReady(still_visible));
+    EXPECT_EQ(coordinator_->GetTileStatus(old_view[old_view.size() - 2]),
+              TileTextureCoordinator::TileStatus::NotLoaded);
+}
+
+TEST_F(TileTextureCoordinatorTest, ShedTiles_KeepsAncestorsOfVisibleTiles) {
+    const TileCoordinates ancestor(0, 0, 6);
+    const TileCoordinates unrelated(5, 5, 6);
+    coordinator_->RequestTiles({ancestor, unrelated}, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    coordinator_->ProcessUploads();
+    ASSERT_TRUE(coordinator_->IsTileReady(ancestor));
+    ASSERT_TRUE(coordinator_->IsTileReady(unrelated));
+
+    const std::vector<TileCoordinates> visible = {{0, 0, 8}};
+    coordinator_->UpdateEvictionPriorities(visible, visible.front());
+    EXPECT_EQ(coordinator_->GetProtectedTileCount(), 4u);
+
+    // Shedding everything still leaves the visible tile's fallback
+    EXPECT_EQ(coordinator_->ShedTiles(0), 1u);
+    EXPECT_TRUE(coordinator_->IsTileReady(ancestor));
+    EXPECT_FALSE(coordinator_->IsTileReady(unrelated));
+}
+
 // ============================================================================
 // Failed Tile Load Tests (demonstrate stuck-in-Loading bug)
 // ============================================================================
@@ -502,7 +1047,7 @@ TEST_F(TileTextureCoordinatorFailureTest, FailedTile_DoesNotStayInLoadingState)
 
     coordinator_->RequestTiles({tile}, 0);
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
-    coordinator_->ProcessUploads(10);
+    coordinator_->ProcessUploads();
 
     // BUG: tile stays Loading forever because failed load never
     // enqueues an upload command and never decrements state.
@@ -515,7 +1060,7 @@ TEST_F(TileTextureCoordinatorFailureTest, FailedTile_PendingCountReturnsToZero)
 
     coordinator_->RequestTiles({tile}, 0);
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
-    coordinator_->ProcessUploads(10);
+    coordinator_->ProcessUploads();
 
     // BUG: pending_load_count_ is incremented on request but never
     // decremented when the worker fails, so it stays at 1.
@@ -528,13 +1073,13 @@ TEST_F(TileTextureCoordinatorFailureTest, FailedTile_CanBeReRequested) {
     // Phase 1: request with failing loader
     coordinator_->RequestTiles({tile}, 0);
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
-    coordinator_->ProcessUploads(10);
+    coordinator_->ProcessUploads();
 
     // Phase 2: fix the loader and re-request the same tile
     loader_->fail_loads.store(false);
     coordinator_->RequestTiles({tile}, 0);
     std::this_thread::sleep_for(std::chrono::milliseconds(200));
-    coordinator_->ProcessUploads(10);
+    coordinator_->ProcessUploads();
 
     // BUG: tile is still stuck in Loading from the first request,
     // so the second request is ignored and tile never becomes ready.
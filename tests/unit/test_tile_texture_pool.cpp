@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <earth_map/renderer/tile_pool/tile_texture_pool.h>
 #include <earth_map/renderer/tile_pool/indirection_texture_manager.h>
+#include <earth_map/renderer/tile_pool/tile_eviction_policy.h>
+#include <earth_map/renderer/texture_atlas/tile_mip_chain.h>
 #include <earth_map/math/tile_mathematics.h>
 #include <optional>
 #include <vector>
@@ -234,6 +236,86 @@ TEST_F(TileTexturePoolTest, GetEvictionCandidate_RespectsTouch) {
     EXPECT_EQ(candidate->y, tile_b.y);
 }
 
+TEST_F(TileTexturePoolTest, PinnedTilesAreNeverEvictionCandidates) {
+    auto pixel_data = CreateTestPixelData(256, 256, 4);
+
+    TileCoordinates tile_a(0, 0, 0);
+    TileCoordinates tile_b(1, 1, 5);
+
+    pool_->UploadTile(tile_a, pixel_data.data(), 256, 256, 4);
+    pool_->UploadTile(tile_b, pixel_data.data(), 256, 256, 4);
+    pool_->PinTile(tile_a);
+    EXPECT_TRUE(pool_->IsTilePinned(tile_a));
+    EXPECT_FALSE(pool_->IsTilePinned(tile_b));
+    EXPECT_EQ(pool_->GetPinnedCount(), 1u);
+
+    // Touching or re-uploading a pinned tile keeps it out of the LRU order
+    pool_->TouchTile(tile_a);
+    pool_->UploadTile(tile_a, pixel_data.data(), 256, 256, 4);
+    auto candidate = pool_->GetEvictionCandidate();
+    ASSERT_TRUE(candidate.has_value());
+    EXPECT_EQ(*candidate, tile_b);
+
+    pool_->EvictTile(tile_b);
+    EXPECT_FALSE(pool_->GetEvictionCandidate().has_value());
+
+    // Explicit eviction still removes a pinned tile
+    pool_->EvictTile(tile_a);
+    EXPECT_FALSE(pool_->IsTileLoaded(tile_a));
+    EXPECT_EQ(pool_->GetPinnedCount(), 0u);
+}
+
+TEST_F(TileTexturePoolTest, GetEvictionCandidates_LeastImportantFirst) {
+    auto pixel_data = CreateTestPixelData(256, 256, 4);
+
+    TileCoordinates ancestor(0, 0, 1);
+    TileCoordinates visible(0, 0, 3);
+    TileCoordinates far_away(7, 7, 3);
+    TileCoordinates nearby(1, 1, 3);
+    for (const auto& tile : {ancestor, visible, far_away, nearby}) {
+        pool_->UploadTile(tile, pixel_data.data(), 256, 256, 4);
+    }
+
+    const TileImportanceFn importance = [&](const TileCoordinates& coords) {
+        if (coords == ancestor) {
+            return TileEvictionPolicy::kProtected;
+        }
+        if (coords == visible) {
+            return 2.0f;
+        }
+        return coords == nearby ? 0.5f : 0.1f;
+    };
+
+    // Protected tiles are never candidates, whatever the batch size
+    const auto victims = pool_->GetEvictionCandidates(8, importance);
+    ASSERT_EQ(victims.size(), 3u);
+    EXPECT_EQ(victims[0], far_away);
+    EXPECT_EQ(victims[1], nearby);
+    EXPECT_EQ(victims[2], visible);
+
+    EXPECT_EQ(pool_->GetEvictionCandidates(1, importance).size(), 1u);
+    EXPECT_TRUE(pool_->GetEvictionCandidates(0, importance).empty());
+}
+
+TEST_F(TileTexturePoolTest, GetEvictionCandidates_LruBreaksTies) {
+    auto pixel_data = CreateTestPixelData(256, 256, 4);
+
+    TileCoordinates tile_a(0, 0, 5);
+    TileCoordinates tile_b(1, 0, 5);
+    TileCoordinates tile_c(2, 0, 5);
+    for (const auto& tile : {tile_a, tile_b, tile_c}) {
+        pool_->UploadTile(tile, pixel_data.data(), 256, 256, 4);
+    }
+    pool_->TouchTile(tile_a);
+
+    // Without scores the batch is the LRU order
+    const auto victims = pool_->GetEvictionCandidates(3);
+    ASSERT_EQ(victims.size(), 3u);
+    EXPECT_EQ(victims[0], tile_b);
+    EXPECT_EQ(victims[1], tile_c);
+    EXPECT_EQ(victims[2], tile_a);
+}
+
 TEST_F(TileTexturePoolTest, GetEvictionCandidate_EmptyPool) {
     auto candidate = pool_->GetEvictionCandidate();
     EXPECT_FALSE(candidate.has_value());
@@ -335,6 +417,111 @@ TEST_F(TileTexturePoolTest, SmallPool_FullReturnsFailure) {
     EXPECT_EQ(small_pool->GetOccupiedLayers(), 4u);
 }
 
+TEST_F(TileTexturePoolTest, CompressedPoolAcceptsOnlyCompressedUploads) {
+    auto bc1_pool = std::make_unique<TileTexturePool>(256, 4, true, TileTextureFormat::BC1);
+    EXPECT_EQ(bc1_pool->GetFormat(), TileTextureFormat::BC1);
+
+    std::vector<std::uint8_t> blocks(
+        TileBlockCompressor::GetEncodedSize(TileTextureFormat::BC1, 256, 256));
+    EXPECT_GE(bc1_pool->UploadTile(TileCoordinates(0, 0, 1), blocks.data(), 256, 256, 0,
+                                   TileTextureFormat::BC1), 0);
+
+    auto pixel_data = CreateTestPixelData(256, 256, 4);
+    EXPECT_EQ(bc1_pool->UploadTile(TileCoordinates(1, 0, 1), pixel_data.data(), 256, 256, 4), -1);
+    EXPECT_EQ(pool_->UploadTile(TileCoordinates(1, 0, 1), blocks.data(), 256, 256, 4,
+                                TileTextureFormat::BC1), -1);
+    EXPECT_EQ(bc1_pool->GetOccupiedLayers(), 1u);
+}
+
+TEST_F(TileTexturePoolTest, MipmappedPoolExpectsFullChains) {
+    auto mip_pool = std::make_unique<TileTexturePool>(256, 4, true, TileTextureFormat::RGBA8, 99);
+    EXPECT_EQ(mip_pool->GetMipLevels(), 9u);  // clamped to 256 -> 1
+    EXPECT_EQ(mip_pool->GetLayerBytes(),
+              TileMipChain::GetLevelOffset(TileTextureFormat::RGBA8, 256, 9));
+
+    std::vector<std::uint8_t> chain(mip_pool->GetLayerBytes());
+    EXPECT_GE(mip_pool->UploadTile(TileCoordinates(0, 0, 1), chain.data(), 256, 256, 4,
+                                   TileTextureFormat::RGBA8, 9), 0);
+    EXPECT_EQ(mip_pool->UploadTile(TileCoordinates(1, 0, 1), chain.data(), 256, 256, 4), -1);
+    EXPECT_EQ(pool_->UploadTile(TileCoordinates(1, 0, 1), chain.data(), 256, 256, 4,
+                                TileTextureFormat::RGBA8, 9), -1);
+    EXPECT_EQ(mip_pool->GetOccupiedLayers(), 1u);
+
+    // BC1 chains stop at the 4x4 level
+    TileTexturePool bc1_pool(256, 4, true, TileTextureFormat::BC1, 99);
+    EXPECT_EQ(bc1_pool.GetMipLevels(), 7u);
+}
+
+// ============================================================================
+// Multiple arrays and layer budget
+// ============================================================================
+
+TEST_F(TileTexturePoolTest, ArraysAreAllocatedAsTilesArrive) {
+    // 64 layers over kMaxArrays arrays of 8
+    EXPECT_EQ(pool_->GetLayersPerArray(), 8u);
+    EXPECT_EQ(pool_->GetAllocatedArrayCount(), 0u);
+
+    auto pixel_data = CreateTestPixelData(256, 256, 4);
+    for (int i = 0; i < 20; ++i) {
+        const int layer = pool_->UploadTile(TileCoordinates(i, 0, 5), pixel_data.data(), 256, 256, 4);
+        EXPECT_EQ(layer, i);  // lowest free layer first
+    }
+
+    EXPECT_EQ(pool_->GetAllocatedArrayCount(), 3u);
+    EXPECT_EQ(pool_->GetAllocatedLayers(), 24u);
+    EXPECT_EQ(pool_->GetFreeLayers(), 44u);
+}
+
+TEST_F(TileTexturePoolTest, BudgetLimitsOccupiedLayers) {
+    pool_->SetBudgetLayers(10);
+    auto pixel_data = CreateTestPixelData(256, 256, 4);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_GE(pool_->UploadTile(TileCoordinates(i, 0, 5), pixel_data.data(), 256, 256, 4), 0);
+    }
+
+    EXPECT_EQ(pool_->GetFreeLayers(), 0u);
+    EXPECT_FALSE(pool_->IsOverBudget());
+    EXPECT_EQ(pool_->UploadTile(TileCoordinates(10, 0, 5), pixel_data.data(), 256, 256, 4), -1);
+    EXPECT_EQ(pool_->GetAllocatedArrayCount(), 2u);
+
+    pool_->SetBudgetLayers(1000);  // clamped to max_layers
+    EXPECT_EQ(pool_->GetBudgetLayers(), 64u);
+    EXPECT_GE(pool_->UploadTile(TileCoordinates(10, 0, 5), pixel_data.data(), 256, 256, 4), 0);
+}
+
+TEST_F(TileTexturePoolTest, LoweringBudgetDrainsAndReleasesArrays) {
+    auto pixel_data = CreateTestPixelData(256, 256, 4);
+    for (int i = 0; i < 32; ++i) {
+        pool_->UploadTile(TileCoordinates(i, 0, 5), pixel_data.data(), 256, 256, 4);
+    }
+    // Layers 0-7 most recently used: they must survive the shrink
+    for (int i = 0; i < 8; ++i) {
+        pool_->TouchTile(TileCoordinates(i, 0, 5));
+    }
+    // Layer 30 recently used too, but its array goes away
+    pool_->TouchTile(TileCoordinates(30, 0, 5));
+    ASSERT_EQ(pool_->GetAllocatedArrayCount(), 4u);
+
+    pool_->SetBudgetLayers(16);
+    EXPECT_TRUE(pool_->IsOverBudget());
+
+    std::vector<TileCoordinates> evicted;
+    while (pool_->IsOverBudget()) {
+        auto candidate = pool_->GetEvictionCandidate();
+        ASSERT_TRUE(candidate.has_value());
+        evicted.push_back(*candidate);
+        pool_->EvictTile(*candidate);
+    }
+
+    EXPECT_EQ(evicted.size(), 16u);
+    EXPECT_EQ(pool_->GetAllocatedArrayCount(), 2u);
+    EXPECT_EQ(pool_->GetOccupiedLayers(), 16u);
+    for (int i = 0; i < 16; ++i) {
+        EXPECT_TRUE(pool_->IsTileLoaded(TileCoordinates(i, 0, 5))) << i;
+    }
+    EXPECT_FALSE(pool_->IsTileLoaded(TileCoordinates(30, 0, 5)));
+}
+
 // ============================================================================
 // Integration: Pool + Indirection eviction coordination
 // ============================================================================
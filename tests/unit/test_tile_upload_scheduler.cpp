@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/texture_atlas/tile_upload_scheduler.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+std::unique_ptr<GLUploadCommand> MakeCommand(int32_t x, int32_t y, int32_t zoom,
+                                             bool has_slot = true) {
+    auto cmd = std::make_unique<GLUploadCommand>(TileCoordinates(x, y, zoom));
+    if (has_slot) {
+        cmd->slot.index = 0;
+        cmd->width = 256;
+        cmd->height = 256;
+        cmd->channels = 4;
+    }
+    return cmd;
+}
+
+} // namespace
+
+class TileUploadSchedulerTest : public ::testing::Test {
+protected:
+    TileUploadSchedulerTest() : scheduler_(TileUploadSchedulerConfig{}, true) {}
+
+    GLUploadQueue queue_;
+    TileUploadScheduler scheduler_;
+    std::vector<TileCoordinates> uploaded_;
+
+    TileUploadScheduler::UploadFn Recorder() {
+        return [this](GLUploadCommand& cmd) { uploaded_.push_back(cmd.coords); };
+    }
+};
+
+TEST_F(TileUploadSchedulerTest, EmptyQueueUploadsNothing) {
+    EXPECT_EQ(scheduler_.RunFrame(queue_, std::chrono::microseconds(2000), Recorder()), 0u);
+    EXPECT_TRUE(uploaded_.empty());
+    EXPECT_EQ(scheduler_.GetStats().uploads_last_frame, 0u);
+}
+
+TEST_F(TileUploadSchedulerTest, LargeBudgetDrainsQueue) {
+    for (int i = 0; i < 20; ++i) {
+        queue_.Push(MakeCommand(i, 0, 5));
+    }
+
+    EXPECT_EQ(scheduler_.RunFrame(queue_, std::chrono::seconds(10), Recorder()), 20u);
+    EXPECT_EQ(uploaded_.size(), 20u);
+    EXPECT_EQ(scheduler_.GetStagedCount(), 0u);
+    EXPECT_EQ(scheduler_.GetStats().total_uploads, 20u);
+}
+
+TEST_F(TileUploadSchedulerTest, LowestZoomThenClosestFirst) {
+    scheduler_.SetFocus(TileCoordinates(10, 10, 5));
+    queue_.Push(MakeCommand(0, 0, 5));
+    queue_.Push(MakeCommand(11, 10, 5));
+    queue_.Push(MakeCommand(2, 2, 3));
+    queue_.Push(MakeCommand(10, 10, 5));
+
+    scheduler_.RunFrame(queue_, std::chrono::seconds(10), Recorder());
+
+    ASSERT_EQ(uploaded_.size(), 4u);
+    EXPECT_EQ(uploaded_[0], TileCoordinates(2, 2, 3));
+    EXPECT_EQ(uploaded_[1], TileCoordinates(10, 10, 5));
+    EXPECT_EQ(uploaded_[2], TileCoordinates(11, 10, 5));
+    EXPECT_EQ(uploaded_[3], TileCoordinates(0, 0, 5));
+}
+
+TEST_F(TileUploadSchedulerTest, DistanceWrapsAroundAntimeridian) {
+    scheduler_.SetFocus(TileCoordinates(0, 4, 3));
+    queue_.Push(MakeCommand(4, 4, 3));
+    queue_.Push(MakeCommand(7, 4, 3));
+
+    scheduler_.RunFrame(queue_, std::chrono::seconds(10), Recorder());
+
+    ASSERT_EQ(uploaded_.size(), 2u);
+    EXPECT_EQ(uploaded_[0], TileCoordinates(7, 4, 3));
+}
+
+TEST_F(TileUploadSchedulerTest, BudgetLimitsUploadsAndCarriesOver) {
+    for (int i = 0; i < 10; ++i) {
+        queue_.Push(MakeCommand(i, 0, 4));
+    }
+
+    auto slow_upload = [this](GLUploadCommand& cmd) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        uploaded_.push_back(cmd.coords);
+    };
+
+    // Budget for roughly one slow upload: never zero, never everything
+    scheduler_.RunFrame(queue_, std::chrono::microseconds(1000), slow_upload);
+    EXPECT_GE(uploaded_.size(), 1u);
+    EXPECT_LT(uploaded_.size(), 10u);
+    EXPECT_EQ(scheduler_.GetStagedCount(), 10u - uploaded_.size());
+
+    // Remaining tiles are uploaded on later frames
+    for (int frame = 0; frame < 20 && scheduler_.GetStagedCount() > 0; ++frame) {
+        scheduler_.RunFrame(queue_, std::chrono::microseconds(1000), slow_upload);
+    }
+    EXPECT_EQ(uploaded_.size(), 10u);
+}
+
+TEST_F(TileUploadSchedulerTest, ZeroBudgetStillMakesProgress) {
+    queue_.Push(MakeCommand(0, 0, 2));
+    queue_.Push(MakeCommand(1, 0, 2));
+
+    scheduler_.RunFrame(queue_, std::chrono::microseconds(0), Recorder());
+
+    EXPECT_EQ(uploaded_.size(), 1u);
+}
+
+TEST_F(TileUploadSchedulerTest, FailuresBypassBudget) {
+    for (int i = 0; i < 5; ++i) {
+        queue_.Push(MakeCommand(i, 0, 3, false));
+    }
+    queue_.Push(MakeCommand(0, 1, 3));
+    queue_.Push(MakeCommand(1, 1, 3));
+
+    const std::size_t handled =
+        scheduler_.RunFrame(queue_, std::chrono::microseconds(0), Recorder());
+
+    // All failures plus the one guaranteed upload
+    EXPECT_EQ(handled, 6u);
+    EXPECT_EQ(scheduler_.GetStats().uploads_last_frame, 1u);
+    EXPECT_EQ(scheduler_.GetStagedCount(), 1u);
+}
+
+TEST_F(TileUploadSchedulerTest, RecyclesHandledCommandsOnly) {
+    std::vector<std::unique_ptr<GLUploadCommand>> recycled;
+    scheduler_.SetRecycler([&recycled](std::unique_ptr<GLUploadCommand> cmd) {
+        recycled.push_back(std::move(cmd));
+    });
+
+    queue_.Push(MakeCommand(0, 0, 3, false));
+    queue_.Push(MakeCommand(0, 1, 3));
+    queue_.Push(MakeCommand(1, 1, 3));
+
+    scheduler_.RunFrame(queue_, std::chrono::microseconds(0), Recorder());
+
+    // The failure and the one upload come back; the staged command stays
+    ASSERT_EQ(recycled.size(), 2u);
+    EXPECT_TRUE(recycled[0] && recycled[1]);
+    EXPECT_EQ(scheduler_.GetStagedCount(), 1u);
+}
+
+TEST_F(TileUploadSchedulerTest, CountsBudgetOverruns) {
+    queue_.Push(MakeCommand(0, 0, 1));
+
+    scheduler_.RunFrame(queue_, std::chrono::microseconds(100), [](GLUploadCommand&) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    });
+
+    const TileUploadStats stats = scheduler_.GetStats();
+    EXPECT_EQ(stats.budget_overruns, 1u);
+    EXPECT_GT(stats.estimated_upload_cost_us, 250.0);
+}
+
+TEST_F(TileUploadSchedulerTest, ReportsUploadsPerSecond) {
+    TileUploadSchedulerConfig config;
+    config.rate_window = std::chrono::milliseconds(20);
+    TileUploadScheduler scheduler(config, true);
+
+    for (int i = 0; i < 8; ++i) {
+        queue_.Push(MakeCommand(i, 0, 3));
+    }
+    scheduler.RunFrame(queue_, std::chrono::seconds(1), Recorder());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    scheduler.RunFrame(queue_, std::chrono::seconds(1), Recorder());
+
+    const TileUploadStats stats = scheduler.GetStats();
+    EXPECT_GT(stats.uploads_per_second, 0.0);
+    EXPECT_EQ(stats.total_uploads, 8u);
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/texture_atlas/tile_upload_thread.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+/**
+ * @brief OpenGLContext stand-in that can refuse to become current
+ */
+class FakeUploadContext : public OpenGLContext {
+public:
+    explicit FakeUploadContext(bool can_make_current) : can_make_current_(can_make_current) {}
+
+    bool Initialize() override { return true; }
+    bool MakeCurrent() override { return can_make_current_; }
+    bool ReleaseCurrent() override { return true; }
+    bool SwapBuffers() override { return false; }
+    bool IsValid() const override { return true; }
+    std::pair<std::uint32_t, std::uint32_t> GetActualVersion() const override { return {3, 3}; }
+    bool IsExtensionSupported(const std::string&) const override { return false; }
+    void SetErrorCallback(OpenGLErrorCallback) override {}
+    bool SetVSyncEnabled(bool) override { return false; }
+    std::string GetContextInfo() const override { return "fake"; }
+    void* GetNativeHandle() const override { return nullptr; }
+
+private:
+    bool can_make_current_;
+};
+
+} // namespace
+
+TEST(TileUploadThreadTest, RejectsEmptyBatchFunction) {
+    EXPECT_THROW(TileUploadThread(nullptr, TileUploadThread::BatchFn{}, true),
+                 std::invalid_argument);
+}
+
+TEST(TileUploadThreadTest, NotRunningWhenContextCannotBeMadeCurrent) {
+    std::atomic<int> batches{0};
+    TileUploadThread thread(std::make_unique<FakeUploadContext>(false),
+                            [&](std::vector<CompletedTileUpload>&) {
+                                ++batches;
+                                return false;
+                            },
+                            true);
+    EXPECT_FALSE(thread.IsRunning());
+    EXPECT_EQ(batches.load(), 0);
+}
+
+TEST(TileUploadThreadTest, PublishesBatchesInUploadOrder) {
+    std::atomic<int> next_x{0};
+    TileUploadThread thread(std::make_unique<FakeUploadContext>(true),
+                            [&](std::vector<CompletedTileUpload>& completed) {
+                                if (next_x.load() >= 6) {
+                                    return false;
+                                }
+                                for (int i = 0; i < 2; ++i) {
+                                    const int x = next_x++;
+                                    completed.push_back(
+                                        CompletedTileUpload{TileCoordinates(x, 0, 5), x, {}});
+                                }
+                                return true;
+                            },
+                            true);
+    ASSERT_TRUE(thread.IsRunning());
+
+    std::vector<int> published;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (published.size() < 6 && std::chrono::steady_clock::now() < deadline) {
+        thread.Publish([&](CompletedTileUpload& upload) {
+            EXPECT_EQ(upload.coords.x, upload.layer);
+            published.push_back(upload.layer);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    EXPECT_EQ(published, (std::vector<int>{0, 1, 2, 3, 4, 5}));
+    EXPECT_EQ(thread.GetBatchCount(), 3u);
+    EXPECT_EQ(thread.GetPendingBatchCount(), 0u);
+}
+
+} // namespace earth_map::tests
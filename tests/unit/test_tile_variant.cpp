@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/tile_cache.h>
+#include <earth_map/data/tile_loader.h>
+#include <earth_map/data/tile_variant.h>
+#include "loopback_http_server.h"
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+TileVariant MakeVariant(const std::string& name, float scale, const std::string& format,
+                        std::size_t bytes) {
+    TileVariant variant;
+    variant.name = name;
+    variant.pixel_scale = scale;
+    variant.format = format;
+    variant.quality = format == "png" ? 0 : 75;
+    variant.expected_bytes = bytes;
+    return variant;
+}
+
+/// @1x/@2x in JPEG and PNG, cheapest first
+std::vector<TileVariant> MakeVariants() {
+    return {MakeVariant("@1x-jpeg", 1.0f, "jpeg", 10000),
+            MakeVariant("@1x-png", 1.0f, "png", 40000),
+            MakeVariant("@2x-jpeg", 2.0f, "jpeg", 35000),
+            MakeVariant("@2x-png", 2.0f, "png", 150000)};
+}
+
+} // namespace
+
+TEST(TileVariantSelectorTest, PrefersRichestVariantAtTheNeededScale) {
+    TileVariantSelectorConfig config;
+    TileVariantSelector selector(config);
+    const auto variants = MakeVariants();
+
+    // No sample yet: optimistic
+    EXPECT_EQ(selector.GetThroughput(), 0.0);
+    EXPECT_EQ(selector.Select(variants, 10), 1u);
+    EXPECT_EQ(selector.GetPreferred(variants), 1u);
+
+    config.required_pixel_scale = 2.0f;
+    selector.SetConfig(config);
+    EXPECT_EQ(selector.GetPreferred(variants), 3u);
+
+    // Nothing covers the need: the largest scale is the best there is
+    config.required_pixel_scale = 3.0f;
+    selector.SetConfig(config);
+    EXPECT_EQ(selector.GetPreferred(variants), 3u);
+
+    EXPECT_EQ(selector.Select({}, 0), TileVariantSelector::kNoVariant);
+}
+
+TEST(TileVariantSelectorTest, DegradesOnSlowLinks) {
+    TileVariantSelectorConfig config;
+    config.required_pixel_scale = 2.0f;
+    config.target_latency = std::chrono::milliseconds(1000);
+    config.throughput_smoothing = 1.0;
+    TileVariantSelector selector(config);
+    const auto variants = MakeVariants();
+
+    // 10 MB/s: @2x PNG arrives in time behind a few pending downloads
+    selector.RecordTransfer(100000, 10, 1);
+    EXPECT_DOUBLE_EQ(selector.GetThroughput(), 10e6);
+    EXPECT_EQ(selector.Select(variants, 4), 3u);
+
+    // 100 KB/s (satellite): @2x JPEG still covers the screen
+    selector.RecordTransfer(50000, 1000, 2);
+    EXPECT_DOUBLE_EQ(selector.GetThroughput(), 100000.0);
+    EXPECT_EQ(selector.Select(variants, 0), 2u);
+
+    // Deep queue: nothing arrives in time, the cheapest variant covering the need
+    EXPECT_EQ(selector.Select(variants, 100), 2u);
+
+    // @1x display: @1x PNG fits, @1x JPEG once the queue grows
+    config.required_pixel_scale = 1.0f;
+    selector.SetConfig(config);
+    EXPECT_EQ(selector.Select(variants, 0), 1u);
+    EXPECT_EQ(selector.Select(variants, 10), 0u);
+}
+
+TEST(TileVariantSelectorTest, IdleNeedsAThroughputSample) {
+    TileVariantSelectorConfig config;
+    config.idle_pending_downloads = 1;
+    TileVariantSelector selector(config);
+    EXPECT_FALSE(selector.IsIdle(0));
+
+    selector.RecordTransfer(0, 10, 1);  // Empty bodies say nothing about the link
+    EXPECT_FALSE(selector.IsIdle(0));
+
+    selector.RecordTransfer(1000, 10, 1);
+    EXPECT_TRUE(selector.IsIdle(1));
+    EXPECT_FALSE(selector.IsIdle(2));
+}
+
+TEST(TileVariantLoaderTest, DegradedTileIsRefinedWhenIdle) {
+    LoopbackHttpServer server([](const std::string& request) {
+        const std::string body = request.find("/hd/") != std::string::npos ? "rich-tile"
+                                                                            : "lean";
+        return "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(body.size()) +
+               "\r\nConnection: close\r\n\r\n" + body;
+    });
+
+    const auto directory = std::filesystem::temp_directory_path() / "earth_map_tile_variant";
+    std::filesystem::remove_all(directory);
+    TileCacheConfig cache_config;
+    cache_config.disk_cache_directory = directory.string();
+    std::shared_ptr<TileCache> cache = CreateTileCache(cache_config);
+    ASSERT_TRUE(cache->Initialize(cache_config));
+
+    // Nothing arrives within a zero budget: every measured download degrades
+    TileLoaderConfig config;
+    config.variant_target_latency = 0;
+    auto loader = CreateTileLoader(config);
+    ASSERT_TRUE(loader->Initialize(config));
+    loader->SetTileCache(cache);
+
+    auto provider = std::make_shared<BasicXYZTileProvider>("Variants", server.BaseUrl() + "/{z}/{x}/{y}.png");
+    provider->AddVariant(MakeVariant("lean", 1.0f, "jpeg", 4), server.BaseUrl() + "/lean/{z}/{x}/{y}.jpg");
+    provider->AddVariant(MakeVariant("hd", 1.0f, "png", 9), server.BaseUrl() + "/hd/{z}/{x}/{y}.png");
+    ASSERT_TRUE(loader->AddProvider(provider));
+    ASSERT_TRUE(loader->SetDefaultProvider("Variants"));
+
+    std::atomic<int> refined{0};
+    loader->SetRefinementCallback([&refined](const TileLoadResult& result) {
+        EXPECT_EQ(result.variant, "hd");
+        ++refined;
+    });
+
+    // No throughput sample yet: the preferred variant
+    auto first = loader->LoadTile(TileCoordinates(1, 1, 3));
+    ASSERT_TRUE(first.success) << first.error_message;
+    EXPECT_EQ(first.variant, "hd");
+
+    auto second = loader->LoadTile(TileCoordinates(2, 1, 3));
+    ASSERT_TRUE(second.success) << second.error_message;
+    EXPECT_EQ(second.variant, "lean");
+    EXPECT_EQ(second.tile_data->metadata.content_type, "image/jpeg");
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (refined.load() == 0 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_EQ(refined.load(), 1);
+
+    auto cached = cache->Get(TileCoordinates(2, 1, 3));
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_EQ(std::string(cached->data.begin(), cached->data.end()), "rich-tile");
+
+    const auto stats = loader->GetStatistics();
+    EXPECT_EQ(stats.degraded_loads, 1u);
+    EXPECT_EQ(stats.refined_loads, 1u);
+    EXPECT_GT(stats.throughput_bytes_per_second, 0.0);
+
+    loader.reset();
+    cache.reset();
+    std::filesystem::remove_all(directory);
+}
+
+} // namespace earth_map::tests
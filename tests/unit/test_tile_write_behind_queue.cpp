@@ -0,0 +1,308 @@
+#include <gtest/gtest.h>
+#include <earth_map/data/tile_write_behind_queue.h>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+std::shared_ptr<const TileData> MakeTile(int32_t x, int32_t y, int32_t zoom,
+                                         std::uint8_t fill = 1) {
+    auto tile = std::make_shared<TileData>();
+    tile->metadata.coordinates = TileCoordinates(x, y, zoom);
+    tile->metadata.file_size = 16;
+    tile->data = std::vector<std::uint8_t>(16, fill);
+    tile->loaded = true;
+    return tile;
+}
+
+TileDiskOp WriteOp(int32_t x, int32_t y, int32_t zoom, std::uint8_t fill = 1) {
+    return TileDiskOp{TileDiskOp::Kind::WRITE_TILE, TileCoordinates(x, y, zoom),
+                      MakeTile(x, y, zoom, fill), nullptr};
+}
+
+/// Writer that blocks until released, recording every batch
+class GatedWriter {
+public:
+    void operator()(const std::vector<TileDiskOp>& batch) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return open_; });
+        batches_.push_back(batch);
+    }
+
+    void Open() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            open_ = true;
+        }
+        cv_.notify_all();
+    }
+
+    std::vector<std::vector<TileDiskOp>> Batches() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return batches_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool open_ = false;
+    std::vector<std::vector<TileDiskOp>> batches_;
+};
+
+} // namespace
+
+TEST(TileWriteBehindQueueTest, RequiresWriter) {
+    EXPECT_THROW(TileWriteBehindQueue(4, nullptr), std::invalid_argument);
+}
+
+TEST(TileWriteBehindQueueTest, PendingOpsStayVisibleUntilWritten) {
+    GatedWriter writer;
+    TileWriteBehindQueue queue(16, [&writer](const auto& batch) { writer(batch); });
+
+    queue.Enqueue(WriteOp(1, 2, 3));
+    auto pending = queue.Find(TileCoordinates(1, 2, 3));
+    ASSERT_TRUE(pending.has_value());
+    EXPECT_EQ(pending->kind, TileDiskOp::Kind::WRITE_TILE);
+    EXPECT_EQ(queue.Size(), 1u);
+
+    writer.Open();
+    queue.Flush();
+    EXPECT_FALSE(queue.Find(TileCoordinates(1, 2, 3)).has_value());
+    EXPECT_EQ(queue.Size(), 0u);
+}
+
+TEST(TileWriteBehindQueueTest, CoalescesOpsOnSameTile) {
+    GatedWriter writer;
+    TileWriteBehindQueue queue(16, [&writer](const auto& batch) { writer(batch); });
+
+    // The I/O thread may grab the first op; park it behind the gate
+    queue.Enqueue(WriteOp(9, 9, 9));
+    queue.Enqueue(WriteOp(1, 1, 1, 1));
+    queue.Enqueue(WriteOp(1, 1, 1, 2));
+
+    auto metadata = std::make_shared<TileMetadata>(TileCoordinates(1, 1, 1));
+    metadata->etag = "v2";
+    queue.Enqueue(TileDiskOp{TileDiskOp::Kind::WRITE_METADATA, TileCoordinates(1, 1, 1),
+                             nullptr, metadata});
+
+    // Metadata folds into the pending tile write
+    auto pending = queue.Find(TileCoordinates(1, 1, 1));
+    ASSERT_TRUE(pending.has_value());
+    ASSERT_EQ(pending->kind, TileDiskOp::Kind::WRITE_TILE);
+    EXPECT_EQ(pending->tile->data[0], 2u);
+    EXPECT_EQ(pending->tile->metadata.etag, "v2");
+    EXPECT_GE(queue.GetCoalescedCount(), 1u);
+
+    writer.Open();
+    queue.Flush();
+
+    std::size_t writes_of_tile = 0;
+    for (const auto& batch : writer.Batches()) {
+        for (const auto& op : batch) {
+            if (op.coordinates == TileCoordinates(1, 1, 1)) {
+                ++writes_of_tile;
+                EXPECT_EQ(op.tile->metadata.etag, "v2");
+            }
+        }
+    }
+    EXPECT_LE(writes_of_tile, 2u);
+    EXPECT_GE(writes_of_tile, 1u);
+}
+
+TEST(TileWriteBehindQueueTest, RemoveSupersedesLaterMetadataWrite) {
+    GatedWriter writer;
+    TileWriteBehindQueue queue(16, [&writer](const auto& batch) { writer(batch); });
+
+    queue.Enqueue(WriteOp(9, 9, 9));
+    queue.Enqueue(WriteOp(1, 1, 1));
+    queue.Enqueue(TileDiskOp{TileDiskOp::Kind::REMOVE, TileCoordinates(1, 1, 1),
+                             nullptr, nullptr});
+    queue.Enqueue(TileDiskOp{TileDiskOp::Kind::WRITE_METADATA, TileCoordinates(1, 1, 1),
+                             nullptr, std::make_shared<TileMetadata>(TileCoordinates(1, 1, 1))});
+
+    auto pending = queue.Find(TileCoordinates(1, 1, 1));
+    ASSERT_TRUE(pending.has_value());
+    EXPECT_EQ(pending->kind, TileDiskOp::Kind::REMOVE);
+
+    writer.Open();
+    queue.Flush();
+
+    // Whatever reached the writer, the last op for the tile is the removal
+    std::optional<TileDiskOp::Kind> last;
+    for (const auto& batch : writer.Batches()) {
+        for (const auto& op : batch) {
+            if (op.coordinates == TileCoordinates(1, 1, 1)) {
+                last = op.kind;
+            }
+        }
+    }
+    ASSERT_TRUE(last.has_value());
+    EXPECT_EQ(*last, TileDiskOp::Kind::REMOVE);
+}
+
+TEST(TileWriteBehindQueueTest, BatchesAreSortedByTile) {
+    GatedWriter writer;
+    TileWriteBehindQueue queue(64, [&writer](const auto& batch) { writer(batch); });
+
+    queue.Enqueue(WriteOp(0, 0, 0));  // May be taken alone while the gate is closed
+    for (int i = 10; i > 0; --i) {
+        queue.Enqueue(WriteOp(i, 0, 5));
+        queue.Enqueue(WriteOp(i, 0, 2));
+    }
+    writer.Open();
+    queue.Flush();
+
+    for (const auto& batch : writer.Batches()) {
+        for (std::size_t i = 1; i < batch.size(); ++i) {
+            const auto& a = batch[i - 1].coordinates;
+            const auto& b = batch[i].coordinates;
+            EXPECT_TRUE(a.zoom < b.zoom || (a.zoom == b.zoom && a.x < b.x));
+        }
+    }
+}
+
+TEST(TileWriteBehindQueueTest, FullQueueBlocksProducer) {
+    GatedWriter writer;
+    TileWriteBehindQueue queue(2, [&writer](const auto& batch) { writer(batch); });
+
+    queue.Enqueue(WriteOp(1, 0, 1));
+    queue.Enqueue(WriteOp(2, 0, 1));
+
+    auto blocked = std::async(std::launch::async, [&queue] { queue.Enqueue(WriteOp(3, 0, 1)); });
+    EXPECT_EQ(blocked.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+
+    // Updating an already pending tile needs no extra slot
+    queue.Enqueue(WriteOp(1, 0, 1, 7));
+
+    writer.Open();
+    blocked.get();
+    queue.Flush();
+    EXPECT_EQ(queue.Size(), 0u);
+}
+
+TEST(TileWriteBehindQueueTest, DestructorWritesEverything) {
+    std::atomic<std::size_t> written{0};
+    {
+        TileWriteBehindQueue queue(256, [&written](const auto& batch) {
+            written += batch.size();
+        });
+        for (int i = 0; i < 100; ++i) {
+            queue.Enqueue(WriteOp(i, 0, 10));
+        }
+    }
+    EXPECT_EQ(written.load(), 100u);
+}
+
+TEST(TileWriteBehindQueueTest, DiscardDropsPendingOps) {
+    GatedWriter writer;
+    TileWriteBehindQueue queue(16, [&writer](const auto& batch) { writer(batch); });
+
+    queue.Enqueue(WriteOp(1, 0, 1));
+    auto discarded = std::async(std::launch::async, [&queue] { queue.Discard(); });
+    writer.Open();
+    discarded.get();
+
+    EXPECT_EQ(queue.Size(), 0u);
+    EXPECT_FALSE(queue.Find(TileCoordinates(1, 0, 1)).has_value());
+}
+
+class TileCacheWriteBehindTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        directory_ = std::filesystem::temp_directory_path() /
+                     (std::string("earth_map_write_behind_") +
+                      ::testing::UnitTest::GetInstance()->current_test_info()->name());
+        std::filesystem::remove_all(directory_);
+        config_.disk_cache_directory = directory_.string();
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory_);
+    }
+
+    TileData MakeCacheTile(int32_t x, int32_t y, int32_t zoom) const {
+        TileData tile = *MakeTile(x, y, zoom, static_cast<std::uint8_t>(x));
+        tile.metadata.last_modified = std::chrono::system_clock::now();
+        return tile;
+    }
+
+    std::filesystem::path directory_;
+    TileCacheConfig config_;
+};
+
+TEST_F(TileCacheWriteBehindTest, FlushPersistsTiles) {
+    auto cache = CreateTileCache(config_);
+    ASSERT_TRUE(cache->Initialize(config_));
+
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_TRUE(cache->Put(MakeCacheTile(i, 1, 5)));
+    }
+    cache->Flush();
+
+    EXPECT_EQ(cache->GetStatistics().pending_disk_writes, 0u);
+    EXPECT_EQ(cache->GetStatistics().disk_cache_count, 20u);
+    EXPECT_TRUE(std::filesystem::exists(directory_ / "5" / "3_1.tile"));
+}
+
+TEST_F(TileCacheWriteBehindTest, ShutdownFlushesQueuedWrites) {
+    {
+        auto cache = CreateTileCache(config_);
+        ASSERT_TRUE(cache->Initialize(config_));
+        for (int i = 0; i < 50; ++i) {
+            ASSERT_TRUE(cache->Put(MakeCacheTile(i, 2, 7)));
+        }
+    }
+
+    auto cache = CreateTileCache(config_);
+    ASSERT_TRUE(cache->Initialize(config_));
+    for (int i = 0; i < 50; ++i) {
+        auto tile = cache->Get(TileCoordinates(i, 2, 7));
+        ASSERT_TRUE(tile.has_value()) << i;
+        EXPECT_EQ(tile->data[0], static_cast<std::uint8_t>(i));
+    }
+}
+
+TEST_F(TileCacheWriteBehindTest, PendingTilesSurviveMemoryEviction) {
+    config_.max_tile_count = 1;
+    auto cache = CreateTileCache(config_);
+    ASSERT_TRUE(cache->Initialize(config_));
+
+    ASSERT_TRUE(cache->Put(MakeCacheTile(1, 1, 3)));
+    ASSERT_TRUE(cache->Put(MakeCacheTile(2, 1, 3)));
+
+    // Evicted from memory, served either from the queue or from disk
+    auto tile = cache->Get(TileCoordinates(1, 1, 3));
+    ASSERT_TRUE(tile.has_value());
+    EXPECT_EQ(tile->data[0], 1u);
+}
+
+TEST_F(TileCacheWriteBehindTest, RemoveIsOrderedAfterPut) {
+    auto cache = CreateTileCache(config_);
+    ASSERT_TRUE(cache->Initialize(config_));
+
+    ASSERT_TRUE(cache->Put(MakeCacheTile(4, 4, 4)));
+    EXPECT_TRUE(cache->Remove(TileCoordinates(4, 4, 4)));
+    EXPECT_FALSE(cache->Contains(TileCoordinates(4, 4, 4)));
+
+    cache->Flush();
+    EXPECT_FALSE(cache->Contains(TileCoordinates(4, 4, 4)));
+    EXPECT_FALSE(std::filesystem::exists(directory_ / "4" / "4_4.tile"));
+}
+
+TEST_F(TileCacheWriteBehindTest, SynchronousModeWritesInline) {
+    config_.enable_write_behind = false;
+    auto cache = CreateTileCache(config_);
+    ASSERT_TRUE(cache->Initialize(config_));
+
+    ASSERT_TRUE(cache->Put(MakeCacheTile(6, 6, 6)));
+    EXPECT_TRUE(std::filesystem::exists(directory_ / "6" / "6_6.tile"));
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <earth_map/math/vector_math.h>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+/// Distance in units in the last place between two doubles of the same sign
+std::int64_t UlpDistance(double a, double b) {
+    if (a == b) {
+        return 0;
+    }
+    if (std::isnan(a) || std::isnan(b)) {
+        return std::isnan(a) && std::isnan(b) ? 0 : std::numeric_limits<std::int64_t>::max();
+    }
+    const auto ordered = [](double v) {
+        const auto bits = std::bit_cast<std::int64_t>(v);
+        return bits < 0 ? std::numeric_limits<std::int64_t>::min() - bits : bits;
+    };
+    const std::int64_t distance = ordered(a) - ordered(b);
+    return distance < 0 ? -distance : distance;
+}
+
+std::vector<double> Uniform(std::size_t count, double low, double high, unsigned seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> dist(low, high);
+    std::vector<double> values(count);
+    for (double& value : values) {
+        value = dist(rng);
+    }
+    return values;
+}
+
+} // namespace
+
+TEST(VectorMathTest, SinCosWithinTwoUlp) {
+    std::vector<double> x = Uniform(100001, -100.0, 100.0, 1);
+    x.insert(x.end(), {0.0, -0.0, 1e-300, M_PI / 4, M_PI / 2, M_PI, -M_PI, 3 * M_PI / 2,
+                       VectorMath::kMaxSinCosArgument, 1e9, std::numeric_limits<double>::infinity(),
+                       std::numeric_limits<double>::quiet_NaN()});
+    std::vector<double> s(x.size());
+    std::vector<double> c(x.size());
+    VectorMath::SinCos(x, s, c);
+    // Near zeros of sin/cos compare absolutely; elsewhere in ULP
+    const auto expect_close = [](double actual, double expected, double x_value) {
+        if (std::abs(expected) > 1e-3 || !std::isfinite(expected)) {
+            EXPECT_LE(UlpDistance(actual, expected), 2) << x_value;
+        } else {
+            EXPECT_NEAR(actual, expected, 1e-17) << x_value;
+        }
+    };
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        expect_close(s[i], std::sin(x[i]), x[i]);
+        expect_close(c[i], std::cos(x[i]), x[i]);
+    }
+}
+
+TEST(VectorMathTest, Atan2WithinTwoUlp) {
+    std::vector<double> y = Uniform(100001, -10.0, 10.0, 2);
+    std::vector<double> x = Uniform(100001, -10.0, 10.0, 3);
+    const double inf = std::numeric_limits<double>::infinity();
+    const std::vector<std::pair<double, double>> special = {
+        {0.0, 0.0}, {-0.0, 0.0}, {0.0, -0.0}, {-0.0, -0.0}, {0.0, -1.0}, {-0.0, -1.0},
+        {1.0, 0.0}, {1.0, -0.0}, {inf, 1.0}, {1.0, -inf}, {1e-310, 1.0}, {1.0, 1.0}};
+    for (const auto& [sy, sx] : special) {
+        y.push_back(sy);
+        x.push_back(sx);
+    }
+    std::vector<double> out(y.size());
+    VectorMath::Atan2(y, x, out);
+    for (std::size_t i = 0; i < y.size(); ++i) {
+        ASSERT_LE(UlpDistance(out[i], std::atan2(y[i], x[i])), 2) << y[i] << ", " << x[i];
+    }
+}
+
+TEST(VectorMathTest, LogWithinOneUlpAndInPlace) {
+    std::vector<double> x = Uniform(100001, 1e-6, 1e6, 4);
+    const std::vector<double> wide = Uniform(1000, -700.0, 700.0, 5);
+    for (const double e : wide) {
+        x.push_back(std::exp(e));
+    }
+    x.insert(x.end(), {1.0, 2.0, 0.5, 4.9e-324, 0.0, -1.0, std::numeric_limits<double>::infinity()});
+    const std::vector<double> input = x;
+    VectorMath::Log(x, x);
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        ASSERT_LE(UlpDistance(x[i], std::log(input[i])), 1) << input[i];
+    }
+
+    std::vector<double> short_out(3);
+    EXPECT_THROW(VectorMath::Log(input, short_out), std::invalid_argument);
+}
+
+} // namespace earth_map::tests
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/vector_tile/vector_tile_arena.h>
+
+namespace earth_map::tests {
+
+namespace {
+
+VectorTileMesh MakeMesh(std::size_t vertices, std::size_t indices, std::size_t fill_indices = 0) {
+    VectorTileMesh mesh;
+    mesh.vertices.resize(vertices);
+    mesh.indices.resize(indices);
+    mesh.fill_index_count = fill_indices;
+    return mesh;
+}
+
+} // namespace
+
+TEST(VectorTileArenaTest, AllocatesFirstFitAndCoalescesFreedRanges) {
+    VectorTileArena arena(100, 300, true);
+    EXPECT_EQ(arena.GetVertexArray(), 0u);
+    EXPECT_EQ(arena.GetGpuMemoryBytes(), 0u);
+
+    const auto a = arena.Upload(MakeMesh(40, 120, 60));
+    const auto b = arena.Upload(MakeMesh(30, 90));
+    const auto c = arena.Upload(MakeMesh(30, 90));
+    ASSERT_TRUE(a && b && c);
+    EXPECT_EQ(a->first_vertex, 0u);
+    EXPECT_EQ(a->fill_index_count, 60u);
+    EXPECT_EQ(b->first_vertex, 40u);
+    EXPECT_EQ(b->first_index, 120u);
+    EXPECT_EQ(c->first_vertex, 70u);
+    EXPECT_EQ(arena.GetUsedVertices(), 100u);
+    EXPECT_EQ(arena.GetUsedIndices(), 300u);
+
+    // Full: nothing fits until tiles are freed
+    EXPECT_FALSE(arena.Upload(MakeMesh(1, 3)).has_value());
+
+    // Freeing a and b leaves one 70-vertex range, not two
+    arena.Free(*b);
+    arena.Free(*a);
+    const auto d = arena.Upload(MakeMesh(70, 210));
+    ASSERT_TRUE(d.has_value());
+    EXPECT_EQ(d->first_vertex, 0u);
+    EXPECT_EQ(d->first_index, 0u);
+
+    arena.Free(*c);
+    arena.Free(*d);
+    EXPECT_EQ(arena.GetUsedVertices(), 0u);
+    EXPECT_EQ(arena.GetUsedIndices(), 0u);
+    EXPECT_TRUE(arena.Upload(MakeMesh(100, 300)).has_value());
+}
+
+TEST(VectorTileArenaTest, FailsWithoutTakingEitherRange) {
+    VectorTileArena arena(100, 10, true);
+    // Vertices fit, indices do not: the vertex range is returned
+    EXPECT_FALSE(arena.Upload(MakeMesh(50, 20)).has_value());
+    EXPECT_EQ(arena.GetUsedVertices(), 0u);
+    EXPECT_FALSE(arena.Upload(MakeMesh(101, 3)).has_value());
+
+    // Empty meshes (nothing styled) are resident without taking room
+    const auto empty = arena.Upload(MakeMesh(0, 0));
+    ASSERT_TRUE(empty.has_value());
+    EXPECT_EQ(empty->index_count, 0u);
+    arena.Free(*empty);
+    EXPECT_EQ(arena.GetUsedVertices(), 0u);
+}
+
+} // namespace earth_map::tests
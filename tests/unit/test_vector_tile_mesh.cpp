@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <earth_map/renderer/vector_tile/vector_tile_mesh.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace earth_map::tests {
+
+namespace {
+
+using Ring = std::vector<glm::vec2>;
+
+/// Total area of triangles over the concatenated rings
+double TriangleArea(const std::vector<Ring>& rings, const std::vector<std::uint32_t>& indices) {
+    std::vector<glm::vec2> points;
+    for (const Ring& ring : rings) {
+        points.insert(points.end(), ring.begin(), ring.end());
+    }
+    double area = 0.0;
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const glm::vec2 a = points[indices[i]];
+        const glm::vec2 b = points[indices[i + 1]];
+        const glm::vec2 c = points[indices[i + 2]];
+        area += std::abs((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) * 0.5;
+    }
+    return area;
+}
+
+} // namespace
+
+TEST(VectorTileMeshTest, TriangulatesConcavePolygon) {
+    // L shape, area 0.75, in either orientation
+    Ring shape = {{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 0.5f}, {0.5f, 0.5f}, {0.5f, 1.0f}, {0.0f, 1.0f}};
+    for (int pass = 0; pass < 2; ++pass) {
+        const std::vector<Ring> rings = {shape};
+        const auto indices = TriangulatePolygon(rings);
+        EXPECT_EQ(indices.size(), 4u * 3u);
+        EXPECT_NEAR(TriangleArea(rings, indices), 0.75, 1e-6);
+        std::reverse(shape.begin(), shape.end());
+    }
+}
+
+TEST(VectorTileMeshTest, TriangulatesPolygonWithHoles) {
+    const std::vector<Ring> rings = {
+        {{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}},
+        {{0.2f, 0.2f}, {0.2f, 0.4f}, {0.4f, 0.4f}, {0.4f, 0.2f}},
+        {{0.6f, 0.6f}, {0.6f, 0.8f}, {0.8f, 0.8f}, {0.8f, 0.6f}},
+    };
+    const auto indices = TriangulatePolygon(rings);
+    // n + 2h - 2 triangles for n vertices and h holes
+    EXPECT_EQ(indices.size(), (12u + 4u - 2u) * 3u);
+    EXPECT_NEAR(TriangleArea(rings, indices), 1.0 - 2 * 0.04, 1e-5);
+    for (const std::uint32_t index : indices) {
+        EXPECT_LT(index, 12u);
+    }
+
+    EXPECT_TRUE(TriangulatePolygon(std::vector<Ring>{{{0.0f, 0.0f}, {1.0f, 1.0f}}}).empty());
+}
+
+TEST(VectorTileMeshTest, ClipsRingsToTheTile) {
+    const Ring inside = {{0.1f, 0.1f}, {0.9f, 0.1f}, {0.5f, 0.9f}};
+    EXPECT_EQ(ClipRingToTile(inside), inside);
+
+    // Square overlapping the tile's right edge into the buffer
+    const Ring straddling = {{0.5f, 0.25f}, {1.5f, 0.25f}, {1.5f, 0.75f}, {0.5f, 0.75f}};
+    const Ring clipped = ClipRingToTile(straddling);
+    EXPECT_NEAR(MvtRingArea(clipped), 0.25, 1e-6);
+    for (const glm::vec2& p : clipped) {
+        EXPECT_LE(p.x, 1.0f);
+    }
+
+    const Ring outside = {{1.1f, 0.1f}, {1.9f, 0.1f}, {1.5f, 0.9f}};
+    EXPECT_TRUE(ClipRingToTile(outside).empty());
+}
+
+TEST(VectorTileMeshTest, TessellatesStyledLayers) {
+    MvtTile tile;
+    MvtLayer water;
+    water.name = "water";
+    MvtFeature lake;
+    lake.type = MvtGeometryType::POLYGON;
+    lake.geometry = {{{0.0f, 0.0f}, {0.5f, 0.0f}, {0.5f, 0.5f}, {0.0f, 0.5f}}};
+    water.features.push_back(lake);
+    MvtFeature river;
+    river.type = MvtGeometryType::LINESTRING;
+    // The second segment leaves the tile and is clipped, the third is outside
+    river.geometry = {{{0.5f, 0.5f}, {0.75f, 0.5f}, {1.25f, 0.5f}, {1.5f, 0.75f}}};
+    water.features.push_back(river);
+    MvtFeature spring;
+    spring.type = MvtGeometryType::POINT;
+    spring.geometry = {{{0.25f, 0.25f}}};
+    water.features.push_back(spring);
+    tile.layers.push_back(water);
+    MvtLayer roads;
+    roads.name = "roads";
+    MvtFeature road;
+    road.type = MvtGeometryType::LINESTRING;
+    road.geometry = {{{0.0f, 1.0f}, {1.0f, 0.0f}}};
+    roads.features.push_back(road);
+    tile.layers.push_back(roads);
+
+    VectorTileStyle style;
+    style.layer = "water";
+    style.fill_color = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+    style.line_width = 2.0f;
+    const std::vector<VectorTileStyle> styles = {VectorTileStyle{}, style};
+
+    const VectorTileMesh mesh = TessellateVectorTile(tile, styles);
+    // Two fill triangles, then two line quads; the roads layer is unstyled
+    EXPECT_EQ(mesh.fill_index_count, 6u);
+    ASSERT_EQ(mesh.indices.size(), 6u + 2u * 6u);
+    ASSERT_EQ(mesh.vertices.size(), 4u + 2u * 4u);
+    EXPECT_EQ(mesh.GetByteSize(), 12u * sizeof(VectorTileVertex) + 18u * sizeof(std::uint32_t));
+    for (std::size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(mesh.vertices[i].extrude, glm::vec2(0.0f));
+    }
+    for (const VectorTileVertex& vertex : mesh.vertices) {
+        EXPECT_EQ(vertex.style, 1.0f);
+        EXPECT_LE(vertex.position.x, 1.0f);
+    }
+    // Line vertices carry the unit normal of their segment, both ways
+    EXPECT_NEAR(std::abs(mesh.vertices[4].extrude.y), 1.0f, 1e-6f);
+    EXPECT_EQ(mesh.vertices[4].extrude, -mesh.vertices[5].extrude);
+    for (std::size_t i = mesh.fill_index_count; i < mesh.indices.size(); ++i) {
+        EXPECT_GE(mesh.indices[i], 4u);
+    }
+
+    EXPECT_TRUE(TessellateVectorTile(tile, {}).indices.empty());
+}
+
+} // namespace earth_map::tests
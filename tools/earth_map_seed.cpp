@@ -0,0 +1,192 @@
+/**
+ * @file earth_map_seed.cpp
+ * @brief Command line tool seeding a region into the packed tile cache
+ *
+ * Usage:
+ *   earth_map_seed --bbox MIN_LON,MIN_LAT,MAX_LON,MAX_LAT --zoom MIN-MAX
+ *                  [--url TEMPLATE] [--cache-dir DIR] [--parallel N]
+ *                  [--rate REQUESTS_PER_SECOND] [--compression none|gzip|lz4|zstd]
+ *
+ * Tiles go to DIR/packed, where a TileCache with the PACKED disk backend and
+ * disk_cache_directory DIR finds them. Interrupting (Ctrl+C) stops after the
+ * downloads in flight are stored; running the same command again resumes.
+ */
+
+#include <earth_map/data/tile_seeder.h>
+#include <earth_map/data/tile_loader.h>
+#include <earth_map/data/packed_tile_store.h>
+#include <spdlog/spdlog.h>
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+namespace {
+
+std::atomic<earth_map::TileSeeder*> g_seeder{nullptr};
+
+void HandleSignal(int /*signal*/) {
+    if (auto* seeder = g_seeder.load()) {
+        seeder->Cancel();
+    }
+}
+
+void PrintUsage() {
+    std::cerr <<
+        "Usage: earth_map_seed --bbox MIN_LON,MIN_LAT,MAX_LON,MAX_LAT --zoom MIN-MAX [options]\n"
+        "\n"
+        "Options:\n"
+        "  --url TEMPLATE        Tile URL template (default: OpenStreetMap)\n"
+        "  --cache-dir DIR       Tile cache directory (default: ./tile_cache)\n"
+        "  --parallel N          Downloads in flight (default: 8)\n"
+        "  --rate R              Download starts per second, 0 = unlimited (default: 10)\n"
+        "  --compression TYPE    none, gzip, lz4 or zstd (default: none)\n"
+        "  --no-resume           Download tiles even if already stored\n";
+}
+
+bool ParseBounds(const std::string& text, earth_map::GeographicBounds& bounds) {
+    double min_lon = 0.0, min_lat = 0.0, max_lon = 0.0, max_lat = 0.0;
+    char c1 = 0, c2 = 0, c3 = 0;
+    std::istringstream stream(text);
+    if (!(stream >> min_lon >> c1 >> min_lat >> c2 >> max_lon >> c3 >> max_lat) ||
+        c1 != ',' || c2 != ',' || c3 != ',') {
+        return false;
+    }
+    bounds = earth_map::GeographicBounds(earth_map::Geographic(min_lat, min_lon),
+                                         earth_map::Geographic(max_lat, max_lon));
+    return bounds.IsValid();
+}
+
+bool ParseZoomRange(const std::string& text, int& min_zoom, int& max_zoom) {
+    char dash = 0;
+    std::istringstream stream(text);
+    if (!(stream >> min_zoom)) {
+        return false;
+    }
+    max_zoom = min_zoom;
+    if (stream >> dash) {
+        if (dash != '-' || !(stream >> max_zoom)) {
+            return false;
+        }
+    }
+    return min_zoom >= 0 && min_zoom <= max_zoom && max_zoom <= 30;
+}
+
+bool ParseCompression(const std::string& text, earth_map::TileMetadata::Compression& type) {
+    using Compression = earth_map::TileMetadata::Compression;
+    if (text == "none") {
+        type = Compression::NONE;
+    } else if (text == "gzip") {
+        type = Compression::GZIP;
+    } else if (text == "lz4") {
+        type = Compression::LZ4;
+    } else if (text == "zstd") {
+        type = Compression::ZSTD;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    using namespace earth_map;
+
+    GeographicBounds bounds;
+    bool have_bounds = false;
+    int min_zoom = 0;
+    int max_zoom = -1;
+    std::string url_template = "https://tile.openstreetmap.org/{z}/{x}/{y}.png";
+    std::string cache_directory = "./tile_cache";
+    TileSeedConfig seed_config;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--bbox" && has_value) {
+            have_bounds = ParseBounds(argv[++i], bounds);
+            if (!have_bounds) {
+                std::cerr << "Invalid --bbox\n";
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--zoom" && has_value) {
+            if (!ParseZoomRange(argv[++i], min_zoom, max_zoom)) {
+                std::cerr << "Invalid --zoom\n";
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--url" && has_value) {
+            url_template = argv[++i];
+        } else if (arg == "--cache-dir" && has_value) {
+            cache_directory = argv[++i];
+        } else if (arg == "--parallel" && has_value) {
+            seed_config.max_parallel_downloads = std::strtoul(argv[++i], nullptr, 10);
+        } else if (arg == "--rate" && has_value) {
+            seed_config.max_requests_per_second = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--compression" && has_value) {
+            if (!ParseCompression(argv[++i], seed_config.compression)) {
+                std::cerr << "Invalid --compression\n";
+                return EXIT_FAILURE;
+            }
+        } else if (arg == "--no-resume") {
+            seed_config.skip_existing = false;
+        } else {
+            PrintUsage();
+            return arg == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    if (!have_bounds || max_zoom < 0) {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    TileLoaderConfig loader_config;
+    loader_config.max_concurrent_downloads = seed_config.max_parallel_downloads;
+    std::shared_ptr<TileLoader> loader = CreateTileLoader(loader_config);
+    if (!loader->Initialize(loader_config) ||
+        !loader->AddProvider(std::make_shared<BasicXYZTileProvider>("Seed", url_template)) ||
+        !loader->SetDefaultProvider("Seed")) {
+        std::cerr << "Failed to set up the tile loader\n";
+        return EXIT_FAILURE;
+    }
+
+    // Same layout as the PACKED disk backend of BasicTileCache
+    PackedTileStoreConfig store_config;
+    store_config.directory = cache_directory + "/packed";
+    store_config.background_compaction = false;
+    auto store = std::make_shared<PackedTileStore>(store_config);
+    if (!store->Open()) {
+        std::cerr << "Failed to open " << store_config.directory << "\n";
+        return EXIT_FAILURE;
+    }
+
+    TileSeeder seeder(loader, store, seed_config);
+    const auto tiles = TileSeeder::EnumerateTiles(bounds, min_zoom, max_zoom);
+    std::cout << "Seeding " << tiles.size() << " tiles (zoom " << min_zoom << "-" << max_zoom
+              << ") into " << store_config.directory << "\n";
+
+    g_seeder = &seeder;
+    std::signal(SIGINT, HandleSignal);
+    std::signal(SIGTERM, HandleSignal);
+
+    const TileSeedStats stats = seeder.Seed(tiles, [](const TileSeedStats& progress) {
+        std::printf("\r%zu / %zu tiles (%zu failed)", progress.GetCompletedTiles(),
+                    progress.total_tiles, progress.failed_tiles);
+        std::fflush(stdout);
+    });
+
+    g_seeder = nullptr;
+    std::signal(SIGINT, SIG_DFL);
+    std::signal(SIGTERM, SIG_DFL);
+    store->Close();
+
+    std::printf("\n%zu downloaded, %zu already stored, %zu failed, %llu bytes%s\n",
+                stats.downloaded_tiles, stats.skipped_tiles, stats.failed_tiles,
+                static_cast<unsigned long long>(stats.downloaded_bytes),
+                stats.cancelled ? " (interrupted; run again to resume)" : "");
+    return stats.failed_tiles == 0 && !stats.cancelled ? EXIT_SUCCESS : EXIT_FAILURE;
+}